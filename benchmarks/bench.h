@@ -0,0 +1,106 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_BENCH_H_
+#define LSST_SPHGEOM_BENCH_H_
+
+/// \file
+/// \brief This file defines inputs shared by the benchmarks.
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace bench {
+
+/// All benchmark regions are centered on this point, which is away from
+/// the boundaries of the root pixels of every pixelization.
+inline UnitVector3d regionCenter() {
+    return UnitVector3d(LonLat::fromDegrees(10.0, 20.0));
+}
+
+/// `randomPoints` returns n points distributed uniformly over the sphere.
+/// The same points are returned for every call with the same n.
+inline std::vector<UnitVector3d> randomPoints(size_t n) {
+    std::mt19937 rng(n);
+    std::normal_distribution<double> dist;
+    std::vector<UnitVector3d> points;
+    points.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        points.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return points;
+}
+
+/// The functions below create regions of the given size, which is a radius
+/// or half-width in arcseconds.
+///@{
+inline std::unique_ptr<Region> makeCircle(int64_t size) {
+    return std::make_unique<Circle>(regionCenter(),
+                                    Angle::fromDegrees(size / 3600.0));
+}
+
+inline std::unique_ptr<Region> makeBox(int64_t size) {
+    return std::make_unique<Box>(LonLat(regionCenter()),
+                                 Angle::fromDegrees(size / 3600.0),
+                                 Angle::fromDegrees(size / 3600.0));
+}
+
+inline std::unique_ptr<Region> makeEllipse(int64_t size) {
+    return std::make_unique<Ellipse>(regionCenter(),
+                                     Angle::fromDegrees(size / 3600.0),
+                                     Angle::fromDegrees(size / 7200.0),
+                                     Angle::fromDegrees(30.0));
+}
+
+/// `makePolygon` returns a regular hexagon.
+inline std::unique_ptr<Region> makePolygon(int64_t size) {
+    UnitVector3d c = regionCenter();
+    UnitVector3d n = UnitVector3d::orthogonalTo(c);
+    Angle r = Angle::fromDegrees(size / 3600.0);
+    std::vector<UnitVector3d> vertices;
+    for (int i = 0; i < 6; ++i) {
+        UnitVector3d v = c.rotatedAround(n, r);
+        vertices.push_back(v.rotatedAround(c, Angle::fromDegrees(60.0 * i)));
+    }
+    return std::make_unique<ConvexPolygon>(vertices);
+}
+///@}
+
+/// `LSST_SPHGEOM_BENCH_REGION_SIZES` lists region sizes in arcseconds, from 0.01 to 10 degrees.
+#define LSST_SPHGEOM_BENCH_REGION_SIZES \
+    ->Arg(36)->Arg(360)->Arg(3600)->Arg(36000)
+
+}}} // namespace lsst::sphgeom::bench
+
+#endif // LSST_SPHGEOM_BENCH_H_
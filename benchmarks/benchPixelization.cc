@@ -0,0 +1,149 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains benchmarks for the pixelizations.
+
+#include <benchmark/benchmark.h>
+
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "bench.h"
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+constexpr size_t NUM_POINTS = 65536;
+
+template <typename P>
+void BM_index(benchmark::State & state) {
+    P pixelization(static_cast<int>(state.range(0)));
+    std::vector<UnitVector3d> points = bench::randomPoints(NUM_POINTS);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pixelization.index(points[i]));
+        i = (i + 1) % NUM_POINTS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename P>
+void BM_indexBatch(benchmark::State & state) {
+    P pixelization(static_cast<int>(state.range(0)));
+    UnitVector3dArray points(bench::randomPoints(NUM_POINTS));
+    std::vector<uint64_t> indexes(NUM_POINTS);
+    for (auto _ : state) {
+        pixelization.index(points, indexes.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_POINTS);
+}
+
+// Region benchmarks use level 10 pixels, about 0.1 degrees wide.
+constexpr int REGION_LEVEL = 10;
+
+template <typename P, std::unique_ptr<Region> (*Make)(int64_t)>
+void BM_envelope(benchmark::State & state) {
+    P pixelization(REGION_LEVEL);
+    std::unique_ptr<Region> region = Make(state.range(0));
+    size_t numRanges = 0;
+    for (auto _ : state) {
+        RangeSet s = pixelization.envelope(*region);
+        numRanges = s.size();
+        benchmark::DoNotOptimize(s);
+    }
+    state.counters["ranges"] = static_cast<double>(numRanges);
+}
+
+template <typename P, std::unique_ptr<Region> (*Make)(int64_t)>
+void BM_interior(benchmark::State & state) {
+    P pixelization(REGION_LEVEL);
+    std::unique_ptr<Region> region = Make(state.range(0));
+    size_t numRanges = 0;
+    for (auto _ : state) {
+        RangeSet s = pixelization.interior(*region);
+        numRanges = s.size();
+        benchmark::DoNotOptimize(s);
+    }
+    state.counters["ranges"] = static_cast<double>(numRanges);
+}
+
+// Adaptive envelopes at level 20 with a range target, to compare against
+// envelope() with the same maxRanges.
+template <typename P>
+void BM_adaptiveEnvelope(benchmark::State & state) {
+    P pixelization(20);
+    std::unique_ptr<Region> region = bench::makeCircle(3600);
+    size_t targetRanges = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            pixelization.adaptiveEnvelope(*region, targetRanges));
+    }
+}
+
+template <typename P>
+void BM_coarsenedEnvelope(benchmark::State & state) {
+    P pixelization(20);
+    std::unique_ptr<Region> region = bench::makeCircle(3600);
+    size_t maxRanges = static_cast<size_t>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(pixelization.envelope(*region, maxRanges));
+    }
+}
+
+} // unnamed namespace
+
+#define LSST_SPHGEOM_BENCH_INDEX(P, maxLevel) \
+    BENCHMARK_TEMPLATE(BM_index, P)->Arg(5)->Arg(10)->Arg(maxLevel); \
+    BENCHMARK_TEMPLATE(BM_indexBatch, P)->Arg(5)->Arg(10)->Arg(maxLevel);
+
+LSST_SPHGEOM_BENCH_INDEX(HtmPixelization, 20)
+LSST_SPHGEOM_BENCH_INDEX(Q3cPixelization, 20)
+LSST_SPHGEOM_BENCH_INDEX(Mq3cPixelization, 20)
+LSST_SPHGEOM_BENCH_INDEX(HealpixPixelization, 20)
+
+#define LSST_SPHGEOM_BENCH_MAX_RANGES(P) \
+    BENCHMARK_TEMPLATE(BM_adaptiveEnvelope, P)->Arg(8)->Arg(32)->Arg(128); \
+    BENCHMARK_TEMPLATE(BM_coarsenedEnvelope, P)->Arg(8)->Arg(32)->Arg(128);
+
+LSST_SPHGEOM_BENCH_MAX_RANGES(HtmPixelization)
+LSST_SPHGEOM_BENCH_MAX_RANGES(Mq3cPixelization)
+
+#define LSST_SPHGEOM_BENCH_REGION(P, make) \
+    BENCHMARK_TEMPLATE(BM_envelope, P, make) LSST_SPHGEOM_BENCH_REGION_SIZES; \
+    BENCHMARK_TEMPLATE(BM_interior, P, make) LSST_SPHGEOM_BENCH_REGION_SIZES;
+
+#define LSST_SPHGEOM_BENCH_REGIONS(P) \
+    LSST_SPHGEOM_BENCH_REGION(P, bench::makeCircle) \
+    LSST_SPHGEOM_BENCH_REGION(P, bench::makeBox) \
+    LSST_SPHGEOM_BENCH_REGION(P, bench::makePolygon) \
+    LSST_SPHGEOM_BENCH_REGION(P, bench::makeEllipse)
+
+LSST_SPHGEOM_BENCH_REGIONS(HtmPixelization)
+LSST_SPHGEOM_BENCH_REGIONS(Q3cPixelization)
+LSST_SPHGEOM_BENCH_REGIONS(Mq3cPixelization)
+LSST_SPHGEOM_BENCH_REGIONS(HealpixPixelization)
@@ -0,0 +1,159 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains benchmarks for RangeSet.
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/RangeSetExpression.h"
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+// `makeRangeSet` returns a set of n random disjoint ranges. Varying the seed
+// gives sets that overlap partially.
+RangeSet makeRangeSet(size_t n, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<uint64_t> gap(1, 1000);
+    RangeSet s;
+    uint64_t x = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t first = x + gap(rng);
+        x = first + gap(rng);
+        s.insert(first, x);
+    }
+    return s;
+}
+
+void BM_insert(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    std::mt19937_64 rng(n);
+    std::uniform_int_distribution<uint64_t> dist(0, 1000 * n);
+    std::vector<uint64_t> values(n);
+    for (uint64_t & v : values) {
+        v = dist(rng);
+    }
+    for (auto _ : state) {
+        RangeSet s;
+        for (uint64_t v : values) {
+            s.insert(v);
+        }
+        benchmark::DoNotOptimize(s);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_union(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1), b = makeRangeSet(n, 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a | b);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+void BM_intersection(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1), b = makeRangeSet(n, 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a & b);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+void BM_difference(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1), b = makeRangeSet(n, 2);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a - b);
+    }
+    state.SetItemsProcessed(state.iterations() * 2 * n);
+}
+
+void BM_chain(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1), b = makeRangeSet(n, 2),
+             c = makeRangeSet(n, 3), d = makeRangeSet(n, 4);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(((a & b) | c) - d);
+    }
+    state.SetItemsProcessed(state.iterations() * 4 * n);
+}
+
+void BM_chainCardinality(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1), b = makeRangeSet(n, 2),
+             c = makeRangeSet(n, 3), d = makeRangeSet(n, 4);
+    RangeSetExpression e = ((RangeSetExpression(a) & b) | c) - d;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(e.cardinality());
+    }
+    state.SetItemsProcessed(state.iterations() * 4 * n);
+}
+
+void BM_complement(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1);
+    for (auto _ : state) {
+        a.complement();
+        benchmark::DoNotOptimize(a);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_encode(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    RangeSet a = makeRangeSet(n, 1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a.encode());
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void BM_decode(benchmark::State & state) {
+    size_t n = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> bytes = makeRangeSet(n, 1).encode();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(RangeSet::decode(bytes));
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+} // unnamed namespace
+
+#define LSST_SPHGEOM_BENCH_RANGE_SET_SIZES ->Arg(16)->Arg(1024)->Arg(65536)
+
+BENCHMARK(BM_insert) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_union) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_intersection) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_difference) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_chain) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_chainCardinality) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_complement) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_encode) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
+BENCHMARK(BM_decode) LSST_SPHGEOM_BENCH_RANGE_SET_SIZES;
@@ -0,0 +1,114 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains benchmarks for regions, orientation and
+///        the Chunker.
+
+#include <benchmark/benchmark.h>
+
+#include "lsst/sphgeom/Chunker.h"
+#include "lsst/sphgeom/orientation.h"
+
+#include "bench.h"
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+template <std::unique_ptr<Region> (*Make)(int64_t)>
+void BM_getSubChunksIntersecting(benchmark::State & state) {
+    // The LSST Qserv partitioning parameters.
+    Chunker chunker(85, 12);
+    std::unique_ptr<Region> region = Make(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(chunker.getSubChunksIntersecting(*region));
+    }
+}
+
+template <std::unique_ptr<Region> (*Make)(int64_t)>
+void BM_encode(benchmark::State & state) {
+    std::unique_ptr<Region> region = Make(3600);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(region->encode());
+    }
+}
+
+template <std::unique_ptr<Region> (*Make)(int64_t)>
+void BM_decode(benchmark::State & state) {
+    std::vector<uint8_t> bytes = Make(3600)->encode();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Region::decode(bytes));
+    }
+}
+
+template <std::unique_ptr<Region> (*Make)(int64_t)>
+void BM_contains(benchmark::State & state) {
+    constexpr size_t n = 65536;
+    std::unique_ptr<Region> region = Make(state.range(0));
+    std::vector<UnitVector3d> points = bench::randomPoints(n);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(region->contains(points[i]));
+        i = (i + 1) % n;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_orientation(benchmark::State & state) {
+    constexpr size_t n = 65536;
+    std::vector<UnitVector3d> points = bench::randomPoints(n + 2);
+    size_t i = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            orientation(points[i], points[i + 1], points[i + 2]));
+        i = (i + 1) % n;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Nearly collinear inputs force orientation onto its exact code path.
+void BM_orientationExact(benchmark::State & state) {
+    UnitVector3d a = UnitVector3d::X();
+    UnitVector3d b(1.0, 1.0e-300, 0.0);
+    UnitVector3d c(1.0, 2.0e-300, 0.0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(orientation(a, b, c));
+    }
+}
+
+} // unnamed namespace
+
+#define LSST_SPHGEOM_BENCH_REGION(make) \
+    BENCHMARK_TEMPLATE(BM_getSubChunksIntersecting, make) \
+        LSST_SPHGEOM_BENCH_REGION_SIZES; \
+    BENCHMARK_TEMPLATE(BM_encode, make); \
+    BENCHMARK_TEMPLATE(BM_decode, make); \
+    BENCHMARK_TEMPLATE(BM_contains, make) LSST_SPHGEOM_BENCH_REGION_SIZES;
+
+LSST_SPHGEOM_BENCH_REGION(bench::makeCircle)
+LSST_SPHGEOM_BENCH_REGION(bench::makeBox)
+LSST_SPHGEOM_BENCH_REGION(bench::makePolygon)
+LSST_SPHGEOM_BENCH_REGION(bench::makeEllipse)
+
+BENCHMARK(BM_orientation);
+BENCHMARK(BM_orientationExact);
@@ -0,0 +1,545 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains a program that replays a corpus of realistic
+///        regions, pixel sets and points through the hot library calls.
+///
+/// Usage:
+///
+///     sphgeom_replay [--repetitions N] [--filter SUBSTRING] CORPUS
+///     sphgeom_replay --generate CORPUS
+///
+/// The first form times every operation on every corpus entry N times
+/// (default 20), and prints latency percentiles and the number and total
+/// size of heap allocations per call. The second form writes the corpus
+/// shipped in benchmarks/corpus, so that it can be regenerated when its
+/// format version changes. Corpora can also be written from production
+/// data; the format is line oriented:
+///
+///     sphgeom-corpus 1
+///     region <name> <hex encoded Region::encode output>
+///     rangeset <name> <hex encoded RangeSet::encode output>
+///     points <name> <n>
+///     <lon> <lat>
+///     ...
+///
+/// where the `points` line is followed by n lines of coordinates in
+/// degrees. Blank lines and lines starting with `#` are ignored.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Chunker.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+
+namespace {
+
+// Heap allocations made by the whole program are counted by replacing the
+// global allocation functions. The sized forms of operator delete forward
+// to the unsized ones, and the remaining forms of operator new and delete
+// forward to these by default. None of them are inlined, since GCC would
+// otherwise see through them and warn that memory from malloc is released
+// by operator delete, or memory from operator new by free.
+std::atomic<size_t> allocationCount{0};
+std::atomic<size_t> allocationBytes{0};
+
+} // unnamed namespace
+
+[[gnu::noinline]] void * operator new(std::size_t n) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(n, std::memory_order_relaxed);
+    if (void * p = std::malloc(n == 0 ? 1 : n)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void * p) noexcept { std::free(p); }
+
+[[gnu::noinline]] void operator delete(void * p, std::size_t) noexcept {
+    ::operator delete(p);
+}
+
+// Polymorphic memory resources allocate with the aligned forms.
+[[gnu::noinline]] void * operator new(std::size_t n, std::align_val_t a) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(n, std::memory_order_relaxed);
+    std::size_t alignment = static_cast<std::size_t>(a);
+    std::size_t size = (std::max<std::size_t>(n, 1) + alignment - 1) /
+                       alignment * alignment;
+    if (void * p = std::aligned_alloc(alignment, size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void * p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+[[gnu::noinline]] void operator delete(void * p,
+                                       std::size_t,
+                                       std::align_val_t a) noexcept {
+    ::operator delete(p, a);
+}
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+constexpr int CORPUS_VERSION = 1;
+
+struct Corpus {
+    struct Entry {
+        std::string name;
+        std::vector<uint8_t> bytes;
+    };
+
+    struct Points {
+        std::string name;
+        std::vector<double> x, y, z;
+    };
+
+    std::vector<Entry> regions;
+    std::vector<Entry> rangeSets;
+    std::vector<Points> points;
+};
+
+std::string toHex(std::vector<uint8_t> const & bytes) {
+    static char const DIGITS[] = "0123456789abcdef";
+    std::string s;
+    s.reserve(2 * bytes.size());
+    for (uint8_t b : bytes) {
+        s.push_back(DIGITS[b >> 4]);
+        s.push_back(DIGITS[b & 0xf]);
+    }
+    return s;
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') { return c - '0'; }
+    if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+    if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+    throw std::runtime_error("Invalid hex digit in corpus");
+}
+
+std::vector<uint8_t> fromHex(std::string const & s) {
+    if (s.size() % 2 != 0) {
+        throw std::runtime_error("Odd number of hex digits in corpus");
+    }
+    std::vector<uint8_t> bytes(s.size() / 2);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<uint8_t>(
+            (hexDigit(s[2 * i]) << 4) | hexDigit(s[2 * i + 1]));
+    }
+    return bytes;
+}
+
+Corpus readCorpus(std::istream & in) {
+    Corpus corpus;
+    std::string line;
+    bool sawVersion = false;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string kind, name, data;
+        fields >> kind;
+        if (!sawVersion) {
+            int version = 0;
+            fields >> version;
+            if (kind != "sphgeom-corpus" || version != CORPUS_VERSION) {
+                throw std::runtime_error("Unsupported corpus version");
+            }
+            sawVersion = true;
+            continue;
+        }
+        fields >> name >> data;
+        if (!fields) {
+            throw std::runtime_error("Malformed corpus line: " + line);
+        }
+        if (kind == "region") {
+            corpus.regions.push_back({name, fromHex(data)});
+        } else if (kind == "rangeset") {
+            corpus.rangeSets.push_back({name, fromHex(data)});
+        } else if (kind == "points") {
+            Corpus::Points p;
+            p.name = name;
+            size_t n = std::stoul(data);
+            for (size_t i = 0; i < n; ++i) {
+                double lon, lat;
+                if (!(in >> lon >> lat)) {
+                    throw std::runtime_error("Truncated point set in corpus");
+                }
+                UnitVector3d v(LonLat::fromDegrees(lon, lat));
+                p.x.push_back(v.x());
+                p.y.push_back(v.y());
+                p.z.push_back(v.z());
+            }
+            corpus.points.push_back(std::move(p));
+        } else {
+            throw std::runtime_error("Unknown corpus entry kind: " + kind);
+        }
+    }
+    if (!sawVersion) {
+        throw std::runtime_error("Empty corpus");
+    }
+    return corpus;
+}
+
+// The generated corpus mimics the inputs that dominate production use:
+// sensor footprints near the poles, where boxes and pixel bounds
+// degenerate, thin ellipses, survey boundaries with many vertices, cone
+// searches, and pixel sets from coverage maps. The generator depends on
+// the standard library's random distributions, which are not portable,
+// so the corpus is checked in rather than regenerated by each build.
+void writeCorpus(std::ostream & out) {
+    std::mt19937 rng(20260101);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::normal_distribution<double> normal;
+    std::vector<std::pair<std::string, std::unique_ptr<Region>>> regions;
+    auto deg = [](double d) { return Angle::fromDegrees(d); };
+
+    // LSST sized sensors, 0.23 degrees on a side.
+    auto sensor = [&](double lon, double lat, double rotation) {
+        UnitVector3d c(LonLat::fromDegrees(lon, lat));
+        UnitVector3d n = UnitVector3d::northFrom(c);
+        std::vector<UnitVector3d> vertices;
+        for (int i = 0; i < 4; ++i) {
+            UnitVector3d v = c.rotatedAround(
+                UnitVector3d(n.cross(c)), deg(0.1626));
+            vertices.push_back(
+                v.rotatedAround(c, deg(rotation + 45.0 + 90.0 * i)));
+        }
+        return std::make_unique<ConvexPolygon>(vertices);
+    };
+    for (int i = 0; i < 12; ++i) {
+        double lat = -80.0 - 10.0 * std::pow(uniform(rng), 0.25);
+        regions.emplace_back("ccd_south_" + std::to_string(i),
+                             sensor(360.0 * uniform(rng), lat,
+                                    360.0 * uniform(rng)));
+    }
+    for (int i = 0; i < 4; ++i) {
+        regions.emplace_back("ccd_north_" + std::to_string(i),
+                             sensor(90.0 * i, 89.95, 30.0 * i));
+    }
+    regions.emplace_back("ccd_equator", sensor(10.0, 0.0, 0.0));
+    for (int i = 0; i < 8; ++i) {
+        double lat = i < 4 ? -90.0 + 180.0 * uniform(rng) : 88.0 + i * 0.2;
+        UnitVector3d c(LonLat::fromDegrees(360.0 * uniform(rng), lat));
+        regions.emplace_back(
+            "thin_ellipse_" + std::to_string(i),
+            std::make_unique<Ellipse>(c, deg(1.0 + i), deg(0.002 * (i + 1)),
+                                      deg(180.0 * uniform(rng))));
+    }
+    // Survey boundaries, as convex hulls of 1000 points on a lumpy loop.
+    for (int i = 0; i < 2; ++i) {
+        UnitVector3d c(LonLat::fromDegrees(60.0 + 150.0 * i, -30.0 + 40.0 * i));
+        UnitVector3d n = UnitVector3d::northFrom(c);
+        UnitVector3d axis(n.cross(c));
+        std::vector<UnitVector3d> vertices;
+        for (int j = 0; j < 1000; ++j) {
+            double t = 2.0 * PI * j / 1000.0;
+            UnitVector3d v = c.rotatedAround(
+                axis, deg(20.0 + 10.0 * i + 1.5 * std::cos(2.0 * t)));
+            vertices.push_back(v.rotatedAround(c, Angle(t)));
+        }
+        regions.emplace_back(
+            "survey_boundary_" + std::to_string(i),
+            std::make_unique<ConvexPolygon>(
+                ConvexPolygon::convexHull(vertices)));
+    }
+    Region const * footprint = regions[regions.size() - 2].second.get();
+    for (double r : {0.0167, 0.5, 3.0}) {
+        UnitVector3d c(LonLat::fromDegrees(360.0 * uniform(rng),
+                                           -60.0 + 120.0 * uniform(rng)));
+        std::ostringstream name;
+        name << "cone_" << r;
+        regions.emplace_back(name.str(), std::make_unique<Circle>(c, deg(r)));
+    }
+    regions.emplace_back("box_lon_wrap",
+                         std::make_unique<Box>(Box::fromDegrees(-2.0, -5.0,
+                                                                2.0, 5.0)));
+    regions.emplace_back("box_polar_cap",
+                         std::make_unique<Box>(Box::fromDegrees(0.0, 85.0,
+                                                                360.0, 90.0)));
+
+    // Coverage maps: a focal plane of sensors tiling a field, a survey
+    // footprint, and a sparse set of pointings.
+    std::vector<std::pair<std::string, RangeSet>> rangeSets;
+    HtmPixelization htm12(12);
+    RangeSet focalPlane;
+    for (int i = -6; i <= 6; ++i) {
+        for (int j = -6; j <= 6; ++j) {
+            if (i * i + j * j <= 42) {
+                focalPlane |= htm12.envelope(
+                    *sensor(150.0 + 0.23 * i / std::cos(0.4),
+                            -23.0 + 0.23 * j, 0.0));
+            }
+        }
+    }
+    rangeSets.emplace_back("focal_plane_htm12", focalPlane);
+    rangeSets.emplace_back(
+        "survey_footprint_htm8",
+        HtmPixelization(8).interior(*footprint));
+    RangeSet pointings;
+    HtmPixelization htm14(14);
+    for (int i = 0; i < 200; ++i) {
+        UnitVector3d c(normal(rng), normal(rng), normal(rng));
+        pointings |= htm14.envelope(Circle(c, deg(0.05)));
+    }
+    rangeSets.emplace_back("pointings_htm14", pointings);
+
+    out << "# Replay corpus for sphgeom_replay; see benchmarks/replay.cc.\n"
+        << "sphgeom-corpus " << CORPUS_VERSION << "\n";
+    for (auto const & r : regions) {
+        out << "region " << r.first << " " << toHex(r.second->encode())
+            << "\n";
+    }
+    for (auto const & s : rangeSets) {
+        out << "rangeset " << s.first << " " << toHex(s.second.encode())
+            << "\n";
+    }
+    // A field of clustered sources and an all-sky sample.
+    size_t const n = 2048;
+    out.precision(12);
+    out << "points field_sources " << n << "\n";
+    for (size_t i = 0; i < n; ++i) {
+        out << 150.0 + 1.5 * normal(rng) << " "
+            << std::max(-90.0, std::min(90.0, -23.0 + 1.5 * normal(rng)))
+            << "\n";
+    }
+    out << "points all_sky " << n << "\n";
+    for (size_t i = 0; i < n; ++i) {
+        LonLat p(UnitVector3d(normal(rng), normal(rng), normal(rng)));
+        out << p.getLon().asDegrees() << " " << p.getLat().asDegrees()
+            << "\n";
+    }
+}
+
+struct Sample {
+    double seconds;
+    size_t allocations;
+    size_t bytes;
+};
+
+class Replayer {
+public:
+    Replayer(int repetitions, std::string filter) :
+        _repetitions(repetitions), _filter(std::move(filter)) {
+        std::printf("%-28s %-22s %10s %10s %10s %10s %8s %10s\n",
+                    "case", "operation", "p50 (us)", "p90 (us)", "p99 (us)",
+                    "max (us)", "allocs", "bytes");
+    }
+
+    // `run` times `op` and prints its statistics. The first call is a
+    // warm-up and is not recorded.
+    void run(std::string const & name, char const * operation,
+             std::function<void()> const & op) {
+        if (!_filter.empty() &&
+            (name + " " + operation).find(_filter) == std::string::npos) {
+            return;
+        }
+        op();
+        std::vector<Sample> samples;
+        for (int i = 0; i < _repetitions; ++i) {
+            size_t count = allocationCount.load();
+            size_t bytes = allocationBytes.load();
+            auto start = std::chrono::steady_clock::now();
+            op();
+            auto end = std::chrono::steady_clock::now();
+            samples.push_back({
+                std::chrono::duration<double>(end - start).count(),
+                allocationCount.load() - count,
+                allocationBytes.load() - bytes
+            });
+        }
+        std::sort(samples.begin(), samples.end(),
+                  [](Sample const & a, Sample const & b) {
+                      return a.seconds < b.seconds;
+                  });
+        auto percentile = [&](double p) {
+            size_t i = static_cast<size_t>(
+                std::ceil(p * static_cast<double>(samples.size()))) - 1;
+            return 1.0e6 * samples[std::min(i, samples.size() - 1)].seconds;
+        };
+        // Allocations do not depend on timing, so the median sample is
+        // representative.
+        Sample const & median = samples[(samples.size() - 1) / 2];
+        std::printf("%-28s %-22s %10.2f %10.2f %10.2f %10.2f %8zu %10zu\n",
+                    name.c_str(), operation, percentile(0.5),
+                    percentile(0.9), percentile(0.99),
+                    1.0e6 * samples.back().seconds, median.allocations,
+                    median.bytes);
+        std::fflush(stdout);
+    }
+
+private:
+    int _repetitions;
+    std::string _filter;
+};
+
+// `keep` prevents the compiler from discarding the computation of `value`.
+template <typename T>
+void keep(T const & value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+void replay(Corpus const & corpus, Replayer & replayer) {
+    HtmPixelization htm(12);
+    Mq3cPixelization mq3c(12);
+    Chunker chunker(85, 12);
+    std::vector<std::unique_ptr<Region>> regions;
+    for (auto const & e : corpus.regions) {
+        regions.push_back(Region::decode(e.bytes));
+    }
+    for (size_t i = 0; i < regions.size(); ++i) {
+        Region const & r = *regions[i];
+        std::string const & name = corpus.regions[i].name;
+        std::vector<uint8_t> const & bytes = corpus.regions[i].bytes;
+        replayer.run(name, "decode", [&] { keep(Region::decode(bytes)); });
+        replayer.run(name, "envelope", [&] { keep(htm.envelope(r)); });
+        replayer.run(name, "envelope64", [&] { keep(mq3c.envelope(r, 64)); });
+        replayer.run(name, "interior", [&] { keep(htm.interior(r)); });
+        // One relate sample relates the region to every corpus region.
+        replayer.run(name, "relate", [&] {
+            int sum = 0;
+            for (auto const & other : regions) {
+                sum += static_cast<int>(r.relate(*other).to_ulong());
+            }
+            keep(sum);
+        });
+        for (auto const & p : corpus.points) {
+            std::unique_ptr<bool[]> out(new bool[p.x.size()]);
+            replayer.run(name, ("contains:" + p.name).c_str(), [&] {
+                r.contains(p.x.data(), p.y.data(), p.z.data(), out.get(),
+                           p.x.size());
+            });
+        }
+        replayer.run(name, "chunker", [&] {
+            keep(chunker.getSubChunksIntersecting(r));
+        });
+    }
+    std::vector<RangeSet> sets;
+    for (auto const & e : corpus.rangeSets) {
+        sets.push_back(RangeSet::decode(e.bytes));
+    }
+    for (size_t i = 0; i < sets.size(); ++i) {
+        RangeSet const & s = sets[i];
+        std::string const & name = corpus.rangeSets[i].name;
+        std::vector<uint8_t> const & bytes = corpus.rangeSets[i].bytes;
+        replayer.run(name, "decode", [&] { keep(RangeSet::decode(bytes)); });
+        // One sample combines the set with every corpus set.
+        replayer.run(name, "union", [&] {
+            for (RangeSet const & t : sets) { keep(s | t); }
+        });
+        replayer.run(name, "intersection", [&] {
+            for (RangeSet const & t : sets) { keep(s & t); }
+        });
+    }
+    for (auto const & p : corpus.points) {
+        std::vector<uint64_t> out(p.x.size());
+        replayer.run(p.name, "index", [&] {
+            htm.index(p.x.data(), p.y.data(), p.z.data(), out.data(),
+                      p.x.size());
+        });
+    }
+}
+
+int usage() {
+    std::cerr << "usage: sphgeom_replay [--repetitions N] "
+                 "[--filter SUBSTRING] CORPUS\n"
+                 "       sphgeom_replay --generate CORPUS\n";
+    return 2;
+}
+
+} // unnamed namespace
+
+int main(int argc, char ** argv) {
+    int repetitions = 20;
+    std::string filter;
+    bool generate = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--generate") {
+            generate = true;
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (path.empty() && arg[0] != '-') {
+            path = arg;
+        } else {
+            return usage();
+        }
+    }
+    if (path.empty() || repetitions < 1) {
+        return usage();
+    }
+    try {
+        if (generate) {
+            std::ofstream out(path);
+            writeCorpus(out);
+            return out ? 0 : 1;
+        }
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "cannot open " << path << "\n";
+            return 1;
+        }
+        Corpus corpus = readCorpus(in);
+        Replayer replayer(repetitions, filter);
+        replay(corpus, replayer);
+    } catch (std::exception const & e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_BOUNDSCACHE_H_
+#define LSST_SPHGEOM_BOUNDSCACHE_H_
+
+/// \file
+/// \brief This file declares a cache for the bounding primitives of
+///        a region.
+
+#include <atomic>
+#include <cstdint>
+
+#include "Box.h"
+#include "Box3d.h"
+#include "Circle.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `BoundsCache` stores the bounding box, bounding 3-box and bounding
+/// circle of an immutable region, each computed on first use.
+///
+/// Lookups are lock-free and safe to perform concurrently. If several
+/// threads request the same uncached bound at once, each computes it,
+/// and exactly one of them stores the result. Copying a cache copies
+/// whatever bounds have been computed so far.
+class BoundsCache {
+public:
+    BoundsCache() = default;
+
+    BoundsCache(BoundsCache const & c) noexcept { _copy(c); }
+
+    BoundsCache & operator=(BoundsCache const & c) noexcept {
+        if (this != &c) {
+            _reset();
+            _copy(c);
+        }
+        return *this;
+    }
+
+    ///@{
+    /// These functions return a cached bound, calling `compute()`
+    /// to obtain it if it has not been computed yet.
+    template <typename Compute>
+    Box getBoundingBox(Compute compute) const {
+        return _get(_boxState, _box, compute);
+    }
+
+    template <typename Compute>
+    Box3d getBoundingBox3d(Compute compute) const {
+        return _get(_box3dState, _box3d, compute);
+    }
+
+    template <typename Compute>
+    Circle getBoundingCircle(Compute compute) const {
+        return _get(_circleState, _circle, compute);
+    }
+    ///@}
+
+private:
+    enum : uint8_t { EMPTY = 0, BUSY = 1, READY = 2 };
+
+    template <typename T, typename Compute>
+    static T _get(std::atomic<uint8_t> & state, T & value, Compute compute) {
+        if (state.load(std::memory_order_acquire) == READY) {
+            return value;
+        }
+        T result = compute();
+        uint8_t expected = EMPTY;
+        // Only the thread that claims the slot writes to it, and readers
+        // only look at the value once it is marked READY.
+        if (state.compare_exchange_strong(expected, BUSY,
+                                          std::memory_order_acquire)) {
+            value = result;
+            state.store(READY, std::memory_order_release);
+        }
+        return result;
+    }
+
+    template <typename T>
+    static void _copyOne(std::atomic<uint8_t> & state, T & value,
+                         std::atomic<uint8_t> const & otherState,
+                         T const & otherValue) {
+        if (otherState.load(std::memory_order_acquire) == READY) {
+            value = otherValue;
+            state.store(READY, std::memory_order_release);
+        }
+    }
+
+    void _copy(BoundsCache const & c) {
+        _copyOne(_boxState, _box, c._boxState, c._box);
+        _copyOne(_box3dState, _box3d, c._box3dState, c._box3d);
+        _copyOne(_circleState, _circle, c._circleState, c._circle);
+    }
+
+    void _reset() {
+        _boxState.store(EMPTY, std::memory_order_relaxed);
+        _box3dState.store(EMPTY, std::memory_order_relaxed);
+        _circleState.store(EMPTY, std::memory_order_relaxed);
+    }
+
+    mutable Box _box;
+    mutable Box3d _box3d;
+    mutable Circle _circle;
+    mutable std::atomic<uint8_t> _boxState{EMPTY};
+    mutable std::atomic<uint8_t> _box3dState{EMPTY};
+    mutable std::atomic<uint8_t> _circleState{EMPTY};
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_BOUNDSCACHE_H_
@@ -307,13 +307,31 @@ public:
     Box getBoundingBox() const override { return *this; }
     Box3d getBoundingBox3d() const override;
     Circle getBoundingCircle() const override;
+    // Points are converted to spherical coordinates before testing them.
+    double getCostHint() const override { return 4.0; }
 
     bool contains(UnitVector3d const & v) const override {
         return contains(LonLat(v));
     }
 
+    /// `contains` tests whether each of the `n` points (x[i], y[i], z[i]),
+    /// which need not be normalized, is inside this box, and stores the
+    /// results in `out`. The results are identical to those of
+    /// `contains(UnitVector3d(x[i], y[i], z[i]))`, but points that are not
+    /// close to the box boundary are classified with a few dot products
+    /// against the edge planes, rather than by computing their longitudes
+    /// and latitudes.
+    void contains(double const * x, double const * y, double const * z,
+                  bool * out, size_t n) const override;
+
     using Region::contains;
 
+    /// `sample` draws points uniformly from this box without rejection, by
+    /// drawing longitudes and the sines of latitudes uniformly. It throws
+    /// std::invalid_argument if this box is empty.
+    void sample(size_t n, std::mt19937_64 & rng,
+                double * x, double * y, double * z) const override;
+
     Relationship relate(Region const & r) const override {
         // Dispatch on the type of r.
         return invert(r.relate(*this));
@@ -334,6 +352,7 @@ public:
     Relationship relate(Ellipse const &) const override;
 
     std::vector<uint8_t> encode() const override;
+    void encodeTo(std::vector<uint8_t> & buffer) const override;
 
     ///@{
     /// `decode` deserializes a Box from a byte string produced by encode.
@@ -344,8 +363,14 @@ public:
     ///@}
 
 private:
+    friend class DecodedRegion;
+
     static constexpr size_t ENCODED_SIZE = 33;
 
+    // `_decode` overwrites this box with one deserialized from a byte
+    // string produced by encode.
+    void _decode(uint8_t const * buffer, size_t n);
+
     void _enforceInvariants() {
         // Make sure that _lat ⊆ [-π/2, π/2].
         _lat.clipTo(allLatitudes());
@@ -0,0 +1,199 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_CHUNKPARTITIONER_H_
+#define LSST_SPHGEOM_CHUNKPARTITIONER_H_
+
+/// \file
+/// \brief This file declares a class for partitioning streams of catalog
+///        rows into chunks.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Angle.h"
+#include "Chunker.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// `CatalogBatch` is a columnar batch of catalog rows. Row i has longitude
+/// `lon[i]` and latitude `lat[i]` in radians, and its payload is made of
+/// the bytes of `payload` in [`offsets[i]`, `offsets[i + 1]`), so that
+/// `offsets` has one more element than there are rows.
+struct CatalogBatch {
+    std::vector<double> lon;
+    std::vector<double> lat;
+    std::vector<uint64_t> offsets = {0};
+    std::vector<uint8_t> payload;
+
+    /// `size` returns the number of rows in this batch.
+    size_t size() const { return lon.size(); }
+
+    void clear() {
+        lon.clear();
+        lat.clear();
+        offsets.assign(1, 0);
+        payload.clear();
+    }
+
+    /// `push_back` appends a row with the given position and payload.
+    void push_back(double lonRad, double latRad,
+                   uint8_t const * data, size_t n) {
+        lon.push_back(lonRad);
+        lat.push_back(latRad);
+        payload.insert(payload.end(), data, data + n);
+        offsets.push_back(payload.size());
+    }
+};
+
+/// `ChunkRows` holds catalog rows assigned to one chunk. Row i belongs to
+/// sub-chunk `subChunkId[i]`, and `isOverlap[i]` is non-zero if it lies in
+/// the overlap region of that sub-chunk rather than in the sub-chunk itself.
+/// Its payload is made of the bytes of `payload` in [`offsets[i]`,
+/// `offsets[i + 1]`).
+struct ChunkRows {
+    std::vector<int32_t> subChunkId;
+    std::vector<uint8_t> isOverlap;
+    std::vector<uint64_t> offsets = {0};
+    std::vector<uint8_t> payload;
+
+    /// `size` returns the number of rows in this buffer.
+    size_t size() const { return subChunkId.size(); }
+
+    bool empty() const { return subChunkId.empty(); }
+
+    /// `bytes` returns the number of bytes of row data in this buffer.
+    size_t bytes() const {
+        return payload.size() + size() * (sizeof(int32_t) + sizeof(uint8_t) +
+                                          sizeof(uint64_t));
+    }
+
+    void clear() {
+        subChunkId.clear();
+        isOverlap.clear();
+        offsets.assign(1, 0);
+        payload.clear();
+    }
+};
+
+/// `ChunkSink` receives the partitioned rows of a ChunkPartitioner.
+class ChunkSink {
+public:
+    virtual ~ChunkSink() = default;
+
+    /// `write` is called with some of the rows of the chunk with the given
+    /// ID, which are only valid for the duration of the call. It may be
+    /// called concurrently from several threads, but never concurrently for
+    /// the same chunk, so that rows can be appended to one file per chunk
+    /// without locking. An exception thrown by `write` is propagated to the
+    /// caller of the ChunkPartitioner function that triggered it.
+    virtual void write(int32_t chunkId, ChunkRows const & rows) = 0;
+};
+
+/// `ChunkPartitioner` partitions streams of catalog rows into chunks.
+///
+/// Rows are located with `Chunker::locateWithOverlap`, so that a row is
+/// assigned to the sub-chunk containing it, and to each sub-chunk whose
+/// overlap region contains it. They are then appended to a per-chunk buffer,
+/// which is passed to a ChunkSink and cleared as soon as it holds more than
+/// a given number of bytes. So at most about that many bytes are buffered
+/// per chunk, and the rows of a chunk reach the sink in order of arrival,
+/// except that the order of rows from batches added concurrently is
+/// unspecified.
+///
+/// Each of `add`, `run` and `flush` may be called from several threads at
+/// once. The sink, which must outlive the partitioner, receives the rows
+/// that remain buffered when `flush` is called; the destructor discards
+/// them.
+class ChunkPartitioner {
+public:
+    /// This constructor creates a partitioner that assigns rows to the
+    /// chunks of `chunker`, with sub-chunk overlap regions of width
+    /// `overlap`, and passes them to `sink` in buffers holding about
+    /// `maxChunkBytes` bytes. It throws std::invalid_argument if `overlap`
+    /// is negative or not finite.
+    ChunkPartitioner(Chunker const & chunker,
+                     Angle overlap,
+                     ChunkSink & sink,
+                     size_t maxChunkBytes = 1 << 20);
+
+    ~ChunkPartitioner();
+
+    ChunkPartitioner(ChunkPartitioner const &) = delete;
+    ChunkPartitioner & operator=(ChunkPartitioner const &) = delete;
+
+    ///@{
+    /// `add` partitions a batch of rows. It throws std::invalid_argument
+    /// if a position is invalid (see `Chunker::locate`) or if the payload
+    /// offsets are not non-decreasing, and in that case no row of the batch
+    /// is buffered.
+    void add(CatalogBatch const & batch);
+
+    void add(double const * lon, double const * lat,
+             uint64_t const * offsets, uint8_t const * payload, size_t n);
+    ///@}
+
+    /// `run` partitions the batches produced by `source`, which fills in
+    /// its argument with the next batch and returns true, or returns false
+    /// when there are none left. If `numThreads` is greater than one, the
+    /// batches are processed by a pipeline of that many threads: each thread
+    /// repeatedly obtains a batch from `source`, with calls to `source`
+    /// serialized, and then locates and scatters its rows while other
+    /// threads read further batches. The first exception thrown by the
+    /// source, by `add` or by the sink stops the pipeline, and is rethrown
+    /// once all threads are done.
+    void run(std::function<bool(CatalogBatch &)> const & source,
+             unsigned numThreads = 1);
+
+    /// `flush` passes all buffered rows to the sink.
+    void flush();
+
+    /// `getNumRows` returns the number of rows added so far, and
+    /// `getNumLocations` the number of rows passed or to be passed to the
+    /// sink, which also counts rows in overlap regions.
+    uint64_t getNumRows() const { return _numRows; }
+    uint64_t getNumLocations() const { return _numLocations; }
+
+    Chunker const & getChunker() const { return _chunker; }
+    Angle getOverlap() const { return _overlap; }
+
+private:
+    struct Shard;
+
+    Chunker const _chunker;
+    Angle const _overlap;
+    ChunkSink * _sink;
+    size_t const _maxChunkBytes;
+    std::unique_ptr<Shard[]> _shards;
+    std::atomic<uint64_t> _numRows{0};
+    std::atomic<uint64_t> _numLocations{0};
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_CHUNKPARTITIONER_H_
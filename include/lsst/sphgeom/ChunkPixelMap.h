@@ -0,0 +1,150 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_SPHGEOM_CHUNKPIXELMAP_H_
+#define LSST_SPHGEOM_CHUNKPIXELMAP_H_
+
+/// \file
+/// \brief This file declares a class that maps between the chunks of a
+///        Chunker and the pixels of a Pixelization.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Chunker.h"
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+class Pixelization;
+
+/// A `ChunkPixelMap` holds precomputed tables mapping each chunk of a
+/// Chunker to the pixels of a pixelization (e.g. HTM or MQ3C at some level)
+/// that cover it, and each pixel back to the chunks it overlaps.
+///
+/// Systems that index data by both chunk ID and pixel can use it to select
+/// chunks for a region from the pixel envelope they already have, with
+/// RangeSet operations instead of the bounding box arithmetic and relate
+/// calls made by `Chunker::getChunksIntersecting`, and the two selections
+/// are consistent by construction. Since chunk and region envelopes both
+/// cover their true extents, the chunks selected from a region envelope
+/// include all chunks that intersect the region.
+///
+/// A map is immutable once built, so it can be used from several threads
+/// at once.
+class ChunkPixelMap {
+public:
+    /// This constructor computes the envelope and interior of every chunk
+    /// of `chunker` with `pixelization`. If `numThreads` is greater than
+    /// one, up to that many threads share the work.
+    ChunkPixelMap(Chunker const & chunker,
+                  Pixelization const & pixelization,
+                  unsigned numThreads = 1);
+
+    /// `getChunker` returns the chunker whose chunks are mapped.
+    Chunker const & getChunker() const { return _chunker; }
+
+    /// `getChunkIds` returns the IDs of all chunks, in ascending order.
+    std::vector<int32_t> const & getChunkIds() const { return _chunkIds; }
+
+    /// `size` returns the number of chunks.
+    size_t size() const { return _chunkIds.size(); }
+
+    /// `getEnvelope` returns the pixels intersecting the given chunk. It
+    /// throws std::invalid_argument if the chunk ID is invalid.
+    RangeSet const & getEnvelope(int32_t chunkId) const {
+        return _envelopes[_find(chunkId)];
+    }
+
+    /// `getInterior` returns the pixels contained in the given chunk. It
+    /// throws std::invalid_argument if the chunk ID is invalid.
+    RangeSet const & getInterior(int32_t chunkId) const {
+        return _interiors[_find(chunkId)];
+    }
+
+    /// `getChunks` returns the IDs of the chunks whose envelopes contain
+    /// the given pixel, in ascending order. A pixel in the interior of a
+    /// chunk is mapped to that chunk alone.
+    std::vector<int32_t> getChunks(uint64_t pixel) const;
+
+    /// `getChunksIntersecting` returns the IDs of the chunks whose
+    /// envelopes intersect `envelope`, in ascending order. Given the
+    /// envelope of a region, these are the chunks potentially intersecting
+    /// it.
+    std::vector<int32_t> getChunksIntersecting(RangeSet const & envelope) const;
+
+    /// `classifyChunks` returns the chunks whose envelopes intersect
+    /// `envelope`, in ascending order of chunk ID, tagging each with
+    /// CONTAINS if `interior` contains its envelope, and with INTERSECTS
+    /// otherwise. Given the envelope and interior of a region, chunks
+    /// tagged with CONTAINS are entirely inside it.
+    std::vector<ClassifiedChunk> classifyChunks(
+        RangeSet const & envelope, RangeSet const & interior) const;
+
+private:
+    Chunker _chunker;
+    std::vector<int32_t> _chunkIds;
+    std::vector<RangeSet> _envelopes;
+    std::vector<RangeSet> _interiors;
+
+    // A `ChunkLists` object holds a sorted list of chunk indexes (into
+    // `_chunkIds`) for each of a sequence of items. The list of item i is
+    // `chunks[offsets[i]]` through `chunks[offsets[i + 1] - 1]`.
+    struct ChunkLists {
+        std::vector<size_t> offsets = {0};
+        std::vector<uint32_t> chunks;
+
+        size_t size() const { return offsets.size() - 1; }
+
+        // `appendTo` appends the list of item i to v.
+        void appendTo(std::vector<uint32_t> & v, size_t i) const {
+            v.insert(v.end(), chunks.begin() + offsets[i],
+                     chunks.begin() + offsets[i + 1]);
+        }
+    };
+
+    // The reverse table divides the pixels into segments of consecutive
+    // pixels that overlap the same chunks. Segment i starts at pixel
+    // `_segmentBegins[i]` and ends where segment i + 1 starts, and
+    // `_segments` lists the chunks each segment overlaps.
+    std::vector<uint64_t> _segmentBegins;
+    ChunkLists _segments;
+
+    // Large regions can span many segments, so the chunks overlapping
+    // aligned blocks of segments are listed as well. Element i of
+    // `_blocks[j]` lists the chunks overlapping segments
+    // [i * B^(j + 1), (i + 1) * B^(j + 1)), where B is a fixed fan-out.
+    std::vector<ChunkLists> _blocks;
+
+    // `_find` returns the index of the given chunk in `_chunkIds`.
+    size_t _find(int32_t chunkId) const;
+
+    // `_findIntersecting` returns the indexes of the chunks whose
+    // envelopes intersect s, in ascending order.
+    std::vector<uint32_t> _findIntersecting(RangeSet const & s) const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_CHUNKPIXELMAP_H_
@@ -28,10 +28,16 @@
 ///        and sub-chunks.
 
 #include <stdint.h>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
 #include <vector>
 
 #include "Angle.h"
 #include "Box.h"
+#include "LonLat.h"
+#include "Relationship.h"
 
 
 namespace lsst {
@@ -53,6 +59,67 @@ struct SubChunks {
 };
 
 
+/// `ClassifiedChunk` is the ID of a chunk intersecting a region, tagged
+/// with CONTAINS if the region contains the entire chunk, and with
+/// INTERSECTS otherwise. The rows of a contained chunk need no further
+/// spatial filtering.
+struct ClassifiedChunk {
+    int32_t chunkId;
+    Relationship relationship;
+};
+
+/// `ClassifiedSubChunks` represents the sub-chunks of a particular chunk
+/// that intersect a region. The chunk, and each sub-chunk, is tagged with
+/// CONTAINS if the region contains it entirely, and with INTERSECTS
+/// otherwise. `subChunkRelationships[i]` is the tag of `subChunkIds[i]`.
+struct ClassifiedSubChunks {
+    int32_t chunkId;
+    Relationship relationship;
+    std::vector<int32_t> subChunkIds;
+    std::vector<Relationship> subChunkRelationships;
+
+    ClassifiedSubChunks() : chunkId(-1) {}
+};
+
+/// `ChunkLocations` is a columnar buffer of point locations, filled in by
+/// `Chunker::locateWithOverlap`. Row i records that the point with index
+/// `pointIndex[i]` belongs to sub-chunk `subChunkId[i]` of chunk
+/// `chunkId[i]`. That sub-chunk is the one containing the point if
+/// `isOverlap[i]` is zero, and one whose overlap region contains the
+/// point otherwise.
+struct ChunkLocations {
+    std::vector<size_t> pointIndex;
+    std::vector<int32_t> chunkId;
+    std::vector<int32_t> subChunkId;
+    std::vector<uint8_t> isOverlap;
+
+    bool empty() const { return pointIndex.empty(); }
+
+    /// `size` returns the number of rows in this buffer.
+    size_t size() const { return pointIndex.size(); }
+
+    void clear() {
+        pointIndex.clear();
+        chunkId.clear();
+        subChunkId.clear();
+        isOverlap.clear();
+    }
+
+    void reserve(size_t n) {
+        pointIndex.reserve(n);
+        chunkId.reserve(n);
+        subChunkId.reserve(n);
+        isOverlap.reserve(n);
+    }
+
+    void push_back(size_t i, int32_t c, int32_t sc, bool overlap) {
+        pointIndex.push_back(i);
+        chunkId.push_back(c);
+        subChunkId.push_back(sc);
+        isOverlap.push_back(overlap ? 1 : 0);
+    }
+};
+
 /// `Chunker` subdivides the unit sphere into longitude-latitude boxes.
 ///
 /// The unit sphere is divided into latitude angle "stripes" of fixed
@@ -63,10 +130,26 @@ struct SubChunks {
 /// subchunks - each stripe is broken into a configureable number of
 /// equal-height "substripes", and each substripe is broken into equal-width
 /// subchunks.
+///
+/// Chunk and sub-chunk bounding boxes can optionally be looked up in a
+/// table rather than computed on every call. The table is filled in one
+/// stripe at a time, on first use, until its size reaches a limit given
+/// at construction. Stripes that do not fit are never stored, and their
+/// bounding boxes are computed on demand as usual. Lookups are lock-free,
+/// and copies of a chunker share its table. A chunker is otherwise immutable,
+/// so it can be used from several threads at once.
 class Chunker {
 public:
+    class BoxIterator;
+    class BoxRange;
+
+    /// This constructor creates a chunker with the given number of stripes
+    /// and sub-stripes per stripe. If `maxBoxTableBytes` is positive,
+    /// chunk and sub-chunk bounding boxes are stored in a table that holds
+    /// at most that many bytes of boxes.
     Chunker(int32_t numStripes,
-            int32_t numSubStripesPerStripe);
+            int32_t numSubStripesPerStripe,
+            size_t maxBoxTableBytes = 0);
 
     bool operator==(Chunker const & c) const {
         return _numStripes == c._numStripes &&
@@ -96,7 +179,78 @@ public:
 
     /// `getSubChunksIntersecting` returns all the sub-chunks that potentially
     /// intersect the given region.
-    std::vector<SubChunks> getSubChunksIntersecting(Region const & r) const;
+    ///
+    /// If `numThreads` is greater than one, up to that many threads are used
+    /// to process the stripes intersecting the region. This does not change
+    /// the result, but requires that `r` can be used concurrently from
+    /// multiple threads, as is the case for all regions in this library.
+    std::vector<SubChunks> getSubChunksIntersecting(Region const & r,
+                                                    unsigned numThreads = 1) const;
+
+    /// `classifyChunks` returns the chunks that potentially intersect the
+    /// given region, in the order of `getChunksIntersecting`, and tags each
+    /// with CONTAINS if the region contains it, or INTERSECTS otherwise.
+    /// Both follow from the single relate call made per candidate chunk.
+    std::vector<ClassifiedChunk> classifyChunks(Region const & r) const;
+
+    /// `classifySubChunks` returns the sub-chunks that potentially intersect
+    /// the given region, like `getSubChunksIntersecting`, and tags each
+    /// chunk and sub-chunk with CONTAINS or INTERSECTS as `classifyChunks`
+    /// does. All sub-chunks of a contained chunk are contained, and are
+    /// not related to the region individually. `numThreads` is as for
+    /// `getSubChunksIntersecting`.
+    std::vector<ClassifiedSubChunks> classifySubChunks(
+        Region const & r, unsigned numThreads = 1) const;
+
+    /// `locate` returns the IDs of the chunk and sub-chunk containing the
+    /// given point. Points on a boundary between chunks or sub-chunks are
+    /// generally assigned to the one with the larger latitude or longitude.
+    std::pair<int32_t, int32_t> locate(LonLat const & p) const;
+
+    /// `locate` stores the IDs of the chunk and sub-chunk containing the
+    /// point with the i-th longitude and latitude (in radians) in `chunk[i]`
+    /// and `subChunk[i]`, for i in [0, n). It throws std::invalid_argument
+    /// if a longitude is not finite or a latitude is outside [-π/2, π/2].
+    void locate(double const * lon, double const * lat,
+                int32_t * chunk, int32_t * subChunk, size_t n) const;
+
+    /// `locateWithOverlap` appends rows to `out` for each of the `n` points
+    /// with the given longitudes and latitudes (in radians). The first row
+    /// for point i is its location as given by `locate`. It is followed by
+    /// a row for every other sub-chunk whose bounding box, dilated by
+    /// `overlap`, contains the point. Rows are appended in order of point
+    /// index, so that `out` can be drained and cleared between batches of
+    /// points in a stream.
+    ///
+    /// Invalid coordinates are rejected as by `locate`, and a negative or
+    /// non-finite `overlap` causes std::invalid_argument to be thrown.
+    void locateWithOverlap(double const * lon, double const * lat, size_t n,
+                           Angle overlap, ChunkLocations & out) const;
+
+    /// `getNeighborChunks` returns the IDs of the chunks, other than the
+    /// given one, whose bounding boxes intersect the bounding box of the
+    /// given chunk dilated by `overlap`, in ascending order. The result is
+    /// the same as that of `getChunksIntersecting` for the dilated box, less
+    /// the given chunk, but candidates are found directly from the stripe
+    /// geometry.
+    ///
+    /// A std::invalid_argument is thrown if the chunk ID is invalid, or if
+    /// `overlap` is negative or not finite.
+    std::vector<int32_t> getNeighborChunks(int32_t chunkId,
+                                           Angle overlap) const;
+
+    /// `getNeighborSubChunks` returns the sub-chunks, other than the given
+    /// one, whose bounding boxes intersect the bounding box of the given
+    /// sub-chunk dilated by `overlap`. Chunks are listed in ascending order
+    /// of chunk ID, and the sub-chunks of each in ascending order of
+    /// sub-chunk ID. The sub-chunks are those `getSubChunksIntersecting`
+    /// returns for the dilated box, less the given sub-chunk.
+    ///
+    /// A std::invalid_argument is thrown if the chunk or sub-chunk ID is
+    /// invalid, or if `overlap` is negative or not finite.
+    std::vector<SubChunks> getNeighborSubChunks(int32_t chunkId,
+                                                int32_t subChunkId,
+                                                Angle overlap) const;
 
     /// `getAllChunks` returns the complete set of chunk IDs for the unit
     /// sphere.
@@ -112,6 +266,14 @@ public:
     Box getChunkBoundingBox(int32_t stripe, int32_t chunk) const;
     Box getSubChunkBoundingBox(int32_t subStripe, int32_t subChunk) const;
 
+    /// `getChunkBoundingBoxes` returns the bounding boxes of the chunks in
+    /// the given stripe, in order of chunk number.
+    BoxRange getChunkBoundingBoxes(int32_t stripe) const;
+
+    /// `getSubChunkBoundingBoxes` returns the bounding boxes of the
+    /// sub-chunks in the given sub-stripe, in order of sub-chunk number.
+    BoxRange getSubChunkBoundingBoxes(int32_t subStripe) const;
+
     /// Return the stripe for the specified chunkId
     int32_t getStripe(int32_t chunkId) const {
         return chunkId / (2 * _numStripes);
@@ -123,6 +285,9 @@ public:
     }
 
 private:
+    struct BoxTable;
+    struct StripeBoxes;
+
     struct Stripe {
         Angle chunkWidth;
         int32_t numChunksPerStripe;
@@ -154,7 +319,35 @@ private:
         return y * _maxSubChunksPerSubStripeChunk + x;
     }
 
-    void _getSubChunks(std::vector<SubChunks> & subChunks,
+    void _locate(double lon, double lat,
+                 int32_t & chunkId, int32_t & subChunkId) const;
+
+    Box _computeChunkBoundingBox(int32_t stripe, int32_t chunk) const;
+    Box _computeSubChunkBoundingBox(int32_t subStripe, int32_t subChunk) const;
+
+    // `_getStripeBoxes` returns the stored bounding boxes for the given
+    // stripe, or null if they are not stored.
+    StripeBoxes const * _getStripeBoxes(int32_t stripe) const;
+
+    // `_findChunks` and `_findSubChunks` implement the chunk and sub-chunk
+    // searches for both plain and classified results.
+    template <typename Chunk>
+    std::vector<Chunk> _findChunks(Region const & r) const;
+
+    template <typename Chunks>
+    std::vector<Chunks> _findSubChunks(Region const & r,
+                                       unsigned numThreads) const;
+
+    template <typename Chunks>
+    void _getSubChunksInStripe(std::vector<Chunks> & subChunks,
+                               Region const & r,
+                               NormalizedAngleInterval const & lon,
+                               int32_t stripe,
+                               int32_t minSS,
+                               int32_t maxSS) const;
+
+    template <typename Chunks>
+    void _getSubChunks(std::vector<Chunks> & subChunks,
                        Region const & r,
                        NormalizedAngleInterval const & lon,
                        int32_t stripe,
@@ -169,6 +362,68 @@ private:
     Angle _subStripeHeight;
     std::vector<Stripe> _stripes;
     std::vector<SubStripe> _subStripes;
+    std::shared_ptr<BoxTable> _boxTable;
+};
+
+/// A `Chunker::BoxIterator` iterates over the chunk or sub-chunk bounding
+/// boxes of a stripe or sub-stripe. Boxes are read from the bounding box
+/// table of the chunker when it holds them, and computed otherwise.
+class Chunker::BoxIterator {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Box;
+    using difference_type = ptrdiff_t;
+    using pointer = Box const *;
+    using reference = Box;
+
+    BoxIterator() = default;
+
+    Box operator*() const {
+        if (_boxes != nullptr) {
+            return _boxes[_i];
+        }
+        return _subChunks ? _chunker->_computeSubChunkBoundingBox(_y, _i)
+                          : _chunker->_computeChunkBoundingBox(_y, _i);
+    }
+
+    BoxIterator & operator++() { ++_i; return *this; }
+    BoxIterator operator++(int) { BoxIterator i = *this; ++_i; return i; }
+
+    bool operator==(BoxIterator const & i) const { return _i == i._i; }
+    bool operator!=(BoxIterator const & i) const { return _i != i._i; }
+
+private:
+    friend class Chunker;
+
+    BoxIterator(Chunker const * chunker, Box const * boxes,
+                int32_t y, int32_t i, bool subChunks) :
+        _chunker(chunker), _boxes(boxes), _y(y), _i(i), _subChunks(subChunks)
+    {}
+
+    Chunker const * _chunker = nullptr;
+    Box const * _boxes = nullptr;
+    int32_t _y = 0;
+    int32_t _i = 0;
+    bool _subChunks = false;
+};
+
+/// A `Chunker::BoxRange` is the sequence of chunk or sub-chunk bounding
+/// boxes of a stripe or sub-stripe.
+class Chunker::BoxRange {
+public:
+    BoxIterator begin() const { return _begin; }
+    BoxIterator end() const { return _end; }
+    size_t size() const { return static_cast<size_t>(_end._i - _begin._i); }
+
+private:
+    friend class Chunker;
+
+    BoxRange(BoxIterator const & begin, BoxIterator const & end) :
+        _begin(begin), _end(end)
+    {}
+
+    BoxIterator _begin;
+    BoxIterator _end;
 };
 
 }} // namespace lsst::sphgeom
@@ -47,6 +47,9 @@ class Circle : public Region {
 public:
     static constexpr uint8_t TYPE_CODE = 'c';
 
+    /// The type code of the compact encoding produced by encodeCompact.
+    static constexpr uint8_t COMPACT_TYPE_CODE = 'C';
+
     static Circle empty() { return Circle(); }
 
     static Circle full() { return Circle(UnitVector3d::Z(), 4.0); }
@@ -216,6 +219,20 @@ public:
     /// `complemented` returns the closure of the complement of this circle.
     Circle complemented() const { return Circle(*this).complement(); }
 
+    ///@{
+    /// `toOuterPolygon` returns a regular convex polygon with `n` vertices
+    /// that contains this circle, and `toInnerPolygon` one contained in it.
+    /// The polygons are padded to cover rounding errors. Unlike those of
+    /// Ellipse, they are not cached, as circles are small value types.
+    ///
+    /// Both throw std::invalid_argument if n < 3, or if this circle is
+    /// empty or has an opening angle of 0.45π or more. `toInnerPolygon`
+    /// also throws if this circle is too small to contain a polygon
+    /// reliably.
+    ConvexPolygon toOuterPolygon(int n = 16) const;
+    ConvexPolygon toInnerPolygon(int n = 16) const;
+    ///@}
+
     Relationship relate(UnitVector3d const & v) const;
 
     // Region interface
@@ -232,8 +249,22 @@ public:
                (v - _center).getSquaredNorm() <= _squaredChordLength;
     }
 
+    /// `contains` tests whether each of the `n` points (x[i], y[i], z[i]),
+    /// which need not be normalized, is inside this circle, and stores the
+    /// results in `out`. The results are identical to those of
+    /// `contains(UnitVector3d(x[i], y[i], z[i]))`, but points are normalized
+    /// several at a time and tested without virtual calls.
+    void contains(double const * x, double const * y, double const * z,
+                  bool * out, size_t n) const override;
+
     using Region::contains;
 
+    /// `sample` draws points uniformly from this circle without rejection,
+    /// by inverting the distribution of their distance from the center. It
+    /// throws std::invalid_argument if this circle is empty.
+    void sample(size_t n, std::mt19937_64 & rng,
+                double * x, double * y, double * z) const override;
+
     Relationship relate(Region const & r) const override {
         // Dispatch on the type of r.
         return invert(r.relate(*this));
@@ -245,9 +276,17 @@ public:
     Relationship relate(Ellipse const &) const override;
 
     std::vector<uint8_t> encode() const override;
+    void encodeTo(std::vector<uint8_t> & buffer) const override;
+
+    /// `encodeCompactTo` appends a 14 byte encoding of this circle to
+    /// `buffer`. The center is quantized to within 4e-10 radians, and the
+    /// opening angle is enlarged by that amount and then rounded up to single
+    /// precision, so that the decoded circle contains this one.
+    void encodeCompactTo(std::vector<uint8_t> & buffer) const override;
 
     ///@{
-    /// `decode` deserializes a Circle from a byte string produced by encode.
+    /// `decode` deserializes a Circle from a byte string produced by encode
+    /// or encodeCompact.
     static std::unique_ptr<Circle> decode(std::vector<uint8_t> const & s) {
         return decode(s.data(), s.size());
     }
@@ -255,7 +294,14 @@ public:
     ///@}
 
 private:
+    friend class DecodedRegion;
+
     static constexpr size_t ENCODED_SIZE = 41;
+    static constexpr size_t COMPACT_ENCODED_SIZE = 14;
+
+    // `_decode` overwrites this circle with one deserialized from a byte
+    // string produced by encode.
+    void _decode(uint8_t const * buffer, size_t n);
 
     UnitVector3d _center;
     double _squaredChordLength;
@@ -27,10 +27,16 @@
 /// \brief This file declares classes for representing compound
 ///        regions on the unit sphere.
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <iterator>
-#include <array>
+#include <memory>
+#include <vector>
 
+#include "BoundsCache.h"
+#include "Box3d.h"
 #include "Region.h"
 #include "UnitVector3d.h"
 
@@ -44,15 +50,24 @@ class Ellipse;
 
 /// CompoundRegion is an intermediate base class for spherical regions that are
 /// comprised of a point-set operation on other nested regions.
+///
+/// A compound region may have any number of operands. Operands that are
+/// themselves compound regions of the same type are flattened into their
+/// parent on construction, so that e.g. the union of many regions built up
+/// one operand at a time is stored as a single level. The 3-D bounding box
+/// of each operand is computed on construction, and used to avoid testing
+/// points and regions against operands they cannot interact with. Operands
+/// are evaluated in order of increasing cost per unit of selectivity (see
+/// Region::getCostHint), which never changes the results, and evaluation
+/// stops as soon as the result is known.
+///
+/// Operands are immutable and held by shared pointers, so copying a compound
+/// region, or building one from the operands of another, never copies the
+/// operand regions themselves. Regions passed to the constructors that take
+/// shared ownership must not be modified afterwards.
 class CompoundRegion : public Region {
 public:
-    //@{
-    /// Construct by copying or taking ownership of operands.
-    CompoundRegion(Region const &first, Region const &second);
-    explicit CompoundRegion(std::array<std::unique_ptr<Region>, 2> operands) noexcept;
-    //@}
-
-    CompoundRegion(CompoundRegion const &);
+    CompoundRegion(CompoundRegion const &) = default;
     CompoundRegion(CompoundRegion &&) noexcept = default;
 
     // Disable assignment (including for subclasses) because it makes it hard
@@ -60,12 +75,22 @@ public:
     CompoundRegion &operator=(CompoundRegion const &) = delete;
     CompoundRegion &operator=(CompoundRegion &&) = delete;
 
+    /// `nOperands` returns the number of operands.
+    std::size_t nOperands() const { return _operands.size(); }
+
     // Return references to the operands.
     Region const & getOperand(std::size_t n) const {
         return *_operands[n];
     }
 
+    /// `getOperandPtr` returns a pointer sharing ownership of the n-th
+    /// operand, which can be used to build other compound regions.
+    std::shared_ptr<Region const> const & getOperandPtr(std::size_t n) const {
+        return _operands[n];
+    }
+
     // Region interface.
+    double getCostHint() const override { return _cost; }
     virtual Relationship relate(Region const &r) const = 0; // still unimplemented; avoid shadowing
     Relationship relate(Box const &b) const override;
     Relationship relate(Circle const &c) const override;
@@ -82,16 +107,66 @@ public:
     ///@}
 
 protected:
+    // Construct by sharing ownership of operands, which must not be null.
+    // Flattening of nested operands is performed by the subclass
+    // constructors (see _flatten).
+    explicit CompoundRegion(std::vector<std::shared_ptr<Region const>> operands);
+
+    // Bounding primitives of the compound region, computed on first use by
+    // the subclass implementations of the Region bounding functions.
+    BoundsCache _bounds;
+
+    // Return the 3-D bounding box of the n-th operand.
+    Box3d const & _getOperandBoundingBox3d(std::size_t n) const {
+        return _operandBoxes[n];
+    }
+
+    // Return the index of the k-th operand in evaluation order.
+    std::size_t _getEvaluationIndex(std::size_t k) const { return _order[k]; }
+
+    // Implementation helper for the subclass constructors, which sets the
+    // evaluation order of the operands. Operands are evaluated in order of
+    // increasing cost per unit of selectivity, where the selectivity of an
+    // operand is the area of its bounding circle for a union (where an
+    // operand is useful when it contains a point), or the area outside of
+    // it for an intersection (where an operand is useful when it rejects a
+    // point).
+    void _orderOperands(bool isUnion);
 
-    // Implementation helper for encode().
-    std::vector<std::uint8_t> _encode(std::uint8_t tc) const;
+    // Implementation helpers for relate(); return true if the cached bounds
+    // of this region or of its n-th operand prove that it is disjoint from
+    // a region with 3-D bounding box rb.
+    bool _boundsDisjointFrom(Box3d const &rb) const;
+    bool _operandDisjointFrom(std::size_t n, Box3d const &rb) const;
 
-    // Implementation helper for decode().
-    static std::array<std::unique_ptr<Region>, 2> _decode(
-        std::uint8_t tc, std::uint8_t const *buffer, std::size_t nBytes);
+    // Implementation helper for the subclass constructors, which replaces
+    // every operand of type T with the (shared) operands of that operand.
+    template <typename T>
+    static std::vector<std::shared_ptr<Region const>> _flatten(
+        std::vector<std::shared_ptr<Region const>> operands);
+
+    // Implementation helper for the subclass constructors, which converts
+    // uniquely owned operands to shared ones.
+    static std::vector<std::shared_ptr<Region const>> _share(
+        std::vector<std::unique_ptr<Region>> operands);
+
+    // Implementation helper for the encoding functions, which appends the
+    // encoding of this region to buffer, using the compact encodings of the
+    // operands if compact is true.
+    void _encode(std::uint8_t tc, std::vector<std::uint8_t> &buffer, bool compact = false) const;
+
+    // Implementation helper for decode(), which accepts both the current
+    // encoding (type code tc) and the legacy binary encoding (type code
+    // legacyTc).
+    static std::vector<std::unique_ptr<Region>> _decode(
+        std::uint8_t tc, std::uint8_t legacyTc,
+        std::uint8_t const *buffer, std::size_t nBytes);
 
 private:
-    std::array<std::unique_ptr<Region>, 2> _operands;
+    std::vector<std::shared_ptr<Region const>> _operands;
+    std::vector<Box3d> _operandBoxes;
+    std::vector<std::size_t> _order;
+    double _cost = 0.0;
 };
 
 /// UnionRegion is a lazy point-set union of its operands.
@@ -100,9 +175,23 @@ private:
 /// nested operand regions and combining the results.
 class UnionRegion : public CompoundRegion {
 public:
-    static constexpr uint8_t TYPE_CODE = 'u';
+    static constexpr uint8_t TYPE_CODE = 'U';
+
+    /// The type code of the legacy binary encoding, in which a compound
+    /// region always has two operands. Such encodings can still be decoded.
+    static constexpr uint8_t LEGACY_TYPE_CODE = 'u';
 
-    using CompoundRegion::CompoundRegion;
+    //@{
+    /// Construct by copying, taking ownership of, or sharing ownership of
+    /// operands. Operands that are themselves UnionRegions are replaced by
+    /// their operands, which are shared rather than copied.
+    UnionRegion(Region const &first, Region const &second);
+    UnionRegion(std::shared_ptr<Region const> first,
+                   std::shared_ptr<Region const> second);
+    explicit UnionRegion(std::array<std::unique_ptr<Region>, 2> operands);
+    explicit UnionRegion(std::vector<std::unique_ptr<Region>> operands);
+    explicit UnionRegion(std::vector<std::shared_ptr<Region const>> operands);
+    //@}
 
     // Region interface.
     std::unique_ptr<Region> clone() const override { return std::make_unique<UnionRegion>(*this); }
@@ -112,7 +201,18 @@ public:
     using Region::contains;
     bool contains(UnitVector3d const &v) const override;
     Relationship relate(Region const &r) const override;
-    std::vector<uint8_t> encode() const override { return _encode(TYPE_CODE); }
+    std::vector<uint8_t> encode() const override {
+        std::vector<uint8_t> buffer;
+        _encode(TYPE_CODE, buffer);
+        return buffer;
+    }
+    void encodeTo(std::vector<uint8_t> & buffer) const override {
+        _encode(TYPE_CODE, buffer);
+    }
+    // Operands are encoded with their compact encodings.
+    void encodeCompactTo(std::vector<uint8_t> & buffer) const override {
+        _encode(TYPE_CODE, buffer, true);
+    }
 
     ///@{
     /// `decode` deserializes a UnionRegion from a byte string produced by
@@ -121,7 +221,8 @@ public:
         return decode(s.data(), s.size());
     }
     static std::unique_ptr<UnionRegion> decode(uint8_t const *buffer, size_t n) {
-        return std::make_unique<UnionRegion>(_decode(TYPE_CODE, buffer, n));
+        return std::make_unique<UnionRegion>(
+            _decode(TYPE_CODE, LEGACY_TYPE_CODE, buffer, n));
     }
     ///@}
 
@@ -133,9 +234,23 @@ public:
 /// its nested operand regions and combining the results.
 class IntersectionRegion : public CompoundRegion {
 public:
-    static constexpr uint8_t TYPE_CODE = 'i';
+    static constexpr uint8_t TYPE_CODE = 'I';
+
+    /// The type code of the legacy binary encoding, in which a compound
+    /// region always has two operands. Such encodings can still be decoded.
+    static constexpr uint8_t LEGACY_TYPE_CODE = 'i';
 
-    using CompoundRegion::CompoundRegion;
+    //@{
+    /// Construct by copying, taking ownership of, or sharing ownership of
+    /// operands. Operands that are themselves IntersectionRegions are replaced by
+    /// their operands, which are shared rather than copied.
+    IntersectionRegion(Region const &first, Region const &second);
+    IntersectionRegion(std::shared_ptr<Region const> first,
+                          std::shared_ptr<Region const> second);
+    explicit IntersectionRegion(std::array<std::unique_ptr<Region>, 2> operands);
+    explicit IntersectionRegion(std::vector<std::unique_ptr<Region>> operands);
+    explicit IntersectionRegion(std::vector<std::shared_ptr<Region const>> operands);
+    //@}
 
     // Region interface.
     std::unique_ptr<Region> clone() const override { return std::make_unique<IntersectionRegion>(*this); }
@@ -145,7 +260,18 @@ public:
     using Region::contains;
     bool contains(UnitVector3d const &v) const override;
     Relationship relate(Region const &r) const override;
-    std::vector<uint8_t> encode() const override { return _encode(TYPE_CODE); }
+    std::vector<uint8_t> encode() const override {
+        std::vector<uint8_t> buffer;
+        _encode(TYPE_CODE, buffer);
+        return buffer;
+    }
+    void encodeTo(std::vector<uint8_t> & buffer) const override {
+        _encode(TYPE_CODE, buffer);
+    }
+    // Operands are encoded with their compact encodings.
+    void encodeCompactTo(std::vector<uint8_t> & buffer) const override {
+        _encode(TYPE_CODE, buffer, true);
+    }
 
     ///@{
     /// `decode` deserializes a IntersetionRegion from a byte string produced
@@ -154,7 +280,8 @@ public:
         return decode(s.data(), s.size());
     }
     static std::unique_ptr<IntersectionRegion> decode(uint8_t const *buffer, size_t n) {
-        return std::make_unique<IntersectionRegion>(_decode(TYPE_CODE, buffer, n));
+        return std::make_unique<IntersectionRegion>(
+            _decode(TYPE_CODE, LEGACY_TYPE_CODE, buffer, n));
     }
     ///@}
 
@@ -27,10 +27,14 @@
 /// \brief This file declares a class for representing convex
 ///        polygons with great circle edges on the unit sphere.
 
+#include <atomic>
 #include <iosfwd>
 #include <vector>
 
+#include "Angle.h"
+#include "BoundsCache.h"
 #include "Region.h"
+#include "SmallVector.h"
 #include "UnitVector3d.h"
 
 
@@ -52,23 +56,55 @@ namespace sphgeom {
 /// polygon, but means e.g. that hemispheres and lunes cannot be represented
 /// by convex polygons.
 ///
-/// Currently, the only way to construct a convex polygon is to compute the
-/// convex hull of a point set.
+/// Convex polygons are usually constructed by computing the convex hull of
+/// a point set. Callers that already hold valid vertices can skip that
+/// computation with `fromTrustedVertices`.
 class ConvexPolygon : public Region {
 public:
     static constexpr uint8_t TYPE_CODE = 'p';
 
+    /// The type code of the compact encoding produced by encodeCompact.
+    static constexpr uint8_t COMPACT_TYPE_CODE = 'P';
+
+    /// `VertexVector` is the type of the vertex container of a polygon.
+    /// Polygons with up to 8 vertices, which includes all pixelization
+    /// pixels, store their vertices inline, and so can be created and
+    /// copied without heap allocation.
+    using VertexVector = SmallVector<UnitVector3d, 8>;
+
     /// `convexHull` returns the convex hull of the given set of points if it
     /// exists and throws an exception otherwise. Though points are supplied
     /// in a vector, they really are conceptually a set - the ConvexPolygon
     /// returned is invariant under permutation of the input array.
-    static ConvexPolygon convexHull(std::vector<UnitVector3d> const & points) {
-        return ConvexPolygon(points);
+    ///
+    /// Large point sets lying in an open hemisphere are handled in
+    /// O(n log n) time. If `numThreads` is greater than one, up to that many
+    /// threads are used to discard points that are obviously interior to
+    /// the hull. This does not change the result.
+    static ConvexPolygon convexHull(std::vector<UnitVector3d> const & points,
+                                    unsigned numThreads = 1) {
+        return ConvexPolygon(points, numThreads);
     }
 
+    ///@{
+    /// `fromTrustedVertices` returns the convex polygon with the given
+    /// vertices, which must already satisfy the invariants described above,
+    /// in counter-clockwise order - for example, the vertices of another
+    /// polygon. The convex hull computation is skipped, and the storage of
+    /// a vertex vector passed as an rvalue is taken over rather than copied.
+    ///
+    /// Builds without NDEBUG verify the vertices, and throw
+    /// std::invalid_argument if they are invalid. Use with caution - for
+    /// performance reasons, this is not verified otherwise!
+    static ConvexPolygon fromTrustedVertices(std::vector<UnitVector3d> vertices);
+    static ConvexPolygon fromTrustedVertices(UnitVector3d const * vertices,
+                                             size_t n);
+    ///@}
+
     /// This constructor creates a convex polygon that is the convex hull of
-    /// the given set of points.
-    explicit ConvexPolygon(std::vector<UnitVector3d> const & points);
+    /// the given set of points; see `convexHull`.
+    explicit ConvexPolygon(std::vector<UnitVector3d> const & points,
+                           unsigned numThreads = 1);
 
     /// This constructor creates a triangle with the given vertices.
     ///
@@ -92,11 +128,17 @@ public:
         _vertices{v0, v1, v2, v3}
     {}
 
+    ConvexPolygon(ConvexPolygon const & p);
+    ConvexPolygon(ConvexPolygon && p) noexcept;
+    ConvexPolygon & operator=(ConvexPolygon const & p);
+    ConvexPolygon & operator=(ConvexPolygon && p) noexcept;
+    ~ConvexPolygon() override;
+
     /// Two convex polygons are equal iff they contain the same points.
     bool operator==(ConvexPolygon const & p) const;
     bool operator!=(ConvexPolygon const & p) const { return !(*this == p); }
 
-    std::vector<UnitVector3d> const & getVertices() const {
+    VertexVector const & getVertices() const {
         return _vertices;
     }
 
@@ -104,14 +146,58 @@ public:
     /// S², assuming a uniform mass distribution over the polygon surface.
     UnitVector3d getCentroid() const;
 
+    /// `getArea` returns the area of this polygon in steradians.
+    double getArea() const;
+
+    ///@{
+    /// `simplifiedInner` returns a polygon with at most `maxVertices`
+    /// vertices that is contained in this polygon. It is the convex hull of
+    /// a subset of the vertices of this polygon, obtained by repeatedly
+    /// removing the vertex that cuts off the smallest triangle.
+    ///
+    /// `simplifiedOuter` returns a polygon with at most `maxVertices`
+    /// vertices that contains this polygon, obtained by repeatedly removing
+    /// the edge whose neighbors, extended until they meet, add the smallest
+    /// triangle. Edges can only be removed if their neighbors converge, so
+    /// the result may have more than `maxVertices` vertices. If rounding
+    /// error would make the result fail to contain this polygon, this
+    /// polygon is returned instead.
+    ///
+    /// Both return this polygon if it has at most `maxVertices` vertices,
+    /// and throw std::invalid_argument if `maxVertices` is less than 3.
+    /// They are meant for polygons with many vertices that are related to
+    /// many regions, where a simplified polygon can often settle a
+    /// relationship at a fraction of the cost.
+    ConvexPolygon simplifiedInner(size_t maxVertices) const;
+    ConvexPolygon simplifiedOuter(size_t maxVertices) const;
+    ///@}
+
+    /// `dilatedBy` returns a polygon containing all points within angle r
+    /// of this polygon. Its edges are those of this polygon, moved outward
+    /// by a little more than r, and each corner is rounded off with up to
+    /// four extra edges, so that the result is larger than the exact
+    /// dilation by at most about 8% of r, and has about 8 more vertices
+    /// than this polygon. A zero angle returns this polygon.
+    ///
+    /// \throws std::invalid_argument if r is negative or NaN, or if the
+    ///          dilated polygon would not fit in a hemisphere.
+    ConvexPolygon dilatedBy(Angle r) const;
+
     // Region interface
     std::unique_ptr<Region> clone() const override {
         return std::unique_ptr<ConvexPolygon>(new ConvexPolygon(*this));
     }
 
+    ///@{
+    /// Bounding primitives are computed on first use and cached, so that
+    /// relating a polygon to many regions does not recompute them.
     Box getBoundingBox() const override;
     Box3d getBoundingBox3d() const override;
     Circle getBoundingCircle() const override;
+    double getCostHint() const override {
+        return static_cast<double>(_vertices.size());
+    }
+    ///@}
 
     ///@{
     /// `contains` returns true if the intersection of this convex polygon and x
@@ -120,8 +206,22 @@ public:
     bool contains(Region const & r) const;
     ///@}
 
+    /// `contains` tests whether each of the `n` points (x[i], y[i], z[i]),
+    /// which need not be normalized, is inside this polygon, and stores the
+    /// results in `out`. The results are identical to those of
+    /// `contains(UnitVector3d(x[i], y[i], z[i]))`, but the edge planes are
+    /// only computed once, and points are tested several at a time.
+    void contains(double const * x, double const * y, double const * z,
+                  bool * out, size_t n) const override;
+
     using Region::contains;
 
+    /// `sample` divides this polygon into a fan of triangles, picks
+    /// triangles with probability proportional to their areas, and draws
+    /// points uniformly from the picked triangles.
+    void sample(size_t n, std::mt19937_64 & rng,
+                double * x, double * y, double * z) const override;
+
     ///@{
     /// `isDisjointFrom` returns true if the intersection of this convex polygon
     /// and x is empty.
@@ -151,9 +251,21 @@ public:
     Relationship relate(Ellipse const &) const override;
 
     std::vector<uint8_t> encode() const override;
+    void encodeTo(std::vector<uint8_t> & buffer) const override;
+
+    /// `encodeCompactTo` appends an encoding of this polygon with 9 rather
+    /// than 24 bytes per vertex to `buffer`. Every edge is first moved
+    /// outward by 1e-9 radians, and the vertices of the resulting polygon are
+    /// quantized to within 4e-10 radians. The decoded polygon is verified to
+    /// be convex and to contain this one; if it does not (e.g. for polygons
+    /// with nearly antiparallel adjacent edges), the lossless encoding is
+    /// written instead. A vertex with interior angle θ moves outward by
+    /// roughly 1e-9 / sin(θ/2) radians.
+    void encodeCompactTo(std::vector<uint8_t> & buffer) const override;
 
     ///@{
-    /// `decode` deserializes a ConvexPolygon from a byte string produced by encode.
+    /// `decode` deserializes a ConvexPolygon from a byte string produced by
+    /// encode or encodeCompact.
     static std::unique_ptr<ConvexPolygon> decode(std::vector<uint8_t> const & s) {
         return decode(s.data(), s.size());
     }
@@ -161,11 +273,32 @@ public:
     ///@}
 
 private:
-    typedef std::vector<UnitVector3d>::const_iterator VertexIterator;
+    friend class DecodedRegion;
+
+    typedef VertexVector::const_iterator VertexIterator;
+
+    // Edge plane normals, computed on first use by contains() and relate().
+    struct Edges;
 
     ConvexPolygon() : _vertices() {}
 
-    std::vector<UnitVector3d> _vertices;
+    explicit ConvexPolygon(VertexVector && vertices);
+
+    Edges const & _getEdges() const;
+
+    // `_decode` overwrites this polygon with one deserialized from a byte
+    // string produced by encode, reusing the vertex storage.
+    void _decode(uint8_t const * buffer, size_t n);
+
+    // `_relate` computes circle relationships using cached edge normals.
+    Relationship _relate(Circle const & c) const;
+
+    VertexVector _vertices;
+    BoundsCache _bounds;
+    // The edge normals are published with a single atomic pointer store, so
+    // that lookups are lock-free. Copies start out without edge normals,
+    // which keeps copying allocation free.
+    mutable std::atomic<Edges const *> _edges{nullptr};
 };
 
 std::ostream & operator<<(std::ostream &, ConvexPolygon const &);
@@ -0,0 +1,108 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_DECODEDREGION_H_
+#define LSST_SPHGEOM_DECODEDREGION_H_
+
+/// \file
+/// \brief This file declares a class for decoding regions into reusable
+///        storage.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "Circle.h"
+#include "ConvexPolygon.h"
+#include "Ellipse.h"
+#include "Region.h"
+#include "Relationship.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `DecodedRegion` holds a region deserialized from a byte string
+/// produced by `Region::encode`, in storage owned by the caller and reused
+/// from one decode to the next. This avoids the heap allocation performed
+/// by `Region::decode` when decoding many regions in turn.
+///
+/// Decoding a box, circle or ellipse never allocates memory. Decoding a
+/// polygon only does so if it has more vertices than fit inline, and more
+/// than any polygon previously decoded into the same object. Compound
+/// regions are decoded with `Region::decode`, and so are heap allocated.
+///
+/// A decoded region remains valid until the next call to `decode`, or
+/// until the `DecodedRegion` is destroyed.
+class DecodedRegion {
+public:
+    DecodedRegion() = default;
+
+    DecodedRegion(DecodedRegion const &) = delete;
+    DecodedRegion & operator=(DecodedRegion const &) = delete;
+
+    ///@{
+    /// `decode` deserializes a region from a byte string produced by
+    /// `Region::encode` and returns a reference to it. It throws
+    /// std::runtime_error if the byte string is invalid, in which case
+    /// this object is left empty.
+    Region const & decode(std::vector<uint8_t> const & s) {
+        return decode(s.data(), s.size());
+    }
+    Region const & decode(uint8_t const * buffer, size_t n);
+    ///@}
+
+    bool empty() const { return _region == nullptr; }
+
+    /// `get` returns the most recently decoded region, or null if this
+    /// object is empty.
+    Region const * get() const { return _region; }
+
+    ///@{
+    /// `relate` returns the relationship between the region encoded in a
+    /// byte string and `r`, which is identical to that computed by
+    /// `Region::decode(buffer, n)->relate(r)`. Other than for compound
+    /// regions, no region is allocated, and no cached state is computed for
+    /// the encoded region. It throws std::runtime_error if the byte string
+    /// is invalid.
+    static Relationship relate(std::vector<uint8_t> const & s,
+                               Region const & r) {
+        return relate(s.data(), s.size(), r);
+    }
+    static Relationship relate(uint8_t const * buffer, size_t n,
+                               Region const & r);
+    ///@}
+
+private:
+    Box _box;
+    Circle _circle;
+    ConvexPolygon _polygon;
+    Ellipse _ellipse;
+    std::unique_ptr<Region> _compound;
+    Region const * _region = nullptr;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_DECODEDREGION_H_
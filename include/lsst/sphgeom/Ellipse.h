@@ -27,6 +27,7 @@
 /// \brief This file declares a class for representing elliptical
 ///        regions on the unit sphere.
 
+#include <atomic>
 #include <iosfwd>
 #include <limits>
 
@@ -185,6 +186,12 @@ public:
         _tanb(std::numeric_limits<double>::infinity())
     {}
 
+    Ellipse(Ellipse const &);
+    Ellipse(Ellipse &&) noexcept;
+    Ellipse & operator=(Ellipse const &);
+    Ellipse & operator=(Ellipse &&) noexcept;
+    ~Ellipse() override;
+
     /// This constructor creates an ellipse corresponding to the given circle.
     explicit Ellipse(Circle const & c) {
         *this = Ellipse(c.getCenter(), c.getCenter(), c.getOpeningAngle());
@@ -210,6 +217,28 @@ public:
             Angle beta,
             Angle orientation);
 
+    /// `fromQuadraticForm` returns the ellipse with transform matrix `S`
+    /// (see getTransformMatrix), semi-axis angles α and β, and focal
+    /// half-angle ɣ, given the absolute cotangents |cot α| and |cot β| of the
+    /// semi-axis angles as well. Unlike the other constructors, it performs
+    /// no trigonometric or vector computations, so it is much cheaper when
+    /// many ellipses are created from parameters computed in bulk, or saved
+    /// from existing ellipses (the cotangents being |tan(α - π/2)| and
+    /// |tan(β - π/2)|).
+    ///
+    /// The parameters are only checked as for the center and semi-axis
+    /// constructor: `S` is assumed to be orthogonal, and ɣ and the
+    /// cotangents to be consistent with α and β.
+    ///
+    /// 	hrows std::invalid_argument if an argument is NaN, or if α and β
+    ///         are not both less than, greater than or equal to π/2.
+    static Ellipse fromQuadraticForm(Matrix3d const & S,
+                                     Angle alpha,
+                                     Angle beta,
+                                     Angle gamma,
+                                     double cotAlpha,
+                                     double cotBeta);
+
     bool operator==(Ellipse const & e) const {
         return _S == e._S && _a == e._a && _b == e._b;
     }
@@ -260,6 +289,9 @@ public:
     /// return value is arbitrary for empty and full ellipses.
     Angle getGamma() const { return _gamma; }
 
+    /// `getArea` returns the area of this ellipse in steradians.
+    double getArea() const;
+
     /// `complement` sets this ellipse to the closure of its complement.
     Ellipse & complement() {
         _S = Matrix3d(-_S(0,0), -_S(0,1), -_S(0,2),
@@ -267,12 +299,34 @@ public:
                       -_S(2,0), -_S(2,1), -_S(2,2));
         _a = -_a;
         _b = -_b;
+        _clearPolygons();
         return *this;
     }
 
     /// `complemented` returns the closure of the complement of this ellipse.
     Ellipse complemented() const { return Ellipse(*this).complement(); }
 
+    /// `POLYGON_VERTICES` is the default number of vertices of the polygons
+    /// returned by toOuterPolygon and toInnerPolygon.
+    static constexpr int POLYGON_VERTICES = 16;
+
+    ///@{
+    /// `toOuterPolygon` returns a convex polygon with `n` vertices that
+    /// contains this ellipse, and `toInnerPolygon` a convex polygon with `n`
+    /// vertices contained in it. The polygons are built in the plane tangent
+    /// to the ellipse center, where great circles are straight lines, and
+    /// their semi-axes are padded to cover rounding errors, so that both
+    /// containment guarantees hold. Polygons with POLYGON_VERTICES vertices
+    /// are computed once per ellipse and cached.
+    ///
+    /// Both throw std::invalid_argument if n < 3, or if this ellipse is
+    /// empty or has a semi-major axis angle of 0.45π or more.
+    /// `toInnerPolygon` also throws if this ellipse is too thin to contain
+    /// a polygon reliably.
+    ConvexPolygon toOuterPolygon(int n = POLYGON_VERTICES) const;
+    ConvexPolygon toInnerPolygon(int n = POLYGON_VERTICES) const;
+    ///@}
+
     // Region interface
     std::unique_ptr<Region> clone() const override {
         return std::unique_ptr<Ellipse>(new Ellipse(*this));
@@ -281,11 +335,30 @@ public:
     Box getBoundingBox() const override;
     Box3d getBoundingBox3d() const override;
     Circle getBoundingCircle() const override;
+    double getCostHint() const override { return 2.0; }
 
     bool contains(UnitVector3d const &v) const override;
 
+    /// `contains` tests whether each of the `n` points (x[i], y[i], z[i]),
+    /// which need not be normalized, is inside this ellipse, and stores the
+    /// results in `out`. The results are identical to those of
+    /// `contains(UnitVector3d(x[i], y[i], z[i]))`, but points are normalized
+    /// several at a time and tested without virtual calls.
+    void contains(double const * x, double const * y, double const * z,
+                  bool * out, size_t n) const override;
+
     using Region::contains;
 
+    /// `contains` tests each of the `n` points (x[j], y[j], z[j]) against
+    /// each of the `m` given ellipses, and stores the result for ellipse i
+    /// and point j in `out[i * n + j]`. The results are identical to those
+    /// of `ellipses[i].contains(UnitVector3d(x[j], y[j], z[j]))`, but each
+    /// point is normalized only once, and blocks of points are tested
+    /// against one ellipse at a time.
+    static void contains(Ellipse const * ellipses, size_t m,
+                         double const * x, double const * y, double const * z,
+                         size_t n, bool * out);
+
     Relationship relate(Region const & r) const override {
         // Dispatch on the type of r.
         return invert(r.relate(*this));
@@ -297,6 +370,7 @@ public:
     Relationship relate(Ellipse const &) const override;
 
     std::vector<uint8_t> encode() const override;
+    void encodeTo(std::vector<uint8_t> & buffer) const override;
 
     ///@{
     /// `decode` deserializes an Ellipse from a byte string produced by encode.
@@ -307,14 +381,40 @@ public:
     ///@}
 
 private:
+    friend class DecodedRegion;
+
     static constexpr size_t ENCODED_SIZE = 113;
 
+    // Polygons approximating an elongated ellipse from inside and outside,
+    // computed on first use by relate().
+    struct Polygons;
+
+    Polygons const & _getPolygons() const;
+
+    // `_getPolygon` returns the cached polygon returned by toOuterPolygon
+    // (outer == true) or toInnerPolygon for the default vertex count.
+    ConvexPolygon const & _getPolygon(bool outer) const;
+    void _clearPolygons();
+
+    // `_relateOuter` relates the circumscribing polygon to a circle.
+    Relationship _relateOuter(Circle const & c) const;
+
+    // `_contains` tests whether the unit vector v is inside this ellipse.
+    bool _contains(Vector3d const & v) const;
+
+    // `_decode` overwrites this ellipse with one deserialized from a byte
+    // string produced by encode.
+    void _decode(uint8_t const * buffer, size_t n);
+
     Matrix3d _S;
     Angle _a; // α - π/2
     Angle _b; // β - π/2
     Angle _gamma; // Half the angle between the ellipse foci
     double _tana; // |tan a| = |cot α|
     double _tanb; // |tan b| = |cot β|
+    // The polygons are published with a single atomic pointer store, as for
+    // the edge normals of ConvexPolygon. Copies start out without them.
+    mutable std::atomic<Polygons const *> _polygons{nullptr};
 };
 
 std::ostream & operator<<(std::ostream &, Ellipse const &);
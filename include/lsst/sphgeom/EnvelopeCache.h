@@ -0,0 +1,131 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_ENVELOPECACHE_H_
+#define LSST_SPHGEOM_ENVELOPECACHE_H_
+
+/// \file
+/// \brief This file declares a cache of pixelization envelopes and
+///        interiors.
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Pixelization.h"
+#include "RangeSet.h"
+#include "Region.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// An `EnvelopeCache` memoizes the results of `Pixelization::envelope` and
+/// `Pixelization::interior`. It is meant for services that pixelize the
+/// same popular regions (standard fields, tract polygons) over and over.
+///
+/// Results are keyed on the operation, `Pixelization::getCacheKey`, the
+/// range limit and the encoding of the region (see `Region::encode`). Keys
+/// are stored in full, so that a result is only ever returned for
+/// byte-for-byte identical regions. Results for pixelizations with an
+/// empty cache key are computed but never stored.
+///
+/// The memory used by the keys and results is bounded by the size given on
+/// construction, and the least recently used results are evicted to stay
+/// within it. Results that do not fit at all are not stored.
+///
+/// All member functions are thread-safe. Results are computed outside of
+/// the cache lock, so concurrent misses on the same key may compute the
+/// same result more than once.
+class EnvelopeCache {
+public:
+    /// This constructor creates a cache using at most `maxBytes` bytes of
+    /// memory. It throws std::invalid_argument if `maxBytes` is zero.
+    explicit EnvelopeCache(size_t maxBytes);
+
+    EnvelopeCache(EnvelopeCache const &) = delete;
+    EnvelopeCache & operator=(EnvelopeCache const &) = delete;
+
+    /// `envelope` returns `pixelization.envelope(region, maxRanges)`,
+    /// computing it only if it is not cached.
+    RangeSet envelope(Pixelization const & pixelization,
+                      Region const & region,
+                      size_t maxRanges = 0);
+
+    /// `interior` returns `pixelization.interior(region, maxRanges)`,
+    /// computing it only if it is not cached.
+    RangeSet interior(Pixelization const & pixelization,
+                      Region const & region,
+                      size_t maxRanges = 0);
+
+    /// `clear` removes all cached results. It does not reset the counters.
+    void clear();
+
+    /// `getMaxBytes` returns the memory budget of this cache.
+    size_t getMaxBytes() const { return _maxBytes; }
+
+    /// `getBytes` returns the memory currently used by this cache.
+    size_t getBytes() const;
+
+    /// `size` returns the number of cached results.
+    size_t size() const;
+
+    /// `getHits`, `getMisses` and `getEvictions` return the number of
+    /// lookups that were answered from the cache, the number that were
+    /// not, and the number of results evicted to make room for others.
+    ///@{
+    uint64_t getHits() const;
+    uint64_t getMisses() const;
+    uint64_t getEvictions() const;
+    ///@}
+
+private:
+    struct Entry {
+        std::string key;
+        RangeSet ranges;
+        size_t bytes;
+    };
+
+    using EntryList = std::list<Entry>;
+
+    mutable std::mutex _mutex;
+    // Entries in order of decreasing recency of use.
+    EntryList _entries;
+    std::unordered_map<std::string, EntryList::iterator> _index;
+    size_t _maxBytes;
+    size_t _bytes = 0;
+    uint64_t _hits = 0;
+    uint64_t _misses = 0;
+    uint64_t _evictions = 0;
+
+    template <typename Compute>
+    RangeSet _find(char op, Pixelization const & pixelization,
+                   Region const & region, size_t maxRanges,
+                   Compute compute);
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_ENVELOPECACHE_H_
@@ -0,0 +1,83 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_EXECUTOR_H_
+#define LSST_SPHGEOM_EXECUTOR_H_
+
+/// \file
+/// \brief This file declares the executor that runs the parallel parts of
+///        library operations, and the library-wide thread settings.
+
+#include <functional>
+#include <memory>
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// An `Executor` runs tasks on behalf of library operations that accept a
+/// `numThreads` argument. Those operations divide their work dynamically
+/// between the calling thread and up to `numThreads - 1` tasks submitted to
+/// the executor, so that all of them share one set of threads.
+///
+/// An operation never waits for a task to start: it does whatever work is
+/// left itself, and tasks that start after it has finished return at once.
+/// Executors therefore need not run tasks promptly, and may run them on
+/// the thread that submits them, or on a thread that is itself running an
+/// operation. An executor that forwards tasks to an external scheduler
+/// (e.g. the worker pool of a distributed task framework) can be
+/// installed with `setExecutor`.
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /// `submit` arranges for `task` to be called once, on any thread, at
+    /// any later time, and may return before it is called. Tasks submitted
+    /// by the library do not throw. Implementations must be thread-safe.
+    virtual void submit(std::function<void()> task) = 0;
+};
+
+/// `getDefaultExecutor` returns the executor used unless another one is
+/// installed: a pool of one thread per hardware thread, started on first
+/// use, in which idle threads take tasks in submission order.
+std::shared_ptr<Executor> getDefaultExecutor();
+
+/// `getExecutor` returns the executor used by parallel operations.
+std::shared_ptr<Executor> getExecutor();
+
+/// `setExecutor` installs the executor used by subsequently started
+/// parallel operations. Passing null restores the default executor.
+void setExecutor(std::shared_ptr<Executor> executor);
+
+/// `getMaxThreads` returns the maximum number of threads used by any one
+/// operation, or 0 if there is no limit.
+unsigned getMaxThreads();
+
+/// `setMaxThreads` limits the number of threads, including the calling
+/// thread, used by any one operation, whatever its `numThreads` argument.
+/// Passing 1 makes all operations serial, and passing 0 removes the limit.
+/// Results never depend on the number of threads used.
+void setMaxThreads(unsigned n);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_EXECUTOR_H_
@@ -0,0 +1,227 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_HEALPIXPIXELIZATION_H_
+#define LSST_SPHGEOM_HEALPIXPIXELIZATION_H_
+
+/// \file
+/// \brief This file declares a Pixelization subclass for the HEALPix
+///        indexing scheme.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "MultiLevelRangeSet.h"
+#include "Pixelization.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace detail {
+template <int NumVertices> class PixelCache;
+}
+
+/// `HealpixPixelization` provides HEALPix indexing of points and regions,
+/// using the NESTED pixel numbering scheme. The pixelization of level L
+/// has nside = 2^L, and 12 * 4^L pixels.
+///
+/// The NESTED scheme numbers the pixels of each of the 12 base pixels in
+/// quad-tree order, so that the children of pixel i at level L are the
+/// pixels 4i, 4i + 1, 4i + 2 and 4i + 3 at level L + 1. Region
+/// pixelization is therefore performed by the same hierarchical search
+/// used for HTM and Q3C.
+///
+/// The edges of HEALPix pixels are not great circles, so the polygonal
+/// representation of a pixel is a quadrilateral whose edges are pushed
+/// outwards far enough to contain the curved pixel edges. Such polygons
+/// contain all unit vectors that map to the pixel, but overlap their
+/// neighbors slightly more than HTM or Q3C pixels do.
+///
+/// Instances of this class are immutable and very cheap to copy.
+///
+/// \warning Setting the `maxRanges` argument for envelope() or interior()
+/// to a non-zero value below 4 can result in very poor region pixelizations
+/// regardless of region size. For instance, if `maxRanges` is 1, a non-empty
+/// circle centered on the equator at longitude 45° will be approximated by
+/// the indexes for base pixels 0 through 8, even as its radius tends to 0.
+class HealpixPixelization : public Pixelization {
+public:
+    /// The maximum supported resolution, nside = 2^29.
+    static constexpr int MAX_LEVEL = 29;
+
+    /// `NUM_VERTICES` is the number of vertices of a HEALPix pixel polygon.
+    static constexpr int NUM_VERTICES = 4;
+
+    /// This constructor creates a HEALPix pixelization of the sphere with
+    /// the given level. If `level` ∉ [0, MAX_LEVEL], a std::invalid_argument
+    /// is thrown.
+    ///
+    /// If `cacheSize` is positive, the vertices of up to about that many
+    /// recently used pixels are cached, so that repeated pixel() and quad()
+    /// calls for the same indexes skip recomputing them. The cache is safe
+    /// to use from multiple threads, and is shared by copies of this
+    /// pixelization.
+    explicit HealpixPixelization(int level, size_t cacheSize = 0);
+
+    /// `getLevel` returns the level of this pixelization.
+    int getLevel() const { return _level; }
+
+    /// `multiLevelEnvelope` returns the pixels intersecting r, as computed by
+    /// envelope(), using the coarsest pixels that represent them exactly.
+    MultiLevelRangeSet multiLevelEnvelope(Region const & r,
+                                          size_t maxRanges = 0,
+                                          unsigned numThreads = 1) const {
+        return MultiLevelRangeSet(envelope(r, maxRanges, numThreads), _level);
+    }
+
+    /// `multiLevelInterior` returns the pixels within r, as computed by
+    /// interior(), using the coarsest pixels that represent them exactly.
+    MultiLevelRangeSet multiLevelInterior(Region const & r,
+                                          size_t maxRanges = 0,
+                                          unsigned numThreads = 1) const {
+        return MultiLevelRangeSet(interior(r, maxRanges, numThreads), _level);
+    }
+
+    ///@{
+    /// `envelopeAtLevels` and `interiorAtLevels` return the pixels
+    /// intersecting (or within) r at each of the given subdivision levels, in
+    /// the order of `levels`; the level of this pixelization is not used.
+    /// All of the sets are collected during a single traversal down to the
+    /// finest level, which passes through the coarser ones, so this is
+    /// cheaper than calling envelope() or interior() once per level.
+    ///
+    /// The set for level l matches that computed for a pixelization at
+    /// level l, except that a traversal for a small region may start at a
+    /// pixel of a finer level known to contain it. The ancestors of that
+    /// pixel are then output whole at the coarser levels, where a
+    /// traversal of their own could have omitted pixels that were only
+    /// reported because relationship tests are conservative.
+    ///
+    /// \throws std::invalid_argument if a level is not in [0, MAX_LEVEL].
+    std::vector<RangeSet> envelopeAtLevels(Region const & r,
+                                           std::vector<int> const & levels) const;
+    std::vector<RangeSet> interiorAtLevels(Region const & r,
+                                           std::vector<int> const & levels) const;
+    ///@}
+
+    /// `getNside` returns the HEALPix resolution parameter, 2^getLevel().
+    uint64_t getNside() const { return static_cast<uint64_t>(1) << _level; }
+
+    /// `quad` returns the quadrilateral containing the HEALPix pixel with
+    /// index `i`. Its vertices are the dilated north, west, south and east
+    /// pixel corners, in that order.
+    ///
+    /// If `i` is not a valid HEALPix index, a std::invalid_argument is
+    /// thrown.
+    ConvexPolygon quad(uint64_t i) const;
+
+    RangeSet universe() const override {
+        return RangeSet(0, static_cast<uint64_t>(12) << 2 * _level);
+    }
+
+    std::unique_ptr<Region> pixel(uint64_t i) const override;
+
+    /// `vertices` writes the vertices of the pixels with the `n` given
+    /// indexes to `out`, which must have room for `3 * NUM_VERTICES * n`
+    /// doubles. The storage layout is that of a `double[n][NUM_VERTICES][3]`
+    /// array; vertex order matches pixel(). No memory is allocated, so this
+    /// is much faster than calling pixel() for each index.
+    ///
+    /// If any index is not a valid HEALPix index, a std::invalid_argument is
+    /// thrown and the contents of `out` are unspecified.
+    void vertices(uint64_t const * indexes, size_t n, double * out) const;
+
+    uint64_t index(UnitVector3d const & v) const override;
+
+    void index(double const * x,
+               double const * y,
+               double const * z,
+               uint64_t * out,
+               size_t n) const override;
+
+    using Pixelization::index;
+
+    /// `toString` converts the given HEALPix index to a string containing
+    /// its decimal representation.
+    ///
+    /// If i is not a valid HEALPix index, a std::invalid_argument is thrown.
+    std::string toString(uint64_t i) const override;
+
+    void toString(uint64_t const * indexes,
+                  size_t n,
+                  char * out,
+                  size_t width) const override;
+
+    using Pixelization::toString;
+
+    size_t maxStringLength() const override;
+
+    /// `fromString` is the inverse of toString: it parses the decimal
+    /// representation of a HEALPix index at the subdivision level of this
+    /// pixelization. Leading zeros and signs are not accepted.
+    uint64_t fromString(char const * s, size_t n) const override;
+
+    using Pixelization::fromString;
+
+    std::string getCacheKey() const override {
+        return "healpix:" + std::to_string(_level);
+    }
+
+private:
+    int _level;
+    std::shared_ptr<detail::PixelCache<NUM_VERTICES>> _cache;
+
+    void _vertices(uint64_t i, UnitVector3d * verts) const;
+
+    RangeSet _envelope(Region const & r,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+    RangeSet _interior(Region const & r,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+    RangeSet _adaptiveEnvelope(Region const & r,
+                               size_t targetRanges,
+                               double areaBudget) const override;
+    RangeSet _adaptiveInterior(Region const & r,
+                               size_t targetRanges,
+                               double areaBudget) const override;
+    ProgressiveEnvelope _progressiveEnvelope(Region const & r) const override;
+    CoverageFractions _coverageFraction(Region const & r) const override;
+    EnvelopeAndInterior _envelopeAndInterior(Region const & r,
+                                             size_t maxRanges) const override;
+    RangeSet _envelope(Pixelization const & from,
+                       RangeSet const & pixels,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+    RangeSet _interior(Pixelization const & from,
+                       RangeSet const & pixels,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_HEALPIXPIXELIZATION_H_
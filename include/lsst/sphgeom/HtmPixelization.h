@@ -28,15 +28,23 @@
 ///        indexing scheme.
 
 #include <cstdint>
+#include <memory>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "ConvexPolygon.h"
+#include "MultiLevelRangeSet.h"
 #include "Pixelization.h"
 
 
 namespace lsst {
 namespace sphgeom {
 
+namespace detail {
+template <int NumVertices> class PixelCache;
+}
+
 /// `HtmPixelization` provides [HTM indexing](\ref htm-overview) of points
 /// and regions.
 ///
@@ -52,6 +60,9 @@ public:
     /// `MAX_LEVEL` is the maximum supported HTM subdivision level.
     static constexpr int MAX_LEVEL = 24;
 
+    /// `NUM_VERTICES` is the number of vertices of an HTM pixel.
+    static constexpr int NUM_VERTICES = 3;
+
     /// `level` returns the subdivision level of the given HTM index.
     ///
     /// If i is not a valid HTM index, -1 is returned.
@@ -62,6 +73,36 @@ public:
     /// If i is not a valid HTM index, a std::invalid_argument is thrown.
     static ConvexPolygon triangle(uint64_t i);
 
+    /// `neighborhood` returns the indexes of all trixels that share a vertex
+    /// with trixel `i` (including `i` itself), in ascending order. An HTM
+    /// trixel has 12 - 2k adjacent trixels, where k is the number of its
+    /// vertices that are also root triangle vertices (0, 1, or 3). The
+    /// neighbors are obtained from `i` by index arithmetic alone.
+    ///
+    /// If i is not a valid HTM index, a std::invalid_argument is thrown.
+    static std::vector<uint64_t> neighborhood(uint64_t i);
+
+    /// `neighborhood` returns the indexes of all trixels that can be
+    /// reached from trixel `i` in at most `k` steps between trixels sharing
+    /// a vertex. For k = 1, this is the same set of trixels as
+    /// `neighborhood(i)`, and for k = 0, it is just `i`.
+    ///
+    /// If i is not a valid HTM index or k is negative, a
+    /// std::invalid_argument is thrown.
+    static RangeSet neighborhood(uint64_t i, int k);
+
+    /// `neighborhood` finds the neighborhoods of the `n` given trixels,
+    /// and returns them in compressed form. On return, `offsets` has size
+    /// n + 1, and the neighborhood of `indexes[i]` consists of
+    /// `neighbors[offsets[i]]`, ..., `neighbors[offsets[i + 1] - 1]`.
+    ///
+    /// If any index is not a valid HTM index, a std::invalid_argument is
+    /// thrown.
+    static void neighborhood(uint64_t const * indexes,
+                             size_t n,
+                             std::vector<size_t> & offsets,
+                             std::vector<uint64_t> & neighbors);
+
     /// `asString` converts the given HTM index to a human readable string.
     ///
     /// The first character in the return value is always 'N' or 'S',
@@ -78,29 +119,127 @@ public:
     /// This constructor creates an HTM pixelization of the sphere with
     /// the given subdivision level. If `level` ∉ [0, MAX_LEVEL],
     /// a std::invalid_argument is thrown.
-    explicit HtmPixelization(int level);
+    ///
+    /// If `cacheSize` is positive, the vertices of up to about that many
+    /// recently used pixels are cached, so that repeated pixel() calls
+    /// for the same indexes skip recomputing them. The cache is safe to use
+    /// from multiple threads, and is shared by copies of this pixelization.
+    explicit HtmPixelization(int level, size_t cacheSize = 0);
 
     /// `getLevel` returns the subdivision level of this pixelization.
     int getLevel() const { return _level; }
 
+    /// `multiLevelEnvelope` returns the pixels intersecting r, as computed by
+    /// envelope(), using the coarsest pixels that represent them exactly.
+    MultiLevelRangeSet multiLevelEnvelope(Region const & r,
+                                          size_t maxRanges = 0,
+                                          unsigned numThreads = 1) const {
+        return MultiLevelRangeSet(envelope(r, maxRanges, numThreads), _level);
+    }
+
+    /// `multiLevelInterior` returns the pixels within r, as computed by
+    /// interior(), using the coarsest pixels that represent them exactly.
+    MultiLevelRangeSet multiLevelInterior(Region const & r,
+                                          size_t maxRanges = 0,
+                                          unsigned numThreads = 1) const {
+        return MultiLevelRangeSet(interior(r, maxRanges, numThreads), _level);
+    }
+
+    ///@{
+    /// `envelopeAtLevels` and `interiorAtLevels` return the pixels
+    /// intersecting (or within) r at each of the given subdivision levels, in
+    /// the order of `levels`; the level of this pixelization is not used.
+    /// All of the sets are collected during a single traversal down to the
+    /// finest level, which passes through the coarser ones, so this is
+    /// cheaper than calling envelope() or interior() once per level.
+    ///
+    /// The set for level l matches that computed for a pixelization at
+    /// level l, except that a traversal for a small region may start at a
+    /// pixel of a finer level known to contain it. The ancestors of that
+    /// pixel are then output whole at the coarser levels, where a
+    /// traversal of their own could have omitted pixels that were only
+    /// reported because relationship tests are conservative.
+    ///
+    /// \throws std::invalid_argument if a level is not in [0, MAX_LEVEL].
+    std::vector<RangeSet> envelopeAtLevels(Region const & r,
+                                           std::vector<int> const & levels) const;
+    std::vector<RangeSet> interiorAtLevels(Region const & r,
+                                           std::vector<int> const & levels) const;
+    ///@}
+
     RangeSet universe() const override {
         return RangeSet(static_cast<uint64_t>(8) << 2 * _level,
                         static_cast<uint64_t>(16) << 2 * _level);
     }
 
-    std::unique_ptr<Region> pixel(uint64_t i) const override {
-        return std::unique_ptr<Region>(new ConvexPolygon(triangle(i)));
-    }
+    std::unique_ptr<Region> pixel(uint64_t i) const override;
+
+    /// `vertices` writes the vertices of the pixels with the `n` given
+    /// indexes to `out`, which must have room for `3 * NUM_VERTICES * n`
+    /// doubles. The storage layout is that of a `double[n][NUM_VERTICES][3]`
+    /// array; vertex order matches pixel(). No memory is allocated, so this
+    /// is much faster than calling pixel() for each index.
+    ///
+    /// If any index is not a valid HTM index, a std::invalid_argument is
+    /// thrown and the contents of `out` are unspecified.
+    void vertices(uint64_t const * indexes, size_t n, double * out) const;
 
     uint64_t index(UnitVector3d const &) const override;
 
+    void index(double const * x,
+               double const * y,
+               double const * z,
+               uint64_t * out,
+               size_t n) const override;
+
+    using Pixelization::index;
+
     std::string toString(uint64_t i) const override { return asString(i); }
 
+    void toString(uint64_t const * indexes,
+                  size_t n,
+                  char * out,
+                  size_t width) const override;
+
+    using Pixelization::toString;
+
+    size_t maxStringLength() const override {
+        return static_cast<size_t>(_level) + 2;
+    }
+
+    /// `fromString` is the inverse of asString. The string may describe
+    /// a pixel at any valid subdivision level, not just that of this
+    /// pixelization.
+    uint64_t fromString(char const * s, size_t n) const override;
+
+    using Pixelization::fromString;
+
+    std::string getCacheKey() const override {
+        return "htm:" + std::to_string(_level);
+    }
+
 private:
     int _level;
-
-    RangeSet _envelope(Region const &, size_t) const override;
-    RangeSet _interior(Region const &, size_t) const override;
+    std::shared_ptr<detail::PixelCache<NUM_VERTICES>> _cache;
+
+    void _vertices(uint64_t i, UnitVector3d * verts) const;
+
+    RangeSet _envelope(Region const &, size_t, unsigned) const override;
+    RangeSet _interior(Region const &, size_t, unsigned) const override;
+    void _findMany(Region const * const *, size_t, size_t, bool,
+                   RangeSetSink const &) const override;
+    RangeSet _adaptiveEnvelope(Region const &, size_t,
+                               double) const override;
+    RangeSet _adaptiveInterior(Region const &, size_t,
+                               double) const override;
+    ProgressiveEnvelope _progressiveEnvelope(Region const &) const override;
+    CoverageFractions _coverageFraction(Region const &) const override;
+    EnvelopeAndInterior _envelopeAndInterior(Region const &,
+                                             size_t) const override;
+    RangeSet _envelope(Pixelization const &, RangeSet const &,
+                       size_t, unsigned) const override;
+    RangeSet _interior(Pixelization const &, RangeSet const &,
+                       size_t, unsigned) const override;
 };
 
 }} // namespace lsst::sphgeom
@@ -0,0 +1,216 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_HYBRIDRANGESET_H_
+#define LSST_SPHGEOM_HYBRIDRANGESET_H_
+
+/// \file
+/// \brief This file provides a compact type for representing fragmented
+///        integer sets.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `HybridRangeSet` is a set of unsigned 64 bit integers, with the same
+/// set algebra as RangeSet but a representation in the spirit of Roaring
+/// bitmaps.
+///
+/// A RangeSet stores 16 bytes per range, which is wasteful for fragmented
+/// sets, e.g. fine level pixelization interiors or sets built from point
+/// indexes, where most ranges contain a single integer. A HybridRangeSet
+/// instead divides [0, 2^64) into blocks of 2^16 consecutive integers that
+/// share their 48 most significant bits:
+///
+/// - Blocks that are entirely in the set are tracked by a RangeSet of
+///   block-aligned ranges, so that large and complemented sets remain cheap.
+/// - Every other non-empty block is stored in the smallest of three
+///   containers: a sorted array of 16 bit offsets (for at most 4096
+///   integers), a list of runs of consecutive offsets, or a 2^16 bit bitmap.
+///
+/// The representation of a set is a function of its contents, so that sets
+/// can be compared for equality directly. Conversion to and from RangeSet
+/// is linear in the size of the input, so pixelization envelopes and
+/// interiors can be converted once and then combined in compact form.
+class HybridRangeSet {
+public:
+    /// The default constructor creates an empty set.
+    HybridRangeSet() = default;
+
+    /// This constructor creates a set containing the integers in s.
+    explicit HybridRangeSet(RangeSet const & s);
+
+    bool operator==(HybridRangeSet const & s) const;
+
+    bool operator!=(HybridRangeSet const & s) const { return !(*this == s); }
+
+    /// `toRangeSet` returns a RangeSet containing the integers in this set.
+    RangeSet toRangeSet() const;
+
+    /// `empty` checks whether there are any integers in this set.
+    bool empty() const { return _full.empty() && _blocks.empty(); }
+
+    /// `full` checks whether all integers in the universe of range sets,
+    /// [0, 2^64), are in this set.
+    bool full() const { return _full.full(); }
+
+    /// `cardinality` returns the number of integers in this set.
+    ///
+    /// As for RangeSet, 0 is returned both for full and empty sets.
+    uint64_t cardinality() const;
+
+    /// `contains` returns true iff u is in this set.
+    bool contains(uint64_t u) const;
+
+    /// `memoryUsage` returns the approximate number of bytes of memory
+    /// used by this set.
+    size_t memoryUsage() const;
+
+    /// `complement` replaces this set S with U ∖ S, where U is the
+    /// universe of range sets, [0, 2^64).
+    HybridRangeSet & complement();
+
+    /// `complemented` returns a complemented copy of this set.
+    HybridRangeSet complemented() const {
+        HybridRangeSet s(*this);
+        s.complement();
+        return s;
+    }
+
+    /// `intersection` returns the intersection of this set and s.
+    HybridRangeSet intersection(HybridRangeSet const & s) const;
+
+    /// `join` returns the union of this set and s.
+    HybridRangeSet join(HybridRangeSet const & s) const;
+
+    /// `difference` returns the difference between this set and s.
+    HybridRangeSet difference(HybridRangeSet const & s) const;
+
+    /// `symmetricDifference` returns the symmetric difference of
+    /// this set and s.
+    HybridRangeSet symmetricDifference(HybridRangeSet const & s) const;
+
+    /// The ~ operator returns the complement of this set.
+    HybridRangeSet operator~() const { return complemented(); }
+
+    /// The & operator returns the intersection of this set and s.
+    HybridRangeSet operator&(HybridRangeSet const & s) const {
+        return intersection(s);
+    }
+
+    /// The | operator returns the union of this set and s.
+    HybridRangeSet operator|(HybridRangeSet const & s) const {
+        return join(s);
+    }
+
+    /// The - operator returns the difference between this set and s.
+    HybridRangeSet operator-(HybridRangeSet const & s) const {
+        return difference(s);
+    }
+
+    /// The ^ operator returns the symmetric difference between this set and s.
+    HybridRangeSet operator^(HybridRangeSet const & s) const {
+        return symmetricDifference(s);
+    }
+
+    /// The &= operator assigns the intersection of this set and s to this set.
+    HybridRangeSet & operator&=(HybridRangeSet const & s) {
+        return *this = intersection(s);
+    }
+
+    /// The |= operator assigns the union of this set and s to this set.
+    HybridRangeSet & operator|=(HybridRangeSet const & s) {
+        return *this = join(s);
+    }
+
+    /// The -= operator assigns the difference between this set and s
+    /// to this set.
+    HybridRangeSet & operator-=(HybridRangeSet const & s) {
+        return *this = difference(s);
+    }
+
+    /// The ^= operator assigns the symmetric difference between this set
+    /// and s to this set.
+    HybridRangeSet & operator^=(HybridRangeSet const & s) {
+        return *this = symmetricDifference(s);
+    }
+
+    /// `simplify` simplifies this set by "coarsening" its ranges, exactly
+    /// as RangeSet::simplify does.
+    HybridRangeSet & simplify(uint32_t n);
+
+    /// `simplified` returns a simplified copy of this set.
+    HybridRangeSet simplified(uint32_t n) const {
+        HybridRangeSet s(*this);
+        s.simplify(n);
+        return s;
+    }
+
+    /// `isValid` checks that this HybridRangeSet is in a valid state.
+    ///
+    /// It is intended for use by unit tests, but calling it in other contexts
+    /// is harmless.
+    bool isValid() const;
+
+private:
+    friend struct HybridRangeSetImpl;
+
+    // A `Block` stores the integers of a set in [key * 2^16, (key + 1) * 2^16)
+    // as 16 bit offsets from key * 2^16.
+    struct Block {
+        enum Kind : uint8_t { ARRAY, RUNS, BITMAP };
+
+        uint64_t key = 0;
+        uint32_t cardinality = 0;
+        Kind kind = ARRAY;
+        // For ARRAY blocks, the sorted offsets of the integers in the block.
+        // For RUNS blocks, the first and last offsets of each run of
+        // consecutive integers.
+        std::vector<uint16_t> values;
+        // For BITMAP blocks, 1024 words with one bit per integer.
+        std::vector<uint64_t> bits;
+
+        bool operator==(Block const & b) const {
+            return key == b.key && cardinality == b.cardinality &&
+                   kind == b.kind && values == b.values && bits == b.bits;
+        }
+    };
+
+    // The block-aligned ranges of integers in blocks that are entirely
+    // contained in this set.
+    RangeSet _full;
+
+    // The blocks that are partially contained in this set, sorted by key.
+    std::vector<Block> _blocks;
+
+    RangeSet _blockRanges() const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_HYBRIDRANGESET_H_
@@ -26,6 +26,7 @@
 /// \file
 /// \brief This file contains a class representing 3x3 real matrices.
 
+#include <cstddef>
 #include <iosfwd>
 
 #include "Vector3d.h"
@@ -110,6 +111,18 @@ public:
         return Vector3d(_c[0] * v(0) + _c[1] * v(1) + _c[2] * v(2));
     }
 
+    /// `apply` computes the products of this matrix with the n vectors
+    /// (x[i], y[i], z[i]), and writes their components to ox, oy and oz.
+    /// The results are identical to those of `*this * Vector3d(x[i], y[i],
+    /// z[i])`. The output arrays may be the same as the input arrays.
+    void apply(double const * x,
+               double const * y,
+               double const * z,
+               double * ox,
+               double * oy,
+               double * oz,
+               size_t n) const;
+
     /// The multiplication operator returns the product of this matrix
     /// with matrix `m`.
     Matrix3d operator*(Matrix3d const & m) const {
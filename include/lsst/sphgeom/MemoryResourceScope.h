@@ -0,0 +1,74 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_MEMORYRESOURCESCOPE_H_
+#define LSST_SPHGEOM_MEMORYRESOURCESCOPE_H_
+
+/// \file
+/// \brief This file declares a scope that selects the memory resource
+///        used for pixelization and decoding results.
+
+#include <memory_resource>
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// `MemoryResourceScope` makes the RangeSet objects returned by
+/// `Pixelization::envelope`, `Pixelization::interior`,
+/// `Pixelization::coverageFraction` and `RangeSet::decode` on the current
+/// thread, along with the scratch storage of the pixel traversals behind
+/// them, allocate from the given memory resource for its lifetime. Scopes
+/// nest; the innermost one is used, and the previous memory resource is
+/// restored when it ends. For example, all the memory used to process a
+/// request can be released at once with:
+///
+///     std::pmr::monotonic_buffer_resource arena;
+///     {
+///         MemoryResourceScope scope(arena);
+///         RangeSet s = pixelization.envelope(region, 64);
+///         ...
+///     }
+///
+/// Sets allocated from a scoped resource must not outlive it. Since memory
+/// resources are generally not thread-safe, they must also only be modified
+/// on the thread that created them. Traversals using more than one thread
+/// allocate from the default memory resource on the worker threads.
+class MemoryResourceScope {
+public:
+    explicit MemoryResourceScope(std::pmr::memory_resource & resource);
+    ~MemoryResourceScope();
+
+    MemoryResourceScope(MemoryResourceScope const &) = delete;
+    MemoryResourceScope & operator=(MemoryResourceScope const &) = delete;
+
+    /// `current` returns the memory resource for the current thread, which
+    /// is `std::pmr::get_default_resource()` if there is no scope.
+    static std::pmr::memory_resource * current();
+
+private:
+    std::pmr::memory_resource * _previous;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_MEMORYRESOURCESCOPE_H_
@@ -0,0 +1,114 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_MULTILEVELRANGESET_H_
+#define LSST_SPHGEOM_MULTILEVELRANGESET_H_
+
+/// \file
+/// \brief This file declares a class for representing pixel sets that mix
+///        the pixels of several subdivision levels.
+
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `MultiLevelRangeSet` represents a set of pixels from a hierarchical
+/// pixelization (HTM, Q3C, MQ3C or HEALPix) as the union of pixels from
+/// subdivision levels 0 through some maximum level L, in the manner of an
+/// IVOA Multi-Order Coverage map (MOC). The pixels at level l are stored as a
+/// RangeSet of level l pixel indexes, and each covers 4ᴸ⁻ˡ pixels at level L.
+///
+/// Sets are always normalized: no pixel in the set is contained in another,
+/// and no 4 siblings are all present (they are replaced by their parent).
+/// So each pixel set has exactly one representation, which uses pixels
+/// that are as coarse as possible. Compared to the equivalent level L
+/// RangeSet, this shrinks the description of large regions to mostly coarse
+/// pixels in the interior and fine ones near the boundary.
+class MultiLevelRangeSet {
+public:
+    /// This constructor creates an empty set with a maximum level of 0.
+    MultiLevelRangeSet() : _levels(1) {}
+
+    /// This constructor converts a set of pixel indexes at the given level
+    /// to its multi-level representation. It throws std::invalid_argument if
+    /// `level` is not in [0, 30].
+    MultiLevelRangeSet(RangeSet const & s, int level);
+
+    bool operator==(MultiLevelRangeSet const & s) const {
+        return _levels == s._levels;
+    }
+
+    bool operator!=(MultiLevelRangeSet const & s) const {
+        return _levels != s._levels;
+    }
+
+    /// `getMaxLevel` returns the finest subdivision level of this set.
+    int getMaxLevel() const { return static_cast<int>(_levels.size()) - 1; }
+
+    /// `getRanges` returns the indexes of the pixels at the given level.
+    /// It throws std::invalid_argument if `level` is not in
+    /// [0, getMaxLevel()].
+    RangeSet const & getRanges(int level) const;
+
+    /// `empty` checks whether this set contains no pixels.
+    bool empty() const;
+
+    /// `size` returns the total number of ranges over all levels.
+    size_t size() const;
+
+    /// `getNumPixels` returns the total number of pixels over all levels.
+    uint64_t getNumPixels() const;
+
+    /// `flatten` returns the pixels of this set at the maximum level.
+    RangeSet flatten() const;
+
+    /// `uniq` returns the pixels of this set in the NUNIQ encoding of the
+    /// IVOA MOC standard, in ascending order. Pixel i at level l is encoded
+    /// as 4ˡ⁺¹ + i. This is reversible only for pixelizations whose level l
+    /// indexes are less than 3·4ˡ⁺¹ (e.g. HEALPix and Q3C), and
+    /// std::invalid_argument is thrown for other pixels. HTM and MQ3C
+    /// indexes already identify their level; use getRanges() for those.
+    std::vector<uint64_t> uniq() const;
+
+    /// `fromUniq` creates a set from pixels in the NUNIQ encoding, in any
+    /// order. Pixels contained in others are allowed. It throws
+    /// std::invalid_argument if a value is not a valid NUNIQ value for a
+    /// level in [0, 30], or if `maxLevel` is smaller than the level of some
+    /// pixel. A negative `maxLevel` is replaced by the finest pixel level.
+    static MultiLevelRangeSet fromUniq(std::vector<uint64_t> const & uniq,
+                                       int maxLevel = -1);
+
+private:
+    std::vector<RangeSet> _levels;
+};
+
+std::ostream & operator<<(std::ostream &, MultiLevelRangeSet const &);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_MULTILEVELRANGESET_H_
@@ -0,0 +1,141 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PERFORMANCECOUNTERS_H_
+#define LSST_SPHGEOM_PERFORMANCECOUNTERS_H_
+
+/// \file
+/// \brief This file declares library-wide performance counters.
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// `PerformanceCounter` identifies a library-wide performance counter.
+/// Each `_NANOSECONDS` counter holds the cumulative wall clock time of the
+/// calls counted by the `_CALLS` counter before it.
+enum class PerformanceCounter : unsigned {
+    /// Calls to `envelope` and `interior` of each built-in pixelization,
+    /// including those made for each region by the batch methods. Combined
+    /// `envelopeAndInterior` traversals are not counted.
+    HTM_ENVELOPE_CALLS,
+    HTM_ENVELOPE_NANOSECONDS,
+    HTM_INTERIOR_CALLS,
+    HTM_INTERIOR_NANOSECONDS,
+    Q3C_ENVELOPE_CALLS,
+    Q3C_ENVELOPE_NANOSECONDS,
+    Q3C_INTERIOR_CALLS,
+    Q3C_INTERIOR_NANOSECONDS,
+    MQ3C_ENVELOPE_CALLS,
+    MQ3C_ENVELOPE_NANOSECONDS,
+    MQ3C_INTERIOR_CALLS,
+    MQ3C_INTERIOR_NANOSECONDS,
+    HEALPIX_ENVELOPE_CALLS,
+    HEALPIX_ENVELOPE_NANOSECONDS,
+    HEALPIX_INTERIOR_CALLS,
+    HEALPIX_INTERIOR_NANOSECONDS,
+    /// Relate calls between each pair of region types, counted once
+    /// whichever operand the call was made on. Box-Box relations, which
+    /// are inline interval comparisons, are not counted.
+    RELATE_BOX_CIRCLE,
+    RELATE_CIRCLE_CIRCLE,
+    RELATE_CONVEX_POLYGON_BOX,
+    RELATE_CONVEX_POLYGON_CIRCLE,
+    RELATE_CONVEX_POLYGON_CONVEX_POLYGON,
+    RELATE_ELLIPSE_BOX,
+    RELATE_ELLIPSE_CIRCLE,
+    RELATE_ELLIPSE_CONVEX_POLYGON,
+    RELATE_ELLIPSE_ELLIPSE,
+    /// Orientation computations that the double precision determinant
+    /// could not decide, and that fell back to exact arithmetic.
+    ORIENTATION_FALLBACKS,
+    /// Calls to `Region::decode`, and the number of bytes they decoded.
+    /// Operands of compound regions are counted again.
+    REGION_DECODE_CALLS,
+    REGION_DECODE_BYTES,
+    /// Binary RangeSet operations (intersection, union, difference and
+    /// symmetric difference), and the total number of ranges in their
+    /// operands.
+    RANGE_SET_MERGES,
+    RANGE_SET_MERGE_RANGES,
+};
+
+/// `NUM_PERFORMANCE_COUNTERS` is the number of performance counters.
+constexpr size_t NUM_PERFORMANCE_COUNTERS =
+    static_cast<size_t>(PerformanceCounter::RANGE_SET_MERGE_RANGES) + 1;
+
+/// A `PerformanceSnapshot` holds the values of all performance counters
+/// at some point in time.
+struct PerformanceSnapshot {
+    /// `ENABLED` is false if the library was compiled with
+    /// `LSST_SPHGEOM_NO_PERFORMANCE_COUNTERS`, in which case all counters
+    /// are always zero.
+    static bool const ENABLED;
+
+    std::array<uint64_t, NUM_PERFORMANCE_COUNTERS> values{};
+
+    uint64_t operator[](PerformanceCounter c) const {
+        return values[static_cast<size_t>(c)];
+    }
+
+    /// `getName` returns a name for c, such as "htm.envelope.calls", that
+    /// is suitable for use as a metric name.
+    static char const * getName(PerformanceCounter c);
+};
+
+/// `getPerformanceCounters` returns the values of all performance counters
+/// accumulated by all threads since the last call to
+/// `resetPerformanceCounters`.
+///
+/// Counters are compiled in by default. Each thread increments its own
+/// counters with relaxed atomic stores, so that counting costs a few
+/// nanoseconds and causes no contention between threads. Taking a snapshot
+/// sums the counters of all threads, including those that have exited.
+/// Counts from calls that are in progress on other threads may or may not
+/// be included.
+PerformanceSnapshot getPerformanceCounters();
+
+/// `resetPerformanceCounters` sets all performance counters to zero.
+void resetPerformanceCounters();
+
+/// `setPerformanceCallback` arranges for `callback` to be called with a
+/// snapshot of the performance counters every `period`, from a dedicated
+/// reporting thread, e.g. to export them to a monitoring system. It
+/// replaces any previous callback, and waits for a call of that callback in
+/// progress to return. An empty callback stops reporting.
+///
+/// Exceptions thrown by the callback are ignored. This function must not be
+/// called from the callback. It throws std::invalid_argument if `callback`
+/// is not empty and `period` is not positive.
+void setPerformanceCallback(
+    std::function<void(PerformanceSnapshot const &)> callback,
+    std::chrono::milliseconds period);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_PERFORMANCECOUNTERS_H_
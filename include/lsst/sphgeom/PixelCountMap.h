@@ -0,0 +1,167 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PIXELCOUNTMAP_H_
+#define LSST_SPHGEOM_PIXELCOUNTMAP_H_
+
+/// \file
+/// \brief This file declares a class for accumulating sparse per-pixel
+///        counts and weights.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `PixelCountRuns` holds the contents of a PixelCountMap in columnar
+/// form. Each of the pixels with indexes in [begin[i], end[i]) has the
+/// weight value[i] ≠ 0, where, as in RangeSet, an end of 0 stands for 2⁶⁴.
+/// Runs are sorted and disjoint, and adjacent runs have different weights.
+struct PixelCountRuns {
+    std::vector<uint64_t> begin;
+    std::vector<uint64_t> end;
+    std::vector<double> value;
+
+    /// `size` returns the number of runs.
+    size_t size() const { return value.size(); }
+};
+
+/// A `PixelCountMap` accumulates counts or weights for the pixels of a
+/// hierarchical pixelization (HTM, Q3C, MQ3C or HEALPix) at a single
+/// subdivision level, as when building survey depth or source density maps.
+///
+/// Only pixels with non-zero weight are stored, as runs of consecutive
+/// pixels sharing the same weight. Weights added for individual pixel
+/// indexes (e.g. from Pixelization::index) usually form runs of length 1,
+/// while adding a weight for all the pixels of a RangeSet (e.g. from
+/// Pixelization::envelope) adds a few long runs. So unlike a dense array
+/// indexed by pixel, memory use is proportional to the number of distinct
+/// runs rather than to the number of pixels at the map level.
+///
+/// Pixel indexes are not validated, since the map does not know which
+/// pixelization they come from. Any indexes whose parents are obtained by
+/// dropping the two least significant bits per level can be used.
+class PixelCountMap {
+public:
+    /// This constructor creates an empty map for pixels at the given level.
+    /// It throws std::invalid_argument if `level` is not in [0, 30].
+    explicit PixelCountMap(int level);
+
+    bool operator==(PixelCountMap const & m) const {
+        return _level == m._level && _runs == m._runs;
+    }
+
+    bool operator!=(PixelCountMap const & m) const { return !(*this == m); }
+
+    /// `getLevel` returns the subdivision level of the map pixels.
+    int getLevel() const { return _level; }
+
+    /// `empty` checks whether all pixels have a weight of 0.
+    bool empty() const { return _runs.size() == 0; }
+
+    /// `size` returns the number of runs of pixels with equal weights.
+    size_t size() const { return _runs.size(); }
+
+    /// `getNumPixels` returns the number of pixels with non-zero weight,
+    /// modulo 2⁶⁴.
+    uint64_t getNumPixels() const;
+
+    /// `get` returns the weight of the pixel with index i.
+    double get(uint64_t i) const;
+
+    /// `total` returns the sum of the weights of all pixels.
+    double total() const;
+
+    /// `add` adds `weight` to the weight of the pixel with index i. This
+    /// takes time linear in the size of the map, so that the batch method
+    /// should be used to add more than a handful of pixels.
+    void add(uint64_t i, double weight = 1.0);
+
+    /// `add` adds `weights[k]` to the weight of pixel `indexes[k]`, for k in
+    /// [0, n). If `weights` is null, each occurrence of an index adds 1.
+    ///
+    /// If `numThreads` is greater than one, the input is split into that
+    /// many blocks, each of which is sorted and accumulated into a separate
+    /// buffer by its own thread, and the buffers are merged at the end. The
+    /// results do not depend on the number of threads, except for the
+    /// order in which floating point weights are summed.
+    void add(uint64_t const * indexes,
+             double const * weights,
+             size_t n,
+             unsigned numThreads = 1);
+
+    /// `add` adds `weight` to the weights of all the pixels in s.
+    void add(RangeSet const & s, double weight = 1.0);
+
+    /// `add` adds the weights of the pixels in m to those in this map. It
+    /// throws std::invalid_argument if the maps have different levels.
+    void add(PixelCountMap const & m);
+
+    /// `coarsened` returns a map at the given coarser level, in which the
+    /// weight of each pixel is the sum of the weights of its descendants in
+    /// this map. It throws std::invalid_argument if `level` is not in
+    /// [0, getLevel()].
+    PixelCountMap coarsened(int level) const;
+
+    /// `getPixels` returns the indexes of the pixels with non-zero weight.
+    RangeSet getPixels() const;
+
+    /// `getRuns` returns the pixels with non-zero weight and their weights
+    /// in columnar form.
+    PixelCountRuns getRuns() const;
+
+private:
+    // Run i consists of the pixels [first[i], last[i]], which all have the
+    // weight value[i]. Inclusive bounds avoid overflow for the last pixel of
+    // a level 30 MQ3C pixelization.
+    struct Runs {
+        std::vector<uint64_t> first;
+        std::vector<uint64_t> last;
+        std::vector<double> value;
+
+        bool operator==(Runs const & r) const {
+            return first == r.first && last == r.last && value == r.value;
+        }
+
+        size_t size() const { return value.size(); }
+
+        // `append` adds a run after all existing ones. Runs with a weight of
+        // 0 are dropped, and a run adjacent to the last one and with the
+        // same weight is coalesced with it.
+        void append(uint64_t f, uint64_t l, double v);
+    };
+
+    // `_merge` returns the runs of the sum of the weights in a and b.
+    static Runs _merge(Runs const & a, Runs const & b);
+
+    int _level;
+    Runs _runs;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_PIXELCOUNTMAP_H_
@@ -0,0 +1,168 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PIXELREGION_H_
+#define LSST_SPHGEOM_PIXELREGION_H_
+
+/// \file
+/// \brief This file declares a class for representing regions made up of
+///        pixels.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "BoundsCache.h"
+#include "CompoundRegion.h"
+#include "ConvexPolygon.h"
+#include "Pixelization.h"
+#include "RangeSet.h"
+#include "Region.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `PixelRegion` is the union of a set of pixels from a pixelization,
+/// for example a coverage map stored as the indexes of level 12 HTM
+/// trixels. It is typically far cheaper to work with than the union of
+/// the corresponding pixel polygons: testing whether a point is inside
+/// it costs a call to Pixelization::index and a binary search of the
+/// pixel index ranges.
+///
+/// Relationships with other regions are computed by comparing the pixels
+/// of this region with the envelope and interior of the other region in
+/// the same pixelization, so they are conservative in the same way that
+/// envelope() and interior() are. The relationships between two pixel
+/// regions of the same pixelization are computed exactly from their pixel
+/// sets.
+///
+/// HTM, Q3C, modified Q3C and HEALPix pixelizations are supported. Pixel
+/// regions are immutable, and their bounding primitives are computed on
+/// first use.
+class PixelRegion : public Region {
+public:
+    static constexpr uint8_t TYPE_CODE = 'm';
+
+    /// This constructor creates the region made up of the given pixels
+    /// of `pixelization`. It throws std::invalid_argument if the type of
+    /// `pixelization` is not supported, or if `pixels` contains indexes
+    /// outside of its universe.
+    PixelRegion(Pixelization const & pixelization, RangeSet pixels);
+
+    PixelRegion(PixelRegion const &) = default;
+    PixelRegion & operator=(PixelRegion const &) = default;
+
+    /// Two pixel regions are equal if they consist of the same pixels of
+    /// equivalent pixelizations.
+    bool operator==(PixelRegion const & r) const {
+        return _pixels == r._pixels &&
+               _pixelization->getCacheKey() == r._pixelization->getCacheKey();
+    }
+
+    bool operator!=(PixelRegion const & r) const { return !(*this == r); }
+
+    /// `getPixelization` returns the pixelization of this region.
+    Pixelization const & getPixelization() const { return *_pixelization; }
+
+    /// `getLevel` returns the subdivision level of the pixelization.
+    int getLevel() const { return _level; }
+
+    /// `getPixels` returns the indexes of the pixels in this region.
+    RangeSet const & getPixels() const { return _pixels; }
+
+    /// `isEmpty` returns true if this region contains no pixels.
+    bool isEmpty() const { return _pixels.empty(); }
+
+    /// `getPolygons` returns a small number of convex polygons with
+    /// disjoint interiors whose union is this region, e.g. for clients that
+    /// only understand polygons. Complete groups of sibling pixels are
+    /// merged into their parent, and neighboring pixels are then merged for
+    /// as long as the result is convex. The polygons may differ from the
+    /// union of the pixels by rounding errors, and for HEALPix, whose
+    /// pixel edges are not great circles, by the approximation of each
+    /// pixel as a polygon made by Pixelization::pixel.
+    std::vector<ConvexPolygon> getPolygons() const;
+
+    /// `toUnionRegion` returns the union of the polygons returned by
+    /// getPolygons().
+    std::unique_ptr<UnionRegion> toUnionRegion() const;
+
+    // Region interface.
+    std::unique_ptr<Region> clone() const override {
+        return std::unique_ptr<PixelRegion>(new PixelRegion(*this));
+    }
+
+    Box getBoundingBox() const override;
+    Box3d getBoundingBox3d() const override;
+    Circle getBoundingCircle() const override;
+
+    bool contains(UnitVector3d const & v) const override {
+        return _pixels.contains(_pixelization->index(v));
+    }
+
+    /// `contains` tests whether each of the `n` points (x[i], y[i], z[i])
+    /// is inside this region. The points are indexed in blocks, and the
+    /// indexes of each block are looked up in the pixel set together.
+    void contains(double const * x, double const * y, double const * z,
+                  bool * out, size_t n) const override;
+
+    using Region::contains;
+
+    Relationship relate(Region const & r) const override;
+    Relationship relate(Box const & b) const override;
+    Relationship relate(Circle const & c) const override;
+    Relationship relate(ConvexPolygon const & p) const override;
+    Relationship relate(Ellipse const & e) const override;
+
+    std::vector<uint8_t> encode() const override;
+    void encodeTo(std::vector<uint8_t> & buffer) const override;
+
+    ///@{
+    /// `decode` deserializes a PixelRegion from a byte string produced by
+    /// encode. It throws std::runtime_error if the byte string is invalid.
+    static std::unique_ptr<PixelRegion> decode(std::vector<uint8_t> const & s) {
+        return decode(s.data(), s.size());
+    }
+    static std::unique_ptr<PixelRegion> decode(uint8_t const * buffer,
+                                               size_t n);
+    ///@}
+
+private:
+    PixelRegion(std::shared_ptr<Pixelization const> pixelization,
+                uint8_t kind, int level, RangeSet pixels);
+
+    // `_relate` relates this region to a region other than a pixel region
+    // of the same pixelization.
+    Relationship _relate(Region const & r) const;
+
+    std::shared_ptr<Pixelization const> _pixelization;
+    RangeSet _pixels;
+    uint8_t _kind;
+    int _level;
+    BoundsCache _bounds;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_PIXELREGION_H_
@@ -26,8 +26,14 @@
 /// \file
 /// \brief This file defines an interface for pixelizations of the sphere.
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
+#include "ProgressiveEnvelope.h"
 #include "RangeSet.h"
 
 
@@ -36,7 +42,57 @@ namespace sphgeom {
 
 class Region;
 class UnitVector3d;
+class UnitVector3dArray;
 
+/// A `FlatRangeSets` holds a sequence of pixel index sets in compressed
+/// sparse row form, as computed by Pixelization::envelopeManyFlat. The
+/// ranges of the i-th set are [bounds[2j], bounds[2j + 1]) for j in
+/// [offsets[i], offsets[i + 1]), where, as in RangeSet, an end of 0 stands
+/// for 2⁶⁴. Storing all ranges in two arrays avoids allocating memory per
+/// set.
+struct FlatRangeSets {
+    std::vector<size_t> offsets;
+    std::vector<uint64_t> bounds;
+
+    /// `size` returns the number of sets.
+    size_t size() const { return offsets.empty() ? 0 : offsets.size() - 1; }
+
+    /// `get` returns the i-th set.
+    RangeSet get(size_t i) const;
+};
+
+/// A `CoverageFractions` holds the fractions of the areas of pixels that are
+/// covered by a region, as computed by Pixelization::coverageFraction, in
+/// columnar form. Each of the pixels with indexes in [begin[i], end[i]) is
+/// covered to the fraction fraction[i] ∈ (0, 1]. Runs are sorted and
+/// disjoint. Pixels within the region form runs with a fraction of 1, which
+/// may span many pixels, and each pixel straddling the region boundary forms
+/// a run of its own. Pixels disjoint from the region are omitted.
+struct CoverageFractions {
+    std::vector<uint64_t> begin;
+    std::vector<uint64_t> end;
+    std::vector<double> fraction;
+
+    /// `size` returns the number of runs.
+    size_t size() const { return fraction.size(); }
+};
+
+/// An `EnvelopeAndInterior` holds the pixels intersecting a region and the
+/// pixels within it, as computed by Pixelization::envelopeAndInterior.
+struct EnvelopeAndInterior {
+    RangeSet envelope;
+    RangeSet interior;
+};
+
+/// An `EnvelopeUpdate` holds the envelope of a region that has replaced an
+/// earlier one, as computed by Pixelization::updateEnvelope, along with the
+/// pixels that were added to and removed from the envelope of the earlier
+/// region.
+struct EnvelopeUpdate {
+    RangeSet envelope;
+    RangeSet added;
+    RangeSet removed;
+};
 
 /// A `Pixelization` (or partitioning) of the sphere is a mapping between
 /// points on the sphere and a set of pixels (a.k.a. cells or partitions)
@@ -74,6 +130,9 @@ class UnitVector3d;
 ///
 ///      RangeSet exterior = pixelization.universe() -
 ///                          pixelization.envelope(r);
+///
+/// Pixelizations are immutable, and all of their methods may be called
+/// concurrently from several threads.
 class Pixelization {
 public:
     virtual ~Pixelization() {}
@@ -96,9 +155,88 @@ public:
     /// `index` computes the index of the pixel for v.
     virtual uint64_t index(UnitVector3d const & v) const = 0;
 
+    /// `index` computes the pixel indexes of n points in one call. The i-th
+    /// point is `UnitVector3d(x[i], y[i], z[i])`, and its pixel index is
+    /// written to `out[i]`; the input components therefore need not be
+    /// normalized, but must not all be zero.
+    ///
+    /// The default implementation simply calls the single point method in a
+    /// loop. Subclasses are expected to override it with an implementation
+    /// that hoists the per-call setup out of the loop.
+    virtual void index(double const * x,
+                       double const * y,
+                       double const * z,
+                       uint64_t * out,
+                       size_t n) const;
+
+    /// `index` is equivalent to `index(x, y, z, out, n)`, except that if
+    /// `numThreads` is greater than one, blocks of points are divided among
+    /// that many threads, including the calling thread. The results do not
+    /// depend on the number of threads.
+    void index(double const * x,
+               double const * y,
+               double const * z,
+               uint64_t * out,
+               size_t n,
+               unsigned numThreads) const;
+
+    /// `index` computes the pixel indexes of the given points, and writes
+    /// them to `out`, which must have room for `points.size()` values.
+    void index(UnitVector3dArray const & points, uint64_t * out) const;
+
     /// `toString` converts the given pixel index to a human-readable string.
     virtual std::string toString(uint64_t i) const = 0;
 
+    /// `toString` converts n pixel indexes to strings without allocating
+    /// memory. The string for `indexes[k]` is written to the `width`
+    /// characters starting at `out + k * width`, followed by NUL characters
+    /// if it is shorter; this is the layout of a NumPy `S<width>` array.
+    ///
+    /// If an index is invalid, or its string is longer than `width`, a
+    /// std::invalid_argument is thrown.
+    ///
+    /// The default implementation calls the single index method in a loop.
+    /// Subclasses are expected to override it with one that formats
+    /// directly into `out`.
+    virtual void toString(uint64_t const * indexes,
+                          size_t n,
+                          char * out,
+                          size_t width) const;
+
+    /// `maxStringLength` returns the length of the longest string produced
+    /// by toString for a pixel index at the subdivision level of this
+    /// pixelization.
+    virtual size_t maxStringLength() const = 0;
+
+    /// `fromString` is the inverse of toString: it returns the pixel index
+    /// described by the n characters starting at s.
+    ///
+    /// If these do not form a valid pixel string, a std::invalid_argument
+    /// is thrown.
+    virtual uint64_t fromString(char const * s, size_t n) const = 0;
+
+    uint64_t fromString(std::string const & s) const {
+        return fromString(s.data(), s.size());
+    }
+
+    /// `fromString` parses n fixed-width strings laid out as by the
+    /// toString overload above, and writes the corresponding pixel indexes
+    /// to `out`. Trailing NUL characters in each `width` character field
+    /// are ignored.
+    ///
+    /// If a string is invalid, a std::invalid_argument is thrown.
+    void fromString(char const * in,
+                    size_t n,
+                    size_t width,
+                    uint64_t * out) const;
+
+    /// `getCacheKey` returns a string identifying this pixelization, such
+    /// that pixelizations with the same key assign the same indexes to all
+    /// points, for use in caches of pixelization results. The default
+    /// implementation returns an empty string, which means that results
+    /// must not be cached.
+    virtual std::string getCacheKey() const { return std::string(); }
+
     /// `envelope` returns the indexes of the pixels intersecting the
     /// spherical region r.
     ///
@@ -128,8 +266,14 @@ public:
     /// pixelization like Q3C or HTM will lower the subdivision level when
     /// too many ranges have been found. Each coarse pixel I at level L - n
     /// corresponds to pixels [I*4ⁿ, (I + 1)*4ⁿ) at level L.
-    RangeSet envelope(Region const & r, size_t maxRanges = 0) const {
-        return _envelope(r, maxRanges);
+    ///
+    /// If `numThreads` is greater than one, implementations may use up to
+    /// that many threads to traverse the pixel hierarchy. This does not
+    /// change the return value.
+    RangeSet envelope(Region const & r,
+                      size_t maxRanges = 0,
+                      unsigned numThreads = 1) const {
+        return _envelope(r, maxRanges, numThreads);
     }
 
     /// `interior` returns the indexes of the pixels within the spherical
@@ -139,14 +283,246 @@ public:
     /// envelope() argument. The only difference is that implementations must
     /// remove interior pixels to keep the number of ranges at or below the
     /// maximum. The return value is therefore always a subset of the interior
-    /// pixels.
-    RangeSet interior(Region const & r, size_t maxRanges = 0) const {
-        return _interior(r, maxRanges);
+    /// pixels. The same goes for `numThreads`.
+    RangeSet interior(Region const & r,
+                      size_t maxRanges = 0,
+                      unsigned numThreads = 1) const {
+        return _interior(r, maxRanges, numThreads);
+    }
+
+    /// `envelopeAndInterior` returns both envelope(r, maxRanges) and
+    /// interior(r, maxRanges), for callers such as query planners that need
+    /// the pixels whose contents may intersect r as well as those whose
+    /// contents are all within it.
+    ///
+    /// Hierarchical pixelizations find both sets in a single traversal,
+    /// relating each pixel to r only once: the pixels within r are the
+    /// interior, and adding the pixels at the target level that straddle the
+    /// boundary of r yields the envelope. With a non-zero `maxRanges`, the
+    /// sets are then coarsened separately, which can leave them tighter
+    /// than those of envelope() and interior(), whose traversals stop
+    /// subdividing early instead. Ellipses, which are bounded separately
+    /// from outside and inside, are still traversed twice. The default
+    /// implementation calls envelope() and interior().
+    EnvelopeAndInterior envelopeAndInterior(Region const & r,
+                                            size_t maxRanges = 0) const {
+        return _envelopeAndInterior(r, maxRanges);
+    }
+
+    /// `updateEnvelope` returns the envelope of the region r, which replaces
+    /// a region `previous` with the envelope `previousEnvelope` (computed
+    /// with the same `maxRanges`), together with the pixels that the change
+    /// adds to and removes from that envelope. This suits regions that move
+    /// or change shape slightly from one call to the next, as when tracking
+    /// a moving field of view, and whose consumers only need to act on the
+    /// pixels that changed.
+    ///
+    /// If r and `previous` have the same encoding, `previousEnvelope` is
+    /// returned with empty deltas, without any traversal. Otherwise the
+    /// envelope of r is computed in full: hierarchical traversal only visits
+    /// the pixels along the boundary of r, which is cheaper than testing the
+    /// boundary pixels of the previous envelope and their neighbors
+    /// individually. The deltas are then obtained by set differences, in
+    /// time linear in the number of ranges.
+    EnvelopeUpdate updateEnvelope(Region const & previous,
+                                  RangeSet const & previousEnvelope,
+                                  Region const & r,
+                                  size_t maxRanges = 0,
+                                  unsigned numThreads = 1) const;
+
+    ///@{
+    /// `envelopeMany` and `interiorMany` return the envelopes (or interiors)
+    /// of many regions, in the order of `regions`. The region pointers
+    /// must not be null.
+    ///
+    /// Regions are processed in the order of the centers of their bounding
+    /// circles along a space filling curve, so that consecutive regions lie
+    /// close together, and blocks of regions are divided among `numThreads`
+    /// threads. Hierarchical pixelizations may start the traversal for a
+    /// region at the smallest pixel found to contain it, rather than at the
+    /// root pixels. Such an envelope contains every pixel that intersects
+    /// the region, but may omit pixels that envelope() reports only because
+    /// its relationship tests are conservative. Traversal statistics are
+    /// not recorded.
+    std::vector<RangeSet> envelopeMany(std::vector<Region const *> const & regions,
+                                       size_t maxRanges = 0,
+                                       unsigned numThreads = 1) const;
+
+    std::vector<RangeSet> interiorMany(std::vector<Region const *> const & regions,
+                                       size_t maxRanges = 0,
+                                       unsigned numThreads = 1) const;
+    ///@}
+
+    ///@{
+    /// `envelopeManyFlat` and `interiorManyFlat` compute the same pixel sets
+    /// as envelopeMany() and interiorMany(), but store them in a single
+    /// FlatRangeSets, which is much cheaper than creating a RangeSet per
+    /// region when there are many small regions.
+    FlatRangeSets envelopeManyFlat(std::vector<Region const *> const & regions,
+                                   size_t maxRanges = 0,
+                                   unsigned numThreads = 1) const;
+
+    FlatRangeSets interiorManyFlat(std::vector<Region const *> const & regions,
+                                   size_t maxRanges = 0,
+                                   unsigned numThreads = 1) const;
+    ///@}
+
+    /// `adaptiveEnvelope` returns the indexes of a set of pixels covering the
+    /// spherical region r, choosing the subdivision depth separately for each
+    /// part of the region in a single traversal.
+    ///
+    /// Rather than finding all intersecting pixels at the target level and
+    /// then coarsening the result until it has at most `maxRanges` ranges,
+    /// as envelope() does, hierarchical pixelizations subdivide the largest
+    /// pixels intersecting the boundary of r first, and stop just before the
+    /// result would have more than `targetRanges` ranges, or once the total
+    /// nominal area of the pixels straddling the boundary (which bounds the
+    /// area of the result outside of r) is at most `areaBudget` steradians.
+    /// A `targetRanges` of zero imposes no limit, and with a zero area
+    /// budget as well the result is the same as that of envelope().
+    ///
+    /// The result is a superset of the intersecting pixels, and has at
+    /// most `targetRanges` ranges unless the root pixels intersecting r
+    /// already have more, in which case envelope(r, targetRanges) is
+    /// returned. The default implementation always does the latter.
+    RangeSet adaptiveEnvelope(Region const & r,
+                              size_t targetRanges,
+                              double areaBudget = 0.0) const {
+        return _adaptiveEnvelope(r, targetRanges, areaBudget);
+    }
+
+    /// `adaptiveInterior` is the counterpart of adaptiveEnvelope() for
+    /// interior pixels. The result is a subset of the pixels within r, and
+    /// the area budget bounds the area of r that is not covered by it.
+    RangeSet adaptiveInterior(Region const & r,
+                              size_t targetRanges,
+                              double areaBudget = 0.0) const {
+        return _adaptiveInterior(r, targetRanges, areaBudget);
+    }
+
+    /// `progressiveEnvelope` returns an envelope of the spherical region r
+    /// that is computed on demand, so that callers with a latency budget can
+    /// stop refining it at any time and still obtain a superset of the
+    /// intersecting pixels (see ProgressiveEnvelope). Initially it only
+    /// contains the root pixels intersecting r, and once fully refined its
+    /// ranges are equal to those of envelope(r).
+    ///
+    /// Hierarchical pixelizations refine the largest pixels straddling the
+    /// boundary of r first, as adaptiveEnvelope() does. The region is copied,
+    /// so it need not outlive the envelope. The default implementation
+    /// returns an envelope that is already complete.
+    ProgressiveEnvelope progressiveEnvelope(Region const & r) const {
+        return _progressiveEnvelope(r);
+    }
+
+    /// `coverageFraction` returns the fraction of the area of each pixel
+    /// that is covered by the region r, which must be a ConvexPolygon,
+    /// Circle or Box. The area of a pixel is that of the polygon returned by
+    /// pixel(), and the covered area is computed exactly (up to rounding
+    /// errors) by overlapArea().
+    ///
+    /// Hierarchical pixelizations find the pixels within r and those
+    /// straddling its boundary in a single traversal, so that only the
+    /// latter are clipped against r. The default implementation computes
+    /// the envelope and interior of r separately.
+    ///
+    /// \throws std::invalid_argument if r is of some other type.
+    CoverageFractions coverageFraction(Region const & r) const {
+        return _coverageFraction(r);
+    }
+
+    /// `envelope` returns the indexes of the pixels intersecting the union
+    /// of the pixels of another pixelization (or of this pixelization at
+    /// another subdivision level) with the given indexes. This converts
+    /// pixel sets between pixelizations without computing a region per
+    /// source pixel.
+    ///
+    /// Hierarchical pixelizations implement this by top down traversal of
+    /// their own pixels. A pixel P is related to the source pixels by
+    /// computing the envelope E of P in `from`: P is disjoint from the
+    /// source pixels if E is, and is covered by them if they contain all of
+    /// E, in which case P is output without visiting its children. The
+    /// result may therefore include pixels that come close to, but do not
+    /// intersect the source pixels.
+    ///
+    /// The `maxRanges` and `numThreads` arguments are as for the region
+    /// version of this method.
+    RangeSet envelope(Pixelization const & from,
+                      RangeSet const & pixels,
+                      size_t maxRanges = 0,
+                      unsigned numThreads = 1) const {
+        return _envelope(from, pixels, maxRanges, numThreads);
+    }
+
+    /// `interior` returns the indexes of the pixels that are covered by the
+    /// union of the pixels of `from` with the given indexes. Pixels are only
+    /// output if they are conclusively covered, as described for envelope(),
+    /// so the result may omit pixels that are only just covered.
+    RangeSet interior(Pixelization const & from,
+                      RangeSet const & pixels,
+                      size_t maxRanges = 0,
+                      unsigned numThreads = 1) const {
+        return _interior(from, pixels, maxRanges, numThreads);
     }
 
+protected:
+    /// A `RangeSetSink` receives the pixel set computed for the region at
+    /// the given position in a batch. The set may be modified or reused
+    /// once the sink returns.
+    using RangeSetSink = std::function<void(size_t, RangeSet &)>;
+
 private:
-    virtual RangeSet _envelope(Region const & r, size_t maxRanges) const = 0;
-    virtual RangeSet _interior(Region const & r, size_t maxRanges) const = 0;
+    virtual RangeSet _envelope(Region const & r,
+                               size_t maxRanges,
+                               unsigned numThreads) const = 0;
+    virtual RangeSet _interior(Region const & r,
+                               size_t maxRanges,
+                               unsigned numThreads) const = 0;
+
+    virtual RangeSet _adaptiveEnvelope(Region const & r,
+                                       size_t targetRanges,
+                                       double areaBudget) const;
+    virtual RangeSet _adaptiveInterior(Region const & r,
+                                       size_t targetRanges,
+                                       double areaBudget) const;
+
+    virtual ProgressiveEnvelope _progressiveEnvelope(Region const & r) const;
+
+    virtual CoverageFractions _coverageFraction(Region const & r) const;
+
+    virtual EnvelopeAndInterior _envelopeAndInterior(Region const & r,
+                                                     size_t maxRanges) const;
+
+    // `_findMany` computes the envelope (or interior, if `interior` is true)
+    // of each of the n regions in turn, passing each to `sink`. The default
+    // implementation calls _envelope or _interior for each region.
+    virtual void _findMany(Region const * const * regions,
+                           size_t n,
+                           size_t maxRanges,
+                           bool interior,
+                           RangeSetSink const & sink) const;
+
+    // `_findManyOrdered` sorts regions and divides them among threads for
+    // _findMany. The sink is called concurrently, with the position of the
+    // region in sorted order and in `regions`.
+    void _findManyOrdered(
+        std::vector<Region const *> const & regions,
+        size_t maxRanges,
+        unsigned numThreads,
+        bool interior,
+        std::function<void(size_t, size_t, RangeSet &)> const & sink) const;
+
+    // The default implementations of pixel set conversion relate the
+    // pixels of `from` to this pixelization one at a time. They are
+    // overridden by all the pixelizations in this library.
+    virtual RangeSet _envelope(Pixelization const & from,
+                               RangeSet const & pixels,
+                               size_t maxRanges,
+                               unsigned numThreads) const;
+    virtual RangeSet _interior(Pixelization const & from,
+                               RangeSet const & pixels,
+                               size_t maxRanges,
+                               unsigned numThreads) const;
 };
 
 }} // namespace lsst::sphgeom
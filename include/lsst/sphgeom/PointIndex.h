@@ -0,0 +1,133 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_POINTINDEX_H_
+#define LSST_SPHGEOM_POINTINDEX_H_
+
+/// \file
+/// \brief This file declares a spatial index over a set of points.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Angle.h"
+#include "Mq3cPixelization.h"
+#include "UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+class UnitVector3dArray;
+
+/// A `PointIndex` is an immutable spatial index over a set of points, for
+/// example a star catalogue. It answers radius and k-nearest-neighbor
+/// queries in time that grows with the number of points near the query
+/// rather than with the total number of points.
+///
+/// Points are stored in the order of their modified Q3C pixel indexes at
+/// a configurable subdivision level, alongside a table of the non-empty
+/// pixels. Radius queries visit the points in the envelope of the query
+/// circle. Nearest neighbor queries scan rings of pixels around the query
+/// point, grown with `Mq3cPixelization::dilate`, until no unvisited point
+/// can be closer than the k-th nearest point found so far. Levels at which
+/// pixels hold a few tens of points on average work well.
+///
+/// Points are identified by their position in the sequence used to
+/// construct the index. An index can be written to a file, and a file can
+/// be memory-mapped rather than read, so that opening even a very large
+/// index is fast, and its pages are shared between processes. Once built,
+/// an index may be queried concurrently from multiple threads.
+class PointIndex {
+public:
+    /// This constructor creates an empty index.
+    PointIndex();
+
+    /// This constructor creates an index over the given points, using the
+    /// given modified Q3C subdivision level. If `numThreads` is greater than
+    /// one, the index is built using that many threads. If `level` is not
+    /// in [0, Mq3cPixelization::MAX_LEVEL], a std::invalid_argument is
+    /// thrown.
+    PointIndex(UnitVector3dArray const & points,
+               int level,
+               unsigned numThreads = 1);
+
+    /// `open` memory-maps the index in the given file, which must have been
+    /// created by `write` on a machine with the same byte order. The file
+    /// stays mapped for as long as the returned index or a copy of it
+    /// exists. A std::runtime_error is thrown if the file cannot be mapped,
+    /// or does not contain an index.
+    static PointIndex open(std::string const & path);
+
+    /// `write` writes this index to the given file. A std::runtime_error
+    /// is thrown if the file cannot be written.
+    void write(std::string const & path) const;
+
+    bool empty() const { return _numPoints == 0; }
+
+    /// `size` returns the number of points in this index.
+    size_t size() const { return _numPoints; }
+
+    /// `getLevel` returns the modified Q3C subdivision level of this index.
+    int getLevel() const { return _pixelization.getLevel(); }
+
+    /// `findWithin` returns the indexes of the points separated from v by
+    /// at most the given radius, in ascending order. Point i is returned
+    /// exactly when `Circle(v, radius).contains(points[i])`.
+    std::vector<size_t> findWithin(UnitVector3d const & v, Angle radius) const;
+
+    /// `findNearest` returns the indexes of the k points closest to v, along
+    /// with their angular separations from v, in order of increasing
+    /// separation. Points at the same distance from v are ordered by index.
+    /// If the index contains fewer than k points, all of them are returned.
+    std::vector<std::pair<size_t, Angle>> findNearest(UnitVector3d const & v,
+                                                      size_t k) const;
+
+private:
+    Mq3cPixelization _pixelization;
+    // The index data, which is either owned or memory-mapped.
+    std::shared_ptr<uint64_t const> _data;
+    size_t _size;
+    size_t _numPoints;
+    size_t _numPixels;
+    // Pointers into _data. The points in pixel _pixels[i] are the points
+    // with positions in [_offsets[i], _offsets[i + 1]).
+    uint64_t const * _pixels;
+    uint64_t const * _offsets;
+    double const * _x;
+    double const * _y;
+    double const * _z;
+    uint64_t const * _indexes;
+
+    void _init(std::shared_ptr<uint64_t const> data, size_t size);
+
+    // `_span` returns the positions of the points in the pixels in [b, e).
+    std::pair<size_t, size_t> _span(uint64_t b, uint64_t e) const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_POINTINDEX_H_
@@ -0,0 +1,166 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_POLYGONMESH_H_
+#define LSST_SPHGEOM_POLYGONMESH_H_
+
+/// \file
+/// \brief This file declares a class for tessellations of the unit sphere
+///        by convex polygons that share vertices and edges.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ConvexPolygon.h"
+#include "Relationship.h"
+#include "UnitVector3d.h"
+#include "Vector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+class Region;
+
+/// A `PolygonMesh` is an immutable collection of convex polygons (faces)
+/// with disjoint interiors, such as the patches of a skymap tract or the
+/// CCDs of a mosaic, in which adjacent faces share vertices and edges.
+///
+/// Identical vertices are stored once, and the plane normal of an edge
+/// shared by two faces is computed once. Faces are identified by their
+/// position in the sequence used to construct the mesh. Each face keeps
+/// the vertex order of the polygon it was built from, so that
+/// `getFace(i)` is equal to that polygon, and `getFace(i).contains(v)`
+/// is always equal to `contains(i, v)`.
+///
+/// Faces that share an edge are neighbors. Points are located by walking
+/// from face to neighboring face towards the point, so that locating a
+/// sequence of nearby points costs a few edge tests per point. Once built,
+/// a mesh may be queried concurrently from multiple threads.
+class PolygonMesh {
+public:
+    /// `NO_FACE` is the face index returned for points not in any face.
+    static constexpr size_t NO_FACE = static_cast<size_t>(-1);
+
+    /// This constructor creates an empty mesh.
+    PolygonMesh() = default;
+
+    /// This constructor creates a mesh from the given faces. Vertices are
+    /// shared when they are exactly equal. A std::invalid_argument is
+    /// thrown if two faces traverse an edge in the same direction, which
+    /// means that they overlap, or if the mesh has 2³² or more vertices
+    /// or corners.
+    explicit PolygonMesh(std::vector<ConvexPolygon> const & faces);
+
+    bool empty() const { return _offsets.size() <= 1; }
+
+    /// `getNumFaces` returns the number of faces in this mesh.
+    size_t getNumFaces() const { return empty() ? 0 : _offsets.size() - 1; }
+
+    /// `getNumEdges` returns the number of distinct edges in this mesh.
+    size_t getNumEdges() const { return _normals.size(); }
+
+    /// `getVertices` returns the distinct vertices of this mesh.
+    std::vector<UnitVector3d> const & getVertices() const { return _vertices; }
+
+    /// `getFaceVertices` returns the indexes in `getVertices()` of the
+    /// vertices of face i, in counter-clockwise order.
+    std::vector<uint32_t> getFaceVertices(size_t i) const {
+        return std::vector<uint32_t>(_corners.begin() + _offsets[i],
+                                     _corners.begin() + _offsets[i + 1]);
+    }
+
+    /// `getFace` returns face i as a polygon.
+    ConvexPolygon getFace(size_t i) const;
+
+    /// `getNeighbor` returns the face sharing edge k of face i, or NO_FACE
+    /// if there is none. Edge k runs from vertex k - 1 (modulo the number
+    /// of vertices) to vertex k of the face.
+    size_t getNeighbor(size_t i, size_t k) const;
+
+    /// `contains` returns true if face i contains v.
+    bool contains(size_t i, UnitVector3d const & v) const {
+        return _exitCorner(i, v, 0) == NO_CORNER;
+    }
+
+    /// `findFace` returns the index of a face containing v, or NO_FACE.
+    /// The search starts at face `hint`, so passing a face close to v, for
+    /// example the face found for a nearby point, makes it faster. If v
+    /// lies on the boundary between faces, any of them may be returned.
+    ///
+    /// When the walk leaves the mesh or fails to make progress, all faces
+    /// are tested, so locating points outside of the mesh costs time
+    /// proportional to its size.
+    size_t findFace(UnitVector3d const & v, size_t hint = 0) const;
+
+    /// `findFaces` stores the index of a face containing `points[i]`, or
+    /// NO_FACE, in `out[i]` for i in [0, n). The search for each point
+    /// starts at the face found for the previous one, so ordering points
+    /// spatially is beneficial. If `numThreads` is greater than one, blocks
+    /// of points are divided among that many threads, including the calling
+    /// thread.
+    void findFaces(UnitVector3d const * points,
+                   size_t n,
+                   size_t * out,
+                   unsigned numThreads = 1) const;
+
+    /// `relate` computes `out[i] = getFace(i).relate(r)` for every face i.
+    /// Each distinct vertex is tested against r once, and faces with
+    /// vertices both inside and outside of r, which can be neither disjoint
+    /// from nor within r, are reported as INTERSECTS without further tests.
+    /// If `numThreads` is greater than one, blocks of faces are divided
+    /// among that many threads, including the calling thread.
+    void relate(Region const & r,
+                Relationship * out,
+                unsigned numThreads = 1) const;
+
+private:
+    static constexpr size_t NO_CORNER = static_cast<size_t>(-1);
+
+    std::vector<UnitVector3d> _vertices;
+    // The corners of face i are [_offsets[i], _offsets[i + 1]). Corner c
+    // holds the index of a vertex in _corners[c], and the index of the
+    // edge ending at that vertex, shifted left by one, in _edges[c]. The
+    // low bit of _edges[c] is set if the face traverses the edge in the
+    // opposite direction to the one its normal was computed for.
+    std::vector<uint32_t> _offsets;
+    std::vector<uint32_t> _corners;
+    std::vector<uint32_t> _edges;
+    // The plane normal of edge e, computed exactly like ConvexPolygon edge
+    // normals, and the faces on its left and right. The face that corner c
+    // belongs to is _edgeFaces[_edges[c]], and its neighbor across the edge
+    // of c is _edgeFaces[_edges[c] ^ 1].
+    std::vector<Vector3d> _normals;
+    std::vector<uint32_t> _edgeFaces;
+
+    // `_exitCorner` returns the first corner, starting from the given
+    // position within face i, whose edge v lies outside of, or NO_CORNER
+    // if face i contains v.
+    size_t _exitCorner(size_t i, UnitVector3d const & v, size_t start) const;
+
+    size_t _scan(UnitVector3d const & v) const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_POLYGONMESH_H_
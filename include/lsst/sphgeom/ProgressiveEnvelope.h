@@ -0,0 +1,113 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PROGRESSIVEENVELOPE_H_
+#define LSST_SPHGEOM_PROGRESSIVEENVELOPE_H_
+
+/// \file
+/// \brief This file declares a class for computing envelopes progressively.
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace detail { class ProgressiveEnvelopeState; }
+
+/// `ProgressiveEnvelope` computes the envelope of a region (see
+/// `Pixelization::envelope`) incrementally, so that the time spent on it
+/// can be bounded without giving up correctness.
+///
+/// It is obtained from `Pixelization::progressiveEnvelope`. Hierarchical
+/// pixelizations start with the root pixels intersecting the region, and
+/// each refinement step subdivides the largest pixel straddling the region
+/// boundary (ties going to the lowest index) and replaces it with its
+/// children that intersect the region. Pixels that have not been subdivided
+/// down to the target level are kept whole in the current result, which is
+/// therefore always a superset of the final envelope. Once there is nothing
+/// left to subdivide, the result is equal to that of `envelope(r)`.
+///
+/// An envelope is movable but not copyable, and not thread safe.
+class ProgressiveEnvelope {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// This constructor is for use by Pixelization implementations.
+    explicit ProgressiveEnvelope(
+        std::unique_ptr<detail::ProgressiveEnvelopeState> state);
+
+    ProgressiveEnvelope(ProgressiveEnvelope &&) noexcept;
+    ProgressiveEnvelope & operator=(ProgressiveEnvelope &&) noexcept;
+    ~ProgressiveEnvelope();
+
+    /// `refine` performs at most `maxSteps` refinement steps, and returns
+    /// true if the envelope is then complete.
+    bool refine(size_t maxSteps);
+
+    /// `refineUntil` performs refinement steps until the envelope is complete
+    /// or `deadline` has passed, and returns true in the former case. The
+    /// clock is read before each step, so the deadline is overrun by at most
+    /// the time it takes to relate the 4 children of a pixel to the region.
+    bool refineUntil(Clock::time_point deadline);
+
+    /// `refineFor` is equivalent to `refineUntil(Clock::now() + timeout)`.
+    template <typename Rep, typename Period>
+    bool refineFor(std::chrono::duration<Rep, Period> const & timeout) {
+        return refineUntil(
+            Clock::now() +
+            std::chrono::duration_cast<Clock::duration>(timeout));
+    }
+
+    /// `isComplete` returns true if the envelope cannot be refined further.
+    bool isComplete() const;
+
+    /// `getRanges` returns the current envelope. It is a superset of the
+    /// result of `envelope(r)`, and is equal to it once the envelope is
+    /// complete.
+    RangeSet const & getRanges() const;
+
+    /// `getCoarsestLevel` returns the subdivision level of the largest pixel
+    /// that is still to be subdivided, or the target level if the envelope
+    /// is complete.
+    int getCoarsestLevel() const;
+
+    /// `getFrontierArea` returns the total nominal area in steradians of the
+    /// pixels that are still to be subdivided. This bounds the area by which
+    /// the current envelope exceeds the complete one.
+    double getFrontierArea() const;
+
+    /// `getNumSteps` returns the number of refinement steps performed so
+    /// far.
+    size_t getNumSteps() const;
+
+private:
+    std::unique_ptr<detail::ProgressiveEnvelopeState> _state;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_PROGRESSIVEENVELOPE_H_
@@ -28,20 +28,33 @@
 ///        scheme.
 
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 #include "ConvexPolygon.h"
+#include "MultiLevelRangeSet.h"
 #include "Pixelization.h"
 
 
 namespace lsst {
 namespace sphgeom {
 
+namespace detail {
+template <int NumVertices> class PixelCache;
+}
+
 /// `Q3cPixelization` provides [Q3C indexing](\ref q3c-original) of points
 /// and regions.
 ///
 /// Instances of this class are immutable and very cheap to copy.
 ///
+/// By default, the pixels of each cube face are numbered in Morton (Z)
+/// order, as in the original Q3C scheme. Hilbert order can be requested
+/// instead. It uses the same faces, pixels and index range, but spatially
+/// compact regions then map to fewer, longer index ranges, because
+/// consecutive Hilbert indexes always correspond to adjacent pixels.
+///
 /// \warning Setting the `maxRanges` argument for envelope() or interior()
 /// to a non-zero value below 4 can result in very poor region pixelizations
 /// regardless of region size. For instance, if `maxRanges` is 1, a non-empty
@@ -52,14 +65,71 @@ public:
     /// The maximum supported cube-face grid resolution is 2^30 by 2^30.
     static constexpr int MAX_LEVEL = 30;
 
+    /// `NUM_VERTICES` is the number of vertices of a Q3C pixel.
+    static constexpr int NUM_VERTICES = 4;
+
     /// This constructor creates a Q3C pixelization of the sphere with
     /// the given subdivision level. If `level` ∉ [0, MAX_LEVEL],
     /// a std::invalid_argument is thrown.
-    explicit Q3cPixelization(int level);
+    ///
+    /// If `cacheSize` is positive, the vertices of up to about that many
+    /// recently used pixels are cached, so that repeated pixel() and quad()
+    /// calls for the same indexes skip recomputing them. The cache is safe
+    /// to use from multiple threads, and is shared by copies of this
+    /// pixelization.
+    ///
+    /// If `hilbertOrder` is true, pixels are numbered in Hilbert rather
+    /// than Morton order within each cube face.
+    explicit Q3cPixelization(int level,
+                             size_t cacheSize = 0,
+                             bool hilbertOrder = false);
 
     /// `getLevel` returns the subdivision level of this pixelization.
     int getLevel() const { return _level; }
 
+    /// `multiLevelEnvelope` returns the pixels intersecting r, as computed by
+    /// envelope(), using the coarsest pixels that represent them exactly.
+    MultiLevelRangeSet multiLevelEnvelope(Region const & r,
+                                          size_t maxRanges = 0,
+                                          unsigned numThreads = 1) const {
+        return MultiLevelRangeSet(envelope(r, maxRanges, numThreads), _level);
+    }
+
+    /// `multiLevelInterior` returns the pixels within r, as computed by
+    /// interior(), using the coarsest pixels that represent them exactly.
+    MultiLevelRangeSet multiLevelInterior(Region const & r,
+                                          size_t maxRanges = 0,
+                                          unsigned numThreads = 1) const {
+        return MultiLevelRangeSet(interior(r, maxRanges, numThreads), _level);
+    }
+
+    ///@{
+    /// `envelopeAtLevels` and `interiorAtLevels` return the pixels
+    /// intersecting (or within) r at each of the given subdivision levels, in
+    /// the order of `levels`; the level of this pixelization is not used.
+    /// All of the sets are collected during a single traversal down to the
+    /// finest level, which passes through the coarser ones, so this is
+    /// cheaper than calling envelope() or interior() once per level.
+    ///
+    /// The set for level l matches that computed for a pixelization at
+    /// level l, except that a traversal for a small region may start at a
+    /// pixel of a finer level known to contain it. The ancestors of that
+    /// pixel are then output whole at the coarser levels, where a
+    /// traversal of their own could have omitted pixels that were only
+    /// reported because relationship tests are conservative.
+    ///
+    /// \throws std::invalid_argument if a level is not in [0, MAX_LEVEL].
+    std::vector<RangeSet> envelopeAtLevels(Region const & r,
+                                           std::vector<int> const & levels) const;
+    std::vector<RangeSet> interiorAtLevels(Region const & r,
+                                           std::vector<int> const & levels) const;
+    ///@}
+
+    /// `isHilbertOrder` returns true if pixels are numbered in Hilbert
+    /// order within each cube face, and false if they are numbered in
+    /// Morton order.
+    bool isHilbertOrder() const { return _hilbert; }
+
     /// `quad` returns the quadrilateral corresponding to the Q3C pixel with
     /// index `i`.
     ///
@@ -74,14 +144,61 @@ public:
     /// If `i` is not a valid Q3C index, a std::invalid_argument is thrown.
     std::vector<uint64_t> neighborhood(uint64_t i) const;
 
+    /// `neighborhood` stores the neighborhood of pixel `i` in ascending
+    /// order in `out` without allocating memory, and returns the number of
+    /// pixels stored. The remaining entries of `out` are set to the largest
+    /// index in the neighborhood, so that every entry is a valid index.
+    ///
+    /// If `i` is not a valid Q3C index, a std::invalid_argument is thrown.
+    int neighborhood(uint64_t i, uint64_t (&out)[9]) const;
+
+    /// `neighborhoods` finds the neighborhoods of the `n` given pixels.
+    /// On return, row p of the n x 9 row-major array `out` holds the
+    /// neighborhood of `indexes[p]`, padded as by the fixed-array
+    /// `neighborhood`, and `counts[p]` is its size.
+    ///
+    /// If any index is not a valid Q3C index, a std::invalid_argument is
+    /// thrown.
+    void neighborhoods(uint64_t const * indexes,
+                       size_t n,
+                       uint64_t * out,
+                       uint8_t * counts) const;
+
+    /// `dilate` returns the indexes of all pixels that can be reached from
+    /// one of the given pixels in at most `k` steps between pixels sharing
+    /// a vertex, i.e. grows `pixels` by k rings of neighbors. Applying it
+    /// with k = 1 to a single pixel yields its neighborhood.
+    ///
+    /// If `pixels` contains indexes outside of universe() or k is negative,
+    /// a std::invalid_argument is thrown.
+    RangeSet dilate(RangeSet const & pixels, int k) const;
+
     RangeSet universe() const override {
         return RangeSet(0, static_cast<uint64_t>(6) << 2 * _level);
     }
 
     std::unique_ptr<Region> pixel(uint64_t i) const override;
 
+    /// `vertices` writes the vertices of the pixels with the `n` given
+    /// indexes to `out`, which must have room for `3 * NUM_VERTICES * n`
+    /// doubles. The storage layout is that of a `double[n][NUM_VERTICES][3]`
+    /// array; vertex order matches pixel(). No memory is allocated, so this
+    /// is much faster than calling pixel() for each index.
+    ///
+    /// If any index is not a valid Q3C index, a std::invalid_argument is
+    /// thrown and the contents of `out` are unspecified.
+    void vertices(uint64_t const * indexes, size_t n, double * out) const;
+
     uint64_t index(UnitVector3d const & v) const override;
 
+    void index(double const * x,
+               double const * y,
+               double const * z,
+               uint64_t * out,
+               size_t n) const override;
+
+    using Pixelization::index;
+
     /// `toString` converts the given Q3C index to a human readable string.
     ///
     /// The first two characters in the return value are always '+X', '+Y',
@@ -89,16 +206,64 @@ public:
     /// face F containing `i`. Each subsequent character is a digit in [0-3]
     /// corresponding to a child pixel index, so that reading the string
     /// from left to right corresponds to descent of the quad-tree overlaid
-    /// on F.
+    /// on F. For Hilbert ordered pixelizations, the digits are Hilbert
+    /// rather than Morton child indexes.
     ///
     /// If i is not a valid Q3C index, a std::invalid_argument is thrown.
     std::string toString(uint64_t i) const override;
 
+    void toString(uint64_t const * indexes,
+                  size_t n,
+                  char * out,
+                  size_t width) const override;
+
+    using Pixelization::toString;
+
+    size_t maxStringLength() const override {
+        return static_cast<size_t>(_level) + 2;
+    }
+
+    /// `fromString` is the inverse of toString. The string must describe
+    /// a pixel at the subdivision level of this pixelization.
+    uint64_t fromString(char const * s, size_t n) const override;
+
+    using Pixelization::fromString;
+
+    std::string getCacheKey() const override {
+        return (_hilbert ? "q3c-hilbert:" : "q3c:") + std::to_string(_level);
+    }
+
 private:
     int _level;
+    bool _hilbert;
+    std::shared_ptr<detail::PixelCache<NUM_VERTICES>> _cache;
+
+    void _vertices(uint64_t i, UnitVector3d * verts) const;
 
-    RangeSet _envelope(Region const & r, size_t maxRanges) const override;
-    RangeSet _interior(Region const & r, size_t maxRanges) const override;
+    RangeSet _envelope(Region const & r,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+    RangeSet _interior(Region const & r,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+    RangeSet _adaptiveEnvelope(Region const & r,
+                               size_t targetRanges,
+                               double areaBudget) const override;
+    RangeSet _adaptiveInterior(Region const & r,
+                               size_t targetRanges,
+                               double areaBudget) const override;
+    ProgressiveEnvelope _progressiveEnvelope(Region const & r) const override;
+    CoverageFractions _coverageFraction(Region const & r) const override;
+    EnvelopeAndInterior _envelopeAndInterior(Region const & r,
+                                             size_t maxRanges) const override;
+    RangeSet _envelope(Pixelization const & from,
+                       RangeSet const & pixels,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
+    RangeSet _interior(Pixelization const & from,
+                       RangeSet const & pixels,
+                       size_t maxRanges,
+                       unsigned numThreads) const override;
 };
 
 }} // namespace lsst::sphgeom
@@ -26,13 +26,16 @@
 /// \file
 /// \brief This file provides a type for representing integer sets.
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <iosfwd>
 #include <iterator>
+#include <memory_resource>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -56,8 +59,8 @@ namespace sphgeom {
 /// > http://www.aanda.org/articles/aa/abs/2015/08/aa26549-15/aa26549-15.html
 ///
 /// The beginning and end points of the disjoint, non-empty, half-open integer
-/// ranges in the set are stored in a std::vector<uint64_t>, with monotonically
-/// increasing values, except for the last one. Each pair of consecutive
+/// ranges in the set are stored in a std::pmr::vector<uint64_t>, with
+/// monotonically increasing values, except for the last one. Each pair of consecutive
 /// elements [begin, end) in the vector is a non-empty half-open range, where
 /// the value of end is defined as the integer obtained by adding one to the
 /// largest element in the range.
@@ -96,6 +99,9 @@ namespace sphgeom {
 ///
 /// The ranges in a set can be iterated over. Set modification may
 /// invalidate all iterators.
+///
+/// As with standard library containers, const methods may be called
+/// concurrently, but modifying a set requires exclusive access to it.
 class RangeSet {
 public:
 
@@ -172,11 +178,19 @@ public:
         uint64_t const * p = nullptr;
     };
 
+    /// The type code of byte strings produced by encode().
+    static constexpr uint8_t TYPE_CODE = 'R';
+
     using difference_type = ptrdiff_t;
     using size_type = size_t;
     using value_type = std::tuple<uint64_t, uint64_t>;
     using const_iterator = Iterator;
+    using allocator_type = std::pmr::polymorphic_allocator<uint64_t>;
 
+    /// The copy constructor allocates from the default memory resource,
+    /// rather than from the one used by the set being copied. Assignment
+    /// preserves the memory resource of the assigned-to set, and the move
+    /// constructor takes the memory resource of the moved-from set.
     RangeSet(RangeSet const &) = default;
     RangeSet(RangeSet &&) = default;
     RangeSet & operator=(RangeSet const &) = default;
@@ -185,6 +199,22 @@ public:
     /// The default constructor creates an empty set.
     RangeSet() = default;
 
+    ///@{
+    /// These constructors create an empty set, or a copy of `s`, with
+    /// storage obtained from the given allocator. Passing a pointer to a
+    /// `std::pmr::monotonic_buffer_resource`, for instance, makes the set
+    /// and the sets derived from it by the set operations below allocate
+    /// from an arena. A memory resource is generally not thread-safe, so
+    /// such a set must only be modified by one thread at a time.
+    explicit RangeSet(allocator_type const & alloc) : _ranges({0, 0}, alloc) {}
+
+    RangeSet(RangeSet const & s, allocator_type const & alloc) :
+        _ranges(s._ranges, alloc), _offset(s._offset) {}
+
+    RangeSet(RangeSet && s, allocator_type const & alloc) :
+        _ranges(std::move(s._ranges), alloc), _offset(s._offset) {}
+    ///@}
+
     ///@{
     /// This constructor creates a set containing the given integer(s)
     /// or integer range(s).
@@ -221,6 +251,9 @@ public:
     /// This generic constructor creates a set containing the integers or
     /// ranges obtained by dereferencing the iterators in [a, b).
     ///
+    /// Integers are inserted in bulk, as if by insertMany(), so they need
+    /// not be sorted for construction to run in linear time.
+    ///
     /// It is hidden via SFINAE if InputIterator is not a standard
     /// input iterator.
     template <
@@ -233,9 +266,8 @@ public:
         >::type
     >
     RangeSet(InputIterator a, InputIterator b) {
-        for (; a != b; ++a) {
-            insert(*a);
-        }
+        _insertAll(a, b, std::is_integral<
+            typename std::iterator_traits<InputIterator>::value_type>());
     }
 
     /// This generic constructor creates a set containing the integers or
@@ -299,6 +331,45 @@ public:
     void insert(uint64_t first, uint64_t last);
     ///@}
 
+    /// `append` adds the integers in [first, last) to this set, like insert.
+    ///
+    /// It is intended for producers that generate ranges in ascending order,
+    /// e.g. pixelization tree traversals. If this set is non-empty,
+    /// first < last, and first is greater than or equal to the beginning
+    /// point of the last range in this set, then the new range is coalesced
+    /// with or placed after the last range inline, without any of the
+    /// searching done by insert. Otherwise, append is equivalent to insert.
+    /// It is strongly exception safe.
+    void append(uint64_t first, uint64_t last) {
+        uint64_t * rend = const_cast<uint64_t *>(_end());
+        if (rend == _begin() || rend[-1] == 0 ||
+            first < rend[-2] || first >= last) {
+            insert(first, last);
+        } else if (first <= rend[-1]) {
+            // [first, last) extends the last range in this set.
+            rend[-1] = std::max(rend[-1], last);
+        } else {
+            // [first, last) follows the last range in this set, which is
+            // bounded, so rend points to the trailing bookend.
+            size_t const size = _ranges.size();
+            if (_ranges.capacity() < size + 2) {
+                _ranges.reserve(2 * size);
+            }
+            _ranges.back() = first;
+            _ranges.push_back(last);
+            _ranges.push_back(0);
+        }
+    }
+
+    /// `insertMany` adds the n integers in the given array to this set.
+    ///
+    /// The integers need not be sorted or distinct. They are copied and
+    /// radix sorted, runs of consecutive integers are collapsed into ranges,
+    /// and the resulting set is built in a single pass, so that the run time
+    /// is O(n + N), where N is the number of ranges in this set. It is
+    /// strongly exception safe.
+    void insertMany(uint64_t const * values, size_t n);
+
     ///@{
     /// `erase` removes the given integers from this set.
     ///
@@ -329,7 +400,7 @@ public:
 
     /// `complemented` returns a complemented copy of this set.
     RangeSet complemented() const {
-        RangeSet s(*this);
+        RangeSet s(*this, get_allocator());
         s.complement();
         return s;
     }
@@ -347,28 +418,74 @@ public:
     /// this set and s.
     RangeSet symmetricDifference(RangeSet const & s) const;
 
-    /// The ~ operator returns the complement of this set.
-    RangeSet operator~() const {
-        RangeSet s(*this);
+    ///@{
+    /// `unionAll` returns the union of the given sets, and `intersectAll`
+    /// returns their intersection. The union of no sets is empty, and their
+    /// intersection is full.
+    ///
+    /// Rather than combining sets pairwise, the boundaries of all the sets
+    /// are merged in a single sweep using a heap, which takes O(N log k)
+    /// time for k sets with a total of N ranges. If `numThreads` is greater
+    /// than one, the integers are split into disjoint intervals that are
+    /// swept concurrently by up to that many threads. The result is the same
+    /// in either case.
+    static RangeSet unionAll(std::vector<RangeSet> const & sets,
+                             unsigned numThreads = 1) {
+        return _combineAll(sets, 1, numThreads);
+    }
+
+    static RangeSet intersectAll(std::vector<RangeSet> const & sets,
+                                 unsigned numThreads = 1) {
+        return _combineAll(sets, sets.size(), numThreads);
+    }
+    ///@}
+
+    ///@{
+    /// The ~, &, | and - operators return the complement of this set, and
+    /// its intersection, union and difference with s. When this set is a
+    /// temporary, the result is computed in place, as if by the
+    /// corresponding assignment operator, and reuses its storage. An
+    /// expression like `((a & b) | c) - d` therefore allocates memory only
+    /// for the result of `a & b`, and when that result must grow.
+    RangeSet operator~() const & {
+        RangeSet s(*this, get_allocator());
         s.complement();
         return s;
     }
 
-    /// The & operator returns the intersection of this set and s.
-    RangeSet operator&(RangeSet const & s) const {
+    RangeSet operator~() && {
+        complement();
+        return std::move(*this);
+    }
+
+    RangeSet operator&(RangeSet const & s) const & {
         return intersection(s);
     }
 
-    /// The | operator returns the union of this set and s.
-    RangeSet operator|(RangeSet const & s) const {
+    RangeSet operator&(RangeSet const & s) && {
+        *this &= s;
+        return std::move(*this);
+    }
+
+    RangeSet operator|(RangeSet const & s) const & {
         return join(s);
     }
 
-    /// The - operator returns the difference between this set and s.
-    RangeSet operator-(RangeSet const & s) const {
+    RangeSet operator|(RangeSet const & s) && {
+        *this |= s;
+        return std::move(*this);
+    }
+
+    RangeSet operator-(RangeSet const & s) const & {
         return difference(s);
     }
 
+    RangeSet operator-(RangeSet const & s) && {
+        *this -= s;
+        return std::move(*this);
+    }
+    ///@}
+
     /// The ^ operator returns the symmetric difference between this set and s.
     RangeSet operator^(RangeSet const & s) const {
         return symmetricDifference(s);
@@ -378,8 +495,7 @@ public:
     /// It is strongly exception safe.
     RangeSet & operator&=(RangeSet const & s) {
         if (this != &s) {
-            RangeSet r = intersection(s);
-            swap(r);
+            _intersectInPlace(s._begin(), s._end(), false);
         }
         return *this;
     }
@@ -388,8 +504,9 @@ public:
     /// It is strongly exception safe.
     RangeSet & operator|=(RangeSet const & s) {
         if (this != &s) {
-            RangeSet r = join(s);
-            swap(r);
+            // A ∪ B = ¬(¬A ∩ ¬B)
+            _intersectInPlace(s._beginc(), s._endc(), true);
+            complement();
         }
         return *this;
     }
@@ -398,8 +515,8 @@ public:
     /// to this set. It is strongly exception safe.
     RangeSet & operator-=(RangeSet const & s) {
         if (this != &s) {
-            RangeSet r = difference(s);
-            swap(r);
+            // A ∖ B = A ∩ ¬B
+            _intersectInPlace(s._beginc(), s._endc(), false);
         } else {
             clear();
         }
@@ -439,6 +556,15 @@ public:
     bool contains(RangeSet const & s) const;
     ///@}
 
+    /// `contains` sets `out[i]` to true iff `values[i]` is in this set,
+    /// for all i < n.
+    ///
+    /// Runs of ascending values are answered by scanning forward from the
+    /// range containing the previous value, so that sorted input is
+    /// processed in O(n log(N/n)) time, where N is the number of ranges in
+    /// this set. Other values are located with a branch-free binary search.
+    void contains(uint64_t const * values, size_t n, bool * out) const;
+
     ///@{
     /// `isWithin` returns true iff every integer in this set is also one of
     /// the given integers.
@@ -477,11 +603,39 @@ public:
 
     /// `simplified` returns a simplified copy of this set.
     RangeSet simplified(uint32_t n) const {
-        RangeSet rs(*this);
+        RangeSet rs(*this, get_allocator());
         rs.simplify(n);
         return rs;
     }
 
+    /// `compact` reduces the number of ranges in this set to at most
+    /// `maxRanges` by filling in the gaps between its ranges, shortest
+    /// first.
+    ///
+    /// Unlike `simplify`, which rounds range boundaries to multiples of a
+    /// power of 2 whether or not that merges any ranges, this adds as few
+    /// integers as possible for the requested number of ranges. For pixel
+    /// index ranges that are turned into one database predicate each, that
+    /// minimizes the number of extra rows scanned for a given predicate
+    /// count. Gaps of equal length are filled in from the lowest one up.
+    /// A `maxRanges` of zero means no limit. The run time is linear in the
+    /// number of ranges in this set.
+    RangeSet & compact(size_t maxRanges);
+
+    /// `compacted` returns a compacted copy of this set.
+    RangeSet compacted(size_t maxRanges) const {
+        RangeSet rs(*this, get_allocator());
+        rs.compact(maxRanges);
+        return rs;
+    }
+
+    /// `compactionOverCoverage` returns the number of integers that
+    /// `compact(maxRanges)` would add to this set, divided by the
+    /// cardinality of this set, without modifying it. Evaluating it for
+    /// several candidate range counts lets a caller trade predicate count
+    /// against over-coverage.
+    double compactionOverCoverage(size_t maxRanges) const;
+
     /// `scale` multiplies the endpoints of each range in this set by the
     /// given integer.
     ///
@@ -492,11 +646,46 @@ public:
 
     /// `scaled` returns a scaled copy of this set.
     RangeSet scaled(uint64_t i) const {
-        RangeSet rs(*this);
+        RangeSet rs(*this, get_allocator());
         rs.scale(i);
         return rs;
     }
 
+    /// `coarsen` replaces each integer u in this set with u / 4^levels.
+    ///
+    /// In the HTM, Q3C, MQ3C and nested HEALPix pixelizations, the
+    /// ancestor of a pixel n levels up is obtained by dropping the 2n
+    /// least significant bits of its index, so this converts a set of
+    /// pixels to a coarser level. If `interior` is false, the result
+    /// contains every coarse pixel with at least one descendant in this
+    /// set (like `Pixelization::envelope`). Otherwise it contains only
+    /// the coarse pixels all of whose descendants are in this set (like
+    /// `Pixelization::interior`). The run time is linear in the number of
+    /// ranges in this set.
+    RangeSet & coarsen(uint32_t levels, bool interior = false);
+
+    /// `coarsened` returns a coarsened copy of this set.
+    RangeSet coarsened(uint32_t levels, bool interior = false) const {
+        RangeSet rs(*this, get_allocator());
+        rs.coarsen(levels, interior);
+        return rs;
+    }
+
+    /// `refine` replaces each integer u in this set with the integers
+    /// in [u * 4^levels, (u + 1) * 4^levels).
+    ///
+    /// This is the inverse of `coarsen`, and converts a set of pixels to the
+    /// set of their descendants `levels` levels down. Ranges that would
+    /// extend past 2^64 are truncated, as for `scale`.
+    RangeSet & refine(uint32_t levels);
+
+    /// `refined` returns a refined copy of this set.
+    RangeSet refined(uint32_t levels) const {
+        RangeSet rs(*this, get_allocator());
+        rs.refine(levels);
+        return rs;
+    }
+
     /// `clear` removes all integers from this set.
     void clear() { _ranges = {0, 0}; _offset = true; }
 
@@ -544,9 +733,21 @@ public:
     /// contains 2^64 integers, which is 0 modulo 2^64).
     uint64_t cardinality() const;
 
+    /// `get_allocator` returns the allocator used by this set.
+    allocator_type get_allocator() const { return _ranges.get_allocator(); }
+
+    /// `swap` exchanges the contents of this set and s. It runs in constant
+    /// time if both sets use the same memory resource; otherwise, each set
+    /// keeps its memory resource and the ranges are copied.
     void swap(RangeSet & s) {
         using std::swap;
-        swap(_ranges, s._ranges);
+        if (_ranges.get_allocator() == s._ranges.get_allocator()) {
+            swap(_ranges, s._ranges);
+        } else {
+            std::pmr::vector<uint64_t> r(std::move(_ranges));
+            _ranges = std::move(s._ranges);
+            s._ranges = std::move(r);
+        }
         swap(_offset, s._offset);
     }
 
@@ -557,8 +758,31 @@ public:
     /// isn't preserving its invariants, i.e. has a bug.
     bool isValid() const;
 
+    /// `encode` serializes this set into a compact byte string.
+    ///
+    /// The byte string consists of the type code, a flag byte that is 1 iff
+    /// this set contains 0, and the number of range beginning and end points
+    /// followed by the differences between consecutive points, all stored
+    /// as variable length integers (see encodeVarint). Sets of closely
+    /// spaced ranges, such as pixelization envelopes, therefore take only
+    /// a few bytes per range.
+    std::vector<uint8_t> encode() const;
+
+    ///@{
+    /// `decode` deserializes a RangeSet from a byte string produced by
+    /// encode. It throws std::runtime_error if the byte string is invalid.
+    static RangeSet decode(std::vector<uint8_t> const & s) {
+        return decode(s.data(), s.size());
+    }
+
+    static RangeSet decode(uint8_t const * buffer, size_t n);
+    ///@}
+
 private:
-    std::vector<uint64_t> _ranges = {0, 0};
+    friend class RangeSetExpression;
+    friend class RangeSetView;
+
+    std::pmr::vector<uint64_t> _ranges = {0, 0};
 
     // The offset of the first range in _ranges. It is 0 (false) if the
     // first integer in the set is 0, and 1 (true) otherwise.
@@ -586,17 +810,46 @@ private:
 
     void _insert(uint64_t first, uint64_t last);
 
-    static void _intersectOne(std::vector<uint64_t> &,
-                              uint64_t const *,
-                              uint64_t const *, uint64_t const *);
+    template <typename InputIterator>
+    void _insertAll(InputIterator a, InputIterator b, std::true_type) {
+        std::vector<uint64_t> values(a, b);
+        _insertMany(values);
+    }
+
+    template <typename InputIterator>
+    void _insertAll(InputIterator a, InputIterator b, std::false_type) {
+        for (; a != b; ++a) {
+            insert(*a);
+        }
+    }
+
+    // `_insertMany` inserts the given integers, sorting them in place.
+    void _insertMany(std::vector<uint64_t> & values);
 
-    static void _intersect(std::vector<uint64_t> &,
-                           uint64_t const *, uint64_t const *,
-                           uint64_t const *, uint64_t const *);
+    template <typename OutputIterator>
+    static OutputIterator _intersectLinear(OutputIterator,
+                                           uint64_t const *, uint64_t const *,
+                                           uint64_t const *, uint64_t const *);
+
+    template <typename OutputIterator>
+    static OutputIterator _intersectGallop(OutputIterator,
+                                           uint64_t const *, uint64_t const *,
+                                           uint64_t const *, uint64_t const *);
 
     void _intersect(uint64_t const *, uint64_t const *,
                     uint64_t const *, uint64_t const *);
 
+    // `_intersectInPlace` replaces this set, or its complement if
+    // `complement` is true, with its intersection with the given ranges.
+    void _intersectInPlace(uint64_t const *, uint64_t const *,
+                           bool complement);
+
+    // `_combineAll` returns the set of integers contained in at least
+    // `threshold` of the given sets.
+    static RangeSet _combineAll(std::vector<RangeSet> const & sets,
+                                size_t threshold,
+                                unsigned numThreads);
+
     static bool _intersectsOne(uint64_t const *,
                                uint64_t const *, uint64_t const *);
 
@@ -609,6 +862,63 @@ inline void swap(RangeSet & a, RangeSet & b) {
     a.swap(b);
 }
 
+
+/// A `RangeSetDecoder` reads the ranges of a RangeSet from a byte string
+/// produced by RangeSet::encode, in ascending order and one at a time. This
+/// allows large encoded sets to be scanned or queried without materializing
+/// them.
+///
+/// A decoder does not copy or own the byte string, which must outlive it.
+/// As the byte string is only validated while it is read, methods other than
+/// size() may throw std::runtime_error if it is invalid.
+class RangeSetDecoder {
+public:
+    ///@{
+    /// This constructor reads the header of the given byte string, and
+    /// throws std::runtime_error if it is not an encoded RangeSet.
+    RangeSetDecoder(uint8_t const * buffer, size_t n);
+
+    explicit RangeSetDecoder(std::vector<uint8_t> const & s) :
+        RangeSetDecoder(s.data(), s.size())
+    {}
+    ///@}
+
+    /// `size` returns the number of ranges in the encoded set.
+    size_t size() const { return (_numPoints + _containsZero + 1) / 2; }
+
+    /// `empty` checks whether the encoded set is empty.
+    bool empty() const { return _numPoints == 0 && !_containsZero; }
+
+    /// `next` stores the next range of the encoded set in [first, last) and
+    /// returns true, or returns false if all ranges have already been read.
+    bool next(uint64_t & first, uint64_t & last);
+
+    /// `rewind` restarts decoding at the first range of the encoded set.
+    void rewind();
+
+    ///@{
+    /// `intersects` returns true iff the intersection of the encoded set
+    /// and the given integers is non-empty. Decoding stops as soon as the
+    /// answer is known, and the position of this decoder is not changed.
+    bool intersects(uint64_t u) const { return intersects(u, u + 1); }
+
+    bool intersects(uint64_t first, uint64_t last) const;
+    ///@}
+
+private:
+    uint8_t const * _begin;
+    uint8_t const * _end;
+    uint8_t const * _cursor;
+    size_t _numPoints;
+    size_t _remaining;
+    uint64_t _point;
+    bool _containsZero;
+    bool _pendingZero;
+
+    uint64_t _nextPoint();
+    bool _intersects(uint64_t first, uint64_t last) const;
+};
+
 std::ostream & operator<<(std::ostream &, RangeSet const &);
 
 }} // namespace lsst::sphgeom
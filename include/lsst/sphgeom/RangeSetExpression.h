@@ -0,0 +1,142 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_RANGESETEXPRESSION_H_
+#define LSST_SPHGEOM_RANGESETEXPRESSION_H_
+
+/// \file
+/// \brief This file declares a class for lazily combining range sets.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// `RangeSetExpression` is a boolean combination of RangeSet operands,
+/// built with the ~, &, |, - and ^ operators, that is evaluated lazily.
+///
+/// Rather than materializing the result of each operator, an expression
+/// is evaluated in a single sweep over the beginning and end points of all
+/// its operands, in O(N log k) time for k distinct operands with a total of
+/// N ranges. Its cardinality, or whether it is empty, can be computed
+/// without storing any ranges at all. For example:
+///
+///     RangeSetExpression e = (RangeSetExpression(visits) & footprint) -
+///                            (RangeSetExpression(masked) | extra);
+///     uint64_t n = e.cardinality();
+///
+/// An expression refers to its operands, which must outlive it, and it
+/// cannot be built from a temporary RangeSet. Note that in C++, the -
+/// operator binds more tightly than & and |, so `RangeSetExpression(a) &
+/// b - c` does not compile, because `b - c` is a temporary RangeSet; write
+/// `RangeSetExpression(a) & (RangeSetExpression(b) - c)` instead.
+class RangeSetExpression {
+public:
+    /// This constructor creates an expression for the set s.
+    RangeSetExpression(RangeSet const & s) :
+        _operands{&s}, _program{{OPERAND, 0}} {}
+
+    RangeSetExpression(RangeSet &&) = delete;
+
+    /// `evaluate` returns the set of integers in this expression.
+    RangeSet evaluate() const;
+
+    /// `empty` checks whether this expression contains no integers.
+    bool empty() const;
+
+    /// `cardinality` returns the number of integers in this expression,
+    /// modulo 2^64. As for RangeSet::cardinality, 0 is returned both for
+    /// full and empty expressions.
+    uint64_t cardinality() const;
+
+    /// `contains` checks whether this expression contains the integer u.
+    bool contains(uint64_t u) const;
+
+    friend RangeSetExpression operator~(RangeSetExpression const & e) {
+        RangeSetExpression r(e);
+        r._program.push_back({NOT, 0});
+        return r;
+    }
+
+    friend RangeSetExpression operator&(RangeSetExpression const & a,
+                                        RangeSetExpression const & b) {
+        return _combine(a, b, AND);
+    }
+
+    friend RangeSetExpression operator|(RangeSetExpression const & a,
+                                        RangeSetExpression const & b) {
+        return _combine(a, b, OR);
+    }
+
+    friend RangeSetExpression operator-(RangeSetExpression const & a,
+                                        RangeSetExpression const & b) {
+        return _combine(a, b, DIFFERENCE);
+    }
+
+    friend RangeSetExpression operator^(RangeSetExpression const & a,
+                                        RangeSetExpression const & b) {
+        return _combine(a, b, SYMMETRIC_DIFFERENCE);
+    }
+
+private:
+    enum Opcode : uint8_t {
+        OPERAND,
+        NOT,
+        AND,
+        OR,
+        DIFFERENCE,
+        SYMMETRIC_DIFFERENCE
+    };
+
+    // An `Instruction` of the postfix program for the expression. The
+    // argument of an OPERAND instruction is the index of the operand.
+    struct Instruction {
+        Opcode opcode;
+        uint32_t operand;
+    };
+
+    // The distinct operands of the expression.
+    std::vector<RangeSet const *> _operands;
+    std::vector<Instruction> _program;
+
+    static RangeSetExpression _combine(RangeSetExpression const & a,
+                                       RangeSetExpression const & b,
+                                       Opcode opcode);
+
+    // `_evaluate` evaluates the program on up to 64 integers at once, given
+    // a word per operand with bit j set iff the operand contains the j-th
+    // integer, using `stack` for scratch space.
+    uint64_t _evaluate(uint64_t const * operands,
+                       std::vector<uint64_t> & stack) const;
+
+    template <typename Sink>
+    bool _sweep(Sink && sink) const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_RANGESETEXPRESSION_H_
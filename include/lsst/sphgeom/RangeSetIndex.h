@@ -0,0 +1,118 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_RANGESETINDEX_H_
+#define LSST_SPHGEOM_RANGESETINDEX_H_
+
+/// \file
+/// \brief This file declares a rank/select index over the integers of a
+///        RangeSet.
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `RangeSetIndex` answers order statistics queries about the integers of
+/// a RangeSet in O(log n) time, where n is the number of ranges in the set:
+/// `select(k)` returns the k-th smallest integer in the set, and `rank(i)`
+/// counts the integers in the set that are smaller than i. This allows the
+/// pixels in a large pixel set to be paged through, or sampled uniformly,
+/// without summing range lengths each time.
+///
+/// An index holds a copy of the ranges of the set it was built from, along
+/// with their cumulative lengths, and is unaffected by later changes to
+/// that set.
+///
+/// Integer counts are computed modulo 2^64, so that the cardinality of a
+/// full set is 0, as with RangeSet::cardinality(). Since a full set is the
+/// only one with 2^64 integers, `select` and `rank` are nevertheless exact
+/// for all sets.
+class RangeSetIndex {
+public:
+    /// This constructor creates an index of the empty set.
+    RangeSetIndex() = default;
+
+    /// This constructor creates an index of the integers in `s`.
+    explicit RangeSetIndex(RangeSet const & s);
+
+    /// `getRangeSet` returns the set this index was built from.
+    RangeSet getRangeSet() const;
+
+    /// `empty` checks whether the indexed set is empty.
+    bool empty() const { return _bounds.empty(); }
+
+    /// `full` checks whether the indexed set is full.
+    bool full() const { return _full; }
+
+    /// `size` returns the number of ranges in the indexed set.
+    size_t size() const { return _bounds.size() / 2; }
+
+    /// `cardinality` returns the number of integers in the indexed set,
+    /// modulo 2^64.
+    uint64_t cardinality() const { return _cardinality; }
+
+    /// `select` returns the k-th smallest integer in the indexed set,
+    /// counting from zero. It throws std::out_of_range unless k is less
+    /// than the cardinality of a set that is not full.
+    uint64_t select(uint64_t k) const;
+
+    /// `select` returns the set of the integers with ranks in
+    /// [first, last), e.g. a page of pixels. Ranks past the end of the
+    /// set are ignored, and last = 0 stands for 2^64.
+    RangeSet select(uint64_t first, uint64_t last) const;
+
+    /// `rank` returns the number of integers in the indexed set that are
+    /// less than i. If the set contains i, this is the rank of i, so that
+    /// select(rank(i)) == i.
+    uint64_t rank(uint64_t i) const;
+
+    /// `sample` draws `n` integers uniformly at random and with replacement
+    /// from the indexed set, and stores them in `out`. It throws
+    /// std::invalid_argument if the set is empty.
+    void sample(size_t n, std::mt19937_64 & rng, uint64_t * out) const;
+
+private:
+    // The ranges of the indexed set as [begin, end) pairs, where an end
+    // of 0 stands for 2^64.
+    std::vector<uint64_t> _bounds;
+
+    // `_counts[i]` is the number of integers in the ranges before range i.
+    std::vector<uint64_t> _counts;
+
+    uint64_t _cardinality = 0;
+    bool _full = false;
+
+    // `_find` returns the index of the range containing the integer with
+    // rank k, which must be less than the cardinality.
+    size_t _find(uint64_t k) const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_RANGESETINDEX_H_
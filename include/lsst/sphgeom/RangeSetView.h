@@ -0,0 +1,193 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_RANGESETVIEW_H_
+#define LSST_SPHGEOM_RANGESETVIEW_H_
+
+/// \file
+/// \brief This file provides a read-only view of a RangeSet stored
+///        in a memory mapped file.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `RangeSetView` is a read-only RangeSet that does not own the memory
+/// holding its ranges.
+///
+/// Views are usually created from files written by RangeSetView::write,
+/// which are mapped into memory rather than read. Opening a view therefore
+/// takes constant time regardless of the size of the set, pages are only
+/// loaded from disk when a query touches them, and processes that map the
+/// same file share a single copy of it in the operating system page cache.
+///
+/// A file written by `write` contains three native-endian 64 bit words - a
+/// magic number, a flag word which is 1 if the set contains 0, and the
+/// number n of points that follow - and then the n points of the set,
+/// in the same layout that RangeSet uses in memory. Files are therefore
+/// not portable between machines of differing byte order.
+///
+/// Only the header of a file is validated when it is opened, since checking
+/// every point would defeat the purpose of mapping it. Call isValid to check
+/// files from untrusted sources.
+///
+/// Copies of a view share the underlying mapping, which is released when
+/// the last copy is destroyed. Views created from a RangeSet or a caller
+/// supplied buffer must not outlive it.
+class RangeSetView {
+public:
+    /// The magic number of files written by `write` ("sphgRSV1").
+    static constexpr uint64_t MAGIC = 0x3156535267687073;
+
+    /// `write` stores s in a file that can be mapped by a RangeSetView.
+    /// It throws std::runtime_error if the file cannot be written.
+    static void write(RangeSet const & s, std::string const & path);
+
+    /// The default constructor creates a view of the empty set.
+    RangeSetView();
+
+    /// This constructor maps the given file, which must have been created
+    /// by `write`, into memory. It throws std::runtime_error if the file
+    /// cannot be mapped or was not written by `write`.
+    explicit RangeSetView(std::string const & path);
+
+    /// This constructor creates a view of the n bytes at buffer, which
+    /// must have the same contents as a file created by `write` and be
+    /// aligned to an 8 byte boundary. It throws std::runtime_error if the
+    /// buffer is too small or has an invalid header.
+    RangeSetView(void const * buffer, size_t n);
+
+    /// This constructor creates a view of the ranges in s.
+    explicit RangeSetView(RangeSet const & s);
+
+    /// `toRangeSet` returns a copy of the set viewed by this object.
+    RangeSet toRangeSet() const;
+
+    ///@{
+    /// `intersects` returns true iff the intersection of the viewed set
+    /// and the given integers is non-empty.
+    bool intersects(uint64_t u) const { return intersects(u, u + 1); }
+
+    bool intersects(uint64_t first, uint64_t last) const;
+
+    bool intersects(RangeSet const & s) const;
+    ///@}
+
+    ///@{
+    /// `contains` returns true iff all the given integers are in the
+    /// viewed set.
+    bool contains(uint64_t u) const { return contains(u, u + 1); }
+
+    bool contains(uint64_t first, uint64_t last) const;
+
+    bool contains(RangeSet const & s) const;
+    ///@}
+
+    ///@{
+    /// `isWithin` returns true iff all the integers in the viewed set are
+    /// among the given integers.
+    bool isWithin(uint64_t u) const { return isWithin(u, u + 1); }
+
+    bool isWithin(uint64_t first, uint64_t last) const;
+
+    bool isWithin(RangeSet const & s) const;
+    ///@}
+
+    ///@{
+    /// `isDisjointFrom` returns true iff the intersection of the viewed set
+    /// and the given integers is empty.
+    bool isDisjointFrom(uint64_t u) const { return !intersects(u); }
+
+    bool isDisjointFrom(uint64_t first, uint64_t last) const {
+        return !intersects(first, last);
+    }
+
+    bool isDisjointFrom(RangeSet const & s) const { return !intersects(s); }
+    ///@}
+
+    /// `empty` checks whether the viewed set is empty.
+    bool empty() const { return _begin() == _end(); }
+
+    /// `full` checks whether the viewed set contains all integers
+    /// in [0, 2^64).
+    bool full() const { return _beginc() == _endc(); }
+
+    ///@{
+    /// `begin` returns a constant iterator to the first range in the
+    /// viewed set.
+    RangeSet::Iterator begin() const { return RangeSet::Iterator(_begin()); }
+    RangeSet::Iterator cbegin() const { return begin(); }
+    ///@}
+
+    ///@{
+    /// `end` returns a constant iterator to just past the last range in the
+    /// viewed set.
+    RangeSet::Iterator end() const { return RangeSet::Iterator(_end()); }
+    RangeSet::Iterator cend() const { return end(); }
+    ///@}
+
+    /// `size` returns the number of ranges in the viewed set.
+    size_t size() const { return (_size - _offset) / 2; }
+
+    /// `cardinality` returns the number of integers in the viewed set.
+    ///
+    /// As for RangeSet, 0 is returned both for full and empty sets.
+    uint64_t cardinality() const;
+
+    /// `isValid` checks that the viewed points form a valid RangeSet.
+    /// It reads every point, so it takes time linear in the size of the set.
+    bool isValid() const;
+
+private:
+    // Keeps the memory mapping (if any) alive.
+    std::shared_ptr<void const> _mapping;
+    // The points of the viewed set, including the zero bookends.
+    uint64_t const * _ranges;
+    size_t _size;
+    // See RangeSet::_offset.
+    bool _offset;
+
+    void _init(void const * buffer, size_t n);
+
+    uint64_t const * _begin() const { return _ranges + _offset; }
+
+    uint64_t const * _end() const {
+        return _ranges + (_size - ((_size & 1) ^ _offset));
+    }
+
+    uint64_t const * _beginc() const { return _ranges + !_offset; }
+
+    uint64_t const * _endc() const {
+        return _ranges + (_size - ((_size & 1) ^ !_offset));
+    }
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_RANGESETVIEW_H_
@@ -26,7 +26,9 @@
 /// \file
 /// \brief This file defines an interface for spherical regions.
 
+#include <cstddef>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "Relationship.h"
@@ -42,6 +44,7 @@ class Circle;
 class ConvexPolygon;
 class Ellipse;
 class UnitVector3d;
+class UnitVector3dArray;
 
 /// `Region` is a minimal interface for 2-dimensional regions on the unit
 /// sphere. It provides three core pieces of functionality:
@@ -76,6 +79,11 @@ class UnitVector3d;
 ///
 /// One negative consequence of this design is that one cannot implement new
 /// Region types outside of this library.
+///
+/// It is safe to call const methods of a region from several threads at
+/// once. Quantities that regions compute lazily and cache (bounds, polygon
+/// edges) are published atomically. Non-const methods, such as complement(),
+/// require exclusive access.
 class Region {
 public:
     virtual ~Region() {}
@@ -92,6 +100,12 @@ public:
     /// `getBoundingCircle` returns a bounding-circle for this region.
     virtual Circle getBoundingCircle() const = 0;
 
+    /// `getCostHint` returns a rough estimate of the cost of testing a point
+    /// against this region, or of relating it to another region, in units of
+    /// the cost of doing so for a Circle. Compound regions use it to evaluate
+    /// cheap operands first.
+    virtual double getCostHint() const { return 1.0; }
+
     /// `contains` tests whether the given unit vector is inside this region.
     virtual bool contains(UnitVector3d const &) const = 0;
 
@@ -103,6 +117,40 @@ public:
     /// and latitude coordinates (in radians) is inside this region.
     bool contains(double lon, double lat) const;
 
+    /// `contains` tests whether each of the `n` unit vectors defined by the
+    /// (not necessarily normalized) coordinates (x[i], y[i], z[i]) is inside
+    /// this region, and stores the results in `out`.
+    ///
+    /// The default implementation simply calls the single point method in a
+    /// loop. Subclasses may override it with an implementation that tests
+    /// several points at a time.
+    virtual void contains(double const * x, double const * y, double const * z,
+                          bool * out, size_t n) const;
+
+    /// `contains` is equivalent to `contains(x, y, z, out, n)`, except that
+    /// if `numThreads` is greater than one, blocks of points are divided
+    /// among that many threads, including the calling thread.
+    void contains(double const * x, double const * y, double const * z,
+                  bool * out, size_t n, unsigned numThreads) const;
+
+    /// `contains` tests whether each of the given points is inside this
+    /// region, and stores the results in `out`, which must have room for
+    /// `points.size()` values.
+    void contains(UnitVector3dArray const & points, bool * out) const;
+
+    /// `sample` draws `n` points distributed uniformly over this region using
+    /// the given random number generator, and stores their coordinates in
+    /// `x`, `y` and `z`. The points are unit vectors for which `contains`
+    /// returns true, except perhaps for degenerate regions with zero area.
+    ///
+    /// The default implementation draws points uniformly from the bounding
+    /// circle and rejects those outside this region, so it is slow for
+    /// regions much smaller than their bounding circles. It throws
+    /// std::invalid_argument if this region is empty, and std::runtime_error
+    /// if no point is accepted after many attempts.
+    virtual void sample(size_t n, std::mt19937_64 & rng,
+                        double * x, double * y, double * z) const;
+
     ///@{
     /// `relate` computes the spatial relationships between this region A and
     /// another region B. The return value S is a bitset with the following
@@ -132,8 +180,39 @@ public:
     /// emitted by encode can be deserialized with decode.
     virtual std::vector<uint8_t> encode() const = 0;
 
+    /// `encodeTo` appends the byte string produced by encode to `buffer`.
+    /// Encoding many regions into the same buffer in this way avoids
+    /// allocating and copying a byte string per region.
+    ///
+    /// The default implementation calls encode; all the regions in this
+    /// library override it to write to `buffer` directly.
+    virtual void encodeTo(std::vector<uint8_t> & buffer) const {
+        std::vector<uint8_t> s = encode();
+        buffer.insert(buffer.end(), s.begin(), s.end());
+    }
+
+    /// `encodeCompact` serializes this region like encode, but may use a
+    /// smaller, lossy encoding (see encodeCompactTo). The result can be
+    /// deserialized with decode.
+    std::vector<uint8_t> encodeCompact() const {
+        std::vector<uint8_t> buffer;
+        encodeCompactTo(buffer);
+        return buffer;
+    }
+
+    /// `encodeCompactTo` appends the byte string produced by encodeCompact
+    /// to `buffer`. A compact encoding is conservative: the region decoded
+    /// from it always contains this one, and regions that override this
+    /// method document how much larger it may be.
+    ///
+    /// The default implementation calls encodeTo.
+    virtual void encodeCompactTo(std::vector<uint8_t> & buffer) const {
+        encodeTo(buffer);
+    }
+
     ///@{
-    /// `decode` deserializes a Region from a byte string produced by encode.
+    /// `decode` deserializes a Region from a byte string produced by encode
+    /// or encodeCompact.
     static std::unique_ptr<Region> decode(std::vector<uint8_t> const & s) {
         return decode(s.data(), s.size());
     }
@@ -142,6 +221,21 @@ public:
     ///@}
 };
 
+/// `relateMany` computes `out[i] = query.relate(*targets[i])` for i in
+/// [0, n). It throws std::invalid_argument if any target is null.
+///
+/// Runs of consecutive targets with the same concrete type are related to
+/// the query with non-virtual calls specific to the types of the query and
+/// the targets, so ordering targets by type is beneficial. If `numThreads`
+/// is greater than one, blocks of targets are divided among that many
+/// threads, including the calling thread. The results do not depend on
+/// `numThreads`.
+void relateMany(Region const & query,
+                Region const * const * targets,
+                size_t n,
+                Relationship * out,
+                unsigned numThreads = 1);
+
 }} // namespace lsst::sphgeom
 
 #endif // LSST_SPHGEOM_REGION_H_
@@ -0,0 +1,150 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_REGIONBATCH_H_
+#define LSST_SPHGEOM_REGIONBATCH_H_
+
+/// \file
+/// \brief This file declares classes for encoding and decoding many
+///        regions as a single byte string.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "DecodedRegion.h"
+#include "Region.h"
+#include "RelateCache.h"
+#include "Relationship.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `RegionBatchEncoder` appends a batch of encoded regions to a byte
+/// buffer owned by the caller. Regions are encoded directly into the
+/// buffer with `Region::encodeTo`, so that encoding many regions does not
+/// allocate a byte string per region.
+///
+/// A batch consists of the type code byte `RegionBatchEncoder::TYPE_CODE`,
+/// followed by each region encoding, prefixed with its size as a 64 bit
+/// little-endian integer. An index holding the offset of each size prefix
+/// from the start of the batch, and finally the number of regions, follow
+/// in the same format. The index allows any region of a batch to be found
+/// without reading the others; see `RegionBatchDecoder`.
+///
+/// The buffer must outlive the encoder, and must not be modified by
+/// anything else until `finish` has been called.
+class RegionBatchEncoder {
+public:
+    static constexpr uint8_t TYPE_CODE = 'R';
+
+    /// This constructor starts a new batch at the end of `buffer`.
+    explicit RegionBatchEncoder(std::vector<uint8_t> & buffer);
+
+    /// `append` adds a region to the batch.
+    void append(Region const & region);
+
+    /// `size` returns the number of regions added to the batch so far.
+    size_t size() const { return _offsets.size(); }
+
+    /// `finish` writes the index of the batch. No regions can be added to
+    /// a finished batch, and calling `finish` more than once has no effect.
+    void finish();
+
+private:
+    std::vector<uint8_t> & _buffer;
+    size_t _begin;
+    std::vector<uint64_t> _offsets;
+    bool _finished = false;
+};
+
+/// A `RegionBatchDecoder` provides random access to the regions in a byte
+/// string produced by `RegionBatchEncoder`. Regions are only decoded when
+/// asked for, and can be decoded into reusable storage or related to other
+/// regions without being materialized; see `DecodedRegion`.
+///
+/// A decoder does not copy or own the byte string, which must outlive it.
+/// As region encodings are only validated when accessed, methods other
+/// than `size` may throw std::runtime_error if the byte string is invalid.
+class RegionBatchDecoder {
+public:
+    ///@{
+    /// This constructor reads the index of the given byte string, and
+    /// throws std::runtime_error if it is not an encoded region batch.
+    RegionBatchDecoder(uint8_t const * buffer, size_t n);
+
+    explicit RegionBatchDecoder(std::vector<uint8_t> const & s) :
+        RegionBatchDecoder(s.data(), s.size())
+    {}
+    ///@}
+
+    /// `size` returns the number of regions in the batch.
+    size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    /// `getEncoded` returns a pointer to the encoding of the i-th region
+    /// and its size in bytes.
+    std::pair<uint8_t const *, size_t> getEncoded(size_t i) const;
+
+    /// `decode` deserializes the i-th region in the batch.
+    std::unique_ptr<Region> decode(size_t i) const {
+        std::pair<uint8_t const *, size_t> s = getEncoded(i);
+        return Region::decode(s.first, s.second);
+    }
+
+    /// `decode` deserializes the i-th region in the batch into `storage`,
+    /// and returns a reference to it.
+    Region const & decode(size_t i, DecodedRegion & storage) const {
+        std::pair<uint8_t const *, size_t> s = getEncoded(i);
+        return storage.decode(s.first, s.second);
+    }
+
+    /// `relate` returns the relationship between the i-th region in the
+    /// batch and `r`; see `DecodedRegion::relate`.
+    Relationship relate(size_t i, Region const & r) const {
+        std::pair<uint8_t const *, size_t> s = getEncoded(i);
+        return DecodedRegion::relate(s.first, s.second, r);
+    }
+
+    /// `relate` returns the relationship between the i-th region in the
+    /// batch and `r`, memoized in `cache`; see `RelateCache`.
+    Relationship relate(size_t i, Region const & r, RelateCache & cache) const;
+
+    /// `relateAll` returns the relationships between every region in the
+    /// batch and `r`, in batch order. If `cache` is not null, results are
+    /// memoized in it, and `r` is encoded only once for all regions.
+    std::vector<Relationship> relateAll(Region const & r,
+                                        RelateCache * cache = nullptr) const;
+
+private:
+    uint8_t const * _begin;
+    uint8_t const * _index;
+    size_t _size;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_REGIONBATCH_H_
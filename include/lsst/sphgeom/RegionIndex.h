@@ -0,0 +1,110 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_REGIONINDEX_H_
+#define LSST_SPHGEOM_REGIONINDEX_H_
+
+/// \file
+/// \brief This file declares a spatial index over a collection of regions.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Region.h"
+#include "UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace detail { class BoxTree; }
+
+/// A `RegionIndex` is an immutable spatial index over a collection of
+/// regions, for example a catalogue of visit footprints. It finds the
+/// regions overlapping a query region, or containing a query point, in
+/// time that grows with the number of regions near the query rather than
+/// with the total number of regions.
+///
+/// Regions are bulk-loaded into an R-tree style bounding volume hierarchy
+/// keyed by their 3-D bounding boxes. Only the regions whose boxes
+/// intersect those of a query are compared to it exactly.
+///
+/// Regions are identified by their position in the sequence used to
+/// construct the index. Once built, an index may be queried concurrently
+/// from multiple threads.
+class RegionIndex {
+public:
+    static constexpr uint8_t TYPE_CODE = 'x';
+
+    /// This constructor creates an empty index.
+    RegionIndex() = default;
+
+    /// This constructor creates an index over the given regions.
+    explicit RegionIndex(std::vector<std::unique_ptr<Region>> regions);
+
+    RegionIndex(RegionIndex const &) = delete;
+    RegionIndex(RegionIndex &&) = default;
+    RegionIndex & operator=(RegionIndex const &) = delete;
+    RegionIndex & operator=(RegionIndex &&) = default;
+
+    bool empty() const { return _regions.empty(); }
+
+    /// `size` returns the number of regions in this index.
+    size_t size() const { return _regions.size(); }
+
+    /// `getRegion` returns the i-th region in this index.
+    Region const & getRegion(size_t i) const { return *_regions[i]; }
+
+    /// `overlapping` returns the indexes of the regions in this index that
+    /// may intersect r, in ascending order. A region is reported unless its
+    /// relationship with r includes DISJOINT, so like `Region::relate`, the
+    /// result may be conservative.
+    std::vector<size_t> overlapping(Region const & r) const;
+
+    /// `containing` returns the indexes of the regions in this index that
+    /// contain v, in ascending order.
+    std::vector<size_t> containing(UnitVector3d const & v) const;
+
+    /// `encode` serializes this index as a byte string, by concatenating
+    /// the encodings of its regions. The spatial index itself is not
+    /// stored; it is rebuilt by `decode`.
+    std::vector<uint8_t> encode() const;
+
+    ///@{
+    /// `decode` deserializes a RegionIndex from a byte string produced
+    /// by encode.
+    static std::unique_ptr<RegionIndex> decode(std::vector<uint8_t> const & s) {
+        return decode(s.data(), s.size());
+    }
+    static std::unique_ptr<RegionIndex> decode(uint8_t const * buffer, size_t n);
+    ///@}
+
+private:
+    std::vector<std::unique_ptr<Region>> _regions;
+    std::shared_ptr<detail::BoxTree const> _tree;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_REGIONINDEX_H_
@@ -0,0 +1,114 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_REGIONSET_H_
+#define LSST_SPHGEOM_REGIONSET_H_
+
+/// \file
+/// \brief This file declares a class for testing points against many
+///        regions at once.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Region.h"
+#include "UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace detail { class BoxTree; }
+
+/// A `RegionSet` is an immutable collection of regions, indexed so that
+/// the regions containing a point can be found without testing the point
+/// against every region.
+///
+/// The index is a bounding volume hierarchy over the 3-D bounding boxes of
+/// the regions. A point is only tested for containment by the regions whose
+/// bounding boxes contain it, so the cost of a lookup grows with the number
+/// of regions near the point rather than the total number of regions.
+///
+/// Regions are identified by their position in the sequence used to
+/// construct the set. All query functions are const, and may be called
+/// concurrently from multiple threads.
+class RegionSet {
+public:
+    /// This constructor creates an empty set.
+    RegionSet() = default;
+
+    /// This constructor creates a set containing the given regions.
+    explicit RegionSet(std::vector<std::unique_ptr<Region>> regions);
+
+    RegionSet(RegionSet const &) = delete;
+    RegionSet(RegionSet &&) = default;
+    RegionSet & operator=(RegionSet const &) = delete;
+    RegionSet & operator=(RegionSet &&) = default;
+
+    bool empty() const { return _regions.empty(); }
+
+    /// `size` returns the number of regions in this set.
+    size_t size() const { return _regions.size(); }
+
+    /// `getRegion` returns the i-th region in this set.
+    Region const & getRegion(size_t i) const { return *_regions[i]; }
+
+    ///@{
+    /// `containsAny` returns true if any region in this set contains
+    /// the given point.
+    bool containsAny(UnitVector3d const & v) const;
+    bool containsAny(double x, double y, double z) const {
+        return containsAny(UnitVector3d(x, y, z));
+    }
+    bool containsAny(double lon, double lat) const;
+    ///@}
+
+    /// `containsWhich` returns the indexes of the regions in this set that
+    /// contain the given point, in ascending order.
+    std::vector<size_t> containsWhich(UnitVector3d const & v) const;
+
+    /// `containsWhich` finds the regions containing each of the `n` given
+    /// points, and returns them as a list of hit lists in compressed form.
+    ///
+    /// On return, `offsets` has size n + 1, and the (ascending) indexes of
+    /// the regions containing `points[i]` are
+    /// `indexes[offsets[i]]`, ..., `indexes[offsets[i + 1] - 1]`.
+    void containsWhich(UnitVector3d const * points,
+                       size_t n,
+                       std::vector<size_t> & offsets,
+                       std::vector<size_t> & indexes) const;
+
+private:
+    std::vector<std::unique_ptr<Region>> _regions;
+    std::shared_ptr<detail::BoxTree const> _tree;
+
+    // `_find` calls f(i) for the index i of every region containing v,
+    // stopping early if f returns true.
+    template <typename F>
+    void _find(UnitVector3d const & v, F f) const;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_REGIONSET_H_
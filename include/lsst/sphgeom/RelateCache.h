@@ -0,0 +1,121 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_RELATECACHE_H_
+#define LSST_SPHGEOM_RELATECACHE_H_
+
+/// \file
+/// \brief This file declares a cache of region relationships.
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "Region.h"
+#include "Relationship.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `RelateCache` memoizes the results of `Region::relate`. It is meant
+/// for relating the same few query regions to the same stored regions over
+/// and over, e.g. when paging through the results of a spatial query.
+///
+/// Results are keyed on the encodings of both regions (see
+/// `Region::encode`), which are stored in full, so that a result is only
+/// ever returned for byte-for-byte identical regions. The cache is
+/// direct-mapped on a hash of the encodings: each pair of regions maps to
+/// a single slot, and evicts whatever pair previously occupied it.
+///
+/// The memory used by the slot table and the stored encodings is bounded
+/// by the size given on construction. Results that do not fit are not
+/// stored.
+///
+/// All member functions are thread-safe. Slots are protected by a fixed
+/// number of mutexes, and relationships are computed outside of any lock.
+class RelateCache {
+public:
+    /// This constructor creates a cache using at most `maxBytes` bytes of
+    /// memory. The cache always has at least one slot, but stores nothing
+    /// if `maxBytes` is smaller than its slot table. It throws
+    /// std::invalid_argument if `maxBytes` is zero.
+    explicit RelateCache(size_t maxBytes);
+
+    RelateCache(RelateCache const &) = delete;
+    RelateCache & operator=(RelateCache const &) = delete;
+
+    /// `relate` returns `a.relate(b)`, computing it only if the result for
+    /// the same pair of regions is not cached.
+    Relationship relate(Region const & a, Region const & b);
+
+    /// `relate` returns the relationship between the region encoded in
+    /// `buffer`, and `b`, which must have the encoding `encodedB`. This is
+    /// equivalent to `relate(*Region::decode(buffer, n), b)`, but only
+    /// decodes the region (with `DecodedRegion::relate`) if the result is
+    /// not cached, and avoids encoding `b` for each call. It throws
+    /// std::runtime_error if the byte string is invalid.
+    Relationship relate(uint8_t const * buffer, size_t n, Region const & b,
+                        std::vector<uint8_t> const & encodedB);
+
+    /// `clear` removes all cached results.
+    void clear();
+
+    /// `getMaxBytes` returns the memory budget of this cache.
+    size_t getMaxBytes() const { return _maxBytes; }
+
+    /// `getBytes` returns the memory currently used by this cache.
+    size_t getBytes() const {
+        return _tableBytes + _keyBytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t NUM_LOCKS = 64;
+
+    struct Slot {
+        uint64_t hash = 0;
+        // The encodings of both regions, concatenated, and the size of the
+        // first of them.
+        std::vector<uint8_t> key;
+        size_t firstSize = 0;
+        Relationship relationship;
+        bool full = false;
+    };
+
+    std::vector<Slot> _slots;
+    std::mutex _locks[NUM_LOCKS];
+    size_t _maxBytes;
+    size_t _tableBytes;
+    std::atomic<size_t> _keyBytes{0};
+    int _bits = 0;
+
+    template <typename Compute>
+    Relationship _relate(uint8_t const * a, size_t na,
+                         uint8_t const * b, size_t nb,
+                         Compute compute);
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_RELATECACHE_H_
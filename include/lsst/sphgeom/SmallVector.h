@@ -0,0 +1,177 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_SMALLVECTOR_H_
+#define LSST_SPHGEOM_SMALLVECTOR_H_
+
+/// \file
+/// \brief This file declares a sequence container with inline storage
+///        for a small number of elements.
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `SmallVector` is a sequence container that stores up to N elements
+/// inline, and only falls back to heap allocated storage (a std::vector)
+/// when it grows beyond that.
+///
+/// It provides the subset of the std::vector interface needed to store
+/// polygon vertices. Elements are always contiguous, so iterators are
+/// plain pointers, and a SmallVector converts implicitly to a std::vector.
+/// The element type must be default constructible and copyable.
+template <typename T, size_t N>
+class SmallVector {
+public:
+    using value_type = T;
+    using size_type = size_t;
+    using difference_type = ptrdiff_t;
+    using reference = T &;
+    using const_reference = T const &;
+    using iterator = T *;
+    using const_iterator = T const *;
+
+    SmallVector() = default;
+
+    SmallVector(std::initializer_list<T> values) {
+        assign(values.begin(), values.end());
+    }
+
+    template <typename ForwardIterator>
+    SmallVector(ForwardIterator first, ForwardIterator last) {
+        assign(first, last);
+    }
+
+    /// This constructor takes over the storage of v if it holds more than
+    /// N elements, rather than copying them.
+    explicit SmallVector(std::vector<T> && v) : _size(v.size()) {
+        if (_size > N) {
+            _heap = std::move(v);
+        } else {
+            std::copy(v.begin(), v.end(), _inline);
+        }
+    }
+
+    SmallVector(SmallVector const &) = default;
+
+    SmallVector(SmallVector && v) noexcept :
+        _heap(std::move(v._heap)),
+        _size(v._size)
+    {
+        std::copy(v._inline, v._inline + std::min(_size, N), _inline);
+        v._heap.clear();
+        v._size = 0;
+    }
+
+    SmallVector & operator=(SmallVector const &) = default;
+
+    SmallVector & operator=(SmallVector && v) noexcept {
+        if (this != &v) {
+            _heap = std::move(v._heap);
+            _size = v._size;
+            std::copy(v._inline, v._inline + std::min(_size, N), _inline);
+            v._heap.clear();
+            v._size = 0;
+        }
+        return *this;
+    }
+
+    operator std::vector<T>() const { return std::vector<T>(begin(), end()); }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    T * data() { return _size > N ? _heap.data() : _inline; }
+    T const * data() const { return _size > N ? _heap.data() : _inline; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + _size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + _size; }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+    T & operator[](size_t i) { return data()[i]; }
+    T const & operator[](size_t i) const { return data()[i]; }
+
+    T & front() { return data()[0]; }
+    T const & front() const { return data()[0]; }
+    T & back() { return data()[_size - 1]; }
+    T const & back() const { return data()[_size - 1]; }
+
+    void clear() {
+        _heap.clear();
+        _size = 0;
+    }
+
+    /// `reserve` preallocates heap storage if n exceeds the inline capacity.
+    void reserve(size_t n) {
+        if (n > N) {
+            _heap.reserve(n);
+        }
+    }
+
+    template <typename ForwardIterator>
+    void assign(ForwardIterator first, ForwardIterator last) {
+        size_t n = static_cast<size_t>(std::distance(first, last));
+        if (n > N) {
+            _heap.assign(first, last);
+        } else {
+            std::copy(first, last, _inline);
+            _heap.clear();
+        }
+        _size = n;
+    }
+
+    void push_back(T const & value) {
+        if (_size < N) {
+            _inline[_size] = value;
+        } else if (_size == N) {
+            // Move the inline elements to the heap. Leave the inline
+            // elements in place until this succeeds, so that this
+            // container is unchanged if an exception is thrown.
+            _heap.reserve(2 * N);
+            _heap.assign(_inline, _inline + N);
+            _heap.push_back(value);
+        } else {
+            _heap.push_back(value);
+        }
+        ++_size;
+    }
+
+private:
+    // Elements are stored in _inline if there are at most N of them,
+    // and in _heap otherwise.
+    T _inline[N];
+    std::vector<T> _heap;
+    size_t _size = 0;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_SMALLVECTOR_H_
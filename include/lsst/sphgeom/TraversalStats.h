@@ -0,0 +1,124 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_TRAVERSALSTATS_H_
+#define LSST_SPHGEOM_TRAVERSALSTATS_H_
+
+/// \file
+/// \brief This file declares a sink for pixel finder traversal statistics.
+
+#include <cstdint>
+#include <vector>
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// `TraversalStats` accumulates statistics about the hierarchical pixel
+/// traversals performed by `Pixelization::envelope` and
+/// `Pixelization::interior`. They explain where the time of a slow call goes:
+/// deep traversals, many relate calls, or repeated simplification when the
+/// `maxRanges` limit forces the subdivision level down.
+///
+/// Statistics are only collected for calls made on a thread while a
+/// TraversalStatsScope is active on it, and only if the library was compiled
+/// without `LSST_SPHGEOM_NO_TRAVERSAL_STATS`; otherwise the counters are
+/// compiled out of the traversal entirely. Work done by helper threads of a
+/// multi-threaded call is attributed to the calling thread's sink. A
+/// multi-threaded call that falls back to a serial traversal records the
+/// work of both attempts.
+struct TraversalStats {
+    /// `ENABLED` is false if statistics collection was compiled out.
+    static bool const ENABLED;
+
+    /// `nodesVisited[l]` is the number of pixels at level l that were
+    /// related to the search region.
+    std::vector<uint64_t> nodesVisited;
+    /// The number of relate calls that found a pixel to be disjoint from
+    /// the search region.
+    uint64_t disjoint = 0;
+    /// The number of relate calls that found a pixel to be within the
+    /// search region.
+    uint64_t within = 0;
+    /// The number of relate calls with any other outcome.
+    uint64_t intersects = 0;
+    /// The number of pixel ranges appended to result sets.
+    uint64_t inserts = 0;
+    /// The number of times a result set was simplified because it had
+    /// too many ranges, each of which reduces the subdivision level by one.
+    uint64_t simplifications = 0;
+    /// The subdivision level at which the most recent traversal ended, or
+    /// -1 if no traversal has been recorded. This is lower than the
+    /// pixelization level if `maxRanges` forced it down. For adaptive
+    /// traversals, it is the level of the largest pixel left unsubdivided.
+    int finalLevel = -1;
+
+    /// `relates` returns the total number of relate calls.
+    uint64_t relates() const { return disjoint + within + intersects; }
+
+    /// `clear` resets all statistics.
+    void clear() { *this = TraversalStats(); }
+
+    /// `merge` adds the counters of `s` to those of this object, and
+    /// takes its final level if it has one.
+    TraversalStats & merge(TraversalStats const & s);
+};
+
+/// `TraversalStatsScope` directs the traversal statistics of calls made on
+/// the current thread to a sink for its lifetime. Scopes nest; the
+/// innermost one receives the statistics, and the previous sink is restored
+/// when it ends. For example:
+///
+///     TraversalStats stats;
+///     {
+///         TraversalStatsScope scope(stats);
+///         RangeSet s = pixelization.envelope(region, 64);
+///     }
+///     // stats.nodesVisited, stats.simplifications, ... describe the call.
+class TraversalStatsScope {
+public:
+    explicit TraversalStatsScope(TraversalStats & stats);
+    ~TraversalStatsScope();
+
+    TraversalStatsScope(TraversalStatsScope const &) = delete;
+    TraversalStatsScope & operator=(TraversalStatsScope const &) = delete;
+
+    /// `current` returns the sink for the current thread, or null if there
+    /// is none.
+    static TraversalStats * current();
+
+    /// `release` clears the sink for the current thread and returns the
+    /// previous one. It is used by traversals to claim the sink, so that
+    /// nested traversals (e.g. the envelopes computed while relating pixels
+    /// to a pixel set) are not recorded twice.
+    static TraversalStats * release();
+
+    /// `restore` makes `stats` the sink for the current thread.
+    static void restore(TraversalStats * stats);
+
+private:
+    TraversalStats * _previous;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_TRAVERSALSTATS_H_
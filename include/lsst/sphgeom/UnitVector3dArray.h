@@ -0,0 +1,157 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_UNITVECTOR3DARRAY_H_
+#define LSST_SPHGEOM_UNITVECTOR3DARRAY_H_
+
+/// \file
+/// \brief This file declares a structure-of-arrays container for unit
+///        vectors.
+
+#include <cstddef>
+#include <vector>
+
+#include "Matrix3d.h"
+#include "UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `UnitVector3dArray` is a sequence of unit vectors, stored as separate
+/// contiguous arrays of x, y and z components.
+///
+/// This layout matches that of the batch APIs that take component arrays,
+/// e.g. `Pixelization::index` and `Region::contains`, so a stream of points
+/// can be converted, transformed, pixelized and tested against regions
+/// without ever being repacked. The conversion and transformation functions
+/// process several points at a time, using AVX2 where the CPU supports it.
+class UnitVector3dArray {
+public:
+    /// This constructor creates an empty array.
+    UnitVector3dArray() = default;
+
+    /// This constructor copies the given unit vectors.
+    explicit UnitVector3dArray(std::vector<UnitVector3d> const & v);
+
+    /// `fromComponents` returns an array holding the normalized versions of
+    /// the n vectors (x[i], y[i], z[i]). The results are identical to those
+    /// of `UnitVector3d(x[i], y[i], z[i])`, and as for that constructor,
+    /// a std::runtime_error is thrown if any of the vectors is zero.
+    static UnitVector3dArray fromComponents(double const * x,
+                                            double const * y,
+                                            double const * z,
+                                            size_t n);
+
+    /// `normalize` writes the components of `UnitVector3d(x[i], y[i], z[i])`
+    /// to `ox[i]`, `oy[i]` and `oz[i]` for i in [0, n), several vectors at a
+    /// time where possible. The output arrays may be the same as the input
+    /// arrays. A std::runtime_error is thrown if any of the vectors is zero.
+    static void normalize(double const * x,
+                          double const * y,
+                          double const * z,
+                          double * ox,
+                          double * oy,
+                          double * oz,
+                          size_t n);
+
+    /// `fromLonLat` returns an array holding the unit vectors of the n
+    /// points with the given longitudes and latitudes, in radians.
+    ///
+    /// This is equivalent to `UnitVector3d(LonLat::fromRadians(lon[i],
+    /// lat[i]))`, and as for that function, a std::invalid_argument is
+    /// thrown if a latitude has magnitude greater than π/2. The sines and
+    /// cosines are evaluated with a polynomial approximation rather than by
+    /// the C++ standard library however, so vector components may differ
+    /// from the single point results by a few units in the last place.
+    /// Longitudes are also not wrapped to [0, 2π) beforehand, which for very
+    /// large longitudes avoids the error incurred by reducing them modulo
+    /// a rounded value of 2π.
+    static UnitVector3dArray fromLonLat(double const * lon,
+                                        double const * lat,
+                                        size_t n);
+
+    bool empty() const { return _x.empty(); }
+
+    /// `size` returns the number of vectors in this array.
+    size_t size() const { return _x.size(); }
+
+    void reserve(size_t n) {
+        _x.reserve(n);
+        _y.reserve(n);
+        _z.reserve(n);
+    }
+
+    void clear() {
+        _x.clear();
+        _y.clear();
+        _z.clear();
+    }
+
+    void push_back(UnitVector3d const & v) {
+        _x.push_back(v.x());
+        _y.push_back(v.y());
+        _z.push_back(v.z());
+    }
+
+    /// The subscript operator returns the i-th vector. Bounds are not
+    /// checked.
+    UnitVector3d operator[](size_t i) const {
+        return UnitVector3d::fromNormalized(_x[i], _y[i], _z[i]);
+    }
+
+    ///@{
+    /// These functions return pointers to the component arrays, each of
+    /// which holds `size()` values.
+    double const * x() const { return _x.data(); }
+    double const * y() const { return _y.data(); }
+    double const * z() const { return _z.data(); }
+    ///@}
+
+    bool operator==(UnitVector3dArray const & a) const {
+        return _x == a._x && _y == a._y && _z == a._z;
+    }
+
+    bool operator!=(UnitVector3dArray const & a) const {
+        return !(*this == a);
+    }
+
+    /// `toLonLat` writes the longitude and latitude (in radians) of each
+    /// vector in this array to `lon` and `lat`, which must have room for
+    /// `size()` values. The results are identical to those of
+    /// `LonLat(v)`, so longitudes are in [0, 2π).
+    void toLonLat(double * lon, double * lat) const;
+
+    /// `rotate` replaces every vector v in this array with
+    /// `UnitVector3d(m * v)`, and returns a reference to this array. The
+    /// results are identical to those of the single vector computation.
+    UnitVector3dArray & rotate(Matrix3d const & m);
+
+private:
+    std::vector<double> _x;
+    std::vector<double> _y;
+    std::vector<double> _z;
+};
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_UNITVECTOR3DARRAY_H_
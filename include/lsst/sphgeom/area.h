@@ -0,0 +1,50 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_AREA_H_
+#define LSST_SPHGEOM_AREA_H_
+
+/// \file
+/// \brief This file declares a function for computing the area of the
+///        intersection of a convex polygon and another region.
+
+
+namespace lsst {
+namespace sphgeom {
+
+class ConvexPolygon;
+class Region;
+
+/// `overlapArea` returns the area in steradians of the intersection of the
+/// polygon `p` and the region `r`, which must be a ConvexPolygon, Circle or
+/// Box. Unlike relate, which only classifies the spatial relationship between
+/// two regions, the result is computed exactly up to rounding errors: the
+/// polygon is clipped by the edges of a polygon or the meridians of a box, and
+/// the area of its intersection with a circle or latitude band is obtained
+/// by integrating over the boundary arcs of the intersection.
+///
+/// \throws std::invalid_argument if `r` is of some other type.
+double overlapArea(ConvexPolygon const & p, Region const & r);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_AREA_H_
@@ -0,0 +1,225 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_ARROW_H_
+#define LSST_SPHGEOM_ARROW_H_
+
+/// \file
+/// \brief This file declares functions that operate on Arrow columns of
+///        encoded regions.
+///
+/// Regions are often stored in Arrow or Parquet tables as binary columns
+/// holding the output of `Region::encode`. The functions declared here
+/// decode, relate, test and pixelize a whole such column at once, and
+/// return their results as Arrow arrays, so that region columns can be
+/// filtered without materializing a Region object per row.
+///
+/// Arrays are exchanged through the Arrow C data interface, which is a
+/// stable ABI consisting of the two structures below. No Arrow library is
+/// needed to build or use these functions.
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "DecodedRegion.h"
+#include "Pixelization.h"
+#include "Region.h"
+#include "UnitVector3d.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+    // Array type description
+    const char * format;
+    const char * name;
+    const char * metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema ** children;
+    struct ArrowSchema * dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema *);
+    // Opaque producer-specific data
+    void * private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void ** buffers;
+    struct ArrowArray ** children;
+    struct ArrowArray * dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray *);
+    // Opaque producer-specific data
+    void * private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+#ifdef __cplusplus
+}
+#endif
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// A `RegionColumn` is a read-only view of an Arrow binary (format `z`) or
+/// large binary (format `Z`) array, each non-null value of which is a
+/// region encoded by `Region::encode`. Slices (arrays with a non-zero
+/// offset) and null values are supported.
+///
+/// A column does not copy or own the array, which must outlive it. As
+/// region encodings are only validated when accessed, methods that decode
+/// rows may throw std::runtime_error if a value is not an encoded region.
+class RegionColumn {
+public:
+    /// This constructor throws std::invalid_argument if `schema` does not
+    /// describe a binary or large binary array, or if `array` has been
+    /// released or is malformed.
+    RegionColumn(ArrowSchema const & schema, ArrowArray const & array);
+
+    /// `size` returns the number of rows in the column.
+    size_t size() const { return _size; }
+
+    bool empty() const { return _size == 0; }
+
+    /// `getNullCount` returns the number of null rows in the column.
+    size_t getNullCount() const { return _nullCount; }
+
+    /// `isNull` returns true if the i-th row of the column is null.
+    bool isNull(size_t i) const {
+        size_t j = i + _offset;
+        return _validity != nullptr && ((_validity[j >> 3] >> (j & 7)) & 1) == 0;
+    }
+
+    /// `getEncoded` returns a pointer to the encoded region in the i-th row
+    /// and its size in bytes, or a null pointer and a size of 0 if the row
+    /// is null. It throws std::out_of_range if i is not less than size().
+    std::pair<uint8_t const *, size_t> getEncoded(size_t i) const;
+
+    /// `decode` deserializes the region in the i-th row, and returns null
+    /// if the row is null.
+    std::unique_ptr<Region> decode(size_t i) const;
+
+    /// `decode` deserializes the region in the i-th row into `storage`,
+    /// and returns a pointer to it, or null if the row is null.
+    Region const * decode(size_t i, DecodedRegion & storage) const;
+
+    /// `copyValidity` writes the validity bitmap of the column, shifted so
+    /// that it starts at bit 0, to the (size() + 7)/8 bytes at `out`. All
+    /// bits are set if the column has no validity bitmap.
+    void copyValidity(uint8_t * out) const;
+
+private:
+    uint8_t const * _validity;
+    void const * _offsets;
+    uint8_t const * _data;
+    size_t _offset;
+    size_t _size;
+    size_t _nullCount;
+    bool _large;
+};
+
+/// An `ArrowColumn` owns an Arrow array and its schema, produced by one of
+/// the column functions below. Ownership can be handed to any consumer of
+/// the Arrow C data interface with `exportTo`, after which the column is
+/// empty. Otherwise, the array is released when the column is destroyed.
+class ArrowColumn {
+public:
+    ArrowColumn();
+    ArrowColumn(ArrowSchema schema, ArrowArray array);
+    ArrowColumn(ArrowColumn const &) = delete;
+    ArrowColumn(ArrowColumn && other) noexcept;
+    ArrowColumn & operator=(ArrowColumn const &) = delete;
+    ArrowColumn & operator=(ArrowColumn && other) noexcept;
+    ~ArrowColumn();
+
+    /// `empty` returns true if this column holds no array.
+    bool empty() const { return _array.release == nullptr; }
+
+    ArrowSchema const & getSchema() const { return _schema; }
+    ArrowArray const & getArray() const { return _array; }
+
+    /// `exportTo` moves the schema and array of this column into the
+    /// structures pointed to, which take ownership of them. Either pointer
+    /// may be null, in which case that structure is released instead. It
+    /// throws std::runtime_error if this column is empty.
+    void exportTo(ArrowSchema * schema, ArrowArray * array);
+
+private:
+    void _release();
+
+    ArrowSchema _schema;
+    ArrowArray _array;
+};
+
+/// `relateColumn` returns an Arrow uint8 (format `C`) array of the
+/// relationships between the region in each row of `column` and `region`,
+/// i.e. `column.decode(i)->relate(region)`. Null rows give null results.
+/// If `numThreads` is greater than one, blocks of rows are divided among
+/// that many threads, including the calling thread.
+ArrowColumn relateColumn(RegionColumn const & column,
+                         Region const & region,
+                         unsigned numThreads = 1);
+
+/// `containsColumn` returns an Arrow boolean (format `b`) array indicating
+/// which of the regions in `column` contain `v`. Null rows give null
+/// results. Arguments are otherwise as for `relateColumn`.
+ArrowColumn containsColumn(RegionColumn const & column,
+                           UnitVector3d const & v,
+                           unsigned numThreads = 1);
+
+/// `envelopeColumn` returns the envelope of the region in each row of
+/// `column`, computed by `pixelization.envelope(region, maxRanges)`, as an
+/// Arrow large list (format `+L`) of two element fixed size lists (format
+/// `+w:2`) of uint64 (format `L`) values. Each list element is a half-open
+/// pixel index range [begin, end), where, as in `RangeSet`, an end of 0
+/// stands for 2⁶⁴. Null rows give null results. Arguments are otherwise as
+/// for `relateColumn`.
+ArrowColumn envelopeColumn(RegionColumn const & column,
+                           Pixelization const & pixelization,
+                           size_t maxRanges = 0,
+                           unsigned numThreads = 1);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_ARROW_H_
@@ -0,0 +1,84 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_BOXJOIN_H_
+#define LSST_SPHGEOM_BOXJOIN_H_
+
+/// \file
+/// \brief This file declares functions for finding the intersecting pairs
+///        of boxes or regions in large collections.
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "Box3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+class Region;
+
+/// `boxJoin` returns the index pairs (i, j), with i < j, of the boxes
+/// `boxes[i]` and `boxes[j]` that intersect, sorted in increasing order.
+/// Pair (i, j) is returned exactly when `boxes[i].intersects(boxes[j])`,
+/// so empty boxes never appear in the result.
+///
+/// The boxes are sorted by the lower bound of their x intervals and swept
+/// in that order, so that each box is only compared against the boxes whose
+/// x intervals overlap its own. The y and z intervals are compared from
+/// separate arrays of bounds, without branching. If `numThreads` is greater
+/// than one, the sweep is distributed over that many threads. The result
+/// does not depend on the number of threads.
+std::vector<std::pair<size_t, size_t>> boxJoin(std::vector<Box3d> const & boxes,
+                                               unsigned numThreads = 1);
+
+/// `boxJoin` returns the index pairs (i, j) of the boxes `a[i]` and `b[j]`
+/// that intersect, sorted in increasing order. Pair (i, j) is returned
+/// exactly when `a[i].intersects(b[j])`.
+std::vector<std::pair<size_t, size_t>> boxJoin(std::vector<Box3d> const & a,
+                                               std::vector<Box3d> const & b,
+                                               unsigned numThreads = 1);
+
+/// `regionJoin` returns the index pairs (i, j), with i < j, of the regions
+/// `regions[i]` and `regions[j]` that may intersect, sorted in increasing
+/// order. The candidate pairs are found with `boxJoin` on the 3-D bounding
+/// boxes of the regions, and a candidate pair is only returned if `relate`
+/// cannot prove that its regions are disjoint. Like `relate`, this is
+/// conservative: a pair of disjoint regions may be returned, but a pair of
+/// intersecting regions is never omitted.
+std::vector<std::pair<size_t, size_t>> regionJoin(
+    std::vector<std::unique_ptr<Region>> const & regions,
+    unsigned numThreads = 1);
+
+/// `regionJoin` returns the index pairs (i, j) of the regions `a[i]` and
+/// `b[j]` that may intersect, sorted in increasing order.
+std::vector<std::pair<size_t, size_t>> regionJoin(
+    std::vector<std::unique_ptr<Region>> const & a,
+    std::vector<std::unique_ptr<Region>> const & b,
+    unsigned numThreads = 1);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_BOXJOIN_H_
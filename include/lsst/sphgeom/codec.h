@@ -121,6 +121,57 @@ inline std::uint64_t decodeU64(uint8_t const * buffer) {
 #endif
 }
 
+/// `encodeU32` appends an uint32 in little-endian byte order
+/// to the end of buffer.
+inline void encodeU32(std::uint32_t item, std::vector<uint8_t> & buffer) {
+    buffer.push_back(static_cast<uint8_t>(item));
+    buffer.push_back(static_cast<uint8_t>(item >> 8));
+    buffer.push_back(static_cast<uint8_t>(item >> 16));
+    buffer.push_back(static_cast<uint8_t>(item >> 24));
+}
+
+/// `decodeU32` extracts an uint32 from the 4 byte little-endian byte
+/// sequence in buffer.
+inline std::uint32_t decodeU32(uint8_t const * buffer) {
+    return static_cast<std::uint32_t>(buffer[0]) +
+        (static_cast<std::uint32_t>(buffer[1]) << 8) +
+        (static_cast<std::uint32_t>(buffer[2]) << 16) +
+        (static_cast<std::uint32_t>(buffer[3]) << 24);
+}
+
+/// `encodeVarint` appends an uint64 to the end of buffer as a variable
+/// length little-endian sequence of 7 bit groups. The high bit of each byte
+/// is set iff another byte follows, so that values below 128 occupy a single
+/// byte and no value occupies more than 10.
+inline void encodeVarint(std::uint64_t item, std::vector<uint8_t> & buffer) {
+    while (item >= 0x80) {
+        buffer.push_back(static_cast<uint8_t>(item) | 0x80);
+        item >>= 7;
+    }
+    buffer.push_back(static_cast<uint8_t>(item));
+}
+
+/// `decodeVarint` extracts an uint64 encoded by encodeVarint from the bytes
+/// in [buffer, end). It returns a pointer to the byte following the encoded
+/// value, or nullptr if [buffer, end) does not start with a valid encoding.
+inline uint8_t const * decodeVarint(uint8_t const * buffer,
+                                    uint8_t const * end,
+                                    std::uint64_t & item) {
+    std::uint64_t u = 0;
+    for (int shift = 0; shift < 64 && buffer != end; shift += 7) {
+        std::uint64_t b = *buffer++;
+        if (shift == 63 && b > 1) {
+            return nullptr;
+        }
+        u |= (b & 0x7f) << shift;
+        if (b < 0x80) {
+            item = u;
+            return buffer;
+        }
+    }
+    return nullptr;
+}
+
 }} // namespace lsst::sphgeom
 
 #endif // LSST_SPHGEOM_CODEC_H_
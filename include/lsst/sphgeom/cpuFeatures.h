@@ -0,0 +1,74 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_CPUFEATURES_H_
+#define LSST_SPHGEOM_CPUFEATURES_H_
+
+/// \file
+/// \brief This file declares functions for inspecting and restricting the
+///        instruction set extensions used by batch kernels.
+///
+/// The library is compiled for a baseline instruction set (x86-64 with SSE2,
+/// or aarch64). Batch kernels that benefit from wider vectors or special
+/// instructions are additionally compiled for those extensions, and the
+/// variant to run is chosen when the kernel is called, according to the
+/// features of the CPU. All variants of a kernel compute identical results.
+///
+/// Setting the environment variable `SPHGEOM_BASELINE_KERNELS` to a value
+/// other than "0" before the library is first used disables all optional
+/// kernel variants.
+
+namespace lsst {
+namespace sphgeom {
+
+/// `CpuFeatures` lists the optional instruction set extensions that batch
+/// kernels can dispatch to.
+struct CpuFeatures {
+    /// AVX2 (x86-64): batch orientation, polygon containment, point indexing
+    /// for Q3C pixelizations, batch matrix products, unit vector array
+    /// conversions, and pair finding for cross matches.
+    bool avx2 = false;
+    /// BMI2 pdep and pext (x86-64), when implemented in hardware: batch
+    /// Morton and Hilbert index computations.
+    bool fastBmi2 = false;
+    /// Advanced SIMD (aarch64): batch orientation and polygon containment.
+    bool neon = false;
+};
+
+/// `detectCpuFeatures` returns the optional features that the library was
+/// compiled with and that the CPU executing the calling code supports.
+CpuFeatures detectCpuFeatures();
+
+/// `getCpuFeatures` returns the features that batch kernels currently
+/// dispatch to.
+CpuFeatures getCpuFeatures();
+
+/// `setCpuFeatures` sets the features that batch kernels dispatch to.
+/// Features that are not detected are ignored, and setting every member of
+/// `features` to false selects the baseline kernels. Since results do not
+/// depend on the kernel variant, this is mainly useful for testing and
+/// benchmarking.
+void setCpuFeatures(CpuFeatures const & features);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_CPUFEATURES_H_
@@ -0,0 +1,67 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_CROSSMATCH_H_
+#define LSST_SPHGEOM_CROSSMATCH_H_
+
+/// \file
+/// \brief This file declares a function for spatially cross-matching two
+///        sets of points.
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Angle.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+class UnitVector3dArray;
+
+/// `crossMatch` returns the index pairs (i, j) of the points `a[i]` and `b[j]`
+/// that are separated by at most the given radius, sorted in increasing
+/// order. Pair (i, j) is returned exactly when
+/// `Circle(a[i], radius).contains(b[j])`.
+///
+/// Both inputs are partitioned with a modified Q3C pixelization, at the
+/// finest level for which the pixels sharing a vertex with a pixel P cover
+/// every point within the radius of P. The points of each pixel of `a` are
+/// then compared against the points of its neighborhood in `b`, with the
+/// batch distance kernel of `findPairsWithin`. If `numThreads` is greater
+/// than one, the pixels of `a` are distributed over that many threads.
+/// The result does not depend on the number of threads.
+std::vector<std::pair<size_t, size_t>> crossMatch(UnitVector3dArray const & a,
+                                                  UnitVector3dArray const & b,
+                                                  Angle radius,
+                                                  unsigned numThreads = 1);
+
+/// `crossMatchLevel` returns the modified Q3C subdivision level that
+/// `crossMatch` uses for inputs with `n` points in total,
+/// or -1 if the radius is so large that all pairs of points are compared
+/// directly.
+int crossMatchLevel(Angle radius, size_t n);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_CROSSMATCH_H_
@@ -0,0 +1,127 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_INLINEKERNELS_H_
+#define LSST_SPHGEOM_INLINEKERNELS_H_
+
+/// \file
+/// \brief This file provides header-only variants of a few hot geometric
+///        kernels, so that calls from tight loops can be inlined.
+
+#include <cmath>
+#include <stdexcept>
+
+#include "Angle.h"
+#include "UnitVector3d.h"
+#include "Vector3d.h"
+#include "orientation.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// The functions in this namespace compute exactly the same results as
+/// their out-of-line counterparts elsewhere in the library, but are defined
+/// in this header so that the compiler can inline (and possibly vectorize)
+/// them into the loops that call them. Results are identical provided that
+/// the caller is compiled without floating point contraction (the default
+/// in strict ISO C++ modes), as the library itself is.
+namespace inlined {
+
+/// `normalize` scales v to unit norm and returns its original norm, exactly
+/// like `Vector3d::normalize`.
+///
+/// \throws std::runtime_error if v is the zero vector.
+inline double normalize(Vector3d & v) {
+    double x = v.x(), y = v.y(), z = v.z();
+    double ax = std::fabs(x), ay = std::fabs(y), az = std::fabs(z);
+    // Arrange for w to be the component with the largest absolute value.
+    // When several components tie, the choice does not affect the result,
+    // since each of them is scaled to ±1 before taking the norm.
+    double * w = &z;
+    double * u = &x;
+    double * t = &y;
+    if (ax > ay) {
+        if (ax > az) { w = &x; u = &y; t = &z; }
+    } else if (ay > az) {
+        w = &y; u = &x; t = &z;
+    }
+    if (*w == 0.0) {
+        throw std::runtime_error("Cannot normalize zero vector");
+    }
+    // Divide components by the absolute value of the largest
+    // component to avoid overflow/underflow.
+    double maxabs = std::fabs(*w);
+    *u /= maxabs;
+    *t /= maxabs;
+    *w = std::copysign(1.0, *w);
+    double norm = std::sqrt(1.0 + (*u * *u + *t * *t));
+    v = Vector3d(x / norm, y / norm, z / norm);
+    return norm * maxabs;
+}
+
+/// `normalized` returns the unit vector in the direction of v, exactly like
+/// `UnitVector3d(v)`.
+///
+/// \throws std::runtime_error if v is the zero vector.
+inline UnitVector3d normalized(Vector3d const & v) {
+    Vector3d n = v;
+    normalize(n);
+    return UnitVector3d::fromNormalized(n);
+}
+
+/// `unitVector` returns the unit vector with the given longitude and
+/// latitude, exactly like `UnitVector3d(lon, lat)`.
+inline UnitVector3d unitVector(Angle lon, Angle lat) {
+    double sinLon = sin(lon);
+    double cosLon = cos(lon);
+    double sinLat = sin(lat);
+    double cosLat = cos(lat);
+    return UnitVector3d::fromNormalized(cosLon * cosLat,
+                                        sinLon * cosLat,
+                                        sinLat);
+}
+
+/// `orientation` returns the same value as `lsst::sphgeom::orientation`.
+/// The double precision determinant and its fixed error bound are evaluated
+/// inline, and only the calls that this filter cannot decide are passed on
+/// to the out-of-line implementation. Decisions made inline are not counted
+/// by the orientation statistics.
+inline int orientation(UnitVector3d const & a,
+                       UnitVector3d const & b,
+                       UnitVector3d const & c) {
+    double determinant = a.x() * (b.y() * c.z() - b.z() * c.y()) +
+                         a.y() * (b.z() * c.x() - b.x() * c.z()) +
+                         a.z() * (b.x() * c.y() - b.y() * c.x());
+    if (determinant > ORIENTATION_MAX_ABSOLUTE_ERROR) {
+        return 1;
+    } else if (determinant < -ORIENTATION_MAX_ABSOLUTE_ERROR) {
+        return -1;
+    }
+    return ::lsst::sphgeom::orientation(a, b, c);
+}
+
+} // namespace inlined
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_INLINEKERNELS_H_
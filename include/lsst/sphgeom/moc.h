@@ -0,0 +1,94 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_MOC_H_
+#define LSST_SPHGEOM_MOC_H_
+
+/// \file
+/// \brief This file declares functions for reading and writing IVOA
+///        Multi-Order Coverage maps (MOCs).
+///
+/// A spatial MOC is a set of HEALPix NESTED pixels of orders (levels) 0
+/// through 29. Here, MOCs are represented as RangeSets of level 29 HEALPix
+/// nested pixel indexes (see HealpixPixelization), so that MOC union,
+/// intersection and difference are just the corresponding RangeSet
+/// operations, and MOCs can be combined directly with the envelopes and
+/// interiors of regions computed by `HealpixPixelization(29)`.
+///
+/// Both the ASCII serialization (e.g. `"1/0-3 8 3/512,517"`) and the FITS
+/// serialization (a binary table extension with a single 64 bit integer
+/// column of NUNIQ values, or of range bounds for `ORDERING = 'RANGE'`) of
+/// the MOC 1.1 and 2.0 standards are supported. Readers parse their input
+/// incrementally in fixed size blocks, and accumulate the pixels of each
+/// order separately, so that the pixels of a MOC listed in the usual
+/// ascending order are appended to RangeSets without any searching.
+
+#include <iosfwd>
+#include <string>
+
+#include "RangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+/// `MOC_MAX_ORDER` is the maximum order of a spatial MOC.
+constexpr int MOC_MAX_ORDER = 29;
+
+/// `readMocAscii` parses a MOC in the ASCII serialization, and returns its
+/// pixels at order 29. A leading `s` (space) prefix, as written by MOC 2.0
+/// tools, is accepted. It throws std::runtime_error if the input is invalid.
+RangeSet readMocAscii(std::istream & is);
+
+/// `writeMocAscii` writes the pixels in `s`, which are level 29 HEALPix
+/// nested indexes, as a MOC of the given order in the ASCII serialization.
+/// If `order` is less than 29, the pixels are coarsened to that order, so
+/// that the MOC covers them. It throws std::invalid_argument if `order` is
+/// not in [0, 29] or if `s` contains indexes that are not valid level 29
+/// HEALPix indexes.
+void writeMocAscii(std::ostream & os, RangeSet const & s,
+                   int order = MOC_MAX_ORDER);
+
+/// `readMocFits` parses a MOC in the FITS serialization, and returns its
+/// pixels at order 29. It throws std::runtime_error if the input is not a
+/// FITS file containing a MOC.
+RangeSet readMocFits(std::istream & is);
+
+/// `writeMocFits` writes the pixels in `s` as a MOC of the given order in
+/// the FITS (NUNIQ) serialization. Arguments are as for writeMocAscii.
+void writeMocFits(std::ostream & os, RangeSet const & s,
+                  int order = MOC_MAX_ORDER);
+
+/// `readMoc` reads a MOC from the file with the given path, which may use
+/// either serialization. It throws std::runtime_error if the file cannot be
+/// read or does not contain a MOC.
+RangeSet readMoc(std::string const & path);
+
+/// `writeMoc` writes a MOC to the file with the given path, using the FITS
+/// serialization if `fits` is true, and the ASCII one otherwise. It throws
+/// std::runtime_error if the file cannot be written.
+void writeMoc(std::string const & path, RangeSet const & s,
+              int order = MOC_MAX_ORDER, bool fits = true);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_MOC_H_
@@ -26,19 +26,28 @@
 /// \file
 /// \brief This file declares functions for orienting points on the sphere.
 
+#include <cstddef>
+#include <cstdint>
+
 #include "UnitVector3d.h"
 
 
 namespace lsst {
 namespace sphgeom {
 
+/// `ORIENTATION_MAX_ABSOLUTE_ERROR`, a little larger than 3 * 5ε where
+/// ε = 2^-53, is an upper bound on the absolute error in the double precision
+/// determinant of 3 unit vectors computed by `orientation`. Determinants
+/// with larger magnitudes have the correct sign.
+constexpr double ORIENTATION_MAX_ABSOLUTE_ERROR = 1.7e-15;
+
 /// `orientationExact` computes and returns the orientations of 3 vectors a, b
 /// and c, which need not be normalized but are assumed to have finite
 /// components. The return value is +1 if the vectors a, b, and c are in
 /// counter-clockwise orientation, 0 if they are coplanar, colinear, or
 /// identical, and -1 if they are in clockwise orientation. The implementation
-/// uses arbitrary precision arithmetic to avoid floating point rounding error,
-/// underflow and overflow.
+/// uses exact fixed point integer arithmetic to avoid floating point rounding
+/// error, underflow and overflow.
 int orientationExact(Vector3d const & a,
                      Vector3d const & b,
                      Vector3d const & c);
@@ -53,12 +62,61 @@ int orientationExact(Vector3d const & a,
 /// a, b and c as columns/rows.
 ///
 /// The implementation proceeds by first computing a double precision
-/// approximation, and then falling back to arbitrary precision arithmetic
+/// approximation, and then falling back to floating point expansion
+/// arithmetic, or as a last resort to exact integer arithmetic,
 /// when necessary. Consequently, the result is exact.
 int orientation(UnitVector3d const & a,
                 UnitVector3d const & b,
                 UnitVector3d const & c);
 
+/// `orientationBatch` computes `out[i] = orientation(a[i], b[i], c[i])` for
+/// i in [0, n). It is faster than calling `orientation` n times, because
+/// the double precision approximations are computed several at a time.
+void orientationBatch(UnitVector3d const * a,
+                      UnitVector3d const * b,
+                      UnitVector3d const * c,
+                      int * out,
+                      size_t n);
+
+/// `orientationEdges` computes the orientation of v with respect to each
+/// edge of the closed chain of n vertices, i.e. it sets
+/// `out[i] = orientation(v, vertices[i], vertices[(i + 1) % n])` for i in
+/// [0, n).
+void orientationEdges(UnitVector3d const & v,
+                      UnitVector3d const * vertices,
+                      int * out,
+                      size_t n);
+
+/// `OrientationStatistics` records how many orientation computations were
+/// decided by each stage of the implementation, from cheapest to most
+/// expensive.
+struct OrientationStatistics {
+    /// Decided by the double precision determinant and a fixed error bound.
+    uint64_t fast = 0;
+    /// Decided by the double precision determinant and a tighter error
+    /// bound derived from the permanent.
+    uint64_t permanent = 0;
+    /// Decided because two of the inputs were identical or antipodal.
+    uint64_t degenerate = 0;
+    /// Decided exactly using floating point expansion arithmetic.
+    uint64_t expansion = 0;
+    /// Decided exactly using integer arithmetic, by `orientationExact`.
+    uint64_t exact = 0;
+};
+
+/// `enableOrientationStatistics` turns the collection of statistics for
+/// `orientation`, `orientationX`, `orientationY` and `orientationZ` on or
+/// off. Collection is off by default; when on, every call updates a shared
+/// counter, which is slow when many threads compute orientations at once.
+void enableOrientationStatistics(bool enable);
+
+/// `getOrientationStatistics` returns the statistics collected since the
+/// last call to `resetOrientationStatistics`.
+OrientationStatistics getOrientationStatistics();
+
+/// `resetOrientationStatistics` sets all orientation statistics to zero.
+void resetOrientationStatistics();
+
 /// `orientationX(b, c)` is equivalent to `orientation(UnitVector3d::X(), b, c)`.
 int orientationX(UnitVector3d const & b, UnitVector3d const & c);
 
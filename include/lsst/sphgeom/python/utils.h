@@ -24,10 +24,12 @@
 #define LSST_SPHGEOM_PYTHON_UTILS_H_
 
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
 
 #include <limits>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
 
 #include "lsst/sphgeom/Region.h"
 
@@ -81,6 +83,27 @@ inline std::vector<std::unique_ptr<Region>> convert_region_sequence(S const & se
     return result;
 }
 
+/// Compute the vertices of the pixels with the given indexes, using the
+/// batch `vertices` method of pixelization P. The result has the shape of
+/// `indexes`, followed by (P::NUM_VERTICES, 3).
+template <typename P>
+pybind11::array_t<double> pixelVertices(
+        P const &self,
+        pybind11::array_t<uint64_t, pybind11::array::c_style | pybind11::array::forcecast> indexes) {
+    std::vector<pybind11::ssize_t> shape(indexes.shape(), indexes.shape() + indexes.ndim());
+    shape.push_back(P::NUM_VERTICES);
+    shape.push_back(3);
+    pybind11::array_t<double> result(shape);
+    uint64_t const *data = indexes.data();
+    size_t n = static_cast<size_t>(indexes.size());
+    double *out = result.mutable_data();
+    {
+        pybind11::gil_scoped_release release;
+        self.vertices(data, n, out);
+    }
+    return result;
+}
+
 }  // python
 }  // sphgeom
 }  // lsst
@@ -0,0 +1,74 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_SPATIALSORT_H_
+#define LSST_SPHGEOM_SPATIALSORT_H_
+
+/// \file
+/// \brief This file declares functions for ordering points along a
+///        space filling curve.
+
+#include <cstddef>
+#include <vector>
+
+
+namespace lsst {
+namespace sphgeom {
+
+class Pixelization;
+class UnitVector3dArray;
+
+/// `spatialSort` returns the permutation p of [0, n) that sorts the points
+/// (x[p[i]], y[p[i]], z[p[i]]), which need not be normalized, by their pixel
+/// indexes. Points in the same pixel keep their relative order. Reordering
+/// rows with p clusters them spatially, which makes joins and per-block
+/// bounds (e.g. of Parquet row groups) much more selective.
+///
+/// Indexes are computed with the batch `Pixelization::index`, and sorted
+/// with a radix sort. If `numThreads` is greater than one, both steps are
+/// divided among that many threads. The result does not depend on the
+/// number of threads.
+std::vector<size_t> spatialSort(Pixelization const & pixelization,
+                                double const * x,
+                                double const * y,
+                                double const * z,
+                                size_t n,
+                                unsigned numThreads = 1);
+
+/// `spatialSort` sorts points by their modified Q3C indexes at the given
+/// subdivision level. Since these follow a Hilbert curve, consecutive
+/// points are almost always close together. It throws
+/// std::invalid_argument if the level is invalid.
+std::vector<size_t> spatialSort(double const * x,
+                                double const * y,
+                                double const * z,
+                                size_t n,
+                                int level,
+                                unsigned numThreads = 1);
+
+std::vector<size_t> spatialSort(UnitVector3dArray const & points,
+                                int level,
+                                unsigned numThreads = 1);
+
+}} // namespace lsst::sphgeom
+
+#endif // LSST_SPHGEOM_SPATIALSORT_H_
@@ -26,6 +26,10 @@
 /// \file
 /// \brief This file declares miscellaneous utility functions.
 
+#include <cstddef>
+#include <utility>
+#include <vector>
+
 #include "Angle.h"
 
 
@@ -35,6 +39,7 @@ namespace sphgeom {
 // Forward declarations
 class Vector3d;
 class UnitVector3d;
+class UnitVector3dArray;
 
 /// Let p be the unit vector closest to v that lies on the plane with
 /// normal n in the direction of the cross product of a and b. If p is in the
@@ -83,6 +88,46 @@ Vector3d getWeightedCentroid(UnitVector3d const & v0,
                              UnitVector3d const & v1,
                              UnitVector3d const & v2);
 
+///@{
+/// `getSquaredChordLengths` computes the squared chord lengths ‖v - p‖²
+/// between each point v in `a` and each point p in `b`. The result for the
+/// i-th point of `a` and the j-th point of `b` is stored in
+/// `out[i * b.size() + j]`. The kernels process several points at a time
+/// using AVX2 where the CPU supports it, and their results are identical to
+/// those of `(v - p).getSquaredNorm()`.
+void getSquaredChordLengths(UnitVector3d const & v,
+                            UnitVector3dArray const & b,
+                            double * out);
+void getSquaredChordLengths(UnitVector3dArray const & a,
+                            UnitVector3dArray const & b,
+                            double * out);
+///@}
+
+///@{
+/// `getAngularSeparations` computes the angular separations (in radians)
+/// between each point in `a` and each point in `b`, with the same output
+/// layout as `getSquaredChordLengths`. Separations are derived from squared
+/// chord lengths as in `Circle::openingAngleFor`, and so are accurate for
+/// both small and large angles.
+void getAngularSeparations(UnitVector3d const & v,
+                           UnitVector3dArray const & b,
+                           double * out);
+void getAngularSeparations(UnitVector3dArray const & a,
+                           UnitVector3dArray const & b,
+                           double * out);
+///@}
+
+/// `findPairsWithin` appends the index pairs (i, j) of the points in `a` and
+/// `b` that are separated by at most the given radius to `pairs`, in no
+/// particular order. Pair (i, j) is found exactly when
+/// `Circle(a[i], radius).contains(b[j])`, so a cross-match may use this
+/// function on the points of one pixel (or chunk) at a time. The points of
+/// `b` are processed in cache sized blocks, so that `b` may be large.
+void findPairsWithin(UnitVector3dArray const & a,
+                     UnitVector3dArray const & b,
+                     Angle radius,
+                     std::vector<std::pair<size_t, size_t>> & pairs);
+
 }} // namespace lsst::sphgeom
 
 #endif // LSST_SPHGEOM_UTILS_H_
@@ -0,0 +1,236 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+"""Generates `src/HtmTables.h`, which contains the vertices of all HTM
+trixels at subdivision levels 0 through `LEVEL`, the normals of the edges
+separating the children of trixels at levels 0 through `LEVEL - 1`, and
+the edge adjacencies of the root triangles.
+
+Vertices are computed with the same floating point operations, in the
+same order, as the C++ code in `src/HtmPixelization.cc` and
+`Vector3d::normalize`, so that the tabulated values are identical to the
+ones that code computes. Usage:
+
+    python misc/makeHtmTables.py > src/HtmTables.h
+"""
+
+import math
+
+LEVEL = 3
+
+LICENSE = """\
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */"""
+
+X = (1.0, 0.0, 0.0)
+Y = (0.0, 1.0, 0.0)
+Z = (0.0, 0.0, 1.0)
+
+
+def neg(v):
+    """Return -v, negating zero components as C++ does."""
+    return tuple(-c for c in v)
+
+
+# The root triangle vertices, as in `rootVertex` of HtmPixelization.cc.
+ROOTS = [
+    (X, neg(Z), Y),
+    (Y, neg(Z), neg(X)),
+    (neg(X), neg(Z), neg(Y)),
+    (neg(Y), neg(Z), X),
+    (X, Z, neg(Y)),
+    (neg(Y), Z, neg(X)),
+    (neg(X), Z, Y),
+    (Y, Z, X),
+]
+
+
+def normalize(v):
+    """Return v / |v|, computed as in `Vector3d::normalize`.
+
+    The component with the largest absolute value is divided out first.
+    When several components tie, the choice does not change the result.
+    """
+    w = max(range(3), key=lambda i: abs(v[i]))
+    u, t = [i for i in range(3) if i != w]
+    maxabs = abs(v[w])
+    a = v[u] / maxabs
+    b = v[t] / maxabs
+    norm = math.sqrt(1.0 + (a * a + b * b))
+    out = [0.0] * 3
+    out[u] = a / norm
+    out[t] = b / norm
+    out[w] = math.copysign(1.0, v[w]) / norm
+    return tuple(out)
+
+
+def midpoint(a, b):
+    """Return the normalized sum of a and b."""
+    return normalize(tuple(x + y for x, y in zip(a, b)))
+
+
+def children(t):
+    """Return the children of trixel t, as in `HtmPixelFinder::expand`."""
+    v0, v1, v2 = t
+    m0 = midpoint(v1, v2)
+    m1 = midpoint(v2, v0)
+    m2 = midpoint(v0, v1)
+    return [(v0, m2, m1), (v1, m0, m2), (v2, m1, m0), (m0, m1, m2)]
+
+
+def cross(b, c):
+    """Return the cross product of b and c, computed as the determinant
+    in `inlined::orientation`.
+    """
+    return (b[1] * c[2] - b[2] * c[1],
+            b[2] * c[0] - b[0] * c[2],
+            b[0] * c[1] - b[1] * c[0])
+
+
+def child_normals(t):
+    """Return the normals of the edges between the children of trixel t,
+    in the order they are tested by `locate` in HtmPixelization.cc.
+    """
+    v0, v1, v2 = t
+    m0 = midpoint(v1, v2)
+    m1 = midpoint(v2, v0)
+    m2 = midpoint(v0, v1)
+    return [cross(m2, m1), cross(m0, m2), cross(m1, m0)]
+
+
+def print_rows(levels, row):
+    """Print the 3x3 table rows row(t) for the trixels t in levels."""
+    n = 0
+    for level, trixels in enumerate(levels):
+        for i, t in enumerate(trixels):
+            index = (8 << (2 * level)) + i
+            assert index - (16 << (2 * level)) // 3 - 3 == n
+            print("    // %d" % index)
+            for j, v in enumerate(row(t)):
+                print("    %s{%s}%s" % (
+                    "{" if j == 0 else " ",
+                    ", ".join(fmt(c) for c in v),
+                    "}," if j == 2 else ","))
+            n += 1
+
+
+def root_adjacency():
+    """Return the neighbor and its edge index across each root edge."""
+    adj = []
+    for r in range(8):
+        row = []
+        for j in range(3):
+            a = ROOTS[r][(j + 1) % 3]
+            b = ROOTS[r][(j + 2) % 3]
+            for s in range(8):
+                for k in range(3):
+                    if ROOTS[s][(k + 1) % 3] == b and ROOTS[s][(k + 2) % 3] == a:
+                        row.append((s, k))
+        adj.append(row)
+    return adj
+
+
+def fmt(x):
+    """Format x as a C++ literal that round-trips exactly."""
+    return repr(x)
+
+
+def main():
+    levels = [ROOTS]
+    for _ in range(LEVEL):
+        levels.append([c for t in levels[-1] for c in children(t)])
+    rows = sum(len(trixels) for trixels in levels)
+    print(LICENSE)
+    print()
+    print("// This file was generated by misc/makeHtmTables.py. Do not edit.")
+    print()
+    print("#ifndef LSST_SPHGEOM_HTMTABLES_H_")
+    print("#define LSST_SPHGEOM_HTMTABLES_H_")
+    print()
+    print("#include <cstdint>")
+    print()
+    print()
+    print("namespace lsst {")
+    print("namespace sphgeom {")
+    print("namespace detail {")
+    print()
+    print("// `HTM_TABLE_LEVEL` is the deepest subdivision level with tabulated")
+    print("// trixel vertices.")
+    print("constexpr int HTM_TABLE_LEVEL = %d;" % LEVEL)
+    print()
+    print("// `htmTableRow` returns the row of `HTM_TRIXEL_VERTICES` holding the")
+    print("// trixel with index i at subdivision level l <= HTM_TABLE_LEVEL.")
+    print("// Trixels are stored by level, and in index order within a level.")
+    print("constexpr uint64_t htmTableRow(uint64_t i, int l) {")
+    print("    return i - (static_cast<uint64_t>(16) << (2 * l)) / 3 - 3;")
+    print("}")
+    print()
+    print("// `HTM_TRIXEL_VERTICES` contains the (x, y, z) components of the")
+    print("// vertices of every trixel at levels 0 through HTM_TABLE_LEVEL.")
+    print("alignas(64) constexpr double HTM_TRIXEL_VERTICES[%d][3][3] = {" % rows)
+    print_rows(levels, lambda t: t)
+    print("};")
+    print()
+    print("// `HTM_CHILD_EDGE_NORMALS` contains, for every trixel at levels 0")
+    print("// through HTM_TABLE_LEVEL - 1, the double precision cross products")
+    print("// m01 × m20, m12 × m01 and m20 × m12 of its edge midpoints. Rows are")
+    print("// indexed by `htmTableRow`.")
+    print("alignas(64) constexpr double HTM_CHILD_EDGE_NORMALS[%d][3][3] = {" %
+          (rows - len(levels[-1])))
+    print_rows(levels[:-1], child_normals)
+    print("};")
+    print()
+    print("// `HTM_ROOT_ADJACENCY[r][j]` holds the root triangle (0-7) on the")
+    print("// other side of edge j of root triangle r, and the index of that")
+    print("// edge in the neighbor.")
+    print("constexpr uint8_t HTM_ROOT_ADJACENCY[8][3][2] = {")
+    for r, row in enumerate(root_adjacency()):
+        print("    {%s}%s" % (", ".join("{%d, %d}" % a for a in row),
+                             "," if r != 7 else ""))
+    print("};")
+    print()
+    print("}}} // namespace lsst::sphgeom::detail")
+    print()
+    print("#endif // LSST_SPHGEOM_HTMTABLES_H_")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,69 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+"""airspeed velocity benchmarks for lsst.sphgeom.
+
+These measure the cost of calling into the library from Python, both per
+element (one call per point or range) and in bulk (one call per array), so
+that regressions in the binding layer show up alongside those in the C++
+code.
+"""
+
+import numpy as np
+from lsst.sphgeom import Angle, Box, Circle, ConvexPolygon, Ellipse, LonLat, UnitVector3d
+
+# Region sizes (radii or half-widths) in arcseconds, from 0.01 to 10 degrees.
+REGION_SIZES = [36, 360, 3600, 36000]
+
+REGION_KINDS = ["circle", "box", "polygon", "ellipse"]
+
+
+def random_points(n, seed=1):
+    """Return arrays x, y, z of n points distributed uniformly over the
+    sphere.
+    """
+    rng = np.random.default_rng(seed)
+    v = rng.normal(size=(3, n))
+    v /= np.sqrt(np.sum(v * v, axis=0))
+    return v[0], v[1], v[2]
+
+
+def region_center():
+    """Return the center of all benchmark regions."""
+    return UnitVector3d(LonLat.fromDegrees(10.0, 20.0))
+
+
+def make_region(kind, size):
+    """Return a region of the given kind and size in arcseconds."""
+    c = region_center()
+    r = Angle.fromDegrees(size / 3600.0)
+    if kind == "circle":
+        return Circle(c, r)
+    if kind == "box":
+        return Box(LonLat(c), r, r)
+    if kind == "ellipse":
+        return Ellipse(c, r, Angle.fromDegrees(size / 7200.0), Angle.fromDegrees(30.0))
+    if kind == "polygon":
+        n = UnitVector3d.orthogonalTo(c)
+        v = c.rotatedAround(n, r)
+        return ConvexPolygon([v.rotatedAround(c, Angle.fromDegrees(60.0 * i)) for i in range(6)])
+    raise ValueError(f"unknown region kind {kind!r}")
@@ -0,0 +1,107 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+"""Benchmarks for the pixelizations."""
+
+import numpy as np
+from lsst.sphgeom import (
+    HealpixPixelization,
+    HtmPixelization,
+    Mq3cPixelization,
+    Q3cPixelization,
+    UnitVector3d,
+)
+
+from . import REGION_KINDS, REGION_SIZES, make_region, random_points
+
+PIXELIZATIONS = {
+    "htm": HtmPixelization,
+    "q3c": Q3cPixelization,
+    "mq3c": Mq3cPixelization,
+    "healpix": HealpixPixelization,
+}
+
+
+class Index:
+    """Per-element and bulk point indexing."""
+
+    params = (list(PIXELIZATIONS), [5, 10, 20], [1000, 100000])
+    param_names = ["scheme", "level", "n"]
+
+    def setup(self, scheme, level, n):
+        self.pixelization = PIXELIZATIONS[scheme](level)
+        self.x, self.y, self.z = random_points(n)
+        self.lon = np.arctan2(self.y, self.x)
+        self.lat = np.arcsin(self.z)
+
+    def time_index_per_element(self, scheme, level, n):
+        # Dominated by UnitVector3d construction and per-call overhead.
+        index = self.pixelization.index
+        for x, y, z in zip(self.x.tolist(), self.y.tolist(), self.z.tolist()):
+            index(UnitVector3d(x, y, z))
+
+    def time_index_xyz(self, scheme, level, n):
+        self.pixelization.index(self.x, self.y, self.z)
+
+    def time_index_lonlat(self, scheme, level, n):
+        self.pixelization.index(self.lon, self.lat)
+
+
+class Regions:
+    """Envelope and interior computation for regions of varying size."""
+
+    params = (list(PIXELIZATIONS), REGION_KINDS, REGION_SIZES)
+    param_names = ["scheme", "region", "size"]
+
+    def setup(self, scheme, region, size):
+        self.pixelization = PIXELIZATIONS[scheme](10)
+        self.region = make_region(region, size)
+
+    def time_envelope(self, scheme, region, size):
+        self.pixelization.envelope(self.region)
+
+    def time_interior(self, scheme, region, size):
+        self.pixelization.interior(self.region)
+
+    def track_envelope_ranges(self, scheme, region, size):
+        return len(self.pixelization.envelope(self.region))
+
+    track_envelope_ranges.unit = "ranges"
+
+
+class Pixel:
+    """Pixel region construction, as used by callers iterating over the
+    pixels of an envelope.
+    """
+
+    params = (list(PIXELIZATIONS), [5, 10, 20])
+    param_names = ["scheme", "level"]
+
+    def setup(self, scheme, level):
+        self.pixelization = PIXELIZATIONS[scheme](level)
+        x, y, z = random_points(1000)
+        self.indexes = self.pixelization.index(x, y, z).tolist()
+
+    def time_pixel(self, scheme, level):
+        pixel = self.pixelization.pixel
+        for i in self.indexes:
+            pixel(i)
@@ -0,0 +1,127 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+"""Benchmarks for RangeSet."""
+
+import pickle
+
+import numpy as np
+from lsst.sphgeom import RangeSet
+
+SIZES = [16, 1024, 65536]
+
+
+def make_range_set(n, seed):
+    """Return a RangeSet of n random disjoint ranges."""
+    rng = np.random.default_rng(seed)
+    bounds = np.cumsum(rng.integers(1, 1000, size=2 * n, dtype=np.uint64))
+    return RangeSet(bounds.reshape(n, 2))
+
+
+class SetOperations:
+    """Binary set operations and complement."""
+
+    params = [SIZES]
+    param_names = ["n"]
+
+    def setup(self, n):
+        self.a = make_range_set(n, 1)
+        self.b = make_range_set(n, 2)
+
+    def time_union(self, n):
+        self.a | self.b
+
+    def time_intersection(self, n):
+        self.a & self.b
+
+    def time_difference(self, n):
+        self.a - self.b
+
+    def time_complemented(self, n):
+        self.a.complemented()
+
+
+class Access:
+    """Getting ranges out of and values into a RangeSet."""
+
+    params = [SIZES]
+    param_names = ["n"]
+
+    def setup(self, n):
+        self.s = make_range_set(n, 1)
+        self.values = np.random.default_rng(3).integers(0, 1000 * n, size=n, dtype=np.uint64)
+
+    def time_getitem(self, n):
+        # Boxes every range into a tuple.
+        s = self.s
+        for i in range(len(s)):
+            s[i]
+
+    def time_iterate(self, n):
+        for _ in self.s:
+            pass
+
+    def time_ranges(self, n):
+        self.s.ranges()
+
+    def time_asarray(self, n):
+        np.asarray(self.s)
+
+    def time_insert_per_element(self, n):
+        s = RangeSet()
+        for v in self.values.tolist():
+            s.insert(v)
+
+    def time_insert_many(self, n):
+        RangeSet().insertMany(self.values)
+
+    def time_contains_array(self, n):
+        self.s.contains(self.values)
+
+
+class Serialization:
+    """Pickling and encode/decode round trips."""
+
+    params = [SIZES]
+    param_names = ["n"]
+
+    def setup(self, n):
+        self.s = make_range_set(n, 1)
+        self.pickled = pickle.dumps(self.s)
+        self.encoded = self.s.encode()
+
+    def time_pickle(self, n):
+        pickle.dumps(self.s)
+
+    def time_unpickle(self, n):
+        pickle.loads(self.pickled)
+
+    def time_encode(self, n):
+        self.s.encode()
+
+    def time_decode(self, n):
+        RangeSet.decode(self.encoded)
+
+    def track_pickled_bytes(self, n):
+        return len(self.pickled)
+
+    track_pickled_bytes.unit = "bytes"
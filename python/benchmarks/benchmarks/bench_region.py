@@ -0,0 +1,108 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+"""Benchmarks for regions and the Chunker."""
+
+import pickle
+
+import numpy as np
+from lsst.sphgeom import Chunker, Region, UnitVector3d
+
+from . import REGION_KINDS, REGION_SIZES, make_region, random_points
+
+
+class Contains:
+    """Per-element and vectorized point-in-region tests."""
+
+    params = (REGION_KINDS, [1000, 100000])
+    param_names = ["region", "n"]
+
+    def setup(self, region, n):
+        self.region = make_region(region, 3600)
+        self.x, self.y, self.z = random_points(n)
+
+    def time_contains_per_element(self, region, n):
+        contains = self.region.contains
+        for x, y, z in zip(self.x.tolist(), self.y.tolist(), self.z.tolist()):
+            contains(UnitVector3d(x, y, z))
+
+    def time_contains_array(self, region, n):
+        self.region.contains(self.x, self.y, self.z)
+
+
+class Serialization:
+    """Region pickling, which goes through python::encode and decode."""
+
+    params = [REGION_KINDS]
+    param_names = ["region"]
+
+    def setup(self, region):
+        self.region = make_region(region, 3600)
+        self.pickled = pickle.dumps(self.region)
+        self.encoded = self.region.encode()
+        self.regions = [make_region(region, size) for size in range(1, 1001)]
+        self.batch = Region.encodeBatch(self.regions)
+
+    def time_pickle(self, region):
+        pickle.dumps(self.region)
+
+    def time_unpickle(self, region):
+        pickle.loads(self.pickled)
+
+    def time_encode(self, region):
+        self.region.encode()
+
+    def time_decode(self, region):
+        Region.decode(self.encoded)
+
+    def time_encode_many(self, region):
+        for r in self.regions:
+            r.encode()
+
+    def time_encode_batch(self, region):
+        Region.encodeBatch(self.regions)
+
+    def time_decode_batch(self, region):
+        Region.decodeBatch(self.batch)
+
+
+class ChunkerQueries:
+    """Chunk and sub-chunk lookups with the Qserv partitioning parameters."""
+
+    params = [REGION_SIZES]
+    param_names = ["size"]
+
+    def setup(self, size):
+        self.chunker = Chunker(85, 12)
+        self.region = make_region("circle", size)
+        x, y, z = random_points(100000)
+        self.lon = np.arctan2(y, x) % (2.0 * np.pi)
+        self.lat = np.arcsin(z)
+
+    def time_get_chunks_intersecting(self, size):
+        self.chunker.getChunksIntersecting(self.region)
+
+    def time_get_sub_chunks_intersecting(self, size):
+        self.chunker.getSubChunksIntersecting(self.region)
+
+    def time_locate(self, size):
+        self.chunker.locate(self.lon, self.lat)
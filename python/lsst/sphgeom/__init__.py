@@ -23,7 +23,6 @@
 """lsst.sphgeom
 """
 
-from ._healpixPixelization import *
 from ._sphgeom import *
 from ._sphgeom import Pixelization
 from ._yaml import *
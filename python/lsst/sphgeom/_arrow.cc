@@ -0,0 +1,158 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+
+#include <memory>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/arrow.h"
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+namespace {
+
+// Arrays are exchanged with Python using the Arrow PyCapsule interface,
+// so that any Arrow implementation (e.g. pyarrow, polars or nanoarrow)
+// can provide and consume them.
+
+void releaseSchemaCapsule(PyObject *capsule) {
+    auto *schema = static_cast<ArrowSchema *>(PyCapsule_GetPointer(capsule, "arrow_schema"));
+    if (schema->release != nullptr) {
+        schema->release(schema);
+    }
+    delete schema;
+}
+
+void releaseArrayCapsule(PyObject *capsule) {
+    auto *array = static_cast<ArrowArray *>(PyCapsule_GetPointer(capsule, "arrow_array"));
+    if (array->release != nullptr) {
+        array->release(array);
+    }
+    delete array;
+}
+
+// `ImportedColumn` keeps the capsules obtained from an Arrow array alive
+// while a RegionColumn refers to the structures they own.
+struct ImportedColumn {
+    py::object schema;
+    py::object array;
+    std::unique_ptr<RegionColumn> column;
+};
+
+// The capsules are released with the GIL held, so an `ImportedColumn` must
+// outlive any scope in which the GIL is released.
+ImportedColumn importColumn(py::handle obj) {
+    if (!py::hasattr(obj, "__arrow_c_array__")) {
+        throw py::type_error("Region columns must be Arrow arrays implementing __arrow_c_array__");
+    }
+    py::tuple capsules = obj.attr("__arrow_c_array__")();
+    ImportedColumn result;
+    result.schema = capsules[0];
+    result.array = capsules[1];
+    auto *schema = static_cast<ArrowSchema *>(PyCapsule_GetPointer(result.schema.ptr(), "arrow_schema"));
+    auto *array = static_cast<ArrowArray *>(PyCapsule_GetPointer(result.array.ptr(), "arrow_array"));
+    if (schema == nullptr || array == nullptr) {
+        throw py::error_already_set();
+    }
+    result.column.reset(new RegionColumn(*schema, *array));
+    return result;
+}
+
+}  // <anonymous>
+
+void defineArrow(py::module &mod) {
+    py::class_<ArrowColumn, std::unique_ptr<ArrowColumn>> cls(mod, "ArrowColumn");
+    // The requested schema may be ignored by producers.
+    cls.def("__arrow_c_array__",
+            [](ArrowColumn &self, py::object) {
+                std::unique_ptr<ArrowSchema> schema(new ArrowSchema);
+                std::unique_ptr<ArrowArray> array(new ArrowArray);
+                self.exportTo(schema.get(), array.get());
+                py::capsule s(schema.get(), "arrow_schema", &releaseSchemaCapsule);
+                schema.release();
+                py::capsule a(array.get(), "arrow_array", &releaseArrayCapsule);
+                array.release();
+                return py::make_tuple(s, a);
+            },
+            "requested_schema"_a = py::none());
+    cls.def("empty", &ArrowColumn::empty);
+
+    mod.def("decodeColumn",
+            [](py::handle column) {
+                ImportedColumn c = importColumn(column);
+                py::list result;
+                for (size_t i = 0; i < c.column->size(); ++i) {
+                    std::unique_ptr<Region> r = c.column->decode(i);
+                    if (r) {
+                        result.append(py::cast(std::move(r)));
+                    } else {
+                        result.append(py::none());
+                    }
+                }
+                return result;
+            },
+            "column"_a);
+    mod.def("relateColumn",
+            [](py::handle column, Region const &region, unsigned numThreads) {
+                ImportedColumn c = importColumn(column);
+                ArrowColumn result;
+                {
+                    py::gil_scoped_release release;
+                    result = relateColumn(*c.column, region, numThreads);
+                }
+                return result;
+            },
+            "column"_a, "region"_a, "numThreads"_a = 1);
+    mod.def("containsColumn",
+            [](py::handle column, UnitVector3d const &v, unsigned numThreads) {
+                ImportedColumn c = importColumn(column);
+                ArrowColumn result;
+                {
+                    py::gil_scoped_release release;
+                    result = containsColumn(*c.column, v, numThreads);
+                }
+                return result;
+            },
+            "column"_a, "v"_a, "numThreads"_a = 1);
+    mod.def("envelopeColumn",
+            [](py::handle column, Pixelization const &pixelization, size_t maxRanges,
+               unsigned numThreads) {
+                ImportedColumn c = importColumn(column);
+                ArrowColumn result;
+                {
+                    py::gil_scoped_release release;
+                    result = envelopeColumn(*c.column, pixelization, maxRanges, numThreads);
+                }
+                return result;
+            },
+            "column"_a, "pixelization"_a, "maxRanges"_a = 0, "numThreads"_a = 1);
+}
+
+}  // sphgeom
+}  // lsst
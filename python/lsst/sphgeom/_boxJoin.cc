@@ -0,0 +1,111 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/boxJoin.h"
+#include "lsst/sphgeom/Region.h"
+
+#include "lsst/sphgeom/python/utils.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+using Regions = std::vector<std::unique_ptr<Region>>;
+
+/// Convert index pairs to an array of shape (N, 2).
+py::array_t<uint64_t> toArray(Pairs const &pairs) {
+    py::ssize_t rows = static_cast<py::ssize_t>(pairs.size());
+    py::array_t<uint64_t> result({rows, static_cast<py::ssize_t>(2)});
+    uint64_t *out = result.mutable_data();
+    for (auto const &p : pairs) {
+        *out++ = p.first;
+        *out++ = p.second;
+    }
+    return result;
+}
+
+}  // <anonymous>
+
+void defineBoxJoin(py::module &mod) {
+    mod.def("boxJoin",
+            [](std::vector<Box3d> const &boxes, unsigned numThreads) {
+                Pairs pairs;
+                {
+                    py::gil_scoped_release release;
+                    pairs = boxJoin(boxes, numThreads);
+                }
+                return toArray(pairs);
+            },
+            "boxes"_a, "numThreads"_a = 1);
+    mod.def("boxJoin",
+            [](std::vector<Box3d> const &a, std::vector<Box3d> const &b,
+               unsigned numThreads) {
+                Pairs pairs;
+                {
+                    py::gil_scoped_release release;
+                    pairs = boxJoin(a, b, numThreads);
+                }
+                return toArray(pairs);
+            },
+            "a"_a, "b"_a, "numThreads"_a = 1);
+    mod.def("regionJoin",
+            [](py::sequence regions, unsigned numThreads) {
+                Regions r = python::convert_region_sequence(regions);
+                Pairs pairs;
+                {
+                    py::gil_scoped_release release;
+                    pairs = regionJoin(r, numThreads);
+                }
+                return toArray(pairs);
+            },
+            "regions"_a, "numThreads"_a = 1);
+    mod.def("regionJoin",
+            [](py::sequence a, py::sequence b, unsigned numThreads) {
+                Regions ra = python::convert_region_sequence(a);
+                Regions rb = python::convert_region_sequence(b);
+                Pairs pairs;
+                {
+                    py::gil_scoped_release release;
+                    pairs = regionJoin(ra, rb, numThreads);
+                }
+                return toArray(pairs);
+            },
+            "a"_a, "b"_a, "numThreads"_a = 1);
+}
+
+}  // sphgeom
+}  // lsst
@@ -0,0 +1,68 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/stl.h"
+
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/ChunkPixelMap.h"
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/python/relationship.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+template <>
+void defineClass(py::class_<ChunkPixelMap, std::shared_ptr<ChunkPixelMap>> &cls) {
+    cls.def(py::init<Chunker const &, Pixelization const &, unsigned>(), "chunker"_a,
+            "pixelization"_a, "numThreads"_a = 1, py::call_guard<py::gil_scoped_release>());
+
+    cls.def("__len__", &ChunkPixelMap::size);
+    cls.def_property_readonly("chunker", &ChunkPixelMap::getChunker);
+    cls.def("getChunkIds", &ChunkPixelMap::getChunkIds);
+    cls.def("getEnvelope", &ChunkPixelMap::getEnvelope, "chunkId"_a);
+    cls.def("getInterior", &ChunkPixelMap::getInterior, "chunkId"_a);
+    cls.def("getChunks", &ChunkPixelMap::getChunks, "pixel"_a);
+    cls.def("getChunksIntersecting", &ChunkPixelMap::getChunksIntersecting, "envelope"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("classifyChunks",
+            [](ChunkPixelMap const &self, RangeSet const &envelope, RangeSet const &interior) {
+                std::vector<ClassifiedChunk> chunks;
+                {
+                    py::gil_scoped_release release;
+                    chunks = self.classifyChunks(envelope, interior);
+                }
+                py::list results;
+                for (auto const &c : chunks) {
+                    results.append(py::make_tuple(c.chunkId, c.relationship));
+                }
+                return results;
+            },
+            "envelope"_a, "interior"_a);
+}
+
+}  // sphgeom
+}  // lsst
@@ -20,11 +20,15 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
 #include "pybind11/stl.h"
 
+#include <algorithm>
+
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/Chunker.h"
+#include "lsst/sphgeom/python/relationship.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -33,6 +37,54 @@ namespace lsst {
 namespace sphgeom {
 
 namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Locate the chunks and sub-chunks containing the points with the given
+/// arrays of longitudes and latitudes (in radians), having the same shape.
+py::tuple locateArray(Chunker const &self, DoubleArray lon, DoubleArray lat) {
+    if (lon.request().shape != lat.request().shape) {
+        throw py::value_error("lon and lat must have the same shape");
+    }
+    py::array_t<int32_t> chunk(lon.request().shape);
+    py::array_t<int32_t> subChunk(lon.request().shape);
+    size_t n = static_cast<size_t>(lon.size());
+    double const *lonp = lon.data();
+    double const *latp = lat.data();
+    int32_t *chunkp = chunk.mutable_data();
+    int32_t *subChunkp = subChunk.mutable_data();
+    {
+        py::gil_scoped_release release;
+        self.locate(lonp, latp, chunkp, subChunkp, n);
+    }
+    return py::make_tuple(chunk, subChunk);
+}
+
+/// Locate the chunks and sub-chunks containing, or having overlap regions
+/// containing, the points with the given arrays of longitudes and latitudes
+/// (in radians), and return the result as a tuple of four 1-D arrays.
+py::tuple locateWithOverlapArray(Chunker const &self, DoubleArray lon,
+                                 DoubleArray lat, Angle overlap) {
+    if (lon.request().shape != lat.request().shape) {
+        throw py::value_error("lon and lat must have the same shape");
+    }
+    size_t n = static_cast<size_t>(lon.size());
+    double const *lonp = lon.data();
+    double const *latp = lat.data();
+    ChunkLocations out;
+    {
+        py::gil_scoped_release release;
+        self.locateWithOverlap(lonp, latp, n, overlap, out);
+    }
+    py::ssize_t rows = static_cast<py::ssize_t>(out.size());
+    py::array_t<uint64_t> pointIndex(rows);
+    std::copy(out.pointIndex.begin(), out.pointIndex.end(), pointIndex.mutable_data());
+    return py::make_tuple(pointIndex,
+                          py::array_t<int32_t>(rows, out.chunkId.data()),
+                          py::array_t<int32_t>(rows, out.subChunkId.data()),
+                          py::array_t<uint8_t>(rows, out.isOverlap.data()).attr("astype")("bool"));
+}
+
 py::str toString(Chunker const &self) {
     return py::str("Chunker({!s}, {!s})")
             .format(self.getNumStripes(), self.getNumSubStripesPerStripe());
@@ -41,8 +93,8 @@ py::str toString(Chunker const &self) {
 
 template <>
 void defineClass(py::class_<Chunker, std::shared_ptr<Chunker>> &cls) {
-    cls.def(py::init<int32_t, int32_t>(), "numStripes"_a,
-            "numSubStripesPerStripe"_a);
+    cls.def(py::init<int32_t, int32_t, size_t>(), "numStripes"_a,
+            "numSubStripesPerStripe"_a, "maxBoxTableBytes"_a = 0);
 
     cls.def("__eq__", &Chunker::operator==, py::is_operator());
     cls.def("__ne__", &Chunker::operator!=, py::is_operator());
@@ -52,21 +104,90 @@ void defineClass(py::class_<Chunker, std::shared_ptr<Chunker>> &cls) {
                               &Chunker::getNumSubStripesPerStripe);
 
     cls.def("getChunksIntersecting", &Chunker::getChunksIntersecting,
-            "region"_a);
+            "region"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("getSubChunksIntersecting",
-            [](Chunker const &self, Region const &region) {
+            [](Chunker const &self, Region const &region, unsigned numThreads) {
+                std::vector<SubChunks> subChunks;
+                {
+                    py::gil_scoped_release release;
+                    subChunks = self.getSubChunksIntersecting(region, numThreads);
+                }
                 py::list results;
-                for (auto const &sc : self.getSubChunksIntersecting(region)) {
+                for (auto const &sc : subChunks) {
                     results.append(py::make_tuple(sc.chunkId, sc.subChunkIds));
                 }
                 return results;
             },
+            "region"_a, "numThreads"_a = 1);
+    cls.def("classifyChunks",
+            [](Chunker const &self, Region const &region) {
+                std::vector<ClassifiedChunk> chunks;
+                {
+                    py::gil_scoped_release release;
+                    chunks = self.classifyChunks(region);
+                }
+                py::list results;
+                for (auto const &c : chunks) {
+                    results.append(py::make_tuple(c.chunkId, c.relationship));
+                }
+                return results;
+            },
             "region"_a);
-    cls.def("getAllChunks", &Chunker::getAllChunks);
-    cls.def("getAllSubChunks", &Chunker::getAllSubChunks, "chunkId"_a);
+    cls.def("classifySubChunks",
+            [](Chunker const &self, Region const &region, unsigned numThreads) {
+                std::vector<ClassifiedSubChunks> subChunks;
+                {
+                    py::gil_scoped_release release;
+                    subChunks = self.classifySubChunks(region, numThreads);
+                }
+                py::list results;
+                for (auto const &sc : subChunks) {
+                    results.append(py::make_tuple(sc.chunkId, sc.relationship,
+                                                  sc.subChunkIds,
+                                                  sc.subChunkRelationships));
+                }
+                return results;
+            },
+            "region"_a, "numThreads"_a = 1);
+    cls.def("getNeighborChunks", &Chunker::getNeighborChunks, "chunkId"_a,
+            "overlap"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("getNeighborSubChunks",
+            [](Chunker const &self, int32_t chunkId, int32_t subChunkId, Angle overlap) {
+                std::vector<SubChunks> subChunks;
+                {
+                    py::gil_scoped_release release;
+                    subChunks = self.getNeighborSubChunks(chunkId, subChunkId, overlap);
+                }
+                py::list results;
+                for (auto const &sc : subChunks) {
+                    results.append(py::make_tuple(sc.chunkId, sc.subChunkIds));
+                }
+                return results;
+            },
+            "chunkId"_a, "subChunkId"_a, "overlap"_a);
+    cls.def("locate", py::overload_cast<LonLat const &>(&Chunker::locate, py::const_),
+            "lonLat"_a);
+    cls.def("locate", &locateArray, "lon"_a, "lat"_a);
+    cls.def("locateWithOverlap", &locateWithOverlapArray, "lon"_a, "lat"_a,
+            "overlap"_a);
+    cls.def("getAllChunks", &Chunker::getAllChunks, py::call_guard<py::gil_scoped_release>());
+    cls.def("getAllSubChunks", &Chunker::getAllSubChunks, "chunkId"_a,
+            py::call_guard<py::gil_scoped_release>());
 
     cls.def("getChunkBoundingBox", &Chunker::getChunkBoundingBox, "stripe"_a, "chunk"_a);
     cls.def("getSubChunkBoundingBox", &Chunker::getSubChunkBoundingBox, "subStripe"_a, "subChunk"_a);
+    cls.def("getChunkBoundingBoxes",
+            [](Chunker const &self, int32_t stripe) {
+                Chunker::BoxRange boxes = self.getChunkBoundingBoxes(stripe);
+                return std::vector<Box>(boxes.begin(), boxes.end());
+            },
+            "stripe"_a);
+    cls.def("getSubChunkBoundingBoxes",
+            [](Chunker const &self, int32_t subStripe) {
+                Chunker::BoxRange boxes = self.getSubChunkBoundingBoxes(subStripe);
+                return std::vector<Box>(boxes.begin(), boxes.end());
+            },
+            "subStripe"_a);
 
     cls.def("getStripe", &Chunker::getStripe, "chunkId"_a);
     cls.def("getChunk", &Chunker::getChunk, "chunkId"_a, "stripe"_a);
@@ -43,6 +43,7 @@ namespace sphgeom {
 template <>
 void defineClass(py::class_<Circle, std::unique_ptr<Circle>, Region> &cls) {
     cls.attr("TYPE_CODE") = py::int_(Circle::TYPE_CODE);
+    cls.attr("COMPACT_TYPE_CODE") = py::int_(Circle::COMPACT_TYPE_CODE);
 
     cls.def_static("empty", &Circle::empty);
     cls.def_static("full", &Circle::full);
@@ -121,6 +122,8 @@ void defineClass(py::class_<Circle, std::unique_ptr<Circle>, Region> &cls) {
     cls.def("getArea", &Circle::getArea);
     cls.def("complement", &Circle::complement);
     cls.def("complemented", &Circle::complemented);
+    cls.def("toOuterPolygon", &Circle::toOuterPolygon, "n"_a = 16);
+    cls.def("toInnerPolygon", &Circle::toInnerPolygon, "n"_a = 16);
 
     // Note that the Region interface has already been wrapped.
 
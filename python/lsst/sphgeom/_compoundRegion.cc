@@ -34,20 +34,34 @@ namespace sphgeom {
 
 namespace {
 
-py::str _repr(const char *format, CompoundRegion const &self) {
-    py::object first = py::cast(self.getOperand(0), py::return_value_policy::reference);
-    py::object second = py::cast(self.getOperand(1), py::return_value_policy::reference);
-    return py::str(format).format(first, second);
+py::str _repr(const char *name, CompoundRegion const &self) {
+    py::list operands;
+    for (std::size_t i = 0; i < self.nOperands(); ++i) {
+        operands.append(py::repr(py::cast(self.getOperand(i), py::return_value_policy::reference)));
+    }
+    return py::str("{}({})").format(name, py::str(", ").attr("join")(operands));
+}
+
+// Clone the regions in the given positional arguments.
+std::vector<std::unique_ptr<Region>> _cloneOperands(py::args args) {
+    std::vector<std::unique_ptr<Region>> operands;
+    operands.reserve(args.size());
+    for (py::handle arg : args) {
+        operands.push_back(arg.cast<Region const &>().clone());
+    }
+    return operands;
 }
 
 }  // namespace
 
 template <>
 void defineClass(py::class_<CompoundRegion, std::unique_ptr<CompoundRegion>, Region> &cls) {
+    cls.def("nOperands", &CompoundRegion::nOperands);
     cls.def(
         "cloneOperand",
         [](CompoundRegion const &self, std::ptrdiff_t n) {
-            return self.getOperand(python::convertIndex(2, n)).clone();
+            return self.getOperand(python::convertIndex(
+                static_cast<std::ptrdiff_t>(self.nOperands()), n)).clone();
         }
     );
 }
@@ -55,17 +69,23 @@ void defineClass(py::class_<CompoundRegion, std::unique_ptr<CompoundRegion>, Reg
 template <>
 void defineClass(py::class_<UnionRegion, std::unique_ptr<UnionRegion>, CompoundRegion> &cls) {
     cls.attr("TYPE_CODE") = py::int_(UnionRegion::TYPE_CODE);
-    cls.def(py::init<Region const &, Region const &>());
+    cls.attr("LEGACY_TYPE_CODE") = py::int_(UnionRegion::LEGACY_TYPE_CODE);
+    cls.def(py::init([](py::args args) {
+        return std::make_unique<UnionRegion>(_cloneOperands(args));
+    }));
     cls.def(py::pickle(&python::encode, &python::decode<UnionRegion>));
-    cls.def("__repr__", [](CompoundRegion const &self) { return _repr("UnionRegion({!r}, {!r})", self); });
+    cls.def("__repr__", [](CompoundRegion const &self) { return _repr("UnionRegion", self); });
 }
 
 template <>
 void defineClass(py::class_<IntersectionRegion, std::unique_ptr<IntersectionRegion>, CompoundRegion> &cls) {
     cls.attr("TYPE_CODE") = py::int_(IntersectionRegion::TYPE_CODE);
-    cls.def(py::init<Region const &, Region const &>());
+    cls.attr("LEGACY_TYPE_CODE") = py::int_(IntersectionRegion::LEGACY_TYPE_CODE);
+    cls.def(py::init([](py::args args) {
+        return std::make_unique<IntersectionRegion>(_cloneOperands(args));
+    }));
     cls.def(py::pickle(&python::encode, &python::decode<IntersectionRegion>));
-    cls.def("__repr__", [](CompoundRegion const &self) { return _repr("IntersectionRegion({!r}, {!r})", self); });
+    cls.def("__repr__", [](CompoundRegion const &self) { return _repr("IntersectionRegion", self); });
 }
 
 }  // namespace sphgeom
@@ -45,18 +45,29 @@ template <>
 void defineClass(py::class_<ConvexPolygon, std::unique_ptr<ConvexPolygon>,
                             Region> &cls) {
     cls.attr("TYPE_CODE") = py::int_(ConvexPolygon::TYPE_CODE);
+    cls.attr("COMPACT_TYPE_CODE") = py::int_(ConvexPolygon::COMPACT_TYPE_CODE);
 
-    cls.def_static("convexHull", &ConvexPolygon::convexHull, "points"_a);
+    cls.def_static("convexHull", &ConvexPolygon::convexHull, "points"_a,
+                   "numThreads"_a = 1, py::call_guard<py::gil_scoped_release>());
 
-    cls.def(py::init<std::vector<UnitVector3d> const &>(), "points"_a);
+    cls.def(py::init<std::vector<UnitVector3d> const &>(), "points"_a,
+            py::call_guard<py::gil_scoped_release>());
     // Do not wrap the two unsafe (3 and 4 vertex) constructors
     cls.def(py::init<ConvexPolygon const &>(), "convexPolygon"_a);
 
     cls.def("__eq__", &ConvexPolygon::operator==, py::is_operator());
     cls.def("__ne__", &ConvexPolygon::operator!=, py::is_operator());
 
-    cls.def("getVertices", &ConvexPolygon::getVertices);
+    cls.def("getVertices", [](ConvexPolygon const &self) {
+        return std::vector<UnitVector3d>(self.getVertices());
+    });
     cls.def("getCentroid", &ConvexPolygon::getCentroid);
+    cls.def("getArea", &ConvexPolygon::getArea);
+    cls.def("simplifiedInner", &ConvexPolygon::simplifiedInner,
+            "maxVertices"_a);
+    cls.def("simplifiedOuter", &ConvexPolygon::simplifiedOuter,
+            "maxVertices"_a);
+    cls.def("dilatedBy", &ConvexPolygon::dilatedBy, "radius"_a);
 
     // Note that much of the Region interface has already been wrapped. Here are bits that have not:
     // (include overloads from Region that would otherwise be shadowed).
@@ -73,7 +84,8 @@ void defineClass(py::class_<ConvexPolygon, std::unique_ptr<ConvexPolygon>,
     cls.def("isWithin", &ConvexPolygon::isWithin);
 
     cls.def("__repr__", [](ConvexPolygon const &self) {
-        return py::str("ConvexPolygon({!r})").format(self.getVertices());
+        return py::str("ConvexPolygon({!r})").format(
+                std::vector<UnitVector3d>(self.getVertices()));
     });
     cls.def(py::pickle(&python::encode, &python::decode<ConvexPolygon>));
 }
@@ -0,0 +1,120 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Angle.h"
+#include "lsst/sphgeom/crossMatch.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+
+/// Convert arrays of longitudes and latitudes (in radians), having the same
+/// shape, to unit vectors.
+UnitVector3dArray toUnitVectors(DoubleArray lon, DoubleArray lat) {
+    if (lon.request().shape != lat.request().shape) {
+        throw py::value_error("lon and lat must have the same shape");
+    }
+    size_t n = static_cast<size_t>(lon.size());
+    double const *lonp = lon.data();
+    double const *latp = lat.data();
+    UnitVector3dArray points;
+    points.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        points.push_back(UnitVector3d(LonLat::fromRadians(lonp[i], latp[i])));
+    }
+    return points;
+}
+
+/// Convert arrays of (not necessarily normalized) unit vector components,
+/// all having the same shape, to unit vectors.
+UnitVector3dArray toUnitVectors(DoubleArray x, DoubleArray y, DoubleArray z) {
+    if (x.request().shape != y.request().shape || x.request().shape != z.request().shape) {
+        throw py::value_error("x, y and z must have the same shape");
+    }
+    return UnitVector3dArray::fromComponents(x.data(), y.data(), z.data(),
+                                             static_cast<size_t>(x.size()));
+}
+
+/// Cross-match two sets of unit vectors, and return the matching index
+/// pairs as an array of shape (N, 2).
+py::array_t<uint64_t> crossMatchArray(UnitVector3dArray const &a,
+                                      UnitVector3dArray const &b,
+                                      Angle radius, unsigned numThreads) {
+    Pairs pairs;
+    {
+        py::gil_scoped_release release;
+        pairs = crossMatch(a, b, radius, numThreads);
+    }
+    py::ssize_t rows = static_cast<py::ssize_t>(pairs.size());
+    py::array_t<uint64_t> result({rows, static_cast<py::ssize_t>(2)});
+    uint64_t *out = result.mutable_data();
+    for (auto const &p : pairs) {
+        *out++ = p.first;
+        *out++ = p.second;
+    }
+    return result;
+}
+
+}  // <anonymous>
+
+void defineCrossMatch(py::module &mod) {
+    mod.def("crossMatch",
+            [](DoubleArray lon1, DoubleArray lat1, DoubleArray lon2,
+               DoubleArray lat2, Angle radius, unsigned numThreads) {
+                return crossMatchArray(toUnitVectors(lon1, lat1),
+                                       toUnitVectors(lon2, lat2), radius,
+                                       numThreads);
+            },
+            "lon1"_a, "lat1"_a, "lon2"_a, "lat2"_a, "radius"_a,
+            "numThreads"_a = 1);
+    mod.def("crossMatch",
+            [](DoubleArray x1, DoubleArray y1, DoubleArray z1, DoubleArray x2,
+               DoubleArray y2, DoubleArray z2, Angle radius,
+               unsigned numThreads) {
+                return crossMatchArray(toUnitVectors(x1, y1, z1),
+                                       toUnitVectors(x2, y2, z2), radius,
+                                       numThreads);
+            },
+            "x1"_a, "y1"_a, "z1"_a, "x2"_a, "y2"_a, "z2"_a, "radius"_a,
+            "numThreads"_a = 1);
+    mod.def("crossMatchLevel", &crossMatchLevel, "radius"_a, "n"_a);
+}
+
+}  // sphgeom
+}  // lsst
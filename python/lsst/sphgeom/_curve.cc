@@ -36,8 +36,10 @@ void defineCurve(py::module &mod) {
     mod.def("mortonIndexInverse",
             (std::tuple<uint32_t, uint32_t>(*)(uint64_t)) & mortonIndexInverse,
             "z"_a);
-    mod.def("mortonToHilbert", &mortonToHilbert, "z"_a, "m"_a);
-    mod.def("hilbertToMorton", &hilbertToMorton, "h"_a, "m"_a);
+    mod.def("mortonToHilbert", (uint64_t(*)(uint64_t, int)) & mortonToHilbert,
+            "z"_a, "m"_a);
+    mod.def("hilbertToMorton", (uint64_t(*)(uint64_t, int)) & hilbertToMorton,
+            "h"_a, "m"_a);
     mod.def("hilbertIndex",
             (uint64_t(*)(uint32_t, uint32_t, int)) & hilbertIndex, "x"_a, "y"_a,
             "m"_a);
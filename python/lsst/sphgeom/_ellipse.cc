@@ -46,6 +46,8 @@ void defineClass(py::class_<Ellipse, std::unique_ptr<Ellipse>, Region> &cls) {
 
     cls.def_static("empty", &Ellipse::empty);
     cls.def_static("full", &Ellipse::full);
+    cls.def_static("fromQuadraticForm", &Ellipse::fromQuadraticForm, "S"_a,
+                   "alpha"_a, "beta"_a, "gamma"_a, "cotAlpha"_a, "cotBeta"_a);
 
     cls.def(py::init<>());
     cls.def(py::init<Circle const &>(), "circle"_a);
@@ -71,8 +73,13 @@ void defineClass(py::class_<Ellipse, std::unique_ptr<Ellipse>, Region> &cls) {
     cls.def("getAlpha", &Ellipse::getAlpha);
     cls.def("getBeta", &Ellipse::getBeta);
     cls.def("getGamma", &Ellipse::getGamma);
+    cls.def("getArea", &Ellipse::getArea);
     cls.def("complement", &Ellipse::complement);
     cls.def("complemented", &Ellipse::complemented);
+    cls.def("toOuterPolygon", &Ellipse::toOuterPolygon,
+            "n"_a = 16);
+    cls.def("toInnerPolygon", &Ellipse::toInnerPolygon,
+            "n"_a = 16);
 
     // Note that the Region interface has already been wrapped.
 
@@ -0,0 +1,56 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+
+#include <memory>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/EnvelopeCache.h"
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/Region.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+template <>
+void defineClass(py::class_<EnvelopeCache, std::unique_ptr<EnvelopeCache>> &cls) {
+    cls.def(py::init<size_t>(), "maxBytes"_a);
+    cls.def("envelope", &EnvelopeCache::envelope, "pixelization"_a, "region"_a, "maxRanges"_a = 0,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("interior", &EnvelopeCache::interior, "pixelization"_a, "region"_a, "maxRanges"_a = 0,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("clear", &EnvelopeCache::clear);
+    cls.def("getMaxBytes", &EnvelopeCache::getMaxBytes);
+    cls.def("getBytes", &EnvelopeCache::getBytes);
+    cls.def("getHits", &EnvelopeCache::getHits);
+    cls.def("getMisses", &EnvelopeCache::getMisses);
+    cls.def("getEvictions", &EnvelopeCache::getEvictions);
+    cls.def("__len__", &EnvelopeCache::size);
+}
+
+}  // sphgeom
+}  // lsst
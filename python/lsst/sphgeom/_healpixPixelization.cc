@@ -0,0 +1,78 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/python/utils.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+template <>
+void defineClass(py::class_<HealpixPixelization, Pixelization> &cls) {
+    cls.attr("MAX_LEVEL") = py::int_(HealpixPixelization::MAX_LEVEL);
+    cls.attr("NUM_VERTICES") = py::int_(HealpixPixelization::NUM_VERTICES);
+
+    cls.def(py::init<int, size_t>(), "level"_a, "cacheSize"_a = 0);
+    cls.def(py::init<HealpixPixelization const &>(), "healpixPixelization"_a);
+
+    cls.def("getLevel", &HealpixPixelization::getLevel);
+    cls.def_property_readonly("level", &HealpixPixelization::getLevel);
+    cls.def("multiLevelEnvelope", &HealpixPixelization::multiLevelEnvelope,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("multiLevelInterior", &HealpixPixelization::multiLevelInterior,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("envelopeAtLevels", &HealpixPixelization::envelopeAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("interiorAtLevels", &HealpixPixelization::interiorAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("getNside", &HealpixPixelization::getNside);
+    cls.def_property_readonly("nside", &HealpixPixelization::getNside);
+    cls.def("vertices", &python::pixelVertices<HealpixPixelization>, "indexes"_a);
+    cls.def("quad", &HealpixPixelization::quad);
+
+    cls.def("__eq__",
+            [](HealpixPixelization const &self, HealpixPixelization const &other) {
+                return self.getLevel() == other.getLevel();
+            });
+    cls.def("__ne__",
+            [](HealpixPixelization const &self, HealpixPixelization const &other) {
+                return self.getLevel() != other.getLevel();
+            });
+    cls.def("__repr__", [](HealpixPixelization const &self) {
+        return py::str("HealpixPixelization({!s})").format(self.getLevel());
+    });
+    cls.def("__reduce__", [cls](HealpixPixelization const &self) {
+        return py::make_tuple(cls, py::make_tuple(self.getLevel()));
+    });
+}
+
+}  // sphgeom
+}  // lsst
@@ -20,10 +20,16 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
+
+#include <algorithm>
+#include <vector>
 
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/python/utils.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -31,18 +37,58 @@ using namespace pybind11::literals;
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using IndexArray = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+py::tuple neighborhoods(IndexArray indexes) {
+    if (indexes.ndim() != 1) {
+        throw std::invalid_argument("indexes must be a 1-D array");
+    }
+    std::vector<size_t> offsets;
+    std::vector<uint64_t> neighbors;
+    {
+        py::gil_scoped_release release;
+        HtmPixelization::neighborhood(indexes.data(), static_cast<size_t>(indexes.size()), offsets,
+                                      neighbors);
+    }
+    py::array_t<uint64_t> o(static_cast<py::ssize_t>(offsets.size()));
+    py::array_t<uint64_t> n(static_cast<py::ssize_t>(neighbors.size()));
+    std::copy(offsets.begin(), offsets.end(), o.mutable_data());
+    std::copy(neighbors.begin(), neighbors.end(), n.mutable_data());
+    return py::make_tuple(o, n);
+}
+
+}  // <anonymous>
+
 template <>
 void defineClass(py::class_<HtmPixelization, Pixelization> &cls) {
     cls.attr("MAX_LEVEL") = py::int_(HtmPixelization::MAX_LEVEL);
+    cls.attr("NUM_VERTICES") = py::int_(HtmPixelization::NUM_VERTICES);
 
     cls.def_static("level", &HtmPixelization::level, "i"_a);
     cls.def_static("triangle", &HtmPixelization::triangle, "i"_a);
     cls.def_static("asString", &HtmPixelization::asString, "i"_a);
+    cls.def_static("neighborhood", py::overload_cast<uint64_t>(&HtmPixelization::neighborhood), "i"_a);
+    cls.def_static("neighborhood", py::overload_cast<uint64_t, int>(&HtmPixelization::neighborhood),
+                   "i"_a, "k"_a);
+    cls.def_static("neighborhoods", &neighborhoods, "indexes"_a);
 
-    cls.def(py::init<int>(), "level"_a);
+    cls.def(py::init<int, size_t>(), "level"_a, "cacheSize"_a = 0);
     cls.def(py::init<HtmPixelization const &>(), "htmPixelization"_a);
 
     cls.def("getLevel", &HtmPixelization::getLevel);
+    cls.def("multiLevelEnvelope", &HtmPixelization::multiLevelEnvelope,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("multiLevelInterior", &HtmPixelization::multiLevelInterior,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("envelopeAtLevels", &HtmPixelization::envelopeAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("interiorAtLevels", &HtmPixelization::interiorAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("vertices", &python::pixelVertices<HtmPixelization>, "indexes"_a);
 
     cls.def("__eq__",
             [](HtmPixelization const &self, HtmPixelization const &other) {
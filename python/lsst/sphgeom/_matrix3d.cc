@@ -20,10 +20,15 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <algorithm>
+#include <vector>
 
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/Matrix3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
 #include "lsst/sphgeom/python/utils.h"
 
 namespace py = pybind11;
@@ -33,11 +38,44 @@ namespace lsst {
 namespace sphgeom {
 
 namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
 Vector3d getRow(Matrix3d const &self, py::int_ row) {
     return self.getRow(static_cast<int>(python::convertIndex(3, row)));
 }
+
+/// Multiply arrays of vector components, all having the same shape, by a
+/// matrix, and optionally normalize the products.
+py::tuple applyArray(Matrix3d const &self, DoubleArray x, DoubleArray y,
+                     DoubleArray z, bool normalize) {
+    if (x.request().shape != y.request().shape || x.request().shape != z.request().shape) {
+        throw py::value_error("x, y and z must have the same shape");
+    }
+    std::vector<py::ssize_t> shape = x.request().shape;
+    DoubleArray ox(shape), oy(shape), oz(shape);
+    size_t n = static_cast<size_t>(x.size());
+    double const *xp = x.data();
+    double const *yp = y.data();
+    double const *zp = z.data();
+    double *oxp = ox.mutable_data();
+    double *oyp = oy.mutable_data();
+    double *ozp = oz.mutable_data();
+    {
+        py::gil_scoped_release release;
+        self.apply(xp, yp, zp, oxp, oyp, ozp, n);
+        if (normalize) {
+            UnitVector3dArray u = UnitVector3dArray::fromComponents(oxp, oyp, ozp, n);
+            std::copy(u.x(), u.x() + n, oxp);
+            std::copy(u.y(), u.y() + n, oyp);
+            std::copy(u.z(), u.z() + n, ozp);
+        }
+    }
+    return py::make_tuple(ox, oy, oz);
 }
 
+}  // namespace
+
 template <>
 void defineClass(py::class_<Matrix3d, std::shared_ptr<Matrix3d>> &cls) {
     cls.def(py::init<>());
@@ -90,6 +128,7 @@ void defineClass(py::class_<Matrix3d, std::shared_ptr<Matrix3d>> &cls) {
             (Matrix3d(Matrix3d::*)(Matrix3d const &) const) &
                     Matrix3d::operator*,
             "matrix"_a, py::is_operator());
+    cls.def("apply", &applyArray, "x"_a, "y"_a, "z"_a, "normalize"_a = false);
     cls.def("__add__", &Matrix3d::operator+, py::is_operator());
     cls.def("__sub__", &Matrix3d::operator-, py::is_operator());
 
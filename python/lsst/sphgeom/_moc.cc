@@ -0,0 +1,82 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+
+#include <sstream>
+#include <string>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/moc.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+void defineMoc(py::module &mod) {
+    mod.attr("MOC_MAX_ORDER") = MOC_MAX_ORDER;
+    mod.def("mocFromAscii",
+            [](std::string const &s) {
+                std::istringstream is(s);
+                return readMocAscii(is);
+            },
+            "s"_a);
+    mod.def("mocToAscii",
+            [](RangeSet const &s, int order) {
+                std::ostringstream os;
+                writeMocAscii(os, s, order);
+                return os.str();
+            },
+            "s"_a, "order"_a = MOC_MAX_ORDER);
+    mod.def("mocFromFits",
+            [](py::bytes const &b) {
+                std::istringstream is(static_cast<std::string>(b));
+                return readMocFits(is);
+            },
+            "b"_a);
+    mod.def("mocToFits",
+            [](RangeSet const &s, int order) {
+                std::ostringstream os;
+                writeMocFits(os, s, order);
+                return py::bytes(os.str());
+            },
+            "s"_a, "order"_a = MOC_MAX_ORDER);
+    mod.def("readMoc",
+            [](std::string const &path) {
+                py::gil_scoped_release release;
+                return readMoc(path);
+            },
+            "path"_a);
+    mod.def("writeMoc",
+            [](std::string const &path, RangeSet const &s, int order,
+               bool fits) {
+                py::gil_scoped_release release;
+                writeMoc(path, s, order, fits);
+            },
+            "path"_a, "s"_a, "order"_a = MOC_MAX_ORDER, "fits"_a = true);
+}
+
+}  // sphgeom
+}  // lsst
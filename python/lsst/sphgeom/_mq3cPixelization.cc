@@ -20,10 +20,13 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
 
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/python/utils.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -31,19 +34,58 @@ using namespace pybind11::literals;
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using IndexArray = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+py::tuple neighborhoods(IndexArray indexes) {
+    if (indexes.ndim() != 1) {
+        throw std::invalid_argument("indexes must be a 1-D array");
+    }
+    py::ssize_t n = indexes.size();
+    py::array_t<uint64_t> out({n, static_cast<py::ssize_t>(9)});
+    py::array_t<uint8_t> counts(n);
+    {
+        py::gil_scoped_release release;
+        Mq3cPixelization::neighborhoods(indexes.data(), static_cast<size_t>(n),
+                 out.mutable_data(), counts.mutable_data());
+    }
+    return py::make_tuple(out, counts);
+}
+
+}  // <anonymous>
+
 template <>
 void defineClass(py::class_<Mq3cPixelization, Pixelization> &cls) {
     cls.attr("MAX_LEVEL") = py::int_(Mq3cPixelization::MAX_LEVEL);
+    cls.attr("NUM_VERTICES") = py::int_(Mq3cPixelization::NUM_VERTICES);
 
     cls.def_static("level", &Mq3cPixelization::level);
     cls.def_static("quad", &Mq3cPixelization::quad);
-    cls.def_static("neighborhood", &Mq3cPixelization::neighborhood);
+    cls.def_static(
+            "neighborhood",
+            py::overload_cast<uint64_t>(&Mq3cPixelization::neighborhood),
+            "i"_a);
+    cls.def_static("neighborhoods", &neighborhoods, "indexes"_a);
+    cls.def("dilate", &Mq3cPixelization::dilate, "pixels"_a, "k"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
     cls.def_static("asString", &Mq3cPixelization::asString);
 
-    cls.def(py::init<int>(), "level"_a);
+    cls.def(py::init<int, size_t>(), "level"_a, "cacheSize"_a = 0);
     cls.def(py::init<Mq3cPixelization const &>(), "mq3cPixelization"_a);
 
     cls.def("getLevel", &Mq3cPixelization::getLevel);
+    cls.def("multiLevelEnvelope", &Mq3cPixelization::multiLevelEnvelope,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("multiLevelInterior", &Mq3cPixelization::multiLevelInterior,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("envelopeAtLevels", &Mq3cPixelization::envelopeAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("interiorAtLevels", &Mq3cPixelization::interiorAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("vertices", &python::pixelVertices<Mq3cPixelization>, "indexes"_a);
 
     cls.def("__eq__",
             [](Mq3cPixelization const &self, Mq3cPixelization const &other) {
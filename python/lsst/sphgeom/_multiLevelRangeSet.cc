@@ -0,0 +1,96 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/MultiLevelRangeSet.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using UInt64Array = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+/// Return the NUNIQ encoding of a set as a 1-D array.
+py::array_t<uint64_t> uniq(MultiLevelRangeSet const &self) {
+    std::vector<uint64_t> u = self.uniq();
+    py::array_t<uint64_t> result(static_cast<py::ssize_t>(u.size()));
+    std::copy(u.begin(), u.end(), result.mutable_data());
+    return result;
+}
+
+MultiLevelRangeSet fromUniq(UInt64Array uniq, int maxLevel) {
+    uint64_t const *p = uniq.data();
+    std::vector<uint64_t> u(p, p + uniq.size());
+    py::gil_scoped_release release;
+    return MultiLevelRangeSet::fromUniq(u, maxLevel);
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<MultiLevelRangeSet, std::shared_ptr<MultiLevelRangeSet>> &cls) {
+    cls.def(py::init<>());
+    cls.def(py::init<RangeSet const &, int>(), "rangeSet"_a, "level"_a);
+    cls.def(py::init<MultiLevelRangeSet const &>(), "multiLevelRangeSet"_a);
+
+    cls.def("__eq__", &MultiLevelRangeSet::operator==, py::is_operator());
+    cls.def("__ne__", &MultiLevelRangeSet::operator!=, py::is_operator());
+    cls.def("__len__", &MultiLevelRangeSet::size);
+
+    cls.def("getMaxLevel", &MultiLevelRangeSet::getMaxLevel);
+    cls.def_property_readonly("maxLevel", &MultiLevelRangeSet::getMaxLevel);
+    cls.def("getRanges", &MultiLevelRangeSet::getRanges, "level"_a);
+    cls.def("empty", &MultiLevelRangeSet::empty);
+    cls.def("size", &MultiLevelRangeSet::size);
+    cls.def("getNumPixels", &MultiLevelRangeSet::getNumPixels);
+    cls.def("flatten", &MultiLevelRangeSet::flatten);
+    cls.def("uniq", &uniq);
+    cls.def_static("fromUniq", &fromUniq, "uniq"_a, "maxLevel"_a = -1);
+
+    cls.def("__str__", [](MultiLevelRangeSet const &self) {
+        std::ostringstream os;
+        os << self;
+        return os.str();
+    });
+    cls.def("__repr__", [](MultiLevelRangeSet const &self) {
+        return py::str("MultiLevelRangeSet({!r}, {!s})")
+                .format(self.flatten(), self.getMaxLevel());
+    });
+    cls.def("__reduce__", [cls](MultiLevelRangeSet const &self) {
+        return py::make_tuple(cls, py::make_tuple(self.flatten(), self.getMaxLevel()));
+    });
+}
+
+}  // sphgeom
+}  // lsst
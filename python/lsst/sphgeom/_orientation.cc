@@ -35,6 +35,17 @@ void defineOrientation(py::module &mod) {
     mod.def("orientationX", &orientationX, "b"_a, "c"_a);
     mod.def("orientationY", &orientationY, "b"_a, "c"_a);
     mod.def("orientationZ", &orientationZ, "b"_a, "c"_a);
+
+    py::class_<OrientationStatistics> stats(mod, "OrientationStatistics");
+    stats.def_readonly("fast", &OrientationStatistics::fast);
+    stats.def_readonly("permanent", &OrientationStatistics::permanent);
+    stats.def_readonly("degenerate", &OrientationStatistics::degenerate);
+    stats.def_readonly("expansion", &OrientationStatistics::expansion);
+    stats.def_readonly("exact", &OrientationStatistics::exact);
+    mod.def("enableOrientationStatistics", &enableOrientationStatistics,
+            "enable"_a);
+    mod.def("getOrientationStatistics", &getOrientationStatistics);
+    mod.def("resetOrientationStatistics", &resetOrientationStatistics);
 }
 
 }  // sphgeom
@@ -0,0 +1,97 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+
+#include "lsst/sphgeom/PerformanceCounters.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+py::dict toDict(PerformanceSnapshot const &s) {
+    py::dict d;
+    for (size_t i = 0; i < NUM_PERFORMANCE_COUNTERS; ++i) {
+        d[PerformanceSnapshot::getName(static_cast<PerformanceCounter>(i))] =
+                s.values[i];
+    }
+    return d;
+}
+
+void setCallback(py::object callback, double period) {
+    std::function<void(PerformanceSnapshot const &)> f;
+    if (!callback.is_none()) {
+        if (!(period > 0.0)) {
+            throw std::invalid_argument(
+                    "Performance callback period must be positive");
+        }
+        // The callback may be destroyed by the reporting thread, which
+        // must hold the GIL to release its reference.
+        std::shared_ptr<py::object> holder(
+                new py::object(std::move(callback)), [](py::object *o) {
+                    py::gil_scoped_acquire gil;
+                    delete o;
+                });
+        f = [holder](PerformanceSnapshot const &s) {
+            py::gil_scoped_acquire gil;
+            try {
+                (*holder)(toDict(s));
+            } catch (py::error_already_set &e) {
+                e.discard_as_unraisable("performance callback");
+            }
+        };
+    }
+    auto ms = std::chrono::milliseconds(
+            static_cast<int64_t>(std::ceil(std::max(period, 0.0) * 1000.0)));
+    // Release the GIL so that a callback in progress can finish.
+    py::gil_scoped_release release;
+    setPerformanceCallback(std::move(f), ms);
+}
+
+}  // <anonymous>
+
+void definePerformanceCounters(py::module &mod) {
+    mod.attr("PERFORMANCE_COUNTERS_ENABLED") =
+            py::bool_(PerformanceSnapshot::ENABLED);
+    mod.def("getPerformanceCounters",
+            []() { return toDict(getPerformanceCounters()); });
+    mod.def("resetPerformanceCounters", &resetPerformanceCounters);
+    mod.def("setPerformanceCallback", &setCallback, "callback"_a,
+            "period"_a = 10.0);
+    // The reporting thread must not call into Python during interpreter
+    // finalization.
+    py::module::import("atexit").attr("register")(py::cpp_function(
+            []() { setCallback(py::none(), 0.0); }));
+}
+
+}  // sphgeom
+}  // lsst
@@ -0,0 +1,111 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/numpy.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/PixelCountMap.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using UInt64Array = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Accumulate an array of pixel indexes, with optional weights of the same
+/// shape. Each index adds 1 if there are no weights.
+void addIndexes(PixelCountMap &self, UInt64Array indexes, py::object weights,
+                unsigned numThreads) {
+    size_t const n = static_cast<size_t>(indexes.size());
+    uint64_t const *in = indexes.data();
+    DoubleArray w;
+    double const *wp = nullptr;
+    if (!weights.is_none()) {
+        w = weights.cast<DoubleArray>();
+        if (w.request().shape != indexes.request().shape) {
+            throw py::value_error("indexes and weights must have the same shape");
+        }
+        wp = w.data();
+    }
+    py::gil_scoped_release release;
+    self.add(in, wp, n, numThreads);
+}
+
+/// Return the runs of a map as a tuple of NumPy arrays (begin, end, value).
+py::tuple getRunArrays(PixelCountMap const &self) {
+    PixelCountRuns runs = self.getRuns();
+    py::ssize_t n = static_cast<py::ssize_t>(runs.size());
+    py::array_t<uint64_t> begin(n);
+    py::array_t<uint64_t> end(n);
+    py::array_t<double> value(n);
+    std::copy(runs.begin.begin(), runs.begin.end(), begin.mutable_data());
+    std::copy(runs.end.begin(), runs.end.end(), end.mutable_data());
+    std::copy(runs.value.begin(), runs.value.end(), value.mutable_data());
+    return py::make_tuple(begin, end, value);
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<PixelCountMap, std::shared_ptr<PixelCountMap>> &cls) {
+    cls.def(py::init<int>(), "level"_a);
+    cls.def(py::init<PixelCountMap const &>(), "pixelCountMap"_a);
+
+    cls.def("__eq__", &PixelCountMap::operator==, py::is_operator());
+    cls.def("__ne__", &PixelCountMap::operator!=, py::is_operator());
+    cls.def("__len__", &PixelCountMap::size);
+
+    cls.def("getLevel", &PixelCountMap::getLevel);
+    cls.def_property_readonly("level", &PixelCountMap::getLevel);
+    cls.def("empty", &PixelCountMap::empty);
+    cls.def("size", &PixelCountMap::size);
+    cls.def("getNumPixels", &PixelCountMap::getNumPixels);
+    cls.def("get", &PixelCountMap::get, "i"_a);
+    cls.def("total", &PixelCountMap::total);
+    cls.def("add", py::overload_cast<uint64_t, double>(&PixelCountMap::add),
+            "i"_a, "weight"_a = 1.0);
+    cls.def("add", py::overload_cast<PixelCountMap const &>(&PixelCountMap::add),
+            "pixelCountMap"_a);
+    cls.def("addIndexes", &addIndexes, "indexes"_a, "weights"_a = py::none(),
+            "numThreads"_a = 1);
+    cls.def("addRanges", py::overload_cast<RangeSet const &, double>(&PixelCountMap::add),
+            "rangeSet"_a, "weight"_a = 1.0);
+    cls.def("coarsened", &PixelCountMap::coarsened, "level"_a);
+    cls.def("getPixels", &PixelCountMap::getPixels);
+    cls.def("getRuns", &getRunArrays);
+
+    cls.def("__repr__", [](PixelCountMap const &self) {
+        return py::str("<PixelCountMap level={} runs={}>").format(self.getLevel(), self.size());
+    });
+}
+
+}  // sphgeom
+}  // lsst
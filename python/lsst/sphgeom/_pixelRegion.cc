@@ -0,0 +1,75 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/PixelRegion.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+#include "lsst/sphgeom/python/utils.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+template <>
+void defineClass(py::class_<PixelRegion, std::unique_ptr<PixelRegion>,
+                            Region> &cls) {
+    cls.attr("TYPE_CODE") = py::int_(PixelRegion::TYPE_CODE);
+
+    cls.def(py::init<Pixelization const &, RangeSet>(), "pixelization"_a,
+            "pixels"_a);
+    cls.def(py::init<PixelRegion const &>(), "pixelRegion"_a);
+
+    cls.def("__eq__", &PixelRegion::operator==, py::is_operator());
+    cls.def("__ne__", &PixelRegion::operator!=, py::is_operator());
+
+    cls.def("getPixelization", &PixelRegion::getPixelization,
+            py::return_value_policy::reference_internal);
+    cls.def("getLevel", &PixelRegion::getLevel);
+    cls.def("getPixels", &PixelRegion::getPixels);
+    cls.def("isEmpty", &PixelRegion::isEmpty);
+    cls.def("getPolygons", &PixelRegion::getPolygons,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("toUnionRegion", &PixelRegion::toUnionRegion,
+            py::call_guard<py::gil_scoped_release>());
+
+    // Note that the Region interface has already been wrapped.
+
+    cls.def("__repr__", [](PixelRegion const &self) {
+        return py::str("PixelRegion({!r}, {!r})")
+                .format(py::cast(self.getPixelization(),
+                                 py::return_value_policy::reference),
+                        self.getPixels());
+    });
+    cls.def(py::pickle(&python::encode, &python::decode<PixelRegion>));
+}
+
+}  // sphgeom
+}  // lsst
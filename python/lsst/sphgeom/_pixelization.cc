@@ -20,10 +20,21 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
 
 #include "lsst/sphgeom/python.h"
 
+#include "lsst/sphgeom/LonLat.h"
 #include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/RangeSet.h"
 #include "lsst/sphgeom/Region.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 
@@ -33,14 +44,319 @@ using namespace pybind11::literals;
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Compute pixel indexes for arrays of (not necessarily normalized) unit
+/// vector components, all having the same shape.
+py::array_t<uint64_t> indexArray(Pixelization const &self, DoubleArray x,
+                                 DoubleArray y, DoubleArray z, unsigned numThreads) {
+    if (x.request().shape != y.request().shape || x.request().shape != z.request().shape) {
+        throw py::value_error("x, y and z must have the same shape");
+    }
+    py::array_t<uint64_t> result(x.request().shape);
+    size_t n = static_cast<size_t>(x.size());
+    double const *xp = x.data();
+    double const *yp = y.data();
+    double const *zp = z.data();
+    uint64_t *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        self.index(xp, yp, zp, out, n, numThreads);
+    }
+    return result;
+}
+
+/// Compute pixel indexes for an array of (not necessarily normalized) unit
+/// vectors with shape S + (3,), e.g. as returned by
+/// `UnitVector3d.fromLonLatArrays`. The result has shape S.
+py::array_t<uint64_t> indexArray(Pixelization const &self, DoubleArray vectors,
+                                 unsigned numThreads) {
+    std::vector<py::ssize_t> shape = vectors.request().shape;
+    if (shape.empty() || shape.back() != 3) {
+        throw py::value_error("vectors must have shape (..., 3)");
+    }
+    shape.pop_back();
+    py::array_t<uint64_t> result(shape);
+    size_t n = static_cast<size_t>(result.size());
+    double const *in = vectors.data();
+    uint64_t *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        std::vector<double> xyz(3 * n);
+        for (size_t i = 0; i < n; ++i) {
+            xyz[i] = in[3 * i];
+            xyz[n + i] = in[3 * i + 1];
+            xyz[2 * n + i] = in[3 * i + 2];
+        }
+        self.index(xyz.data(), xyz.data() + n, xyz.data() + 2 * n, out, n, numThreads);
+    }
+    return result;
+}
+
+/// Compute pixel indexes for arrays of longitudes and latitudes (in
+/// radians) having the same shape.
+py::array_t<uint64_t> indexArray(Pixelization const &self, DoubleArray lon,
+                                 DoubleArray lat, unsigned numThreads) {
+    if (lon.request().shape != lat.request().shape) {
+        throw py::value_error("lon and lat must have the same shape");
+    }
+    py::array_t<uint64_t> result(lon.request().shape);
+    size_t n = static_cast<size_t>(lon.size());
+    double const *lonp = lon.data();
+    double const *latp = lat.data();
+    uint64_t *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        std::vector<double> xyz(3 * n);
+        for (size_t i = 0; i < n; ++i) {
+            UnitVector3d v(LonLat::fromRadians(lonp[i], latp[i]));
+            xyz[i] = v.x();
+            xyz[n + i] = v.y();
+            xyz[2 * n + i] = v.z();
+        }
+        self.index(xyz.data(), xyz.data() + n, xyz.data() + 2 * n, out, n, numThreads);
+    }
+    return result;
+}
+
+/// Compute the envelope or interior of a region as an (N, 2) NumPy array
+/// of [begin, end) pixel index ranges, or, if `expand` is true, as a 1-D
+/// array of the pixel indexes in those ranges, in ascending order.
+py::array_t<uint64_t> findArray(Pixelization const &self, Region const &region, size_t maxRanges,
+                                unsigned numThreads, bool expand, bool interior) {
+    RangeSet rs;
+    {
+        py::gil_scoped_release release;
+        rs = interior ? self.interior(region, maxRanges, numThreads)
+                      : self.envelope(region, maxRanges, numThreads);
+    }
+    // Ranges are stored as consecutive [begin, end) pairs.
+    uint64_t const *ranges = rs.begin().p;
+    size_t const numRanges = rs.size();
+    if (!expand) {
+        py::array_t<uint64_t> result({static_cast<py::ssize_t>(numRanges), static_cast<py::ssize_t>(2)});
+        std::copy(ranges, ranges + 2 * numRanges, result.mutable_data());
+        return result;
+    }
+    // Pixel indexes are always less than 2**64, so no range of a pixel
+    // index set wraps around.
+    uint64_t const n = rs.cardinality();
+    if (n > static_cast<uint64_t>(std::numeric_limits<py::ssize_t>::max()) / sizeof(uint64_t)) {
+        throw py::value_error("Too many pixels to expand");
+    }
+    py::array_t<uint64_t> result(static_cast<py::ssize_t>(n));
+    uint64_t *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        for (size_t i = 0; i < numRanges; ++i) {
+            for (uint64_t j = ranges[2 * i]; j != ranges[2 * i + 1]; ++j) {
+                *out++ = j;
+            }
+        }
+    }
+    return result;
+}
+
+/// Compute the envelopes or interiors of many regions as a tuple of NumPy
+/// arrays (offsets, bounds), where bounds has shape (N, 2) and the ranges of
+/// the i-th region are the rows in [offsets[i], offsets[i + 1]).
+py::tuple findManyFlat(Pixelization const &self, std::vector<Region const *> const &regions,
+                       size_t maxRanges, unsigned numThreads, bool interior) {
+    FlatRangeSets flat;
+    {
+        py::gil_scoped_release release;
+        flat = interior ? self.interiorManyFlat(regions, maxRanges, numThreads)
+                        : self.envelopeManyFlat(regions, maxRanges, numThreads);
+    }
+    py::array_t<uint64_t> offsets(static_cast<py::ssize_t>(flat.offsets.size()));
+    std::copy(flat.offsets.begin(), flat.offsets.end(), offsets.mutable_data());
+    py::array_t<uint64_t> bounds(
+            {static_cast<py::ssize_t>(flat.bounds.size() / 2), static_cast<py::ssize_t>(2)});
+    std::copy(flat.bounds.begin(), flat.bounds.end(), bounds.mutable_data());
+    return py::make_tuple(offsets, bounds);
+}
+
+/// Compute the coverage fractions of the pixels intersecting a region as a
+/// tuple of NumPy arrays (begin, end, fraction), where each of the pixels in
+/// [begin[i], end[i]) is covered to the fraction fraction[i].
+py::tuple coverageFractionArrays(Pixelization const &self, Region const &region) {
+    CoverageFractions c;
+    {
+        py::gil_scoped_release release;
+        c = self.coverageFraction(region);
+    }
+    py::ssize_t n = static_cast<py::ssize_t>(c.size());
+    py::array_t<uint64_t> begin(n);
+    py::array_t<uint64_t> end(n);
+    py::array_t<double> fraction(n);
+    std::copy(c.begin.begin(), c.begin.end(), begin.mutable_data());
+    std::copy(c.end.begin(), c.end.end(), end.mutable_data());
+    std::copy(c.fraction.begin(), c.fraction.end(), fraction.mutable_data());
+    return py::make_tuple(begin, end, fraction);
+}
+
+/// Convert an array of pixel indexes to a NumPy array of fixed-width byte
+/// strings with the same shape. The strings of the longest pixel indexes
+/// at the pixelization level exactly fill the fields.
+py::array toStringArray(Pixelization const &self,
+                        py::array_t<uint64_t, py::array::c_style | py::array::forcecast> indexes) {
+    size_t const width = std::max<size_t>(self.maxStringLength(), 1);
+    py::array result(py::dtype("S" + std::to_string(width)), indexes.request().shape);
+    size_t n = static_cast<size_t>(indexes.size());
+    uint64_t const *in = indexes.data();
+    char *out = static_cast<char *>(result.mutable_data());
+    {
+        py::gil_scoped_release release;
+        self.toString(in, n, out, width);
+    }
+    return result;
+}
+
+/// Parse a NumPy array of fixed-width byte strings (dtype S) to an array of
+/// pixel indexes with the same shape.
+py::array_t<uint64_t> fromStringArray(Pixelization const &self, py::array strings) {
+    if (strings.dtype().kind() != 'S') {
+        throw py::type_error("strings must be a NumPy array of byte strings");
+    }
+    py::array contiguous = py::array::ensure(strings, py::array::c_style);
+    size_t const width = static_cast<size_t>(contiguous.itemsize());
+    py::array_t<uint64_t> result(contiguous.request().shape);
+    size_t n = static_cast<size_t>(contiguous.size());
+    char const *in = static_cast<char const *>(contiguous.data());
+    uint64_t *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        self.fromString(in, n, width, out);
+    }
+    return result;
+}
+
+}  // <anonymous>
+
 template <>
 void defineClass(py::class_<Pixelization> &cls) {
     cls.def("universe", &Pixelization::universe);
     cls.def("pixel", &Pixelization::pixel, "i"_a);
-    cls.def("index", &Pixelization::index, "i"_a);
-    cls.def("toString", &Pixelization::toString, "i"_a);
-    cls.def("envelope", &Pixelization::envelope, "region"_a, "maxRanges"_a = 0);
-    cls.def("interior", &Pixelization::interior, "region"_a, "maxRanges"_a = 0);
+    cls.def("index",
+            py::overload_cast<UnitVector3d const &>(&Pixelization::index, py::const_),
+            "i"_a);
+    cls.def("index",
+            py::overload_cast<Pixelization const &, DoubleArray, DoubleArray, DoubleArray,
+                              unsigned>(&indexArray),
+            "x"_a, "y"_a, "z"_a, "numThreads"_a = 1);
+    cls.def("index",
+            py::overload_cast<Pixelization const &, DoubleArray, DoubleArray, unsigned>(
+                    &indexArray),
+            "lon"_a, "lat"_a, "numThreads"_a = 1);
+    cls.def("index",
+            py::overload_cast<Pixelization const &, DoubleArray, unsigned>(&indexArray),
+            "vectors"_a, "numThreads"_a = 1);
+    // indexArray and pixels are the batch methods of PixelizationABC.
+    cls.def("indexArray",
+            py::overload_cast<Pixelization const &, DoubleArray, DoubleArray, DoubleArray,
+                              unsigned>(&indexArray),
+            "x"_a, "y"_a, "z"_a, "numThreads"_a = 1);
+    cls.def("pixels",
+            [](Pixelization const &self, std::vector<uint64_t> const &indexes) {
+                std::vector<std::unique_ptr<Region>> regions;
+                regions.reserve(indexes.size());
+                for (uint64_t i : indexes) {
+                    regions.push_back(self.pixel(i));
+                }
+                return regions;
+            },
+            "indexes"_a);
+    cls.def("toString", py::overload_cast<uint64_t>(&Pixelization::toString, py::const_), "i"_a);
+    cls.def("toStringArray", &toStringArray, "indexes"_a);
+    cls.def("maxStringLength", &Pixelization::maxStringLength);
+    cls.def("fromString",
+            py::overload_cast<std::string const &>(&Pixelization::fromString, py::const_),
+            "s"_a);
+    cls.def("fromStringArray", &fromStringArray, "strings"_a);
+    cls.def("getCacheKey", &Pixelization::getCacheKey);
+    cls.def("envelope",
+            py::overload_cast<Region const &, size_t, unsigned>(
+                    &Pixelization::envelope, py::const_),
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("envelopeArray",
+            [](Pixelization const &self, Region const &region, size_t maxRanges, unsigned numThreads,
+               bool expand) { return findArray(self, region, maxRanges, numThreads, expand, false); },
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1, "expand"_a = false);
+    cls.def("interiorArray",
+            [](Pixelization const &self, Region const &region, size_t maxRanges, unsigned numThreads,
+               bool expand) { return findArray(self, region, maxRanges, numThreads, expand, true); },
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1, "expand"_a = false);
+    cls.def("envelopeMany", &Pixelization::envelopeMany, "regions"_a,
+            "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("interiorMany", &Pixelization::interiorMany, "regions"_a,
+            "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("envelopeAndInterior",
+            [](Pixelization const &self, Region const &region,
+               size_t maxRanges) {
+                EnvelopeAndInterior result;
+                {
+                    py::gil_scoped_release release;
+                    result = self.envelopeAndInterior(region, maxRanges);
+                }
+                return py::make_tuple(result.envelope, result.interior);
+            },
+            "region"_a, "maxRanges"_a = 0);
+    cls.def("updateEnvelope",
+            [](Pixelization const &self, Region const &previous,
+               RangeSet const &previousEnvelope, Region const &region,
+               size_t maxRanges, unsigned numThreads) {
+                EnvelopeUpdate update;
+                {
+                    py::gil_scoped_release release;
+                    update = self.updateEnvelope(previous, previousEnvelope,
+                                                 region, maxRanges, numThreads);
+                }
+                return py::make_tuple(update.envelope, update.added,
+                                      update.removed);
+            },
+            "previous"_a, "previousEnvelope"_a, "region"_a, "maxRanges"_a = 0,
+            "numThreads"_a = 1);
+    cls.def("envelopeManyFlat",
+            [](Pixelization const &self, std::vector<Region const *> const &regions,
+               size_t maxRanges, unsigned numThreads) {
+                return findManyFlat(self, regions, maxRanges, numThreads, false);
+            },
+            "regions"_a, "maxRanges"_a = 0, "numThreads"_a = 1);
+    cls.def("interiorManyFlat",
+            [](Pixelization const &self, std::vector<Region const *> const &regions,
+               size_t maxRanges, unsigned numThreads) {
+                return findManyFlat(self, regions, maxRanges, numThreads, true);
+            },
+            "regions"_a, "maxRanges"_a = 0, "numThreads"_a = 1);
+    cls.def("adaptiveEnvelope", &Pixelization::adaptiveEnvelope, "region"_a,
+            "targetRanges"_a, "areaBudget"_a = 0.0,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("adaptiveInterior", &Pixelization::adaptiveInterior, "region"_a,
+            "targetRanges"_a, "areaBudget"_a = 0.0,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("progressiveEnvelope", &Pixelization::progressiveEnvelope,
+            "region"_a);
+    cls.def("coverageFraction", &coverageFractionArrays, "region"_a);
+    cls.def("envelope",
+            py::overload_cast<Pixelization const &, RangeSet const &, size_t, unsigned>(
+                    &Pixelization::envelope, py::const_),
+            "pixelization"_a, "pixels"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("interior",
+            py::overload_cast<Region const &, size_t, unsigned>(
+                    &Pixelization::interior, py::const_),
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("interior",
+            py::overload_cast<Pixelization const &, RangeSet const &, size_t, unsigned>(
+                    &Pixelization::interior, py::const_),
+            "pixelization"_a, "pixels"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
 }
 
 }  // sphgeom
@@ -0,0 +1,120 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Angle.h"
+#include "lsst/sphgeom/PointIndex.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Create an index over the (not necessarily normalized) unit vectors with
+/// the given component arrays, all having the same shape.
+std::unique_ptr<PointIndex> makeIndex(DoubleArray x, DoubleArray y,
+                                      DoubleArray z, int level,
+                                      unsigned numThreads) {
+    if (x.request().shape != y.request().shape || x.request().shape != z.request().shape) {
+        throw py::value_error("x, y and z must have the same shape");
+    }
+    size_t n = static_cast<size_t>(x.size());
+    double const *xp = x.data();
+    double const *yp = y.data();
+    double const *zp = z.data();
+    py::gil_scoped_release release;
+    return std::make_unique<PointIndex>(
+            UnitVector3dArray::fromComponents(xp, yp, zp, n), level,
+            numThreads);
+}
+
+/// Find the k nearest neighbors of v, and return their indexes and angular
+/// separations (in radians) as a tuple of two arrays.
+py::tuple findNearest(PointIndex const &self, UnitVector3d const &v,
+                      size_t k) {
+    std::vector<std::pair<size_t, Angle>> nearest;
+    {
+        py::gil_scoped_release release;
+        nearest = self.findNearest(v, k);
+    }
+    py::ssize_t n = static_cast<py::ssize_t>(nearest.size());
+    py::array_t<uint64_t> indexes(n);
+    py::array_t<double> separations(n);
+    uint64_t *ip = indexes.mutable_data();
+    double *sp = separations.mutable_data();
+    for (auto const &p : nearest) {
+        *ip++ = p.first;
+        *sp++ = p.second.asRadians();
+    }
+    return py::make_tuple(indexes, separations);
+}
+
+/// Find the points within the given radius of v, and return their indexes
+/// as an array.
+py::array_t<uint64_t> findWithin(PointIndex const &self,
+                                 UnitVector3d const &v, Angle radius) {
+    std::vector<size_t> within;
+    {
+        py::gil_scoped_release release;
+        within = self.findWithin(v, radius);
+    }
+    py::array_t<uint64_t> result(static_cast<py::ssize_t>(within.size()));
+    std::copy(within.begin(), within.end(), result.mutable_data());
+    return result;
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<PointIndex, std::unique_ptr<PointIndex>> &cls) {
+    cls.def(py::init<>());
+    cls.def(py::init(&makeIndex), "x"_a, "y"_a, "z"_a, "level"_a,
+            "numThreads"_a = 1);
+    cls.def_static("open", &PointIndex::open, "path"_a);
+
+    cls.def("__len__", &PointIndex::size);
+    cls.def("empty", &PointIndex::empty);
+    cls.def("getLevel", &PointIndex::getLevel);
+
+    cls.def("findWithin", &findWithin, "unitVector"_a, "radius"_a);
+    cls.def("findNearest", &findNearest, "unitVector"_a, "k"_a);
+    cls.def("write", &PointIndex::write, "path"_a,
+            py::call_guard<py::gil_scoped_release>());
+}
+
+}  // sphgeom
+}  // lsst
@@ -0,0 +1,119 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/PolygonMesh.h"
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "lsst/sphgeom/python/utils.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+// Locate the given points, returning -1 for points outside of the mesh.
+py::array_t<int64_t> findFaces(PolygonMesh const &self, DoubleArray x, DoubleArray y, DoubleArray z,
+                               unsigned numThreads) {
+    if (x.ndim() != 1 || y.ndim() != 1 || z.ndim() != 1 || x.size() != y.size() || x.size() != z.size()) {
+        throw std::invalid_argument("x, y and z must be 1-D arrays of equal length");
+    }
+    size_t n = static_cast<size_t>(x.size());
+    std::vector<size_t> out(n);
+    {
+        py::gil_scoped_release release;
+        std::vector<UnitVector3d> points;
+        points.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            points.emplace_back(x.data()[i], y.data()[i], z.data()[i]);
+        }
+        self.findFaces(points.data(), n, out.data(), numThreads);
+    }
+    py::array_t<int64_t> result(static_cast<py::ssize_t>(n));
+    int64_t *data = result.mutable_data();
+    for (size_t i = 0; i < n; ++i) {
+        data[i] = out[i] == PolygonMesh::NO_FACE ? -1 : static_cast<int64_t>(out[i]);
+    }
+    return result;
+}
+
+py::array_t<uint8_t> relate(PolygonMesh const &self, Region const &region, unsigned numThreads) {
+    std::vector<Relationship> out(self.getNumFaces());
+    {
+        py::gil_scoped_release release;
+        self.relate(region, out.data(), numThreads);
+    }
+    py::array_t<uint8_t> result(static_cast<py::ssize_t>(out.size()));
+    uint8_t *data = result.mutable_data();
+    for (size_t i = 0; i < out.size(); ++i) {
+        data[i] = static_cast<uint8_t>(out[i].to_ulong());
+    }
+    return result;
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<PolygonMesh, std::unique_ptr<PolygonMesh>> &cls) {
+    cls.def(py::init<>());
+    cls.def(py::init<std::vector<ConvexPolygon> const &>(), "faces"_a);
+
+    cls.def("__len__", &PolygonMesh::getNumFaces);
+    cls.def("__getitem__", [](PolygonMesh const &self, py::int_ i) {
+        return self.getFace(python::convertIndex(static_cast<ptrdiff_t>(self.getNumFaces()), i));
+    });
+    cls.def("empty", &PolygonMesh::empty);
+    cls.def("getNumFaces", &PolygonMesh::getNumFaces);
+    cls.def("getNumEdges", &PolygonMesh::getNumEdges);
+    cls.def("getVertices", &PolygonMesh::getVertices);
+    cls.def("getFaceVertices", &PolygonMesh::getFaceVertices, "i"_a);
+    cls.def("getNeighbor", [](PolygonMesh const &self, size_t i, size_t k) -> py::object {
+        size_t j = self.getNeighbor(i, k);
+        return j == PolygonMesh::NO_FACE ? py::object(py::none()) : py::object(py::int_(j));
+    }, "i"_a, "k"_a);
+
+    cls.def("findFace", [](PolygonMesh const &self, UnitVector3d const &v, size_t hint) -> py::object {
+        size_t i = self.findFace(v, hint);
+        return i == PolygonMesh::NO_FACE ? py::object(py::none()) : py::object(py::int_(i));
+    }, "unitVector"_a, "hint"_a = 0);
+    cls.def("findFaces", &findFaces, "x"_a, "y"_a, "z"_a, "numThreads"_a = 1);
+    cls.def("relate", &relate, "region"_a, "numThreads"_a = 1);
+}
+
+}  // sphgeom
+}  // lsst
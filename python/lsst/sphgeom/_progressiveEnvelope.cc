@@ -0,0 +1,57 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/ProgressiveEnvelope.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+template <>
+void defineClass(py::class_<ProgressiveEnvelope,
+                            std::unique_ptr<ProgressiveEnvelope>> &cls) {
+    cls.def("refine", &ProgressiveEnvelope::refine, "maxSteps"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("refineFor",
+            [](ProgressiveEnvelope &self, double seconds) {
+                return self.refineFor(std::chrono::duration<double>(seconds));
+            },
+            "seconds"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("isComplete", &ProgressiveEnvelope::isComplete);
+    cls.def("getRanges", &ProgressiveEnvelope::getRanges);
+    cls.def("getCoarsestLevel", &ProgressiveEnvelope::getCoarsestLevel);
+    cls.def("getFrontierArea", &ProgressiveEnvelope::getFrontierArea);
+    cls.def("getNumSteps", &ProgressiveEnvelope::getNumSteps);
+}
+
+}  // sphgeom
+}  // lsst
@@ -20,10 +20,13 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
 
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/python/utils.h"
 
 namespace py = pybind11;
 using namespace pybind11::literals;
@@ -31,30 +34,78 @@ using namespace pybind11::literals;
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using IndexArray = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+py::tuple neighborhoods(Q3cPixelization const &self, IndexArray indexes) {
+    if (indexes.ndim() != 1) {
+        throw std::invalid_argument("indexes must be a 1-D array");
+    }
+    py::ssize_t n = indexes.size();
+    py::array_t<uint64_t> out({n, static_cast<py::ssize_t>(9)});
+    py::array_t<uint8_t> counts(n);
+    {
+        py::gil_scoped_release release;
+        self.neighborhoods(indexes.data(), static_cast<size_t>(n),
+                 out.mutable_data(), counts.mutable_data());
+    }
+    return py::make_tuple(out, counts);
+}
+
+}  // <anonymous>
+
 template <>
 void defineClass(py::class_<Q3cPixelization, Pixelization> &cls) {
     cls.attr("MAX_LEVEL") = py::int_(Q3cPixelization::MAX_LEVEL);
+    cls.attr("NUM_VERTICES") = py::int_(Q3cPixelization::NUM_VERTICES);
 
-    cls.def(py::init<int>(), "level"_a);
+    cls.def(py::init<int, size_t, bool>(), "level"_a, "cacheSize"_a = 0,
+            "hilbertOrder"_a = false);
     cls.def(py::init<Q3cPixelization const &>(), "q3cPixelization"_a);
 
     cls.def("getLevel", &Q3cPixelization::getLevel);
+    cls.def("multiLevelEnvelope", &Q3cPixelization::multiLevelEnvelope,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("multiLevelInterior", &Q3cPixelization::multiLevelInterior,
+            "region"_a, "maxRanges"_a = 0, "numThreads"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("envelopeAtLevels", &Q3cPixelization::envelopeAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("interiorAtLevels", &Q3cPixelization::interiorAtLevels,
+            "region"_a, "levels"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("isHilbertOrder", &Q3cPixelization::isHilbertOrder);
+    cls.def("vertices", &python::pixelVertices<Q3cPixelization>, "indexes"_a);
     cls.def("quad", &Q3cPixelization::quad);
-    cls.def("neighborhood", &Q3cPixelization::neighborhood);
+    cls.def("neighborhood",
+            py::overload_cast<uint64_t>(&Q3cPixelization::neighborhood,
+                                        py::const_),
+            "i"_a);
+    cls.def("neighborhoods", &neighborhoods, "indexes"_a);
+    cls.def("dilate", &Q3cPixelization::dilate, "pixels"_a, "k"_a = 1,
+            py::call_guard<py::gil_scoped_release>());
 
     cls.def("__eq__",
             [](Q3cPixelization const &self, Q3cPixelization const &other) {
-                return self.getLevel() == other.getLevel();
+                return self.getLevel() == other.getLevel() &&
+                       self.isHilbertOrder() == other.isHilbertOrder();
             });
     cls.def("__ne__",
             [](Q3cPixelization const &self, Q3cPixelization const &other) {
-                return self.getLevel() != other.getLevel();
+                return self.getLevel() != other.getLevel() ||
+                       self.isHilbertOrder() != other.isHilbertOrder();
             });
     cls.def("__repr__", [](Q3cPixelization const &self) {
+        if (self.isHilbertOrder()) {
+            return py::str("Q3cPixelization({!s}, hilbertOrder=True)")
+                    .format(self.getLevel());
+        }
         return py::str("Q3cPixelization({!s})").format(self.getLevel());
     });
     cls.def("__reduce__", [cls](Q3cPixelization const &self) {
-        return py::make_tuple(cls, py::make_tuple(self.getLevel()));
+        return py::make_tuple(
+                cls, py::make_tuple(self.getLevel(), 0, self.isHilbertOrder()));
     });
 }
 
@@ -20,6 +20,7 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
 
 #include "lsst/sphgeom/python.h"
 
@@ -65,6 +66,122 @@ RangeSet makeRangeSet(py::iterable iterable) {
     return rs;
 }
 
+using IndexArray = py::array_t<uint64_t, py::array::c_style | py::array::forcecast>;
+
+/// Convert a numpy array of integers with the given number of dimensions
+/// to an array of uint64_t, copying only if necessary. Returns false if the
+/// array cannot be interpreted in that way.
+bool _toIndexArray(py::array const &array, IndexArray &out, py::ssize_t ndim = 1) {
+    if (array.ndim() != ndim) {
+        return false;
+    }
+    char kind = array.dtype().kind();
+    if (kind == 'i') {
+        auto signedArray = py::array_t<int64_t, py::array::c_style | py::array::forcecast>::ensure(array);
+        int64_t const *data = signedArray.data();
+        for (py::ssize_t i = 0; i < signedArray.size(); ++i) {
+            if (data[i] < 0) {
+                throw py::value_error(
+                        "RangeSet elements and range beginning and "
+                        "end points must be non-negative integers "
+                        "less than 2**64");
+            }
+        }
+        out = IndexArray::ensure(signedArray);
+        return true;
+    }
+    if (kind == 'u') {
+        out = IndexArray::ensure(array);
+        return true;
+    }
+    return false;
+}
+
+/// Insert the integers in a 1-D array of uint64_t into a RangeSet.
+void _insertMany(RangeSet &rs, IndexArray const &array) {
+    uint64_t const *data = array.data();
+    size_t n = static_cast<size_t>(array.shape(0));
+    py::gil_scoped_release release;
+    rs.insertMany(data, n);
+}
+
+/// Insert the ranges in an (N, 2) array of uint64_t into a RangeSet. Ranges
+/// that are sorted and disjoint are appended in amortized constant time.
+void _insertRanges(RangeSet &rs, IndexArray const &array) {
+    uint64_t const *data = array.data();
+    size_t n = static_cast<size_t>(array.shape(0));
+    py::gil_scoped_release release;
+    for (size_t i = 0; i < n; ++i) {
+        // Ranges exported by the buffer protocol are in ascending order, so
+        // append avoids searching in the common case.
+        rs.append(data[2 * i], data[2 * i + 1]);
+    }
+}
+
+/// Insert the integers in a 1-D numpy array into a RangeSet.
+void insertMany(RangeSet &rs, py::array const &array) {
+    IndexArray a;
+    if (!_toIndexArray(array, a)) {
+        throw py::value_error("Expected a 1-D array of integers");
+    }
+    _insertMany(rs, a);
+}
+
+/// Test whether each integer in a 1-D numpy array is in a RangeSet.
+py::array_t<bool> containsMany(RangeSet const &rs, py::array const &array) {
+    IndexArray a;
+    if (!_toIndexArray(array, a)) {
+        throw py::value_error("Expected a 1-D array of integers");
+    }
+    size_t n = static_cast<size_t>(a.shape(0));
+    py::array_t<bool> result(static_cast<py::ssize_t>(n));
+    uint64_t const *data = a.data();
+    bool *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        rs.contains(data, n, out);
+    }
+    return result;
+}
+
+/// Copy the RangeSets in an iterable into a vector.
+std::vector<RangeSet> _toRangeSets(py::iterable iterable) {
+    std::vector<RangeSet> sets;
+    for (py::handle item : iterable) {
+        sets.push_back(item.cast<RangeSet const &>());
+    }
+    return sets;
+}
+
+/// Compute the union of an iterable of RangeSets.
+RangeSet unionAll(py::iterable iterable, unsigned numThreads) {
+    std::vector<RangeSet> sets = _toRangeSets(iterable);
+    py::gil_scoped_release release;
+    return RangeSet::unionAll(sets, numThreads);
+}
+
+/// Compute the intersection of an iterable of RangeSets.
+RangeSet intersectAll(py::iterable iterable, unsigned numThreads) {
+    std::vector<RangeSet> sets = _toRangeSets(iterable);
+    py::gil_scoped_release release;
+    return RangeSet::intersectAll(sets, numThreads);
+}
+
+/// Encode a RangeSet as a pybind11 bytes object.
+py::bytes encode(RangeSet const &self) {
+    std::vector<uint8_t> bytes = self.encode();
+    return py::bytes(reinterpret_cast<char const *>(bytes.data()),
+                     bytes.size());
+}
+
+/// Decode a RangeSet from a pybind11 bytes object.
+RangeSet decode(py::bytes bytes) {
+    uint8_t const *buffer = reinterpret_cast<uint8_t const *>(
+            PYBIND11_BYTES_AS_STRING(bytes.ptr()));
+    size_t n = static_cast<size_t>(PYBIND11_BYTES_SIZE(bytes.ptr()));
+    return RangeSet::decode(buffer, n);
+}
+
 /// Make a python list of the ranges in the given RangeSet.
 py::list ranges(RangeSet const &self) {
     py::list list;
@@ -92,6 +209,24 @@ void defineClass(py::class_<RangeSet, std::shared_ptr<RangeSet>> &cls) {
             }),
             "first"_a, "last"_a);
     cls.def(py::init<RangeSet const &>(), "rangeSet"_a);
+    // Integer numpy arrays are handled in bulk: 1-D arrays hold integers,
+    // and (N, 2) arrays hold ranges, e.g. as exported by the buffer protocol
+    // below. This overload must precede the one for generic iterables, which
+    // numpy arrays also are.
+    cls.def(py::init([](py::array const &array) {
+                IndexArray a;
+                RangeSet rs;
+                if (_toIndexArray(array, a)) {
+                    _insertMany(rs, a);
+                } else if (array.ndim() == 2 && array.shape(1) == 2 &&
+                           _toIndexArray(array, a, 2)) {
+                    _insertRanges(rs, a);
+                } else {
+                    rs = makeRangeSet(array);
+                }
+                return rs;
+            }),
+            "array"_a);
     cls.def(py::init(
             [](py::iterable iterable) {
                 return new RangeSet(makeRangeSet(iterable));
@@ -105,29 +240,63 @@ void defineClass(py::class_<RangeSet, std::shared_ptr<RangeSet>> &cls) {
     cls.def("insert",
             (void (RangeSet::*)(uint64_t, uint64_t)) & RangeSet::insert,
             "first"_a, "last"_a);
+    cls.def("insertMany", &insertMany, "array"_a);
     cls.def("erase", (void (RangeSet::*)(uint64_t)) & RangeSet::erase,
             "integer"_a);
     cls.def("erase", (void (RangeSet::*)(uint64_t, uint64_t)) & RangeSet::erase,
             "first"_a, "last"_a);
 
-    cls.def("complement", &RangeSet::complement);
-    cls.def("complemented", &RangeSet::complemented);
-    cls.def("intersection", &RangeSet::intersection, "rangeSet"_a);
+    cls.def("complement", &RangeSet::complement, py::call_guard<py::gil_scoped_release>());
+    cls.def("complemented", &RangeSet::complemented, py::call_guard<py::gil_scoped_release>());
+    cls.def("intersection", &RangeSet::intersection, "rangeSet"_a,
+            py::call_guard<py::gil_scoped_release>());
     // In C++, the set union function is named join because union is a keyword.
     // Python does not suffer from the same restriction.
-    cls.def("union", &RangeSet::join, "rangeSet"_a);
-    cls.def("difference", &RangeSet::difference, "rangeSet"_a);
+    cls.def("union", &RangeSet::join, "rangeSet"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def("difference", &RangeSet::difference, "rangeSet"_a,
+            py::call_guard<py::gil_scoped_release>());
     cls.def("symmetricDifference", &RangeSet::symmetricDifference,
-            "rangeSet"_a);
-    cls.def("__invert__", &RangeSet::operator~, py::is_operator());
-    cls.def("__and__", &RangeSet::operator&, py::is_operator());
-    cls.def("__or__", &RangeSet::operator|, py::is_operator());
-    cls.def("__sub__", &RangeSet::operator-, py::is_operator());
-    cls.def("__xor__", &RangeSet::operator^, py::is_operator());
-    cls.def("__iand__", &RangeSet::operator&=);
-    cls.def("__ior__", &RangeSet::operator|=);
-    cls.def("__isub__", &RangeSet::operator-=);
-    cls.def("__ixor__", &RangeSet::operator^=);
+            "rangeSet"_a, py::call_guard<py::gil_scoped_release>());
+    cls.def_static("unionAll", &unionAll, "rangeSets"_a,
+                   "numThreads"_a = 1);
+    cls.def_static("intersectAll", &intersectAll, "rangeSets"_a,
+                   "numThreads"_a = 1);
+    cls.def("__invert__",
+            (RangeSet (RangeSet::*)() const &) & RangeSet::operator~,
+            py::is_operator(),
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("__and__",
+            (RangeSet (RangeSet::*)(RangeSet const &) const &) & RangeSet::operator&,
+            py::is_operator(),
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("__or__",
+            (RangeSet (RangeSet::*)(RangeSet const &) const &) & RangeSet::operator|,
+            py::is_operator(),
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("__sub__",
+            (RangeSet (RangeSet::*)(RangeSet const &) const &) & RangeSet::operator-,
+            py::is_operator(),
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("__xor__", &RangeSet::operator^, py::is_operator(),
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("__iand__", &RangeSet::operator&=, py::call_guard<py::gil_scoped_release>());
+    cls.def("__ior__", &RangeSet::operator|=, py::call_guard<py::gil_scoped_release>());
+    cls.def("__isub__", &RangeSet::operator-=, py::call_guard<py::gil_scoped_release>());
+    cls.def("__ixor__", &RangeSet::operator^=, py::call_guard<py::gil_scoped_release>());
+
+    // Expose the ranges as a read-only (N, 2) array of uint64 without
+    // copying. Range end-points are stored contiguously, and begin() accounts
+    // for whether or not the set contains 0. As with ranges(), an end-point
+    // of 0 denotes 2**64. The buffer is invalidated by modifying the set.
+    cls.def_buffer([](RangeSet &self) {
+        return py::buffer_info(
+                const_cast<uint64_t *>(self.begin().p), sizeof(uint64_t),
+                py::format_descriptor<uint64_t>::format(), 2,
+                {static_cast<py::ssize_t>(self.size()), py::ssize_t(2)},
+                {static_cast<py::ssize_t>(2 * sizeof(uint64_t)),
+                 static_cast<py::ssize_t>(sizeof(uint64_t))},
+                true);
+    });
 
     cls.def("__len__", &RangeSet::size);
     cls.def("__getitem__", [](RangeSet const &self, py::int_ i) {
@@ -146,6 +315,7 @@ void defineClass(py::class_<RangeSet, std::shared_ptr<RangeSet>> &cls) {
             (bool (RangeSet::*)(RangeSet const &) const) & RangeSet::intersects,
             "rangeSet"_a);
 
+    cls.def("contains", &containsMany, "array"_a);
     cls.def("contains",
             (bool (RangeSet::*)(uint64_t) const) & RangeSet::contains,
             "integer"_a);
@@ -189,8 +359,17 @@ void defineClass(py::class_<RangeSet, std::shared_ptr<RangeSet>> &cls) {
 
     cls.def("simplify", &RangeSet::simplify, "n"_a);
     cls.def("simplified", &RangeSet::simplified, "n"_a);
+    cls.def("compact", &RangeSet::compact, "maxRanges"_a);
+    cls.def("compacted", &RangeSet::compacted, "maxRanges"_a);
+    cls.def("compactionOverCoverage", &RangeSet::compactionOverCoverage,
+            "maxRanges"_a);
     cls.def("scale", &RangeSet::scale, "factor"_a);
     cls.def("scaled", &RangeSet::scaled, "factor"_a);
+    cls.def("coarsen", &RangeSet::coarsen, "levels"_a, "interior"_a = false);
+    cls.def("coarsened", &RangeSet::coarsened, "levels"_a,
+            "interior"_a = false);
+    cls.def("refine", &RangeSet::refine, "levels"_a);
+    cls.def("refined", &RangeSet::refined, "levels"_a);
     cls.def("fill", &RangeSet::fill);
     cls.def("clear", &RangeSet::clear);
     cls.def("empty", &RangeSet::empty);
@@ -201,6 +380,8 @@ void defineClass(py::class_<RangeSet, std::shared_ptr<RangeSet>> &cls) {
     // requirement, and the latter doesn't seem relevant to Python.
     cls.def("isValid", &RangeSet::cardinality);
     cls.def("ranges", &ranges);
+    cls.def("encode", &encode);
+    cls.def_static("decode", &decode, "bytes"_a);
 
     cls.def("__str__",
             [](RangeSet const &self) { return py::str(ranges(self)); });
@@ -208,8 +389,20 @@ void defineClass(py::class_<RangeSet, std::shared_ptr<RangeSet>> &cls) {
         return py::str("RangeSet({!s})").format(ranges(self));
     });
 
-    cls.def("__reduce__", [cls](RangeSet const &self) {
-        return py::make_tuple(cls, py::make_tuple(ranges(self)));
+    // With pickle protocol 5, the ranges are pickled as a numpy array view
+    // of the set, which numpy hands to the pickler as an out-of-band buffer,
+    // so that sets can be sent to other processes without copying. Earlier
+    // protocols use the compact encoding of encode() as the pickled state.
+    cls.def("__reduce_ex__", [cls](py::object self, int protocol) {
+        if (protocol >= 5) {
+            py::object array = py::module::import("numpy").attr("asarray")(self);
+            return py::make_tuple(cls, py::make_tuple(array));
+        }
+        return py::make_tuple(cls, py::tuple(),
+                              encode(self.cast<RangeSet const &>()));
+    });
+    cls.def("__setstate__", [](RangeSet &self, py::bytes state) {
+        self = decode(state);
     });
 }
 
@@ -0,0 +1,82 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <random>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/RangeSetIndex.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Draw n integers uniformly from the indexed set, returning them as an
+// array. A random seed is used if none is given.
+py::array_t<uint64_t> sample(RangeSetIndex const &self, size_t n, py::object seed) {
+    std::mt19937_64 rng(seed.is_none() ? std::random_device()() : seed.cast<uint64_t>());
+    py::array_t<uint64_t> result(static_cast<py::ssize_t>(n));
+    uint64_t *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        self.sample(n, rng, out);
+    }
+    return result;
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<RangeSetIndex, std::shared_ptr<RangeSetIndex>> &cls) {
+    cls.def(py::init<>());
+    cls.def(py::init<RangeSet const &>(), "rangeSet"_a);
+
+    cls.def("__len__", &RangeSetIndex::size);
+
+    cls.def("getRangeSet", &RangeSetIndex::getRangeSet);
+    cls.def("empty", &RangeSetIndex::empty);
+    cls.def("full", &RangeSetIndex::full);
+    cls.def("size", &RangeSetIndex::size);
+    cls.def("cardinality", &RangeSetIndex::cardinality);
+    cls.def("select",
+            (uint64_t(RangeSetIndex::*)(uint64_t) const) & RangeSetIndex::select,
+            "k"_a);
+    cls.def("select",
+            (RangeSet(RangeSetIndex::*)(uint64_t, uint64_t) const) & RangeSetIndex::select,
+            "first"_a, "last"_a);
+    cls.def("rank", &RangeSetIndex::rank, "i"_a);
+    cls.def("sample", &sample, "n"_a, "seed"_a = py::none());
+
+    cls.def("__repr__", [](RangeSetIndex const &self) {
+        return py::str("RangeSetIndex({!r})").format(self.getRangeSet());
+    });
+}
+
+}  // sphgeom
+}  // lsst
@@ -22,6 +22,12 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/numpy.h"
 
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
+#include <random>
+#include <vector>
+
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/Box.h"
@@ -29,7 +35,10 @@
 #include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/LonLat.h"
 #include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/RegionBatch.h"
+#include "lsst/sphgeom/RelateCache.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 
 #include "lsst/sphgeom/python/relationship.h"
@@ -41,18 +50,152 @@ using namespace pybind11::literals;
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+bool sameShape(DoubleArray const &a, DoubleArray const &b) {
+    return a.ndim() == b.ndim() && std::equal(a.shape(), a.shape() + a.ndim(), b.shape());
+}
+
+// Broadcast the given arrays against each other, as py::vectorize does.
+void broadcast(std::initializer_list<DoubleArray *> arrays) {
+    DoubleArray const &first = **arrays.begin();
+    bool same = true;
+    for (DoubleArray *a : arrays) {
+        same = same && sameShape(first, *a);
+    }
+    if (same) {
+        return;
+    }
+    py::list args;
+    for (DoubleArray *a : arrays) {
+        args.append(*a);
+    }
+    py::sequence result = py::module::import("numpy").attr("broadcast_arrays")(*args);
+    size_t i = 0;
+    for (DoubleArray *a : arrays) {
+        *a = DoubleArray::ensure(result[i++]);
+    }
+}
+
+// Wrap the output of a batch containment test, returning a Python bool
+// for 0-dimensional inputs.
+py::object containsResult(DoubleArray const &shape, bool const *out) {
+    if (shape.ndim() == 0) {
+        return py::bool_(out[0]);
+    }
+    py::array_t<bool> result(std::vector<py::ssize_t>(shape.shape(), shape.shape() + shape.ndim()));
+    std::copy(out, out + shape.size(), result.mutable_data());
+    return std::move(result);
+}
+
+py::object containsArray(Region const &self, DoubleArray x, DoubleArray y, DoubleArray z,
+                         unsigned numThreads) {
+    broadcast({&x, &y, &z});
+    size_t const n = static_cast<size_t>(x.size());
+    std::unique_ptr<bool[]> out(new bool[n]);
+    {
+        py::gil_scoped_release release;
+        self.contains(x.data(), y.data(), z.data(), out.get(), n, numThreads);
+    }
+    return containsResult(x, out.get());
+}
+
+py::object containsArray(Region const &self, DoubleArray lon, DoubleArray lat, unsigned numThreads) {
+    broadcast({&lon, &lat});
+    size_t const n = static_cast<size_t>(lon.size());
+    std::unique_ptr<bool[]> out(new bool[n]);
+    {
+        py::gil_scoped_release release;
+        double const *lo = lon.data();
+        double const *la = lat.data();
+        std::vector<double> xyz(3 * n);
+        for (size_t i = 0; i < n; ++i) {
+            UnitVector3d v(LonLat::fromRadians(lo[i], la[i]));
+            xyz[i] = v.x();
+            xyz[n + i] = v.y();
+            xyz[2 * n + i] = v.z();
+        }
+        self.contains(xyz.data(), xyz.data() + n, xyz.data() + 2 * n, out.get(), n, numThreads);
+    }
+    return containsResult(lon, out.get());
+}
+
+// Relate a region to a sequence of regions, or to the regions in a byte
+// string produced by Region.encodeBatch. Items of a sequence may also be
+// region encodings.
+py::array_t<uint8_t> relateMany(Region const &self, py::object targets, unsigned numThreads) {
+    std::vector<std::unique_ptr<Region>> decoded;
+    std::vector<Region const *> pointers;
+    if (py::isinstance<py::bytes>(targets)) {
+        py::bytes bytes = targets;
+        RegionBatchDecoder decoder(reinterpret_cast<uint8_t const *>(PYBIND11_BYTES_AS_STRING(bytes.ptr())),
+                                   static_cast<size_t>(PYBIND11_BYTES_SIZE(bytes.ptr())));
+        decoded.reserve(decoder.size());
+        for (size_t i = 0; i < decoder.size(); ++i) {
+            decoded.push_back(decoder.decode(i));
+            pointers.push_back(decoded.back().get());
+        }
+    } else {
+        for (py::handle t : targets) {
+            if (py::isinstance<py::bytes>(t)) {
+                decoded.push_back(python::decode<Region>(py::reinterpret_borrow<py::bytes>(t)));
+                pointers.push_back(decoded.back().get());
+            } else {
+                pointers.push_back(&t.cast<Region const &>());
+            }
+        }
+    }
+    std::vector<Relationship> out(pointers.size());
+    {
+        py::gil_scoped_release release;
+        lsst::sphgeom::relateMany(self, pointers.data(), pointers.size(), out.data(), numThreads);
+    }
+    py::array_t<uint8_t> result(static_cast<py::ssize_t>(out.size()));
+    uint8_t *data = result.mutable_data();
+    for (size_t i = 0; i < out.size(); ++i) {
+        data[i] = static_cast<uint8_t>(out[i].to_ulong());
+    }
+    return result;
+}
+
+// Draw n points uniformly from a region, returning their coordinates as a
+// tuple of arrays. A random seed is used if none is given.
+py::tuple sample(Region const &self, size_t n, py::object seed) {
+    std::mt19937_64 rng(seed.is_none() ? std::random_device()() : seed.cast<uint64_t>());
+    py::array_t<double> x(static_cast<py::ssize_t>(n));
+    py::array_t<double> y(static_cast<py::ssize_t>(n));
+    py::array_t<double> z(static_cast<py::ssize_t>(n));
+    double *xs = x.mutable_data();
+    double *ys = y.mutable_data();
+    double *zs = z.mutable_data();
+    {
+        py::gil_scoped_release release;
+        self.sample(n, rng, xs, ys, zs);
+    }
+    return py::make_tuple(x, y, z);
+}
+
+}  // <anonymous>
+
 template <>
 void defineClass(py::class_<Region, std::unique_ptr<Region>> &cls) {
     cls.def("clone", &Region::clone);
     cls.def("getBoundingBox", &Region::getBoundingBox);
     cls.def("getBoundingBox3d", &Region::getBoundingBox3d);
     cls.def("getBoundingCircle", &Region::getBoundingCircle);
+    cls.def("getCostHint", &Region::getCostHint);
     cls.def("contains", py::overload_cast<UnitVector3d const &>(&Region::contains, py::const_),
             "unitVector"_a);
-    cls.def("contains", py::vectorize((bool (Region::*)(double, double, double) const)&Region::contains),
-            "x"_a, "y"_a, "z"_a);
-    cls.def("contains", py::vectorize((bool (Region::*)(double, double) const)&Region::contains),
-            "lon"_a, "lat"_a);
+    cls.def("contains",
+            py::overload_cast<Region const &, DoubleArray, DoubleArray, DoubleArray, unsigned>(
+                    &containsArray),
+            "x"_a, "y"_a, "z"_a, "numThreads"_a = 1);
+    cls.def("contains",
+            py::overload_cast<Region const &, DoubleArray, DoubleArray, unsigned>(&containsArray),
+            "lon"_a, "lat"_a, "numThreads"_a = 1);
+    cls.def("sample", &sample, "n"_a, "seed"_a = py::none());
     cls.def("__contains__", py::overload_cast<UnitVector3d const &>(&Region::contains, py::const_),
             py::is_operator());
     // The per-subclass relate() overloads are used to implement
@@ -60,8 +203,56 @@ void defineClass(py::class_<Region, std::unique_ptr<Region>> &cls) {
     cls.def("relate",
             (Relationship(Region::*)(Region const &) const) & Region::relate,
             "region"_a);
+    cls.def("relateMany", &relateMany, "regions"_a, "numThreads"_a = 1);
     cls.def("encode", &python::encode);
+    cls.def("encodeCompact", [](Region const &self) {
+        std::vector<uint8_t> bytes = self.encodeCompact();
+        return py::bytes(reinterpret_cast<char const *>(bytes.data()),
+                         bytes.size());
+    });
     cls.def_static("decode", &python::decode<Region>, "bytes"_a);
+    cls.def_static("encodeBatch",
+                   [](py::iterable regions) {
+                       std::vector<uint8_t> buffer;
+                       RegionBatchEncoder encoder(buffer);
+                       for (py::handle r : regions) {
+                           encoder.append(r.cast<Region const &>());
+                       }
+                       encoder.finish();
+                       return py::bytes(reinterpret_cast<char const *>(buffer.data()),
+                                        buffer.size());
+                   },
+                   "regions"_a);
+    cls.def_static("decodeBatch",
+                   [](py::bytes bytes) {
+                       uint8_t const *buffer = reinterpret_cast<uint8_t const *>(
+                               PYBIND11_BYTES_AS_STRING(bytes.ptr()));
+                       size_t n = static_cast<size_t>(PYBIND11_BYTES_SIZE(bytes.ptr()));
+                       RegionBatchDecoder decoder(buffer, n);
+                       py::list result;
+                       for (size_t i = 0; i < decoder.size(); ++i) {
+                           result.append(py::cast(decoder.decode(i)));
+                       }
+                       return result;
+                   },
+                   "bytes"_a);
+    cls.def_static("relateBatch",
+                   [](py::bytes bytes, Region const &region, RelateCache *cache) {
+                       uint8_t const *buffer = reinterpret_cast<uint8_t const *>(
+                               PYBIND11_BYTES_AS_STRING(bytes.ptr()));
+                       size_t n = static_cast<size_t>(PYBIND11_BYTES_SIZE(bytes.ptr()));
+                       std::vector<Relationship> relationships;
+                       {
+                           py::gil_scoped_release release;
+                           relationships = RegionBatchDecoder(buffer, n).relateAll(region, cache);
+                       }
+                       py::list result;
+                       for (Relationship r : relationships) {
+                           result.append(py::cast(r));
+                       }
+                       return result;
+                   },
+                   "bytes"_a, "region"_a, "cache"_a = nullptr);
 }
 
 }  // sphgeom
@@ -0,0 +1,76 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include <memory>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/RegionIndex.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "lsst/sphgeom/python/utils.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+py::bytes encode(RegionIndex const &self) {
+    std::vector<uint8_t> bytes = self.encode();
+    return py::bytes(reinterpret_cast<char const *>(bytes.data()), bytes.size());
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<RegionIndex, std::unique_ptr<RegionIndex>> &cls) {
+    cls.attr("TYPE_CODE") = py::int_(RegionIndex::TYPE_CODE);
+
+    cls.def(py::init([](py::sequence regions) {
+                return std::make_unique<RegionIndex>(python::convert_region_sequence(regions));
+            }),
+            "regions"_a);
+
+    cls.def("__len__", &RegionIndex::size);
+    cls.def("__getitem__", [](RegionIndex const &self, py::int_ i) {
+        return self.getRegion(python::convertIndex(static_cast<ptrdiff_t>(self.size()), i)).clone();
+    });
+
+    cls.def("overlapping", &RegionIndex::overlapping, "region"_a,
+            py::call_guard<py::gil_scoped_release>());
+    cls.def("containing", &RegionIndex::containing, "unitVector"_a,
+            py::call_guard<py::gil_scoped_release>());
+
+    cls.def("encode", &encode);
+    cls.def_static("decode", &python::decode<RegionIndex>, "bytes"_a);
+    cls.def(py::pickle(&encode, &python::decode<RegionIndex>));
+}
+
+}  // sphgeom
+}  // lsst
@@ -0,0 +1,101 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+#include "pybind11/stl.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/RegionSet.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "lsst/sphgeom/python/utils.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+py::tuple containsWhich(RegionSet const &self, DoubleArray x, DoubleArray y, DoubleArray z) {
+    if (x.ndim() != 1 || y.ndim() != 1 || z.ndim() != 1 || x.size() != y.size() || x.size() != z.size()) {
+        throw std::invalid_argument("x, y and z must be 1-D arrays of equal length");
+    }
+    size_t n = static_cast<size_t>(x.size());
+    std::vector<size_t> offsets;
+    std::vector<size_t> indexes;
+    {
+        py::gil_scoped_release release;
+        std::vector<UnitVector3d> points;
+        points.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            points.emplace_back(x.data()[i], y.data()[i], z.data()[i]);
+        }
+        self.containsWhich(points.data(), n, offsets, indexes);
+    }
+    py::array_t<uint64_t> o(static_cast<py::ssize_t>(offsets.size()));
+    py::array_t<uint64_t> r(static_cast<py::ssize_t>(indexes.size()));
+    std::copy(offsets.begin(), offsets.end(), o.mutable_data());
+    std::copy(indexes.begin(), indexes.end(), r.mutable_data());
+    return py::make_tuple(o, r);
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<RegionSet, std::unique_ptr<RegionSet>> &cls) {
+    cls.def(py::init([](py::sequence regions) {
+                return std::make_unique<RegionSet>(python::convert_region_sequence(regions));
+            }),
+            "regions"_a);
+
+    cls.def("__len__", &RegionSet::size);
+    cls.def("__getitem__", [](RegionSet const &self, py::int_ i) {
+        return self.getRegion(python::convertIndex(static_cast<ptrdiff_t>(self.size()), i)).clone();
+    });
+
+    cls.def("containsAny", py::overload_cast<UnitVector3d const &>(&RegionSet::containsAny, py::const_),
+            "unitVector"_a);
+    cls.def("containsAny",
+            py::vectorize((bool (RegionSet::*)(double, double, double) const) & RegionSet::containsAny),
+            "x"_a, "y"_a, "z"_a);
+    cls.def("containsAny",
+            py::vectorize((bool (RegionSet::*)(double, double) const) & RegionSet::containsAny),
+            "lon"_a, "lat"_a);
+    cls.def("containsWhich",
+            py::overload_cast<UnitVector3d const &>(&RegionSet::containsWhich, py::const_),
+            "unitVector"_a);
+    cls.def("containsWhich", &containsWhich, "x"_a, "y"_a, "z"_a);
+}
+
+}  // sphgeom
+}  // lsst
@@ -0,0 +1,54 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+
+#include <memory>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/RelateCache.h"
+
+#include "lsst/sphgeom/python/relationship.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+template <>
+void defineClass(py::class_<RelateCache, std::unique_ptr<RelateCache>> &cls) {
+    cls.def(py::init<size_t>(), "maxBytes"_a);
+    cls.def("relate",
+            [](RelateCache &self, Region const &a, Region const &b) {
+                py::gil_scoped_release release;
+                return self.relate(a, b);
+            },
+            "a"_a, "b"_a);
+    cls.def("clear", &RelateCache::clear);
+    cls.def("getMaxBytes", &RelateCache::getMaxBytes);
+    cls.def("getBytes", &RelateCache::getBytes);
+}
+
+}  // sphgeom
+}  // lsst
@@ -0,0 +1,86 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/spatialSort.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Sort points given by arrays of (not necessarily normalized) unit vector
+/// components, and return the permutation as an index array.
+template <typename Sort>
+py::array_t<py::ssize_t> spatialSortArray(DoubleArray x, DoubleArray y, DoubleArray z, Sort const &sort) {
+    if (x.ndim() != 1 || x.request().shape != y.request().shape || x.request().shape != z.request().shape) {
+        throw py::value_error("x, y and z must be 1-dimensional and have the same shape");
+    }
+    size_t n = static_cast<size_t>(x.size());
+    std::vector<size_t> permutation;
+    {
+        py::gil_scoped_release release;
+        permutation = sort(x.data(), y.data(), z.data(), n);
+    }
+    py::array_t<py::ssize_t> result(static_cast<py::ssize_t>(n));
+    py::ssize_t *out = result.mutable_data();
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = static_cast<py::ssize_t>(permutation[i]);
+    }
+    return result;
+}
+
+}  // <anonymous>
+
+void defineSpatialSort(py::module &mod) {
+    mod.def("spatialSort",
+            [](DoubleArray x, DoubleArray y, DoubleArray z, int level, unsigned numThreads) {
+                return spatialSortArray(x, y, z, [&](double const *xp, double const *yp, double const *zp,
+                                                     size_t n) {
+                    return spatialSort(xp, yp, zp, n, level, numThreads);
+                });
+            },
+            "x"_a, "y"_a, "z"_a, "level"_a, "numThreads"_a = 1);
+    mod.def("spatialSort",
+            [](Pixelization const &pixelization, DoubleArray x, DoubleArray y, DoubleArray z,
+               unsigned numThreads) {
+                return spatialSortArray(x, y, z, [&](double const *xp, double const *yp, double const *zp,
+                                                     size_t n) {
+                    return spatialSort(pixelization, xp, yp, zp, n, numThreads);
+                });
+            },
+            "pixelization"_a, "x"_a, "y"_a, "z"_a, "numThreads"_a = 1);
+}
+
+}  // sphgeom
+}  // lsst
@@ -27,22 +27,36 @@
 #include "lsst/sphgeom/AngleInterval.h"
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/ChunkPixelMap.h"
 #include "lsst/sphgeom/Chunker.h"
 #include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/CompoundRegion.h"
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/EnvelopeCache.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
 #include "lsst/sphgeom/HtmPixelization.h"
 #include "lsst/sphgeom/Interval1d.h"
 #include "lsst/sphgeom/LonLat.h"
 #include "lsst/sphgeom/Matrix3d.h"
 #include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/MultiLevelRangeSet.h"
 #include "lsst/sphgeom/NormalizedAngle.h"
 #include "lsst/sphgeom/NormalizedAngleInterval.h"
+#include "lsst/sphgeom/PixelCountMap.h"
+#include "lsst/sphgeom/PixelRegion.h"
 #include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/PointIndex.h"
+#include "lsst/sphgeom/PolygonMesh.h"
+#include "lsst/sphgeom/ProgressiveEnvelope.h"
 #include "lsst/sphgeom/Q3cPixelization.h"
 #include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/RangeSetIndex.h"
 #include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/RegionIndex.h"
+#include "lsst/sphgeom/RegionSet.h"
+#include "lsst/sphgeom/RelateCache.h"
+#include "lsst/sphgeom/TraversalStats.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 #include "lsst/sphgeom/Vector3d.h"
 
@@ -51,9 +65,15 @@ namespace py = pybind11;
 namespace lsst {
 namespace sphgeom {
 
+void defineArrow(py::module&);
+void defineBoxJoin(py::module&);
+void defineCrossMatch(py::module&);
 void defineCurve(py::module&);
+void defineMoc(py::module&);
 void defineOrientation(py::module&);
+void definePerformanceCounters(py::module&);
 void defineRelationship(py::module&);
+void defineSpatialSort(py::module&);
 void defineUtils(py::module&);
 
 namespace {
@@ -93,18 +113,42 @@ PYBIND11_MODULE(_sphgeom, mod) {
     py::class_<UnionRegion, std::unique_ptr<UnionRegion>, CompoundRegion> unionRegion(mod, "UnionRegion");
     py::class_<IntersectionRegion, std::unique_ptr<IntersectionRegion>, CompoundRegion>
             intersectionRegion(mod, "IntersectionRegion");
-
-    py::class_<RangeSet, std::shared_ptr<RangeSet>> rangeSet(mod, "RangeSet");
-
+    py::class_<PixelRegion, std::unique_ptr<PixelRegion>, Region> pixelRegion(
+            mod, "PixelRegion");
+    py::class_<RegionIndex, std::unique_ptr<RegionIndex>> regionIndex(mod, "RegionIndex");
+    py::class_<PolygonMesh, std::unique_ptr<PolygonMesh>> polygonMesh(mod, "PolygonMesh");
+    py::class_<RegionSet, std::unique_ptr<RegionSet>> regionSet(mod, "RegionSet");
+    py::class_<RelateCache, std::unique_ptr<RelateCache>> relateCache(mod, "RelateCache");
+
+    py::class_<RangeSet, std::shared_ptr<RangeSet>> rangeSet(mod, "RangeSet",
+                                                     py::buffer_protocol());
+    py::class_<MultiLevelRangeSet, std::shared_ptr<MultiLevelRangeSet>> multiLevelRangeSet(
+            mod, "MultiLevelRangeSet");
+    py::class_<RangeSetIndex, std::shared_ptr<RangeSetIndex>> rangeSetIndex(
+            mod, "RangeSetIndex");
+    py::class_<PixelCountMap, std::shared_ptr<PixelCountMap>> pixelCountMap(
+            mod, "PixelCountMap");
+
+    py::class_<ProgressiveEnvelope, std::unique_ptr<ProgressiveEnvelope>>
+            progressiveEnvelope(mod, "ProgressiveEnvelope");
     py::class_<Pixelization> pixelization(mod, "Pixelization");
+    py::class_<HealpixPixelization, Pixelization> healpixPixelization(
+            mod, "HealpixPixelization");
     py::class_<HtmPixelization, Pixelization> htmPixelization(
             mod, "HtmPixelization");
     py::class_<Mq3cPixelization, Pixelization> mq3cPixelization(
             mod, "Mq3cPixelization");
     py::class_<Q3cPixelization, Pixelization> q3cPixelization(
             mod, "Q3cPixelization");
+    py::class_<EnvelopeCache, std::unique_ptr<EnvelopeCache>> envelopeCache(
+            mod, "EnvelopeCache");
 
     py::class_<Chunker, std::shared_ptr<Chunker>> chunker(mod, "Chunker");
+    py::class_<ChunkPixelMap, std::shared_ptr<ChunkPixelMap>> chunkPixelMap(
+            mod, "ChunkPixelMap");
+    py::class_<PointIndex, std::unique_ptr<PointIndex>> pointIndex(mod, "PointIndex");
+    py::class_<TraversalStats, std::shared_ptr<TraversalStats>> traversalStats(
+            mod, "TraversalStats");
 
     defineClass(angle);
     defineClass(normalizedAngle);
@@ -127,21 +171,41 @@ PYBIND11_MODULE(_sphgeom, mod) {
     defineClass(compoundRegion);
     defineClass(unionRegion);
     defineClass(intersectionRegion);
+    defineClass(pixelRegion);
+    defineClass(regionIndex);
+    defineClass(polygonMesh);
+    defineClass(regionSet);
+    defineClass(relateCache);
 
     defineClass(rangeSet);
+    defineClass(multiLevelRangeSet);
+    defineClass(rangeSetIndex);
+    defineClass(pixelCountMap);
 
+    defineClass(progressiveEnvelope);
     defineClass(pixelization);
+    defineClass(healpixPixelization);
     defineClass(htmPixelization);
     defineClass(mq3cPixelization);
     defineClass(q3cPixelization);
+    defineClass(envelopeCache);
 
     defineClass(chunker);
+    defineClass(chunkPixelMap);
+    defineClass(pointIndex);
+    defineClass(traversalStats);
 
     // Define C++ functions.
 
+    defineArrow(mod);
+    defineBoxJoin(mod);
+    defineCrossMatch(mod);
     defineCurve(mod);
+    defineMoc(mod);
     defineOrientation(mod);
+    definePerformanceCounters(mod);
     defineRelationship(mod);
+    defineSpatialSort(mod);
     defineUtils(mod);
 }
 
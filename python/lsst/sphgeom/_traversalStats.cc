@@ -0,0 +1,97 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/python.h"
+
+#include "lsst/sphgeom/TraversalStats.h"
+
+namespace py = pybind11;
+using namespace pybind11::literals;
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+/// The scopes entered on the current thread by `with` statements, innermost
+/// last. Each one holds a reference to its sink so that the sink outlives it.
+using Scope = std::pair<std::shared_ptr<TraversalStats>,
+                        std::unique_ptr<TraversalStatsScope>>;
+thread_local std::vector<Scope> scopes;
+
+std::shared_ptr<TraversalStats> enter(std::shared_ptr<TraversalStats> self) {
+    scopes.emplace_back(self, std::make_unique<TraversalStatsScope>(*self));
+    return self;
+}
+
+void exit(TraversalStats const &self, py::args) {
+    if (scopes.empty() || scopes.back().first.get() != &self) {
+        throw py::value_error(
+                "TraversalStats contexts must be exited in the reverse "
+                "order they were entered, on the same thread");
+    }
+    scopes.pop_back();
+}
+
+}  // <anonymous>
+
+template <>
+void defineClass(py::class_<TraversalStats, std::shared_ptr<TraversalStats>> &cls) {
+    cls.attr("ENABLED") = py::bool_(TraversalStats::ENABLED);
+
+    cls.def(py::init<>());
+
+    cls.def_readonly("nodesVisited", &TraversalStats::nodesVisited);
+    cls.def_readonly("disjoint", &TraversalStats::disjoint);
+    cls.def_readonly("within", &TraversalStats::within);
+    cls.def_readonly("intersects", &TraversalStats::intersects);
+    cls.def_readonly("inserts", &TraversalStats::inserts);
+    cls.def_readonly("simplifications", &TraversalStats::simplifications);
+    cls.def_readonly("finalLevel", &TraversalStats::finalLevel);
+
+    cls.def("relates", &TraversalStats::relates);
+    cls.def("clear", &TraversalStats::clear);
+    cls.def("merge",
+            [](TraversalStats &self, TraversalStats const &stats) { self.merge(stats); },
+            "stats"_a);
+
+    cls.def("__enter__", &enter);
+    cls.def("__exit__", &exit);
+
+    cls.def("__repr__", [](TraversalStats const &self) {
+        return py::str("TraversalStats(nodesVisited={!r}, disjoint={!r}, "
+                       "within={!r}, intersects={!r}, inserts={!r}, "
+                       "simplifications={!r}, finalLevel={!r})")
+                .format(self.nodesVisited, self.disjoint, self.within,
+                        self.intersects, self.inserts, self.simplifications,
+                        self.finalLevel);
+    });
+}
+
+}  // sphgeom
+}  // lsst
@@ -20,6 +20,9 @@
  * see <https://www.lsstcorp.org/LegalNotices/>.
  */
 #include "pybind11/pybind11.h"
+#include "pybind11/numpy.h"
+
+#include <vector>
 
 #include "lsst/sphgeom/python.h"
 
@@ -27,6 +30,7 @@
 #include "lsst/sphgeom/LonLat.h"
 #include "lsst/sphgeom/Vector3d.h"
 #include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
 #include "lsst/sphgeom/python/utils.h"
 
 namespace py = pybind11;
@@ -35,6 +39,86 @@ using namespace pybind11::literals;
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using DoubleArray = py::array_t<double, py::array::c_style | py::array::forcecast>;
+
+/// Convert arrays of longitudes and latitudes having the same shape S to
+/// an array of unit vectors with shape S + (3,). Unless `fast` is true, the
+/// vectors are identical to `UnitVector3d(LonLat(lon, lat))`; otherwise
+/// sines and cosines are evaluated with the vectorized approximation used
+/// by `UnitVector3dArray::fromLonLat`, and components may differ by a few
+/// units in the last place.
+DoubleArray fromLonLatArrays(DoubleArray lon, DoubleArray lat, bool degrees, bool fast) {
+    if (lon.request().shape != lat.request().shape) {
+        throw py::value_error("lon and lat must have the same shape");
+    }
+    std::vector<py::ssize_t> shape = lon.request().shape;
+    shape.push_back(3);
+    DoubleArray result(shape);
+    size_t n = static_cast<size_t>(lon.size());
+    double const *lonp = lon.data();
+    double const *latp = lat.data();
+    double *out = result.mutable_data();
+    {
+        py::gil_scoped_release release;
+        if (fast) {
+            std::vector<double> r;
+            if (degrees) {
+                r.resize(2 * n);
+                for (size_t i = 0; i < n; ++i) {
+                    r[i] = lonp[i] * RAD_PER_DEG;
+                    r[n + i] = latp[i] * RAD_PER_DEG;
+                }
+                lonp = r.data();
+                latp = r.data() + n;
+            }
+            UnitVector3dArray a = UnitVector3dArray::fromLonLat(lonp, latp, n);
+            for (size_t i = 0; i < n; ++i) {
+                out[3 * i] = a.x()[i];
+                out[3 * i + 1] = a.y()[i];
+                out[3 * i + 2] = a.z()[i];
+            }
+        } else {
+            for (size_t i = 0; i < n; ++i) {
+                UnitVector3d v(degrees ? LonLat::fromDegrees(lonp[i], latp[i])
+                                       : LonLat::fromRadians(lonp[i], latp[i]));
+                out[3 * i] = v.x();
+                out[3 * i + 1] = v.y();
+                out[3 * i + 2] = v.z();
+            }
+        }
+    }
+    return result;
+}
+
+/// Convert an array of (not necessarily normalized) vectors with shape
+/// S + (3,) to a tuple of longitude and latitude arrays with shape S. The
+/// results are identical to those of `LonLat(Vector3d(x, y, z))`.
+py::tuple toLonLatArrays(DoubleArray vectors, bool degrees) {
+    std::vector<py::ssize_t> shape = vectors.request().shape;
+    if (shape.empty() || shape.back() != 3) {
+        throw py::value_error("vectors must have shape (..., 3)");
+    }
+    shape.pop_back();
+    DoubleArray lon(shape), lat(shape);
+    size_t n = static_cast<size_t>(lon.size());
+    double const *in = vectors.data();
+    double *lonp = lon.mutable_data();
+    double *latp = lat.mutable_data();
+    {
+        py::gil_scoped_release release;
+        for (size_t i = 0; i < n; ++i) {
+            LonLat p(Vector3d(in[3 * i], in[3 * i + 1], in[3 * i + 2]));
+            lonp[i] = degrees ? p.getLon().asDegrees() : p.getLon().asRadians();
+            latp[i] = degrees ? p.getLat().asDegrees() : p.getLat().asRadians();
+        }
+    }
+    return py::make_tuple(lon, lat);
+}
+
+}  // <anonymous>
+
 template <>
 void defineClass(py::class_<UnitVector3d, std::shared_ptr<UnitVector3d>> &cls) {
     // Provide the equivalent of the UnitVector3d to Vector3d C++ cast
@@ -54,6 +138,10 @@ void defineClass(py::class_<UnitVector3d, std::shared_ptr<UnitVector3d>> &cls) {
                            UnitVector3d::orthogonalTo,
                    "meridian"_a);
     cls.def_static("northFrom", &UnitVector3d::northFrom, "vector"_a);
+    cls.def_static("fromLonLatArrays", &fromLonLatArrays, "lon"_a, "lat"_a,
+                   "degrees"_a = true, "fast"_a = false);
+    cls.def_static("toLonLatArrays", &toLonLatArrays, "vectors"_a,
+                   "degrees"_a = true);
     cls.def_static("X", &UnitVector3d::X);
     cls.def_static("Y", &UnitVector3d::Y);
     cls.def_static("Z", &UnitVector3d::Z);
@@ -24,6 +24,10 @@
 #include "lsst/sphgeom/python.h"
 
 #include "lsst/sphgeom/Angle.h"
+#include "lsst/sphgeom/area.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Executor.h"
+#include "lsst/sphgeom/Region.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 #include "lsst/sphgeom/utils.h"
 #include "lsst/sphgeom/Vector3d.h"
@@ -43,6 +47,9 @@ void defineUtils(py::module &mod) {
     mod.def("getMaxAngleToCircle", &getMaxAngleToCircle, "x"_a, "c"_a);
     mod.def("getWeightedCentroid", &getWeightedCentroid, "vector0"_a,
             "vector1"_a, "vector2"_a);
+    mod.def("overlapArea", &overlapArea, "polygon"_a, "region"_a);
+    mod.def("getMaxThreads", &getMaxThreads);
+    mod.def("setMaxThreads", &setMaxThreads, "n"_a);
 }
 
 }  // sphgeom
@@ -31,15 +31,16 @@ try:
 except ImportError:
     yaml = None
 
-from ._healpixPixelization import HealpixPixelization
 from ._sphgeom import (
     Box,
     Circle,
     ConvexPolygon,
     Ellipse,
+    HealpixPixelization,
     HtmPixelization,
     IntersectionRegion,
     Mq3cPixelization,
+    PixelRegion,
     Q3cPixelization,
     Region,
     UnionRegion,
@@ -81,7 +82,15 @@ def region_constructor(loader, node):
 
 # Register all the region classes with the same constructor and representer
 if yaml:
-    for region_class in (ConvexPolygon, Ellipse, Circle, Box, UnionRegion, IntersectionRegion):
+    for region_class in (
+        ConvexPolygon,
+        Ellipse,
+        Circle,
+        Box,
+        UnionRegion,
+        IntersectionRegion,
+        PixelRegion,
+    ):
         yaml.add_representer(region_class, region_representer)
 
         for loader in YamlLoaders:
@@ -94,10 +103,13 @@ if yaml:
 def pixel_representer(dumper, data):
     """Represent a pixelization in YAML.
 
-    Stored as the pixelization level in a mapping with a single key
-    ``level``.
+    Stored as the pixelization level in a mapping with key ``level``.
+    Hilbert ordered Q3C pixelizations also have a ``hilbertOrder`` key.
     """
-    return dumper.represent_mapping(f"lsst.sphgeom.{type(data).__name__}", {"level": data.getLevel()})
+    mapping = {"level": data.getLevel()}
+    if isinstance(data, Q3cPixelization) and data.isHilbertOrder():
+        mapping["hilbertOrder"] = True
+    return dumper.represent_mapping(f"lsst.sphgeom.{type(data).__name__}", mapping)
 
 
 def pixel_constructor(loader, node):
@@ -117,6 +129,8 @@ def pixel_constructor(loader, node):
             f"Encountered unexpected class {className} associated with sphgeom pixelization YAML constructor"
         )
 
+    if mapping.get("hilbertOrder", False):
+        return pixelMap[className](mapping["level"], hilbertOrder=True)
     return pixelMap[className](mapping["level"])
 
 
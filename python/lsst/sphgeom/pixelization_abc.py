@@ -22,6 +22,8 @@ __all__ = ["PixelizationABC"]
 
 import abc
 
+import numpy as np
+
 from ._sphgeom import RangeSet, Region, UnitVector3d
 
 
@@ -141,3 +143,91 @@ class PixelizationABC(abc.ABC):
         rangeSet : `lsst.sphgeom.RangeSet`
         """
         pass
+
+    def indexArray(self, x, y, z, numThreads: int = 1) -> np.ndarray:
+        """Compute the indexes of the pixels containing many points.
+
+        The default implementation calls `index` for each point. The
+        pixelizations implemented in C++ provide a native implementation.
+
+        Parameters
+        ----------
+        x, y, z : `numpy.ndarray`
+            The (not necessarily normalized) components of the points, all
+            having the same shape.
+        numThreads : `int`
+            The maximum number of threads to use. Implementations may
+            ignore it.
+
+        Returns
+        -------
+        indexes : `numpy.ndarray`
+            The pixel indexes, as an array of `numpy.uint64` with the shape
+            of the inputs.
+        """
+        x, y, z = (np.asarray(a, dtype=np.float64) for a in (x, y, z))
+        if x.shape != y.shape or x.shape != z.shape:
+            raise ValueError("x, y and z must have the same shape")
+        result = np.fromiter(
+            (self.index(UnitVector3d(*v)) for v in zip(x.ravel(), y.ravel(), z.ravel())),
+            dtype=np.uint64,
+            count=x.size,
+        )
+        return result.reshape(x.shape)
+
+    def pixels(self, indexes) -> list[Region]:
+        """Return the spherical regions of many pixels.
+
+        The default implementation calls `pixel` for each index.
+
+        Parameters
+        ----------
+        indexes : iterable of `int`
+            Pixel indexes.
+
+        Returns
+        -------
+        regions : `list` [`lsst.sphgeom.Region`]
+            The regions of the pixels, in the order of ``indexes``.
+        """
+        return [self.pixel(int(i)) for i in indexes]
+
+    def envelopeMany(self, regions, maxRanges: int = 0, numThreads: int = 1) -> list[RangeSet]:
+        """Return the envelopes of many regions.
+
+        The default implementation calls `envelope` for each region.
+
+        Parameters
+        ----------
+        regions : iterable of `lsst.sphgeom.Region`
+        maxRanges : `int`
+            See `envelope`.
+        numThreads : `int`
+            The maximum number of threads to use. Implementations may
+            ignore it.
+
+        Returns
+        -------
+        rangeSets : `list` [`lsst.sphgeom.RangeSet`]
+        """
+        return [self.envelope(r, maxRanges) for r in regions]
+
+    def interiorMany(self, regions, maxRanges: int = 0, numThreads: int = 1) -> list[RangeSet]:
+        """Return the interiors of many regions.
+
+        The default implementation calls `interior` for each region.
+
+        Parameters
+        ----------
+        regions : iterable of `lsst.sphgeom.Region`
+        maxRanges : `int`
+            See `interior`.
+        numThreads : `int`
+            The maximum number of threads to use. Implementations may
+            ignore it.
+
+        Returns
+        -------
+        rangeSets : `list` [`lsst.sphgeom.RangeSet`]
+        """
+        return [self.interior(r, maxRanges) for r in regions]
@@ -25,6 +25,7 @@
 
 #include "lsst/sphgeom/Box.h"
 
+#include <algorithm>
 #include <cmath>
 #include <ostream>
 #include <stdexcept>
@@ -33,9 +34,13 @@
 #include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
 #include "lsst/sphgeom/codec.h"
 #include "lsst/sphgeom/utils.h"
 
+#include "PerformanceCounting.h"
+#include "PreparedBox.h"
+
 
 namespace lsst {
 namespace sphgeom {
@@ -124,6 +129,58 @@ double Box::getArea() const {
     return std::fabs(_lon.getSize().asRadians() * dz);
 }
 
+void Box::contains(double const * x,
+                   double const * y,
+                   double const * z,
+                   bool * out,
+                   size_t n) const
+{
+    static constexpr size_t BLOCK_SIZE = 256;
+    double u[3][BLOCK_SIZE];
+    detail::PreparedBox const box(*this);
+    for (size_t begin = 0; begin < n; begin += BLOCK_SIZE) {
+        size_t const m = std::min(BLOCK_SIZE, n - begin);
+        UnitVector3dArray::normalize(x + begin, y + begin, z + begin,
+                                     u[0], u[1], u[2], m);
+        for (size_t i = 0; i < m; ++i) {
+            UnitVector3d v = UnitVector3d::fromNormalized(u[0][i], u[1][i], u[2][i]);
+            int c = box.classify(v);
+            out[begin + i] = (c != 0) ? c > 0 : contains(LonLat(v));
+        }
+    }
+}
+
+void Box::sample(size_t n, std::mt19937_64 & rng,
+                 double * x, double * y, double * z) const
+{
+    // Candidates outside the box due to rounding are redrawn this many
+    // times before being accepted anyway.
+    static constexpr int MAX_ATTEMPTS = 64;
+    if (isEmpty()) {
+        throw std::invalid_argument("Cannot sample an empty box");
+    }
+    // Area is uniform in longitude and in the sine of latitude.
+    double const lon = _lon.getA().asRadians();
+    double const width = _lon.getSize().asRadians();
+    double const za = sin(_lat.getA());
+    double const dz = sin(_lat.getB()) - za;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d v;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+            double z = std::max(-1.0, std::min(1.0, za + dz * uniform(rng)));
+            v = UnitVector3d(LonLat::fromRadians(lon + width * uniform(rng),
+                                                 std::asin(z)));
+            if (contains(v)) {
+                break;
+            }
+        }
+        x[i] = v.x();
+        y[i] = v.y();
+        z[i] = v.z();
+    }
+}
+
 Box3d Box::getBoundingBox3d() const {
     if (isEmpty()) {
         return Box3d();
@@ -316,122 +373,8 @@ Circle Box::getBoundingCircle() const {
 }
 
 Relationship Box::relate(Circle const & c) const {
-    if (isEmpty()) {
-        if (c.isEmpty()) {
-            return CONTAINS | DISJOINT | WITHIN;
-        }
-        return DISJOINT | WITHIN;
-    } else if (c.isEmpty()) {
-        return CONTAINS | DISJOINT;
-    }
-    if (isFull()) {
-        if (c.isFull()) {
-            return CONTAINS | WITHIN;
-        }
-        return CONTAINS;
-    } else if (c.isFull()) {
-        return WITHIN;
-    }
-    // Neither region is empty or full. We now determine whether or not the
-    // circle and box boundaries intersect.
-    //
-    // If the box vertices are not all inside or all outside of c, then the
-    // boundaries cross.
-    LonLat vertLonLat[4] = {
-        LonLat(_lon.getA(), _lat.getA()),
-        LonLat(_lon.getA(), _lat.getB()),
-        LonLat(_lon.getB(), _lat.getA()),
-        LonLat(_lon.getB(), _lat.getB())
-    };
-    UnitVector3d verts[4];
-    bool inside = false;
-    for (int i = 0; i < 4; ++i) {
-        verts[i] = UnitVector3d(vertLonLat[i]);
-        double d = (verts[i] - c.getCenter()).getSquaredNorm();
-        if (std::fabs(d - c.getSquaredChordLength()) <
-            MAX_SQUARED_CHORD_LENGTH_ERROR) {
-            // A box vertex is close to the circle boundary.
-            return INTERSECTS;
-        }
-        bool b = d < c.getSquaredChordLength();
-        if (i == 0) {
-            inside = b;
-        } else if (inside != b) {
-            // There are box vertices both inside and outside of c.
-            return INTERSECTS;
-        }
-    }
-    UnitVector3d norms[2] = {
-        UnitVector3d::orthogonalTo(_lon.getA()),
-        UnitVector3d::orthogonalTo(_lon.getB())
-    };
-    if (inside) {
-        // All box vertices are inside c. Look for points in the box edge
-        // interiors that are outside c.
-        for (int i = 0; i < 2; ++i) {
-            double d = getMaxSquaredChordLength(
-                c.getCenter(), verts[2 * i + 1], verts[2 * i], norms[i]);
-            if (d > c.getSquaredChordLength() -
-                    MAX_SQUARED_CHORD_LENGTH_ERROR) {
-                return INTERSECTS;
-            }
-        }
-        LonLat cc(-c.getCenter());
-        if (_lon.contains(cc.getLon())) {
-            // The points furthest from the center of c on the small circles
-            // defined by the box edges with constant latitude are in the box
-            // edge interiors. Find the largest squared chord length to either.
-            Angle a = std::min(getMinAngleToCircle(cc.getLat(), _lat.getA()),
-                               getMinAngleToCircle(cc.getLat(), _lat.getB()));
-            double d = Circle::squaredChordLengthFor(Angle(PI) - a);
-            if (d > c.getSquaredChordLength() -
-                    MAX_SQUARED_CHORD_LENGTH_ERROR) {
-                return INTERSECTS;
-            }
-        }
-        // The box boundary is completely inside c. However, the box is not
-        // necessarily within c: consider a circle with opening angle equal to
-        // π - ε. If a box contains the complement of such a circle, then
-        // intersecting it with that circle will punch a hole in the box. In
-        // this case each region contains the boundary of the other, but
-        // neither region contains the other.
-        //
-        // To handle this case, check that the box does not contain the
-        // complement of c - since the boundaries do not intersect, this is the
-        // case iff the box contains the center of the complement of c.
-        if (contains(cc)) {
-            return INTERSECTS;
-        }
-        return WITHIN;
-    }
-    // All box vertices are outside c. Look for points in the box edge
-    // interiors that are inside c.
-    for (int i = 0; i < 2; ++i) {
-        double d = getMinSquaredChordLength(
-            c.getCenter(), verts[2 * i + 1], verts[2 * i], norms[i]);
-        if (d < c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR) {
-            return INTERSECTS;
-        }
-    }
-    LonLat cc(c.getCenter());
-    if (_lon.contains(cc.getLon())) {
-        // The points closest to the center of c on the small circles
-        // defined by the box edges with constant latitude are in the box
-        // edge interiors. Find the smallest squared chord length to either.
-        Angle a = std::min(getMinAngleToCircle(cc.getLat(), _lat.getA()),
-                           getMinAngleToCircle(cc.getLat(), _lat.getB()));
-        double d = Circle::squaredChordLengthFor(a);
-        if (d < c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR) {
-            return INTERSECTS;
-        }
-    }
-    // The box boundary is completely outside of c. If the box contains the
-    // circle center, then the box contains c. Otherwise, the box and circle
-    // are disjoint.
-    if (contains(cc)) {
-        return CONTAINS;
-    }
-    return DISJOINT;
+    detail::count(PerformanceCounter::RELATE_BOX_CIRCLE);
+    return detail::PreparedBox(*this).relate(c);
 }
 
 Relationship Box::relate(ConvexPolygon const & p) const {
@@ -446,30 +389,38 @@ Relationship Box::relate(Ellipse const & e) const {
 
 std::vector<uint8_t> Box::encode() const {
     std::vector<uint8_t> buffer;
-    uint8_t tc = TYPE_CODE;
     buffer.reserve(ENCODED_SIZE);
+    encodeTo(buffer);
+    return buffer;
+}
+
+void Box::encodeTo(std::vector<uint8_t> & buffer) const {
+    uint8_t tc = TYPE_CODE;
     buffer.push_back(tc);
     encodeDouble(_lon.getA().asRadians(), buffer);
     encodeDouble(_lon.getB().asRadians(), buffer);
     encodeDouble(_lat.getA().asRadians(), buffer);
     encodeDouble(_lat.getB().asRadians(), buffer);
-    return buffer;
 }
 
 std::unique_ptr<Box> Box::decode(uint8_t const * buffer, size_t n) {
+    std::unique_ptr<Box> box(new Box);
+    box->_decode(buffer, n);
+    return box;
+}
+
+void Box::_decode(uint8_t const * buffer, size_t n) {
     if (buffer == nullptr || n != ENCODED_SIZE || *buffer != TYPE_CODE) {
         throw std::runtime_error("Byte-string is not an encoded Box");
     }
-    std::unique_ptr<Box> box(new Box);
     ++buffer;
     double a = decodeDouble(buffer); buffer += 8;
     double b = decodeDouble(buffer); buffer += 8;
-    box->_lon = NormalizedAngleInterval::fromRadians(a, b);
+    _lon = NormalizedAngleInterval::fromRadians(a, b);
     a = decodeDouble(buffer); buffer += 8;
     b = decodeDouble(buffer); buffer += 8;
-    box->_lat = AngleInterval::fromRadians(a, b);
-    box->_enforceInvariants();
-    return box;
+    _lat = AngleInterval::fromRadians(a, b);
+    _enforceInvariants();
 }
 
 std::ostream & operator<<(std::ostream & os, Box const & b) {
@@ -0,0 +1,192 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_BOXTREE_H_
+#define LSST_SPHGEOM_BOXTREE_H_
+
+/// \file
+/// \brief This file contains a bounding volume hierarchy over 3-D boxes.
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/Vector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+/// A `BoxTree` is an immutable bounding volume hierarchy over a sequence
+/// of 3-D boxes. It finds the boxes containing a point, or intersecting a
+/// box, without visiting every box.
+///
+/// The tree is built top-down by splitting at the median box center along
+/// the axis over which the centers are most spread out, so its depth is
+/// logarithmic in the number of boxes. Nodes are stored in depth first
+/// order in a single array.
+class BoxTree {
+public:
+    BoxTree() = default;
+
+    /// This constructor creates a tree over the given boxes. Empty boxes
+    /// are left out of the tree, and are never reported by searches.
+    explicit BoxTree(std::vector<Box3d> const & boxes) {
+        if (boxes.size() > std::numeric_limits<uint32_t>::max()) {
+            throw std::invalid_argument("Too many boxes for a BoxTree");
+        }
+        std::vector<Vector3d> centers;
+        _order.reserve(boxes.size());
+        _boxes.reserve(boxes.size());
+        centers.reserve(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].isEmpty()) {
+                continue;
+            }
+            _order.push_back(static_cast<uint32_t>(i));
+            _boxes.push_back(boxes[i]);
+            centers.push_back(boxes[i].getCenter());
+        }
+        if (!_order.empty()) {
+            _nodes.reserve(2 * (_order.size() / MAX_LEAF_SIZE + 1));
+            _build(0, static_cast<uint32_t>(_order.size()), centers);
+        }
+    }
+
+    /// `findContaining` calls `f(i)` for the index i of every box
+    /// containing v, stopping early if `f` returns true.
+    template <typename F>
+    void findContaining(Vector3d const & v, F f) const {
+        _find([&v](Box3d const & b) { return b.contains(v); }, f);
+    }
+
+    /// `findIntersecting` calls `f(i)` for the index i of every box
+    /// intersecting b, stopping early if `f` returns true.
+    template <typename F>
+    void findIntersecting(Box3d const & b, F f) const {
+        _find([&b](Box3d const & c) { return c.intersects(b); }, f);
+    }
+
+private:
+    // Leaves refer to the boxes with positions [begin, end) in _order.
+    // The first child of an interior node immediately follows it.
+    struct Node {
+        Box3d box;
+        uint32_t begin;
+        uint32_t end;
+        uint32_t second;  // Index of the second child, or 0 for a leaf.
+    };
+
+    static constexpr uint32_t MAX_LEAF_SIZE = 4;
+
+    std::vector<Node> _nodes;
+    // Box indexes in leaf order, and the corresponding boxes.
+    std::vector<uint32_t> _order;
+    std::vector<Box3d> _boxes;
+
+    uint32_t _build(uint32_t begin, uint32_t end,
+                    std::vector<Vector3d> & centers) {
+        uint32_t n = static_cast<uint32_t>(_nodes.size());
+        _nodes.push_back(Node{Box3d(), begin, end, 0});
+        Box3d box;
+        Box3d centerBox;
+        for (uint32_t i = begin; i < end; ++i) {
+            box.expandTo(_boxes[i]);
+            centerBox.expandTo(centers[i]);
+        }
+        _nodes[n].box = box;
+        if (end - begin <= MAX_LEAF_SIZE) {
+            return n;
+        }
+        int axis = 0;
+        double extent = centerBox.x().getSize();
+        if (centerBox.y().getSize() > extent) {
+            axis = 1;
+            extent = centerBox.y().getSize();
+        }
+        if (centerBox.z().getSize() > extent) {
+            axis = 2;
+        }
+        // Partition positions [begin, end) around the median center, then
+        // apply the permutation to _order, _boxes and centers together.
+        uint32_t const size = end - begin;
+        uint32_t const mid = begin + size / 2;
+        std::vector<uint32_t> perm(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            perm[i] = begin + i;
+        }
+        std::nth_element(perm.begin(), perm.begin() + (mid - begin), perm.end(),
+                         [&centers, axis](uint32_t a, uint32_t b) {
+                             return centers[a](axis) < centers[b](axis);
+                         });
+        std::vector<uint32_t> order(size);
+        std::vector<Box3d> boxes(size);
+        std::vector<Vector3d> cs(size);
+        for (uint32_t i = 0; i < size; ++i) {
+            order[i] = _order[perm[i]];
+            boxes[i] = _boxes[perm[i]];
+            cs[i] = centers[perm[i]];
+        }
+        std::copy(order.begin(), order.end(), _order.begin() + begin);
+        std::copy(boxes.begin(), boxes.end(), _boxes.begin() + begin);
+        std::copy(cs.begin(), cs.end(), centers.begin() + begin);
+        _build(begin, mid, centers);
+        _nodes[n].second = _build(mid, end, centers);
+        return n;
+    }
+
+    template <typename Overlaps, typename F>
+    void _find(Overlaps overlaps, F f) const {
+        if (_nodes.empty()) {
+            return;
+        }
+        // The tree depth is at most 32, so a fixed size stack suffices.
+        uint32_t stack[64];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            uint32_t n = stack[--top];
+            Node const & node = _nodes[n];
+            if (!overlaps(node.box)) {
+                continue;
+            }
+            if (node.second == 0) {
+                for (uint32_t i = node.begin; i < node.end; ++i) {
+                    if (overlaps(_boxes[i]) && f(_order[i])) {
+                        return;
+                    }
+                }
+                continue;
+            }
+            stack[top++] = node.second;
+            stack[top++] = n + 1;
+        }
+    }
+};
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_BOXTREE_H_
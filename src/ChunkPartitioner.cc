@@ -0,0 +1,200 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the ChunkPartitioner class implementation.
+
+#include "lsst/sphgeom/ChunkPartitioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Chunk buffers are spread over this many independently locked shards, so
+// that threads scattering rows to different chunks rarely contend.
+constexpr size_t NUM_SHARDS = 64;
+
+size_t shardOf(int32_t chunkId) {
+    return static_cast<uint32_t>(chunkId) % NUM_SHARDS;
+}
+
+} // unnamed namespace
+
+struct ChunkPartitioner::Shard {
+    std::mutex mutex;
+    std::unordered_map<int32_t, ChunkRows> buffers;
+};
+
+ChunkPartitioner::ChunkPartitioner(Chunker const & chunker,
+                                   Angle overlap,
+                                   ChunkSink & sink,
+                                   size_t maxChunkBytes) :
+    _chunker{chunker},
+    _overlap{overlap},
+    _sink{&sink},
+    _maxChunkBytes{maxChunkBytes},
+    _shards{new Shard[NUM_SHARDS]}
+{
+    if (!(overlap.asRadians() >= 0.0) || !std::isfinite(overlap.asRadians())) {
+        throw std::invalid_argument("The overlap must be finite and "
+                                    "non-negative");
+    }
+}
+
+ChunkPartitioner::~ChunkPartitioner() = default;
+
+void ChunkPartitioner::add(CatalogBatch const & batch) {
+    if (batch.lat.size() != batch.size() ||
+        batch.offsets.size() != batch.size() + 1 ||
+        batch.offsets.back() > batch.payload.size()) {
+        throw std::invalid_argument("Inconsistent catalog batch sizes");
+    }
+    add(batch.lon.data(), batch.lat.data(), batch.offsets.data(),
+        batch.payload.data(), batch.size());
+}
+
+void ChunkPartitioner::add(double const * lon,
+                           double const * lat,
+                           uint64_t const * offsets,
+                           uint8_t const * payload,
+                           size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (offsets[i + 1] < offsets[i]) {
+            throw std::invalid_argument(
+                "Payload offsets must be non-decreasing");
+        }
+    }
+    ChunkLocations locations;
+    locations.reserve(n + n / 4);
+    _chunker.locateWithOverlap(lon, lat, n, _overlap, locations);
+    // Group the locations by shard with a counting sort, which preserves
+    // their order within each shard.
+    size_t const m = locations.size();
+    std::vector<size_t> start(NUM_SHARDS + 1, 0);
+    for (size_t i = 0; i < m; ++i) {
+        ++start[shardOf(locations.chunkId[i]) + 1];
+    }
+    for (size_t s = 0; s < NUM_SHARDS; ++s) {
+        start[s + 1] += start[s];
+    }
+    std::vector<size_t> order(m);
+    {
+        std::vector<size_t> next(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < m; ++i) {
+            order[next[shardOf(locations.chunkId[i])]++] = i;
+        }
+    }
+    for (size_t s = 0; s < NUM_SHARDS; ++s) {
+        if (start[s] == start[s + 1]) {
+            continue;
+        }
+        Shard & shard = _shards[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (size_t j = start[s]; j < start[s + 1]; ++j) {
+            size_t const i = order[j];
+            int32_t const chunkId = locations.chunkId[i];
+            size_t const p = locations.pointIndex[i];
+            ChunkRows & rows = shard.buffers[chunkId];
+            rows.subChunkId.push_back(locations.subChunkId[i]);
+            rows.isOverlap.push_back(locations.isOverlap[i]);
+            rows.payload.insert(rows.payload.end(), payload + offsets[p],
+                                payload + offsets[p + 1]);
+            rows.offsets.push_back(rows.payload.size());
+            if (rows.bytes() >= _maxChunkBytes) {
+                _sink->write(chunkId, rows);
+                rows.clear();
+            }
+        }
+    }
+    _numRows += n;
+    _numLocations += m;
+}
+
+void ChunkPartitioner::run(std::function<bool(CatalogBatch &)> const & source,
+                           unsigned numThreads)
+{
+    std::mutex sourceMutex;
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    std::atomic<bool> stop{false};
+    auto work = [&]() {
+        CatalogBatch batch;
+        try {
+            while (!stop) {
+                {
+                    std::lock_guard<std::mutex> lock(sourceMutex);
+                    if (stop) {
+                        break;
+                    }
+                    if (!source(batch)) {
+                        stop = true;
+                        break;
+                    }
+                }
+                add(batch);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            stop = true;
+        }
+    };
+    detail::runInParallel(numThreads, work);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ChunkPartitioner::flush() {
+    for (size_t s = 0; s < NUM_SHARDS; ++s) {
+        Shard & shard = _shards[s];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        std::vector<int32_t> chunkIds;
+        for (auto const & b: shard.buffers) {
+            if (!b.second.empty()) {
+                chunkIds.push_back(b.first);
+            }
+        }
+        std::sort(chunkIds.begin(), chunkIds.end());
+        for (int32_t chunkId: chunkIds) {
+            ChunkRows & rows = shard.buffers[chunkId];
+            _sink->write(chunkId, rows);
+            rows.clear();
+        }
+    }
+}
+
+}} // namespace lsst::sphgeom
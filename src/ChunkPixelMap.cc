@@ -0,0 +1,246 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+/// \file
+/// \brief This file contains the ChunkPixelMap implementation.
+
+#include "lsst/sphgeom/ChunkPixelMap.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Pixelization.h"
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The number of chunks pixelized by each thread at a time.
+constexpr size_t BLOCK_SIZE = 16;
+
+// The number of segments, or of blocks at the level below, in a block.
+constexpr size_t FAN_OUT = 16;
+
+// An `Endpoint` is the beginning or end of a range of pixels in the
+// envelope of a chunk.
+struct Endpoint {
+    uint64_t pixel;
+    uint32_t chunk;
+    bool begin;
+};
+
+} // unnamed namespace
+
+ChunkPixelMap::ChunkPixelMap(Chunker const & chunker,
+                             Pixelization const & pixelization,
+                             unsigned numThreads) :
+    _chunker(chunker),
+    _chunkIds(chunker.getAllChunks()),
+    _envelopes(_chunkIds.size()),
+    _interiors(_chunkIds.size())
+{
+    size_t const n = _chunkIds.size();
+    detail::forEachBlock(n, BLOCK_SIZE, numThreads,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                int32_t stripe = _chunker.getStripe(_chunkIds[i]);
+                Box box = _chunker.getChunkBoundingBox(
+                    stripe, _chunker.getChunk(_chunkIds[i], stripe));
+                EnvelopeAndInterior e = pixelization.envelopeAndInterior(box);
+                _envelopes[i] = std::move(e.envelope);
+                _interiors[i] = std::move(e.interior);
+            }
+        });
+    // Build the reverse table by sweeping through the range endpoints of
+    // all chunk envelopes in ascending order, starting a segment at each
+    // distinct endpoint. An end of 0 stands for 2^64, and is never reached.
+    std::vector<Endpoint> endpoints;
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t chunk = static_cast<uint32_t>(i);
+        for (auto const & r: _envelopes[i]) {
+            endpoints.push_back(Endpoint{std::get<0>(r), chunk, true});
+            if (std::get<1>(r) != 0) {
+                endpoints.push_back(Endpoint{std::get<1>(r), chunk, false});
+            }
+        }
+    }
+    std::sort(endpoints.begin(), endpoints.end(),
+              [](Endpoint const & a, Endpoint const & b) {
+                  return a.pixel < b.pixel;
+              });
+    // The indexes of the chunks overlapping the current segment.
+    std::vector<uint32_t> active;
+    for (size_t e = 0; e < endpoints.size();) {
+        uint64_t const pixel = endpoints[e].pixel;
+        for (; e < endpoints.size() && endpoints[e].pixel == pixel; ++e) {
+            uint32_t chunk = endpoints[e].chunk;
+            auto i = std::lower_bound(active.begin(), active.end(), chunk);
+            if (endpoints[e].begin) {
+                active.insert(i, chunk);
+            } else {
+                active.erase(i);
+            }
+        }
+        _segmentBegins.push_back(pixel);
+        _segments.chunks.insert(_segments.chunks.end(),
+                                active.begin(), active.end());
+        _segments.offsets.push_back(_segments.chunks.size());
+    }
+    // Summarize each level of blocks from the level below it.
+    for (ChunkLists const * below = &_segments; below->size() > FAN_OUT;
+         below = &_blocks.back()) {
+        ChunkLists level;
+        for (size_t b = 0; b < below->size(); b += FAN_OUT) {
+            size_t const begin = level.chunks.size();
+            for (size_t i = b; i < std::min(b + FAN_OUT, below->size()); ++i) {
+                below->appendTo(level.chunks, i);
+            }
+            std::sort(level.chunks.begin() + begin, level.chunks.end());
+            level.chunks.erase(
+                std::unique(level.chunks.begin() + begin, level.chunks.end()),
+                level.chunks.end());
+            level.offsets.push_back(level.chunks.size());
+        }
+        _blocks.push_back(std::move(level));
+    }
+}
+
+std::vector<int32_t> ChunkPixelMap::getChunks(uint64_t pixel) const {
+    std::vector<int32_t> chunkIds;
+    size_t s = static_cast<size_t>(
+        std::upper_bound(_segmentBegins.begin(), _segmentBegins.end(),
+                         pixel) - _segmentBegins.begin());
+    if (s == 0) {
+        return chunkIds;
+    }
+    std::vector<uint32_t> chunks;
+    _segments.appendTo(chunks, s - 1);
+    for (uint32_t i: chunks) {
+        chunkIds.push_back(_chunkIds[i]);
+    }
+    return chunkIds;
+}
+
+std::vector<int32_t> ChunkPixelMap::getChunksIntersecting(
+    RangeSet const & envelope) const
+{
+    std::vector<int32_t> chunkIds;
+    for (uint32_t i: _findIntersecting(envelope)) {
+        chunkIds.push_back(_chunkIds[i]);
+    }
+    return chunkIds;
+}
+
+std::vector<ClassifiedChunk> ChunkPixelMap::classifyChunks(
+    RangeSet const & envelope, RangeSet const & interior) const
+{
+    std::vector<ClassifiedChunk> chunks;
+    for (uint32_t i: _findIntersecting(envelope)) {
+        chunks.push_back(ClassifiedChunk{
+            _chunkIds[i],
+            interior.contains(_envelopes[i]) ? CONTAINS : INTERSECTS});
+    }
+    return chunks;
+}
+
+size_t ChunkPixelMap::_find(int32_t chunkId) const {
+    auto i = std::lower_bound(_chunkIds.begin(), _chunkIds.end(), chunkId);
+    if (i == _chunkIds.end() || *i != chunkId) {
+        throw std::invalid_argument("Invalid chunk ID");
+    }
+    return static_cast<size_t>(i - _chunkIds.begin());
+}
+
+std::vector<uint32_t> ChunkPixelMap::_findIntersecting(
+    RangeSet const & s) const
+{
+    // Chunks are marked in a bit set as they are found, since the segments
+    // and blocks of a region usually overlap many of the same chunks.
+    std::vector<uint64_t> marks((_chunkIds.size() + 63) / 64, 0);
+    auto mark = [&marks](ChunkLists const & lists, size_t i) {
+        for (size_t j = lists.offsets[i]; j < lists.offsets[i + 1]; ++j) {
+            uint32_t c = lists.chunks[j];
+            marks[c >> 6] |= uint64_t(1) << (c & 63);
+        }
+    };
+    size_t const numSegments = _segmentBegins.size();
+    uint64_t const * begins = _segmentBegins.data();
+    size_t k = 0;
+    for (auto const & r: s) {
+        uint64_t const first = std::get<0>(r);
+        // Range ends are exclusive, and an end of 0 stands for 2^64, so
+        // the end minus one is the last pixel of the range in both cases.
+        uint64_t const last = std::get<1>(r) - 1;
+        // The ranges of s are in ascending order, so the first segment
+        // starting after the range begins is searched for from the segment
+        // after those visited for the previous range, in increasing steps.
+        size_t lo = k;
+        size_t hi = k;
+        for (size_t step = 1; hi < numSegments && begins[hi] <= first;
+             step *= 2) {
+            lo = hi + 1;
+            hi += step;
+        }
+        hi = std::min(hi, numSegments);
+        k = static_cast<size_t>(
+            std::upper_bound(begins + lo, begins + hi, first) - begins);
+        // Start with the segment containing the first pixel of the range,
+        // if there is one, and end with the one containing the last.
+        if (k != 0) {
+            --k;
+        }
+        size_t const end = static_cast<size_t>(
+            std::upper_bound(begins + k, begins + numSegments, last) - begins);
+        while (k < end) {
+            // Use the largest aligned block of segments that starts at k
+            // and ends before the end of the range, if there is one.
+            size_t j = 0;
+            size_t n = FAN_OUT;
+            for (; j < _blocks.size() && k % n == 0 && k + n <= end;
+                 ++j, n *= FAN_OUT) {}
+            n /= FAN_OUT;
+            if (j == 0) {
+                mark(_segments, k);
+                ++k;
+            } else {
+                mark(_blocks[j - 1], k / n);
+                k += n;
+            }
+        }
+    }
+    std::vector<uint32_t> chunks;
+    for (size_t w = 0; w < marks.size(); ++w) {
+        for (uint64_t m = marks[w]; m != 0; m &= m - 1) {
+            chunks.push_back(static_cast<uint32_t>(
+                w * 64 + static_cast<size_t>(__builtin_ctzll(m))));
+        }
+    }
+    return chunks;
+}
+
+}} // namespace lsst::sphgeom
@@ -25,6 +25,15 @@
 
 #include "lsst/sphgeom/Chunker.h"
 
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "Parallel.h"
+
 namespace lsst {
 namespace sphgeom {
 
@@ -51,11 +60,141 @@ int32_t computeNumSegments(AngleInterval const & latitudes, Angle width) {
 
 constexpr double BOX_EPSILON = 5.0e-12; // ~1 micro-arcsecond
 
+// `classify` reduces the relationship between a region and a chunk or
+// sub-chunk it is not disjoint from to CONTAINS or INTERSECTS.
+Relationship classify(Relationship r) {
+    return (r & CONTAINS) != 0 ? CONTAINS : INTERSECTS;
+}
+
+// The following functions record the chunks and sub-chunks that are not
+// disjoint from a region in plain or classified search results.
+void addChunk(std::vector<int32_t> & chunks, int32_t id, Relationship r) {
+    if ((r & DISJOINT) == 0) {
+        chunks.push_back(id);
+    }
+}
+
+void addChunk(std::vector<ClassifiedChunk> & chunks, int32_t id,
+              Relationship r) {
+    if ((r & DISJOINT) == 0) {
+        chunks.push_back(ClassifiedChunk{id, classify(r)});
+    }
+}
+
+void setChunkRelationship(SubChunks &, Relationship) {}
+
+void setChunkRelationship(ClassifiedSubChunks & c, Relationship r) {
+    c.relationship = classify(r);
+}
+
+void addSubChunk(SubChunks & c, int32_t id, Relationship r) {
+    if ((r & DISJOINT) == 0) {
+        c.subChunkIds.push_back(id);
+    }
+}
+
+void addSubChunk(ClassifiedSubChunks & c, int32_t id, Relationship r) {
+    if ((r & DISJOINT) == 0) {
+        c.subChunkIds.push_back(id);
+        c.subChunkRelationships.push_back(classify(r));
+    }
+}
+
+void addAllSubChunks(SubChunks & c, std::vector<int32_t> ids) {
+    c.subChunkIds = std::move(ids);
+}
+
+void addAllSubChunks(ClassifiedSubChunks & c, std::vector<int32_t> ids) {
+    c.subChunkRelationships.assign(ids.size(), CONTAINS);
+    c.subChunkIds = std::move(ids);
+}
+
+void checkOverlap(Angle overlap) {
+    if (!(overlap.asRadians() >= 0.0) || !std::isfinite(overlap.asRadians())) {
+        throw std::invalid_argument("The overlap must be finite and "
+                                    "non-negative");
+    }
+}
+
+// `segmentRange` computes the range [a, b] of the indexes of the n
+// equal-width longitude segments overlapping lon, the same way that
+// getChunksIntersecting does. The range wraps around if a > b.
+void segmentRange(NormalizedAngleInterval const & lon, Angle width,
+                  int32_t n, int32_t & a, int32_t & b) {
+    a = std::min(static_cast<int32_t>(std::floor(lon.getA() / width)), n - 1);
+    b = std::min(static_cast<int32_t>(std::floor(lon.getB() / width)), n - 1);
+    if (a == b && lon.wraps()) {
+        a = 0;
+        b = n - 1;
+    }
+}
+
+// `forEachInRange` calls f(i), in ascending order, for every i in [lo, hi]
+// that is in the possibly wrapping range [a, b] computed by segmentRange.
+template <typename F>
+void forEachInRange(int32_t a, int32_t b, int32_t lo, int32_t hi, F f) {
+    if (a <= b) {
+        for (int32_t i = std::max(a, lo); i <= std::min(b, hi); ++i) {
+            f(i);
+        }
+    } else {
+        for (int32_t i = lo; i <= std::min(b, hi); ++i) {
+            f(i);
+        }
+        for (int32_t i = std::max(a, lo); i <= hi; ++i) {
+            f(i);
+        }
+    }
+}
+
 } // unnamed namespace
 
+// The bounding boxes of the chunks of a stripe, followed by those of the
+// sub-chunks of each of its sub-stripes.
+struct Chunker::StripeBoxes {
+    std::vector<Box> boxes;
+    // offsets[i] is the position in boxes of the first sub-chunk box of
+    // the i-th sub-stripe of the stripe.
+    std::vector<size_t> offsets;
+};
+
+struct Chunker::BoxTable {
+    std::unique_ptr<std::atomic<StripeBoxes const *>[]> stripes;
+    // Stripes whose boxes did not fit in the table. Their slots in
+    // stripes point at this sentinel.
+    StripeBoxes const rejected;
+    std::atomic<size_t> bytes;
+    size_t const maxBytes;
+    int32_t const numStripes;
+
+    BoxTable(int32_t n, size_t max) :
+        stripes(new std::atomic<StripeBoxes const *>[n]),
+        bytes(0),
+        maxBytes(max),
+        numStripes(n)
+    {
+        for (int32_t s = 0; s < n; ++s) {
+            stripes[s].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~BoxTable() {
+        for (int32_t s = 0; s < numStripes; ++s) {
+            StripeBoxes const * b = stripes[s].load(std::memory_order_relaxed);
+            if (b != &rejected) {
+                delete b;
+            }
+        }
+    }
+
+    BoxTable(BoxTable const &) = delete;
+    BoxTable & operator=(BoxTable const &) = delete;
+};
+
 
 Chunker::Chunker(int32_t numStripes,
-                 int32_t numSubStripesPerStripe) :
+                 int32_t numSubStripesPerStripe,
+                 size_t maxBoxTableBytes) :
     _numStripes(numStripes),
     _numSubStripesPerStripe(numSubStripesPerStripe),
     _numSubStripes(numStripes * numSubStripesPerStripe),
@@ -98,10 +237,22 @@ Chunker::Chunker(int32_t numStripes,
         }
         _stripes.push_back(stripe);
     }
+    if (maxBoxTableBytes > 0) {
+        _boxTable = std::make_shared<BoxTable>(_numStripes, maxBoxTableBytes);
+    }
 }
 
 std::vector<int32_t> Chunker::getChunksIntersecting(Region const & r) const {
-    std::vector<int32_t> chunkIds;
+    return _findChunks<int32_t>(r);
+}
+
+std::vector<ClassifiedChunk> Chunker::classifyChunks(Region const & r) const {
+    return _findChunks<ClassifiedChunk>(r);
+}
+
+template <typename Chunk>
+std::vector<Chunk> Chunker::_findChunks(Region const & r) const {
+    std::vector<Chunk> chunks;
     // Find the stripes that intersect the bounding box of r.
     Box b = r.getBoundingBox().dilatedBy(Angle(BOX_EPSILON));
     double ya = std::floor((b.getLat().getA() + Angle(0.5 * PI)) / _subStripeHeight);
@@ -125,30 +276,42 @@ std::vector<int32_t> Chunker::getChunksIntersecting(Region const & r) const {
         // Examine each chunk overlapping the bounding box of r.
         if (ca <= cb) {
             for (int32_t c = ca; c <= cb; ++c) {
-                if ((r.relate(getChunkBoundingBox(s, c)) & DISJOINT) == 0) {
-                    chunkIds.push_back(_getChunkId(s, c));
-                }
+                addChunk(chunks, _getChunkId(s, c),
+                         r.relate(getChunkBoundingBox(s, c)));
             }
         } else {
             for (int32_t c = 0; c <= cb; ++c) {
-                if ((r.relate(getChunkBoundingBox(s, c)) & DISJOINT) == 0) {
-                    chunkIds.push_back(_getChunkId(s, c));
-                }
+                addChunk(chunks, _getChunkId(s, c),
+                         r.relate(getChunkBoundingBox(s, c)));
             }
             for (int32_t c = ca; c < nc; ++c) {
-                if ((r.relate(getChunkBoundingBox(s, c)) & DISJOINT) == 0) {
-                    chunkIds.push_back(_getChunkId(s, c));
-                }
+                addChunk(chunks, _getChunkId(s, c),
+                         r.relate(getChunkBoundingBox(s, c)));
             }
         }
     }
-    return chunkIds;
+    return chunks;
 }
 
 std::vector<SubChunks> Chunker::getSubChunksIntersecting(
-    Region const & r) const
+    Region const & r,
+    unsigned numThreads) const
 {
-    std::vector<SubChunks> chunks;
+    return _findSubChunks<SubChunks>(r, numThreads);
+}
+
+std::vector<ClassifiedSubChunks> Chunker::classifySubChunks(
+    Region const & r,
+    unsigned numThreads) const
+{
+    return _findSubChunks<ClassifiedSubChunks>(r, numThreads);
+}
+
+template <typename Chunks>
+std::vector<Chunks> Chunker::_findSubChunks(Region const & r,
+                                            unsigned numThreads) const
+{
+    std::vector<Chunks> chunks;
     // Find the stripes that intersect the bounding box of r.
     Box b = r.getBoundingBox().dilatedBy(Angle(BOX_EPSILON));
     double ya = std::floor((b.getLat().getA() + Angle(0.5 * PI)) / _subStripeHeight);
@@ -157,36 +320,92 @@ std::vector<SubChunks> Chunker::getSubChunksIntersecting(
     int32_t maxSS = std::min(static_cast<int32_t>(yb), _numSubStripes - 1);
     int32_t minS = minSS / _numSubStripesPerStripe;
     int32_t maxS = maxSS / _numSubStripesPerStripe;
-    for (int32_t s = minS; s <= maxS; ++s) {
-        // Find the chunks of s that intersect the bounding box of r.
-        Angle chunkWidth = _stripes[s].chunkWidth;
-        int32_t nc = _stripes[s].numChunksPerStripe;
-        double xa = std::floor(b.getLon().getA() / chunkWidth);
-        double xb = std::floor(b.getLon().getB() / chunkWidth);
-        int32_t ca = std::min(static_cast<int32_t>(xa), nc - 1);
-        int32_t cb = std::min(static_cast<int32_t>(xb), nc - 1);
-        if (ca == cb && b.getLon().wraps()) {
-            ca = 0;
-            cb = nc - 1;
+    size_t const numStripes = static_cast<size_t>(maxS - minS + 1);
+    if (numThreads <= 1 || numStripes <= 1) {
+        for (int32_t s = minS; s <= maxS; ++s) {
+            _getSubChunksInStripe(chunks, r, b.getLon(), s, minSS, maxSS);
         }
-        // Examine sub-chunks for each chunk overlapping the bounding box of r.
-        if (ca <= cb) {
-            for (int32_t c = ca; c <= cb; ++c) {
-                _getSubChunks(chunks, r, b.getLon(), s, c, minSS, maxSS);
-            }
-        } else {
-            for (int32_t c = 0; c <= cb; ++c) {
-                _getSubChunks(chunks, r, b.getLon(), s, c, minSS, maxSS);
+        return chunks;
+    }
+    // Hand out stripes to threads one at a time, so that the load stays
+    // balanced even though the cost of a stripe varies a lot, and then
+    // concatenate the per-stripe results in stripe order. The result is
+    // identical to that of the serial code.
+    std::vector<std::vector<Chunks>> results(numStripes);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&]() {
+        try {
+            for (size_t i = next++; i < numStripes && !failed; i = next++) {
+                _getSubChunksInStripe(results[i], r, b.getLon(),
+                                      minS + static_cast<int32_t>(i),
+                                      minSS, maxSS);
             }
-            for (int32_t c = ca; c < nc; ++c) {
-                _getSubChunks(chunks, r, b.getLon(), s, c, minSS, maxSS);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
             }
+            failed = true;
+        }
+    };
+    numThreads = static_cast<unsigned>(
+        std::min<size_t>(numThreads, numStripes));
+    detail::runInParallel(numThreads, work);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    size_t n = 0;
+    for (auto const & v: results) {
+        n += v.size();
+    }
+    chunks.reserve(n);
+    for (auto & v: results) {
+        for (Chunks & sc: v) {
+            chunks.push_back(std::move(sc));
         }
     }
     return chunks;
 }
 
-void Chunker::_getSubChunks(std::vector<SubChunks> & chunks,
+template <typename Chunks>
+void Chunker::_getSubChunksInStripe(std::vector<Chunks> & chunks,
+                                    Region const & r,
+                                    NormalizedAngleInterval const & lon,
+                                    int32_t stripe,
+                                    int32_t minSS,
+                                    int32_t maxSS) const
+{
+    // Find the chunks of the stripe that intersect the bounding box of r.
+    Angle chunkWidth = _stripes[stripe].chunkWidth;
+    int32_t nc = _stripes[stripe].numChunksPerStripe;
+    double xa = std::floor(lon.getA() / chunkWidth);
+    double xb = std::floor(lon.getB() / chunkWidth);
+    int32_t ca = std::min(static_cast<int32_t>(xa), nc - 1);
+    int32_t cb = std::min(static_cast<int32_t>(xb), nc - 1);
+    if (ca == cb && lon.wraps()) {
+        ca = 0;
+        cb = nc - 1;
+    }
+    // Examine sub-chunks for each chunk overlapping the bounding box of r.
+    if (ca <= cb) {
+        for (int32_t c = ca; c <= cb; ++c) {
+            _getSubChunks(chunks, r, lon, stripe, c, minSS, maxSS);
+        }
+    } else {
+        for (int32_t c = 0; c <= cb; ++c) {
+            _getSubChunks(chunks, r, lon, stripe, c, minSS, maxSS);
+        }
+        for (int32_t c = ca; c < nc; ++c) {
+            _getSubChunks(chunks, r, lon, stripe, c, minSS, maxSS);
+        }
+    }
+}
+
+template <typename Chunks>
+void Chunker::_getSubChunks(std::vector<Chunks> & chunks,
                             Region const & r,
                             NormalizedAngleInterval const & lon,
                             int32_t stripe,
@@ -194,12 +413,14 @@ void Chunker::_getSubChunks(std::vector<SubChunks> & chunks,
                             int32_t minSS,
                             int32_t maxSS) const
 {
-    SubChunks subChunks;
+    Chunks subChunks;
     subChunks.chunkId = _getChunkId(stripe, chunk);
-    if ((r.relate(getChunkBoundingBox(stripe, chunk)) & CONTAINS) != 0) {
+    Relationship const rel = r.relate(getChunkBoundingBox(stripe, chunk));
+    setChunkRelationship(subChunks, rel);
+    if ((rel & CONTAINS) != 0) {
         // r contains the entire chunk, so there is no need to test sub-chunks
         // for intersection with r.
-        subChunks.subChunkIds = getAllSubChunks(subChunks.chunkId);
+        addAllSubChunks(subChunks, getAllSubChunks(subChunks.chunkId));
     } else {
         // Find the sub-stripes to iterate over.
         minSS = std::max(minSS, stripe * _numSubStripesPerStripe);
@@ -224,25 +445,22 @@ void Chunker::_getSubChunks(std::vector<SubChunks> & chunks,
                 minSC = std::max(sca, minSC);
                 maxSC = std::min(scb, maxSC);
                 for (int32_t sc = minSC; sc <= maxSC; ++sc) {
-                    if ((r.relate(getSubChunkBoundingBox(ss, sc)) & DISJOINT) == 0) {
-                        subChunks.subChunkIds.push_back(
-                            _getSubChunkId(stripe, ss, chunk, sc));
-                    }
+                    addSubChunk(subChunks,
+                                _getSubChunkId(stripe, ss, chunk, sc),
+                                r.relate(getSubChunkBoundingBox(ss, sc)));
                 }
             } else {
                 sca = std::max(sca, minSC);
                 scb = std::min(scb, maxSC);
                 for (int32_t sc = sca; sc <= maxSC; ++sc) {
-                    if ((r.relate(getSubChunkBoundingBox(ss, sc)) & DISJOINT) == 0) {
-                        subChunks.subChunkIds.push_back(
-                            _getSubChunkId(stripe, ss, chunk, sc));
-                    }
+                    addSubChunk(subChunks,
+                                _getSubChunkId(stripe, ss, chunk, sc),
+                                r.relate(getSubChunkBoundingBox(ss, sc)));
                 }
                 for (int32_t sc = minSC; sc <= scb; ++sc) {
-                    if ((r.relate(getSubChunkBoundingBox(ss, sc)) & DISJOINT) == 0) {
-                        subChunks.subChunkIds.push_back(
-                            _getSubChunkId(stripe, ss, chunk, sc));
-                    }
+                    addSubChunk(subChunks,
+                                _getSubChunkId(stripe, ss, chunk, sc),
+                                r.relate(getSubChunkBoundingBox(ss, sc)));
                 }
             }
         }
@@ -250,9 +468,220 @@ void Chunker::_getSubChunks(std::vector<SubChunks> & chunks,
     // If any sub-chunks of this chunk intersect r,
     // append them to the result vector.
     if (!subChunks.subChunkIds.empty()) {
-        chunks.push_back(SubChunks());
-        chunks.back().swap(subChunks);
+        chunks.push_back(std::move(subChunks));
+    }
+}
+
+std::pair<int32_t, int32_t> Chunker::locate(LonLat const & p) const {
+    std::pair<int32_t, int32_t> ids;
+    _locate(p.getLon().asRadians(), p.getLat().asRadians(),
+            ids.first, ids.second);
+    return ids;
+}
+
+void Chunker::locate(double const * lon, double const * lat,
+                     int32_t * chunk, int32_t * subChunk, size_t n) const {
+    for (size_t i = 0; i < n; ++i) {
+        if (!std::isfinite(lon[i]) || !(std::fabs(lat[i]) <= 0.5 * PI)) {
+            throw std::invalid_argument(
+                "Longitudes must be finite, and latitudes must be "
+                "in [-π/2, π/2]");
+        }
+        _locate(NormalizedAngle(lon[i]).asRadians(), lat[i],
+                chunk[i], subChunk[i]);
+    }
+}
+
+void Chunker::locateWithOverlap(double const * lon, double const * lat,
+                                size_t n, Angle overlap,
+                                ChunkLocations & out) const {
+    checkOverlap(overlap);
+    // By construction, all sub-chunk bounding boxes in a sub-stripe have
+    // the same latitude interval, and hence need the same longitude
+    // dilation. Compute it once per sub-stripe, on first use, along with
+    // the extent of the dilated boxes.
+    struct Dilation {
+        double width = -1.0;  // Longitude dilation of the boxes.
+        double margin;        // Amount by which dilated boxes extend past
+                              // their sub-chunk along each longitude edge.
+        AngleInterval lat;    // Latitude interval of the dilated boxes.
+    };
+    std::vector<Dilation> dilations(_numSubStripes);
+    double const h = _subStripeHeight.asRadians();
+    double const r = overlap.asRadians() + BOX_EPSILON;
+    for (size_t i = 0; i < n; ++i) {
+        if (!std::isfinite(lon[i]) || !(std::fabs(lat[i]) <= 0.5 * PI)) {
+            throw std::invalid_argument(
+                "Longitudes must be finite, and latitudes must be "
+                "in [-π/2, π/2]");
+        }
+        double const x = NormalizedAngle(lon[i]).asRadians();
+        double const y = lat[i];
+        int32_t chunkId;
+        int32_t subChunkId;
+        _locate(x, y, chunkId, subChunkId);
+        out.push_back(i, chunkId, subChunkId, false);
+        LonLat const p = LonLat::fromRadians(x, y);
+        // Find candidate sub-chunks conservatively from the stripe geometry,
+        // and then test the point against their dilated bounding boxes.
+        int32_t ssa = static_cast<int32_t>(std::floor((y - r + 0.5 * PI) / h)) - 1;
+        int32_t ssb = static_cast<int32_t>(std::floor((y + r + 0.5 * PI) / h)) + 1;
+        ssa = std::max(0, ssa);
+        ssb = std::min(_numSubStripes - 1, ssb);
+        for (int32_t ss = ssa; ss <= ssb; ++ss) {
+            int32_t const s = ss / _numSubStripesPerStripe;
+            int32_t const nsc = _subStripes[ss].numSubChunksPerChunk;
+            int32_t const m = _stripes[s].numChunksPerStripe * nsc;
+            double const width = _subStripes[ss].subChunkWidth.asRadians();
+            Dilation & d = dilations[ss];
+            if (d.width < 0.0) {
+                Box b = getSubChunkBoundingBox(ss, 0);
+                Angle maxAbsLat = std::max(abs(b.getLat().getA()),
+                                           abs(b.getLat().getB()));
+                d.width = Box::halfWidthForCircle(overlap, maxAbsLat).asRadians();
+                b.dilateBy(Angle(d.width), overlap);
+                d.margin = b.getLon().isFull() ? PI :
+                           0.5 * (b.getLon().getSize().asRadians() - width);
+                d.lat = b.getLat();
+            }
+            if (!d.lat.contains(Angle(y))) {
+                continue;
+            }
+            // Widen the candidate range slightly, so that rounding cannot
+            // cause a sub-chunk to be missed.
+            double const w = d.margin * (1.0 + 1.0e-9) + 1.0e-15;
+            int32_t lo = static_cast<int32_t>(std::floor((x - w) / width));
+            int32_t hi = static_cast<int32_t>(std::floor((x + w) / width));
+            if (hi - lo + 1 >= m) {
+                lo = 0;
+                hi = m - 1;
+            }
+            for (int32_t k = lo; k <= hi; ++k) {
+                int32_t const sc = ((k % m) + m) % m;
+                int32_t const c = sc / nsc;
+                int32_t const id = _getSubChunkId(s, ss, c, sc);
+                if (id == subChunkId && _getChunkId(s, c) == chunkId) {
+                    continue;
+                }
+                // This is equivalent to dilatedBy(overlap), but avoids
+                // recomputing the longitude dilation for every box.
+                Box b = getSubChunkBoundingBox(ss, sc).dilatedBy(
+                    Angle(d.width), overlap);
+                if (b.contains(p)) {
+                    out.push_back(i, _getChunkId(s, c), id, true);
+                }
+            }
+        }
+    }
+}
+
+void Chunker::_locate(double lon, double lat,
+                      int32_t & chunkId, int32_t & subChunkId) const {
+    // lon is in [0, 2π) and lat is in [-π/2, π/2].
+    int32_t ss = static_cast<int32_t>(
+        std::floor((lat + 0.5 * PI) / _subStripeHeight.asRadians()));
+    ss = std::max(0, std::min(ss, _numSubStripes - 1));
+    int32_t const s = ss / _numSubStripesPerStripe;
+    int32_t const nc = _stripes[s].numChunksPerStripe;
+    int32_t const nsc = _subStripes[ss].numSubChunksPerChunk;
+    int32_t sc = static_cast<int32_t>(
+        std::floor(lon / _subStripes[ss].subChunkWidth.asRadians()));
+    sc = std::max(0, std::min(sc, nc * nsc - 1));
+    // Derive the chunk from the sub-chunk, so that the sub-chunk is always
+    // one of the sub-chunks of the chunk, even when rounding puts lon on
+    // different sides of a boundary shared by the two.
+    int32_t const c = sc / nsc;
+    chunkId = _getChunkId(s, c);
+    subChunkId = _getSubChunkId(s, ss, c, sc);
+}
+
+std::vector<int32_t> Chunker::getNeighborChunks(int32_t chunkId,
+                                                Angle overlap) const {
+    checkOverlap(overlap);
+    if (chunkId < 0 || !valid(chunkId)) {
+        throw std::invalid_argument("Invalid chunk ID");
     }
+    int32_t const s = getStripe(chunkId);
+    int32_t const c = getChunk(chunkId, s);
+    // This is the box getChunksIntersecting would search for the dilated
+    // chunk bounding box.
+    Box b = getChunkBoundingBox(s, c).dilatedBy(overlap)
+                                     .dilatedBy(Angle(BOX_EPSILON));
+    double ya = std::floor((b.getLat().getA() + Angle(0.5 * PI)) / _subStripeHeight);
+    double yb = std::floor((b.getLat().getB() + Angle(0.5 * PI)) / _subStripeHeight);
+    int32_t minS = std::min(static_cast<int32_t>(ya), _numSubStripes - 1) /
+                   _numSubStripesPerStripe;
+    int32_t maxS = std::min(static_cast<int32_t>(yb), _numSubStripes - 1) /
+                   _numSubStripesPerStripe;
+    std::vector<int32_t> chunkIds;
+    for (int32_t t = minS; t <= maxS; ++t) {
+        int32_t const nc = _stripes[t].numChunksPerStripe;
+        int32_t ca, cb;
+        segmentRange(b.getLon(), _stripes[t].chunkWidth, nc, ca, cb);
+        forEachInRange(ca, cb, 0, nc - 1, [&](int32_t k) {
+            if ((t != s || k != c) && b.intersects(getChunkBoundingBox(t, k))) {
+                chunkIds.push_back(_getChunkId(t, k));
+            }
+        });
+    }
+    return chunkIds;
+}
+
+std::vector<SubChunks> Chunker::getNeighborSubChunks(int32_t chunkId,
+                                                     int32_t subChunkId,
+                                                     Angle overlap) const {
+    checkOverlap(overlap);
+    if (chunkId < 0 || !valid(chunkId)) {
+        throw std::invalid_argument("Invalid chunk ID");
+    }
+    int32_t const s = getStripe(chunkId);
+    int32_t const c = getChunk(chunkId, s);
+    int32_t const y = subChunkId / _maxSubChunksPerSubStripeChunk;
+    int32_t const x = subChunkId % _maxSubChunksPerSubStripeChunk;
+    if (subChunkId < 0 || y >= _numSubStripesPerStripe ||
+        x >= _subStripes[s * _numSubStripesPerStripe + y].numSubChunksPerChunk) {
+        throw std::invalid_argument("Invalid sub-chunk ID");
+    }
+    int32_t const ss0 = s * _numSubStripesPerStripe + y;
+    int32_t const sc0 = c * _subStripes[ss0].numSubChunksPerChunk + x;
+    Box b = getSubChunkBoundingBox(ss0, sc0).dilatedBy(overlap)
+                                            .dilatedBy(Angle(BOX_EPSILON));
+    double ya = std::floor((b.getLat().getA() + Angle(0.5 * PI)) / _subStripeHeight);
+    double yb = std::floor((b.getLat().getB() + Angle(0.5 * PI)) / _subStripeHeight);
+    int32_t minSS = std::min(static_cast<int32_t>(ya), _numSubStripes - 1);
+    int32_t maxSS = std::min(static_cast<int32_t>(yb), _numSubStripes - 1);
+    std::vector<SubChunks> chunks;
+    for (int32_t t = minSS / _numSubStripesPerStripe;
+         t <= maxSS / _numSubStripesPerStripe; ++t) {
+        int32_t const nc = _stripes[t].numChunksPerStripe;
+        int32_t const ssa = std::max(minSS, t * _numSubStripesPerStripe);
+        int32_t const ssb = std::min(maxSS, (t + 1) * _numSubStripesPerStripe - 1);
+        int32_t ca, cb;
+        segmentRange(b.getLon(), _stripes[t].chunkWidth, nc, ca, cb);
+        forEachInRange(ca, cb, 0, nc - 1, [&](int32_t k) {
+            SubChunks subChunks;
+            subChunks.chunkId = _getChunkId(t, k);
+            for (int32_t ss = ssa; ss <= ssb; ++ss) {
+                int32_t const nsc = _subStripes[ss].numSubChunksPerChunk;
+                int32_t sca, scb;
+                segmentRange(b.getLon(), _subStripes[ss].subChunkWidth,
+                             nc * nsc, sca, scb);
+                forEachInRange(sca, scb, k * nsc, (k + 1) * nsc - 1,
+                               [&](int32_t j) {
+                    if ((ss != ss0 || j != sc0) &&
+                        b.intersects(getSubChunkBoundingBox(ss, j))) {
+                        subChunks.subChunkIds.push_back(
+                            _getSubChunkId(t, ss, k, j));
+                    }
+                });
+            }
+            if (!subChunks.subChunkIds.empty()) {
+                chunks.push_back(SubChunks());
+                chunks.back().swap(subChunks);
+            }
+        });
+    }
+    return chunks;
 }
 
 std::vector<int32_t> Chunker::getAllChunks() const {
@@ -289,6 +718,53 @@ bool Chunker::valid(int32_t chunkId) const {
 }
 
 Box Chunker::getChunkBoundingBox(int32_t stripe, int32_t chunk) const {
+    StripeBoxes const * sb = _getStripeBoxes(stripe);
+    if (sb != nullptr) {
+        return sb->boxes[chunk];
+    }
+    return _computeChunkBoundingBox(stripe, chunk);
+}
+
+Box Chunker::getSubChunkBoundingBox(int32_t subStripe, int32_t subChunk) const {
+    int32_t stripe = subStripe / _numSubStripesPerStripe;
+    StripeBoxes const * sb = _getStripeBoxes(stripe);
+    if (sb != nullptr) {
+        int32_t i = subStripe - stripe * _numSubStripesPerStripe;
+        return sb->boxes[sb->offsets[i] + subChunk];
+    }
+    return _computeSubChunkBoundingBox(subStripe, subChunk);
+}
+
+Chunker::BoxRange Chunker::getChunkBoundingBoxes(int32_t stripe) const {
+    if (stripe < 0 || stripe >= _numStripes) {
+        throw std::invalid_argument("Invalid stripe");
+    }
+    StripeBoxes const * sb = _getStripeBoxes(stripe);
+    Box const * boxes = sb != nullptr ? sb->boxes.data() : nullptr;
+    return BoxRange(
+        BoxIterator(this, boxes, stripe, 0, false),
+        BoxIterator(this, boxes, stripe,
+                    _stripes[stripe].numChunksPerStripe, false));
+}
+
+Chunker::BoxRange Chunker::getSubChunkBoundingBoxes(int32_t subStripe) const {
+    if (subStripe < 0 || subStripe >= _numSubStripes) {
+        throw std::invalid_argument("Invalid sub-stripe");
+    }
+    int32_t stripe = subStripe / _numSubStripesPerStripe;
+    StripeBoxes const * sb = _getStripeBoxes(stripe);
+    Box const * boxes = nullptr;
+    if (sb != nullptr) {
+        int32_t i = subStripe - stripe * _numSubStripesPerStripe;
+        boxes = sb->boxes.data() + sb->offsets[i];
+    }
+    int32_t n = _stripes[stripe].numChunksPerStripe *
+                _subStripes[subStripe].numSubChunksPerChunk;
+    return BoxRange(BoxIterator(this, boxes, subStripe, 0, true),
+                    BoxIterator(this, boxes, subStripe, n, true));
+}
+
+Box Chunker::_computeChunkBoundingBox(int32_t stripe, int32_t chunk) const {
     Angle chunkWidth = _stripes[stripe].chunkWidth;
     NormalizedAngleInterval lon(chunkWidth * chunk,
                                 chunkWidth * (chunk + 1));
@@ -299,7 +775,8 @@ Box Chunker::getChunkBoundingBox(int32_t stripe, int32_t chunk) const {
     return Box(lon, lat).dilatedBy(Angle(BOX_EPSILON));
 }
 
-Box Chunker::getSubChunkBoundingBox(int32_t subStripe, int32_t subChunk) const {
+Box Chunker::_computeSubChunkBoundingBox(int32_t subStripe,
+                                         int32_t subChunk) const {
     Angle subChunkWidth = _subStripes[subStripe].subChunkWidth;
     NormalizedAngleInterval lon(subChunkWidth * subChunk,
                                 subChunkWidth * (subChunk + 1));
@@ -308,4 +785,57 @@ Box Chunker::getSubChunkBoundingBox(int32_t subStripe, int32_t subChunk) const {
     return Box(lon, lat).dilatedBy(Angle(BOX_EPSILON));
 }
 
+Chunker::StripeBoxes const * Chunker::_getStripeBoxes(int32_t stripe) const {
+    if (!_boxTable) {
+        return nullptr;
+    }
+    BoxTable & table = *_boxTable;
+    StripeBoxes const * sb =
+        table.stripes[stripe].load(std::memory_order_acquire);
+    if (sb != nullptr) {
+        return sb == &table.rejected ? nullptr : sb;
+    }
+    // Reserve space for the boxes of the stripe, or give up on storing
+    // them if it is not available.
+    int32_t const nc = _stripes[stripe].numChunksPerStripe;
+    int32_t const ssBeg = stripe * _numSubStripesPerStripe;
+    int32_t const ssEnd = ssBeg + _numSubStripesPerStripe;
+    size_t n = static_cast<size_t>(nc);
+    for (int32_t ss = ssBeg; ss < ssEnd; ++ss) {
+        n += static_cast<size_t>(nc) * _subStripes[ss].numSubChunksPerChunk;
+    }
+    size_t const bytes = n * sizeof(Box);
+    size_t used = table.bytes.load(std::memory_order_relaxed);
+    do {
+        if (used + bytes > table.maxBytes) {
+            StripeBoxes const * expected = nullptr;
+            table.stripes[stripe].compare_exchange_strong(
+                expected, &table.rejected, std::memory_order_acq_rel);
+            return nullptr;
+        }
+    } while (!table.bytes.compare_exchange_weak(used, used + bytes,
+                                                std::memory_order_relaxed));
+    std::unique_ptr<StripeBoxes> boxes(new StripeBoxes());
+    boxes->boxes.reserve(n);
+    boxes->offsets.reserve(_numSubStripesPerStripe);
+    for (int32_t c = 0; c < nc; ++c) {
+        boxes->boxes.push_back(_computeChunkBoundingBox(stripe, c));
+    }
+    for (int32_t ss = ssBeg; ss < ssEnd; ++ss) {
+        boxes->offsets.push_back(boxes->boxes.size());
+        int32_t const nsc = nc * _subStripes[ss].numSubChunksPerChunk;
+        for (int32_t sc = 0; sc < nsc; ++sc) {
+            boxes->boxes.push_back(_computeSubChunkBoundingBox(ss, sc));
+        }
+    }
+    // Publish the boxes, unless another thread got there first.
+    StripeBoxes const * expected = nullptr;
+    if (table.stripes[stripe].compare_exchange_strong(
+            expected, boxes.get(), std::memory_order_acq_rel)) {
+        return boxes.release();
+    }
+    table.bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    return expected == &table.rejected ? nullptr : expected;
+}
+
 }} // namespace lsst::sphgeom
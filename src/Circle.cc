@@ -25,15 +25,22 @@
 
 #include "lsst/sphgeom/Circle.h"
 
+#include <algorithm>
+#include <cmath>
 #include <ostream>
 #include <stdexcept>
+#include <vector>
 
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
 #include "lsst/sphgeom/codec.h"
 
+#include "CompactCodec.h"
+#include "PerformanceCounting.h"
+
 
 namespace lsst {
 namespace sphgeom {
@@ -211,6 +218,107 @@ Circle & Circle::complement() {
     return *this;
 }
 
+namespace {
+
+// `polygon` implements Circle::toOuterPolygon and Circle::toInnerPolygon.
+// The vertices are those of a regular polygon in the plane tangent to the
+// circle center, where the circle is a disk of radius tan θ and great
+// circles are straight lines.
+ConvexPolygon polygon(Circle const & c, int n, bool outer) {
+    if (n < 3) {
+        throw std::invalid_argument("A polygon must have at least 3 vertices");
+    }
+    Angle const pad = 2.0 * Angle(MAX_ASIN_ERROR);
+    Angle const theta = c.getOpeningAngle();
+    if (c.isEmpty() || theta >= Angle(0.45 * PI)) {
+        throw std::invalid_argument(
+            "Circle is empty or too large to be approximated by a polygon");
+    }
+    if (!outer && theta <= pad) {
+        throw std::invalid_argument("Circle is too small to contain a polygon");
+    }
+    double const t = outer ?
+        std::tan((theta + pad).asRadians()) / std::cos(PI / n) :
+        std::tan((theta - pad).asRadians());
+    UnitVector3d const & center = c.getCenter();
+    UnitVector3d const u = UnitVector3d::orthogonalTo(center);
+    Vector3d const w = center.cross(u);
+    std::vector<UnitVector3d> vertices;
+    vertices.reserve(n);
+    for (int i = 0; i < n; ++i) {
+        double const phi = 2.0 * PI * i / n;
+        vertices.emplace_back(
+            center + t * (std::cos(phi) * u + std::sin(phi) * w));
+    }
+    return ConvexPolygon::convexHull(vertices);
+}
+
+} // unnamed namespace
+
+ConvexPolygon Circle::toOuterPolygon(int n) const {
+    return polygon(*this, n, true);
+}
+
+ConvexPolygon Circle::toInnerPolygon(int n) const {
+    return polygon(*this, n, false);
+}
+
+void Circle::contains(double const * x,
+                      double const * y,
+                      double const * z,
+                      bool * out,
+                      size_t n) const
+{
+    static constexpr size_t BLOCK_SIZE = 256;
+    double u[3][BLOCK_SIZE];
+    bool const full = isFull();
+    for (size_t begin = 0; begin < n; begin += BLOCK_SIZE) {
+        size_t const m = std::min(BLOCK_SIZE, n - begin);
+        UnitVector3dArray::normalize(x + begin, y + begin, z + begin,
+                                     u[0], u[1], u[2], m);
+        for (size_t i = 0; i < m; ++i) {
+            Vector3d v(u[0][i], u[1][i], u[2][i]);
+            out[begin + i] = full ||
+                (v - _center).getSquaredNorm() <= _squaredChordLength;
+        }
+    }
+}
+
+void Circle::sample(size_t n, std::mt19937_64 & rng,
+                    double * x, double * y, double * z) const
+{
+    // Candidates outside the circle due to rounding are redrawn this many
+    // times before being accepted anyway.
+    static constexpr int MAX_ATTEMPTS = 64;
+    if (isEmpty()) {
+        throw std::invalid_argument("Cannot sample an empty circle");
+    }
+    UnitVector3d e1 = UnitVector3d::orthogonalTo(_center);
+    UnitVector3d e2 = UnitVector3d::orthogonalTo(_center, e1);
+    // The area of the cap of points with 1 - cos(d) ≤ h, where d is the
+    // distance to the center, is proportional to h, so h is drawn uniformly
+    // from [0, s/2], where s is the squared chord length of the circle.
+    double const hmax = 0.5 * std::min(_squaredChordLength, 4.0);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d v;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+            double h = hmax * uniform(rng);
+            double r = std::sqrt(h * (2.0 - h));
+            double phi = 2.0 * PI * uniform(rng);
+            v = UnitVector3d((1.0 - h) * _center +
+                             (r * std::cos(phi)) * e1 +
+                             (r * std::sin(phi)) * e2);
+            if (contains(v)) {
+                break;
+            }
+        }
+        x[i] = v.x();
+        y[i] = v.y();
+        z[i] = v.z();
+    }
+}
+
 Box Circle::getBoundingBox() const {
     LonLat c(_center);
     Angle h = _openingAngle + 2.0 * Angle(MAX_ASIN_ERROR);
@@ -283,6 +391,7 @@ Relationship Circle::relate(Box const & b) const {
 }
 
 Relationship Circle::relate(Circle const & c) const {
+    detail::count(PerformanceCounter::RELATE_CIRCLE_CIRCLE);
     if (isEmpty()) {
         if (c.isEmpty()) {
             return CONTAINS | DISJOINT | WITHIN;
@@ -331,32 +440,71 @@ Relationship Circle::relate(Ellipse const & e) const {
 
 std::vector<uint8_t> Circle::encode() const {
     std::vector<uint8_t> buffer;
-    uint8_t tc = TYPE_CODE;
     buffer.reserve(ENCODED_SIZE);
+    encodeTo(buffer);
+    return buffer;
+}
+
+void Circle::encodeTo(std::vector<uint8_t> & buffer) const {
+    uint8_t tc = TYPE_CODE;
     buffer.push_back(tc);
     encodeDouble(_center.x(), buffer);
     encodeDouble(_center.y(), buffer);
     encodeDouble(_center.z(), buffer);
     encodeDouble(_squaredChordLength, buffer);
     encodeDouble(_openingAngle.asRadians(), buffer);
-    return buffer;
+}
+
+void Circle::encodeCompactTo(std::vector<uint8_t> & buffer) const {
+    // Empty circles are encoded with a negative opening angle, and full
+    // circles with one of at least π, so that both are decoded exactly.
+    float a = -1.0f;
+    if (isFull()) {
+        a = std::nextafter(static_cast<float>(PI), 4.0f);
+    } else if (!isEmpty()) {
+        // The margin covers the rounding error of the chord length computed
+        // from the opening angle when decoding.
+        double r = _openingAngle.asRadians() + detail::MAX_QUANTIZATION_ERROR +
+                   1.0e-15;
+        a = static_cast<float>(r);
+        if (a < r) {
+            a = std::nextafter(a, 4.0f);
+        }
+    }
+    buffer.push_back(COMPACT_TYPE_CODE);
+    detail::encodeQuantized(_center, buffer);
+    detail::encodeFloat(a, buffer);
 }
 
 std::unique_ptr<Circle> Circle::decode(uint8_t const * buffer, size_t n) {
+    std::unique_ptr<Circle> circle(new Circle);
+    circle->_decode(buffer, n);
+    return circle;
+}
+
+void Circle::_decode(uint8_t const * buffer, size_t n) {
+    if (buffer != nullptr && n == COMPACT_ENCODED_SIZE &&
+        *buffer == COMPACT_TYPE_CODE) {
+        _center = detail::decodeQuantized(buffer + 1);
+        double a = detail::decodeFloat(buffer + 1 + detail::QUANTIZED_VECTOR_SIZE);
+        if (std::isnan(a)) {
+            throw std::runtime_error("Byte-string is not an encoded Circle");
+        }
+        *this = Circle(_center, Angle(a));
+        return;
+    }
     if (buffer == nullptr || n != ENCODED_SIZE || *buffer != TYPE_CODE) {
         throw std::runtime_error("Byte-string is not an encoded Circle");
     }
-    std::unique_ptr<Circle> circle(new Circle);
     ++buffer;
     double x = decodeDouble(buffer); buffer += 8;
     double y = decodeDouble(buffer); buffer += 8;
     double z = decodeDouble(buffer); buffer += 8;
     double squaredChordLength = decodeDouble(buffer); buffer += 8;
     double openingAngle = decodeDouble(buffer); buffer += 8;
-    circle->_center = UnitVector3d::fromNormalized(x, y, z);
-    circle->_squaredChordLength = squaredChordLength;
-    circle->_openingAngle = Angle(openingAngle);
-    return circle;
+    _center = UnitVector3d::fromNormalized(x, y, z);
+    _squaredChordLength = squaredChordLength;
+    _openingAngle = Angle(openingAngle);
 }
 
 std::ostream & operator<<(std::ostream & os, Circle const & c) {
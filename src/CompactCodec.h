@@ -0,0 +1,111 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_COMPACTCODEC_H_
+#define LSST_SPHGEOM_COMPACTCODEC_H_
+
+/// \file
+/// \brief This file provides the quantized unit vector encoding used by
+///        compact region encodings.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/Vector3d.h"
+#include "lsst/sphgeom/codec.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+// A quantized unit vector is encoded as the number of the cube face
+// (2 * axis + 1 if the dominant component is negative, 2 * axis otherwise)
+// it projects onto, followed by its two face coordinates, each mapped from
+// [-1, 1] to a 32 bit grid coordinate.
+constexpr size_t QUANTIZED_VECTOR_SIZE = 9;
+
+// `MAX_QUANTIZATION_ERROR` bounds the angle in radians between a unit vector
+// and the result of decoding its quantized encoding. Face coordinates are
+// off by at most half a grid step, 2⁻³², and the central projection from a
+// cube face back onto the sphere never magnifies distances, so the angle is
+// below √2 · 2⁻³² ≈ 3.3e-10 (plus a few ulps due to rounding).
+constexpr double MAX_QUANTIZATION_ERROR = 4.0e-10;
+
+// The largest grid coordinate, 2³² - 1.
+constexpr double GRID_MAX = 4294967295.0;
+
+// `encodeQuantized` appends the quantized encoding of v to buffer.
+
+inline void encodeQuantized(UnitVector3d const & v,
+                            std::vector<uint8_t> & buffer)
+{
+    double const a[3] = { std::fabs(v.x()), std::fabs(v.y()), std::fabs(v.z()) };
+    int axis = (a[0] >= a[1] && a[0] >= a[2]) ? 0 : (a[1] >= a[2] ? 1 : 2);
+    double m = v(axis);
+    buffer.push_back(static_cast<uint8_t>(2 * axis + (m < 0.0 ? 1 : 0)));
+    m = std::fabs(m);
+    for (int i = 1; i < 3; ++i) {
+        double w = v((axis + i) % 3) / m;
+        double g = std::round((w + 1.0) * (0.5 * GRID_MAX));
+        encodeU32(static_cast<uint32_t>(std::min(std::max(g, 0.0), GRID_MAX)),
+                  buffer);
+    }
+}
+
+// `decodeQuantized` decodes the quantized unit vector starting at buffer.
+inline UnitVector3d decodeQuantized(uint8_t const * buffer) {
+    uint8_t const face = buffer[0];
+    if (face >= 6) {
+        throw std::runtime_error("Invalid quantized unit vector");
+    }
+    int const axis = face >> 1;
+    double c[3];
+    c[axis] = (face & 1) ? -1.0 : 1.0;
+    c[(axis + 1) % 3] = decodeU32(buffer + 1) * (2.0 / GRID_MAX) - 1.0;
+    c[(axis + 2) % 3] = decodeU32(buffer + 5) * (2.0 / GRID_MAX) - 1.0;
+    return UnitVector3d(c[0], c[1], c[2]);
+}
+
+// `encodeFloat` appends the bits of an IEEE single precision float in
+// little-endian byte order to buffer.
+inline void encodeFloat(float item, std::vector<uint8_t> & buffer) {
+    std::uint32_t u;
+    std::memcpy(&u, &item, sizeof(u));
+    encodeU32(u, buffer);
+}
+
+inline float decodeFloat(uint8_t const * buffer) {
+    std::uint32_t u = decodeU32(buffer);
+    float f;
+    std::memcpy(&f, &u, sizeof(f));
+    return f;
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_COMPACTCODEC_H_
@@ -25,8 +25,12 @@
 
 #include "lsst/sphgeom/CompoundRegion.h"
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
 
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
@@ -53,64 +57,172 @@ std::uint64_t consumeDecodeU64(std::uint8_t const *&buffer, std::uint8_t const *
 
 template <typename F>
 auto getUnionBounds(UnionRegion const &compound, F func) {
-    auto bounds = func(compound.getOperand(0));
-    bounds.expandTo(func(compound.getOperand(1)));
+    decltype(func(compound)) bounds;
+    for (std::size_t i = 0; i < compound.nOperands(); ++i) {
+        bounds.expandTo(func(compound.getOperand(i)));
+    }
     return bounds;
 }
 
-template <typename F>
-auto getIntersectionBounds(IntersectionRegion const &compound, F func) {
-    auto bounds = func(compound.getOperand(0));
-    bounds.clipTo(func(compound.getOperand(1)));
+template <typename F, typename T>
+auto getIntersectionBounds(IntersectionRegion const &compound, F func, T full) {
+    decltype(func(compound)) bounds = full;
+    for (std::size_t i = 0; i < compound.nOperands(); ++i) {
+        bounds.clipTo(func(compound.getOperand(i)));
+    }
     return bounds;
 }
 
 }  // namespace
 
-CompoundRegion::CompoundRegion(Region const &first, Region const &second)
-        : _operands{first.clone(), second.clone()} {}
+CompoundRegion::CompoundRegion(std::vector<std::shared_ptr<Region const>> operands)
+        : _operands(std::move(operands)) {
+    _operandBoxes.reserve(_operands.size());
+    for (auto const &operand : _operands) {
+        if (!operand) {
+            throw std::invalid_argument("CompoundRegion operands must not be null.");
+        }
+        _operandBoxes.push_back(operand->getBoundingBox3d());
+        _cost += operand->getCostHint();
+    }
+    _order.resize(_operands.size());
+    std::iota(_order.begin(), _order.end(), 0);
+}
+
+void CompoundRegion::_orderOperands(bool isUnion) {
+    if (_operands.size() < 2) {
+        return;
+    }
+    // A relative selectivity floor keeps keys finite for operands that are
+    // never (or always) useful; those are evaluated last.
+    static double const minSelectivity = 1.0e-300;
+    std::vector<double> keys;
+    keys.reserve(_operands.size());
+    for (auto const &operand : _operands) {
+        double area = operand->getBoundingCircle().getArea();
+        double selectivity = isUnion ? area : 4.0 * PI - area;
+        keys.push_back(operand->getCostHint() / std::max(selectivity, minSelectivity));
+    }
+    std::stable_sort(_order.begin(), _order.end(),
+                     [&keys](std::size_t i, std::size_t j) { return keys[i] < keys[j]; });
+}
+
+std::vector<std::shared_ptr<Region const>> CompoundRegion::_share(
+    std::vector<std::unique_ptr<Region>> operands) {
+    return std::vector<std::shared_ptr<Region const>>(
+        std::make_move_iterator(operands.begin()),
+        std::make_move_iterator(operands.end()));
+}
+
+template <typename T>
+std::vector<std::shared_ptr<Region const>> CompoundRegion::_flatten(
+    std::vector<std::shared_ptr<Region const>> operands) {
+    // Operands of type T were flattened when they were constructed, so
+    // there is no need to recurse.
+    std::size_t n = 0;
+    for (auto const &operand : operands) {
+        auto const *c = dynamic_cast<T const *>(operand.get());
+        n += c ? c->nOperands() : 1;
+    }
+    if (n == operands.size()) {
+        return operands;
+    }
+    std::vector<std::shared_ptr<Region const>> result;
+    result.reserve(n);
+    for (auto &operand : operands) {
+        if (dynamic_cast<T const *>(operand.get())) {
+            auto const &nested = static_cast<CompoundRegion const &>(*operand)._operands;
+            result.insert(result.end(), nested.begin(), nested.end());
+        } else {
+            result.push_back(std::move(operand));
+        }
+    }
+    return result;
+}
 
-CompoundRegion::CompoundRegion(
-    std::array<std::unique_ptr<Region>, 2> operands) noexcept
-        : _operands(std::move(operands)) {}
+bool CompoundRegion::_boundsDisjointFrom(Box3d const &rb) const {
+    // Empty regions have empty bounds, which are disjoint from everything.
+    // Leave those cases to the exact computation, which reports all of the
+    // relationships that hold.
+    Box3d b = getBoundingBox3d();
+    return !b.isEmpty() && !rb.isEmpty() && b.isDisjointFrom(rb);
+}
 
-CompoundRegion::CompoundRegion(CompoundRegion const &other)
-        : _operands{other.getOperand(0).clone(), other.getOperand(1).clone()} {}
+bool CompoundRegion::_operandDisjointFrom(std::size_t n, Box3d const &rb) const {
+    Box3d const &b = _operandBoxes[n];
+    return !b.isEmpty() && !rb.isEmpty() && b.isDisjointFrom(rb);
+}
 
 Relationship CompoundRegion::relate(Box const &b) const { return relate(static_cast<Region const &>(b)); }
 Relationship CompoundRegion::relate(Circle const &c) const { return relate(static_cast<Region const &>(c)); }
 Relationship CompoundRegion::relate(ConvexPolygon const &p) const { return relate(static_cast<Region const &>(p)); }
 Relationship CompoundRegion::relate(Ellipse const &e) const { return relate(static_cast<Region const &>(e)); }
 
-std::vector<std::uint8_t> CompoundRegion::_encode(std::uint8_t tc) const {
-    std::vector<std::uint8_t> buffer;
+// A compound region with n operands is encoded as its type code, followed by
+// n as a u64, followed by the sizes of the n operand encodings as u64s,
+// followed by the concatenated operand encodings. The legacy binary encoding
+// is a different type code, followed by the (u64 size, encoding) pairs of two
+// operands.
+void CompoundRegion::_encode(std::uint8_t tc, std::vector<std::uint8_t> &buffer, bool compact) const {
     buffer.push_back(tc);
-    auto buffer1 = getOperand(0).encode();
-    encodeU64(buffer1.size(), buffer);
-    buffer.insert(buffer.end(), buffer1.begin(), buffer1.end());
-    auto buffer2 = getOperand(1).encode();
-    encodeU64(buffer2.size(), buffer);
-    buffer.insert(buffer.end(), buffer2.begin(), buffer2.end());
-    return buffer;
+    encodeU64(_operands.size(), buffer);
+    // Encode each operand in place after a table of placeholders for the
+    // operand sizes, and then fill in the sizes.
+    std::size_t const table = buffer.size();
+    buffer.resize(table + 8 * _operands.size());
+    for (std::size_t i = 0; i < _operands.size(); ++i) {
+        std::size_t const offset = buffer.size();
+        if (compact) {
+            _operands[i]->encodeCompactTo(buffer);
+        } else {
+            _operands[i]->encodeTo(buffer);
+        }
+        std::uint64_t const size = buffer.size() - offset;
+        for (int b = 0; b < 8; ++b) {
+            buffer[table + 8 * i + b] = static_cast<std::uint8_t>(size >> (8 * b));
+        }
+    }
 }
 
-std::array<std::unique_ptr<Region>, 2> CompoundRegion::_decode(
-    std::uint8_t tc, std::uint8_t const *buffer, std::size_t nBytes) {
-    std::uint8_t const *end = buffer + nBytes;
-    if (nBytes == 0) {
+std::vector<std::unique_ptr<Region>> CompoundRegion::_decode(
+    std::uint8_t tc, std::uint8_t legacyTc,
+    std::uint8_t const *buffer, std::size_t nBytes) {
+    if (buffer == nullptr || nBytes == 0) {
         throw std::runtime_error("Encoded CompoundRegion is truncated.");
     }
-    if (buffer[0] != tc) {
+    std::uint8_t const *end = buffer + nBytes;
+    std::vector<std::unique_ptr<Region>> result;
+    if (buffer[0] == legacyTc) {
+        ++buffer;
+        for (int i = 0; i < 2; ++i) {
+            std::uint64_t size = consumeDecodeU64(buffer, end);
+            if (size > static_cast<std::uint64_t>(end - buffer)) {
+                throw std::runtime_error("Encoded CompoundRegion is truncated.");
+            }
+            result.push_back(Region::decode(buffer, size));
+            buffer += size;
+        }
+    } else if (buffer[0] == tc) {
+        ++buffer;
+        std::uint64_t n = consumeDecodeU64(buffer, end);
+        // Each operand needs at least 8 bytes for its size.
+        if (n > static_cast<std::uint64_t>(end - buffer) / 8) {
+            throw std::runtime_error("Encoded CompoundRegion is truncated.");
+        }
+        std::uint8_t const *operand = buffer + 8 * n;
+        result.reserve(n);
+        for (std::uint64_t i = 0; i < n; ++i) {
+            std::uint64_t size = consumeDecodeU64(buffer, end);
+            if (size > static_cast<std::uint64_t>(end - operand)) {
+                throw std::runtime_error("Encoded CompoundRegion is truncated.");
+            }
+            result.push_back(Region::decode(operand, size));
+            operand += size;
+        }
+        buffer = operand;
+    } else {
         throw std::runtime_error("Byte string is not an encoded CompoundRegion.");
     }
-    ++buffer;
-    std::array<std::unique_ptr<Region>, 2> result;
-    std::uint64_t nBytes1 = consumeDecodeU64(buffer, end);
-    result[0] = Region::decode(buffer, nBytes1);
-    buffer += nBytes1;
-    std::uint64_t nBytes2 = consumeDecodeU64(buffer, end);
-    result[1] = Region::decode(buffer, nBytes2);
-    buffer += nBytes2;
     if (buffer != end) {
         throw std::runtime_error("Encoded CompoundRegion is has unexpected additional bytes.");
     }
@@ -123,73 +235,170 @@ std::unique_ptr<CompoundRegion> CompoundRegion::decode(uint8_t const *buffer, si
     }
     switch (buffer[0]) {
         case UnionRegion::TYPE_CODE:
+        case UnionRegion::LEGACY_TYPE_CODE:
             return UnionRegion::decode(buffer, n);
         case IntersectionRegion::TYPE_CODE:
+        case IntersectionRegion::LEGACY_TYPE_CODE:
             return IntersectionRegion::decode(buffer, n);
         default:
             throw std::runtime_error("Byte string is not an encoded CompoundRegion.");
     }
 }
 
+UnionRegion::UnionRegion(Region const &first, Region const &second)
+        : UnionRegion(std::array<std::unique_ptr<Region>, 2>{first.clone(), second.clone()}) {}
+
+UnionRegion::UnionRegion(std::array<std::unique_ptr<Region>, 2> operands)
+        : UnionRegion(std::vector<std::unique_ptr<Region>>(
+              std::make_move_iterator(operands.begin()),
+              std::make_move_iterator(operands.end()))) {}
+
+UnionRegion::UnionRegion(std::shared_ptr<Region const> first,
+                         std::shared_ptr<Region const> second)
+        : UnionRegion(std::vector<std::shared_ptr<Region const>>{std::move(first), std::move(second)}) {}
+
+UnionRegion::UnionRegion(std::vector<std::unique_ptr<Region>> operands)
+        : CompoundRegion(_flatten<UnionRegion>(_share(std::move(operands)))) {
+    _orderOperands(true);
+}
+
+UnionRegion::UnionRegion(std::vector<std::shared_ptr<Region const>> operands)
+        : CompoundRegion(_flatten<UnionRegion>(std::move(operands))) {
+    _orderOperands(true);
+}
+
 Box UnionRegion::getBoundingBox() const {
-    return getUnionBounds(*this, [](Region const &r) { return r.getBoundingBox(); });
+    return _bounds.getBoundingBox([this]() {
+        return getUnionBounds(*this, [](Region const &r) { return r.getBoundingBox(); });
+    });
 }
 
 Box3d UnionRegion::getBoundingBox3d() const {
-    return getUnionBounds(*this, [](Region const &r) { return r.getBoundingBox3d(); });
+    return _bounds.getBoundingBox3d([this]() {
+        return getUnionBounds(*this, [](Region const &r) { return r.getBoundingBox3d(); });
+    });
 }
 
 Circle UnionRegion::getBoundingCircle() const {
-    return getUnionBounds(*this, [](Region const &r) { return r.getBoundingCircle(); });
+    return _bounds.getBoundingCircle([this]() {
+        return getUnionBounds(*this, [](Region const &r) { return r.getBoundingCircle(); });
+    });
 }
 
 bool UnionRegion::contains(UnitVector3d const &v) const {
-    return getOperand(0).contains(v) || getOperand(1).contains(v);
+    for (std::size_t k = 0; k < nOperands(); ++k) {
+        std::size_t const i = _getEvaluationIndex(k);
+        if (_getOperandBoundingBox3d(i).contains(v) && getOperand(i).contains(v)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 Relationship UnionRegion::relate(Region const &rhs) const {
-    auto r1 = getOperand(0).relate(rhs);
-    auto r2 = getOperand(1).relate(rhs);
-    return
-        // Both operands must be disjoint with the given region for the union
-        // to be disjoint with it.
-        ((r1 & DISJOINT) & (r2 & DISJOINT))
-        // Both operands must be within the given region for the union to be
-        // within it.
-        | ((r1 & WITHIN) & (r2 & WITHIN))
-        // If either operand contains the given region, the union contains it.
-        | ((r1 & CONTAINS) | (r2 & CONTAINS));
+    Box3d const rb = rhs.getBoundingBox3d();
+    if (_boundsDisjointFrom(rb)) {
+        return DISJOINT;
+    }
+    // All operands must be disjoint with the given region for the union to
+    // be disjoint with it, and all operands must be within the given region
+    // for the union to be within it.
+    Relationship all = DISJOINT | WITHIN;
+    // If any operand contains the given region, the union contains it.
+    Relationship any;
+    for (std::size_t k = 0; k < nOperands(); ++k) {
+        std::size_t const i = _getEvaluationIndex(k);
+        Relationship r = _operandDisjointFrom(i, rb) ? DISJOINT : getOperand(i).relate(rhs);
+        all &= r;
+        any |= r & CONTAINS;
+        if (all.none() && any == CONTAINS) {
+            break;
+        }
+    }
+    return all | any;
+}
+
+IntersectionRegion::IntersectionRegion(Region const &first, Region const &second)
+        : IntersectionRegion(std::array<std::unique_ptr<Region>, 2>{first.clone(), second.clone()}) {}
+
+IntersectionRegion::IntersectionRegion(std::array<std::unique_ptr<Region>, 2> operands)
+        : IntersectionRegion(std::vector<std::unique_ptr<Region>>(
+              std::make_move_iterator(operands.begin()),
+              std::make_move_iterator(operands.end()))) {}
+
+IntersectionRegion::IntersectionRegion(std::shared_ptr<Region const> first,
+                                       std::shared_ptr<Region const> second)
+        : IntersectionRegion(std::vector<std::shared_ptr<Region const>>{std::move(first), std::move(second)}) {}
+
+IntersectionRegion::IntersectionRegion(std::vector<std::unique_ptr<Region>> operands)
+        : CompoundRegion(_flatten<IntersectionRegion>(_share(std::move(operands)))) {
+    _orderOperands(false);
+}
+
+IntersectionRegion::IntersectionRegion(std::vector<std::shared_ptr<Region const>> operands)
+        : CompoundRegion(_flatten<IntersectionRegion>(std::move(operands))) {
+    _orderOperands(false);
 }
 
 Box IntersectionRegion::getBoundingBox() const {
-    return getIntersectionBounds(*this, [](Region const &r) { return r.getBoundingBox(); });
+    return _bounds.getBoundingBox([this]() {
+        return getIntersectionBounds(*this, [](Region const &r) { return r.getBoundingBox(); },
+                                     Box::full());
+    });
 }
 
 Box3d IntersectionRegion::getBoundingBox3d() const {
-    return getIntersectionBounds(*this, [](Region const &r) { return r.getBoundingBox3d(); });
+    return _bounds.getBoundingBox3d([this]() {
+        return getIntersectionBounds(*this, [](Region const &r) { return r.getBoundingBox3d(); },
+                                     Box3d::aroundUnitSphere());
+    });
 }
 
 Circle IntersectionRegion::getBoundingCircle() const {
-    return getIntersectionBounds(*this, [](Region const &r) { return r.getBoundingCircle(); });
+    return _bounds.getBoundingCircle([this]() {
+        return getIntersectionBounds(*this, [](Region const &r) { return r.getBoundingCircle(); },
+                                     Circle::full());
+    });
 }
 
 bool IntersectionRegion::contains(UnitVector3d const &v) const {
-    return getOperand(0).contains(v) && getOperand(1).contains(v);
+    // Check all of the (cheap) operand bounding boxes before testing any
+    // of the operands themselves.
+    for (std::size_t i = 0; i < nOperands(); ++i) {
+        if (!_getOperandBoundingBox3d(i).contains(v)) {
+            return false;
+        }
+    }
+    for (std::size_t k = 0; k < nOperands(); ++k) {
+        if (!getOperand(_getEvaluationIndex(k)).contains(v)) {
+            return false;
+        }
+    }
+    return true;
 }
 
 Relationship IntersectionRegion::relate(Region const &rhs) const {
-    auto r1 = getOperand(0).relate(rhs);
-    auto r2 = getOperand(1).relate(rhs);
-    return
-        // Both operands must contain the given region for the intersection to
-        // contain it.
-        ((r1 & CONTAINS) & (r2 & CONTAINS))
-        // If either operand is disjoint with the given region, the
-        // intersection is disjoint with it.
-        | ((r1 & DISJOINT) | (r2 & DISJOINT))
-        // If either operand is within the given region, the intersection is
-        // within it.
-        | ((r1 & WITHIN) | (r2 & WITHIN));
+    Box3d const rb = rhs.getBoundingBox3d();
+    if (_boundsDisjointFrom(rb)) {
+        return DISJOINT;
+    }
+    // All operands must contain the given region for the intersection to
+    // contain it.
+    Relationship all = CONTAINS;
+    // If any operand is disjoint with the given region, the intersection is
+    // disjoint with it, and if any operand is within the given region, the
+    // intersection is within it.
+    Relationship any;
+    for (std::size_t k = 0; k < nOperands(); ++k) {
+        std::size_t const i = _getEvaluationIndex(k);
+        Relationship r = _operandDisjointFrom(i, rb) ? DISJOINT : getOperand(i).relate(rhs);
+        all &= r;
+        any |= r & (DISJOINT | WITHIN);
+        if (all.none() && any == (DISJOINT | WITHIN)) {
+            break;
+        }
+    }
+    return all | any;
 }
 
 }  // namespace sphgeom
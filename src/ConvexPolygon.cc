@@ -25,13 +25,46 @@
 
 #include "lsst/sphgeom/ConvexPolygon.h"
 
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <exception>
+#include <limits>
 #include <ostream>
+#include <queue>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+#if !defined(NO_SIMD) && defined(__x86_64__)
+    #include <x86intrin.h>
+#endif
+#if !defined(NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
 
+#include "lsst/sphgeom/UnitVector3dArray.h"
 #include "lsst/sphgeom/codec.h"
 #include "lsst/sphgeom/orientation.h"
 
+#include "CompactCodec.h"
 #include "ConvexPolygonImpl.h"
+#include "CpuDispatch.h"
+#include "Parallel.h"
+#include "PerformanceCounting.h"
+
+// The wide (AVX2) batch containment kernel is compiled with a function level
+// target attribute and selected at run time, so that a baseline x86-64 build
+// still runs on CPUs without AVX2.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define LSST_SPHGEOM_POLYGON_AVX2 1
+#endif
+
+// Advanced SIMD is part of the aarch64 baseline, so the 2-wide (NEON) kernel
+// needs no target attribute.
+#if !defined(NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+    #define LSST_SPHGEOM_POLYGON_NEON 1
+#endif
 
 
 namespace lsst {
@@ -142,10 +175,170 @@ std::vector<UnitVector3d>::iterator findTriangle(
     return ++v;
 }
 
-void computeHull(std::vector<UnitVector3d> & points) {
+// Point sets with fewer than this many points are always handled by the
+// incremental hull algorithm, which is fastest for small inputs.
+size_t const MIN_PROJECTED_HULL_SIZE = 64;
+
+// Interior point rejection is split over several threads only when each
+// thread has at least this many points to test.
+size_t const MIN_POINTS_PER_THREAD = 16384;
+
+// `discardInterior` removes points strictly inside the polygon with vertices
+// o[0], ..., o[numVertices - 1] from `points`. Because the polygon vertices are input
+// points, the hull of the remaining points is the same as the hull of the
+// original points, even if the polygon is not convex: a point strictly to
+// the left of every edge of a closed chain has a positive winding number
+// with respect to it, and so lies in the hull of its vertices.
+void discardInterior(std::vector<UnitVector3d> & points,
+                     UnitVector3d const * o,
+                     int numVertices,
+                     unsigned numThreads)
+{
+    size_t const n = points.size();
+    std::vector<char> keep(n);
+    auto work = [&points, o, numVertices, &keep](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            bool inside = true;
+            for (int j = 0, k = numVertices - 1; inside && j < numVertices;
+                 k = j, ++j) {
+                inside = orientation(o[k], o[j], points[i]) > 0;
+            }
+            keep[i] = !inside;
+        }
+    };
+    size_t numChunks = std::min<size_t>(std::max(numThreads, 1u),
+                                        n / MIN_POINTS_PER_THREAD);
+    if (numChunks <= 1) {
+        work(0, n);
+    } else {
+        detail::forEachBlock(n, (n + numChunks - 1) / numChunks,
+                             static_cast<unsigned>(numChunks), work);
+    }
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) {
+            points[m++] = points[i];
+        }
+    }
+    points.resize(m);
+}
+
+// `computeProjectedHull` computes the convex hull of a point set that lies
+// in an open hemisphere, in O(n log n) time. It returns false, leaving
+// `points` unchanged, if it cannot establish that the points lie in an open
+// hemisphere.
+//
+// Points in the open hemisphere centered on p map under the gnomonic
+// projection centered on p to points in the tangent plane at p, and great
+// circle segments map to line segments, so the problem reduces to that of
+// computing a planar convex hull. This is done with Andrew's monotone chain
+// algorithm, after discarding points inside an octagon of extreme points
+// (the Akl-Toussaint heuristic). No projected coordinates are ever compared:
+// with (e₁, e₂, p) a right-handed orthonormal basis, the projected x
+// coordinate of a is less than that of b iff orientation(a, b, e₂) > 0,
+// and the projected y coordinates of a and b (with equal x) satisfy the same
+// relationship iff orientation(a, b, e₁) < 0. All decisions are therefore
+// made with the exact orientation predicate.
+bool computeProjectedHull(std::vector<UnitVector3d> & points,
+                          unsigned numThreads)
+{
+    // Points must make an angle of less than π/2 - 10⁻¹⁰ with the center.
+    // This leaves ample room for the rounding errors in p, the dot products
+    // and the basis vectors, which are all on the order of 10⁻¹⁶.
+    static double const MIN_DOT = 1.0e-10;
+    Vector3d sum;
+    for (UnitVector3d const & v : points) {
+        sum += v;
+    }
+    if (sum.getSquaredNorm() < 1.0) {
+        return false;
+    }
+    UnitVector3d const p(sum);
+    UnitVector3d const e2 = UnitVector3d::orthogonalTo(p);
+    UnitVector3d const e1(e2.cross(p));
+    // Compute approximate projected coordinates to find extreme points in
+    // 8 directions. Only the choice of octagon vertices depends on these,
+    // so rounding error is harmless.
+    double const dirs[8][2] = {
+        {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
+    };
+    double best[8];
+    size_t extreme[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    std::fill(best, best + 8, -std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < points.size(); ++i) {
+        UnitVector3d const & v = points[i];
+        double d = v.dot(p);
+        if (!(d > MIN_DOT)) {
+            return false;
+        }
+        double x = v.dot(e1) / d;
+        double y = v.dot(e2) / d;
+        for (int j = 0; j < 8; ++j) {
+            double s = dirs[j][0] * x + dirs[j][1] * y;
+            if (s > best[j]) {
+                best[j] = s;
+                extreme[j] = i;
+            }
+        }
+    }
+    // Several directions can share an extreme point. Drop the duplicates,
+    // since no point is strictly to the left of a zero length edge.
+    UnitVector3d octagon[8];
+    int m = 0;
+    for (int j = 0; j < 8; ++j) {
+        if (m == 0 || extreme[j] != extreme[j - 1]) {
+            octagon[m++] = points[extreme[j]];
+        }
+    }
+    while (m > 1 && octagon[m - 1] == octagon[0]) {
+        --m;
+    }
+    if (m >= 3) {
+        discardInterior(points, octagon, m, numThreads);
+    }
+    // Sort by projected x, then y.
+    std::sort(points.begin(), points.end(),
+              [&e1, &e2](UnitVector3d const & a, UnitVector3d const & b) {
+                  int o = orientation(a, b, e2);
+                  return o > 0 || (o == 0 && orientation(a, b, e1) < 0);
+              });
+    // Build the lower and then the upper hull, dropping vertices that do
+    // not make strictly counter-clockwise turns.
+    size_t const n = points.size();
+    std::vector<UnitVector3d> hull(2 * n);
+    size_t k = 0;
+    for (size_t i = 0; i < n; ++i) {
+        while (k >= 2 && orientation(hull[k - 2], hull[k - 1], points[i]) <= 0) {
+            --k;
+        }
+        hull[k++] = points[i];
+    }
+    for (size_t i = n - 1, t = k + 1; i > 0; --i) {
+        while (k >= t && orientation(hull[k - 2], hull[k - 1], points[i - 1]) <= 0) {
+            --k;
+        }
+        hull[k++] = points[i - 1];
+    }
+    // The last point is a copy of the first.
+    if (k < 4) {
+        throw std::invalid_argument(NOT_ENOUGH_POINTS);
+    }
+    hull.resize(k - 1);
+    points.swap(hull);
+    return true;
+}
+
+void computeHull(std::vector<UnitVector3d> & points, unsigned numThreads) {
+    if (points.size() >= MIN_PROJECTED_HULL_SIZE &&
+        computeProjectedHull(points, numThreads)) {
+        return;
+    }
     typedef std::vector<UnitVector3d>::iterator VertexIterator;
     VertexIterator hullEnd = points.begin() + 3;
     VertexIterator const end = points.end();
+    // ccw[k] is the orientation of the point being added with respect to
+    // the edge of the current hull from vertex k to vertex k + 1.
+    std::vector<int> ccw;
     // Start with a triangular hull.
     for (VertexIterator v = findTriangle(points); v != end; ++v) {
         // Compute the hull of the current hull and v.
@@ -171,15 +364,18 @@ void computeHull(std::vector<UnitVector3d> & points) {
         // changes from counter-clockwise to clockwise or coplanar. It may
         // equal toCCW.
         VertexIterator fromCCW = hullEnd;
+        size_t const hullSize = static_cast<size_t>(hullEnd - j);
+        ccw.resize(hullSize);
+        orientationEdges(*v, &*j, ccw.data(), hullSize);
         // Compute the orientation of the first point in the current hull
         // with respect to v.
-        bool const firstCCW = orientation(*v, *i, *j) > 0;
+        bool const firstCCW = ccw[hullSize - 1] > 0;
         bool prevCCW = firstCCW;
         // Compute the orientation of points in the current hull with respect
         // to v, starting with the second point. Update toCCW / fromCCW when
         // we transition to / from counter-clockwise orientation.
         for (i = j, ++j; j != hullEnd; i = j, ++j) {
-            if (orientation(*v, *i, *j) > 0) {
+            if (ccw[i - points.begin()] > 0) {
                 if (!prevCCW) {
                     toCCW = i;
                     prevCCW = true;
@@ -249,13 +445,966 @@ void computeHull(std::vector<UnitVector3d> & points) {
 // a fast hull merging algorithm, which could then be used to implement Chan's
 // algorithm.
 
+// Edge plane normals of a polygon; see ConvexPolygon::Edges.
+using EdgeNormals = SmallVector<Vector3d, 8>;
+
+// This is the absolute error bound on the determinant computed by
+// orientation() for unit vectors; see orientation.cc.
+double const MAX_DETERMINANT_ERROR = 1.7e-15;
+
+// `containsPoint` tests whether the polygon with the given vertices and
+// edge normals contains v. Edges are classified using the floating point
+// determinant where its sign is certain, and with orientation() otherwise.
+bool containsPoint(ConvexPolygon::VertexVector const & vertices,
+                   EdgeNormals const & normals,
+                   UnitVector3d const & v)
+{
+    for (size_t i = 0, j = vertices.size() - 1; i < vertices.size(); j = i, ++i) {
+        Vector3d const & n = normals[i];
+        double d = v.x() * n.x() + v.y() * n.y() + v.z() * n.z();
+        if (d > MAX_DETERMINANT_ERROR) {
+            continue;
+        }
+        if (d < -MAX_DETERMINANT_ERROR ||
+            orientation(v, vertices[j], vertices[i]) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(LSST_SPHGEOM_POLYGON_AVX2)
+
+// `containsAvx2` tests the points (x[i], y[i], z[i]) 4 at a time, for i in
+// [0, n & ~3), and returns the number of points tested.
+//
+// Points are not normalized. The sign of v · n is invariant under positive
+// scaling of v, and |v · n| > T |v| with T = 4e-15 guarantees that the exact
+// orientation of UnitVector3d(v) has the same sign: this allows for the
+// rounding error in v · n (under 6.1e-16 |v|), and the differences between
+// v/|v| and the computed unit vector (under 6.7e-16) and between n and the
+// exact cross product of the edge vertices (under 7.7e-16). The test is
+// carried out as (v · n)² > T² |v|², so no square roots are needed. Points
+// that cannot be classified this way, including those so large or small
+// that squaring them could overflow or underflow, are passed to the exact
+// scalar code.
+__attribute__((target("avx2")))
+size_t containsAvx2(ConvexPolygon::VertexVector const & vertices,
+                    EdgeNormals const & normals,
+                    double const * x,
+                    double const * y,
+                    double const * z,
+                    bool * out,
+                    size_t n)
+{
+    __m256d const zero = _mm256_setzero_pd();
+    __m256d const t2 = _mm256_set1_pd(4.0e-15 * 4.0e-15);
+    __m256d const minNorm2 = _mm256_set1_pd(1.0e-200);
+    __m256d const maxNorm2 = _mm256_set1_pd(1.0e200);
+    size_t const m = n & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < m; i += 4) {
+        __m256d px = _mm256_loadu_pd(x + i);
+        __m256d py = _mm256_loadu_pd(y + i);
+        __m256d pz = _mm256_loadu_pd(z + i);
+        __m256d norm2 = _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(px, px), _mm256_mul_pd(py, py)),
+            _mm256_mul_pd(pz, pz));
+        __m256d threshold = _mm256_mul_pd(norm2, t2);
+        // NaN norms fail both comparisons, and so are also uncertain.
+        int uncertain = 0xf & ~_mm256_movemask_pd(_mm256_and_pd(
+            _mm256_cmp_pd(norm2, minNorm2, _CMP_GE_OQ),
+            _mm256_cmp_pd(norm2, maxNorm2, _CMP_LE_OQ)));
+        int outside = 0;
+        for (Vector3d const & e : normals) {
+            __m256d d = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(px, _mm256_set1_pd(e.x())),
+                              _mm256_mul_pd(py, _mm256_set1_pd(e.y()))),
+                _mm256_mul_pd(pz, _mm256_set1_pd(e.z())));
+            int certain = _mm256_movemask_pd(_mm256_cmp_pd(
+                _mm256_mul_pd(d, d), threshold, _CMP_GT_OQ));
+            int negative = _mm256_movemask_pd(_mm256_cmp_pd(d, zero, _CMP_LT_OQ));
+            outside |= certain & negative;
+            uncertain |= ~certain & 0xf;
+        }
+        // Points shown to be outside some edge are outside the polygon, no
+        // matter what the exact orientations of their other edges are.
+        uncertain &= ~outside;
+        for (int j = 0; j < 4; ++j) {
+            if (uncertain & (1 << j)) {
+                out[i + j] = containsPoint(
+                    vertices, normals, UnitVector3d(x[i + j], y[i + j], z[i + j]));
+            } else {
+                out[i + j] = (outside & (1 << j)) == 0;
+            }
+        }
+    }
+    return m;
+}
+
+#endif
+
+#if defined(LSST_SPHGEOM_POLYGON_NEON)
+
+// `maskBits` returns the lanes of a comparison result as a 2 bit mask.
+inline int maskBits(uint64x2_t m) {
+    return static_cast<int>((vgetq_lane_u64(m, 0) & 1) |
+                            (vgetq_lane_u64(m, 1) & 2));
+}
+
+// `containsNeon` is the 2-wide analogue of `containsAvx2`. It tests the
+// points (x[i], y[i], z[i]) for i in [0, n & ~1), using the same error
+// bound, and returns the number of points tested.
+size_t containsNeon(ConvexPolygon::VertexVector const & vertices,
+                    EdgeNormals const & normals,
+                    double const * x,
+                    double const * y,
+                    double const * z,
+                    bool * out,
+                    size_t n)
+{
+    float64x2_t const zero = vdupq_n_f64(0.0);
+    float64x2_t const t2 = vdupq_n_f64(4.0e-15 * 4.0e-15);
+    float64x2_t const minNorm2 = vdupq_n_f64(1.0e-200);
+    float64x2_t const maxNorm2 = vdupq_n_f64(1.0e200);
+    size_t const m = n & ~static_cast<size_t>(1);
+    for (size_t i = 0; i < m; i += 2) {
+        float64x2_t px = vld1q_f64(x + i);
+        float64x2_t py = vld1q_f64(y + i);
+        float64x2_t pz = vld1q_f64(z + i);
+        float64x2_t norm2 = vaddq_f64(
+            vaddq_f64(vmulq_f64(px, px), vmulq_f64(py, py)),
+            vmulq_f64(pz, pz));
+        float64x2_t threshold = vmulq_f64(norm2, t2);
+        // NaN norms fail both comparisons, and so are also uncertain.
+        int uncertain = 0x3 & ~maskBits(vandq_u64(
+            vcgeq_f64(norm2, minNorm2), vcleq_f64(norm2, maxNorm2)));
+        int outside = 0;
+        for (Vector3d const & e : normals) {
+            float64x2_t d = vaddq_f64(
+                vaddq_f64(vmulq_f64(px, vdupq_n_f64(e.x())),
+                          vmulq_f64(py, vdupq_n_f64(e.y()))),
+                vmulq_f64(pz, vdupq_n_f64(e.z())));
+            int certain = maskBits(vcgtq_f64(vmulq_f64(d, d), threshold));
+            int negative = maskBits(vcltq_f64(d, zero));
+            outside |= certain & negative;
+            uncertain |= ~certain & 0x3;
+        }
+        uncertain &= ~outside;
+        for (int j = 0; j < 2; ++j) {
+            if (uncertain & (1 << j)) {
+                out[i + j] = containsPoint(
+                    vertices, normals, UnitVector3d(x[i + j], y[i + j], z[i + j]));
+            } else {
+                out[i + j] = (outside & (1 << j)) == 0;
+            }
+        }
+    }
+    return m;
+}
+
+#endif
+
+// Polygons with at least this many vertices compute their bounding boxes
+// with `polygonBoundingBox` and `polygonBoundingBox3d`, which reuse the
+// cached edge normals and process edges several at a time. For smaller
+// polygons, the set up costs outweigh the savings.
+size_t const MIN_VERTICES_FOR_BATCH_BOUNDS = 32;
+
+// `BoundsData` holds the vertices and robust edge normals of a polygon in
+// structure of arrays form. Entry k + 1 of x, y and z is vertex k, and entry
+// 0 is the last vertex, so that edge k runs from entry k to entry k + 1.
+// Entry k of nx, ny and nz is the robust normal of edge k.
+struct BoundsData {
+    std::vector<double> x, y, z;
+    std::vector<double> nx, ny, nz;
+
+    BoundsData(ConvexPolygon::VertexVector const & vertices,
+               EdgeNormals const & robust) :
+        x(vertices.size() + 1), y(vertices.size() + 1), z(vertices.size() + 1),
+        nx(vertices.size()), ny(vertices.size()), nz(vertices.size())
+    {
+        size_t const n = vertices.size();
+        x[0] = vertices[n - 1].x();
+        y[0] = vertices[n - 1].y();
+        z[0] = vertices[n - 1].z();
+        for (size_t k = 0; k < n; ++k) {
+            x[k + 1] = vertices[k].x();
+            y[k + 1] = vertices[k].y();
+            z[k + 1] = vertices[k].z();
+            nx[k] = robust[k].x();
+            ny[k] = robust[k].y();
+            nz[k] = robust[k].z();
+        }
+    }
+};
+
+// Latitude extremum flags; see `latitudeExtremum`.
+uint8_t const MAX_LATITUDE_INSIDE = 1;
+uint8_t const MIN_LATITUDE_INSIDE = 2;
+
+// `latitudeExtremum` determines whether the maximum or minimum latitude
+// point of the great circle containing edge k lies in the edge interior,
+// exactly as detail::boundingBox does.
+inline uint8_t latitudeExtremum(BoundsData const & b, size_t k) {
+    double const nx = b.nx[k];
+    double const ny = b.ny[k];
+    double const nz = b.nz[k];
+    double const vx = -nx * nz;
+    double const vy = -ny * nz;
+    double const vz = nx * nx + ny * ny;
+    if (vx == 0.0 && vy == 0.0 && vz == 0.0) {
+        return 0;
+    }
+    double const zni = b.y[k] * nx - b.x[k] * ny;
+    double const znj = b.y[k + 1] * nx - b.x[k + 1] * ny;
+    if (zni > 0.0 && znj < 0.0) {
+        return MAX_LATITUDE_INSIDE;
+    } else if (zni < 0.0 && znj > 0.0) {
+        return MIN_LATITUDE_INSIDE;
+    }
+    return 0;
+}
+
+// `edgeExtrema` updates emin and emax with the coordinates of vertex k and
+// with the coordinate extrema of edge k lying in the edge interior, exactly
+// as detail::boundingBox3d does. `ux`, `uy` and `uz` hold the normalized
+// edge normals.
+inline void edgeExtrema(BoundsData const & b,
+                        double const * ux,
+                        double const * uy,
+                        double const * uz,
+                        size_t k,
+                        double * emin,
+                        double * emax)
+{
+    double const v[3] = { b.x[k + 1], b.y[k + 1], b.z[k + 1] };
+    double const n[3] = { ux[k], uy[k], uz[k] };
+    for (int i = 0; i < 3; ++i) {
+        emin[i] = std::min(emin[i], v[i]);
+        emax[i] = std::max(emax[i], v[i]);
+        double ni = n[i];
+        double d = std::fabs(1.0 - ni * ni);
+        if (d > 0.0) {
+            double e[3] = { n[0] * ni, n[1] * ni, n[2] * ni };
+            e[i] = -d;
+            double wx = e[1] * n[2] - e[2] * n[1];
+            double wy = e[2] * n[0] - e[0] * n[2];
+            double wz = e[0] * n[1] - e[1] * n[0];
+            double wdj = wx * b.x[k] + wy * b.y[k] + wz * b.z[k];
+            double wdk = wx * v[0] + wy * v[1] + wz * v[2];
+            if (wdj >= 0.0 && wdk <= 0.0) {
+                emin[i] = std::min(emin[i], -std::sqrt(d));
+            }
+            if (wdj <= 0.0 && wdk >= 0.0) {
+                emax[i] = std::max(emax[i], std::sqrt(d));
+            }
+        }
+    }
+}
+
+#if defined(LSST_SPHGEOM_POLYGON_AVX2)
+
+// `latitudeExtremaAvx2` computes latitudeExtremum(b, k) for 4 edges at a
+// time, for k in [0, n & ~3), and returns the number of edges processed.
+__attribute__((target("avx2")))
+size_t latitudeExtremaAvx2(BoundsData const & b, uint8_t * flags, size_t n) {
+    __m256d const zero = _mm256_setzero_pd();
+    size_t const m = n & ~static_cast<size_t>(3);
+    for (size_t k = 0; k < m; k += 4) {
+        __m256d nx = _mm256_loadu_pd(b.nx.data() + k);
+        __m256d ny = _mm256_loadu_pd(b.ny.data() + k);
+        __m256d nz = _mm256_loadu_pd(b.nz.data() + k);
+        __m256d nzero = _mm256_and_pd(
+            _mm256_and_pd(_mm256_cmp_pd(_mm256_mul_pd(nx, nz), zero, _CMP_EQ_OQ),
+                          _mm256_cmp_pd(_mm256_mul_pd(ny, nz), zero, _CMP_EQ_OQ)),
+            _mm256_cmp_pd(_mm256_add_pd(_mm256_mul_pd(nx, nx),
+                                        _mm256_mul_pd(ny, ny)),
+                          zero, _CMP_EQ_OQ));
+        __m256d zni = _mm256_sub_pd(
+            _mm256_mul_pd(_mm256_loadu_pd(b.y.data() + k), nx),
+            _mm256_mul_pd(_mm256_loadu_pd(b.x.data() + k), ny));
+        __m256d znj = _mm256_sub_pd(
+            _mm256_mul_pd(_mm256_loadu_pd(b.y.data() + k + 1), nx),
+            _mm256_mul_pd(_mm256_loadu_pd(b.x.data() + k + 1), ny));
+        int skip = _mm256_movemask_pd(nzero);
+        int maxInside = _mm256_movemask_pd(_mm256_and_pd(
+            _mm256_cmp_pd(zni, zero, _CMP_GT_OQ),
+            _mm256_cmp_pd(znj, zero, _CMP_LT_OQ))) & ~skip;
+        int minInside = _mm256_movemask_pd(_mm256_and_pd(
+            _mm256_cmp_pd(zni, zero, _CMP_LT_OQ),
+            _mm256_cmp_pd(znj, zero, _CMP_GT_OQ))) & ~skip;
+        for (int j = 0; j < 4; ++j) {
+            flags[k + j] =
+                ((maxInside >> j) & 1) ? MAX_LATITUDE_INSIDE :
+                ((minInside >> j) & 1) ? MIN_LATITUDE_INSIDE : 0;
+        }
+    }
+    return m;
+}
+
+// `edgeExtremaAvx2` performs the updates of edgeExtrema for 4 edges at a
+// time, for k in [0, n & ~3), and returns the number of edges processed.
+// Extrema are reduced with min and max, which are exact, and the remaining
+// arithmetic is carried out in the same order as in edgeExtrema, so the
+// results are identical.
+__attribute__((target("avx2")))
+size_t edgeExtremaAvx2(BoundsData const & b,
+                       double const * ux,
+                       double const * uy,
+                       double const * uz,
+                       size_t n,
+                       double * emin,
+                       double * emax)
+{
+    __m256d const zero = _mm256_setzero_pd();
+    __m256d const one = _mm256_set1_pd(1.0);
+    __m256d const signBit = _mm256_set1_pd(-0.0);
+    __m256d lo[3];
+    __m256d hi[3];
+    for (int i = 0; i < 3; ++i) {
+        lo[i] = _mm256_set1_pd(emin[i]);
+        hi[i] = _mm256_set1_pd(emax[i]);
+    }
+    size_t const m = n & ~static_cast<size_t>(3);
+    for (size_t k = 0; k < m; k += 4) {
+        __m256d const vj[3] = { _mm256_loadu_pd(b.x.data() + k),
+                                _mm256_loadu_pd(b.y.data() + k),
+                                _mm256_loadu_pd(b.z.data() + k) };
+        __m256d const vk[3] = { _mm256_loadu_pd(b.x.data() + k + 1),
+                                _mm256_loadu_pd(b.y.data() + k + 1),
+                                _mm256_loadu_pd(b.z.data() + k + 1) };
+        __m256d const u[3] = { _mm256_loadu_pd(ux + k),
+                               _mm256_loadu_pd(uy + k),
+                               _mm256_loadu_pd(uz + k) };
+        for (int i = 0; i < 3; ++i) {
+            lo[i] = _mm256_min_pd(lo[i], vk[i]);
+            hi[i] = _mm256_max_pd(hi[i], vk[i]);
+            __m256d ni = u[i];
+            __m256d d = _mm256_andnot_pd(
+                signBit, _mm256_sub_pd(one, _mm256_mul_pd(ni, ni)));
+            __m256d e[3] = { _mm256_mul_pd(u[0], ni),
+                             _mm256_mul_pd(u[1], ni),
+                             _mm256_mul_pd(u[2], ni) };
+            e[i] = _mm256_xor_pd(d, signBit);
+            __m256d wx = _mm256_sub_pd(_mm256_mul_pd(e[1], u[2]),
+                                       _mm256_mul_pd(e[2], u[1]));
+            __m256d wy = _mm256_sub_pd(_mm256_mul_pd(e[2], u[0]),
+                                       _mm256_mul_pd(e[0], u[2]));
+            __m256d wz = _mm256_sub_pd(_mm256_mul_pd(e[0], u[1]),
+                                       _mm256_mul_pd(e[1], u[0]));
+            __m256d wdj = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(wx, vj[0]), _mm256_mul_pd(wy, vj[1])),
+                _mm256_mul_pd(wz, vj[2]));
+            __m256d wdk = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(wx, vk[0]), _mm256_mul_pd(wy, vk[1])),
+                _mm256_mul_pd(wz, vk[2]));
+            __m256d positive = _mm256_cmp_pd(d, zero, _CMP_GT_OQ);
+            __m256d s = _mm256_sqrt_pd(d);
+            __m256d toMin = _mm256_and_pd(
+                positive, _mm256_and_pd(_mm256_cmp_pd(wdj, zero, _CMP_GE_OQ),
+                                        _mm256_cmp_pd(wdk, zero, _CMP_LE_OQ)));
+            __m256d toMax = _mm256_and_pd(
+                positive, _mm256_and_pd(_mm256_cmp_pd(wdj, zero, _CMP_LE_OQ),
+                                        _mm256_cmp_pd(wdk, zero, _CMP_GE_OQ)));
+            lo[i] = _mm256_blendv_pd(
+                lo[i], _mm256_min_pd(lo[i], _mm256_xor_pd(s, signBit)), toMin);
+            hi[i] = _mm256_blendv_pd(hi[i], _mm256_max_pd(hi[i], s), toMax);
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        double l[4];
+        double h[4];
+        _mm256_storeu_pd(l, lo[i]);
+        _mm256_storeu_pd(h, hi[i]);
+        for (int j = 0; j < 4; ++j) {
+            emin[i] = std::min(emin[i], l[j]);
+            emax[i] = std::max(emax[i], h[j]);
+        }
+    }
+    return m;
+}
+
+#endif
+
+// `orientationSign` returns the sign of the 2x2 determinant computed by
+// orientationX, orientationY or orientationZ for vertices a and b, given the
+// corresponding component det of the cached cross product of a and b. The
+// exact predicate is only evaluated when the sign of det is uncertain.
+template <typename Orientation>
+inline int orientationSign(double det,
+                           UnitVector3d const & a,
+                           UnitVector3d const & b,
+                           Orientation orientation)
+{
+    if (det > MAX_DETERMINANT_ERROR) {
+        return 1;
+    } else if (det < -MAX_DETERMINANT_ERROR) {
+        return -1;
+    }
+    return orientation(a, b);
+}
+
+// `polygonBoundingBox` computes the same box as detail::boundingBox, using
+// the cached cross products and robust normals of the polygon edges.
+Box polygonBoundingBox(ConvexPolygon::VertexVector const & vertices,
+                       EdgeNormals const & cross,
+                       EdgeNormals const & robust)
+{
+    Angle const eps(5.0e-10);
+    size_t const n = vertices.size();
+    Box bbox;
+    for (UnitVector3d const & v: vertices) {
+        bbox.expandTo(Box(LonLat(v), eps, eps));
+    }
+    bool haveCW = false;
+    bool haveCCW = false;
+    for (size_t k = 0, j = n - 1; k < n && !(haveCW && haveCCW); j = k, ++k) {
+        int o = orientationSign(cross[k].z(), vertices[j], vertices[k],
+                                orientationZ);
+        haveCCW = haveCCW || (o > 0);
+        haveCW = haveCW || (o < 0);
+    }
+    // Latitude intervals are merged by taking their union, so the order in
+    // which the vertex and edge latitude extrema are added is immaterial.
+    BoundsData const b(vertices, robust);
+    std::vector<uint8_t> flags(n);
+    size_t k = 0;
+#if defined(LSST_SPHGEOM_POLYGON_AVX2)
+    if (detail::hasAvx2()) {
+        k = latitudeExtremaAvx2(b, flags.data(), n);
+    }
+#endif
+    for (; k < n; ++k) {
+        flags[k] = latitudeExtremum(b, k);
+    }
+    AngleInterval lat = bbox.getLat();
+    for (k = 0; k < n; ++k) {
+        if (flags[k] == 0) {
+            continue;
+        }
+        Vector3d const & nk = robust[k];
+        Vector3d v(-nk.x() * nk.z(),
+                   -nk.y() * nk.z(),
+                   nk.x() * nk.x() + nk.y() * nk.y());
+        if (flags[k] == MAX_LATITUDE_INSIDE) {
+            lat.expandTo(LonLat::latitudeOf(v) + eps);
+        } else {
+            lat.expandTo(LonLat::latitudeOf(-v) - eps);
+        }
+    }
+    bbox = Box(bbox.getLon(), lat);
+    if (!haveCW) {
+        Box northPole(Box::allLongitudes(), AngleInterval(Angle(0.5 * PI)));
+        bbox.expandTo(northPole);
+    } else if (!haveCCW) {
+        Box southPole(Box::allLongitudes(), AngleInterval(Angle(-0.5 * PI)));
+        bbox.expandTo(southPole);
+    }
+    return bbox;
+}
+
+// `polygonBoundingBox3d` computes the same box as detail::boundingBox3d,
+// using the cached cross products and robust normals of the polygon edges.
+Box3d polygonBoundingBox3d(ConvexPolygon::VertexVector const & vertices,
+                           EdgeNormals const & cross,
+                           EdgeNormals const & robust)
+{
+    static double const maxError = 1.0e-14;
+    size_t const n = vertices.size();
+    BoundsData const b(vertices, robust);
+    std::vector<double> u(3 * n);
+    double * ux = u.data();
+    double * uy = ux + n;
+    double * uz = uy + n;
+    UnitVector3dArray::normalize(b.nx.data(), b.ny.data(), b.nz.data(),
+                                 ux, uy, uz, n);
+    double emin[3] = { b.x[1], b.y[1], b.z[1] };
+    double emax[3] = { b.x[1], b.y[1], b.z[1] };
+    size_t k = 0;
+#if defined(LSST_SPHGEOM_POLYGON_AVX2)
+    if (detail::hasAvx2()) {
+        k = edgeExtremaAvx2(b, ux, uy, uz, n, emin, emax);
+    }
+#endif
+    for (; k < n; ++k) {
+        edgeExtrema(b, ux, uy, uz, k, emin, emax);
+    }
+    bool a[3] = { true, true, true };
+    bool c[3] = { true, true, true };
+    size_t j = n - 1;
+    for (k = 0; k < n; j = k, ++k) {
+        UnitVector3d const & vj = vertices[j];
+        UnitVector3d const & vk = vertices[k];
+        int ox = orientationSign(cross[k].x(), vj, vk, orientationX);
+        a[0] = a[0] && (ox <= 0);
+        c[0] = c[0] && (ox >= 0);
+        int oy = orientationSign(cross[k].y(), vj, vk, orientationY);
+        a[1] = a[1] && (oy <= 0);
+        c[1] = c[1] && (oy >= 0);
+        int oz = orientationSign(cross[k].z(), vj, vk, orientationZ);
+        a[2] = a[2] && (oz <= 0);
+        c[2] = c[2] && (oz >= 0);
+    }
+    for (int i = 0; i < 3; ++i) {
+        emin[i] = a[i] ? -1.0 : std::max(-1.0, emin[i] - maxError);
+        emax[i] = c[i] ? 1.0 : std::min(1.0, emax[i] + maxError);
+    }
+    return Box3d(Interval1d(emin[0], emax[0]),
+                 Interval1d(emin[1], emax[1]),
+                 Interval1d(emin[2], emax[2]));
+}
+
+// `chordsDisjoint` is a cheap, conservative version of Circle::isDisjointFrom
+// for two non-empty circles. Chord lengths obey the triangle inequality, so
+// the circles are disjoint if the chord between their centers is longer than
+// the sum of their chord radii. The margin covers rounding errors, which are
+// a few ε at most.
+bool chordsDisjoint(Circle const & a, Circle const & b) {
+    double d2 = (a.getCenter() - b.getCenter()).getSquaredNorm();
+    double r = std::sqrt(a.getSquaredChordLength()) +
+               std::sqrt(b.getSquaredChordLength());
+    return d2 > r * r * (1.0 + 1.0e-14) + 1.0e-28;
+}
+
+// `checkTrustedVertices` throws if the given vertices do not form a convex
+// polygon in counter-clockwise order: every vertex must be strictly inside
+// the great circles of all edges it is not an endpoint of.
+void checkTrustedVertices(ConvexPolygon::VertexVector const & vertices) {
+    size_t const n = vertices.size();
+    if (n < 3) {
+        throw std::invalid_argument("A convex polygon has at least 3 vertices");
+    }
+    for (size_t i = n - 1, j = 0; j < n; i = j, ++j) {
+        for (size_t k = 0; k < n; ++k) {
+            if (k != i && k != j &&
+                orientation(vertices[k], vertices[i], vertices[j]) <= 0) {
+                throw std::invalid_argument(
+                    "Vertices do not form a counter-clockwise convex polygon");
+            }
+        }
+    }
+}
+
+// Edges are moved outward by this angle in radians before the vertices of a
+// polygon are quantized by its compact encoding. It is more than twice the
+// quantization error, so that the quantized polygon contains the original
+// unless an edge is too short for the displacements to be negligible.
+double const COMPACT_EDGE_OFFSET = 1.0e-9;
+
+// `encodeCompactVertices` moves every edge of the polygon with the given
+// vertices and robust edge normals outward by COMPACT_EDGE_OFFSET, and
+// appends the quantized vertices of the resulting polygon to buffer. It
+// returns false, leaving buffer unchanged, unless the decoded vertices form
+// a convex polygon containing the original one.
+bool encodeCompactVertices(ConvexPolygon::VertexVector const & vertices,
+                           EdgeNormals const & robust,
+                           std::vector<uint8_t> & buffer)
+{
+    size_t const n = vertices.size();
+    size_t const start = buffer.size();
+    double const s = std::sin(COMPACT_EDGE_OFFSET);
+    ConvexPolygon::VertexVector quantized;
+    quantized.reserve(n);
+    for (size_t k = 0; k < n; ++k) {
+        // Vertex k is shared by edges k and k + 1, with inward unit normals
+        // n1 and n2. Moving it to v = (p - t (n1 + n2)) / |p - t (n1 + n2)|,
+        // where v · n1 = v · n2 = -sin δ, displaces both edges by δ.
+        UnitVector3d n1(robust[k]);
+        UnitVector3d n2(robust[(k + 1) % n]);
+        double c = n1.dot(n2);
+        double d = (1.0 + c) * (1.0 + c - 2.0 * s * s);
+        if (!(d > 0.0)) {
+            buffer.resize(start);
+            return false;
+        }
+        UnitVector3d v(vertices[k] - (n1 + n2) * (s / std::sqrt(d)));
+        detail::encodeQuantized(v, buffer);
+        quantized.push_back(detail::decodeQuantized(
+            buffer.data() + buffer.size() - detail::QUANTIZED_VECTOR_SIZE));
+    }
+    // A convex polygon contains another if it contains all of its vertices.
+    try {
+        checkTrustedVertices(quantized);
+    } catch (std::invalid_argument const &) {
+        buffer.resize(start);
+        return false;
+    }
+    EdgeNormals cross;
+    cross.reserve(n);
+    for (size_t k = 0, j = n - 1; k < n; j = k, ++k) {
+        cross.push_back(quantized[j].cross(quantized[k]));
+    }
+    for (UnitVector3d const & v: vertices) {
+        if (!containsPoint(quantized, cross, v)) {
+            buffer.resize(start);
+            return false;
+        }
+    }
+    return true;
+}
+
+// `VertexRing` is a doubly linked ring of polygon vertices, from which
+// vertices can be removed in constant time. The vertex removed by
+// simplifyInner or the edge removed by simplifyOuter is chosen using
+// a priority queue of candidates, each tagged with the version of its
+// first vertex at the time it was queued, so that candidates invalidated
+// by later removals are recognized and skipped.
+struct VertexRing {
+    struct Candidate {
+        double cost;
+        size_t vertex;
+        uint64_t version;
+
+        bool operator<(Candidate const & c) const { return cost > c.cost; }
+    };
+
+    std::vector<UnitVector3d> vertices;
+    std::vector<size_t> prev;
+    std::vector<size_t> next;
+    std::vector<uint64_t> version;
+    std::priority_queue<Candidate> queue;
+    size_t size;
+
+    explicit VertexRing(ConvexPolygon::VertexVector const & v) :
+        vertices(v.begin(), v.end()),
+        prev(v.size()),
+        next(v.size()),
+        version(v.size(), 0),
+        size(v.size())
+    {
+        for (size_t i = 0; i < size; ++i) {
+            prev[i] = (i + size - 1) % size;
+            next[i] = (i + 1) % size;
+        }
+    }
+
+    void remove(size_t i) {
+        next[prev[i]] = next[i];
+        prev[next[i]] = prev[i];
+        --size;
+    }
+
+    bool isCurrent(Candidate const & c) const {
+        return c.version == version[c.vertex];
+    }
+
+    // `result` returns the remaining vertices in counter-clockwise order,
+    // starting with the remaining vertex of lowest index.
+    ConvexPolygon::VertexVector result(size_t start) const {
+        ConvexPolygon::VertexVector v;
+        v.reserve(size);
+        size_t i = start;
+        do {
+            v.push_back(vertices[i]);
+            i = next[i];
+        } while (i != start);
+        return v;
+    }
+};
+
+// `triangleCost` measures the area of the triangle with the given vertices
+// by the magnitude of the cross product of two of its chords.
+double triangleCost(Vector3d const & a, Vector3d const & b,
+                    Vector3d const & c) {
+    return (b - a).cross(c - a).getNorm();
+}
+
+// `simplifyInner` removes vertices from a polygon until at most
+// `maxVertices` are left. The convex hull of a subset of the vertices of a
+// convex polygon is contained in it, so each step removes the vertex that
+// cuts off the smallest triangle.
+ConvexPolygon::VertexVector simplifyInner(
+    ConvexPolygon::VertexVector const & vertices, size_t maxVertices)
+{
+    VertexRing ring(vertices);
+    auto push = [&ring](size_t i) {
+        ring.queue.push(VertexRing::Candidate{
+            triangleCost(ring.vertices[ring.prev[i]], ring.vertices[i],
+                         ring.vertices[ring.next[i]]),
+            i, ring.version[i]});
+    };
+    for (size_t i = 0; i < ring.size; ++i) {
+        push(i);
+    }
+    size_t start = 0;
+    while (ring.size > maxVertices) {
+        VertexRing::Candidate c = ring.queue.top();
+        ring.queue.pop();
+        if (!ring.isCurrent(c)) {
+            continue;
+        }
+        size_t const i = c.vertex;
+        size_t const p = ring.prev[i];
+        size_t const n = ring.next[i];
+        ring.remove(i);
+        ++ring.version[i];
+        ++ring.version[p];
+        ++ring.version[n];
+        push(p);
+        push(n);
+        if (i == start) {
+            start = n;
+        }
+    }
+    return ring.result(start);
+}
+
+// The edges meeting at a vertex created by simplifyOuter are moved outward
+// by this angle in radians.
+double const SIMPLIFIED_EDGE_OFFSET = 1.0e-12;
+
+// `simplifyOuter` removes edges from a polygon until at most `maxVertices`
+// vertices are left, or no edge can be removed. Removing the edge from
+// vertex a to vertex b extends the edges ending at a and starting at b
+// until they meet at a point x outside of the polygon, replacing a and b
+// with x. This is only possible if those edges converge, and each step
+// removes the edge for which the added triangle (a, x, b) is smallest.
+// The edges meeting at x are moved outward slightly, and removals that
+// would not leave a and b strictly inside them are skipped. The caller
+// should nevertheless verify that the result contains the original polygon.
+ConvexPolygon::VertexVector simplifyOuter(
+    ConvexPolygon::VertexVector const & vertices, size_t maxVertices)
+{
+    VertexRing ring(vertices);
+    std::vector<UnitVector3d> apex(ring.size);
+    double const offset = std::sin(SIMPLIFIED_EDGE_OFFSET);
+    // `push` queues the removal of the edge starting at vertex i, if the
+    // edges adjacent to it converge.
+    auto push = [&ring, &apex, offset](size_t i) {
+        ++ring.version[i];
+        size_t const b = ring.next[i];
+        size_t const p = ring.prev[i];
+        size_t const q = ring.next[b];
+        if (p == b || q == i || ring.next[q] == i) {
+            // A triangle has no edge that can be removed.
+            return;
+        }
+        UnitVector3d const & va = ring.vertices[i];
+        UnitVector3d const & vb = ring.vertices[b];
+        UnitVector3d const & vp = ring.vertices[p];
+        UnitVector3d const & vq = ring.vertices[q];
+        Vector3d const n1 = vp.robustCross(va);
+        Vector3d const n2 = vb.robustCross(vq);
+        Vector3d x = n1.cross(n2);
+        if (x.dot(va + vb) < 0.0) {
+            x = -x;
+        }
+        double const n = x.getSquaredNorm() * n1.getSquaredNorm() *
+                         n2.getSquaredNorm();
+        if (!(n > 0.0) || !std::isfinite(n)) {
+            return;
+        }
+        // The edges from p to the apex and from the apex to q are moved
+        // outward by SIMPLIFIED_EDGE_OFFSET (as in encodeCompactVertices),
+        // so that a and b end up strictly inside them despite rounding.
+        UnitVector3d const u1(n1);
+        UnitVector3d const u2(n2);
+        double const c = u1.dot(u2);
+        double const d = (1.0 + c) * (1.0 + c - 2.0 * offset * offset);
+        if (!(d > 0.0)) {
+            return;
+        }
+        UnitVector3d v(UnitVector3d(x) - (u1 + u2) * (offset / std::sqrt(d)));
+        if (v.dot(va) <= 0.0 || v.dot(vb) <= 0.0 ||
+            orientation(v, va, vb) >= 0 ||
+            orientation(vp, v, vq) <= 0 ||
+            orientation(va, vp, v) <= 0 ||
+            orientation(vb, v, vq) <= 0) {
+            return;
+        }
+        apex[i] = v;
+        ring.queue.push(VertexRing::Candidate{
+            triangleCost(va, v, vb), i, ring.version[i]});
+    };
+    for (size_t i = 0; i < ring.size; ++i) {
+        push(i);
+    }
+    size_t start = 0;
+    while (ring.size > maxVertices && !ring.queue.empty()) {
+        VertexRing::Candidate c = ring.queue.top();
+        ring.queue.pop();
+        if (!ring.isCurrent(c)) {
+            continue;
+        }
+        // Vertex a is replaced by the apex, and vertex b is removed.
+        size_t const a = c.vertex;
+        size_t const b = ring.next[a];
+        ring.vertices[a] = apex[a];
+        ring.remove(b);
+        ++ring.version[b];
+        if (b == start) {
+            start = a;
+        }
+        // The edges whose removal involves the apex must be requeued.
+        size_t const p = ring.prev[a];
+        push(ring.prev[p]);
+        push(p);
+        push(a);
+        push(ring.next[a]);
+    }
+    return ring.result(start);
+}
+
+// Corners are rounded with vertices at most this far apart in azimuth
+// around the corner.
+constexpr double MAX_DILATION_CORNER_ANGLE = 0.25 * PI;
+
+// The computed vertices of a dilated polygon lie within a few ulps of their
+// intended positions, far less than this margin (in radians).
+constexpr double DILATION_MARGIN = 1.0e-14;
+
+// `dilate` returns points whose convex hull contains all points within
+// angle r of the convex polygon with the given vertices. Each vertex v is
+// replaced by points at angle R from v, in directions spanning the exterior
+// angle at v, from the outward normal of the edge ending at v to the
+// outward normal of the edge starting at v.
+//
+// Since consecutive points share an offset direction at the ends of each
+// edge, the hull edge between them lies at least R outside the great circle
+// of the edge. Around a corner, a great circle arc joining two points at
+// angle R from v, separated by azimuth θ, comes within angle d of v, where
+// tan d = tan R cos(θ / 2). Choosing R so that d ≥ r for θ no greater than
+// MAX_DILATION_CORNER_ANGLE makes the hull contain the rounded corners as
+// well.
+std::vector<UnitVector3d> dilate(ConvexPolygon::VertexVector const & vertices,
+                                 double r)
+{
+    double const maxStep = MAX_DILATION_CORNER_ANGLE;
+    double const R = std::atan(std::tan(r) / std::cos(0.5 * maxStep)) +
+                     DILATION_MARGIN;
+    double const cosR = std::cos(R);
+    double const sinR = std::sin(R);
+    size_t const n = vertices.size();
+    std::vector<UnitVector3d> points;
+    points.reserve(n * 5);
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d const & u = vertices[(i + n - 1) % n];
+        UnitVector3d const & v = vertices[i];
+        UnitVector3d const & w = vertices[(i + 1) % n];
+        // The outward normals of the edges (u, v) and (v, w), which are
+        // tangent to the sphere at v.
+        Vector3d a = -UnitVector3d(u.robustCross(v));
+        Vector3d b = -UnitVector3d(v.robustCross(w));
+        double const exterior = std::atan2(a.cross(b).getNorm(), a.dot(b));
+        int const steps = std::max(
+            1, static_cast<int>(std::ceil(exterior / maxStep)));
+        points.push_back(UnitVector3d(cosR * v + sinR * a));
+        if (steps > 1) {
+            UnitVector3d t(b - a.dot(b) * a);
+            for (int k = 1; k < steps; ++k) {
+                double const theta = exterior * k / steps;
+                Vector3d d = std::cos(theta) * a + std::sin(theta) * t;
+                points.push_back(UnitVector3d(cosR * v + sinR * d));
+            }
+        }
+        points.push_back(UnitVector3d(cosR * v + sinR * b));
+    }
+    return points;
+}
+
 } // unnamed namespace
 
+struct ConvexPolygon::Edges {
+    // Edge k runs from vertex k - 1 (mod the vertex count) to vertex k.
+    //
+    // `cross[k]` is computed exactly as orientation(v, a, b) computes the
+    // cross product of the edge vertices a and b, so that v · cross[k]
+    // reproduces its first, floating point determinant bit for bit.
+    // `robust[k]` is a.robustCross(b).
+    EdgeNormals cross;
+    EdgeNormals robust;
+
+    explicit Edges(VertexVector const & vertices) {
+        cross.reserve(vertices.size());
+        robust.reserve(vertices.size());
+        for (size_t k = 0, j = vertices.size() - 1; k < vertices.size(); j = k, ++k) {
+            UnitVector3d const & a = vertices[j];
+            UnitVector3d const & b = vertices[k];
+            cross.push_back(Vector3d(a.y() * b.z() - a.z() * b.y(),
+                                     a.z() * b.x() - a.x() * b.z(),
+                                     a.x() * b.y() - a.y() * b.x()));
+            robust.push_back(a.robustCross(b));
+        }
+    }
+};
+
+
+ConvexPolygon::ConvexPolygon(ConvexPolygon const & p) :
+    Region(p),
+    _vertices(p._vertices),
+    _bounds(p._bounds)
+{}
+
+ConvexPolygon::ConvexPolygon(ConvexPolygon && p) noexcept :
+    Region(std::move(p)),
+    _vertices(std::move(p._vertices)),
+    _bounds(p._bounds),
+    _edges(p._edges.exchange(nullptr, std::memory_order_relaxed))
+{}
+
+ConvexPolygon & ConvexPolygon::operator=(ConvexPolygon const & p) {
+    if (this != &p) {
+        _vertices = p._vertices;
+        _bounds = p._bounds;
+        delete _edges.exchange(nullptr, std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+ConvexPolygon & ConvexPolygon::operator=(ConvexPolygon && p) noexcept {
+    if (this != &p) {
+        _vertices = std::move(p._vertices);
+        _bounds = p._bounds;
+        delete _edges.exchange(
+            p._edges.exchange(nullptr, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+ConvexPolygon::~ConvexPolygon() {
+    delete _edges.load(std::memory_order_relaxed);
+}
+
+ConvexPolygon::Edges const & ConvexPolygon::_getEdges() const {
+    Edges const * edges = _edges.load(std::memory_order_acquire);
+    if (edges == nullptr) {
+        // Threads racing to compute the normals each do so, and exactly
+        // one of them publishes its result.
+        Edges const * e = new Edges(_vertices);
+        if (_edges.compare_exchange_strong(edges, e,
+                                           std::memory_order_acq_rel,
+                                           std::memory_order_acquire)) {
+            edges = e;
+        } else {
+            delete e;
+        }
+    }
+    return *edges;
+}
+
+ConvexPolygon::ConvexPolygon(std::vector<UnitVector3d> const & points,
+                             unsigned numThreads) {
+    std::vector<UnitVector3d> hull(points);
+    computeHull(hull, numThreads);
+    _vertices.assign(hull.begin(), hull.end());
+}
 
-ConvexPolygon::ConvexPolygon(std::vector<UnitVector3d> const & points) :
-    _vertices(points)
+ConvexPolygon::ConvexPolygon(VertexVector && vertices) :
+    _vertices(std::move(vertices))
 {
-    computeHull(_vertices);
+#ifndef NDEBUG
+    checkTrustedVertices(_vertices);
+#endif
+}
+
+ConvexPolygon ConvexPolygon::fromTrustedVertices(std::vector<UnitVector3d> vertices) {
+    return ConvexPolygon(VertexVector(std::move(vertices)));
+}
+
+ConvexPolygon ConvexPolygon::fromTrustedVertices(UnitVector3d const * vertices,
+                                                 size_t n) {
+    return ConvexPolygon(VertexVector(vertices, vertices + n));
 }
 
 bool ConvexPolygon::operator==(ConvexPolygon const & p) const {
@@ -293,24 +1442,204 @@ bool ConvexPolygon::operator==(ConvexPolygon const & p) const {
     return true;
 }
 
+ConvexPolygon ConvexPolygon::simplifiedInner(size_t maxVertices) const {
+    if (maxVertices < 3) {
+        throw std::invalid_argument(
+            "A convex polygon has at least 3 vertices");
+    }
+    if (_vertices.size() <= maxVertices) {
+        return *this;
+    }
+    return ConvexPolygon(simplifyInner(_vertices, maxVertices));
+}
+
+ConvexPolygon ConvexPolygon::simplifiedOuter(size_t maxVertices) const {
+    if (maxVertices < 3) {
+        throw std::invalid_argument(
+            "A convex polygon has at least 3 vertices");
+    }
+    if (_vertices.size() <= maxVertices) {
+        return *this;
+    }
+    VertexVector vertices = simplifyOuter(_vertices, maxVertices);
+    if (vertices.size() == _vertices.size()) {
+        return *this;
+    }
+    // A convex polygon contains another if it contains all of its vertices.
+    // If rounding error broke that guarantee, this polygon is returned.
+    try {
+        checkTrustedVertices(vertices);
+    } catch (std::invalid_argument const &) {
+        return *this;
+    }
+    EdgeNormals cross;
+    cross.reserve(vertices.size());
+    for (size_t k = 0, j = vertices.size() - 1; k < vertices.size(); j = k, ++k) {
+        cross.push_back(vertices[j].cross(vertices[k]));
+    }
+    for (UnitVector3d const & v: _vertices) {
+        if (!containsPoint(vertices, cross, v)) {
+            return *this;
+        }
+    }
+    return ConvexPolygon(std::move(vertices));
+}
+
 UnitVector3d ConvexPolygon::getCentroid() const {
     return detail::centroid(_vertices.begin(), _vertices.end());
 }
 
+ConvexPolygon ConvexPolygon::dilatedBy(Angle r) const {
+    double const radians = r.asRadians();
+    if (!(radians >= 0.0)) {
+        throw std::invalid_argument(
+            "Convex polygons can only be dilated by a non-negative angle");
+    }
+    if (radians == 0.0) {
+        return *this;
+    }
+    // The points of the dilated polygon lie within r / cos(π/8), plus a
+    // tiny margin, of the vertices. Require them to fit in an open
+    // hemisphere with some room to spare for rounding error.
+    Circle c = getBoundingCircle();
+    double const reach = c.getOpeningAngle().asRadians() +
+        std::atan(std::tan(radians) / std::cos(0.5 * MAX_DILATION_CORNER_ANGLE));
+    if (!(radians < 0.5 * PI) || !(reach < 0.5 * PI - MAX_ASIN_ERROR)) {
+        throw std::invalid_argument(
+            "The dilated polygon does not fit in a hemisphere");
+    }
+    return ConvexPolygon(dilate(_vertices, radians));
+}
+
+double ConvexPolygon::getArea() const {
+    return detail::area(_vertices.begin(), _vertices.end());
+}
+
 Circle ConvexPolygon::getBoundingCircle() const {
-    return detail::boundingCircle(_vertices.begin(), _vertices.end());
+    return _bounds.getBoundingCircle([this]() {
+        return detail::boundingCircle(_vertices.begin(), _vertices.end());
+    });
 }
 
 Box ConvexPolygon::getBoundingBox() const {
-    return detail::boundingBox(_vertices.begin(), _vertices.end());
+    return _bounds.getBoundingBox([this]() {
+        if (_vertices.size() >= MIN_VERTICES_FOR_BATCH_BOUNDS) {
+            Edges const & edges = _getEdges();
+            return polygonBoundingBox(_vertices, edges.cross, edges.robust);
+        }
+        return detail::boundingBox(_vertices.begin(), _vertices.end());
+    });
 }
 
 Box3d ConvexPolygon::getBoundingBox3d() const {
-    return detail::boundingBox3d(_vertices.begin(), _vertices.end());
+    return _bounds.getBoundingBox3d([this]() {
+        if (_vertices.size() >= MIN_VERTICES_FOR_BATCH_BOUNDS) {
+            Edges const & edges = _getEdges();
+            return polygonBoundingBox3d(_vertices, edges.cross, edges.robust);
+        }
+        return detail::boundingBox3d(_vertices.begin(), _vertices.end());
+    });
 }
 
 bool ConvexPolygon::contains(UnitVector3d const & v) const {
-    return detail::contains(_vertices.begin(), _vertices.end(), v);
+    return containsPoint(_vertices, _getEdges().cross, v);
+}
+
+void ConvexPolygon::contains(double const * x,
+                             double const * y,
+                             double const * z,
+                             bool * out,
+                             size_t n) const
+{
+    EdgeNormals const & normals = _getEdges().cross;
+    size_t i = 0;
+#if defined(LSST_SPHGEOM_POLYGON_AVX2)
+    if (detail::hasAvx2()) {
+        i = containsAvx2(_vertices, normals, x, y, z, out, n);
+    }
+#elif defined(LSST_SPHGEOM_POLYGON_NEON)
+    if (detail::hasNeon()) {
+        i = containsNeon(_vertices, normals, x, y, z, out, n);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = containsPoint(_vertices, normals,
+                               UnitVector3d(x[i], y[i], z[i]));
+    }
+}
+
+void ConvexPolygon::sample(size_t n, std::mt19937_64 & rng,
+                           double * x, double * y, double * z) const
+{
+    // Candidates outside the polygon due to rounding are redrawn this many
+    // times before being accepted anyway.
+    static constexpr int MAX_ATTEMPTS = 64;
+    // Points are drawn uniformly from the gnomonic projection of a fan
+    // triangle about its center m, where it is a planar triangle, and
+    // accepted with probability |p|⁻³ (the ratio of sphere to plane area
+    // elements at p). Since p·m = 1 the acceptance rate is at least 1/8 for
+    // triangles with vertices within 60° of m; larger triangles are split
+    // in four first.
+    struct Triangle { Vector3d a, ab, ac; };
+    std::vector<Triangle> triangles;
+    std::vector<double> cumulativeArea;
+    double totalArea = 0.0;
+    std::vector<std::array<UnitVector3d, 3>> pending;
+    for (size_t i = 2; i < _vertices.size(); ++i) {
+        pending.push_back({_vertices[0], _vertices[i - 1], _vertices[i]});
+    }
+    while (!pending.empty()) {
+        std::array<UnitVector3d, 3> t = pending.back();
+        pending.pop_back();
+        UnitVector3d m(t[0] + t[1] + t[2]);
+        double d0 = m.dot(t[0]), d1 = m.dot(t[1]), d2 = m.dot(t[2]);
+        if (std::min({d0, d1, d2}) < 0.5) {
+            UnitVector3d m01(t[0] + t[1]), m12(t[1] + t[2]), m20(t[2] + t[0]);
+            pending.push_back({t[0], m01, m20});
+            pending.push_back({m01, t[1], m12});
+            pending.push_back({m20, m12, t[2]});
+            pending.push_back({m01, m12, m20});
+            continue;
+        }
+        // The area E of a spherical triangle satisfies
+        // tan(E/2) = |a·(b×c)| / (1 + a·b + b·c + c·a).
+        double area = 2.0 * std::atan2(
+            std::fabs(t[0].dot(t[1].cross(t[2]))),
+            1.0 + t[0].dot(t[1]) + t[1].dot(t[2]) + t[2].dot(t[0]));
+        Vector3d a = t[0] / d0;
+        triangles.push_back({a, t[1] / d1 - a, t[2] / d2 - a});
+        totalArea += area;
+        cumulativeArea.push_back(totalArea);
+    }
+    EdgeNormals const & normals = _getEdges().cross;
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d v;
+        for (int attempt = 0; attempt < MAX_ATTEMPTS; ++attempt) {
+            Vector3d p;
+            do {
+                size_t j = static_cast<size_t>(
+                    std::upper_bound(cumulativeArea.begin(),
+                                     cumulativeArea.end() - 1,
+                                     totalArea * uniform(rng)) -
+                    cumulativeArea.begin());
+                double s = uniform(rng), t = uniform(rng);
+                if (s + t > 1.0) {
+                    s = 1.0 - s;
+                    t = 1.0 - t;
+                }
+                Triangle const & tri = triangles[j];
+                p = tri.a + s * tri.ab + t * tri.ac;
+            } while (uniform(rng) * std::pow(p.getSquaredNorm(), 1.5) > 1.0);
+            v = UnitVector3d(p);
+            if (containsPoint(_vertices, normals, v)) {
+                break;
+            }
+        }
+        x[i] = v.x();
+        y[i] = v.y();
+        z[i] = v.z();
+    }
 }
 
 bool ConvexPolygon::contains(Region const & r) const {
@@ -329,58 +1658,122 @@ bool ConvexPolygon::isWithin(Region const & r) const {
     return (relate(r) & WITHIN) != 0;
 }
 
+Relationship ConvexPolygon::_relate(Circle const & c) const {
+    EdgeNormals const & normals = _getEdges().robust;
+    VertexIterator const begin = _vertices.begin();
+    return detail::relate(
+        begin, _vertices.end(), c,
+        [begin, &normals](VertexIterator, VertexIterator b) -> Vector3d const & {
+            return normals[b - begin];
+        });
+}
+
+// The relate implementations below first compare cheap, cached bounding
+// primitives, and only fall back to exact geometry when the bounds fail to
+// establish disjointness.
+
 Relationship ConvexPolygon::relate(Box const & b) const {
-    return detail::relate(_vertices.begin(), _vertices.end(), b);
+    detail::count(PerformanceCounter::RELATE_CONVEX_POLYGON_BOX);
+    return getBoundingBox().relate(b) & (DISJOINT | WITHIN);
 }
 
 Relationship ConvexPolygon::relate(Circle const & c) const {
-    return detail::relate(_vertices.begin(), _vertices.end(), c);
+    detail::count(PerformanceCounter::RELATE_CONVEX_POLYGON_CIRCLE);
+    if (!c.isEmpty() && getBoundingCircle().isDisjointFrom(c)) {
+        return DISJOINT;
+    }
+    return _relate(c);
 }
 
 Relationship ConvexPolygon::relate(ConvexPolygon const & p) const {
-    return detail::relate(_vertices.begin(), _vertices.end(), p);
+    detail::count(PerformanceCounter::RELATE_CONVEX_POLYGON_CONVEX_POLYGON);
+    if (getBoundingBox3d().isDisjointFrom(p.getBoundingBox3d()) ||
+        chordsDisjoint(getBoundingCircle(), p.getBoundingCircle())) {
+        return DISJOINT;
+    }
+    return detail::relate(
+        _vertices.begin(), _vertices.end(),
+        p._vertices.begin(), p._vertices.end(),
+        [this](UnitVector3d const & v) { return contains(v); },
+        [&p](UnitVector3d const & v) { return p.contains(v); });
 }
 
 Relationship ConvexPolygon::relate(Ellipse const & e) const {
-    return detail::relate(_vertices.begin(), _vertices.end(), e);
+    // Ellipse-ConvexPolygon relations are implemented by Ellipse.
+    return invert(e.relate(*this));
 }
 
 std::vector<uint8_t> ConvexPolygon::encode() const {
     std::vector<uint8_t> buffer;
-    uint8_t tc = TYPE_CODE;
     buffer.reserve(1 + 24 * _vertices.size());
+    encodeTo(buffer);
+    return buffer;
+}
+
+void ConvexPolygon::encodeTo(std::vector<uint8_t> & buffer) const {
+    uint8_t tc = TYPE_CODE;
     buffer.push_back(tc);
     for (UnitVector3d const & v: _vertices) {
         encodeDouble(v.x(), buffer);
         encodeDouble(v.y(), buffer);
         encodeDouble(v.z(), buffer);
     }
-    return buffer;
+}
+
+void ConvexPolygon::encodeCompactTo(std::vector<uint8_t> & buffer) const {
+    size_t const start = buffer.size();
+    buffer.push_back(COMPACT_TYPE_CODE);
+    if (!encodeCompactVertices(_vertices, _getEdges().robust, buffer)) {
+        buffer.resize(start);
+        encodeTo(buffer);
+    }
 }
 
 std::unique_ptr<ConvexPolygon> ConvexPolygon::decode(uint8_t const * buffer,
                                                      size_t n)
 {
+    std::unique_ptr<ConvexPolygon> poly(new ConvexPolygon);
+    poly->_decode(buffer, n);
+    return poly;
+}
+
+void ConvexPolygon::_decode(uint8_t const * buffer, size_t n) {
+    size_t const qs = detail::QUANTIZED_VECTOR_SIZE;
+    if (buffer != nullptr && *buffer == COMPACT_TYPE_CODE &&
+        n >= 1 + qs * 3 && (n - 1) % qs == 0) {
+        _bounds = BoundsCache();
+        delete _edges.exchange(nullptr, std::memory_order_relaxed);
+        ++buffer;
+        size_t nv = (n - 1) / qs;
+        _vertices.clear();
+        _vertices.reserve(nv);
+        for (size_t i = 0; i < nv; ++i, buffer += qs) {
+            _vertices.push_back(detail::decodeQuantized(buffer));
+        }
+        return;
+    }
     if (buffer == nullptr || *buffer != TYPE_CODE ||
         n < 1 + 24*3 || (n - 1) % 24 != 0) {
         throw std::runtime_error("Byte-string is not an encoded ConvexPolygon");
     }
-    std::unique_ptr<ConvexPolygon> poly(new ConvexPolygon);
+    // Discard cached state derived from the old vertices.
+    _bounds = BoundsCache();
+    delete _edges.exchange(nullptr, std::memory_order_relaxed);
     ++buffer;
     size_t nv = (n - 1) / 24;
-    poly->_vertices.reserve(nv);
+    _vertices.clear();
+    _vertices.reserve(nv);
     for (size_t i = 0; i < nv; ++i, buffer += 24) {
-        poly->_vertices.push_back(UnitVector3d::fromNormalized(
+        _vertices.push_back(UnitVector3d::fromNormalized(
             decodeDouble(buffer),
             decodeDouble(buffer + 8),
             decodeDouble(buffer + 16)
         ));
     }
-    return poly;
 }
 
 std::ostream & operator<<(std::ostream & os, ConvexPolygon const & p) {
-    typedef std::vector<UnitVector3d>::const_iterator VertexIterator;
+    typedef ConvexPolygon::VertexVector::const_iterator VertexIterator;
     VertexIterator v = p.getVertices().begin();
     VertexIterator const end = p.getVertices().end();
     os << "{\"ConvexPolygon\": [" << *v;
@@ -32,10 +32,14 @@
 /// a spherical region use them to avoid the cost of creating ConvexPolygon
 /// objects for each triangle/quad.
 
+#include <cmath>
+#include <iterator>
+
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
 #include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/inlineKernels.h"
 #include "lsst/sphgeom/orientation.h"
 #include "lsst/sphgeom/utils.h"
 
@@ -65,6 +69,40 @@ UnitVector3d centroid(VertexIterator const begin, VertexIterator const end) {
     return UnitVector3d(cm);
 }
 
+// `triangleArea` returns the signed area of the spherical triangle with
+// vertices a, b and c, which is positive if orientation(a, b, c) = 1. It
+// uses the formula of Van Oosterom and Strackee,
+//
+//     tan(E/2) = a · (b × c) / (1 + a · b + b · c + c · a),
+//
+// evaluating the triple product as a · ((b - a) × (c - a)), so that it is
+// accurate to a few ulps even for tiny triangles.
+inline double triangleArea(UnitVector3d const & a,
+                           UnitVector3d const & b,
+                           UnitVector3d const & c)
+{
+    Vector3d const u = b - a;
+    Vector3d const w = c - a;
+    double det = a.dot(u.cross(w));
+    return 2.0 * std::atan2(det, 1.0 + a.dot(b) + b.dot(c) + c.dot(a));
+}
+
+// `area` returns the area of the convex polygon with the given vertices.
+// Sequences with fewer than 3 vertices have zero area.
+template <typename VertexIterator>
+double area(VertexIterator const begin, VertexIterator const end) {
+    if (std::distance(begin, end) < 3) {
+        return 0.0;
+    }
+    double a = 0.0;
+    VertexIterator i = std::next(begin);
+    VertexIterator j = std::next(i);
+    for (; j != end; i = j, ++j) {
+        a += triangleArea(*begin, *i, *j);
+    }
+    return a;
+}
+
 template <typename VertexIterator>
 Circle boundingCircle(VertexIterator const begin, VertexIterator const end) {
     UnitVector3d c = centroid(begin, end);
@@ -263,10 +301,36 @@ Relationship relate(VertexIterator const begin,
     return boundingBox(begin, end).relate(b) & (DISJOINT | WITHIN);
 }
 
-template <typename VertexIterator>
+// `CircleEdgeTests` compares the distances between the center of a circle
+// and great circle segments to the circle radius. For the segment from a to
+// b with normal n = a.robustCross(b), `isNear` returns true if some point
+// of the segment may be inside the circle, and `isFar` returns true if some
+// point may be outside of it, allowing for rounding errors.
+struct CircleEdgeTests {
+    Circle const & c;
+
+    bool isNear(Vector3d const & a, Vector3d const & b, Vector3d const & n) const {
+        double d = getMinSquaredChordLength(c.getCenter(), a, b, n);
+        return d < c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR;
+    }
+
+    bool isFar(Vector3d const & a, Vector3d const & b, Vector3d const & n) const {
+        double d = getMaxSquaredChordLength(c.getCenter(), a, b, n);
+        return d > c.getSquaredChordLength() - MAX_SQUARED_CHORD_LENGTH_ERROR;
+    }
+};
+
+// `relate` computes the relationship between a polygon and a circle.
+// `edgeNormal(a, b)` must return a.robustCross(b) for consecutive polygon
+// vertices a and b; callers with precomputed edge normals can avoid
+// recomputing them. `edges` must provide the edge tests of CircleEdgeTests;
+// callers with prepared circles can supply cheaper ones.
+template <typename VertexIterator, typename EdgeNormal, typename EdgeTests>
 Relationship relate(VertexIterator const begin,
                     VertexIterator const end,
-                    Circle const & c)
+                    Circle const & c,
+                    EdgeNormal edgeNormal,
+                    EdgeTests const & edges)
 {
     if (c.isEmpty()) {
         return CONTAINS | DISJOINT;
@@ -297,10 +361,7 @@ Relationship relate(VertexIterator const begin,
         // All polygon vertices are inside c. Look for points in the polygon
         // edge interiors that are outside c.
         for (VertexIterator a = std::prev(end), b = begin; b != end; a = b, ++b) {
-            Vector3d n = a->robustCross(*b);
-            double d = getMaxSquaredChordLength(c.getCenter(), *a, *b, n);
-            if (d > c.getSquaredChordLength() -
-                    MAX_SQUARED_CHORD_LENGTH_ERROR) {
+            if (edges.isFar(*a, *b, edgeNormal(a, b))) {
                 return INTERSECTS;
             }
         }
@@ -316,9 +377,7 @@ Relationship relate(VertexIterator const begin,
     // All polygon vertices are outside c. Look for points in the polygon edge
     // interiors that are inside c.
     for (VertexIterator a = std::prev(end), b = begin; b != end; a = b, ++b) {
-        Vector3d n = a->robustCross(*b);
-        double d = getMinSquaredChordLength(c.getCenter(), *a, *b, n);
-        if (d < c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR) {
+        if (edges.isNear(*a, *b, edgeNormal(a, b))) {
             return INTERSECTS;
         }
     }
@@ -331,12 +390,69 @@ Relationship relate(VertexIterator const begin,
     return DISJOINT;
 }
 
+template <typename VertexIterator, typename EdgeNormal>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    Circle const & c,
+                    EdgeNormal edgeNormal)
+{
+    return relate(begin, end, c, edgeNormal, CircleEdgeTests{c});
+}
+
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    Circle const & c)
+{
+    return relate(begin, end, c, [](VertexIterator a, VertexIterator b) {
+        return a->robustCross(*b);
+    });
+}
+
+// `separates` returns true if the great circle through some edge of the
+// first polygon has every vertex of the second polygon strictly outside of
+// it, which proves that the polygons are disjoint. The scan for each edge
+// starts at the vertex found inside the previous edge. Around convex
+// polygons these witnesses advance together with the edges, so for
+// polygons that are not separated only O(n + m) vertex/edge pairs are
+// usually tested.
+template <typename VertexIterator1, typename VertexIterator2>
+bool separates(VertexIterator1 const begin1,
+               VertexIterator1 const end1,
+               VertexIterator2 const begin2,
+               VertexIterator2 const end2)
+{
+    VertexIterator2 w = begin2;
+    for (VertexIterator1 a = std::prev(end1), b = begin1;
+         b != end1; a = b, ++b) {
+        VertexIterator2 v = w;
+        while (inlined::orientation(*v, *a, *b) < 0) {
+            if (++v == end2) {
+                v = begin2;
+            }
+            if (v == w) {
+                return true;
+            }
+        }
+        w = v;
+    }
+    return false;
+}
+
+// `relate` computes the relationship between two polygons. `contains1(v)`
+// and `contains2(v)` must test whether the first and second polygon contain
+// v; callers with prepared polygons can supply faster tests than the
+// generic one.
 template <typename VertexIterator1,
-          typename VertexIterator2>
+          typename VertexIterator2,
+          typename Contains1,
+          typename Contains2>
 Relationship relate(VertexIterator1 const begin1,
                     VertexIterator1 const end1,
                     VertexIterator2 const begin2,
-                    VertexIterator2 const end2)
+                    VertexIterator2 const end2,
+                    Contains1 contains1,
+                    Contains2 contains2)
 {
     // TODO(smm): Make this more performant. Instead of the current quadratic
     // implementation, it should be possible to determine whether the boundaries
@@ -347,17 +463,26 @@ Relationship relate(VertexIterator1 const begin1,
     // Joseph O'Rourke, Chi-Bin Chien, Thomas Olson, David Naddor
     //
     // http://www.sciencedirect.com/science/article/pii/0146664X82900235
+    //
+    // Most disjoint polygons are separated by the great circle of an edge,
+    // which is much cheaper to find than the tests below.
+    if (separates(begin1, end1, begin2, end2) ||
+        separates(begin2, end2, begin1, end1)) {
+        return DISJOINT;
+    }
     bool all1 = true;
     bool any1 = false;
     bool all2 = true;
     bool any2 = false;
-    for (VertexIterator1 i = begin1; i != end1; ++i) {
-        bool b = contains(begin2, end2, *i);
+    // The loops stop as soon as the remaining vertices can no longer
+    // change the result.
+    for (VertexIterator1 i = begin1; i != end1 && (all1 || !any1); ++i) {
+        bool b = contains2(*i);
         all1 = b && all1;
         any1 = b || any1;
     }
-    for (VertexIterator2 j = begin2; j != end2; ++j) {
-        bool b = contains(begin1, end1, *j);
+    for (VertexIterator2 j = begin2; j != end2 && (all2 || !(any1 || any2)); ++j) {
+        bool b = contains1(*j);
         all2 = b && all2;
         any2 = b || any2;
     }
@@ -390,12 +515,29 @@ Relationship relate(VertexIterator1 const begin1,
     return DISJOINT;
 }
 
+template <typename VertexIterator1,
+          typename VertexIterator2>
+Relationship relate(VertexIterator1 const begin1,
+                    VertexIterator1 const end1,
+                    VertexIterator2 const begin2,
+                    VertexIterator2 const end2)
+{
+    return relate(
+        begin1, end1, begin2, end2,
+        [begin1, end1](UnitVector3d const & v) { return contains(begin1, end1, v); },
+        [begin2, end2](UnitVector3d const & v) { return contains(begin2, end2, v); });
+}
+
 template <typename VertexIterator>
 Relationship relate(VertexIterator const begin,
                     VertexIterator const end,
                     ConvexPolygon const & p)
 {
-    return relate(begin, end, p.getVertices().begin(), p.getVertices().end());
+    // Use the (cached edge normal) containment test of p for its side.
+    return relate(
+        begin, end, p.getVertices().begin(), p.getVertices().end(),
+        [begin, end](UnitVector3d const & v) { return contains(begin, end, v); },
+        [&p](UnitVector3d const & v) { return p.contains(v); });
 }
 
 template <typename VertexIterator>
@@ -0,0 +1,55 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_CPUDISPATCH_H_
+#define LSST_SPHGEOM_CPUDISPATCH_H_
+
+/// \file
+/// \brief This file provides the run time feature tests that batch kernels
+///        use to select an implementation.
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+enum CpuFeature : unsigned {
+    CPU_AVX2 = 1,
+    CPU_FAST_BMI2 = 2,
+    CPU_NEON = 4
+};
+
+// `enabledCpuFeatures` returns the bitwise OR of the CpuFeature values
+// that kernels may currently use.
+unsigned enabledCpuFeatures();
+
+inline bool hasAvx2() { return (enabledCpuFeatures() & CPU_AVX2) != 0; }
+
+// `hasFastBmi2` returns true if the CPU supports BMI2 and implements pdep
+// and pext in hardware. AMD family 17h CPUs (Zen and Zen 2) microcode them,
+// making them far slower than the portable bit twiddling.
+inline bool hasFastBmi2() { return (enabledCpuFeatures() & CPU_FAST_BMI2) != 0; }
+
+inline bool hasNeon() { return (enabledCpuFeatures() & CPU_NEON) != 0; }
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_CPUDISPATCH_H_
@@ -0,0 +1,130 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the DecodedRegion class implementation.
+
+#include "lsst/sphgeom/DecodedRegion.h"
+
+#include <stdexcept>
+
+
+#include "ConvexPolygonImpl.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// `relatePolygon` computes the relationship between p and r exactly as
+// p.relate(r) does, but without computing and caching bounds or edge
+// normals that are only worth having if p is used many times.
+Relationship relatePolygon(ConvexPolygon const & p, Region const & r) {
+    auto const begin = p.getVertices().begin();
+    auto const end = p.getVertices().end();
+    if (Box const * b = dynamic_cast<Box const *>(&r)) {
+        return detail::boundingBox(begin, end).relate(*b) & (DISJOINT | WITHIN);
+    }
+    if (Circle const * c = dynamic_cast<Circle const *>(&r)) {
+        if (!c->isEmpty() &&
+            detail::boundingCircle(begin, end).isDisjointFrom(*c)) {
+            return DISJOINT;
+        }
+        return detail::relate(begin, end, *c);
+    }
+    if (ConvexPolygon const * q = dynamic_cast<ConvexPolygon const *>(&r)) {
+        if (detail::boundingBox3d(begin, end).isDisjointFrom(
+                q->getBoundingBox3d())) {
+            return DISJOINT;
+        }
+        return detail::relate(
+            begin, end, q->getVertices().begin(), q->getVertices().end(),
+            [begin, end](UnitVector3d const & v) {
+                return detail::contains(begin, end, v);
+            },
+            [q](UnitVector3d const & v) { return q->contains(v); });
+    }
+    return p.relate(r);
+}
+
+} // unnamed namespace
+
+Region const & DecodedRegion::decode(uint8_t const * buffer, size_t n) {
+    _region = nullptr;
+    _compound.reset();
+    if (buffer == nullptr || n == 0) {
+        throw std::runtime_error("Byte-string is not an encoded Region");
+    }
+    uint8_t type = *buffer;
+    if (type == Box::TYPE_CODE) {
+        _box._decode(buffer, n);
+        _region = &_box;
+    } else if (type == Circle::TYPE_CODE ||
+               type == Circle::COMPACT_TYPE_CODE) {
+        _circle._decode(buffer, n);
+        _region = &_circle;
+    } else if (type == ConvexPolygon::TYPE_CODE ||
+               type == ConvexPolygon::COMPACT_TYPE_CODE) {
+        _polygon._decode(buffer, n);
+        _region = &_polygon;
+    } else if (type == Ellipse::TYPE_CODE) {
+        _ellipse._decode(buffer, n);
+        _region = &_ellipse;
+    } else {
+        // Compound and pixel regions, in any of their encodings, and invalid
+        // input.
+        _compound = Region::decode(buffer, n);
+        _region = _compound.get();
+    }
+    return *_region;
+}
+
+Relationship DecodedRegion::relate(uint8_t const * buffer, size_t n,
+                                   Region const & r) {
+    if (buffer == nullptr || n == 0) {
+        throw std::runtime_error("Byte-string is not an encoded Region");
+    }
+    uint8_t type = *buffer;
+    if (type == Box::TYPE_CODE) {
+        Box b;
+        b._decode(buffer, n);
+        return b.relate(r);
+    } else if (type == Circle::TYPE_CODE ||
+               type == Circle::COMPACT_TYPE_CODE) {
+        Circle c;
+        c._decode(buffer, n);
+        return c.relate(r);
+    } else if (type == ConvexPolygon::TYPE_CODE ||
+               type == ConvexPolygon::COMPACT_TYPE_CODE) {
+        ConvexPolygon p;
+        p._decode(buffer, n);
+        return relatePolygon(p, r);
+    } else if (type == Ellipse::TYPE_CODE) {
+        Ellipse e;
+        e._decode(buffer, n);
+        return e.relate(r);
+    }
+    return Region::decode(buffer, n)->relate(r);
+}
+
+}} // namespace lsst::sphgeom
@@ -25,6 +25,7 @@
 
 #include "lsst/sphgeom/Ellipse.h"
 
+#include <algorithm>
 #include <cmath>
 #include <ostream>
 #include <stdexcept>
@@ -33,12 +34,373 @@
 #include "lsst/sphgeom/Box3d.h"
 #include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
 #include "lsst/sphgeom/codec.h"
 
+#include "ConvexPolygonImpl.h"
+#include "EllipseImpl.h"
+#include "PerformanceCounting.h"
+
 
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+using detail::ELLIPSE_POLYGON_VERTICES;
+
+// `boxCaps` stores circles whose intersection is the box `b` in `caps`,
+// which must have room for 4 circles, and returns their number. These are
+// the caps bounded by the parallels of the box, and the hemispheres bounded
+// by its meridians. If the longitude interval of `b` is wider than π but not
+// full, the hemispheres are omitted, in which case the intersection of the
+// circles merely contains `b` and `exact` is set to false.
+int boxCaps(Box const & b, Circle * caps, bool & exact) {
+    int n = 0;
+    AngleInterval const & lat = b.getLat();
+    if (lat.getA().asRadians() > -0.5 * PI) {
+        caps[n++] = Circle(UnitVector3d::Z(), Angle(0.5 * PI) - lat.getA());
+    }
+    if (lat.getB().asRadians() < 0.5 * PI) {
+        caps[n++] = Circle(-UnitVector3d::Z(), Angle(0.5 * PI) + lat.getB());
+    }
+    NormalizedAngleInterval const & lon = b.getLon();
+    exact = lon.isFull() || lon.getSize().asRadians() <= PI;
+    if (!lon.isFull() && exact) {
+        caps[n++] = Circle(UnitVector3d::orthogonalTo(lon.getA()), 2.0);
+        caps[n++] = Circle(-UnitVector3d::orthogonalTo(lon.getB()), 2.0);
+    }
+    return n;
+}
+
+// `boxPolygon` stores the vertices of a convex polygon containing the box
+// `b` in `out`, which must have room for 5 vertices, in counter-clockwise
+// order, and returns their number. It returns 0 if `b` is empty or wider than
+// π/2 in longitude.
+//
+// The meridian edges of a box are great circle segments, but the geodesic
+// between the endpoints of a parallel always lies further from the equator
+// than the parallel. So a box is contained in the polygon obtained by
+// joining consecutive box vertices, unless its edge closest to the equator
+// is not the equator itself. If so, that edge is replaced by the two great
+// circles tangent to it at its endpoints, which meet on the central
+// meridian of the box. The box is first dilated slightly, so that the
+// result is conservative despite rounding errors.
+int boxPolygon(Box const & b, UnitVector3d * out) {
+    if (b.isEmpty() || b.getLon().isFull() ||
+        b.getLon().getSize().asRadians() > 0.5 * PI) {
+        return 0;
+    }
+    Angle const margin = 2.0 * Angle(MAX_ASIN_ERROR);
+    Box const d = b.dilatedBy(margin, margin);
+    NormalizedAngle const lon1 = d.getLon().getA();
+    NormalizedAngle const lon2 = d.getLon().getB();
+    Angle const lat1 = d.getLat().getA();
+    Angle const lat2 = d.getLat().getB();
+    // The tangent great circles at longitudes λ and λ + Δλ of the parallel
+    // with latitude φ meet at latitude atan(tan φ cos (Δλ/2)).
+    auto corner = [&](Angle lat) {
+        double const c = std::cos(0.5 * d.getLon().getSize().asRadians());
+        return UnitVector3d(LonLat(d.getLon().getCenter(),
+                                   Angle(std::atan(tan(lat) * c))));
+    };
+    int n = 0;
+    if (lat1.asRadians() <= -0.5 * PI) {
+        out[n++] = -UnitVector3d::Z();
+    } else {
+        out[n++] = UnitVector3d(LonLat(lon1, lat1));
+        if (lat1.asRadians() > 0.0) {
+            out[n++] = corner(lat1);
+        }
+        out[n++] = UnitVector3d(LonLat(lon2, lat1));
+    }
+    if (lat2.asRadians() >= 0.5 * PI) {
+        out[n++] = UnitVector3d::Z();
+    } else {
+        out[n++] = UnitVector3d(LonLat(lon2, lat2));
+        if (lat2.asRadians() < 0.0) {
+            out[n++] = corner(lat2);
+        }
+        out[n++] = UnitVector3d(LonLat(lon1, lat2));
+    }
+    return n;
+}
+
+// `computeEdges` stores the inward edge plane normals of the polygon with
+// the given vertices in `edges`.
+void computeEdges(UnitVector3d const * verts, int n, Vector3d * edges) {
+    for (int i = n - 1, j = 0; j < n; i = j, ++j) {
+        edges[j] = verts[i].robustCross(verts[j]);
+    }
+}
+
+// `outside` returns true if all the given vertices are strictly outside
+// one of the given edge planes.
+bool outside(Vector3d const * edges, int numEdges,
+             UnitVector3d const * verts, int numVerts)
+{
+    for (int i = 0; i < numEdges; ++i) {
+        int j = 0;
+        for (; j < numVerts && edges[i].dot(verts[j]) < 0.0; ++j) {}
+        if (j == numVerts) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// `inside` returns true if all the given vertices are strictly inside all
+// the given edge planes.
+bool inside(Vector3d const * edges, int numEdges,
+            UnitVector3d const * verts, int numVerts)
+{
+    for (int i = 0; i < numEdges; ++i) {
+        for (int j = 0; j < numVerts; ++j) {
+            if (edges[i].dot(verts[j]) <= 0.0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// `EllipseIntegrand` is the integrand of the area of an ellipse with
+// semi-axis lengths α, β ≤ π/2, given cos²α and cos²β (see getArea).
+struct EllipseIntegrand {
+    double cosAlpha2;
+    double cosBeta2;
+
+    double operator()(double v) const {
+        double const c = std::cos(v);
+        double const s = std::sin(v);
+        return 1.0 / (1.0 + std::sqrt(cosBeta2 * c * c + cosAlpha2 * s * s));
+    }
+};
+
+// `kronrod` applies the 15 point Gauss-Kronrod rule to f over [a, b],
+// storing the embedded 7 point Gauss estimate in `gauss`.
+template <typename F>
+double kronrod(F const & f, double a, double b, double & gauss) {
+    static constexpr double XGK[8] = {
+        0.991455371120812639206854697526329,
+        0.949107912342758524526189684047851,
+        0.864864423359769072789712788640926,
+        0.741531185599394439863864773280788,
+        0.586087235467691130294144845693013,
+        0.405845151377397166906606412076961,
+        0.207784955007898467600689403773245,
+        0.0
+    };
+    static constexpr double WGK[8] = {
+        0.022935322010529224963732008058970,
+        0.063092092629978553290700663189204,
+        0.104790010322250183839876322541518,
+        0.140653259715525918745189590510238,
+        0.169004726639267902826583426598550,
+        0.190350578064785409913256402421014,
+        0.204432940075298892414161999234649,
+        0.209482141084727828012999174891714
+    };
+    static constexpr double WG[4] = {
+        0.129484966168869693270611432679082,
+        0.279705391489276667901467771423780,
+        0.381830050505118944950369775488975,
+        0.417959183673469387755102040816327
+    };
+    double const c = 0.5 * (a + b);
+    double const h = 0.5 * (b - a);
+    double const fc = f(c);
+    double k = WGK[7] * fc;
+    double g = WG[3] * fc;
+    for (int i = 0; i < 7; ++i) {
+        double const fs = f(c - h * XGK[i]) + f(c + h * XGK[i]);
+        k += WGK[i] * fs;
+        if (i % 2 == 1) {
+            g += WG[i / 2] * fs;
+        }
+    }
+    gauss = g * h;
+    return k * h;
+}
+
+// `integrate` adaptively integrates f over [a, b], bisecting until the Gauss
+// and Kronrod estimates over a subinterval agree to within `tolerance`.
+template <typename F>
+double integrate(F const & f, double a, double b, double tolerance,
+                 int depth = 0)
+{
+    double gauss;
+    double const k = kronrod(f, a, b, gauss);
+    if (std::fabs(k - gauss) <= tolerance || depth >= 50) {
+        return k;
+    }
+    double const m = 0.5 * (a + b);
+    return integrate(f, a, m, 0.5 * tolerance, depth + 1) +
+           integrate(f, m, b, 0.5 * tolerance, depth + 1);
+}
+
+// `polygon` implements Ellipse::toOuterPolygon and Ellipse::toInnerPolygon.
+ConvexPolygon polygon(Ellipse const & e, int n, bool outer) {
+    if (n < 3) {
+        throw std::invalid_argument("A polygon must have at least 3 vertices");
+    }
+    Angle const margin = 2.0 * Angle(MAX_ASIN_ERROR);
+    if (e.isEmpty() || e.getAlpha() >= Angle(0.45 * PI)) {
+        throw std::invalid_argument(
+            "Ellipse is empty or too large to be approximated by a polygon");
+    }
+    if (!outer && e.getBeta() <= margin) {
+        throw std::invalid_argument(
+            "Ellipse is too thin to contain a polygon");
+    }
+    // These are the semi-axes used by ellipsePolygonAxes.
+    Angle const pad = outer ? margin : -margin;
+    double const a = std::tan((e.getAlpha() + pad).asRadians());
+    double const b = std::tan((e.getBeta() + pad).asRadians());
+    return detail::ellipsePolygon(e.getTransformMatrix(), a, b, outer, n);
+}
+
+} // unnamed namespace
+
+struct Ellipse::Polygons {
+    bool hasInner;
+    bool hasOuter;
+    UnitVector3d inner[ELLIPSE_POLYGON_VERTICES];
+    UnitVector3d outer[ELLIPSE_POLYGON_VERTICES];
+    Vector3d innerEdges[ELLIPSE_POLYGON_VERTICES];
+    Vector3d outerEdges[ELLIPSE_POLYGON_VERTICES];
+    // The polygons returned by toOuterPolygon and toInnerPolygon, computed
+    // on first use and published like the polygons themselves.
+    mutable std::atomic<ConvexPolygon const *> outerPolygon{nullptr};
+    mutable std::atomic<ConvexPolygon const *> innerPolygon{nullptr};
+
+    ~Polygons() {
+        delete outerPolygon.load(std::memory_order_relaxed);
+        delete innerPolygon.load(std::memory_order_relaxed);
+    }
+
+    explicit Polygons(Ellipse const & e) {
+        int const n = ELLIPSE_POLYGON_VERTICES;
+        double a = 0.0, b = 0.0;
+        hasInner = detail::ellipsePolygonAxes(e, false, a, b);
+        if (hasInner) {
+            detail::ellipseVertices(e.getTransformMatrix(), a, b, false, inner);
+            computeEdges(inner, n, innerEdges);
+        }
+        hasOuter = detail::ellipsePolygonAxes(e, true, a, b);
+        if (hasOuter) {
+            detail::ellipseVertices(e.getTransformMatrix(), a, b, true, outer);
+            computeEdges(outer, n, outerEdges);
+        }
+    }
+};
+
+Ellipse::Ellipse(Ellipse const & e) :
+    Region(e),
+    _S(e._S),
+    _a(e._a),
+    _b(e._b),
+    _gamma(e._gamma),
+    _tana(e._tana),
+    _tanb(e._tanb)
+{}
+
+Ellipse::Ellipse(Ellipse && e) noexcept :
+    Region(std::move(e)),
+    _S(e._S),
+    _a(e._a),
+    _b(e._b),
+    _gamma(e._gamma),
+    _tana(e._tana),
+    _tanb(e._tanb),
+    _polygons(e._polygons.exchange(nullptr, std::memory_order_relaxed))
+{}
+
+Ellipse & Ellipse::operator=(Ellipse const & e) {
+    if (this != &e) {
+        _S = e._S;
+        _a = e._a;
+        _b = e._b;
+        _gamma = e._gamma;
+        _tana = e._tana;
+        _tanb = e._tanb;
+        _clearPolygons();
+    }
+    return *this;
+}
+
+Ellipse & Ellipse::operator=(Ellipse && e) noexcept {
+    if (this != &e) {
+        _S = e._S;
+        _a = e._a;
+        _b = e._b;
+        _gamma = e._gamma;
+        _tana = e._tana;
+        _tanb = e._tanb;
+        delete _polygons.exchange(
+            e._polygons.exchange(nullptr, std::memory_order_relaxed),
+            std::memory_order_relaxed);
+    }
+    return *this;
+}
+
+Ellipse::~Ellipse() {
+    delete _polygons.load(std::memory_order_relaxed);
+}
+
+Ellipse::Polygons const & Ellipse::_getPolygons() const {
+    Polygons const * polygons = _polygons.load(std::memory_order_acquire);
+    if (polygons == nullptr) {
+        // Threads racing to compute the polygons each do so, and exactly
+        // one of them publishes its result.
+        Polygons const * p = new Polygons(*this);
+        if (_polygons.compare_exchange_strong(polygons, p,
+                                              std::memory_order_acq_rel,
+                                              std::memory_order_acquire)) {
+            polygons = p;
+        } else {
+            delete p;
+        }
+    }
+    return *polygons;
+}
+
+ConvexPolygon const & Ellipse::_getPolygon(bool outer) const {
+    Polygons const & p = _getPolygons();
+    std::atomic<ConvexPolygon const *> & slot =
+        outer ? p.outerPolygon : p.innerPolygon;
+    ConvexPolygon const * poly = slot.load(std::memory_order_acquire);
+    if (poly == nullptr) {
+        ConvexPolygon const * q =
+            new ConvexPolygon(polygon(*this, ELLIPSE_POLYGON_VERTICES, outer));
+        if (slot.compare_exchange_strong(poly, q, std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+            poly = q;
+        } else {
+            delete q;
+        }
+    }
+    return *poly;
+}
+
+ConvexPolygon Ellipse::toOuterPolygon(int n) const {
+    if (n == ELLIPSE_POLYGON_VERTICES) {
+        return _getPolygon(true);
+    }
+    return polygon(*this, n, true);
+}
+
+ConvexPolygon Ellipse::toInnerPolygon(int n) const {
+    if (n == ELLIPSE_POLYGON_VERTICES) {
+        return _getPolygon(false);
+    }
+    return polygon(*this, n, false);
+}
+
+void Ellipse::_clearPolygons() {
+    delete _polygons.exchange(nullptr, std::memory_order_relaxed);
+}
+
 Ellipse::Ellipse(UnitVector3d const & f1, UnitVector3d const & f2, Angle alpha) :
     _a(alpha.asRadians() - 0.5 * PI)
 {
@@ -157,7 +519,40 @@ Ellipse::Ellipse(UnitVector3d const & center,
     _tanb = std::fabs(tan(_b));
 }
 
-bool Ellipse::contains(UnitVector3d const & v) const {
+Ellipse Ellipse::fromQuadraticForm(Matrix3d const & S,
+                                   Angle alpha,
+                                   Angle beta,
+                                   Angle gamma,
+                                   double cotAlpha,
+                                   double cotBeta)
+{
+    if (alpha.isNan() ||
+        beta.isNan() ||
+        (alpha.asRadians() <  0.5 * PI && beta.asRadians() >= 0.5 * PI) ||
+        (alpha.asRadians() >  0.5 * PI && beta.asRadians() <= 0.5 * PI) ||
+        (alpha.asRadians() == 0.5 * PI && beta.asRadians() != 0.5 * PI)) {
+        throw std::invalid_argument("Invalid ellipse semi-axis angle(s)");
+    }
+    if (gamma.isNan() || std::isnan(cotAlpha) || std::isnan(cotBeta)) {
+        throw std::invalid_argument("Invalid ellipse parameters");
+    }
+    if (alpha.asRadians() < 0.0 || beta.asRadians() < 0.0) {
+        return empty();
+    } else if (alpha.asRadians() > PI || beta.asRadians() > PI ||
+               (alpha.asRadians() == PI && beta.asRadians() == PI)) {
+        return full();
+    }
+    Ellipse e;
+    e._S = S;
+    e._a = alpha - Angle(0.5 * PI);
+    e._b = beta - Angle(0.5 * PI);
+    e._gamma = gamma;
+    e._tana = std::fabs(cotAlpha);
+    e._tanb = std::fabs(cotBeta);
+    return e;
+}
+
+inline bool Ellipse::_contains(Vector3d const & v) const {
     UnitVector3d const c = getCenter();
     double vdotc = v.dot(c);
     Vector3d u;
@@ -187,6 +582,80 @@ bool Ellipse::contains(UnitVector3d const & v) const {
     }
 }
 
+bool Ellipse::contains(UnitVector3d const & v) const { return _contains(v); }
+
+void Ellipse::contains(double const * x,
+                       double const * y,
+                       double const * z,
+                       bool * out,
+                       size_t n) const
+{
+    static constexpr size_t BLOCK_SIZE = 256;
+    double u[3][BLOCK_SIZE];
+    for (size_t begin = 0; begin < n; begin += BLOCK_SIZE) {
+        size_t const m = std::min(BLOCK_SIZE, n - begin);
+        UnitVector3dArray::normalize(x + begin, y + begin, z + begin,
+                                     u[0], u[1], u[2], m);
+        for (size_t i = 0; i < m; ++i) {
+            out[begin + i] = _contains(Vector3d(u[0][i], u[1][i], u[2][i]));
+        }
+    }
+}
+
+void Ellipse::contains(Ellipse const * ellipses,
+                       size_t m,
+                       double const * x,
+                       double const * y,
+                       double const * z,
+                       size_t n,
+                       bool * out)
+{
+    static constexpr size_t BLOCK_SIZE = 256;
+    double u[3][BLOCK_SIZE];
+    for (size_t begin = 0; begin < n; begin += BLOCK_SIZE) {
+        size_t const k = std::min(BLOCK_SIZE, n - begin);
+        UnitVector3dArray::normalize(x + begin, y + begin, z + begin,
+                                     u[0], u[1], u[2], k);
+        for (size_t e = 0; e < m; ++e) {
+            Ellipse const & ellipse = ellipses[e];
+            bool * o = out + e * n + begin;
+            for (size_t i = 0; i < k; ++i) {
+                o[i] = ellipse._contains(Vector3d(u[0][i], u[1][i], u[2][i]));
+            }
+        }
+    }
+}
+
+// The area of an ellipse with semi-axis lengths α, β ≤ π/2 is
+//
+//     4 sin α sin β ∫₀^{π/2} dv / (1 + √(cos²β cos²v + cos²α sin²v))
+//
+// which follows from integrating the solid angle subtended by the cone
+// x²/tan²α + y²/tan²β ≤ z² in polar coordinates. A closed form exists in
+// terms of incomplete elliptic integrals of the third kind, but it cancels
+// catastrophically for small ellipses. The integrand is smooth and positive,
+// so adaptive Gauss-Kronrod quadrature converges to full precision quickly.
+// An ellipse with α > π/2 is the complement of one with semi-axis lengths
+// π - α and π - β, which have the same sines and squared cosines.
+double Ellipse::getArea() const {
+    if (isEmpty()) {
+        return 0.0;
+    }
+    if (isFull()) {
+        return 4.0 * PI;
+    }
+    double const sinAlpha = std::cos(_a.asRadians());
+    double const sinBeta = std::cos(_b.asRadians());
+    double const cosAlpha = std::sin(_a.asRadians());
+    double const cosBeta = std::sin(_b.asRadians());
+    EllipseIntegrand const f{cosAlpha * cosAlpha, cosBeta * cosBeta};
+    double gauss;
+    double const estimate = kronrod(f, 0.0, 0.5 * PI, gauss);
+    double const area = 4.0 * sinAlpha * sinBeta *
+        integrate(f, 0.0, 0.5 * PI, 1.0e-15 * std::fabs(estimate));
+    return _a.asRadians() > 0.0 ? 4.0 * PI - area : area;
+}
+
 Box Ellipse::getBoundingBox() const {
     // For now, simply return the bounding box of the ellipse bounding circle.
     //
@@ -243,12 +712,82 @@ Circle Ellipse::getBoundingCircle() const {
     return Circle(getCenter(), r);
 }
 
+// Ellipses are related to boxes and circles via conservative approximations
+// from outside and inside (see EllipseImpl.h). Elongated ellipses are
+// approximated by polygons with ELLIPSE_POLYGON_VERTICES vertices, which
+// are much tighter than the bounding and inscribed circles: the polygons
+// deviate from the ellipse boundary by less than 2% of the major semi-axis.
+//
+// To relate such a polygon to a box, the box is approximated from outside
+// by another polygon (see boxPolygon). Each of the two polygons is disjoint
+// from the other if all vertices of the other are outside one of its edges.
+// The box is within the ellipse if the vertices of its polygon are all
+// inside the inscribed polygon. Finally, the ellipse is within the box if
+// its circumscribing polygon is within the caps and hemispheres defining
+// the box (see boxCaps).
 Relationship Ellipse::relate(Box const & b) const {
-    return getBoundingCircle().relate(b) & (DISJOINT | WITHIN);
+    detail::count(PerformanceCounter::RELATE_ELLIPSE_BOX);
+    if (isEmpty()) {
+        return Circle::empty().relate(b);
+    } else if (isFull()) {
+        return Circle::full().relate(b);
+    }
+    Relationship r = getBoundingCircle().relate(b) & (DISJOINT | WITHIN);
+    if ((r & DISJOINT) != 0) {
+        return r;
+    }
+    int const n = ELLIPSE_POLYGON_VERTICES;
+    Polygons const & p = _getPolygons();
+    if (!p.hasInner) {
+        r |= detail::ellipseInnerCircle(*this).relate(b) & CONTAINS;
+    }
+    if (!p.hasInner && !p.hasOuter) {
+        return r;
+    }
+    UnitVector3d boxVerts[5];
+    int const m = boxPolygon(b, boxVerts);
+    // The box can only be within the ellipse if its vertices are.
+    if (p.hasInner && m != 0 && contains(boxVerts[0]) &&
+        inside(p.innerEdges, n, boxVerts, m)) {
+        r |= CONTAINS;
+    }
+    if (!p.hasOuter) {
+        return r;
+    }
+    if (m != 0) {
+        Vector3d boxEdges[5];
+        computeEdges(boxVerts, m, boxEdges);
+        if (outside(p.outerEdges, n, boxVerts, m) ||
+            outside(boxEdges, m, p.outer, n)) {
+            return r | DISJOINT;
+        }
+    }
+    // The ellipse can only be within the box if its center is, so unless
+    // the box is too wide for boxPolygon, the caps only need to be checked
+    // in that case.
+    bool within = b.contains(getCenter());
+    if (!within && m != 0) {
+        return r;
+    }
+    Circle caps[4];
+    bool exact = true;
+    int const k = boxCaps(b, caps, exact);
+    within = within && exact;
+    for (int i = 0; i < k; ++i) {
+        Relationship rc = _relateOuter(caps[i]);
+        if ((rc & DISJOINT) != 0) {
+            return r | DISJOINT;
+        }
+        within = within && (rc & WITHIN) != 0;
+    }
+    if (within) {
+        r |= WITHIN;
+    }
+    return r;
 }
 
-// For now, implement ellipse-circle and ellipse-ellipse relation
-// computation by approximating ellipses via their bounding circles.
+// For now, implement ellipse-ellipse relation computation by approximating
+// ellipses via their bounding circles.
 //
 // It should be possible to improve on this using the following algorithm to
 // compute ellipse-ellipse intersection points.
@@ -325,21 +864,87 @@ Relationship Ellipse::relate(Box const & b) const {
 //   between them and the degenerate quadratic forms they engender?
 
 Relationship Ellipse::relate(Circle const & c) const {
-    return getBoundingCircle().relate(c) & (DISJOINT | WITHIN);
+    detail::count(PerformanceCounter::RELATE_ELLIPSE_CIRCLE);
+    if (isEmpty()) {
+        return Circle::empty().relate(c);
+    } else if (isFull()) {
+        return Circle::full().relate(c);
+    }
+    Relationship r = getBoundingCircle().relate(c) & (DISJOINT | WITHIN);
+    if ((r & DISJOINT) != 0) {
+        return r;
+    }
+    int const n = ELLIPSE_POLYGON_VERTICES;
+    Polygons const & p = _getPolygons();
+    if (p.hasInner) {
+        r |= detail::relate(p.inner, p.inner + n, c,
+                            [&p](UnitVector3d const *, UnitVector3d const * v) {
+                                return p.innerEdges[v - p.inner];
+                            }) & CONTAINS;
+    } else {
+        r |= detail::ellipseInnerCircle(*this).relate(c) & CONTAINS;
+    }
+    if (p.hasOuter) {
+        r |= _relateOuter(c) & (DISJOINT | WITHIN);
+    }
+    return r;
+}
+
+Relationship Ellipse::_relateOuter(Circle const & c) const {
+    Polygons const & p = _getPolygons();
+    return detail::relate(p.outer, p.outer + ELLIPSE_POLYGON_VERTICES, c,
+                          [&p](UnitVector3d const *, UnitVector3d const * v) {
+                              return p.outerEdges[v - p.outer];
+                          });
 }
 
 Relationship Ellipse::relate(ConvexPolygon const & p) const {
-    return getBoundingCircle().relate(p) & (DISJOINT | WITHIN);
+    detail::count(PerformanceCounter::RELATE_ELLIPSE_CONVEX_POLYGON);
+    if (isEmpty()) {
+        return Circle::empty().relate(p);
+    } else if (isFull()) {
+        return Circle::full().relate(p);
+    }
+    Relationship r = getBoundingCircle().relate(p) & (DISJOINT | WITHIN);
+    if ((r & DISJOINT) != 0) {
+        return r;
+    }
+    // The ellipse contains p if its inscribed polygon (or circle) does, and
+    // it is disjoint from or within p if its circumscribing polygon is.
+    int const n = ELLIPSE_POLYGON_VERTICES;
+    Polygons const & q = _getPolygons();
+    if (q.hasInner) {
+        r |= detail::relate(q.inner, q.inner + n, p) & CONTAINS;
+    } else {
+        r |= detail::ellipseInnerCircle(*this).relate(p) & CONTAINS;
+    }
+    if (q.hasOuter) {
+        r |= detail::relate(q.outer, q.outer + n, p) & (DISJOINT | WITHIN);
+    }
+    return r;
 }
 
 Relationship Ellipse::relate(Ellipse const & e) const {
-    return getBoundingCircle().relate(e.getBoundingCircle()) & DISJOINT;
+    detail::count(PerformanceCounter::RELATE_ELLIPSE_ELLIPSE);
+    Relationship r = getBoundingCircle().relate(e.getBoundingCircle()) &
+                     DISJOINT;
+    if ((r & DISJOINT) == 0 && _getPolygons().hasOuter) {
+        // e is disjoint from this ellipse if it is disjoint from the
+        // circumscribing polygon.
+        r |= invert(e.relate(_getPolygon(true))) & DISJOINT;
+    }
+    return r;
 }
 
 std::vector<uint8_t> Ellipse::encode() const {
     std::vector<uint8_t> buffer;
-    uint8_t tc = TYPE_CODE;
     buffer.reserve(ENCODED_SIZE);
+    encodeTo(buffer);
+    return buffer;
+}
+
+void Ellipse::encodeTo(std::vector<uint8_t> & buffer) const {
+    uint8_t tc = TYPE_CODE;
     buffer.push_back(tc);
     for (int r = 0; r < 3; ++r) {
         for (int c = 0; c < 3; ++c) {
@@ -351,14 +956,19 @@ std::vector<uint8_t> Ellipse::encode() const {
     encodeDouble(_gamma.asRadians(), buffer);
     encodeDouble(_tana, buffer);
     encodeDouble(_tanb, buffer);
-    return buffer;
 }
 
 std::unique_ptr<Ellipse> Ellipse::decode(uint8_t const * buffer, size_t n) {
+    std::unique_ptr<Ellipse> ellipse(new Ellipse);
+    ellipse->_decode(buffer, n);
+    return ellipse;
+}
+
+void Ellipse::_decode(uint8_t const * buffer, size_t n) {
     if (buffer == nullptr || n != ENCODED_SIZE || buffer[0] != TYPE_CODE) {
         throw std::runtime_error("Byte-string is not an encoded Ellipse");
     }
-    std::unique_ptr<Ellipse> ellipse(new Ellipse);
+    _clearPolygons();
     ++buffer;
     double m00 = decodeDouble(buffer); buffer += 8;
     double m01 = decodeDouble(buffer); buffer += 8;
@@ -369,20 +979,19 @@ std::unique_ptr<Ellipse> Ellipse::decode(uint8_t const * buffer, size_t n) {
     double m20 = decodeDouble(buffer); buffer += 8;
     double m21 = decodeDouble(buffer); buffer += 8;
     double m22 = decodeDouble(buffer); buffer += 8;
-    ellipse->_S = Matrix3d(m00, m01, m02,
-                           m10, m11, m12,
-                           m20, m21, m22);
+    _S = Matrix3d(m00, m01, m02,
+                  m10, m11, m12,
+                  m20, m21, m22);
     double a = decodeDouble(buffer); buffer += 8;
     double b = decodeDouble(buffer); buffer += 8;
     double gamma = decodeDouble(buffer); buffer += 8;
-    ellipse->_a = Angle(a);
-    ellipse->_b = Angle(b);
-    ellipse->_gamma = Angle(gamma);
+    _a = Angle(a);
+    _b = Angle(b);
+    _gamma = Angle(gamma);
     double tana = decodeDouble(buffer); buffer += 8;
     double tanb = decodeDouble(buffer); buffer += 8;
-    ellipse->_tana = tana;
-    ellipse->_tanb = tanb;
-    return ellipse;
+    _tana = tana;
+    _tanb = tanb;
 }
 
 std::ostream & operator<<(std::ostream & os, Ellipse const & e) {
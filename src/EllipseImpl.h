@@ -0,0 +1,182 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_ELLIPSEIMPL_H_
+#define LSST_SPHGEOM_ELLIPSEIMPL_H_
+
+/// \file
+/// \brief This file contains polygonal and circular approximations of
+///        ellipses, used to relate ellipses to other regions.
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/Matrix3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+// `ELLIPSE_POLYGON_VERTICES` is the number of vertices in the polygons used
+// to approximate ellipses.
+constexpr int ELLIPSE_POLYGON_VERTICES = Ellipse::POLYGON_VERTICES;
+
+// `ellipseVertices` computes the vertices of a polygon approximating an
+// ellipse, and stores them in counter-clockwise order in `out`, which must
+// have room for ELLIPSE_POLYGON_VERTICES vertices. The `s` argument is the
+// ellipse transform matrix (see Ellipse), and a and b are the tangents of
+// its semi-axis angles, i.e. the semi-axis lengths of the planar ellipse
+// obtained by gnomonic projection onto the plane tangent to the sphere at
+// the ellipse center. Great circles project to straight lines, so a polygon
+// inscribed in (or circumscribing) the planar ellipse is inscribed in (or
+// circumscribes) the spherical ellipse. The vertices of the circumscribing
+// polygon are those of the inscribed one, scaled by 1/cos(π/n).
+//
+// The second overload computes polygons with n ≥ 3 vertices, and stores
+// them in `out`, which must have room for n vertices.
+inline void ellipseVertices(Matrix3d const & s,
+                            double a,
+                            double b,
+                            bool outer,
+                            int n,
+                            UnitVector3d * out)
+{
+    double const k = outer ? 1.0 / std::cos(PI / n) : 1.0;
+    Matrix3d const st = s.transpose();
+    bool const reverse =
+        s.getRow(0).cross(s.getRow(1)).dot(s.getRow(2)) < 0.0;
+    for (int i = 0; i < n; ++i) {
+        double const phi = (2.0 * PI * i) / n;
+        out[reverse ? n - 1 - i : i] = UnitVector3d(
+            st * Vector3d(k * a * std::cos(phi), k * b * std::sin(phi), 1.0));
+    }
+}
+
+inline void ellipseVertices(Matrix3d const & s,
+                            double a,
+                            double b,
+                            bool outer,
+                            UnitVector3d * out)
+{
+    int const n = ELLIPSE_POLYGON_VERTICES;
+    // The cosines and sines of the vertex angles 2πi/n.
+    struct Table {
+        double cs[n][2];
+        Table() {
+            for (int i = 0; i < n; ++i) {
+                cs[i][0] = std::cos((2.0 * PI * i) / n);
+                cs[i][1] = std::sin((2.0 * PI * i) / n);
+            }
+        }
+    };
+    static Table const table;
+    double const k = outer ? 1.0 / std::cos(PI / n) : 1.0;
+    Matrix3d const st = s.transpose();
+    // The rows of s form an orthonormal basis which may be left-handed,
+    // in which case the vertices must be emitted in reverse order.
+    bool const reverse =
+        s.getRow(0).cross(s.getRow(1)).dot(s.getRow(2)) < 0.0;
+    for (int i = 0; i < n; ++i) {
+        out[reverse ? n - 1 - i : i] = UnitVector3d(
+            st * Vector3d(k * a * table.cs[i][0], k * b * table.cs[i][1], 1.0));
+    }
+}
+
+// `ellipsePolygon` returns the polygon with the n vertices computed by
+// ellipseVertices.
+inline ConvexPolygon ellipsePolygon(Matrix3d const & s,
+                                    double a,
+                                    double b,
+                                    bool outer,
+                                    int n = ELLIPSE_POLYGON_VERTICES)
+{
+    std::vector<UnitVector3d> points(n);
+    ellipseVertices(s, a, b, outer, n, points.data());
+    return ConvexPolygon::convexHull(points);
+}
+
+// `ellipsePolygonAxes` determines whether an ellipse should be approximated
+// from outside (outer == true) or inside by a polygon. Ellipses that lie well
+// within a hemisphere and are noticeably elongated are. If `e` is one of
+// them, the tangents of its semi-axis angles, padded by the same margin as
+// the one used for Ellipse::getBoundingCircle() in the appropriate direction,
+// are stored in `a` and `b` for use with ellipseVertices, and true is
+// returned.
+inline bool ellipsePolygonAxes(Ellipse const & e,
+                               bool outer,
+                               double & a,
+                               double & b)
+{
+    Angle const margin = 2.0 * Angle(MAX_ASIN_ERROR);
+    Angle const alpha = e.getAlpha();
+    Angle const beta = e.getBeta();
+    if (e.isEmpty() || e.isFull() || alpha >= Angle(0.45 * PI)) {
+        return false;
+    }
+    // Here β ≤ α < π/2.
+    if (!outer && beta <= margin) {
+        return false;
+    }
+    Angle const pad = outer ? margin : -margin;
+    a = std::tan((alpha + pad).asRadians());
+    b = std::tan((beta + pad).asRadians());
+    // The polygon is only a better approximation than a circle if the
+    // ellipse is elongated enough.
+    return b < a * std::cos(PI / ELLIPSE_POLYGON_VERTICES);
+}
+
+// `ellipseInnerCircle` returns a circle inscribed in `e`, or an empty circle
+// if `e` is too thin to reliably contain one.
+inline Circle ellipseInnerCircle(Ellipse const & e) {
+    Angle const margin = 2.0 * Angle(MAX_ASIN_ERROR);
+    Angle const r = std::min(e.getAlpha(), e.getBeta()) - margin;
+    if (e.isEmpty() || r.asRadians() <= 0.0) {
+        return Circle();
+    }
+    return Circle(e.getCenter(), r);
+}
+
+// `ellipseBound` returns a region approximating an ellipse from outside
+// (outer == true) or inside. This is a polygon if ellipsePolygonAxes
+// says so, and otherwise the bounding circle or the inscribed circle of the
+// ellipse.
+inline std::unique_ptr<Region> ellipseBound(Ellipse const & e, bool outer) {
+    double a = 0.0, b = 0.0;
+    if (ellipsePolygonAxes(e, outer, a, b)) {
+        // These are the polygons cached by the ellipse.
+        return std::unique_ptr<Region>(new ConvexPolygon(
+            outer ? e.toOuterPolygon() : e.toInnerPolygon()));
+    }
+    if (outer) {
+        return std::unique_ptr<Region>(new Circle(e.getBoundingCircle()));
+    }
+    return std::unique_ptr<Region>(new Circle(ellipseInnerCircle(e)));
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_ELLIPSEIMPL_H_
@@ -0,0 +1,162 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the EnvelopeCache class implementation.
+
+#include "lsst/sphgeom/EnvelopeCache.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/MemoryResourceScope.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// An estimate of the bookkeeping memory of an entry, beyond its key and
+// ranges: a list node, a hash table node and bucket, and the ranges of an
+// empty set.
+constexpr size_t ENTRY_OVERHEAD = 160;
+
+} // unnamed namespace
+
+EnvelopeCache::EnvelopeCache(size_t maxBytes) : _maxBytes(maxBytes) {
+    if (maxBytes == 0) {
+        throw std::invalid_argument("EnvelopeCache size must be positive");
+    }
+}
+
+template <typename Compute>
+RangeSet EnvelopeCache::_find(char op,
+                              Pixelization const & pixelization,
+                              Region const & region,
+                              size_t maxRanges,
+                              Compute compute)
+{
+    std::string pixelizationKey = pixelization.getCacheKey();
+    if (pixelizationKey.empty()) {
+        return compute();
+    }
+    // The key is the operation, the pixelization key, the range limit and
+    // the region encoding. The pixelization key is terminated by a NUL
+    // byte; it cannot contain one since it is generally human-readable.
+    std::vector<uint8_t> encoding = region.encode();
+    std::string key;
+    key.reserve(2 + pixelizationKey.size() + sizeof(maxRanges) +
+                encoding.size());
+    key.push_back(op);
+    key.append(pixelizationKey);
+    key.push_back('\0');
+    key.append(reinterpret_cast<char const *>(&maxRanges), sizeof(maxRanges));
+    key.append(encoding.begin(), encoding.end());
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto i = _index.find(key);
+        if (i != _index.end()) {
+            ++_hits;
+            _entries.splice(_entries.begin(), _entries, i->second);
+            return RangeSet(i->second->ranges, MemoryResourceScope::current());
+        }
+        ++_misses;
+    }
+    RangeSet result = compute();
+    size_t const bytes = 2 * key.size() + 16 * result.size() + ENTRY_OVERHEAD;
+    if (bytes > _maxBytes) {
+        return result;
+    }
+    // Cached sets must not use the memory resource of a scope, which
+    // may be released before they are evicted.
+    RangeSet stored(result, std::pmr::get_default_resource());
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_index.count(key) != 0) {
+        // Another thread stored the same result in the meantime.
+        return result;
+    }
+    while (_bytes + bytes > _maxBytes) {
+        Entry const & last = _entries.back();
+        _bytes -= last.bytes;
+        _index.erase(last.key);
+        _entries.pop_back();
+        ++_evictions;
+    }
+    _entries.push_front(Entry{key, std::move(stored), bytes});
+    _index.emplace(std::move(key), _entries.begin());
+    _bytes += bytes;
+    return result;
+}
+
+RangeSet EnvelopeCache::envelope(Pixelization const & pixelization,
+                                 Region const & region,
+                                 size_t maxRanges)
+{
+    return _find('e', pixelization, region, maxRanges, [&]() {
+        return pixelization.envelope(region, maxRanges);
+    });
+}
+
+RangeSet EnvelopeCache::interior(Pixelization const & pixelization,
+                                 Region const & region,
+                                 size_t maxRanges)
+{
+    return _find('i', pixelization, region, maxRanges, [&]() {
+        return pixelization.interior(region, maxRanges);
+    });
+}
+
+void EnvelopeCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _index.clear();
+    _entries.clear();
+    _bytes = 0;
+}
+
+size_t EnvelopeCache::getBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _bytes;
+}
+
+size_t EnvelopeCache::size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+uint64_t EnvelopeCache::getHits() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _hits;
+}
+
+uint64_t EnvelopeCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _misses;
+}
+
+uint64_t EnvelopeCache::getEvictions() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _evictions;
+}
+
+}} // namespace lsst::sphgeom
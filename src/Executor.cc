@@ -0,0 +1,188 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the default executor, and the function that
+///        runs parallel work on the current executor.
+
+#include "lsst/sphgeom/Executor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// `ThreadPool` runs tasks on a fixed number of threads, which are started
+// when the first task is submitted.
+class ThreadPool : public Executor {
+public:
+    explicit ThreadPool(unsigned numThreads) : _numThreads(numThreads) {}
+
+    ~ThreadPool() override {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _ready.notify_all();
+        for (std::thread & t: _threads) {
+            t.join();
+        }
+    }
+
+    void submit(std::function<void()> task) override {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_threads.empty()) {
+                for (unsigned t = 0; t < _numThreads; ++t) {
+                    _threads.emplace_back([this]() { _run(); });
+                }
+            }
+            _tasks.push_back(std::move(task));
+        }
+        _ready.notify_one();
+    }
+
+private:
+    void _run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true) {
+            _ready.wait(lock, [this]() { return _stop || !_tasks.empty(); });
+            if (_tasks.empty()) {
+                return;
+            }
+            std::function<void()> task = std::move(_tasks.front());
+            _tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+        }
+    }
+
+    unsigned const _numThreads;
+    std::mutex _mutex;
+    std::condition_variable _ready;
+    std::deque<std::function<void()>> _tasks;
+    std::vector<std::thread> _threads;
+    bool _stop = false;
+};
+
+std::mutex executorMutex;
+std::shared_ptr<Executor> executor;
+std::atomic<unsigned> maxThreads{0};
+
+// `Workers` tracks the tasks submitted by one call to runInParallel. It is
+// shared with the tasks, since they may start after the call has returned.
+struct Workers {
+    std::mutex mutex;
+    std::condition_variable done;
+    unsigned running = 0;
+    bool closed = false;
+
+    // `close` prevents tasks that have not started from running the work,
+    // and waits for those that have to finish.
+    void close() {
+        std::unique_lock<std::mutex> lock(mutex);
+        closed = true;
+        done.wait(lock, [this]() { return running == 0; });
+    }
+};
+
+} // unnamed namespace
+
+std::shared_ptr<Executor> getDefaultExecutor() {
+    // The pool threads and the calling thread share the hardware threads.
+    static std::shared_ptr<Executor> const pool = std::make_shared<ThreadPool>(
+        std::max(std::thread::hardware_concurrency(), 2u) - 1);
+    return pool;
+}
+
+std::shared_ptr<Executor> getExecutor() {
+    std::lock_guard<std::mutex> lock(executorMutex);
+    return executor ? executor : getDefaultExecutor();
+}
+
+void setExecutor(std::shared_ptr<Executor> e) {
+    std::lock_guard<std::mutex> lock(executorMutex);
+    executor = std::move(e);
+}
+
+unsigned getMaxThreads() {
+    return maxThreads.load(std::memory_order_relaxed);
+}
+
+void setMaxThreads(unsigned n) {
+    maxThreads.store(n, std::memory_order_relaxed);
+}
+
+namespace detail {
+
+void runInParallel(unsigned numThreads, std::function<void()> const & work) {
+    unsigned const limit = getMaxThreads();
+    if (limit != 0) {
+        numThreads = std::min(numThreads, limit);
+    }
+    if (numThreads <= 1) {
+        work();
+        return;
+    }
+    std::shared_ptr<Executor> e = getExecutor();
+    auto workers = std::make_shared<Workers>();
+    // Tasks only use work, which lives on the stack of the caller, while
+    // the caller is blocked in close().
+    struct Closer {
+        Workers & w;
+        ~Closer() { w.close(); }
+    } closer{*workers};
+    for (unsigned t = 1; t < numThreads; ++t) {
+        e->submit([workers, &work]() {
+            {
+                std::lock_guard<std::mutex> lock(workers->mutex);
+                if (workers->closed) {
+                    return;
+                }
+                ++workers->running;
+            }
+            work();
+            std::lock_guard<std::mutex> lock(workers->mutex);
+            if (--workers->running == 0) {
+                workers->done.notify_all();
+            }
+        });
+    }
+    work();
+}
+
+} // namespace detail
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,640 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the HealpixPixelization class implementation.
+
+#include "lsst/sphgeom/HealpixPixelization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "lsst/sphgeom/constants.h"
+#include "lsst/sphgeom/curve.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "PerformanceCounting.h"
+#include "PixelCache.h"
+#include "PixelFinder.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The base pixel layout of the HEALPix reference implementation. The point
+// with coordinates (x, y) ∈ [0, 1]² in base pixel f has ring coordinate
+// JRLL[f] - x - y, which runs from 0 at the north pole to 4 at the south
+// pole, in units of nside rings. JPLL[f] is the longitude of the center of
+// base pixel f, in units of π/4.
+int const JRLL[12] = {2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4};
+int const JPLL[12] = {1, 3, 5, 7, 0, 2, 4, 6, 1, 3, 5, 7};
+
+constexpr double QUARTER_PI = 0.25 * PI;
+
+// The amount by which pixel edges are pushed outwards, in addition to the
+// distance by which the curved edges stray from their chords. This ensures
+// that the polygonal representation of a pixel contains all unit vectors
+// that map to that pixel, despite rounding errors.
+constexpr double DILATION = 1.0e-15;
+
+// Upper bounds on |d²p/ds²| for the image p(s) on the unit sphere of a
+// pixel edge parametrized by face coordinate s. In the equatorial zone,
+// z and φ are linear in s, with slopes 2/3 and π/4, and |z| ≤ 2/3. In the
+// polar caps, POLAR_CURVATURE bounds the terms that do not involve the
+// variation of φ; see polarCurvature().
+constexpr double EQUATORIAL_CURVATURE = 2.7;
+constexpr double POLAR_CURVATURE = 1.17;
+
+// Pixel edges are sampled at their midpoints if the deviation bound
+// obtained from their end points alone exceeds this fraction of their
+// length in face coordinates.
+constexpr double MAX_UNSAMPLED_DEVIATION = 1.0 / 1024.0;
+
+// `ringCoordinate` returns the ring coordinate of the point with
+// coordinates (x, y) in the given base pixel.
+inline double ringCoordinate(int face, double x, double y) {
+    return JRLL[face] - x - y;
+}
+
+// `faceToSphere` maps the point with coordinates (x, y) in the given base
+// pixel to the unit sphere. The north, west, south and east corners of a
+// base pixel have coordinates (1, 1), (0, 1), (0, 0) and (1, 0).
+UnitVector3d faceToSphere(int face, double x, double y) {
+    double const jr = ringCoordinate(face, x, y);
+    double nr, z, sinTheta;
+    if (jr < 1.0 || jr > 3.0) {
+        // Polar caps. Computing sin θ from nr avoids the cancellation
+        // in sqrt(1 - z²) close to the poles.
+        nr = jr < 1.0 ? jr : 4.0 - jr;
+        double const t = nr * nr / 3.0;
+        z = jr < 1.0 ? 1.0 - t : t - 1.0;
+        sinTheta = std::sqrt(t * (2.0 - t));
+    } else {
+        nr = 1.0;
+        z = (2.0 - jr) * (2.0 / 3.0);
+        sinTheta = std::sqrt((1.0 - z) * (1.0 + z));
+    }
+    double const phi = nr > 0.0 ? QUARTER_PI * (JPLL[face] * nr + x - y) / nr
+                                : 0.0;
+    return UnitVector3d::fromNormalized(
+        sinTheta * std::cos(phi), sinTheta * std::sin(phi), z);
+}
+
+// `curvatureBound` returns an upper bound on |d²p/ds²| along the segment of
+// a pixel edge from (x0, y0) to (x1, y1) in the given base pixel. The
+// segment must not cross the boundary between the equatorial zone and a
+// polar cap.
+double curvatureBound(int face, double x0, double y0, double x1, double y1) {
+    double const jr0 = ringCoordinate(face, x0, y0);
+    double const jr1 = ringCoordinate(face, x1, y1);
+    double const jr = 0.5 * (jr0 + jr1);
+    if (jr >= 1.0 && jr <= 3.0) {
+        return EQUATORIAL_CURVATURE;
+    }
+    // In a polar cap, nr changes by one per unit of face coordinate along an
+    // edge, and x - y = a + b·nr with b = ±1. Therefore φ = φ₀ + β/nr, where
+    // β = a·π/4, and z = ±(1 - nr²/3). Differentiating twice, and using
+    // nr ≤ 1, shows that
+    //
+    //     |d²p/ds²| ≤ POLAR_CURVATURE + (√6/3)·β²/nr³ + (4√6/3)·|β|/nr².
+    double const nr0 = jr < 1.0 ? jr0 : 4.0 - jr0;
+    double const nr1 = jr < 1.0 ? jr1 : 4.0 - jr1;
+    double const b = ((x1 - y1) - (x0 - y0)) / (nr1 - nr0);
+    double const beta = QUARTER_PI * std::fabs((x0 - y0) - b * nr0);
+    double const nr = std::min(nr0, nr1);
+    if (beta == 0.0 || nr <= 0.0) {
+        // The edge lies on a meridian. Only pixel edges that end at a pole
+        // have nr = 0, and all of them are meridians.
+        return POLAR_CURVATURE;
+    }
+    return POLAR_CURVATURE + beta * (0.817 * beta / nr + 3.267) / (nr * nr);
+}
+
+// `sampleEdge` bounds the deviations of the edge from (x0, y0) to (x1, y1)
+// in the given base pixel from the great circle with unit normal n, which
+// must contain (the images of) the end points. On return, `left` and
+// `right` are at most the sines of the angles by which the curved edge
+// strays to the right and left of that great circle, i.e. outside of the
+// pixels to the left and right of the edge.
+//
+// The deviation h(s) = -n·p(s) is sampled at the edge parameters
+// t[0] = 0 < t[1] < ... < t[numSamples - 1] = 1, which must include the
+// point where the edge enters or leaves a polar cap, if any. Between
+// consecutive samples s₀ and s₁, |h''| ≤ |p''| ≤ B, and so h(s) is at most
+// max(h(s₀), h(s₁)) + B·(s₁ - s₀)²/8, and -h(s) is bounded similarly.
+void sampleEdge(int face,
+                double x0,
+                double y0,
+                double x1,
+                double y1,
+                UnitVector3d const & n,
+                double const * t,
+                int numSamples,
+                double & left,
+                double & right)
+{
+    double const length = (x1 - x0) + (y1 - y0);
+    double l = 0.0;
+    double r = 0.0;
+    double hPrev = 0.0;
+    double xPrev = x0;
+    double yPrev = y0;
+    for (int i = 1; i < numSamples; ++i) {
+        double const x = x0 + (x1 - x0) * t[i];
+        double const y = y0 + (y1 - y0) * t[i];
+        double const h = (i == numSamples - 1) ?
+            0.0 : -n.dot(faceToSphere(face, x, y));
+        double const ds = (t[i] - t[i - 1]) * length;
+        double const slack =
+            0.125 * curvatureBound(face, xPrev, yPrev, x, y) * ds * ds;
+        l = std::max(l, std::max(hPrev, h) + slack);
+        r = std::max(r, slack - std::min(hPrev, h));
+        hPrev = h;
+        xPrev = x;
+        yPrev = y;
+    }
+    left = std::min(left, l);
+    right = std::min(right, r);
+}
+
+// An `Edge` holds the normals of two great circles that bound a pixel edge
+// from corner a to corner b, where b has the larger face coordinate. The
+// pixel to the left of a → b is inside the great circle with normal `left`,
+// and the pixel to the right is inside the one with normal `right`.
+struct Edge {
+    Vector3d left;
+    Vector3d right;
+};
+
+// `makeEdge` returns the edge from corner a at (x0, y0) to corner b at
+// (x1, y1) in the given base pixel.
+//
+// The bounding great circles are obtained by tilting the great circle
+// through a and b outwards, about the axis orthogonal to its normal n and
+// to the edge midpoint m̂. If c is the cosine of half the edge length, a
+// point at most d outside of the great circle with normal n is inside the
+// one with normal n + d/(c - d)·m̂.
+//
+// Edges are only sampled at their midpoints if the deviation bounds
+// obtained without doing so are loose, which is only the case for the
+// pixels of the first few levels, and for pixels close to the poles.
+Edge makeEdge(int face,
+              double x0,
+              double y0,
+              double x1,
+              double y1,
+              UnitVector3d const & a,
+              UnitVector3d const & b)
+{
+    UnitVector3d const n(a.robustCross(b));
+    double left = std::numeric_limits<double>::infinity();
+    double right = left;
+    double t[4] = {0.0, 1.0, 1.0, 1.0};
+    int numSamples = 2;
+    double const jr0 = ringCoordinate(face, x0, y0);
+    double const jr1 = ringCoordinate(face, x1, y1);
+    for (double boundary: {1.0, 3.0}) {
+        double const tb = (boundary - jr0) / (jr1 - jr0);
+        if (tb > 0.0 && tb < 1.0) {
+            t[1] = tb;
+            numSamples = 3;
+        }
+    }
+    sampleEdge(face, x0, y0, x1, y1, n, t, numSamples, left, right);
+    double const tolerance = MAX_UNSAMPLED_DEVIATION * ((x1 - x0) + (y1 - y0));
+    if (std::max(left, right) > tolerance && t[1] != 0.5) {
+        t[numSamples - 1] = 0.5;
+        t[numSamples] = 1.0;
+        ++numSamples;
+        std::sort(t, t + numSamples);
+        sampleEdge(face, x0, y0, x1, y1, n, t, numSamples, left, right);
+    }
+    left += DILATION;
+    right += DILATION;
+    Vector3d const m = a + b;
+    double const c = 0.5 * m.getNorm();
+    return Edge{n + m * (0.5 * left / (c * (c - left))),
+                -n + m * (0.5 * right / (c * (c - right)))};
+}
+
+// `makeQuad` computes the vertices of the polygon containing the pixel with
+// the given south, east, north and west edges.
+void makeQuad(Edge const & south,
+              Edge const & east,
+              Edge const & north,
+              Edge const & west,
+              UnitVector3d * verts)
+{
+    // The pixel is to the right of its north and west edges, which run
+    // from west to east and from south to north.
+    Vector3d const * planes[4] = {
+        &north.right, &west.right, &south.left, &east.left
+    };
+    // Vertices are the intersections of consecutive planes, starting with
+    // the north corner, and are in counter-clockwise order.
+    for (int k = 0; k < 4; ++k) {
+        Vector3d v = planes[(k + 3) & 3]->cross(*planes[k]);
+        verts[k] = UnitVector3d::fromNormalized(v / v.getNorm());
+    }
+}
+
+// `makeQuad` computes the vertices of the polygon containing the pixel with
+// index i at the given level.
+void makeQuad(uint64_t i, int level, UnitVector3d * verts) {
+    uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
+    int const face = static_cast<int>(i >> (2 * level));
+    double const scale = std::ldexp(1.0, -level);
+    uint32_t s, t;
+    std::tie(s, t) = mortonIndexInverse(i & mask);
+    double const x0 = s * scale;
+    double const x1 = (s + 1) * scale;
+    double const y0 = t * scale;
+    double const y1 = (t + 1) * scale;
+    UnitVector3d const sw = faceToSphere(face, x0, y0);
+    UnitVector3d const se = faceToSphere(face, x1, y0);
+    UnitVector3d const nw = faceToSphere(face, x0, y1);
+    UnitVector3d const ne = faceToSphere(face, x1, y1);
+    makeQuad(makeEdge(face, x0, y0, x1, y0, sw, se),
+             makeEdge(face, x1, y0, x1, y1, se, ne),
+             makeEdge(face, x0, y1, x1, y1, nw, ne),
+             makeEdge(face, x0, y0, x0, y1, sw, nw),
+             verts);
+}
+
+// `computeIndex` returns the NESTED HEALPix index of p at the given level.
+// This follows the reference implementation.
+uint64_t computeIndex(UnitVector3d const & p, int level) {
+    uint64_t const nside = static_cast<uint64_t>(1) << level;
+    double const z = p.z();
+    double const za = std::fabs(z);
+    // tt ∈ [0, 4) is the longitude of p in units of π/2.
+    double tt = std::atan2(p.y(), p.x()) * (2.0 * ONE_OVER_PI);
+    if (tt < 0.0) {
+        tt += 4.0;
+        if (tt >= 4.0) {
+            tt = 0.0;
+        }
+    }
+    uint64_t face, x, y;
+    if (za <= 2.0 / 3.0) {
+        // Equatorial zone. jp and jm are the indexes of the ascending and
+        // descending pixel edge lines below p.
+        double const t1 = nside * (0.5 + tt);
+        double const t2 = nside * (0.75 * z);
+        uint64_t const jp = static_cast<uint64_t>(t1 - t2);
+        uint64_t const jm = static_cast<uint64_t>(t1 + t2);
+        uint64_t const fp = jp >> level;
+        uint64_t const fm = jm >> level;
+        face = (fp == fm) ? (fp | 4) : ((fp < fm) ? fp : (fm + 8));
+        x = jm & (nside - 1);
+        y = nside - (jp & (nside - 1)) - 1;
+    } else {
+        // Polar caps.
+        uint64_t const ntt = std::min(static_cast<uint64_t>(3),
+                                      static_cast<uint64_t>(tt));
+        double const tp = tt - ntt;
+        double const tmp = (za < 0.99) ?
+            nside * std::sqrt(3.0 * (1.0 - za)) :
+            nside * std::hypot(p.x(), p.y()) / std::sqrt((1.0 + za) / 3.0);
+        uint64_t const jp = std::min(nside - 1,
+                                     static_cast<uint64_t>(tp * tmp));
+        uint64_t const jm = std::min(nside - 1,
+                                     static_cast<uint64_t>((1.0 - tp) * tmp));
+        if (z > 0.0) {
+            face = ntt;
+            x = nside - jm - 1;
+            y = nside - jp - 1;
+        } else {
+            face = ntt + 8;
+            x = jp;
+            y = jm;
+        }
+    }
+    return (face << (2 * level)) | mortonIndex(static_cast<uint32_t>(x),
+                                               static_cast<uint32_t>(y));
+}
+
+
+// `HealpixPixelFinder` locates HEALPix pixels that intersect a region.
+template <typename RegionType, bool InteriorOnly>
+class HealpixPixelFinder: public detail::PixelFinder<
+    HealpixPixelFinder<RegionType, InteriorOnly>, RegionType, InteriorOnly, 4>
+{
+private:
+    using Base = detail::PixelFinder<
+        HealpixPixelFinder<RegionType, InteriorOnly>,
+        RegionType, InteriorOnly, 4>;
+    using Base::visit;
+
+public:
+    HealpixPixelFinder(RangeSet & ranges,
+                       RegionType const & region,
+                       int level,
+                       size_t maxRanges):
+        Base(ranges, region, level, maxRanges)
+    {}
+
+    void operator()() {
+        UnitVector3d pixel[4];
+        // Loop over base pixels
+        for (uint64_t f = 0; f < 12; ++f) {
+            makeQuad(f, 0, pixel);
+            visit(pixel, f, 0);
+        }
+    }
+
+    static constexpr int MAX_LEVEL = HealpixPixelization::MAX_LEVEL;
+
+    // The corners and edges of the children of a pixel form a 3x3 grid,
+    // and each interior edge is shared by two children. The edge from grid
+    // point (i, j) to (i + 1, j) is horizontal[j][i], and the edge from grid
+    // point (i, j) to (i, j + 1) is vertical[i][j].
+    struct Cache {
+        Edge horizontal[3][2];
+        Edge vertical[3][2];
+    };
+
+    void expand(UnitVector3d const *, uint64_t index, int level, Cache & c) {
+        uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
+        int const face = static_cast<int>(index >> (2 * level));
+        double const scale = std::ldexp(1.0, -level - 1);
+        uint32_t s, t;
+        std::tie(s, t) = mortonIndexInverse(index & mask);
+        double xs[3], ys[3];
+        UnitVector3d corners[3][3];
+        for (int j = 0; j < 3; ++j) {
+            xs[j] = (2 * s + j) * scale;
+            ys[j] = (2 * t + j) * scale;
+        }
+        for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 3; ++i) {
+                corners[j][i] = faceToSphere(face, xs[i], ys[j]);
+            }
+        }
+        for (int j = 0; j < 3; ++j) {
+            for (int i = 0; i < 2; ++i) {
+                c.horizontal[j][i] = makeEdge(face, xs[i], ys[j], xs[i + 1],
+                                              ys[j], corners[j][i],
+                                              corners[j][i + 1]);
+                c.vertical[j][i] = makeEdge(face, xs[j], ys[i], xs[j],
+                                            ys[i + 1], corners[i][j],
+                                            corners[i + 1][j]);
+            }
+        }
+    }
+
+    UnitVector3d const * child(Cache const & c,
+                               uint64_t index,
+                               int,
+                               UnitVector3d * pixel) {
+        int const i = static_cast<int>(index & 1);
+        int const j = static_cast<int>((index >> 1) & 1);
+        makeQuad(c.horizontal[j][i], c.vertical[i + 1][j],
+                 c.horizontal[j + 1][i], c.vertical[i][j], pixel);
+        return pixel;
+    }
+};
+
+// `MAX_DECIMAL_DIGITS` is the number of decimal digits in 2⁶⁴ - 1.
+constexpr size_t MAX_DECIMAL_DIGITS = 20;
+
+// `formatDecimal` writes the decimal representation of i to the end of
+// the MAX_DECIMAL_DIGITS characters starting at buf, and returns the
+// number of digits written.
+size_t formatDecimal(uint64_t i, char * buf) {
+    char * p = buf + MAX_DECIMAL_DIGITS;
+    do {
+        *--p = static_cast<char>('0' + i % 10);
+        i /= 10;
+    } while (i != 0);
+    return static_cast<size_t>(buf + MAX_DECIMAL_DIGITS - p);
+}
+
+} // unnamed namespace
+
+
+HealpixPixelization::HealpixPixelization(int level, size_t cacheSize) :
+    _level{level}
+{
+    if (level < 0 || level > MAX_LEVEL) {
+        throw std::invalid_argument("HEALPix level not in [0, 29]");
+    }
+    if (cacheSize > 0) {
+        _cache = std::make_shared<detail::PixelCache<4>>(cacheSize);
+    }
+}
+
+ConvexPolygon HealpixPixelization::quad(uint64_t i) const {
+    UnitVector3d verts[NUM_VERTICES];
+    _vertices(i, verts);
+    return ConvexPolygon(verts[0], verts[1], verts[2], verts[3]);
+}
+
+std::string HealpixPixelization::toString(uint64_t i) const {
+    if (i >= static_cast<uint64_t>(12) << (2 * _level)) {
+        throw std::invalid_argument("Invalid HEALPix index");
+    }
+    return std::to_string(i);
+}
+
+void HealpixPixelization::toString(uint64_t const * indexes,
+                                   size_t n,
+                                   char * out,
+                                   size_t width) const
+{
+    uint64_t const end = static_cast<uint64_t>(12) << (2 * _level);
+    char buf[MAX_DECIMAL_DIGITS];
+    for (size_t k = 0; k < n; ++k, out += width) {
+        if (indexes[k] >= end) {
+            throw std::invalid_argument("Invalid HEALPix index");
+        }
+        size_t len = formatDecimal(indexes[k], buf);
+        if (len > width) {
+            throw std::invalid_argument(
+                "HEALPix index string is longer than the field width");
+        }
+        std::copy(buf + (MAX_DECIMAL_DIGITS - len), buf + MAX_DECIMAL_DIGITS,
+                  out);
+        std::fill(out + len, out + width, '\0');
+    }
+}
+
+size_t HealpixPixelization::maxStringLength() const {
+    char buf[MAX_DECIMAL_DIGITS];
+    return formatDecimal((static_cast<uint64_t>(12) << (2 * _level)) - 1, buf);
+}
+
+uint64_t HealpixPixelization::fromString(char const * s, size_t n) const {
+    // Valid indexes are less than 12·4²⁹ < 10¹⁹, so that accumulating at
+    // most 19 digits cannot overflow.
+    if (n == 0 || n >= MAX_DECIMAL_DIGITS || (n > 1 && s[0] == '0')) {
+        throw std::invalid_argument("Invalid HEALPix index string");
+    }
+    uint64_t i = 0;
+    for (size_t j = 0; j < n; ++j) {
+        if (s[j] < '0' || s[j] > '9') {
+            throw std::invalid_argument("Invalid HEALPix index string");
+        }
+        i = 10 * i + static_cast<uint64_t>(s[j] - '0');
+    }
+    if (i >= static_cast<uint64_t>(12) << (2 * _level)) {
+        throw std::invalid_argument("Invalid HEALPix index string");
+    }
+    return i;
+}
+
+std::unique_ptr<Region> HealpixPixelization::pixel(uint64_t i) const {
+    return std::unique_ptr<Region>(new ConvexPolygon(quad(i)));
+}
+
+void HealpixPixelization::vertices(uint64_t const * indexes,
+                                   size_t n,
+                                   double * out) const
+{
+    for (size_t k = 0; k < n; ++k) {
+        UnitVector3d verts[NUM_VERTICES];
+        _vertices(indexes[k], verts);
+        for (int j = 0; j < NUM_VERTICES; ++j, out += 3) {
+            out[0] = verts[j].x();
+            out[1] = verts[j].y();
+            out[2] = verts[j].z();
+        }
+    }
+}
+
+void HealpixPixelization::_vertices(uint64_t i, UnitVector3d * verts) const {
+    if (i >= static_cast<uint64_t>(12) << (2 * _level)) {
+        throw std::invalid_argument("Invalid HEALPix index");
+    }
+    if (_cache) {
+        int const level = _level;
+        _cache->get(i, verts, [level](uint64_t j, UnitVector3d * v) {
+            makeQuad(j, level, v);
+        });
+    } else {
+        makeQuad(i, _level, verts);
+    }
+}
+
+uint64_t HealpixPixelization::index(UnitVector3d const & p) const {
+    return computeIndex(p, _level);
+}
+
+void HealpixPixelization::index(double const * x,
+                                double const * y,
+                                double const * z,
+                                uint64_t * out,
+                                size_t n) const
+{
+    int const level = _level;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = computeIndex(UnitVector3d(x[i], y[i], z[i]), level);
+    }
+}
+
+std::vector<RangeSet> HealpixPixelization::envelopeAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    return detail::findPixelsAtLevels<HealpixPixelFinder, false>(r, levels, MAX_LEVEL);
+}
+
+std::vector<RangeSet> HealpixPixelization::interiorAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    return detail::findPixelsAtLevels<HealpixPixelFinder, true>(r, levels, MAX_LEVEL);
+}
+
+RangeSet HealpixPixelization::_envelope(Region const & r,
+                                        size_t maxRanges,
+                                        unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::HEALPIX_ENVELOPE_CALLS);
+    return detail::findPixels<HealpixPixelFinder, false>(
+        r, maxRanges, _level, numThreads);
+}
+
+RangeSet HealpixPixelization::_interior(Region const & r,
+                                        size_t maxRanges,
+                                        unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::HEALPIX_INTERIOR_CALLS);
+    return detail::findPixels<HealpixPixelFinder, true>(
+        r, maxRanges, _level, numThreads);
+}
+
+RangeSet HealpixPixelization::_adaptiveEnvelope(Region const & r,
+                                                size_t targetRanges,
+                                                double areaBudget) const {
+    return detail::findPixelsAdaptive<HealpixPixelFinder, false>(
+        r, _level, targetRanges, areaBudget, PI / 3.0);
+}
+
+RangeSet HealpixPixelization::_adaptiveInterior(Region const & r,
+                                                size_t targetRanges,
+                                                double areaBudget) const {
+    return detail::findPixelsAdaptive<HealpixPixelFinder, true>(
+        r, _level, targetRanges, areaBudget, PI / 3.0);
+}
+
+ProgressiveEnvelope HealpixPixelization::_progressiveEnvelope(
+    Region const & r) const
+{
+    return ProgressiveEnvelope(
+        detail::findPixelsProgressive<HealpixPixelFinder>(r, _level, PI / 3.0));
+}
+
+EnvelopeAndInterior HealpixPixelization::_envelopeAndInterior(
+    Region const & r,
+    size_t maxRanges) const
+{
+    return detail::findEnvelopeAndInterior<HealpixPixelFinder>(
+        r, maxRanges, _level);
+}
+
+CoverageFractions HealpixPixelization::_coverageFraction(
+    Region const & r) const
+{
+    return detail::findCoverage<HealpixPixelFinder>(r, _level);
+}
+
+RangeSet HealpixPixelization::_envelope(Pixelization const & from,
+                                        RangeSet const & pixels,
+                                        size_t maxRanges,
+                                        unsigned numThreads) const {
+    return detail::findPixels<HealpixPixelFinder, false>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
+}
+
+RangeSet HealpixPixelization::_interior(Pixelization const & from,
+                                        RangeSet const & pixels,
+                                        size_t maxRanges,
+                                        unsigned numThreads) const {
+    return detail::findPixels<HealpixPixelFinder, true>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
+}
+
+}} // namespace lsst::sphgeom
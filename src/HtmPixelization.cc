@@ -25,9 +25,16 @@
 
 #include "lsst/sphgeom/HtmPixelization.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "lsst/sphgeom/curve.h"
+#include "lsst/sphgeom/inlineKernels.h"
 #include "lsst/sphgeom/orientation.h"
 
+#include "HtmTables.h"
+#include "PerformanceCounting.h"
+#include "PixelCache.h"
 #include "PixelFinder.h"
 
 
@@ -36,31 +43,175 @@ namespace sphgeom {
 
 namespace {
 
-// `rootVertex` returns the i-th (0-3) root vertex of HTM root triangle r (0-8).
-UnitVector3d const & rootVertex(int r, int i) {
-    static UnitVector3d const VERTICES[8][3] = {
-        { UnitVector3d::X(), -UnitVector3d::Z(),  UnitVector3d::Y()},
-        { UnitVector3d::Y(), -UnitVector3d::Z(), -UnitVector3d::X()},
-        {-UnitVector3d::X(), -UnitVector3d::Z(), -UnitVector3d::Y()},
-        {-UnitVector3d::Y(), -UnitVector3d::Z(),  UnitVector3d::X()},
-        { UnitVector3d::X(),  UnitVector3d::Z(), -UnitVector3d::Y()},
-        {-UnitVector3d::Y(),  UnitVector3d::Z(), -UnitVector3d::X()},
-        {-UnitVector3d::X(),  UnitVector3d::Z(),  UnitVector3d::Y()},
-        { UnitVector3d::Y(),  UnitVector3d::Z(),  UnitVector3d::X()}
+using detail::HTM_CHILD_EDGE_NORMALS;
+using detail::HTM_TABLE_LEVEL;
+using detail::HTM_TRIXEL_VERTICES;
+using detail::htmTableRow;
+
+// `tableVertex` returns the j-th (0-2) vertex of the trixel with index i
+// at subdivision level l <= HTM_TABLE_LEVEL.
+inline UnitVector3d tableVertex(uint64_t i, int l, int j) {
+    double const * v = HTM_TRIXEL_VERTICES[htmTableRow(i, l)][j];
+    return UnitVector3d::fromNormalized(v[0], v[1], v[2]);
+}
+
+// `rootVertex` returns the i-th (0-2) root vertex of HTM root triangle r (0-7).
+inline UnitVector3d rootVertex(int r, int i) {
+    return tableVertex(static_cast<uint64_t>(r + 8), 0, i);
+}
+
+// `side` returns orientation(v, a, b), given the tabulated double precision
+// cross product n of a and b. The dot product of v and n is exactly the
+// determinant computed by inlined::orientation, so the same error bound
+// applies, and only points very close to the edge need the exact test.
+inline int side(UnitVector3d const & v, double const * n,
+                UnitVector3d const & a, UnitVector3d const & b) {
+    double d = v.x() * n[0] + v.y() * n[1] + v.z() * n[2];
+    if (d > ORIENTATION_MAX_ABSOLUTE_ERROR) {
+        return 1;
+    } else if (d < -ORIENTATION_MAX_ABSOLUTE_ERROR) {
+        return -1;
+    }
+    return orientation(v, a, b);
+}
+
+// `locate` returns the HTM index of v at the given subdivision level, and
+// passes the vertices of the trixels containing v at levels 0 through
+// `level` to `f`. These are computed exactly as in makeChildTriangles.
+template <typename F>
+inline uint64_t locate(UnitVector3d const & v, int level, F const & f) {
+    // Find the root triangle containing v.
+    uint64_t r;
+    if (v.z() < 0.0) {
+        // v is in the southern hemisphere (root triangle 0, 1, 2, or 3).
+        if (v.y() > 0.0) {
+            r = (v.x() > 0.0) ? 0 : 1;
+        } else if (v.y() == 0.0) {
+            r = (v.x() >= 0.0) ? 0 : 2;
+        } else {
+            r = (v.x() < 0.0) ? 2 : 3;
+        }
+    } else {
+        // v is in the northern hemisphere (root triangle 4, 5, 6, or 7).
+        if (v.y() > 0.0) {
+            r = (v.x() > 0.0) ? 7 : 6;
+        } else if (v.y() == 0.0) {
+            r = (v.x() >= 0.0) ? 7 : 5;
+        } else {
+            r = (v.x() < 0.0) ? 5 : 4;
+        }
+    }
+    uint64_t i = r + 8;
+    UnitVector3d v0 = tableVertex(i, 0, 0);
+    UnitVector3d v1 = tableVertex(i, 0, 1);
+    UnitVector3d v2 = tableVertex(i, 0, 2);
+    f(0, v0, v1, v2);
+    int l = 0;
+    // Near the root, edge midpoints are the tabulated vertices of the
+    // first two children, and the edge normals are tabulated as well.
+    for (; l < level && l < HTM_TABLE_LEVEL; ++l) {
+        double const (*n)[3] = HTM_CHILD_EDGE_NORMALS[htmTableRow(i, l)];
+        i <<= 2;
+        UnitVector3d m01 = tableVertex(i, l + 1, 1);
+        UnitVector3d m20 = tableVertex(i, l + 1, 2);
+        if (side(v, n[0], m01, m20) < 0) {
+            UnitVector3d m12 = tableVertex(i + 1, l + 1, 1);
+            if (side(v, n[1], m12, m01) >= 0) {
+                i += 1;
+            } else if (side(v, n[2], m20, m12) >= 0) {
+                i += 2;
+            } else {
+                i += 3;
+            }
+        }
+        v0 = tableVertex(i, l + 1, 0);
+        v1 = tableVertex(i, l + 1, 1);
+        v2 = tableVertex(i, l + 1, 2);
+        f(l + 1, v0, v1, v2);
+    }
+    for (; l < level; ++l) {
+        UnitVector3d m01 = inlined::normalized(v0 + v1);
+        UnitVector3d m20 = inlined::normalized(v2 + v0);
+        i <<= 2;
+        if (inlined::orientation(v, m01, m20) >= 0) {
+            v1 = m01; v2 = m20;
+        } else {
+            UnitVector3d m12 = inlined::normalized(v1 + v2);
+            if (inlined::orientation(v, m12, m01) >= 0) {
+                v0 = v1; v1 = m12; v2 = m01;
+                i += 1;
+            } else if (inlined::orientation(v, m20, m12) >= 0) {
+                v0 = v2; v1 = m20; v2 = m12;
+                i += 2;
+            } else {
+                v0 = m12; v1 = m20; v2 = m01;
+                i += 3;
+            }
+        }
+        f(l + 1, v0, v1, v2);
+    }
+    return i;
+}
+
+// `computeIndex` returns the HTM index of v at the given subdivision level.
+inline uint64_t computeIndex(UnitVector3d const & v, int level) {
+    return locate(v, level, [](int, UnitVector3d const &,
+                               UnitVector3d const &, UnitVector3d const &) {});
+}
+
+// `makeChildTriangles` computes the vertices of the children of the trixel
+// with the given vertices, index and subdivision level. Siblings share edge
+// midpoints, which are therefore computed only once. Near the root, the
+// children are looked up instead.
+inline void makeChildTriangles(UnitVector3d const * trixel,
+                               uint64_t i,
+                               int level,
+                               UnitVector3d (*child)[3])
+{
+    if (level < HTM_TABLE_LEVEL) {
+        for (int c = 0; c < 4; ++c) {
+            for (int v = 0; v < 3; ++v) {
+                child[c][v] = tableVertex(4 * i + c, level + 1, v);
+            }
+        }
+        return;
+    }
+    UnitVector3d mid[3] = {
+        UnitVector3d(trixel[1] + trixel[2]),
+        UnitVector3d(trixel[2] + trixel[0]),
+        UnitVector3d(trixel[0] + trixel[1])
     };
-    return VERTICES[r][i];
+    child[0][0] = trixel[0];
+    child[0][1] = mid[2];
+    child[0][2] = mid[1];
+    child[1][0] = trixel[1];
+    child[1][1] = mid[0];
+    child[1][2] = mid[2];
+    child[2][0] = trixel[2];
+    child[2][1] = mid[1];
+    child[2][2] = mid[0];
+    child[3][0] = mid[0];
+    child[3][1] = mid[1];
+    child[3][2] = mid[2];
 }
 
 // `HtmPixelFinder` locates trixels that intersect a region.
+//
+// For large regions, the traversal begins with a loop over the root
+// triangles. For small regions, it instead starts at the trixel containing
+// the region bounding circle, found by locating its center at a level
+// where trixels are much larger than the circle, and checking whether that
+// trixel or one of its two closest ancestors contains the circle.
 template <typename RegionType, bool InteriorOnly>
 class HtmPixelFinder: public detail::PixelFinder<
     HtmPixelFinder<RegionType, InteriorOnly>, RegionType, InteriorOnly, 3>
 {
     using Base = detail::PixelFinder<
         HtmPixelFinder<RegionType, InteriorOnly>, RegionType, InteriorOnly, 3>;
-    using Base::visit;
 
 public:
+    using Base::visit;
+
     HtmPixelFinder(RangeSet & ranges,
                    RegionType const & region,
                    int level,
@@ -69,6 +220,25 @@ public:
     {}
 
     void operator()() {
+        Circle const c = detail::boundingCircle(this->region());
+        int l = this->seedLevel(c, SEED_WIDTH);
+        if (l >= 0) {
+            UnitVector3d path[MAX_LEVEL + 1][3];
+            uint64_t i = locate(
+                c.getCenter(), l,
+                [&path](int k, UnitVector3d const & v0,
+                        UnitVector3d const & v1, UnitVector3d const & v2) {
+                    path[k][0] = v0;
+                    path[k][1] = v1;
+                    path[k][2] = v2;
+                });
+            for (int k = 0; k < 3 && l >= 0; ++k, --l, i >>= 2) {
+                if ((detail::relate(path[l], path[l] + 3, c) & CONTAINS) != 0) {
+                    this->visitSeed(path[l], i, l);
+                    return;
+                }
+            }
+        }
         UnitVector3d trixel[3];
         // Loop over HTM root triangles.
         for (uint64_t r = 0; r < 8; ++r) {
@@ -79,31 +249,271 @@ public:
         }
     }
 
-    void subdivide(UnitVector3d const * trixel, uint64_t index, int level) {
-        UnitVector3d mid[3] = {
-            UnitVector3d(trixel[1] + trixel[2]),
-            UnitVector3d(trixel[2] + trixel[0]),
-            UnitVector3d(trixel[0] + trixel[1])
-        };
-        UnitVector3d child[3] = {trixel[0], mid[2], mid[1]};
-        index *= 4;
-        ++level;
-        visit(child, index, level);
-        child[0] = trixel[1];
-        child[1] = mid[0];
-        child[2] = mid[2];
-        ++index;
-        visit(child, index, level);
-        child[0] = trixel[2];
-        child[1] = mid[1];
-        child[2] = mid[0];
-        ++index;
-        visit(child, index, level);
-        ++index;
-        visit(mid, index, level);
+    static constexpr int MAX_LEVEL = HtmPixelization::MAX_LEVEL;
+
+    // Bounding circles are located at the deepest level L where their
+    // chord length radius is below SEED_WIDTH * 2^-L, at which trixels
+    // usually contain them, because their inscribed circles have radii
+    // of about 0.45 * 2^-L.
+    static constexpr double SEED_WIDTH = 0.1;
+
+    // The vertices of the children of a trixel.
+    struct Cache {
+        UnitVector3d child[4][3];
+    };
+
+    void expand(UnitVector3d const * trixel,
+                uint64_t index,
+                int level,
+                Cache & cache)
+    {
+        makeChildTriangles(trixel, index, level, cache.child);
+    }
+
+    UnitVector3d const * child(Cache const & cache,
+                               uint64_t index,
+                               int,
+                               UnitVector3d *) {
+        return cache.child[index & 3];
+    }
+};
+
+// `makeTriangle` computes the vertices of the trixel with the given valid
+// HTM index and subdivision level.
+void makeTriangle(uint64_t i, int l, UnitVector3d * verts) {
+    // Start from the tabulated ancestor closest to the trixel.
+    int const t = std::min(l, HTM_TABLE_LEVEL);
+    uint64_t const a = i >> (2 * (l - t));
+    UnitVector3d v0 = tableVertex(a, t, 0);
+    UnitVector3d v1 = tableVertex(a, t, 1);
+    UnitVector3d v2 = tableVertex(a, t, 2);
+    for (l = 2 * (l - t - 1); l >= 0; l -= 2) {
+        int child = (i >> l) & 3;
+        UnitVector3d m12 = UnitVector3d(v1 + v2);
+        UnitVector3d m20 = UnitVector3d(v2 + v0);
+        UnitVector3d m01 = UnitVector3d(v0 + v1);
+        switch (child) {
+            case 0: v1 = m01; v2 = m20; break;
+            case 1: v0 = v1; v1 = m12; v2 = m01; break;
+            case 2: v0 = v2; v1 = m20; v2 = m12; break;
+            case 3: v0 = m12; v1 = m20; v2 = m01; break;
+        }
+    }
+    verts[0] = v0;
+    verts[1] = v1;
+    verts[2] = v2;
+}
+
+// An `Adjacency` identifies the trixel on the other side of some trixel
+// edge, along with the index of that edge in the neighboring trixel. The
+// j-th edge of a trixel with vertices (v₀, v₁, v₂) is the one opposite vⱼ,
+// running from vⱼ₊₁ to vⱼ₊₂ (indexes modulo 3). Since all trixels are
+// counter-clockwise, neighbors traverse their shared edge in opposite
+// directions: if trixel T has neighbor N across edge j of T and edge k of N,
+// then vertex j + 1 of T is vertex k + 2 of N, and vertex j + 2 of T is
+// vertex k + 1 of N.
+struct Adjacency {
+    uint64_t trixel;
+    int edge;
+};
+
+// `rootAdjacency` returns the neighbor of root triangle r (0-7) across
+// its j-th edge.
+inline Adjacency rootAdjacency(int r, int j) {
+    uint8_t const * a = detail::HTM_ROOT_ADJACENCY[r][j];
+    return Adjacency{static_cast<uint64_t>(a[0] + 8), a[1]};
+}
+
+// `findEdgeNeighbors` stores the neighbors of the trixel with the given
+// valid HTM index and subdivision level across each of its edges in
+// `neighbors`.
+//
+// The neighbors are computed by descending the trixel tree from the root,
+// using the fact that the children of a trixel (v₀, v₁, v₂) with edge
+// midpoints m₀ ⊥ v₁+v₂, m₁ ⊥ v₂+v₀, m₂ ⊥ v₀+v₁ are (v₀, m₂, m₁),
+// (v₁, m₀, m₂), (v₂, m₁, m₀) and (m₀, m₁, m₂). The first edge of a corner
+// child c < 3 is shared with the center child, whose c-th edge it is, and
+// its other two edges are halves of edges c + 1 and c + 2 of the parent.
+// The neighbor across such a half edge is the corner child of the parent's
+// neighbor that contains vertex c of the parent.
+void findEdgeNeighbors(uint64_t i, int level, Adjacency * neighbors) {
+    int const r = static_cast<int>((i >> (2 * level)) & 7);
+    for (int j = 0; j < 3; ++j) {
+        neighbors[j] = rootAdjacency(r, j);
+    }
+    uint64_t parent = r + 8;
+    for (int l = 2 * (level - 1); l >= 0; l -= 2) {
+        int const c = static_cast<int>((i >> l) & 3);
+        if (c == 3) {
+            for (int j = 0; j < 3; ++j) {
+                neighbors[j] = Adjacency{4 * parent + j, 0};
+            }
+        } else {
+            Adjacency const n1 = neighbors[(c + 1) % 3];
+            Adjacency const n2 = neighbors[(c + 2) % 3];
+            // Parent vertex c is vertex k + 1 of the neighbor across
+            // (parent) edge c + 1, and vertex k + 2 of the one across
+            // edge c + 2, where k is the index of the edge in the neighbor.
+            int const k1 = (n1.edge + 1) % 3;
+            int const k2 = (n2.edge + 2) % 3;
+            neighbors[0] = Adjacency{4 * parent + 3, c};
+            // Half of edge k + 1 of a parent is edge 1 of its child k,
+            // and half of edge k + 2 is edge 2.
+            neighbors[1] = Adjacency{4 * n1.trixel + k1,
+                                     n1.edge == (k1 + 1) % 3 ? 1 : 2};
+            neighbors[2] = Adjacency{4 * n2.trixel + k2,
+                                     n2.edge == (k2 + 1) % 3 ? 1 : 2};
+        }
+        parent = 4 * parent + c;
+    }
+}
+
+// `findNeighborhood` stores the indexes of the trixels sharing a vertex
+// with the trixel with the given valid HTM index and subdivision level in
+// `dst`, which must have room for 16 indexes, and returns their number.
+// The trixel itself is included, and indexes are sorted and unique.
+//
+// The trixels around each vertex are found by stepping from one trixel
+// to the next across the edges incident to the vertex: vertex j of a
+// trixel is vertex k + 1 of its neighbor across edge j + 1, k being the
+// index of the edge in the neighbor.
+int findNeighborhood(uint64_t i, int level, uint64_t * dst) {
+    Adjacency neighbors[3];
+    findEdgeNeighbors(i, level, neighbors);
+    int n = 0;
+    dst[n++] = i;
+    for (int v = 0; v < 3; ++v) {
+        // At most 6 trixels meet at a vertex.
+        Adjacency a = neighbors[(v + 1) % 3];
+        for (int step = 0; step < 5 && a.trixel != i; ++step) {
+            dst[n++] = a.trixel;
+            Adjacency next[3];
+            findEdgeNeighbors(a.trixel, level, next);
+            a = next[(a.edge + 2) % 3];
+        }
     }
+    std::sort(dst, dst + n);
+    return static_cast<int>(std::unique(dst, dst + n) - dst);
+}
+
+// `AncestorPath` finds the smallest trixel, at subdivision level at most
+// `level`, that contains a circle. It keeps the trixels found for the
+// previous circle, and when circles are visited in spatial order, reuses
+// those that also contain the next one. Trixel vertices are computed by
+// makeChildTriangles, as in HtmPixelFinder.
+class AncestorPath {
+public:
+    explicit AncestorPath(int level) : _level(level), _depth(-1) {}
+
+    // `find` returns the level of the smallest trixel containing c, or -1
+    // if no root triangle contains c. The trixel is then available via
+    // index() and vertices().
+    int find(Circle const & c) {
+        // Nested trixels contain c up to some level, and the deepest of
+        // the previous trixels that contains c is found by bisection.
+        // Only trixels that have been checked to contain c are used as
+        // starting points, so rounding errors that break this monotonicity
+        // can only make the search start higher up in the hierarchy.
+        int lo = -1;
+        int hi = _depth + 1;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2;
+            if (_contains(_vertices[mid], c)) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+        _depth = lo;
+        if (_depth < 0) {
+            for (int r = 0; r < 8 && _depth < 0; ++r) {
+                UnitVector3d * v = _vertices[0];
+                for (int i = 0; i < 3; ++i) {
+                    v[i] = rootVertex(r, i);
+                }
+                if (_contains(v, c)) {
+                    _depth = 0;
+                    _index[0] = r + 8;
+                }
+            }
+            if (_depth < 0) {
+                return -1;
+            }
+        }
+        // Descend into children containing c.
+        while (_depth < _level) {
+            UnitVector3d children[4][3];
+            makeChildTriangles(_vertices[_depth], _index[_depth], _depth,
+                               children);
+            int child = 0;
+            while (child < 4 && !_contains(children[child], c)) {
+                ++child;
+            }
+            if (child == 4) {
+                break;
+            }
+            ++_depth;
+            std::copy(children[child], children[child] + 3, _vertices[_depth]);
+            _index[_depth] = _index[_depth - 1] * 4 + child;
+        }
+        return _depth;
+    }
+
+    uint64_t index(int l) const { return _index[l]; }
+    UnitVector3d const * vertices(int l) const { return _vertices[l]; }
+
+private:
+    static bool _contains(UnitVector3d const * v, Circle const & c) {
+        return (detail::relate(v, v + 3, c) & CONTAINS) != 0;
+    }
+
+    int _level;
+    int _depth;
+    uint64_t _index[HtmPixelization::MAX_LEVEL + 1];
+    UnitVector3d _vertices[HtmPixelization::MAX_LEVEL + 1][3];
 };
 
+// `findMany` computes the envelopes or interiors of n regions, which
+// should be in spatial order. The traversal for each region starts at the
+// smallest trixel containing its bounding circle, rather than at the root
+// triangles.
+template <bool InteriorOnly, typename Sink>
+void findMany(Region const * const * regions,
+              size_t n,
+              size_t maxRanges,
+              int level,
+              Sink const & sink)
+{
+    AncestorPath path(level);
+    RangeSet s;
+    for (size_t i = 0; i < n; ++i) {
+        Region const & r = *regions[i];
+        int const l = path.find(r.getBoundingCircle());
+        s.clear();
+        detail::findPixelsFrom<HtmPixelFinder, InteriorOnly>(
+            s, r, maxRanges, level,
+            [&](auto & find) {
+                if (l < 0) {
+                    find();
+                } else {
+                    find.visit(path.vertices(l), path.index(l), l);
+                }
+            });
+        sink(i, s);
+    }
+}
+
+// `formatIndex` writes the string for the HTM index i, which has level l,
+// to the l + 2 characters starting at dst.
+void formatIndex(uint64_t i, int l, char * dst) {
+    // Print in base-4, from least to most significant digit.
+    for (char * p = dst + l + 1; p != dst; --p, i >>= 2) {
+        *p = '0' + (i & 3);
+    }
+    // The remaining bit corresponds to the hemisphere.
+    *dst = (i & 1) == 0 ? 'S' : 'N';
+}
+
 } // unnamed namespace
 
 
@@ -120,29 +530,75 @@ int HtmPixelization::level(uint64_t i) {
     return (j - 3) >> 1;
 }
 
-ConvexPolygon HtmPixelization::triangle(uint64_t i) {
+std::vector<uint64_t> HtmPixelization::neighborhood(uint64_t i) {
     int l = level(i);
     if (l < 0 || l > MAX_LEVEL) {
         throw std::invalid_argument("Invalid HTM index");
     }
-    l *= 2;
-    uint64_t r = (i >> l) & 7;
-    UnitVector3d v0 = rootVertex(r, 0);
-    UnitVector3d v1 = rootVertex(r, 1);
-    UnitVector3d v2 = rootVertex(r, 2);
-    for (l -= 2; l >= 0; l -= 2) {
-        int child = (i >> l) & 3;
-        UnitVector3d m12 = UnitVector3d(v1 + v2);
-        UnitVector3d m20 = UnitVector3d(v2 + v0);
-        UnitVector3d m01 = UnitVector3d(v0 + v1);
-        switch (child) {
-            case 0: v1 = m01; v2 = m20; break;
-            case 1: v0 = v1; v1 = m12; v2 = m01; break;
-            case 2: v0 = v2; v1 = m20; v2 = m12; break;
-            case 3: v0 = m12; v1 = m20; v2 = m01; break;
+    uint64_t indexes[16];
+    int n = findNeighborhood(i, l, indexes);
+    return std::vector<uint64_t>(indexes, indexes + n);
+}
+
+RangeSet HtmPixelization::neighborhood(uint64_t i, int k) {
+    int l = level(i);
+    if (l < 0 || l > MAX_LEVEL) {
+        throw std::invalid_argument("Invalid HTM index");
+    }
+    if (k < 0) {
+        throw std::invalid_argument("Neighborhood radius must be non-negative");
+    }
+    // Breadth first search, where each step adds the trixels sharing
+    // a vertex with a trixel added by the previous step.
+    RangeSet result(i);
+    std::vector<uint64_t> frontier(1, i);
+    std::vector<uint64_t> next;
+    for (; k > 0 && !frontier.empty(); --k) {
+        next.clear();
+        for (uint64_t j: frontier) {
+            uint64_t indexes[16];
+            int n = findNeighborhood(j, l, indexes);
+            for (int m = 0; m < n; ++m) {
+                if (!result.contains(indexes[m])) {
+                    result.insert(indexes[m]);
+                    next.push_back(indexes[m]);
+                }
+            }
+        }
+        frontier.swap(next);
+    }
+    return result;
+}
+
+void HtmPixelization::neighborhood(uint64_t const * indexes,
+                                   size_t n,
+                                   std::vector<size_t> & offsets,
+                                   std::vector<uint64_t> & neighbors) {
+    offsets.clear();
+    neighbors.clear();
+    offsets.reserve(n + 1);
+    neighbors.reserve(13 * n);
+    offsets.push_back(0);
+    for (size_t p = 0; p < n; ++p) {
+        int l = level(indexes[p]);
+        if (l < 0 || l > MAX_LEVEL) {
+            throw std::invalid_argument("Invalid HTM index");
         }
+        uint64_t buf[16];
+        int m = findNeighborhood(indexes[p], l, buf);
+        neighbors.insert(neighbors.end(), buf, buf + m);
+        offsets.push_back(neighbors.size());
+    }
+}
+
+ConvexPolygon HtmPixelization::triangle(uint64_t i) {
+    int l = level(i);
+    if (l < 0 || l > MAX_LEVEL) {
+        throw std::invalid_argument("Invalid HTM index");
     }
-    return ConvexPolygon(v0, v1, v2);
+    UnitVector3d verts[3];
+    makeTriangle(i, l, verts);
+    return ConvexPolygon(verts[0], verts[1], verts[2]);
 }
 
 std::string HtmPixelization::asString(uint64_t i) {
@@ -151,77 +607,196 @@ std::string HtmPixelization::asString(uint64_t i) {
     if (l < 0 || l > MAX_LEVEL) {
         throw std::invalid_argument("Invalid HTM index");
     }
-    // Print in base-4, from least to most significant digit.
-    char * p = s + (sizeof(s) - 1);
-    for (; l >= 0; --l, --p, i >>= 2) {
-        *p = '0' + (i & 3);
+    formatIndex(i, l, s);
+    return std::string(s, static_cast<size_t>(l) + 2);
+}
+
+void HtmPixelization::toString(uint64_t const * indexes,
+                               size_t n,
+                               char * out,
+                               size_t width) const
+{
+    for (size_t k = 0; k < n; ++k, out += width) {
+        int l = level(indexes[k]);
+        if (l < 0 || l > MAX_LEVEL) {
+            throw std::invalid_argument("Invalid HTM index");
+        }
+        size_t len = static_cast<size_t>(l) + 2;
+        if (len > width) {
+            throw std::invalid_argument(
+                "HTM index string is longer than the field width");
+        }
+        formatIndex(indexes[k], l, out);
+        std::fill(out + len, out + width, '\0');
     }
-    // The remaining bit corresponds to the hemisphere.
-    *p = (i & 1) == 0 ? 'S' : 'N';
-    return std::string(p, sizeof(s) - static_cast<size_t>(p - s));
 }
 
-HtmPixelization::HtmPixelization(int level) : _level(level) {
+uint64_t HtmPixelization::fromString(char const * s, size_t n) const {
+    if (n < 2 || n > MAX_LEVEL + 2 || (s[0] != 'N' && s[0] != 'S')) {
+        throw std::invalid_argument("Invalid HTM index string");
+    }
+    uint64_t i = s[0] == 'N' ? 3 : 2;
+    for (size_t j = 1; j < n; ++j) {
+        if (s[j] < '0' || s[j] > '3') {
+            throw std::invalid_argument("Invalid HTM index string");
+        }
+        i = (i << 2) | static_cast<uint64_t>(s[j] - '0');
+    }
+    return i;
+}
+
+HtmPixelization::HtmPixelization(int level, size_t cacheSize) :
+    _level(level)
+{
     if (level < 0 || level > MAX_LEVEL) {
         throw std::invalid_argument("Invalid HTM subdivision level");
     }
+    if (cacheSize > 0) {
+        _cache = std::make_shared<detail::PixelCache<3>>(cacheSize);
+    }
 }
 
-uint64_t HtmPixelization::index(UnitVector3d const & v) const {
-    // Find the root triangle containing v.
-    uint64_t r;
-    if (v.z() < 0.0) {
-        // v is in the southern hemisphere (root triangle 0, 1, 2, or 3).
-        if (v.y() > 0.0) {
-            r = (v.x() > 0.0) ? 0 : 1;
-        } else if (v.y() == 0.0) {
-            r = (v.x() >= 0.0) ? 0 : 2;
-        } else {
-            r = (v.x() < 0.0) ? 2 : 3;
+std::unique_ptr<Region> HtmPixelization::pixel(uint64_t i) const {
+    UnitVector3d verts[NUM_VERTICES];
+    _vertices(i, verts);
+    return std::unique_ptr<Region>(
+        new ConvexPolygon(verts[0], verts[1], verts[2]));
+}
+
+void HtmPixelization::vertices(uint64_t const * indexes,
+                               size_t n,
+                               double * out) const
+{
+    for (size_t k = 0; k < n; ++k) {
+        UnitVector3d verts[NUM_VERTICES];
+        _vertices(indexes[k], verts);
+        for (int j = 0; j < NUM_VERTICES; ++j, out += 3) {
+            out[0] = verts[j].x();
+            out[1] = verts[j].y();
+            out[2] = verts[j].z();
         }
+    }
+}
+
+void HtmPixelization::_vertices(uint64_t i, UnitVector3d * verts) const {
+    int l = level(i);
+    if (l < 0 || l > MAX_LEVEL) {
+        throw std::invalid_argument("Invalid HTM index");
+    }
+    if (_cache) {
+        _cache->get(i, verts, [l](uint64_t j, UnitVector3d * v) {
+            makeTriangle(j, l, v);
+        });
     } else {
-        // v is in the northern hemisphere (root triangle 4, 5, 6, or 7).
-        if (v.y() > 0.0) {
-            r = (v.x() > 0.0) ? 7 : 6;
-        } else if (v.y() == 0.0) {
-            r = (v.x() >= 0.0) ? 7 : 5;
-        } else {
-            r = (v.x() < 0.0) ? 5 : 4;
-        }
+        makeTriangle(i, l, verts);
     }
-    UnitVector3d v0 = rootVertex(r, 0);
-    UnitVector3d v1 = rootVertex(r, 1);
-    UnitVector3d v2 = rootVertex(r, 2);
-    uint64_t i = r + 8;
-    for (int l = 0; l < _level; ++l) {
-        UnitVector3d m01 = UnitVector3d(v0 + v1);
-        UnitVector3d m20 = UnitVector3d(v2 + v0);
-        i <<= 2;
-        if (orientation(v, m01, m20) >= 0) {
-            v1 = m01; v2 = m20;
-            continue;
-        }
-        UnitVector3d m12 = UnitVector3d(v1 + v2);
-        if (orientation(v, m12, m01) >= 0) {
-            v0 = v1; v1 = m12; v2 = m01;
-            i += 1;
-        } else if (orientation(v, m20, m12) >= 0) {
-            v0 = v2; v1 = m20; v2 = m12;
-            i += 2;
-        } else {
-            v0 = m12; v1 = m20; v2 = m01;
-            i += 3;
-        }
+}
+
+uint64_t HtmPixelization::index(UnitVector3d const & v) const {
+    return computeIndex(v, _level);
+}
+
+void HtmPixelization::index(double const * x,
+                            double const * y,
+                            double const * z,
+                            uint64_t * out,
+                            size_t n) const
+{
+    int const level = _level;
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = computeIndex(UnitVector3d(x[i], y[i], z[i]), level);
     }
-    return i;
 }
 
-RangeSet HtmPixelization::_envelope(Region const & r, size_t maxRanges) const {
-    return detail::findPixels<HtmPixelFinder, false>(r, maxRanges, _level);
+std::vector<RangeSet> HtmPixelization::envelopeAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    return detail::findPixelsAtLevels<HtmPixelFinder, false>(r, levels, MAX_LEVEL);
+}
+
+std::vector<RangeSet> HtmPixelization::interiorAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    return detail::findPixelsAtLevels<HtmPixelFinder, true>(r, levels, MAX_LEVEL);
+}
+
+RangeSet HtmPixelization::_envelope(Region const & r,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::HTM_ENVELOPE_CALLS);
+    return detail::findPixels<HtmPixelFinder, false>(
+        r, maxRanges, _level, numThreads);
+}
+
+RangeSet HtmPixelization::_interior(Region const & r,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::HTM_INTERIOR_CALLS);
+    return detail::findPixels<HtmPixelFinder, true>(
+        r, maxRanges, _level, numThreads);
+}
+
+void HtmPixelization::_findMany(Region const * const * regions,
+                                size_t n,
+                                size_t maxRanges,
+                                bool interior,
+                                RangeSetSink const & sink) const {
+    if (interior) {
+        findMany<true>(regions, n, maxRanges, _level, sink);
+    } else {
+        findMany<false>(regions, n, maxRanges, _level, sink);
+    }
+}
+
+RangeSet HtmPixelization::_adaptiveEnvelope(Region const & r,
+                                            size_t targetRanges,
+                                            double areaBudget) const {
+    return detail::findPixelsAdaptive<HtmPixelFinder, false>(
+        r, _level, targetRanges, areaBudget, 0.5 * PI);
+}
+
+RangeSet HtmPixelization::_adaptiveInterior(Region const & r,
+                                            size_t targetRanges,
+                                            double areaBudget) const {
+    return detail::findPixelsAdaptive<HtmPixelFinder, true>(
+        r, _level, targetRanges, areaBudget, 0.5 * PI);
+}
+
+ProgressiveEnvelope HtmPixelization::_progressiveEnvelope(
+    Region const & r) const
+{
+    return ProgressiveEnvelope(
+        detail::findPixelsProgressive<HtmPixelFinder>(r, _level, 0.5 * PI));
+}
+
+EnvelopeAndInterior HtmPixelization::_envelopeAndInterior(
+    Region const & r,
+    size_t maxRanges) const
+{
+    return detail::findEnvelopeAndInterior<HtmPixelFinder>(
+        r, maxRanges, _level);
+}
+
+CoverageFractions HtmPixelization::_coverageFraction(Region const & r) const {
+    return detail::findCoverage<HtmPixelFinder>(r, _level);
+}
+
+RangeSet HtmPixelization::_envelope(Pixelization const & from,
+                                    RangeSet const & pixels,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    return detail::findPixels<HtmPixelFinder, false>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
 }
 
-RangeSet HtmPixelization::_interior(Region const & r, size_t maxRanges) const {
-    return detail::findPixels<HtmPixelFinder, true>(r, maxRanges, _level);
+RangeSet HtmPixelization::_interior(Pixelization const & from,
+                                    RangeSet const & pixels,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    return detail::findPixels<HtmPixelFinder, true>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
 }
 
 }} // namespace lsst::sphgeom
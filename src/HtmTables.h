@@ -0,0 +1,3466 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+// This file was generated by misc/makeHtmTables.py. Do not edit.
+
+#ifndef LSST_SPHGEOM_HTMTABLES_H_
+#define LSST_SPHGEOM_HTMTABLES_H_
+
+#include <cstdint>
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+// `HTM_TABLE_LEVEL` is the deepest subdivision level with tabulated
+// trixel vertices.
+constexpr int HTM_TABLE_LEVEL = 3;
+
+// `htmTableRow` returns the row of `HTM_TRIXEL_VERTICES` holding the
+// trixel with index i at subdivision level l <= HTM_TABLE_LEVEL.
+// Trixels are stored by level, and in index order within a level.
+constexpr uint64_t htmTableRow(uint64_t i, int l) {
+    return i - (static_cast<uint64_t>(16) << (2 * l)) / 3 - 3;
+}
+
+// `HTM_TRIXEL_VERTICES` contains the (x, y, z) components of the
+// vertices of every trixel at levels 0 through HTM_TABLE_LEVEL.
+alignas(64) constexpr double HTM_TRIXEL_VERTICES[680][3][3] = {
+    // 8
+    {{1.0, 0.0, 0.0},
+     {-0.0, -0.0, -1.0},
+     {0.0, 1.0, 0.0}},
+    // 9
+    {{0.0, 1.0, 0.0},
+     {-0.0, -0.0, -1.0},
+     {-1.0, -0.0, -0.0}},
+    // 10
+    {{-1.0, -0.0, -0.0},
+     {-0.0, -0.0, -1.0},
+     {-0.0, -1.0, -0.0}},
+    // 11
+    {{-0.0, -1.0, -0.0},
+     {-0.0, -0.0, -1.0},
+     {1.0, 0.0, 0.0}},
+    // 12
+    {{1.0, 0.0, 0.0},
+     {0.0, 0.0, 1.0},
+     {-0.0, -1.0, -0.0}},
+    // 13
+    {{-0.0, -1.0, -0.0},
+     {0.0, 0.0, 1.0},
+     {-1.0, -0.0, -0.0}},
+    // 14
+    {{-1.0, -0.0, -0.0},
+     {0.0, 0.0, 1.0},
+     {0.0, 1.0, 0.0}},
+    // 15
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.0, 1.0},
+     {1.0, 0.0, 0.0}},
+    // 32
+    {{1.0, 0.0, 0.0},
+     {0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.7071067811865475, 0.7071067811865475, 0.0}},
+    // 33
+    {{-0.0, -0.0, -1.0},
+     {0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.7071067811865475, 0.0, -0.7071067811865475}},
+    // 34
+    {{0.0, 1.0, 0.0},
+     {0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.0, 0.7071067811865475, -0.7071067811865475}},
+    // 35
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.7071067811865475, 0.0, -0.7071067811865475}},
+    // 36
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.7071067811865475, -0.7071067811865475},
+     {-0.7071067811865475, 0.7071067811865475, 0.0}},
+    // 37
+    {{-0.0, -0.0, -1.0},
+     {-0.7071067811865475, -0.0, -0.7071067811865475},
+     {0.0, 0.7071067811865475, -0.7071067811865475}},
+    // 38
+    {{-1.0, -0.0, -0.0},
+     {-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.7071067811865475, -0.0, -0.7071067811865475}},
+    // 39
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.0, 0.7071067811865475, -0.7071067811865475}},
+    // 40
+    {{-1.0, -0.0, -0.0},
+     {-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.7071067811865475, -0.7071067811865475, -0.0}},
+    // 41
+    {{-0.0, -0.0, -1.0},
+     {-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.7071067811865475, -0.0, -0.7071067811865475}},
+    // 42
+    {{-0.0, -1.0, -0.0},
+     {-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.0, -0.7071067811865475, -0.7071067811865475}},
+    // 43
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.7071067811865475, -0.0, -0.7071067811865475}},
+    // 44
+    {{-0.0, -1.0, -0.0},
+     {-0.0, -0.7071067811865475, -0.7071067811865475},
+     {0.7071067811865475, -0.7071067811865475, 0.0}},
+    // 45
+    {{-0.0, -0.0, -1.0},
+     {0.7071067811865475, 0.0, -0.7071067811865475},
+     {-0.0, -0.7071067811865475, -0.7071067811865475}},
+    // 46
+    {{1.0, 0.0, 0.0},
+     {0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.7071067811865475, 0.0, -0.7071067811865475}},
+    // 47
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.7071067811865475, -0.7071067811865475, 0.0},
+     {-0.0, -0.7071067811865475, -0.7071067811865475}},
+    // 48
+    {{1.0, 0.0, 0.0},
+     {0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.7071067811865475, -0.7071067811865475, 0.0}},
+    // 49
+    {{0.0, 0.0, 1.0},
+     {0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.7071067811865475, 0.0, 0.7071067811865475}},
+    // 50
+    {{-0.0, -1.0, -0.0},
+     {0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.0, -0.7071067811865475, 0.7071067811865475}},
+    // 51
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.7071067811865475, 0.0, 0.7071067811865475}},
+    // 52
+    {{-0.0, -1.0, -0.0},
+     {0.0, -0.7071067811865475, 0.7071067811865475},
+     {-0.7071067811865475, -0.7071067811865475, -0.0}},
+    // 53
+    {{0.0, 0.0, 1.0},
+     {-0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.0, -0.7071067811865475, 0.7071067811865475}},
+    // 54
+    {{-1.0, -0.0, -0.0},
+     {-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.7071067811865475, 0.0, 0.7071067811865475}},
+    // 55
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.7071067811865475, -0.7071067811865475, -0.0},
+     {0.0, -0.7071067811865475, 0.7071067811865475}},
+    // 56
+    {{-1.0, -0.0, -0.0},
+     {-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.7071067811865475, 0.7071067811865475, 0.0}},
+    // 57
+    {{0.0, 0.0, 1.0},
+     {0.0, 0.7071067811865475, 0.7071067811865475},
+     {-0.7071067811865475, 0.0, 0.7071067811865475}},
+    // 58
+    {{0.0, 1.0, 0.0},
+     {-0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.0, 0.7071067811865475, 0.7071067811865475}},
+    // 59
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.7071067811865475, 0.0, 0.7071067811865475}},
+    // 60
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.7071067811865475, 0.7071067811865475, 0.0}},
+    // 61
+    {{0.0, 0.0, 1.0},
+     {0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.0, 0.7071067811865475, 0.7071067811865475}},
+    // 62
+    {{1.0, 0.0, 0.0},
+     {0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.7071067811865475, 0.0, 0.7071067811865475}},
+    // 63
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.0, 0.7071067811865475, 0.7071067811865475}},
+    // 128
+    {{1.0, 0.0, 0.0},
+     {0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.9238795325112867, 0.3826834323650897, 0.0}},
+    // 129
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.9238795325112867, 0.0, -0.3826834323650897}},
+    // 130
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.8164965809277261, 0.4082482904638631, -0.4082482904638631}},
+    // 131
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.9238795325112867, 0.0, -0.3826834323650897}},
+    // 132
+    {{-0.0, -0.0, -1.0},
+     {0.0, 0.3826834323650897, -0.9238795325112867},
+     {0.3826834323650897, 0.0, -0.9238795325112867}},
+    // 133
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.0, 0.3826834323650897, -0.9238795325112867}},
+    // 134
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.4082482904638631, 0.4082482904638631, -0.8164965809277261}},
+    // 135
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.0, 0.3826834323650897, -0.9238795325112867}},
+    // 136
+    {{0.0, 1.0, 0.0},
+     {0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.0, 0.9238795325112867, -0.3826834323650897}},
+    // 137
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.3826834323650897, 0.9238795325112867, 0.0}},
+    // 138
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.0, 0.9238795325112867, -0.3826834323650897},
+     {0.4082482904638631, 0.8164965809277261, -0.4082482904638631}},
+    // 139
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.0, 0.9238795325112867, -0.3826834323650897},
+     {0.3826834323650897, 0.9238795325112867, 0.0}},
+    // 140
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.4082482904638631, 0.4082482904638631, -0.8164965809277261}},
+    // 141
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.4082482904638631, 0.8164965809277261, -0.4082482904638631}},
+    // 142
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.8164965809277261, 0.4082482904638631, -0.4082482904638631}},
+    // 143
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.4082482904638631, 0.8164965809277261, -0.4082482904638631}},
+    // 144
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.9238795325112867, -0.3826834323650897},
+     {-0.3826834323650897, 0.9238795325112867, 0.0}},
+    // 145
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.0, 0.9238795325112867, -0.3826834323650897}},
+    // 146
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.4082482904638631, 0.8164965809277261, -0.4082482904638631}},
+    // 147
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.0, 0.9238795325112867, -0.3826834323650897}},
+    // 148
+    {{-0.0, -0.0, -1.0},
+     {-0.3826834323650897, -0.0, -0.9238795325112867},
+     {0.0, 0.3826834323650897, -0.9238795325112867}},
+    // 149
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.3826834323650897, -0.0, -0.9238795325112867}},
+    // 150
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.0, 0.3826834323650897, -0.9238795325112867},
+     {-0.4082482904638631, 0.4082482904638631, -0.8164965809277261}},
+    // 151
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.0, 0.3826834323650897, -0.9238795325112867},
+     {-0.3826834323650897, -0.0, -0.9238795325112867}},
+    // 152
+    {{-1.0, -0.0, -0.0},
+     {-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.9238795325112867, -0.0, -0.3826834323650897}},
+    // 153
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.9238795325112867, 0.3826834323650897, 0.0}},
+    // 154
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.8164965809277261, 0.4082482904638631, -0.4082482904638631}},
+    // 155
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.9238795325112867, 0.3826834323650897, 0.0}},
+    // 156
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.4082482904638631, 0.4082482904638631, -0.8164965809277261}},
+    // 157
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.8164965809277261, 0.4082482904638631, -0.4082482904638631}},
+    // 158
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.4082482904638631, 0.8164965809277261, -0.4082482904638631}},
+    // 159
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.8164965809277261, 0.4082482904638631, -0.4082482904638631}},
+    // 160
+    {{-1.0, -0.0, -0.0},
+     {-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.9238795325112867, -0.3826834323650897, -0.0}},
+    // 161
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.9238795325112867, -0.0, -0.3826834323650897}},
+    // 162
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.8164965809277261, -0.4082482904638631, -0.4082482904638631}},
+    // 163
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.9238795325112867, -0.0, -0.3826834323650897}},
+    // 164
+    {{-0.0, -0.0, -1.0},
+     {-0.0, -0.3826834323650897, -0.9238795325112867},
+     {-0.3826834323650897, -0.0, -0.9238795325112867}},
+    // 165
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.0, -0.3826834323650897, -0.9238795325112867}},
+    // 166
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.4082482904638631, -0.4082482904638631, -0.8164965809277261}},
+    // 167
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.0, -0.3826834323650897, -0.9238795325112867}},
+    // 168
+    {{-0.0, -1.0, -0.0},
+     {-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.0, -0.9238795325112867, -0.3826834323650897}},
+    // 169
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.3826834323650897, -0.9238795325112867, -0.0}},
+    // 170
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.0, -0.9238795325112867, -0.3826834323650897},
+     {-0.4082482904638631, -0.8164965809277261, -0.4082482904638631}},
+    // 171
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.0, -0.9238795325112867, -0.3826834323650897},
+     {-0.3826834323650897, -0.9238795325112867, -0.0}},
+    // 172
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.4082482904638631, -0.4082482904638631, -0.8164965809277261}},
+    // 173
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.4082482904638631, -0.8164965809277261, -0.4082482904638631}},
+    // 174
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.8164965809277261, -0.4082482904638631, -0.4082482904638631}},
+    // 175
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.4082482904638631, -0.8164965809277261, -0.4082482904638631}},
+    // 176
+    {{-0.0, -1.0, -0.0},
+     {-0.0, -0.9238795325112867, -0.3826834323650897},
+     {0.3826834323650897, -0.9238795325112867, 0.0}},
+    // 177
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.0, -0.9238795325112867, -0.3826834323650897}},
+    // 178
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.4082482904638631, -0.8164965809277261, -0.4082482904638631}},
+    // 179
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.3826834323650897, -0.9238795325112867, 0.0},
+     {-0.0, -0.9238795325112867, -0.3826834323650897}},
+    // 180
+    {{-0.0, -0.0, -1.0},
+     {0.3826834323650897, 0.0, -0.9238795325112867},
+     {-0.0, -0.3826834323650897, -0.9238795325112867}},
+    // 181
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.3826834323650897, 0.0, -0.9238795325112867}},
+    // 182
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.0, -0.3826834323650897, -0.9238795325112867},
+     {0.4082482904638631, -0.4082482904638631, -0.8164965809277261}},
+    // 183
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.0, -0.3826834323650897, -0.9238795325112867},
+     {0.3826834323650897, 0.0, -0.9238795325112867}},
+    // 184
+    {{1.0, 0.0, 0.0},
+     {0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.9238795325112867, 0.0, -0.3826834323650897}},
+    // 185
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.9238795325112867, -0.3826834323650897, 0.0}},
+    // 186
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.8164965809277261, -0.4082482904638631, -0.4082482904638631}},
+    // 187
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.9238795325112867, -0.3826834323650897, 0.0}},
+    // 188
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.4082482904638631, -0.4082482904638631, -0.8164965809277261}},
+    // 189
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.8164965809277261, -0.4082482904638631, -0.4082482904638631}},
+    // 190
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.4082482904638631, -0.8164965809277261, -0.4082482904638631}},
+    // 191
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.8164965809277261, -0.4082482904638631, -0.4082482904638631}},
+    // 192
+    {{1.0, 0.0, 0.0},
+     {0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.9238795325112867, -0.3826834323650897, 0.0}},
+    // 193
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.9238795325112867, 0.0, 0.3826834323650897}},
+    // 194
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.8164965809277261, -0.4082482904638631, 0.4082482904638631}},
+    // 195
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.9238795325112867, 0.0, 0.3826834323650897}},
+    // 196
+    {{0.0, 0.0, 1.0},
+     {0.0, -0.3826834323650897, 0.9238795325112867},
+     {0.3826834323650897, 0.0, 0.9238795325112867}},
+    // 197
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.0, -0.3826834323650897, 0.9238795325112867}},
+    // 198
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.4082482904638631, -0.4082482904638631, 0.8164965809277261}},
+    // 199
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.0, -0.3826834323650897, 0.9238795325112867}},
+    // 200
+    {{-0.0, -1.0, -0.0},
+     {0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.0, -0.9238795325112867, 0.3826834323650897}},
+    // 201
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.3826834323650897, -0.9238795325112867, 0.0}},
+    // 202
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.0, -0.9238795325112867, 0.3826834323650897},
+     {0.4082482904638631, -0.8164965809277261, 0.4082482904638631}},
+    // 203
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.0, -0.9238795325112867, 0.3826834323650897},
+     {0.3826834323650897, -0.9238795325112867, 0.0}},
+    // 204
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.4082482904638631, -0.4082482904638631, 0.8164965809277261}},
+    // 205
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.4082482904638631, -0.8164965809277261, 0.4082482904638631}},
+    // 206
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.8164965809277261, -0.4082482904638631, 0.4082482904638631}},
+    // 207
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.4082482904638631, -0.8164965809277261, 0.4082482904638631}},
+    // 208
+    {{-0.0, -1.0, -0.0},
+     {0.0, -0.9238795325112867, 0.3826834323650897},
+     {-0.3826834323650897, -0.9238795325112867, -0.0}},
+    // 209
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.0, -0.9238795325112867, 0.3826834323650897}},
+    // 210
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.4082482904638631, -0.8164965809277261, 0.4082482904638631}},
+    // 211
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.3826834323650897, -0.9238795325112867, -0.0},
+     {0.0, -0.9238795325112867, 0.3826834323650897}},
+    // 212
+    {{0.0, 0.0, 1.0},
+     {-0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.0, -0.3826834323650897, 0.9238795325112867}},
+    // 213
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.3826834323650897, 0.0, 0.9238795325112867}},
+    // 214
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.0, -0.3826834323650897, 0.9238795325112867},
+     {-0.4082482904638631, -0.4082482904638631, 0.8164965809277261}},
+    // 215
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.0, -0.3826834323650897, 0.9238795325112867},
+     {-0.3826834323650897, 0.0, 0.9238795325112867}},
+    // 216
+    {{-1.0, -0.0, -0.0},
+     {-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.9238795325112867, 0.0, 0.3826834323650897}},
+    // 217
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.9238795325112867, -0.3826834323650897, -0.0}},
+    // 218
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.8164965809277261, -0.4082482904638631, 0.4082482904638631}},
+    // 219
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.9238795325112867, -0.3826834323650897, -0.0}},
+    // 220
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.4082482904638631, -0.4082482904638631, 0.8164965809277261}},
+    // 221
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.8164965809277261, -0.4082482904638631, 0.4082482904638631}},
+    // 222
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.4082482904638631, -0.8164965809277261, 0.4082482904638631}},
+    // 223
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.8164965809277261, -0.4082482904638631, 0.4082482904638631}},
+    // 224
+    {{-1.0, -0.0, -0.0},
+     {-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.9238795325112867, 0.3826834323650897, 0.0}},
+    // 225
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.9238795325112867, 0.0, 0.3826834323650897}},
+    // 226
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.8164965809277261, 0.4082482904638631, 0.4082482904638631}},
+    // 227
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.9238795325112867, 0.0, 0.3826834323650897}},
+    // 228
+    {{0.0, 0.0, 1.0},
+     {0.0, 0.3826834323650897, 0.9238795325112867},
+     {-0.3826834323650897, 0.0, 0.9238795325112867}},
+    // 229
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.0, 0.3826834323650897, 0.9238795325112867}},
+    // 230
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.4082482904638631, 0.4082482904638631, 0.8164965809277261}},
+    // 231
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.0, 0.3826834323650897, 0.9238795325112867}},
+    // 232
+    {{0.0, 1.0, 0.0},
+     {-0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.0, 0.9238795325112867, 0.3826834323650897}},
+    // 233
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.3826834323650897, 0.9238795325112867, 0.0}},
+    // 234
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.0, 0.9238795325112867, 0.3826834323650897},
+     {-0.4082482904638631, 0.8164965809277261, 0.4082482904638631}},
+    // 235
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.0, 0.9238795325112867, 0.3826834323650897},
+     {-0.3826834323650897, 0.9238795325112867, 0.0}},
+    // 236
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.4082482904638631, 0.4082482904638631, 0.8164965809277261}},
+    // 237
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.4082482904638631, 0.8164965809277261, 0.4082482904638631}},
+    // 238
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.8164965809277261, 0.4082482904638631, 0.4082482904638631}},
+    // 239
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.4082482904638631, 0.8164965809277261, 0.4082482904638631}},
+    // 240
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.9238795325112867, 0.3826834323650897},
+     {0.3826834323650897, 0.9238795325112867, 0.0}},
+    // 241
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.0, 0.9238795325112867, 0.3826834323650897}},
+    // 242
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.4082482904638631, 0.8164965809277261, 0.4082482904638631}},
+    // 243
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.0, 0.9238795325112867, 0.3826834323650897}},
+    // 244
+    {{0.0, 0.0, 1.0},
+     {0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.0, 0.3826834323650897, 0.9238795325112867}},
+    // 245
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.3826834323650897, 0.0, 0.9238795325112867}},
+    // 246
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.0, 0.3826834323650897, 0.9238795325112867},
+     {0.4082482904638631, 0.4082482904638631, 0.8164965809277261}},
+    // 247
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.0, 0.3826834323650897, 0.9238795325112867},
+     {0.3826834323650897, 0.0, 0.9238795325112867}},
+    // 248
+    {{1.0, 0.0, 0.0},
+     {0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.9238795325112867, 0.0, 0.3826834323650897}},
+    // 249
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.9238795325112867, 0.3826834323650897, 0.0}},
+    // 250
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.8164965809277261, 0.4082482904638631, 0.4082482904638631}},
+    // 251
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.9238795325112867, 0.3826834323650897, 0.0}},
+    // 252
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.4082482904638631, 0.4082482904638631, 0.8164965809277261}},
+    // 253
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.8164965809277261, 0.4082482904638631, 0.4082482904638631}},
+    // 254
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.4082482904638631, 0.8164965809277261, 0.4082482904638631}},
+    // 255
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.8164965809277261, 0.4082482904638631, 0.4082482904638631}},
+    // 512
+    {{1.0, 0.0, 0.0},
+     {0.9807852804032304, 0.0, -0.19509032201612825},
+     {0.9807852804032304, 0.19509032201612825, 0.0}},
+    // 513
+    {{0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {0.9807852804032304, 0.0, -0.19509032201612825}},
+    // 514
+    {{0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.9807852804032304, 0.19509032201612825, 0.0},
+     {0.9596829822606674, 0.1987568534155134, -0.1987568534155134}},
+    // 515
+    {{0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {0.9807852804032304, 0.19509032201612825, 0.0},
+     {0.9807852804032304, 0.0, -0.19509032201612825}},
+    // 516
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.788675134594813, 0.21132486540518713, -0.5773502691896257},
+     {0.8314696123025452, 0.0, -0.5555702330196021}},
+    // 517
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {0.788675134594813, 0.21132486540518713, -0.5773502691896257}},
+    // 518
+    {{0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.8314696123025452, 0.0, -0.5555702330196021},
+     {0.8903200344966339, 0.20884659887152338, -0.40461504459635395}},
+    // 519
+    {{0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {0.8314696123025452, 0.0, -0.5555702330196021},
+     {0.788675134594813, 0.21132486540518713, -0.5773502691896257}},
+    // 520
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.8314696123025452, 0.5555702330196021, 0.0},
+     {0.788675134594813, 0.5773502691896257, -0.21132486540518713}},
+    // 521
+    {{0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {0.8314696123025452, 0.5555702330196021, 0.0}},
+    // 522
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.788675134594813, 0.5773502691896257, -0.21132486540518713},
+     {0.8903200344966339, 0.40461504459635395, -0.20884659887152338}},
+    // 523
+    {{0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {0.788675134594813, 0.5773502691896257, -0.21132486540518713},
+     {0.8314696123025452, 0.5555702330196021, 0.0}},
+    // 524
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {0.8903200344966339, 0.20884659887152338, -0.40461504459635395}},
+    // 525
+    {{0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {0.8903200344966339, 0.40461504459635395, -0.20884659887152338}},
+    // 526
+    {{0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {0.9596829822606674, 0.1987568534155134, -0.1987568534155134}},
+    // 527
+    {{0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {0.8903200344966339, 0.40461504459635395, -0.20884659887152338}},
+    // 528
+    {{-0.0, -0.0, -1.0},
+     {0.0, 0.19509032201612825, -0.9807852804032304},
+     {0.19509032201612825, 0.0, -0.9807852804032304}},
+    // 529
+    {{0.0, 0.3826834323650897, -0.9238795325112867},
+     {0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {0.0, 0.19509032201612825, -0.9807852804032304}},
+    // 530
+    {{0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.19509032201612825, 0.0, -0.9807852804032304},
+     {0.1987568534155134, 0.1987568534155134, -0.9596829822606674}},
+    // 531
+    {{0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {0.19509032201612825, 0.0, -0.9807852804032304},
+     {0.0, 0.19509032201612825, -0.9807852804032304}},
+    // 532
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.21132486540518713, 0.5773502691896257, -0.788675134594813},
+     {0.0, 0.5555702330196021, -0.8314696123025452}},
+    // 533
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {0.21132486540518713, 0.5773502691896257, -0.788675134594813}},
+    // 534
+    {{0.0, 0.3826834323650897, -0.9238795325112867},
+     {0.0, 0.5555702330196021, -0.8314696123025452},
+     {0.20884659887152338, 0.40461504459635395, -0.8903200344966339}},
+    // 535
+    {{0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {0.0, 0.5555702330196021, -0.8314696123025452},
+     {0.21132486540518713, 0.5773502691896257, -0.788675134594813}},
+    // 536
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.5555702330196021, 0.0, -0.8314696123025452},
+     {0.5773502691896257, 0.21132486540518713, -0.788675134594813}},
+    // 537
+    {{0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {0.5555702330196021, 0.0, -0.8314696123025452}},
+    // 538
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.5773502691896257, 0.21132486540518713, -0.788675134594813},
+     {0.40461504459635395, 0.20884659887152338, -0.8903200344966339}},
+    // 539
+    {{0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {0.5773502691896257, 0.21132486540518713, -0.788675134594813},
+     {0.5555702330196021, 0.0, -0.8314696123025452}},
+    // 540
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {0.20884659887152338, 0.40461504459635395, -0.8903200344966339}},
+    // 541
+    {{0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {0.40461504459635395, 0.20884659887152338, -0.8903200344966339}},
+    // 542
+    {{0.0, 0.3826834323650897, -0.9238795325112867},
+     {0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {0.1987568534155134, 0.1987568534155134, -0.9596829822606674}},
+    // 543
+    {{0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {0.40461504459635395, 0.20884659887152338, -0.8903200344966339}},
+    // 544
+    {{0.0, 1.0, 0.0},
+     {0.19509032201612825, 0.9807852804032304, 0.0},
+     {0.0, 0.9807852804032304, -0.19509032201612825}},
+    // 545
+    {{0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {0.19509032201612825, 0.9807852804032304, 0.0}},
+    // 546
+    {{0.0, 0.9238795325112867, -0.3826834323650897},
+     {0.0, 0.9807852804032304, -0.19509032201612825},
+     {0.1987568534155134, 0.9596829822606674, -0.1987568534155134}},
+    // 547
+    {{0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {0.0, 0.9807852804032304, -0.19509032201612825},
+     {0.19509032201612825, 0.9807852804032304, 0.0}},
+    // 548
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.5773502691896257, 0.788675134594813, -0.21132486540518713},
+     {0.5555702330196021, 0.8314696123025452, 0.0}},
+    // 549
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {0.5773502691896257, 0.788675134594813, -0.21132486540518713}},
+    // 550
+    {{0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.5555702330196021, 0.8314696123025452, 0.0},
+     {0.40461504459635395, 0.8903200344966339, -0.20884659887152338}},
+    // 551
+    {{0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {0.5555702330196021, 0.8314696123025452, 0.0},
+     {0.5773502691896257, 0.788675134594813, -0.21132486540518713}},
+    // 552
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.0, 0.8314696123025452, -0.5555702330196021},
+     {0.21132486540518713, 0.788675134594813, -0.5773502691896257}},
+    // 553
+    {{0.0, 0.9238795325112867, -0.3826834323650897},
+     {0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {0.0, 0.8314696123025452, -0.5555702330196021}},
+    // 554
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.21132486540518713, 0.788675134594813, -0.5773502691896257},
+     {0.20884659887152338, 0.8903200344966339, -0.40461504459635395}},
+    // 555
+    {{0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {0.21132486540518713, 0.788675134594813, -0.5773502691896257},
+     {0.0, 0.8314696123025452, -0.5555702330196021}},
+    // 556
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {0.40461504459635395, 0.8903200344966339, -0.20884659887152338}},
+    // 557
+    {{0.0, 0.9238795325112867, -0.3826834323650897},
+     {0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {0.20884659887152338, 0.8903200344966339, -0.40461504459635395}},
+    // 558
+    {{0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {0.1987568534155134, 0.9596829822606674, -0.1987568534155134}},
+    // 559
+    {{0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {0.20884659887152338, 0.8903200344966339, -0.40461504459635395}},
+    // 560
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.21132486540518713, 0.788675134594813, -0.5773502691896257},
+     {0.21132486540518713, 0.5773502691896257, -0.788675134594813}},
+    // 561
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {0.21132486540518713, 0.788675134594813, -0.5773502691896257}},
+    // 562
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.21132486540518713, 0.5773502691896257, -0.788675134594813},
+     {0.4264014327112209, 0.6396021490668312, -0.6396021490668312}},
+    // 563
+    {{0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {0.21132486540518713, 0.5773502691896257, -0.788675134594813},
+     {0.21132486540518713, 0.788675134594813, -0.5773502691896257}},
+    // 564
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.788675134594813, 0.5773502691896257, -0.21132486540518713},
+     {0.5773502691896257, 0.788675134594813, -0.21132486540518713}},
+    // 565
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {0.788675134594813, 0.5773502691896257, -0.21132486540518713}},
+    // 566
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.5773502691896257, 0.788675134594813, -0.21132486540518713},
+     {0.6396021490668312, 0.6396021490668312, -0.4264014327112209}},
+    // 567
+    {{0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {0.5773502691896257, 0.788675134594813, -0.21132486540518713},
+     {0.788675134594813, 0.5773502691896257, -0.21132486540518713}},
+    // 568
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.5773502691896257, 0.21132486540518713, -0.788675134594813},
+     {0.788675134594813, 0.21132486540518713, -0.5773502691896257}},
+    // 569
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {0.5773502691896257, 0.21132486540518713, -0.788675134594813}},
+    // 570
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.788675134594813, 0.21132486540518713, -0.5773502691896257},
+     {0.6396021490668312, 0.4264014327112209, -0.6396021490668312}},
+    // 571
+    {{0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {0.788675134594813, 0.21132486540518713, -0.5773502691896257},
+     {0.5773502691896257, 0.21132486540518713, -0.788675134594813}},
+    // 572
+    {{0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {0.6396021490668312, 0.6396021490668312, -0.4264014327112209}},
+    // 573
+    {{0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {0.6396021490668312, 0.4264014327112209, -0.6396021490668312}},
+    // 574
+    {{0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {0.4264014327112209, 0.6396021490668312, -0.6396021490668312}},
+    // 575
+    {{0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {0.6396021490668312, 0.4264014327112209, -0.6396021490668312}},
+    // 576
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.9807852804032304, -0.19509032201612825},
+     {-0.19509032201612825, 0.9807852804032304, 0.0}},
+    // 577
+    {{0.0, 0.9238795325112867, -0.3826834323650897},
+     {-0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {0.0, 0.9807852804032304, -0.19509032201612825}},
+    // 578
+    {{-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.19509032201612825, 0.9807852804032304, 0.0},
+     {-0.1987568534155134, 0.9596829822606674, -0.1987568534155134}},
+    // 579
+    {{-0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {-0.19509032201612825, 0.9807852804032304, 0.0},
+     {0.0, 0.9807852804032304, -0.19509032201612825}},
+    // 580
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {-0.21132486540518713, 0.788675134594813, -0.5773502691896257},
+     {0.0, 0.8314696123025452, -0.5555702330196021}},
+    // 581
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {-0.21132486540518713, 0.788675134594813, -0.5773502691896257}},
+    // 582
+    {{0.0, 0.9238795325112867, -0.3826834323650897},
+     {0.0, 0.8314696123025452, -0.5555702330196021},
+     {-0.20884659887152338, 0.8903200344966339, -0.40461504459635395}},
+    // 583
+    {{-0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {0.0, 0.8314696123025452, -0.5555702330196021},
+     {-0.21132486540518713, 0.788675134594813, -0.5773502691896257}},
+    // 584
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.5555702330196021, 0.8314696123025452, 0.0},
+     {-0.5773502691896257, 0.788675134594813, -0.21132486540518713}},
+    // 585
+    {{-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {-0.5555702330196021, 0.8314696123025452, 0.0}},
+    // 586
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.5773502691896257, 0.788675134594813, -0.21132486540518713},
+     {-0.40461504459635395, 0.8903200344966339, -0.20884659887152338}},
+    // 587
+    {{-0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {-0.5773502691896257, 0.788675134594813, -0.21132486540518713},
+     {-0.5555702330196021, 0.8314696123025452, 0.0}},
+    // 588
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.40461504459635395, 0.8903200344966339, -0.20884659887152338},
+     {-0.20884659887152338, 0.8903200344966339, -0.40461504459635395}},
+    // 589
+    {{-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {-0.40461504459635395, 0.8903200344966339, -0.20884659887152338}},
+    // 590
+    {{0.0, 0.9238795325112867, -0.3826834323650897},
+     {-0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {-0.1987568534155134, 0.9596829822606674, -0.1987568534155134}},
+    // 591
+    {{-0.1987568534155134, 0.9596829822606674, -0.1987568534155134},
+     {-0.20884659887152338, 0.8903200344966339, -0.40461504459635395},
+     {-0.40461504459635395, 0.8903200344966339, -0.20884659887152338}},
+    // 592
+    {{-0.0, -0.0, -1.0},
+     {-0.19509032201612825, -0.0, -0.9807852804032304},
+     {0.0, 0.19509032201612825, -0.9807852804032304}},
+    // 593
+    {{-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {-0.19509032201612825, -0.0, -0.9807852804032304}},
+    // 594
+    {{0.0, 0.3826834323650897, -0.9238795325112867},
+     {0.0, 0.19509032201612825, -0.9807852804032304},
+     {-0.1987568534155134, 0.1987568534155134, -0.9596829822606674}},
+    // 595
+    {{-0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {0.0, 0.19509032201612825, -0.9807852804032304},
+     {-0.19509032201612825, -0.0, -0.9807852804032304}},
+    // 596
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.5773502691896257, 0.21132486540518713, -0.788675134594813},
+     {-0.5555702330196021, -0.0, -0.8314696123025452}},
+    // 597
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {-0.5773502691896257, 0.21132486540518713, -0.788675134594813}},
+    // 598
+    {{-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.5555702330196021, -0.0, -0.8314696123025452},
+     {-0.40461504459635395, 0.20884659887152338, -0.8903200344966339}},
+    // 599
+    {{-0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {-0.5555702330196021, -0.0, -0.8314696123025452},
+     {-0.5773502691896257, 0.21132486540518713, -0.788675134594813}},
+    // 600
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {0.0, 0.5555702330196021, -0.8314696123025452},
+     {-0.21132486540518713, 0.5773502691896257, -0.788675134594813}},
+    // 601
+    {{0.0, 0.3826834323650897, -0.9238795325112867},
+     {-0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {0.0, 0.5555702330196021, -0.8314696123025452}},
+    // 602
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.21132486540518713, 0.5773502691896257, -0.788675134594813},
+     {-0.20884659887152338, 0.40461504459635395, -0.8903200344966339}},
+    // 603
+    {{-0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {-0.21132486540518713, 0.5773502691896257, -0.788675134594813},
+     {0.0, 0.5555702330196021, -0.8314696123025452}},
+    // 604
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.20884659887152338, 0.40461504459635395, -0.8903200344966339},
+     {-0.40461504459635395, 0.20884659887152338, -0.8903200344966339}},
+    // 605
+    {{0.0, 0.3826834323650897, -0.9238795325112867},
+     {-0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {-0.20884659887152338, 0.40461504459635395, -0.8903200344966339}},
+    // 606
+    {{-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {-0.1987568534155134, 0.1987568534155134, -0.9596829822606674}},
+    // 607
+    {{-0.1987568534155134, 0.1987568534155134, -0.9596829822606674},
+     {-0.40461504459635395, 0.20884659887152338, -0.8903200344966339},
+     {-0.20884659887152338, 0.40461504459635395, -0.8903200344966339}},
+    // 608
+    {{-1.0, -0.0, -0.0},
+     {-0.9807852804032304, 0.19509032201612825, 0.0},
+     {-0.9807852804032304, -0.0, -0.19509032201612825}},
+    // 609
+    {{-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {-0.9807852804032304, 0.19509032201612825, 0.0}},
+    // 610
+    {{-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.9807852804032304, -0.0, -0.19509032201612825},
+     {-0.9596829822606674, 0.1987568534155134, -0.1987568534155134}},
+    // 611
+    {{-0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {-0.9807852804032304, -0.0, -0.19509032201612825},
+     {-0.9807852804032304, 0.19509032201612825, 0.0}},
+    // 612
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.788675134594813, 0.5773502691896257, -0.21132486540518713},
+     {-0.8314696123025452, 0.5555702330196021, 0.0}},
+    // 613
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {-0.788675134594813, 0.5773502691896257, -0.21132486540518713}},
+    // 614
+    {{-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.8314696123025452, 0.5555702330196021, 0.0},
+     {-0.8903200344966339, 0.40461504459635395, -0.20884659887152338}},
+    // 615
+    {{-0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {-0.8314696123025452, 0.5555702330196021, 0.0},
+     {-0.788675134594813, 0.5773502691896257, -0.21132486540518713}},
+    // 616
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.8314696123025452, -0.0, -0.5555702330196021},
+     {-0.788675134594813, 0.21132486540518713, -0.5773502691896257}},
+    // 617
+    {{-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {-0.8314696123025452, -0.0, -0.5555702330196021}},
+    // 618
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.788675134594813, 0.21132486540518713, -0.5773502691896257},
+     {-0.8903200344966339, 0.20884659887152338, -0.40461504459635395}},
+    // 619
+    {{-0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {-0.788675134594813, 0.21132486540518713, -0.5773502691896257},
+     {-0.8314696123025452, -0.0, -0.5555702330196021}},
+    // 620
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.8903200344966339, 0.20884659887152338, -0.40461504459635395},
+     {-0.8903200344966339, 0.40461504459635395, -0.20884659887152338}},
+    // 621
+    {{-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {-0.8903200344966339, 0.20884659887152338, -0.40461504459635395}},
+    // 622
+    {{-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {-0.9596829822606674, 0.1987568534155134, -0.1987568534155134}},
+    // 623
+    {{-0.9596829822606674, 0.1987568534155134, -0.1987568534155134},
+     {-0.8903200344966339, 0.40461504459635395, -0.20884659887152338},
+     {-0.8903200344966339, 0.20884659887152338, -0.40461504459635395}},
+    // 624
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.788675134594813, 0.21132486540518713, -0.5773502691896257},
+     {-0.5773502691896257, 0.21132486540518713, -0.788675134594813}},
+    // 625
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {-0.788675134594813, 0.21132486540518713, -0.5773502691896257}},
+    // 626
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.5773502691896257, 0.21132486540518713, -0.788675134594813},
+     {-0.6396021490668312, 0.4264014327112209, -0.6396021490668312}},
+    // 627
+    {{-0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {-0.5773502691896257, 0.21132486540518713, -0.788675134594813},
+     {-0.788675134594813, 0.21132486540518713, -0.5773502691896257}},
+    // 628
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.5773502691896257, 0.788675134594813, -0.21132486540518713},
+     {-0.788675134594813, 0.5773502691896257, -0.21132486540518713}},
+    // 629
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {-0.5773502691896257, 0.788675134594813, -0.21132486540518713}},
+    // 630
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.788675134594813, 0.5773502691896257, -0.21132486540518713},
+     {-0.6396021490668312, 0.6396021490668312, -0.4264014327112209}},
+    // 631
+    {{-0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {-0.788675134594813, 0.5773502691896257, -0.21132486540518713},
+     {-0.5773502691896257, 0.788675134594813, -0.21132486540518713}},
+    // 632
+    {{0.0, 0.7071067811865475, -0.7071067811865475},
+     {-0.21132486540518713, 0.5773502691896257, -0.788675134594813},
+     {-0.21132486540518713, 0.788675134594813, -0.5773502691896257}},
+    // 633
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {-0.21132486540518713, 0.5773502691896257, -0.788675134594813}},
+    // 634
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.21132486540518713, 0.788675134594813, -0.5773502691896257},
+     {-0.4264014327112209, 0.6396021490668312, -0.6396021490668312}},
+    // 635
+    {{-0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {-0.21132486540518713, 0.788675134594813, -0.5773502691896257},
+     {-0.21132486540518713, 0.5773502691896257, -0.788675134594813}},
+    // 636
+    {{-0.4082482904638631, 0.8164965809277261, -0.4082482904638631},
+     {-0.4264014327112209, 0.6396021490668312, -0.6396021490668312},
+     {-0.6396021490668312, 0.6396021490668312, -0.4264014327112209}},
+    // 637
+    {{-0.4082482904638631, 0.4082482904638631, -0.8164965809277261},
+     {-0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {-0.4264014327112209, 0.6396021490668312, -0.6396021490668312}},
+    // 638
+    {{-0.8164965809277261, 0.4082482904638631, -0.4082482904638631},
+     {-0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {-0.6396021490668312, 0.4264014327112209, -0.6396021490668312}},
+    // 639
+    {{-0.6396021490668312, 0.4264014327112209, -0.6396021490668312},
+     {-0.6396021490668312, 0.6396021490668312, -0.4264014327112209},
+     {-0.4264014327112209, 0.6396021490668312, -0.6396021490668312}},
+    // 640
+    {{-1.0, -0.0, -0.0},
+     {-0.9807852804032304, -0.0, -0.19509032201612825},
+     {-0.9807852804032304, -0.19509032201612825, -0.0}},
+    // 641
+    {{-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {-0.9807852804032304, -0.0, -0.19509032201612825}},
+    // 642
+    {{-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.9807852804032304, -0.19509032201612825, -0.0},
+     {-0.9596829822606674, -0.1987568534155134, -0.1987568534155134}},
+    // 643
+    {{-0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {-0.9807852804032304, -0.19509032201612825, -0.0},
+     {-0.9807852804032304, -0.0, -0.19509032201612825}},
+    // 644
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.788675134594813, -0.21132486540518713, -0.5773502691896257},
+     {-0.8314696123025452, -0.0, -0.5555702330196021}},
+    // 645
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {-0.788675134594813, -0.21132486540518713, -0.5773502691896257}},
+    // 646
+    {{-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.8314696123025452, -0.0, -0.5555702330196021},
+     {-0.8903200344966339, -0.20884659887152338, -0.40461504459635395}},
+    // 647
+    {{-0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {-0.8314696123025452, -0.0, -0.5555702330196021},
+     {-0.788675134594813, -0.21132486540518713, -0.5773502691896257}},
+    // 648
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.8314696123025452, -0.5555702330196021, -0.0},
+     {-0.788675134594813, -0.5773502691896257, -0.21132486540518713}},
+    // 649
+    {{-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {-0.8314696123025452, -0.5555702330196021, -0.0}},
+    // 650
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.788675134594813, -0.5773502691896257, -0.21132486540518713},
+     {-0.8903200344966339, -0.40461504459635395, -0.20884659887152338}},
+    // 651
+    {{-0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {-0.788675134594813, -0.5773502691896257, -0.21132486540518713},
+     {-0.8314696123025452, -0.5555702330196021, -0.0}},
+    // 652
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {-0.8903200344966339, -0.20884659887152338, -0.40461504459635395}},
+    // 653
+    {{-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {-0.8903200344966339, -0.40461504459635395, -0.20884659887152338}},
+    // 654
+    {{-0.9238795325112867, -0.0, -0.3826834323650897},
+     {-0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {-0.9596829822606674, -0.1987568534155134, -0.1987568534155134}},
+    // 655
+    {{-0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {-0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {-0.8903200344966339, -0.40461504459635395, -0.20884659887152338}},
+    // 656
+    {{-0.0, -0.0, -1.0},
+     {-0.0, -0.19509032201612825, -0.9807852804032304},
+     {-0.19509032201612825, -0.0, -0.9807852804032304}},
+    // 657
+    {{-0.0, -0.3826834323650897, -0.9238795325112867},
+     {-0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {-0.0, -0.19509032201612825, -0.9807852804032304}},
+    // 658
+    {{-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.19509032201612825, -0.0, -0.9807852804032304},
+     {-0.1987568534155134, -0.1987568534155134, -0.9596829822606674}},
+    // 659
+    {{-0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {-0.19509032201612825, -0.0, -0.9807852804032304},
+     {-0.0, -0.19509032201612825, -0.9807852804032304}},
+    // 660
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.21132486540518713, -0.5773502691896257, -0.788675134594813},
+     {-0.0, -0.5555702330196021, -0.8314696123025452}},
+    // 661
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {-0.21132486540518713, -0.5773502691896257, -0.788675134594813}},
+    // 662
+    {{-0.0, -0.3826834323650897, -0.9238795325112867},
+     {-0.0, -0.5555702330196021, -0.8314696123025452},
+     {-0.20884659887152338, -0.40461504459635395, -0.8903200344966339}},
+    // 663
+    {{-0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {-0.0, -0.5555702330196021, -0.8314696123025452},
+     {-0.21132486540518713, -0.5773502691896257, -0.788675134594813}},
+    // 664
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.5555702330196021, -0.0, -0.8314696123025452},
+     {-0.5773502691896257, -0.21132486540518713, -0.788675134594813}},
+    // 665
+    {{-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {-0.5555702330196021, -0.0, -0.8314696123025452}},
+    // 666
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.5773502691896257, -0.21132486540518713, -0.788675134594813},
+     {-0.40461504459635395, -0.20884659887152338, -0.8903200344966339}},
+    // 667
+    {{-0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {-0.5773502691896257, -0.21132486540518713, -0.788675134594813},
+     {-0.5555702330196021, -0.0, -0.8314696123025452}},
+    // 668
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {-0.20884659887152338, -0.40461504459635395, -0.8903200344966339}},
+    // 669
+    {{-0.3826834323650897, -0.0, -0.9238795325112867},
+     {-0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {-0.40461504459635395, -0.20884659887152338, -0.8903200344966339}},
+    // 670
+    {{-0.0, -0.3826834323650897, -0.9238795325112867},
+     {-0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {-0.1987568534155134, -0.1987568534155134, -0.9596829822606674}},
+    // 671
+    {{-0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {-0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {-0.40461504459635395, -0.20884659887152338, -0.8903200344966339}},
+    // 672
+    {{-0.0, -1.0, -0.0},
+     {-0.19509032201612825, -0.9807852804032304, -0.0},
+     {-0.0, -0.9807852804032304, -0.19509032201612825}},
+    // 673
+    {{-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {-0.19509032201612825, -0.9807852804032304, -0.0}},
+    // 674
+    {{-0.0, -0.9238795325112867, -0.3826834323650897},
+     {-0.0, -0.9807852804032304, -0.19509032201612825},
+     {-0.1987568534155134, -0.9596829822606674, -0.1987568534155134}},
+    // 675
+    {{-0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {-0.0, -0.9807852804032304, -0.19509032201612825},
+     {-0.19509032201612825, -0.9807852804032304, -0.0}},
+    // 676
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.5773502691896257, -0.788675134594813, -0.21132486540518713},
+     {-0.5555702330196021, -0.8314696123025452, -0.0}},
+    // 677
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {-0.5773502691896257, -0.788675134594813, -0.21132486540518713}},
+    // 678
+    {{-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.5555702330196021, -0.8314696123025452, -0.0},
+     {-0.40461504459635395, -0.8903200344966339, -0.20884659887152338}},
+    // 679
+    {{-0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {-0.5555702330196021, -0.8314696123025452, -0.0},
+     {-0.5773502691896257, -0.788675134594813, -0.21132486540518713}},
+    // 680
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.0, -0.8314696123025452, -0.5555702330196021},
+     {-0.21132486540518713, -0.788675134594813, -0.5773502691896257}},
+    // 681
+    {{-0.0, -0.9238795325112867, -0.3826834323650897},
+     {-0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {-0.0, -0.8314696123025452, -0.5555702330196021}},
+    // 682
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.21132486540518713, -0.788675134594813, -0.5773502691896257},
+     {-0.20884659887152338, -0.8903200344966339, -0.40461504459635395}},
+    // 683
+    {{-0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {-0.21132486540518713, -0.788675134594813, -0.5773502691896257},
+     {-0.0, -0.8314696123025452, -0.5555702330196021}},
+    // 684
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {-0.40461504459635395, -0.8903200344966339, -0.20884659887152338}},
+    // 685
+    {{-0.0, -0.9238795325112867, -0.3826834323650897},
+     {-0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {-0.20884659887152338, -0.8903200344966339, -0.40461504459635395}},
+    // 686
+    {{-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {-0.1987568534155134, -0.9596829822606674, -0.1987568534155134}},
+    // 687
+    {{-0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {-0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {-0.20884659887152338, -0.8903200344966339, -0.40461504459635395}},
+    // 688
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.21132486540518713, -0.788675134594813, -0.5773502691896257},
+     {-0.21132486540518713, -0.5773502691896257, -0.788675134594813}},
+    // 689
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {-0.21132486540518713, -0.788675134594813, -0.5773502691896257}},
+    // 690
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.21132486540518713, -0.5773502691896257, -0.788675134594813},
+     {-0.4264014327112209, -0.6396021490668312, -0.6396021490668312}},
+    // 691
+    {{-0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {-0.21132486540518713, -0.5773502691896257, -0.788675134594813},
+     {-0.21132486540518713, -0.788675134594813, -0.5773502691896257}},
+    // 692
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.788675134594813, -0.5773502691896257, -0.21132486540518713},
+     {-0.5773502691896257, -0.788675134594813, -0.21132486540518713}},
+    // 693
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {-0.788675134594813, -0.5773502691896257, -0.21132486540518713}},
+    // 694
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.5773502691896257, -0.788675134594813, -0.21132486540518713},
+     {-0.6396021490668312, -0.6396021490668312, -0.4264014327112209}},
+    // 695
+    {{-0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {-0.5773502691896257, -0.788675134594813, -0.21132486540518713},
+     {-0.788675134594813, -0.5773502691896257, -0.21132486540518713}},
+    // 696
+    {{-0.7071067811865475, -0.0, -0.7071067811865475},
+     {-0.5773502691896257, -0.21132486540518713, -0.788675134594813},
+     {-0.788675134594813, -0.21132486540518713, -0.5773502691896257}},
+    // 697
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {-0.5773502691896257, -0.21132486540518713, -0.788675134594813}},
+    // 698
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.788675134594813, -0.21132486540518713, -0.5773502691896257},
+     {-0.6396021490668312, -0.4264014327112209, -0.6396021490668312}},
+    // 699
+    {{-0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {-0.788675134594813, -0.21132486540518713, -0.5773502691896257},
+     {-0.5773502691896257, -0.21132486540518713, -0.788675134594813}},
+    // 700
+    {{-0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {-0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {-0.6396021490668312, -0.6396021490668312, -0.4264014327112209}},
+    // 701
+    {{-0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {-0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {-0.6396021490668312, -0.4264014327112209, -0.6396021490668312}},
+    // 702
+    {{-0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {-0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {-0.4264014327112209, -0.6396021490668312, -0.6396021490668312}},
+    // 703
+    {{-0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {-0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {-0.6396021490668312, -0.4264014327112209, -0.6396021490668312}},
+    // 704
+    {{-0.0, -1.0, -0.0},
+     {-0.0, -0.9807852804032304, -0.19509032201612825},
+     {0.19509032201612825, -0.9807852804032304, 0.0}},
+    // 705
+    {{-0.0, -0.9238795325112867, -0.3826834323650897},
+     {0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {-0.0, -0.9807852804032304, -0.19509032201612825}},
+    // 706
+    {{0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.19509032201612825, -0.9807852804032304, 0.0},
+     {0.1987568534155134, -0.9596829822606674, -0.1987568534155134}},
+    // 707
+    {{0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {0.19509032201612825, -0.9807852804032304, 0.0},
+     {-0.0, -0.9807852804032304, -0.19509032201612825}},
+    // 708
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {0.21132486540518713, -0.788675134594813, -0.5773502691896257},
+     {-0.0, -0.8314696123025452, -0.5555702330196021}},
+    // 709
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {0.21132486540518713, -0.788675134594813, -0.5773502691896257}},
+    // 710
+    {{-0.0, -0.9238795325112867, -0.3826834323650897},
+     {-0.0, -0.8314696123025452, -0.5555702330196021},
+     {0.20884659887152338, -0.8903200344966339, -0.40461504459635395}},
+    // 711
+    {{0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {-0.0, -0.8314696123025452, -0.5555702330196021},
+     {0.21132486540518713, -0.788675134594813, -0.5773502691896257}},
+    // 712
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.5555702330196021, -0.8314696123025452, 0.0},
+     {0.5773502691896257, -0.788675134594813, -0.21132486540518713}},
+    // 713
+    {{0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {0.5555702330196021, -0.8314696123025452, 0.0}},
+    // 714
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.5773502691896257, -0.788675134594813, -0.21132486540518713},
+     {0.40461504459635395, -0.8903200344966339, -0.20884659887152338}},
+    // 715
+    {{0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {0.5773502691896257, -0.788675134594813, -0.21132486540518713},
+     {0.5555702330196021, -0.8314696123025452, 0.0}},
+    // 716
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.40461504459635395, -0.8903200344966339, -0.20884659887152338},
+     {0.20884659887152338, -0.8903200344966339, -0.40461504459635395}},
+    // 717
+    {{0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {0.40461504459635395, -0.8903200344966339, -0.20884659887152338}},
+    // 718
+    {{-0.0, -0.9238795325112867, -0.3826834323650897},
+     {0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {0.1987568534155134, -0.9596829822606674, -0.1987568534155134}},
+    // 719
+    {{0.1987568534155134, -0.9596829822606674, -0.1987568534155134},
+     {0.20884659887152338, -0.8903200344966339, -0.40461504459635395},
+     {0.40461504459635395, -0.8903200344966339, -0.20884659887152338}},
+    // 720
+    {{-0.0, -0.0, -1.0},
+     {0.19509032201612825, 0.0, -0.9807852804032304},
+     {-0.0, -0.19509032201612825, -0.9807852804032304}},
+    // 721
+    {{0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {0.19509032201612825, 0.0, -0.9807852804032304}},
+    // 722
+    {{-0.0, -0.3826834323650897, -0.9238795325112867},
+     {-0.0, -0.19509032201612825, -0.9807852804032304},
+     {0.1987568534155134, -0.1987568534155134, -0.9596829822606674}},
+    // 723
+    {{0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {-0.0, -0.19509032201612825, -0.9807852804032304},
+     {0.19509032201612825, 0.0, -0.9807852804032304}},
+    // 724
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.5773502691896257, -0.21132486540518713, -0.788675134594813},
+     {0.5555702330196021, 0.0, -0.8314696123025452}},
+    // 725
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {0.5773502691896257, -0.21132486540518713, -0.788675134594813}},
+    // 726
+    {{0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.5555702330196021, 0.0, -0.8314696123025452},
+     {0.40461504459635395, -0.20884659887152338, -0.8903200344966339}},
+    // 727
+    {{0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {0.5555702330196021, 0.0, -0.8314696123025452},
+     {0.5773502691896257, -0.21132486540518713, -0.788675134594813}},
+    // 728
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {-0.0, -0.5555702330196021, -0.8314696123025452},
+     {0.21132486540518713, -0.5773502691896257, -0.788675134594813}},
+    // 729
+    {{-0.0, -0.3826834323650897, -0.9238795325112867},
+     {0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {-0.0, -0.5555702330196021, -0.8314696123025452}},
+    // 730
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.21132486540518713, -0.5773502691896257, -0.788675134594813},
+     {0.20884659887152338, -0.40461504459635395, -0.8903200344966339}},
+    // 731
+    {{0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {0.21132486540518713, -0.5773502691896257, -0.788675134594813},
+     {-0.0, -0.5555702330196021, -0.8314696123025452}},
+    // 732
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.20884659887152338, -0.40461504459635395, -0.8903200344966339},
+     {0.40461504459635395, -0.20884659887152338, -0.8903200344966339}},
+    // 733
+    {{-0.0, -0.3826834323650897, -0.9238795325112867},
+     {0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {0.20884659887152338, -0.40461504459635395, -0.8903200344966339}},
+    // 734
+    {{0.3826834323650897, 0.0, -0.9238795325112867},
+     {0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {0.1987568534155134, -0.1987568534155134, -0.9596829822606674}},
+    // 735
+    {{0.1987568534155134, -0.1987568534155134, -0.9596829822606674},
+     {0.40461504459635395, -0.20884659887152338, -0.8903200344966339},
+     {0.20884659887152338, -0.40461504459635395, -0.8903200344966339}},
+    // 736
+    {{1.0, 0.0, 0.0},
+     {0.9807852804032304, -0.19509032201612825, 0.0},
+     {0.9807852804032304, 0.0, -0.19509032201612825}},
+    // 737
+    {{0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {0.9807852804032304, -0.19509032201612825, 0.0}},
+    // 738
+    {{0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.9807852804032304, 0.0, -0.19509032201612825},
+     {0.9596829822606674, -0.1987568534155134, -0.1987568534155134}},
+    // 739
+    {{0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {0.9807852804032304, 0.0, -0.19509032201612825},
+     {0.9807852804032304, -0.19509032201612825, 0.0}},
+    // 740
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.788675134594813, -0.5773502691896257, -0.21132486540518713},
+     {0.8314696123025452, -0.5555702330196021, 0.0}},
+    // 741
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {0.788675134594813, -0.5773502691896257, -0.21132486540518713}},
+    // 742
+    {{0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.8314696123025452, -0.5555702330196021, 0.0},
+     {0.8903200344966339, -0.40461504459635395, -0.20884659887152338}},
+    // 743
+    {{0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {0.8314696123025452, -0.5555702330196021, 0.0},
+     {0.788675134594813, -0.5773502691896257, -0.21132486540518713}},
+    // 744
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.8314696123025452, 0.0, -0.5555702330196021},
+     {0.788675134594813, -0.21132486540518713, -0.5773502691896257}},
+    // 745
+    {{0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {0.8314696123025452, 0.0, -0.5555702330196021}},
+    // 746
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.788675134594813, -0.21132486540518713, -0.5773502691896257},
+     {0.8903200344966339, -0.20884659887152338, -0.40461504459635395}},
+    // 747
+    {{0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {0.788675134594813, -0.21132486540518713, -0.5773502691896257},
+     {0.8314696123025452, 0.0, -0.5555702330196021}},
+    // 748
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.8903200344966339, -0.20884659887152338, -0.40461504459635395},
+     {0.8903200344966339, -0.40461504459635395, -0.20884659887152338}},
+    // 749
+    {{0.9238795325112867, 0.0, -0.3826834323650897},
+     {0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {0.8903200344966339, -0.20884659887152338, -0.40461504459635395}},
+    // 750
+    {{0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {0.9596829822606674, -0.1987568534155134, -0.1987568534155134}},
+    // 751
+    {{0.9596829822606674, -0.1987568534155134, -0.1987568534155134},
+     {0.8903200344966339, -0.40461504459635395, -0.20884659887152338},
+     {0.8903200344966339, -0.20884659887152338, -0.40461504459635395}},
+    // 752
+    {{0.7071067811865475, 0.0, -0.7071067811865475},
+     {0.788675134594813, -0.21132486540518713, -0.5773502691896257},
+     {0.5773502691896257, -0.21132486540518713, -0.788675134594813}},
+    // 753
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {0.788675134594813, -0.21132486540518713, -0.5773502691896257}},
+    // 754
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.5773502691896257, -0.21132486540518713, -0.788675134594813},
+     {0.6396021490668312, -0.4264014327112209, -0.6396021490668312}},
+    // 755
+    {{0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {0.5773502691896257, -0.21132486540518713, -0.788675134594813},
+     {0.788675134594813, -0.21132486540518713, -0.5773502691896257}},
+    // 756
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.5773502691896257, -0.788675134594813, -0.21132486540518713},
+     {0.788675134594813, -0.5773502691896257, -0.21132486540518713}},
+    // 757
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {0.5773502691896257, -0.788675134594813, -0.21132486540518713}},
+    // 758
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.788675134594813, -0.5773502691896257, -0.21132486540518713},
+     {0.6396021490668312, -0.6396021490668312, -0.4264014327112209}},
+    // 759
+    {{0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {0.788675134594813, -0.5773502691896257, -0.21132486540518713},
+     {0.5773502691896257, -0.788675134594813, -0.21132486540518713}},
+    // 760
+    {{-0.0, -0.7071067811865475, -0.7071067811865475},
+     {0.21132486540518713, -0.5773502691896257, -0.788675134594813},
+     {0.21132486540518713, -0.788675134594813, -0.5773502691896257}},
+    // 761
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {0.21132486540518713, -0.5773502691896257, -0.788675134594813}},
+    // 762
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.21132486540518713, -0.788675134594813, -0.5773502691896257},
+     {0.4264014327112209, -0.6396021490668312, -0.6396021490668312}},
+    // 763
+    {{0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {0.21132486540518713, -0.788675134594813, -0.5773502691896257},
+     {0.21132486540518713, -0.5773502691896257, -0.788675134594813}},
+    // 764
+    {{0.4082482904638631, -0.8164965809277261, -0.4082482904638631},
+     {0.4264014327112209, -0.6396021490668312, -0.6396021490668312},
+     {0.6396021490668312, -0.6396021490668312, -0.4264014327112209}},
+    // 765
+    {{0.4082482904638631, -0.4082482904638631, -0.8164965809277261},
+     {0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {0.4264014327112209, -0.6396021490668312, -0.6396021490668312}},
+    // 766
+    {{0.8164965809277261, -0.4082482904638631, -0.4082482904638631},
+     {0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {0.6396021490668312, -0.4264014327112209, -0.6396021490668312}},
+    // 767
+    {{0.6396021490668312, -0.4264014327112209, -0.6396021490668312},
+     {0.6396021490668312, -0.6396021490668312, -0.4264014327112209},
+     {0.4264014327112209, -0.6396021490668312, -0.6396021490668312}},
+    // 768
+    {{1.0, 0.0, 0.0},
+     {0.9807852804032304, 0.0, 0.19509032201612825},
+     {0.9807852804032304, -0.19509032201612825, 0.0}},
+    // 769
+    {{0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {0.9807852804032304, 0.0, 0.19509032201612825}},
+    // 770
+    {{0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.9807852804032304, -0.19509032201612825, 0.0},
+     {0.9596829822606674, -0.1987568534155134, 0.1987568534155134}},
+    // 771
+    {{0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {0.9807852804032304, -0.19509032201612825, 0.0},
+     {0.9807852804032304, 0.0, 0.19509032201612825}},
+    // 772
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.788675134594813, -0.21132486540518713, 0.5773502691896257},
+     {0.8314696123025452, 0.0, 0.5555702330196021}},
+    // 773
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {0.788675134594813, -0.21132486540518713, 0.5773502691896257}},
+    // 774
+    {{0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.8314696123025452, 0.0, 0.5555702330196021},
+     {0.8903200344966339, -0.20884659887152338, 0.40461504459635395}},
+    // 775
+    {{0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {0.8314696123025452, 0.0, 0.5555702330196021},
+     {0.788675134594813, -0.21132486540518713, 0.5773502691896257}},
+    // 776
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.8314696123025452, -0.5555702330196021, 0.0},
+     {0.788675134594813, -0.5773502691896257, 0.21132486540518713}},
+    // 777
+    {{0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {0.8314696123025452, -0.5555702330196021, 0.0}},
+    // 778
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.788675134594813, -0.5773502691896257, 0.21132486540518713},
+     {0.8903200344966339, -0.40461504459635395, 0.20884659887152338}},
+    // 779
+    {{0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {0.788675134594813, -0.5773502691896257, 0.21132486540518713},
+     {0.8314696123025452, -0.5555702330196021, 0.0}},
+    // 780
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {0.8903200344966339, -0.20884659887152338, 0.40461504459635395}},
+    // 781
+    {{0.9238795325112867, -0.3826834323650897, 0.0},
+     {0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {0.8903200344966339, -0.40461504459635395, 0.20884659887152338}},
+    // 782
+    {{0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {0.9596829822606674, -0.1987568534155134, 0.1987568534155134}},
+    // 783
+    {{0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {0.8903200344966339, -0.40461504459635395, 0.20884659887152338}},
+    // 784
+    {{0.0, 0.0, 1.0},
+     {0.0, -0.19509032201612825, 0.9807852804032304},
+     {0.19509032201612825, 0.0, 0.9807852804032304}},
+    // 785
+    {{0.0, -0.3826834323650897, 0.9238795325112867},
+     {0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {0.0, -0.19509032201612825, 0.9807852804032304}},
+    // 786
+    {{0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.19509032201612825, 0.0, 0.9807852804032304},
+     {0.1987568534155134, -0.1987568534155134, 0.9596829822606674}},
+    // 787
+    {{0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {0.19509032201612825, 0.0, 0.9807852804032304},
+     {0.0, -0.19509032201612825, 0.9807852804032304}},
+    // 788
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.21132486540518713, -0.5773502691896257, 0.788675134594813},
+     {0.0, -0.5555702330196021, 0.8314696123025452}},
+    // 789
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {0.21132486540518713, -0.5773502691896257, 0.788675134594813}},
+    // 790
+    {{0.0, -0.3826834323650897, 0.9238795325112867},
+     {0.0, -0.5555702330196021, 0.8314696123025452},
+     {0.20884659887152338, -0.40461504459635395, 0.8903200344966339}},
+    // 791
+    {{0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {0.0, -0.5555702330196021, 0.8314696123025452},
+     {0.21132486540518713, -0.5773502691896257, 0.788675134594813}},
+    // 792
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.5555702330196021, 0.0, 0.8314696123025452},
+     {0.5773502691896257, -0.21132486540518713, 0.788675134594813}},
+    // 793
+    {{0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {0.5555702330196021, 0.0, 0.8314696123025452}},
+    // 794
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.5773502691896257, -0.21132486540518713, 0.788675134594813},
+     {0.40461504459635395, -0.20884659887152338, 0.8903200344966339}},
+    // 795
+    {{0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {0.5773502691896257, -0.21132486540518713, 0.788675134594813},
+     {0.5555702330196021, 0.0, 0.8314696123025452}},
+    // 796
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {0.20884659887152338, -0.40461504459635395, 0.8903200344966339}},
+    // 797
+    {{0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {0.40461504459635395, -0.20884659887152338, 0.8903200344966339}},
+    // 798
+    {{0.0, -0.3826834323650897, 0.9238795325112867},
+     {0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {0.1987568534155134, -0.1987568534155134, 0.9596829822606674}},
+    // 799
+    {{0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {0.40461504459635395, -0.20884659887152338, 0.8903200344966339}},
+    // 800
+    {{-0.0, -1.0, -0.0},
+     {0.19509032201612825, -0.9807852804032304, 0.0},
+     {0.0, -0.9807852804032304, 0.19509032201612825}},
+    // 801
+    {{0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {0.19509032201612825, -0.9807852804032304, 0.0}},
+    // 802
+    {{0.0, -0.9238795325112867, 0.3826834323650897},
+     {0.0, -0.9807852804032304, 0.19509032201612825},
+     {0.1987568534155134, -0.9596829822606674, 0.1987568534155134}},
+    // 803
+    {{0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {0.0, -0.9807852804032304, 0.19509032201612825},
+     {0.19509032201612825, -0.9807852804032304, 0.0}},
+    // 804
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.5773502691896257, -0.788675134594813, 0.21132486540518713},
+     {0.5555702330196021, -0.8314696123025452, 0.0}},
+    // 805
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {0.5773502691896257, -0.788675134594813, 0.21132486540518713}},
+    // 806
+    {{0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.5555702330196021, -0.8314696123025452, 0.0},
+     {0.40461504459635395, -0.8903200344966339, 0.20884659887152338}},
+    // 807
+    {{0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {0.5555702330196021, -0.8314696123025452, 0.0},
+     {0.5773502691896257, -0.788675134594813, 0.21132486540518713}},
+    // 808
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.0, -0.8314696123025452, 0.5555702330196021},
+     {0.21132486540518713, -0.788675134594813, 0.5773502691896257}},
+    // 809
+    {{0.0, -0.9238795325112867, 0.3826834323650897},
+     {0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {0.0, -0.8314696123025452, 0.5555702330196021}},
+    // 810
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.21132486540518713, -0.788675134594813, 0.5773502691896257},
+     {0.20884659887152338, -0.8903200344966339, 0.40461504459635395}},
+    // 811
+    {{0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {0.21132486540518713, -0.788675134594813, 0.5773502691896257},
+     {0.0, -0.8314696123025452, 0.5555702330196021}},
+    // 812
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {0.40461504459635395, -0.8903200344966339, 0.20884659887152338}},
+    // 813
+    {{0.0, -0.9238795325112867, 0.3826834323650897},
+     {0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {0.20884659887152338, -0.8903200344966339, 0.40461504459635395}},
+    // 814
+    {{0.3826834323650897, -0.9238795325112867, 0.0},
+     {0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {0.1987568534155134, -0.9596829822606674, 0.1987568534155134}},
+    // 815
+    {{0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {0.20884659887152338, -0.8903200344966339, 0.40461504459635395}},
+    // 816
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.21132486540518713, -0.788675134594813, 0.5773502691896257},
+     {0.21132486540518713, -0.5773502691896257, 0.788675134594813}},
+    // 817
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {0.21132486540518713, -0.788675134594813, 0.5773502691896257}},
+    // 818
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.21132486540518713, -0.5773502691896257, 0.788675134594813},
+     {0.4264014327112209, -0.6396021490668312, 0.6396021490668312}},
+    // 819
+    {{0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {0.21132486540518713, -0.5773502691896257, 0.788675134594813},
+     {0.21132486540518713, -0.788675134594813, 0.5773502691896257}},
+    // 820
+    {{0.7071067811865475, -0.7071067811865475, 0.0},
+     {0.788675134594813, -0.5773502691896257, 0.21132486540518713},
+     {0.5773502691896257, -0.788675134594813, 0.21132486540518713}},
+    // 821
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {0.788675134594813, -0.5773502691896257, 0.21132486540518713}},
+    // 822
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.5773502691896257, -0.788675134594813, 0.21132486540518713},
+     {0.6396021490668312, -0.6396021490668312, 0.4264014327112209}},
+    // 823
+    {{0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {0.5773502691896257, -0.788675134594813, 0.21132486540518713},
+     {0.788675134594813, -0.5773502691896257, 0.21132486540518713}},
+    // 824
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.5773502691896257, -0.21132486540518713, 0.788675134594813},
+     {0.788675134594813, -0.21132486540518713, 0.5773502691896257}},
+    // 825
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {0.5773502691896257, -0.21132486540518713, 0.788675134594813}},
+    // 826
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.788675134594813, -0.21132486540518713, 0.5773502691896257},
+     {0.6396021490668312, -0.4264014327112209, 0.6396021490668312}},
+    // 827
+    {{0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {0.788675134594813, -0.21132486540518713, 0.5773502691896257},
+     {0.5773502691896257, -0.21132486540518713, 0.788675134594813}},
+    // 828
+    {{0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {0.6396021490668312, -0.6396021490668312, 0.4264014327112209}},
+    // 829
+    {{0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {0.6396021490668312, -0.4264014327112209, 0.6396021490668312}},
+    // 830
+    {{0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {0.4264014327112209, -0.6396021490668312, 0.6396021490668312}},
+    // 831
+    {{0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {0.6396021490668312, -0.4264014327112209, 0.6396021490668312}},
+    // 832
+    {{-0.0, -1.0, -0.0},
+     {0.0, -0.9807852804032304, 0.19509032201612825},
+     {-0.19509032201612825, -0.9807852804032304, -0.0}},
+    // 833
+    {{0.0, -0.9238795325112867, 0.3826834323650897},
+     {-0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {0.0, -0.9807852804032304, 0.19509032201612825}},
+    // 834
+    {{-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.19509032201612825, -0.9807852804032304, -0.0},
+     {-0.1987568534155134, -0.9596829822606674, 0.1987568534155134}},
+    // 835
+    {{-0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {-0.19509032201612825, -0.9807852804032304, -0.0},
+     {0.0, -0.9807852804032304, 0.19509032201612825}},
+    // 836
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {-0.21132486540518713, -0.788675134594813, 0.5773502691896257},
+     {0.0, -0.8314696123025452, 0.5555702330196021}},
+    // 837
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {-0.21132486540518713, -0.788675134594813, 0.5773502691896257}},
+    // 838
+    {{0.0, -0.9238795325112867, 0.3826834323650897},
+     {0.0, -0.8314696123025452, 0.5555702330196021},
+     {-0.20884659887152338, -0.8903200344966339, 0.40461504459635395}},
+    // 839
+    {{-0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {0.0, -0.8314696123025452, 0.5555702330196021},
+     {-0.21132486540518713, -0.788675134594813, 0.5773502691896257}},
+    // 840
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.5555702330196021, -0.8314696123025452, -0.0},
+     {-0.5773502691896257, -0.788675134594813, 0.21132486540518713}},
+    // 841
+    {{-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {-0.5555702330196021, -0.8314696123025452, -0.0}},
+    // 842
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.5773502691896257, -0.788675134594813, 0.21132486540518713},
+     {-0.40461504459635395, -0.8903200344966339, 0.20884659887152338}},
+    // 843
+    {{-0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {-0.5773502691896257, -0.788675134594813, 0.21132486540518713},
+     {-0.5555702330196021, -0.8314696123025452, -0.0}},
+    // 844
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.40461504459635395, -0.8903200344966339, 0.20884659887152338},
+     {-0.20884659887152338, -0.8903200344966339, 0.40461504459635395}},
+    // 845
+    {{-0.3826834323650897, -0.9238795325112867, -0.0},
+     {-0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {-0.40461504459635395, -0.8903200344966339, 0.20884659887152338}},
+    // 846
+    {{0.0, -0.9238795325112867, 0.3826834323650897},
+     {-0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {-0.1987568534155134, -0.9596829822606674, 0.1987568534155134}},
+    // 847
+    {{-0.1987568534155134, -0.9596829822606674, 0.1987568534155134},
+     {-0.20884659887152338, -0.8903200344966339, 0.40461504459635395},
+     {-0.40461504459635395, -0.8903200344966339, 0.20884659887152338}},
+    // 848
+    {{0.0, 0.0, 1.0},
+     {-0.19509032201612825, 0.0, 0.9807852804032304},
+     {0.0, -0.19509032201612825, 0.9807852804032304}},
+    // 849
+    {{-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {-0.19509032201612825, 0.0, 0.9807852804032304}},
+    // 850
+    {{0.0, -0.3826834323650897, 0.9238795325112867},
+     {0.0, -0.19509032201612825, 0.9807852804032304},
+     {-0.1987568534155134, -0.1987568534155134, 0.9596829822606674}},
+    // 851
+    {{-0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {0.0, -0.19509032201612825, 0.9807852804032304},
+     {-0.19509032201612825, 0.0, 0.9807852804032304}},
+    // 852
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.5773502691896257, -0.21132486540518713, 0.788675134594813},
+     {-0.5555702330196021, 0.0, 0.8314696123025452}},
+    // 853
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {-0.5773502691896257, -0.21132486540518713, 0.788675134594813}},
+    // 854
+    {{-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.5555702330196021, 0.0, 0.8314696123025452},
+     {-0.40461504459635395, -0.20884659887152338, 0.8903200344966339}},
+    // 855
+    {{-0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {-0.5555702330196021, 0.0, 0.8314696123025452},
+     {-0.5773502691896257, -0.21132486540518713, 0.788675134594813}},
+    // 856
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {0.0, -0.5555702330196021, 0.8314696123025452},
+     {-0.21132486540518713, -0.5773502691896257, 0.788675134594813}},
+    // 857
+    {{0.0, -0.3826834323650897, 0.9238795325112867},
+     {-0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {0.0, -0.5555702330196021, 0.8314696123025452}},
+    // 858
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.21132486540518713, -0.5773502691896257, 0.788675134594813},
+     {-0.20884659887152338, -0.40461504459635395, 0.8903200344966339}},
+    // 859
+    {{-0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {-0.21132486540518713, -0.5773502691896257, 0.788675134594813},
+     {0.0, -0.5555702330196021, 0.8314696123025452}},
+    // 860
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.20884659887152338, -0.40461504459635395, 0.8903200344966339},
+     {-0.40461504459635395, -0.20884659887152338, 0.8903200344966339}},
+    // 861
+    {{0.0, -0.3826834323650897, 0.9238795325112867},
+     {-0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {-0.20884659887152338, -0.40461504459635395, 0.8903200344966339}},
+    // 862
+    {{-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {-0.1987568534155134, -0.1987568534155134, 0.9596829822606674}},
+    // 863
+    {{-0.1987568534155134, -0.1987568534155134, 0.9596829822606674},
+     {-0.40461504459635395, -0.20884659887152338, 0.8903200344966339},
+     {-0.20884659887152338, -0.40461504459635395, 0.8903200344966339}},
+    // 864
+    {{-1.0, -0.0, -0.0},
+     {-0.9807852804032304, -0.19509032201612825, -0.0},
+     {-0.9807852804032304, 0.0, 0.19509032201612825}},
+    // 865
+    {{-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {-0.9807852804032304, -0.19509032201612825, -0.0}},
+    // 866
+    {{-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.9807852804032304, 0.0, 0.19509032201612825},
+     {-0.9596829822606674, -0.1987568534155134, 0.1987568534155134}},
+    // 867
+    {{-0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {-0.9807852804032304, 0.0, 0.19509032201612825},
+     {-0.9807852804032304, -0.19509032201612825, -0.0}},
+    // 868
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.788675134594813, -0.5773502691896257, 0.21132486540518713},
+     {-0.8314696123025452, -0.5555702330196021, -0.0}},
+    // 869
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {-0.788675134594813, -0.5773502691896257, 0.21132486540518713}},
+    // 870
+    {{-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.8314696123025452, -0.5555702330196021, -0.0},
+     {-0.8903200344966339, -0.40461504459635395, 0.20884659887152338}},
+    // 871
+    {{-0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {-0.8314696123025452, -0.5555702330196021, -0.0},
+     {-0.788675134594813, -0.5773502691896257, 0.21132486540518713}},
+    // 872
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.8314696123025452, 0.0, 0.5555702330196021},
+     {-0.788675134594813, -0.21132486540518713, 0.5773502691896257}},
+    // 873
+    {{-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {-0.8314696123025452, 0.0, 0.5555702330196021}},
+    // 874
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.788675134594813, -0.21132486540518713, 0.5773502691896257},
+     {-0.8903200344966339, -0.20884659887152338, 0.40461504459635395}},
+    // 875
+    {{-0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {-0.788675134594813, -0.21132486540518713, 0.5773502691896257},
+     {-0.8314696123025452, 0.0, 0.5555702330196021}},
+    // 876
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.8903200344966339, -0.20884659887152338, 0.40461504459635395},
+     {-0.8903200344966339, -0.40461504459635395, 0.20884659887152338}},
+    // 877
+    {{-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {-0.8903200344966339, -0.20884659887152338, 0.40461504459635395}},
+    // 878
+    {{-0.9238795325112867, -0.3826834323650897, -0.0},
+     {-0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {-0.9596829822606674, -0.1987568534155134, 0.1987568534155134}},
+    // 879
+    {{-0.9596829822606674, -0.1987568534155134, 0.1987568534155134},
+     {-0.8903200344966339, -0.40461504459635395, 0.20884659887152338},
+     {-0.8903200344966339, -0.20884659887152338, 0.40461504459635395}},
+    // 880
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.788675134594813, -0.21132486540518713, 0.5773502691896257},
+     {-0.5773502691896257, -0.21132486540518713, 0.788675134594813}},
+    // 881
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {-0.788675134594813, -0.21132486540518713, 0.5773502691896257}},
+    // 882
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.5773502691896257, -0.21132486540518713, 0.788675134594813},
+     {-0.6396021490668312, -0.4264014327112209, 0.6396021490668312}},
+    // 883
+    {{-0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {-0.5773502691896257, -0.21132486540518713, 0.788675134594813},
+     {-0.788675134594813, -0.21132486540518713, 0.5773502691896257}},
+    // 884
+    {{-0.7071067811865475, -0.7071067811865475, -0.0},
+     {-0.5773502691896257, -0.788675134594813, 0.21132486540518713},
+     {-0.788675134594813, -0.5773502691896257, 0.21132486540518713}},
+    // 885
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {-0.5773502691896257, -0.788675134594813, 0.21132486540518713}},
+    // 886
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.788675134594813, -0.5773502691896257, 0.21132486540518713},
+     {-0.6396021490668312, -0.6396021490668312, 0.4264014327112209}},
+    // 887
+    {{-0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {-0.788675134594813, -0.5773502691896257, 0.21132486540518713},
+     {-0.5773502691896257, -0.788675134594813, 0.21132486540518713}},
+    // 888
+    {{0.0, -0.7071067811865475, 0.7071067811865475},
+     {-0.21132486540518713, -0.5773502691896257, 0.788675134594813},
+     {-0.21132486540518713, -0.788675134594813, 0.5773502691896257}},
+    // 889
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {-0.21132486540518713, -0.5773502691896257, 0.788675134594813}},
+    // 890
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.21132486540518713, -0.788675134594813, 0.5773502691896257},
+     {-0.4264014327112209, -0.6396021490668312, 0.6396021490668312}},
+    // 891
+    {{-0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {-0.21132486540518713, -0.788675134594813, 0.5773502691896257},
+     {-0.21132486540518713, -0.5773502691896257, 0.788675134594813}},
+    // 892
+    {{-0.4082482904638631, -0.8164965809277261, 0.4082482904638631},
+     {-0.4264014327112209, -0.6396021490668312, 0.6396021490668312},
+     {-0.6396021490668312, -0.6396021490668312, 0.4264014327112209}},
+    // 893
+    {{-0.4082482904638631, -0.4082482904638631, 0.8164965809277261},
+     {-0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {-0.4264014327112209, -0.6396021490668312, 0.6396021490668312}},
+    // 894
+    {{-0.8164965809277261, -0.4082482904638631, 0.4082482904638631},
+     {-0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {-0.6396021490668312, -0.4264014327112209, 0.6396021490668312}},
+    // 895
+    {{-0.6396021490668312, -0.4264014327112209, 0.6396021490668312},
+     {-0.6396021490668312, -0.6396021490668312, 0.4264014327112209},
+     {-0.4264014327112209, -0.6396021490668312, 0.6396021490668312}},
+    // 896
+    {{-1.0, -0.0, -0.0},
+     {-0.9807852804032304, 0.0, 0.19509032201612825},
+     {-0.9807852804032304, 0.19509032201612825, 0.0}},
+    // 897
+    {{-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {-0.9807852804032304, 0.0, 0.19509032201612825}},
+    // 898
+    {{-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.9807852804032304, 0.19509032201612825, 0.0},
+     {-0.9596829822606674, 0.1987568534155134, 0.1987568534155134}},
+    // 899
+    {{-0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {-0.9807852804032304, 0.19509032201612825, 0.0},
+     {-0.9807852804032304, 0.0, 0.19509032201612825}},
+    // 900
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.788675134594813, 0.21132486540518713, 0.5773502691896257},
+     {-0.8314696123025452, 0.0, 0.5555702330196021}},
+    // 901
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {-0.788675134594813, 0.21132486540518713, 0.5773502691896257}},
+    // 902
+    {{-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.8314696123025452, 0.0, 0.5555702330196021},
+     {-0.8903200344966339, 0.20884659887152338, 0.40461504459635395}},
+    // 903
+    {{-0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {-0.8314696123025452, 0.0, 0.5555702330196021},
+     {-0.788675134594813, 0.21132486540518713, 0.5773502691896257}},
+    // 904
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.8314696123025452, 0.5555702330196021, 0.0},
+     {-0.788675134594813, 0.5773502691896257, 0.21132486540518713}},
+    // 905
+    {{-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {-0.8314696123025452, 0.5555702330196021, 0.0}},
+    // 906
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.788675134594813, 0.5773502691896257, 0.21132486540518713},
+     {-0.8903200344966339, 0.40461504459635395, 0.20884659887152338}},
+    // 907
+    {{-0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {-0.788675134594813, 0.5773502691896257, 0.21132486540518713},
+     {-0.8314696123025452, 0.5555702330196021, 0.0}},
+    // 908
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {-0.8903200344966339, 0.20884659887152338, 0.40461504459635395}},
+    // 909
+    {{-0.9238795325112867, 0.3826834323650897, 0.0},
+     {-0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {-0.8903200344966339, 0.40461504459635395, 0.20884659887152338}},
+    // 910
+    {{-0.9238795325112867, 0.0, 0.3826834323650897},
+     {-0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {-0.9596829822606674, 0.1987568534155134, 0.1987568534155134}},
+    // 911
+    {{-0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {-0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {-0.8903200344966339, 0.40461504459635395, 0.20884659887152338}},
+    // 912
+    {{0.0, 0.0, 1.0},
+     {0.0, 0.19509032201612825, 0.9807852804032304},
+     {-0.19509032201612825, 0.0, 0.9807852804032304}},
+    // 913
+    {{0.0, 0.3826834323650897, 0.9238795325112867},
+     {-0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {0.0, 0.19509032201612825, 0.9807852804032304}},
+    // 914
+    {{-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.19509032201612825, 0.0, 0.9807852804032304},
+     {-0.1987568534155134, 0.1987568534155134, 0.9596829822606674}},
+    // 915
+    {{-0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {-0.19509032201612825, 0.0, 0.9807852804032304},
+     {0.0, 0.19509032201612825, 0.9807852804032304}},
+    // 916
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {-0.21132486540518713, 0.5773502691896257, 0.788675134594813},
+     {0.0, 0.5555702330196021, 0.8314696123025452}},
+    // 917
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {-0.21132486540518713, 0.5773502691896257, 0.788675134594813}},
+    // 918
+    {{0.0, 0.3826834323650897, 0.9238795325112867},
+     {0.0, 0.5555702330196021, 0.8314696123025452},
+     {-0.20884659887152338, 0.40461504459635395, 0.8903200344966339}},
+    // 919
+    {{-0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {0.0, 0.5555702330196021, 0.8314696123025452},
+     {-0.21132486540518713, 0.5773502691896257, 0.788675134594813}},
+    // 920
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.5555702330196021, 0.0, 0.8314696123025452},
+     {-0.5773502691896257, 0.21132486540518713, 0.788675134594813}},
+    // 921
+    {{-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {-0.5555702330196021, 0.0, 0.8314696123025452}},
+    // 922
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.5773502691896257, 0.21132486540518713, 0.788675134594813},
+     {-0.40461504459635395, 0.20884659887152338, 0.8903200344966339}},
+    // 923
+    {{-0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {-0.5773502691896257, 0.21132486540518713, 0.788675134594813},
+     {-0.5555702330196021, 0.0, 0.8314696123025452}},
+    // 924
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {-0.20884659887152338, 0.40461504459635395, 0.8903200344966339}},
+    // 925
+    {{-0.3826834323650897, 0.0, 0.9238795325112867},
+     {-0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {-0.40461504459635395, 0.20884659887152338, 0.8903200344966339}},
+    // 926
+    {{0.0, 0.3826834323650897, 0.9238795325112867},
+     {-0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {-0.1987568534155134, 0.1987568534155134, 0.9596829822606674}},
+    // 927
+    {{-0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {-0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {-0.40461504459635395, 0.20884659887152338, 0.8903200344966339}},
+    // 928
+    {{0.0, 1.0, 0.0},
+     {-0.19509032201612825, 0.9807852804032304, 0.0},
+     {0.0, 0.9807852804032304, 0.19509032201612825}},
+    // 929
+    {{-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {-0.19509032201612825, 0.9807852804032304, 0.0}},
+    // 930
+    {{0.0, 0.9238795325112867, 0.3826834323650897},
+     {0.0, 0.9807852804032304, 0.19509032201612825},
+     {-0.1987568534155134, 0.9596829822606674, 0.1987568534155134}},
+    // 931
+    {{-0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {0.0, 0.9807852804032304, 0.19509032201612825},
+     {-0.19509032201612825, 0.9807852804032304, 0.0}},
+    // 932
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.5773502691896257, 0.788675134594813, 0.21132486540518713},
+     {-0.5555702330196021, 0.8314696123025452, 0.0}},
+    // 933
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {-0.5773502691896257, 0.788675134594813, 0.21132486540518713}},
+    // 934
+    {{-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.5555702330196021, 0.8314696123025452, 0.0},
+     {-0.40461504459635395, 0.8903200344966339, 0.20884659887152338}},
+    // 935
+    {{-0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {-0.5555702330196021, 0.8314696123025452, 0.0},
+     {-0.5773502691896257, 0.788675134594813, 0.21132486540518713}},
+    // 936
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.0, 0.8314696123025452, 0.5555702330196021},
+     {-0.21132486540518713, 0.788675134594813, 0.5773502691896257}},
+    // 937
+    {{0.0, 0.9238795325112867, 0.3826834323650897},
+     {-0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {0.0, 0.8314696123025452, 0.5555702330196021}},
+    // 938
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.21132486540518713, 0.788675134594813, 0.5773502691896257},
+     {-0.20884659887152338, 0.8903200344966339, 0.40461504459635395}},
+    // 939
+    {{-0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {-0.21132486540518713, 0.788675134594813, 0.5773502691896257},
+     {0.0, 0.8314696123025452, 0.5555702330196021}},
+    // 940
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {-0.40461504459635395, 0.8903200344966339, 0.20884659887152338}},
+    // 941
+    {{0.0, 0.9238795325112867, 0.3826834323650897},
+     {-0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {-0.20884659887152338, 0.8903200344966339, 0.40461504459635395}},
+    // 942
+    {{-0.3826834323650897, 0.9238795325112867, 0.0},
+     {-0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {-0.1987568534155134, 0.9596829822606674, 0.1987568534155134}},
+    // 943
+    {{-0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {-0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {-0.20884659887152338, 0.8903200344966339, 0.40461504459635395}},
+    // 944
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {-0.21132486540518713, 0.788675134594813, 0.5773502691896257},
+     {-0.21132486540518713, 0.5773502691896257, 0.788675134594813}},
+    // 945
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {-0.21132486540518713, 0.788675134594813, 0.5773502691896257}},
+    // 946
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.21132486540518713, 0.5773502691896257, 0.788675134594813},
+     {-0.4264014327112209, 0.6396021490668312, 0.6396021490668312}},
+    // 947
+    {{-0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {-0.21132486540518713, 0.5773502691896257, 0.788675134594813},
+     {-0.21132486540518713, 0.788675134594813, 0.5773502691896257}},
+    // 948
+    {{-0.7071067811865475, 0.7071067811865475, 0.0},
+     {-0.788675134594813, 0.5773502691896257, 0.21132486540518713},
+     {-0.5773502691896257, 0.788675134594813, 0.21132486540518713}},
+    // 949
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {-0.788675134594813, 0.5773502691896257, 0.21132486540518713}},
+    // 950
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.5773502691896257, 0.788675134594813, 0.21132486540518713},
+     {-0.6396021490668312, 0.6396021490668312, 0.4264014327112209}},
+    // 951
+    {{-0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {-0.5773502691896257, 0.788675134594813, 0.21132486540518713},
+     {-0.788675134594813, 0.5773502691896257, 0.21132486540518713}},
+    // 952
+    {{-0.7071067811865475, 0.0, 0.7071067811865475},
+     {-0.5773502691896257, 0.21132486540518713, 0.788675134594813},
+     {-0.788675134594813, 0.21132486540518713, 0.5773502691896257}},
+    // 953
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {-0.5773502691896257, 0.21132486540518713, 0.788675134594813}},
+    // 954
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.788675134594813, 0.21132486540518713, 0.5773502691896257},
+     {-0.6396021490668312, 0.4264014327112209, 0.6396021490668312}},
+    // 955
+    {{-0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {-0.788675134594813, 0.21132486540518713, 0.5773502691896257},
+     {-0.5773502691896257, 0.21132486540518713, 0.788675134594813}},
+    // 956
+    {{-0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {-0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {-0.6396021490668312, 0.6396021490668312, 0.4264014327112209}},
+    // 957
+    {{-0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {-0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {-0.6396021490668312, 0.4264014327112209, 0.6396021490668312}},
+    // 958
+    {{-0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {-0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {-0.4264014327112209, 0.6396021490668312, 0.6396021490668312}},
+    // 959
+    {{-0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {-0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {-0.6396021490668312, 0.4264014327112209, 0.6396021490668312}},
+    // 960
+    {{0.0, 1.0, 0.0},
+     {0.0, 0.9807852804032304, 0.19509032201612825},
+     {0.19509032201612825, 0.9807852804032304, 0.0}},
+    // 961
+    {{0.0, 0.9238795325112867, 0.3826834323650897},
+     {0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {0.0, 0.9807852804032304, 0.19509032201612825}},
+    // 962
+    {{0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.19509032201612825, 0.9807852804032304, 0.0},
+     {0.1987568534155134, 0.9596829822606674, 0.1987568534155134}},
+    // 963
+    {{0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {0.19509032201612825, 0.9807852804032304, 0.0},
+     {0.0, 0.9807852804032304, 0.19509032201612825}},
+    // 964
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.21132486540518713, 0.788675134594813, 0.5773502691896257},
+     {0.0, 0.8314696123025452, 0.5555702330196021}},
+    // 965
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {0.21132486540518713, 0.788675134594813, 0.5773502691896257}},
+    // 966
+    {{0.0, 0.9238795325112867, 0.3826834323650897},
+     {0.0, 0.8314696123025452, 0.5555702330196021},
+     {0.20884659887152338, 0.8903200344966339, 0.40461504459635395}},
+    // 967
+    {{0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {0.0, 0.8314696123025452, 0.5555702330196021},
+     {0.21132486540518713, 0.788675134594813, 0.5773502691896257}},
+    // 968
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.5555702330196021, 0.8314696123025452, 0.0},
+     {0.5773502691896257, 0.788675134594813, 0.21132486540518713}},
+    // 969
+    {{0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {0.5555702330196021, 0.8314696123025452, 0.0}},
+    // 970
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.5773502691896257, 0.788675134594813, 0.21132486540518713},
+     {0.40461504459635395, 0.8903200344966339, 0.20884659887152338}},
+    // 971
+    {{0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {0.5773502691896257, 0.788675134594813, 0.21132486540518713},
+     {0.5555702330196021, 0.8314696123025452, 0.0}},
+    // 972
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.40461504459635395, 0.8903200344966339, 0.20884659887152338},
+     {0.20884659887152338, 0.8903200344966339, 0.40461504459635395}},
+    // 973
+    {{0.3826834323650897, 0.9238795325112867, 0.0},
+     {0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {0.40461504459635395, 0.8903200344966339, 0.20884659887152338}},
+    // 974
+    {{0.0, 0.9238795325112867, 0.3826834323650897},
+     {0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {0.1987568534155134, 0.9596829822606674, 0.1987568534155134}},
+    // 975
+    {{0.1987568534155134, 0.9596829822606674, 0.1987568534155134},
+     {0.20884659887152338, 0.8903200344966339, 0.40461504459635395},
+     {0.40461504459635395, 0.8903200344966339, 0.20884659887152338}},
+    // 976
+    {{0.0, 0.0, 1.0},
+     {0.19509032201612825, 0.0, 0.9807852804032304},
+     {0.0, 0.19509032201612825, 0.9807852804032304}},
+    // 977
+    {{0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {0.19509032201612825, 0.0, 0.9807852804032304}},
+    // 978
+    {{0.0, 0.3826834323650897, 0.9238795325112867},
+     {0.0, 0.19509032201612825, 0.9807852804032304},
+     {0.1987568534155134, 0.1987568534155134, 0.9596829822606674}},
+    // 979
+    {{0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {0.0, 0.19509032201612825, 0.9807852804032304},
+     {0.19509032201612825, 0.0, 0.9807852804032304}},
+    // 980
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.5773502691896257, 0.21132486540518713, 0.788675134594813},
+     {0.5555702330196021, 0.0, 0.8314696123025452}},
+    // 981
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {0.5773502691896257, 0.21132486540518713, 0.788675134594813}},
+    // 982
+    {{0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.5555702330196021, 0.0, 0.8314696123025452},
+     {0.40461504459635395, 0.20884659887152338, 0.8903200344966339}},
+    // 983
+    {{0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {0.5555702330196021, 0.0, 0.8314696123025452},
+     {0.5773502691896257, 0.21132486540518713, 0.788675134594813}},
+    // 984
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.0, 0.5555702330196021, 0.8314696123025452},
+     {0.21132486540518713, 0.5773502691896257, 0.788675134594813}},
+    // 985
+    {{0.0, 0.3826834323650897, 0.9238795325112867},
+     {0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {0.0, 0.5555702330196021, 0.8314696123025452}},
+    // 986
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.21132486540518713, 0.5773502691896257, 0.788675134594813},
+     {0.20884659887152338, 0.40461504459635395, 0.8903200344966339}},
+    // 987
+    {{0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {0.21132486540518713, 0.5773502691896257, 0.788675134594813},
+     {0.0, 0.5555702330196021, 0.8314696123025452}},
+    // 988
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.20884659887152338, 0.40461504459635395, 0.8903200344966339},
+     {0.40461504459635395, 0.20884659887152338, 0.8903200344966339}},
+    // 989
+    {{0.0, 0.3826834323650897, 0.9238795325112867},
+     {0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {0.20884659887152338, 0.40461504459635395, 0.8903200344966339}},
+    // 990
+    {{0.3826834323650897, 0.0, 0.9238795325112867},
+     {0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {0.1987568534155134, 0.1987568534155134, 0.9596829822606674}},
+    // 991
+    {{0.1987568534155134, 0.1987568534155134, 0.9596829822606674},
+     {0.40461504459635395, 0.20884659887152338, 0.8903200344966339},
+     {0.20884659887152338, 0.40461504459635395, 0.8903200344966339}},
+    // 992
+    {{1.0, 0.0, 0.0},
+     {0.9807852804032304, 0.19509032201612825, 0.0},
+     {0.9807852804032304, 0.0, 0.19509032201612825}},
+    // 993
+    {{0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {0.9807852804032304, 0.19509032201612825, 0.0}},
+    // 994
+    {{0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.9807852804032304, 0.0, 0.19509032201612825},
+     {0.9596829822606674, 0.1987568534155134, 0.1987568534155134}},
+    // 995
+    {{0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {0.9807852804032304, 0.0, 0.19509032201612825},
+     {0.9807852804032304, 0.19509032201612825, 0.0}},
+    // 996
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.788675134594813, 0.5773502691896257, 0.21132486540518713},
+     {0.8314696123025452, 0.5555702330196021, 0.0}},
+    // 997
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {0.788675134594813, 0.5773502691896257, 0.21132486540518713}},
+    // 998
+    {{0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.8314696123025452, 0.5555702330196021, 0.0},
+     {0.8903200344966339, 0.40461504459635395, 0.20884659887152338}},
+    // 999
+    {{0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {0.8314696123025452, 0.5555702330196021, 0.0},
+     {0.788675134594813, 0.5773502691896257, 0.21132486540518713}},
+    // 1000
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.8314696123025452, 0.0, 0.5555702330196021},
+     {0.788675134594813, 0.21132486540518713, 0.5773502691896257}},
+    // 1001
+    {{0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {0.8314696123025452, 0.0, 0.5555702330196021}},
+    // 1002
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.788675134594813, 0.21132486540518713, 0.5773502691896257},
+     {0.8903200344966339, 0.20884659887152338, 0.40461504459635395}},
+    // 1003
+    {{0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {0.788675134594813, 0.21132486540518713, 0.5773502691896257},
+     {0.8314696123025452, 0.0, 0.5555702330196021}},
+    // 1004
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.8903200344966339, 0.20884659887152338, 0.40461504459635395},
+     {0.8903200344966339, 0.40461504459635395, 0.20884659887152338}},
+    // 1005
+    {{0.9238795325112867, 0.0, 0.3826834323650897},
+     {0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {0.8903200344966339, 0.20884659887152338, 0.40461504459635395}},
+    // 1006
+    {{0.9238795325112867, 0.3826834323650897, 0.0},
+     {0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {0.9596829822606674, 0.1987568534155134, 0.1987568534155134}},
+    // 1007
+    {{0.9596829822606674, 0.1987568534155134, 0.1987568534155134},
+     {0.8903200344966339, 0.40461504459635395, 0.20884659887152338},
+     {0.8903200344966339, 0.20884659887152338, 0.40461504459635395}},
+    // 1008
+    {{0.7071067811865475, 0.0, 0.7071067811865475},
+     {0.788675134594813, 0.21132486540518713, 0.5773502691896257},
+     {0.5773502691896257, 0.21132486540518713, 0.788675134594813}},
+    // 1009
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {0.788675134594813, 0.21132486540518713, 0.5773502691896257}},
+    // 1010
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.5773502691896257, 0.21132486540518713, 0.788675134594813},
+     {0.6396021490668312, 0.4264014327112209, 0.6396021490668312}},
+    // 1011
+    {{0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {0.5773502691896257, 0.21132486540518713, 0.788675134594813},
+     {0.788675134594813, 0.21132486540518713, 0.5773502691896257}},
+    // 1012
+    {{0.7071067811865475, 0.7071067811865475, 0.0},
+     {0.5773502691896257, 0.788675134594813, 0.21132486540518713},
+     {0.788675134594813, 0.5773502691896257, 0.21132486540518713}},
+    // 1013
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {0.5773502691896257, 0.788675134594813, 0.21132486540518713}},
+    // 1014
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.788675134594813, 0.5773502691896257, 0.21132486540518713},
+     {0.6396021490668312, 0.6396021490668312, 0.4264014327112209}},
+    // 1015
+    {{0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {0.788675134594813, 0.5773502691896257, 0.21132486540518713},
+     {0.5773502691896257, 0.788675134594813, 0.21132486540518713}},
+    // 1016
+    {{0.0, 0.7071067811865475, 0.7071067811865475},
+     {0.21132486540518713, 0.5773502691896257, 0.788675134594813},
+     {0.21132486540518713, 0.788675134594813, 0.5773502691896257}},
+    // 1017
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {0.21132486540518713, 0.5773502691896257, 0.788675134594813}},
+    // 1018
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.21132486540518713, 0.788675134594813, 0.5773502691896257},
+     {0.4264014327112209, 0.6396021490668312, 0.6396021490668312}},
+    // 1019
+    {{0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {0.21132486540518713, 0.788675134594813, 0.5773502691896257},
+     {0.21132486540518713, 0.5773502691896257, 0.788675134594813}},
+    // 1020
+    {{0.4082482904638631, 0.8164965809277261, 0.4082482904638631},
+     {0.4264014327112209, 0.6396021490668312, 0.6396021490668312},
+     {0.6396021490668312, 0.6396021490668312, 0.4264014327112209}},
+    // 1021
+    {{0.4082482904638631, 0.4082482904638631, 0.8164965809277261},
+     {0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {0.4264014327112209, 0.6396021490668312, 0.6396021490668312}},
+    // 1022
+    {{0.8164965809277261, 0.4082482904638631, 0.4082482904638631},
+     {0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {0.6396021490668312, 0.4264014327112209, 0.6396021490668312}},
+    // 1023
+    {{0.6396021490668312, 0.4264014327112209, 0.6396021490668312},
+     {0.6396021490668312, 0.6396021490668312, 0.4264014327112209},
+     {0.4264014327112209, 0.6396021490668312, 0.6396021490668312}},
+};
+
+// `HTM_CHILD_EDGE_NORMALS` contains, for every trixel at levels 0
+// through HTM_TABLE_LEVEL - 1, the double precision cross products
+// m01 × m20, m12 × m01 and m20 × m12 of its edge midpoints. Rows are
+// indexed by `htmTableRow`.
+alignas(64) constexpr double HTM_CHILD_EDGE_NORMALS[168][3][3] = {
+    // 8
+    {{0.4999999999999999, -0.4999999999999999, 0.4999999999999999},
+     {-0.4999999999999999, -0.4999999999999999, -0.4999999999999999},
+     {-0.4999999999999999, 0.4999999999999999, 0.4999999999999999}},
+    // 9
+    {{0.4999999999999999, 0.4999999999999999, 0.4999999999999999},
+     {0.4999999999999999, -0.4999999999999999, -0.4999999999999999},
+     {-0.4999999999999999, -0.4999999999999999, 0.4999999999999999}},
+    // 10
+    {{-0.4999999999999999, 0.4999999999999999, 0.4999999999999999},
+     {0.4999999999999999, 0.4999999999999999, -0.4999999999999999},
+     {0.4999999999999999, -0.4999999999999999, 0.4999999999999999}},
+    // 11
+    {{-0.4999999999999999, -0.4999999999999999, 0.4999999999999999},
+     {-0.4999999999999999, 0.4999999999999999, -0.4999999999999999},
+     {0.4999999999999999, 0.4999999999999999, 0.4999999999999999}},
+    // 12
+    {{0.4999999999999999, 0.4999999999999999, -0.4999999999999999},
+     {-0.4999999999999999, 0.4999999999999999, 0.4999999999999999},
+     {-0.4999999999999999, -0.4999999999999999, -0.4999999999999999}},
+    // 13
+    {{0.4999999999999999, -0.4999999999999999, -0.4999999999999999},
+     {0.4999999999999999, 0.4999999999999999, 0.4999999999999999},
+     {-0.4999999999999999, 0.4999999999999999, -0.4999999999999999}},
+    // 14
+    {{-0.4999999999999999, -0.4999999999999999, -0.4999999999999999},
+     {0.4999999999999999, -0.4999999999999999, 0.4999999999999999},
+     {0.4999999999999999, 0.4999999999999999, -0.4999999999999999}},
+    // 15
+    {{-0.4999999999999999, 0.4999999999999999, -0.4999999999999999},
+     {-0.4999999999999999, -0.4999999999999999, 0.4999999999999999},
+     {0.4999999999999999, -0.4999999999999999, -0.4999999999999999}},
+    // 32
+    {{0.1464466094067262, -0.35355339059327373, 0.35355339059327373},
+     {-0.15622985705189124, -0.06471252563850333, -0.3771722397422858},
+     {-0.15622985705189124, 0.3771722397422858, 0.06471252563850333}},
+    // 33
+    {{-0.35355339059327373, -0.35355339059327373, -0.1464466094067262},
+     {-0.06471252563850333, 0.3771722397422858, 0.15622985705189124},
+     {0.3771722397422858, -0.06471252563850333, 0.15622985705189124}},
+    // 34
+    {{-0.35355339059327373, 0.1464466094067262, 0.35355339059327373},
+     {0.3771722397422858, -0.15622985705189124, 0.06471252563850333},
+     {-0.06471252563850333, -0.15622985705189124, -0.3771722397422858}},
+    // 35
+    {{-0.5000000000000001, 0.1666666666666667, -0.1666666666666667},
+     {0.1666666666666667, 0.1666666666666667, 0.5000000000000001},
+     {0.1666666666666667, -0.5000000000000001, -0.1666666666666667}},
+    // 36
+    {{0.35355339059327373, 0.1464466094067262, 0.35355339059327373},
+     {0.06471252563850333, -0.15622985705189124, -0.3771722397422858},
+     {-0.3771722397422858, -0.15622985705189124, 0.06471252563850333}},
+    // 37
+    {{0.35355339059327373, -0.35355339059327373, -0.1464466094067262},
+     {-0.3771722397422858, -0.06471252563850333, 0.15622985705189124},
+     {0.06471252563850333, 0.3771722397422858, 0.15622985705189124}},
+    // 38
+    {{-0.1464466094067262, -0.35355339059327373, 0.35355339059327373},
+     {0.15622985705189124, 0.3771722397422858, 0.06471252563850333},
+     {0.15622985705189124, -0.06471252563850333, -0.3771722397422858}},
+    // 39
+    {{-0.1666666666666667, -0.5000000000000001, -0.1666666666666667},
+     {-0.1666666666666667, 0.1666666666666667, 0.5000000000000001},
+     {0.5000000000000001, 0.1666666666666667, -0.1666666666666667}},
+    // 40
+    {{-0.1464466094067262, 0.35355339059327373, 0.35355339059327373},
+     {0.15622985705189124, 0.06471252563850333, -0.3771722397422858},
+     {0.15622985705189124, -0.3771722397422858, 0.06471252563850333}},
+    // 41
+    {{0.35355339059327373, 0.35355339059327373, -0.1464466094067262},
+     {0.06471252563850333, -0.3771722397422858, 0.15622985705189124},
+     {-0.3771722397422858, 0.06471252563850333, 0.15622985705189124}},
+    // 42
+    {{0.35355339059327373, -0.1464466094067262, 0.35355339059327373},
+     {-0.3771722397422858, 0.15622985705189124, 0.06471252563850333},
+     {0.06471252563850333, 0.15622985705189124, -0.3771722397422858}},
+    // 43
+    {{0.5000000000000001, -0.1666666666666667, -0.1666666666666667},
+     {-0.1666666666666667, -0.1666666666666667, 0.5000000000000001},
+     {-0.1666666666666667, 0.5000000000000001, -0.1666666666666667}},
+    // 44
+    {{-0.35355339059327373, -0.1464466094067262, 0.35355339059327373},
+     {-0.06471252563850333, 0.15622985705189124, -0.3771722397422858},
+     {0.3771722397422858, 0.15622985705189124, 0.06471252563850333}},
+    // 45
+    {{-0.35355339059327373, 0.35355339059327373, -0.1464466094067262},
+     {0.3771722397422858, 0.06471252563850333, 0.15622985705189124},
+     {-0.06471252563850333, -0.3771722397422858, 0.15622985705189124}},
+    // 46
+    {{0.1464466094067262, 0.35355339059327373, 0.35355339059327373},
+     {-0.15622985705189124, -0.3771722397422858, 0.06471252563850333},
+     {-0.15622985705189124, 0.06471252563850333, -0.3771722397422858}},
+    // 47
+    {{0.1666666666666667, 0.5000000000000001, -0.1666666666666667},
+     {0.1666666666666667, -0.1666666666666667, 0.5000000000000001},
+     {-0.5000000000000001, -0.1666666666666667, -0.1666666666666667}},
+    // 48
+    {{0.1464466094067262, 0.35355339059327373, -0.35355339059327373},
+     {-0.15622985705189124, 0.06471252563850333, 0.3771722397422858},
+     {-0.15622985705189124, -0.3771722397422858, -0.06471252563850333}},
+    // 49
+    {{-0.35355339059327373, 0.35355339059327373, 0.1464466094067262},
+     {-0.06471252563850333, -0.3771722397422858, -0.15622985705189124},
+     {0.3771722397422858, 0.06471252563850333, -0.15622985705189124}},
+    // 50
+    {{-0.35355339059327373, -0.1464466094067262, -0.35355339059327373},
+     {0.3771722397422858, 0.15622985705189124, -0.06471252563850333},
+     {-0.06471252563850333, 0.15622985705189124, 0.3771722397422858}},
+    // 51
+    {{-0.5000000000000001, -0.1666666666666667, 0.1666666666666667},
+     {0.1666666666666667, -0.1666666666666667, -0.5000000000000001},
+     {0.1666666666666667, 0.5000000000000001, 0.1666666666666667}},
+    // 52
+    {{0.35355339059327373, -0.1464466094067262, -0.35355339059327373},
+     {0.06471252563850333, 0.15622985705189124, 0.3771722397422858},
+     {-0.3771722397422858, 0.15622985705189124, -0.06471252563850333}},
+    // 53
+    {{0.35355339059327373, 0.35355339059327373, 0.1464466094067262},
+     {-0.3771722397422858, 0.06471252563850333, -0.15622985705189124},
+     {0.06471252563850333, -0.3771722397422858, -0.15622985705189124}},
+    // 54
+    {{-0.1464466094067262, 0.35355339059327373, -0.35355339059327373},
+     {0.15622985705189124, -0.3771722397422858, -0.06471252563850333},
+     {0.15622985705189124, 0.06471252563850333, 0.3771722397422858}},
+    // 55
+    {{-0.1666666666666667, 0.5000000000000001, 0.1666666666666667},
+     {-0.1666666666666667, -0.1666666666666667, -0.5000000000000001},
+     {0.5000000000000001, -0.1666666666666667, 0.1666666666666667}},
+    // 56
+    {{-0.1464466094067262, -0.35355339059327373, -0.35355339059327373},
+     {0.15622985705189124, -0.06471252563850333, 0.3771722397422858},
+     {0.15622985705189124, 0.3771722397422858, -0.06471252563850333}},
+    // 57
+    {{0.35355339059327373, -0.35355339059327373, 0.1464466094067262},
+     {0.06471252563850333, 0.3771722397422858, -0.15622985705189124},
+     {-0.3771722397422858, -0.06471252563850333, -0.15622985705189124}},
+    // 58
+    {{0.35355339059327373, 0.1464466094067262, -0.35355339059327373},
+     {-0.3771722397422858, -0.15622985705189124, -0.06471252563850333},
+     {0.06471252563850333, -0.15622985705189124, 0.3771722397422858}},
+    // 59
+    {{0.5000000000000001, 0.1666666666666667, 0.1666666666666667},
+     {-0.1666666666666667, 0.1666666666666667, -0.5000000000000001},
+     {-0.1666666666666667, -0.5000000000000001, 0.1666666666666667}},
+    // 60
+    {{-0.35355339059327373, 0.1464466094067262, -0.35355339059327373},
+     {-0.06471252563850333, -0.15622985705189124, 0.3771722397422858},
+     {0.3771722397422858, -0.15622985705189124, -0.06471252563850333}},
+    // 61
+    {{-0.35355339059327373, -0.35355339059327373, 0.1464466094067262},
+     {0.3771722397422858, -0.06471252563850333, -0.15622985705189124},
+     {-0.06471252563850333, 0.3771722397422858, -0.15622985705189124}},
+    // 62
+    {{0.1464466094067262, -0.35355339059327373, -0.35355339059327373},
+     {-0.15622985705189124, 0.3771722397422858, -0.06471252563850333},
+     {-0.15622985705189124, -0.06471252563850333, 0.3771722397422858}},
+    // 63
+    {{0.1666666666666667, -0.5000000000000001, 0.1666666666666667},
+     {0.1666666666666667, 0.1666666666666667, -0.5000000000000001},
+     {-0.5000000000000001, 0.1666666666666667, 0.1666666666666667}},
+    // 128
+    {{0.03806023374435662, -0.19134171618254486, 0.19134171618254486},
+     {-0.03877553853574491, -0.00771293416656621, -0.1949377962091981},
+     {-0.03877553853574491, 0.1949377962091981, 0.00771293416656621}},
+    // 129
+    {{-0.11740580471599586, -0.041884776182261996, -0.1757102039083385},
+     {-0.03507242023757352, 0.19491668682543273, 0.02343464198287512},
+     {0.1160289536004036, -0.15821019476500758, 0.17364960059441073}},
+    // 130
+    {{-0.11740580471599586, 0.1757102039083385, 0.041884776182261996},
+     {0.1160289536004036, -0.17364960059441073, 0.15821019476500758},
+     {-0.03507242023757352, -0.02343464198287512, -0.19491668682543273}},
+    // 131
+    {{-0.1200964324535065, 0.17429656935108354, -0.17429656935108354},
+     {0.03891032027031305, 0.023469318250678578, 0.2113449640764196},
+     {0.03891032027031305, -0.2113449640764196, -0.023469318250678578}},
+    // 132
+    {{-0.19134171618254486, -0.19134171618254486, -0.03806023374435662},
+     {-0.00771293416656621, 0.1949377962091981, 0.03877553853574491},
+     {0.1949377962091981, -0.00771293416656621, 0.03877553853574491}},
+    // 133
+    {{-0.041884776182261996, 0.1757102039083385, 0.11740580471599586},
+     {0.19491668682543273, -0.02343464198287512, 0.03507242023757352},
+     {-0.15821019476500758, -0.17364960059441073, -0.1160289536004036}},
+    // 134
+    {{0.1757102039083385, -0.041884776182261996, 0.11740580471599586},
+     {-0.17364960059441073, -0.15821019476500758, -0.1160289536004036},
+     {-0.02343464198287512, 0.19491668682543273, 0.03507242023757352}},
+    // 135
+    {{0.17429656935108354, 0.17429656935108354, 0.1200964324535065},
+     {0.023469318250678578, -0.2113449640764196, -0.03891032027031305},
+     {-0.2113449640764196, 0.023469318250678578, -0.03891032027031305}},
+    // 136
+    {{-0.19134171618254486, 0.03806023374435662, 0.19134171618254486},
+     {0.1949377962091981, -0.03877553853574491, 0.00771293416656621},
+     {-0.00771293416656621, -0.03877553853574491, -0.1949377962091981}},
+    // 137
+    {{0.1757102039083385, -0.11740580471599586, 0.041884776182261996},
+     {-0.02343464198287512, -0.03507242023757352, -0.19491668682543273},
+     {-0.17364960059441073, 0.1160289536004036, 0.15821019476500758}},
+    // 138
+    {{-0.041884776182261996, -0.11740580471599586, -0.1757102039083385},
+     {-0.15821019476500758, 0.1160289536004036, 0.17364960059441073},
+     {0.19491668682543273, -0.03507242023757352, 0.02343464198287512}},
+    // 139
+    {{0.17429656935108354, -0.1200964324535065, -0.17429656935108354},
+     {-0.2113449640764196, 0.03891032027031305, -0.023469318250678578},
+     {0.023469318250678578, 0.03891032027031305, 0.2113449640764196}},
+    // 140
+    {{-0.28867513459481303, 0.04465819873852049, -0.04465819873852049},
+     {0.13516383806441662, 0.11101914389424891, 0.20112836927052666},
+     {0.13516383806441662, -0.20112836927052666, -0.11101914389424891}},
+    // 141
+    {{0.04465819873852049, 0.04465819873852049, 0.28867513459481303},
+     {0.11101914389424891, -0.20112836927052666, -0.13516383806441662},
+     {-0.20112836927052666, 0.11101914389424891, -0.13516383806441662}},
+    // 142
+    {{0.04465819873852049, -0.28867513459481303, -0.04465819873852049},
+     {-0.20112836927052666, 0.13516383806441662, -0.11101914389424891},
+     {0.11101914389424891, 0.13516383806441662, 0.20112836927052666}},
+    // 143
+    {{0.22727272727272718, -0.1363636363636363, 0.1363636363636363},
+     {-0.1363636363636363, -0.1363636363636363, -0.22727272727272718},
+     {-0.1363636363636363, 0.22727272727272718, 0.1363636363636363}},
+    // 144
+    {{0.19134171618254486, 0.03806023374435662, 0.19134171618254486},
+     {0.00771293416656621, -0.03877553853574491, -0.1949377962091981},
+     {-0.1949377962091981, -0.03877553853574491, 0.00771293416656621}},
+    // 145
+    {{0.041884776182261996, -0.11740580471599586, -0.1757102039083385},
+     {-0.19491668682543273, -0.03507242023757352, 0.02343464198287512},
+     {0.15821019476500758, 0.1160289536004036, 0.17364960059441073}},
+    // 146
+    {{-0.1757102039083385, -0.11740580471599586, 0.041884776182261996},
+     {0.17364960059441073, 0.1160289536004036, 0.15821019476500758},
+     {0.02343464198287512, -0.03507242023757352, -0.19491668682543273}},
+    // 147
+    {{-0.17429656935108354, -0.1200964324535065, -0.17429656935108354},
+     {-0.023469318250678578, 0.03891032027031305, 0.2113449640764196},
+     {0.2113449640764196, 0.03891032027031305, -0.023469318250678578}},
+    // 148
+    {{0.19134171618254486, -0.19134171618254486, -0.03806023374435662},
+     {-0.1949377962091981, -0.00771293416656621, 0.03877553853574491},
+     {0.00771293416656621, 0.1949377962091981, 0.03877553853574491}},
+    // 149
+    {{-0.1757102039083385, -0.041884776182261996, 0.11740580471599586},
+     {0.02343464198287512, 0.19491668682543273, 0.03507242023757352},
+     {0.17364960059441073, -0.15821019476500758, -0.1160289536004036}},
+    // 150
+    {{0.041884776182261996, 0.1757102039083385, 0.11740580471599586},
+     {0.15821019476500758, -0.17364960059441073, -0.1160289536004036},
+     {-0.19491668682543273, -0.02343464198287512, 0.03507242023757352}},
+    // 151
+    {{-0.17429656935108354, 0.17429656935108354, 0.1200964324535065},
+     {0.2113449640764196, 0.023469318250678578, -0.03891032027031305},
+     {-0.023469318250678578, -0.2113449640764196, -0.03891032027031305}},
+    // 152
+    {{-0.03806023374435662, -0.19134171618254486, 0.19134171618254486},
+     {0.03877553853574491, 0.1949377962091981, 0.00771293416656621},
+     {0.03877553853574491, -0.00771293416656621, -0.1949377962091981}},
+    // 153
+    {{0.11740580471599586, 0.1757102039083385, 0.041884776182261996},
+     {0.03507242023757352, -0.02343464198287512, -0.19491668682543273},
+     {-0.1160289536004036, -0.17364960059441073, 0.15821019476500758}},
+    // 154
+    {{0.11740580471599586, -0.041884776182261996, -0.1757102039083385},
+     {-0.1160289536004036, -0.15821019476500758, 0.17364960059441073},
+     {0.03507242023757352, 0.19491668682543273, 0.02343464198287512}},
+    // 155
+    {{0.1200964324535065, 0.17429656935108354, -0.17429656935108354},
+     {-0.03891032027031305, -0.2113449640764196, -0.023469318250678578},
+     {-0.03891032027031305, 0.023469318250678578, 0.2113449640764196}},
+    // 156
+    {{-0.04465819873852049, -0.28867513459481303, -0.04465819873852049},
+     {-0.11101914389424891, 0.13516383806441662, 0.20112836927052666},
+     {0.20112836927052666, 0.13516383806441662, -0.11101914389424891}},
+    // 157
+    {{-0.04465819873852049, 0.04465819873852049, 0.28867513459481303},
+     {0.20112836927052666, 0.11101914389424891, -0.13516383806441662},
+     {-0.11101914389424891, -0.20112836927052666, -0.13516383806441662}},
+    // 158
+    {{0.28867513459481303, 0.04465819873852049, -0.04465819873852049},
+     {-0.13516383806441662, -0.20112836927052666, -0.11101914389424891},
+     {-0.13516383806441662, 0.11101914389424891, 0.20112836927052666}},
+    // 159
+    {{0.1363636363636363, 0.22727272727272718, 0.1363636363636363},
+     {0.1363636363636363, -0.1363636363636363, -0.22727272727272718},
+     {-0.22727272727272718, -0.1363636363636363, 0.1363636363636363}},
+    // 160
+    {{-0.03806023374435662, 0.19134171618254486, 0.19134171618254486},
+     {0.03877553853574491, 0.00771293416656621, -0.1949377962091981},
+     {0.03877553853574491, -0.1949377962091981, 0.00771293416656621}},
+    // 161
+    {{0.11740580471599586, 0.041884776182261996, -0.1757102039083385},
+     {0.03507242023757352, -0.19491668682543273, 0.02343464198287512},
+     {-0.1160289536004036, 0.15821019476500758, 0.17364960059441073}},
+    // 162
+    {{0.11740580471599586, -0.1757102039083385, 0.041884776182261996},
+     {-0.1160289536004036, 0.17364960059441073, 0.15821019476500758},
+     {0.03507242023757352, 0.02343464198287512, -0.19491668682543273}},
+    // 163
+    {{0.1200964324535065, -0.17429656935108354, -0.17429656935108354},
+     {-0.03891032027031305, -0.023469318250678578, 0.2113449640764196},
+     {-0.03891032027031305, 0.2113449640764196, -0.023469318250678578}},
+    // 164
+    {{0.19134171618254486, 0.19134171618254486, -0.03806023374435662},
+     {0.00771293416656621, -0.1949377962091981, 0.03877553853574491},
+     {-0.1949377962091981, 0.00771293416656621, 0.03877553853574491}},
+    // 165
+    {{0.041884776182261996, -0.1757102039083385, 0.11740580471599586},
+     {-0.19491668682543273, 0.02343464198287512, 0.03507242023757352},
+     {0.15821019476500758, 0.17364960059441073, -0.1160289536004036}},
+    // 166
+    {{-0.1757102039083385, 0.041884776182261996, 0.11740580471599586},
+     {0.17364960059441073, 0.15821019476500758, -0.1160289536004036},
+     {0.02343464198287512, -0.19491668682543273, 0.03507242023757352}},
+    // 167
+    {{-0.17429656935108354, -0.17429656935108354, 0.1200964324535065},
+     {-0.023469318250678578, 0.2113449640764196, -0.03891032027031305},
+     {0.2113449640764196, -0.023469318250678578, -0.03891032027031305}},
+    // 168
+    {{0.19134171618254486, -0.03806023374435662, 0.19134171618254486},
+     {-0.1949377962091981, 0.03877553853574491, 0.00771293416656621},
+     {0.00771293416656621, 0.03877553853574491, -0.1949377962091981}},
+    // 169
+    {{-0.1757102039083385, 0.11740580471599586, 0.041884776182261996},
+     {0.02343464198287512, 0.03507242023757352, -0.19491668682543273},
+     {0.17364960059441073, -0.1160289536004036, 0.15821019476500758}},
+    // 170
+    {{0.041884776182261996, 0.11740580471599586, -0.1757102039083385},
+     {0.15821019476500758, -0.1160289536004036, 0.17364960059441073},
+     {-0.19491668682543273, 0.03507242023757352, 0.02343464198287512}},
+    // 171
+    {{-0.17429656935108354, 0.1200964324535065, -0.17429656935108354},
+     {0.2113449640764196, -0.03891032027031305, -0.023469318250678578},
+     {-0.023469318250678578, -0.03891032027031305, 0.2113449640764196}},
+    // 172
+    {{0.28867513459481303, -0.04465819873852049, -0.04465819873852049},
+     {-0.13516383806441662, -0.11101914389424891, 0.20112836927052666},
+     {-0.13516383806441662, 0.20112836927052666, -0.11101914389424891}},
+    // 173
+    {{-0.04465819873852049, -0.04465819873852049, 0.28867513459481303},
+     {-0.11101914389424891, 0.20112836927052666, -0.13516383806441662},
+     {0.20112836927052666, -0.11101914389424891, -0.13516383806441662}},
+    // 174
+    {{-0.04465819873852049, 0.28867513459481303, -0.04465819873852049},
+     {0.20112836927052666, -0.13516383806441662, -0.11101914389424891},
+     {-0.11101914389424891, -0.13516383806441662, 0.20112836927052666}},
+    // 175
+    {{-0.22727272727272718, 0.1363636363636363, 0.1363636363636363},
+     {0.1363636363636363, 0.1363636363636363, -0.22727272727272718},
+     {0.1363636363636363, -0.22727272727272718, 0.1363636363636363}},
+    // 176
+    {{-0.19134171618254486, -0.03806023374435662, 0.19134171618254486},
+     {-0.00771293416656621, 0.03877553853574491, -0.1949377962091981},
+     {0.1949377962091981, 0.03877553853574491, 0.00771293416656621}},
+    // 177
+    {{-0.041884776182261996, 0.11740580471599586, -0.1757102039083385},
+     {0.19491668682543273, 0.03507242023757352, 0.02343464198287512},
+     {-0.15821019476500758, -0.1160289536004036, 0.17364960059441073}},
+    // 178
+    {{0.1757102039083385, 0.11740580471599586, 0.041884776182261996},
+     {-0.17364960059441073, -0.1160289536004036, 0.15821019476500758},
+     {-0.02343464198287512, 0.03507242023757352, -0.19491668682543273}},
+    // 179
+    {{0.17429656935108354, 0.1200964324535065, -0.17429656935108354},
+     {0.023469318250678578, -0.03891032027031305, 0.2113449640764196},
+     {-0.2113449640764196, -0.03891032027031305, -0.023469318250678578}},
+    // 180
+    {{-0.19134171618254486, 0.19134171618254486, -0.03806023374435662},
+     {0.1949377962091981, 0.00771293416656621, 0.03877553853574491},
+     {-0.00771293416656621, -0.1949377962091981, 0.03877553853574491}},
+    // 181
+    {{0.1757102039083385, 0.041884776182261996, 0.11740580471599586},
+     {-0.02343464198287512, -0.19491668682543273, 0.03507242023757352},
+     {-0.17364960059441073, 0.15821019476500758, -0.1160289536004036}},
+    // 182
+    {{-0.041884776182261996, -0.1757102039083385, 0.11740580471599586},
+     {-0.15821019476500758, 0.17364960059441073, -0.1160289536004036},
+     {0.19491668682543273, 0.02343464198287512, 0.03507242023757352}},
+    // 183
+    {{0.17429656935108354, -0.17429656935108354, 0.1200964324535065},
+     {-0.2113449640764196, -0.023469318250678578, -0.03891032027031305},
+     {0.023469318250678578, 0.2113449640764196, -0.03891032027031305}},
+    // 184
+    {{0.03806023374435662, 0.19134171618254486, 0.19134171618254486},
+     {-0.03877553853574491, -0.1949377962091981, 0.00771293416656621},
+     {-0.03877553853574491, 0.00771293416656621, -0.1949377962091981}},
+    // 185
+    {{-0.11740580471599586, -0.1757102039083385, 0.041884776182261996},
+     {-0.03507242023757352, 0.02343464198287512, -0.19491668682543273},
+     {0.1160289536004036, 0.17364960059441073, 0.15821019476500758}},
+    // 186
+    {{-0.11740580471599586, 0.041884776182261996, -0.1757102039083385},
+     {0.1160289536004036, 0.15821019476500758, 0.17364960059441073},
+     {-0.03507242023757352, -0.19491668682543273, 0.02343464198287512}},
+    // 187
+    {{-0.1200964324535065, -0.17429656935108354, -0.17429656935108354},
+     {0.03891032027031305, 0.2113449640764196, -0.023469318250678578},
+     {0.03891032027031305, -0.023469318250678578, 0.2113449640764196}},
+    // 188
+    {{0.04465819873852049, 0.28867513459481303, -0.04465819873852049},
+     {0.11101914389424891, -0.13516383806441662, 0.20112836927052666},
+     {-0.20112836927052666, -0.13516383806441662, -0.11101914389424891}},
+    // 189
+    {{0.04465819873852049, -0.04465819873852049, 0.28867513459481303},
+     {-0.20112836927052666, -0.11101914389424891, -0.13516383806441662},
+     {0.11101914389424891, 0.20112836927052666, -0.13516383806441662}},
+    // 190
+    {{-0.28867513459481303, -0.04465819873852049, -0.04465819873852049},
+     {0.13516383806441662, 0.20112836927052666, -0.11101914389424891},
+     {0.13516383806441662, -0.11101914389424891, 0.20112836927052666}},
+    // 191
+    {{-0.1363636363636363, -0.22727272727272718, 0.1363636363636363},
+     {-0.1363636363636363, 0.1363636363636363, -0.22727272727272718},
+     {0.22727272727272718, 0.1363636363636363, 0.1363636363636363}},
+    // 192
+    {{0.03806023374435662, 0.19134171618254486, -0.19134171618254486},
+     {-0.03877553853574491, 0.00771293416656621, 0.1949377962091981},
+     {-0.03877553853574491, -0.1949377962091981, -0.00771293416656621}},
+    // 193
+    {{-0.11740580471599586, 0.041884776182261996, 0.1757102039083385},
+     {-0.03507242023757352, -0.19491668682543273, -0.02343464198287512},
+     {0.1160289536004036, 0.15821019476500758, -0.17364960059441073}},
+    // 194
+    {{-0.11740580471599586, -0.1757102039083385, -0.041884776182261996},
+     {0.1160289536004036, 0.17364960059441073, -0.15821019476500758},
+     {-0.03507242023757352, 0.02343464198287512, 0.19491668682543273}},
+    // 195
+    {{-0.1200964324535065, -0.17429656935108354, 0.17429656935108354},
+     {0.03891032027031305, -0.023469318250678578, -0.2113449640764196},
+     {0.03891032027031305, 0.2113449640764196, 0.023469318250678578}},
+    // 196
+    {{-0.19134171618254486, 0.19134171618254486, 0.03806023374435662},
+     {-0.00771293416656621, -0.1949377962091981, -0.03877553853574491},
+     {0.1949377962091981, 0.00771293416656621, -0.03877553853574491}},
+    // 197
+    {{-0.041884776182261996, -0.1757102039083385, -0.11740580471599586},
+     {0.19491668682543273, 0.02343464198287512, -0.03507242023757352},
+     {-0.15821019476500758, 0.17364960059441073, 0.1160289536004036}},
+    // 198
+    {{0.1757102039083385, 0.041884776182261996, -0.11740580471599586},
+     {-0.17364960059441073, 0.15821019476500758, 0.1160289536004036},
+     {-0.02343464198287512, -0.19491668682543273, -0.03507242023757352}},
+    // 199
+    {{0.17429656935108354, -0.17429656935108354, -0.1200964324535065},
+     {0.023469318250678578, 0.2113449640764196, 0.03891032027031305},
+     {-0.2113449640764196, -0.023469318250678578, 0.03891032027031305}},
+    // 200
+    {{-0.19134171618254486, -0.03806023374435662, -0.19134171618254486},
+     {0.1949377962091981, 0.03877553853574491, -0.00771293416656621},
+     {-0.00771293416656621, 0.03877553853574491, 0.1949377962091981}},
+    // 201
+    {{0.1757102039083385, 0.11740580471599586, -0.041884776182261996},
+     {-0.02343464198287512, 0.03507242023757352, 0.19491668682543273},
+     {-0.17364960059441073, -0.1160289536004036, -0.15821019476500758}},
+    // 202
+    {{-0.041884776182261996, 0.11740580471599586, 0.1757102039083385},
+     {-0.15821019476500758, -0.1160289536004036, -0.17364960059441073},
+     {0.19491668682543273, 0.03507242023757352, -0.02343464198287512}},
+    // 203
+    {{0.17429656935108354, 0.1200964324535065, 0.17429656935108354},
+     {-0.2113449640764196, -0.03891032027031305, 0.023469318250678578},
+     {0.023469318250678578, -0.03891032027031305, -0.2113449640764196}},
+    // 204
+    {{-0.28867513459481303, -0.04465819873852049, 0.04465819873852049},
+     {0.13516383806441662, -0.11101914389424891, -0.20112836927052666},
+     {0.13516383806441662, 0.20112836927052666, 0.11101914389424891}},
+    // 205
+    {{0.04465819873852049, -0.04465819873852049, -0.28867513459481303},
+     {0.11101914389424891, 0.20112836927052666, 0.13516383806441662},
+     {-0.20112836927052666, -0.11101914389424891, 0.13516383806441662}},
+    // 206
+    {{0.04465819873852049, 0.28867513459481303, 0.04465819873852049},
+     {-0.20112836927052666, -0.13516383806441662, 0.11101914389424891},
+     {0.11101914389424891, -0.13516383806441662, -0.20112836927052666}},
+    // 207
+    {{0.22727272727272718, 0.1363636363636363, -0.1363636363636363},
+     {-0.1363636363636363, 0.1363636363636363, 0.22727272727272718},
+     {-0.1363636363636363, -0.22727272727272718, -0.1363636363636363}},
+    // 208
+    {{0.19134171618254486, -0.03806023374435662, -0.19134171618254486},
+     {0.00771293416656621, 0.03877553853574491, 0.1949377962091981},
+     {-0.1949377962091981, 0.03877553853574491, -0.00771293416656621}},
+    // 209
+    {{0.041884776182261996, 0.11740580471599586, 0.1757102039083385},
+     {-0.19491668682543273, 0.03507242023757352, -0.02343464198287512},
+     {0.15821019476500758, -0.1160289536004036, -0.17364960059441073}},
+    // 210
+    {{-0.1757102039083385, 0.11740580471599586, -0.041884776182261996},
+     {0.17364960059441073, -0.1160289536004036, -0.15821019476500758},
+     {0.02343464198287512, 0.03507242023757352, 0.19491668682543273}},
+    // 211
+    {{-0.17429656935108354, 0.1200964324535065, 0.17429656935108354},
+     {-0.023469318250678578, -0.03891032027031305, -0.2113449640764196},
+     {0.2113449640764196, -0.03891032027031305, 0.023469318250678578}},
+    // 212
+    {{0.19134171618254486, 0.19134171618254486, 0.03806023374435662},
+     {-0.1949377962091981, 0.00771293416656621, -0.03877553853574491},
+     {0.00771293416656621, -0.1949377962091981, -0.03877553853574491}},
+    // 213
+    {{-0.1757102039083385, 0.041884776182261996, -0.11740580471599586},
+     {0.02343464198287512, -0.19491668682543273, -0.03507242023757352},
+     {0.17364960059441073, 0.15821019476500758, 0.1160289536004036}},
+    // 214
+    {{0.041884776182261996, -0.1757102039083385, -0.11740580471599586},
+     {0.15821019476500758, 0.17364960059441073, 0.1160289536004036},
+     {-0.19491668682543273, 0.02343464198287512, -0.03507242023757352}},
+    // 215
+    {{-0.17429656935108354, -0.17429656935108354, -0.1200964324535065},
+     {0.2113449640764196, -0.023469318250678578, 0.03891032027031305},
+     {-0.023469318250678578, 0.2113449640764196, 0.03891032027031305}},
+    // 216
+    {{-0.03806023374435662, 0.19134171618254486, -0.19134171618254486},
+     {0.03877553853574491, -0.1949377962091981, -0.00771293416656621},
+     {0.03877553853574491, 0.00771293416656621, 0.1949377962091981}},
+    // 217
+    {{0.11740580471599586, -0.1757102039083385, -0.041884776182261996},
+     {0.03507242023757352, 0.02343464198287512, 0.19491668682543273},
+     {-0.1160289536004036, 0.17364960059441073, -0.15821019476500758}},
+    // 218
+    {{0.11740580471599586, 0.041884776182261996, 0.1757102039083385},
+     {-0.1160289536004036, 0.15821019476500758, -0.17364960059441073},
+     {0.03507242023757352, -0.19491668682543273, -0.02343464198287512}},
+    // 219
+    {{0.1200964324535065, -0.17429656935108354, 0.17429656935108354},
+     {-0.03891032027031305, 0.2113449640764196, 0.023469318250678578},
+     {-0.03891032027031305, -0.023469318250678578, -0.2113449640764196}},
+    // 220
+    {{-0.04465819873852049, 0.28867513459481303, 0.04465819873852049},
+     {-0.11101914389424891, -0.13516383806441662, -0.20112836927052666},
+     {0.20112836927052666, -0.13516383806441662, 0.11101914389424891}},
+    // 221
+    {{-0.04465819873852049, -0.04465819873852049, -0.28867513459481303},
+     {0.20112836927052666, -0.11101914389424891, 0.13516383806441662},
+     {-0.11101914389424891, 0.20112836927052666, 0.13516383806441662}},
+    // 222
+    {{0.28867513459481303, -0.04465819873852049, 0.04465819873852049},
+     {-0.13516383806441662, 0.20112836927052666, 0.11101914389424891},
+     {-0.13516383806441662, -0.11101914389424891, -0.20112836927052666}},
+    // 223
+    {{0.1363636363636363, -0.22727272727272718, -0.1363636363636363},
+     {0.1363636363636363, 0.1363636363636363, 0.22727272727272718},
+     {-0.22727272727272718, 0.1363636363636363, -0.1363636363636363}},
+    // 224
+    {{-0.03806023374435662, -0.19134171618254486, -0.19134171618254486},
+     {0.03877553853574491, -0.00771293416656621, 0.1949377962091981},
+     {0.03877553853574491, 0.1949377962091981, -0.00771293416656621}},
+    // 225
+    {{0.11740580471599586, -0.041884776182261996, 0.1757102039083385},
+     {0.03507242023757352, 0.19491668682543273, -0.02343464198287512},
+     {-0.1160289536004036, -0.15821019476500758, -0.17364960059441073}},
+    // 226
+    {{0.11740580471599586, 0.1757102039083385, -0.041884776182261996},
+     {-0.1160289536004036, -0.17364960059441073, -0.15821019476500758},
+     {0.03507242023757352, -0.02343464198287512, 0.19491668682543273}},
+    // 227
+    {{0.1200964324535065, 0.17429656935108354, 0.17429656935108354},
+     {-0.03891032027031305, 0.023469318250678578, -0.2113449640764196},
+     {-0.03891032027031305, -0.2113449640764196, 0.023469318250678578}},
+    // 228
+    {{0.19134171618254486, -0.19134171618254486, 0.03806023374435662},
+     {0.00771293416656621, 0.1949377962091981, -0.03877553853574491},
+     {-0.1949377962091981, -0.00771293416656621, -0.03877553853574491}},
+    // 229
+    {{0.041884776182261996, 0.1757102039083385, -0.11740580471599586},
+     {-0.19491668682543273, -0.02343464198287512, -0.03507242023757352},
+     {0.15821019476500758, -0.17364960059441073, 0.1160289536004036}},
+    // 230
+    {{-0.1757102039083385, -0.041884776182261996, -0.11740580471599586},
+     {0.17364960059441073, -0.15821019476500758, 0.1160289536004036},
+     {0.02343464198287512, 0.19491668682543273, -0.03507242023757352}},
+    // 231
+    {{-0.17429656935108354, 0.17429656935108354, -0.1200964324535065},
+     {-0.023469318250678578, -0.2113449640764196, 0.03891032027031305},
+     {0.2113449640764196, 0.023469318250678578, 0.03891032027031305}},
+    // 232
+    {{0.19134171618254486, 0.03806023374435662, -0.19134171618254486},
+     {-0.1949377962091981, -0.03877553853574491, -0.00771293416656621},
+     {0.00771293416656621, -0.03877553853574491, 0.1949377962091981}},
+    // 233
+    {{-0.1757102039083385, -0.11740580471599586, -0.041884776182261996},
+     {0.02343464198287512, -0.03507242023757352, 0.19491668682543273},
+     {0.17364960059441073, 0.1160289536004036, -0.15821019476500758}},
+    // 234
+    {{0.041884776182261996, -0.11740580471599586, 0.1757102039083385},
+     {0.15821019476500758, 0.1160289536004036, -0.17364960059441073},
+     {-0.19491668682543273, -0.03507242023757352, -0.02343464198287512}},
+    // 235
+    {{-0.17429656935108354, -0.1200964324535065, 0.17429656935108354},
+     {0.2113449640764196, 0.03891032027031305, 0.023469318250678578},
+     {-0.023469318250678578, 0.03891032027031305, -0.2113449640764196}},
+    // 236
+    {{0.28867513459481303, 0.04465819873852049, 0.04465819873852049},
+     {-0.13516383806441662, 0.11101914389424891, -0.20112836927052666},
+     {-0.13516383806441662, -0.20112836927052666, 0.11101914389424891}},
+    // 237
+    {{-0.04465819873852049, 0.04465819873852049, -0.28867513459481303},
+     {-0.11101914389424891, -0.20112836927052666, 0.13516383806441662},
+     {0.20112836927052666, 0.11101914389424891, 0.13516383806441662}},
+    // 238
+    {{-0.04465819873852049, -0.28867513459481303, 0.04465819873852049},
+     {0.20112836927052666, 0.13516383806441662, 0.11101914389424891},
+     {-0.11101914389424891, 0.13516383806441662, -0.20112836927052666}},
+    // 239
+    {{-0.22727272727272718, -0.1363636363636363, -0.1363636363636363},
+     {0.1363636363636363, -0.1363636363636363, 0.22727272727272718},
+     {0.1363636363636363, 0.22727272727272718, -0.1363636363636363}},
+    // 240
+    {{-0.19134171618254486, 0.03806023374435662, -0.19134171618254486},
+     {-0.00771293416656621, -0.03877553853574491, 0.1949377962091981},
+     {0.1949377962091981, -0.03877553853574491, -0.00771293416656621}},
+    // 241
+    {{-0.041884776182261996, -0.11740580471599586, 0.1757102039083385},
+     {0.19491668682543273, -0.03507242023757352, -0.02343464198287512},
+     {-0.15821019476500758, 0.1160289536004036, -0.17364960059441073}},
+    // 242
+    {{0.1757102039083385, -0.11740580471599586, -0.041884776182261996},
+     {-0.17364960059441073, 0.1160289536004036, -0.15821019476500758},
+     {-0.02343464198287512, -0.03507242023757352, 0.19491668682543273}},
+    // 243
+    {{0.17429656935108354, -0.1200964324535065, 0.17429656935108354},
+     {0.023469318250678578, 0.03891032027031305, -0.2113449640764196},
+     {-0.2113449640764196, 0.03891032027031305, 0.023469318250678578}},
+    // 244
+    {{-0.19134171618254486, -0.19134171618254486, 0.03806023374435662},
+     {0.1949377962091981, -0.00771293416656621, -0.03877553853574491},
+     {-0.00771293416656621, 0.1949377962091981, -0.03877553853574491}},
+    // 245
+    {{0.1757102039083385, -0.041884776182261996, -0.11740580471599586},
+     {-0.02343464198287512, 0.19491668682543273, -0.03507242023757352},
+     {-0.17364960059441073, -0.15821019476500758, 0.1160289536004036}},
+    // 246
+    {{-0.041884776182261996, 0.1757102039083385, -0.11740580471599586},
+     {-0.15821019476500758, -0.17364960059441073, 0.1160289536004036},
+     {0.19491668682543273, -0.02343464198287512, -0.03507242023757352}},
+    // 247
+    {{0.17429656935108354, 0.17429656935108354, -0.1200964324535065},
+     {-0.2113449640764196, 0.023469318250678578, 0.03891032027031305},
+     {0.023469318250678578, -0.2113449640764196, 0.03891032027031305}},
+    // 248
+    {{0.03806023374435662, -0.19134171618254486, -0.19134171618254486},
+     {-0.03877553853574491, 0.1949377962091981, -0.00771293416656621},
+     {-0.03877553853574491, -0.00771293416656621, 0.1949377962091981}},
+    // 249
+    {{-0.11740580471599586, 0.1757102039083385, -0.041884776182261996},
+     {-0.03507242023757352, -0.02343464198287512, 0.19491668682543273},
+     {0.1160289536004036, -0.17364960059441073, -0.15821019476500758}},
+    // 250
+    {{-0.11740580471599586, -0.041884776182261996, 0.1757102039083385},
+     {0.1160289536004036, -0.15821019476500758, -0.17364960059441073},
+     {-0.03507242023757352, 0.19491668682543273, -0.02343464198287512}},
+    // 251
+    {{-0.1200964324535065, 0.17429656935108354, 0.17429656935108354},
+     {0.03891032027031305, -0.2113449640764196, 0.023469318250678578},
+     {0.03891032027031305, 0.023469318250678578, -0.2113449640764196}},
+    // 252
+    {{0.04465819873852049, -0.28867513459481303, 0.04465819873852049},
+     {0.11101914389424891, 0.13516383806441662, -0.20112836927052666},
+     {-0.20112836927052666, 0.13516383806441662, 0.11101914389424891}},
+    // 253
+    {{0.04465819873852049, 0.04465819873852049, -0.28867513459481303},
+     {-0.20112836927052666, 0.11101914389424891, 0.13516383806441662},
+     {0.11101914389424891, -0.20112836927052666, 0.13516383806441662}},
+    // 254
+    {{-0.28867513459481303, 0.04465819873852049, 0.04465819873852049},
+     {0.13516383806441662, -0.20112836927052666, 0.11101914389424891},
+     {0.13516383806441662, 0.11101914389424891, -0.20112836927052666}},
+    // 255
+    {{-0.1363636363636363, 0.22727272727272718, -0.1363636363636363},
+     {-0.1363636363636363, -0.1363636363636363, 0.22727272727272718},
+     {0.22727272727272718, -0.1363636363636363, -0.1363636363636363}},
+};
+
+// `HTM_ROOT_ADJACENCY[r][j]` holds the root triangle (0-7) on the
+// other side of edge j of root triangle r, and the index of that
+// edge in the neighbor.
+constexpr uint8_t HTM_ROOT_ADJACENCY[8][3][2] = {
+    {{1, 2}, {7, 1}, {3, 0}},
+    {{2, 2}, {6, 1}, {0, 0}},
+    {{3, 2}, {5, 1}, {1, 0}},
+    {{0, 2}, {4, 1}, {2, 0}},
+    {{5, 2}, {3, 1}, {7, 0}},
+    {{6, 2}, {2, 1}, {4, 0}},
+    {{7, 2}, {1, 1}, {5, 0}},
+    {{4, 2}, {0, 1}, {6, 0}}
+};
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_HTMTABLES_H_
@@ -0,0 +1,650 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the HybridRangeSet implementation.
+
+#include "lsst/sphgeom/HybridRangeSet.h"
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+constexpr int BLOCK_BITS = 16;
+constexpr uint32_t BLOCK_SIZE = static_cast<uint32_t>(1) << BLOCK_BITS;
+constexpr uint64_t OFFSET_MASK = BLOCK_SIZE - 1;
+constexpr size_t NUM_WORDS = BLOCK_SIZE / 64;
+// Array containers hold at most this many integers.
+constexpr uint32_t MAX_ARRAY_SIZE = 4096;
+
+// The result of a block level operation.
+enum class Status { EMPTY, PARTIAL, FULL };
+
+// A `Run` is an inclusive range of offsets within a block.
+using Run = std::pair<uint32_t, uint32_t>;
+
+// `wordsToRuns` stores the runs of set bits in a bitmap in runs.
+void wordsToRuns(uint64_t const * words, std::vector<Run> & runs) {
+    runs.clear();
+    bool inRun = false;
+    uint32_t first = 0;
+    for (size_t i = 0; i < NUM_WORDS; ++i) {
+        uint64_t w = words[i];
+        uint32_t base = static_cast<uint32_t>(i * 64);
+        // Find bit transitions within the word, treating the bit before it
+        // as the current run state.
+        while (true) {
+            if (!inRun) {
+                if (w == 0) {
+                    break;
+                }
+                int b = __builtin_ctzll(w);
+                first = base + b;
+                inRun = true;
+                // Set all bits below b, so that the next search finds the
+                // first 0 bit at or above b.
+                w |= (static_cast<uint64_t>(1) << b) - 1;
+            }
+            uint64_t z = ~w;
+            if (z == 0) {
+                break;
+            }
+            int b = __builtin_ctzll(z);
+            runs.emplace_back(first, base + b - 1);
+            inRun = false;
+            // Clear all bits below b.
+            w &= ~((static_cast<uint64_t>(1) << b) - 1);
+        }
+    }
+    if (inRun) {
+        runs.emplace_back(first, BLOCK_SIZE - 1);
+    }
+}
+
+// `valuesToRuns` stores the runs of consecutive values in a sorted array
+// of distinct offsets in runs.
+void valuesToRuns(uint16_t const * values, size_t n, std::vector<Run> & runs) {
+    runs.clear();
+    for (size_t i = 0; i < n; ++i) {
+        uint32_t v = values[i];
+        if (!runs.empty() && runs.back().second + 1 == v) {
+            runs.back().second = v;
+        } else {
+            runs.emplace_back(v, v);
+        }
+    }
+}
+
+} // unnamed namespace
+
+// The block level helpers below need access to HybridRangeSet::Block, so
+// they are implemented as members of a private helper struct.
+struct HybridRangeSetImpl {
+    using Block = HybridRangeSet::Block;
+
+    // `finish` stores the integers in the given sorted, disjoint and
+    // non-adjacent runs in a block with the given key, using the smallest
+    // container for them. Empty and full blocks are not materialized.
+    static Status finish(uint64_t key, std::vector<Run> const & runs,
+                         Block & block)
+    {
+        uint32_t cardinality = 0;
+        for (Run const & r: runs) {
+            cardinality += r.second - r.first + 1;
+        }
+        if (cardinality == 0) {
+            return Status::EMPTY;
+        } else if (cardinality == BLOCK_SIZE) {
+            return Status::FULL;
+        }
+        block.key = key;
+        block.cardinality = cardinality;
+        block.values.clear();
+        block.bits.clear();
+        size_t const runBytes = 4 * runs.size();
+        size_t const arrayBytes = 2 * static_cast<size_t>(cardinality);
+        size_t const bitmapBytes = 8 * NUM_WORDS;
+        if (runBytes < bitmapBytes &&
+            (cardinality > MAX_ARRAY_SIZE || runBytes < arrayBytes)) {
+            block.kind = Block::RUNS;
+            block.values.reserve(2 * runs.size());
+            for (Run const & r: runs) {
+                block.values.push_back(static_cast<uint16_t>(r.first));
+                block.values.push_back(static_cast<uint16_t>(r.second));
+            }
+        } else if (cardinality <= MAX_ARRAY_SIZE) {
+            block.kind = Block::ARRAY;
+            block.values.reserve(cardinality);
+            for (Run const & r: runs) {
+                for (uint32_t v = r.first; v <= r.second; ++v) {
+                    block.values.push_back(static_cast<uint16_t>(v));
+                }
+            }
+        } else {
+            block.kind = Block::BITMAP;
+            block.bits.assign(NUM_WORDS, 0);
+            for (Run const & r: runs) {
+                for (uint32_t v = r.first; v <= r.second; ++v) {
+                    block.bits[v >> 6] |= static_cast<uint64_t>(1) << (v & 63);
+                }
+            }
+        }
+        return Status::PARTIAL;
+    }
+
+    // `toRuns` stores the runs of integers in a block in runs.
+    static void toRuns(Block const & block, std::vector<Run> & runs) {
+        switch (block.kind) {
+            case Block::ARRAY:
+                valuesToRuns(block.values.data(), block.values.size(), runs);
+                break;
+            case Block::RUNS:
+                runs.clear();
+                for (size_t i = 0; i < block.values.size(); i += 2) {
+                    runs.emplace_back(block.values[i], block.values[i + 1]);
+                }
+                break;
+            case Block::BITMAP:
+                wordsToRuns(block.bits.data(), runs);
+                break;
+        }
+    }
+
+    // `toWords` stores the integers in a block as a bitmap in words.
+    static void toWords(Block const & block, uint64_t * words) {
+        if (block.kind == Block::BITMAP) {
+            std::copy(block.bits.begin(), block.bits.end(), words);
+            return;
+        }
+        std::fill(words, words + NUM_WORDS, 0);
+        if (block.kind == Block::ARRAY) {
+            for (uint32_t v: block.values) {
+                words[v >> 6] |= static_cast<uint64_t>(1) << (v & 63);
+            }
+        } else {
+            for (size_t i = 0; i < block.values.size(); i += 2) {
+                for (uint32_t v = block.values[i]; v <= block.values[i + 1];
+                     ++v) {
+                    words[v >> 6] |= static_cast<uint64_t>(1) << (v & 63);
+                }
+            }
+        }
+    }
+
+    static bool contains(Block const & block, uint32_t v) {
+        switch (block.kind) {
+            case Block::ARRAY:
+                return std::binary_search(block.values.begin(),
+                                          block.values.end(),
+                                          static_cast<uint16_t>(v));
+            case Block::RUNS: {
+                // Find the last run beginning at or before v.
+                size_t lo = 0;
+                size_t hi = block.values.size() / 2;
+                while (lo < hi) {
+                    size_t mid = (lo + hi) / 2;
+                    if (block.values[2 * mid] <= v) {
+                        lo = mid + 1;
+                    } else {
+                        hi = mid;
+                    }
+                }
+                return lo > 0 && v <= block.values[2 * lo - 1];
+            }
+            case Block::BITMAP:
+                return (block.bits[v >> 6] >> (v & 63)) & 1;
+        }
+        return false;
+    }
+
+    enum Op { AND, OR, ANDNOT, XOR };
+
+    // `combine` stores the result of applying op to the integers in blocks
+    // a and b, which must have the same key, in out.
+    static Status combine(Block const & a, Block const & b, Op op,
+                          Block & out)
+    {
+        std::vector<Run> runs;
+        if (a.kind == Block::ARRAY && b.kind == Block::ARRAY) {
+            // Merge sparse blocks directly.
+            std::vector<uint16_t> v;
+            auto ab = a.values.begin(), ae = a.values.end();
+            auto bb = b.values.begin(), be = b.values.end();
+            auto it = std::back_inserter(v);
+            switch (op) {
+                case AND: std::set_intersection(ab, ae, bb, be, it); break;
+                case OR: std::set_union(ab, ae, bb, be, it); break;
+                case ANDNOT: std::set_difference(ab, ae, bb, be, it); break;
+                case XOR:
+                    std::set_symmetric_difference(ab, ae, bb, be, it);
+                    break;
+            }
+            valuesToRuns(v.data(), v.size(), runs);
+        } else {
+            uint64_t wa[NUM_WORDS];
+            uint64_t wb[NUM_WORDS];
+            toWords(a, wa);
+            toWords(b, wb);
+            for (size_t i = 0; i < NUM_WORDS; ++i) {
+                switch (op) {
+                    case AND: wa[i] &= wb[i]; break;
+                    case OR: wa[i] |= wb[i]; break;
+                    case ANDNOT: wa[i] &= ~wb[i]; break;
+                    case XOR: wa[i] ^= wb[i]; break;
+                }
+            }
+            wordsToRuns(wa, runs);
+        }
+        return finish(a.key, runs, out);
+    }
+
+    // `invert` stores the complement of a block (within the block) in out.
+    static Status invert(Block const & a, Block & out) {
+        std::vector<Run> runs;
+        std::vector<Run> inverted;
+        toRuns(a, runs);
+        uint32_t next = 0;
+        for (Run const & r: runs) {
+            if (r.first > next) {
+                inverted.emplace_back(next, r.first - 1);
+            }
+            next = r.second + 1;
+        }
+        if (next < BLOCK_SIZE) {
+            inverted.emplace_back(next, BLOCK_SIZE - 1);
+        }
+        return finish(a.key, inverted, out);
+    }
+
+    static void append(HybridRangeSet & s, RangeSet & full, uint64_t key,
+                       Status status, Block && block)
+    {
+        if (status == Status::PARTIAL) {
+            s._blocks.push_back(std::move(block));
+        } else if (status == Status::FULL) {
+            full.insert(key << BLOCK_BITS, (key + 1) << BLOCK_BITS);
+        }
+    }
+
+    static bool isFull(RangeSet const & full, uint64_t key) {
+        // Ranges in full are block-aligned, so a block is inside one
+        // iff its first integer is.
+        return full.contains(key << BLOCK_BITS);
+    }
+};
+
+namespace {
+
+using Impl = HybridRangeSetImpl;
+
+} // unnamed namespace
+
+HybridRangeSet::HybridRangeSet(RangeSet const & s) {
+    std::vector<Run> runs;
+    uint64_t key = 0;
+    auto flush = [&]() {
+        if (!runs.empty()) {
+            Block block;
+            Status status = Impl::finish(key, runs, block);
+            Impl::append(*this, _full, key, status, std::move(block));
+            runs.clear();
+        }
+    };
+    auto addRun = [&](uint64_t k, uint32_t first, uint32_t last) {
+        if (k != key) {
+            flush();
+            key = k;
+        }
+        runs.emplace_back(first, last);
+    };
+    for (auto r: s) {
+        uint64_t first = std::get<0>(r);
+        // The last integer in the range. An end point of 0 denotes 2^64.
+        uint64_t last = std::get<1>(r) - 1;
+        uint64_t kf = first >> BLOCK_BITS;
+        uint64_t kl = last >> BLOCK_BITS;
+        uint32_t of = static_cast<uint32_t>(first & OFFSET_MASK);
+        uint32_t ol = static_cast<uint32_t>(last & OFFSET_MASK);
+        if (kf == kl && (of != 0 || ol != OFFSET_MASK)) {
+            addRun(kf, of, ol);
+            continue;
+        }
+        // Split the range into a partial head block, whole blocks and
+        // a partial tail block.
+        uint64_t wf = kf;
+        uint64_t wl = kl;
+        if (of != 0) {
+            addRun(kf, of, static_cast<uint32_t>(OFFSET_MASK));
+            ++wf;
+        }
+        bool tail = (ol != OFFSET_MASK);
+        if (tail) {
+            --wl;
+        }
+        if (wf <= wl) {
+            _full.insert(wf << BLOCK_BITS, (wl + 1) << BLOCK_BITS);
+        }
+        if (tail) {
+            addRun(kl, 0, ol);
+        }
+    }
+    flush();
+}
+
+bool HybridRangeSet::operator==(HybridRangeSet const & s) const {
+    return _full == s._full && _blocks == s._blocks;
+}
+
+RangeSet HybridRangeSet::toRangeSet() const {
+    // Full and partial blocks never overlap, so their ranges can be
+    // appended to the result in ascending order.
+    RangeSet result;
+    RangeSet::Iterator f = _full.begin();
+    RangeSet::Iterator fend = _full.end();
+    std::vector<Run> runs;
+    for (Block const & block: _blocks) {
+        uint64_t base = block.key << BLOCK_BITS;
+        for (; f != fend && std::get<0>(*f) < base; ++f) {
+            result.insert(std::get<0>(*f), std::get<1>(*f));
+        }
+        Impl::toRuns(block, runs);
+        for (Run const & r: runs) {
+            result.insert(base + r.first, base + r.second + 1);
+        }
+    }
+    for (; f != fend; ++f) {
+        result.insert(std::get<0>(*f), std::get<1>(*f));
+    }
+    return result;
+}
+
+uint64_t HybridRangeSet::cardinality() const {
+    uint64_t n = _full.cardinality();
+    for (Block const & block: _blocks) {
+        n += block.cardinality;
+    }
+    return n;
+}
+
+bool HybridRangeSet::contains(uint64_t u) const {
+    if (_full.contains(u)) {
+        return true;
+    }
+    uint64_t key = u >> BLOCK_BITS;
+    auto b = std::lower_bound(
+        _blocks.begin(), _blocks.end(), key,
+        [](Block const & block, uint64_t k) { return block.key < k; });
+    return b != _blocks.end() && b->key == key &&
+           Impl::contains(*b, static_cast<uint32_t>(u & OFFSET_MASK));
+}
+
+size_t HybridRangeSet::memoryUsage() const {
+    size_t n = sizeof(HybridRangeSet) + 16 * (_full.size() + 1) +
+               sizeof(Block) * _blocks.capacity();
+    for (Block const & block: _blocks) {
+        n += 2 * block.values.capacity() + 8 * block.bits.capacity();
+    }
+    return n;
+}
+
+RangeSet HybridRangeSet::_blockRanges() const {
+    RangeSet s;
+    for (Block const & block: _blocks) {
+        s.insert(block.key << BLOCK_BITS, (block.key + 1) << BLOCK_BITS);
+    }
+    return s;
+}
+
+HybridRangeSet & HybridRangeSet::complement() {
+    _full = ~(_full | _blockRanges());
+    for (Block & block: _blocks) {
+        Block inverted;
+        Impl::invert(block, inverted);
+        block = std::move(inverted);
+    }
+    return *this;
+}
+
+HybridRangeSet HybridRangeSet::intersection(HybridRangeSet const & s) const {
+    HybridRangeSet r;
+    r._full = _full & s._full;
+    auto a = _blocks.begin(), aend = _blocks.end();
+    auto b = s._blocks.begin(), bend = s._blocks.end();
+    while (a != aend || b != bend) {
+        if (b == bend || (a != aend && a->key < b->key)) {
+            if (Impl::isFull(s._full, a->key)) {
+                r._blocks.push_back(*a);
+            }
+            ++a;
+        } else if (a == aend || b->key < a->key) {
+            if (Impl::isFull(_full, b->key)) {
+                r._blocks.push_back(*b);
+            }
+            ++b;
+        } else {
+            Block block;
+            Status status = Impl::combine(*a, *b, Impl::AND, block);
+            Impl::append(r, r._full, a->key, status, std::move(block));
+            ++a;
+            ++b;
+        }
+    }
+    return r;
+}
+
+HybridRangeSet HybridRangeSet::join(HybridRangeSet const & s) const {
+    HybridRangeSet r;
+    r._full = _full | s._full;
+    RangeSet filled;
+    auto a = _blocks.begin(), aend = _blocks.end();
+    auto b = s._blocks.begin(), bend = s._blocks.end();
+    while (a != aend || b != bend) {
+        if (b == bend || (a != aend && a->key < b->key)) {
+            if (!Impl::isFull(s._full, a->key)) {
+                r._blocks.push_back(*a);
+            }
+            ++a;
+        } else if (a == aend || b->key < a->key) {
+            if (!Impl::isFull(_full, b->key)) {
+                r._blocks.push_back(*b);
+            }
+            ++b;
+        } else {
+            Block block;
+            Status status = Impl::combine(*a, *b, Impl::OR, block);
+            Impl::append(r, filled, a->key, status, std::move(block));
+            ++a;
+            ++b;
+        }
+    }
+    if (!filled.empty()) {
+        r._full |= filled;
+    }
+    return r;
+}
+
+HybridRangeSet HybridRangeSet::difference(HybridRangeSet const & s) const {
+    HybridRangeSet r;
+    // Blocks of s that are partially contained in s and entirely contained
+    // in this set become partial blocks of the result.
+    r._full = _full - s._full - s._blockRanges();
+    auto a = _blocks.begin(), aend = _blocks.end();
+    auto b = s._blocks.begin(), bend = s._blocks.end();
+    while (a != aend || b != bend) {
+        if (b == bend || (a != aend && a->key < b->key)) {
+            if (!Impl::isFull(s._full, a->key)) {
+                r._blocks.push_back(*a);
+            }
+            ++a;
+        } else if (a == aend || b->key < a->key) {
+            if (Impl::isFull(_full, b->key)) {
+                Block block;
+                Status status = Impl::invert(*b, block);
+                Impl::append(r, r._full, b->key, status, std::move(block));
+            }
+            ++b;
+        } else {
+            Block block;
+            Status status = Impl::combine(*a, *b, Impl::ANDNOT, block);
+            Impl::append(r, r._full, a->key, status, std::move(block));
+            ++a;
+            ++b;
+        }
+    }
+    return r;
+}
+
+HybridRangeSet HybridRangeSet::symmetricDifference(
+    HybridRangeSet const & s) const
+{
+    HybridRangeSet r;
+    r._full = (_full ^ s._full) - _blockRanges() - s._blockRanges();
+    RangeSet filled;
+    auto a = _blocks.begin(), aend = _blocks.end();
+    auto b = s._blocks.begin(), bend = s._blocks.end();
+    while (a != aend || b != bend) {
+        Block block;
+        Status status;
+        uint64_t key;
+        if (b == bend || (a != aend && a->key < b->key)) {
+            key = a->key;
+            if (Impl::isFull(s._full, key)) {
+                status = Impl::invert(*a, block);
+            } else {
+                status = Status::PARTIAL;
+                block = *a;
+            }
+            ++a;
+        } else if (a == aend || b->key < a->key) {
+            key = b->key;
+            if (Impl::isFull(_full, key)) {
+                status = Impl::invert(*b, block);
+            } else {
+                status = Status::PARTIAL;
+                block = *b;
+            }
+            ++b;
+        } else {
+            key = a->key;
+            status = Impl::combine(*a, *b, Impl::XOR, block);
+            ++a;
+            ++b;
+        }
+        Impl::append(r, filled, key, status, std::move(block));
+    }
+    if (!filled.empty()) {
+        r._full |= filled;
+    }
+    return r;
+}
+
+HybridRangeSet & HybridRangeSet::simplify(uint32_t n) {
+    if (empty() || n == 0) {
+        return *this;
+    }
+    if (n >= BLOCK_BITS) {
+        // Coarsening any non-empty subset of a block yields the ranges
+        // obtained by coarsening the whole block.
+        _full |= _blockRanges();
+        _full.simplify(n);
+        _blocks.clear();
+        return *this;
+    }
+    // Blocks are aligned to multiples of 2^n, so coarsened ranges never
+    // cross block boundaries, but blocks may fill up.
+    uint32_t const m = (static_cast<uint32_t>(1) << n) - 1;
+    std::vector<Block> blocks;
+    blocks.swap(_blocks);
+    RangeSet filled;
+    std::vector<Run> runs;
+    std::vector<Run> coarse;
+    for (Block & block: blocks) {
+        Impl::toRuns(block, runs);
+        coarse.clear();
+        for (Run const & r: runs) {
+            uint32_t first = r.first & ~m;
+            uint32_t last = r.second | m;
+            if (!coarse.empty() && coarse.back().second + 1 >= first) {
+                coarse.back().second = last;
+            } else {
+                coarse.emplace_back(first, last);
+            }
+        }
+        Block simplified;
+        Status status = Impl::finish(block.key, coarse, simplified);
+        Impl::append(*this, filled, block.key, status, std::move(simplified));
+    }
+    if (!filled.empty()) {
+        _full |= filled;
+    }
+    return *this;
+}
+
+bool HybridRangeSet::isValid() const {
+    if (!_full.isValid()) {
+        return false;
+    }
+    for (auto r: _full) {
+        if ((std::get<0>(r) & OFFSET_MASK) != 0 ||
+            (std::get<1>(r) & OFFSET_MASK) != 0) {
+            return false;
+        }
+    }
+    std::vector<Run> runs;
+    for (size_t i = 0; i < _blocks.size(); ++i) {
+        Block const & block = _blocks[i];
+        if ((i > 0 && _blocks[i - 1].key >= block.key) ||
+            block.key > (~static_cast<uint64_t>(0) >> BLOCK_BITS) ||
+            Impl::isFull(_full, block.key)) {
+            return false;
+        }
+        if (block.kind == Block::ARRAY &&
+            !std::is_sorted(block.values.begin(), block.values.end())) {
+            return false;
+        }
+        if (block.kind == Block::BITMAP && block.bits.size() != NUM_WORDS) {
+            return false;
+        }
+        // The block must be non-empty, non-full, and stored canonically.
+        Impl::toRuns(block, runs);
+        for (size_t j = 1; j < runs.size(); ++j) {
+            if (runs[j].first <= runs[j - 1].second + 1) {
+                return false;
+            }
+        }
+        Block canonical;
+        if (Impl::finish(block.key, runs, canonical) != Status::PARTIAL ||
+            !(canonical == block)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}} // namespace lsst::sphgeom
@@ -27,11 +27,116 @@
 
 #include <cstdio>
 #include <ostream>
+#if !defined(NO_SIMD) && defined(__x86_64__)
+    #include <x86intrin.h>
+#endif
+
+#include "CpuDispatch.h"
+
+// The wide (AVX2) batch product kernel is compiled with a function level
+// target attribute and selected at run time, so that a baseline x86-64 build
+// still runs on CPUs without AVX2.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define LSST_SPHGEOM_MATRIX3D_AVX2 1
+#endif
 
 
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+// Matrix3d::operator* computes (c0 * x + c1 * y) + c2 * z, where ci is the
+// i-th matrix column. The kernels below evaluate the same expression.
+
+void applyScalar(Matrix3d const & m,
+                 double const * x,
+                 double const * y,
+                 double const * z,
+                 double * ox,
+                 double * oy,
+                 double * oz,
+                 size_t n)
+{
+    Vector3d const & c0 = m.getColumn(0);
+    Vector3d const & c1 = m.getColumn(1);
+    Vector3d const & c2 = m.getColumn(2);
+    for (size_t i = 0; i < n; ++i) {
+        double vx = x[i];
+        double vy = y[i];
+        double vz = z[i];
+        ox[i] = (c0.x() * vx + c1.x() * vy) + c2.x() * vz;
+        oy[i] = (c0.y() * vx + c1.y() * vy) + c2.y() * vz;
+        oz[i] = (c0.z() * vx + c1.z() * vy) + c2.z() * vz;
+    }
+}
+
+#if defined(LSST_SPHGEOM_MATRIX3D_AVX2)
+
+    // `applyAvx2` transforms vectors 4 at a time, for i in [0, n & ~3), and
+    // returns the number of vectors transformed.
+    __attribute__((target("avx2")))
+    size_t applyAvx2(Matrix3d const & m,
+                     double const * x,
+                     double const * y,
+                     double const * z,
+                     double * ox,
+                     double * oy,
+                     double * oz,
+                     size_t n)
+    {
+        __m256d m00 = _mm256_set1_pd(m(0, 0));
+        __m256d m01 = _mm256_set1_pd(m(0, 1));
+        __m256d m02 = _mm256_set1_pd(m(0, 2));
+        __m256d m10 = _mm256_set1_pd(m(1, 0));
+        __m256d m11 = _mm256_set1_pd(m(1, 1));
+        __m256d m12 = _mm256_set1_pd(m(1, 2));
+        __m256d m20 = _mm256_set1_pd(m(2, 0));
+        __m256d m21 = _mm256_set1_pd(m(2, 1));
+        __m256d m22 = _mm256_set1_pd(m(2, 2));
+        size_t const e = n & ~static_cast<size_t>(3);
+        for (size_t i = 0; i < e; i += 4) {
+            __m256d vx = _mm256_loadu_pd(x + i);
+            __m256d vy = _mm256_loadu_pd(y + i);
+            __m256d vz = _mm256_loadu_pd(z + i);
+            __m256d rx = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(m00, vx), _mm256_mul_pd(m01, vy)),
+                _mm256_mul_pd(m02, vz));
+            __m256d ry = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(m10, vx), _mm256_mul_pd(m11, vy)),
+                _mm256_mul_pd(m12, vz));
+            __m256d rz = _mm256_add_pd(
+                _mm256_add_pd(_mm256_mul_pd(m20, vx), _mm256_mul_pd(m21, vy)),
+                _mm256_mul_pd(m22, vz));
+            _mm256_storeu_pd(ox + i, rx);
+            _mm256_storeu_pd(oy + i, ry);
+            _mm256_storeu_pd(oz + i, rz);
+        }
+        return e;
+    }
+
+#endif
+
+} // unnamed namespace
+
+void Matrix3d::apply(double const * x,
+                     double const * y,
+                     double const * z,
+                     double * ox,
+                     double * oy,
+                     double * oz,
+                     size_t n) const
+{
+    size_t i = 0;
+#if defined(LSST_SPHGEOM_MATRIX3D_AVX2)
+    if (detail::hasAvx2()) {
+        i = applyAvx2(*this, x, y, z, ox, oy, oz, n);
+    }
+#endif
+    applyScalar(*this, x + i, y + i, z + i, ox + i, oy + i, oz + i, n - i);
+}
+
 std::ostream & operator<<(std::ostream & os, Matrix3d const & m) {
     return os << '[' << m.getRow(0) << ", " << m.getRow(1) << ", " << m.getRow(2) << ']';
 }
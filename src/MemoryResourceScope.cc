@@ -0,0 +1,50 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the MemoryResourceScope implementation.
+
+#include "lsst/sphgeom/MemoryResourceScope.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+thread_local std::pmr::memory_resource * scoped = nullptr;
+
+} // unnamed namespace
+
+MemoryResourceScope::MemoryResourceScope(std::pmr::memory_resource & resource) :
+    _previous{scoped}
+{
+    scoped = &resource;
+}
+
+MemoryResourceScope::~MemoryResourceScope() { scoped = _previous; }
+
+std::pmr::memory_resource * MemoryResourceScope::current() {
+    return scoped != nullptr ? scoped : std::pmr::get_default_resource();
+}
+
+}} // namespace lsst::sphgeom
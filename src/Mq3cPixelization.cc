@@ -25,12 +25,15 @@
 
 #include "lsst/sphgeom/Mq3cPixelization.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/curve.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 
+#include "PerformanceCounting.h"
+#include "PixelCache.h"
 #include "PixelFinder.h"
 #include "Q3cPixelizationImpl.h"
 
@@ -128,6 +131,10 @@ int findNeighborhood(int level, uint64_t i, uint64_t * dst) {
     return static_cast<int>(std::unique(dst, dst + 9) - dst);
 }
 
+// `makeQuad` computes the vertices of the modified-Q3C pixel with the given
+// index and subdivision level, and `makeChildQuads` computes those of its 4
+// children, in index order. The vertices of a pixel are identical in both
+// cases.
 #if defined(NO_SIMD) || !defined(__x86_64__)
     void makeQuad(uint64_t i, int level, UnitVector3d * verts) {
         int const face = static_cast<int>(i >> (2 * level)) - 10;
@@ -155,6 +162,38 @@ int findNeighborhood(int level, uint64_t i, uint64_t * dst) {
             std::swap(verts[1], verts[3]);
         }
     }
+
+    void makeChildQuads(uint64_t i, int level, UnitVector3d (*verts)[4]) {
+        int const l = level + 1;
+        int const face = static_cast<int>(i >> (2 * level)) - 10;
+        double const faceScale = FACE_SCALE[l];
+        uint32_t s[4], t[4];
+        childGridCoordinates(i << 2, l, true, s, t);
+        // Dilated lower and upper face coordinates of the children in
+        // grid column (row) a of the 2 x 2 block of children.
+        double ulo[2], uhi[2], vlo[2], vhi[2];
+        for (int a = 0; a < 2; ++a) {
+            double u, v;
+            std::tie(u, v) = gridToFace(
+                l, static_cast<int32_t>((s[0] & ~1u) + a),
+                static_cast<int32_t>((t[0] & ~1u) + a));
+            std::tie(uhi[a], vhi[a]) = atanApproxInverse(
+                (u + faceScale) + DILATION, (v + faceScale) + DILATION);
+            std::tie(ulo[a], vlo[a]) = atanApproxInverse(
+                u - DILATION, v - DILATION);
+        }
+        for (int k = 0; k < 4; ++k) {
+            int const a = s[k] & 1;
+            int const b = t[k] & 1;
+            verts[k][0] = faceToSphere(face, ulo[a], vlo[b], FACE_COMP, FACE_CONST);
+            verts[k][1] = faceToSphere(face, uhi[a], vlo[b], FACE_COMP, FACE_CONST);
+            verts[k][2] = faceToSphere(face, uhi[a], vhi[b], FACE_COMP, FACE_CONST);
+            verts[k][3] = faceToSphere(face, ulo[a], vhi[b], FACE_COMP, FACE_CONST);
+            if ((face & 1) == 0) {
+                std::swap(verts[k][1], verts[k][3]);
+            }
+        }
+    }
 #else
     void makeQuad(uint64_t i, int level, UnitVector3d * verts) {
         int const face = static_cast<int>(i >> (2 * level)) - 10;
@@ -174,26 +213,92 @@ int findNeighborhood(int level, uint64_t i, uint64_t * dst) {
             std::swap(verts[1], verts[3]);
         }
     }
+
+    void makeChildQuads(uint64_t i, int level, UnitVector3d (*verts)[4]) {
+        int const l = level + 1;
+        int const face = static_cast<int>(i >> (2 * level)) - 10;
+        __m128d faceScale = _mm_set1_pd(FACE_SCALE[l]);
+        __m128d dilation = _mm_set1_pd(DILATION);
+        uint32_t s[4], t[4];
+        childGridCoordinates(i << 2, l, true, s, t);
+        // Dilated lower and upper (u, v) face coordinates of the children
+        // in grid column and row a of the 2 x 2 block of children.
+        __m128d lo[2], hi[2];
+        for (int a = 0; a < 2; ++a) {
+            __m128d uv = gridToFace(l, _mm_set_epi64x((t[0] & ~1u) + a,
+                                                      (s[0] & ~1u) + a));
+            hi[a] = atanApproxInverse(
+                _mm_add_pd(_mm_add_pd(uv, faceScale), dilation));
+            lo[a] = atanApproxInverse(_mm_sub_pd(uv, dilation));
+        }
+        for (int k = 0; k < 4; ++k) {
+            __m128d u0v0 = _mm_shuffle_pd(lo[s[k] & 1], lo[t[k] & 1], 2);
+            __m128d u1v1 = _mm_shuffle_pd(hi[s[k] & 1], hi[t[k] & 1], 2);
+            verts[k][0] = faceToSphere(face, u0v0, FACE_COMP, FACE_CONST);
+            verts[k][1] = faceToSphere(face, _mm_shuffle_pd(u1v1, u0v0, 2),
+                                       FACE_COMP, FACE_CONST);
+            verts[k][2] = faceToSphere(face, u1v1, FACE_COMP, FACE_CONST);
+            verts[k][3] = faceToSphere(face, _mm_shuffle_pd(u0v0, u1v1, 2),
+                                       FACE_COMP, FACE_CONST);
+            if ((face & 1) == 0) {
+                std::swap(verts[k][1], verts[k][3]);
+            }
+        }
+    }
+#endif
+
+
+// `computeIndex` returns the modified-Q3C index of p at the given subdivision
+// level.
+#if defined(NO_SIMD) || !defined(__x86_64__)
+    inline uint64_t computeIndex(UnitVector3d const & p, int level) {
+        int face = faceNumber(p, FACE_NUM);
+        double w = std::fabs(p(FACE_COMP[face][2]));
+        double u = (p(FACE_COMP[face][0]) / w) * FACE_CONST[face][0];
+        double v = (p(FACE_COMP[face][1]) / w) * FACE_CONST[face][1];
+        std::tie(u, v) = atanApprox(u, v);
+        std::tuple<int32_t, int32_t> g = faceToGrid(level, u, v);
+        uint64_t h = hilbertIndex(static_cast<uint32_t>(std::get<0>(g)),
+                                  static_cast<uint32_t>(std::get<1>(g)),
+                                  level);
+        return (static_cast<uint64_t>(face + 10) << (2 * level)) | h;
+    }
+#else
+    inline uint64_t computeIndex(UnitVector3d const & p, int level) {
+        int face = faceNumber(p, FACE_NUM);
+        __m128d ww = _mm_set1_pd(p(FACE_COMP[face][2]));
+        __m128d uv = _mm_set_pd(p(FACE_COMP[face][1]), p(FACE_COMP[face][0]));
+        uv = _mm_mul_pd(
+            _mm_div_pd(uv, _mm_andnot_pd(_mm_set_pd(-0.0, -0.0), ww)),
+            _mm_set_pd(FACE_CONST[face][1], FACE_CONST[face][0])
+        );
+        __m128i st = faceToGrid(level, atanApprox(uv));
+        uint64_t h = hilbertIndex(st, level);
+        return (static_cast<uint64_t>(face + 10) << (2 * level)) | h;
+    }
 #endif
 
 
 // `Mq3cPixelFinder` locates modified-Q3C pixels that intersect a region.
 //
-// For now, we always begin with a loop over the root cube faces. For small
-// regions, this could be made significantly faster by computing the modified
-// Q3C index of the region bounding circle center, and looping over that pixel
-// and its neighbors.
+// For large regions, the traversal begins with a loop over the root cube
+// faces. For small regions, it instead computes the modified Q3C index of
+// the region bounding circle center, and loops over that pixel and its
+// neighbors.
 //
-// The subdivision level for the initial index computation would have to be
-// chosen such that the 8 or 9 pixel neighborhood of the center pixel is
-// guaranteed to contain the bounding circle. The minimum angular pixel width
-// could be precomputed per level. Alternatively, there is some constant W
-// such that the minimum angle between two points separated by at least one
-// pixel is greater than W * 2^-L at level L. Given the bounding circle
-// radius R, the subdivision level L of the initial neighborhood is the binary
-// exponent of W/R (and can be extracted by calling std::frexp).
+// The subdivision level for the initial index computation is chosen such
+// that the 8 or 9 pixel neighborhood of the center pixel is guaranteed to
+// contain the bounding circle. There is some constant W such that the
+// minimum angle between two points separated by at least one pixel is
+// greater than W * 2^-L at level L. Given the bounding circle radius R, the
+// subdivision level L of the initial neighborhood is the binary exponent of
+// W/R (see PixelFinder::seedLevel).
 //
-// Finding W and implementing the above is left as a future optimization.
+// The derivative of the face coordinate transformation f(x) = x(4 - |x|)/3
+// is at most 4/3, so a grid step spans at least 3/4 of the face coordinate
+// interval it spans in the original Q3C scheme. Since the minimum angle for
+// original Q3C pixels is greater than √2/3 * 2^-L, W = √2/4 is a valid
+// choice. Sampling suggests that the true minimum is about 1.09 * 2^-L.
 template <typename RegionType, bool InteriorOnly>
 class Mq3cPixelFinder: public detail::PixelFinder<
     Mq3cPixelFinder<RegionType, InteriorOnly>, RegionType, InteriorOnly, 4>
@@ -213,6 +318,18 @@ public:
 
     void operator()() {
         UnitVector3d pixel[4];
+        Circle const c = detail::boundingCircle(this->region());
+        int const l = this->seedLevel(c, SEED_WIDTH);
+        if (l >= 0) {
+            // Loop over the neighborhood of the bounding circle center.
+            uint64_t indexes[9];
+            int n = findNeighborhood(l, computeIndex(c.getCenter(), l), indexes);
+            for (int k = 0; k < n; ++k) {
+                makeQuad(indexes[k], l, pixel);
+                this->visitSeed(pixel, indexes[k], l);
+            }
+            return;
+        }
         // Loop over cube faces
         for (uint64_t f = 10; f < 16; ++f) {
             makeQuad(f, 0, pixel);
@@ -220,16 +337,46 @@ public:
         }
     }
 
-    void subdivide(UnitVector3d const *, uint64_t i, int level) {
-        UnitVector3d pixel[4];
-        ++level;
-        for (uint64_t c = i * 4; c != i * 4 + 4; ++c) {
-            makeQuad(c, level, pixel);
-            visit(pixel, c, level);
-        }
+    static constexpr int MAX_LEVEL = Mq3cPixelization::MAX_LEVEL;
+    static constexpr double SEED_WIDTH = 0.3535533905932738; // √2/4
+
+    // Quad vertices are dilated, so siblings share none of them, but they
+    // share grid and face coordinates, which are computed once per parent.
+    struct Cache {
+        UnitVector3d child[4][4];
+    };
+
+    void expand(UnitVector3d const *, uint64_t i, int level, Cache & cache) {
+        makeChildQuads(i, level, cache.child);
+    }
+
+    UnitVector3d const * child(Cache const & cache,
+                               uint64_t i,
+                               int,
+                               UnitVector3d *) {
+        return cache.child[i & 3];
     }
 };
 
+// `FACE_NORM` gives the normal vector names of the root cube faces, in
+// the order of their modified-Q3C indexes.
+char const FACE_NORM[6][2] = {
+    {'-', 'Z'}, {'+', 'X'}, {'+', 'Y'},
+    {'+', 'Z'}, {'-', 'X'}, {'-', 'Y'},
+};
+
+// `formatIndex` writes the string for the modified-Q3C index i, which has
+// level l, to the l + 2 characters starting at dst.
+void formatIndex(uint64_t i, int l, char * dst) {
+    // Print in base-4, from least to most significant digit.
+    for (char * p = dst + l + 1; p != dst + 1; --p, i >>= 2) {
+        *p = '0' + (i & 3);
+    }
+    // The remaining bits correspond to the cube face.
+    dst[0] = FACE_NORM[i - 10][0];
+    dst[1] = FACE_NORM[i - 10][1];
+}
+
 } // unnamed namespace
 
 
@@ -258,89 +405,262 @@ ConvexPolygon Mq3cPixelization::quad(uint64_t i) {
 }
 
 std::vector<uint64_t> Mq3cPixelization::neighborhood(uint64_t i) {
+    uint64_t indexes[9];
+    int n = neighborhood(i, indexes);
+    return std::vector<uint64_t>(indexes, indexes + n);
+}
+
+int Mq3cPixelization::neighborhood(uint64_t i, uint64_t (&out)[9]) {
     int l = level(i);
     if (l < 0 || l > MAX_LEVEL) {
         throw std::invalid_argument("Invalid modified-Q3C index");
     }
-    uint64_t indexes[9];
-    int n = findNeighborhood(l, i, indexes);
-    return std::vector<uint64_t>(indexes, indexes + n);
+    int n = findNeighborhood(l, i, out);
+    std::fill(out + n, out + 9, out[n - 1]);
+    return n;
+}
+
+void Mq3cPixelization::neighborhoods(uint64_t const * indexes,
+                                     size_t n,
+                                     uint64_t * out,
+                                     uint8_t * counts) {
+    for (size_t p = 0; p < n; ++p, out += 9) {
+        int l = level(indexes[p]);
+        if (l < 0 || l > MAX_LEVEL) {
+            throw std::invalid_argument("Invalid modified-Q3C index");
+        }
+        int m = findNeighborhood(l, indexes[p], out);
+        std::fill(out + m, out + 9, out[m - 1]);
+        counts[p] = static_cast<uint8_t>(m);
+    }
+}
+
+RangeSet Mq3cPixelization::dilate(RangeSet const & pixels, int k) const {
+    if (!universe().contains(pixels)) {
+        throw std::invalid_argument("Invalid modified-Q3C index");
+    }
+    if (k < 0) {
+        throw std::invalid_argument("Dilation radius must be non-negative");
+    }
+    int const level = _level;
+    return dilatePixels(
+        pixels, level, k,
+        [level](uint64_t i) {
+            uint32_t s, t;
+            std::tie(s, t) = hilbertIndexInverse(i, level);
+            return std::make_tuple(
+                static_cast<int>(i >> (2 * level)) - 10, s, t);
+        },
+        [level](int face, uint32_t s, uint32_t t) {
+            return (static_cast<uint64_t>(face + 10) << (2 * level)) |
+                   hilbertIndex(s, t, level);
+        },
+        [level](uint64_t i, uint64_t * dst) {
+            return findNeighborhood(level, i, dst);
+        });
 }
 
 std::string Mq3cPixelization::asString(uint64_t i) {
-    static char const FACE_NORM[6][2] = {
-        {'-', 'Z'}, {'+', 'X'}, {'+', 'Y'},
-        {'+', 'Z'}, {'-', 'X'}, {'-', 'Y'},
-    };
     char s[MAX_LEVEL + 2];
     int l = level(i);
     if (l < 0 || l > MAX_LEVEL) {
         throw std::invalid_argument("Invalid modified-Q3C index");
     }
-    // Print in base-4, from least to most significant digit.
-    char * p = s + (sizeof(s) - 1);
-    for (; l > 0; --l, --p, i >>= 2) {
-        *p = '0' + (i & 3);
+    formatIndex(i, l, s);
+    return std::string(s, static_cast<size_t>(l) + 2);
+}
+
+void Mq3cPixelization::toString(uint64_t const * indexes,
+                                size_t n,
+                                char * out,
+                                size_t width) const
+{
+    for (size_t k = 0; k < n; ++k, out += width) {
+        int l = level(indexes[k]);
+        if (l < 0 || l > MAX_LEVEL) {
+            throw std::invalid_argument("Invalid modified-Q3C index");
+        }
+        size_t len = static_cast<size_t>(l) + 2;
+        if (len > width) {
+            throw std::invalid_argument(
+                "Modified-Q3C index string is longer than the field width");
+        }
+        formatIndex(indexes[k], l, out);
+        std::fill(out + len, out + width, '\0');
     }
-    // The remaining bits correspond to the cube face.
-    --p;
-    p[0] = FACE_NORM[i - 10][0];
-    p[1] = FACE_NORM[i - 10][1];
-    return std::string(p, sizeof(s) - static_cast<size_t>(p - s));
 }
 
-Mq3cPixelization::Mq3cPixelization(int level) : _level{level} {
+uint64_t Mq3cPixelization::fromString(char const * s, size_t n) const {
+    if (n < 2 || n > MAX_LEVEL + 2) {
+        throw std::invalid_argument("Invalid modified-Q3C index string");
+    }
+    uint64_t i = 0;
+    while (i < 6 && (FACE_NORM[i][0] != s[0] || FACE_NORM[i][1] != s[1])) {
+        ++i;
+    }
+    if (i == 6) {
+        throw std::invalid_argument("Invalid modified-Q3C index string");
+    }
+    i += 10;
+    for (size_t j = 2; j < n; ++j) {
+        if (s[j] < '0' || s[j] > '3') {
+            throw std::invalid_argument("Invalid modified-Q3C index string");
+        }
+        i = (i << 2) | static_cast<uint64_t>(s[j] - '0');
+    }
+    return i;
+}
+
+Mq3cPixelization::Mq3cPixelization(int level, size_t cacheSize) :
+    _level{level}
+{
     if (level < 0 || level > MAX_LEVEL) {
         throw std::invalid_argument(
             "Modified-Q3C subdivision level not in [0, 30]");
     }
+    if (cacheSize > 0) {
+        _cache = std::make_shared<detail::PixelCache<4>>(cacheSize);
+    }
 }
 
 std::unique_ptr<Region> Mq3cPixelization::pixel(uint64_t i) const {
+    UnitVector3d verts[NUM_VERTICES];
+    _vertices(i, verts);
+    return std::unique_ptr<Region>(
+        new ConvexPolygon(verts[0], verts[1], verts[2], verts[3]));
+}
+
+void Mq3cPixelization::vertices(uint64_t const * indexes,
+                                size_t n,
+                                double * out) const
+{
+    for (size_t k = 0; k < n; ++k) {
+        UnitVector3d verts[NUM_VERTICES];
+        _vertices(indexes[k], verts);
+        for (int j = 0; j < NUM_VERTICES; ++j, out += 3) {
+            out[0] = verts[j].x();
+            out[1] = verts[j].y();
+            out[2] = verts[j].z();
+        }
+    }
+}
+
+void Mq3cPixelization::_vertices(uint64_t i, UnitVector3d * verts) const {
     uint64_t f = i >> (2 * _level);
     if (f < 10 || f > 15) {
         throw std::invalid_argument("Invalid modified-Q3C index");
     }
-    UnitVector3d verts[4];
-    makeQuad(i, _level, verts);
-    return std::unique_ptr<Region>(
-        new ConvexPolygon(verts[0], verts[1], verts[2], verts[3]));
+    if (_cache) {
+        int const level = _level;
+        _cache->get(i, verts, [level](uint64_t j, UnitVector3d * v) {
+            makeQuad(j, level, v);
+        });
+    } else {
+        makeQuad(i, _level, verts);
+    }
 }
 
-#if defined(NO_SIMD) || !defined(__x86_64__)
-    uint64_t Mq3cPixelization::index(UnitVector3d const & p) const {
-        int face = faceNumber(p, FACE_NUM);
-        double w = std::fabs(p(FACE_COMP[face][2]));
-        double u = (p(FACE_COMP[face][0]) / w) * FACE_CONST[face][0];
-        double v = (p(FACE_COMP[face][1]) / w) * FACE_CONST[face][1];
-        std::tie(u, v) = atanApprox(u, v);
-        std::tuple<int32_t, int32_t> g = faceToGrid(_level, u, v);
-        uint64_t h = hilbertIndex(static_cast<uint32_t>(std::get<0>(g)),
-                                  static_cast<uint32_t>(std::get<1>(g)),
-                                  _level);
-        return (static_cast<uint64_t>(face + 10) << (2 * _level)) | h;
-    }
-#else
-    uint64_t Mq3cPixelization::index(UnitVector3d const & p) const {
-        int face = faceNumber(p, FACE_NUM);
-        __m128d ww = _mm_set1_pd(p(FACE_COMP[face][2]));
-        __m128d uv = _mm_set_pd(p(FACE_COMP[face][1]), p(FACE_COMP[face][0]));
-        uv = _mm_mul_pd(
-            _mm_div_pd(uv, _mm_andnot_pd(_mm_set_pd(-0.0, -0.0), ww)),
-            _mm_set_pd(FACE_CONST[face][1], FACE_CONST[face][0])
-        );
-        __m128i st = faceToGrid(_level, atanApprox(uv));
-        uint64_t h = hilbertIndex(st, _level);
-        return (static_cast<uint64_t>(face + 10) << (2 * _level)) | h;
+uint64_t Mq3cPixelization::index(UnitVector3d const & p) const {
+    return computeIndex(p, _level);
+}
+
+void Mq3cPixelization::index(double const * x,
+                             double const * y,
+                             double const * z,
+                             uint64_t * out,
+                             size_t n) const
+{
+    int const level = _level;
+    size_t i = 0;
+#if defined(LSST_SPHGEOM_Q3C_AVX2)
+    if (detail::hasAvx2()) {
+        i = indexAvx2<true>(x, y, z, out, n, level,
+                            FACE_NUM, FACE_COMP, FACE_CONST);
     }
 #endif
+    for (; i < n; ++i) {
+        out[i] = computeIndex(UnitVector3d(x[i], y[i], z[i]), level);
+    }
+}
+
+std::vector<RangeSet> Mq3cPixelization::envelopeAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    return detail::findPixelsAtLevels<Mq3cPixelFinder, false>(r, levels, MAX_LEVEL);
+}
+
+std::vector<RangeSet> Mq3cPixelization::interiorAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    return detail::findPixelsAtLevels<Mq3cPixelFinder, true>(r, levels, MAX_LEVEL);
+}
+
+RangeSet Mq3cPixelization::_envelope(Region const & r,
+                                     size_t maxRanges,
+                                     unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::MQ3C_ENVELOPE_CALLS);
+    return detail::findPixels<Mq3cPixelFinder, false>(
+        r, maxRanges, _level, numThreads);
+}
+
+RangeSet Mq3cPixelization::_interior(Region const & r,
+                                     size_t maxRanges,
+                                     unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::MQ3C_INTERIOR_CALLS);
+    return detail::findPixels<Mq3cPixelFinder, true>(
+        r, maxRanges, _level, numThreads);
+}
+
+RangeSet Mq3cPixelization::_adaptiveEnvelope(Region const & r,
+                                             size_t targetRanges,
+                                             double areaBudget) const {
+    return detail::findPixelsAdaptive<Mq3cPixelFinder, false>(
+        r, _level, targetRanges, areaBudget, (2.0 / 3.0) * PI);
+}
+
+RangeSet Mq3cPixelization::_adaptiveInterior(Region const & r,
+                                             size_t targetRanges,
+                                             double areaBudget) const {
+    return detail::findPixelsAdaptive<Mq3cPixelFinder, true>(
+        r, _level, targetRanges, areaBudget, (2.0 / 3.0) * PI);
+}
+
+ProgressiveEnvelope Mq3cPixelization::_progressiveEnvelope(
+    Region const & r) const
+{
+    return ProgressiveEnvelope(
+        detail::findPixelsProgressive<Mq3cPixelFinder>(
+            r, _level, (2.0 / 3.0) * PI));
+}
+
+EnvelopeAndInterior Mq3cPixelization::_envelopeAndInterior(
+    Region const & r,
+    size_t maxRanges) const
+{
+    return detail::findEnvelopeAndInterior<Mq3cPixelFinder>(
+        r, maxRanges, _level);
+}
+
+CoverageFractions Mq3cPixelization::_coverageFraction(Region const & r) const {
+    return detail::findCoverage<Mq3cPixelFinder>(r, _level);
+}
 
-RangeSet Mq3cPixelization::_envelope(Region const & r, size_t maxRanges) const {
-    return detail::findPixels<Mq3cPixelFinder, false>(r, maxRanges, _level);
+RangeSet Mq3cPixelization::_envelope(Pixelization const & from,
+                                     RangeSet const & pixels,
+                                     size_t maxRanges,
+                                     unsigned numThreads) const {
+    return detail::findPixels<Mq3cPixelFinder, false>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
 }
 
-RangeSet Mq3cPixelization::_interior(Region const & r, size_t maxRanges) const {
-    return detail::findPixels<Mq3cPixelFinder, true>(r, maxRanges, _level);
+RangeSet Mq3cPixelization::_interior(Pixelization const & from,
+                                     RangeSet const & pixels,
+                                     size_t maxRanges,
+                                     unsigned numThreads) const {
+    return detail::findPixels<Mq3cPixelFinder, true>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
 }
 
 }} // namespace lsst::sphgeom
@@ -0,0 +1,186 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the MultiLevelRangeSet implementation.
+
+#include "lsst/sphgeom/MultiLevelRangeSet.h"
+
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+
+#include "lsst/sphgeom/curve.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+constexpr int MAX_LEVEL = 30;
+
+} // unnamed namespace
+
+MultiLevelRangeSet::MultiLevelRangeSet(RangeSet const & s, int level) {
+    if (level < 0 || level > MAX_LEVEL) {
+        throw std::invalid_argument("Invalid MultiLevelRangeSet level");
+    }
+    _levels.resize(level + 1);
+    // Decompose each range into maximal aligned blocks of 4ᵏ level L pixels,
+    // i.e. into level L - k pixels. Ranges are processed in ascending order,
+    // so pixels can be appended to the set for their level.
+    for (auto const & r: s) {
+        uint64_t x = std::get<0>(r);
+        uint64_t e = std::get<1>(r);
+        // An end of 0 means 2⁶⁴, which no pixel index can reach; it is
+        // handled by computing the remaining range size modulo 2⁶⁴.
+        uint64_t remaining = e - x;
+        if (remaining == 0) {
+            remaining = ~static_cast<uint64_t>(0);
+        }
+        while (remaining != 0) {
+            int k = level;
+            if (x != 0) {
+                k = std::min(k, __builtin_ctzll(x) >> 1);
+            }
+            k = std::min(k, static_cast<int>(log2(remaining)) >> 1);
+            // Consecutive level 0 pixels are emitted all at once.
+            uint64_t m = (k == level) ? remaining >> (2 * k) : 1;
+            uint64_t i = x >> (2 * k);
+            _levels[level - k].append(i, i + m);
+            uint64_t n = m << (2 * k);
+            x += n;
+            remaining -= n;
+        }
+    }
+}
+
+RangeSet const & MultiLevelRangeSet::getRanges(int level) const {
+    if (level < 0 || level > getMaxLevel()) {
+        throw std::invalid_argument("Invalid MultiLevelRangeSet level");
+    }
+    return _levels[level];
+}
+
+bool MultiLevelRangeSet::empty() const {
+    return std::all_of(_levels.begin(), _levels.end(),
+                       [](RangeSet const & s) { return s.empty(); });
+}
+
+size_t MultiLevelRangeSet::size() const {
+    size_t n = 0;
+    for (RangeSet const & s: _levels) {
+        n += s.size();
+    }
+    return n;
+}
+
+uint64_t MultiLevelRangeSet::getNumPixels() const {
+    uint64_t n = 0;
+    for (RangeSet const & s: _levels) {
+        n += s.cardinality();
+    }
+    return n;
+}
+
+RangeSet MultiLevelRangeSet::flatten() const {
+    int const level = getMaxLevel();
+    RangeSet result;
+    for (int l = 0; l <= level; ++l) {
+        int shift = 2 * (level - l);
+        for (auto const & r: _levels[l]) {
+            result.insert(std::get<0>(r) << shift, std::get<1>(r) << shift);
+        }
+    }
+    return result;
+}
+
+std::vector<uint64_t> MultiLevelRangeSet::uniq() const {
+    std::vector<uint64_t> result;
+    result.reserve(getNumPixels());
+    for (int l = 0; l <= getMaxLevel(); ++l) {
+        uint64_t base = static_cast<uint64_t>(4) << (2 * l);
+        for (auto const & r: _levels[l]) {
+            uint64_t first = std::get<0>(r);
+            uint64_t last = std::get<1>(r);
+            if (last == 0 || last > 3 * base) {
+                throw std::invalid_argument(
+                    "Pixel index cannot be NUNIQ encoded");
+            }
+            for (uint64_t i = first; i < last; ++i) {
+                result.push_back(base + i);
+            }
+        }
+    }
+    // Levels are disjoint NUNIQ intervals in ascending order.
+    return result;
+}
+
+MultiLevelRangeSet MultiLevelRangeSet::fromUniq(
+    std::vector<uint64_t> const & uniq,
+    int maxLevel)
+{
+    int finest = 0;
+    for (uint64_t u: uniq) {
+        if (u < 4) {
+            throw std::invalid_argument("Invalid NUNIQ value");
+        }
+        finest = std::max(finest, log2(u) / 2 - 1);
+    }
+    if (finest > MAX_LEVEL) {
+        throw std::invalid_argument("Invalid NUNIQ value");
+    }
+    if (maxLevel < 0) {
+        maxLevel = finest;
+    } else if (maxLevel < finest || maxLevel > MAX_LEVEL) {
+        throw std::invalid_argument("Invalid MultiLevelRangeSet level");
+    }
+    RangeSet s;
+    for (uint64_t u: uniq) {
+        int l = log2(u) / 2 - 1;
+        uint64_t i = u - (static_cast<uint64_t>(4) << (2 * l));
+        int shift = 2 * (maxLevel - l);
+        s.insert(i << shift, (i + 1) << shift);
+    }
+    return MultiLevelRangeSet(s, maxLevel);
+}
+
+std::ostream & operator<<(std::ostream & os, MultiLevelRangeSet const & s) {
+    os << "{\"MultiLevelRangeSet\": {";
+    bool first = true;
+    for (int l = 0; l <= s.getMaxLevel(); ++l) {
+        if (s.getRanges(l).empty() && l != s.getMaxLevel()) {
+            continue;
+        }
+        if (!first) {
+            os << ", ";
+        }
+        first = false;
+        os << '"' << l << "\": " << s.getRanges(l);
+    }
+    os << "}}";
+    return os;
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,93 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PARALLEL_H_
+#define LSST_SPHGEOM_PARALLEL_H_
+
+/// \file
+/// \brief This file provides a helper for dividing work among threads.
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+/// `runInParallel` calls `work` on the calling thread, and concurrently from
+/// up to `numThreads - 1` tasks submitted to the current executor, subject
+/// to the limit set with setMaxThreads. It returns once every call has
+/// returned. Calls from tasks that start late are skipped, so `work` must
+/// hand out pieces of a shared job, and finish it if it is the only call.
+/// It must not throw.
+void runInParallel(unsigned numThreads, std::function<void()> const & work);
+
+/// `forEachBlock` calls `f(begin, end)` for consecutive blocks of at most
+/// `blockSize` items covering [0, n). If `numThreads` is greater than one,
+/// blocks are handed out to that many threads, including the calling one,
+/// and the first exception thrown by `f` is rethrown once all threads are
+/// done. No block is started after an exception has been thrown.
+template <typename F>
+void forEachBlock(size_t n, size_t blockSize, unsigned numThreads, F const & f) {
+    size_t const numBlocks = (n + blockSize - 1) / blockSize;
+    auto block = [&](size_t b) {
+        size_t begin = b * blockSize;
+        f(begin, std::min(n, begin + blockSize));
+    };
+    if (numThreads <= 1 || numBlocks <= 1) {
+        for (size_t b = 0; b < numBlocks; ++b) {
+            block(b);
+        }
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&]() {
+        try {
+            for (size_t b = next++; b < numBlocks && !failed; b = next++) {
+                block(b);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+    runInParallel(static_cast<unsigned>(std::min<size_t>(numThreads, numBlocks)),
+                  work);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_PARALLEL_H_
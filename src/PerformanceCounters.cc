@@ -0,0 +1,260 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the performance counter implementation.
+
+#include "lsst/sphgeom/PerformanceCounters.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "PerformanceCounting.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using Values = std::array<uint64_t, NUM_PERFORMANCE_COUNTERS>;
+
+char const * const NAMES[NUM_PERFORMANCE_COUNTERS] = {
+    "htm.envelope.calls",
+    "htm.envelope.nanoseconds",
+    "htm.interior.calls",
+    "htm.interior.nanoseconds",
+    "q3c.envelope.calls",
+    "q3c.envelope.nanoseconds",
+    "q3c.interior.calls",
+    "q3c.interior.nanoseconds",
+    "mq3c.envelope.calls",
+    "mq3c.envelope.nanoseconds",
+    "mq3c.interior.calls",
+    "mq3c.interior.nanoseconds",
+    "healpix.envelope.calls",
+    "healpix.envelope.nanoseconds",
+    "healpix.interior.calls",
+    "healpix.interior.nanoseconds",
+    "relate.box.circle",
+    "relate.circle.circle",
+    "relate.convexPolygon.box",
+    "relate.convexPolygon.circle",
+    "relate.convexPolygon.convexPolygon",
+    "relate.ellipse.box",
+    "relate.ellipse.circle",
+    "relate.ellipse.convexPolygon",
+    "relate.ellipse.ellipse",
+    "orientation.fallbacks",
+    "region.decode.calls",
+    "region.decode.bytes",
+    "rangeSet.merges",
+    "rangeSet.mergeRanges",
+};
+
+// A `CounterBlock` holds the counters of one thread. Only that thread
+// modifies them, so relaxed loads and stores suffice for updates, and
+// other threads can read them at any time.
+struct CounterBlock {
+    std::atomic<uint64_t> values[NUM_PERFORMANCE_COUNTERS] = {};
+};
+
+// The `Registry` tracks the counter blocks of all live threads. Counters are
+// never reset in place, since that would race with their owners. Instead,
+// the totals at the time of the last reset are recorded and subtracted from
+// later totals.
+struct Registry {
+    std::mutex mutex;
+    std::vector<CounterBlock const *> blocks;
+    // The counts of threads that have exited.
+    Values retired{};
+    // The totals at the time of the last reset.
+    Values baseline{};
+
+    // `total` sums the counts of all threads. The mutex must be held.
+    Values total() const {
+        Values v = retired;
+        for (CounterBlock const * b: blocks) {
+            for (size_t i = 0; i < NUM_PERFORMANCE_COUNTERS; ++i) {
+                v[i] += b->values[i].load(std::memory_order_relaxed);
+            }
+        }
+        return v;
+    }
+};
+
+// The registry is never destroyed, so that threads exiting during static
+// destruction can still retire their counters.
+Registry & registry() {
+    static Registry * r = new Registry();
+    return *r;
+}
+
+// A `ThreadCounters` object registers the counter block of a thread for
+// its lifetime.
+struct ThreadCounters {
+    CounterBlock block;
+
+    ThreadCounters() {
+        Registry & r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.blocks.push_back(&block);
+    }
+
+    ~ThreadCounters() {
+        Registry & r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (size_t i = 0; i < NUM_PERFORMANCE_COUNTERS; ++i) {
+            r.retired[i] += block.values[i].load(std::memory_order_relaxed);
+        }
+        r.blocks.erase(std::find(r.blocks.begin(), r.blocks.end(), &block));
+    }
+};
+
+thread_local ThreadCounters threadCounters;
+
+// The `Reporter` calls the performance callback periodically from its own
+// thread.
+class Reporter {
+public:
+    ~Reporter() { stop(); }
+
+    void start(std::function<void(PerformanceSnapshot const &)> callback,
+               std::chrono::milliseconds period)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _callback = std::move(callback);
+        _period = period;
+        _stopping = false;
+        _thread = std::thread([this]() { _run(); });
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stopping = true;
+        }
+        _cv.notify_all();
+        if (_thread.joinable()) {
+            _thread.join();
+        }
+        // Destroy the callback before returning, so that callers know it is
+        // no longer referenced.
+        std::lock_guard<std::mutex> lock(_mutex);
+        _callback = nullptr;
+    }
+
+private:
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _thread;
+    std::function<void(PerformanceSnapshot const &)> _callback;
+    std::chrono::milliseconds _period{0};
+    bool _stopping = false;
+
+    void _run() {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_cv.wait_for(lock, _period, [this]() { return _stopping; })) {
+            lock.unlock();
+            try {
+                _callback(getPerformanceCounters());
+            } catch (...) {
+                // Reporting must not terminate the process.
+            }
+            lock.lock();
+        }
+    }
+};
+
+Reporter & reporter() {
+    static Reporter r;
+    return r;
+}
+
+// `setPerformanceCallback` calls must not overlap.
+std::mutex callbackMutex;
+
+} // unnamed namespace
+
+#ifdef LSST_SPHGEOM_NO_PERFORMANCE_COUNTERS
+bool const PerformanceSnapshot::ENABLED = false;
+#else
+bool const PerformanceSnapshot::ENABLED = true;
+#endif
+
+char const * PerformanceSnapshot::getName(PerformanceCounter c) {
+    size_t i = static_cast<size_t>(c);
+    if (i >= NUM_PERFORMANCE_COUNTERS) {
+        throw std::invalid_argument("Invalid performance counter");
+    }
+    return NAMES[i];
+}
+
+PerformanceSnapshot getPerformanceCounters() {
+    Registry & r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    Values total = r.total();
+    PerformanceSnapshot s;
+    for (size_t i = 0; i < NUM_PERFORMANCE_COUNTERS; ++i) {
+        s.values[i] = total[i] - r.baseline[i];
+    }
+    return s;
+}
+
+void resetPerformanceCounters() {
+    Registry & r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    r.baseline = r.total();
+}
+
+void setPerformanceCallback(
+    std::function<void(PerformanceSnapshot const &)> callback,
+    std::chrono::milliseconds period)
+{
+    if (callback && period.count() <= 0) {
+        throw std::invalid_argument(
+            "Performance callback period must be positive");
+    }
+    std::lock_guard<std::mutex> lock(callbackMutex);
+    reporter().stop();
+    if (callback) {
+        reporter().start(std::move(callback), period);
+    }
+}
+
+namespace detail {
+
+void addToCounter(PerformanceCounter c, uint64_t n) {
+    std::atomic<uint64_t> & v =
+        threadCounters.block.values[static_cast<size_t>(c)];
+    v.store(v.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,92 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PERFORMANCECOUNTING_H_
+#define LSST_SPHGEOM_PERFORMANCECOUNTING_H_
+
+/// \file
+/// \brief This file provides the functions used by the library to update
+///        its performance counters.
+
+#include <chrono>
+#include <cstdint>
+
+#include "lsst/sphgeom/PerformanceCounters.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+/// `PERFORMANCE_COUNTERS` is false if performance counters are compiled out,
+/// in which case the functions below do nothing.
+#ifdef LSST_SPHGEOM_NO_PERFORMANCE_COUNTERS
+constexpr bool PERFORMANCE_COUNTERS = false;
+#else
+constexpr bool PERFORMANCE_COUNTERS = true;
+#endif
+
+/// `addToCounter` adds n to the counter c of the calling thread.
+void addToCounter(PerformanceCounter c, uint64_t n);
+
+/// `count` adds n to the counter c of the calling thread.
+inline void count(PerformanceCounter c, uint64_t n = 1) {
+    if (PERFORMANCE_COUNTERS) {
+        addToCounter(c, n);
+    }
+}
+
+/// A `CallTimer` counts a call in the `_CALLS` counter it is constructed
+/// with when it is destroyed, and adds the time elapsed since its
+/// construction to the `_NANOSECONDS` counter that follows.
+class CallTimer {
+public:
+    explicit CallTimer(PerformanceCounter calls) : _calls(calls) {
+        if (PERFORMANCE_COUNTERS) {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~CallTimer() {
+        if (PERFORMANCE_COUNTERS) {
+            auto elapsed = std::chrono::steady_clock::now() - _start;
+            addToCounter(_calls, 1);
+            addToCounter(
+                static_cast<PerformanceCounter>(
+                    static_cast<unsigned>(_calls) + 1),
+                static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        elapsed).count()));
+        }
+    }
+
+    CallTimer(CallTimer const &) = delete;
+    CallTimer & operator=(CallTimer const &) = delete;
+
+private:
+    PerformanceCounter _calls;
+    std::chrono::steady_clock::time_point _start;
+};
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_PERFORMANCECOUNTING_H_
@@ -0,0 +1,113 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PIXELCACHE_H_
+#define LSST_SPHGEOM_PIXELCACHE_H_
+
+/// \file
+/// \brief This file contains a cache for pixel vertices.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "lsst/sphgeom/UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+/// A `PixelCache` is a bounded, thread-safe cache of the vertices of
+/// pixels with `NumVertices` vertices, keyed by pixel index.
+///
+/// The cache is direct-mapped: each pixel index hashes to a single slot,
+/// and a pixel evicts whatever pixel previously occupied its slot. This
+/// approximates LRU replacement at much lower cost, and behaves well for
+/// the workloads the cache targets, where a working set of pixels that
+/// is small relative to the cache capacity is requested over and over.
+///
+/// Slots are protected by a fixed number of mutexes, so that concurrent
+/// lookups of different pixels rarely contend. Vertices are computed
+/// outside of any lock.
+template <int NumVertices>
+class PixelCache {
+public:
+    /// This constructor creates a cache with room for at least `capacity`
+    /// pixels, which must be positive.
+    explicit PixelCache(size_t capacity) {
+        while ((static_cast<size_t>(1) << _bits) < capacity && _bits < 40) {
+            ++_bits;
+        }
+        _slots.resize(static_cast<size_t>(1) << _bits);
+    }
+
+    /// `get` stores the vertices of pixel `i` in `verts`, calling
+    /// `compute(i, verts)` to obtain them if they are not cached.
+    template <typename Compute>
+    void get(uint64_t i, UnitVector3d * verts, Compute compute) {
+        size_t s = _slot(i);
+        {
+            std::lock_guard<std::mutex> lock(_locks[s % NUM_LOCKS]);
+            Slot const & slot = _slots[s];
+            if (slot.full && slot.index == i) {
+                std::copy(slot.verts, slot.verts + NumVertices, verts);
+                return;
+            }
+        }
+        compute(i, verts);
+        std::lock_guard<std::mutex> lock(_locks[s % NUM_LOCKS]);
+        Slot & slot = _slots[s];
+        slot.index = i;
+        slot.full = true;
+        std::copy(verts, verts + NumVertices, slot.verts);
+    }
+
+private:
+    static constexpr size_t NUM_LOCKS = 64;
+
+    struct Slot {
+        uint64_t index = 0;
+        bool full = false;
+        UnitVector3d verts[NumVertices];
+    };
+
+    std::vector<Slot> _slots;
+    std::mutex _locks[NUM_LOCKS];
+    int _bits = 0;
+
+    // `_slot` maps a pixel index to a slot via Fibonacci hashing, so that
+    // runs of consecutive indexes are spread over the whole cache.
+    size_t _slot(uint64_t i) const {
+        if (_bits == 0) {
+            return 0;
+        }
+        return static_cast<size_t>(
+            (i * UINT64_C(0x9e3779b97f4a7c15)) >> (64 - _bits));
+    }
+};
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_PIXELCACHE_H_
@@ -0,0 +1,304 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the PixelCountMap implementation.
+
+#include "lsst/sphgeom/PixelCountMap.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "Parallel.h"
+#include "RadixSort.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The minimum number of pixel indexes accumulated by each thread.
+constexpr size_t MIN_BLOCK_SIZE = 65536;
+
+// An `Entry` is a pixel index and the weight to add to that pixel.
+struct Entry {
+    uint64_t index;
+    double weight;
+};
+
+} // unnamed namespace
+
+void PixelCountMap::Runs::append(uint64_t f, uint64_t l, double v) {
+    if (v == 0.0) {
+        return;
+    }
+    if (!value.empty() && value.back() == v && last.back() + 1 == f) {
+        last.back() = l;
+        return;
+    }
+    first.push_back(f);
+    last.push_back(l);
+    value.push_back(v);
+}
+
+PixelCountMap::Runs PixelCountMap::_merge(Runs const & a, Runs const & b) {
+    size_t const na = a.size();
+    size_t const nb = b.size();
+    Runs out;
+    out.first.reserve(na + nb);
+    out.last.reserve(na + nb);
+    out.value.reserve(na + nb);
+    size_t i = 0;
+    size_t j = 0;
+    // fa and fb are the first pixels of the parts of runs i of a and j of b
+    // that have not been output yet.
+    uint64_t fa = na > 0 ? a.first[0] : 0;
+    uint64_t fb = nb > 0 ? b.first[0] : 0;
+    while (i < na && j < nb) {
+        uint64_t const la = a.last[i];
+        uint64_t const lb = b.last[j];
+        if (la < fb) {
+            out.append(fa, la, a.value[i]);
+            if (++i < na) {
+                fa = a.first[i];
+            }
+        } else if (lb < fa) {
+            out.append(fb, lb, b.value[j]);
+            if (++j < nb) {
+                fb = b.first[j];
+            }
+        } else if (fa < fb) {
+            out.append(fa, fb - 1, a.value[i]);
+            fa = fb;
+        } else if (fb < fa) {
+            out.append(fb, fa - 1, b.value[j]);
+            fb = fa;
+        } else {
+            // The runs start at the same pixel.
+            uint64_t const l = std::min(la, lb);
+            out.append(fa, l, a.value[i] + b.value[j]);
+            if (la == l) {
+                if (++i < na) {
+                    fa = a.first[i];
+                }
+            } else {
+                fa = l + 1;
+            }
+            if (lb == l) {
+                if (++j < nb) {
+                    fb = b.first[j];
+                }
+            } else {
+                fb = l + 1;
+            }
+        }
+    }
+    for (; i < na; ++i) {
+        out.append(fa, a.last[i], a.value[i]);
+        fa = i + 1 < na ? a.first[i + 1] : 0;
+    }
+    for (; j < nb; ++j) {
+        out.append(fb, b.last[j], b.value[j]);
+        fb = j + 1 < nb ? b.first[j + 1] : 0;
+    }
+    return out;
+}
+
+PixelCountMap::PixelCountMap(int level) : _level(level) {
+    if (level < 0 || level > 30) {
+        throw std::invalid_argument("Pixel count map level not in [0, 30]");
+    }
+}
+
+uint64_t PixelCountMap::getNumPixels() const {
+    uint64_t n = 0;
+    for (size_t i = 0; i < _runs.size(); ++i) {
+        n += _runs.last[i] - _runs.first[i] + 1;
+    }
+    return n;
+}
+
+double PixelCountMap::get(uint64_t i) const {
+    auto it = std::upper_bound(_runs.first.begin(), _runs.first.end(), i);
+    if (it == _runs.first.begin()) {
+        return 0.0;
+    }
+    size_t const r = static_cast<size_t>(it - _runs.first.begin()) - 1;
+    return i <= _runs.last[r] ? _runs.value[r] : 0.0;
+}
+
+double PixelCountMap::total() const {
+    double sum = 0.0;
+    for (size_t i = 0; i < _runs.size(); ++i) {
+        double n = static_cast<double>(_runs.last[i] - _runs.first[i]) + 1.0;
+        sum += n * _runs.value[i];
+    }
+    return sum;
+}
+
+void PixelCountMap::add(uint64_t i, double weight) {
+    Runs runs;
+    runs.append(i, i, weight);
+    _runs = _merge(_runs, runs);
+}
+
+void PixelCountMap::add(uint64_t const * indexes,
+                        double const * weights,
+                        size_t n,
+                        unsigned numThreads)
+{
+    if (n == 0) {
+        return;
+    }
+    size_t const numBlocks = std::max<size_t>(
+        1, std::min<size_t>(numThreads, n / MIN_BLOCK_SIZE));
+    size_t const blockSize = (n + numBlocks - 1) / numBlocks;
+    std::vector<Runs> buffers(numBlocks);
+    detail::forEachBlock(n, blockSize, numThreads,
+                         [&](size_t begin, size_t end) {
+        std::vector<Entry> entries(end - begin);
+        for (size_t k = begin; k < end; ++k) {
+            entries[k - begin] = Entry{indexes[k],
+                                       weights == nullptr ? 1.0 : weights[k]};
+        }
+        detail::radixSort(entries, [](Entry const & e) { return e.index; });
+        Runs & runs = buffers[begin / blockSize];
+        for (size_t k = 0; k < entries.size();) {
+            uint64_t const i = entries[k].index;
+            double w = 0.0;
+            for (; k < entries.size() && entries[k].index == i; ++k) {
+                w += entries[k].weight;
+            }
+            runs.append(i, i, w);
+        }
+    });
+    // Merge the per-thread buffers pairwise.
+    for (size_t step = 1; step < numBlocks; step *= 2) {
+        size_t const numPairs = (numBlocks - step + 2 * step - 1) / (2 * step);
+        detail::forEachBlock(numPairs, 1, numThreads,
+                             [&](size_t begin, size_t) {
+            size_t const b = 2 * step * begin;
+            buffers[b] = _merge(buffers[b], buffers[b + step]);
+            buffers[b + step] = Runs();
+        });
+    }
+    _runs = _merge(_runs, buffers[0]);
+}
+
+void PixelCountMap::add(RangeSet const & s, double weight) {
+    if (weight == 0.0 || s.empty()) {
+        return;
+    }
+    Runs runs;
+    for (auto const & r: s) {
+        // An end of 0 means 2⁶⁴, so that subtracting 1 yields the last
+        // integer in every range.
+        runs.append(std::get<0>(r), std::get<1>(r) - 1, weight);
+    }
+    _runs = _merge(_runs, runs);
+}
+
+void PixelCountMap::add(PixelCountMap const & m) {
+    if (m._level != _level) {
+        throw std::invalid_argument("Pixel count map levels differ");
+    }
+    _runs = _merge(_runs, m._runs);
+}
+
+PixelCountMap PixelCountMap::coarsened(int level) const {
+    if (level < 0 || level > _level) {
+        throw std::invalid_argument("Invalid pixel count map level");
+    }
+    PixelCountMap result(level);
+    int const shift = 2 * (_level - level);
+    if (shift == 0) {
+        result._runs = _runs;
+        return result;
+    }
+    double const numChildren = static_cast<double>(uint64_t(1) << shift);
+    Runs & out = result._runs;
+    // Partial contributions to a parent pixel arrive in ascending order of
+    // parent index. The weight of the parent with index `pending` is summed
+    // until a contribution to a later parent arrives.
+    bool havePending = false;
+    uint64_t pending = 0;
+    double pendingWeight = 0.0;
+    auto flush = [&]() {
+        if (havePending) {
+            out.append(pending, pending, pendingWeight);
+            havePending = false;
+        }
+    };
+    auto addPartial = [&](uint64_t p, double w) {
+        if (havePending && p == pending) {
+            pendingWeight += w;
+            return;
+        }
+        flush();
+        havePending = true;
+        pending = p;
+        pendingWeight = w;
+    };
+    for (size_t i = 0; i < _runs.size(); ++i) {
+        uint64_t const f = _runs.first[i];
+        uint64_t const l = _runs.last[i];
+        double const v = _runs.value[i];
+        uint64_t const pf = f >> shift;
+        uint64_t const pl = l >> shift;
+        if (pf == pl) {
+            addPartial(pf, v * static_cast<double>(l - f + 1));
+            continue;
+        }
+        addPartial(pf, v * static_cast<double>(((pf + 1) << shift) - f));
+        if (pl - pf > 1) {
+            // Parents in (pf, pl) are fully covered by the run.
+            flush();
+            out.append(pf + 1, pl - 1, v * numChildren);
+        }
+        addPartial(pl, v * static_cast<double>(l - (pl << shift) + 1));
+    }
+    flush();
+    return result;
+}
+
+RangeSet PixelCountMap::getPixels() const {
+    RangeSet s;
+    for (size_t i = 0; i < _runs.size(); ++i) {
+        s.append(_runs.first[i], _runs.last[i] + 1);
+    }
+    return s;
+}
+
+PixelCountRuns PixelCountMap::getRuns() const {
+    PixelCountRuns runs;
+    runs.begin = _runs.first;
+    runs.end.reserve(_runs.size());
+    for (uint64_t l: _runs.last) {
+        runs.end.push_back(l + 1);
+    }
+    runs.value = _runs.value;
+    return runs;
+}
+
+}} // namespace lsst::sphgeom
@@ -26,32 +26,408 @@
 /// \file
 /// \brief This file provides a base class for pixel finders.
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <tuple>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/Matrix3d.h"
+#include "lsst/sphgeom/MemoryResourceScope.h"
+#include "lsst/sphgeom/PixelRegion.h"
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/ProgressiveEnvelope.h"
 #include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/TraversalStats.h"
+#include "lsst/sphgeom/area.h"
 
 #include "ConvexPolygonImpl.h"
+#include "EllipseImpl.h"
+#include "Parallel.h"
+#include "PreparedBox.h"
+#include "PreparedCircle.h"
 
 
 namespace lsst {
 namespace sphgeom {
 namespace detail {
 
+// `TRAVERSAL_STATS` is false if traversal statistics are compiled out, in
+// which case pixel finders never record them.
+#ifdef LSST_SPHGEOM_NO_TRAVERSAL_STATS
+constexpr bool TRAVERSAL_STATS = false;
+#else
+constexpr bool TRAVERSAL_STATS = true;
+#endif
+
+// `recordRelate` adds the outcome of relating a pixel at the given level to
+// a search region to `stats`.
+inline void recordRelate(TraversalStats & stats, int level, Relationship r) {
+    std::vector<uint64_t> & nodes = stats.nodesVisited;
+    if (nodes.size() <= static_cast<size_t>(level)) {
+        nodes.resize(level + 1, 0);
+    }
+    ++nodes[level];
+    if ((r & DISJOINT) != 0) {
+        ++stats.disjoint;
+    } else if ((r & WITHIN) != 0) {
+        ++stats.within;
+    } else {
+        ++stats.intersects;
+    }
+}
+
+// `GenericRegion` adapts a region of a type the pixel finders know nothing
+// about, for example a PixelRegion nested in a compound region, so that it
+// can be searched for. Pixels are related to it through the virtual
+// Region::relate, which is slower than relating them to the prepared forms
+// of the built-in regions. It holds a copy of the region, so it can outlive
+// the region it was created from.
+class GenericRegion {
+public:
+    explicit GenericRegion(Region const & r) : _region(r.clone()) {}
+
+    Circle getBoundingCircle() const { return _region->getBoundingCircle(); }
+
+    template <typename VertexIterator>
+    Relationship relate(VertexIterator const begin,
+                        VertexIterator const end) const
+    {
+        ConvexPolygon p(std::vector<UnitVector3d>(begin, end));
+        return invert(_region->relate(p));
+    }
+
+private:
+    std::shared_ptr<Region const> _region;
+};
+
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    GenericRegion const & r)
+{
+    return r.relate(begin, end);
+}
+
+// `SimplifiedPolygon` is a search region for a convex polygon with many
+// vertices. Pixels are first related to an outer and an inner polygon with
+// few vertices (see ConvexPolygon::simplifiedOuter and simplifiedInner).
+// Pixels disjoint from the former are disjoint from the polygon, and pixels
+// within the latter are within it, so only the pixels close to the polygon
+// boundary are related to the polygon itself.
+class SimplifiedPolygon {
+public:
+    // Polygons with fewer vertices than this are searched for directly.
+    static constexpr size_t MIN_VERTICES = 256;
+
+    // The simplified polygons have at most this many vertices.
+    static constexpr size_t SIMPLIFIED_VERTICES = 32;
+
+    explicit SimplifiedPolygon(ConvexPolygon const & p) :
+        _polygon(&p),
+        _outer(p.simplifiedOuter(SIMPLIFIED_VERTICES)),
+        _inner(p.simplifiedInner(SIMPLIFIED_VERTICES))
+    {}
+
+    Circle getBoundingCircle() const { return _polygon->getBoundingCircle(); }
+
+    template <typename VertexIterator>
+    Relationship relate(VertexIterator const begin,
+                        VertexIterator const end) const
+    {
+        if ((detail::relate(begin, end, _outer) & DISJOINT) != 0) {
+            return DISJOINT;
+        }
+        if ((detail::relate(begin, end, _inner) & WITHIN) != 0) {
+            return WITHIN;
+        }
+        return detail::relate(begin, end, *_polygon);
+    }
+
+private:
+    ConvexPolygon const * _polygon;
+    ConvexPolygon _outer;
+    ConvexPolygon _inner;
+};
+
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    SimplifiedPolygon const & p)
+{
+    return p.relate(begin, end);
+}
+
+// `CompiledRegion` is a CompoundRegion flattened into a tree of nodes that
+// can be related to a pixel without virtual function calls or dynamic casts.
+// Ellipse operands are replaced by a pair of approximations from outside and
+// inside (see ellipseBound), which are used to check for disjointness and
+// containment respectively.
+class CompiledRegion {
+public:
+    explicit CompiledRegion(CompoundRegion const & r) :
+        _boundingCircle(r.getBoundingCircle())
+    {
+        _compile(r);
+    }
+
+    Circle const & getBoundingCircle() const { return _boundingCircle; }
+
+    template <typename VertexIterator>
+    Relationship relate(VertexIterator const begin,
+                        VertexIterator const end) const
+    {
+        return _relate(begin, end, _nodes.size() - 1);
+    }
+
+private:
+    enum Kind {
+        CIRCLE, BOX, POLYGON, REGION, UNION, INTERSECTION, APPROXIMATION
+    };
+
+    // Operands of a node always precede it. Leaf nodes store an index into
+    // the vector of regions of the appropriate type in `operand[0]`. Union
+    // and intersection nodes store the range [operand[0], operand[1]) of
+    // `_children` holding the indexes of their operand nodes.
+    struct Node {
+        Kind kind;
+        size_t operand[2];
+    };
+
+    Circle _boundingCircle;
+    std::vector<Node> _nodes;
+    std::vector<size_t> _children;
+    std::vector<PreparedCircle> _circles;
+    std::vector<PreparedBox> _boxes;
+    std::vector<ConvexPolygon> _polygons;
+    std::vector<GenericRegion> _regions;
+
+    size_t _push(Kind kind, size_t first, size_t second = 0) {
+        _nodes.push_back(Node{kind, {first, second}});
+        return _nodes.size() - 1;
+    }
+
+    size_t _compile(Region const & r) {
+        if (auto c = dynamic_cast<Circle const *>(&r)) {
+            _circles.emplace_back(*c);
+            return _push(CIRCLE, _circles.size() - 1);
+        }
+        if (auto e = dynamic_cast<Ellipse const *>(&r)) {
+            size_t outer = _compile(*ellipseBound(*e, true));
+            size_t inner = _compile(*ellipseBound(*e, false));
+            return _push(APPROXIMATION, outer, inner);
+        }
+        if (auto b = dynamic_cast<Box const *>(&r)) {
+            _boxes.emplace_back(*b);
+            return _push(BOX, _boxes.size() - 1);
+        }
+        if (auto u = dynamic_cast<UnionRegion const *>(&r)) {
+            return _compileOperands(UNION, *u);
+        }
+        if (auto i = dynamic_cast<IntersectionRegion const *>(&r)) {
+            return _compileOperands(INTERSECTION, *i);
+        }
+        if (auto p = dynamic_cast<ConvexPolygon const *>(&r)) {
+            _polygons.push_back(*p);
+            return _push(POLYGON, _polygons.size() - 1);
+        }
+        _regions.emplace_back(r);
+        return _push(REGION, _regions.size() - 1);
+    }
+
+    size_t _compileOperands(Kind kind, CompoundRegion const & r) {
+        // Operands may themselves have operands, so their node indexes
+        // are only appended to _children once all of them are compiled.
+        std::vector<size_t> children;
+        children.reserve(r.nOperands());
+        for (size_t i = 0; i < r.nOperands(); ++i) {
+            children.push_back(_compile(r.getOperand(i)));
+        }
+        size_t begin = _children.size();
+        _children.insert(_children.end(), children.begin(), children.end());
+        return _push(kind, begin, _children.size());
+    }
+
+    template <typename VertexIterator>
+    Relationship _relate(VertexIterator const begin,
+                         VertexIterator const end,
+                         size_t n) const
+    {
+        Node const & node = _nodes[n];
+        switch (node.kind) {
+            case CIRCLE:
+                return detail::relate(begin, end, _circles[node.operand[0]]);
+            case BOX:
+                return detail::relate(begin, end, _boxes[node.operand[0]]);
+            case POLYGON:
+                return detail::relate(begin, end, _polygons[node.operand[0]]);
+            case REGION:
+                return _regions[node.operand[0]].relate(begin, end);
+            case UNION: {
+                // A pixel within any operand is within the union, and there
+                // is then no need to look at the remaining operands.
+                Relationship all = CONTAINS | DISJOINT;
+                for (size_t i = node.operand[0]; i < node.operand[1]; ++i) {
+                    Relationship r = _relate(begin, end, _children[i]);
+                    if ((r & WITHIN) != 0) {
+                        return WITHIN;
+                    }
+                    all &= r;
+                }
+                return all;
+            }
+            case INTERSECTION: {
+                // A pixel disjoint from any operand is disjoint from the
+                // intersection, and there is then no need to look at the
+                // remaining operands.
+                Relationship all = WITHIN;
+                Relationship any;
+                for (size_t i = node.operand[0]; i < node.operand[1]; ++i) {
+                    Relationship r = _relate(begin, end, _children[i]);
+                    if ((r & DISJOINT) != 0) {
+                        return DISJOINT;
+                    }
+                    all &= r;
+                    any |= r & CONTAINS;
+                }
+                return all | any;
+            }
+            case APPROXIMATION: {
+                Relationship r1 = _relate(begin, end, node.operand[0]);
+                if ((r1 & DISJOINT) != 0) {
+                    return DISJOINT;
+                }
+                Relationship r2 = _relate(begin, end, node.operand[1]);
+                return (r1 & CONTAINS) | (r2 & WITHIN);
+            }
+        }
+        return INTERSECTS;
+    }
+};
+
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    CompiledRegion const & r)
+{
+    return r.relate(begin, end);
+}
+
+// `PixelCoverage` is the union of a set of pixels from some pixelization,
+// used as a search region to convert pixel sets between pixelizations.
+//
+// A pixel P is related to the coverage by computing the envelope E of (the
+// polygon bounding) P in the source pixelization. P is disjoint from the
+// coverage if E does not intersect the source pixel set, and within it if
+// the source pixel set contains E. Both conclusions hold even though E is
+// only an approximation of the pixels intersecting P, since E always
+// includes all of them.
+//
+// Most pixels visited by a traversal straddle the boundary of the coverage.
+// For such a pixel, there are usually vertices inside and outside of the
+// coverage, and this is detected by looking up the source pixel of each
+// vertex, which is much cheaper than computing an envelope.
+class PixelCoverage {
+public:
+    PixelCoverage(Pixelization const & pixelization, RangeSet const & pixels):
+        _pixelization{&pixelization},
+        _pixels{&pixels}
+    {}
+
+    template <typename VertexIterator>
+    Relationship relate(VertexIterator const begin,
+                        VertexIterator const end) const
+    {
+        bool in = false;
+        bool out = false;
+        for (VertexIterator v = begin; v != end; ++v) {
+            if (_pixels->contains(_pixelization->index(*v))) {
+                in = true;
+            } else {
+                out = true;
+            }
+        }
+        if (in && out) {
+            return INTERSECTS;
+        }
+        ConvexPolygon p(std::vector<UnitVector3d>(begin, end));
+        RangeSet e = _pixelization->envelope(p);
+        if (!_pixels->intersects(e)) {
+            return DISJOINT;
+        }
+        if (_pixels->contains(e)) {
+            return WITHIN;
+        }
+        return INTERSECTS;
+    }
+
+private:
+    Pixelization const * _pixelization;
+    RangeSet const * _pixels;
+};
+
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    PixelCoverage const & c)
+{
+    return c.relate(begin, end);
+}
+
+// `boundingCircle` returns a circle containing a search region, which pixel
+// finders use to start traversals for small regions close to the region.
+// A pixel coverage has no cheap bound, so the full circle is returned.
+template <typename RegionType>
+Circle boundingCircle(RegionType const & r) { return r.getBoundingCircle(); }
+
+inline Circle boundingCircle(PixelCoverage const &) { return Circle::full(); }
+
+// A `LevelOutput` receives the pixels that a pixel finder finds at a
+// subdivision level coarser than its own (see PixelFinder::setLevelOutputs).
+struct LevelOutput {
+    int level;
+    RangeSet * ranges;
+};
+
 // `PixelFinder` is a CRTP base class that locates pixels intersecting a
 // region. It assumes a hierarchical pixelization, and that pixels are
 // convex spherical polygons with a fixed number of vertices.
 //
-// The algorithm used is top-down tree traversal, implemented via recursion
-// for simplicity. Subclasses must provide a method named `subdivide` with
-// the following signature:
+// The algorithm used is top-down tree traversal. Rather than recursing, it
+// keeps an explicit stack of partially visited pixels with one frame per
+// subdivision level, so that no allocation or function call overhead is
+// incurred per pixel. Subclasses must provide a constant `MAX_LEVEL` giving
+// the maximum subdivision level, a type named `Cache` holding per-pixel
+// state shared by its children (e.g. vertices shared by siblings), and
+// methods with the following signatures:
 //
-//      void subdivide(UnitVector3d const * pixel,
-//                     uint64_t index,
-//                     int level);
+//      void expand(UnitVector3d const * pixel,
+//                  uint64_t index,
+//                  int level,
+//                  Cache & cache);
 //
-// that subdivides a pixel into its children and then invokes visit() on
-// each child. Children should be visited in ascending index order to keep
-// RangeSet inserts efficient. The subclass is also responsible for
-// implementing a top-level method that invokes visit() on each root pixel,
-// or on some set of candidate pixels.
+//      UnitVector3d const * child(Cache const & cache,
+//                                 uint64_t index,
+//                                 int level,
+//                                 UnitVector3d * scratch);
+//
+// `expand` is called once per pixel that must be subdivided, and `child`
+// is then called on each of its 4 children, in ascending index order,
+// to obtain the child vertices. These can either be stored in `scratch`,
+// which has room for `NumVertices` vertices, or in the cache. The `index`
+// and `level` arguments refer to the child pixel in the latter call. The
+// subclass is also responsible for implementing a top-level method that
+// invokes visit() on each root pixel, or on some set of candidate pixels.
 //
 // The `RegionType` parameter avoids the need for virtual function calls to
 // determine the spatial relationship between pixels and the input region. The
@@ -59,6 +435,21 @@ namespace detail {
 // to locate all pixels that intersect the input region, or only those that
 // are entirely inside it. Finally, the `NumVertices` template parameter is
 // the number of vertices in the polygonal representation of a pixel.
+//
+// A finder can also be asked to stop descending at a given split level and
+// to record the pixels it would have subdivided there as `Task`s, rather
+// than visiting their children. Each task can later be completed by a
+// separate finder, possibly on another thread, via run(). This is what
+// findPixels() uses to parallelize the traversal.
+//
+// A finder given a TraversalStats sink via setStats() counts the pixels it
+// visits, the outcomes of relating them to the search region, and the
+// changes it makes to its output.
+//
+// Finally, a finder can be given outputs for subdivision levels coarser
+// than its own via setLevelOutputs(). The pixels it finds at those levels
+// are then added to them as the traversal passes through, so that pixel
+// sets for several levels are obtained from a single traversal.
 template <
     typename Derived,
     typename RegionType,
@@ -67,6 +458,11 @@ template <
 >
 class PixelFinder {
 public:
+    using SearchRegion = RegionType;
+
+    static constexpr bool INTERIOR_ONLY = InteriorOnly;
+    static constexpr size_t NUM_VERTICES = NumVertices;
+
     PixelFinder(RangeSet & ranges,
                 RegionType const & region,
                 int level,
@@ -78,6 +474,95 @@ public:
         _maxRanges{maxRanges == 0 ? maxRanges - 1 : maxRanges}
     {}
 
+    // `Task` is a pixel that intersects the search region, and whose
+    // children have not been visited yet.
+    struct Task {
+        UnitVector3d pixel[NumVertices];
+        uint64_t index;
+        int level;
+    };
+
+    using TaskVector = std::pmr::vector<Task>;
+
+    // `split` causes pixels at the given level that must be subdivided to
+    // be appended to `tasks` instead. Unless `deepSeeds` is true, traversals
+    // never start below that level (see seedLevel), so that every such pixel
+    // is visited. Otherwise, a traversal for a small region may start below
+    // it, and then creates no tasks; this gives the same result as a
+    // traversal that is not split.
+    void split(TaskVector & tasks, int level, bool deepSeeds = false) {
+        _tasks = &tasks;
+        _splitLevel = level;
+        _deepSeeds = deepSeeds;
+    }
+
+    // `setStats` makes the finder record traversal statistics in `stats`,
+    // which may be null.
+    void setStats(TraversalStats * stats) { _stats = stats; }
+
+    // `setLevelOutputs` makes the finder add the pixels it finds at the
+    // levels of the given outputs to them. The outputs must be sorted by
+    // strictly increasing level, which must be below the level of the
+    // finder, and the finder must not reduce its level, i.e. it must have
+    // been created with no bound on the number of ranges.
+    void setLevelOutputs(LevelOutput const * begin, LevelOutput const * end) {
+        _outputsBegin = begin;
+        _outputsEnd = end;
+    }
+
+    // `collectBoundary` causes pixels at the target level that intersect
+    // the search region, but are not known to be within it, to be appended
+    // to `leaves` rather than inserted into the output. The output then only
+    // receives the pixels found to be within the search region.
+    void collectBoundary(TaskVector & leaves) { _leaves = &leaves; }
+
+    // `collectBoundary` causes the indexes of the pixels described above to
+    // be appended to `boundary` instead. Together with the pixels within the
+    // search region found by an interior-only finder, they form the envelope
+    // of the search region. The finder must not reduce its level, i.e. it
+    // must have been created with no bound on the number of ranges.
+    void collectBoundary(RangeSet & boundary) { _boundary = &boundary; }
+
+    // `level` returns the current subdivision level, which is lower than
+    // the requested one if the number of ranges had to be reduced.
+    int level() const { return _level; }
+
+    // `region` returns the search region.
+    RegionType const & region() const { return *_region; }
+
+    // `seedLevel` returns the subdivision level at which a traversal for
+    // a region with bounding circle c can start from the pixels near the
+    // center of c, or -1 if the traversal should start from the root
+    // pixels. The pixelization must guarantee that points separated by at
+    // least one pixel at level L are more than `width` * 2^-L apart in
+    // chord length. The seed level is the deepest level at which the
+    // radius of c is below this bound, but never deeper than the level of
+    // the traversal or, unless deep seeds were requested, the level at which
+    // it is split into tasks (see split).
+    int seedLevel(Circle const & c, double width) const {
+        if (c.isEmpty() || c.isFull()) {
+            return -1;
+        }
+        int limit = _splitLevel >= 0 && !_deepSeeds ?
+                    std::min(_level, _splitLevel) : _level;
+        double chord = std::sqrt(c.getSquaredChordLength());
+        int l = limit;
+        if (chord > std::ldexp(width, -limit)) {
+            // width / chord = m * 2^e, where m is in [0.5, 1), so that
+            // chord <= width * 2^-(e - 1).
+            std::frexp(width / chord, &l);
+            l -= 1;
+        }
+        return l >= 1 ? l : -1;
+    }
+
+    // `run` completes the traversal of the subtree rooted at a task.
+    void run(Task const & task) {
+        _descend(task.pixel, task.index, task.level);
+    }
+
+    // `visit` finds the pixels intersecting the search region in the
+    // subtree rooted at the given pixel.
     void visit(UnitVector3d const * pixel,
                uint64_t index,
                int level)
@@ -88,40 +573,175 @@ public:
             // has been found.
             return;
         }
+        if (_test(pixel, index, level)) {
+            _descend(pixel, index, level);
+        }
+    }
+
+    // `visitSeed` is like visit, but for the pixels at a seed level (see
+    // seedLevel) that together contain the search region. If the
+    // subdivision level has been reduced below the seed level, the
+    // ancestor of the pixel at the reduced level is added to envelopes
+    // whole, rather than being skipped.
+    void visitSeed(UnitVector3d const * pixel,
+                   uint64_t index,
+                   int level)
+    {
+        if (level > _level) {
+            if (!InteriorOnly && _level >= 0) {
+                _insert(index >> 2 * (level - _level), _level);
+            }
+            return;
+        }
+        _seedLevel = level;
+        visit(pixel, index, level);
+    }
+
+private:
+    RangeSet * _ranges;
+    RegionType const * _region;
+    int _level;
+    int const _desiredLevel;
+    size_t const _maxRanges;
+    TaskVector * _tasks = nullptr;
+    TaskVector * _leaves = nullptr;
+    RangeSet * _boundary = nullptr;
+    int _splitLevel = -1;
+    bool _deepSeeds = false;
+    TraversalStats * _stats = nullptr;
+    LevelOutput const * _outputsBegin = nullptr;
+    LevelOutput const * _outputsEnd = nullptr;
+    int _seedLevel = -1;
+
+    // `_test` determines the relationship between a pixel and the search
+    // region, inserting the pixel into the output if appropriate. It returns
+    // true if the children of the pixel must be visited.
+    bool _test(UnitVector3d const * pixel, uint64_t index, int level) {
         // Determine the relationship between the pixel and the search region.
         Relationship r = detail::relate(pixel, pixel + NumVertices, *_region);
+        if (TRAVERSAL_STATS && _stats != nullptr) {
+            recordRelate(*_stats, level, r);
+        }
         if ((r & DISJOINT) != 0) {
             // The pixel is disjoint from the search region.
-            return;
+            return false;
+        }
+        if (_outputsBegin != _outputsEnd) {
+            _insertLevels(index, level, (r & WITHIN) != 0);
         }
         if ((r & WITHIN) != 0) {
             // The tree traversal has reached a pixel that is entirely within
             // the search region.
             _insert(index, level);
-            return;
+            return false;
         } else if (level == _level) {
             // The tree traversal has reached a leaf.
-            if (!InteriorOnly) {
+            if (_leaves != nullptr) {
+                _leaves->push_back(Task{});
+                Task & t = _leaves->back();
+                std::copy(pixel, pixel + NumVertices, t.pixel);
+                t.index = index;
+                t.level = level;
+            } else if (_boundary != nullptr) {
+                _boundary->append(index, index + 1);
+            } else if (!InteriorOnly) {
                 _insert(index, level);
             }
-            return;
+            return false;
         }
-        static_cast<Derived *>(this)->subdivide(pixel, index, level);
+        if (level == _splitLevel) {
+            _tasks->push_back(Task{});
+            Task & t = _tasks->back();
+            std::copy(pixel, pixel + NumVertices, t.pixel);
+            t.index = index;
+            t.level = level;
+            return false;
+        }
+        return true;
     }
 
-private:
-    RangeSet * _ranges;
-    RegionType const * _region;
-    int _level;
-    int const _desiredLevel;
-    size_t const _maxRanges;
+    // `_descend` visits the descendants of a pixel that intersects the
+    // search region.
+    void _descend(UnitVector3d const * pixel, uint64_t index, int level) {
+        struct Frame {
+            typename Derived::Cache cache;
+            uint64_t index;
+            int level;
+            int next;
+        };
+        Derived & derived = *static_cast<Derived *>(this);
+        Frame stack[Derived::MAX_LEVEL];
+        Frame * top = stack;
+        derived.expand(pixel, index, level, top->cache);
+        top->index = index;
+        top->level = level;
+        top->next = 0;
+        while (true) {
+            if (top->next == 4 || top->level >= _level) {
+                // All children have been visited, or the subdivision level
+                // has been reduced so that there is nothing left to do.
+                if (top == stack) {
+                    return;
+                }
+                --top;
+                continue;
+            }
+            uint64_t i = 4 * top->index + top->next;
+            int l = top->level + 1;
+            ++top->next;
+            UnitVector3d scratch[NumVertices];
+            UnitVector3d const * child =
+                derived.child(top->cache, i, l, scratch);
+            if (_test(child, i, l)) {
+                ++top;
+                derived.expand(child, i, l, top->cache);
+                top->index = i;
+                top->level = l;
+                top->next = 0;
+            }
+        }
+    }
+
+    // `_insertLevels` adds a pixel that is not disjoint from the search
+    // region to the outputs for coarser levels. The pixel itself is added
+    // to the output for its own level, and if it is within the search
+    // region, its descendants are added to the outputs for finer levels.
+    // The ancestors of a seed pixel are never visited, so if the pixel is a
+    // seed, they are added to the envelopes for the levels above it.
+    void _insertLevels(uint64_t index, int level, bool within) {
+        for (LevelOutput const * o = _outputsBegin; o != _outputsEnd; ++o) {
+            if (o->level < level) {
+                if (!InteriorOnly && level == _seedLevel) {
+                    uint64_t i = index >> 2 * (level - o->level);
+                    o->ranges->insert(i, i + 1);
+                }
+                continue;
+            }
+            if (o->level == level) {
+                if (!InteriorOnly || within) {
+                    o->ranges->append(index, index + 1);
+                }
+            } else if (within) {
+                int shift = 2 * (o->level - level);
+                o->ranges->append(index << shift, (index + 1) << shift);
+            } else {
+                return;
+            }
+        }
+    }
 
     void _insert(uint64_t index, int level) {
         int shift = 2 * (_desiredLevel - level);
-        _ranges->insert(index << shift, (index + 1) << shift);
+        _ranges->append(index << shift, (index + 1) << shift);
+        if (TRAVERSAL_STATS && _stats != nullptr) {
+            ++_stats->inserts;
+        }
         while (_ranges->size() > _maxRanges) {
             // Reduce the subdivision level.
             --_level;
+            if (TRAVERSAL_STATS && _stats != nullptr) {
+                ++_stats->simplifications;
+            }
             shift += 2;
             // When looking for intersecting pixels, ranges are simplified
             // by expanding them outwards, causing nearly adjacent small ranges
@@ -141,33 +761,826 @@ private:
 };
 
 
+// `findPixelsParallel` runs a pixel finder using `numThreads` threads. The
+// tree is traversed serially down to a split level chosen to yield a few
+// tasks per thread, and the remaining subtrees are then distributed over the
+// threads, each of which accumulates the pixels it finds in a separate
+// RangeSet per task. Finally, these are merged with the pixels found during
+// the serial phase.
+//
+// Subtrees are traversed without a bound on the number of ranges. Since
+// children are visited in ascending index order, the number of ranges found
+// by a serial traversal never decreases as it proceeds, so a result with at
+// most `maxRanges` ranges is exactly what the serial traversal would have
+// produced. If the result has more ranges, serial traversal would instead
+// have reduced the subdivision level part way through; in that case false
+// is returned (possibly early, as soon as some task on its own exceeds
+// the limit), and the caller must fall back to serial traversal.
+//
+// If `stats` is not null, each thread records statistics for the tasks it
+// runs separately, and these are added to `stats` when it is done.
+//
+// The calling thread allocates the tasks from its scoped memory resource
+// (see MemoryResourceScope), but the per-task results are modified by the
+// worker threads, and so are allocated from the default resource.
+template <typename FinderType>
+bool findPixelsParallel(RangeSet & s,
+                        typename FinderType::SearchRegion const & region,
+                        size_t maxRanges,
+                        int level,
+                        unsigned numThreads,
+                        TraversalStats * stats)
+{
+    using TaskVector = typename FinderType::TaskVector;
+    // Split the tree at the first level with at least 8 pixels per thread.
+    int splitLevel = 0;
+    for (uint64_t n = 6; n < 8 * static_cast<uint64_t>(numThreads); n *= 4) {
+        ++splitLevel;
+    }
+    splitLevel = std::min(splitLevel, level - 1);
+    TaskVector tasks(MemoryResourceScope::current());
+    FinderType find(s, region, level, 0);
+    find.setStats(stats);
+    // Seeding must not depend on the split level, or parallel and serial
+    // envelopes of boxes could differ.
+    find.split(tasks, splitLevel, true);
+    find();
+    std::vector<RangeSet> results(tasks.size() + 1);
+    std::atomic<size_t> next{0};
+    std::atomic<bool> overflow{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    auto work = [&]() {
+        TraversalStats local;
+        try {
+            for (size_t i = next++; i < tasks.size(); i = next++) {
+                if (overflow) {
+                    break;
+                }
+                FinderType f(results[i], region, level, 0);
+                f.setStats(stats != nullptr ? &local : nullptr);
+                f.run(tasks[i]);
+                // Ranges in different tasks cannot merge with one another
+                // inside the index interval of a task, so the final result
+                // has at least as many ranges as any single task produces.
+                if (maxRanges != 0 && results[i].size() > maxRanges) {
+                    overflow = true;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            overflow = true;
+        }
+        if (stats != nullptr) {
+            std::lock_guard<std::mutex> lock(mutex);
+            stats->merge(local);
+        }
+    };
+    numThreads = static_cast<unsigned>(
+        std::min<size_t>(numThreads, tasks.size()));
+    detail::runInParallel(numThreads, work);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    if (overflow) {
+        return false;
+    }
+    results.back() = std::move(s);
+    s = RangeSet::unionAll(results);
+    return maxRanges == 0 || s.size() <= maxRanges;
+}
+
+// `StatsClaim` takes the traversal statistics sink of the current thread
+// for the lifetime of a traversal, and restores it afterwards.
+class StatsClaim {
+public:
+    StatsClaim() :
+        _stats{TRAVERSAL_STATS ? TraversalStatsScope::release() : nullptr}
+    {}
+
+    ~StatsClaim() {
+        if (_stats != nullptr) {
+            TraversalStatsScope::restore(_stats);
+        }
+    }
+
+    StatsClaim(StatsClaim const &) = delete;
+    StatsClaim & operator=(StatsClaim const &) = delete;
+
+    TraversalStats * get() const { return _stats; }
+
+private:
+    TraversalStats * _stats;
+};
+
+template <typename FinderType>
+RangeSet runFinder(typename FinderType::SearchRegion const & region,
+                    size_t maxRanges,
+                    int level,
+                    unsigned numThreads)
+{
+    StatsClaim claim;
+    TraversalStats * stats = claim.get();
+    RangeSet s(MemoryResourceScope::current());
+    if (numThreads > 1 && level > 0) {
+        if (findPixelsParallel<FinderType>(
+                s, region, maxRanges, level, numThreads, stats)) {
+            if (stats != nullptr) {
+                stats->finalLevel = level;
+            }
+            return s;
+        }
+        s.clear();
+    }
+    FinderType find(s, region, level, maxRanges);
+    find.setStats(stats);
+    find();
+    if (stats != nullptr) {
+        stats->finalLevel = find.level();
+    }
+    return s;
+}
+
+// `runAdaptiveFinder` locates pixels intersecting (or within) a region in a
+// single best-first traversal, choosing the subdivision depth per subtree
+// instead of traversing down to `level` and coarsening the result.
+//
+// The frontier is the set of pixels that intersect the region but are
+// neither within it nor at the target level. Its total area bounds the area
+// by which the output can exceed (or, for interior pixels, fall short of)
+// the exact pixel set, since every other pixel is output only if it is known
+// to intersect (or be within) the region. The traversal repeatedly subdivides
+// the largest frontier pixel, i.e. the one with the lowest level, ties going
+// to the lowest index. It stops when the frontier is empty, when its nominal
+// area (`rootArea` / 4ˡ per pixel at level l) is at most `areaBudget`, or
+// just before the first subdivision that would bring the output above
+// `targetRanges` ranges. A target of zero imposes no limit. Frontier pixels
+// are output in full when looking for intersecting pixels, and dropped when
+// looking for interior ones.
+//
+// Each subdivision updates the output in place, and is undone if it yields
+// too many ranges. Since the children of a pixel are contained in it, this
+// only requires re-inserting the parent range for envelopes, or erasing the
+// child ranges for interiors.
+template <typename FinderType>
+RangeSet runAdaptiveFinder(typename FinderType::SearchRegion const & region,
+                           int level,
+                           size_t targetRanges,
+                           double areaBudget,
+                           double rootArea)
+{
+    using Task = typename FinderType::Task;
+    using TaskVector = typename FinderType::TaskVector;
+    constexpr bool interiorOnly = FinderType::INTERIOR_ONLY;
+    constexpr size_t numVertices = FinderType::NUM_VERTICES;
+    struct Larger {
+        bool operator()(Task const & a, Task const & b) const {
+            return a.level > b.level ||
+                   (a.level == b.level && a.index > b.index);
+        }
+    };
+    StatsClaim claim;
+    TraversalStats * stats = claim.get();
+    // Relate the root pixels to the region. Those within it, or at the
+    // target level, are output directly.
+    std::pmr::memory_resource * resource = MemoryResourceScope::current();
+    RangeSet s(resource);
+    TaskVector roots(resource);
+    FinderType find(s, region, level, 0);
+    find.setStats(stats);
+    find.split(roots, 0);
+    find();
+    if (targetRanges == 0) {
+        targetRanges = static_cast<size_t>(-1);
+    }
+    auto pixelRange = [level](uint64_t index, int l) {
+        int shift = 2 * (level - l);
+        return std::make_pair(index << shift, (index + 1) << shift);
+    };
+    auto pixelArea = [rootArea](int l) { return std::ldexp(rootArea, -2 * l); };
+    // For envelopes, `s` includes the frontier pixels.
+    double frontierArea = 0.0;
+    for (Task const & t: roots) {
+        frontierArea += pixelArea(t.level);
+        if (!interiorOnly) {
+            auto r = pixelRange(t.index, t.level);
+            s.insert(r.first, r.second);
+        }
+    }
+    if (s.size() > targetRanges) {
+        // Even the root pixels have too many ranges; fall back to the
+        // coarsening used by the regular traversal.
+        s.clear();
+        FinderType f(s, region, level, targetRanges);
+        f();
+        if (stats != nullptr) {
+            stats->finalLevel = f.level();
+        }
+        return s;
+    }
+    std::priority_queue<Task, TaskVector, Larger> frontier(
+        Larger(), std::move(roots));
+    typename FinderType::Cache cache;
+    Task children[4];
+    Relationship relationships[4];
+    while (!frontier.empty() && frontierArea > areaBudget) {
+        Task const & t = frontier.top();
+        int const l = t.level + 1;
+        auto const parent = pixelRange(t.index, t.level);
+        find.expand(t.pixel, t.index, t.level, cache);
+        if (!interiorOnly) {
+            s.erase(parent.first, parent.second);
+        }
+        double area = frontierArea - pixelArea(t.level);
+        for (int c = 0; c < 4; ++c) {
+            Task & child = children[c];
+            child.index = 4 * t.index + c;
+            child.level = l;
+            UnitVector3d const * v =
+                find.child(cache, child.index, l, child.pixel);
+            if (v != child.pixel) {
+                std::copy(v, v + numVertices, child.pixel);
+            }
+            Relationship r = detail::relate(
+                child.pixel, child.pixel + numVertices, region);
+            if (TRAVERSAL_STATS && stats != nullptr) {
+                recordRelate(*stats, l, r);
+            }
+            relationships[c] = r;
+            if ((r & DISJOINT) != 0) {
+                continue;
+            }
+            bool within = (r & WITHIN) != 0;
+            if (!within && l < level) {
+                area += pixelArea(l);
+            }
+            if (within || !interiorOnly) {
+                auto range = pixelRange(child.index, l);
+                s.insert(range.first, range.second);
+                if (TRAVERSAL_STATS && stats != nullptr) {
+                    ++stats->inserts;
+                }
+            }
+        }
+        if (s.size() > targetRanges) {
+            if (interiorOnly) {
+                for (int c = 0; c < 4; ++c) {
+                    if ((relationships[c] & WITHIN) != 0) {
+                        auto range = pixelRange(children[c].index, l);
+                        s.erase(range.first, range.second);
+                    }
+                }
+            } else {
+                s.insert(parent.first, parent.second);
+            }
+            break;
+        }
+        frontier.pop();
+        frontierArea = area;
+        for (int c = 0; c < 4; ++c) {
+            Relationship r = relationships[c];
+            if ((r & (DISJOINT | WITHIN)) == 0 && l < level) {
+                frontier.push(children[c]);
+            }
+        }
+    }
+    if (stats != nullptr) {
+        stats->finalLevel = frontier.empty() ? level : frontier.top().level;
+    }
+    return s;
+}
+
+// `findPixelsAdaptive` implements adaptive pixel-finding (see
+// runAdaptiveFinder) for an arbitrary Region, given a PixelFinder subclass
+// for a specific pixelization and the nominal area of its root pixels.
+template <
+    template <typename, bool> class Finder,
+    bool InteriorOnly
+>
+RangeSet findPixelsAdaptive(Region const & r,
+                            int level,
+                            size_t targetRanges,
+                            double areaBudget,
+                            double rootArea)
+{
+    if (auto c = dynamic_cast<Circle const *>(&r)) {
+        PreparedCircle prepared(*c);
+        return runAdaptiveFinder<Finder<PreparedCircle, InteriorOnly>>(
+            prepared, level, targetRanges, areaBudget, rootArea);
+    }
+    if (auto e = dynamic_cast<Ellipse const *>(&r)) {
+        return findPixelsAdaptive<Finder, InteriorOnly>(
+            *ellipseBound(*e, !InteriorOnly), level, targetRanges,
+            areaBudget, rootArea);
+    }
+    if (auto b = dynamic_cast<Box const *>(&r)) {
+        PreparedBox prepared(*b);
+        return runAdaptiveFinder<Finder<PreparedBox, InteriorOnly>>(
+            prepared, level, targetRanges, areaBudget, rootArea);
+    }
+    if (auto cr = dynamic_cast<CompoundRegion const *>(&r)) {
+        CompiledRegion compiled(*cr);
+        return runAdaptiveFinder<Finder<CompiledRegion, InteriorOnly>>(
+            compiled, level, targetRanges, areaBudget, rootArea);
+    }
+    if (auto p = dynamic_cast<ConvexPolygon const *>(&r)) {
+        return runAdaptiveFinder<Finder<ConvexPolygon, InteriorOnly>>(
+            *p, level, targetRanges, areaBudget, rootArea);
+    }
+    GenericRegion generic(r);
+    return runAdaptiveFinder<Finder<GenericRegion, InteriorOnly>>(
+        generic, level, targetRanges, areaBudget, rootArea);
+}
+
+// `ProgressiveEnvelopeState` holds the state of a ProgressiveEnvelope. On
+// its own it represents an envelope that is already complete, which is what
+// the default Pixelization implementation returns.
+class ProgressiveEnvelopeState {
+public:
+    using Clock = ProgressiveEnvelope::Clock;
+
+    explicit ProgressiveEnvelopeState(RangeSet && r = RangeSet(),
+                                      int level = 0) :
+        ranges{std::move(r)},
+        coarsestLevel{level}
+    {}
+
+    virtual ~ProgressiveEnvelopeState() = default;
+
+    // `refine` performs at most `maxSteps` refinement steps, stopping early
+    // if `deadline` passes. The clock is not read if the deadline is
+    // Clock::time_point::max().
+    virtual void refine(size_t, Clock::time_point) {}
+
+    RangeSet ranges;
+    double frontierArea = 0.0;
+    size_t numSteps = 0;
+    int coarsestLevel;
+    bool complete = true;
+};
+
+// `ProgressiveFinder` computes an envelope with the best-first traversal of
+// runAdaptiveFinder, but without range or area limits, and one subdivision
+// at a time so that the traversal can be suspended and resumed. The
+// frontier pixels are included whole in `ranges`.
+//
+// The search region is copied, so that the state does not depend on the
+// lifetime of the region it was created for, and the finder is only used
+// to relate the root pixels and to compute child pixels.
+template <typename FinderType>
+class ProgressiveFinder : public ProgressiveEnvelopeState {
+public:
+    using SearchRegion = typename FinderType::SearchRegion;
+
+    ProgressiveFinder(SearchRegion const & region,
+                      int level,
+                      double rootArea) :
+        ProgressiveEnvelopeState{RangeSet(), level},
+        _region{region},
+        _find{ranges, _region, level, 0},
+        _level{level},
+        _rootArea{rootArea}
+    {
+        TaskVector roots;
+        _find.split(roots, 0);
+        _find();
+        for (Task const & t: roots) {
+            frontierArea += _pixelArea(t.level);
+            auto r = _pixelRange(t.index, t.level);
+            ranges.insert(r.first, r.second);
+        }
+        _frontier = Queue(Larger(), std::move(roots));
+        _update();
+    }
+
+    void refine(size_t maxSteps, Clock::time_point deadline) override {
+        bool const timed = deadline != Clock::time_point::max();
+        for (size_t n = 0; n < maxSteps && !_frontier.empty(); ++n) {
+            if (timed && Clock::now() >= deadline) {
+                break;
+            }
+            _step();
+        }
+        _update();
+    }
+
+private:
+    using Task = typename FinderType::Task;
+    using TaskVector = typename FinderType::TaskVector;
+    static constexpr size_t NUM_VERTICES = FinderType::NUM_VERTICES;
+
+    struct Larger {
+        bool operator()(Task const & a, Task const & b) const {
+            return a.level > b.level ||
+                   (a.level == b.level && a.index > b.index);
+        }
+    };
+
+    using Queue = std::priority_queue<Task, TaskVector, Larger>;
+
+    SearchRegion const _region;
+    FinderType _find;
+    int const _level;
+    double const _rootArea;
+    Queue _frontier;
+    typename FinderType::Cache _cache;
+
+    std::pair<uint64_t, uint64_t> _pixelRange(uint64_t index, int l) const {
+        int shift = 2 * (_level - l);
+        return std::make_pair(index << shift, (index + 1) << shift);
+    }
+
+    double _pixelArea(int l) const { return std::ldexp(_rootArea, -2 * l); }
+
+    void _step() {
+        Task const t = _frontier.top();
+        _frontier.pop();
+        int const l = t.level + 1;
+        auto const parent = _pixelRange(t.index, t.level);
+        _find.expand(t.pixel, t.index, t.level, _cache);
+        ranges.erase(parent.first, parent.second);
+        frontierArea -= _pixelArea(t.level);
+        for (int c = 0; c < 4; ++c) {
+            Task child;
+            child.index = 4 * t.index + c;
+            child.level = l;
+            UnitVector3d const * v =
+                _find.child(_cache, child.index, l, child.pixel);
+            if (v != child.pixel) {
+                std::copy(v, v + NUM_VERTICES, child.pixel);
+            }
+            Relationship r = detail::relate(
+                child.pixel, child.pixel + NUM_VERTICES, _region);
+            if ((r & DISJOINT) != 0) {
+                continue;
+            }
+            auto range = _pixelRange(child.index, l);
+            ranges.insert(range.first, range.second);
+            if ((r & WITHIN) == 0 && l < _level) {
+                frontierArea += _pixelArea(l);
+                _frontier.push(child);
+            }
+        }
+        ++numSteps;
+    }
+
+    void _update() {
+        complete = _frontier.empty();
+        coarsestLevel = complete ? _level : _frontier.top().level;
+        if (complete) {
+            frontierArea = 0.0;
+        }
+    }
+};
+
+// `findPixelsProgressive` creates the state of a ProgressiveEnvelope (see
+// ProgressiveFinder) for an arbitrary Region, given a PixelFinder subclass
+// for a specific pixelization and the nominal area of its root pixels.
+template <template <typename, bool> class Finder>
+std::unique_ptr<ProgressiveEnvelopeState> findPixelsProgressive(
+    Region const & r,
+    int level,
+    double rootArea)
+{
+    using State = std::unique_ptr<ProgressiveEnvelopeState>;
+    if (auto c = dynamic_cast<Circle const *>(&r)) {
+        return State(new ProgressiveFinder<Finder<PreparedCircle, false>>(
+            PreparedCircle(*c), level, rootArea));
+    }
+    if (auto e = dynamic_cast<Ellipse const *>(&r)) {
+        return findPixelsProgressive<Finder>(
+            *ellipseBound(*e, true), level, rootArea);
+    }
+    if (auto b = dynamic_cast<Box const *>(&r)) {
+        return State(new ProgressiveFinder<Finder<PreparedBox, false>>(
+            PreparedBox(*b), level, rootArea));
+    }
+    if (auto cr = dynamic_cast<CompoundRegion const *>(&r)) {
+        return State(new ProgressiveFinder<Finder<CompiledRegion, false>>(
+            CompiledRegion(*cr), level, rootArea));
+    }
+    if (auto p = dynamic_cast<ConvexPolygon const *>(&r)) {
+        return State(new ProgressiveFinder<Finder<ConvexPolygon, false>>(
+            *p, level, rootArea));
+    }
+    return State(new ProgressiveFinder<Finder<GenericRegion, false>>(
+        GenericRegion(r), level, rootArea));
+}
+
 // `findPixels` implements pixel-finding for an arbitrary Region, given a
-// PixelFinder subclass for a specific pixelization.
+// PixelFinder subclass for a specific pixelization. If `numThreads` is
+// greater than one, the traversal is parallelized as described above; the
+// result is the same in either case.
 template <
     template <typename, bool> class Finder,
     bool InteriorOnly
 >
-RangeSet findPixels(Region const & r, size_t maxRanges, int level) {
-    RangeSet s;
-    Circle const * c = nullptr;
-    Ellipse const * e = nullptr;
-    Box const * b = nullptr;
-    if ((c = dynamic_cast<Circle const *>(&r))) {
-        Finder<Circle, InteriorOnly> find(s, *c, level, maxRanges);
-        find();
-    } else if ((e = dynamic_cast<Ellipse const *>(&r))) {
-        Finder<Circle, InteriorOnly> find(
-            s, e->getBoundingCircle(), level, maxRanges);
-        find();
-    } else if ((b = dynamic_cast<Box const *>(&r))) {
-        Finder<Box, InteriorOnly> find(s, *b, level, maxRanges);
-        find();
+RangeSet findPixels(Region const & r,
+                    size_t maxRanges,
+                    int level,
+                    unsigned numThreads = 1)
+{
+    if (auto c = dynamic_cast<Circle const *>(&r)) {
+        PreparedCircle prepared(*c);
+        return runFinder<Finder<PreparedCircle, InteriorOnly>>(
+            prepared, maxRanges, level, numThreads);
+    }
+    if (auto e = dynamic_cast<Ellipse const *>(&r)) {
+        return findPixels<Finder, InteriorOnly>(
+            *ellipseBound(*e, !InteriorOnly), maxRanges, level, numThreads);
+    }
+    if (auto b = dynamic_cast<Box const *>(&r)) {
+        PreparedBox prepared(*b);
+        return runFinder<Finder<PreparedBox, InteriorOnly>>(
+            prepared, maxRanges, level, numThreads);
+    }
+    if (auto cr = dynamic_cast<CompoundRegion const *>(&r)) {
+        CompiledRegion compiled(*cr);
+        return runFinder<Finder<CompiledRegion, InteriorOnly>>(
+            compiled, maxRanges, level, numThreads);
+    }
+    if (auto p = dynamic_cast<ConvexPolygon const *>(&r)) {
+        if (p->getVertices().size() >= SimplifiedPolygon::MIN_VERTICES) {
+            SimplifiedPolygon simplified(*p);
+            return runFinder<Finder<SimplifiedPolygon, InteriorOnly>>(
+                simplified, maxRanges, level, numThreads);
+        }
+        return runFinder<Finder<ConvexPolygon, InteriorOnly>>(
+            *p, maxRanges, level, numThreads);
+    }
+    if (auto pr = dynamic_cast<PixelRegion const *>(&r)) {
+        PixelCoverage coverage(pr->getPixelization(), pr->getPixels());
+        return runFinder<Finder<PixelCoverage, InteriorOnly>>(
+            coverage, maxRanges, level, numThreads);
+    }
+    GenericRegion generic(r);
+    return runFinder<Finder<GenericRegion, InteriorOnly>>(
+        generic, maxRanges, level, numThreads);
+}
+
+// `findPixelsFrom` locates the pixels intersecting (or within) r like
+// findPixels, but adds them to `s`, and begins the traversal by calling
+// `start(finder)` rather than by visiting the root pixels. This allows the
+// traversal to start at a pixel known to contain r, or to be serially
+// repeated for many regions with one output set. Unlike findPixels, it
+// does not look for a traversal statistics sink, and it dispatches on the
+// exact region type where possible, which is cheaper than a dynamic cast.
+template <
+    template <typename, bool> class Finder,
+    bool InteriorOnly,
+    typename Start
+>
+void findPixelsFrom(RangeSet & s,
+                    Region const & r,
+                    size_t maxRanges,
+                    int level,
+                    Start const & start)
+{
+    std::type_info const & t = typeid(r);
+    if (t == typeid(Circle)) {
+        PreparedCircle prepared(static_cast<Circle const &>(r));
+        Finder<PreparedCircle, InteriorOnly> find(s, prepared, level, maxRanges);
+        start(find);
+    } else if (t == typeid(ConvexPolygon)) {
+        ConvexPolygon const & p = static_cast<ConvexPolygon const &>(r);
+        if (p.getVertices().size() >= SimplifiedPolygon::MIN_VERTICES) {
+            SimplifiedPolygon simplified(p);
+            Finder<SimplifiedPolygon, InteriorOnly> find(
+                s, simplified, level, maxRanges);
+            start(find);
+        } else {
+            Finder<ConvexPolygon, InteriorOnly> find(s, p, level, maxRanges);
+            start(find);
+        }
+    } else if (t == typeid(Box)) {
+        PreparedBox prepared(static_cast<Box const &>(r));
+        Finder<PreparedBox, InteriorOnly> find(s, prepared, level, maxRanges);
+        start(find);
+    } else if (t == typeid(Ellipse)) {
+        findPixelsFrom<Finder, InteriorOnly>(
+            s, *ellipseBound(static_cast<Ellipse const &>(r), !InteriorOnly),
+            maxRanges, level, start);
+    } else if (auto cr = dynamic_cast<CompoundRegion const *>(&r)) {
+        CompiledRegion compiled(*cr);
+        Finder<CompiledRegion, InteriorOnly> find(s, compiled, level, maxRanges);
+        start(find);
+    } else if (auto pr = dynamic_cast<PixelRegion const *>(&r)) {
+        PixelCoverage coverage(pr->getPixelization(), pr->getPixels());
+        Finder<PixelCoverage, InteriorOnly> find(s, coverage, level, maxRanges);
+        start(find);
     } else {
-        Finder<ConvexPolygon, InteriorOnly> find(
-            s, dynamic_cast<ConvexPolygon const &>(r), level, maxRanges);
-        find();
+        GenericRegion generic(r);
+        Finder<GenericRegion, InteriorOnly> find(s, generic, level, maxRanges);
+        start(find);
     }
-    return s;
+}
+
+// `coarsen` reduces the number of ranges in a pixel set to at most
+// `maxRanges` (if it is non-zero) in the way a pixel finder does, by
+// lowering the level one step at a time. Envelopes grow to cover
+// every coarser pixel they intersect, and interiors shrink to the coarser
+// pixels they contain.
+inline void coarsen(RangeSet & s, size_t maxRanges, bool interior) {
+    if (maxRanges == 0) {
+        return;
+    }
+    for (uint32_t shift = 2; s.size() > maxRanges; shift += 2) {
+        if (interior) {
+            s.complement();
+        }
+        s.simplify(shift);
+        if (interior) {
+            s.complement();
+        }
+    }
+}
+
+// `findEnvelopeAndInterior` locates the pixels intersecting r and those
+// within it with a single interior-only traversal that also collects the
+// pixels straddling the boundary of r. Both sets are computed at the target
+// level and then coarsened. Ellipses have different bounds for the two
+// sets, and so are traversed twice.
+template <template <typename, bool> class Finder>
+EnvelopeAndInterior findEnvelopeAndInterior(Region const & r,
+                                            size_t maxRanges,
+                                            int level)
+{
+    EnvelopeAndInterior result;
+    if (typeid(r) == typeid(Ellipse)) {
+        result.envelope = findPixels<Finder, false>(r, maxRanges, level);
+        result.interior = findPixels<Finder, true>(r, maxRanges, level);
+        return result;
+    }
+    RangeSet boundary;
+    findPixelsFrom<Finder, true>(
+        result.interior, r, 0, level,
+        [&](auto & find) {
+            find.collectBoundary(boundary);
+            find();
+        });
+    result.envelope = result.interior | boundary;
+    coarsen(result.envelope, maxRanges, false);
+    coarsen(result.interior, maxRanges, true);
+    return result;
+}
+
+// `findPixelsAtLevels` returns the pixels intersecting (or within) r at
+// each of the given subdivision levels, in the order of `levels`, from a
+// single traversal down to the finest of them. It throws
+// std::invalid_argument if a level is not in [0, maxLevel].
+template <
+    template <typename, bool> class Finder,
+    bool InteriorOnly
+>
+std::vector<RangeSet> findPixelsAtLevels(Region const & r,
+                                         std::vector<int> const & levels,
+                                         int maxLevel)
+{
+    for (int l: levels) {
+        if (l < 0 || l > maxLevel) {
+            throw std::invalid_argument("Invalid subdivision level");
+        }
+    }
+    std::vector<RangeSet> results(levels.size());
+    if (levels.empty()) {
+        return results;
+    }
+    std::vector<int> sorted(levels);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+    std::vector<RangeSet> sets(sorted.size());
+    std::vector<LevelOutput> outputs;
+    for (size_t k = 0; k + 1 < sorted.size(); ++k) {
+        outputs.push_back(LevelOutput{sorted[k], &sets[k]});
+    }
+    findPixelsFrom<Finder, InteriorOnly>(
+        sets.back(), r, 0, sorted.back(),
+        [&](auto & find) {
+            find.setLevelOutputs(outputs.data(),
+                                 outputs.data() + outputs.size());
+            find();
+        });
+    for (size_t i = 0; i < levels.size(); ++i) {
+        size_t k = static_cast<size_t>(
+            std::lower_bound(sorted.begin(), sorted.end(), levels[i]) -
+            sorted.begin());
+        results[i] = sets[k];
+    }
+    return results;
+}
+
+// `coveredFraction` returns the fraction of the area of the pixel polygon p
+// covered by the region r, clamped to at most 1.
+inline double coveredFraction(ConvexPolygon const & p, Region const & r) {
+    return std::min(1.0, overlapArea(p, r) / p.getArea());
+}
+
+// `mergeCoverage` returns the coverage fractions of the pixels in `within`,
+// which are entirely covered by some region, and of `boundary` pixels given
+// as (index, fraction) pairs sorted by index, none of which are in `within`.
+inline CoverageFractions mergeCoverage(
+    RangeSet const & within,
+    std::vector<std::pair<uint64_t, double>> const & boundary)
+{
+    CoverageFractions c;
+    size_t const n = within.size() + boundary.size();
+    c.begin.reserve(n);
+    c.end.reserve(n);
+    c.fraction.reserve(n);
+    auto push = [&c](uint64_t begin, uint64_t end, double fraction) {
+        c.begin.push_back(begin);
+        c.end.push_back(end);
+        c.fraction.push_back(fraction);
+    };
+    auto r = within.begin();
+    for (auto const & p: boundary) {
+        for (; r != within.end() && std::get<0>(*r) < p.first; ++r) {
+            push(std::get<0>(*r), std::get<1>(*r), 1.0);
+        }
+        push(p.first, p.first + 1, p.second);
+    }
+    for (; r != within.end(); ++r) {
+        push(std::get<0>(*r), std::get<1>(*r), 1.0);
+    }
+    return c;
+}
+
+// `runCoverageFinder` computes the coverage fractions of the pixels
+// intersecting a region in a single traversal. Pixels within the region are
+// gathered into ranges as usual, while those at the target level straddling
+// its boundary are collected along with their vertices, and then clipped
+// against the original region r.
+template <typename FinderType>
+CoverageFractions runCoverageFinder(
+    typename FinderType::SearchRegion const & region,
+    Region const & r,
+    int level)
+{
+    using Task = typename FinderType::Task;
+    StatsClaim claim;
+    TraversalStats * stats = claim.get();
+    std::pmr::memory_resource * resource = MemoryResourceScope::current();
+    RangeSet within(resource);
+    typename FinderType::TaskVector leaves(resource);
+    FinderType find(within, region, level, 0);
+    find.setStats(stats);
+    find.collectBoundary(leaves);
+    find();
+    if (stats != nullptr) {
+        stats->finalLevel = level;
+    }
+    std::vector<std::pair<uint64_t, double>> boundary;
+    boundary.reserve(leaves.size());
+    for (Task const & t: leaves) {
+        double f = coveredFraction(ConvexPolygon::fromTrustedVertices(
+            t.pixel, FinderType::NUM_VERTICES), r);
+        if (f > 0.0) {
+            boundary.emplace_back(t.index, f);
+        }
+    }
+    // Traversals that start from a neighborhood of seed pixels need not
+    // visit leaves in index order.
+    std::sort(boundary.begin(), boundary.end());
+    return mergeCoverage(within, boundary);
+}
+
+// `findCoverage` implements Pixelization::coverageFraction, given a
+// PixelFinder subclass for a specific pixelization.
+template <template <typename, bool> class Finder>
+CoverageFractions findCoverage(Region const & r, int level) {
+    if (auto c = dynamic_cast<Circle const *>(&r)) {
+        PreparedCircle prepared(*c);
+        return runCoverageFinder<Finder<PreparedCircle, false>>(
+            prepared, r, level);
+    }
+    if (auto b = dynamic_cast<Box const *>(&r)) {
+        PreparedBox prepared(*b);
+        return runCoverageFinder<Finder<PreparedBox, false>>(
+            prepared, r, level);
+    }
+    if (auto p = dynamic_cast<ConvexPolygon const *>(&r)) {
+        return runCoverageFinder<Finder<ConvexPolygon, false>>(*p, r, level);
+    }
+    throw std::invalid_argument(
+        "coverageFraction only supports ConvexPolygon, Circle and Box regions");
+}
+
+// `findPixels` locates the pixels intersecting (or within) the union of a
+// set of pixels from another pixelization.
+template <
+    template <typename, bool> class Finder,
+    bool InteriorOnly
+>
+RangeSet findPixels(PixelCoverage const & c,
+                    size_t maxRanges,
+                    int level,
+                    unsigned numThreads = 1)
+{
+    return runFinder<Finder<PixelCoverage, InteriorOnly>>(
+        c, maxRanges, level, numThreads);
 }
 
 }}} // namespace lsst::sphgeom::detail
@@ -0,0 +1,332 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the PixelRegion class implementation.
+
+#include "lsst/sphgeom/PixelRegion.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+
+#include "PolygonMerger.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Pixelization kinds, as stored in encoded pixel regions.
+enum : uint8_t { HTM = 0, MQ3C = 1, Q3C = 2, Q3C_HILBERT = 3, HEALPIX = 4 };
+
+// Points tested by the multi-point contains are indexed in blocks of
+// this size.
+constexpr size_t CONTAINS_BLOCK_SIZE = 256;
+
+// Pixel sets with more ranges than this are coarsened before bounding
+// primitives are computed from them.
+constexpr size_t MAX_BOUND_RANGES = 1024;
+
+int getMaxLevel(uint8_t kind) {
+    switch (kind) {
+        case HTM: return HtmPixelization::MAX_LEVEL;
+        case MQ3C: return Mq3cPixelization::MAX_LEVEL;
+        case HEALPIX: return HealpixPixelization::MAX_LEVEL;
+        default: return Q3cPixelization::MAX_LEVEL;
+    }
+}
+
+std::shared_ptr<Pixelization const> makePixelization(uint8_t kind,
+                                                     int level) {
+    switch (kind) {
+        case HTM:
+            return std::make_shared<HtmPixelization>(level);
+        case MQ3C:
+            return std::make_shared<Mq3cPixelization>(level);
+        case Q3C:
+            return std::make_shared<Q3cPixelization>(level);
+        case Q3C_HILBERT:
+            return std::make_shared<Q3cPixelization>(level, 0, true);
+        default:
+            return std::make_shared<HealpixPixelization>(level);
+    }
+}
+
+// `getKind` returns the kind and level of a pixelization, or throws if
+// its type is not supported.
+std::tuple<uint8_t, int> getKind(Pixelization const & p) {
+    if (auto htm = dynamic_cast<HtmPixelization const *>(&p)) {
+        return std::make_tuple(HTM, htm->getLevel());
+    } else if (auto mq3c = dynamic_cast<Mq3cPixelization const *>(&p)) {
+        return std::make_tuple(MQ3C, mq3c->getLevel());
+    } else if (auto q3c = dynamic_cast<Q3cPixelization const *>(&p)) {
+        return std::make_tuple(q3c->isHilbertOrder() ? Q3C_HILBERT : Q3C,
+                               q3c->getLevel());
+    } else if (auto hp = dynamic_cast<HealpixPixelization const *>(&p)) {
+        return std::make_tuple(HEALPIX, hp->getLevel());
+    }
+    throw std::invalid_argument("Unsupported PixelRegion pixelization");
+}
+
+// `forEachBlock` calls f(k, i) for the largest aligned blocks of pixels
+// in `pixels`, a set of pixels at the given level, where i is the index of
+// the pixel at level `level - k` made up of the pixels of the block.
+//
+// All supported pixelizations are hierarchical, so that pixel I at level
+// L - k is made up of pixels [I*4ᵏ, (I + 1)*4ᵏ) at level L. Each range is
+// split into the largest aligned blocks it contains, which merges complete
+// groups of sibling pixels into their parent at each level.
+template <typename F>
+void forEachBlock(int level, RangeSet const & pixels, F f) {
+    for (auto const & r: pixels) {
+        uint64_t i = std::get<0>(r);
+        uint64_t const end = std::get<1>(r);
+        while (i != end) {
+            int k = 0;
+            while (k < level && (i & ((uint64_t(4) << (2 * k)) - 1)) == 0 &&
+                   end - i >= (uint64_t(4) << (2 * k))) {
+                ++k;
+            }
+            f(k, i >> (2 * k));
+            i += uint64_t(1) << (2 * k);
+        }
+    }
+}
+
+// `unionBounds` returns the union of the bounds of the pixels in `pixels`,
+// a set of pixels from the pixelization of the given kind and level.
+//
+// The pixel set is first coarsened until it has few ranges, so that only
+// one pixel per aligned block of its ranges has to be bounded.
+template <typename T, typename F>
+T unionBounds(uint8_t kind, int level, RangeSet pixels, F bound) {
+    while (pixels.size() > MAX_BOUND_RANGES && level > 0) {
+        pixels.coarsen(1);
+        --level;
+    }
+    std::vector<std::shared_ptr<Pixelization const>> pixelizations(
+        static_cast<size_t>(level) + 1);
+    T result = T::empty();
+    forEachBlock(level, pixels, [&](int k, uint64_t i) {
+        auto & p = pixelizations[level - k];
+        if (!p) {
+            p = makePixelization(kind, level - k);
+        }
+        result.expandTo(bound(*p->pixel(i)));
+    });
+    return result;
+}
+
+} // unnamed namespace
+
+PixelRegion::PixelRegion(Pixelization const & pixelization,
+                         RangeSet pixels) :
+    _pixels(std::move(pixels))
+{
+    std::tie(_kind, _level) = getKind(pixelization);
+    if (!_pixels.isWithin(pixelization.universe())) {
+        throw std::invalid_argument(
+            "PixelRegion pixels must belong to the pixelization universe");
+    }
+    _pixelization = makePixelization(_kind, _level);
+}
+
+PixelRegion::PixelRegion(std::shared_ptr<Pixelization const> pixelization,
+                         uint8_t kind, int level, RangeSet pixels) :
+    _pixelization(std::move(pixelization)),
+    _pixels(std::move(pixels)),
+    _kind(kind),
+    _level(level)
+{}
+
+Box PixelRegion::getBoundingBox() const {
+    return _bounds.getBoundingBox([this]() {
+        return unionBounds<Box>(_kind, _level, _pixels, [](Region const & r) {
+            return r.getBoundingBox();
+        });
+    });
+}
+
+Box3d PixelRegion::getBoundingBox3d() const {
+    return _bounds.getBoundingBox3d([this]() {
+        return unionBounds<Box3d>(_kind, _level, _pixels,
+                                  [](Region const & r) {
+            return r.getBoundingBox3d();
+        });
+    });
+}
+
+Circle PixelRegion::getBoundingCircle() const {
+    return _bounds.getBoundingCircle([this]() {
+        return unionBounds<Circle>(_kind, _level, _pixels,
+                                   [](Region const & r) {
+            return r.getBoundingCircle();
+        });
+    });
+}
+
+void PixelRegion::contains(double const * x, double const * y,
+                           double const * z, bool * out, size_t n) const
+{
+    uint64_t indexes[CONTAINS_BLOCK_SIZE];
+    for (size_t i = 0; i < n; i += CONTAINS_BLOCK_SIZE) {
+        size_t const m = std::min(CONTAINS_BLOCK_SIZE, n - i);
+        _pixelization->index(x + i, y + i, z + i, indexes, m);
+        _pixels.contains(indexes, m, out + i);
+    }
+}
+
+Relationship PixelRegion::relate(Region const & r) const {
+    auto p = dynamic_cast<PixelRegion const *>(&r);
+    if (p == nullptr || p->_kind != _kind || p->_level != _level) {
+        return _relate(r);
+    }
+    // Both regions are made up of pixels of the same pixelization, so
+    // their relationship follows from that of their pixel sets.
+    RangeSet const & s = p->_pixels;
+    Relationship result;
+    if (_pixels.isDisjointFrom(s)) {
+        result |= DISJOINT;
+    }
+    if (_pixels.contains(s)) {
+        result |= CONTAINS;
+    }
+    if (_pixels.isWithin(s)) {
+        result |= WITHIN;
+    }
+    return result;
+}
+
+Relationship PixelRegion::relate(Box const & b) const { return _relate(b); }
+
+Relationship PixelRegion::relate(Circle const & c) const {
+    return _relate(c);
+}
+
+Relationship PixelRegion::relate(ConvexPolygon const & p) const {
+    return _relate(p);
+}
+
+Relationship PixelRegion::relate(Ellipse const & e) const {
+    return _relate(e);
+}
+
+Relationship PixelRegion::_relate(Region const & r) const {
+    if (_pixels.empty()) {
+        return DISJOINT | WITHIN;
+    }
+    if (getBoundingBox3d().isDisjointFrom(r.getBoundingBox3d())) {
+        return DISJOINT;
+    }
+    // Every point of r belongs to a pixel of its envelope, so this region
+    // contains r if its pixels include the envelope, and is disjoint from
+    // r if it has no pixels in common with it.
+    RangeSet const envelope = _pixelization->envelope(r);
+    if (_pixels.isDisjointFrom(envelope)) {
+        return envelope.empty() ? (DISJOINT | CONTAINS) : DISJOINT;
+    }
+    Relationship result;
+    if (_pixels.contains(envelope)) {
+        result |= CONTAINS;
+    }
+    // This region can only be within r if all of its pixels intersect r,
+    // which avoids computing the interior of r in most cases.
+    if (envelope.contains(_pixels) &&
+        _pixelization->interior(r).contains(_pixels)) {
+        result |= WITHIN;
+    }
+    return result;
+}
+
+std::vector<ConvexPolygon> PixelRegion::getPolygons() const {
+    std::vector<std::shared_ptr<Pixelization const>> pixelizations(
+        static_cast<size_t>(_level) + 1);
+    pixelizations[_level] = _pixelization;
+    detail::PolygonMerger merger;
+    forEachBlock(_level, _pixels, [&](int k, uint64_t i) {
+        auto & p = pixelizations[_level - k];
+        if (!p) {
+            p = makePixelization(_kind, _level - k);
+        }
+        // The pixels of all supported pixelizations are convex polygons.
+        std::unique_ptr<Region> pixel = p->pixel(i);
+        merger.add(static_cast<ConvexPolygon const &>(*pixel));
+    });
+    return merger.merge();
+}
+
+std::unique_ptr<UnionRegion> PixelRegion::toUnionRegion() const {
+    std::vector<std::unique_ptr<Region>> operands;
+    for (ConvexPolygon & p: getPolygons()) {
+        operands.emplace_back(new ConvexPolygon(std::move(p)));
+    }
+    return std::unique_ptr<UnionRegion>(new UnionRegion(std::move(operands)));
+}
+
+std::vector<uint8_t> PixelRegion::encode() const {
+    std::vector<uint8_t> buffer;
+    encodeTo(buffer);
+    return buffer;
+}
+
+void PixelRegion::encodeTo(std::vector<uint8_t> & buffer) const {
+    buffer.push_back(TYPE_CODE);
+    buffer.push_back(_kind);
+    buffer.push_back(static_cast<uint8_t>(_level));
+    std::vector<uint8_t> s = _pixels.encode();
+    buffer.insert(buffer.end(), s.begin(), s.end());
+}
+
+std::unique_ptr<PixelRegion> PixelRegion::decode(uint8_t const * buffer,
+                                                 size_t n)
+{
+    if (buffer == nullptr || n < 3 || buffer[0] != TYPE_CODE ||
+        buffer[1] > HEALPIX || buffer[2] > getMaxLevel(buffer[1])) {
+        throw std::runtime_error("Byte-string is not an encoded PixelRegion");
+    }
+    uint8_t const kind = buffer[1];
+    int const level = buffer[2];
+    RangeSet pixels = RangeSet::decode(buffer + 3, n - 3);
+    std::shared_ptr<Pixelization const> pixelization =
+        makePixelization(kind, level);
+    if (!pixels.isWithin(pixelization->universe())) {
+        throw std::runtime_error(
+            "Encoded PixelRegion contains invalid pixel indexes");
+    }
+    return std::unique_ptr<PixelRegion>(new PixelRegion(
+        std::move(pixelization), kind, level, std::move(pixels)));
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,403 @@
+/*
+ * LSST Data Management System
+ * Copyright 2016 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the Pixelization class implementation.
+
+#include "lsst/sphgeom/Pixelization.h"
+
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/TraversalStats.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "Parallel.h"
+#include "PixelFinder.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Points indexed by the multi-threaded index are handed out to threads in
+// blocks of this size.
+constexpr size_t INDEX_BLOCK_SIZE = 16384;
+
+} // unnamed namespace
+
+void Pixelization::index(double const * x,
+                         double const * y,
+                         double const * z,
+                         uint64_t * out,
+                         size_t n) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = index(UnitVector3d(x[i], y[i], z[i]));
+    }
+}
+
+void Pixelization::index(double const * x,
+                         double const * y,
+                         double const * z,
+                         uint64_t * out,
+                         size_t n,
+                         unsigned numThreads) const
+{
+    detail::forEachBlock(n, INDEX_BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        index(x + begin, y + begin, z + begin, out + begin, end - begin);
+    });
+}
+
+void Pixelization::index(UnitVector3dArray const & points,
+                         uint64_t * out) const
+{
+    index(points.x(), points.y(), points.z(), out, points.size());
+}
+
+void Pixelization::toString(uint64_t const * indexes,
+                            size_t n,
+                            char * out,
+                            size_t width) const
+{
+    for (size_t k = 0; k < n; ++k, out += width) {
+        std::string s = toString(indexes[k]);
+        if (s.size() > width) {
+            throw std::invalid_argument(
+                "Pixel index string is longer than the field width");
+        }
+        std::fill(std::copy(s.begin(), s.end(), out), out + width, '\0');
+    }
+}
+
+void Pixelization::fromString(char const * in,
+                              size_t n,
+                              size_t width,
+                              uint64_t * out) const
+{
+    for (size_t k = 0; k < n; ++k, in += width) {
+        size_t len = width;
+        while (len > 0 && in[len - 1] == '\0') {
+            --len;
+        }
+        out[k] = fromString(in, len);
+    }
+}
+
+RangeSet FlatRangeSets::get(size_t i) const {
+    if (i >= size()) {
+        throw std::out_of_range("FlatRangeSets index out of range");
+    }
+    RangeSet s;
+    for (size_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+        s.append(bounds[2 * j], bounds[2 * j + 1]);
+    }
+    return s;
+}
+
+namespace {
+
+// Regions of a batch are handed out to threads in blocks of this size.
+constexpr size_t MANY_BLOCK_SIZE = 256;
+
+// Batched regions are sorted by the modified Q3C index of their bounding
+// circle centers at this level, where pixels are about 0.2 arcsec wide.
+constexpr int MANY_SORT_LEVEL = 20;
+
+// `StatsSuppression` clears the traversal statistics sink of the current
+// thread for its lifetime.
+class StatsSuppression {
+public:
+    StatsSuppression() : _stats{TraversalStatsScope::release()} {}
+    ~StatsSuppression() { TraversalStatsScope::restore(_stats); }
+
+    StatsSuppression(StatsSuppression const &) = delete;
+    StatsSuppression & operator=(StatsSuppression const &) = delete;
+
+private:
+    TraversalStats * _stats;
+};
+
+// `collectFlat` stores the pixel sets that `run` passes to the sink it is
+// given in a FlatRangeSets. The sets of each block of regions are gathered
+// separately, and copied into place once all have been computed.
+template <typename Run>
+FlatRangeSets collectFlat(size_t n, Run const & run) {
+    size_t const numBlocks = (n + MANY_BLOCK_SIZE - 1) / MANY_BLOCK_SIZE;
+    std::vector<std::vector<uint64_t>> blocks(numBlocks);
+    std::vector<size_t> position(n);
+    std::vector<size_t> start(n);
+    FlatRangeSets result;
+    result.offsets.assign(n + 1, 0);
+    run([&](size_t p, size_t i, RangeSet & s) {
+        std::vector<uint64_t> & bounds = blocks[p / MANY_BLOCK_SIZE];
+        position[i] = p;
+        start[i] = bounds.size();
+        result.offsets[i + 1] = s.size();
+        for (auto const & r: s) {
+            bounds.push_back(std::get<0>(r));
+            bounds.push_back(std::get<1>(r));
+        }
+    });
+    for (size_t i = 0; i < n; ++i) {
+        result.offsets[i + 1] += result.offsets[i];
+    }
+    result.bounds.resize(2 * result.offsets[n]);
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t const * b = blocks[position[i] / MANY_BLOCK_SIZE].data() + start[i];
+        std::copy(b, b + 2 * (result.offsets[i + 1] - result.offsets[i]),
+                  result.bounds.begin() + 2 * result.offsets[i]);
+    }
+    return result;
+}
+
+// `limitRanges` coarsens s until it has at most `maxRanges` ranges, by
+// expanding ranges outwards, or by shrinking them inwards if `interior`
+// is true.
+void limitRanges(RangeSet & s, size_t maxRanges, bool interior) {
+    uint32_t shift = 0;
+    while (maxRanges != 0 && s.size() > maxRanges) {
+        shift += 2;
+        if (interior) {
+            s.complement();
+        }
+        s.simplify(shift);
+        if (interior) {
+            s.complement();
+        }
+    }
+}
+
+} // unnamed namespace
+
+std::vector<RangeSet> Pixelization::envelopeMany(
+    std::vector<Region const *> const & regions,
+    size_t maxRanges,
+    unsigned numThreads) const
+{
+    std::vector<RangeSet> results(regions.size());
+    _findManyOrdered(regions, maxRanges, numThreads, false,
+                     [&](size_t, size_t i, RangeSet & s) { results[i].swap(s); });
+    return results;
+}
+
+std::vector<RangeSet> Pixelization::interiorMany(
+    std::vector<Region const *> const & regions,
+    size_t maxRanges,
+    unsigned numThreads) const
+{
+    std::vector<RangeSet> results(regions.size());
+    _findManyOrdered(regions, maxRanges, numThreads, true,
+                     [&](size_t, size_t i, RangeSet & s) { results[i].swap(s); });
+    return results;
+}
+
+EnvelopeUpdate Pixelization::updateEnvelope(Region const & previous,
+                                            RangeSet const & previousEnvelope,
+                                            Region const & r,
+                                            size_t maxRanges,
+                                            unsigned numThreads) const
+{
+    EnvelopeUpdate update;
+    if (&previous == &r || previous.encode() == r.encode()) {
+        update.envelope = previousEnvelope;
+        return update;
+    }
+    update.envelope = _envelope(r, maxRanges, numThreads);
+    update.added = update.envelope - previousEnvelope;
+    update.removed = previousEnvelope - update.envelope;
+    return update;
+}
+
+FlatRangeSets Pixelization::envelopeManyFlat(
+    std::vector<Region const *> const & regions,
+    size_t maxRanges,
+    unsigned numThreads) const
+{
+    return collectFlat(regions.size(), [&](auto const & sink) {
+        _findManyOrdered(regions, maxRanges, numThreads, false, sink);
+    });
+}
+
+FlatRangeSets Pixelization::interiorManyFlat(
+    std::vector<Region const *> const & regions,
+    size_t maxRanges,
+    unsigned numThreads) const
+{
+    return collectFlat(regions.size(), [&](auto const & sink) {
+        _findManyOrdered(regions, maxRanges, numThreads, true, sink);
+    });
+}
+
+void Pixelization::_findMany(Region const * const * regions,
+                             size_t n,
+                             size_t maxRanges,
+                             bool interior,
+                             RangeSetSink const & sink) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        RangeSet s = interior ? _interior(*regions[i], maxRanges, 1)
+                              : _envelope(*regions[i], maxRanges, 1);
+        sink(i, s);
+    }
+}
+
+void Pixelization::_findManyOrdered(
+    std::vector<Region const *> const & regions,
+    size_t maxRanges,
+    unsigned numThreads,
+    bool interior,
+    std::function<void(size_t, size_t, RangeSet &)> const & sink) const
+{
+    size_t const n = regions.size();
+    for (Region const * r: regions) {
+        if (r == nullptr) {
+            throw std::invalid_argument("Regions must not be null");
+        }
+    }
+    StatsSuppression suppression;
+    // Order regions along a space filling curve through the centers of
+    // their bounding circles, breaking ties by position to keep the order
+    // deterministic. Modified Q3C indexes are much cheaper to compute than
+    // indexes in deep HTM pixelizations, and order points just as well.
+    static Mq3cPixelization const curve(MANY_SORT_LEVEL);
+    std::vector<std::pair<uint64_t, size_t>> order(n);
+    detail::forEachBlock(n, MANY_BLOCK_SIZE, numThreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            order[i] = std::make_pair(curve.index(regions[i]->getBoundingCircle().getCenter()), i);
+        }
+    });
+    std::sort(order.begin(), order.end());
+    detail::forEachBlock(n, MANY_BLOCK_SIZE, numThreads, [&](size_t begin, size_t end) {
+        Region const * block[MANY_BLOCK_SIZE];
+        for (size_t p = begin; p < end; ++p) {
+            block[p - begin] = regions[order[p].second];
+        }
+        _findMany(block, end - begin, maxRanges, interior, [&](size_t j, RangeSet & s) {
+            sink(begin + j, order[begin + j].second, s);
+        });
+    });
+}
+
+RangeSet Pixelization::_adaptiveEnvelope(Region const & r,
+                                         size_t targetRanges,
+                                         double) const
+{
+    return _envelope(r, targetRanges, 1);
+}
+
+RangeSet Pixelization::_adaptiveInterior(Region const & r,
+                                         size_t targetRanges,
+                                         double) const
+{
+    return _interior(r, targetRanges, 1);
+}
+
+ProgressiveEnvelope Pixelization::_progressiveEnvelope(Region const & r) const {
+    return ProgressiveEnvelope(
+        std::unique_ptr<detail::ProgressiveEnvelopeState>(
+            new detail::ProgressiveEnvelopeState(_envelope(r, 0, 1))));
+}
+
+EnvelopeAndInterior Pixelization::_envelopeAndInterior(Region const & r,
+                                                       size_t maxRanges) const
+{
+    EnvelopeAndInterior result;
+    result.envelope = _envelope(r, maxRanges, 1);
+    result.interior = _interior(r, maxRanges, 1);
+    return result;
+}
+
+CoverageFractions Pixelization::_coverageFraction(Region const & r) const {
+    if (dynamic_cast<ConvexPolygon const *>(&r) == nullptr &&
+        dynamic_cast<Circle const *>(&r) == nullptr &&
+        dynamic_cast<Box const *>(&r) == nullptr) {
+        throw std::invalid_argument("coverageFraction only supports "
+                                    "ConvexPolygon, Circle and Box regions");
+    }
+    RangeSet within = _interior(r, 0, 1);
+    RangeSet candidates = _envelope(r, 0, 1) - within;
+    std::vector<std::pair<uint64_t, double>> boundary;
+    for (auto const & range: candidates) {
+        for (uint64_t i = std::get<0>(range); i != std::get<1>(range); ++i) {
+            std::unique_ptr<Region> p = pixel(i);
+            auto polygon = dynamic_cast<ConvexPolygon const *>(p.get());
+            if (polygon == nullptr) {
+                throw std::invalid_argument(
+                    "coverageFraction requires polygonal pixels");
+            }
+            double f = detail::coveredFraction(*polygon, r);
+            if (f > 0.0) {
+                boundary.emplace_back(i, f);
+            }
+        }
+    }
+    return detail::mergeCoverage(within, boundary);
+}
+
+RangeSet Pixelization::_envelope(Pixelization const & from,
+                                 RangeSet const & pixels,
+                                 size_t maxRanges,
+                                 unsigned numThreads) const
+{
+    RangeSet s;
+    for (auto const & r: pixels) {
+        for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+            s |= envelope(*from.pixel(i), 0, numThreads);
+        }
+    }
+    limitRanges(s, maxRanges, false);
+    return s;
+}
+
+RangeSet Pixelization::_interior(Pixelization const & from,
+                                 RangeSet const & pixels,
+                                 size_t maxRanges,
+                                 unsigned numThreads) const
+{
+    RangeSet candidates = Pixelization::_envelope(from, pixels, 0, numThreads);
+    RangeSet s;
+    for (auto const & r: candidates) {
+        for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+            if (pixels.contains(from.envelope(*pixel(i), 0, numThreads))) {
+                s.insert(i);
+            }
+        }
+    }
+    limitRanges(s, maxRanges, true);
+    return s;
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,370 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the PointIndex class implementation.
+
+#include "lsst/sphgeom/PointIndex.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Index data consists of 64 bit words. It starts with a header giving the
+// magic number and version of the format, the subdivision level, the number
+// of points n, and the number of non-empty pixels m. This is followed by
+// the m pixel indexes, the m + 1 point offsets of the pixels, the x, y and
+// z components of the n points in pixel order, and the n point indexes.
+constexpr uint64_t MAGIC = 0x7864697067687073; // "sphgpidx"
+constexpr uint64_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 5;
+
+size_t numWords(size_t numPoints, size_t numPixels) {
+    return HEADER_SIZE + 2 * numPixels + 1 + 4 * numPoints;
+}
+
+// `parallelFor` calls `task(i)` for i in [0, n), using up to `numThreads`
+// threads. Tasks are handed out one at a time, and the first exception
+// thrown by a task is rethrown once all threads have finished.
+template <typename F>
+void parallelFor(size_t n, unsigned numThreads, F const & task) {
+    if (numThreads <= 1 || n <= 1) {
+        for (size_t i = 0; i < n; ++i) {
+            task(i);
+        }
+        return;
+    }
+    std::atomic<size_t> next{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto work = [&]() {
+        try {
+            for (size_t i = next++; i < n && !failed; i = next++) {
+                task(i);
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            failed = true;
+        }
+    };
+    numThreads = static_cast<unsigned>(std::min<size_t>(numThreads, n));
+    detail::runInParallel(numThreads, work);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+using Key = std::pair<uint64_t, uint64_t>;
+
+// `sortKeys` sorts the given (pixel index, point index) pairs. With
+// multiple threads, chunks of the keys are sorted concurrently, and then
+// merged pairwise in rounds.
+void sortKeys(std::vector<Key> & keys, unsigned numThreads) {
+    size_t const numChunks = std::max<size_t>(
+        1, std::min<size_t>(numThreads, keys.size() / 65536));
+    std::vector<size_t> bounds;
+    for (size_t c = 0; c <= numChunks; ++c) {
+        bounds.push_back(keys.size() * c / numChunks);
+    }
+    parallelFor(numChunks, numThreads, [&](size_t c) {
+        std::sort(keys.begin() + bounds[c], keys.begin() + bounds[c + 1]);
+    });
+    while (bounds.size() > 2) {
+        size_t const numMerges = (bounds.size() - 1) / 2;
+        parallelFor(numMerges, numThreads, [&](size_t m) {
+            std::inplace_merge(keys.begin() + bounds[2 * m],
+                               keys.begin() + bounds[2 * m + 1],
+                               keys.begin() + bounds[2 * m + 2]);
+        });
+        std::vector<size_t> merged;
+        for (size_t c = 0; c < bounds.size(); c += 2) {
+            merged.push_back(bounds[c]);
+        }
+        if (merged.back() != bounds.back()) {
+            merged.push_back(bounds.back());
+        }
+        bounds.swap(merged);
+    }
+}
+
+std::runtime_error notAnIndex(std::string const & path) {
+    return std::runtime_error("File " + path + " does not contain a PointIndex");
+}
+
+} // unnamed namespace
+
+
+PointIndex::PointIndex() : PointIndex(UnitVector3dArray(), 0) {}
+
+PointIndex::PointIndex(UnitVector3dArray const & points,
+                       int level,
+                       unsigned numThreads) :
+    _pixelization(level)
+{
+    size_t const n = points.size();
+    // Sort the points by pixel, and then by index.
+    std::vector<Key> keys(n);
+    size_t const numBlocks = (n + 65535) / 65536;
+    parallelFor(numBlocks, numThreads, [&](size_t b) {
+        size_t const begin = b * 65536;
+        size_t const end = std::min(n, begin + 65536);
+        std::vector<uint64_t> p(end - begin);
+        _pixelization.index(points.x() + begin, points.y() + begin,
+                            points.z() + begin, p.data(), end - begin);
+        for (size_t i = begin; i < end; ++i) {
+            keys[i] = Key(p[i - begin], i);
+        }
+    });
+    sortKeys(keys, numThreads);
+    size_t m = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0 || keys[i].first != keys[i - 1].first) {
+            ++m;
+        }
+    }
+    size_t const size = numWords(n, m);
+    std::shared_ptr<uint64_t> data(new uint64_t[size],
+                                   std::default_delete<uint64_t[]>());
+    uint64_t * w = data.get();
+    w[0] = MAGIC;
+    w[1] = VERSION;
+    w[2] = static_cast<uint64_t>(level);
+    w[3] = n;
+    w[4] = m;
+    uint64_t * pixels = w + HEADER_SIZE;
+    uint64_t * offsets = pixels + m;
+    double * x = reinterpret_cast<double *>(offsets + m + 1);
+    double * y = x + n;
+    double * z = y + n;
+    uint64_t * indexes = reinterpret_cast<uint64_t *>(z + n);
+    size_t j = 0;
+    for (size_t i = 0; i < n; ++i) {
+        if (i == 0 || keys[i].first != keys[i - 1].first) {
+            pixels[j] = keys[i].first;
+            offsets[j] = i;
+            ++j;
+        }
+    }
+    offsets[m] = n;
+    parallelFor(numBlocks, numThreads, [&](size_t b) {
+        size_t const begin = b * 65536;
+        size_t const end = std::min(n, begin + 65536);
+        for (size_t i = begin; i < end; ++i) {
+            size_t k = keys[i].second;
+            x[i] = points.x()[k];
+            y[i] = points.y()[k];
+            z[i] = points.z()[k];
+            indexes[i] = k;
+        }
+    });
+    _init(data, size);
+}
+
+PointIndex PointIndex::open(std::string const & path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat s;
+    if (::fstat(fd, &s) != 0 ||
+        static_cast<size_t>(s.st_size) < HEADER_SIZE * sizeof(uint64_t) ||
+        s.st_size % sizeof(uint64_t) != 0) {
+        ::close(fd);
+        throw notAnIndex(path);
+    }
+    size_t const bytes = static_cast<size_t>(s.st_size);
+    void * addr = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        throw std::runtime_error("Cannot memory-map " + path);
+    }
+    std::shared_ptr<uint64_t const> data(
+        static_cast<uint64_t const *>(addr),
+        [bytes](uint64_t const * p) {
+            ::munmap(const_cast<uint64_t *>(p), bytes);
+        });
+    uint64_t const * w = data.get();
+    size_t const size = bytes / sizeof(uint64_t);
+    if (w[0] != MAGIC || w[1] != VERSION ||
+        w[2] > static_cast<uint64_t>(Mq3cPixelization::MAX_LEVEL) ||
+        w[3] > size || w[4] > size || numWords(w[3], w[4]) != size) {
+        throw notAnIndex(path);
+    }
+    PointIndex index;
+    index._pixelization = Mq3cPixelization(static_cast<int>(w[2]));
+    index._init(data, size);
+    return index;
+}
+
+void PointIndex::write(std::string const & path) const {
+    std::FILE * f = std::fopen(path.c_str(), "wb");
+    if (f == nullptr) {
+        throw std::runtime_error("Cannot open " + path + " for writing");
+    }
+    bool ok = std::fwrite(_data.get(), sizeof(uint64_t), _size, f) == _size;
+    ok = (std::fclose(f) == 0) && ok;
+    if (!ok) {
+        throw std::runtime_error("Cannot write PointIndex to " + path);
+    }
+}
+
+void PointIndex::_init(std::shared_ptr<uint64_t const> data, size_t size) {
+    _data = std::move(data);
+    _size = size;
+    uint64_t const * w = _data.get();
+    _numPoints = static_cast<size_t>(w[3]);
+    _numPixels = static_cast<size_t>(w[4]);
+    _pixels = w + HEADER_SIZE;
+    _offsets = _pixels + _numPixels;
+    _x = reinterpret_cast<double const *>(_offsets + _numPixels + 1);
+    _y = _x + _numPoints;
+    _z = _y + _numPoints;
+    _indexes = reinterpret_cast<uint64_t const *>(_z + _numPoints);
+}
+
+std::pair<size_t, size_t> PointIndex::_span(uint64_t b, uint64_t e) const {
+    uint64_t const * end = _pixels + _numPixels;
+    size_t i = std::lower_bound(_pixels, end, b) - _pixels;
+    // An end of 0 denotes 2^64.
+    size_t j = (e == 0) ? _numPixels
+                        : std::lower_bound(_pixels, end, e) - _pixels;
+    return std::make_pair(static_cast<size_t>(_offsets[i]),
+                          static_cast<size_t>(_offsets[j]));
+}
+
+std::vector<size_t> PointIndex::findWithin(UnitVector3d const & v,
+                                           Angle radius) const
+{
+    std::vector<size_t> result;
+    Circle c(v, radius);
+    if (c.isEmpty() || empty()) {
+        return result;
+    }
+    // Full circles contain every point, including those with squared
+    // chord lengths that exceed 4 because of rounding.
+    double const d2 = c.isFull() ? HUGE_VAL : c.getSquaredChordLength();
+    for (auto const & r: _pixelization.envelope(c)) {
+        size_t b, e;
+        std::tie(b, e) = _span(std::get<0>(r), std::get<1>(r));
+        for (size_t i = b; i < e; ++i) {
+            double dx = _x[i] - v.x();
+            double dy = _y[i] - v.y();
+            double dz = _z[i] - v.z();
+            if (dx * dx + dy * dy + dz * dz <= d2) {
+                result.push_back(static_cast<size_t>(_indexes[i]));
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+std::vector<std::pair<size_t, Angle>> PointIndex::findNearest(
+    UnitVector3d const & v,
+    size_t k) const
+{
+    std::vector<std::pair<size_t, Angle>> result;
+    if (k == 0 || empty()) {
+        return result;
+    }
+    // A max-heap of the k nearest (squared chord length, index) pairs
+    // found so far.
+    std::vector<std::pair<double, size_t>> heap;
+    heap.reserve(std::min(k, _numPoints));
+    auto scan = [&](RangeSet const & pixels) {
+        for (auto const & r: pixels) {
+            size_t b, e;
+            std::tie(b, e) = _span(std::get<0>(r), std::get<1>(r));
+            for (size_t i = b; i < e; ++i) {
+                double dx = _x[i] - v.x();
+                double dy = _y[i] - v.y();
+                double dz = _z[i] - v.z();
+                std::pair<double, size_t> p(dx * dx + dy * dy + dz * dz,
+                                            static_cast<size_t>(_indexes[i]));
+                if (heap.size() < k) {
+                    heap.push_back(p);
+                    std::push_heap(heap.begin(), heap.end());
+                } else if (p < heap.front()) {
+                    std::pop_heap(heap.begin(), heap.end());
+                    heap.back() = p;
+                    std::push_heap(heap.begin(), heap.end());
+                }
+            }
+        }
+    };
+    // After r rings of neighbors have been added to the pixel containing v,
+    // every unvisited point is separated from v by r pixels. The distance
+    // between opposite edges of a modified Q3C pixel is at least about
+    // 1.06 * 2^-L radians, so such points are further than r * 2^-L radians
+    // from v.
+    RangeSet const universe = _pixelization.universe();
+    double const width = std::ldexp(1.0, -getLevel());
+    RangeSet ring(_pixelization.index(v));
+    RangeSet visited = ring;
+    for (int r = 0; ; ++r) {
+        scan(ring);
+        if (heap.size() == k && heap.front().first <=
+                Circle::squaredChordLengthFor(Angle(r * width))) {
+            break;
+        }
+        if (visited == universe) {
+            break;
+        }
+        ring = _pixelization.dilate(ring, 1) - visited;
+        visited |= ring;
+    }
+    std::sort_heap(heap.begin(), heap.end());
+    result.reserve(heap.size());
+    for (auto const & p: heap) {
+        result.emplace_back(p.second, Circle::openingAngleFor(p.first));
+    }
+    return result;
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,312 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+/// \file
+/// \brief This file contains the PolygonMerger class implementation.
+
+#include "PolygonMerger.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "lsst/sphgeom/Vector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+namespace {
+
+// Vertex coordinates are rounded to multiples of 1/VERTEX_GRID to decide
+// whether two vertices are the same.
+constexpr double VERTEX_GRID = 1099511627776.0; // 2^40
+
+// Three vertices are on the same great circle if the triple product of
+// their coordinates is at most this times the sum of the lengths of the
+// two edges they form. This bounds the distance of the middle vertex from
+// the great circle through the other two.
+constexpr double COLLINEARITY_TOLERANCE = 1.0e-14;
+
+// Merged pieces have at most this many vertices, including those where
+// the boundary goes straight on.
+constexpr size_t MAX_PIECE_VERTICES = 256;
+
+// Merged pieces must have edges shorter than this chord length (that of
+// 120 degrees), which rules out pieces that are not strictly convex, such
+// as lunes.
+constexpr double MAX_SQUARED_EDGE_CHORD = 3.0;
+
+uint64_t edgeKey(uint32_t a, uint32_t b) {
+    return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+} // unnamed namespace
+
+void PolygonMerger::add(ConvexPolygon const & p) {
+    Piece piece;
+    for (UnitVector3d const & v: p.getVertices()) {
+        uint32_t id = _getVertexId(v);
+        if (piece.empty() || (piece.back() != id && piece.front() != id)) {
+            piece.push_back(id);
+        }
+    }
+    if (piece.size() >= 3) {
+        _pieces.push_back(std::move(piece));
+    }
+}
+
+std::vector<ConvexPolygon> PolygonMerger::merge() {
+    uint32_t const n = static_cast<uint32_t>(_pieces.size());
+    std::unordered_multimap<uint32_t, uint32_t> next;
+    for (Piece const & piece: _pieces) {
+        for (size_t i = 0; i < piece.size(); ++i) {
+            next.emplace(piece[i], piece[(i + 1) % piece.size()]);
+        }
+    }
+    _edges.clear();
+    for (uint32_t p = 0; p < n; ++p) {
+        _insertEdges(p);
+    }
+    for (uint32_t p = 0; p < n; ++p) {
+        _split(p, next);
+    }
+    for (bool merged = true; merged;) {
+        merged = false;
+        for (uint32_t p = 0; p < n; ++p) {
+            // Keep growing piece p until none of its neighbors fit.
+            for (size_t i = 0; i < _pieces[p].size(); ++i) {
+                Piece const & piece = _pieces[p];
+                uint32_t const a = piece[i];
+                uint32_t const b = piece[(i + 1) % piece.size()];
+                auto e = _edges.find(edgeKey(b, a));
+                if (e != _edges.end() && e->second != p &&
+                    _merge(p, e->second)) {
+                    merged = true;
+                    i = static_cast<size_t>(-1);
+                }
+            }
+        }
+    }
+    std::vector<ConvexPolygon> result;
+    std::vector<UnitVector3d> vertices;
+    for (Piece const & piece: _pieces) {
+        size_t const m = piece.size();
+        if (m == 0) {
+            continue;
+        }
+        vertices.clear();
+        for (size_t i = 0; i < m; ++i) {
+            if (_turn(piece[(i + m - 1) % m], piece[i],
+                      piece[(i + 1) % m]) != 0) {
+                vertices.push_back(_vertices[piece[i]]);
+            }
+        }
+        result.push_back(ConvexPolygon::convexHull(vertices));
+    }
+    return result;
+}
+
+uint32_t PolygonMerger::_getVertexId(UnitVector3d const & v) {
+    std::array<int64_t, 3> key = {
+        std::llround(v.x() * VERTEX_GRID),
+        std::llround(v.y() * VERTEX_GRID),
+        std::llround(v.z() * VERTEX_GRID)
+    };
+    auto i = _vertexIds.emplace(key, static_cast<uint32_t>(_vertices.size()));
+    if (i.second) {
+        _vertices.push_back(v);
+    }
+    return i.first->second;
+}
+
+void PolygonMerger::_insertEdges(uint32_t p) {
+    Piece const & piece = _pieces[p];
+    for (size_t i = 0; i < piece.size(); ++i) {
+        _edges[edgeKey(piece[i], piece[(i + 1) % piece.size()])] = p;
+    }
+}
+
+void PolygonMerger::_eraseEdges(uint32_t p) {
+    Piece const & piece = _pieces[p];
+    for (size_t i = 0; i < piece.size(); ++i) {
+        _edges.erase(edgeKey(piece[i], piece[(i + 1) % piece.size()]));
+    }
+}
+
+void PolygonMerger::_split(
+    uint32_t p, std::unordered_multimap<uint32_t, uint32_t> const & next)
+{
+    Piece split;
+    std::vector<uint32_t> chain;
+    Piece const & piece = _pieces[p];
+    size_t const m = piece.size();
+    for (size_t i = 0; i < m; ++i) {
+        uint32_t const a = piece[i];
+        uint32_t const b = piece[(i + 1) % m];
+        split.push_back(a);
+        if (_edges.count(edgeKey(b, a)) != 0) {
+            continue;
+        }
+        // The neighbors along edge ab run from b to a. Follow their edges
+        // from b for as long as they stay on ab.
+        chain.clear();
+        UnitVector3d const & va = _vertices[a];
+        UnitVector3d const & vb = _vertices[b];
+        for (uint32_t v = b; v != a;) {
+            uint32_t w = v;
+            auto range = next.equal_range(v);
+            for (auto j = range.first; j != range.second; ++j) {
+                uint32_t c = j->second;
+                if (c == a && v != b) {
+                    w = c;
+                    break;
+                }
+                UnitVector3d const & vc = _vertices[c];
+                if (c != a && (vb - vc).dot(va - vc) < 0.0 &&
+                    _turn(b, c, a) == 0) {
+                    w = c;
+                    break;
+                }
+            }
+            if (w == v || chain.size() >= MAX_PIECE_VERTICES) {
+                chain.clear();
+                break;
+            }
+            if (w != a) {
+                chain.push_back(w);
+            }
+            v = w;
+        }
+        split.insert(split.end(), chain.rbegin(), chain.rend());
+    }
+    if (split.size() != m) {
+        _eraseEdges(p);
+        _pieces[p] = std::move(split);
+        _insertEdges(p);
+    }
+}
+
+bool PolygonMerger::_merge(uint32_t p, uint32_t q) {
+    Piece const & pp = _pieces[p];
+    Piece const & qq = _pieces[q];
+    size_t const n = pp.size();
+    size_t const m = qq.size();
+    auto shared = [&](size_t i) {
+        auto e = _edges.find(edgeKey(pp[(i + 1) % n], pp[i % n]));
+        return e != _edges.end() && e->second == q;
+    };
+    // Find the run of edges of p shared with q, which is contiguous
+    // since both pieces are convex. It starts at vertex s of p, and has
+    // length k.
+    size_t s = 0;
+    while (s < n && !shared(s)) {
+        ++s;
+    }
+    if (s == n) {
+        return false;
+    }
+    for (size_t steps = 0; shared(s + n - 1); ++steps) {
+        if (steps == n) {
+            // Every edge is shared, which valid pieces cannot do.
+            return false;
+        }
+        s = (s + n - 1) % n;
+    }
+    size_t k = 1;
+    while (k < n && shared(s + k)) {
+        ++k;
+    }
+    if (n + m - 2 * k > MAX_PIECE_VERTICES) {
+        return false;
+    }
+    size_t const t = (s + k) % n;
+    uint32_t const a = pp[s];
+    uint32_t const b = pp[t];
+    size_t const qa = static_cast<size_t>(
+        std::find(qq.begin(), qq.end(), a) - qq.begin());
+    size_t const qb = (qa + m - k) % m;
+    // The merged piece follows p from b to a, and then q back to b.
+    Piece merged;
+    merged.reserve(n + m - 2 * k);
+    for (size_t i = 0; i <= n - k; ++i) {
+        merged.push_back(pp[(t + i) % n]);
+    }
+    for (size_t i = 1; i < m - k; ++i) {
+        merged.push_back(qq[(qa + i) % m]);
+    }
+    // Only the turns at a and b differ from those of p and q.
+    if (_turn(pp[(s + n - 1) % n], a, qq[(qa + 1) % m]) < 0 ||
+        _turn(qq[(qb + m - 1) % m], b, pp[(t + 1) % n]) < 0) {
+        return false;
+    }
+    // Check that the edges between the vertices where the boundary turns
+    // are not too long.
+    size_t const r = merged.size();
+    uint32_t first = UINT32_MAX;
+    uint32_t last = UINT32_MAX;
+    size_t turns = 0;
+    for (size_t i = 0; i < r; ++i) {
+        uint32_t v = merged[i];
+        if (_turn(merged[(i + r - 1) % r], v, merged[(i + 1) % r]) == 0) {
+            continue;
+        }
+        if (last != UINT32_MAX && (_vertices[v] - _vertices[last])
+                .getSquaredNorm() >= MAX_SQUARED_EDGE_CHORD) {
+            return false;
+        }
+        if (first == UINT32_MAX) {
+            first = v;
+        }
+        last = v;
+        ++turns;
+    }
+    if (turns < 3 || (_vertices[first] - _vertices[last])
+            .getSquaredNorm() >= MAX_SQUARED_EDGE_CHORD) {
+        return false;
+    }
+    _eraseEdges(p);
+    _eraseEdges(q);
+    _pieces[p] = std::move(merged);
+    _pieces[q].clear();
+    _insertEdges(p);
+    return true;
+}
+
+int PolygonMerger::_turn(uint32_t a, uint32_t b, uint32_t c) const {
+    Vector3d const & va = _vertices[a];
+    Vector3d const & vb = _vertices[b];
+    Vector3d const & vc = _vertices[c];
+    Vector3d const ab = va - vb;
+    Vector3d const cb = vc - vb;
+    double const d = va.dot(vb.cross(vc));
+    double const tolerance =
+        COLLINEARITY_TOLERANCE * (ab.getNorm() + cb.getNorm());
+    if (d > tolerance) {
+        return 1;
+    } else if (d < -tolerance) {
+        return -1;
+    }
+    return ab.dot(cb) < 0.0 ? 0 : -1;
+}
+
+}}} // namespace lsst::sphgeom::detail
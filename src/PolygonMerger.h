@@ -0,0 +1,98 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef LSST_SPHGEOM_POLYGONMERGER_H_
+#define LSST_SPHGEOM_POLYGONMERGER_H_
+
+/// \file
+/// \brief This file declares a class for merging adjacent convex polygons.
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+// A `PolygonMerger` merges convex polygons with disjoint interiors, such
+// as the pixels of a pixel set, into fewer and larger convex polygons that
+// cover the same area.
+//
+// Polygons are stored as cycles of vertex IDs, and vertices closer than
+// rounding errors are given the same ID, so that polygons sharing an
+// edge can be found from an edge table. A polygon edge that a neighbor
+// only covers partially, as happens where a pixel meets the smaller
+// pixels of a finer level, is first split at the neighbor vertices lying
+// on it. Then, like the Hertel-Mehlhorn algorithm, which removes diagonals
+// from a triangulation, polygons sharing edges are merged greedily for as
+// long as the result is convex.
+class PolygonMerger {
+public:
+    // `add` adds a polygon to the set to merge.
+    void add(ConvexPolygon const & p);
+
+    // `merge` merges the polygons added so far and returns the result.
+    // Vertices where the boundary of a merged polygon does not turn are
+    // removed, which moves its edges by at most about 1e-14 radians.
+    std::vector<ConvexPolygon> merge();
+
+private:
+    // A `Piece` is a polygon, as a counter-clockwise cycle of vertex IDs.
+    // Merged pieces are left empty.
+    using Piece = std::vector<uint32_t>;
+
+    std::vector<UnitVector3d> _vertices;
+    std::map<std::array<int64_t, 3>, uint32_t> _vertexIds;
+    std::vector<Piece> _pieces;
+
+    // `_edges` maps each directed edge of a piece to that piece.
+    std::unordered_map<uint64_t, uint32_t> _edges;
+
+    uint32_t _getVertexId(UnitVector3d const & v);
+
+    void _insertEdges(uint32_t p);
+    void _eraseEdges(uint32_t p);
+
+    // `_split` splits the edges of piece p that are only partially covered
+    // by the edges of its neighbors, given the successors of every vertex.
+    void _split(uint32_t p,
+                std::unordered_multimap<uint32_t, uint32_t> const & next);
+
+    // `_merge` merges piece q into piece p if they share edges and the
+    // result is convex, and returns true if it did.
+    bool _merge(uint32_t p, uint32_t q);
+
+    // `_turn` returns 1 if the boundary turns counter-clockwise at vertex
+    // b on its way from a to c, 0 if it goes straight on, and -1 if it
+    // turns clockwise or doubles back.
+    int _turn(uint32_t a, uint32_t b, uint32_t c) const;
+};
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_POLYGONMERGER_H_
@@ -0,0 +1,286 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the PolygonMesh class implementation.
+
+#include "lsst/sphgeom/PolygonMesh.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/orientation.h"
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// This is the absolute error bound on the determinant computed by
+// orientation() for unit vectors; see orientation.cc.
+double const MAX_DETERMINANT_ERROR = 1.7e-15;
+
+uint32_t const NONE = std::numeric_limits<uint32_t>::max();
+
+// Points and faces are processed in blocks of this size when using
+// multiple threads.
+size_t const BLOCK_SIZE = 1024;
+
+// `cross` computes the edge plane normal a × b exactly as orientation()
+// and the ConvexPolygon edge normals do.
+Vector3d cross(UnitVector3d const & a, UnitVector3d const & b) {
+    return Vector3d(a.y() * b.z() - a.z() * b.y(),
+                    a.z() * b.x() - a.x() * b.z(),
+                    a.x() * b.y() - a.y() * b.x());
+}
+
+bool lessThan(UnitVector3d const & a, UnitVector3d const & b) {
+    return std::make_tuple(a.x(), a.y(), a.z()) <
+           std::make_tuple(b.x(), b.y(), b.z());
+}
+
+} // unnamed namespace
+
+PolygonMesh::PolygonMesh(std::vector<ConvexPolygon> const & faces) {
+    if (faces.empty()) {
+        return;
+    }
+    std::vector<UnitVector3d> points;
+    _offsets.reserve(faces.size() + 1);
+    _offsets.push_back(0);
+    for (ConvexPolygon const & f : faces) {
+        points.insert(points.end(), f.getVertices().begin(),
+                      f.getVertices().end());
+        if (points.size() >= NONE) {
+            throw std::invalid_argument("PolygonMesh has too many corners");
+        }
+        _offsets.push_back(static_cast<uint32_t>(points.size()));
+    }
+    size_t const numCorners = points.size();
+    // Assign vertex indexes by sorting corners on their coordinates.
+    std::vector<uint32_t> order(numCorners);
+    for (size_t c = 0; c < numCorners; ++c) {
+        order[c] = static_cast<uint32_t>(c);
+    }
+    std::sort(order.begin(), order.end(), [&points](uint32_t a, uint32_t b) {
+        return lessThan(points[a], points[b]);
+    });
+    _corners.resize(numCorners);
+    for (size_t j = 0; j < numCorners; ++j) {
+        UnitVector3d const & v = points[order[j]];
+        if (_vertices.empty() || _vertices.back() != v) {
+            _vertices.push_back(v);
+        }
+        _corners[order[j]] = static_cast<uint32_t>(_vertices.size() - 1);
+    }
+    // Assign edge indexes by sorting corners on the vertex indexes of
+    // their edges, smallest first.
+    std::vector<uint64_t> keys(numCorners);
+    std::vector<char> reversed(numCorners);
+    for (size_t i = 0; i + 1 < _offsets.size(); ++i) {
+        uint32_t const begin = _offsets[i];
+        uint32_t const end = _offsets[i + 1];
+        for (uint32_t c = begin, p = end - 1; c < end; p = c, ++c) {
+            uint64_t a = _corners[p];
+            uint64_t b = _corners[c];
+            reversed[c] = a > b;
+            keys[c] = a > b ? (b << 32 | a) : (a << 32 | b);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&keys](uint32_t a, uint32_t b) {
+        return keys[a] < keys[b];
+    });
+    // The face of each corner, needed to record the faces of its edge.
+    std::vector<uint32_t> cornerFaces(numCorners);
+    for (size_t i = 0; i + 1 < _offsets.size(); ++i) {
+        std::fill(cornerFaces.begin() + _offsets[i],
+                  cornerFaces.begin() + _offsets[i + 1],
+                  static_cast<uint32_t>(i));
+    }
+    _edges.resize(numCorners);
+    for (size_t j = 0; j < numCorners; ++j) {
+        uint32_t const c = order[j];
+        if (j == 0 || keys[order[j - 1]] != keys[c]) {
+            UnitVector3d const & a = _vertices[keys[c] >> 32];
+            UnitVector3d const & b = _vertices[keys[c] & NONE];
+            _normals.push_back(cross(a, b));
+            _edgeFaces.push_back(NONE);
+            _edgeFaces.push_back(NONE);
+        }
+        size_t const e = _normals.size() - 1;
+        uint32_t & face = _edgeFaces[2 * e + reversed[c]];
+        if (face != NONE) {
+            throw std::invalid_argument(
+                "PolygonMesh faces must have disjoint interiors");
+        }
+        face = cornerFaces[c];
+        _edges[c] = static_cast<uint32_t>(e << 1) | reversed[c];
+    }
+}
+
+ConvexPolygon PolygonMesh::getFace(size_t i) const {
+    ConvexPolygon::VertexVector vertices;
+    for (uint32_t c = _offsets[i]; c < _offsets[i + 1]; ++c) {
+        vertices.push_back(_vertices[_corners[c]]);
+    }
+    return ConvexPolygon::fromTrustedVertices(vertices.data(), vertices.size());
+}
+
+size_t PolygonMesh::getNeighbor(size_t i, size_t k) const {
+    uint32_t const e = _edges[_offsets[i] + k];
+    uint32_t const f = _edgeFaces[e ^ 1];
+    return f == NONE ? NO_FACE : f;
+}
+
+size_t PolygonMesh::_exitCorner(size_t i,
+                                UnitVector3d const & v,
+                                size_t start) const {
+    // These are the tests made by ConvexPolygon::contains, with edge
+    // normals negated for edges traversed in reverse. Negation is exact,
+    // so the results are the same bit for bit.
+    size_t const begin = _offsets[i];
+    size_t const n = _offsets[i + 1] - begin;
+    for (size_t t = 0, k = start; t < n; ++t, k = (k + 1 == n) ? 0 : k + 1) {
+        uint32_t const e = _edges[begin + k];
+        Vector3d const & nrm = _normals[e >> 1];
+        double d = v.x() * nrm.x() + v.y() * nrm.y() + v.z() * nrm.z();
+        if (e & 1) {
+            d = -d;
+        }
+        if (d > MAX_DETERMINANT_ERROR) {
+            continue;
+        }
+        if (d < -MAX_DETERMINANT_ERROR) {
+            return k;
+        }
+        size_t const j = (k == 0) ? n - 1 : k - 1;
+        if (orientation(v, _vertices[_corners[begin + j]],
+                        _vertices[_corners[begin + k]]) < 0) {
+            return k;
+        }
+    }
+    return NO_CORNER;
+}
+
+size_t PolygonMesh::_scan(UnitVector3d const & v) const {
+    for (size_t i = 0; i < getNumFaces(); ++i) {
+        if (contains(i, v)) {
+            return i;
+        }
+    }
+    return NO_FACE;
+}
+
+size_t PolygonMesh::findFace(UnitVector3d const & v, size_t hint) const {
+    size_t const numFaces = getNumFaces();
+    if (numFaces == 0) {
+        return NO_FACE;
+    }
+    size_t f = hint < numFaces ? hint : 0;
+    size_t start = 0;
+    // A walk to v visits each face at most once unless it cycles, which
+    // can happen when faces are very unevenly shaped.
+    for (size_t step = 0; step < numFaces; ++step) {
+        size_t const k = _exitCorner(f, v, start);
+        if (k == NO_CORNER) {
+            return f;
+        }
+        uint32_t const e = _edges[_offsets[f] + k];
+        size_t const g = getNeighbor(f, k);
+        if (g == NO_FACE) {
+            break;
+        }
+        // v is inside the edge just crossed, as seen from the new face,
+        // so the tests for the new face start after it.
+        size_t const begin = _offsets[g];
+        size_t const n = _offsets[g + 1] - begin;
+        start = 0;
+        for (size_t j = 0; j < n; ++j) {
+            if ((_edges[begin + j] >> 1) == (e >> 1)) {
+                start = (j + 1 == n) ? 0 : j + 1;
+                break;
+            }
+        }
+        f = g;
+    }
+    return _scan(v);
+}
+
+void PolygonMesh::findFaces(UnitVector3d const * points,
+                            size_t n,
+                            size_t * out,
+                            unsigned numThreads) const {
+    detail::forEachBlock(n, BLOCK_SIZE, numThreads,
+        [this, points, out](size_t begin, size_t end) {
+            size_t hint = 0;
+            for (size_t i = begin; i < end; ++i) {
+                out[i] = findFace(points[i], hint);
+                if (out[i] != NO_FACE) {
+                    hint = out[i];
+                }
+            }
+        });
+}
+
+void PolygonMesh::relate(Region const & r,
+                         Relationship * out,
+                         unsigned numThreads) const {
+    size_t const numVertices = _vertices.size();
+    std::vector<double> x(numVertices);
+    std::vector<double> y(numVertices);
+    std::vector<double> z(numVertices);
+    for (size_t v = 0; v < numVertices; ++v) {
+        x[v] = _vertices[v].x();
+        y[v] = _vertices[v].y();
+        z[v] = _vertices[v].z();
+    }
+    std::unique_ptr<bool[]> inside(new bool[numVertices]);
+    detail::forEachBlock(numVertices, BLOCK_SIZE, numThreads,
+        [&](size_t begin, size_t end) {
+            r.contains(x.data() + begin, y.data() + begin, z.data() + begin,
+                       inside.get() + begin, end - begin);
+        });
+    detail::forEachBlock(getNumFaces(), BLOCK_SIZE, numThreads,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                size_t const n = _offsets[i + 1] - _offsets[i];
+                size_t numInside = 0;
+                for (uint32_t c = _offsets[i]; c < _offsets[i + 1]; ++c) {
+                    numInside += inside[_corners[c]];
+                }
+                if (numInside != 0 && numInside != n) {
+                    out[i] = INTERSECTS;
+                } else {
+                    out[i] = getFace(i).relate(r);
+                }
+            }
+        });
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,184 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the PreparedBox class implementation.
+
+#include "PreparedBox.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/utils.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+PreparedBox::PreparedBox(Box const & b) :
+    _box(b),
+    _zmin(0.0),
+    _zmax(0.0),
+    _wide(false),
+    _prepared(!b.isEmpty() && !b.isFull())
+{
+    if (!_prepared) {
+        return;
+    }
+    NormalizedAngleInterval const & lon = b.getLon();
+    AngleInterval const & lat = b.getLat();
+    // The vertices and normals are computed exactly as by the UnitVector3d
+    // constructor and UnitVector3d::orthogonalTo, from 4 sine/cosine pairs
+    // rather than 10.
+    double const slona = sin(lon.getA()), clona = cos(lon.getA());
+    double const slonb = sin(lon.getB()), clonb = cos(lon.getB());
+    double const slata = sin(lat.getA()), clata = cos(lat.getA());
+    double const slatb = sin(lat.getB()), clatb = cos(lat.getB());
+    _vertices[0] = UnitVector3d::fromNormalized(
+        clona * clata, slona * clata, slata);
+    _vertices[1] = UnitVector3d::fromNormalized(
+        clona * clatb, slona * clatb, slatb);
+    _vertices[2] = UnitVector3d::fromNormalized(
+        clonb * clata, slonb * clata, slata);
+    _vertices[3] = UnitVector3d::fromNormalized(
+        clonb * clatb, slonb * clatb, slatb);
+    _normals[0] = UnitVector3d::fromNormalized(-slona, clona, 0.0);
+    _normals[1] = UnitVector3d::fromNormalized(-slonb, clonb, 0.0);
+    _zmin = slata;
+    _zmax = slatb;
+    _wide = lon.getSize().asRadians() > PI;
+}
+
+Relationship PreparedBox::relate(Circle const & c) const {
+    if (_box.isEmpty()) {
+        if (c.isEmpty()) {
+            return CONTAINS | DISJOINT | WITHIN;
+        }
+        return DISJOINT | WITHIN;
+    } else if (c.isEmpty()) {
+        return CONTAINS | DISJOINT;
+    }
+    if (_box.isFull()) {
+        if (c.isFull()) {
+            return CONTAINS | WITHIN;
+        }
+        return CONTAINS;
+    } else if (c.isFull()) {
+        return WITHIN;
+    }
+    NormalizedAngleInterval const & lon = _box.getLon();
+    AngleInterval const & lat = _box.getLat();
+    // Neither region is empty or full. We now determine whether or not the
+    // circle and box boundaries intersect.
+    //
+    // If the box vertices are not all inside or all outside of c, then the
+    // boundaries cross.
+    bool inside = false;
+    for (int i = 0; i < 4; ++i) {
+        double d = (_vertices[i] - c.getCenter()).getSquaredNorm();
+        if (std::fabs(d - c.getSquaredChordLength()) <
+            MAX_SQUARED_CHORD_LENGTH_ERROR) {
+            // A box vertex is close to the circle boundary.
+            return INTERSECTS;
+        }
+        bool b = d < c.getSquaredChordLength();
+        if (i == 0) {
+            inside = b;
+        } else if (inside != b) {
+            // There are box vertices both inside and outside of c.
+            return INTERSECTS;
+        }
+    }
+    if (inside) {
+        // All box vertices are inside c. Look for points in the box edge
+        // interiors that are outside c.
+        for (int i = 0; i < 2; ++i) {
+            double d = getMaxSquaredChordLength(
+                c.getCenter(), _vertices[2 * i + 1], _vertices[2 * i],
+                _normals[i]);
+            if (d > c.getSquaredChordLength() -
+                    MAX_SQUARED_CHORD_LENGTH_ERROR) {
+                return INTERSECTS;
+            }
+        }
+        LonLat cc(-c.getCenter());
+        if (lon.contains(cc.getLon())) {
+            // The points furthest from the center of c on the small circles
+            // defined by the box edges with constant latitude are in the box
+            // edge interiors. Find the largest squared chord length to either.
+            Angle a = std::min(getMinAngleToCircle(cc.getLat(), lat.getA()),
+                               getMinAngleToCircle(cc.getLat(), lat.getB()));
+            double d = Circle::squaredChordLengthFor(Angle(PI) - a);
+            if (d > c.getSquaredChordLength() -
+                    MAX_SQUARED_CHORD_LENGTH_ERROR) {
+                return INTERSECTS;
+            }
+        }
+        // The box boundary is completely inside c. However, the box is not
+        // necessarily within c: consider a circle with opening angle equal to
+        // π - ε. If a box contains the complement of such a circle, then
+        // intersecting it with that circle will punch a hole in the box. In
+        // this case each region contains the boundary of the other, but
+        // neither region contains the other.
+        //
+        // To handle this case, check that the box does not contain the
+        // complement of c - since the boundaries do not intersect, this is the
+        // case iff the box contains the center of the complement of c.
+        if (_box.contains(cc)) {
+            return INTERSECTS;
+        }
+        return WITHIN;
+    }
+    // All box vertices are outside c. Look for points in the box edge
+    // interiors that are inside c.
+    for (int i = 0; i < 2; ++i) {
+        double d = getMinSquaredChordLength(
+            c.getCenter(), _vertices[2 * i + 1], _vertices[2 * i],
+            _normals[i]);
+        if (d < c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR) {
+            return INTERSECTS;
+        }
+    }
+    LonLat cc(c.getCenter());
+    if (lon.contains(cc.getLon())) {
+        // The points closest to the center of c on the small circles
+        // defined by the box edges with constant latitude are in the box
+        // edge interiors. Find the smallest squared chord length to either.
+        Angle a = std::min(getMinAngleToCircle(cc.getLat(), lat.getA()),
+                           getMinAngleToCircle(cc.getLat(), lat.getB()));
+        double d = Circle::squaredChordLengthFor(a);
+        if (d < c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR) {
+            return INTERSECTS;
+        }
+    }
+    // The box boundary is completely outside of c. If the box contains the
+    // circle center, then the box contains c. Otherwise, the box and circle
+    // are disjoint.
+    if (_box.contains(cc)) {
+        return CONTAINS;
+    }
+    return DISJOINT;
+}
+
+}}} // namespace lsst::sphgeom::detail
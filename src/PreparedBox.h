@@ -0,0 +1,134 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PREPAREDBOX_H_
+#define LSST_SPHGEOM_PREPAREDBOX_H_
+
+/// \file
+/// \brief This file declares a class for relating a Box to many regions.
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Relationship.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "ConvexPolygonImpl.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+// A `PreparedBox` is a Box along with its vertices, the planes of its
+// meridian edges and the sines of its latitude bounds, which every
+// relation with a circle or a pixel needs. They are computed once, from
+// the sines and cosines of the 4 box bounds, rather than by each relate
+// call.
+class PreparedBox {
+public:
+    explicit PreparedBox(Box const & b);
+
+    Box const & getBox() const { return _box; }
+
+    Circle getBoundingCircle() const { return _box.getBoundingCircle(); }
+
+    // `relate` returns the same result as `getBox().relate(c)`.
+    Relationship relate(Circle const & c) const;
+
+    // `classify` returns 1 if v is inside the box, -1 if it is outside,
+    // and 0 if v is too close to the box boundary for either to be
+    // certain despite rounding errors.
+    int classify(UnitVector3d const & v) const {
+        if (!_prepared) {
+            return 0;
+        }
+        double const z = v.z();
+        if (z < _zmin - MARGIN || z > _zmax + MARGIN) {
+            return -1;
+        }
+        bool const lat = z > _zmin + MARGIN && z < _zmax - MARGIN;
+        if (_box.getLon().isFull()) {
+            return lat ? 1 : 0;
+        }
+        // v·nₐ is cos φ sin(θ - a) for a point with longitude θ and
+        // latitude φ, and is positive for points up to π east of the
+        // meridian a.
+        double const da = v.dot(_normals[0]);
+        double const db = v.dot(_normals[1]);
+        bool in;
+        bool out;
+        if (_wide) {
+            in = da > MARGIN || db < -MARGIN;
+            out = da < -MARGIN && db > MARGIN;
+        } else {
+            in = da > MARGIN && db < -MARGIN;
+            out = da < -MARGIN || db > MARGIN;
+        }
+        if (out) {
+            return -1;
+        }
+        return (in && lat) ? 1 : 0;
+    }
+
+private:
+    static constexpr double MARGIN = 1.0e-12;
+
+    Box _box;
+    // (lonA, latA), (lonA, latB), (lonB, latA) and (lonB, latB).
+    UnitVector3d _vertices[4];
+    // The normals of the planes of the meridians at lonA and lonB,
+    // pointing towards increasing longitude.
+    UnitVector3d _normals[2];
+    double _zmin;
+    double _zmax;
+    // `_wide` is true if the box is wider than π.
+    bool _wide;
+    // `_prepared` is false for empty and full boxes.
+    bool _prepared;
+};
+
+// `relate` computes the relationship between a pixel and a prepared box.
+// Pixels that straddle the box boundary usually have vertices on both
+// sides of it, which are found with a few dot products, and only the
+// remaining pixels are related by computing their bounding boxes.
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    PreparedBox const & b)
+{
+    bool in = false;
+    bool out = false;
+    for (VertexIterator v = begin; v != end; ++v) {
+        int const c = b.classify(*v);
+        in = in || c > 0;
+        out = out || c < 0;
+    }
+    if (in && out) {
+        return INTERSECTS;
+    }
+    return relate(begin, end, b.getBox());
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_PREPAREDBOX_H_
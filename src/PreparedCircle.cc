@@ -0,0 +1,66 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the PreparedCircle class implementation.
+
+#include "PreparedCircle.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "lsst/sphgeom/constants.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+PreparedCircle::PreparedCircle(Circle const & c) :
+    _circle(c),
+    _nearTan2(0.0),
+    _farTan2(0.0)
+{
+    // getMinSquaredChordLength and getMaxSquaredChordLength return 4 and 0
+    // when the closest and farthest edge points are endpoints, and values
+    // of at most and at least 2 otherwise.
+    double const near = c.getSquaredChordLength() + MAX_SQUARED_CHORD_LENGTH_ERROR;
+    double const far = c.getSquaredChordLength() - MAX_SQUARED_CHORD_LENGTH_ERROR;
+    _nearEnds = 4.0 < near;
+    _nearAll = near > 2.0;
+    if (!_nearAll && near > 0.0) {
+        // θ ∈ [0, π/2) is below 2 arcsin(√near / 2).
+        double const t = std::tan(2.0 * std::asin(0.5 * std::sqrt(near)));
+        _nearTan2 = t * t;
+    }
+    _farEnds = 0.0 > far;
+    _farAll = far < 2.0;
+    if (!_farAll) {
+        // θ ∈ (π/2, π] is above 2 arcsin(√far / 2), so that π - θ is below
+        // π - 2 arcsin(√far / 2).
+        double const t = std::tan(
+            PI - 2.0 * std::asin(std::min(1.0, 0.5 * std::sqrt(far))));
+        _farTan2 = t * t;
+    }
+}
+
+}}} // namespace lsst::sphgeom::detail
@@ -0,0 +1,112 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_PREPAREDCIRCLE_H_
+#define LSST_SPHGEOM_PREPAREDCIRCLE_H_
+
+/// \file
+/// \brief This file declares a class for relating a Circle to many pixels.
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Relationship.h"
+#include "lsst/sphgeom/Vector3d.h"
+
+#include "ConvexPolygonImpl.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+// A `PreparedCircle` is a Circle along with the thresholds needed to
+// compare the distances between its center and polygon edges to its radius
+// without trigonometric functions.
+//
+// Relating a polygon to a circle may require the minimum or maximum
+// squared chord length d = 4 sin²(θ/2) between the circle center v and a
+// polygon edge, where θ is given by tan θ = |v·n| / ‖v × n‖ (or by
+// tan(π - θ) for the maximum) for the edge normal n. Since d increases with
+// θ, comparing d to the squared chord length of the circle (plus or minus
+// the maximum error of d) is the same as comparing tan² θ to a threshold
+// computed once per circle.
+class PreparedCircle {
+public:
+    explicit PreparedCircle(Circle const & c);
+
+    Circle const & getCircle() const { return _circle; }
+
+    Circle getBoundingCircle() const { return _circle; }
+
+    // `isNear` and `isFar` implement the edge tests of CircleEdgeTests.
+    bool isNear(Vector3d const & a, Vector3d const & b, Vector3d const & n) const {
+        Vector3d const & v = _circle.getCenter();
+        Vector3d vxn = v.cross(n);
+        if (vxn.dot(a) > 0.0 && vxn.dot(b) < 0.0) {
+            // The point of the edge closest to v is in its interior.
+            double s = v.dot(n);
+            return _nearAll || s * s < vxn.getSquaredNorm() * _nearTan2;
+        }
+        return _nearEnds;
+    }
+
+    bool isFar(Vector3d const & a, Vector3d const & b, Vector3d const & n) const {
+        Vector3d const & v = _circle.getCenter();
+        Vector3d vxn = v.cross(n);
+        if (vxn.dot(a) < 0.0 && vxn.dot(b) > 0.0) {
+            // The point of the edge farthest from v is in its interior.
+            double s = v.dot(n);
+            return _farAll || s * s < vxn.getSquaredNorm() * _farTan2;
+        }
+        return _farEnds;
+    }
+
+private:
+    Circle _circle;
+    // The result of `isNear` for edges with a closest point in their
+    // interior is `_nearAll` if that is true, and is otherwise given by
+    // comparing tan² θ to `_nearTan2`. When the closest point is an edge
+    // endpoint, the result is `_nearEnds`. The members for `isFar` are
+    // analogous.
+    double _nearTan2;
+    double _farTan2;
+    bool _nearAll;
+    bool _nearEnds;
+    bool _farAll;
+    bool _farEnds;
+};
+
+template <typename VertexIterator>
+Relationship relate(VertexIterator const begin,
+                    VertexIterator const end,
+                    PreparedCircle const & c)
+{
+    return relate(begin, end, c.getCircle(),
+                  [](VertexIterator a, VertexIterator b) {
+                      return a->robustCross(*b);
+                  },
+                  c);
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_PREPAREDCIRCLE_H_
@@ -0,0 +1,81 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the ProgressiveEnvelope implementation.
+
+#include "lsst/sphgeom/ProgressiveEnvelope.h"
+
+#include <limits>
+#include <utility>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+
+#include "PixelFinder.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+ProgressiveEnvelope::ProgressiveEnvelope(
+    std::unique_ptr<detail::ProgressiveEnvelopeState> state
+) :
+    _state{std::move(state)}
+{}
+
+ProgressiveEnvelope::ProgressiveEnvelope(ProgressiveEnvelope &&) noexcept =
+    default;
+
+ProgressiveEnvelope & ProgressiveEnvelope::operator=(
+    ProgressiveEnvelope &&) noexcept = default;
+
+ProgressiveEnvelope::~ProgressiveEnvelope() = default;
+
+bool ProgressiveEnvelope::refine(size_t maxSteps) {
+    _state->refine(maxSteps, Clock::time_point::max());
+    return _state->complete;
+}
+
+bool ProgressiveEnvelope::refineUntil(Clock::time_point deadline) {
+    _state->refine(std::numeric_limits<size_t>::max(), deadline);
+    return _state->complete;
+}
+
+bool ProgressiveEnvelope::isComplete() const { return _state->complete; }
+
+RangeSet const & ProgressiveEnvelope::getRanges() const {
+    return _state->ranges;
+}
+
+int ProgressiveEnvelope::getCoarsestLevel() const {
+    return _state->coarsestLevel;
+}
+
+double ProgressiveEnvelope::getFrontierArea() const {
+    return _state->frontierArea;
+}
+
+size_t ProgressiveEnvelope::getNumSteps() const { return _state->numSteps; }
+
+}} // namespace lsst::sphgeom
@@ -25,12 +25,15 @@
 
 #include "lsst/sphgeom/Q3cPixelization.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/curve.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 
+#include "PerformanceCounting.h"
+#include "PixelCache.h"
 #include "PixelFinder.h"
 #include "Q3cPixelizationImpl.h"
 
@@ -79,10 +82,23 @@ alignas(16) double const FACE_CONST[6][4] = {
 // mapping face coordinates (u,v) to the unit sphere and back.
 constexpr double DILATION = 1.0e-15;
 
+// `faceIndex` returns the Morton or Hilbert index of grid coordinates (s, t)
+// within a cube face, and `faceIndexInverse` inverts it.
+inline uint64_t faceIndex(uint32_t s, uint32_t t, int level, bool hilbert) {
+    return hilbert ? hilbertIndex(s, t, level) : mortonIndex(s, t);
+}
+
+inline std::tuple<uint32_t, uint32_t> faceIndexInverse(uint64_t z,
+                                                        int level,
+                                                        bool hilbert) {
+    return hilbert ? hilbertIndexInverse(z, level) : mortonIndexInverse(z);
+}
+
 // `wrapIndex` returns the Q3C index for grid coordinates (face, s, t) at
 // the given level. Both s and t may underflow or overflow by 1, i.e. wrap
 // to an adjacent face.
 uint64_t wrapIndex(int level,
+                   bool hilbert,
                    int face,
                    uint32_t s,
                    uint32_t t)
@@ -137,35 +153,39 @@ uint64_t wrapIndex(int level,
         }
         break;
     }
-    return (static_cast<uint64_t>(face) << (2 * level)) | mortonIndex(s, t);
+    return (static_cast<uint64_t>(face) << (2 * level)) |
+           faceIndex(s, t, level, hilbert);
 }
 
-int findNeighborhood(int level, uint64_t i, uint64_t * dst) {
+int findNeighborhood(int level, bool hilbert, uint64_t i, uint64_t * dst) {
     uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
     int const face = static_cast<int>(i >> (2 * level));
     uint32_t s, t;
-    std::tie(s, t) = mortonIndexInverse(i & mask);
-    dst[0] = wrapIndex(level, face, s - 1, t - 1);
-    dst[1] = wrapIndex(level, face, s    , t - 1);
-    dst[2] = wrapIndex(level, face, s + 1, t - 1);
-    dst[3] = wrapIndex(level, face, s - 1, t);
+    std::tie(s, t) = faceIndexInverse(i & mask, level, hilbert);
+    dst[0] = wrapIndex(level, hilbert, face, s - 1, t - 1);
+    dst[1] = wrapIndex(level, hilbert, face, s    , t - 1);
+    dst[2] = wrapIndex(level, hilbert, face, s + 1, t - 1);
+    dst[3] = wrapIndex(level, hilbert, face, s - 1, t);
     dst[4] = i;
-    dst[5] = wrapIndex(level, face, s + 1, t);
-    dst[6] = wrapIndex(level, face, s - 1, t + 1);
-    dst[7] = wrapIndex(level, face, s    , t + 1);
-    dst[8] = wrapIndex(level, face, s + 1, t + 1);
+    dst[5] = wrapIndex(level, hilbert, face, s + 1, t);
+    dst[6] = wrapIndex(level, hilbert, face, s - 1, t + 1);
+    dst[7] = wrapIndex(level, hilbert, face, s    , t + 1);
+    dst[8] = wrapIndex(level, hilbert, face, s + 1, t + 1);
     std::sort(dst, dst + 9);
     return static_cast<int>(std::unique(dst, dst + 9) - dst);
 }
 
+// `makeQuad` computes the vertices of the Q3C pixel with the given index and
+// subdivision level, and `makeChildQuads` computes those of its 4 children,
+// in index order. The vertices of a pixel are identical in both cases.
 #if defined(NO_SIMD) || !defined(__x86_64__)
-    void makeQuad(uint64_t i, int level, UnitVector3d * verts) {
+    void makeQuad(uint64_t i, int level, bool hilbert, UnitVector3d * verts) {
         uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
         int const face = static_cast<int>(i >> (2 * level));
         double const faceScale = FACE_SCALE[level];
         double u0, v0;
         uint32_t s, t;
-        std::tie(s, t) = mortonIndexInverse(i & mask);
+        std::tie(s, t) = faceIndexInverse(i & mask, level, hilbert);
         std::tie(u0, v0) = gridToFace(
             level, static_cast<int32_t>(s), static_cast<int32_t>(t));
         double u1 = (u0 + faceScale) + DILATION;
@@ -177,13 +197,46 @@ int findNeighborhood(int level, uint64_t i, uint64_t * dst) {
         verts[2] = faceToSphere(face, u1, v1, FACE_COMP, FACE_CONST);
         verts[3] = faceToSphere(face, u0, v1, FACE_COMP, FACE_CONST);
     }
+
+    void makeChildQuads(uint64_t i, int level, bool hilbert,
+                        UnitVector3d (*verts)[4]) {
+        int const l = level + 1;
+        uint64_t const mask = (static_cast<uint64_t>(1) << (2 * l)) - 1;
+        int const face = static_cast<int>(i >> (2 * level));
+        double const faceScale = FACE_SCALE[l];
+        uint32_t s[4], t[4];
+        childGridCoordinates((i << 2) & mask, l, hilbert, s, t);
+        // Dilated lower and upper face coordinates of the children in
+        // grid column (row) a of the 2 x 2 block of children.
+        double ulo[2], uhi[2], vlo[2], vhi[2];
+        for (int a = 0; a < 2; ++a) {
+            double u, v;
+            std::tie(u, v) = gridToFace(
+                l, static_cast<int32_t>((s[0] & ~1u) + a),
+                static_cast<int32_t>((t[0] & ~1u) + a));
+            uhi[a] = (u + faceScale) + DILATION;
+            vhi[a] = (v + faceScale) + DILATION;
+            ulo[a] = u - DILATION;
+            vlo[a] = v - DILATION;
+        }
+        for (int k = 0; k < 4; ++k) {
+            int const a = s[k] & 1;
+            int const b = t[k] & 1;
+            verts[k][0] = faceToSphere(face, ulo[a], vlo[b], FACE_COMP, FACE_CONST);
+            verts[k][1] = faceToSphere(face, uhi[a], vlo[b], FACE_COMP, FACE_CONST);
+            verts[k][2] = faceToSphere(face, uhi[a], vhi[b], FACE_COMP, FACE_CONST);
+            verts[k][3] = faceToSphere(face, ulo[a], vhi[b], FACE_COMP, FACE_CONST);
+        }
+    }
 #else
-    void makeQuad(uint64_t i, int level, UnitVector3d * verts) {
+    void makeQuad(uint64_t i, int level, bool hilbert, UnitVector3d * verts) {
         uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
         int const face = static_cast<int>(i >> (2 * level));
         __m128d faceScale = _mm_set1_pd(FACE_SCALE[level]);
         __m128d dilation = _mm_set1_pd(DILATION);
-        __m128d u0v0 = gridToFace(level, mortonIndexInverseSimd(i & mask));
+        __m128d u0v0 = gridToFace(
+            level, hilbert ? hilbertIndexInverseSimd(i & mask, level)
+                           : mortonIndexInverseSimd(i & mask));
         __m128d u1v1 = _mm_add_pd(u0v0, faceScale);
         u0v0 = _mm_sub_pd(u0v0, dilation);
         u1v1 = _mm_add_pd(u1v1, dilation);
@@ -194,37 +247,103 @@ int findNeighborhood(int level, uint64_t i, uint64_t * dst) {
         verts[3] = faceToSphere(face, _mm_shuffle_pd(u0v0, u1v1, 2),
                                 FACE_COMP, FACE_CONST);
     }
+
+    void makeChildQuads(uint64_t i, int level, bool hilbert,
+                        UnitVector3d (*verts)[4]) {
+        int const l = level + 1;
+        uint64_t const mask = (static_cast<uint64_t>(1) << (2 * l)) - 1;
+        int const face = static_cast<int>(i >> (2 * level));
+        __m128d faceScale = _mm_set1_pd(FACE_SCALE[l]);
+        __m128d dilation = _mm_set1_pd(DILATION);
+        uint32_t s[4], t[4];
+        childGridCoordinates((i << 2) & mask, l, hilbert, s, t);
+        // Dilated lower and upper (u, v) face coordinates of the children
+        // in grid column and row a of the 2 x 2 block of children.
+        __m128d lo[2], hi[2];
+        for (int a = 0; a < 2; ++a) {
+            __m128d uv = gridToFace(l, _mm_set_epi64x((t[0] & ~1u) + a,
+                                                      (s[0] & ~1u) + a));
+            hi[a] = _mm_add_pd(_mm_add_pd(uv, faceScale), dilation);
+            lo[a] = _mm_sub_pd(uv, dilation);
+        }
+        for (int k = 0; k < 4; ++k) {
+            __m128d u0v0 = _mm_shuffle_pd(lo[s[k] & 1], lo[t[k] & 1], 2);
+            __m128d u1v1 = _mm_shuffle_pd(hi[s[k] & 1], hi[t[k] & 1], 2);
+            verts[k][0] = faceToSphere(face, u0v0, FACE_COMP, FACE_CONST);
+            verts[k][1] = faceToSphere(face, _mm_shuffle_pd(u1v1, u0v0, 2),
+                                       FACE_COMP, FACE_CONST);
+            verts[k][2] = faceToSphere(face, u1v1, FACE_COMP, FACE_CONST);
+            verts[k][3] = faceToSphere(face, _mm_shuffle_pd(u0v0, u1v1, 2),
+                                       FACE_COMP, FACE_CONST);
+        }
+    }
+#endif
+
+
+// `computeIndex` returns the Q3C index of p at the given subdivision
+// level, using Hilbert rather than Morton order within faces if `hilbert`
+// is true.
+#if defined(NO_SIMD) || !defined(__x86_64__)
+    inline uint64_t computeIndex(UnitVector3d const & p,
+                                 int level,
+                                 bool hilbert) {
+        int face = faceNumber(p, FACE_NUM);
+        double w = std::fabs(p(FACE_COMP[face][2]));
+        double u = (p(FACE_COMP[face][0]) / w) * FACE_CONST[face][0];
+        double v = (p(FACE_COMP[face][1]) / w) * FACE_CONST[face][1];
+        std::tuple<int32_t, int32_t> g = faceToGrid(level, u, v);
+        uint64_t z = faceIndex(static_cast<uint32_t>(std::get<0>(g)),
+                               static_cast<uint32_t>(std::get<1>(g)),
+                               level, hilbert);
+        return (static_cast<uint64_t>(face) << (2 * level)) | z;
+    }
+#else
+    inline uint64_t computeIndex(UnitVector3d const & p,
+                                 int level,
+                                 bool hilbert) {
+        int face = faceNumber(p, FACE_NUM);
+        __m128d ww = _mm_set1_pd(p(FACE_COMP[face][2]));
+        __m128d uv = _mm_set_pd(p(FACE_COMP[face][1]), p(FACE_COMP[face][0]));
+        uv = _mm_mul_pd(
+            _mm_div_pd(uv, _mm_andnot_pd(_mm_set_pd(-0.0, -0.0), ww)),
+            _mm_set_pd(FACE_CONST[face][1], FACE_CONST[face][0])
+        );
+        __m128i st = faceToGrid(level, uv);
+        uint64_t z = hilbert ? hilbertIndex(st, level) : mortonIndex(st);
+        return (static_cast<uint64_t>(face) << (2 * level)) | z;
+    }
 #endif
 
 
 // `Q3cPixelFinder` locates Q3C pixels that intersect a region.
 //
-// For now, we always begin with a loop over the root cube faces. For small
-// regions, this could be made significantly faster by computing the Q3C
-// index of the region bounding circle center, and looping over that pixel
-// and its neighbors.
+// For large regions, the traversal begins with a loop over the root cube
+// faces. For small regions, it instead computes the Q3C index of the region
+// bounding circle center, and loops over that pixel and its neighbors.
 //
-// The subdivision level for the initial index computation would have to be
-// chosen such that the 8 or 9 pixel neighborhood of the center pixel is
-// guaranteed to contain the bounding circle. The minimum angular pixel width
-// could be precomputed per level. Alternatively, the minimum angle (and
-// chord length) between two points separated by at least one pixel can be
-// shown to be greater than √2/3 * 2^-L at level L. Given the bounding circle
-// radius R, the subdivision level L of the initial neighborhood is the binary
-// exponent of √2/3/R (and can be extracted by calling std::frexp).
+// The subdivision level for the initial index computation is chosen such
+// that the 8 or 9 pixel neighborhood of the center pixel is guaranteed to
+// contain the bounding circle. The minimum angle (and chord length) between
+// two points separated by at least one pixel can be shown to be greater
+// than √2/3 * 2^-L at level L. Given the bounding circle radius R, the
+// subdivision level L of the initial neighborhood is the binary exponent of
+// √2/3/R (see PixelFinder::seedLevel).
 //
-// This is left as a future optimization.
-template <typename RegionType, bool InteriorOnly>
-class Q3cPixelFinder: public detail::PixelFinder<
-    Q3cPixelFinder<RegionType, InteriorOnly>, RegionType, InteriorOnly, 4>
+// Children are visited in index order, so if `Hilbert` is true, the
+// pixels of each face are found in Hilbert order.
+template <typename RegionType, bool InteriorOnly, bool Hilbert>
+class Q3cPixelFinderImpl: public detail::PixelFinder<
+    Q3cPixelFinderImpl<RegionType, InteriorOnly, Hilbert>,
+    RegionType, InteriorOnly, 4>
 {
 private:
     using Base = detail::PixelFinder<
-        Q3cPixelFinder<RegionType, InteriorOnly>, RegionType, InteriorOnly, 4>;
+        Q3cPixelFinderImpl<RegionType, InteriorOnly, Hilbert>,
+        RegionType, InteriorOnly, 4>;
     using Base::visit;
 
 public:
-    Q3cPixelFinder(RangeSet & ranges,
+    Q3cPixelFinderImpl(RangeSet & ranges,
                    RegionType const & region,
                    int level,
                    size_t maxRanges):
@@ -233,112 +352,388 @@ public:
 
     void operator()() {
         UnitVector3d pixel[4];
+        Circle const c = detail::boundingCircle(this->region());
+        int const l = this->seedLevel(c, SEED_WIDTH);
+        if (l >= 0) {
+            // Loop over the neighborhood of the bounding circle center.
+            uint64_t indexes[9];
+            int n = findNeighborhood(
+                l, Hilbert, computeIndex(c.getCenter(), l, Hilbert), indexes);
+            for (int k = 0; k < n; ++k) {
+                makeQuad(indexes[k], l, Hilbert, pixel);
+                this->visitSeed(pixel, indexes[k], l);
+            }
+            return;
+        }
         // Loop over cube faces
         for (uint64_t f = 0; f < 6; ++f) {
-            makeQuad(f, 0, pixel);
+            makeQuad(f, 0, Hilbert, pixel);
             visit(pixel, f, 0);
         }
     }
 
-    void subdivide(UnitVector3d const *, uint64_t i, int level) {
-        UnitVector3d pixel[4];
-        ++level;
-        for (uint64_t c = i * 4; c != i * 4 + 4; ++c) {
-            makeQuad(c, level, pixel);
-            visit(pixel, c, level);
-        }
+    static constexpr int MAX_LEVEL = Q3cPixelization::MAX_LEVEL;
+    static constexpr double SEED_WIDTH = 0.4714045207910317; // √2/3
+
+    // Quad vertices are dilated, so siblings share none of them, but they
+    // share grid and face coordinates, which are computed once per parent.
+    struct Cache {
+        UnitVector3d child[4][4];
+    };
+
+    void expand(UnitVector3d const *, uint64_t i, int level, Cache & cache) {
+        makeChildQuads(i, level, Hilbert, cache.child);
+    }
+
+    UnitVector3d const * child(Cache const & cache,
+                               uint64_t i,
+                               int,
+                               UnitVector3d *) {
+        return cache.child[i & 3];
     }
 };
 
+template <typename RegionType, bool InteriorOnly>
+using Q3cPixelFinder = Q3cPixelFinderImpl<RegionType, InteriorOnly, false>;
+
+template <typename RegionType, bool InteriorOnly>
+using Q3cHilbertPixelFinder =
+    Q3cPixelFinderImpl<RegionType, InteriorOnly, true>;
+
+// `FACE_NORM` gives the normal vector names of the root cube faces, in
+// the order of their Q3C indexes.
+char const FACE_NORM[6][2] = {
+    {'+', 'Z'}, {'+', 'X'}, {'+', 'Y'},
+    {'-', 'X'}, {'-', 'Y'}, {'-', 'Z'},
+};
+
+// `formatIndex` writes the string for the Q3C index i, which has level l,
+// to the l + 2 characters starting at dst.
+void formatIndex(uint64_t i, int l, char * dst) {
+    // Print in base-4, from least to most significant digit.
+    for (char * p = dst + l + 1; p != dst + 1; --p, i >>= 2) {
+        *p = '0' + (i & 3);
+    }
+    // The remaining bits correspond to the cube face.
+    dst[0] = FACE_NORM[i][0];
+    dst[1] = FACE_NORM[i][1];
+}
+
 } // unnamed namespace
 
 
-Q3cPixelization::Q3cPixelization(int level) : _level{level} {
+Q3cPixelization::Q3cPixelization(int level,
+                                 size_t cacheSize,
+                                 bool hilbertOrder) :
+    _level{level},
+    _hilbert{hilbertOrder}
+{
     if (level < 0 || level > MAX_LEVEL) {
         throw std::invalid_argument("Q3C subdivision level not in [0, 30]");
     }
+    if (cacheSize > 0) {
+        _cache = std::make_shared<detail::PixelCache<4>>(cacheSize);
+    }
 }
 
 ConvexPolygon Q3cPixelization::quad(uint64_t i) const {
-    if (i >= static_cast<uint64_t>(6) << (2 * _level)) {
-        throw std::invalid_argument("Invalid Q3C index");
-    }
-    UnitVector3d verts[4];
-    makeQuad(i, _level, verts);
+    UnitVector3d verts[NUM_VERTICES];
+    _vertices(i, verts);
     return ConvexPolygon(verts[0], verts[1], verts[2], verts[3]);
 }
 
 std::vector<uint64_t> Q3cPixelization::neighborhood(uint64_t i) const {
+    uint64_t indexes[9];
+    int n = neighborhood(i, indexes);
+    return std::vector<uint64_t>(indexes, indexes + n);
+}
+
+int Q3cPixelization::neighborhood(uint64_t i, uint64_t (&out)[9]) const {
     if (i >= static_cast<uint64_t>(6) << (2 * _level)) {
         throw std::invalid_argument("Invalid Q3C index");
     }
-    uint64_t indexes[9];
-    int n = findNeighborhood(_level, i, indexes);
-    return std::vector<uint64_t>(indexes, indexes + n);
+    int n = findNeighborhood(_level, _hilbert, i, out);
+    std::fill(out + n, out + 9, out[n - 1]);
+    return n;
+}
+
+void Q3cPixelization::neighborhoods(uint64_t const * indexes,
+                                    size_t n,
+                                    uint64_t * out,
+                                    uint8_t * counts) const {
+    uint64_t const end = static_cast<uint64_t>(6) << (2 * _level);
+    for (size_t p = 0; p < n; ++p, out += 9) {
+        if (indexes[p] >= end) {
+            throw std::invalid_argument("Invalid Q3C index");
+        }
+        int m = findNeighborhood(_level, _hilbert, indexes[p], out);
+        std::fill(out + m, out + 9, out[m - 1]);
+        counts[p] = static_cast<uint8_t>(m);
+    }
+}
+
+RangeSet Q3cPixelization::dilate(RangeSet const & pixels, int k) const {
+    if (!universe().contains(pixels)) {
+        throw std::invalid_argument("Invalid Q3C index");
+    }
+    if (k < 0) {
+        throw std::invalid_argument("Dilation radius must be non-negative");
+    }
+    int const level = _level;
+    bool const hilbert = _hilbert;
+    uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
+    return dilatePixels(
+        pixels, level, k,
+        [level, hilbert, mask](uint64_t i) {
+            uint32_t s, t;
+            std::tie(s, t) = faceIndexInverse(i & mask, level, hilbert);
+            return std::make_tuple(static_cast<int>(i >> (2 * level)), s, t);
+        },
+        [level, hilbert](int face, uint32_t s, uint32_t t) {
+            return (static_cast<uint64_t>(face) << (2 * level)) |
+                   faceIndex(s, t, level, hilbert);
+        },
+        [level, hilbert](uint64_t i, uint64_t * dst) {
+            return findNeighborhood(level, hilbert, i, dst);
+        });
 }
 
 std::string Q3cPixelization::toString(uint64_t i) const {
-    static char const FACE_NORM[6][2] = {
-        {'+', 'Z'}, {'+', 'X'}, {'+', 'Y'},
-        {'-', 'X'}, {'-', 'Y'}, {'-', 'Z'},
-    };
     char s[MAX_LEVEL + 2];
     if (i >= static_cast<uint64_t>(6) << (2 * _level)) {
         throw std::invalid_argument("Invalid Q3C index");
     }
-    // Print in base-4, from least to most significant digit.
-    char * p = s + (sizeof(s) - 1);
-    for (int l = _level; l > 0; --l, --p, i >>= 2) {
-        *p = '0' + (i & 3);
+    formatIndex(i, _level, s);
+    return std::string(s, static_cast<size_t>(_level) + 2);
+}
+
+void Q3cPixelization::toString(uint64_t const * indexes,
+                               size_t n,
+                               char * out,
+                               size_t width) const
+{
+    size_t const len = static_cast<size_t>(_level) + 2;
+    if (n > 0 && len > width) {
+        throw std::invalid_argument(
+            "Q3C index string is longer than the field width");
+    }
+    uint64_t const end = static_cast<uint64_t>(6) << (2 * _level);
+    for (size_t k = 0; k < n; ++k, out += width) {
+        if (indexes[k] >= end) {
+            throw std::invalid_argument("Invalid Q3C index");
+        }
+        formatIndex(indexes[k], _level, out);
+        std::fill(out + len, out + width, '\0');
     }
-    // The remaining bits correspond to the cube face.
-    --p;
-    p[0] = FACE_NORM[i][0];
-    p[1] = FACE_NORM[i][1];
-    return std::string(p, sizeof(s) - static_cast<size_t>(p - s));
+}
+
+uint64_t Q3cPixelization::fromString(char const * s, size_t n) const {
+    if (n != static_cast<size_t>(_level) + 2) {
+        throw std::invalid_argument("Invalid Q3C index string");
+    }
+    uint64_t i = 0;
+    while (i < 6 && (FACE_NORM[i][0] != s[0] || FACE_NORM[i][1] != s[1])) {
+        ++i;
+    }
+    if (i == 6) {
+        throw std::invalid_argument("Invalid Q3C index string");
+    }
+    for (size_t j = 2; j < n; ++j) {
+        if (s[j] < '0' || s[j] > '3') {
+            throw std::invalid_argument("Invalid Q3C index string");
+        }
+        i = (i << 2) | static_cast<uint64_t>(s[j] - '0');
+    }
+    return i;
 }
 
 std::unique_ptr<Region> Q3cPixelization::pixel(uint64_t i) const {
+    return std::unique_ptr<Region>(new ConvexPolygon(quad(i)));
+}
+
+void Q3cPixelization::vertices(uint64_t const * indexes,
+                               size_t n,
+                               double * out) const
+{
+    for (size_t k = 0; k < n; ++k) {
+        UnitVector3d verts[NUM_VERTICES];
+        _vertices(indexes[k], verts);
+        for (int j = 0; j < NUM_VERTICES; ++j, out += 3) {
+            out[0] = verts[j].x();
+            out[1] = verts[j].y();
+            out[2] = verts[j].z();
+        }
+    }
+}
+
+void Q3cPixelization::_vertices(uint64_t i, UnitVector3d * verts) const {
     if (i >= static_cast<uint64_t>(6) << (2 * _level)) {
         throw std::invalid_argument("Invalid Q3C index");
     }
-    UnitVector3d verts[4];
-    makeQuad(i, _level, verts);
-    return std::unique_ptr<Region>(
-        new ConvexPolygon(verts[0], verts[1], verts[2], verts[3]));
+    if (_cache) {
+        int const level = _level;
+        bool const hilbert = _hilbert;
+        _cache->get(i, verts, [level, hilbert](uint64_t j, UnitVector3d * v) {
+            makeQuad(j, level, hilbert, v);
+        });
+    } else {
+        makeQuad(i, _level, _hilbert, verts);
+    }
 }
 
-#if defined(NO_SIMD) || !defined(__x86_64__)
-    uint64_t Q3cPixelization::index(UnitVector3d const & p) const {
-        int face = faceNumber(p, FACE_NUM);
-        double w = std::fabs(p(FACE_COMP[face][2]));
-        double u = (p(FACE_COMP[face][0]) / w) * FACE_CONST[face][0];
-        double v = (p(FACE_COMP[face][1]) / w) * FACE_CONST[face][1];
-        std::tuple<int32_t, int32_t> g = faceToGrid(_level, u, v);
-        uint64_t z = mortonIndex(static_cast<uint32_t>(std::get<0>(g)),
-                                 static_cast<uint32_t>(std::get<1>(g)));
-        return (static_cast<uint64_t>(face) << (2 * _level)) | z;
-    }
-#else
-    uint64_t Q3cPixelization::index(UnitVector3d const & p) const {
-        int face = faceNumber(p, FACE_NUM);
-        __m128d ww = _mm_set1_pd(p(FACE_COMP[face][2]));
-        __m128d uv = _mm_set_pd(p(FACE_COMP[face][1]), p(FACE_COMP[face][0]));
-        uv = _mm_mul_pd(
-            _mm_div_pd(uv, _mm_andnot_pd(_mm_set_pd(-0.0, -0.0), ww)),
-            _mm_set_pd(FACE_CONST[face][1], FACE_CONST[face][0])
-        );
-        __m128i st = faceToGrid(_level, uv);
-        return (static_cast<uint64_t>(face) << (2 * _level)) | mortonIndex(st);
+uint64_t Q3cPixelization::index(UnitVector3d const & p) const {
+    return computeIndex(p, _level, _hilbert);
+}
+
+void Q3cPixelization::index(double const * x,
+                            double const * y,
+                            double const * z,
+                            uint64_t * out,
+                            size_t n) const
+{
+    int const level = _level;
+    bool const hilbert = _hilbert;
+    size_t i = 0;
+#if defined(LSST_SPHGEOM_Q3C_AVX2)
+    if (detail::hasAvx2()) {
+        if (hilbert) {
+            i = indexAvx2<false, true>(x, y, z, out, n, level,
+                                       FACE_NUM, FACE_COMP, FACE_CONST);
+        } else {
+            i = indexAvx2<false, false>(x, y, z, out, n, level,
+                                        FACE_NUM, FACE_COMP, FACE_CONST);
+        }
     }
 #endif
+    for (; i < n; ++i) {
+        out[i] = computeIndex(UnitVector3d(x[i], y[i], z[i]), level, hilbert);
+    }
+}
+
+std::vector<RangeSet> Q3cPixelization::envelopeAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    if (_hilbert) {
+        return detail::findPixelsAtLevels<Q3cHilbertPixelFinder, false>(
+            r, levels, MAX_LEVEL);
+    }
+    return detail::findPixelsAtLevels<Q3cPixelFinder, false>(
+        r, levels, MAX_LEVEL);
+}
+
+std::vector<RangeSet> Q3cPixelization::interiorAtLevels(
+    Region const & r,
+    std::vector<int> const & levels) const
+{
+    if (_hilbert) {
+        return detail::findPixelsAtLevels<Q3cHilbertPixelFinder, true>(
+            r, levels, MAX_LEVEL);
+    }
+    return detail::findPixelsAtLevels<Q3cPixelFinder, true>(
+        r, levels, MAX_LEVEL);
+}
+
+RangeSet Q3cPixelization::_envelope(Region const & r,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::Q3C_ENVELOPE_CALLS);
+    if (_hilbert) {
+        return detail::findPixels<Q3cHilbertPixelFinder, false>(
+            r, maxRanges, _level, numThreads);
+    }
+    return detail::findPixels<Q3cPixelFinder, false>(
+        r, maxRanges, _level, numThreads);
+}
+
+RangeSet Q3cPixelization::_interior(Region const & r,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    detail::CallTimer timer(PerformanceCounter::Q3C_INTERIOR_CALLS);
+    if (_hilbert) {
+        return detail::findPixels<Q3cHilbertPixelFinder, true>(
+            r, maxRanges, _level, numThreads);
+    }
+    return detail::findPixels<Q3cPixelFinder, true>(
+        r, maxRanges, _level, numThreads);
+}
 
-RangeSet Q3cPixelization::_envelope(Region const & r, size_t maxRanges) const {
-    return detail::findPixels<Q3cPixelFinder, false>(r, maxRanges, _level);
+RangeSet Q3cPixelization::_adaptiveEnvelope(Region const & r,
+                                            size_t targetRanges,
+                                            double areaBudget) const {
+    if (_hilbert) {
+        return detail::findPixelsAdaptive<Q3cHilbertPixelFinder, false>(
+            r, _level, targetRanges, areaBudget, (2.0 / 3.0) * PI);
+    }
+    return detail::findPixelsAdaptive<Q3cPixelFinder, false>(
+        r, _level, targetRanges, areaBudget, (2.0 / 3.0) * PI);
+}
+
+RangeSet Q3cPixelization::_adaptiveInterior(Region const & r,
+                                            size_t targetRanges,
+                                            double areaBudget) const {
+    if (_hilbert) {
+        return detail::findPixelsAdaptive<Q3cHilbertPixelFinder, true>(
+            r, _level, targetRanges, areaBudget, (2.0 / 3.0) * PI);
+    }
+    return detail::findPixelsAdaptive<Q3cPixelFinder, true>(
+        r, _level, targetRanges, areaBudget, (2.0 / 3.0) * PI);
+}
+
+ProgressiveEnvelope Q3cPixelization::_progressiveEnvelope(
+    Region const & r) const
+{
+    if (_hilbert) {
+        return ProgressiveEnvelope(
+            detail::findPixelsProgressive<Q3cHilbertPixelFinder>(
+                r, _level, (2.0 / 3.0) * PI));
+    }
+    return ProgressiveEnvelope(
+        detail::findPixelsProgressive<Q3cPixelFinder>(
+            r, _level, (2.0 / 3.0) * PI));
 }
 
-RangeSet Q3cPixelization::_interior(Region const & r, size_t maxRanges) const {
-    return detail::findPixels<Q3cPixelFinder, true>(r, maxRanges, _level);
+EnvelopeAndInterior Q3cPixelization::_envelopeAndInterior(
+    Region const & r,
+    size_t maxRanges) const
+{
+    if (_hilbert) {
+        return detail::findEnvelopeAndInterior<Q3cHilbertPixelFinder>(
+            r, maxRanges, _level);
+    }
+    return detail::findEnvelopeAndInterior<Q3cPixelFinder>(
+        r, maxRanges, _level);
+}
+
+CoverageFractions Q3cPixelization::_coverageFraction(Region const & r) const {
+    if (_hilbert) {
+        return detail::findCoverage<Q3cHilbertPixelFinder>(r, _level);
+    }
+    return detail::findCoverage<Q3cPixelFinder>(r, _level);
+}
+
+RangeSet Q3cPixelization::_envelope(Pixelization const & from,
+                                    RangeSet const & pixels,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    if (_hilbert) {
+        return detail::findPixels<Q3cHilbertPixelFinder, false>(
+            detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
+    }
+    return detail::findPixels<Q3cPixelFinder, false>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
+}
+
+RangeSet Q3cPixelization::_interior(Pixelization const & from,
+                                    RangeSet const & pixels,
+                                    size_t maxRanges,
+                                    unsigned numThreads) const {
+    if (_hilbert) {
+        return detail::findPixels<Q3cHilbertPixelFinder, true>(
+            detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
+    }
+    return detail::findPixels<Q3cPixelFinder, true>(
+        detail::PixelCoverage(from, pixels), maxRanges, _level, numThreads);
 }
 
 }} // namespace lsst::sphgeom
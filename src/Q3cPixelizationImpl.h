@@ -27,15 +27,29 @@
 /// \brief This file contains functions used by Q3C pixelization
 ///        implementations.
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
-#if defined(NO_SIMD) || !defined(__x86_64__)
-    #include <tuple>
-#else
+#include <tuple>
+#include <vector>
+#if !defined(NO_SIMD) && defined(__x86_64__)
     #include <x86intrin.h>
 #endif
 
+#include "lsst/sphgeom/curve.h"
+#include "lsst/sphgeom/RangeSet.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 
+#include "CpuDispatch.h"
+
+// Wide (AVX2) batch kernels are compiled with function level target
+// attributes and selected at run time, so that a baseline x86-64 build
+// still runs on CPUs without AVX2.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define LSST_SPHGEOM_Q3C_AVX2 1
+#endif
+
 
 namespace lsst {
 namespace sphgeom {
@@ -356,6 +370,241 @@ double const FACE_SCALE[31] = {
 
 #endif
 
+#if defined(LSST_SPHGEOM_Q3C_AVX2)
+
+    // `indexAvx2` computes the Q3C (or modified-Q3C, if `Modified` is true)
+    // indexes of the points (x[i], y[i], z[i]) 4 at a time, for i in
+    // [0, n & ~3). Indexes are in Hilbert order within faces if `Hilbert`
+    // is true, and in Morton order otherwise. The number of indexes computed
+    // is returned, and it is up to the caller to index the remaining (at
+    // most 3) points.
+    //
+    // Input vectors are normalized with UnitVector3d, and every subsequent
+    // floating point operation mirrors the SSE2 single point kernel, so that
+    // the results are identical to those of the single point code.
+    template <bool Modified, bool Hilbert = Modified>
+    __attribute__((target("avx2")))
+    size_t indexAvx2(double const * x,
+                     double const * y,
+                     double const * z,
+                     uint64_t * out,
+                     size_t n,
+                     int level,
+                     uint8_t const (&faceNumbers)[64],
+                     uint8_t const (&faceComponents)[6][4],
+                     double const (&faceConstants)[6][4])
+    {
+        __m256d const m0 = _mm256_set1_pd(-0.0);
+        __m256d const gridScale = _mm256_set1_pd(GRID_SCALE[level]);
+        __m256d const stMax = _mm256_set1_pd(ST_MAX[level]);
+        __m256i const b5 = _mm256_set1_epi64x(32);
+        __m256i const b4 = _mm256_set1_epi64x(16);
+        __m256i const b3 = _mm256_set1_epi64x(8);
+        __m256i const b2 = _mm256_set1_epi64x(4);
+        __m256i const b1 = _mm256_set1_epi64x(2);
+        __m256i const b0 = _mm256_set1_epi64x(1);
+        __m256i const m16 = _mm256_set1_epi64x(INT64_C(0x0000ffff0000ffff));
+        __m256i const m8 = _mm256_set1_epi64x(INT64_C(0x00ff00ff00ff00ff));
+        __m256i const m4 = _mm256_set1_epi64x(INT64_C(0x0f0f0f0f0f0f0f0f));
+        __m256i const m2 = _mm256_set1_epi64x(INT64_C(0x3333333333333333));
+        __m256i const m1 = _mm256_set1_epi64x(INT64_C(0x5555555555555555));
+        int const shift = 2 * level;
+        uint64_t const faceOffset = Modified ? 10 : 0;
+        size_t const m = n & ~static_cast<size_t>(3);
+        alignas(32) double p[3][4];
+        alignas(32) double uvw[3][4];
+        alignas(32) double c[2][4];
+        alignas(32) int64_t lut[4];
+        alignas(32) uint64_t zz[4];
+        int face[4];
+        for (size_t i = 0; i < m; i += 4) {
+            for (int j = 0; j < 4; ++j) {
+                UnitVector3d v(x[i + j], y[i + j], z[i + j]);
+                p[0][j] = v.x();
+                p[1][j] = v.y();
+                p[2][j] = v.z();
+            }
+            __m256d px = _mm256_load_pd(p[0]);
+            __m256d py = _mm256_load_pd(p[1]);
+            __m256d pz = _mm256_load_pd(p[2]);
+            __m256d mpy = _mm256_xor_pd(py, m0);
+            __m256d mpz = _mm256_xor_pd(pz, m0);
+            // Compute the faceNumbers LUT index for each lane.
+            __m256i k = _mm256_and_si256(
+                _mm256_castpd_si256(_mm256_cmp_pd(px, py, _CMP_GT_OQ)), b5);
+            k = _mm256_or_si256(k, _mm256_and_si256(
+                _mm256_castpd_si256(_mm256_cmp_pd(px, mpy, _CMP_GT_OQ)), b4));
+            k = _mm256_or_si256(k, _mm256_and_si256(
+                _mm256_castpd_si256(_mm256_cmp_pd(px, pz, _CMP_GT_OQ)), b3));
+            k = _mm256_or_si256(k, _mm256_and_si256(
+                _mm256_castpd_si256(_mm256_cmp_pd(px, mpz, _CMP_GT_OQ)), b2));
+            k = _mm256_or_si256(k, _mm256_and_si256(
+                _mm256_castpd_si256(_mm256_cmp_pd(py, pz, _CMP_GT_OQ)), b1));
+            k = _mm256_or_si256(k, _mm256_and_si256(
+                _mm256_castpd_si256(_mm256_cmp_pd(py, mpz, _CMP_GT_OQ)), b0));
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lut), k);
+            // Gather the face coordinate components of each lane.
+            for (int j = 0; j < 4; ++j) {
+                int f = faceNumbers[lut[j]];
+                face[j] = f;
+                uvw[0][j] = p[faceComponents[f][0]][j];
+                uvw[1][j] = p[faceComponents[f][1]][j];
+                uvw[2][j] = p[faceComponents[f][2]][j];
+                c[0][j] = faceConstants[f][0];
+                c[1][j] = faceConstants[f][1];
+            }
+            __m256d w = _mm256_andnot_pd(m0, _mm256_load_pd(uvw[2]));
+            __m256d u = _mm256_mul_pd(_mm256_div_pd(_mm256_load_pd(uvw[0]), w),
+                                      _mm256_load_pd(c[0]));
+            __m256d v = _mm256_mul_pd(_mm256_div_pd(_mm256_load_pd(uvw[1]), w),
+                                      _mm256_load_pd(c[1]));
+            if (Modified) {
+                __m256d const a = _mm256_set1_pd(1.3333333333333333);
+                __m256d const b = _mm256_set1_pd(0.3333333333333333);
+                u = _mm256_mul_pd(u, _mm256_sub_pd(
+                    a, _mm256_mul_pd(b, _mm256_andnot_pd(m0, u))));
+                v = _mm256_mul_pd(v, _mm256_sub_pd(
+                    a, _mm256_mul_pd(b, _mm256_andnot_pd(m0, v))));
+            }
+            // Map face coordinates to grid coordinates.
+            __m256d s = _mm256_add_pd(_mm256_mul_pd(u, gridScale), gridScale);
+            __m256d t = _mm256_add_pd(_mm256_mul_pd(v, gridScale), gridScale);
+            s = _mm256_min_pd(_mm256_max_pd(s, _mm256_setzero_pd()), stMax);
+            t = _mm256_min_pd(_mm256_max_pd(t, _mm256_setzero_pd()), stMax);
+            __m256i si = _mm256_cvtepu32_epi64(_mm256_cvttpd_epi32(s));
+            __m256i ti = _mm256_cvtepu32_epi64(_mm256_cvttpd_epi32(t));
+            // Interleave the bits of s and t.
+            si = _mm256_and_si256(_mm256_or_si256(si, _mm256_slli_epi64(si, 16)), m16);
+            ti = _mm256_and_si256(_mm256_or_si256(ti, _mm256_slli_epi64(ti, 16)), m16);
+            si = _mm256_and_si256(_mm256_or_si256(si, _mm256_slli_epi64(si, 8)), m8);
+            ti = _mm256_and_si256(_mm256_or_si256(ti, _mm256_slli_epi64(ti, 8)), m8);
+            si = _mm256_and_si256(_mm256_or_si256(si, _mm256_slli_epi64(si, 4)), m4);
+            ti = _mm256_and_si256(_mm256_or_si256(ti, _mm256_slli_epi64(ti, 4)), m4);
+            si = _mm256_and_si256(_mm256_or_si256(si, _mm256_slli_epi64(si, 2)), m2);
+            ti = _mm256_and_si256(_mm256_or_si256(ti, _mm256_slli_epi64(ti, 2)), m2);
+            si = _mm256_and_si256(_mm256_or_si256(si, _mm256_slli_epi64(si, 1)), m1);
+            ti = _mm256_and_si256(_mm256_or_si256(ti, _mm256_slli_epi64(ti, 1)), m1);
+            _mm256_store_si256(reinterpret_cast<__m256i *>(zz),
+                               _mm256_or_si256(si, _mm256_slli_epi64(ti, 1)));
+            if (Hilbert) {
+                mortonToHilbert(zz, zz, 4, level);
+            }
+            for (int j = 0; j < 4; ++j) {
+                out[i + j] = ((static_cast<uint64_t>(face[j]) + faceOffset)
+                              << shift) | zz[j];
+            }
+        }
+        return m;
+    }
+
+#endif
+
+// `childGridCoordinates` stores the grid coordinates of the 4 children of
+// a pixel in s and t, in index order, given the index z of the first child
+// within its cube face, and its subdivision level. The children of a pixel
+// form a 2 x 2 block of grid cells. In Morton order, they are visited row
+// by row. In Hilbert order, consecutive children are adjacent, so that the
+// third and fourth children are diagonally opposite the first and second.
+// Only the first two children therefore need to have their indexes
+// inverted.
+inline void childGridCoordinates(uint64_t z,
+                                 int level,
+                                 bool hilbert,
+                                 uint32_t * s,
+                                 uint32_t * t)
+{
+    if (hilbert) {
+        std::tie(s[0], t[0]) = hilbertIndexInverse(z, level);
+        std::tie(s[1], t[1]) = hilbertIndexInverse(z + 1, level);
+        s[2] = s[0] ^ 1;
+        t[2] = t[0] ^ 1;
+        s[3] = s[1] ^ 1;
+        t[3] = t[1] ^ 1;
+    } else {
+        std::tie(s[0], t[0]) = mortonIndexInverse(z);
+        for (int k = 1; k < 4; ++k) {
+            s[k] = s[0] + (k & 1);
+            t[k] = t[0] + (k >> 1);
+        }
+    }
+}
+
+// `dilatePixels` returns the pixels of a Q3C-like pixelization at the given
+// level that can be reached from `pixels` in at most k steps between pixels
+// sharing a vertex.
+//
+// Pixels are visited in breadth first order, starting from the pixels on
+// the boundary of the input. Since both Morton and Hilbert indexes map an
+// aligned block of 4ⁿ consecutive indexes to a 2ⁿ x 2ⁿ square of grid
+// coordinates, every range is split into aligned blocks, and only the
+// pixels on the perimeters of those blocks are expanded. The `coords`
+// function maps a pixel index to its face number and grid coordinates,
+// `index` maps these back to an index, and `neighborhood(i, dst)` stores
+// the 9 pixel neighborhood of pixel i in dst and returns its size.
+template <typename Coords, typename Index, typename Neighborhood>
+RangeSet dilatePixels(RangeSet const & pixels,
+                      int level,
+                      int k,
+                      Coords coords,
+                      Index index,
+                      Neighborhood neighborhood)
+{
+    RangeSet result = pixels;
+    if (k == 0) {
+        return result;
+    }
+    std::vector<uint64_t> frontier;
+    for (auto const & r: pixels) {
+        uint64_t first = std::get<0>(r);
+        uint64_t const last = std::get<1>(r);
+        while (first != last) {
+            int m = 0;
+            while (m < level &&
+                   (first & ((static_cast<uint64_t>(4) << (2 * m)) - 1)) == 0 &&
+                   last - first >= (static_cast<uint64_t>(4) << (2 * m))) {
+                ++m;
+            }
+            int face;
+            uint32_t s, t;
+            std::tie(face, s, t) = coords(first);
+            uint32_t const side = static_cast<uint32_t>(1) << m;
+            s &= ~(side - 1);
+            t &= ~(side - 1);
+            for (uint32_t x = 0; x < side; ++x) {
+                frontier.push_back(index(face, s + x, t));
+                frontier.push_back(index(face, s + x, t + side - 1));
+            }
+            for (uint32_t y = 1; y + 1 < side; ++y) {
+                frontier.push_back(index(face, s, t + y));
+                frontier.push_back(index(face, s + side - 1, t + y));
+            }
+            first += static_cast<uint64_t>(1) << (2 * m);
+        }
+    }
+    std::vector<uint64_t> next;
+    for (; k > 0 && !frontier.empty(); --k) {
+        next.clear();
+        for (uint64_t i: frontier) {
+            uint64_t indexes[9];
+            int n = neighborhood(i, indexes);
+            for (int j = 0; j < n; ++j) {
+                if (!result.contains(indexes[j])) {
+                    next.push_back(indexes[j]);
+                }
+            }
+        }
+        std::sort(next.begin(), next.end());
+        next.erase(std::unique(next.begin(), next.end()), next.end());
+        RangeSet added;
+        for (uint64_t i: next) {
+            added.append(i, i + 1);
+        }
+        result |= added;
+        frontier.swap(next);
+    }
+    return result;
+}
+
 } // unnamed namespace
 }} // namespace lsst::sphgeom
 
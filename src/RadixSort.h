@@ -0,0 +1,118 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_RADIXSORT_H_
+#define LSST_SPHGEOM_RADIXSORT_H_
+
+/// \file
+/// \brief This file provides a stable radix sort on 64 bit integer keys.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+/// `radixSort` stably sorts `values` in ascending order of `key(value)`,
+/// which must return a uint64_t. It uses an LSD radix sort with 8 bit
+/// digits, skipping digits that are the same for all keys. Already sorted
+/// input is detected and left alone.
+///
+/// If `numThreads` is greater than one, the values are split into that many
+/// contiguous blocks of at least `MIN_BLOCK_SIZE` values. Each pass counts
+/// digits per block, and then scatters all blocks concurrently, with the
+/// output offsets of each block following those of the blocks before it so
+/// that the sort stays stable. The result does not depend on the number of
+/// threads.
+template <typename T, typename Key>
+void radixSort(std::vector<T> & values, Key const & key,
+               unsigned numThreads = 1)
+{
+    static constexpr size_t MIN_BLOCK_SIZE = 65536;
+    size_t const n = values.size();
+    auto less = [&](T const & a, T const & b) { return key(a) < key(b); };
+    if (std::is_sorted(values.begin(), values.end(), less)) {
+        return;
+    }
+    if (n < 256) {
+        std::stable_sort(values.begin(), values.end(), less);
+        return;
+    }
+    size_t const numBlocks = std::max<size_t>(
+        1, std::min<size_t>(numThreads, n / MIN_BLOCK_SIZE));
+    size_t const blockSize = (n + numBlocks - 1) / numBlocks;
+    // Digit counts of every block, for the digit of the current pass.
+    std::vector<size_t> counts(numBlocks * 256);
+    T * in = values.data();
+    auto countDigits = [&](int d) {
+        std::fill(counts.begin(), counts.end(), 0);
+        forEachBlock(n, blockSize, numThreads, [&](size_t begin, size_t end) {
+            size_t * c = counts.data() + 256 * (begin / blockSize);
+            for (size_t i = begin; i < end; ++i) {
+                ++c[(key(in[i]) >> (8 * d)) & 0xff];
+            }
+        });
+    };
+    // Find the digits that vary, in a single pass over all digits.
+    uint64_t varying = 0;
+    uint64_t const first = key(in[0]);
+    for (size_t i = 1; i < n; ++i) {
+        varying |= key(in[i]) ^ first;
+    }
+    std::vector<T> buffer(n);
+    T * out = buffer.data();
+    for (int d = 0; d < 8; ++d) {
+        if (((varying >> (8 * d)) & 0xff) == 0) {
+            continue;
+        }
+        countDigits(d);
+        // Convert counts to output offsets, ordered by digit and then block.
+        size_t offset = 0;
+        for (int v = 0; v < 256; ++v) {
+            for (size_t b = 0; b < numBlocks; ++b) {
+                size_t count = counts[256 * b + v];
+                counts[256 * b + v] = offset;
+                offset += count;
+            }
+        }
+        forEachBlock(n, blockSize, numThreads, [&](size_t begin, size_t end) {
+            size_t * c = counts.data() + 256 * (begin / blockSize);
+            for (size_t i = begin; i < end; ++i) {
+                out[c[(key(in[i]) >> (8 * d)) & 0xff]++] = in[i];
+            }
+        });
+        std::swap(in, out);
+    }
+    if (in != values.data()) {
+        values.swap(buffer);
+    }
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_RADIXSORT_H_
@@ -26,7 +26,20 @@
 #include "lsst/sphgeom/RangeSet.h"
 
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
 #include <ostream>
+#include <stdexcept>
+#include <utility>
+
+#include "lsst/sphgeom/MemoryResourceScope.h"
+#include "lsst/sphgeom/codec.h"
+
+#include "Parallel.h"
+#include "PerformanceCounting.h"
+#include "RadixSort.h"
+#include "RangeSetSweep.h"
 
 
 namespace lsst {
@@ -38,6 +51,15 @@ namespace {
 // greater than or equal to i.
 inline ptrdiff_t roundUpToEven(ptrdiff_t i) { return i + (i & 1); }
 
+// `countMerge` records a merge of the [a, aend) and [b, bend) range
+// endpoint arrays in the library performance counters.
+inline void countMerge(uint64_t const * a, uint64_t const * aend,
+                       uint64_t const * b, uint64_t const * bend) {
+    detail::count(PerformanceCounter::RANGE_SET_MERGES);
+    detail::count(PerformanceCounter::RANGE_SET_MERGE_RANGES,
+                  static_cast<uint64_t>((aend - a) + (bend - b)) / 2);
+}
+
 
 // `RangeIter` is a stride-2 iterator over uint64_t values
 // in an underlying array.
@@ -88,6 +110,158 @@ struct RangeIter {
     uint64_t * ptr = nullptr;
 };
 
+// Intersections of range lists whose lengths differ by at least this
+// factor are computed by galloping through the longer list.
+constexpr size_t GALLOP_RATIO = 8;
+
+// `gallop` returns a pointer to the first range in [b, bend) with a last
+// value greater than or equal to x, or bend if there is no such range.
+// It performs an exponential search from b followed by a binary search,
+// and so runs in time logarithmic in the distance to the answer.
+uint64_t const * gallop(uint64_t const * b,
+                        uint64_t const * bend,
+                        uint64_t x)
+{
+    // One is subtracted from range end-points so that trailing zero
+    // bookends compare greater than all other values.
+    size_t const n = static_cast<size_t>(bend - b) >> 1;
+    if (n == 0 || b[1] - 1 >= x) {
+        return b;
+    }
+    // The range at index lo ends before x. Find hi such that the range
+    // at hi does not, or hi = n.
+    size_t lo = 0;
+    size_t step = 1;
+    size_t hi = 1;
+    while (hi < n && b[2 * hi + 1] - 1 < x) {
+        lo = hi;
+        step <<= 1;
+        hi = lo + step;
+    }
+    hi = std::min(hi, n);
+    while (hi - lo > 1) {
+        size_t mid = lo + ((hi - lo) >> 1);
+        if (b[2 * mid + 1] - 1 < x) {
+            lo = mid;
+        } else {
+            hi = mid;
+        }
+    }
+    return b + 2 * hi;
+}
+
+// `countAtMost` returns the number of elements less than or equal to u
+// in the sorted array x of length m, using a branch-free binary search.
+size_t countAtMost(uint64_t const * x, size_t m, uint64_t u) {
+    if (m == 0) {
+        return 0;
+    }
+    uint64_t const * p = x;
+    while (m > 1) {
+        size_t half = m >> 1;
+        p = (p[half] <= u) ? p + half : p;
+        m -= half;
+    }
+    return static_cast<size_t>(p - x) + (*p <= u);
+}
+
+// `countAtMost` returns the number of elements less than or equal to u
+// in the sorted array x of length m, given that at least c of them are.
+// It performs an exponential search forward from index c, and so runs in
+// time logarithmic in the difference between c and the answer.
+size_t countAtMost(uint64_t const * x, size_t m, size_t c, uint64_t u) {
+    if (c == m || x[c] > u) {
+        return c;
+    }
+    // x[lo] <= u; find hi such that x[hi] > u, or hi = m.
+    size_t lo = c;
+    size_t step = 1;
+    size_t hi = c + 1;
+    while (hi < m && x[hi] <= u) {
+        lo = hi;
+        step <<= 1;
+        hi = lo + step;
+    }
+    hi = std::min(hi, m);
+    return lo + 1 + countAtMost(x + lo + 1, hi - lo - 1, u);
+}
+
+char const * const NOT_AN_ENCODED_RANGESET =
+    "Byte-string is not an encoded RangeSet";
+
+// `decodeHeader` reads the header of a byte string produced by
+// RangeSet::encode, and returns a pointer to the first encoded point.
+uint8_t const * decodeHeader(uint8_t const * buffer,
+                             size_t n,
+                             size_t & numPoints,
+                             bool & containsZero)
+{
+    if (buffer == nullptr || n < 3 || buffer[0] != RangeSet::TYPE_CODE ||
+        buffer[1] > 1) {
+        throw std::runtime_error(NOT_AN_ENCODED_RANGESET);
+    }
+    uint8_t const * end = buffer + n;
+    uint64_t count = 0;
+    uint8_t const * p = decodeVarint(buffer + 2, end, count);
+    // Every point occupies at least one byte.
+    if (p == nullptr || count > static_cast<uint64_t>(end - p)) {
+        throw std::runtime_error(NOT_AN_ENCODED_RANGESET);
+    }
+    numPoints = static_cast<size_t>(count);
+    containsZero = (buffer[1] == 1);
+    return p;
+}
+
+// `decodePoint` reads the difference between the next point and the
+// point preceding it, and adds it to the latter.
+uint8_t const * decodePoint(uint8_t const * p,
+                            uint8_t const * end,
+                            uint64_t & point)
+{
+    uint64_t delta = 0;
+    p = decodeVarint(p, end, delta);
+    // Points must be strictly increasing, and must not wrap around.
+    if (p == nullptr || delta == 0 || delta > ~point) {
+        throw std::runtime_error(NOT_AN_ENCODED_RANGESET);
+    }
+    point += delta;
+    return p;
+}
+
+// `Compaction` decides which of the gaps between the n ranges with points
+// starting at r are filled in to leave at most maxRanges ranges: the gaps
+// shorter than `threshold`, and the first `ties` gaps with exactly that
+// length. Since filling in a gap adds as many integers as it is long, this
+// adds the fewest integers possible.
+struct Compaction {
+    uint64_t threshold;
+    size_t ties;
+
+    Compaction(uint64_t const * r, size_t n, size_t maxRanges) {
+        std::vector<uint64_t> gaps(n - 1);
+        for (size_t i = 0; i < n - 1; ++i) {
+            gaps[i] = r[2 * i + 2] - r[2 * i + 1];
+        }
+        size_t const numFilled = n - maxRanges;
+        auto nth = gaps.begin() + (numFilled - 1);
+        std::nth_element(gaps.begin(), nth, gaps.end());
+        threshold = *nth;
+        ties = numFilled - static_cast<size_t>(std::count_if(
+            gaps.begin(), nth, [this](uint64_t g) { return g < threshold; }));
+    }
+
+    // `fill` returns true if the next gap, of the given length, is filled.
+    bool fill(uint64_t gap) {
+        if (gap < threshold) {
+            return true;
+        } else if (gap == threshold && ties != 0) {
+            --ties;
+            return true;
+        }
+        return false;
+    }
+};
+
 } // unnamed namespace
 
 
@@ -107,8 +281,13 @@ void RangeSet::insert(uint64_t first, uint64_t last) {
     } else {
         // Ensure that there is enough space for 2 new values in _ranges.
         // Afterwards, none of the possible modifications of _ranges will throw,
-        // so the strong exception safety guarantee is provided.
-        _ranges.reserve(_ranges.size() + 2);
+        // so the strong exception safety guarantee is provided. Capacity is
+        // grown geometrically, so that appending ranges in ascending order
+        // takes amortized constant time per range.
+        size_t const size = _ranges.size();
+        if (_ranges.capacity() < size + 2) {
+            _ranges.reserve(std::max(2 * size, size + 2));
+        }
         if (first <= last - 1) {
             _insert(first, last);
         } else {
@@ -118,6 +297,48 @@ void RangeSet::insert(uint64_t first, uint64_t last) {
     }
 }
 
+void RangeSet::insertMany(uint64_t const * values, size_t n) {
+    std::vector<uint64_t> v(values, values + n);
+    _insertMany(v);
+}
+
+void RangeSet::_insertMany(std::vector<uint64_t> & values) {
+    if (values.empty()) {
+        return;
+    }
+    detail::radixSort(values, [](uint64_t v) { return v; });
+    // Collapse runs of consecutive integers into ranges, and build the
+    // range vector (including bookends) of the corresponding set.
+    RangeSet s(get_allocator());
+    s._ranges.clear();
+    s._ranges.push_back(0);
+    auto v = values.begin();
+    auto const vend = values.end();
+    while (v != vend) {
+        uint64_t first = *v;
+        uint64_t last = first;
+        for (++v; v != vend && *v - last <= 1; ++v) {
+            last = *v;
+        }
+        if (first == 0) {
+            // The leading bookend is the beginning of the first range.
+            s._offset = false;
+        } else {
+            s._ranges.push_back(first);
+        }
+        s._ranges.push_back(last + 1);
+    }
+    if (s._ranges.back() != 0) {
+        // Append a trailing bookend if necessary.
+        s._ranges.push_back(0);
+    }
+    if (empty()) {
+        swap(s);
+    } else {
+        *this |= s;
+    }
+}
+
 void RangeSet::erase(uint64_t first, uint64_t last) {
     // To erase [first, last), insert it into the complement of this set,
     // then complement the result. The complements are performed in the
@@ -133,7 +354,7 @@ void RangeSet::erase(uint64_t first, uint64_t last) {
 }
 
 RangeSet RangeSet::intersection(RangeSet const & s) const {
-    RangeSet result;
+    RangeSet result(get_allocator());
     if (this == &s) {
         result = s;
     } else {
@@ -143,7 +364,7 @@ RangeSet RangeSet::intersection(RangeSet const & s) const {
 }
 
 RangeSet RangeSet::join(RangeSet const & s) const {
-    RangeSet result;
+    RangeSet result(get_allocator());
     if (this == &s) {
         result = s;
     } else {
@@ -155,7 +376,7 @@ RangeSet RangeSet::join(RangeSet const & s) const {
 }
 
 RangeSet RangeSet::difference(RangeSet const & s) const {
-    RangeSet result;
+    RangeSet result(get_allocator());
     if (this != &s) {
         // A ∖ B = A ∩ ¬B
         result._intersect(_begin(), _end(), s._beginc(), s._endc());
@@ -164,8 +385,9 @@ RangeSet RangeSet::difference(RangeSet const & s) const {
 }
 
 RangeSet RangeSet::symmetricDifference(RangeSet const & s) const {
-    RangeSet result;
+    RangeSet result(get_allocator());
     if (this != &s) {
+        countMerge(_begin(), _end(), s._begin(), s._end());
         if (empty()) {
             result = s;
         } else if (s.empty()) {
@@ -238,6 +460,99 @@ RangeSet RangeSet::symmetricDifference(RangeSet const & s) const {
     return result;
 }
 
+RangeSet RangeSet::_combineAll(std::vector<RangeSet> const & sets,
+                               size_t threshold,
+                               unsigned numThreads)
+{
+    std::vector<detail::SweepInput> inputs;
+    inputs.reserve(sets.size());
+    size_t numPoints = 0;
+    for (RangeSet const & s: sets) {
+        uint64_t const * p = s._ranges.data();
+        inputs.push_back(detail::SweepInput{p + 1, p + s._ranges.size() - 1,
+                                    !s._offset});
+        numPoints += s._ranges.size() - 2;
+    }
+    // Choose the lower bounds of the intervals to sweep concurrently from
+    // a sample of the input points, so that intervals contain similar
+    // numbers of points. Small inputs are swept serially.
+    std::vector<uint64_t> bounds = {0};
+    if (numThreads > 1 && numPoints >= 65536) {
+        size_t const perSet = std::max<size_t>(
+            1, 64 * static_cast<size_t>(numThreads) / inputs.size());
+        std::vector<uint64_t> sample;
+        for (detail::SweepInput const & in: inputs) {
+            size_t const n = static_cast<size_t>(in.end - in.begin);
+            for (size_t j = 1; j <= perSet && j <= n; ++j) {
+                sample.push_back(in.begin[j * n / (perSet + 1)]);
+            }
+        }
+        std::sort(sample.begin(), sample.end());
+        for (unsigned t = 1; t < numThreads; ++t) {
+            uint64_t b = sample[t * sample.size() / numThreads];
+            if (b > bounds.back()) {
+                bounds.push_back(b);
+            }
+        }
+    }
+    size_t const numIntervals = bounds.size();
+    std::vector<std::vector<uint64_t>> points(numIntervals);
+    std::vector<char> initial(numIntervals);
+    std::vector<std::exception_ptr> errors(numIntervals);
+    auto work = [&](size_t i) {
+        try {
+            uint64_t hi = (i + 1 < numIntervals) ? bounds[i + 1] : 0;
+            bool init = false;
+            detail::sweep(
+                inputs, bounds[i], hi,
+                [threshold](std::vector<char> const &, size_t count) {
+                    return count >= threshold;
+                },
+                init,
+                [&points, i](uint64_t u) {
+                    points[i].push_back(u);
+                    return true;
+                });
+            initial[i] = init;
+        } catch (...) {
+            errors[i] = std::current_exception();
+        }
+    };
+    std::atomic<size_t> next{0};
+    detail::runInParallel(static_cast<unsigned>(numIntervals), [&]() {
+        for (size_t i = next++; i < numIntervals; i = next++) {
+            work(i);
+        }
+    });
+    for (std::exception_ptr const & e: errors) {
+        if (e) {
+            std::rethrow_exception(e);
+        }
+    }
+    // Concatenate the per-interval results. The lower bound of an interval
+    // is a membership change point iff membership differs on either side.
+    size_t n = 2;
+    for (auto const & p: points) {
+        n += p.size() + 1;
+    }
+    RangeSet result;
+    result._ranges.clear();
+    result._ranges.reserve(n);
+    result._ranges.push_back(0);
+    bool state = initial[0];
+    for (size_t i = 0; i < numIntervals; ++i) {
+        if (i > 0 && initial[i] != state) {
+            result._ranges.push_back(bounds[i]);
+        }
+        result._ranges.insert(result._ranges.end(),
+                              points[i].begin(), points[i].end());
+        state = (initial[i] != 0) != ((points[i].size() & 1) != 0);
+    }
+    result._ranges.push_back(0);
+    result._offset = !initial[0];
+    return result;
+}
+
 bool RangeSet::intersects(uint64_t first, uint64_t last) const {
     if (empty()) {
         return false;
@@ -284,6 +599,28 @@ bool RangeSet::contains(RangeSet const & s) const {
     return !_intersects(_beginc(), _endc(), s._begin(), s._end());
 }
 
+void RangeSet::contains(uint64_t const * values, size_t n, bool * out) const {
+    // The interior elements of _ranges (all but the leading and trailing
+    // zero bookends) are the strictly increasing boundaries between ranges
+    // of this set and ranges of its complement. If c of them are less than
+    // or equal to u, then u belongs to this set iff c and _offset have the
+    // same parity.
+    uint64_t const * x = _ranges.data() + 1;
+    size_t const m = _ranges.size() - 2;
+    size_t c = 0;
+    uint64_t prev = 0;
+    for (size_t i = 0; i < n; ++i) {
+        uint64_t u = values[i];
+        if (u >= prev) {
+            c = countAtMost(x, m, c, u);
+        } else {
+            c = countAtMost(x, m, u);
+        }
+        out[i] = ((c & 1) == _offset);
+        prev = u;
+    }
+}
+
 bool RangeSet::isWithin(uint64_t first, uint64_t last) const {
     if (empty() || first == last) {
         return true;
@@ -351,6 +688,49 @@ RangeSet & RangeSet::simplify(uint32_t n) {
     return *this;
 }
 
+RangeSet & RangeSet::compact(size_t maxRanges) {
+    size_t const n = size();
+    if (maxRanges == 0 || n <= maxRanges) {
+        return *this;
+    }
+    uint64_t * r = const_cast<uint64_t *>(_begin());
+    uint64_t * rend = const_cast<uint64_t *>(_end());
+    Compaction c(r, n, maxRanges);
+    // Filling in a gap removes the end of the range before it and the
+    // beginning of the range after it. The first beginning and the last
+    // end are never removed, so the bookends are unaffected.
+    uint64_t * out = r + 1;
+    for (uint64_t * p = r + 1; p != rend - 1; p += 2) {
+        uint64_t const last = p[0];
+        uint64_t const first = p[1];
+        if (!c.fill(first - last)) {
+            out[0] = last;
+            out[1] = first;
+            out += 2;
+        }
+    }
+    out = std::copy(rend - 1, _ranges.data() + _ranges.size(), out);
+    _ranges.erase(_ranges.begin() + (out - _ranges.data()), _ranges.end());
+    return *this;
+}
+
+double RangeSet::compactionOverCoverage(size_t maxRanges) const {
+    size_t const n = size();
+    if (maxRanges == 0 || n <= maxRanges) {
+        return 0.0;
+    }
+    uint64_t const * r = _begin();
+    Compaction c(r, n, maxRanges);
+    uint64_t added = 0;
+    for (size_t i = 0; i < n - 1; ++i) {
+        uint64_t const gap = r[2 * i + 2] - r[2 * i + 1];
+        if (c.fill(gap)) {
+            added += gap;
+        }
+    }
+    return static_cast<double>(added) / static_cast<double>(cardinality());
+}
+
 RangeSet & RangeSet::scale(uint64_t i) {
     if (empty() || i == 1) {
         return *this;
@@ -374,6 +754,57 @@ RangeSet & RangeSet::scale(uint64_t i) {
     return *this;
 }
 
+RangeSet & RangeSet::coarsen(uint32_t levels, bool interior) {
+    if (empty() || levels == 0) {
+        return *this;
+    }
+    if (levels >= 32) {
+        // Every integer has ancestor 0.
+        bool keep = interior ? full() : true;
+        clear();
+        if (keep) {
+            insert(0);
+        }
+        return *this;
+    }
+    uint32_t const n = 2 * levels;
+    // The coarse counterpart of an end-point of 0 (i.e. 2^64).
+    uint64_t const top = static_cast<uint64_t>(1) << (64 - n);
+    // Coarse ranges are produced in ascending order, so they can be
+    // appended to (and coalesced with) the result in a single pass.
+    RangeSet rs(get_allocator());
+    rs._ranges.reserve(_ranges.size() + 1);
+    for (auto r = _begin(), e = _end(); r != e; r += 2) {
+        uint64_t first;
+        uint64_t last;
+        if (interior) {
+            first = (r[0] == 0) ? 0 : ((r[0] - 1) >> n) + 1;
+            last = (r[1] == 0) ? top : r[1] >> n;
+        } else {
+            first = r[0] >> n;
+            last = (r[1] == 0) ? top : ((r[1] - 1) >> n) + 1;
+        }
+        if (first < last) {
+            rs.append(first, last);
+        }
+    }
+    swap(rs);
+    return *this;
+}
+
+RangeSet & RangeSet::refine(uint32_t levels) {
+    if (levels >= 32) {
+        // Only the descendants of 0 are representable.
+        bool keep = contains(0);
+        clear();
+        if (keep) {
+            fill();
+        }
+        return *this;
+    }
+    return scale(static_cast<uint64_t>(1) << (2 * levels));
+}
+
 bool RangeSet::isValid() const {
     // Bookends are mandatory.
     if (_ranges.size() < 2) {
@@ -474,80 +905,81 @@ void RangeSet::_insert(uint64_t first, uint64_t last) {
     }
 }
 
-/// `_intersectOne` stores the intersection of the single range pointed
-/// to by `a` and the ranges pointed to by `b` in `v`.
-void RangeSet::_intersectOne(std::vector<uint64_t> & v,
-                             uint64_t const * a,
-                             uint64_t const * b,
-                             uint64_t const * bend)
+/// `_intersectLinear` writes the intersection of the ranges pointed to by
+/// `a` and the ranges pointed to by `b` to `out`, using a linear merge, and
+/// returns the output iterator past the last value written.
+template <typename OutputIterator>
+OutputIterator RangeSet::_intersectLinear(OutputIterator out,
+                                          uint64_t const * a,
+                                          uint64_t const * aend,
+                                          uint64_t const * b,
+                                          uint64_t const * bend)
 {
-    // The range B = [b[0], bend[-1]) contains all the ranges
-    // [b[0], b[1]), ... , [bend[-2], bend[-1]). If [a[0], a[1])
-    // does not intersect B, it does not intersect any of them.
-    //
     // Note that one is subtracted from range end-points prior to
     // comparison - otherwise, trailing zero bookends would not be
     // ordered properly with respect to other values.
-    if (a[0] > bend[-1] - 1 || a[1] - 1 < b[0]) {
-        return;
-    }
-    if (b + 2 == bend) {
-        // Output the intersection of the ranges pointed to by a and b.
-        uint64_t u = std::max(a[0], b[0]);
-        if (u != 0) {
-            v.push_back(u);
-        }
-        v.push_back(std::min(a[1] - 1, b[1] - 1) + 1);
-    } else if (a[0] <= b[0] && a[1] - 1 >= bend[-1] - 1) {
-        // [a[0], a[1]) contains [b[0], bend[-1]), so it contains
-        // [b[0], b[1]), [b[2], b[3]), ... , [bend[-2], bend[-1]).
-        v.insert(v.end(), b + (b[0] == 0), bend);
-    } else {
-        // Divide and conquer - split the list of ranges pointed
-        // to by b in half and recurse.
-        uint64_t const * bmid = b + roundUpToEven((bend - b) >> 1);
-        _intersectOne(v, a, b, bmid);
-        _intersectOne(v, a, bmid, bend);
+    while (a != aend && b != bend) {
+        uint64_t alast = a[1] - 1;
+        uint64_t blast = b[1] - 1;
+        uint64_t first = std::max(a[0], b[0]);
+        uint64_t last = std::min(alast, blast);
+        if (first <= last) {
+            if (first != 0) {
+                *out++ = first;
+            }
+            *out++ = last + 1;
+        }
+        // Advance past whichever range(s) end first.
+        a += 2 * (alast <= blast);
+        b += 2 * (blast <= alast);
     }
+    return out;
 }
 
-/// `_intersect` stores the intersection of the ranges pointed to by `a`
-/// and the ranges pointed to by `b` in `v`.
-void RangeSet::_intersect(std::vector<uint64_t> & v,
-                          uint64_t const * a,
-                          uint64_t const * aend,
-                          uint64_t const * b,
-                          uint64_t const * bend)
+/// `_intersectGallop` writes the intersection of the ranges pointed to by
+/// `a` and the ranges pointed to by `b` to `out`, and returns the output
+/// iterator past the last value written. For each range in `a`, the
+/// overlapping ranges in `b` are located with exponential searches, so that
+/// the cost is O(n log(m/n)) rather than O(n + m) when `a` holds n ranges
+/// and `b` holds m ≫ n.
+template <typename OutputIterator>
+OutputIterator RangeSet::_intersectGallop(OutputIterator out,
+                                          uint64_t const * a,
+                                          uint64_t const * aend,
+                                          uint64_t const * b,
+                                          uint64_t const * bend)
 {
-    // The range A = [a[0], aend[-1]) contains all the ranges
-    // [a[0], a[1]), ... , [aend[-2], aend[-1]), and similarly,
-    // B = [b[0], bend[-1]) contains all the ranges pointed to by b.
-    // A and B must intersect if any of the ranges pointed to by
-    // a and b do, so if A and B are disjoint there is nothing to do.
-    //
-    // Note that one is subtracted from range end-points prior to
-    // comparison - otherwise, trailing zero bookends would not be
-    // ordered properly with respect to other values.
-    if (a + 2 == aend) {
-        _intersectOne(v, a, b, bend);
-    } else if (b + 2 == bend) {
-        _intersectOne(v, b, a, aend);
-    } else if (a[0] <= bend[-1] - 1 && aend[-1] - 1 >= b[0]) {
-        // Divide and conquer - split the lists of ranges pointed to by a and b
-        // in half and recurse. This is a depth first dual-tree traversal of
-        // implicit balanced binary trees, where a sorted list of ranges forms
-        // the bottom level of a tree, and level N - 1 is obtained from level N
-        // by joining adjacent ranges.
-        //
-        // Note that the order of the recursive calls matters -
-        // output must be generated in sorted order.
-        uint64_t const * amid = a + roundUpToEven((aend - a) >> 1);
-        uint64_t const * bmid = b + roundUpToEven((bend - b) >> 1);
-        _intersect(v, a, amid, b, bmid);
-        _intersect(v, a, amid, bmid, bend);
-        _intersect(v, amid, aend, b, bmid);
-        _intersect(v, amid, aend, bmid, bend);
+    for (; a != aend; a += 2) {
+        b = gallop(b, bend, a[0]);
+        if (b == bend) {
+            break;
+        }
+        uint64_t alast = a[1] - 1;
+        if (b[0] > alast) {
+            continue;
+        }
+        // All ranges in [b, e) end before [a[0], a[1]) does, and all but
+        // the first are contained in it.
+        uint64_t const * e = gallop(b, bend, alast);
+        if (b != e) {
+            uint64_t first = std::max(a[0], b[0]);
+            if (first != 0) {
+                *out++ = first;
+            }
+            *out++ = b[1];
+            out = std::copy(b + 2, e, out);
+        }
+        if (e != bend && e[0] <= alast) {
+            uint64_t first = std::max(a[0], e[0]);
+            if (first != 0) {
+                *out++ = first;
+            }
+            *out++ = a[1];
+        }
+        // The range at e may also intersect the next range in a.
+        b = e;
     }
+    return out;
 }
 
 void RangeSet::_intersect(uint64_t const * a,
@@ -555,6 +987,7 @@ void RangeSet::_intersect(uint64_t const * a,
                           uint64_t const * b,
                           uint64_t const * bend)
 {
+    countMerge(a, aend, b, bend);
     if (a == aend || b == bend) {
         clear();
     } else {
@@ -564,13 +997,77 @@ void RangeSet::_intersect(uint64_t const * a,
         // and _offset must be 0 (false).
         _offset = ((*a != 0) || (*b != 0));
         // Compute the intersection and append a trailing bookend if necessary.
-        _intersect(_ranges, a, aend, b, bend);
+        // When one list of ranges is much shorter than the other, galloping
+        // through the longer list avoids visiting most of its ranges.
+        size_t na = static_cast<size_t>(aend - a);
+        size_t nb = static_cast<size_t>(bend - b);
+        auto out = std::back_inserter(_ranges);
+        if (na * GALLOP_RATIO <= nb) {
+            _intersectGallop(out, a, aend, b, bend);
+        } else if (nb * GALLOP_RATIO <= na) {
+            _intersectGallop(out, b, bend, a, aend);
+        } else {
+            _intersectLinear(out, a, aend, b, bend);
+        }
         if ((aend[-1] != 0) || (bend[-1] != 0)) {
             _ranges.push_back(0);
         }
     }
 }
 
+/// `_intersectInPlace` replaces this set, or its complement if `complement`
+/// is true, with its intersection with the ranges pointed to by `b`.
+///
+/// The ranges of this set are first moved to the back of its vector,
+/// leaving room for one more value than `b` holds in front of them. The
+/// intersection is then merged into the vector from the front. Each range
+/// written is the intersection of a range of this set and a range of `b`,
+/// and these pairs are ordered in both sets. So while the i-th range of
+/// this set is being read, at most i + m ranges have been written, where m
+/// is the number of ranges in `b`, and outputs never overwrite the ranges
+/// of this set that are still needed.
+void RangeSet::_intersectInPlace(uint64_t const * b,
+                                 uint64_t const * bend,
+                                 bool complement)
+{
+    uint64_t const * a = complement ? _beginc() : _begin();
+    uint64_t const * aend = complement ? _endc() : _end();
+    size_t const na = static_cast<size_t>(aend - a);
+    size_t const nb = static_cast<size_t>(bend - b);
+    countMerge(a, aend, b, bend);
+    if (na == 0 || nb == 0) {
+        clear();
+        return;
+    }
+    if (na * GALLOP_RATIO <= nb) {
+        // Making room for all of b would dwarf this set, so compute the
+        // intersection in a new vector, whose size is bounded by the output.
+        RangeSet s(get_allocator());
+        s._intersect(a, aend, b, bend);
+        swap(s);
+        return;
+    }
+    bool const offset = (*a != 0) || (*b != 0);
+    bool const bookend = (aend[-1] != 0) || (bend[-1] != 0);
+    size_t const i = static_cast<size_t>(a - _ranges.data());
+    size_t const gap = nb + 1;
+    // Only the resize can throw; if it does, this set is unchanged.
+    _ranges.resize(gap + na);
+    uint64_t * data = _ranges.data();
+    std::copy_backward(data + i, data + i + na, data + gap + na);
+    a = data + gap;
+    aend = a + na;
+    data[0] = 0;
+    uint64_t * out = (nb * GALLOP_RATIO <= na) ?
+        _intersectGallop(data + 1, b, bend, a, aend) :
+        _intersectLinear(data + 1, a, aend, b, bend);
+    if (bookend) {
+        *out++ = 0;
+    }
+    _ranges.resize(static_cast<size_t>(out - data));
+    _offset = offset;
+}
+
 /// `_intersectsOne` checks if the single range pointed to by `a` intersects
 /// any of the ranges pointed to by `b`.
 bool RangeSet::_intersectsOne(uint64_t const * a,
@@ -613,6 +1110,114 @@ bool RangeSet::_intersects(uint64_t const * a,
            _intersects(amid, aend, bmid, bend);
 }
 
+std::vector<uint8_t> RangeSet::encode() const {
+    // The points stored between the leading and trailing zero bookends
+    // are strictly increasing, so their differences are all positive.
+    size_t const numPoints = _ranges.size() - 2;
+    std::vector<uint8_t> buffer;
+    buffer.reserve(12 + numPoints);
+    buffer.push_back(TYPE_CODE);
+    buffer.push_back(_offset ? 0 : 1);
+    encodeVarint(numPoints, buffer);
+    uint64_t previous = 0;
+    for (size_t i = 1; i <= numPoints; ++i) {
+        encodeVarint(_ranges[i] - previous, buffer);
+        previous = _ranges[i];
+    }
+    return buffer;
+}
+
+RangeSet RangeSet::decode(uint8_t const * buffer, size_t n) {
+    size_t numPoints = 0;
+    bool containsZero = false;
+    uint8_t const * p = decodeHeader(buffer, n, numPoints, containsZero);
+    uint8_t const * end = buffer + n;
+    RangeSet s(MemoryResourceScope::current());
+    s._ranges.clear();
+    s._ranges.reserve(numPoints + 2);
+    s._ranges.push_back(0);
+    uint64_t point = 0;
+    for (size_t i = 0; i < numPoints; ++i) {
+        p = decodePoint(p, end, point);
+        s._ranges.push_back(point);
+    }
+    if (p != end) {
+        throw std::runtime_error(NOT_AN_ENCODED_RANGESET);
+    }
+    s._ranges.push_back(0);
+    s._offset = !containsZero;
+    return s;
+}
+
+RangeSetDecoder::RangeSetDecoder(uint8_t const * buffer, size_t n) :
+    _end(buffer + n)
+{
+    _begin = decodeHeader(buffer, n, _numPoints, _containsZero);
+    rewind();
+}
+
+void RangeSetDecoder::rewind() {
+    _cursor = _begin;
+    _remaining = _numPoints;
+    _point = 0;
+    _pendingZero = _containsZero;
+}
+
+uint64_t RangeSetDecoder::_nextPoint() {
+    _cursor = decodePoint(_cursor, _end, _point);
+    --_remaining;
+    if (_remaining == 0 && _cursor != _end) {
+        throw std::runtime_error(NOT_AN_ENCODED_RANGESET);
+    }
+    return _point;
+}
+
+bool RangeSetDecoder::next(uint64_t & first, uint64_t & last) {
+    if (_pendingZero) {
+        _pendingZero = false;
+        first = 0;
+    } else if (_remaining == 0) {
+        return false;
+    } else {
+        first = _nextPoint();
+    }
+    // If the points run out, the range contains 2^64 - 1 and its end point
+    // is the trailing zero bookend, which is not encoded.
+    last = (_remaining == 0) ? 0 : _nextPoint();
+    return true;
+}
+
+bool RangeSetDecoder::intersects(uint64_t first, uint64_t last) const {
+    if (empty()) {
+        return false;
+    }
+    if (first == last) {
+        return true;
+    }
+    if (first <= last - 1) {
+        return _intersects(first, last);
+    }
+    return _intersects(0, last) || _intersects(first, 0);
+}
+
+bool RangeSetDecoder::_intersects(uint64_t first, uint64_t last) const {
+    RangeSetDecoder d(*this);
+    d.rewind();
+    uint64_t b = 0;
+    uint64_t e = 0;
+    // Subtract one from end points before comparisons so that an end
+    // point of 0 is ordered properly.
+    while (d.next(b, e)) {
+        if (b > last - 1) {
+            return false;
+        }
+        if (e - 1 >= first) {
+            return true;
+        }
+    }
+    return false;
+}
+
 std::ostream & operator<<(std::ostream & os, RangeSet const & s) {
     os << "{\"RangeSet\": [";
     bool first = true;
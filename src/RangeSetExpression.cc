@@ -0,0 +1,237 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RangeSetExpression implementation.
+
+#include "lsst/sphgeom/RangeSetExpression.h"
+
+#include <algorithm>
+
+#include "RangeSetSweep.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Membership in expressions with at most this many distinct operands is
+// tabulated in a single word, indexed by the memberships of the operands.
+constexpr size_t MAX_TABULATED_OPERANDS = 6;
+
+// Bit m of COLUMNS[i] is bit i of m.
+constexpr uint64_t COLUMNS[MAX_TABULATED_OPERANDS] = {
+    0xaaaaaaaaaaaaaaaa,
+    0xcccccccccccccccc,
+    0xf0f0f0f0f0f0f0f0,
+    0xff00ff00ff00ff00,
+    0xffff0000ffff0000,
+    0xffffffff00000000
+};
+
+// `sweepTabulated` is like detail::sweep for k ≤ MAX_TABULATED_OPERANDS
+// sets, with membership given by bit m of `table` for an integer in the
+// sets whose indexes are the bits of m. It returns whether 0 is a member.
+//
+// Rather than maintaining a heap, it finds the next point by scanning the
+// sets, which is faster for so few of them. One is subtracted from points,
+// which are never 0, so that the trailing zero bookend of an exhausted set
+// becomes the largest uint64_t, which no other point can become.
+template <typename Sink>
+bool sweepTabulated(std::vector<detail::SweepInput> const & inputs,
+                    uint64_t table,
+                    Sink && sink)
+{
+    size_t const k = inputs.size();
+    uint64_t const exhausted = ~uint64_t(0);
+    uint64_t const * next[MAX_TABULATED_OPERANDS];
+    uint64_t key[MAX_TABULATED_OPERANDS];
+    unsigned mask = 0;
+    for (size_t i = 0; i < k; ++i) {
+        next[i] = inputs[i].begin;
+        key[i] = *next[i] - 1;
+        mask |= unsigned(inputs[i].containsZero) << i;
+    }
+    bool const initial = ((table >> mask) & 1) != 0;
+    bool state = initial;
+    while (true) {
+        uint64_t u = key[0];
+        for (size_t i = 1; i < k; ++i) {
+            u = std::min(u, key[i]);
+        }
+        if (u == exhausted) {
+            break;
+        }
+        for (size_t i = 0; i < k; ++i) {
+            if (key[i] == u) {
+                mask ^= 1u << i;
+                key[i] = *++next[i] - 1;
+            }
+        }
+        if ((((table >> mask) & 1) != 0) != state) {
+            state = !state;
+            if (!sink(u + 1)) {
+                break;
+            }
+        }
+    }
+    return initial;
+}
+
+} // unnamed namespace
+
+RangeSetExpression RangeSetExpression::_combine(RangeSetExpression const & a,
+                                                RangeSetExpression const & b,
+                                                Opcode opcode)
+{
+    RangeSetExpression r(a);
+    r._program.reserve(a._program.size() + b._program.size() + 1);
+    // Operands of b that are also operands of a are swept only once.
+    std::vector<uint32_t> index(b._operands.size());
+    for (size_t i = 0; i < b._operands.size(); ++i) {
+        auto o = std::find(r._operands.begin(), r._operands.end(),
+                           b._operands[i]);
+        index[i] = static_cast<uint32_t>(o - r._operands.begin());
+        if (o == r._operands.end()) {
+            r._operands.push_back(b._operands[i]);
+        }
+    }
+    for (Instruction const & i: b._program) {
+        r._program.push_back(
+            {i.opcode, i.opcode == OPERAND ? index[i.operand] : 0});
+    }
+    r._program.push_back({opcode, 0});
+    return r;
+}
+
+uint64_t RangeSetExpression::_evaluate(uint64_t const * operands,
+                                       std::vector<uint64_t> & stack) const
+{
+    stack.clear();
+    for (Instruction const & i: _program) {
+        if (i.opcode == OPERAND) {
+            stack.push_back(operands[i.operand]);
+            continue;
+        }
+        if (i.opcode == NOT) {
+            stack.back() = ~stack.back();
+            continue;
+        }
+        uint64_t const b = stack.back();
+        stack.pop_back();
+        uint64_t & a = stack.back();
+        switch (i.opcode) {
+            case AND: a &= b; break;
+            case OR: a |= b; break;
+            case DIFFERENCE: a &= ~b; break;
+            default: a ^= b; break;
+        }
+    }
+    return stack.back();
+}
+
+// `_sweep` calls `sink(u)` for each point u at which membership in this
+// expression changes, in ascending order, until it returns false. It returns
+// whether or not the expression contains 0.
+template <typename Sink>
+bool RangeSetExpression::_sweep(Sink && sink) const {
+    std::vector<detail::SweepInput> inputs;
+    inputs.reserve(_operands.size());
+    for (RangeSet const * s: _operands) {
+        uint64_t const * p = s->_ranges.data();
+        inputs.push_back(detail::SweepInput{
+            p + 1, p + s->_ranges.size() - 1, !s->_offset});
+    }
+    std::vector<uint64_t> stack;
+    stack.reserve(_program.size());
+    size_t const k = inputs.size();
+    if (k > MAX_TABULATED_OPERANDS) {
+        std::vector<uint64_t> words(k);
+        bool initial = false;
+        detail::sweep(
+            inputs, 0, 0,
+            [this, &words, &stack](std::vector<char> const & inside, size_t) {
+                for (size_t i = 0; i < words.size(); ++i) {
+                    words[i] = inside[i] ? ~uint64_t(0) : 0;
+                }
+                return (_evaluate(words.data(), stack) & 1) != 0;
+            },
+            initial,
+            sink);
+        return initial;
+    }
+    // Bit m of the table tells whether an integer belongs to the expression
+    // when the operands containing it are those given by the bits of m.
+    return sweepTabulated(inputs, _evaluate(COLUMNS, stack), sink);
+}
+
+RangeSet RangeSetExpression::evaluate() const {
+    RangeSet result;
+    result._ranges.clear();
+    result._ranges.push_back(0);
+    bool initial = _sweep([&result](uint64_t u) {
+        result._ranges.push_back(u);
+        return true;
+    });
+    result._ranges.push_back(0);
+    result._offset = !initial;
+    return result;
+}
+
+bool RangeSetExpression::empty() const {
+    bool change = false;
+    bool initial = _sweep([&change](uint64_t) {
+        change = true;
+        return false;
+    });
+    return !initial && !change;
+}
+
+uint64_t RangeSetExpression::cardinality() const {
+    // Membership changes at the points p_0 < p_1 < ... < p_n-1. If the
+    // expression contains 0, its ranges are [0, p_0), [p_1, p_2), ..., and
+    // otherwise they are [p_0, p_1), [p_2, p_3), ..., where an end point of
+    // 2^64 is 0 modulo 2^64. So the cardinality is p_0 - p_1 + p_2 - ...
+    // modulo 2^64 in the first case, and its negation in the second.
+    uint64_t sum = 0;
+    bool odd = false;
+    bool initial = _sweep([&sum, &odd](uint64_t u) {
+        sum = odd ? sum - u : sum + u;
+        odd = !odd;
+        return true;
+    });
+    return initial ? sum : 0 - sum;
+}
+
+bool RangeSetExpression::contains(uint64_t u) const {
+    std::vector<uint64_t> words;
+    words.reserve(_operands.size());
+    for (RangeSet const * s: _operands) {
+        words.push_back(s->contains(u) ? ~uint64_t(0) : 0);
+    }
+    std::vector<uint64_t> stack;
+    stack.reserve(_program.size());
+    return (_evaluate(words.data(), stack) & 1) != 0;
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,149 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RangeSetIndex implementation.
+
+#include "lsst/sphgeom/RangeSetIndex.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+
+namespace lsst {
+namespace sphgeom {
+
+RangeSetIndex::RangeSetIndex(RangeSet const & s) :
+    _full(s.full())
+{
+    _bounds.reserve(2 * s.size());
+    _counts.reserve(s.size());
+    for (auto const & r: s) {
+        uint64_t const first = std::get<0>(r);
+        uint64_t const last = std::get<1>(r);
+        _bounds.push_back(first);
+        _bounds.push_back(last);
+        _counts.push_back(_cardinality);
+        // An end of 0 means 2⁶⁴, and the range length is computed modulo
+        // 2⁶⁴, which is exact for all ranges but that of a full set.
+        _cardinality += last - first;
+    }
+}
+
+RangeSet RangeSetIndex::getRangeSet() const {
+    RangeSet s;
+    for (size_t i = 0; i < _bounds.size(); i += 2) {
+        s.append(_bounds[i], _bounds[i + 1]);
+    }
+    return s;
+}
+
+size_t RangeSetIndex::_find(uint64_t k) const {
+    // The ranges are non-empty, so the counts are strictly increasing.
+    return static_cast<size_t>(
+        std::upper_bound(_counts.begin(), _counts.end(), k) -
+        _counts.begin()) - 1;
+}
+
+uint64_t RangeSetIndex::select(uint64_t k) const {
+    if (_full) {
+        return k;
+    }
+    if (k >= _cardinality) {
+        throw std::out_of_range("Rank is not less than the set cardinality");
+    }
+    size_t const i = _find(k);
+    return _bounds[2 * i] + (k - _counts[i]);
+}
+
+RangeSet RangeSetIndex::select(uint64_t first, uint64_t last) const {
+    RangeSet s;
+    if (_full) {
+        if (last == 0 || first < last) {
+            s.insert(first, last);
+        }
+        return s;
+    }
+    if (last == 0 || last > _cardinality) {
+        last = _cardinality;
+    }
+    if (first >= last) {
+        return s;
+    }
+    // The set is not full, so counts can not overflow.
+    for (size_t i = _find(first); i < _counts.size() && _counts[i] < last; ++i) {
+        uint64_t const begin = _bounds[2 * i];
+        uint64_t const end = _counts[i] + (_bounds[2 * i + 1] - begin);
+        s.append(begin + (std::max(first, _counts[i]) - _counts[i]),
+                 end <= last ? _bounds[2 * i + 1] :
+                               begin + (last - _counts[i]));
+    }
+    return s;
+}
+
+uint64_t RangeSetIndex::rank(uint64_t i) const {
+    if (_full) {
+        return i;
+    }
+    // Find the number of ranges beginning at or before i.
+    size_t lo = 0;
+    size_t hi = size();
+    while (lo < hi) {
+        size_t const mid = lo + (hi - lo) / 2;
+        if (_bounds[2 * mid] <= i) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return 0;
+    }
+    uint64_t const first = _bounds[2 * lo - 2];
+    uint64_t const last = _bounds[2 * lo - 1];
+    if (last == 0 || i < last) {
+        return _counts[lo - 1] + (i - first);
+    }
+    return _counts[lo - 1] + (last - first);
+}
+
+void RangeSetIndex::sample(size_t n, std::mt19937_64 & rng,
+                           uint64_t * out) const
+{
+    if (empty()) {
+        throw std::invalid_argument("Cannot sample an empty set");
+    }
+    if (_full) {
+        // std::mt19937_64 produces uniformly distributed 64 bit integers.
+        std::generate(out, out + n, [&rng]() {
+            return static_cast<uint64_t>(rng());
+        });
+        return;
+    }
+    std::uniform_int_distribution<uint64_t> uniform(0, _cardinality - 1);
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = select(uniform(rng));
+    }
+}
+
+}} // namespace lsst::sphgeom
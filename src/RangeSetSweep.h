@@ -0,0 +1,119 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_SPHGEOM_RANGESETSWEEP_H_
+#define LSST_SPHGEOM_RANGESETSWEEP_H_
+
+/// \file
+/// \brief This file provides a sweep over the boundaries of many range sets.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+
+namespace lsst {
+namespace sphgeom {
+namespace detail {
+
+/// `SweepInput` holds the strictly increasing points of a set, i.e. the
+/// elements of RangeSet::_ranges other than the zero bookends, and whether
+/// or not the set contains 0.
+struct SweepInput {
+    uint64_t const * begin;
+    uint64_t const * end;
+    bool containsZero;
+};
+
+/// `sweep` visits the points in (lo, hi) at which membership in a boolean
+/// combination of the given sets changes, where hi = 0 stands for 2^64.
+///
+/// The combination is defined by `member(inside, count)`, which must return
+/// whether an integer belongs to it, given a vector of flags telling which
+/// sets contain the integer, and the number of such sets. `initial` is set
+/// to whether lo belongs to the combination before any point is visited.
+/// Then, `sink(u)` is called for each point u in ascending order, and the
+/// sweep stops early if it returns false.
+///
+/// The sweep merges the points of all sets using a heap, and so takes
+/// O(N log k) time for k sets with a total of N points.
+template <typename Member, typename Sink>
+void sweep(std::vector<SweepInput> const & sets,
+           uint64_t lo,
+           uint64_t hi,
+           Member const & member,
+           bool & initial,
+           Sink && sink)
+{
+    // A min-heap of (next point, set index) pairs.
+    using Entry = std::pair<uint64_t, size_t>;
+    std::vector<Entry> heap;
+    std::vector<uint64_t const *> next(sets.size());
+    std::vector<char> inside(sets.size());
+    heap.reserve(sets.size());
+    size_t count = 0;
+    for (size_t i = 0; i < sets.size(); ++i) {
+        SweepInput const & s = sets[i];
+        // An integer u is in s iff the number of points less than or equal
+        // to u and s.containsZero have different parities.
+        uint64_t const * p = std::upper_bound(s.begin, s.end, lo);
+        inside[i] = (((p - s.begin) & 1) != 0) != s.containsZero;
+        count += inside[i];
+        next[i] = p;
+        if (p != s.end && (hi == 0 || *p < hi)) {
+            heap.emplace_back(*p, i);
+        }
+    }
+    auto greater = std::greater<Entry>();
+    std::make_heap(heap.begin(), heap.end(), greater);
+    initial = member(inside, count);
+    bool state = initial;
+    while (!heap.empty()) {
+        uint64_t const u = heap.front().first;
+        // Toggle the membership of every set with a point equal to u.
+        while (!heap.empty() && heap.front().first == u) {
+            std::pop_heap(heap.begin(), heap.end(), greater);
+            size_t const i = heap.back().second;
+            heap.pop_back();
+            count = inside[i] ? count - 1 : count + 1;
+            inside[i] = !inside[i];
+            uint64_t const * p = ++next[i];
+            if (p != sets[i].end && (hi == 0 || *p < hi)) {
+                heap.emplace_back(*p, i);
+                std::push_heap(heap.begin(), heap.end(), greater);
+            }
+        }
+        if (member(inside, count) != state) {
+            state = !state;
+            if (!sink(u)) {
+                return;
+            }
+        }
+    }
+}
+
+}}} // namespace lsst::sphgeom::detail
+
+#endif // LSST_SPHGEOM_RANGESETSWEEP_H_
@@ -0,0 +1,223 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RangeSetView class implementation.
+
+#include "lsst/sphgeom/RangeSetView.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <stdexcept>
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The number of 64 bit words preceding the points of a set.
+size_t const HEADER_WORDS = 3;
+
+char const * const NOT_A_RANGESET_FILE =
+    "Buffer does not contain a RangeSet written by RangeSetView::write";
+
+uint64_t const EMPTY[2] = {0, 0};
+
+} // unnamed namespace
+
+void RangeSetView::write(RangeSet const & s, std::string const & path) {
+    uint64_t const header[HEADER_WORDS] = {
+        MAGIC,
+        s._offset ? 0u : 1u,
+        s._ranges.size()
+    };
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<char const *>(header), sizeof(header));
+    out.write(reinterpret_cast<char const *>(s._ranges.data()),
+              s._ranges.size() * sizeof(uint64_t));
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Unable to write RangeSet to " + path);
+    }
+}
+
+RangeSetView::RangeSetView() : _ranges(EMPTY), _size(2), _offset(true) {}
+
+RangeSetView::RangeSetView(std::string const & path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open " + path);
+    }
+    struct ::stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Unable to stat " + path);
+    }
+    size_t n = static_cast<size_t>(st.st_size);
+    if (n < HEADER_WORDS * sizeof(uint64_t)) {
+        ::close(fd);
+        throw std::runtime_error(NOT_A_RANGESET_FILE);
+    }
+    void * p = ::mmap(nullptr, n, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping remains valid after the file descriptor is closed.
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("Unable to map " + path);
+    }
+    _mapping = std::shared_ptr<void const>(p, [n](void const * q) {
+        ::munmap(const_cast<void *>(q), n);
+    });
+    _init(p, n);
+}
+
+RangeSetView::RangeSetView(void const * buffer, size_t n) {
+    _init(buffer, n);
+}
+
+RangeSetView::RangeSetView(RangeSet const & s) :
+    _ranges(s._ranges.data()),
+    _size(s._ranges.size()),
+    _offset(s._offset)
+{}
+
+void RangeSetView::_init(void const * buffer, size_t n) {
+    if (n < HEADER_WORDS * sizeof(uint64_t) ||
+        n % sizeof(uint64_t) != 0 ||
+        reinterpret_cast<uintptr_t>(buffer) % alignof(uint64_t) != 0) {
+        throw std::runtime_error(NOT_A_RANGESET_FILE);
+    }
+    uint64_t const * header = static_cast<uint64_t const *>(buffer);
+    size_t const size = n / sizeof(uint64_t) - HEADER_WORDS;
+    if (header[0] != MAGIC || header[1] > 1 || header[2] != size ||
+        size < 2) {
+        throw std::runtime_error(NOT_A_RANGESET_FILE);
+    }
+    _ranges = header + HEADER_WORDS;
+    _size = size;
+    _offset = (header[1] == 0);
+    if (_ranges[0] != 0 || _ranges[_size - 1] != 0) {
+        throw std::runtime_error(NOT_A_RANGESET_FILE);
+    }
+}
+
+RangeSet RangeSetView::toRangeSet() const {
+    RangeSet s;
+    s._ranges.assign(_ranges, _ranges + _size);
+    s._offset = _offset;
+    return s;
+}
+
+bool RangeSetView::intersects(uint64_t first, uint64_t last) const {
+    // See RangeSet::intersects.
+    if (empty()) {
+        return false;
+    }
+    if (first == last) {
+        return true;
+    }
+    if (first <= last - 1) {
+        uint64_t r[2] = {first, last};
+        return RangeSet::_intersectsOne(r, _begin(), _end());
+    }
+    uint64_t r[4] = {0, last, first, 0};
+    return RangeSet::_intersectsOne(r, _begin(), _end()) ||
+           RangeSet::_intersectsOne(r + 2, _begin(), _end());
+}
+
+bool RangeSetView::intersects(RangeSet const & s) const {
+    if (empty() || s.empty()) {
+        return false;
+    }
+    return RangeSet::_intersects(_begin(), _end(), s._begin(), s._end());
+}
+
+bool RangeSetView::contains(uint64_t first, uint64_t last) const {
+    // See RangeSet::contains.
+    if (full()) {
+        return true;
+    }
+    if (first == last) {
+        return false;
+    }
+    if (first <= last - 1) {
+        uint64_t r[2] = {first, last};
+        return !RangeSet::_intersectsOne(r, _beginc(), _endc());
+    }
+    uint64_t r[4] = {0, last, first, 0};
+    return !RangeSet::_intersectsOne(r, _beginc(), _endc()) &&
+           !RangeSet::_intersectsOne(r + 2, _beginc(), _endc());
+}
+
+bool RangeSetView::contains(RangeSet const & s) const {
+    if (s.empty() || full()) {
+        return true;
+    }
+    return !RangeSet::_intersects(_beginc(), _endc(), s._begin(), s._end());
+}
+
+bool RangeSetView::isWithin(uint64_t first, uint64_t last) const {
+    // See RangeSet::isWithin.
+    if (empty() || first == last) {
+        return true;
+    }
+    if (last <= first - 1) {
+        uint64_t r[2] = {last, first};
+        return !RangeSet::_intersectsOne(r, _begin(), _end());
+    }
+    uint64_t r[4] = {0, first, last, 0};
+    return !RangeSet::_intersectsOne(r, _begin(), _end()) &&
+           !RangeSet::_intersectsOne(r + 2, _begin(), _end());
+}
+
+bool RangeSetView::isWithin(RangeSet const & s) const {
+    if (empty() || s.full()) {
+        return true;
+    }
+    return !RangeSet::_intersects(s._beginc(), s._endc(), _begin(), _end());
+}
+
+uint64_t RangeSetView::cardinality() const {
+    uint64_t sz = 0;
+    for (auto r = _begin(), e = _end(); r != e; r += 2) {
+        sz += r[1] - r[0];
+    }
+    return sz;
+}
+
+bool RangeSetView::isValid() const {
+    if (_size < 2 || _ranges[0] != 0 || _ranges[_size - 1] != 0) {
+        return false;
+    }
+    for (size_t i = 2; i < _size - 1; ++i) {
+        if (_ranges[i] <= _ranges[i - 1]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}} // namespace lsst::sphgeom
@@ -23,7 +23,11 @@
 /// \file
 /// \brief This file contains the Region class implementation.
 
+#include <algorithm>
+#include <cstdint>
 #include <stdexcept>
+#include <typeinfo>
+#include <vector>
 
 #include "lsst/sphgeom/Region.h"
 
@@ -32,11 +36,129 @@
 #include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/Ellipse.h"
 #include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/PixelRegion.h"
 #include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "Parallel.h"
+#include "PerformanceCounting.h"
 
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+// Targets of relateMany are handed out to threads in blocks of this size.
+constexpr size_t RELATE_BLOCK_SIZE = 1024;
+
+// Points tested by the multi-threaded contains are handed out to threads
+// in blocks of this size.
+constexpr size_t CONTAINS_BLOCK_SIZE = 16384;
+
+enum RegionKind { BOX, CIRCLE, POLYGON, ELLIPSE, OTHER };
+
+RegionKind getKind(Region const & r) {
+    std::type_info const & t = typeid(r);
+    if (t == typeid(ConvexPolygon)) {
+        return POLYGON;
+    } else if (t == typeid(Circle)) {
+        return CIRCLE;
+    } else if (t == typeid(Box)) {
+        return BOX;
+    } else if (t == typeid(Ellipse)) {
+        return ELLIPSE;
+    }
+    return OTHER;
+}
+
+// `relateOne` computes q.relate(t) without virtual calls if the query type
+// is known. Like the virtual Q::relate(Region const &) overloads, it
+// dispatches on the type of the target by calling T::relate(Q const &), so
+// that the results are identical even where Q::relate(T const &) differs,
+// e.g. for two ellipses. If either type is not known, it falls back to the
+// virtual relate(Region const &).
+template <typename Q, typename T>
+Relationship relateOne(Q const & q, T const & t) {
+    return invert(t.T::relate(q));
+}
+
+template <typename Q>
+Relationship relateOne(Q const & q, Region const & t) {
+    return q.relate(t);
+}
+
+template <typename T>
+Relationship relateOne(Region const & q, T const & t) {
+    return q.relate(static_cast<Region const &>(t));
+}
+
+Relationship relateOne(Region const & q, Region const & t) {
+    return q.relate(t);
+}
+
+template <typename Q, typename T>
+void relateGroup(Q const & q,
+                 Region const * const * targets,
+                 size_t begin,
+                 size_t end,
+                 Relationship * out)
+{
+    for (size_t i = begin; i < end; ++i) {
+        out[i] = relateOne(q, static_cast<T const &>(*targets[i]));
+    }
+}
+
+// `relateBlock` relates q to each run of consecutive targets with the same
+// concrete type in turn. Grouping runs rather than sorting targets by type
+// keeps the outputs in order, and touches each target once.
+template <typename Q>
+void relateBlock(Q const & q,
+                 Region const * const * targets,
+                 size_t n,
+                 Relationship * out)
+{
+    for (size_t i = 0; i < n;) {
+        RegionKind const k = getKind(*targets[i]);
+        size_t j = i + 1;
+        while (j < n && getKind(*targets[j]) == k) {
+            ++j;
+        }
+        switch (k) {
+            case BOX:
+                relateGroup<Q, Box>(q, targets, i, j, out);
+                break;
+            case CIRCLE:
+                relateGroup<Q, Circle>(q, targets, i, j, out);
+                break;
+            case POLYGON:
+                relateGroup<Q, ConvexPolygon>(q, targets, i, j, out);
+                break;
+            case ELLIPSE:
+                relateGroup<Q, Ellipse>(q, targets, i, j, out);
+                break;
+            default:
+                relateGroup<Q, Region>(q, targets, i, j, out);
+                break;
+        }
+        i = j;
+    }
+}
+
+template <typename Q>
+void relateBlocks(Q const & q,
+                  Region const * const * targets,
+                  size_t n,
+                  Relationship * out,
+                  unsigned numThreads)
+{
+    detail::forEachBlock(n, RELATE_BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        relateBlock(q, targets + begin, end - begin, out + begin);
+    });
+}
+
+} // unnamed namespace
+
 bool Region::contains(double x, double y, double z) const {
     return contains(UnitVector3d(x, y, z));
 }
@@ -45,25 +167,133 @@ bool Region::contains(double lon, double lat) const {
     return contains(UnitVector3d(LonLat::fromRadians(lon, lat)));
 }
 
+void Region::contains(double const * x,
+                      double const * y,
+                      double const * z,
+                      bool * out,
+                      size_t n) const
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = contains(UnitVector3d(x[i], y[i], z[i]));
+    }
+}
+
+void Region::contains(double const * x,
+                      double const * y,
+                      double const * z,
+                      bool * out,
+                      size_t n,
+                      unsigned numThreads) const
+{
+    detail::forEachBlock(n, CONTAINS_BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        contains(x + begin, y + begin, z + begin, out + begin, end - begin);
+    });
+}
+
+void Region::contains(UnitVector3dArray const & points, bool * out) const {
+    contains(points.x(), points.y(), points.z(), out, points.size());
+}
+
+void Region::sample(size_t n, std::mt19937_64 & rng,
+                    double * x, double * y, double * z) const
+{
+    static constexpr size_t BLOCK_SIZE = 256;
+    // Sampling gives up after this many consecutive rejections.
+    static constexpr size_t MAX_REJECTIONS = static_cast<size_t>(1) << 24;
+    if (n == 0) {
+        return;
+    }
+    Circle bound = getBoundingCircle();
+    if (bound.isEmpty()) {
+        throw std::invalid_argument("Cannot sample an empty region");
+    }
+    double u[3][BLOCK_SIZE];
+    bool inside[BLOCK_SIZE];
+    size_t i = 0;
+    size_t rejected = 0;
+    while (i < n) {
+        bound.sample(BLOCK_SIZE, rng, u[0], u[1], u[2]);
+        contains(u[0], u[1], u[2], inside, BLOCK_SIZE);
+        for (size_t j = 0; j < BLOCK_SIZE && i < n; ++j) {
+            if (inside[j]) {
+                x[i] = u[0][j];
+                y[i] = u[1][j];
+                z[i] = u[2][j];
+                ++i;
+                rejected = 0;
+            } else if (++rejected == MAX_REJECTIONS) {
+                throw std::runtime_error(
+                    "Region is too small relative to its bounding circle "
+                    "to be sampled");
+            }
+        }
+    }
+}
+
 std::unique_ptr<Region> Region::decode(uint8_t const * buffer, size_t n) {
     if (buffer == nullptr || n == 0) {
         throw std::runtime_error("Byte-string is not an encoded Region");
     }
+    detail::count(PerformanceCounter::REGION_DECODE_CALLS);
+    detail::count(PerformanceCounter::REGION_DECODE_BYTES, n);
     uint8_t type = *buffer;
     if (type == Box::TYPE_CODE) {
         return Box::decode(buffer, n);
-    } else if (type == Circle::TYPE_CODE) {
+    } else if (type == Circle::TYPE_CODE ||
+               type == Circle::COMPACT_TYPE_CODE) {
         return Circle::decode(buffer, n);
-    } else if (type == ConvexPolygon::TYPE_CODE) {
+    } else if (type == ConvexPolygon::TYPE_CODE ||
+               type == ConvexPolygon::COMPACT_TYPE_CODE) {
         return ConvexPolygon::decode(buffer, n);
     } else if (type == Ellipse::TYPE_CODE) {
         return Ellipse::decode(buffer, n);
-    } else if (type == UnionRegion::TYPE_CODE) {
+    } else if (type == UnionRegion::TYPE_CODE ||
+               type == UnionRegion::LEGACY_TYPE_CODE) {
         return UnionRegion::decode(buffer, n);
-    } else if (type == IntersectionRegion::TYPE_CODE) {
+    } else if (type == IntersectionRegion::TYPE_CODE ||
+               type == IntersectionRegion::LEGACY_TYPE_CODE) {
         return IntersectionRegion::decode(buffer, n);
+    } else if (type == PixelRegion::TYPE_CODE) {
+        return PixelRegion::decode(buffer, n);
     }
     throw std::runtime_error("Byte-string is not an encoded Region");
 }
 
+void relateMany(Region const & query,
+                Region const * const * targets,
+                size_t n,
+                Relationship * out,
+                unsigned numThreads)
+{
+    if (n == 0) {
+        return;
+    }
+    if (targets == nullptr || out == nullptr) {
+        throw std::invalid_argument("relateMany targets and output must not be null");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (targets[i] == nullptr) {
+            throw std::invalid_argument("relateMany targets must not be null");
+        }
+    }
+    switch (getKind(query)) {
+        case BOX:
+            relateBlocks(static_cast<Box const &>(query), targets, n, out, numThreads);
+            break;
+        case CIRCLE:
+            relateBlocks(static_cast<Circle const &>(query), targets, n, out, numThreads);
+            break;
+        case POLYGON:
+            relateBlocks(static_cast<ConvexPolygon const &>(query), targets, n, out, numThreads);
+            break;
+        case ELLIPSE:
+            relateBlocks(static_cast<Ellipse const &>(query), targets, n, out, numThreads);
+            break;
+        default:
+            relateBlocks(query, targets, n, out, numThreads);
+            break;
+    }
+}
+
 }} // namespace lsst:sphgeom
@@ -0,0 +1,145 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RegionBatchEncoder and RegionBatchDecoder
+///        class implementations.
+
+#include "lsst/sphgeom/RegionBatch.h"
+
+#include <stdexcept>
+
+#include "lsst/sphgeom/codec.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+char const NOT_A_REGION_BATCH[] = "Byte-string is not an encoded region batch";
+
+void storeU64(std::uint64_t item, uint8_t * buffer) {
+    for (int b = 0; b < 8; ++b) {
+        buffer[b] = static_cast<uint8_t>(item >> (8 * b));
+    }
+}
+
+} // unnamed namespace
+
+RegionBatchEncoder::RegionBatchEncoder(std::vector<uint8_t> & buffer) :
+    _buffer(buffer),
+    _begin(buffer.size())
+{
+    _buffer.push_back(TYPE_CODE);
+}
+
+void RegionBatchEncoder::append(Region const & region) {
+    if (_finished) {
+        throw std::runtime_error("Cannot add regions to a finished batch");
+    }
+    size_t const offset = _buffer.size();
+    _offsets.push_back(offset - _begin);
+    // Encode the region in place after a placeholder for its size, and
+    // then fill in the size. Leave the buffer unchanged on failure.
+    try {
+        encodeU64(0, _buffer);
+        region.encodeTo(_buffer);
+    } catch (...) {
+        _buffer.resize(offset);
+        _offsets.pop_back();
+        throw;
+    }
+    storeU64(_buffer.size() - offset - 8, _buffer.data() + offset);
+}
+
+void RegionBatchEncoder::finish() {
+    if (_finished) {
+        return;
+    }
+    _buffer.reserve(_buffer.size() + 8 * (_offsets.size() + 1));
+    for (uint64_t offset: _offsets) {
+        encodeU64(offset, _buffer);
+    }
+    encodeU64(_offsets.size(), _buffer);
+    _finished = true;
+}
+
+RegionBatchDecoder::RegionBatchDecoder(uint8_t const * buffer, size_t n) :
+    _begin(buffer)
+{
+    if (buffer == nullptr || n < 9 || buffer[0] != RegionBatchEncoder::TYPE_CODE) {
+        throw std::runtime_error(NOT_A_REGION_BATCH);
+    }
+    uint64_t size = decodeU64(buffer + n - 8);
+    // Each region occupies at least 8 + 1 bytes, and 8 in the index.
+    if (size > (n - 9) / 17) {
+        throw std::runtime_error(NOT_A_REGION_BATCH);
+    }
+    _size = static_cast<size_t>(size);
+    _index = buffer + n - 8 * (_size + 1);
+}
+
+std::pair<uint8_t const *, size_t> RegionBatchDecoder::getEncoded(size_t i) const {
+    if (i >= _size) {
+        throw std::out_of_range("Region batch index out of range");
+    }
+    // Record i runs from its offset to the next offset, or the index.
+    uint64_t const end = static_cast<uint64_t>(_index - _begin);
+    uint64_t const offset = decodeU64(_index + 8 * i);
+    if (offset < 1 || offset > end || end - offset < 8) {
+        throw std::runtime_error(NOT_A_REGION_BATCH);
+    }
+    uint64_t const n = decodeU64(_begin + offset);
+    if (n > end - offset - 8) {
+        throw std::runtime_error(NOT_A_REGION_BATCH);
+    }
+    return std::make_pair(_begin + offset + 8, static_cast<size_t>(n));
+}
+
+Relationship RegionBatchDecoder::relate(size_t i, Region const & r,
+                                        RelateCache & cache) const {
+    std::pair<uint8_t const *, size_t> s = getEncoded(i);
+    return cache.relate(s.first, s.second, r, r.encode());
+}
+
+std::vector<Relationship> RegionBatchDecoder::relateAll(
+    Region const & r, RelateCache * cache) const
+{
+    std::vector<Relationship> results;
+    results.reserve(_size);
+    std::vector<uint8_t> encoded;
+    if (cache != nullptr) {
+        encoded = r.encode();
+    }
+    for (size_t i = 0; i < _size; ++i) {
+        std::pair<uint8_t const *, size_t> s = getEncoded(i);
+        if (cache != nullptr) {
+            results.push_back(cache->relate(s.first, s.second, r, encoded));
+        } else {
+            results.push_back(DecodedRegion::relate(s.first, s.second, r));
+        }
+    }
+    return results;
+}
+
+}} // namespace lsst::sphgeom
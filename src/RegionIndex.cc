@@ -0,0 +1,146 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RegionIndex class implementation.
+
+#include "lsst/sphgeom/RegionIndex.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/codec.h"
+
+#include "BoxTree.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+char const * const TRUNCATED = "Encoded RegionIndex is truncated.";
+
+// A version of decodeU64 from codec.h that checks for buffer overruns and
+// increments the buffer pointer it is given.
+uint64_t consumeDecodeU64(uint8_t const *& buffer, uint8_t const * end) {
+    if (end - buffer < 8) {
+        throw std::runtime_error(TRUNCATED);
+    }
+    uint64_t result = decodeU64(buffer);
+    buffer += 8;
+    return result;
+}
+
+} // unnamed namespace
+
+RegionIndex::RegionIndex(std::vector<std::unique_ptr<Region>> regions) :
+    _regions(std::move(regions))
+{
+    std::vector<Box3d> boxes;
+    boxes.reserve(_regions.size());
+    for (auto const & r : _regions) {
+        if (!r) {
+            throw std::invalid_argument("RegionIndex regions must not be null");
+        }
+        boxes.push_back(r->getBoundingBox3d());
+    }
+    _tree = std::make_shared<detail::BoxTree>(boxes);
+}
+
+std::vector<size_t> RegionIndex::overlapping(Region const & r) const {
+    std::vector<size_t> indexes;
+    if (!_tree) {
+        return indexes;
+    }
+    _tree->findIntersecting(r.getBoundingBox3d(), [&](uint32_t i) {
+        if ((_regions[i]->relate(r) & DISJOINT) == 0) {
+            indexes.push_back(i);
+        }
+        return false;
+    });
+    std::sort(indexes.begin(), indexes.end());
+    return indexes;
+}
+
+std::vector<size_t> RegionIndex::containing(UnitVector3d const & v) const {
+    std::vector<size_t> indexes;
+    if (!_tree) {
+        return indexes;
+    }
+    _tree->findContaining(v, [&](uint32_t i) {
+        if (_regions[i]->contains(v)) {
+            indexes.push_back(i);
+        }
+        return false;
+    });
+    std::sort(indexes.begin(), indexes.end());
+    return indexes;
+}
+
+std::vector<uint8_t> RegionIndex::encode() const {
+    std::vector<uint8_t> buffer;
+    buffer.push_back(TYPE_CODE);
+    encodeU64(_regions.size(), buffer);
+    for (auto const & r : _regions) {
+        std::vector<uint8_t> b = r->encode();
+        encodeU64(b.size(), buffer);
+        buffer.insert(buffer.end(), b.begin(), b.end());
+    }
+    return buffer;
+}
+
+std::unique_ptr<RegionIndex> RegionIndex::decode(uint8_t const * buffer,
+                                                 size_t n) {
+    uint8_t const * end = buffer + n;
+    if (n == 0) {
+        throw std::runtime_error(TRUNCATED);
+    }
+    if (buffer[0] != TYPE_CODE) {
+        throw std::runtime_error("Byte string is not an encoded RegionIndex.");
+    }
+    ++buffer;
+    uint64_t count = consumeDecodeU64(buffer, end);
+    std::vector<std::unique_ptr<Region>> regions;
+    // Every encoded region occupies at least 9 bytes, which bounds the
+    // number of regions a valid buffer can hold.
+    if (count > static_cast<uint64_t>(end - buffer) / 9) {
+        throw std::runtime_error(TRUNCATED);
+    }
+    regions.reserve(count);
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t nBytes = consumeDecodeU64(buffer, end);
+        if (nBytes > static_cast<uint64_t>(end - buffer)) {
+            throw std::runtime_error(TRUNCATED);
+        }
+        regions.push_back(Region::decode(buffer, nBytes));
+        buffer += nBytes;
+    }
+    if (buffer != end) {
+        throw std::runtime_error(
+            "Encoded RegionIndex has unexpected additional bytes.");
+    }
+    return std::make_unique<RegionIndex>(std::move(regions));
+}
+
+}} // namespace lsst::sphgeom
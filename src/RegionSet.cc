@@ -0,0 +1,101 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RegionSet class implementation.
+
+#include "lsst/sphgeom/RegionSet.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "lsst/sphgeom/LonLat.h"
+
+#include "BoxTree.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+RegionSet::RegionSet(std::vector<std::unique_ptr<Region>> regions) :
+    _regions(std::move(regions))
+{
+    std::vector<Box3d> boxes;
+    boxes.reserve(_regions.size());
+    for (auto const & r : _regions) {
+        if (!r) {
+            throw std::invalid_argument("RegionSet regions must not be null");
+        }
+        // Regions with empty bounds contain no points, and are left
+        // out of the tree.
+        boxes.push_back(r->getBoundingBox3d());
+    }
+    _tree = std::make_shared<detail::BoxTree>(boxes);
+}
+
+template <typename F>
+void RegionSet::_find(UnitVector3d const & v, F f) const {
+    if (!_tree) {
+        return;
+    }
+    _tree->findContaining(v, [this, &v, &f](uint32_t i) {
+        return _regions[i]->contains(v) && f(i);
+    });
+}
+
+bool RegionSet::containsAny(UnitVector3d const & v) const {
+    bool found = false;
+    _find(v, [&found](uint32_t) { found = true; return true; });
+    return found;
+}
+
+bool RegionSet::containsAny(double lon, double lat) const {
+    return containsAny(UnitVector3d(LonLat::fromRadians(lon, lat)));
+}
+
+std::vector<size_t> RegionSet::containsWhich(UnitVector3d const & v) const {
+    std::vector<size_t> indexes;
+    _find(v, [&indexes](uint32_t i) { indexes.push_back(i); return false; });
+    std::sort(indexes.begin(), indexes.end());
+    return indexes;
+}
+
+void RegionSet::containsWhich(UnitVector3d const * points,
+                              size_t n,
+                              std::vector<size_t> & offsets,
+                              std::vector<size_t> & indexes) const {
+    offsets.clear();
+    indexes.clear();
+    offsets.reserve(n + 1);
+    offsets.push_back(0);
+    for (size_t p = 0; p < n; ++p) {
+        size_t first = indexes.size();
+        _find(points[p], [&indexes](uint32_t i) {
+            indexes.push_back(i);
+            return false;
+        });
+        std::sort(indexes.begin() + first, indexes.end());
+        offsets.push_back(indexes.size());
+    }
+}
+
+}} // namespace lsst::sphgeom
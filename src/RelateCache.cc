@@ -0,0 +1,157 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the RelateCache class implementation.
+
+#include "lsst/sphgeom/RelateCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include "lsst/sphgeom/DecodedRegion.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The number of slots is chosen so that the table and keys of this size
+// in every slot fit in the memory budget. Two polygons with 10 vertices
+// each have encodings of about this size.
+constexpr size_t TYPICAL_KEY_BYTES = 512;
+
+constexpr uint64_t MULTIPLIER = UINT64_C(0x9e3779b97f4a7c15);
+
+uint64_t hashBytes(uint8_t const * p, size_t n, uint64_t h) {
+    for (; n >= 8; p += 8, n -= 8) {
+        uint64_t w;
+        std::memcpy(&w, p, 8);
+        h = (h ^ w) * MULTIPLIER;
+        h ^= h >> 29;
+    }
+    for (; n > 0; ++p, --n) {
+        h = (h ^ *p) * MULTIPLIER;
+    }
+    h ^= h >> 32;
+    return h;
+}
+
+} // unnamed namespace
+
+RelateCache::RelateCache(size_t maxBytes) : _maxBytes(maxBytes) {
+    if (maxBytes == 0) {
+        throw std::invalid_argument("RelateCache size must be positive");
+    }
+    size_t const perSlot = sizeof(Slot) + TYPICAL_KEY_BYTES;
+    while ((static_cast<size_t>(2) << _bits) <= maxBytes / perSlot &&
+           _bits < 40) {
+        ++_bits;
+    }
+    _slots.resize(static_cast<size_t>(1) << _bits);
+    _tableBytes = sizeof(RelateCache) + _slots.size() * sizeof(Slot);
+}
+
+template <typename Compute>
+Relationship RelateCache::_relate(uint8_t const * a, size_t na,
+                                  uint8_t const * b, size_t nb,
+                                  Compute compute)
+{
+    uint64_t const h = hashBytes(b, nb, hashBytes(a, na, na));
+    size_t const s = _bits == 0 ? 0 : static_cast<size_t>(
+        (h * MULTIPLIER) >> (64 - _bits));
+    std::mutex & mutex = _locks[s % NUM_LOCKS];
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        Slot const & slot = _slots[s];
+        if (slot.full && slot.hash == h && slot.firstSize == na &&
+            slot.key.size() == na + nb &&
+            std::equal(a, a + na, slot.key.begin()) &&
+            std::equal(b, b + nb, slot.key.begin() + na)) {
+            return slot.relationship;
+        }
+    }
+    Relationship const result = compute();
+    std::vector<uint8_t> key;
+    key.reserve(na + nb);
+    key.insert(key.end(), a, a + na);
+    key.insert(key.end(), b, b + nb);
+    std::lock_guard<std::mutex> lock(mutex);
+    Slot & slot = _slots[s];
+    size_t const oldBytes = slot.key.capacity();
+    size_t const newBytes = key.capacity();
+    if (newBytes > oldBytes) {
+        // Claim the additional memory, or leave the slot alone if that
+        // would exceed the budget.
+        size_t used = _keyBytes.load(std::memory_order_relaxed);
+        do {
+            if (_tableBytes + used + (newBytes - oldBytes) > _maxBytes) {
+                return result;
+            }
+        } while (!_keyBytes.compare_exchange_weak(
+            used, used + (newBytes - oldBytes), std::memory_order_relaxed));
+    } else {
+        _keyBytes.fetch_sub(oldBytes - newBytes, std::memory_order_relaxed);
+    }
+    slot.hash = h;
+    slot.key.swap(key);
+    slot.firstSize = na;
+    slot.relationship = result;
+    slot.full = true;
+    return result;
+}
+
+Relationship RelateCache::relate(Region const & a, Region const & b) {
+    std::vector<uint8_t> ea = a.encode();
+    std::vector<uint8_t> eb = b.encode();
+    return _relate(ea.data(), ea.size(), eb.data(), eb.size(),
+                   [&a, &b]() { return a.relate(b); });
+}
+
+Relationship RelateCache::relate(uint8_t const * buffer, size_t n,
+                                 Region const & b,
+                                 std::vector<uint8_t> const & encodedB)
+{
+    if (buffer == nullptr || n == 0) {
+        throw std::runtime_error("Byte-string is not an encoded Region");
+    }
+    return _relate(buffer, n, encodedB.data(), encodedB.size(),
+                   [buffer, n, &b]() {
+                       return DecodedRegion::relate(buffer, n, b);
+                   });
+}
+
+void RelateCache::clear() {
+    for (size_t i = 0; i < NUM_LOCKS; ++i) {
+        std::lock_guard<std::mutex> lock(_locks[i]);
+        for (size_t s = i; s < _slots.size(); s += NUM_LOCKS) {
+            Slot & slot = _slots[s];
+            _keyBytes.fetch_sub(slot.key.capacity(), std::memory_order_relaxed);
+            std::vector<uint8_t>().swap(slot.key);
+            slot.full = false;
+        }
+    }
+}
+
+}} // namespace lsst::sphgeom
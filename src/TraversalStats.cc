@@ -0,0 +1,82 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the TraversalStats implementation.
+
+#include "lsst/sphgeom/TraversalStats.h"
+
+#include <algorithm>
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+thread_local TraversalStats * sink = nullptr;
+
+} // unnamed namespace
+
+#ifdef LSST_SPHGEOM_NO_TRAVERSAL_STATS
+bool const TraversalStats::ENABLED = false;
+#else
+bool const TraversalStats::ENABLED = true;
+#endif
+
+TraversalStats & TraversalStats::merge(TraversalStats const & s) {
+    if (nodesVisited.size() < s.nodesVisited.size()) {
+        nodesVisited.resize(s.nodesVisited.size(), 0);
+    }
+    for (size_t l = 0; l < s.nodesVisited.size(); ++l) {
+        nodesVisited[l] += s.nodesVisited[l];
+    }
+    disjoint += s.disjoint;
+    within += s.within;
+    intersects += s.intersects;
+    inserts += s.inserts;
+    simplifications += s.simplifications;
+    if (s.finalLevel >= 0) {
+        finalLevel = s.finalLevel;
+    }
+    return *this;
+}
+
+TraversalStatsScope::TraversalStatsScope(TraversalStats & stats) :
+    _previous{sink}
+{
+    sink = &stats;
+}
+
+TraversalStatsScope::~TraversalStatsScope() { sink = _previous; }
+
+TraversalStats * TraversalStatsScope::current() { return sink; }
+
+TraversalStats * TraversalStatsScope::release() {
+    TraversalStats * s = sink;
+    sink = nullptr;
+    return s;
+}
+
+void TraversalStatsScope::restore(TraversalStats * stats) { sink = stats; }
+
+}} // namespace lsst::sphgeom
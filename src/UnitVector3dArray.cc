@@ -0,0 +1,365 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the UnitVector3dArray class implementation.
+
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "lsst/sphgeom/Angle.h"
+#include "lsst/sphgeom/LonLat.h"
+
+#include "CpuDispatch.h"
+
+// AVX2 kernels are compiled with function level target attributes and
+// selected at run time, so that a baseline x86-64 build still runs on CPUs
+// without AVX2. They do not use FMA, so that every floating point
+// operation mirrors the corresponding scalar code, and results do not
+// depend on the CPU executing them.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #include <x86intrin.h>
+    #define LSST_SPHGEOM_UNITVECTOR3DARRAY_AVX2 1
+#endif
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Arguments are reduced modulo π/2 with a 3 part Cody-Waite scheme, using
+// the 33 bit leading parts of π/2 from fdlibm. Products of these with
+// integers below 2^20 are exact, so the reduction is accurate for
+// |x| ≤ MAX_REDUCIBLE; std::sin and std::cos are used for larger (and
+// non-finite) arguments.
+constexpr double TWO_OVER_PI = 6.36619772367581382433e-01;
+constexpr double PIO2_1 = 1.57079632673412561417e+00;
+constexpr double PIO2_2 = 6.07710050630396597660e-11;
+constexpr double PIO2_3 = 2.02226624879595063154e-21;
+constexpr double MAX_REDUCIBLE = 524288.0;
+
+// Adding and then subtracting ROUND = 1.5 * 2^52 rounds a double with
+// magnitude below 2^51 to the nearest integer. The sum holds the integer
+// (modulo 2^51) in its low order mantissa bits.
+constexpr double ROUND = 6755399441055744.0;
+
+// Minimax polynomial coefficients for sin and cos on [-π/4, π/4], as in
+// the Cephes math library.
+constexpr double S0 =  1.58962301576546568060e-10;
+constexpr double S1 = -2.50507477628578072866e-8;
+constexpr double S2 =  2.75573136213857245213e-6;
+constexpr double S3 = -1.98412698295895385996e-4;
+constexpr double S4 =  8.33333333332211858878e-3;
+constexpr double S5 = -1.66666666666666307295e-1;
+constexpr double C0 = -1.13585365213876817300e-11;
+constexpr double C1 =  2.08757008419747316778e-9;
+constexpr double C2 = -2.75573141792967388112e-7;
+constexpr double C3 =  2.48015872888517045348e-5;
+constexpr double C4 = -1.38888888888730564116e-3;
+constexpr double C5 =  4.16666666666665929218e-2;
+
+// `sinCos` computes the sine and cosine of x.
+void sinCos(double x, double & sinx, double & cosx) {
+    if (!(std::fabs(x) <= MAX_REDUCIBLE)) {
+        sinx = std::sin(x);
+        cosx = std::cos(x);
+        return;
+    }
+    double t = x * TWO_OVER_PI + ROUND;
+    double q = t - ROUND;
+    double r = ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+    double z = r * r;
+    double s = r + r * z *
+        (((((S0 * z + S1) * z + S2) * z + S3) * z + S4) * z + S5);
+    double c = (1.0 - 0.5 * z) + z * z *
+        (((((C0 * z + C1) * z + C2) * z + C3) * z + C4) * z + C5);
+    // Map the result for r to the quadrant of x.
+    uint64_t quadrant;
+    std::memcpy(&quadrant, &t, sizeof(t));
+    sinx = (quadrant & 1) ? c : s;
+    cosx = (quadrant & 1) ? s : c;
+    if (quadrant & 2) {
+        sinx = -sinx;
+    }
+    if ((quadrant + 1) & 2) {
+        cosx = -cosx;
+    }
+}
+
+void fromLonLatScalar(double const * lon,
+                      double const * lat,
+                      double * x,
+                      double * y,
+                      double * z,
+                      size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        double sinLon, cosLon, sinLat, cosLat;
+        sinCos(lon[i], sinLon, cosLon);
+        sinCos(lat[i], sinLat, cosLat);
+        x[i] = cosLon * cosLat;
+        y[i] = sinLon * cosLat;
+        z[i] = sinLat;
+    }
+}
+
+void normalizeScalar(double const * x,
+                     double const * y,
+                     double const * z,
+                     double * ox,
+                     double * oy,
+                     double * oz,
+                     size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d v(x[i], y[i], z[i]);
+        ox[i] = v.x();
+        oy[i] = v.y();
+        oz[i] = v.z();
+    }
+}
+
+#if defined(LSST_SPHGEOM_UNITVECTOR3DARRAY_AVX2)
+
+    // `sinCosAvx2` mirrors sinCos for 4 arguments, and returns false if
+    // any of them is too large (or not finite) to be reduced.
+    __attribute__((target("avx2")))
+    inline bool sinCosAvx2(__m256d x, __m256d & sinx, __m256d & cosx) {
+        __m256d const m0 = _mm256_set1_pd(-0.0);
+        __m256d ok = _mm256_cmp_pd(_mm256_andnot_pd(m0, x),
+                                   _mm256_set1_pd(MAX_REDUCIBLE),
+                                   _CMP_LE_OQ);
+        if (_mm256_movemask_pd(ok) != 0xf) {
+            return false;
+        }
+        __m256d const round = _mm256_set1_pd(ROUND);
+        __m256d t = _mm256_add_pd(
+            _mm256_mul_pd(x, _mm256_set1_pd(TWO_OVER_PI)), round);
+        __m256d q = _mm256_sub_pd(t, round);
+        __m256d r = _mm256_sub_pd(
+            _mm256_sub_pd(
+                _mm256_sub_pd(x, _mm256_mul_pd(q, _mm256_set1_pd(PIO2_1))),
+                _mm256_mul_pd(q, _mm256_set1_pd(PIO2_2))),
+            _mm256_mul_pd(q, _mm256_set1_pd(PIO2_3)));
+        __m256d z = _mm256_mul_pd(r, r);
+        __m256d p = _mm256_add_pd(
+            _mm256_mul_pd(_mm256_set1_pd(S0), z), _mm256_set1_pd(S1));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(S2));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(S3));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(S4));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(S5));
+        __m256d s = _mm256_add_pd(r, _mm256_mul_pd(_mm256_mul_pd(r, z), p));
+        p = _mm256_add_pd(
+            _mm256_mul_pd(_mm256_set1_pd(C0), z), _mm256_set1_pd(C1));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(C2));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(C3));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(C4));
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(C5));
+        __m256d c = _mm256_add_pd(
+            _mm256_sub_pd(_mm256_set1_pd(1.0),
+                          _mm256_mul_pd(_mm256_set1_pd(0.5), z)),
+            _mm256_mul_pd(_mm256_mul_pd(z, z), p));
+        __m256i const one = _mm256_set1_epi64x(1);
+        __m256i const two = _mm256_set1_epi64x(2);
+        __m256i quadrant = _mm256_castpd_si256(t);
+        __m256d swap = _mm256_castsi256_pd(
+            _mm256_cmpeq_epi64(_mm256_and_si256(quadrant, one), one));
+        __m256d sinSign = _mm256_castsi256_pd(
+            _mm256_slli_epi64(_mm256_and_si256(quadrant, two), 62));
+        __m256d cosSign = _mm256_castsi256_pd(_mm256_slli_epi64(
+            _mm256_and_si256(_mm256_add_epi64(quadrant, one), two), 62));
+        sinx = _mm256_xor_pd(_mm256_blendv_pd(s, c, swap), sinSign);
+        cosx = _mm256_xor_pd(_mm256_blendv_pd(c, s, swap), cosSign);
+        return true;
+    }
+
+    __attribute__((target("avx2")))
+    void fromLonLatAvx2(double const * lon,
+                        double const * lat,
+                        double * x,
+                        double * y,
+                        double * z,
+                        size_t n)
+    {
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d sinLon, cosLon, sinLat, cosLat;
+            if (!sinCosAvx2(_mm256_loadu_pd(lon + i), sinLon, cosLon) ||
+                !sinCosAvx2(_mm256_loadu_pd(lat + i), sinLat, cosLat)) {
+                fromLonLatScalar(lon + i, lat + i, x + i, y + i, z + i, 4);
+                continue;
+            }
+            _mm256_storeu_pd(x + i, _mm256_mul_pd(cosLon, cosLat));
+            _mm256_storeu_pd(y + i, _mm256_mul_pd(sinLon, cosLat));
+            _mm256_storeu_pd(z + i, sinLat);
+        }
+        fromLonLatScalar(lon + i, lat + i, x + i, y + i, z + i, n - i);
+    }
+
+    // `normalizeAvx2` mirrors Vector3d::normalize for 4 vectors at a time.
+    //
+    // That function divides the components by the largest component
+    // magnitude m, and then divides them all by √(1 + u² + v²), where u and
+    // v are the two smaller scaled components. The largest scaled component
+    // is exactly ±1, so it does not matter which of several tied components
+    // is treated as the largest one. Blocks containing zero or non-finite
+    // vectors are handed to the scalar code, which reports errors.
+    __attribute__((target("avx2")))
+    void normalizeAvx2(double const * x,
+                       double const * y,
+                       double const * z,
+                       double * ox,
+                       double * oy,
+                       double * oz,
+                       size_t n)
+    {
+        __m256d const m0 = _mm256_set1_pd(-0.0);
+        __m256d const inf = _mm256_set1_pd(HUGE_VAL);
+        __m256d const one = _mm256_set1_pd(1.0);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256d vx = _mm256_loadu_pd(x + i);
+            __m256d vy = _mm256_loadu_pd(y + i);
+            __m256d vz = _mm256_loadu_pd(z + i);
+            __m256d ax = _mm256_andnot_pd(m0, vx);
+            __m256d ay = _mm256_andnot_pd(m0, vy);
+            __m256d az = _mm256_andnot_pd(m0, vz);
+            __m256d m = _mm256_max_pd(_mm256_max_pd(ax, ay), az);
+            __m256d ok = _mm256_and_pd(
+                _mm256_and_pd(_mm256_cmp_pd(ax, inf, _CMP_LT_OQ),
+                              _mm256_cmp_pd(ay, inf, _CMP_LT_OQ)),
+                _mm256_and_pd(_mm256_cmp_pd(az, inf, _CMP_LT_OQ),
+                              _mm256_cmp_pd(m, _mm256_setzero_pd(),
+                                            _CMP_GT_OQ)));
+            if (_mm256_movemask_pd(ok) != 0xf) {
+                normalizeScalar(x + i, y + i, z + i,
+                                ox + i, oy + i, oz + i, 4);
+                continue;
+            }
+            __m256d qx = _mm256_div_pd(vx, m);
+            __m256d qy = _mm256_div_pd(vy, m);
+            __m256d qz = _mm256_div_pd(vz, m);
+            __m256d sx = _mm256_mul_pd(qx, qx);
+            __m256d sy = _mm256_mul_pd(qy, qy);
+            __m256d sz = _mm256_mul_pd(qz, qz);
+            __m256d xMax = _mm256_cmp_pd(ax, m, _CMP_EQ_OQ);
+            __m256d yMax = _mm256_cmp_pd(ay, m, _CMP_EQ_OQ);
+            __m256d d = _mm256_blendv_pd(
+                _mm256_blendv_pd(_mm256_add_pd(sx, sy),
+                                 _mm256_add_pd(sx, sz), yMax),
+                _mm256_add_pd(sy, sz), xMax);
+            __m256d norm = _mm256_sqrt_pd(_mm256_add_pd(one, d));
+            _mm256_storeu_pd(ox + i, _mm256_div_pd(qx, norm));
+            _mm256_storeu_pd(oy + i, _mm256_div_pd(qy, norm));
+            _mm256_storeu_pd(oz + i, _mm256_div_pd(qz, norm));
+        }
+        normalizeScalar(x + i, y + i, z + i, ox + i, oy + i, oz + i, n - i);
+    }
+
+#endif
+
+} // unnamed namespace
+
+void UnitVector3dArray::normalize(double const * x,
+                                  double const * y,
+                                  double const * z,
+                                  double * ox,
+                                  double * oy,
+                                  double * oz,
+                                  size_t n)
+{
+#if defined(LSST_SPHGEOM_UNITVECTOR3DARRAY_AVX2)
+    if (detail::hasAvx2()) {
+        normalizeAvx2(x, y, z, ox, oy, oz, n);
+        return;
+    }
+#endif
+    normalizeScalar(x, y, z, ox, oy, oz, n);
+}
+
+
+UnitVector3dArray::UnitVector3dArray(std::vector<UnitVector3d> const & v) {
+    reserve(v.size());
+    for (UnitVector3d const & u: v) {
+        push_back(u);
+    }
+}
+
+UnitVector3dArray UnitVector3dArray::fromComponents(double const * x,
+                                                    double const * y,
+                                                    double const * z,
+                                                    size_t n)
+{
+    UnitVector3dArray a;
+    a._x.resize(n);
+    a._y.resize(n);
+    a._z.resize(n);
+    normalize(x, y, z, a._x.data(), a._y.data(), a._z.data(), n);
+    return a;
+}
+
+UnitVector3dArray UnitVector3dArray::fromLonLat(double const * lon,
+                                                double const * lat,
+                                                size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        if (std::fabs(lat[i]) > 0.5 * PI) {
+            throw std::invalid_argument("invalid latitude angle");
+        }
+    }
+    UnitVector3dArray a;
+    a._x.resize(n);
+    a._y.resize(n);
+    a._z.resize(n);
+#if defined(LSST_SPHGEOM_UNITVECTOR3DARRAY_AVX2)
+    if (detail::hasAvx2()) {
+        fromLonLatAvx2(lon, lat, a._x.data(), a._y.data(), a._z.data(), n);
+        return a;
+    }
+#endif
+    fromLonLatScalar(lon, lat, a._x.data(), a._y.data(), a._z.data(), n);
+    return a;
+}
+
+void UnitVector3dArray::toLonLat(double * lon, double * lat) const {
+    for (size_t i = 0; i < _x.size(); ++i) {
+        Vector3d v(_x[i], _y[i], _z[i]);
+        lon[i] = LonLat::longitudeOf(v).asRadians();
+        lat[i] = LonLat::latitudeOf(v).asRadians();
+    }
+}
+
+UnitVector3dArray & UnitVector3dArray::rotate(Matrix3d const & m) {
+    m.apply(_x.data(), _y.data(), _z.data(),
+            _x.data(), _y.data(), _z.data(), _x.size());
+    normalize(_x.data(), _y.data(), _z.data(),
+              _x.data(), _y.data(), _z.data(), _x.size());
+    return *this;
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,258 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the overlap area implementation.
+
+#include "lsst/sphgeom/area.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+
+#include "ConvexPolygonImpl.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using Vertices = std::vector<UnitVector3d>;
+
+// `clip` returns the vertices of the intersection of the convex polygon with
+// the given vertices and the half-space {v : m · v ≥ 0}, using the
+// Sutherland-Hodgman algorithm. The points where polygon edges cross the
+// plane of m are linear combinations of the edge endpoints with positive
+// weights, so they lie on the edges. Vertices on the plane are kept, but
+// never duplicated.
+Vertices clip(Vertices const & verts, Vector3d const & m) {
+    Vertices out;
+    if (verts.empty()) {
+        return out;
+    }
+    out.reserve(verts.size() + 1);
+    UnitVector3d p = verts.back();
+    double sp = m.dot(p);
+    for (UnitVector3d const & q: verts) {
+        double const sq = m.dot(q);
+        if ((sp < 0.0 && sq > 0.0) || (sp > 0.0 && sq < 0.0)) {
+            out.push_back(UnitVector3d((sq * p - sp * q) / (sq - sp)));
+        }
+        if (sq >= 0.0) {
+            out.push_back(q);
+        }
+        p = q;
+        sp = sq;
+    }
+    return out;
+}
+
+// `Piece` is the part [t0, t1] of a polygon edge inside a circle, where
+// t parametrizes the edge by arc length from its first vertex. `entry` and
+// `exit` are true if the boundary of the circle crosses the edge at t0 and
+// t1 respectively, rather than at a polygon vertex inside the circle.
+struct Piece {
+    UnitVector3d p;
+    UnitVector3d q;
+    bool entry;
+    bool exit;
+};
+
+// `capOverlap` returns the area of the intersection of the convex polygon
+// with the given vertices and the circle c.
+//
+// If c is at most a hemisphere, it is convex and its intersection with an
+// edge is a single (possibly empty) segment. The boundary of the
+// intersection then consists of these segments, plus arcs of the circle
+// boundary that join each exit from the circle to the next entry. Its area
+// is the sum of the signed areas of the triangles joining the center of c
+// to each segment, and of the areas of the circle sectors spanned by each
+// arc. Circles larger than a hemisphere are handled via their complements.
+double capOverlap(Vertices const & verts, Circle const & c) {
+    if (verts.size() < 3 || c.isEmpty()) {
+        return 0.0;
+    }
+    double const polygonArea = detail::area(verts.begin(), verts.end());
+    if (c.isFull()) {
+        return polygonArea;
+    }
+    double const s = c.getSquaredChordLength();
+    if (s > 2.0) {
+        return polygonArea - capOverlap(verts, c.complemented());
+    }
+    UnitVector3d const & center = c.getCenter();
+    size_t const n = verts.size();
+    std::vector<bool> inside(n);
+    size_t numInside = 0;
+    for (size_t i = 0; i < n; ++i) {
+        inside[i] = (verts[i] - center).getSquaredNorm() <= s;
+        numInside += inside[i];
+    }
+    if (numInside == n) {
+        return polygonArea;
+    }
+    double const r = 2.0 * std::asin(0.5 * std::sqrt(s));
+    std::vector<Piece> pieces;
+    pieces.reserve(n);
+    for (size_t i = n - 1, j = 0; j < n; i = j, ++j) {
+        UnitVector3d const & a = verts[i];
+        UnitVector3d const & b = verts[j];
+        if (a == b) {
+            continue;
+        }
+        if (inside[i] && inside[j]) {
+            pieces.push_back(Piece{a, b, false, false});
+            continue;
+        }
+        // Parametrize the great circle through a and b as
+        // a cos t + u sin t, with b at t = l ∈ (0, π).
+        UnitVector3d const nrm(a.robustCross(b));
+        UnitVector3d const u = UnitVector3d::fromNormalized(nrm.cross(a));
+        double const l = std::atan2(b.dot(u), b.dot(a));
+        // The closest point to the circle center is at t = tf, at distance d.
+        // The circle boundary crosses the great circle at t = tf ± δ, where
+        // cos r = cos d cos δ.
+        double tf = std::atan2(center.dot(u), center.dot(a));
+        double const d = std::asin(std::min(1.0, std::fabs(center.dot(nrm))));
+        double delta = 0.0;
+        if (d < r) {
+            double const h = std::sin(0.5 * (r + d)) *
+                             std::sin(0.5 * (r - d)) / std::cos(d);
+            delta = 2.0 * std::asin(std::min(1.0, std::sqrt(h)));
+        }
+        if (tf + delta < 0.0) {
+            tf += 2.0 * PI;
+        }
+        auto point = [&](double t) {
+            t = std::min(l, std::max(0.0, t));
+            return UnitVector3d(a * std::cos(t) + u * std::sin(t));
+        };
+        if (inside[i]) {
+            pieces.push_back(Piece{a, point(tf + delta), false, true});
+        } else if (inside[j]) {
+            pieces.push_back(Piece{point(tf - delta), b, true, false});
+        } else if (tf - delta > 0.0 && tf + delta < l && delta >= 1.0e-9 * r) {
+            // Both endpoints are outside the circle, but the edge cuts
+            // through it. Tangencies are ignored.
+            pieces.push_back(
+                Piece{point(tf - delta), point(tf + delta), true, true});
+        }
+    }
+    if (pieces.empty()) {
+        // The circle boundary does not cross the polygon boundary.
+        return detail::contains(verts.begin(), verts.end(), center) ?
+               c.getArea() : 0.0;
+    }
+    double result = 0.0;
+    for (size_t k = 0; k < pieces.size(); ++k) {
+        Piece const & piece = pieces[k];
+        result += detail::triangleArea(center, piece.p, piece.q);
+        if (!piece.exit) {
+            continue;
+        }
+        // Add the sector spanned by the circle boundary arc from this exit
+        // counter-clockwise to the next entry.
+        UnitVector3d const & p = piece.q;
+        UnitVector3d const & q = pieces[(k + 1) % pieces.size()].p;
+        double phi = std::atan2(center.dot(p.cross(q)),
+                                p.dot(q) - p.dot(center) * q.dot(center));
+        if (phi < 0.0) {
+            phi = (phi > -1.0e-9) ? 0.0 : phi + 2.0 * PI;
+        }
+        result += 0.5 * s * phi;
+    }
+    return result;
+}
+
+// `lonOverlap` returns the area of the intersection of the convex polygon
+// with the given vertices and the box b, which must not be empty or wider
+// than π in longitude. The longitude bounds of b are hemispheres bounded by
+// meridian planes, so they can be clipped away; the latitude band that
+// remains is the difference of two circles centered on the north pole.
+double lonOverlap(Vertices verts, Box const & b) {
+    NormalizedAngleInterval const & lon = b.getLon();
+    if (!lon.isFull()) {
+        verts = clip(verts, UnitVector3d::orthogonalTo(lon.getA()));
+        verts = clip(verts, -UnitVector3d::orthogonalTo(lon.getB()));
+    }
+    if (verts.size() < 3) {
+        return 0.0;
+    }
+    Angle const latA = b.getLat().getA();
+    Angle const latB = b.getLat().getB();
+    double const south = (latA.asRadians() <= -0.5 * PI) ?
+        detail::area(verts.begin(), verts.end()) :
+        capOverlap(verts, Circle(UnitVector3d::Z(), Angle(0.5 * PI) - latA));
+    double const north = (latB.asRadians() >= 0.5 * PI) ? 0.0 :
+        capOverlap(verts, Circle(UnitVector3d::Z(), Angle(0.5 * PI) - latB));
+    return south - north;
+}
+
+double boxOverlap(Vertices const & verts, Box const & b) {
+    if (b.isEmpty()) {
+        return 0.0;
+    }
+    NormalizedAngleInterval const & lon = b.getLon();
+    if (lon.isFull() || lon.getSize().asRadians() <= PI) {
+        return lonOverlap(verts, b);
+    }
+    NormalizedAngle const mid = lon.getCenter();
+    return lonOverlap(verts, Box(NormalizedAngleInterval(lon.getA(), mid),
+                                 b.getLat())) +
+           lonOverlap(verts, Box(NormalizedAngleInterval(mid, lon.getB()),
+                                 b.getLat()));
+}
+
+double polygonOverlap(Vertices verts, ConvexPolygon const & q) {
+    ConvexPolygon::VertexVector const & w = q.getVertices();
+    for (size_t i = w.size() - 1, j = 0; j < w.size(); i = j, ++j) {
+        verts = clip(verts, w[i].robustCross(w[j]));
+        if (verts.size() < 3) {
+            return 0.0;
+        }
+    }
+    return detail::area(verts.begin(), verts.end());
+}
+
+} // unnamed namespace
+
+double overlapArea(ConvexPolygon const & p, Region const & r) {
+    Vertices const verts(p.getVertices().begin(), p.getVertices().end());
+    if (auto q = dynamic_cast<ConvexPolygon const *>(&r)) {
+        return polygonOverlap(verts, *q);
+    }
+    if (auto c = dynamic_cast<Circle const *>(&r)) {
+        return capOverlap(verts, *c);
+    }
+    if (auto b = dynamic_cast<Box const *>(&r)) {
+        return boxOverlap(verts, *b);
+    }
+    throw std::invalid_argument(
+        "overlapArea only supports ConvexPolygon, Circle and Box regions");
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,402 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the implementations of the Arrow region
+///        column functions.
+
+#include "lsst/sphgeom/arrow.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/RangeSet.h"
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Rows are handed out to threads in blocks of this size, which is a
+// multiple of 64 so that threads never write to the same bitmap word.
+constexpr size_t BLOCK_SIZE = 1024;
+
+// Buffers are stored as vectors of 64 bit words, which gives them the
+// 8 byte alignment recommended by the Arrow specification.
+using Buffer = std::vector<uint64_t>;
+
+size_t bitmapWords(size_t n) { return (n + 63) / 64; }
+
+// `ArrayData` owns the buffers and children of an exported array.
+struct ArrayData {
+    std::vector<Buffer> buffers;
+    std::vector<void const *> pointers;
+    std::vector<ArrowArray> children;
+    std::vector<ArrowArray *> childPointers;
+};
+
+void releaseArray(ArrowArray * array) {
+    ArrayData * data = static_cast<ArrayData *>(array->private_data);
+    for (ArrowArray & child: data->children) {
+        if (child.release != nullptr) {
+            child.release(&child);
+        }
+    }
+    delete data;
+    array->release = nullptr;
+}
+
+// `makeArray` exports an array with the given buffers, of which empty ones
+// are exported as null pointers, and children.
+ArrowArray makeArray(size_t length,
+                     size_t nullCount,
+                     std::vector<Buffer> buffers,
+                     ArrowArray * child = nullptr)
+{
+    std::unique_ptr<ArrayData> data(new ArrayData);
+    data->buffers = std::move(buffers);
+    for (Buffer const & b: data->buffers) {
+        data->pointers.push_back(b.empty() ? nullptr : b.data());
+    }
+    if (child != nullptr) {
+        data->children.push_back(*child);
+        child->release = nullptr;
+        data->childPointers.push_back(&data->children[0]);
+    }
+    ArrowArray array;
+    array.length = static_cast<int64_t>(length);
+    array.null_count = static_cast<int64_t>(nullCount);
+    array.offset = 0;
+    array.n_buffers = static_cast<int64_t>(data->pointers.size());
+    array.n_children = static_cast<int64_t>(data->children.size());
+    array.buffers = data->pointers.data();
+    array.children = data->childPointers.empty() ? nullptr : data->childPointers.data();
+    array.dictionary = nullptr;
+    array.release = &releaseArray;
+    array.private_data = data.release();
+    return array;
+}
+
+// `SchemaData` owns the strings and children of an exported schema.
+struct SchemaData {
+    std::string format;
+    std::string name;
+    std::vector<ArrowSchema> children;
+    std::vector<ArrowSchema *> childPointers;
+};
+
+void releaseSchema(ArrowSchema * schema) {
+    SchemaData * data = static_cast<SchemaData *>(schema->private_data);
+    for (ArrowSchema & child: data->children) {
+        if (child.release != nullptr) {
+            child.release(&child);
+        }
+    }
+    delete data;
+    schema->release = nullptr;
+}
+
+ArrowSchema makeSchema(char const * format,
+                       char const * name,
+                       ArrowSchema * child = nullptr)
+{
+    std::unique_ptr<SchemaData> data(new SchemaData);
+    data->format = format;
+    data->name = name;
+    if (child != nullptr) {
+        data->children.push_back(*child);
+        child->release = nullptr;
+        data->childPointers.push_back(&data->children[0]);
+    }
+    ArrowSchema schema;
+    schema.format = data->format.c_str();
+    schema.name = data->name.c_str();
+    schema.metadata = nullptr;
+    schema.flags = ARROW_FLAG_NULLABLE;
+    schema.n_children = static_cast<int64_t>(data->children.size());
+    schema.children = data->childPointers.empty() ? nullptr : data->childPointers.data();
+    schema.dictionary = nullptr;
+    schema.release = &releaseSchema;
+    schema.private_data = data.release();
+    return schema;
+}
+
+// `validityBuffer` returns the validity bitmap of a result with the same
+// null rows as `column`, which is empty if there are none.
+Buffer validityBuffer(RegionColumn const & column) {
+    Buffer validity;
+    if (column.getNullCount() != 0) {
+        validity.resize(bitmapWords(column.size()));
+        column.copyValidity(reinterpret_cast<uint8_t *>(validity.data()));
+    }
+    return validity;
+}
+
+char const MALFORMED_ARRAY[] = "Malformed Arrow binary array";
+
+} // unnamed namespace
+
+RegionColumn::RegionColumn(ArrowSchema const & schema, ArrowArray const & array) {
+    if (schema.release == nullptr || array.release == nullptr) {
+        throw std::invalid_argument("Arrow array has been released");
+    }
+    if (schema.format != nullptr && std::strcmp(schema.format, "z") == 0) {
+        _large = false;
+    } else if (schema.format != nullptr && std::strcmp(schema.format, "Z") == 0) {
+        _large = true;
+    } else {
+        throw std::invalid_argument(
+            "Region columns must be Arrow binary or large binary arrays");
+    }
+    if (array.length < 0 || array.offset < 0 || array.n_buffers != 3 ||
+        array.buffers == nullptr) {
+        throw std::invalid_argument(MALFORMED_ARRAY);
+    }
+    _validity = static_cast<uint8_t const *>(array.buffers[0]);
+    _offsets = array.buffers[1];
+    _data = static_cast<uint8_t const *>(array.buffers[2]);
+    _offset = static_cast<size_t>(array.offset);
+    _size = static_cast<size_t>(array.length);
+    if (_size != 0 && _offsets == nullptr) {
+        throw std::invalid_argument(MALFORMED_ARRAY);
+    }
+    _nullCount = 0;
+    if (_validity == nullptr) {
+        return;
+    }
+    if (array.null_count >= 0) {
+        _nullCount = static_cast<size_t>(array.null_count);
+    } else {
+        for (size_t i = 0; i < _size; ++i) {
+            _nullCount += isNull(i);
+        }
+    }
+    if (_nullCount == 0) {
+        _validity = nullptr;
+    }
+}
+
+std::pair<uint8_t const *, size_t> RegionColumn::getEncoded(size_t i) const {
+    if (i >= _size) {
+        throw std::out_of_range("Region column index out of range");
+    }
+    if (isNull(i)) {
+        return std::make_pair(nullptr, 0);
+    }
+    size_t const j = i + _offset;
+    int64_t begin, end;
+    if (_large) {
+        int64_t const * offsets = static_cast<int64_t const *>(_offsets);
+        begin = offsets[j];
+        end = offsets[j + 1];
+    } else {
+        int32_t const * offsets = static_cast<int32_t const *>(_offsets);
+        begin = offsets[j];
+        end = offsets[j + 1];
+    }
+    if (begin < 0 || end < begin || (_data == nullptr && end != begin)) {
+        throw std::runtime_error(MALFORMED_ARRAY);
+    }
+    return std::make_pair(_data + begin, static_cast<size_t>(end - begin));
+}
+
+std::unique_ptr<Region> RegionColumn::decode(size_t i) const {
+    std::pair<uint8_t const *, size_t> s = getEncoded(i);
+    if (isNull(i)) {
+        return nullptr;
+    }
+    return Region::decode(s.first, s.second);
+}
+
+Region const * RegionColumn::decode(size_t i, DecodedRegion & storage) const {
+    std::pair<uint8_t const *, size_t> s = getEncoded(i);
+    if (isNull(i)) {
+        return nullptr;
+    }
+    return &storage.decode(s.first, s.second);
+}
+
+void RegionColumn::copyValidity(uint8_t * out) const {
+    size_t const n = (_size + 7) / 8;
+    if (_validity == nullptr) {
+        std::memset(out, 0xff, n);
+    } else if ((_offset & 7) == 0) {
+        std::memcpy(out, _validity + (_offset >> 3), n);
+    } else {
+        std::memset(out, 0, n);
+        for (size_t i = 0; i < _size; ++i) {
+            out[i >> 3] |= static_cast<uint8_t>(!isNull(i)) << (i & 7);
+        }
+    }
+}
+
+ArrowColumn::ArrowColumn() {
+    std::memset(&_schema, 0, sizeof(_schema));
+    std::memset(&_array, 0, sizeof(_array));
+}
+
+ArrowColumn::ArrowColumn(ArrowSchema schema, ArrowArray array) :
+    _schema(schema), _array(array)
+{}
+
+ArrowColumn::ArrowColumn(ArrowColumn && other) noexcept :
+    _schema(other._schema), _array(other._array)
+{
+    other._schema.release = nullptr;
+    other._array.release = nullptr;
+}
+
+ArrowColumn & ArrowColumn::operator=(ArrowColumn && other) noexcept {
+    if (this != &other) {
+        _release();
+        _schema = other._schema;
+        _array = other._array;
+        other._schema.release = nullptr;
+        other._array.release = nullptr;
+    }
+    return *this;
+}
+
+ArrowColumn::~ArrowColumn() { _release(); }
+
+void ArrowColumn::_release() {
+    if (_schema.release != nullptr) {
+        _schema.release(&_schema);
+    }
+    if (_array.release != nullptr) {
+        _array.release(&_array);
+    }
+}
+
+void ArrowColumn::exportTo(ArrowSchema * schema, ArrowArray * array) {
+    if (empty()) {
+        throw std::runtime_error("Arrow column has already been exported");
+    }
+    if (schema != nullptr) {
+        *schema = _schema;
+        _schema.release = nullptr;
+    }
+    if (array != nullptr) {
+        *array = _array;
+        _array.release = nullptr;
+    }
+    _release();
+}
+
+ArrowColumn relateColumn(RegionColumn const & column,
+                         Region const & region,
+                         unsigned numThreads)
+{
+    size_t const n = column.size();
+    Buffer values(std::max<size_t>(1, (n + 7) / 8));
+    uint8_t * out = reinterpret_cast<uint8_t *>(values.data());
+    detail::forEachBlock(n, BLOCK_SIZE, numThreads, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::pair<uint8_t const *, size_t> s = column.getEncoded(i);
+            out[i] = column.isNull(i) ? 0 : static_cast<uint8_t>(
+                DecodedRegion::relate(s.first, s.second, region).to_ulong());
+        }
+    });
+    std::vector<Buffer> buffers;
+    buffers.push_back(validityBuffer(column));
+    buffers.push_back(std::move(values));
+    return ArrowColumn(makeSchema("C", ""),
+                       makeArray(n, column.getNullCount(), std::move(buffers)));
+}
+
+ArrowColumn containsColumn(RegionColumn const & column,
+                           UnitVector3d const & v,
+                           unsigned numThreads)
+{
+    size_t const n = column.size();
+    Buffer values(std::max<size_t>(1, bitmapWords(n)));
+    uint8_t * out = reinterpret_cast<uint8_t *>(values.data());
+    detail::forEachBlock(n, BLOCK_SIZE, numThreads, [&](size_t begin, size_t end) {
+        DecodedRegion storage;
+        for (size_t i = begin; i < end; ++i) {
+            Region const * r = column.decode(i, storage);
+            if (r != nullptr && r->contains(v)) {
+                out[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+            }
+        }
+    });
+    std::vector<Buffer> buffers;
+    buffers.push_back(validityBuffer(column));
+    buffers.push_back(std::move(values));
+    return ArrowColumn(makeSchema("b", ""),
+                       makeArray(n, column.getNullCount(), std::move(buffers)));
+}
+
+ArrowColumn envelopeColumn(RegionColumn const & column,
+                           Pixelization const & pixelization,
+                           size_t maxRanges,
+                           unsigned numThreads)
+{
+    size_t const n = column.size();
+    std::vector<RangeSet> envelopes(n);
+    detail::forEachBlock(n, BLOCK_SIZE, numThreads, [&](size_t begin, size_t end) {
+        DecodedRegion storage;
+        for (size_t i = begin; i < end; ++i) {
+            Region const * r = column.decode(i, storage);
+            if (r != nullptr) {
+                envelopes[i] = pixelization.envelope(*r, maxRanges);
+            }
+        }
+    });
+    Buffer offsets(n + 1);
+    int64_t * o = reinterpret_cast<int64_t *>(offsets.data());
+    o[0] = 0;
+    for (size_t i = 0; i < n; ++i) {
+        o[i + 1] = o[i] + static_cast<int64_t>(envelopes[i].size());
+    }
+    size_t const numRanges = static_cast<size_t>(o[n]);
+    Buffer bounds(std::max<size_t>(1, 2 * numRanges));
+    uint64_t * b = bounds.data();
+    for (RangeSet & s: envelopes) {
+        for (auto const & r: s) {
+            *b++ = std::get<0>(r);
+            *b++ = std::get<1>(r);
+        }
+        s = RangeSet();
+    }
+    std::vector<Buffer> buffers(2);
+    buffers[1] = std::move(bounds);
+    ArrowArray values = makeArray(2 * numRanges, 0, std::move(buffers));
+    ArrowSchema valuesSchema = makeSchema("L", "item");
+    ArrowArray ranges = makeArray(numRanges, 0, std::vector<Buffer>(1), &values);
+    ArrowSchema rangesSchema = makeSchema("+w:2", "item", &valuesSchema);
+    buffers.clear();
+    buffers.push_back(validityBuffer(column));
+    buffers.push_back(std::move(offsets));
+    return ArrowColumn(
+        makeSchema("+L", "", &rangesSchema),
+        makeArray(n, column.getNullCount(), std::move(buffers), &ranges));
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,244 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the box and region join implementations.
+
+#include "lsst/sphgeom/boxJoin.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/Relationship.h"
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+
+// The sweep is split into blocks of this many boxes, each of which is
+// processed by a single thread.
+constexpr size_t BLOCK_SIZE = 256;
+
+// `SortedBoxes` stores the non-empty boxes of an input in order of
+// increasing x lower bound, as separate arrays of interval bounds.
+// `index[k]` is the position of the k-th sorted box in the input.
+struct SortedBoxes {
+    std::vector<size_t> index;
+    std::vector<double> xmin, xmax, ymin, ymax, zmin, zmax;
+
+    explicit SortedBoxes(std::vector<Box3d> const & boxes) {
+        index.reserve(boxes.size());
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if (!boxes[i].isEmpty()) {
+                index.push_back(i);
+            }
+        }
+        std::stable_sort(index.begin(), index.end(), [&](size_t i, size_t j) {
+            return boxes[i].x().getA() < boxes[j].x().getA();
+        });
+        size_t const n = index.size();
+        for (auto * v: {&xmin, &xmax, &ymin, &ymax, &zmin, &zmax}) {
+            v->resize(n);
+        }
+        for (size_t k = 0; k < n; ++k) {
+            Box3d const & b = boxes[index[k]];
+            xmin[k] = b.x().getA();
+            xmax[k] = b.x().getB();
+            ymin[k] = b.y().getA();
+            ymax[k] = b.y().getB();
+            zmin[k] = b.z().getA();
+            zmax[k] = b.z().getB();
+        }
+    }
+
+    size_t size() const { return index.size(); }
+
+    // `overlapsYZ` returns true if the y and z intervals of the k-th box
+    // in this set intersect those of the m-th box in `s`. The comparisons
+    // are combined with bitwise operators so that they compile to straight
+    // line code.
+    bool overlapsYZ(size_t k, SortedBoxes const & s, size_t m) const {
+        return (ymin[k] <= s.ymax[m]) & (s.ymin[m] <= ymax[k]) &
+               (zmin[k] <= s.zmax[m]) & (s.zmin[m] <= zmax[k]);
+    }
+};
+
+// `sweep` appends the pairs (index[k], s.index[m]) for which the x lower
+// bound of box m in `s` lies in [xmin[k], xmax[k]] (or in (xmin[k], xmax[k]]
+// if `open` is true), box m starts at or after `first`, and the y and z
+// intervals of the boxes intersect.
+void sweep(SortedBoxes const & r, size_t k, SortedBoxes const & s,
+           size_t first, bool open, bool swap, Pairs & pairs)
+{
+    double const lo = r.xmin[k];
+    double const hi = r.xmax[k];
+    auto begin = s.xmin.begin() + first;
+    size_t m = static_cast<size_t>(
+        (open ? std::upper_bound(begin, s.xmin.end(), lo) :
+                std::lower_bound(begin, s.xmin.end(), lo)) - s.xmin.begin());
+    size_t const n = s.size();
+    for (; m < n && s.xmin[m] <= hi; ++m) {
+        if (r.overlapsYZ(k, s, m)) {
+            if (swap) {
+                pairs.emplace_back(s.index[m], r.index[k]);
+            } else {
+                pairs.emplace_back(r.index[k], s.index[m]);
+            }
+        }
+    }
+}
+
+// `forEachBox` calls f(k, pairs) for every box k of `s`, possibly in
+// parallel, and appends the pairs produced for all boxes to `result`.
+template <typename F>
+void forEachBox(SortedBoxes const & s, unsigned numThreads, Pairs & result,
+                F const & f)
+{
+    size_t const n = s.size();
+    std::vector<Pairs> blocks((n + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    detail::forEachBlock(n, BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        Pairs & pairs = blocks[begin / BLOCK_SIZE];
+        for (size_t k = begin; k < end; ++k) {
+            f(k, pairs);
+        }
+    });
+    size_t total = result.size();
+    for (auto const & b: blocks) {
+        total += b.size();
+    }
+    result.reserve(total);
+    for (auto const & b: blocks) {
+        result.insert(result.end(), b.begin(), b.end());
+    }
+}
+
+std::vector<Box3d> boundingBoxes(
+    std::vector<std::unique_ptr<Region>> const & regions,
+    unsigned numThreads)
+{
+    std::vector<Box3d> boxes(regions.size());
+    detail::forEachBlock(regions.size(), BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            boxes[i] = regions[i]->getBoundingBox3d();
+        }
+    });
+    return boxes;
+}
+
+// `removeDisjoint` removes the candidate pairs of regions that `relate`
+// proves to be disjoint, preserving the order of the remaining pairs.
+template <typename First, typename Second>
+void removeDisjoint(Pairs & pairs, First const & first, Second const & second,
+                    unsigned numThreads)
+{
+    std::vector<char> keep(pairs.size());
+    detail::forEachBlock(pairs.size(), BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        for (size_t p = begin; p < end; ++p) {
+            Region const & r1 = first(pairs[p].first);
+            Region const & r2 = second(pairs[p].second);
+            keep[p] = (r1.relate(r2) & DISJOINT) == 0;
+        }
+    });
+    size_t n = 0;
+    for (size_t p = 0; p < pairs.size(); ++p) {
+        if (keep[p]) {
+            pairs[n++] = pairs[p];
+        }
+    }
+    pairs.resize(n);
+}
+
+} // unnamed namespace
+
+Pairs boxJoin(std::vector<Box3d> const & boxes, unsigned numThreads) {
+    SortedBoxes s(boxes);
+    Pairs pairs;
+    // Every intersecting pair is found exactly once, from the box that
+    // comes first in sweep order.
+    forEachBox(s, numThreads, pairs, [&](size_t k, Pairs & result) {
+        size_t const begin = result.size();
+        sweep(s, k, s, k + 1, false, false, result);
+        for (size_t p = begin; p < result.size(); ++p) {
+            if (result[p].first > result[p].second) {
+                std::swap(result[p].first, result[p].second);
+            }
+        }
+    });
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+Pairs boxJoin(std::vector<Box3d> const & a,
+              std::vector<Box3d> const & b,
+              unsigned numThreads)
+{
+    SortedBoxes sa(a);
+    SortedBoxes sb(b);
+    Pairs pairs;
+    // If the x intervals of two boxes intersect, then the lower bound of
+    // one lies in the x interval of the other. Pairs for which the lower
+    // bound of the box from `b` lies in the x interval of the box from `a`
+    // are found from `a`, and the remaining pairs, for which the lower
+    // bound of the box from `a` is strictly greater, are found from `b`.
+    forEachBox(sa, numThreads, pairs, [&](size_t k, Pairs & result) {
+        sweep(sa, k, sb, 0, false, false, result);
+    });
+    forEachBox(sb, numThreads, pairs, [&](size_t k, Pairs & result) {
+        sweep(sb, k, sa, 0, true, true, result);
+    });
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+Pairs regionJoin(std::vector<std::unique_ptr<Region>> const & regions,
+                 unsigned numThreads)
+{
+    Pairs pairs = boxJoin(boundingBoxes(regions, numThreads), numThreads);
+    auto at = [&](size_t i) -> Region const & { return *regions[i]; };
+    removeDisjoint(pairs, at, at, numThreads);
+    return pairs;
+}
+
+Pairs regionJoin(std::vector<std::unique_ptr<Region>> const & a,
+                 std::vector<std::unique_ptr<Region>> const & b,
+                 unsigned numThreads)
+{
+    Pairs pairs = boxJoin(boundingBoxes(a, numThreads),
+                          boundingBoxes(b, numThreads),
+                          numThreads);
+    auto atA = [&](size_t i) -> Region const & { return *a[i]; };
+    auto atB = [&](size_t i) -> Region const & { return *b[i]; };
+    removeDisjoint(pairs, atA, atB, numThreads);
+    return pairs;
+}
+
+}} // namespace lsst::sphgeom
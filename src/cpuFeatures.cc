@@ -0,0 +1,105 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the run time CPU feature detection.
+
+#include "lsst/sphgeom/cpuFeatures.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "CpuDispatch.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+unsigned detect() {
+    unsigned features = 0;
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        features |= detail::CPU_AVX2;
+    }
+    if (__builtin_cpu_supports("bmi2") && !__builtin_cpu_is("amdfam17h")) {
+        features |= detail::CPU_FAST_BMI2;
+    }
+#elif !defined(NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+    features |= detail::CPU_NEON;
+#endif
+    return features;
+}
+
+unsigned detected() {
+    static unsigned const features = detect();
+    return features;
+}
+
+std::atomic<unsigned> & enabled() {
+    static std::atomic<unsigned> features([]() {
+        char const * env = std::getenv("SPHGEOM_BASELINE_KERNELS");
+        bool baseline = env != nullptr && *env != '\0' &&
+                        std::strcmp(env, "0") != 0;
+        return baseline ? 0u : detected();
+    }());
+    return features;
+}
+
+CpuFeatures toCpuFeatures(unsigned mask) {
+    CpuFeatures f;
+    f.avx2 = (mask & detail::CPU_AVX2) != 0;
+    f.fastBmi2 = (mask & detail::CPU_FAST_BMI2) != 0;
+    f.neon = (mask & detail::CPU_NEON) != 0;
+    return f;
+}
+
+} // unnamed namespace
+
+namespace detail {
+
+unsigned enabledCpuFeatures() {
+    return enabled().load(std::memory_order_relaxed);
+}
+
+} // namespace detail
+
+CpuFeatures detectCpuFeatures() {
+    return toCpuFeatures(detected());
+}
+
+CpuFeatures getCpuFeatures() {
+    return toCpuFeatures(detail::enabledCpuFeatures());
+}
+
+void setCpuFeatures(CpuFeatures const & features) {
+    unsigned mask = (features.avx2 ? detail::CPU_AVX2 : 0u) |
+                    (features.fastBmi2 ? detail::CPU_FAST_BMI2 : 0u) |
+                    (features.neon ? detail::CPU_NEON : 0u);
+    enabled().store(mask & detected(), std::memory_order_relaxed);
+}
+
+}} // namespace lsst::sphgeom
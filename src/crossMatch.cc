@@ -0,0 +1,235 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the cross-match implementation.
+
+#include "lsst/sphgeom/crossMatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <mutex>
+#include <numeric>
+
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+#include "lsst/sphgeom/utils.h"
+
+#include "Parallel.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+
+// Finer pixelizations are only used while there are at least this many
+// input points per pixel, on average; beyond that, the cost of per-pixel
+// bookkeeping exceeds the savings from comparing fewer pairs.
+constexpr double MIN_POINTS_PER_PIXEL = 16.0;
+
+// A `Partition` holds the points of one input in increasing pixel order,
+// so that the points of a pixel can be copied out sequentially. Since the
+// number of pixels is at most a small fraction of the number of points,
+// the points are ordered with a counting sort, which also yields the offset
+// of the first point in each pixel.
+struct Partition {
+    uint64_t base;
+    UnitVector3dArray points;
+    std::vector<size_t> indexes;
+    std::vector<size_t> offsets;
+
+    Partition(Mq3cPixelization const & pixelization,
+              UnitVector3dArray const & input) :
+        base(static_cast<uint64_t>(10) << 2 * pixelization.getLevel())
+    {
+        size_t const n = input.size();
+        std::vector<uint64_t> p(n);
+        pixelization.index(input, p.data());
+        size_t const numPixels =
+            static_cast<size_t>(6) << 2 * pixelization.getLevel();
+        offsets.assign(numPixels + 1, 0);
+        for (uint64_t i: p) {
+            ++offsets[i - base + 1];
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+        indexes.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            indexes[next[p[i] - base]++] = i;
+        }
+        points.reserve(n);
+        for (size_t i: indexes) {
+            points.push_back(input[i]);
+        }
+    }
+
+    // `gather` appends the points in pixel i, and their input indexes,
+    // to `out` and `outIndexes`.
+    void gather(uint64_t i,
+                UnitVector3dArray & out,
+                std::vector<size_t> & outIndexes) const
+    {
+        size_t const end = offsets[i - base + 1];
+        for (size_t j = offsets[i - base]; j < end; ++j) {
+            out.push_back(points[j]);
+            outIndexes.push_back(indexes[j]);
+        }
+    }
+};
+
+// `Matcher` compares the points in one pixel of a with the points in the
+// neighborhood of that pixel in b. Instances reuse their buffers, so each
+// thread should have its own matcher.
+struct Matcher {
+    Partition const & pa;
+    Partition const & pb;
+    Angle radius;
+    UnitVector3dArray blockA;
+    UnitVector3dArray blockB;
+    std::vector<size_t> indexesA;
+    std::vector<size_t> indexesB;
+    Pairs pairs;
+
+    Matcher(Partition const & pa_, Partition const & pb_, Angle radius_) :
+        pa(pa_), pb(pb_), radius(radius_)
+    {}
+
+    void match(uint64_t pixel, Pairs & out) {
+        blockA.clear();
+        blockB.clear();
+        indexesA.clear();
+        indexesB.clear();
+        pa.gather(pixel, blockA, indexesA);
+        for (uint64_t n: Mq3cPixelization::neighborhood(pixel)) {
+            pb.gather(n, blockB, indexesB);
+        }
+        pairs.clear();
+        findPairsWithin(blockA, blockB, radius, pairs);
+        for (auto const & p: pairs) {
+            out.emplace_back(indexesA[p.first], indexesB[p.second]);
+        }
+    }
+};
+
+} // unnamed namespace
+
+
+// The angular distance between the opposite edges of a modified Q3C pixel
+// at level L is at least about 1.06 / 2^L radians (the minimum over all
+// pixels was measured to be 1.0980, 1.0667 and 1.0622 times 2^-L at levels
+// 3, 6 and 8). A point outside of the neighborhood of pixel P is separated
+// from P by at least one such pixel, so comparing the points of P with
+// those of its neighborhood finds all matches when the radius is at most
+// 2^-L; the remaining margin of about 6% absorbs rounding errors in
+// pixel index computations.
+int crossMatchLevel(Angle radius, size_t n) {
+    double r = radius.asRadians();
+    if (!(r <= 1.0)) {
+        return -1;
+    }
+    int level = 0;
+    while (level < Mq3cPixelization::MAX_LEVEL &&
+           std::ldexp(r, level + 1) <= 1.0 &&
+           6.0 * std::ldexp(MIN_POINTS_PER_PIXEL, 2 * (level + 1)) <=
+               static_cast<double>(n)) {
+        ++level;
+    }
+    return level;
+}
+
+Pairs crossMatch(UnitVector3dArray const & a,
+                 UnitVector3dArray const & b,
+                 Angle radius,
+                 unsigned numThreads)
+{
+    Pairs result;
+    if (a.empty() || b.empty() || !(radius.asRadians() >= 0.0)) {
+        return result;
+    }
+    int level = crossMatchLevel(radius, a.size() + b.size());
+    if (level < 0) {
+        findPairsWithin(a, b, radius, result);
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+    Mq3cPixelization pixelization(level);
+    Partition pa(pixelization, a);
+    Partition pb(pixelization, b);
+    std::vector<uint64_t> pixels;
+    for (size_t i = 0; i + 1 < pa.offsets.size(); ++i) {
+        if (pa.offsets[i] != pa.offsets[i + 1]) {
+            pixels.push_back(pa.base + i);
+        }
+    }
+    size_t const numPixels = pixels.size();
+    if (numThreads <= 1 || numPixels <= 1) {
+        Matcher matcher(pa, pb, radius);
+        for (uint64_t p: pixels) {
+            matcher.match(p, result);
+        }
+    } else {
+        // Hand out pixels to threads one at a time, so that the load stays
+        // balanced even when point densities vary a lot.
+        std::vector<Pairs> results(numPixels);
+        std::atomic<size_t> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr error;
+        std::mutex errorMutex;
+        auto work = [&]() {
+            try {
+                Matcher matcher(pa, pb, radius);
+                for (size_t i = next++; i < numPixels && !failed; i = next++) {
+                    matcher.match(pixels[i], results[i]);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+                failed = true;
+            }
+        };
+        numThreads = static_cast<unsigned>(
+            std::min<size_t>(numThreads, numPixels));
+        detail::runInParallel(numThreads, work);
+        if (error) {
+            std::rethrow_exception(error);
+        }
+        size_t n = 0;
+        for (Pairs const & r: results) {
+            n += r.size();
+        }
+        result.reserve(n);
+        for (Pairs const & r: results) {
+            result.insert(result.end(), r.begin(), r.end());
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+}} // namespace lsst::sphgeom
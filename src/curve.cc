@@ -0,0 +1,219 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the batch space filling curve function
+///        implementations.
+
+#include "lsst/sphgeom/curve.h"
+
+#include <algorithm>
+
+#include "CpuDispatch.h"
+
+// BMI2 kernels are compiled with function level target attributes and
+// selected at run time, so that a baseline x86-64 build still runs on CPUs
+// without BMI2.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define LSST_SPHGEOM_CURVE_BMI2 1
+#endif
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The single step Hilbert LUT described in curve.h. It maps (e, d, l),
+// where e and d form the 2 bit curve state and l is a 2 bit Morton digit,
+// to (e, d, w), where w is the corresponding Hilbert digit.
+constexpr uint64_t HILBERT_LUT_1 = UINT64_C(0x8d3ec79a6b5021f4);
+
+// A `HilbertLut4` maps a 2 bit curve state s and 4 input digits (8 bits),
+// packed as (s << 8) | digits, to the 4 output digits and the state after
+// consuming them, packed the same way. A step therefore consumes 8 input
+// bits rather than the 6 consumed per step by the inline conversion
+// functions; the 2 KiB table still fits comfortably in L1 cache.
+struct HilbertLut4 {
+    uint16_t values[1024];
+};
+
+// `makeHilbertLut4` composes 4 steps of the single step LUT. If `inverse`
+// is true, the single step LUT is inverted first, so that the result maps
+// Hilbert digits to Morton digits.
+constexpr HilbertLut4 makeHilbertLut4(bool inverse) {
+    uint8_t step[16] = {};
+    for (uint32_t i = 0; i < 16; ++i) {
+        uint8_t j = static_cast<uint8_t>((HILBERT_LUT_1 >> (4 * i)) & 0xf);
+        if (inverse) {
+            // (e, d, l) -> (e', d', w) becomes (e, d, w) -> (e', d', l).
+            step[(i & 0xc) | (j & 3)] =
+                static_cast<uint8_t>((j & 0xc) | (i & 3));
+        } else {
+            step[i] = j;
+        }
+    }
+    HilbertLut4 lut = {};
+    for (uint32_t s = 0; s < 4; ++s) {
+        for (uint32_t in = 0; in < 256; ++in) {
+            uint32_t i = s << 2;
+            uint32_t out = 0;
+            for (int k = 3; k >= 0; --k) {
+                i = step[(i & 0xc) | ((in >> (2 * k)) & 3)];
+                out = (out << 2) | (i & 3);
+            }
+            lut.values[(s << 8) | in] =
+                static_cast<uint16_t>(out | ((i & 0xc) << 6));
+        }
+    }
+    return lut;
+}
+
+alignas(64) constexpr HilbertLut4 HILBERT_LUT_4 = makeHilbertLut4(false);
+alignas(64) constexpr HilbertLut4 HILBERT_INVERSE_LUT_4 =
+    makeHilbertLut4(true);
+
+// `convert` maps the 2m-bit index z from one curve to the other, 4 digits
+// at a time, using the given 4 step LUT.
+inline uint64_t convert(HilbertLut4 const & lut, uint64_t z, int m) {
+    uint64_t h = 0;
+    uint32_t i = 0;
+    for (m = 2 * m; m >= 8;) {
+        m -= 8;
+        uint32_t j = lut.values[i | ((z >> m) & 0xff)];
+        h = (h << 8) | (j & 0xff);
+        i = j & 0x300;
+    }
+    if (m != 0) {
+        // m = 2, 4 or 6
+        int r = 8 - m;
+        uint32_t j = lut.values[i | ((z << r) & 0xff)];
+        h = (h << m) | ((j & 0xff) >> r);
+    }
+    return h;
+}
+
+#if defined(LSST_SPHGEOM_CURVE_BMI2)
+
+    __attribute__((target("bmi2")))
+    void mortonIndexBmi2(uint32_t const * x,
+                         uint32_t const * y,
+                         uint64_t * out,
+                         size_t n)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = _pdep_u64(x[i], UINT64_C(0x5555555555555555)) |
+                     _pdep_u64(y[i], UINT64_C(0xaaaaaaaaaaaaaaaa));
+        }
+    }
+
+    __attribute__((target("bmi2")))
+    void mortonIndexInverseBmi2(uint64_t const * z,
+                                uint32_t * x,
+                                uint32_t * y,
+                                size_t n)
+    {
+        for (size_t i = 0; i < n; ++i) {
+            uint64_t const zi = z[i];
+            x[i] = static_cast<uint32_t>(
+                _pext_u64(zi, UINT64_C(0x5555555555555555)));
+            y[i] = static_cast<uint32_t>(
+                _pext_u64(zi, UINT64_C(0xaaaaaaaaaaaaaaaa)));
+        }
+    }
+
+#endif
+
+} // unnamed namespace
+
+
+void mortonIndex(uint32_t const * x,
+                 uint32_t const * y,
+                 uint64_t * out,
+                 size_t n)
+{
+#if defined(LSST_SPHGEOM_CURVE_BMI2)
+    if (detail::hasFastBmi2()) {
+        mortonIndexBmi2(x, y, out, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = mortonIndex(x[i], y[i]);
+    }
+}
+
+void mortonIndexInverse(uint64_t const * z,
+                        uint32_t * x,
+                        uint32_t * y,
+                        size_t n)
+{
+#if defined(LSST_SPHGEOM_CURVE_BMI2)
+    if (detail::hasFastBmi2()) {
+        mortonIndexInverseBmi2(z, x, y, n);
+        return;
+    }
+#endif
+    for (size_t i = 0; i < n; ++i) {
+        std::tie(x[i], y[i]) = mortonIndexInverse(z[i]);
+    }
+}
+
+void mortonToHilbert(uint64_t const * z, uint64_t * out, size_t n, int m) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = convert(HILBERT_LUT_4, z[i], m);
+    }
+}
+
+void hilbertToMorton(uint64_t const * h, uint64_t * out, size_t n, int m) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = convert(HILBERT_INVERSE_LUT_4, h[i], m);
+    }
+}
+
+void hilbertIndex(uint32_t const * x,
+                  uint32_t const * y,
+                  uint64_t * out,
+                  size_t n,
+                  int m)
+{
+    mortonIndex(x, y, out, n);
+    mortonToHilbert(out, out, n, m);
+}
+
+void hilbertIndexInverse(uint64_t const * h,
+                         uint32_t * x,
+                         uint32_t * y,
+                         size_t n,
+                         int m)
+{
+    // Convert to Morton order in blocks, so that no memory is allocated.
+    uint64_t z[256];
+    for (size_t i = 0; i < n; i += 256) {
+        size_t const b = std::min(n - i, static_cast<size_t>(256));
+        hilbertToMorton(h + i, z, b, m);
+        mortonIndexInverse(z, x + i, y + i, b);
+    }
+}
+
+}} // namespace lsst::sphgeom
@@ -0,0 +1,505 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the MOC reader and writer implementations.
+
+#include "lsst/sphgeom/moc.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/curve.h"
+#include "lsst/sphgeom/MultiLevelRangeSet.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// The number of HEALPix pixels at order 29, 12·4²⁹.
+constexpr uint64_t MOC_LIMIT = static_cast<uint64_t>(12) << 58;
+
+// Input is read in blocks of `BLOCK_SIZE` bytes.
+constexpr size_t BLOCK_SIZE = 1 << 16;
+
+constexpr size_t FITS_BLOCK_SIZE = 2880;
+constexpr size_t FITS_CARD_SIZE = 80;
+
+// `MocBuilder` accumulates the pixels of a MOC in one RangeSet per order,
+// since MOCs usually list pixels in ascending order within each order.
+class MocBuilder {
+public:
+    MocBuilder() : _orders(MOC_MAX_ORDER + 1) {}
+
+    // `add` adds the order `order` pixels [first, last].
+    void add(int order, uint64_t first, uint64_t last) {
+        if (order < 0 || order > MOC_MAX_ORDER) {
+            throw std::runtime_error("Invalid MOC order");
+        }
+        if (first > last || last >= (static_cast<uint64_t>(12) << (2 * order))) {
+            throw std::runtime_error("Invalid MOC pixel index");
+        }
+        int shift = 2 * (MOC_MAX_ORDER - order);
+        _orders[order].append(first << shift, (last + 1) << shift);
+    }
+
+    // `addRange` adds the order 29 pixels [first, last).
+    void addRange(uint64_t first, uint64_t last) {
+        if (first >= last || last > MOC_LIMIT) {
+            throw std::runtime_error("Invalid MOC range");
+        }
+        _orders[MOC_MAX_ORDER].append(first, last);
+    }
+
+    // `addUniq` adds the pixel with the given NUNIQ value.
+    void addUniq(uint64_t u) {
+        if (u < 4) {
+            throw std::runtime_error("Invalid MOC NUNIQ value");
+        }
+        int order = log2(u) / 2 - 1;
+        uint64_t i = u - (static_cast<uint64_t>(4) << (2 * order));
+        add(order, i, i);
+    }
+
+    RangeSet finish() const { return RangeSet::unionAll(_orders); }
+
+private:
+    std::vector<RangeSet> _orders;
+};
+
+// `toMultiLevel` checks the arguments of the MOC writers, and converts a
+// set of order 29 pixels to a multi-level set of the given order.
+MultiLevelRangeSet toMultiLevel(RangeSet const & s, int order) {
+    if (order < 0 || order > MOC_MAX_ORDER) {
+        throw std::invalid_argument("Invalid MOC order");
+    }
+    if (!s.isWithin(0, MOC_LIMIT)) {
+        throw std::invalid_argument(
+            "MOC pixels must be order 29 HEALPix nested indexes");
+    }
+    return MultiLevelRangeSet(
+        s.coarsened(static_cast<uint32_t>(MOC_MAX_ORDER - order)), order);
+}
+
+// FITS header parsing and formatting.
+
+// `trim` removes leading and trailing spaces.
+std::string trim(std::string const & s) {
+    size_t b = s.find_first_not_of(' ');
+    if (b == std::string::npos) {
+        return std::string();
+    }
+    return s.substr(b, s.find_last_not_of(' ') - b + 1);
+}
+
+using FitsHeader = std::map<std::string, std::string>;
+
+// `readFitsHeader` reads header blocks up to and including the one
+// containing the END card. It returns false if there is no more input.
+// String values are stored without their quotes and trailing spaces.
+bool readFitsHeader(std::istream & is, FitsHeader & header) {
+    header.clear();
+    char block[FITS_BLOCK_SIZE];
+    bool first = true;
+    while (true) {
+        is.read(block, FITS_BLOCK_SIZE);
+        if (is.gcount() == 0 && first) {
+            return false;
+        }
+        if (static_cast<size_t>(is.gcount()) != FITS_BLOCK_SIZE) {
+            throw std::runtime_error("Truncated FITS header");
+        }
+        first = false;
+        for (size_t c = 0; c < FITS_BLOCK_SIZE; c += FITS_CARD_SIZE) {
+            std::string card(block + c, FITS_CARD_SIZE);
+            std::string key = trim(card.substr(0, 8));
+            if (key == "END") {
+                return true;
+            }
+            if (card.compare(8, 2, "= ") != 0) {
+                continue;
+            }
+            std::string value = card.substr(10);
+            size_t q = value.find('\'');
+            if (q != std::string::npos && trim(value.substr(0, q)).empty()) {
+                // A string value, in which '' stands for a quote.
+                std::string str;
+                size_t i = q + 1;
+                for (; i < value.size(); ++i) {
+                    if (value[i] == '\'') {
+                        if (i + 1 < value.size() && value[i + 1] == '\'') {
+                            str += '\'';
+                            ++i;
+                            continue;
+                        }
+                        break;
+                    }
+                    str += value[i];
+                }
+                header[key] = trim(str);
+            } else {
+                header[key] = trim(value.substr(0, value.find('/')));
+            }
+        }
+    }
+}
+
+int64_t getInt(FitsHeader const & header, std::string const & key,
+               int64_t defaultValue) {
+    auto i = header.find(key);
+    if (i == header.end()) {
+        return defaultValue;
+    }
+    char * end = nullptr;
+    long long v = std::strtoll(i->second.c_str(), &end, 10);
+    if (end == i->second.c_str() || *end != '\0') {
+        throw std::runtime_error("Invalid FITS header value for " + key);
+    }
+    return v;
+}
+
+std::string getString(FitsHeader const & header, std::string const & key) {
+    auto i = header.find(key);
+    return i == header.end() ? std::string() : i->second;
+}
+
+// `skipFitsData` skips the data unit following a header.
+void skipFitsData(std::istream & is, FitsHeader const & header) {
+    int64_t naxis = getInt(header, "NAXIS", 0);
+    uint64_t size = 0;
+    if (naxis > 0) {
+        size = 1;
+        for (int64_t i = 1; i <= naxis; ++i) {
+            size *= static_cast<uint64_t>(
+                getInt(header, "NAXIS" + std::to_string(i), 0));
+        }
+    }
+    size = (size + static_cast<uint64_t>(getInt(header, "PCOUNT", 0))) *
+           static_cast<uint64_t>(getInt(header, "GCOUNT", 1)) *
+           static_cast<uint64_t>(std::abs(getInt(header, "BITPIX", 8)) / 8);
+    size = (size + FITS_BLOCK_SIZE - 1) / FITS_BLOCK_SIZE * FITS_BLOCK_SIZE;
+    is.ignore(static_cast<std::streamsize>(size));
+}
+
+std::string fitsCard(std::string const & key, std::string const & value,
+                     bool isString)
+{
+    char card[FITS_CARD_SIZE + 1];
+    if (isString) {
+        std::string v = value;
+        v.resize(std::max<size_t>(v.size(), 8), ' ');
+        std::snprintf(card, sizeof(card), "%-8s= '%s'", key.c_str(), v.c_str());
+    } else {
+        std::snprintf(card, sizeof(card), "%-8s= %20s", key.c_str(),
+                      value.c_str());
+    }
+    std::string s(card);
+    s.resize(FITS_CARD_SIZE, ' ');
+    return s;
+}
+
+void writeFitsHeader(std::ostream & os, std::string cards) {
+    std::string end("END");
+    end.resize(FITS_CARD_SIZE, ' ');
+    cards += end;
+    cards.resize((cards.size() + FITS_BLOCK_SIZE - 1) / FITS_BLOCK_SIZE *
+                 FITS_BLOCK_SIZE, ' ');
+    os.write(cards.data(), static_cast<std::streamsize>(cards.size()));
+}
+
+uint64_t loadBigEndian(unsigned char const * p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; ++i) {
+        v = (v << 8) | p[i];
+    }
+    return v;
+}
+
+} // unnamed namespace
+
+
+RangeSet readMocAscii(std::istream & is) {
+    MocBuilder builder;
+    std::vector<char> buffer(BLOCK_SIZE);
+    int order = -1;
+    uint64_t value = 0;
+    uint64_t low = 0;
+    bool haveValue = false;
+    bool haveLow = false;
+    bool tokenStart = true;
+    auto finishNumber = [&]() {
+        if (haveValue) {
+            if (order < 0) {
+                throw std::runtime_error("MOC pixel index without an order");
+            }
+            builder.add(order, haveLow ? low : value, value);
+        } else if (haveLow) {
+            throw std::runtime_error("Incomplete MOC pixel range");
+        }
+        value = 0;
+        haveValue = false;
+        haveLow = false;
+        tokenStart = true;
+    };
+    while (is) {
+        is.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        size_t n = static_cast<size_t>(is.gcount());
+        for (size_t i = 0; i < n; ++i) {
+            char c = buffer[i];
+            if (c >= '0' && c <= '9') {
+                if (value > (~static_cast<uint64_t>(0) - 9) / 10) {
+                    throw std::runtime_error("MOC integer overflow");
+                }
+                value = 10 * value + static_cast<uint64_t>(c - '0');
+                haveValue = true;
+                tokenStart = false;
+                continue;
+            }
+            switch (c) {
+                case '/':
+                    if (!haveValue || haveLow || value > MOC_MAX_ORDER) {
+                        throw std::runtime_error("Invalid MOC order");
+                    }
+                    order = static_cast<int>(value);
+                    value = 0;
+                    haveValue = false;
+                    tokenStart = true;
+                    break;
+                case '-':
+                    if (!haveValue || haveLow) {
+                        throw std::runtime_error("Invalid MOC pixel range");
+                    }
+                    low = value;
+                    value = 0;
+                    haveValue = false;
+                    haveLow = true;
+                    break;
+                case ' ': case ',': case '\n': case '\r': case '\t':
+                    finishNumber();
+                    break;
+                case 's':
+                    // The space MOC prefix of MOC 2.0.
+                    if (tokenStart && order < 0) {
+                        tokenStart = false;
+                        break;
+                    }
+                    throw std::runtime_error("Invalid character in MOC");
+                default:
+                    throw std::runtime_error("Invalid character in MOC");
+            }
+        }
+    }
+    finishNumber();
+    return builder.finish();
+}
+
+void writeMocAscii(std::ostream & os, RangeSet const & s, int order) {
+    MultiLevelRangeSet m = toMultiLevel(s, order);
+    bool first = true;
+    for (int l = 0; l <= order; ++l) {
+        RangeSet const & r = m.getRanges(l);
+        if (r.empty() && l != order) {
+            continue;
+        }
+        if (!first) {
+            os << ' ';
+        }
+        first = false;
+        os << l << '/';
+        bool firstRange = true;
+        for (auto const & t: r) {
+            uint64_t a = std::get<0>(t);
+            uint64_t b = std::get<1>(t) - 1;
+            os << (firstRange ? "" : " ") << a;
+            if (b != a) {
+                os << '-' << b;
+            }
+            firstRange = false;
+        }
+    }
+    os << '\n';
+}
+
+RangeSet readMocFits(std::istream & is) {
+    FitsHeader header;
+    if (!readFitsHeader(is, header) || getString(header, "SIMPLE") != "T") {
+        throw std::runtime_error("Not a FITS file");
+    }
+    skipFitsData(is, header);
+    while (readFitsHeader(is, header)) {
+        if (getString(header, "XTENSION") != "BINTABLE" ||
+            getInt(header, "TFIELDS", 0) != 1) {
+            skipFitsData(is, header);
+            continue;
+        }
+        std::string dim = getString(header, "MOCDIM");
+        if (!dim.empty() && dim != "SPACE") {
+            throw std::runtime_error("Only spatial MOCs are supported");
+        }
+        std::string form = getString(header, "TFORM1");
+        size_t width;
+        if (form == "K" || form == "1K") {
+            width = 8;
+        } else if (form == "J" || form == "1J") {
+            width = 4;
+        } else {
+            throw std::runtime_error("Unsupported MOC column format " + form);
+        }
+        if (getInt(header, "NAXIS1", 0) != static_cast<int64_t>(width)) {
+            throw std::runtime_error("Invalid MOC table row size");
+        }
+        std::string ordering = getString(header, "ORDERING");
+        bool ranges = (ordering == "RANGE");
+        if (!ranges && !ordering.empty() && ordering != "NUNIQ") {
+            throw std::runtime_error("Unsupported MOC ordering " + ordering);
+        }
+        int64_t rows = getInt(header, "NAXIS2", 0);
+        if (rows < 0 || (ranges && rows % 2 != 0)) {
+            throw std::runtime_error("Invalid MOC table size");
+        }
+        MocBuilder builder;
+        std::vector<unsigned char> buffer(BLOCK_SIZE / width * width);
+        uint64_t remaining = static_cast<uint64_t>(rows) * width;
+        uint64_t rangeStart = 0;
+        bool haveStart = false;
+        while (remaining != 0) {
+            size_t n = static_cast<size_t>(
+                std::min<uint64_t>(remaining, buffer.size()));
+            is.read(reinterpret_cast<char *>(buffer.data()),
+                    static_cast<std::streamsize>(n));
+            if (static_cast<size_t>(is.gcount()) != n) {
+                throw std::runtime_error("Truncated MOC table");
+            }
+            remaining -= n;
+            for (size_t i = 0; i < n; i += width) {
+                uint64_t v = loadBigEndian(buffer.data() + i, width);
+                if (!ranges) {
+                    builder.addUniq(v);
+                } else if (haveStart) {
+                    builder.addRange(rangeStart, v);
+                    haveStart = false;
+                } else {
+                    rangeStart = v;
+                    haveStart = true;
+                }
+            }
+        }
+        return builder.finish();
+    }
+    throw std::runtime_error("FITS file does not contain a MOC table");
+}
+
+void writeMocFits(std::ostream & os, RangeSet const & s, int order) {
+    MultiLevelRangeSet m = toMultiLevel(s, order);
+    uint64_t n = m.getNumPixels();
+    writeFitsHeader(os, fitsCard("SIMPLE", "T", false) +
+                        fitsCard("BITPIX", "8", false) +
+                        fitsCard("NAXIS", "0", false) +
+                        fitsCard("EXTEND", "T", false));
+    writeFitsHeader(os, fitsCard("XTENSION", "BINTABLE", true) +
+                        fitsCard("BITPIX", "8", false) +
+                        fitsCard("NAXIS", "2", false) +
+                        fitsCard("NAXIS1", "8", false) +
+                        fitsCard("NAXIS2", std::to_string(n), false) +
+                        fitsCard("PCOUNT", "0", false) +
+                        fitsCard("GCOUNT", "1", false) +
+                        fitsCard("TFIELDS", "1", false) +
+                        fitsCard("TTYPE1", "UNIQ", true) +
+                        fitsCard("TFORM1", "1K", true) +
+                        fitsCard("PIXTYPE", "HEALPIX", true) +
+                        fitsCard("ORDERING", "NUNIQ", true) +
+                        fitsCard("COORDSYS", "C", true) +
+                        fitsCard("MOCDIM", "SPACE", true) +
+                        fitsCard("MOCORDER", std::to_string(order), false) +
+                        fitsCard("MOCVERS", "2.0", true) +
+                        fitsCard("MOCTOOL", "lsst.sphgeom", true));
+    // NUNIQ values increase with order, and with index within an order.
+    std::vector<unsigned char> buffer;
+    buffer.reserve(BLOCK_SIZE);
+    for (int l = 0; l <= order; ++l) {
+        uint64_t base = static_cast<uint64_t>(4) << (2 * l);
+        for (auto const & t: m.getRanges(l)) {
+            for (uint64_t i = std::get<0>(t); i < std::get<1>(t); ++i) {
+                uint64_t u = base + i;
+                for (int b = 56; b >= 0; b -= 8) {
+                    buffer.push_back(static_cast<unsigned char>(u >> b));
+                }
+                if (buffer.size() == BLOCK_SIZE) {
+                    os.write(reinterpret_cast<char const *>(buffer.data()),
+                             static_cast<std::streamsize>(buffer.size()));
+                    buffer.clear();
+                }
+            }
+        }
+    }
+    size_t pad = static_cast<size_t>((FITS_BLOCK_SIZE - (8 * n) % FITS_BLOCK_SIZE) %
+                                     FITS_BLOCK_SIZE);
+    buffer.insert(buffer.end(), pad, 0);
+    os.write(reinterpret_cast<char const *>(buffer.data()),
+             static_cast<std::streamsize>(buffer.size()));
+}
+
+RangeSet readMoc(std::string const & path) {
+    std::ifstream is(path, std::ios::binary);
+    if (!is) {
+        throw std::runtime_error("Failed to open MOC file " + path);
+    }
+    char magic[9] = {};
+    is.read(magic, 9);
+    is.clear();
+    is.seekg(0);
+    if (std::memcmp(magic, "SIMPLE  =", 9) == 0) {
+        return readMocFits(is);
+    }
+    return readMocAscii(is);
+}
+
+void writeMoc(std::string const & path, RangeSet const & s, int order,
+              bool fits)
+{
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        throw std::runtime_error("Failed to open MOC file " + path);
+    }
+    if (fits) {
+        writeMocFits(os, s, order);
+    } else {
+        writeMocAscii(os, s, order);
+    }
+    os.close();
+    if (!os) {
+        throw std::runtime_error("Failed to write MOC file " + path);
+    }
+}
+
+}} // namespace lsst::sphgeom
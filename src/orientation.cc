@@ -26,8 +26,34 @@
 #include "lsst/sphgeom/orientation.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#if !defined(NO_SIMD) && defined(__x86_64__)
+    #include <x86intrin.h>
+#endif
+#if !defined(NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
 
-#include "lsst/sphgeom/BigInteger.h"
+#include "CpuDispatch.h"
+#include "PerformanceCounting.h"
+
+// The wide (AVX2) batch orientation kernel is compiled with a function level
+// target attribute and selected at run time, so that a baseline x86-64 build
+// still runs on CPUs without AVX2.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #define LSST_SPHGEOM_ORIENTATION_AVX2 1
+#endif
+
+// Advanced SIMD is part of the aarch64 baseline, so the 2-wide (NEON) kernel
+// needs no target attribute.
+#if !defined(NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+    #define LSST_SPHGEOM_ORIENTATION_NEON 1
+#endif
 
 
 namespace lsst {
@@ -35,99 +61,434 @@ namespace sphgeom {
 
 namespace {
 
-// `BigFloat` is an exact floating point type.
-struct BigFloat {
-    BigInteger * mantissa;
-    int exponent;
+// The exact orientation computation sums the 6 products of 3 doubles in the
+// expansion of the determinant using fixed point arithmetic. The constants
+// below bound the sizes involved, given the range of double exponents.
+
+// The number of bits in a double significand.
+constexpr int SIGNIFICAND_BITS = std::numeric_limits<double>::digits;
+// The range of exponents e such that a finite non-zero double is equal to
+// ±m·2ᵉ, where m is its integer significand.
+constexpr int MIN_EXPONENT =
+    std::numeric_limits<double>::min_exponent - SIGNIFICAND_BITS;
+constexpr int MAX_EXPONENT =
+    std::numeric_limits<double>::max_exponent - SIGNIFICAND_BITS;
+// The maximum difference between the exponents of two triple products.
+constexpr int MAX_EXPONENT_DIFFERENCE = 3 * (MAX_EXPONENT - MIN_EXPONENT);
 
-    BigFloat() : mantissa(0), exponent(0) {}
-    BigFloat(BigInteger * m) : mantissa(m), exponent(0) {}
+// `Product` is the exact product of 3 doubles, equal to ±m·2ᵉ, where the
+// magnitude m has at most 3·53 bits and is stored as 3 64 bit limbs, from
+// least to most significant.
+struct Product {
+    uint64_t m[3];
+    int exponent;
+    bool negative;
 };
 
+// `multiply64` computes the 128 bit product of a and b.
+inline void multiply64(uint64_t a, uint64_t b, uint64_t & hi, uint64_t & lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 uint128_t;
+    uint128_t p = static_cast<uint128_t>(a) * b;
+    hi = static_cast<uint64_t>(p >> 64);
+    lo = static_cast<uint64_t>(p);
+#else
+    uint64_t a0 = a & 0xffffffff, a1 = a >> 32;
+    uint64_t b0 = b & 0xffffffff, b1 = b >> 32;
+    uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+    uint64_t mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+    hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+    lo = (mid << 32) | (p00 & 0xffffffff);
+#endif
+}
+
+// `decompose` returns the integer significand m of the finite double d, and
+// sets e so that |d| = m·2ᵉ.
+inline uint64_t decompose(double d, int & e) {
+    static_assert(std::numeric_limits<double>::is_iec559,
+                  "doubles must be IEEE 754 binary64 values");
+    uint64_t bits;
+    std::memcpy(&bits, &d, sizeof(bits));
+    int biasedExponent = static_cast<int>((bits >> 52) & 0x7ff);
+    uint64_t m = bits & ((uint64_t(1) << 52) - 1);
+    if (biasedExponent == 0) {
+        // d is zero or subnormal.
+        e = MIN_EXPONENT;
+        return m;
+    }
+    e = biasedExponent + MIN_EXPONENT - 1;
+    return m | (uint64_t(1) << 52);
+}
+
 // `computeProduct` computes the product of 3 doubles exactly and stores the
-// result in p.
-void computeProduct(BigFloat & p, double d0, double d1, double d2) {
-    // This constant (2^53) is used to scale the fractions returned by
-    // std::frexp and turn them into integer mantissas.
-    static double const SCALE = 9007199254740992.0;
-    uint32_t buf[2];
-    BigInteger i(buf, sizeof(buf) / sizeof(uint32_t));
-    // Unpack the 3 input doubles into integer mantissas and exponents.
-    int e0 = 0;
-    int e1 = 0;
-    int e2 = 0;
-    double m0 = std::frexp(d0, &e0) * SCALE;
-    double m1 = std::frexp(d1, &e1) * SCALE;
-    double m2 = std::frexp(d2, &e2) * SCALE;
-    // Compute the product of the 3 input doubles using exact arithmetic.
-    p.mantissa->setTo(static_cast<int64_t>(m0));
-    i.setTo(static_cast<int64_t>(m1));
-    p.mantissa->multiply(i);
-    i.setTo(static_cast<int64_t>(m2));
-    p.mantissa->multiply(i);
-    // Finally, adjust the exponent of the result to compensate for the 3
-    // multiplications by 2^53 performed above.
-    p.exponent = e0 + e1 + e2 - 3 * 53;
+// result in p. It returns false if the product is zero.
+bool computeProduct(Product & p, double d0, double d1, double d2) {
+    if (d0 == 0.0 || d1 == 0.0 || d2 == 0.0) {
+        return false;
+    }
+    int e0, e1, e2;
+    uint64_t i0 = decompose(d0, e0);
+    uint64_t i1 = decompose(d1, e1);
+    uint64_t i2 = decompose(d2, e2);
+    p.negative = std::signbit(d0) != (std::signbit(d1) != std::signbit(d2));
+    // The product of the first two significands has at most 106 bits, and
+    // its high limb at most 42, so the product with the third has 3 limbs.
+    uint64_t hi, lo, h0, l0, h1, l1;
+    multiply64(i0, i1, hi, lo);
+    multiply64(lo, i2, h0, l0);
+    multiply64(hi, i2, h1, l1);
+    p.m[0] = l0;
+    p.m[1] = h0 + l1;
+    p.m[2] = h1 + (p.m[1] < h0);
+    p.exponent = e0 + e1 + e2;
+    return true;
+}
+
+// `FixedInteger<N>` is a signed integer with N 64 bit limbs, stored from
+// least to most significant in two's complement form, that lives on the
+// stack. It supports just enough arithmetic to sum triple products.
+template <unsigned N>
+class FixedInteger {
+public:
+    // `clear` sets the lowest n limbs of this integer to zero, and makes
+    // them the only limbs that subsequent operations touch.
+    void clear(unsigned n) {
+        _size = n;
+        std::fill(_limbs, _limbs + n, uint64_t(0));
+    }
+
+    // `add` adds (or subtracts, if `negative` is true) p·2ˢ to this integer.
+    // The shifted product must fit in limbs [s/64, s/64 + 4) of the limbs
+    // in use, and the result must fit in all of them.
+    void add(Product const & p, unsigned s) {
+        uint64_t t[4];
+        unsigned const q = s >> 6;
+        unsigned const r = s & 63;
+        if (r == 0) {
+            t[0] = p.m[0];
+            t[1] = p.m[1];
+            t[2] = p.m[2];
+            t[3] = 0;
+        } else {
+            t[0] = p.m[0] << r;
+            t[1] = (p.m[1] << r) | (p.m[0] >> (64 - r));
+            t[2] = (p.m[2] << r) | (p.m[1] >> (64 - r));
+            t[3] = p.m[2] >> (64 - r);
+        }
+        uint64_t * limbs = _limbs + q;
+        unsigned const n = _size - q;
+        if (p.negative) {
+            uint64_t borrow = 0;
+            for (unsigned i = 0; i < 4; ++i) {
+                uint64_t x = limbs[i];
+                uint64_t d = x - t[i] - borrow;
+                borrow = (x < t[i]) | ((x - t[i]) < borrow);
+                limbs[i] = d;
+            }
+            for (unsigned i = 4; borrow != 0 && i < n; ++i) {
+                borrow = (limbs[i] == 0);
+                limbs[i] -= 1;
+            }
+        } else {
+            uint64_t carry = 0;
+            for (unsigned i = 0; i < 4; ++i) {
+                uint64_t x = limbs[i] + carry;
+                carry = (x < carry);
+                limbs[i] = x + t[i];
+                carry |= (limbs[i] < x);
+            }
+            for (unsigned i = 4; carry != 0 && i < n; ++i) {
+                limbs[i] += 1;
+                carry = (limbs[i] == 0);
+            }
+        }
+    }
+
+    // `getSign` returns -1, 0 or 1 if this integer is negative, zero or
+    // positive.
+    int getSign() const {
+        if (static_cast<int64_t>(_limbs[_size - 1]) < 0) {
+            return -1;
+        }
+        for (unsigned i = 0; i < _size; ++i) {
+            if (_limbs[i] != 0) {
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    uint64_t _limbs[N];
+    unsigned _size = 0;
+};
+
+// A shifted product occupies 4 limbs, and one more holds carries and the
+// sign of the sum of 6 products.
+using Accumulator = FixedInteger<MAX_EXPONENT_DIFFERENCE / 64 + 5>;
+
+// An upper bound on the absolute error in the double precision determinant
+// computed by orientation() for unit vectors; see below.
+constexpr double MAX_ABSOLUTE_ERROR = ORIENTATION_MAX_ABSOLUTE_ERROR;
+
+// Orientation statistics, indexed by the stage that decided a call.
+enum Stage { FAST, PERMANENT, DEGENERATE, EXPANSION, EXACT, NUM_STAGES };
+
+std::atomic<bool> statisticsEnabled{false};
+std::atomic<uint64_t> statistics[NUM_STAGES];
+
+inline void record(Stage stage, uint64_t count = 1) {
+    if (statisticsEnabled.load(std::memory_order_relaxed)) {
+        statistics[stage].fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+// The functions below implement the floating point expansion arithmetic
+// described in:
+//
+//     Adaptive Precision Floating-Point Arithmetic
+//     and Fast Robust Geometric Predicates,
+//     Jonathan Richard Shewchuk,
+//     Discrete & Computational Geometry 18(3):305–363, October 1997.
+//
+// An expansion is a sum of doubles stored in order of increasing magnitude,
+// no two of which have overlapping significant bits. The sign of an
+// expansion is the sign of its largest component. All operations are exact,
+// provided that no intermediate result overflows or underflows, and that
+// double precision arithmetic is correctly rounded (which in particular
+// rules out contracting multiplications and additions into FMAs).
+
+// `twoSum` computes s = fl(a + b) and e such that a + b = s + e exactly.
+inline void twoSum(double a, double b, double & s, double & e) {
+    s = a + b;
+    double bv = s - a;
+    double av = s - bv;
+    e = (a - av) + (b - bv);
+}
+
+// `fastTwoSum` is equivalent to `twoSum`, but requires that |a| ≥ |b|.
+inline void fastTwoSum(double a, double b, double & s, double & e) {
+    s = a + b;
+    e = b - (s - a);
+}
+
+// `split` divides the 53 bit significand of a into two halves, hi and lo,
+// with a = hi + lo.
+inline void split(double a, double & hi, double & lo) {
+    static double const SPLITTER = 134217729.0; // 2^27 + 1
+    double c = SPLITTER * a;
+    hi = c - (c - a);
+    lo = a - hi;
+}
+
+// `twoProduct` computes p = fl(a * b) and e such that a * b = p + e exactly.
+inline void twoProduct(double a, double b, double & p, double & e) {
+    p = a * b;
+    double ahi, alo, bhi, blo;
+    split(a, ahi, alo);
+    split(b, bhi, blo);
+    e = alo * blo - (((p - ahi * bhi) - alo * bhi) - ahi * blo);
+}
+
+// `growExpansion` sets h to the sum of the n component expansion e and b,
+// and returns the number of components in h, which must have room for n + 1.
+int growExpansion(int n, double const * e, double b, double * h) {
+    double q = b;
+    int k = 0;
+    for (int i = 0; i < n; ++i) {
+        double t;
+        twoSum(q, e[i], q, t);
+        if (t != 0.0) {
+            h[k++] = t;
+        }
+    }
+    if (q != 0.0 || k == 0) {
+        h[k++] = q;
+    }
+    return k;
+}
+
+// `sumExpansions` sets h to the sum of the m component expansion e and the
+// n component expansion f, and returns the number of components in h, which
+// must have room for m + n. The inputs are merged in order of increasing
+// magnitude, so the cost is linear in the number of components.
+int sumExpansions(int m, double const * e, int n, double const * f,
+                  double * h) {
+    int i = 0;
+    int j = 0;
+    int k = 0;
+    // `next` returns the smaller magnitude of the next components of e and f.
+    auto next = [&]() -> double {
+        if (j == n || (i < m && std::fabs(e[i]) < std::fabs(f[j]))) {
+            return e[i++];
+        }
+        return f[j++];
+    };
+    double q = next();
+    double t;
+    if (i + j < m + n) {
+        fastTwoSum(next(), q, q, t);
+        if (t != 0.0) {
+            h[k++] = t;
+        }
+    }
+    while (i + j < m + n) {
+        twoSum(q, next(), q, t);
+        if (t != 0.0) {
+            h[k++] = t;
+        }
+    }
+    if (q != 0.0 || k == 0) {
+        h[k++] = q;
+    }
+    return k;
+}
+
+// `scaleExpansion` sets h to the product of the n component expansion e
+// and b, and returns the number of components in h, which must have room
+// for 2n.
+int scaleExpansion(int n, double const * e, double b, double * h) {
+    double q, t;
+    int k = 0;
+    twoProduct(e[0], b, q, t);
+    if (t != 0.0) {
+        h[k++] = t;
+    }
+    for (int i = 1; i < n; ++i) {
+        double p1, p0, sum;
+        twoProduct(e[i], b, p1, p0);
+        twoSum(q, p0, sum, t);
+        if (t != 0.0) {
+            h[k++] = t;
+        }
+        fastTwoSum(p1, sum, q, t);
+        if (t != 0.0) {
+            h[k++] = t;
+        }
+    }
+    if (q != 0.0 || k == 0) {
+        h[k++] = q;
+    }
+    return k;
+}
+
+// `scaledMinor` sets h to the expansion for s·(u0·v1 - u1·v0), and returns
+// the number of components in h, which must have room for 8.
+int scaledMinor(double s, double u0, double v1, double u1, double v0,
+                double * h) {
+    double m[4];
+    double tmp[4];
+    double p, e;
+    twoProduct(u0, v1, p, e);
+    m[0] = e;
+    m[1] = p;
+    twoProduct(u1, v0, p, e);
+    int n = growExpansion(2, m, -p, tmp);
+    n = growExpansion(n, tmp, -e, m);
+    return scaleExpansion(n, m, s, h);
+}
+
+// `orientationExpansion` computes the orientation of a, b and c exactly
+// using floating point expansions. It returns false without setting
+// `result` if a vector component is so small that the computation could
+// underflow.
+bool orientationExpansion(Vector3d const & a,
+                          Vector3d const & b,
+                          Vector3d const & c,
+                          int & result)
+{
+    // If every non-zero component is at least 2^-250 in magnitude (and at
+    // most 1), then every exact triple product is an integer multiple of
+    // 2^-906, and so are all the expansion components derived from them.
+    // Such values are representable as normalized doubles.
+    static double const minComponent = 5.6e-76; // > 2^-250
+    double const components[9] = {
+        a.x(), a.y(), a.z(), b.x(), b.y(), b.z(), c.x(), c.y(), c.z()
+    };
+    for (double d : components) {
+        if (d != 0.0 && std::fabs(d) < minComponent) {
+            return false;
+        }
+    }
+    double x[8], y[8], z[8], xy[16], h[24];
+    int nx = scaledMinor(a.x(), b.y(), c.z(), b.z(), c.y(), x);
+    int ny = scaledMinor(a.y(), b.z(), c.x(), b.x(), c.z(), y);
+    int nz = scaledMinor(a.z(), b.x(), c.y(), b.y(), c.x(), z);
+    int nxy = sumExpansions(nx, x, ny, y, xy);
+    int n = sumExpansions(nxy, xy, nz, z, h);
+    double top = h[n - 1];
+    result = (top > 0.0) - (top < 0.0);
+    return true;
+}
+
+// `orientationFallback` computes the orientation of a, b and c exactly,
+// preferring floating point expansions to integer arithmetic.
+int orientationFallback(Vector3d const & a,
+                        Vector3d const & b,
+                        Vector3d const & c)
+{
+    detail::count(PerformanceCounter::ORIENTATION_FALLBACKS);
+    int result;
+    if (orientationExpansion(a, b, c, result)) {
+        record(EXPANSION);
+        return result;
+    }
+    record(EXACT);
+    return orientationExact(a, b, c);
 }
 
 } // unnamed namespace
 
 
+void enableOrientationStatistics(bool enable) {
+    statisticsEnabled.store(enable, std::memory_order_relaxed);
+}
+
+OrientationStatistics getOrientationStatistics() {
+    OrientationStatistics s;
+    s.fast = statistics[FAST].load(std::memory_order_relaxed);
+    s.permanent = statistics[PERMANENT].load(std::memory_order_relaxed);
+    s.degenerate = statistics[DEGENERATE].load(std::memory_order_relaxed);
+    s.expansion = statistics[EXPANSION].load(std::memory_order_relaxed);
+    s.exact = statistics[EXACT].load(std::memory_order_relaxed);
+    return s;
+}
+
+void resetOrientationStatistics() {
+    for (auto & s : statistics) {
+        s.store(0, std::memory_order_relaxed);
+    }
+}
+
 int orientationExact(Vector3d const & a,
                      Vector3d const & b,
                      Vector3d const & c)
 {
-    // Product mantissa storage buffers.
-    uint32_t mantissaBuffers[6][6];
-    // Product mantissas.
-    BigInteger mantissas[6] = {
-        BigInteger(mantissaBuffers[0], 6),
-        BigInteger(mantissaBuffers[1], 6),
-        BigInteger(mantissaBuffers[2], 6),
-        BigInteger(mantissaBuffers[3], 6),
-        BigInteger(mantissaBuffers[4], 6),
-        BigInteger(mantissaBuffers[5], 6)
-    };
-    BigFloat products[6] = {
-        BigFloat(&mantissas[0]),
-        BigFloat(&mantissas[1]),
-        BigFloat(&mantissas[2]),
-        BigFloat(&mantissas[3]),
-        BigFloat(&mantissas[4]),
-        BigFloat(&mantissas[5])
-    };
-    // An accumulator and its storage.
-    uint32_t accumulatorBuffer[512];
-    BigInteger accumulator(accumulatorBuffer,
-                           sizeof(accumulatorBuffer) / sizeof(uint32_t));
-    // Compute the products in the determinant. Performing all multiplication
-    // up front means that each product mantissa occupies at most 3*53 bits.
-    computeProduct(products[0], a.x(), b.y(), c.z());
-    computeProduct(products[1], a.x(), b.z(), c.y());
-    computeProduct(products[2], a.y(), b.z(), c.x());
-    computeProduct(products[3], a.y(), b.x(), c.z());
-    computeProduct(products[4], a.z(), b.x(), c.y());
-    computeProduct(products[5], a.z(), b.y(), c.x());
-    mantissas[1].negate();
-    mantissas[3].negate();
-    mantissas[5].negate();
-    // Sort the array of products in descending exponent order.
-    std::sort(products, products + 6, [](BigFloat const & a, BigFloat const & b) {
-        return a.exponent > b.exponent;
-    });
-    // First, initialize the accumulator to the product with the highest
-    // exponent, then add the remaining products. Prior to each addition, we
-    // must shift the accumulated value so that its radix point lines up with
-    // the the radix point of the product to add.
-    //
-    // More precisely, at each step we have an accumulated value A·2ʲ and a
-    // product P·2ᵏ, and we update the accumulator to equal (A·2ʲ⁻ᵏ + P)·2ᵏ.
-    // Because the products were sorted beforehand, j ≥ k and 2ʲ⁻ᵏ is an
-    // integer.
-    accumulator = *products[0].mantissa;
-    for (int i = 1; i < 6; ++i) {
-        accumulator.multiplyPow2(products[i - 1].exponent - products[i].exponent);
-        accumulator.add(*products[i].mantissa);
+    // Compute the products in the determinant, dropping zeros.
+    Product products[6];
+    int n = 0;
+    n += computeProduct(products[n], a.x(), b.y(), c.z());
+    n += computeProduct(products[n], -a.x(), b.z(), c.y());
+    n += computeProduct(products[n], a.y(), b.z(), c.x());
+    n += computeProduct(products[n], -a.y(), b.x(), c.z());
+    n += computeProduct(products[n], a.z(), b.x(), c.y());
+    n += computeProduct(products[n], -a.z(), b.y(), c.x());
+    if (n == 0) {
+        return 0;
+    }
+    // Express each product relative to the smallest exponent e, so that the
+    // determinant is an integer multiple of 2ᵉ, and sum them in fixed point.
+    int minExponent = products[0].exponent;
+    int maxExponent = products[0].exponent;
+    for (int i = 1; i < n; ++i) {
+        minExponent = std::min(minExponent, products[i].exponent);
+        maxExponent = std::max(maxExponent, products[i].exponent);
+    }
+    Accumulator accumulator;
+    accumulator.clear(static_cast<unsigned>(maxExponent - minExponent) / 64 + 5);
+    for (int i = 0; i < n; ++i) {
+        accumulator.add(products[i],
+                        static_cast<unsigned>(products[i].exponent - minExponent));
     }
     return accumulator.getSign();
 }
@@ -153,10 +514,9 @@ int orientation(UnitVector3d const & a,
     // Because all 3 unit vectors are normalized, the maximum absolute value of
     // any vector component, cross product component or dot product term in
     // the calculation is very close to 1. The permanent of |M| must therefore
-    // be below 3 + c, where c is some small multiple of ε. This constant, a
-    // little larger than 3 * 5ε, is an upper bound on the absolute error in
-    // the determinant calculation.
-    static double const maxAbsoluteError = 1.7e-15;
+    // be below 3 + c, where c is some small multiple of ε, and
+    // MAX_ABSOLUTE_ERROR bounds the absolute error in the determinant.
+    static double const maxAbsoluteError = MAX_ABSOLUTE_ERROR;
     // This constant accounts for floating point underflow (assuming hardware
     // without gradual underflow, just to be conservative) in the computation
     // of det(M). It is a little more than 14 * 2^-1022.
@@ -172,26 +532,222 @@ int orientation(UnitVector3d const & a,
                          a.y() * (bzcx - bxcz) +
                          a.z() * (bxcy - bycx);
     if (determinant > maxAbsoluteError) {
+        record(FAST);
         return 1;
     } else if (determinant < -maxAbsoluteError) {
+        record(FAST);
         return -1;
     }
     // Expend some more effort on what is hopefully a tighter error bound
-    // before falling back on arbitrary precision arithmetic.
+    // before falling back on exact arithmetic.
     double permanent = std::fabs(a.x()) * (std::fabs(bycz) + std::fabs(bzcy)) +
                        std::fabs(a.y()) * (std::fabs(bzcx) + std::fabs(bxcz)) +
                        std::fabs(a.z()) * (std::fabs(bxcy) + std::fabs(bycx));
     double maxError = relativeError * permanent + minAbsoluteError;
     if (determinant > maxError) {
+        record(PERMANENT);
         return 1;
     } else if (determinant < -maxError) {
+        record(PERMANENT);
         return -1;
     }
     // Avoid the slow path when any two inputs are identical or antipodal.
     if (a == b || b == c || a == c || a == -b || b == -c || a == -c) {
+        record(DEGENERATE);
         return 0;
     }
-    return orientationExact(a, b, c);
+    return orientationFallback(a, b, c);
+}
+
+namespace {
+
+static_assert(sizeof(UnitVector3d) == 3 * sizeof(double),
+              "unit vector arrays must consist of packed components");
+
+#if defined(LSST_SPHGEOM_ORIENTATION_AVX2)
+
+// `load4` loads the components of the 4 unit vectors starting at p.
+__attribute__((target("avx2")))
+inline void load4(UnitVector3d const * p, __m256d & x, __m256d & y, __m256d & z) {
+    double const * d = p->getData();
+    // m0 = (x0 y0 z0 x1), m1 = (y1 z1 x2 y2), m2 = (z2 x3 y3 z3)
+    __m256d m0 = _mm256_loadu_pd(d);
+    __m256d m1 = _mm256_loadu_pd(d + 4);
+    __m256d m2 = _mm256_loadu_pd(d + 8);
+    __m256d t0 = _mm256_permute2f128_pd(m0, m1, 0x30); // x0 y0 x2 y2
+    __m256d t1 = _mm256_permute2f128_pd(m0, m2, 0x21); // z0 x1 z2 x3
+    __m256d t2 = _mm256_permute2f128_pd(m1, m2, 0x30); // y1 z1 y3 z3
+    x = _mm256_shuffle_pd(t0, t1, 0xa);
+    y = _mm256_shuffle_pd(t0, t2, 0x5);
+    z = _mm256_shuffle_pd(t1, t2, 0xa);
+}
+
+// `orientationAvx2` computes orientation(a[i], b[i], c[i]) 4 at a time, for
+// i in [0, n & ~3), and returns the number of orientations computed. If
+// `broadcastA` is true, a[0] is used in place of every a[i].
+//
+// The determinant is computed exactly as in orientation(), and lanes for
+// which its magnitude does not exceed the error bound there are passed to
+// orientation().
+__attribute__((target("avx2")))
+size_t orientationAvx2(UnitVector3d const * a,
+                       bool broadcastA,
+                       UnitVector3d const * b,
+                       UnitVector3d const * c,
+                       int * out,
+                       size_t n)
+{
+    __m256d const maxError = _mm256_set1_pd(MAX_ABSOLUTE_ERROR);
+    __m256d const minError = _mm256_set1_pd(-MAX_ABSOLUTE_ERROR);
+    __m256d ax = _mm256_set1_pd(a->x());
+    __m256d ay = _mm256_set1_pd(a->y());
+    __m256d az = _mm256_set1_pd(a->z());
+    size_t const m = n & ~static_cast<size_t>(3);
+    uint64_t decided = 0;
+    for (size_t i = 0; i < m; i += 4) {
+        __m256d bx, by, bz, cx, cy, cz;
+        if (!broadcastA) {
+            load4(a + i, ax, ay, az);
+        }
+        load4(b + i, bx, by, bz);
+        load4(c + i, cx, cy, cz);
+        __m256d bycz = _mm256_mul_pd(by, cz);
+        __m256d bzcy = _mm256_mul_pd(bz, cy);
+        __m256d bzcx = _mm256_mul_pd(bz, cx);
+        __m256d bxcz = _mm256_mul_pd(bx, cz);
+        __m256d bxcy = _mm256_mul_pd(bx, cy);
+        __m256d bycx = _mm256_mul_pd(by, cx);
+        __m256d det = _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(ax, _mm256_sub_pd(bycz, bzcy)),
+                          _mm256_mul_pd(ay, _mm256_sub_pd(bzcx, bxcz))),
+            _mm256_mul_pd(az, _mm256_sub_pd(bxcy, bycx)));
+        int pos = _mm256_movemask_pd(_mm256_cmp_pd(det, maxError, _CMP_GT_OQ));
+        int neg = _mm256_movemask_pd(_mm256_cmp_pd(det, minError, _CMP_LT_OQ));
+        decided += __builtin_popcount(pos | neg);
+        for (int j = 0; j < 4; ++j) {
+            if (pos & (1 << j)) {
+                out[i + j] = 1;
+            } else if (neg & (1 << j)) {
+                out[i + j] = -1;
+            } else {
+                out[i + j] = orientation(broadcastA ? a[0] : a[i + j],
+                                         b[i + j], c[i + j]);
+            }
+        }
+    }
+    record(FAST, decided);
+    return m;
+}
+
+#endif
+
+#if defined(LSST_SPHGEOM_ORIENTATION_NEON)
+
+// `orientationNeon` is the 2-wide analogue of `orientationAvx2`. It computes
+// orientation(a[i], b[i], c[i]) for i in [0, n & ~1), and returns the number
+// of orientations computed.
+size_t orientationNeon(UnitVector3d const * a,
+                       bool broadcastA,
+                       UnitVector3d const * b,
+                       UnitVector3d const * c,
+                       int * out,
+                       size_t n)
+{
+    float64x2_t const maxError = vdupq_n_f64(MAX_ABSOLUTE_ERROR);
+    float64x2_t const minError = vdupq_n_f64(-MAX_ABSOLUTE_ERROR);
+    float64x2x3_t va;
+    va.val[0] = vdupq_n_f64(a->x());
+    va.val[1] = vdupq_n_f64(a->y());
+    va.val[2] = vdupq_n_f64(a->z());
+    size_t const m = n & ~static_cast<size_t>(1);
+    uint64_t decided = 0;
+    for (size_t i = 0; i < m; i += 2) {
+        if (!broadcastA) {
+            va = vld3q_f64(a[i].getData());
+        }
+        // vld3q_f64 de-interleaves the x, y and z components of 2 vectors.
+        float64x2x3_t vb = vld3q_f64(b[i].getData());
+        float64x2x3_t vc = vld3q_f64(c[i].getData());
+        float64x2_t bycz = vmulq_f64(vb.val[1], vc.val[2]);
+        float64x2_t bzcy = vmulq_f64(vb.val[2], vc.val[1]);
+        float64x2_t bzcx = vmulq_f64(vb.val[2], vc.val[0]);
+        float64x2_t bxcz = vmulq_f64(vb.val[0], vc.val[2]);
+        float64x2_t bxcy = vmulq_f64(vb.val[0], vc.val[1]);
+        float64x2_t bycx = vmulq_f64(vb.val[1], vc.val[0]);
+        float64x2_t det = vaddq_f64(
+            vaddq_f64(vmulq_f64(va.val[0], vsubq_f64(bycz, bzcy)),
+                      vmulq_f64(va.val[1], vsubq_f64(bzcx, bxcz))),
+            vmulq_f64(va.val[2], vsubq_f64(bxcy, bycx)));
+        uint64x2_t pos = vcgtq_f64(det, maxError);
+        uint64x2_t neg = vcltq_f64(det, minError);
+        uint64_t p[2] = {vgetq_lane_u64(pos, 0), vgetq_lane_u64(pos, 1)};
+        uint64_t q[2] = {vgetq_lane_u64(neg, 0), vgetq_lane_u64(neg, 1)};
+        for (int j = 0; j < 2; ++j) {
+            if (p[j] != 0) {
+                out[i + j] = 1;
+                ++decided;
+            } else if (q[j] != 0) {
+                out[i + j] = -1;
+                ++decided;
+            } else {
+                out[i + j] = orientation(broadcastA ? a[0] : a[i + j],
+                                         b[i + j], c[i + j]);
+            }
+        }
+    }
+    record(FAST, decided);
+    return m;
+}
+
+#endif
+
+} // unnamed namespace
+
+void orientationBatch(UnitVector3d const * a,
+                      UnitVector3d const * b,
+                      UnitVector3d const * c,
+                      int * out,
+                      size_t n)
+{
+    size_t i = 0;
+#if defined(LSST_SPHGEOM_ORIENTATION_AVX2)
+    if (detail::hasAvx2()) {
+        i = orientationAvx2(a, false, b, c, out, n);
+    }
+#elif defined(LSST_SPHGEOM_ORIENTATION_NEON)
+    if (detail::hasNeon()) {
+        i = orientationNeon(a, false, b, c, out, n);
+    }
+#endif
+    for (; i < n; ++i) {
+        out[i] = orientation(a[i], b[i], c[i]);
+    }
+}
+
+void orientationEdges(UnitVector3d const & v,
+                      UnitVector3d const * vertices,
+                      int * out,
+                      size_t n)
+{
+    if (n == 0) {
+        return;
+    }
+    // Edge i runs from vertex i to vertex i + 1 for i < n - 1. The final
+    // edge wraps around to vertex 0.
+    size_t i = 0;
+#if defined(LSST_SPHGEOM_ORIENTATION_AVX2)
+    if (detail::hasAvx2()) {
+        i = orientationAvx2(&v, true, vertices, vertices + 1, out, n - 1);
+    }
+#elif defined(LSST_SPHGEOM_ORIENTATION_NEON)
+    if (detail::hasNeon()) {
+        i = orientationNeon(&v, true, vertices, vertices + 1, out, n - 1);
+    }
+#endif
+    for (; i < n - 1; ++i) {
+        out[i] = orientation(v, vertices[i], vertices[i + 1]);
+    }
+    out[n - 1] = orientation(v, vertices[n - 1], vertices[0]);
 }
 
 
@@ -208,15 +764,19 @@ namespace {
 
         double determinant = ab - ba;
         if (determinant > maxAbsoluteError) {
+            record(FAST);
             return 1;
         } else if (determinant < -maxAbsoluteError) {
+            record(FAST);
             return -1;
         }
         double permanent = std::fabs(ab) + std::fabs(ba);
         double maxError = relativeError * permanent + minAbsoluteError;
         if (determinant > maxError) {
+            record(PERMANENT);
             return 1;
         } else if (determinant < -maxError) {
+            record(PERMANENT);
             return -1;
         }
         return 0;
@@ -226,17 +786,17 @@ namespace {
 
 int orientationX(UnitVector3d const & b, UnitVector3d const & c) {
     int o = _orientationXYZ(b.y() * c.z(), b.z() * c.y());
-    return (o != 0) ? o : orientationExact(UnitVector3d::X(), b, c);
+    return (o != 0) ? o : orientationFallback(UnitVector3d::X(), b, c);
 }
 
 int orientationY(UnitVector3d const & b, UnitVector3d const & c) {
     int o = _orientationXYZ(b.z() * c.x(), b.x() * c.z());
-    return (o != 0) ? o : orientationExact(UnitVector3d::Y(), b, c);
+    return (o != 0) ? o : orientationFallback(UnitVector3d::Y(), b, c);
 }
 
 int orientationZ(UnitVector3d const & b, UnitVector3d const & c) {
     int o = _orientationXYZ(b.x() * c.y(), b.y() * c.x());
-    return (o != 0) ? o : orientationExact(UnitVector3d::Z(), b, c);
+    return (o != 0) ? o : orientationFallback(UnitVector3d::Z(), b, c);
 }
 
 }} // namespace lsst::sphgeom
@@ -0,0 +1,101 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains the spatial sort implementation.
+
+#include "lsst/sphgeom/spatialSort.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Pixelization.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "Parallel.h"
+#include "RadixSort.h"
+
+
+namespace lsst {
+namespace sphgeom {
+
+namespace {
+
+// Points are indexed by threads in blocks of this size.
+constexpr size_t INDEX_BLOCK_SIZE = 16384;
+
+struct Entry {
+    uint64_t index;
+    size_t position;
+};
+
+} // unnamed namespace
+
+std::vector<size_t> spatialSort(Pixelization const & pixelization,
+                                double const * x,
+                                double const * y,
+                                double const * z,
+                                size_t n,
+                                unsigned numThreads)
+{
+    std::vector<Entry> entries(n);
+    detail::forEachBlock(n, INDEX_BLOCK_SIZE, numThreads,
+                         [&](size_t begin, size_t end) {
+        static constexpr size_t CHUNK_SIZE = 1024;
+        uint64_t indexes[CHUNK_SIZE];
+        for (size_t b = begin; b < end; b += CHUNK_SIZE) {
+            size_t const m = std::min(CHUNK_SIZE, end - b);
+            pixelization.index(x + b, y + b, z + b, indexes, m);
+            for (size_t i = 0; i < m; ++i) {
+                entries[b + i] = Entry{indexes[i], b + i};
+            }
+        }
+    });
+    detail::radixSort(entries, [](Entry const & e) { return e.index; },
+                      numThreads);
+    std::vector<size_t> permutation(n);
+    for (size_t i = 0; i < n; ++i) {
+        permutation[i] = entries[i].position;
+    }
+    return permutation;
+}
+
+std::vector<size_t> spatialSort(double const * x,
+                                double const * y,
+                                double const * z,
+                                size_t n,
+                                int level,
+                                unsigned numThreads)
+{
+    return spatialSort(Mq3cPixelization(level), x, y, z, n, numThreads);
+}
+
+std::vector<size_t> spatialSort(UnitVector3dArray const & points,
+                                int level,
+                                unsigned numThreads)
+{
+    return spatialSort(points.x(), points.y(), points.z(), points.size(),
+                       level, numThreads);
+}
+
+}} // namespace lsst::sphgeom
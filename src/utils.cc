@@ -25,14 +25,146 @@
 
 #include "lsst/sphgeom/utils.h"
 
+#include <algorithm>
 #include <cmath>
 
+#include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "CpuDispatch.h"
+
+// The AVX2 kernels below are compiled with function level target
+// attributes and selected at run time. They do not use FMA, so that their
+// results are identical to those of the scalar code.
+#if !defined(NO_SIMD) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+    #include <x86intrin.h>
+    #define LSST_SPHGEOM_UTILS_AVX2 1
+#endif
 
 
 namespace lsst {
 namespace sphgeom {
 
+namespace {
+
+// The number of points of the second argument of `findPairsWithin` that are
+// processed together. The components of a block occupy 24 KiB, so a block
+// stays in the L1 or L2 cache while all points of the first argument are
+// compared against it.
+constexpr size_t BLOCK_SIZE = 1024;
+
+inline double squaredChordLength(double vx, double vy, double vz,
+                                 double px, double py, double pz)
+{
+    double dx = vx - px;
+    double dy = vy - py;
+    double dz = vz - pz;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+// `separation` mirrors Circle::openingAngleFor.
+inline double separation(double squaredChordLength) {
+    if (squaredChordLength >= 4.0) {
+        return PI;
+    }
+    return 2.0 * std::asin(0.5 * std::sqrt(squaredChordLength));
+}
+
+#if defined(LSST_SPHGEOM_UTILS_AVX2)
+
+    __attribute__((target("avx2")))
+    inline __m256d squaredChordLengthAvx2(__m256d vx, __m256d vy, __m256d vz,
+                                          double const * px,
+                                          double const * py,
+                                          double const * pz)
+    {
+        __m256d dx = _mm256_sub_pd(vx, _mm256_loadu_pd(px));
+        __m256d dy = _mm256_sub_pd(vy, _mm256_loadu_pd(py));
+        __m256d dz = _mm256_sub_pd(vz, _mm256_loadu_pd(pz));
+        return _mm256_add_pd(
+            _mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)),
+            _mm256_mul_pd(dz, dz));
+    }
+
+    // `squaredChordLengthsAvx2` computes the squared chord lengths between v
+    // and the points p[j], j ∈ [0, n & ~3), and returns the number of points
+    // processed.
+    __attribute__((target("avx2")))
+    size_t squaredChordLengthsAvx2(double vx, double vy, double vz,
+                                   double const * px,
+                                   double const * py,
+                                   double const * pz,
+                                   double * out,
+                                   size_t n)
+    {
+        __m256d x = _mm256_set1_pd(vx);
+        __m256d y = _mm256_set1_pd(vy);
+        __m256d z = _mm256_set1_pd(vz);
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            _mm256_storeu_pd(out + j, squaredChordLengthAvx2(
+                x, y, z, px + j, py + j, pz + j));
+        }
+        return j;
+    }
+
+    // `findWithinAvx2` appends (i, j) to pairs for the points p[j],
+    // j ∈ [0, n & ~3), within squared chord length d2 of v, and returns the
+    // number of points processed.
+    __attribute__((target("avx2")))
+    size_t findWithinAvx2(double vx, double vy, double vz,
+                          double const * px,
+                          double const * py,
+                          double const * pz,
+                          size_t n,
+                          double d2,
+                          size_t i,
+                          size_t offset,
+                          std::vector<std::pair<size_t, size_t>> & pairs)
+    {
+        __m256d x = _mm256_set1_pd(vx);
+        __m256d y = _mm256_set1_pd(vy);
+        __m256d z = _mm256_set1_pd(vz);
+        __m256d r = _mm256_set1_pd(d2);
+        size_t j = 0;
+        for (; j + 4 <= n; j += 4) {
+            __m256d d = squaredChordLengthAvx2(x, y, z, px + j, py + j, pz + j);
+            int mask = _mm256_movemask_pd(_mm256_cmp_pd(d, r, _CMP_LE_OQ));
+            while (mask != 0) {
+                int k = __builtin_ctz(mask);
+                pairs.emplace_back(i, offset + j + k);
+                mask &= mask - 1;
+            }
+        }
+        return j;
+    }
+
+#endif
+
+// `squaredChordLengths` computes the squared chord lengths between v and
+// the n points p[j].
+void squaredChordLengths(double vx, double vy, double vz,
+                         double const * px,
+                         double const * py,
+                         double const * pz,
+                         double * out,
+                         size_t n)
+{
+    size_t j = 0;
+#if defined(LSST_SPHGEOM_UTILS_AVX2)
+    if (detail::hasAvx2()) {
+        j = squaredChordLengthsAvx2(vx, vy, vz, px, py, pz, out, n);
+    }
+#endif
+    for (; j < n; ++j) {
+        out[j] = squaredChordLength(vx, vy, vz, px[j], py[j], pz[j]);
+    }
+}
+
+} // unnamed namespace
+
 double getMinSquaredChordLength(Vector3d const & v,
                                 Vector3d const & a,
                                 Vector3d const & b,
@@ -103,4 +235,78 @@ Vector3d getWeightedCentroid(UnitVector3d const & v0,
     return 0.5 * (x01 * a2 + x12 * a0 + x20 * a1);
 }
 
+void getSquaredChordLengths(UnitVector3d const & v,
+                            UnitVector3dArray const & b,
+                            double * out)
+{
+    squaredChordLengths(v.x(), v.y(), v.z(), b.x(), b.y(), b.z(),
+                        out, b.size());
+}
+
+void getSquaredChordLengths(UnitVector3dArray const & a,
+                            UnitVector3dArray const & b,
+                            double * out)
+{
+    size_t const m = b.size();
+    for (size_t i = 0; i < a.size(); ++i, out += m) {
+        squaredChordLengths(a.x()[i], a.y()[i], a.z()[i],
+                            b.x(), b.y(), b.z(), out, m);
+    }
+}
+
+void getAngularSeparations(UnitVector3d const & v,
+                           UnitVector3dArray const & b,
+                           double * out)
+{
+    getSquaredChordLengths(v, b, out);
+    std::transform(out, out + b.size(), out, separation);
+}
+
+void getAngularSeparations(UnitVector3dArray const & a,
+                           UnitVector3dArray const & b,
+                           double * out)
+{
+    getSquaredChordLengths(a, b, out);
+    std::transform(out, out + a.size() * b.size(), out, separation);
+}
+
+void findPairsWithin(UnitVector3dArray const & a,
+                     UnitVector3dArray const & b,
+                     Angle radius,
+                     std::vector<std::pair<size_t, size_t>> & pairs)
+{
+    double d2 = Circle::squaredChordLengthFor(radius);
+    if (d2 >= 4.0) {
+        // Full circles contain every point, including those with squared
+        // chord lengths that exceed 4 because of rounding.
+        d2 = HUGE_VAL;
+    }
+#if defined(LSST_SPHGEOM_UTILS_AVX2)
+    bool const avx2 = detail::hasAvx2();
+#endif
+    for (size_t begin = 0; begin < b.size(); begin += BLOCK_SIZE) {
+        size_t const n = std::min(BLOCK_SIZE, b.size() - begin);
+        double const * px = b.x() + begin;
+        double const * py = b.y() + begin;
+        double const * pz = b.z() + begin;
+        for (size_t i = 0; i < a.size(); ++i) {
+            double vx = a.x()[i];
+            double vy = a.y()[i];
+            double vz = a.z()[i];
+            size_t j = 0;
+#if defined(LSST_SPHGEOM_UTILS_AVX2)
+            if (avx2) {
+                j = findWithinAvx2(vx, vy, vz, px, py, pz, n, d2,
+                                   i, begin, pairs);
+            }
+#endif
+            for (; j < n; ++j) {
+                if (squaredChordLength(vx, vy, vz, px[j], py[j], pz[j]) <= d2) {
+                    pairs.emplace_back(i, begin + j);
+                }
+            }
+        }
+    }
+}
+
 }} // namespace lsst::sphgeom
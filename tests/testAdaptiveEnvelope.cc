@@ -0,0 +1,161 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for adaptive envelope and interior
+///        computation.
+
+#include <memory>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/TraversalStats.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+std::vector<std::unique_ptr<Pixelization>> makePixelizations(int level) {
+    std::vector<std::unique_ptr<Pixelization>> p;
+    p.emplace_back(new HtmPixelization(level));
+    p.emplace_back(new Q3cPixelization(level));
+    p.emplace_back(new Q3cPixelization(level, true));
+    p.emplace_back(new Mq3cPixelization(level));
+    p.emplace_back(new HealpixPixelization(level));
+    return p;
+}
+
+std::vector<std::unique_ptr<Region>> makeRegions() {
+    std::vector<std::unique_ptr<Region>> r;
+    UnitVector3d c(1.0, -2.0, 3.0);
+    r.emplace_back(new Circle(c, Angle(0.1)));
+    r.emplace_back(new Box(LonLat(c), Angle(0.2), Angle(0.05)));
+    r.emplace_back(new Ellipse(c, Angle(0.1), Angle(0.03), Angle(1.0)));
+    r.emplace_back(new ConvexPolygon(std::vector<UnitVector3d>{
+        UnitVector3d(1, 0, 0), UnitVector3d(1, 0.1, 0),
+        UnitVector3d(1, 0.05, 0.08)}));
+    std::vector<std::unique_ptr<Region>> operands;
+    operands.emplace_back(new Circle(c, Angle(0.05)));
+    operands.emplace_back(new Circle(UnitVector3d(-1, 1, 1), Angle(0.02)));
+    r.emplace_back(new UnionRegion(std::move(operands)));
+    return r;
+}
+
+TEST_CASE(Unbounded) {
+    // Without a range target or area budget, the adaptive traversal
+    // refines every boundary pixel down to the target level.
+    for (auto const & p: makePixelizations(9)) {
+        for (auto const & r: makeRegions()) {
+            CHECK(p->adaptiveEnvelope(*r, 0) == p->envelope(*r));
+            CHECK(p->adaptiveInterior(*r, 0) == p->interior(*r));
+        }
+    }
+}
+
+TEST_CASE(TargetRanges) {
+    for (auto const & p: makePixelizations(14)) {
+        for (auto const & r: makeRegions()) {
+            RangeSet exactEnvelope = p->envelope(*r);
+            RangeSet exactInterior = p->interior(*r);
+            for (size_t target: {4, 16, 64}) {
+                RangeSet e = p->adaptiveEnvelope(*r, target);
+                RangeSet i = p->adaptiveInterior(*r, target);
+                CHECK(e.size() <= target);
+                CHECK(i.size() <= target);
+                CHECK(e.contains(exactEnvelope));
+                CHECK(exactInterior.contains(i));
+                CHECK(p->universe().contains(e));
+            }
+        }
+    }
+}
+
+TEST_CASE(AreaBudget) {
+    Mq3cPixelization p(16);
+    Circle c(UnitVector3d(1.0, -2.0, 3.0), Angle(0.1));
+    RangeSet exact = p.envelope(c);
+    uint64_t previous = 0;
+    // A smaller budget yields a tighter cover.
+    for (double budget: {1.0e-2, 1.0e-3, 1.0e-4, 1.0e-5}) {
+        RangeSet e = p.adaptiveEnvelope(c, 0, budget);
+        CHECK(e.contains(exact));
+        uint64_t excess = e.cardinality() - exact.cardinality();
+        if (previous != 0) {
+            CHECK(excess < previous);
+        }
+        previous = excess;
+        // Level 16 pixels have a nominal area of 2π/3 × 4⁻¹⁶ sr.
+        double pixelArea = (2.0 / 3.0) * PI * std::ldexp(1.0, -32);
+        CHECK(excess * pixelArea <= 1.6 * budget);
+        RangeSet i = p.adaptiveInterior(c, 0, budget);
+        CHECK(p.interior(c).contains(i));
+    }
+    // A budget exceeding the area of the root pixel intersecting the
+    // circle yields that pixel.
+    RangeSet e = p.adaptiveEnvelope(c, 0, 4.0 * PI);
+    CHECK(e.size() == 1);
+    CHECK(e.cardinality() == uint64_t(1) << 32);
+    CHECK(p.adaptiveInterior(c, 0, 4.0 * PI).empty());
+}
+
+TEST_CASE(Coarse) {
+    Circle c(UnitVector3d(1.0, -2.0, 3.0), Angle(0.1));
+    for (auto const & p: makePixelizations(0)) {
+        CHECK(p->adaptiveEnvelope(c, 2) == p->envelope(c));
+    }
+    // A target below the number of intersecting root pixels falls back to
+    // coarsening.
+    HtmPixelization htm(10);
+    Circle big(UnitVector3d(1.0, 1.0, 1.0), Angle(1.0));
+    CHECK(htm.adaptiveEnvelope(big, 1) == htm.envelope(big, 1));
+    CHECK(htm.adaptiveInterior(big, 1) == htm.interior(big, 1));
+}
+
+TEST_CASE(Stats) {
+    if (!TraversalStats::ENABLED) {
+        return;
+    }
+    HtmPixelization p(20);
+    Circle c(UnitVector3d(1.0, -2.0, 3.0), Angle(0.1));
+    TraversalStats adaptive, coarsened;
+    {
+        TraversalStatsScope scope(adaptive);
+        p.adaptiveEnvelope(c, 32);
+    }
+    {
+        TraversalStatsScope scope(coarsened);
+        p.envelope(c, 32);
+    }
+    CHECK(adaptive.nodesVisited[0] == 8);
+    CHECK(adaptive.finalLevel < 20);
+    // The adaptive traversal never descends as deeply as the one that
+    // starts at the target level and coarsens.
+    CHECK(adaptive.relates() < coarsened.relates());
+}
@@ -0,0 +1,198 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for area computations.
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/area.h"
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+bool near(double x, double y, double tolerance) {
+    return std::fabs(x - y) <= tolerance;
+}
+
+ConvexPolygon octant() {
+    return ConvexPolygon(UnitVector3d::X(), UnitVector3d::Y(),
+                         UnitVector3d::Z());
+}
+
+// `cubeFaces` returns the 6 faces of the cube [-1,1]³, centrally projected
+// onto the unit sphere. They partition the sphere.
+std::vector<ConvexPolygon> cubeFaces() {
+    std::vector<ConvexPolygon> faces;
+    for (int axis = 0; axis < 3; ++axis) {
+        for (double sign: {-1.0, 1.0}) {
+            std::vector<UnitVector3d> corners;
+            for (double u: {-1.0, 1.0}) {
+                for (double v: {-1.0, 1.0}) {
+                    double c[3];
+                    c[axis] = sign;
+                    c[(axis + 1) % 3] = u;
+                    c[(axis + 2) % 3] = v;
+                    corners.push_back(UnitVector3d(c[0], c[1], c[2]));
+                }
+            }
+            faces.push_back(ConvexPolygon::convexHull(corners));
+        }
+    }
+    return faces;
+}
+
+} // unnamed namespace
+
+TEST_CASE(PolygonArea) {
+    CHECK(near(octant().getArea(), 0.5 * PI, 1.0e-15));
+    for (ConvexPolygon const & f: cubeFaces()) {
+        CHECK(near(f.getArea(), 4.0 * PI / 6.0, 1.0e-14));
+    }
+    // A tiny right triangle is nearly planar.
+    double const e = 1.0e-6;
+    ConvexPolygon t(UnitVector3d::X(),
+                    UnitVector3d(1.0, e, 0.0),
+                    UnitVector3d(1.0, 0.0, e));
+    CHECK(near(t.getArea(), 0.5 * e * e, 1.0e-12 * e * e));
+}
+
+TEST_CASE(EllipseArea) {
+    CHECK(Ellipse::empty().getArea() == 0.0);
+    CHECK(Ellipse::full().getArea() == 4.0 * PI);
+    for (double r: {1.0e-6, 0.01, 0.5, 1.5, 0.5 * PI, 2.0, 3.0}) {
+        Circle const c(UnitVector3d::Y(), Angle(r));
+        Ellipse const e(c);
+        // The semi-axis lengths of an ellipse are stored as offsets from
+        // π/2, which limits the relative accuracy for tiny ellipses.
+        CHECK(near(e.getArea(), c.getArea(), 1.0e-10 * c.getArea()));
+        CHECK(near(e.getArea() + e.complemented().getArea(), 4.0 * PI,
+                   1.0e-13));
+    }
+    // A small ellipse is nearly planar.
+    Ellipse const small(UnitVector3d::X(), Angle(2.0e-4), Angle(3.0e-5),
+                        Angle(0.3));
+    CHECK(near(small.getArea(), PI * 2.0e-4 * 3.0e-5,
+               1.0e-7 * PI * 2.0e-4 * 3.0e-5));
+    // Check an elongated ellipse against a brute force sum over a
+    // latitude-longitude grid containing it.
+    Ellipse const e(UnitVector3d::X(), Angle(0.9), Angle(0.2), Angle(0.0));
+    CHECK(near(e.getArea() + e.complemented().getArea(), 4.0 * PI, 1.0e-13));
+    int const n = 1500;
+    double const h = 2.0 / n;
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+        double const lat = (i + 0.5) * h - 1.0;
+        for (int j = 0; j < n; ++j) {
+            double const lon = (j + 0.5) * h - 1.0;
+            if (e.contains(UnitVector3d(LonLat::fromRadians(lon, lat)))) {
+                sum += std::cos(lat);
+            }
+        }
+    }
+    sum *= h * h;
+    CHECK(near(e.getArea(), sum, 1.0e-3 * sum));
+}
+
+TEST_CASE(PolygonOverlap) {
+    ConvexPolygon const p = octant();
+    CHECK(near(overlapArea(p, p), p.getArea(), 1.0e-14));
+    double sum = 0.0;
+    for (ConvexPolygon const & f: cubeFaces()) {
+        sum += overlapArea(p, f);
+    }
+    CHECK(near(sum, p.getArea(), 1.0e-14));
+    ConvexPolygon const q(UnitVector3d(1.0, -1.0, -1.0),
+                          UnitVector3d(-1.0, -1.0, -1.0),
+                          UnitVector3d(0.0, 0.0, -1.0));
+    CHECK(overlapArea(p, q) == 0.0);
+    CHECK_THROW(overlapArea(p, Ellipse(UnitVector3d::X(), Angle(0.1))),
+                std::invalid_argument);
+}
+
+TEST_CASE(CircleOverlap) {
+    ConvexPolygon const p = octant();
+    // The intersection of the octant with the cap of points with latitude
+    // at least φ is a quarter of that cap.
+    for (double lat: {-0.5, 0.0, 0.1, 0.7, 1.5}) {
+        Circle const c(UnitVector3d::Z(), Angle(0.5 * PI - lat));
+        double const expected = 0.5 * PI * (1.0 - std::sin(std::max(lat, 0.0)));
+        CHECK(near(overlapArea(p, c), expected, 1.0e-14));
+    }
+    // Circles inside, around and outside the polygon.
+    UnitVector3d const center(1.0, 1.0, 1.0);
+    Circle const inside(center, Angle(0.1));
+    CHECK(near(overlapArea(p, inside), inside.getArea(), 1.0e-15));
+    CHECK(near(overlapArea(p, Circle(center, Angle(1.5))), p.getArea(),
+               1.0e-15));
+    CHECK(overlapArea(p, Circle(-center, Angle(0.5))) == 0.0);
+    CHECK(overlapArea(p, Circle::empty()) == 0.0);
+    CHECK(near(overlapArea(p, Circle::full()), p.getArea(), 1.0e-15));
+    // A circle and its complement split the polygon.
+    for (double r: {0.2, 0.8, 0.5 * PI, 2.0, 2.9}) {
+        for (UnitVector3d const & v: {UnitVector3d(1.0, 0.2, 0.1),
+                                      UnitVector3d(-0.3, 1.0, 0.7),
+                                      UnitVector3d(0.0, 0.0, -1.0)}) {
+            Circle const c(v, Angle(r));
+            double const a = overlapArea(p, c);
+            CHECK(a >= 0.0 && a <= p.getArea() + 1.0e-15);
+            CHECK(near(a + overlapArea(p, c.complemented()), p.getArea(),
+                       1.0e-13));
+        }
+    }
+}
+
+TEST_CASE(BoxOverlap) {
+    ConvexPolygon const p = octant();
+    Box const b = Box::fromRadians(0.1, 0.2, 0.4, 0.5);
+    CHECK(near(overlapArea(p, b), 0.3 * (std::sin(0.5) - std::sin(0.2)),
+               1.0e-15));
+    CHECK(overlapArea(p, Box()) == 0.0);
+    CHECK(near(overlapArea(p, Box::full()), p.getArea(), 1.0e-15));
+    // Boxes that tile the sphere, some of which are wider than π, split any
+    // polygon.
+    ConvexPolygon const q = ConvexPolygon::convexHull({
+        UnitVector3d(1.0, -0.5, 0.8), UnitVector3d(0.3, 1.0, 0.9),
+        UnitVector3d(-1.0, 0.1, 0.6), UnitVector3d(0.2, -1.0, 0.7)});
+    double const lons[] = {0.0, 0.5, 4.5};
+    double const lats[] = {-0.5 * PI, -0.3, 0.4, 0.5 * PI};
+    for (ConvexPolygon const & poly: {p, q}) {
+        double sum = 0.0;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                sum += overlapArea(poly, Box::fromRadians(
+                    lons[i], lats[j], lons[(i + 1) % 3], lats[j + 1]));
+            }
+        }
+        CHECK(near(sum, poly.getArea(), 1.0e-13));
+    }
+}
@@ -0,0 +1,237 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the Arrow region column functions.
+
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/arrow.h"
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+void noRelease(ArrowSchema * s) { s->release = nullptr; }
+void noRelease(ArrowArray * a) { a->release = nullptr; }
+
+// `BinaryColumn` builds an Arrow binary array of encoded regions in which
+// null regions become null rows. The schema and array borrow its storage.
+struct BinaryColumn {
+    std::vector<uint8_t> validity;
+    std::vector<int32_t> offsets;
+    std::vector<uint8_t> data;
+    void const * buffers[3];
+    ArrowSchema schema;
+    ArrowArray array;
+
+    explicit BinaryColumn(std::vector<Region const *> const & regions) {
+        validity.assign((regions.size() + 7) / 8, 0);
+        offsets.push_back(0);
+        int64_t nullCount = 0;
+        for (size_t i = 0; i < regions.size(); ++i) {
+            if (regions[i] != nullptr) {
+                validity[i / 8] |= 1 << (i % 8);
+                std::vector<uint8_t> e = regions[i]->encode();
+                data.insert(data.end(), e.begin(), e.end());
+            } else {
+                ++nullCount;
+            }
+            offsets.push_back(static_cast<int32_t>(data.size()));
+        }
+        buffers[0] = validity.data();
+        buffers[1] = offsets.data();
+        buffers[2] = data.data();
+        std::memset(&schema, 0, sizeof(schema));
+        schema.format = "z";
+        schema.release = &noRelease;
+        std::memset(&array, 0, sizeof(array));
+        array.length = static_cast<int64_t>(regions.size());
+        array.null_count = nullCount;
+        array.n_buffers = 3;
+        array.buffers = buffers;
+        array.release = &noRelease;
+    }
+};
+
+bool bit(void const * bitmap, size_t i) {
+    return (static_cast<uint8_t const *>(bitmap)[i / 8] >> (i % 8)) & 1;
+}
+
+// `Regions` holds one region of each type, and a column of them with nulls.
+struct Regions {
+    Circle circle{UnitVector3d::X(), Angle(0.1)};
+    Box box{Box::fromRadians(-0.05, -0.05, 0.05, 0.05)};
+    Ellipse ellipse{UnitVector3d::Y(), Angle(0.2), Angle(0.1), Angle(0.3)};
+    ConvexPolygon polygon{UnitVector3d(1, 0.1, 0), UnitVector3d(1, 0, 0.1),
+                          UnitVector3d(1, -0.1, -0.1)};
+    std::vector<Region const *> rows{&circle, nullptr, &box, &ellipse,
+                                     &polygon, nullptr, &circle};
+};
+
+} // unnamed namespace
+
+TEST_CASE(InvalidColumns) {
+    Regions r;
+    BinaryColumn c(r.rows);
+    c.schema.format = "u";
+    CHECK_THROW(RegionColumn(c.schema, c.array), std::invalid_argument);
+    c.schema.format = "z";
+    c.array.n_buffers = 2;
+    CHECK_THROW(RegionColumn(c.schema, c.array), std::invalid_argument);
+    c.array.n_buffers = 3;
+    c.array.release = nullptr;
+    CHECK_THROW(RegionColumn(c.schema, c.array), std::invalid_argument);
+    c.array.release = &noRelease;
+    RegionColumn column(c.schema, c.array);
+    CHECK_THROW(column.getEncoded(column.size()), std::out_of_range);
+    // Rows that do not hold encoded regions cannot be decoded.
+    c.data[c.offsets[2]] = 0;
+    CHECK_THROW(column.decode(2), std::runtime_error);
+    CHECK_THROW(relateColumn(column, r.circle), std::runtime_error);
+}
+
+TEST_CASE(Decode) {
+    Regions r;
+    BinaryColumn c(r.rows);
+    RegionColumn column(c.schema, c.array);
+    CHECK(column.size() == r.rows.size());
+    CHECK(column.getNullCount() == 2);
+    DecodedRegion storage;
+    for (size_t i = 0; i < column.size(); ++i) {
+        CHECK(column.isNull(i) == (r.rows[i] == nullptr));
+        std::unique_ptr<Region> d = column.decode(i);
+        Region const * s = column.decode(i, storage);
+        if (r.rows[i] == nullptr) {
+            CHECK(d == nullptr && s == nullptr);
+        } else {
+            CHECK(d->encode() == r.rows[i]->encode());
+            CHECK(s->encode() == r.rows[i]->encode());
+        }
+    }
+    // Slices start at the array offset.
+    c.array.offset = 3;
+    c.array.length = 3;
+    c.array.null_count = -1;
+    RegionColumn slice(c.schema, c.array);
+    CHECK(slice.size() == 3);
+    CHECK(slice.getNullCount() == 1);
+    CHECK(slice.decode(0)->encode() == r.ellipse.encode());
+    CHECK(slice.isNull(2));
+    uint8_t validity = 0;
+    slice.copyValidity(&validity);
+    CHECK(validity == 3);
+}
+
+TEST_CASE(RelateAndContains) {
+    Regions r;
+    BinaryColumn c(r.rows);
+    RegionColumn column(c.schema, c.array);
+    Circle query(UnitVector3d(1, 0.05, 0), Angle(0.02));
+    for (unsigned numThreads: {1u, 4u}) {
+        ArrowColumn relations = relateColumn(column, query, numThreads);
+        ArrowColumn contains = containsColumn(column, query.getCenter(), numThreads);
+        CHECK(std::strcmp(relations.getSchema().format, "C") == 0);
+        CHECK(std::strcmp(contains.getSchema().format, "b") == 0);
+        ArrowArray const & a = relations.getArray();
+        ArrowArray const & b = contains.getArray();
+        CHECK(a.length == 7 && a.null_count == 2 && a.n_buffers == 2);
+        CHECK(b.length == 7 && b.null_count == 2 && b.n_buffers == 2);
+        for (size_t i = 0; i < r.rows.size(); ++i) {
+            CHECK(bit(a.buffers[0], i) == (r.rows[i] != nullptr));
+            CHECK(bit(b.buffers[0], i) == (r.rows[i] != nullptr));
+            if (r.rows[i] != nullptr) {
+                uint8_t rel = static_cast<uint8_t const *>(a.buffers[1])[i];
+                CHECK(rel == r.rows[i]->relate(query).to_ulong());
+                CHECK(bit(b.buffers[1], i) == r.rows[i]->contains(query.getCenter()));
+            }
+        }
+    }
+}
+
+TEST_CASE(Envelope) {
+    Regions r;
+    BinaryColumn c(r.rows);
+    RegionColumn column(c.schema, c.array);
+    HtmPixelization pixelization(8);
+    ArrowColumn envelopes = envelopeColumn(column, pixelization, 0, 2);
+    ArrowSchema const & schema = envelopes.getSchema();
+    CHECK(std::strcmp(schema.format, "+L") == 0);
+    CHECK(schema.n_children == 1);
+    CHECK(std::strcmp(schema.children[0]->format, "+w:2") == 0);
+    CHECK(std::strcmp(schema.children[0]->children[0]->format, "L") == 0);
+    ArrowArray const & a = envelopes.getArray();
+    CHECK(a.length == 7 && a.null_count == 2 && a.n_children == 1);
+    int64_t const * offsets = static_cast<int64_t const *>(a.buffers[1]);
+    ArrowArray const & ranges = *a.children[0];
+    ArrowArray const & values = *ranges.children[0];
+    CHECK(ranges.length == offsets[7]);
+    CHECK(values.length == 2 * offsets[7]);
+    uint64_t const * bounds = static_cast<uint64_t const *>(values.buffers[1]);
+    for (size_t i = 0; i < r.rows.size(); ++i) {
+        CHECK(bit(a.buffers[0], i) == (r.rows[i] != nullptr));
+        RangeSet s;
+        for (int64_t j = offsets[i]; j < offsets[i + 1]; ++j) {
+            s.insert(bounds[2 * j], bounds[2 * j + 1]);
+        }
+        if (r.rows[i] == nullptr) {
+            CHECK(s.empty());
+        } else {
+            CHECK(s == pixelization.envelope(*r.rows[i]));
+        }
+    }
+}
+
+TEST_CASE(Export) {
+    Regions r;
+    BinaryColumn c(r.rows);
+    RegionColumn column(c.schema, c.array);
+    ArrowColumn result = relateColumn(column, r.box);
+    CHECK(!result.empty());
+    ArrowColumn moved(std::move(result));
+    CHECK(result.empty() && !moved.empty());
+    ArrowSchema schema;
+    ArrowArray array;
+    moved.exportTo(&schema, &array);
+    CHECK(moved.empty());
+    CHECK_THROW(moved.exportTo(&schema, &array), std::runtime_error);
+    CHECK(array.length == 7 && array.release != nullptr);
+    schema.release(&schema);
+    array.release(&array);
+    CHECK(schema.release == nullptr && array.release == nullptr);
+    // Large binary arrays have 64 bit offsets.
+    std::vector<int64_t> offsets(c.offsets.begin(), c.offsets.end());
+    c.buffers[1] = offsets.data();
+    c.schema.format = "Z";
+    RegionColumn large(c.schema, c.array);
+    CHECK(large.decode(4)->encode() == r.polygon.encode());
+}
@@ -24,6 +24,8 @@
 /// \brief This file contains tests for the Box class.
 
 #include <memory>
+#include <random>
+#include <vector>
 
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
@@ -404,3 +406,53 @@ TEST_CASE(Codec) {
     CHECK(dynamic_cast<Box *>(r.get()) != nullptr);
     CHECK(*dynamic_cast<Box *>(r.get()) == b);
 }
+
+TEST_CASE(BatchContains) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    Box boxes[] = {
+        Box::fromDegrees(10, 20, 30, 40),
+        Box::fromDegrees(350, -10, 10, 10),
+        Box::fromDegrees(100, -80, 350, 60),
+        Box::fromDegrees(0, 85, 360, 90),
+        Box(LonLat::fromDegrees(45, 45)),
+        Box::full(),
+        Box()
+    };
+    for (Box const & b : boxes) {
+        std::vector<double> x, y, z;
+        auto add = [&](Vector3d const & v) {
+            x.push_back(v.x());
+            y.push_back(v.y());
+            z.push_back(v.z());
+        };
+        // Points on the box boundary are the hard cases.
+        if (!b.isEmpty()) {
+            for (double lon : {b.getLon().getA().asRadians(),
+                               b.getLon().getB().asRadians(),
+                               b.getLon().getCenter().asRadians()}) {
+                for (double lat : {b.getLat().getA().asRadians(),
+                                   b.getLat().getB().asRadians(),
+                                   b.getLat().getCenter().asRadians()}) {
+                    add(UnitVector3d(LonLat::fromRadians(lon, lat)));
+                }
+            }
+        }
+        for (int i = 0; i < 1001; ++i) {
+            double const scales[] = {1.0, 7.5, 1.0e-120, 1.0e120};
+            add(scales[i % 4] * Vector3d(u(rng), u(rng), u(rng)));
+        }
+        size_t const n = x.size();
+        std::unique_ptr<bool[]> out(new bool[n]);
+        b.contains(x.data(), y.data(), z.data(), out.get(), n);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(out[i] == b.contains(UnitVector3d(x[i], y[i], z[i])));
+        }
+        std::unique_ptr<bool[]> threaded(new bool[n]);
+        b.contains(x.data(), y.data(), z.data(), threaded.get(), n, 3);
+        CHECK(std::equal(out.get(), out.get() + n, threaded.get()));
+    }
+    double x = 0.0;
+    bool out;
+    CHECK_THROW(Box::full().contains(&x, &x, &x, &out, 1), std::runtime_error);
+}
@@ -0,0 +1,145 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the box and region joins.
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "lsst/sphgeom/boxJoin.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/Region.h"
+#include "lsst/sphgeom/Relationship.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+
+// `randomBoxes` returns n boxes with random centers in [0, 1]³ and random
+// half-widths of at most `maxWidth`. Every tenth box is empty.
+std::vector<Box3d> randomBoxes(std::mt19937 & rng, size_t n, double maxWidth) {
+    std::uniform_real_distribution<double> center(0.0, 1.0);
+    std::uniform_real_distribution<double> width(0.0, maxWidth);
+    std::vector<Box3d> boxes;
+    for (size_t i = 0; i < n; ++i) {
+        if (i % 10 == 9) {
+            boxes.push_back(Box3d());
+            continue;
+        }
+        Vector3d c(center(rng), center(rng), center(rng));
+        boxes.push_back(Box3d(c, width(rng), width(rng), width(rng)));
+    }
+    return boxes;
+}
+
+Pairs bruteForceJoin(std::vector<Box3d> const & a,
+                     std::vector<Box3d> const & b,
+                     bool self)
+{
+    Pairs pairs;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = self ? i + 1 : 0; j < b.size(); ++j) {
+            if (a[i].intersects(b[j])) {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+TEST_CASE(SelfJoin) {
+    std::mt19937 rng(1);
+    for (double maxWidth: {0.0, 0.01, 0.05, 0.3}) {
+        std::vector<Box3d> boxes = randomBoxes(rng, 700, maxWidth);
+        Pairs expected = bruteForceJoin(boxes, boxes, true);
+        CHECK(boxJoin(boxes) == expected);
+        CHECK(boxJoin(boxes, 4) == expected);
+    }
+    CHECK(boxJoin(std::vector<Box3d>()).empty());
+}
+
+TEST_CASE(SelfJoinSharedBounds) {
+    // Boxes that touch, or share x lower bounds, must all be found.
+    std::vector<Box3d> boxes;
+    for (int i = 0; i < 5; ++i) {
+        boxes.push_back(Box3d(Interval1d(0.0, 1.0), Interval1d(i, i + 1),
+                              Interval1d(0.0, 0.0)));
+    }
+    boxes.push_back(Box3d(Interval1d(1.0, 2.0), Interval1d(0.0, 5.0),
+                          Interval1d(0.0, 1.0)));
+    CHECK(boxJoin(boxes) == bruteForceJoin(boxes, boxes, true));
+    CHECK(boxJoin(boxes).size() == 9);
+}
+
+TEST_CASE(BipartiteJoin) {
+    std::mt19937 rng(2);
+    for (double maxWidth: {0.0, 0.01, 0.05, 0.3}) {
+        std::vector<Box3d> a = randomBoxes(rng, 600, maxWidth);
+        std::vector<Box3d> b = randomBoxes(rng, 400, maxWidth);
+        Pairs expected = bruteForceJoin(a, b, false);
+        CHECK(boxJoin(a, b) == expected);
+        CHECK(boxJoin(a, b, 3) == expected);
+        CHECK(boxJoin(a, a, 2) == bruteForceJoin(a, a, false));
+    }
+    std::vector<Box3d> a = randomBoxes(rng, 10, 0.1);
+    CHECK(boxJoin(a, std::vector<Box3d>()).empty());
+    CHECK(boxJoin(std::vector<Box3d>(), a).empty());
+}
+
+TEST_CASE(RegionJoin) {
+    std::mt19937 rng(3);
+    std::normal_distribution<double> normal;
+    std::uniform_real_distribution<double> radius(0.0, 0.1);
+    std::vector<std::unique_ptr<Region>> a, b;
+    for (int i = 0; i < 300; ++i) {
+        UnitVector3d c(normal(rng), normal(rng), normal(rng));
+        auto circle = std::unique_ptr<Region>(
+            new Circle(c, Angle(radius(rng))));
+        (i % 3 == 0 ? b : a).push_back(std::move(circle));
+    }
+    Pairs self = regionJoin(a, 2);
+    Pairs expected;
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = i + 1; j < a.size(); ++j) {
+            if ((a[i]->relate(*a[j]) & DISJOINT) == 0) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+    CHECK(!expected.empty());
+    CHECK(self == expected);
+    Pairs bipartite = regionJoin(a, b);
+    expected.clear();
+    for (size_t i = 0; i < a.size(); ++i) {
+        for (size_t j = 0; j < b.size(); ++j) {
+            if ((a[i]->relate(*b[j]) & DISJOINT) == 0) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+    CHECK(!expected.empty());
+    CHECK(bipartite == expected);
+}
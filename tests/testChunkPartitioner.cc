@@ -0,0 +1,237 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the ChunkPartitioner class.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/ChunkPartitioner.h"
+#include "lsst/sphgeom/Chunker.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+// A row is identified by its chunk, sub-chunk, overlap flag and payload.
+using Row = std::tuple<int32_t, int32_t, int, std::string>;
+
+// `CollectingSink` records the rows it receives, and checks that buffers
+// are bounded and that no chunk is written by two threads at once.
+struct CollectingSink : ChunkSink {
+    size_t maxRowBytes = std::numeric_limits<size_t>::max();
+    size_t maxBytes = 0;
+    size_t numWrites = 0;
+    bool concurrent = false;
+    std::vector<Row> rows;
+    std::map<int32_t, int> active;
+    std::mutex mutex;
+
+    void write(int32_t chunkId, ChunkRows const & r) override {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (active[chunkId]++ != 0) {
+                concurrent = true;
+            }
+            maxBytes = std::max(maxBytes, r.bytes());
+            ++numWrites;
+        }
+        std::vector<Row> out;
+        for (size_t i = 0; i < r.size(); ++i) {
+            out.emplace_back(
+                chunkId, r.subChunkId[i], r.isOverlap[i],
+                std::string(r.payload.begin() + r.offsets[i],
+                            r.payload.begin() + r.offsets[i + 1]));
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        --active[chunkId];
+        rows.insert(rows.end(), out.begin(), out.end());
+    }
+};
+
+struct ThrowingSink : ChunkSink {
+    void write(int32_t, ChunkRows const &) override {
+        throw std::runtime_error("sink failure");
+    }
+};
+
+// `makeBatch` returns a batch of n random rows, with payloads recording
+// the row number so that rows with the same position are distinct.
+CatalogBatch makeBatch(std::mt19937 & rng, size_t first, size_t n) {
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    CatalogBatch batch;
+    for (size_t i = first; i < first + n; ++i) {
+        std::string data = "row " + std::to_string(i);
+        batch.push_back((u(rng) + 1.0) * PI, std::asin(u(rng)),
+                        reinterpret_cast<uint8_t const *>(data.data()),
+                        data.size());
+    }
+    return batch;
+}
+
+std::vector<Row> expectedRows(Chunker const & chunker, Angle overlap,
+                              std::vector<CatalogBatch> const & batches) {
+    std::vector<Row> rows;
+    for (CatalogBatch const & b: batches) {
+        ChunkLocations out;
+        chunker.locateWithOverlap(b.lon.data(), b.lat.data(), b.size(),
+                                  overlap, out);
+        for (size_t i = 0; i < out.size(); ++i) {
+            size_t p = out.pointIndex[i];
+            rows.emplace_back(
+                out.chunkId[i], out.subChunkId[i], out.isOverlap[i],
+                std::string(b.payload.begin() + b.offsets[p],
+                            b.payload.begin() + b.offsets[p + 1]));
+        }
+    }
+    std::sort(rows.begin(), rows.end());
+    return rows;
+}
+
+} // unnamed namespace
+
+TEST_CASE(Construction) {
+    CollectingSink sink;
+    Chunker chunker(20, 4);
+    CHECK_THROW(ChunkPartitioner(chunker, Angle(-1.0), sink),
+                std::invalid_argument);
+    CHECK_THROW(ChunkPartitioner(chunker, Angle(std::nan("")), sink),
+                std::invalid_argument);
+    ChunkPartitioner p(chunker, Angle::fromDegrees(0.1), sink);
+    CHECK(p.getChunker() == chunker);
+    CHECK(p.getOverlap() == Angle::fromDegrees(0.1));
+    CHECK(p.getNumRows() == 0);
+    p.flush();
+    CHECK(sink.numWrites == 0);
+}
+
+TEST_CASE(Add) {
+    Chunker chunker(20, 4);
+    Angle const overlap = Angle::fromDegrees(1.0);
+    std::mt19937 rng(79);
+    std::vector<CatalogBatch> batches;
+    for (size_t b = 0; b < 8; ++b) {
+        batches.push_back(makeBatch(rng, b * 500, 500));
+    }
+    std::vector<Row> expected = expectedRows(chunker, overlap, batches);
+    for (size_t maxChunkBytes: {size_t(0), size_t(256), size_t(1) << 20}) {
+        CollectingSink sink;
+        ChunkPartitioner p(chunker, overlap, sink, maxChunkBytes);
+        for (CatalogBatch const & b: batches) {
+            p.add(b);
+        }
+        CHECK(p.getNumRows() == 4000);
+        CHECK(p.getNumLocations() == expected.size());
+        size_t numWrites = sink.numWrites;
+        p.flush();
+        p.flush();
+        if (maxChunkBytes == 0) {
+            // Every row is written as soon as it is added.
+            CHECK(numWrites == expected.size());
+            CHECK(sink.numWrites == numWrites);
+        } else {
+            // Buffers never exceed the limit by more than one row.
+            CHECK(sink.maxBytes < maxChunkBytes + 32);
+        }
+        CHECK(!sink.concurrent);
+        std::sort(sink.rows.begin(), sink.rows.end());
+        CHECK(sink.rows == expected);
+    }
+}
+
+TEST_CASE(InvalidRows) {
+    Chunker chunker(20, 4);
+    CollectingSink sink;
+    ChunkPartitioner p(chunker, Angle::fromDegrees(1.0), sink, 0);
+    std::mt19937 rng(3);
+    CatalogBatch batch = makeBatch(rng, 0, 10);
+    batch.lat[7] = 2.0;
+    CHECK_THROW(p.add(batch), std::invalid_argument);
+    batch.lat[7] = 0.0;
+    batch.offsets[5] = 0;
+    CHECK_THROW(p.add(batch), std::invalid_argument);
+    batch.lat.pop_back();
+    CHECK_THROW(p.add(batch), std::invalid_argument);
+    p.flush();
+    CHECK(sink.numWrites == 0);
+    CHECK(p.getNumRows() == 0);
+    ThrowingSink throwingSink;
+    ChunkPartitioner q(chunker, Angle::fromDegrees(1.0), throwingSink, 0);
+    CHECK_THROW(q.add(makeBatch(rng, 0, 10)), std::runtime_error);
+}
+
+TEST_CASE(Run) {
+    Chunker chunker(40, 6);
+    Angle const overlap = Angle::fromDegrees(0.5);
+    std::mt19937 rng(5);
+    std::vector<CatalogBatch> batches;
+    for (size_t b = 0; b < 40; ++b) {
+        batches.push_back(makeBatch(rng, b * 250, 250));
+    }
+    std::vector<Row> expected = expectedRows(chunker, overlap, batches);
+    for (unsigned numThreads: {1u, 2u, 4u}) {
+        CollectingSink sink;
+        ChunkPartitioner p(chunker, overlap, sink, 512);
+        size_t next = 0;
+        p.run([&](CatalogBatch & b) {
+            if (next == batches.size()) {
+                return false;
+            }
+            b = batches[next++];
+            return true;
+        }, numThreads);
+        p.flush();
+        CHECK(p.getNumRows() == 10000);
+        CHECK(!sink.concurrent);
+        std::sort(sink.rows.begin(), sink.rows.end());
+        CHECK(sink.rows == expected);
+        // Errors stop the pipeline and are rethrown.
+        size_t calls = 0;
+        auto failing = [&](CatalogBatch & b) {
+            if (++calls == 3) {
+                throw std::runtime_error("source failure");
+            }
+            b = batches[0];
+            return true;
+        };
+        CHECK_THROW(p.run(failing, numThreads), std::runtime_error);
+        calls = 0;
+        auto invalid = [&](CatalogBatch & b) {
+            b = batches[calls++ % batches.size()];
+            b.lon[0] = std::numeric_limits<double>::infinity();
+            return calls < 1000;
+        };
+        CHECK_THROW(p.run(invalid, numThreads), std::invalid_argument);
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+/// \file
+/// \brief This file contains tests for the ChunkPixelMap class.
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/ChunkPixelMap.h"
+#include "lsst/sphgeom/Chunker.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+// `checkTables` checks the chunk envelopes and interiors of m.
+void checkTables(ChunkPixelMap const & m, Pixelization const & pixelization) {
+    Chunker const & chunker = m.getChunker();
+    REQUIRE(m.getChunkIds() == chunker.getAllChunks());
+    CHECK(m.size() == m.getChunkIds().size());
+    RangeSet interiors;
+    RangeSet envelopes;
+    for (int32_t chunkId: m.getChunkIds()) {
+        int32_t stripe = chunker.getStripe(chunkId);
+        Box box = chunker.getChunkBoundingBox(
+            stripe, chunker.getChunk(chunkId, stripe));
+        CHECK(m.getEnvelope(chunkId) == pixelization.envelope(box));
+        CHECK(m.getInterior(chunkId) == pixelization.interior(box));
+        CHECK(m.getEnvelope(chunkId).contains(m.getInterior(chunkId)));
+        // Chunks do not overlap, so neither do their interiors.
+        CHECK(interiors.isDisjointFrom(m.getInterior(chunkId)));
+        interiors |= m.getInterior(chunkId);
+        envelopes |= m.getEnvelope(chunkId);
+    }
+    CHECK(envelopes == pixelization.universe());
+}
+
+// `checkRegions` checks that chunk selection with m agrees with chunker
+// for random circles.
+void checkRegions(ChunkPixelMap const & m, Pixelization const & pixelization) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> lon(0.0, 360.0);
+    std::uniform_real_distribution<double> lat(-90.0, 90.0);
+    std::uniform_real_distribution<double> radius(0.01, 20.0);
+    Chunker const & chunker = m.getChunker();
+    for (int i = 0; i < 50; ++i) {
+        UnitVector3d center(LonLat::fromDegrees(lon(rng), lat(rng)));
+        Circle c(center, Angle::fromDegrees(radius(rng)));
+        RangeSet envelope = pixelization.envelope(c);
+        RangeSet interior = pixelization.interior(c);
+        std::vector<int32_t> chunkIds = m.getChunksIntersecting(envelope);
+        CHECK(std::is_sorted(chunkIds.begin(), chunkIds.end()));
+        // Every chunk intersecting the circle is selected.
+        std::vector<int32_t> expected = chunker.getChunksIntersecting(c);
+        std::sort(expected.begin(), expected.end());
+        CHECK(std::includes(chunkIds.begin(), chunkIds.end(),
+                            expected.begin(), expected.end()));
+        std::vector<ClassifiedChunk> classified =
+            m.classifyChunks(envelope, interior);
+        REQUIRE(classified.size() == chunkIds.size());
+        for (size_t j = 0; j < classified.size(); ++j) {
+            int32_t chunkId = classified[j].chunkId;
+            CHECK(chunkId == chunkIds[j]);
+            CHECK(!m.getEnvelope(chunkId).isDisjointFrom(envelope));
+            bool contained = interior.contains(m.getEnvelope(chunkId));
+            CHECK(classified[j].relationship ==
+                  (contained ? CONTAINS : INTERSECTS));
+            if (contained) {
+                int32_t stripe = chunker.getStripe(chunkId);
+                Box box = chunker.getChunkBoundingBox(
+                    stripe, chunker.getChunk(chunkId, stripe));
+                CHECK(c.contains(UnitVector3d(box.getCenter())));
+            }
+        }
+        // The chunk containing the circle center is among those
+        // overlapping the pixel containing it.
+        std::vector<int32_t> centerChunks =
+            m.getChunks(pixelization.index(center));
+        int32_t centerChunk = chunker.locate(LonLat(center)).first;
+        CHECK(std::find(centerChunks.begin(), centerChunks.end(),
+                        centerChunk) != centerChunks.end());
+    }
+}
+
+TEST_CASE(HtmTables) {
+    Chunker chunker(18, 3);
+    HtmPixelization pixelization(6);
+    ChunkPixelMap m(chunker, pixelization);
+    checkTables(m, pixelization);
+    checkRegions(m, pixelization);
+}
+
+TEST_CASE(Mq3cTables) {
+    Chunker chunker(18, 3);
+    Mq3cPixelization pixelization(6);
+    ChunkPixelMap m(chunker, pixelization, 2);
+    checkTables(m, pixelization);
+    checkRegions(m, pixelization);
+}
+
+TEST_CASE(ReverseTable) {
+    Chunker chunker(12, 2);
+    HtmPixelization pixelization(5);
+    ChunkPixelMap m(chunker, pixelization);
+    RangeSet universe = pixelization.universe();
+    uint64_t const begin = std::get<0>(*universe.begin());
+    uint64_t const end = std::get<1>(*universe.begin());
+    for (uint64_t pixel = begin; pixel < end; pixel += 7) {
+        std::vector<int32_t> chunkIds = m.getChunks(pixel);
+        CHECK(!chunkIds.empty());
+        CHECK(std::is_sorted(chunkIds.begin(), chunkIds.end()));
+        for (int32_t chunkId: m.getChunkIds()) {
+            bool overlaps = m.getEnvelope(chunkId).contains(pixel);
+            CHECK(overlaps == (std::find(chunkIds.begin(), chunkIds.end(),
+                                         chunkId) != chunkIds.end()));
+            if (m.getInterior(chunkId).contains(pixel)) {
+                CHECK(chunkIds.size() == 1);
+            }
+        }
+        CHECK(m.getChunksIntersecting(RangeSet(pixel)) == chunkIds);
+    }
+    CHECK(m.getChunks(end).empty());
+    CHECK(m.getChunksIntersecting(RangeSet()).empty());
+    CHECK(m.getChunksIntersecting(universe) == m.getChunkIds());
+    CHECK(m.getChunksIntersecting(RangeSet(0, 0)) == m.getChunkIds());
+}
+
+TEST_CASE(InvalidChunkIds) {
+    Chunker chunker(12, 2);
+    HtmPixelization pixelization(3);
+    ChunkPixelMap m(chunker, pixelization);
+    CHECK_THROW(m.getEnvelope(-1), std::invalid_argument);
+    CHECK_THROW(m.getInterior(m.getChunkIds().back() + 1),
+                std::invalid_argument);
+    // Chunk IDs are not contiguous, so IDs between valid ones can be
+    // invalid too.
+    int32_t invalid = m.getChunkIds()[0] + 1;
+    while (chunker.valid(invalid)) {
+        ++invalid;
+    }
+    CHECK_THROW(m.getEnvelope(invalid), std::invalid_argument);
+}
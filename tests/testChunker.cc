@@ -23,8 +23,17 @@
 /// \file
 /// \brief This file contains tests for the Chunker class.
 
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Chunker.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/LonLat.h"
 
 #include "test.h"
 
@@ -67,3 +76,343 @@ TEST_CASE(AllSubChunks) {
     std::vector<int32_t> subChunkIds = chunker.getAllSubChunks(9630);
     CHECK(subChunkIds == expectedSubChunkIds);
 }
+
+void checkSameSubChunks(std::vector<SubChunks> const & a,
+                        std::vector<SubChunks> const & b) {
+    REQUIRE(a.size() == b.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        CHECK(a[i].chunkId == b[i].chunkId);
+        CHECK(a[i].subChunkIds == b[i].subChunkIds);
+    }
+}
+
+TEST_CASE(ParallelSubChunksIntersecting) {
+    Chunker chunker(85, 12);
+    std::vector<UnitVector3d> points = {
+        UnitVector3d(LonLat::fromDegrees(10, -40)),
+        UnitVector3d(LonLat::fromDegrees(80, -35)),
+        UnitVector3d(LonLat::fromDegrees(70, 45)),
+        UnitVector3d(LonLat::fromDegrees(20, 30))
+    };
+    ConvexPolygon poly(points);
+    // Includes a box wrapping around longitude 0 and a region covering
+    // a single stripe, for which no threads are started.
+    Box box1 = Box::fromDegrees(350, -60, 20, 60);
+    Box box2 = Box::fromDegrees(0, 0, 1, 0.5);
+    Region const * regions[] = {&poly, &box1, &box2};
+    for (Region const * r: regions) {
+        std::vector<SubChunks> expected = chunker.getSubChunksIntersecting(*r);
+        CHECK(!expected.empty());
+        for (unsigned numThreads: {2u, 3u, 8u, 1000u}) {
+            checkSameSubChunks(
+                chunker.getSubChunksIntersecting(*r, numThreads), expected);
+        }
+    }
+}
+
+TEST_CASE(ClassifyChunks) {
+    Chunker chunker(85, 12);
+    Circle circle(UnitVector3d(LonLat::fromDegrees(30, 20)),
+                  Angle::fromDegrees(12));
+    Box box = Box::fromDegrees(350, -50, 20, -10);
+    Region const * regions[] = {&circle, &box};
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lon(0.0, 360.0);
+    std::uniform_real_distribution<double> lat(-90.0, 90.0);
+    for (Region const * r: regions) {
+        std::vector<int32_t> ids = chunker.getChunksIntersecting(*r);
+        std::vector<ClassifiedChunk> chunks = chunker.classifyChunks(*r);
+        REQUIRE(chunks.size() == ids.size());
+        std::map<int32_t, Relationship> chunkTags;
+        size_t numContained = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            CHECK(chunks[i].chunkId == ids[i]);
+            CHECK(chunks[i].relationship == CONTAINS ||
+                  chunks[i].relationship == INTERSECTS);
+            int32_t stripe = chunker.getStripe(ids[i]);
+            Box b = chunker.getChunkBoundingBox(
+                stripe, chunker.getChunk(ids[i], stripe));
+            CHECK((chunks[i].relationship == CONTAINS) ==
+                  ((r->relate(b) & CONTAINS) != 0));
+            chunkTags[ids[i]] = chunks[i].relationship;
+            numContained += chunks[i].relationship == CONTAINS;
+        }
+        CHECK(numContained > 0);
+        std::vector<SubChunks> expected = chunker.getSubChunksIntersecting(*r);
+        std::vector<ClassifiedSubChunks> classified =
+            chunker.classifySubChunks(*r);
+        REQUIRE(classified.size() == expected.size());
+        std::map<std::pair<int32_t, int32_t>, Relationship> subChunkTags;
+        for (size_t i = 0; i < classified.size(); ++i) {
+            ClassifiedSubChunks const & c = classified[i];
+            CHECK(c.chunkId == expected[i].chunkId);
+            CHECK(c.relationship == chunkTags[c.chunkId]);
+            CHECK(c.subChunkIds == expected[i].subChunkIds);
+            REQUIRE(c.subChunkRelationships.size() == c.subChunkIds.size());
+            for (size_t j = 0; j < c.subChunkIds.size(); ++j) {
+                if (c.relationship == CONTAINS) {
+                    CHECK(c.subChunkRelationships[j] == CONTAINS);
+                }
+                subChunkTags[std::make_pair(c.chunkId, c.subChunkIds[j])] =
+                    c.subChunkRelationships[j];
+            }
+        }
+        for (unsigned numThreads: {2u, 8u}) {
+            std::vector<ClassifiedSubChunks> p =
+                chunker.classifySubChunks(*r, numThreads);
+            REQUIRE(p.size() == classified.size());
+            for (size_t i = 0; i < p.size(); ++i) {
+                CHECK(p[i].chunkId == classified[i].chunkId);
+                CHECK(p[i].relationship == classified[i].relationship);
+                CHECK(p[i].subChunkIds == classified[i].subChunkIds);
+                CHECK(p[i].subChunkRelationships ==
+                      classified[i].subChunkRelationships);
+            }
+        }
+        // Points in contained chunks and sub-chunks are in the region.
+        for (int i = 0; i < 20000; ++i) {
+            LonLat p = LonLat::fromDegrees(lon(rng), lat(rng));
+            std::pair<int32_t, int32_t> loc = chunker.locate(p);
+            auto c = chunkTags.find(loc.first);
+            if (c != chunkTags.end() && c->second == CONTAINS) {
+                CHECK(r->contains(UnitVector3d(p)));
+            }
+            auto sc = subChunkTags.find(loc);
+            if (sc != subChunkTags.end() && sc->second == CONTAINS) {
+                CHECK(r->contains(UnitVector3d(p)));
+            }
+        }
+    }
+}
+
+TEST_CASE(BoundingBoxTable) {
+    Chunker chunker(85, 12);
+    // Large enough for some, but not all stripes.
+    Chunker tabled(85, 12, 4*1024*1024);
+    Chunker copy(tabled);
+    for (int32_t s = 0; s < chunker.getNumStripes(); ++s) {
+        Chunker::BoxRange expected = chunker.getChunkBoundingBoxes(s);
+        Chunker::BoxRange actual = copy.getChunkBoundingBoxes(s);
+        REQUIRE(expected.size() == actual.size());
+        int32_t c = 0;
+        for (auto i = expected.begin(), j = actual.begin();
+             i != expected.end(); ++i, ++j, ++c) {
+            CHECK(*i == *j);
+            CHECK(*i == chunker.getChunkBoundingBox(s, c));
+            CHECK(*j == tabled.getChunkBoundingBox(s, c));
+        }
+    }
+    int32_t numSubStripes =
+        chunker.getNumStripes() * chunker.getNumSubStripesPerStripe();
+    for (int32_t ss = 0; ss < numSubStripes; ++ss) {
+        Chunker::BoxRange expected = chunker.getSubChunkBoundingBoxes(ss);
+        Chunker::BoxRange actual = tabled.getSubChunkBoundingBoxes(ss);
+        REQUIRE(expected.size() == actual.size());
+        int32_t sc = 0;
+        for (auto i = expected.begin(), j = actual.begin();
+             i != expected.end(); ++i, ++j, ++sc) {
+            CHECK(*i == *j);
+            CHECK(*j == tabled.getSubChunkBoundingBox(ss, sc));
+        }
+    }
+    Box box = Box::fromDegrees(273.6, 30.7, 273.7180105379097, 30.722546655347717);
+    checkSameSubChunks(tabled.getSubChunksIntersecting(box),
+                       chunker.getSubChunksIntersecting(box));
+    CHECK(tabled.getChunksIntersecting(box) ==
+          chunker.getChunksIntersecting(box));
+    CHECK_THROW(chunker.getChunkBoundingBoxes(-1), std::invalid_argument);
+    CHECK_THROW(chunker.getSubChunkBoundingBoxes(numSubStripes),
+                std::invalid_argument);
+}
+
+TEST_CASE(Locate) {
+    Chunker chunker(85, 12);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    size_t const n = 2000;
+    std::vector<double> lon(n);
+    std::vector<double> lat(n);
+    for (size_t i = 0; i < n; ++i) {
+        lon[i] = (u(rng) + 1.0) * PI;
+        lat[i] = std::asin(u(rng));
+    }
+    // Include the poles and points on chunk boundaries.
+    lat[0] = 0.5 * PI;
+    lat[1] = -0.5 * PI;
+    lon[2] = 0.0;
+    lat[2] = 0.0;
+    lon[3] = -PI;
+    std::vector<int32_t> chunkIds(n);
+    std::vector<int32_t> subChunkIds(n);
+    chunker.locate(lon.data(), lat.data(), chunkIds.data(),
+                   subChunkIds.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        LonLat p = LonLat::fromRadians(lon[i], lat[i]);
+        std::pair<int32_t, int32_t> ids = chunker.locate(p);
+        CHECK(ids.first == chunkIds[i]);
+        CHECK(ids.second == subChunkIds[i]);
+        // The located sub-chunk must be one of those intersecting a tiny
+        // circle around the point.
+        Circle c(UnitVector3d(p), Angle(1.0e-9));
+        std::vector<SubChunks> subChunks = chunker.getSubChunksIntersecting(c);
+        bool found = false;
+        for (SubChunks const & sc: subChunks) {
+            if (sc.chunkId == ids.first) {
+                found = std::find(sc.subChunkIds.begin(), sc.subChunkIds.end(),
+                                  ids.second) != sc.subChunkIds.end();
+            }
+        }
+        CHECK(found);
+    }
+    double badLat = 2.0;
+    double goodLon = 0.0;
+    int32_t chunk;
+    int32_t subChunk;
+    CHECK_THROW(chunker.locate(&goodLon, &badLat, &chunk, &subChunk, 1),
+                std::invalid_argument);
+    double badLon = std::numeric_limits<double>::infinity();
+    double goodLat = 0.0;
+    CHECK_THROW(chunker.locate(&badLon, &goodLat, &chunk, &subChunk, 1),
+                std::invalid_argument);
+}
+
+TEST_CASE(LocateWithOverlap) {
+    Chunker chunker(85, 12);
+    int32_t const numSubStripes =
+        chunker.getNumStripes() * chunker.getNumSubStripesPerStripe();
+    double const subStripeHeight = PI / numSubStripes;
+    Angle const overlap = Angle::fromDegrees(1.0 / 60.0);
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    size_t const n = 500;
+    std::vector<double> lon(n);
+    std::vector<double> lat(n);
+    for (size_t i = 0; i < n; ++i) {
+        lon[i] = (u(rng) + 1.0) * PI;
+        lat[i] = std::asin(u(rng));
+    }
+    lat[0] = 0.5 * PI;
+    lat[1] = -0.5 * PI + 1.0e-4;
+    lon[2] = 0.0;
+    lat[2] = 0.0;
+    ChunkLocations out;
+    chunker.locateWithOverlap(lon.data(), lat.data(), n, overlap, out);
+    size_t row = 0;
+    for (size_t i = 0; i < n; ++i) {
+        LonLat p = LonLat::fromRadians(lon[i], lat[i]);
+        // The first row for a point is its home sub-chunk.
+        REQUIRE(row < out.size());
+        CHECK(out.pointIndex[row] == i);
+        CHECK(out.isOverlap[row] == 0);
+        std::pair<int32_t, int32_t> home = chunker.locate(p);
+        CHECK(out.chunkId[row] == home.first);
+        CHECK(out.subChunkId[row] == home.second);
+        ++row;
+        // Count the sub-chunks with dilated bounding boxes containing p.
+        int32_t ss = static_cast<int32_t>((lat[i] + 0.5 * PI) / subStripeHeight);
+        size_t expected = 0;
+        for (int32_t s = std::max(0, ss - 2);
+             s <= std::min(numSubStripes - 1, ss + 2); ++s) {
+            for (Box const & b: chunker.getSubChunkBoundingBoxes(s)) {
+                if (b.dilatedBy(overlap).contains(p)) {
+                    ++expected;
+                }
+            }
+        }
+        std::vector<SubChunks> nearby = chunker.getSubChunksIntersecting(
+            Circle(UnitVector3d(p), 4.0 * overlap));
+        size_t actual = 1;
+        for (; row < out.size() && out.pointIndex[row] == i; ++row, ++actual) {
+            CHECK(out.isOverlap[row] == 1);
+            CHECK(out.chunkId[row] != home.first ||
+                  out.subChunkId[row] != home.second);
+            bool found = false;
+            for (SubChunks const & sc: nearby) {
+                if (sc.chunkId == out.chunkId[row]) {
+                    found = std::find(sc.subChunkIds.begin(),
+                                      sc.subChunkIds.end(),
+                                      out.subChunkId[row]) !=
+                            sc.subChunkIds.end();
+                }
+            }
+            CHECK(found);
+        }
+        CHECK(actual == expected);
+    }
+    CHECK(row == out.size());
+    CHECK_THROW(chunker.locateWithOverlap(lon.data(), lat.data(), n,
+                                          Angle(-1.0), out),
+                std::invalid_argument);
+}
+
+TEST_CASE(NeighborChunks) {
+    Chunker chunker(85, 12);
+    Angle const overlap = Angle::fromDegrees(0.5);
+    std::vector<int32_t> all = chunker.getAllChunks();
+    for (size_t i = 0; i < all.size(); i += 37) {
+        int32_t const chunkId = all[i];
+        int32_t const s = chunker.getStripe(chunkId);
+        Box b = chunker.getChunkBoundingBox(
+            s, chunker.getChunk(chunkId, s)).dilatedBy(overlap);
+        std::vector<int32_t> expected = chunker.getChunksIntersecting(b);
+        expected.erase(std::remove(expected.begin(), expected.end(), chunkId),
+                       expected.end());
+        std::vector<int32_t> neighbors = chunker.getNeighborChunks(chunkId,
+                                                                   overlap);
+        CHECK(neighbors == expected);
+        CHECK(neighbors.size() >= 2);
+        // Pick a sub-chunk of the chunk, and find its bounding box.
+        Box const cb = chunker.getChunkBoundingBox(
+            s, chunker.getChunk(chunkId, s));
+        double const lat = cb.getLat().getA().asRadians() +
+                           0.37 * cb.getLat().getSize().asRadians();
+        double const lon = cb.getLon().getA().asRadians() +
+                           0.29 * cb.getLon().getSize().asRadians();
+        std::pair<int32_t, int32_t> home =
+            chunker.locate(LonLat::fromRadians(lon, lat));
+        REQUIRE(home.first == chunkId);
+        int32_t const ss = static_cast<int32_t>(
+            (lat + 0.5 * PI) / (PI / (85 * 12)));
+        int32_t const m = static_cast<int32_t>(
+            chunker.getSubChunkBoundingBoxes(ss).size());
+        int32_t const sc = static_cast<int32_t>(lon / (2.0 * PI / m));
+        Angle const subOverlap = Angle::fromDegrees(1.0 / 60.0);
+        std::vector<SubChunks> expectedSub = chunker.getSubChunksIntersecting(
+            chunker.getSubChunkBoundingBox(ss, sc).dilatedBy(subOverlap));
+        std::vector<SubChunks> actual = chunker.getNeighborSubChunks(
+            home.first, home.second, subOverlap);
+        size_t count = 0;
+        for (SubChunks & e : expectedSub) {
+            std::sort(e.subChunkIds.begin(), e.subChunkIds.end());
+            if (e.chunkId == home.first) {
+                e.subChunkIds.erase(std::remove(e.subChunkIds.begin(),
+                                                e.subChunkIds.end(),
+                                                home.second),
+                                    e.subChunkIds.end());
+            }
+        }
+        expectedSub.erase(
+            std::remove_if(expectedSub.begin(), expectedSub.end(),
+                           [](SubChunks const & e) {
+                               return e.subChunkIds.empty();
+                           }),
+            expectedSub.end());
+        std::sort(expectedSub.begin(), expectedSub.end(),
+                  [](SubChunks const & a, SubChunks const & b) {
+                      return a.chunkId < b.chunkId;
+                  });
+        REQUIRE(actual.size() == expectedSub.size());
+        for (size_t j = 0; j < actual.size(); ++j) {
+            CHECK(actual[j].chunkId == expectedSub[j].chunkId);
+            CHECK(actual[j].subChunkIds == expectedSub[j].subChunkIds);
+            count += actual[j].subChunkIds.size();
+        }
+        CHECK(count >= 2);
+    }
+    // Out of range IDs and overlaps are rejected.
+    CHECK_THROW(chunker.getNeighborChunks(-1, overlap), std::invalid_argument);
+    CHECK_THROW(chunker.getNeighborChunks(all[0], Angle(-1.0)),
+                std::invalid_argument);
+    CHECK_THROW(chunker.getNeighborSubChunks(all[0], -1, overlap),
+                std::invalid_argument);
+}
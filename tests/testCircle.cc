@@ -23,13 +23,17 @@
 /// \file
 /// \brief This file contains tests for the Box class.
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <memory>
+#include <random>
 #include <vector>
 
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
 #include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
 
 #include "test.h"
 #include "relationshipTestUtils.h"
@@ -322,6 +326,41 @@ TEST_CASE(CircleRelations) {
     CHECK(Circle(x, 1).relate(Circle(y, 1)) == INTERSECTS);
 }
 
+TEST_CASE(Polygons) {
+    std::mt19937_64 rng(5);
+    size_t const n = 500;
+    std::vector<double> x(n), y(n), z(n);
+    for (double r: {1.0e-5, 0.1, 1.0, 1.4}) {
+        Circle c(UnitVector3d(1, -2, 3), Angle(r));
+        for (int numVertices: {3, 4, 16, 33}) {
+            ConvexPolygon outer = c.toOuterPolygon(numVertices);
+            ConvexPolygon inner = c.toInnerPolygon(numVertices);
+            CHECK(outer.getVertices().size() == static_cast<size_t>(numVertices));
+            CHECK(inner.getVertices().size() == static_cast<size_t>(numVertices));
+            c.sample(n, rng, x.data(), y.data(), z.data());
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(outer.contains(UnitVector3d(x[i], y[i], z[i])));
+            }
+            inner.sample(n, rng, x.data(), y.data(), z.data());
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(c.contains(UnitVector3d(x[i], y[i], z[i])));
+            }
+            for (UnitVector3d const & v: inner.getVertices()) {
+                CHECK(c.contains(v));
+            }
+            CHECK(c.relate(inner) == CONTAINS);
+            CHECK((c.relate(outer) & WITHIN) != 0);
+        }
+    }
+    CHECK_THROW(Circle::empty().toOuterPolygon(), std::invalid_argument);
+    CHECK_THROW(Circle::full().toInnerPolygon(), std::invalid_argument);
+    CHECK_THROW(Circle(UnitVector3d::X(), Angle(0.1)).toInnerPolygon(2),
+                std::invalid_argument);
+    CHECK_THROW(Circle(UnitVector3d::X()).toInnerPolygon(),
+                std::invalid_argument);
+    CHECK(Circle(UnitVector3d::X()).toOuterPolygon().contains(UnitVector3d::X()));
+}
+
 TEST_CASE(Box3dBounds1) {
     static double const TOLERANCE = 1.0e-15;
 
@@ -373,3 +412,73 @@ TEST_CASE(Codec) {
     CHECK(dynamic_cast<Circle *>(r.get()) != nullptr);
     CHECK(*dynamic_cast<Circle *>(r.get()) == c);
 }
+
+TEST_CASE(CompactCodec) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    for (int i = 0; i < 100; ++i) {
+        Angle a(std::pow(10.0, 3.5 * u(rng) - 3.0));
+        Circle c(UnitVector3d(u(rng), u(rng), u(rng)), a);
+        std::vector<uint8_t> buffer = c.encodeCompact();
+        CHECK(buffer.size() == 14);
+        CHECK(buffer[0] == Circle::COMPACT_TYPE_CODE);
+        std::unique_ptr<Circle> d = Circle::decode(buffer);
+        // Circle::contains(Circle) is conservative by far more than the
+        // quantization error, so check the geometric condition directly.
+        CHECK(NormalizedAngle(d->getCenter(), c.getCenter()) + a <=
+              d->getOpeningAngle());
+        CHECK(d->getOpeningAngle() <= a * (1.0 + 1.0e-7) + Angle(1.0e-9));
+        CHECK(NormalizedAngle(d->getCenter(), c.getCenter()) <= Angle(4.0e-10));
+        CHECK(*dynamic_cast<Circle *>(Region::decode(buffer).get()) == *d);
+    }
+    CHECK(Circle::decode(Circle::empty().encodeCompact())->isEmpty());
+    CHECK(Circle::decode(Circle::full().encodeCompact())->isFull());
+}
+
+TEST_CASE(BatchContains) {
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    UnitVector3d const center(1, -2, 3);
+    Circle circles[] = {
+        Circle(center, Angle(0.1)),
+        Circle(center, Angle(2.5)),
+        Circle(center),
+        Circle::full(),
+        Circle::empty()
+    };
+    for (Circle const & c : circles) {
+        std::vector<double> x, y, z;
+        auto add = [&](Vector3d const & v) {
+            x.push_back(v.x());
+            y.push_back(v.y());
+            z.push_back(v.z());
+        };
+        add(center);
+        add(-center);
+        // Points on the circle boundary are the hard cases.
+        if (!c.isEmpty() && !c.isFull()) {
+            UnitVector3d v = UnitVector3d::orthogonalTo(center);
+            for (int i = 0; i < 16; ++i) {
+                add(center.rotatedAround(v, c.getOpeningAngle())
+                          .rotatedAround(center, Angle(0.4 * i)));
+            }
+        }
+        for (int i = 0; i < 1001; ++i) {
+            double const scales[] = {1.0, 7.5, 1.0e-120, 1.0e120};
+            add(scales[i % 4] * Vector3d(u(rng), u(rng), u(rng)));
+        }
+        size_t const n = x.size();
+        std::unique_ptr<bool[]> out(new bool[n]);
+        c.contains(x.data(), y.data(), z.data(), out.get(), n);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(out[i] == c.contains(UnitVector3d(x[i], y[i], z[i])));
+        }
+        std::unique_ptr<bool[]> threaded(new bool[n]);
+        c.contains(x.data(), y.data(), z.data(), threaded.get(), n, 3);
+        CHECK(std::equal(out.get(), out.get() + n, threaded.get()));
+    }
+    double x = 0.0;
+    bool out;
+    CHECK_THROW(Circle::full().contains(&x, &x, &x, &out, 1),
+                std::runtime_error);
+}
@@ -0,0 +1,236 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the CompoundRegion classes.
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/codec.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+// Return a row of n small circles along the equator, 1 degree apart.
+std::vector<std::unique_ptr<Region>> makeCircles(int n) {
+    std::vector<std::unique_ptr<Region>> circles;
+    for (int i = 0; i < n; ++i) {
+        circles.push_back(std::make_unique<Circle>(
+            UnitVector3d(LonLat::fromDegrees(i, 0)), Angle::fromDegrees(0.25)));
+    }
+    return circles;
+}
+
+UnitVector3d point(double lon, double lat) {
+    return UnitVector3d(LonLat::fromDegrees(lon, lat));
+}
+
+// A circle that counts point-in-region tests and has a given cost hint. Its
+// 3-D bounding box is the whole sphere, so that compound regions cannot skip
+// the tests.
+class CountingCircle : public Circle {
+public:
+    CountingCircle(UnitVector3d const &c, Angle a, double cost, int *count)
+        : Circle(c, a), _cost(cost), _count(count) {}
+
+    std::unique_ptr<Region> clone() const override {
+        return std::make_unique<CountingCircle>(*this);
+    }
+    Box3d getBoundingBox3d() const override { return Box3d::aroundUnitSphere(); }
+    double getCostHint() const override { return _cost; }
+    using Circle::contains;
+    bool contains(UnitVector3d const &v) const override {
+        ++*_count;
+        return Circle::contains(v);
+    }
+
+private:
+    double _cost;
+    int *_count;
+};
+
+TEST_CASE(Flatten) {
+    Circle c(point(0, 0), Angle::fromDegrees(1));
+    Box b = Box::fromDegrees(-1, -1, 1, 1);
+    UnionRegion u(c, b);
+    CHECK(u.nOperands() == 2);
+    UnionRegion u2(u, c);
+    CHECK(u2.nOperands() == 3);
+    UnionRegion u3(u2, u);
+    CHECK(u3.nOperands() == 5);
+    // Operands of a different compound type are not flattened.
+    IntersectionRegion i(u3, b);
+    CHECK(i.nOperands() == 2);
+    CHECK(dynamic_cast<UnionRegion const *>(&i.getOperand(0)) != nullptr);
+    IntersectionRegion i2(i, i);
+    CHECK(i2.nOperands() == 4);
+    std::vector<std::unique_ptr<Region>> operands;
+    operands.push_back(u.clone());
+    operands.push_back(nullptr);
+    CHECK_THROW(UnionRegion(std::move(operands)), std::invalid_argument);
+}
+
+TEST_CASE(SharedOperands) {
+    std::vector<std::shared_ptr<Region const>> circles;
+    for (auto &c : makeCircles(50)) {
+        circles.push_back(std::move(c));
+    }
+    // Build a union one operand at a time without copying any operands.
+    std::shared_ptr<Region const> u = circles[0];
+    for (std::size_t i = 1; i < circles.size(); ++i) {
+        u = std::make_shared<UnionRegion>(u, circles[i]);
+    }
+    auto const &union_ = dynamic_cast<UnionRegion const &>(*u);
+    REQUIRE(union_.nOperands() == circles.size());
+    for (std::size_t i = 0; i < circles.size(); ++i) {
+        CHECK(union_.getOperandPtr(i) == circles[i]);
+        CHECK(&union_.getOperand(i) == circles[i].get());
+    }
+    CHECK(union_.contains(point(42, 0)));
+    CHECK(!union_.contains(point(42.5, 0)));
+    // Copies share operands with the original.
+    UnionRegion copy(union_);
+    std::unique_ptr<Region> clone = union_.clone();
+    auto const &cloned = dynamic_cast<UnionRegion const &>(*clone);
+    for (std::size_t i = 0; i < circles.size(); ++i) {
+        CHECK(&copy.getOperand(i) == circles[i].get());
+        CHECK(&cloned.getOperand(i) == circles[i].get());
+    }
+    CHECK(copy.encode() == union_.encode());
+    IntersectionRegion i(u, circles[0]);
+    CHECK(i.nOperands() == 2);
+    CHECK(i.getOperandPtr(0) == u);
+    CHECK(i.contains(point(0, 0)));
+    CHECK(!i.contains(point(1, 0)));
+    CHECK_THROW(UnionRegion(u, nullptr), std::invalid_argument);
+}
+
+TEST_CASE(EvaluationOrder) {
+    int cheap = 0;
+    int expensive = 0;
+    UnionRegion u(CountingCircle(point(0, 0), Angle::fromDegrees(2), 500.0, &expensive),
+                  CountingCircle(point(0, 0), Angle::fromDegrees(1), 1.0, &cheap));
+    CHECK(u.getCostHint() == 501.0);
+    CHECK(u.contains(point(0, 0.5)));
+    CHECK(cheap == 1 && expensive == 0);
+    CHECK(u.contains(point(0, 1.5)));
+    CHECK(cheap == 2 && expensive == 1);
+    // The cheap operand is also the more selective one for an intersection;
+    // a point outside of it is rejected without testing the other.
+    cheap = 0;
+    expensive = 0;
+    IntersectionRegion i(CountingCircle(point(0, 0), Angle::fromDegrees(1), 500.0, &expensive),
+                         CountingCircle(point(0, 0), Angle::fromDegrees(0.5), 1.0, &cheap));
+    CHECK(!i.contains(point(0, 0.75)));
+    CHECK(cheap == 1 && expensive == 0);
+    CHECK(i.contains(point(0, 0.25)));
+    CHECK(cheap == 2 && expensive == 1);
+    // Operand order is unchanged.
+    CHECK(u.getOperand(0).getCostHint() == 500.0);
+    CHECK(i.getOperand(1).getCostHint() == 1.0);
+    // Nested compound regions are costed by their operands.
+    IntersectionRegion nested(u, Box::fromDegrees(-1, -1, 1, 1));
+    CHECK(nested.getCostHint() == 505.0);
+}
+
+TEST_CASE(ManyOperands) {
+    UnionRegion u(makeCircles(100));
+    CHECK(u.nOperands() == 100);
+    CHECK(u.contains(point(0, 0)));
+    CHECK(u.contains(point(57, 0.2)));
+    CHECK(!u.contains(point(57.5, 0)));
+    CHECK(!u.contains(point(150, 0)));
+    Box inside = Box::fromDegrees(41.9, -0.1, 42.1, 0.1);
+    Box across = Box::fromDegrees(41.5, -0.1, 44.5, 0.1);
+    Box outside = Box::fromDegrees(120, -10, 130, 10);
+    CHECK(u.relate(inside) == CONTAINS);
+    CHECK(u.relate(across) == INTERSECTS);
+    CHECK(u.relate(outside) == DISJOINT);
+    CHECK(u.relate(Box::fromDegrees(-10, -10, 110, 10)) == WITHIN);
+    IntersectionRegion i(Circle(point(0, 0), Angle::fromDegrees(0.75)),
+                         Circle(point(1, 0), Angle::fromDegrees(0.75)));
+    CHECK(i.contains(point(0.5, 0)));
+    CHECK(!i.contains(point(0, 0)));
+    CHECK(i.relate(outside) == DISJOINT);
+    CHECK(i.relate(Box::fromDegrees(-10, -10, 110, 10)) == WITHIN);
+    CHECK(i.relate(Box::fromDegrees(0.45, -0.01, 0.55, 0.01)) == CONTAINS);
+}
+
+TEST_CASE(NoOperands) {
+    UnionRegion u{std::vector<std::unique_ptr<Region>>()};
+    IntersectionRegion i{std::vector<std::unique_ptr<Region>>()};
+    CHECK(u.nOperands() == 0);
+    CHECK(!u.contains(point(0, 0)));
+    CHECK(u.getBoundingBox().isEmpty());
+    CHECK(i.contains(point(0, 0)));
+    CHECK(i.getBoundingBox().isFull());
+}
+
+TEST_CASE(Codec) {
+    UnionRegion u(makeCircles(10));
+    IntersectionRegion i(u, Box::fromDegrees(-1, -1, 5, 1));
+    std::vector<uint8_t> buffer = i.encode();
+    CHECK(buffer[0] == IntersectionRegion::TYPE_CODE);
+    std::unique_ptr<Region> r = Region::decode(buffer);
+    auto d = dynamic_cast<IntersectionRegion const *>(r.get());
+    REQUIRE(d != nullptr);
+    CHECK(d->nOperands() == 2);
+    auto du = dynamic_cast<UnionRegion const *>(&d->getOperand(0));
+    REQUIRE(du != nullptr);
+    CHECK(du->nOperands() == 10);
+    CHECK(du->encode() == u.encode());
+    for (size_t n = 0; n < buffer.size(); ++n) {
+        CHECK_THROW(Region::decode(buffer.data(), n), std::runtime_error);
+    }
+    buffer.push_back(0);
+    CHECK_THROW(Region::decode(buffer), std::runtime_error);
+}
+
+TEST_CASE(LegacyCodec) {
+    Circle c(point(0, 0), Angle::fromDegrees(1));
+    Box b = Box::fromDegrees(-1, -1, 1, 1);
+    std::vector<uint8_t> buffer{UnionRegion::LEGACY_TYPE_CODE};
+    for (Region const *r : {static_cast<Region const *>(&c),
+                            static_cast<Region const *>(&b)}) {
+        std::vector<uint8_t> operand = r->encode();
+        encodeU64(operand.size(), buffer);
+        buffer.insert(buffer.end(), operand.begin(), operand.end());
+    }
+    std::unique_ptr<UnionRegion> u = UnionRegion::decode(buffer);
+    CHECK(u->nOperands() == 2);
+    CHECK(dynamic_cast<Circle const &>(u->getOperand(0)) == c);
+    CHECK(dynamic_cast<Box const &>(u->getOperand(1)) == b);
+    CHECK(u->encode() == UnionRegion(c, b).encode());
+    buffer[0] = IntersectionRegion::LEGACY_TYPE_CODE;
+    CHECK(CompoundRegion::decode(buffer)->nOperands() == 2);
+    buffer.pop_back();
+    CHECK_THROW(UnionRegion::decode(buffer), std::runtime_error);
+}
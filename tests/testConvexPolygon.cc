@@ -23,19 +23,26 @@
 /// \file
 /// \brief This file contains tests for the ConvexPolygon class.
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
 #include <vector>
 
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Box3d.h"
 #include "lsst/sphgeom/Circle.h"
 #include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/orientation.h"
 
 #include "test.h"
 
 
 using namespace lsst::sphgeom;
 
-typedef std::vector<UnitVector3d>::const_iterator VertexIterator;
+typedef ConvexPolygon::VertexVector::const_iterator VertexIterator;
 
 void checkProperties(ConvexPolygon const & p) {
     CHECK(p.getVertices().size() >= 3);
@@ -133,8 +140,8 @@ TEST_CASE(Construction) {
         CHECK(p.getVertices()[2] == UnitVector3d::Z());
     }
     checkProperties(p);
-    for (VertexIterator v = points.begin(), end = points.end(); v != end; ++v) {
-        CHECK(p.contains(*v));
+    for (UnitVector3d const & v: points) {
+        CHECK(p.contains(v));
     }
     CHECK(p.contains(UnitVector3d(1, 1, 1)));
     std::rotate(points.begin(), points.begin() + 3, points.end());
@@ -152,6 +159,35 @@ TEST_CASE(ConstructionFailure) {
     CHECK_THROW(ConvexPolygon::convexHull(points), std::invalid_argument);
 }
 
+TEST_CASE(TrustedVertices) {
+    for (size_t n : {3, 4, 8, 9, 40}) {
+        ConvexPolygon p = makeNgon(UnitVector3d(1, 2, 3), UnitVector3d(2, 1, 3), n);
+        std::vector<UnitVector3d> vertices = p.getVertices();
+        ConvexPolygon q = ConvexPolygon::fromTrustedVertices(vertices);
+        CHECK(q == p);
+        CHECK(std::vector<UnitVector3d>(q.getVertices()) == vertices);
+        ConvexPolygon r = ConvexPolygon::fromTrustedVertices(vertices.data(), n);
+        CHECK(r == p);
+        CHECK(r.relate(p) == (CONTAINS | WITHIN));
+        ConvexPolygon m = ConvexPolygon::fromTrustedVertices(std::move(vertices));
+        CHECK(m == p);
+        checkProperties(m);
+    }
+#ifndef NDEBUG
+    std::vector<UnitVector3d> points = {
+        UnitVector3d::X(), UnitVector3d::Y(), UnitVector3d::Z()};
+    CHECK(ConvexPolygon::fromTrustedVertices(points) == ConvexPolygon(points));
+    std::vector<UnitVector3d> clockwise(points.rbegin(), points.rend());
+    CHECK_THROW(ConvexPolygon::fromTrustedVertices(clockwise),
+                std::invalid_argument);
+    CHECK_THROW(ConvexPolygon::fromTrustedVertices(points.data(), 2),
+                std::invalid_argument);
+    points.push_back(UnitVector3d(1, 1, 1));
+    CHECK_THROW(ConvexPolygon::fromTrustedVertices(points),
+                std::invalid_argument);
+#endif
+}
+
 TEST_CASE(Centroid) {
     ConvexPolygon p = makeSimpleTriangle();
     UnitVector3d c = p.getCentroid();
@@ -262,6 +298,48 @@ TEST_CASE(BoundingBox3d) {
     CHECK(b.z().getB() == 1);
 }
 
+TEST_CASE(LargePolygonBounds) {
+    // Polygons with many vertices compute bounding boxes in batches.
+    UnitVector3d const centers[] = {
+        UnitVector3d::Z(), -UnitVector3d::Z(), UnitVector3d::Y(),
+        UnitVector3d(1, 2, 3), UnitVector3d(-1, 0.2, -0.1)
+    };
+    for (UnitVector3d const & c: centers) {
+        UnitVector3d v0 = c.rotatedAround(UnitVector3d::orthogonalTo(c),
+                                          Angle(0.3));
+        for (size_t n: {31, 32, 203, 1001}) {
+            ConvexPolygon p = makeNgon(c, v0, n);
+            ConvexPolygon::VertexVector const & vertices = p.getVertices();
+            Box b = p.getBoundingBox();
+            Box3d b3 = p.getBoundingBox3d();
+            CHECK(b.relate(p) == CONTAINS);
+            double zmin = 2.0;
+            double zmax = -2.0;
+            for (size_t i = 0, j = vertices.size() - 1; i < vertices.size();
+                 j = i, ++i) {
+                for (double t: {0.0, 0.25, 0.5, 0.75}) {
+                    UnitVector3d u(vertices[j] * (1.0 - t) + vertices[i] * t);
+                    CHECK(b.contains(u));
+                    CHECK(b3.contains(u));
+                    zmin = std::min(zmin, u.z());
+                    zmax = std::max(zmax, u.z());
+                }
+            }
+            if (c == UnitVector3d::Z()) {
+                CHECK(b.getLon().isFull());
+                CHECK(b3.z().getB() == 1.0);
+            } else if (c == -UnitVector3d::Z()) {
+                CHECK(b.getLon().isFull());
+                CHECK(b3.z().getA() == -1.0);
+            } else {
+                CHECK(!b.getLon().isFull());
+                CHECK(b3.z().getA() <= zmin && b3.z().getA() >= zmin - 1.0e-4);
+                CHECK(b3.z().getB() >= zmax && b3.z().getB() <= zmax + 1.0e-4);
+            }
+        }
+    }
+}
+
 TEST_CASE(BoundingCircle) {
     ConvexPolygon p = makeSimpleTriangle();
     Circle c = p.getBoundingCircle();
@@ -284,6 +362,42 @@ TEST_CASE(Codec) {
     CHECK(*dynamic_cast<ConvexPolygon *>(r.get()) == p);
 }
 
+TEST_CASE(CompactCodec) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    for (int i = 0; i < 200; ++i) {
+        UnitVector3d c(u(rng), u(rng), u(rng));
+        Angle r(std::pow(10.0, 3.0 * u(rng) - 3.0));
+        UnitVector3d v0 = c.rotatedAround(UnitVector3d::orthogonalTo(c), r);
+        size_t n = 3 + i % 50;
+        ConvexPolygon p = makeNgon(c, v0, n);
+        std::vector<uint8_t> buffer = p.encodeCompact();
+        REQUIRE(buffer[0] == ConvexPolygon::COMPACT_TYPE_CODE);
+        CHECK(buffer.size() == 1 + 9 * p.getVertices().size());
+        std::unique_ptr<ConvexPolygon> q = ConvexPolygon::decode(buffer);
+        CHECK((q->relate(p) & CONTAINS) != 0);
+        REQUIRE(q->getVertices().size() == p.getVertices().size());
+        for (size_t j = 0; j < p.getVertices().size(); ++j) {
+            Angle d = NormalizedAngle(q->getVertices()[j], p.getVertices()[j]);
+            CHECK(d.asRadians() > 0.0 && d.asRadians() < 1.0e-8);
+        }
+        std::unique_ptr<Region> decoded = Region::decode(buffer);
+        CHECK(*dynamic_cast<ConvexPolygon *>(decoded.get()) == *q);
+    }
+    // Polygons that cannot be displaced reliably are encoded losslessly,
+    // and the encoding is conservative either way.
+    ConvexPolygon tiny = makeNgon(UnitVector3d(1, 2, 3),
+                                  UnitVector3d(1, 2, 3 + 1.0e-10), 3);
+    std::vector<uint8_t> buffer = tiny.encodeCompact();
+    std::unique_ptr<ConvexPolygon> q = ConvexPolygon::decode(buffer);
+    if (buffer[0] == ConvexPolygon::COMPACT_TYPE_CODE) {
+        CHECK((q->relate(tiny) & CONTAINS) != 0);
+    } else {
+        CHECK(buffer == tiny.encode());
+        CHECK(*q == tiny);
+    }
+}
+
 TEST_CASE(Hull) {
     std::vector<UnitVector3d> points = {
         UnitVector3d(0.9962891943972693, -0.06085984360495963, -0.06085984360495963),
@@ -299,6 +413,93 @@ TEST_CASE(Hull) {
     CHECK(poly.getVertices()[3] != poly.getVertices()[0]);
 }
 
+void checkHull(ConvexPolygon const & hull,
+               std::vector<UnitVector3d> const & points)
+{
+    auto const & verts = hull.getVertices();
+    REQUIRE(verts.size() >= 3);
+    for (size_t i = 0; i < verts.size(); ++i) {
+        // Vertices are input points that make strictly counter-clockwise
+        // turns, and every input point is in the hull.
+        CHECK(std::find(points.begin(), points.end(), verts[i]) != points.end());
+        CHECK(orientation(verts[i], verts[(i + 1) % verts.size()],
+                          verts[(i + 2) % verts.size()]) > 0);
+    }
+    for (UnitVector3d const & v : points) {
+        CHECK(hull.contains(v));
+    }
+}
+
+TEST_CASE(LargeHull) {
+    std::mt19937 rng(3);
+    std::normal_distribution<double> d;
+    std::uniform_real_distribution<double> u(0.0, 2.0 * PI);
+    UnitVector3d center(1, -2, 3);
+    UnitVector3d v0 = UnitVector3d::orthogonalTo(center);
+    std::vector<UnitVector3d> points;
+    // A cloud of points, with some duplicates, inside a circle, and
+    // samples of the circle itself.
+    for (int i = 0; i < 3000; ++i) {
+        points.push_back(UnitVector3d(Vector3d(center) + 0.2 *
+                                      Vector3d(d(rng), d(rng), d(rng))));
+    }
+    points.insert(points.end(), points.begin(), points.begin() + 100);
+    for (int i = 0; i < 500; ++i) {
+        points.push_back(UnitVector3d(
+            Vector3d(center) + 0.7 * Vector3d(
+                v0.rotatedAround(center, Angle(u(rng))))));
+    }
+    ConvexPolygon hull = ConvexPolygon::convexHull(points);
+    checkHull(hull, points);
+    std::shuffle(points.begin(), points.end(), rng);
+    CHECK(ConvexPolygon::convexHull(points) == hull);
+    CHECK(ConvexPolygon::convexHull(points, 4) == hull);
+    // For small hulls, the incremental algorithm applied to the hull
+    // vertices and a few interior points gives the same polygon.
+    for (int trial = 0; trial < 20; ++trial) {
+        std::vector<UnitVector3d> cloud;
+        for (int i = 0; i < 200; ++i) {
+            cloud.push_back(UnitVector3d(Vector3d(center) + 0.1 *
+                                         Vector3d(d(rng), d(rng), d(rng))));
+        }
+        ConvexPolygon h = ConvexPolygon::convexHull(cloud);
+        std::vector<UnitVector3d> verts = h.getVertices();
+        REQUIRE(verts.size() + 10 < 64);
+        verts.insert(verts.end(), cloud.begin(), cloud.begin() + 10);
+        std::shuffle(verts.begin(), verts.end(), rng);
+        CHECK(ConvexPolygon::convexHull(verts) == h);
+    }
+    // Points more than π/2 away from their centroid fall back to the
+    // incremental algorithm.
+    points.clear();
+    for (int i = 0; i < 100; ++i) {
+        points.push_back(UnitVector3d(1.0, 0.05 * d(rng), 0.05 * d(rng)));
+    }
+    points.push_back(UnitVector3d(LonLat::fromDegrees(170.0, 1.0)));
+    points.push_back(UnitVector3d(LonLat::fromDegrees(170.0, -1.0)));
+    ConvexPolygon big = ConvexPolygon::convexHull(points);
+    checkHull(big, points);
+    // Coplanar points have no hull.
+    points.clear();
+    for (int i = 0; i < 100; ++i) {
+        points.push_back(UnitVector3d::X().rotatedAround(
+            UnitVector3d::Z(), Angle(0.01 * i)));
+    }
+    CHECK_THROW(ConvexPolygon::convexHull(points), std::invalid_argument);
+}
+
+TEST_CASE(ParallelHull) {
+    std::mt19937 rng(4);
+    std::normal_distribution<double> d;
+    std::vector<UnitVector3d> points;
+    for (int i = 0; i < 100000; ++i) {
+        points.push_back(UnitVector3d(d(rng), d(rng), 10.0 + d(rng)));
+    }
+    ConvexPolygon hull = ConvexPolygon::convexHull(points);
+    checkHull(hull, points);
+    CHECK(ConvexPolygon::convexHull(points, 8) == hull);
+}
+
 TEST_CASE(Disjoint) {
     std::vector<UnitVector3d> points1 = {
         UnitVector3d(1.0, 0.0, -1.0),
@@ -314,3 +515,307 @@ TEST_CASE(Disjoint) {
     ConvexPolygon poly2(points2);
     CHECK(poly1.relate(poly2) == DISJOINT);
 }
+
+// `referenceRelate` relates two polygons by testing every vertex against
+// every edge, and every pair of edges for a crossing.
+Relationship referenceRelate(ConvexPolygon const & p1, ConvexPolygon const & p2) {
+    auto contains = [](ConvexPolygon const & p, UnitVector3d const & v) {
+        std::vector<UnitVector3d> const & w = p.getVertices();
+        for (size_t i = w.size() - 1, j = 0; j < w.size(); i = j, ++j) {
+            if (orientation(v, w[i], w[j]) < 0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    std::vector<UnitVector3d> const & v1 = p1.getVertices();
+    std::vector<UnitVector3d> const & v2 = p2.getVertices();
+    bool all1 = true, any1 = false, all2 = true, any2 = false;
+    for (UnitVector3d const & v : v1) {
+        bool b = contains(p2, v);
+        all1 = all1 && b;
+        any1 = any1 || b;
+    }
+    for (UnitVector3d const & v : v2) {
+        bool b = contains(p1, v);
+        all2 = all2 && b;
+        any2 = any2 || b;
+    }
+    if (all1 || all2) {
+        return (all1 ? WITHIN : INTERSECTS) | (all2 ? CONTAINS : INTERSECTS);
+    }
+    if (any1 || any2) {
+        return INTERSECTS;
+    }
+    for (size_t a = v1.size() - 1, b = 0; b < v1.size(); a = b, ++b) {
+        for (size_t c = v2.size() - 1, d = 0; d < v2.size(); c = d, ++d) {
+            int acd = orientation(v1[a], v2[c], v2[d]);
+            int bdc = orientation(v1[b], v2[d], v2[c]);
+            if (acd == bdc && acd != 0) {
+                int cba = orientation(v2[c], v1[b], v1[a]);
+                int dab = orientation(v2[d], v1[a], v1[b]);
+                if (cba == dab && cba == acd) {
+                    return INTERSECTS;
+                }
+            }
+        }
+    }
+    return DISJOINT;
+}
+
+TEST_CASE(SeparatedRelations) {
+    // Polygons separated by an edge great circle are rejected without the
+    // quadratic tests, which must not change any relationship. Tiles of a
+    // lon/lat grid share vertices and edges with their neighbors.
+    std::vector<ConvexPolygon> polygons;
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            polygons.push_back(ConvexPolygon(std::vector<UnitVector3d>{
+                UnitVector3d(LonLat::fromDegrees(i, j)),
+                UnitVector3d(LonLat::fromDegrees(i + 1, j)),
+                UnitVector3d(LonLat::fromDegrees(i + 1, j + 1)),
+                UnitVector3d(LonLat::fromDegrees(i, j + 1))}));
+        }
+    }
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> u(0.0, 4.0);
+    for (int k = 0; k < 100; ++k) {
+        UnitVector3d c(LonLat::fromDegrees(u(rng), u(rng)));
+        UnitVector3d v0 = c.rotatedAround(UnitVector3d::orthogonalTo(c),
+                                          Angle::fromDegrees(0.1 + 0.3 * u(rng)));
+        polygons.push_back(makeNgon(c, v0, 3 + k % 20));
+    }
+    for (ConvexPolygon const & p1 : polygons) {
+        for (ConvexPolygon const & p2 : polygons) {
+            CHECK(p1.relate(p2) == referenceRelate(p1, p2));
+        }
+    }
+}
+
+TEST_CASE(CachedBounds) {
+    ConvexPolygon p = makeNgon(UnitVector3d::Z(), UnitVector3d(1, 1, 1), 6);
+    Box b = p.getBoundingBox();
+    Box3d b3 = p.getBoundingBox3d();
+    Circle c = p.getBoundingCircle();
+    CHECK(p.getBoundingBox() == b);
+    CHECK(p.getBoundingBox3d() == b3);
+    CHECK(p.getBoundingCircle() == c);
+    ConvexPolygon q(p);
+    CHECK(q.getBoundingBox() == b);
+    CHECK(q.getBoundingBox3d() == b3);
+    CHECK(q.getBoundingCircle() == c);
+    q = makeSimpleTriangle();
+    CHECK(q.getBoundingCircle() == makeSimpleTriangle().getBoundingCircle());
+    CHECK(q.getBoundingBox3d() == makeSimpleTriangle().getBoundingBox3d());
+}
+
+TEST_CASE(BoundsRejection) {
+    // Relationships established by the bounding primitive tests must agree
+    // with the exact ones, in both directions.
+    ConvexPolygon t = makeSimpleTriangle();
+    ConvexPolygon far = makeNgon(-UnitVector3d::Z(), -UnitVector3d(1, 1, 1), 5);
+    ConvexPolygon near = makeNgon(UnitVector3d(1, 1, 1), UnitVector3d::X(), 4);
+    CHECK(t.relate(far) == DISJOINT);
+    CHECK(far.relate(t) == DISJOINT);
+    CHECK(t.relate(near) != DISJOINT);
+    CHECK(near.relate(t) != DISJOINT);
+    CHECK(far.relate(Circle(UnitVector3d::Z(), 0.1)) == DISJOINT);
+    CHECK(Circle(UnitVector3d::Z(), 0.1).relate(far) == DISJOINT);
+    CHECK(far.relate(Circle::empty()) == (CONTAINS | DISJOINT));
+    CHECK(far.relate(Box::fromDegrees(0, 80, 360, 90)) == DISJOINT);
+}
+
+TEST_CASE(BatchContains) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> d;
+    ConvexPolygon polygons[] = {
+        makeSimpleTriangle(),
+        makeNgon(UnitVector3d(1, 1, 1), UnitVector3d(1, 2, 1), 7),
+        makeNgon(UnitVector3d::Z(), UnitVector3d(1, 0, 1), 12)
+    };
+    for (ConvexPolygon const & p : polygons) {
+        std::vector<double> x, y, z;
+        // Vertices and points on edges are the hard cases.
+        auto const & verts = p.getVertices();
+        for (size_t i = 0; i < verts.size(); ++i) {
+            UnitVector3d const & a = verts[i];
+            UnitVector3d const & b = verts[(i + 1) % verts.size()];
+            UnitVector3d m(a + b);
+            for (UnitVector3d const & v : {a, m, -m}) {
+                x.push_back(v.x());
+                y.push_back(v.y());
+                z.push_back(v.z());
+            }
+        }
+        for (int i = 0; i < 1001; ++i) {
+            // Points need not be normalized.
+            double const scales[] = {1.0, 7.5, 1.0e-120, 1.0e120};
+            double s = scales[i % 4];
+            Vector3d v = s * (Vector3d(p.getCentroid()) +
+                              0.5 * Vector3d(d(rng), d(rng), d(rng)));
+            x.push_back(v.x());
+            y.push_back(v.y());
+            z.push_back(v.z());
+        }
+        size_t const n = x.size();
+        std::unique_ptr<bool[]> out(new bool[n]);
+        p.contains(x.data(), y.data(), z.data(), out.get(), n);
+        size_t inside = 0;
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(out[i] == p.contains(UnitVector3d(x[i], y[i], z[i])));
+            inside += out[i];
+        }
+        CHECK(inside > 0 && inside < n);
+        // Tail handling: batch sizes that are not multiples of the
+        // kernel width must give the same results.
+        for (size_t m = 0; m < 7; ++m) {
+            p.contains(x.data(), y.data(), z.data(), out.get(), m);
+            for (size_t i = 0; i < m; ++i) {
+                CHECK(out[i] == p.contains(UnitVector3d(x[i], y[i], z[i])));
+            }
+        }
+    }
+}
+
+TEST_CASE(CachedEdges) {
+    // Results computed with cached edge normals must match the orientation
+    // based definitions, including for copies and moved-from sources.
+    ConvexPolygon p = makeNgon(UnitVector3d(1, 1, 1), UnitVector3d(1, 2, 1), 9);
+    Circle c(UnitVector3d(1, 1, 1), 0.4);
+    Relationship r = p.relate(c);
+    auto const & verts = p.getVertices();
+    for (size_t i = 0; i < verts.size(); ++i) {
+        UnitVector3d const & a = verts[i];
+        UnitVector3d const & b = verts[(i + 1) % verts.size()];
+        for (UnitVector3d const & v : {a, UnitVector3d(a + b),
+                                       UnitVector3d(a - b), -a}) {
+            bool inside = true;
+            for (size_t j = 0; j < verts.size(); ++j) {
+                inside = inside && orientation(
+                    v, verts[j], verts[(j + 1) % verts.size()]) >= 0;
+            }
+            CHECK(p.contains(v) == inside);
+            CHECK(ConvexPolygon(p).contains(v) == inside);
+        }
+    }
+    ConvexPolygon q(p);
+    CHECK(q.relate(c) == r);
+    CHECK(q.relate(p) == (CONTAINS | WITHIN | INTERSECTS));
+    ConvexPolygon m(std::move(q));
+    CHECK(m.relate(c) == r);
+    q = makeSimpleTriangle();
+    CHECK(q.relate(c) == makeSimpleTriangle().relate(c));
+    q = std::move(m);
+    CHECK(q.relate(c) == r);
+    CHECK(q == p);
+}
+
+TEST_CASE(Simplification) {
+    // Points at random angles on a circle are all hull vertices, with
+    // irregular spacing.
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u(0.0, 2.0 * PI);
+    UnitVector3d const center(1, -1, 2);
+    UnitVector3d const v0 = center.rotatedAround(
+        UnitVector3d::orthogonalTo(center), Angle(0.3));
+    std::vector<UnitVector3d> points;
+    for (int i = 0; i < 3000; ++i) {
+        points.push_back(v0.rotatedAround(center, Angle(u(rng))));
+    }
+    ConvexPolygon const polygons[] = {
+        makeNgon(center, UnitVector3d(1, 1, 1), 500),
+        ConvexPolygon::convexHull(points)
+    };
+    for (ConvexPolygon const & p: polygons) {
+        for (size_t maxVertices: {3, 8, 32}) {
+            ConvexPolygon outer = p.simplifiedOuter(maxVertices);
+            ConvexPolygon inner = p.simplifiedInner(maxVertices);
+            checkProperties(outer);
+            checkProperties(inner);
+            CHECK(outer.getVertices().size() < p.getVertices().size());
+            CHECK(inner.getVertices().size() == maxVertices);
+            // The outer polygon contains every vertex of p, and every
+            // vertex of the inner polygon is a vertex of p.
+            for (UnitVector3d const & v: p.getVertices()) {
+                CHECK(outer.contains(v));
+            }
+            for (UnitVector3d const & v: inner.getVertices()) {
+                CHECK(std::find(p.getVertices().begin(), p.getVertices().end(),
+                                v) != p.getVertices().end());
+            }
+            CHECK((outer.relate(p) & CONTAINS) != 0);
+            CHECK((inner.relate(p) & WITHIN) != 0);
+            CHECK(outer.getArea() >= p.getArea());
+            CHECK(inner.getArea() <= p.getArea());
+        }
+        // With enough vertices, the simplified polygons are close to p.
+        ConvexPolygon outer = p.simplifiedOuter(32);
+        ConvexPolygon inner = p.simplifiedInner(32);
+        CHECK(outer.getVertices().size() <= 32);
+        CHECK(outer.getArea() < 1.1 * p.getArea());
+        CHECK(inner.getArea() > 0.9 * p.getArea());
+    }
+    ConvexPolygon const t = makeSimpleTriangle();
+    CHECK(t.simplifiedOuter(3) == t);
+    CHECK(t.simplifiedInner(10) == t);
+    CHECK_THROW(t.simplifiedOuter(2), std::invalid_argument);
+    CHECK_THROW(t.simplifiedInner(0), std::invalid_argument);
+}
+
+TEST_CASE(Dilation) {
+    std::mt19937 rng(7);
+    std::normal_distribution<double> normal;
+    for (double size: {1e-6, 1e-3, 0.2}) {
+        for (double r: {1e-9, 1e-4, 0.05}) {
+            for (int trial = 0; trial < 10; ++trial) {
+                UnitVector3d c(normal(rng), normal(rng), normal(rng));
+                std::vector<UnitVector3d> points;
+                for (int k = 0; k < 3 + trial; ++k) {
+                    Vector3d d(normal(rng), normal(rng), normal(rng));
+                    points.push_back(UnitVector3d(c + size * d));
+                }
+                ConvexPolygon p = ConvexPolygon::convexHull(points);
+                ConvexPolygon d = p.dilatedBy(Angle(r));
+                CHECK((d.relate(p) & CONTAINS) != 0);
+                CHECK(d.getVertices().size() <= 9 * p.getVertices().size());
+                auto const & v = p.getVertices();
+                size_t const n = v.size();
+                for (size_t i = 0; i < n; ++i) {
+                    UnitVector3d const & a = v[i];
+                    UnitVector3d const & b = v[(i + 1) % n];
+                    UnitVector3d normal(b.robustCross(a));
+                    // Points at distance r from the edge (a, b).
+                    for (int k = 0; k <= 8; ++k) {
+                        UnitVector3d e(a + (b - a) * (k / 8.0));
+                        UnitVector3d q(std::cos(r) * e + std::sin(r) * normal);
+                        CHECK(d.contains(q));
+                    }
+                    // Points at distance r from vertex a.
+                    UnitVector3d u = UnitVector3d::orthogonalTo(a);
+                    UnitVector3d w(a.cross(u));
+                    for (int k = 0; k < 32; ++k) {
+                        double t = k * PI / 16.0;
+                        UnitVector3d q(std::cos(r) * a + std::sin(r) *
+                                       (std::cos(t) * u + std::sin(t) * w));
+                        CHECK(d.contains(q));
+                    }
+                }
+                // The result is close to the exact dilation.
+                for (UnitVector3d const & q: d.getVertices()) {
+                    double minAngle = PI;
+                    for (UnitVector3d const & a: v) {
+                        minAngle = std::min(minAngle,
+                                            Angle(NormalizedAngle(a, q)).asRadians());
+                    }
+                    CHECK(minAngle <= 1.09 * r + 1e-13);
+                }
+            }
+        }
+    }
+    ConvexPolygon p(UnitVector3d::X(), UnitVector3d::Y(), UnitVector3d::Z());
+    CHECK(p.dilatedBy(Angle(0.0)) == p);
+    CHECK_THROW(p.dilatedBy(Angle(-1e-3)), std::invalid_argument);
+    CHECK_THROW(p.dilatedBy(Angle(std::nan(""))), std::invalid_argument);
+    CHECK_THROW(p.dilatedBy(Angle(1.0)), std::invalid_argument);
+    CHECK(p.dilatedBy(Angle(0.1)).contains(UnitVector3d(1, -0.05, 0)));
+}
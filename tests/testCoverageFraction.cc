@@ -0,0 +1,139 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for pixel coverage fraction computation.
+
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/area.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+std::vector<std::unique_ptr<Pixelization>> makePixelizations(int level) {
+    std::vector<std::unique_ptr<Pixelization>> p;
+    p.emplace_back(new HtmPixelization(level));
+    p.emplace_back(new Q3cPixelization(level));
+    p.emplace_back(new Q3cPixelization(level, true));
+    p.emplace_back(new Mq3cPixelization(level));
+    p.emplace_back(new HealpixPixelization(level));
+    return p;
+}
+
+std::vector<std::unique_ptr<Region>> makeRegions() {
+    std::vector<std::unique_ptr<Region>> r;
+    UnitVector3d c(1.0, -2.0, 3.0);
+    r.emplace_back(new Circle(c, Angle(0.1)));
+    r.emplace_back(new Box(LonLat(c), Angle(0.2), Angle(0.05)));
+    r.emplace_back(new ConvexPolygon(std::vector<UnitVector3d>{
+        UnitVector3d(1, 0, 0), UnitVector3d(1, 0.1, 0),
+        UnitVector3d(1, 0.05, 0.08)}));
+    return r;
+}
+
+double pixelArea(Pixelization const & p, uint64_t i) {
+    return dynamic_cast<ConvexPolygon const &>(*p.pixel(i)).getArea();
+}
+
+double regionArea(Region const & r) {
+    if (auto c = dynamic_cast<Circle const *>(&r)) {
+        return c->getArea();
+    }
+    if (auto b = dynamic_cast<Box const *>(&r)) {
+        return b->getArea();
+    }
+    return dynamic_cast<ConvexPolygon const &>(r).getArea();
+}
+
+TEST_CASE(MatchesEnvelopeAndInterior) {
+    for (auto const & p: makePixelizations(7)) {
+        for (auto const & r: makeRegions()) {
+            CoverageFractions c = p->coverageFraction(*r);
+            REQUIRE(c.begin.size() == c.size());
+            REQUIRE(c.end.size() == c.size());
+            RangeSet interior = p->interior(*r);
+            RangeSet envelope = p->envelope(*r);
+            RangeSet full;
+            RangeSet covered;
+            for (size_t i = 0; i < c.size(); ++i) {
+                CHECK(c.begin[i] < c.end[i]);
+                CHECK(i == 0 || c.end[i - 1] <= c.begin[i]);
+                CHECK(c.fraction[i] > 0.0 && c.fraction[i] <= 1.0);
+                covered.insert(c.begin[i], c.end[i]);
+                if (c.end[i] - c.begin[i] > 1 || interior.contains(c.begin[i])) {
+                    CHECK(c.fraction[i] == 1.0);
+                    full.insert(c.begin[i], c.end[i]);
+                } else {
+                    // Boundary pixels are clipped against the region.
+                    uint64_t j = c.begin[i];
+                    auto pixel = p->pixel(j);
+                    double f = overlapArea(
+                        dynamic_cast<ConvexPolygon const &>(*pixel), *r) /
+                        pixelArea(*p, j);
+                    CHECK(std::fabs(c.fraction[i] - f) <= 1.0e-9);
+                }
+            }
+            CHECK(full == interior);
+            CHECK(envelope.contains(covered));
+        }
+    }
+}
+
+TEST_CASE(AreaSum) {
+    // The pixels of HTM and Q3C style pixelizations partition the sphere,
+    // so the covered pixel areas sum to the area of the region.
+    auto pixelizations = makePixelizations(6);
+    pixelizations.pop_back();
+    for (auto const & p: pixelizations) {
+        for (auto const & r: makeRegions()) {
+            CoverageFractions c = p->coverageFraction(*r);
+            double sum = 0.0;
+            for (size_t i = 0; i < c.size(); ++i) {
+                for (uint64_t j = c.begin[i]; j != c.end[i]; ++j) {
+                    sum += c.fraction[i] * pixelArea(*p, j);
+                }
+            }
+            double area = regionArea(*r);
+            CHECK(std::fabs(sum - area) <= 1.0e-9 * area);
+        }
+    }
+}
+
+TEST_CASE(UnsupportedRegions) {
+    Ellipse e(UnitVector3d::X(), Angle(0.1), Angle(0.05), Angle(0.0));
+    for (auto const & p: makePixelizations(3)) {
+        CHECK_THROW(p->coverageFraction(e), std::invalid_argument);
+    }
+}
@@ -0,0 +1,204 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for run time kernel selection.
+
+#include "lsst/sphgeom/cpuFeatures.h"
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/curve.h"
+#include "lsst/sphgeom/Matrix3d.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/orientation.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+#include "lsst/sphgeom/utils.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+// `baselineAndDetected` returns the result of f() computed with the
+// baseline kernels, and with all detected kernel variants.
+template <typename F>
+auto baselineAndDetected(F f) -> std::pair<decltype(f()), decltype(f())> {
+    CpuFeatures saved = getCpuFeatures();
+    setCpuFeatures(CpuFeatures());
+    auto baseline = f();
+    setCpuFeatures(detectCpuFeatures());
+    auto detected = f();
+    setCpuFeatures(saved);
+    return {baseline, detected};
+}
+
+bool identical(std::vector<double> const & a, std::vector<double> const & b) {
+    return a.size() == b.size() &&
+           std::memcmp(a.data(), b.data(), a.size() * sizeof(double)) == 0;
+}
+
+struct Points {
+    std::vector<double> x, y, z;
+    std::vector<UnitVector3d> v;
+    std::vector<uint32_t> s, t;
+
+    explicit Points(size_t n) {
+        std::mt19937 rng(20261014);
+        std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+        std::uniform_int_distribution<uint32_t> grid(0, (1u << 20) - 1);
+        for (size_t i = 0; i < n; ++i) {
+            UnitVector3d p(uniform(rng), uniform(rng), uniform(rng));
+            // Put some points on or very near the polygon edges below.
+            if (i % 5 == 0) {
+                p = UnitVector3d(p.x(), p.y(), 1.0e-17 * uniform(rng));
+            }
+            v.push_back(p);
+            x.push_back(p.x() * (1.0 + i % 3));
+            y.push_back(p.y() * (1.0 + i % 3));
+            z.push_back(p.z() * (1.0 + i % 3));
+            s.push_back(grid(rng));
+            t.push_back(grid(rng));
+        }
+    }
+};
+
+TEST_CASE(SetAndGet) {
+    CpuFeatures detected = detectCpuFeatures();
+    CpuFeatures all;
+    all.avx2 = all.fastBmi2 = all.neon = true;
+    setCpuFeatures(all);
+    CpuFeatures f = getCpuFeatures();
+    CHECK(f.avx2 == detected.avx2);
+    CHECK(f.fastBmi2 == detected.fastBmi2);
+    CHECK(f.neon == detected.neon);
+    setCpuFeatures(CpuFeatures());
+    f = getCpuFeatures();
+    CHECK(!f.avx2 && !f.fastBmi2 && !f.neon);
+    setCpuFeatures(detected);
+}
+
+TEST_CASE(Orientation) {
+    Points p(1001);
+    size_t n = p.v.size() - 2;
+    auto r = baselineAndDetected([&]() {
+        std::vector<int> out(2 * n + 1);
+        orientationBatch(p.v.data(), p.v.data() + 1, p.v.data() + 2,
+                         out.data(), n);
+        orientationEdges(p.v[0], p.v.data() + 1, out.data() + n, n + 1);
+        return out;
+    });
+    CHECK(r.first == r.second);
+    for (size_t i = 0; i < n; ++i) {
+        CHECK(r.second[i] == orientation(p.v[i], p.v[i + 1], p.v[i + 2]));
+    }
+}
+
+TEST_CASE(PolygonContains) {
+    Points p(1001);
+    ConvexPolygon poly(std::vector<UnitVector3d>{
+        UnitVector3d(1, 0, 0), UnitVector3d(0, 1, 0), UnitVector3d(-1, -1, 1)});
+    auto r = baselineAndDetected([&]() {
+        std::unique_ptr<bool[]> out(new bool[p.x.size()]);
+        poly.contains(p.x.data(), p.y.data(), p.z.data(), out.get(),
+                      p.x.size());
+        return std::vector<bool>(out.get(), out.get() + p.x.size());
+    });
+    CHECK(r.first == r.second);
+}
+
+TEST_CASE(PointIndexing) {
+    Points p(1001);
+    for (int level : {1, 10, 30}) {
+        Q3cPixelization q3c(level);
+        Q3cPixelization hq3c(level, 0, true);
+        Mq3cPixelization mq3c(level);
+        for (Pixelization const * pix :
+             {static_cast<Pixelization const *>(&q3c),
+              static_cast<Pixelization const *>(&hq3c),
+              static_cast<Pixelization const *>(&mq3c)}) {
+            auto r = baselineAndDetected([&]() {
+                std::vector<uint64_t> out(p.x.size());
+                pix->index(p.x.data(), p.y.data(), p.z.data(), out.data(),
+                           p.x.size());
+                return out;
+            });
+            CHECK(r.first == r.second);
+        }
+    }
+}
+
+TEST_CASE(Curves) {
+    Points p(1001);
+    size_t n = p.s.size();
+    auto r = baselineAndDetected([&]() {
+        std::vector<uint64_t> out(4 * n);
+        std::vector<uint32_t> s(n), t(n);
+        mortonIndex(p.s.data(), p.t.data(), out.data(), n);
+        hilbertIndex(p.s.data(), p.t.data(), out.data() + n, n, 20);
+        mortonToHilbert(out.data(), out.data() + 2 * n, n, 20);
+        hilbertToMorton(out.data() + n, out.data() + 3 * n, n, 20);
+        mortonIndexInverse(out.data(), s.data(), t.data(), n);
+        CHECK(s == p.s && t == p.t);
+        hilbertIndexInverse(out.data() + n, s.data(), t.data(), n, 20);
+        CHECK(s == p.s && t == p.t);
+        return out;
+    });
+    CHECK(r.first == r.second);
+}
+
+TEST_CASE(UnitVectorArrays) {
+    Points p(1001);
+    std::vector<double> lon, lat;
+    for (UnitVector3d const & v : p.v) {
+        lon.push_back(std::atan2(v.y(), v.x()));
+        lat.push_back(std::asin(v.z()));
+    }
+    auto r = baselineAndDetected([&]() {
+        UnitVector3dArray a = UnitVector3dArray::fromComponents(
+            p.x.data(), p.y.data(), p.z.data(), p.x.size());
+        UnitVector3dArray b = UnitVector3dArray::fromLonLat(
+            lon.data(), lat.data(), lon.size());
+        UnitVector3dArray c = a;
+        c.rotate(Matrix3d(0.36, 0.48, -0.8, -0.8, 0.6, 0.0, 0.48, 0.64, 0.6));
+        std::vector<double> out;
+        for (UnitVector3dArray const * arr : {&a, &b, &c}) {
+            out.insert(out.end(), arr->x(), arr->x() + arr->size());
+            out.insert(out.end(), arr->y(), arr->y() + arr->size());
+            out.insert(out.end(), arr->z(), arr->z() + arr->size());
+        }
+        std::vector<std::pair<size_t, size_t>> pairs;
+        findPairsWithin(a, b, Angle(0.05), pairs);
+        for (auto const & pair : pairs) {
+            out.push_back(static_cast<double>(pair.first));
+            out.push_back(static_cast<double>(pair.second));
+        }
+        return out;
+    });
+    CHECK(identical(r.first, r.second));
+}
@@ -0,0 +1,123 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the crossMatch function.
+
+#include <random>
+#include <vector>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/crossMatch.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+using Pairs = std::vector<std::pair<size_t, size_t>>;
+
+UnitVector3dArray randomPoints(std::mt19937 & rng, size_t n) {
+    std::normal_distribution<double> dist;
+    UnitVector3dArray points;
+    for (size_t i = 0; i < n; ++i) {
+        points.push_back(UnitVector3d(dist(rng), dist(rng), dist(rng)));
+    }
+    return points;
+}
+
+// `perturbed` returns copies of the given points, each moved by up to
+// about `scale` radians in a random direction.
+UnitVector3dArray perturbed(std::mt19937 & rng,
+                            UnitVector3dArray const & points,
+                            double scale)
+{
+    std::uniform_real_distribution<double> dist(-scale, scale);
+    UnitVector3dArray result;
+    for (size_t i = 0; i < points.size(); ++i) {
+        Vector3d d(dist(rng), dist(rng), dist(rng));
+        result.push_back(UnitVector3d(points[i] + d));
+    }
+    return result;
+}
+
+Pairs bruteForceMatch(UnitVector3dArray const & a,
+                      UnitVector3dArray const & b,
+                      Angle radius)
+{
+    Pairs pairs;
+    for (size_t i = 0; i < a.size(); ++i) {
+        Circle c(a[i], radius);
+        for (size_t j = 0; j < b.size(); ++j) {
+            if (c.contains(b[j])) {
+                pairs.emplace_back(i, j);
+            }
+        }
+    }
+    return pairs;
+}
+
+TEST_CASE(Level) {
+    CHECK(crossMatchLevel(Angle(2.0), 1000000) == -1);
+    CHECK(crossMatchLevel(Angle(1.0), 1000000) == 0);
+    CHECK(crossMatchLevel(Angle(0.25), 1000000) == 2);
+    CHECK(crossMatchLevel(Angle(0.2), 1000000) == 2);
+    CHECK(crossMatchLevel(Angle(0.0), 100) == 0);
+    CHECK(crossMatchLevel(Angle(0.0), 400) == 1);
+    CHECK(crossMatchLevel(Angle(0.0), 0) == 0);
+    CHECK(crossMatchLevel(Angle(1e-12), static_cast<size_t>(1) << 62) == 27);
+}
+
+TEST_CASE(Match) {
+    std::mt19937 rng(1);
+    UnitVector3dArray a = randomPoints(rng, 3000);
+    for (double r: {1e-4, 0.003, 0.01, 0.0625, 0.3, 0.9, 1.5}) {
+        // Place about half of the points of b near points of a, at
+        // distances similar to the match radius.
+        UnitVector3dArray b = perturbed(rng, a, r);
+        UnitVector3dArray c = randomPoints(rng, 1500);
+        for (size_t i = 0; i < c.size(); ++i) {
+            b.push_back(c[i]);
+        }
+        Pairs expected = bruteForceMatch(a, b, Angle(r));
+        CHECK(!expected.empty());
+        CHECK(crossMatch(a, b, Angle(r)) == expected);
+        CHECK(crossMatch(a, b, Angle(r), 4) == expected);
+    }
+}
+
+TEST_CASE(EdgeCases) {
+    std::mt19937 rng(2);
+    UnitVector3dArray a = randomPoints(rng, 100);
+    UnitVector3dArray empty;
+    CHECK(crossMatch(a, empty, Angle(0.1)).empty());
+    CHECK(crossMatch(empty, a, Angle(0.1)).empty());
+    CHECK(crossMatch(a, a, Angle(-1.0)).empty());
+    CHECK(crossMatch(a, a, Angle::nan()).empty());
+    // Every point matches itself, even for a zero radius.
+    Pairs pairs = crossMatch(a, a, Angle(0.0));
+    CHECK(pairs.size() == a.size());
+    for (size_t i = 0; i < pairs.size(); ++i) {
+        CHECK(pairs[i] == std::make_pair(i, i));
+    }
+    CHECK(crossMatch(a, a, Angle(PI)).size() == a.size() * a.size());
+}
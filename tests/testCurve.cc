@@ -23,6 +23,8 @@
 /// \file
 /// \brief This file contains tests for space filling curve functions.
 
+#include <vector>
+
 #include "lsst/sphgeom/curve.h"
 
 #include "test.h"
@@ -117,3 +119,54 @@ TEST_CASE(Hilbert) {
         checkHilbert(points3[i][0], points3[i][1], 3, i);
     }
 }
+
+TEST_CASE(Batch) {
+    // Batch results must match those of the single value functions, for
+    // every curve order (and so for every LUT remainder case).
+    std::vector<uint32_t> x;
+    std::vector<uint32_t> y;
+    uint64_t state = UINT64_C(0x9e3779b97f4a7c15);
+    for (int i = 0; i < 1000; ++i) {
+        // A 64 bit linear congruential generator.
+        state = state * UINT64_C(6364136223846793005) +
+                UINT64_C(1442695040888963407);
+        x.push_back(static_cast<uint32_t>(state >> 32));
+        y.push_back(static_cast<uint32_t>(state));
+    }
+    size_t const n = x.size();
+    std::vector<uint64_t> z(n), h(n), out(n);
+    std::vector<uint32_t> xo(n), yo(n);
+    mortonIndex(x.data(), y.data(), z.data(), n);
+    mortonIndexInverse(z.data(), xo.data(), yo.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        CHECK(z[i] == mortonIndex(x[i], y[i]));
+        CHECK(xo[i] == x[i] && yo[i] == y[i]);
+    }
+    for (int m = 0; m <= 32; ++m) {
+        uint32_t const mask = (m == 32) ? UINT32_C(0xffffffff)
+                                        : (UINT32_C(1) << m) - 1;
+        std::vector<uint32_t> xm(n), ym(n);
+        for (size_t i = 0; i < n; ++i) {
+            xm[i] = x[i] & mask;
+            ym[i] = y[i] & mask;
+            z[i] = mortonIndex(xm[i], ym[i]);
+        }
+        mortonToHilbert(z.data(), h.data(), n, m);
+        hilbertToMorton(h.data(), out.data(), n, m);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(h[i] == mortonToHilbert(z[i], m));
+            CHECK(out[i] == z[i]);
+        }
+        hilbertIndex(xm.data(), ym.data(), out.data(), n, m);
+        hilbertIndexInverse(out.data(), xo.data(), yo.data(), n, m);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(out[i] == h[i]);
+            CHECK(xo[i] == xm[i] && yo[i] == ym[i]);
+        }
+        // Conversions may be performed in place.
+        hilbertToMorton(h.data(), h.data(), n, m);
+        CHECK(h == z);
+    }
+    mortonIndex(nullptr, nullptr, nullptr, 0);
+    hilbertIndexInverse(nullptr, nullptr, nullptr, 0, 10);
+}
@@ -0,0 +1,133 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the DecodedRegion class.
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/DecodedRegion.h"
+#include "lsst/sphgeom/Ellipse.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+UnitVector3d randomPoint(std::mt19937 & rng) {
+    std::normal_distribution<double> d;
+    return UnitVector3d(d(rng), d(rng), d(rng));
+}
+
+std::unique_ptr<Region> randomRegion(std::mt19937 & rng, int type) {
+    UnitVector3d c = randomPoint(rng);
+    std::uniform_real_distribution<double> u(0.01, 0.5);
+    switch (type) {
+        case 0:
+            return std::make_unique<Circle>(c, Angle(u(rng)));
+        case 1:
+            return std::make_unique<Box>(LonLat(c), Angle(u(rng)), Angle(u(rng)));
+        case 2:
+            return std::make_unique<Ellipse>(c, randomPoint(rng), Angle(2.0));
+        case 3:
+        case 4:
+        {
+            // Polygons with more vertices than fit inline are included.
+            std::vector<UnitVector3d> points;
+            std::normal_distribution<double> d(0.0, u(rng));
+            for (int j = 0; j < (type == 3 ? 5 : 40); ++j) {
+                points.push_back(UnitVector3d(c + Vector3d(d(rng), d(rng), d(rng))));
+            }
+            return std::make_unique<ConvexPolygon>(ConvexPolygon::convexHull(points));
+        }
+        default:
+        {
+            std::unique_ptr<Region> a = randomRegion(rng, 0);
+            std::unique_ptr<Region> b = randomRegion(rng, 3);
+            return std::make_unique<UnionRegion>(*a, *b);
+        }
+    }
+}
+
+TEST_CASE(DecodeAndRelate) {
+    std::mt19937 rng(5);
+    std::vector<std::unique_ptr<Region>> regions;
+    std::vector<std::vector<uint8_t>> encoded;
+    for (int i = 0; i < 300; ++i) {
+        regions.push_back(randomRegion(rng, i % 6));
+        encoded.push_back(regions.back()->encode());
+    }
+    DecodedRegion decoded;
+    CHECK(decoded.empty());
+    for (size_t i = 0; i < regions.size(); ++i) {
+        Region const & r = decoded.decode(encoded[i]);
+        CHECK(&r == decoded.get());
+        CHECK(r.encode() == encoded[i]);
+        for (size_t j = 0; j < regions.size(); j += 7) {
+            Relationship expected = regions[i]->relate(*regions[j]);
+            CHECK(r.relate(*regions[j]) == expected);
+            CHECK(DecodedRegion::relate(encoded[i], *regions[j]) == expected);
+        }
+    }
+}
+
+TEST_CASE(DecodeReusesPolygon) {
+    std::mt19937 rng(6);
+    std::unique_ptr<Region> big = randomRegion(rng, 4);
+    std::unique_ptr<Region> small = randomRegion(rng, 3);
+    DecodedRegion decoded;
+    ConvexPolygon const & p1 =
+        dynamic_cast<ConvexPolygon const &>(decoded.decode(big->encode()));
+    UnitVector3d c = p1.getCentroid();
+    CHECK(p1.contains(c));
+    Box b1 = p1.getBoundingBox();
+    // Decoding a different polygon must discard cached bounds and edges.
+    ConvexPolygon const & p2 =
+        dynamic_cast<ConvexPolygon const &>(decoded.decode(small->encode()));
+    CHECK(&p1 == &p2);
+    CHECK(p2 == dynamic_cast<ConvexPolygon const &>(*small));
+    CHECK(p2.getBoundingBox() == small->getBoundingBox());
+    CHECK(p2.contains(c) == small->contains(c));
+    CHECK(p2.getBoundingBox() != b1);
+}
+
+TEST_CASE(DecodeInvalid) {
+    DecodedRegion decoded;
+    decoded.decode(Circle(UnitVector3d::Z(), Angle(0.1)).encode());
+    CHECK(!decoded.empty());
+    std::vector<uint8_t> bad = {'x', 0, 1};
+    CHECK_THROW(decoded.decode(bad), std::runtime_error);
+    CHECK(decoded.empty());
+    CHECK_THROW(DecodedRegion::relate(bad, Box::full()), std::runtime_error);
+    std::vector<uint8_t> truncated = Box::full().encode();
+    truncated.pop_back();
+    CHECK_THROW(decoded.decode(truncated), std::runtime_error);
+    CHECK_THROW(DecodedRegion::relate(truncated, Box::full()),
+                std::runtime_error);
+}
@@ -25,10 +25,13 @@
 
 #include <limits>
 #include <memory>
+#include <random>
+#include <thread>
 #include <vector>
 
 #include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
 #include "lsst/sphgeom/Ellipse.h"
 
 #include "test.h"
@@ -141,7 +144,8 @@ TEST_CASE(FullEllipse) {
     // and intersect itself. However, the ellipse-ellipse relation
     // test is currently very inexact.
     CHECK(e.relate(e) == INTERSECTS);
-    CHECK(e.relate(Circle(UnitVector3d::X())) == INTERSECTS);
+    CHECK(e.relate(Circle(UnitVector3d::X())) == CONTAINS);
+    CHECK(e.relate(Box::fromDegrees(0, 0, 1, 1)) == CONTAINS);
     // Check constructor arguments that should produce full ellipses.
     CHECK(Ellipse(UnitVector3d::X(), Angle(PI)).isFull());
     CHECK(Ellipse(UnitVector3d::X(), UnitVector3d::Y(), Angle(PI)).isFull());
@@ -223,6 +227,244 @@ TEST_CASE(Contains2) {
     CHECK(!e.contains(-UnitVector3d::Z()));
 }
 
+TEST_CASE(FromQuadraticForm) {
+    std::vector<Ellipse> ellipses = {
+        Ellipse(UnitVector3d(1, 2, 3), UnitVector3d(3, 2, 1), Angle(1)),
+        Ellipse(UnitVector3d::X(), Angle(0.1), Angle(PI/4), Angle(PI/8)),
+        Ellipse(UnitVector3d::X(), Angle(0.1), Angle(PI/4),
+                Angle(PI/8)).complemented(),
+    };
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (Ellipse const & e: ellipses) {
+        double cota = std::fabs(tan(e.getAlpha() - Angle(0.5 * PI)));
+        double cotb = std::fabs(tan(e.getBeta() - Angle(0.5 * PI)));
+        Ellipse f = Ellipse::fromQuadraticForm(
+            e.getTransformMatrix(), e.getAlpha(), e.getBeta(), e.getGamma(),
+            cota, cotb);
+        CHECK(f.getTransformMatrix() == e.getTransformMatrix());
+        CHECK_CLOSE(f.getAlpha().asRadians(), e.getAlpha().asRadians(), 4);
+        CHECK_CLOSE(f.getBeta().asRadians(), e.getBeta().asRadians(), 4);
+        CHECK(f.getGamma() == e.getGamma());
+        for (int i = 0; i < 1000; ++i) {
+            UnitVector3d v(uniform(rng), uniform(rng), uniform(rng));
+            CHECK(f.contains(v) == e.contains(v));
+        }
+    }
+    CHECK(Ellipse::fromQuadraticForm(
+        Matrix3d(1.0), Angle(-1), Angle(-1), Angle(0), 1, 1).isEmpty());
+    CHECK(Ellipse::fromQuadraticForm(
+        Matrix3d(1.0), Angle(4), Angle(4), Angle(0), 1, 1).isFull());
+    CHECK_THROW(Ellipse::fromQuadraticForm(Matrix3d(1.0), Angle(0.5),
+                                           Angle(2), Angle(0), 1, 1),
+                std::invalid_argument);
+    CHECK_THROW(Ellipse::fromQuadraticForm(
+                    Matrix3d(1.0), Angle(1), Angle(0.5), Angle(0.9),
+                    std::numeric_limits<double>::quiet_NaN(), 1),
+                std::invalid_argument);
+}
+
+TEST_CASE(BatchContains) {
+    std::vector<Ellipse> ellipses = {
+        Ellipse(UnitVector3d(1, 2, 3), UnitVector3d(3, 2, 1), Angle(1)),
+        Ellipse(UnitVector3d::X(), Angle(0.1), Angle(PI/4), Angle(PI/8)),
+        Ellipse(UnitVector3d(-1, 1, 0), Angle(2), Angle(2.5), Angle(1)),
+        Ellipse::full(),
+        Ellipse::empty(),
+    };
+    size_t const n = 1000;
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> uniform(-2.0, 2.0);
+    std::vector<double> x(n), y(n), z(n);
+    for (size_t j = 0; j < n; ++j) {
+        x[j] = uniform(rng);
+        y[j] = uniform(rng);
+        z[j] = uniform(rng);
+    }
+    size_t const m = ellipses.size();
+    std::unique_ptr<bool[]> many(new bool[m * n]);
+    Ellipse::contains(ellipses.data(), m, x.data(), y.data(), z.data(), n,
+                      many.get());
+    std::unique_ptr<bool[]> out(new bool[n]);
+    for (size_t i = 0; i < m; ++i) {
+        Ellipse const & e = ellipses[i];
+        e.contains(x.data(), y.data(), z.data(), out.get(), n);
+        for (size_t j = 0; j < n; ++j) {
+            bool expected = e.contains(UnitVector3d(x[j], y[j], z[j]));
+            CHECK(out[j] == expected);
+            CHECK(many[i * n + j] == expected);
+        }
+    }
+}
+
+TEST_CASE(RelateCircleAndBox) {
+    // A thin ellipse centered at (0, 0), with its major axis running
+    // north-south. Its bounding circle intersects all the regions below.
+    Ellipse e(UnitVector3d::X(), Angle(0.2), Angle(0.02), Angle(0));
+    auto at = [](double lon, double lat) {
+        return UnitVector3d(LonLat::fromRadians(lon, lat));
+    };
+    CHECK(e.relate(Circle(at(0.1, 0.1), Angle(0.03))) == DISJOINT);
+    CHECK(e.relate(Circle(at(0.0, 0.1), Angle(0.01))) == CONTAINS);
+    CHECK(e.relate(Circle(at(0.05, 0.0), Angle(0.22))) == WITHIN);
+    CHECK(e.relate(Circle(at(0.0, 0.0), Angle(0.1))) == INTERSECTS);
+    CHECK(e.relate(Box::fromRadians(0.05, -0.01, 0.1, 0.01)) == DISJOINT);
+    CHECK(e.relate(Box::fromRadians(-0.1, 0.19, 0.1, 0.3)) == INTERSECTS);
+    CHECK(e.relate(Box::fromRadians(-0.005, -0.1, 0.005, 0.1)) == CONTAINS);
+    CHECK(e.relate(Box::fromRadians(-0.03, -0.21, 0.03, 0.21)) == WITHIN);
+    CHECK(e.relate(Box::fromRadians(-1.0, -0.21, 3.0, 0.21)) == WITHIN);
+    CHECK(e.relate(Box::fromRadians(0.0, -0.21, 3.0, 0.21)) == INTERSECTS);
+    CHECK(e.relate(Box::fromRadians(1.0, -0.5, 6.0, 0.5)) == DISJOINT);
+    // The inverse relations follow.
+    CHECK(Box::fromRadians(0.05, -0.01, 0.1, 0.01).relate(e) == DISJOINT);
+    CHECK(Circle(at(0.0, 0.1), Angle(0.01)).relate(e) == WITHIN);
+}
+
+TEST_CASE(RelateIsConservative) {
+    // Relationships reported for random ellipses, circles and boxes must be
+    // consistent with the point-in-region tests of random points.
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<double> u(-1.0, 1.0);
+    auto randomPoint = [&](UnitVector3d const & c, double r) {
+        return UnitVector3d(c + r * Vector3d(u(rng), u(rng), u(rng)));
+    };
+    for (int trial = 0; trial < 400; ++trial) {
+        UnitVector3d c(u(rng), u(rng), u(rng));
+        double alpha = 0.5 * (u(rng) + 1.0);
+        Ellipse e(c, Angle(alpha), Angle(alpha * 0.5 * (u(rng) + 1.0)),
+                  Angle(PI * u(rng)));
+        Circle circle(randomPoint(c, alpha), Angle(0.5 * alpha * (u(rng) + 1.0)));
+        LonLat p(randomPoint(c, alpha));
+        Box box(p, Angle(0.5 * alpha * (u(rng) + 1.0)),
+                Angle(0.5 * alpha * (u(rng) + 1.0)));
+        for (Region const * r: {static_cast<Region const *>(&circle),
+                                static_cast<Region const *>(&box)}) {
+            Relationship rel = e.relate(*r);
+            for (int i = 0; i < 200; ++i) {
+                UnitVector3d v = randomPoint(c, 2.0 * alpha);
+                bool inE = e.contains(v);
+                bool inR = r->contains(v);
+                if ((rel & DISJOINT) != 0) { CHECK(!(inE && inR)); }
+                if ((rel & CONTAINS) != 0) { CHECK(inE || !inR); }
+                if ((rel & WITHIN) != 0) { CHECK(inR || !inE); }
+            }
+        }
+    }
+}
+
+TEST_CASE(Polygons) {
+    // The outer polygon of an ellipse must contain it, and the inner polygon
+    // must be contained in it.
+    std::mt19937_64 rng(7);
+    size_t const n = 500;
+    std::vector<double> x(n), y(n), z(n);
+    Ellipse const ellipses[] = {
+        Ellipse(UnitVector3d(1, 2, 3), Angle(0.3), Angle(0.1), Angle(0.5)),
+        Ellipse(UnitVector3d(-1, 0, 0), Angle(1.2), Angle(1.1), Angle(-1.0)),
+        Ellipse(UnitVector3d(0, 0, 1), Angle(1.0e-4), Angle(0.5e-4), Angle(0))
+    };
+    for (Ellipse const & e: ellipses) {
+        for (int numVertices: {3, 5, 16, 40}) {
+            ConvexPolygon outer = e.toOuterPolygon(numVertices);
+            ConvexPolygon inner = e.toInnerPolygon(numVertices);
+            CHECK(outer.getVertices().size() == static_cast<size_t>(numVertices));
+            CHECK(inner.getVertices().size() == static_cast<size_t>(numVertices));
+            for (UnitVector3d const & v: getPointsOnEllipse(e, 100)) {
+                CHECK(outer.contains(v));
+            }
+            e.sample(n, rng, x.data(), y.data(), z.data());
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(outer.contains(UnitVector3d(x[i], y[i], z[i])));
+            }
+            inner.sample(n, rng, x.data(), y.data(), z.data());
+            for (size_t i = 0; i < n; ++i) {
+                CHECK(e.contains(UnitVector3d(x[i], y[i], z[i])));
+            }
+            for (UnitVector3d const & v: inner.getVertices()) {
+                CHECK(e.contains(v));
+            }
+        }
+        // Polygons with the default vertex count are cached.
+        CHECK(e.toOuterPolygon() == e.toOuterPolygon(Ellipse::POLYGON_VERTICES));
+        CHECK(e.toInnerPolygon() == Ellipse(e).toInnerPolygon());
+        CHECK((e.relate(e.toInnerPolygon()) & CONTAINS) != 0);
+        CHECK((e.relate(e.toOuterPolygon()) & WITHIN) != 0);
+    }
+    Ellipse const sliver(UnitVector3d(1, 2, 3), Angle(0.3), Angle(2.5e-8), Angle(0));
+    CHECK_THROW(Ellipse::empty().toOuterPolygon(), std::invalid_argument);
+    CHECK_THROW(Ellipse::full().toInnerPolygon(), std::invalid_argument);
+    CHECK_THROW(ellipses[0].toOuterPolygon(2), std::invalid_argument);
+    CHECK_THROW(sliver.toInnerPolygon(), std::invalid_argument);
+    CHECK_THROW(Ellipse(UnitVector3d::Z(), Angle(1.5), Angle(1.0), Angle(0))
+                    .toOuterPolygon(), std::invalid_argument);
+    CHECK(sliver.toOuterPolygon().contains(sliver.getCenter()));
+}
+
+TEST_CASE(RelatePolygon) {
+    Ellipse const e(UnitVector3d(1, 0, 0), Angle(0.4), Angle(0.2), Angle(0));
+    // A small polygon around the center is inside the ellipse, even though
+    // it is not inside the circle inscribed in the ellipse.
+    ConvexPolygon const p = Circle(e.getCenter(), Angle(0.05)).toOuterPolygon();
+    CHECK(e.relate(p) == CONTAINS);
+    CHECK(p.relate(e) == WITHIN);
+    // A polygon beyond the minor axis of the ellipse but inside its
+    // bounding circle is disjoint from it.
+    UnitVector3d const u = UnitVector3d::orthogonalTo(e.getCenter());
+    UnitVector3d v = e.getCenter().rotatedAround(u, Angle(0.35));
+    if (e.contains(v)) {
+        v = e.getCenter().rotatedAround(UnitVector3d(e.getCenter().cross(u)), Angle(0.35));
+    }
+    REQUIRE(!e.contains(v));
+    ConvexPolygon const q = Circle(v, Angle(0.05)).toOuterPolygon();
+    CHECK(e.relate(q) == DISJOINT);
+    CHECK(q.relate(e) == DISJOINT);
+    for (Region const * r: {static_cast<Region const *>(&p),
+                            static_cast<Region const *>(&q)}) {
+        CHECK(e.relate(*r) == invert(r->relate(e)));
+    }
+    CHECK(e.relate(Ellipse(v, Angle(0.01), Angle(0.01), Angle(0))) ==
+          DISJOINT);
+}
+
+TEST_CASE(ConcurrentRelate) {
+    // Threads relating the same ellipse race to build its cached polygons,
+    // and must all obtain the results of a serial computation.
+    Ellipse const reference(UnitVector3d(1, 2, 3), Angle(0.3), Angle(0.1),
+                            Angle(0.5));
+    std::vector<Box> boxes;
+    std::vector<Relationship> expected;
+    LonLat center(reference.getCenter());
+    for (int i = 0; i < 64; ++i) {
+        double d = 0.01 * i;
+        LonLat p = LonLat::fromRadians(center.getLon().asRadians() + d,
+                                       center.getLat().asRadians() - d);
+        boxes.push_back(Box(p, Angle(0.05), Angle(0.02 + 0.005 * i)));
+        expected.push_back(reference.relate(boxes.back()));
+    }
+    for (int trial = 0; trial < 20; ++trial) {
+        Ellipse const e(reference);
+        std::vector<char> ok(4, 1);
+        auto work = [&](size_t t) {
+            for (size_t i = 0; i < boxes.size(); ++i) {
+                if (e.relate(boxes[(i + 16 * t) % boxes.size()]) !=
+                    expected[(i + 16 * t) % boxes.size()]) {
+                    ok[t] = 0;
+                }
+            }
+        };
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < ok.size(); ++t) {
+            threads.emplace_back(work, t);
+        }
+        for (std::thread & t: threads) {
+            t.join();
+        }
+        for (char k: ok) {
+            CHECK(k == 1);
+        }
+    }
+}
+
 TEST_CASE(Codec) {
     Ellipse e = Ellipse(UnitVector3d(1, 2, 3), UnitVector3d(3, 2, 1), Angle(1));
     std::vector<uint8_t> buffer = e.encode();
@@ -0,0 +1,175 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the EnvelopeCache class.
+
+#include <memory_resource>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/EnvelopeCache.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/MemoryResourceScope.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+std::vector<Circle> makeCircles(int n) {
+    std::vector<Circle> circles;
+    for (int i = 0; i < n; ++i) {
+        circles.emplace_back(UnitVector3d(LonLat::fromDegrees(7.0 * i, 1.0 * i)),
+                             Angle::fromDegrees(0.5 + 0.01 * i));
+    }
+    return circles;
+}
+
+} // unnamed namespace
+
+TEST_CASE(Construction) {
+    CHECK_THROW(EnvelopeCache(0), std::invalid_argument);
+    EnvelopeCache cache(1 << 20);
+    CHECK(cache.getMaxBytes() == 1 << 20);
+    CHECK(cache.getBytes() == 0);
+    CHECK(cache.size() == 0);
+}
+
+TEST_CASE(CacheKeys) {
+    CHECK(HtmPixelization(3).getCacheKey() == "htm:3");
+    CHECK(HtmPixelization(3).getCacheKey() !=
+          HtmPixelization(4).getCacheKey());
+    CHECK(Mq3cPixelization(3).getCacheKey() !=
+          Q3cPixelization(3).getCacheKey());
+    CHECK(Q3cPixelization(3).getCacheKey() !=
+          Q3cPixelization(3, 0, true).getCacheKey());
+    CHECK(HealpixPixelization(3).getCacheKey() !=
+          HtmPixelization(3).getCacheKey());
+}
+
+TEST_CASE(HitsAndMisses) {
+    EnvelopeCache cache(1 << 20);
+    HtmPixelization htm(10);
+    Mq3cPixelization mq3c(10);
+    std::vector<Circle> circles = makeCircles(10);
+    for (int pass = 0; pass < 3; ++pass) {
+        for (Circle const & c : circles) {
+            CHECK(cache.envelope(htm, c) == htm.envelope(c));
+            CHECK(cache.envelope(htm, c, 8) == htm.envelope(c, 8));
+            CHECK(cache.interior(htm, c) == htm.interior(c));
+            CHECK(cache.envelope(mq3c, c) == mq3c.envelope(c));
+        }
+    }
+    CHECK(cache.size() == 40);
+    CHECK(cache.getMisses() == 40);
+    CHECK(cache.getHits() == 80);
+    CHECK(cache.getEvictions() == 0);
+    CHECK(cache.getBytes() <= cache.getMaxBytes());
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.getBytes() == 0);
+    CHECK(cache.getHits() == 80);
+}
+
+TEST_CASE(Eviction) {
+    HtmPixelization htm(12);
+    std::vector<Circle> circles = makeCircles(20);
+    EnvelopeCache cache(16384);
+    for (Circle const & c : circles) {
+        CHECK(cache.envelope(htm, c, 64) == htm.envelope(c, 64));
+        CHECK(cache.getBytes() <= cache.getMaxBytes());
+    }
+    CHECK(cache.getEvictions() > 0);
+    CHECK(cache.size() + cache.getEvictions() == circles.size());
+    // The most recently used result is still cached.
+    uint64_t hits = cache.getHits();
+    cache.envelope(htm, circles.back(), 64);
+    CHECK(cache.getHits() == hits + 1);
+    // Touching the oldest cached result protects it from the next eviction.
+    size_t oldest = circles.size() - cache.size();
+    cache.envelope(htm, circles[oldest], 64);
+    CHECK(cache.getHits() == hits + 2);
+    cache.envelope(htm, circles[0], 64);
+    cache.envelope(htm, circles[oldest], 64);
+    CHECK(cache.getHits() == hits + 3);
+    // Results larger than the cache are not stored.
+    EnvelopeCache tiny(64);
+    CHECK(tiny.envelope(htm, circles[0]) == htm.envelope(circles[0]));
+    CHECK(tiny.size() == 0);
+}
+
+TEST_CASE(MemoryResource) {
+    HtmPixelization htm(10);
+    Circle c = makeCircles(1)[0];
+    EnvelopeCache cache(1 << 20);
+    {
+        std::pmr::monotonic_buffer_resource arena;
+        MemoryResourceScope scope(arena);
+        RangeSet s = cache.envelope(htm, c);
+        CHECK(s.get_allocator().resource() == &arena);
+    }
+    // The cached copy does not refer to the released arena.
+    RangeSet s = cache.envelope(htm, c);
+    CHECK(s == htm.envelope(c));
+    CHECK(cache.getHits() == 1);
+}
+
+TEST_CASE(Concurrency) {
+    HtmPixelization htm(10);
+    std::vector<Circle> circles = makeCircles(16);
+    std::vector<RangeSet> expected;
+    for (Circle const & c : circles) {
+        expected.push_back(htm.envelope(c));
+    }
+    EnvelopeCache cache(1 << 16);
+    std::vector<std::thread> threads;
+    std::vector<int> failures(4, 0);
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int pass = 0; pass < 20; ++pass) {
+                for (size_t i = 0; i < circles.size(); ++i) {
+                    size_t j = (i + 5 * t) % circles.size();
+                    if (!(cache.envelope(htm, circles[j]) == expected[j])) {
+                        ++failures[t];
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread & t : threads) {
+        t.join();
+    }
+    for (int f : failures) {
+        CHECK(f == 0);
+    }
+    CHECK(cache.getHits() + cache.getMisses() == 4 * 20 * circles.size());
+    CHECK(cache.getBytes() <= cache.getMaxBytes());
+}
@@ -0,0 +1,123 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the executor and thread settings.
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "lsst/sphgeom/Executor.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+struct InlineExecutor : Executor {
+    std::atomic<int> submitted{0};
+
+    void submit(std::function<void()> task) override {
+        ++submitted;
+        task();
+    }
+};
+
+struct DroppingExecutor : Executor {
+    std::atomic<int> submitted{0};
+
+    void submit(std::function<void()>) override { ++submitted; }
+};
+
+struct Points {
+    std::vector<double> x, y, z;
+
+    explicit Points(size_t n) : x(n), y(n), z(n) {
+        for (size_t i = 0; i < n; ++i) {
+            double t = 0.001 * static_cast<double>(i);
+            double s = std::sin(0.37 * t);
+            x[i] = std::cos(t) * std::sqrt(1.0 - s * s);
+            y[i] = std::sin(t) * std::sqrt(1.0 - s * s);
+            z[i] = s;
+        }
+    }
+
+    std::vector<uint64_t> index(unsigned numThreads) const {
+        std::vector<uint64_t> out(x.size());
+        HtmPixelization(10).index(x.data(), y.data(), z.data(), out.data(),
+                                  x.size(), numThreads);
+        return out;
+    }
+};
+
+void reset() {
+    setExecutor(nullptr);
+    setMaxThreads(0);
+}
+
+} // unnamed namespace
+
+TEST_CASE(MaxThreads) {
+    CHECK(getMaxThreads() == 0);
+    setMaxThreads(3);
+    CHECK(getMaxThreads() == 3);
+    setMaxThreads(0);
+    CHECK(getMaxThreads() == 0);
+}
+
+TEST_CASE(DefaultExecutor) {
+    CHECK(getExecutor() == getDefaultExecutor());
+    auto e = std::make_shared<InlineExecutor>();
+    setExecutor(e);
+    CHECK(getExecutor() == e);
+    setExecutor(nullptr);
+    CHECK(getExecutor() == getDefaultExecutor());
+}
+
+TEST_CASE(Executors) {
+    Points points(100000);
+    std::vector<uint64_t> expected = points.index(1);
+    CHECK(points.index(4) == expected);
+    auto inlineExecutor = std::make_shared<InlineExecutor>();
+    setExecutor(inlineExecutor);
+    CHECK(points.index(4) == expected);
+    CHECK(inlineExecutor->submitted == 3);
+    // Operations must complete even if the executor never runs their tasks.
+    auto dropping = std::make_shared<DroppingExecutor>();
+    setExecutor(dropping);
+    CHECK(points.index(4) == expected);
+    CHECK(dropping->submitted == 3);
+    // Only the calling thread is used when the thread limit is 1.
+    setMaxThreads(1);
+    CHECK(points.index(4) == expected);
+    CHECK(dropping->submitted == 3);
+    setMaxThreads(2);
+    CHECK(points.index(4) == expected);
+    CHECK(dropping->submitted == 4);
+    reset();
+    CHECK(points.index(8) == expected);
+}
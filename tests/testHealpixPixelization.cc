@@ -0,0 +1,351 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for HEALPix indexing.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+std::vector<UnitVector3d> randomPoints(size_t n) {
+    std::mt19937 rng(12345);
+    std::normal_distribution<double> normal;
+    std::vector<UnitVector3d> points;
+    for (size_t i = 0; i < n; ++i) {
+        points.push_back(UnitVector3d(normal(rng), normal(rng), normal(rng)));
+    }
+    return points;
+}
+
+
+TEST_CASE(InvalidLevel) {
+    CHECK_THROW(HealpixPixelization(-1), std::invalid_argument);
+    CHECK_THROW((HealpixPixelization(HealpixPixelization::MAX_LEVEL + 1)),
+                std::invalid_argument);
+    HealpixPixelization p(5);
+    CHECK(p.getNside() == 32);
+    CHECK(p.universe() == RangeSet(0, 12 * 32 * 32));
+    CHECK_THROW(p.quad(12 * 32 * 32), std::invalid_argument);
+    CHECK_THROW(p.toString(12 * 32 * 32), std::invalid_argument);
+    CHECK(p.toString(100) == "100");
+}
+
+
+TEST_CASE(IndexPoint) {
+    for (int level = 0; level <= HealpixPixelization::MAX_LEVEL; ++level) {
+        HealpixPixelization p(level);
+        uint64_t const n = static_cast<uint64_t>(1) << (2 * level);
+        // In the NESTED scheme, the poles are in the last pixel of base
+        // pixel 0 and the first pixel of base pixel 8.
+        CHECK(p.index(UnitVector3d::Z()) == n - 1);
+        CHECK(p.index(UnitVector3d(0.0, 0.0, -1.0)) == 8 * n);
+        // Points well inside a base pixel map to that base pixel.
+        for (uint64_t f = 0; f < 4; ++f) {
+            double const lon = 45.0 + 90.0 * f;
+            CHECK(p.index(UnitVector3d(LonLat::fromDegrees(lon, 60.0))) / n == f);
+            CHECK(p.index(UnitVector3d(LonLat::fromDegrees(lon - 45.0, 1.0))) / n ==
+                  f + 4);
+            CHECK(p.index(UnitVector3d(LonLat::fromDegrees(lon, -60.0))) / n ==
+                  f + 8);
+        }
+    }
+    // Matches the reference implementation, e.g. healpy.ang2pix(16, π/2, 0,
+    // nest=True).
+    CHECK(HealpixPixelization(4).index(UnitVector3d::X()) == 1130);
+}
+
+
+TEST_CASE(IndexBatch) {
+    // Check that batch indexing agrees with single point indexing. The
+    // batch inputs are deliberately left unnormalized.
+    std::vector<double> x, y, z;
+    for (int lat = -90; lat <= 90; lat += 5) {
+        for (int lon = 0; lon < 360; lon += 5) {
+            UnitVector3d v(LonLat::fromDegrees(lon + 0.5 * lat, lat));
+            x.push_back(3.0 * v.x());
+            y.push_back(3.0 * v.y());
+            z.push_back(3.0 * v.z());
+        }
+    }
+    std::vector<uint64_t> indexes(x.size());
+    for (int level = 0; level <= HealpixPixelization::MAX_LEVEL; level += 3) {
+        HealpixPixelization p(level);
+        p.index(x.data(), y.data(), z.data(), indexes.data(), x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            CHECK(indexes[i] == p.index(UnitVector3d(x[i], y[i], z[i])));
+        }
+    }
+}
+
+
+TEST_CASE(PixelContainsPoints) {
+    // Every point must be inside the polygon of the pixel it maps to,
+    // including close to the poles, where pixel edges are most curved.
+    std::vector<UnitVector3d> points = randomPoints(20000);
+    for (double lat = 89.0; lat < 90.0; lat += 0.01) {
+        for (double lon = 0.0; lon < 360.0; lon += 0.7) {
+            points.push_back(UnitVector3d(LonLat::fromDegrees(lon, lat)));
+            points.push_back(UnitVector3d(LonLat::fromDegrees(lon, -lat)));
+        }
+    }
+    for (int level: {0, 1, 2, 3, 5, 8, 12, 20, 29}) {
+        HealpixPixelization p(level);
+        for (UnitVector3d const & v: points) {
+            CHECK(p.quad(p.index(v)).contains(v));
+        }
+    }
+}
+
+
+TEST_CASE(Envelope) {
+    HealpixPixelization pixelization(1);
+    RangeSet universe = pixelization.universe();
+    for (uint64_t i = 0; i < 4 * 12; ++i) {
+        UnitVector3d v = pixelization.quad(i).getCentroid();
+        CHECK(pixelization.index(v) == i);
+        Circle c(v, Angle::fromDegrees(0.1));
+        RangeSet rs = pixelization.envelope(c);
+        CHECK(rs == RangeSet(i));
+        CHECK(rs.isWithin(universe));
+    }
+}
+
+
+TEST_CASE(Interior) {
+    HealpixPixelization pixelization(2);
+    RangeSet universe = pixelization.universe();
+    for (uint64_t i = 0; i < 16 * 12; ++i) {
+        ConvexPolygon p = pixelization.quad(i);
+        RangeSet rs = pixelization.interior(p.getBoundingCircle());
+        CHECK(rs == RangeSet(i));
+        CHECK(rs.isWithin(universe));
+        rs = pixelization.interior(p);
+        CHECK(rs == RangeSet(i));
+    }
+}
+
+
+TEST_CASE(EnvelopeAndInteriorContainment) {
+    // Envelopes must contain the pixels of all points in a region, and
+    // interior pixels must be contained by the region.
+    Ellipse e(UnitVector3d(LonLat::fromDegrees(30.0, 60.0)),
+              Angle::fromDegrees(5.0),
+              Angle::fromDegrees(0.3),
+              Angle::fromDegrees(35.0));
+    Box b(LonLat::fromDegrees(100.0, -89.0), LonLat::fromDegrees(140.0, -75.0));
+    Region const * regions[] = {&e, &b};
+    HealpixPixelization pixelization(9);
+    std::vector<UnitVector3d> points = randomPoints(200000);
+    for (Region const * r: regions) {
+        RangeSet env = pixelization.envelope(*r);
+        RangeSet in = pixelization.interior(*r);
+        CHECK(!in.empty());
+        CHECK(env.contains(in));
+        for (UnitVector3d const & v: points) {
+            uint64_t i = pixelization.index(v);
+            if (r->contains(v)) {
+                CHECK(env.contains(i));
+            } else {
+                CHECK(!in.contains(i));
+            }
+        }
+        for (auto const & rng: in) {
+            for (uint64_t i = std::get<0>(rng); i != std::get<1>(rng); ++i) {
+                CHECK(r->contains(pixelization.quad(i).getCentroid()));
+            }
+        }
+    }
+}
+
+
+TEST_CASE(MaxLevelEnvelope) {
+    // Exercise the deepest possible traversal.
+    HealpixPixelization p(HealpixPixelization::MAX_LEVEL);
+    for (double lat: {-89.99, -33.3, 0.0, 50.0, 89.99}) {
+        UnitVector3d v(LonLat::fromDegrees(12.5, lat));
+        RangeSet s = p.envelope(Circle(v, Angle::fromDegrees(1.0e-7)));
+        CHECK(!s.empty());
+        CHECK(s.contains(p.index(v)));
+    }
+}
+
+
+TEST_CASE(ParallelTraversal) {
+    UnitVector3d center(1.0, -1.0, 0.5);
+    Circle c(center, Angle::fromDegrees(20.0));
+    Box b(LonLat::fromDegrees(10.0, -30.0), LonLat::fromDegrees(75.0, 45.0));
+    Region const * regions[] = {&c, &b};
+    for (int level = 0; level <= 8; level += 4) {
+        HealpixPixelization pixelization(level);
+        for (Region const * r: regions) {
+            for (size_t maxRanges: {0, 8, 100000}) {
+                RangeSet e = pixelization.envelope(*r, maxRanges);
+                RangeSet i = pixelization.interior(*r, maxRanges);
+                for (unsigned numThreads: {2, 3}) {
+                    CHECK(pixelization.envelope(
+                        *r, maxRanges, numThreads) == e);
+                    CHECK(pixelization.interior(
+                        *r, maxRanges, numThreads) == i);
+                }
+            }
+        }
+    }
+}
+
+
+TEST_CASE(Vertices) {
+    HealpixPixelization p(5);
+    HealpixPixelization cached(5, 100);
+    std::vector<uint64_t> indexes = {0, 1234, 12287, 0};
+    std::vector<double> out(
+        3 * HealpixPixelization::NUM_VERTICES * indexes.size());
+    cached.vertices(indexes.data(), indexes.size(), out.data());
+    double const * o = out.data();
+    for (uint64_t i: indexes) {
+        std::unique_ptr<Region> r = p.pixel(i);
+        ConvexPolygon const & poly = *static_cast<ConvexPolygon *>(r.get());
+        CHECK(poly == cached.quad(i));
+        for (UnitVector3d const & v: poly.getVertices()) {
+            CHECK(o[0] == v.x() && o[1] == v.y() && o[2] == v.z());
+            o += 3;
+        }
+    }
+    uint64_t invalid = 12 << 10;
+    CHECK_THROW(p.vertices(&invalid, 1, out.data()), std::invalid_argument);
+}
+
+TEST_CASE(EnvelopeAndInteriorAtLevels) {
+    std::vector<int> levels = {10, 2, 6, 0};
+    std::vector<Circle> circles = {
+        Circle(UnitVector3d(1, 1, 1), Angle(1e-5)),
+        Circle(UnitVector3d(0.3, -0.2, 0.9), Angle(0.01)),
+        Circle(UnitVector3d::Z(), Angle(0.3)),
+        Circle(UnitVector3d(-1, 0.5, 0.1), Angle(1.5))
+    };
+    for (HealpixPixelization const & pixelization: {HealpixPixelization(3)}) {
+        for (Circle const & c: circles) {
+            Box b = c.getBoundingBox();
+            for (Region const * r: {static_cast<Region const *>(&c),
+                                    static_cast<Region const *>(&b)}) {
+                std::vector<RangeSet> envelopes =
+                    pixelization.envelopeAtLevels(*r, levels);
+                std::vector<RangeSet> interiors =
+                    pixelization.interiorAtLevels(*r, levels);
+                for (size_t i = 0; i < levels.size(); ++i) {
+                    HealpixPixelization p(levels[i]);
+                    // Traversals for coarser levels can start closer to r.
+                    RangeSet e = p.envelope(*r);
+                    CHECK(envelopes[i].isWithin(e));
+                    CHECK(envelopes[i] == e || levels[i] < 10);
+                    CHECK(interiors[i] == p.interior(*r));
+                }
+            }
+        }
+    }
+    CHECK_THROW(HealpixPixelization(3).envelopeAtLevels(Circle::full(), {30}),
+                std::invalid_argument);
+}
+
+TEST_CASE(CombinedEnvelopeAndInterior) {
+    std::vector<std::unique_ptr<Region>> regions;
+    regions.emplace_back(new Circle(UnitVector3d(1, 1, 1), Angle(1e-5)));
+    regions.emplace_back(new Circle(UnitVector3d(0.3, -0.2, 0.9), Angle(0.05)));
+    regions.emplace_back(new Circle(UnitVector3d(-1, 0.5, 0.1), Angle(1.5)));
+    regions.emplace_back(new Box(LonLat::fromDegrees(10, 20),
+                                 Angle::fromDegrees(3), Angle::fromDegrees(1)));
+    regions.emplace_back(new ConvexPolygon(
+        UnitVector3d(1, 0, 0.1), UnitVector3d(1, 0.1, 0), UnitVector3d(1, 0, -0.1)));
+    regions.emplace_back(new Ellipse(UnitVector3d::Z(), Angle(0.2), Angle(0.1),
+                                     Angle(0.5)));
+    HealpixPixelization pixelization(9);
+    for (auto const & r: regions) {
+        EnvelopeAndInterior both = pixelization.envelopeAndInterior(*r);
+        RangeSet envelope = pixelization.envelope(*r);
+        RangeSet interior = pixelization.interior(*r);
+        CHECK(both.envelope == envelope);
+        CHECK(both.interior == interior);
+        for (size_t maxRanges: {1, 4, 20}) {
+            both = pixelization.envelopeAndInterior(*r, maxRanges);
+            CHECK(both.envelope.size() <= maxRanges);
+            CHECK(both.interior.size() <= maxRanges);
+            CHECK(both.envelope.contains(envelope));
+            CHECK(both.interior.isWithin(interior));
+        }
+    }
+}
+
+TEST_CASE(StringConversion) {
+    HealpixPixelization p(5);
+    std::vector<uint64_t> indexes;
+    for (uint64_t i = 0; i < 12 << 10; i += 37) {
+        indexes.push_back(i);
+    }
+    indexes.push_back((12 << 10) - 1);
+    size_t const width = p.maxStringLength();
+    CHECK(width == 5);
+    std::vector<char> buf(indexes.size() * width, 'x');
+    p.toString(indexes.data(), indexes.size(), buf.data(), width);
+    std::vector<uint64_t> parsed(indexes.size());
+    p.fromString(buf.data(), indexes.size(), width, parsed.data());
+    CHECK(parsed == indexes);
+    for (size_t k = 0; k < indexes.size(); ++k) {
+        std::string s = p.toString(indexes[k]);
+        CHECK(std::string(buf.data() + k * width, s.size()) == s);
+        CHECK(std::all_of(buf.data() + k * width + s.size(),
+                          buf.data() + (k + 1) * width,
+                          [](char c) { return c == '\0'; }));
+        CHECK(p.fromString(s) == indexes[k]);
+    }
+    // Fields wider than needed are padded.
+    std::vector<char> wide(2 * (width + 3));
+    p.toString(indexes.data(), 2, wide.data(), width + 3);
+    p.fromString(wide.data(), 2, width + 3, parsed.data());
+    CHECK(parsed[0] == indexes[0] && parsed[1] == indexes[1]);
+    CHECK_THROW(p.toString(&indexes.back(), 1, buf.data(), width - 1),
+                std::invalid_argument);
+    uint64_t invalid = 12 << 10;
+    CHECK_THROW(p.toString(&invalid, 1, buf.data(), width),
+                std::invalid_argument);
+    for (char const * s: {"", "-1", "+1", "01", "1x", "12288"}) {
+        CHECK_THROW(p.fromString(s), std::invalid_argument);
+    }
+    CHECK(p.fromString("0") == 0);
+    CHECK(HealpixPixelization(29).maxStringLength() == 19);
+}
@@ -23,10 +23,25 @@
 /// \file
 /// \brief This file contains tests for HTM indexing.
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
 #include "lsst/sphgeom/LonLat.h"
 #include "lsst/sphgeom/HtmPixelization.h"
 #include "lsst/sphgeom/UnitVector3d.h"
+#include "lsst/sphgeom/orientation.h"
 
 #include "test.h"
 
@@ -164,6 +179,104 @@ TEST_CASE(Index) {
     CHECK(s == RangeSet({704643072, 738197504, 838860800, 872415232}));
 }
 
+TEST_CASE(IndexBatch) {
+    // Check that batch indexing agrees with single point indexing. The
+    // batch inputs are deliberately left unnormalized.
+    std::vector<double> x, y, z;
+    for (int lat = -90; lat <= 90; lat += 5) {
+        for (int lon = 0; lon < 360; lon += 5) {
+            UnitVector3d v(LonLat::fromDegrees(lon + 0.5 * lat, lat));
+            x.push_back(3.0 * v.x());
+            y.push_back(3.0 * v.y());
+            z.push_back(3.0 * v.z());
+        }
+    }
+    std::vector<uint64_t> indexes(x.size());
+    for (int level = 0; level <= HtmPixelization::MAX_LEVEL; level += 3) {
+        HtmPixelization p(level);
+        p.index(x.data(), y.data(), z.data(), indexes.data(), x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            CHECK(indexes[i] == p.index(UnitVector3d(x[i], y[i], z[i])));
+        }
+    }
+}
+
+// Return the HTM index of v at the given level, obtained by subdividing
+// its root triangle with exact orientation tests at every level.
+uint64_t referenceIndex(UnitVector3d const & v, int level) {
+    static UnitVector3d const roots[8][3] = {
+        { UnitVector3d::X(), -UnitVector3d::Z(),  UnitVector3d::Y()},
+        { UnitVector3d::Y(), -UnitVector3d::Z(), -UnitVector3d::X()},
+        {-UnitVector3d::X(), -UnitVector3d::Z(), -UnitVector3d::Y()},
+        {-UnitVector3d::Y(), -UnitVector3d::Z(),  UnitVector3d::X()},
+        { UnitVector3d::X(),  UnitVector3d::Z(), -UnitVector3d::Y()},
+        {-UnitVector3d::Y(),  UnitVector3d::Z(), -UnitVector3d::X()},
+        {-UnitVector3d::X(),  UnitVector3d::Z(),  UnitVector3d::Y()},
+        { UnitVector3d::Y(),  UnitVector3d::Z(),  UnitVector3d::X()}
+    };
+    uint64_t i = HtmPixelization(0).index(v);
+    UnitVector3d v0 = roots[i - 8][0];
+    UnitVector3d v1 = roots[i - 8][1];
+    UnitVector3d v2 = roots[i - 8][2];
+    for (int l = 0; l < level; ++l) {
+        UnitVector3d m01(v0 + v1), m12(v1 + v2), m20(v2 + v0);
+        i <<= 2;
+        if (orientation(v, m01, m20) >= 0) {
+            v1 = m01; v2 = m20;
+        } else if (orientation(v, m12, m01) >= 0) {
+            v0 = v1; v1 = m12; v2 = m01;
+            i += 1;
+        } else if (orientation(v, m20, m12) >= 0) {
+            v0 = v2; v1 = m20; v2 = m12;
+            i += 2;
+        } else {
+            v0 = m12; v1 = m20; v2 = m01;
+            i += 3;
+        }
+    }
+    return i;
+}
+
+TEST_CASE(IndexNearEdges) {
+    // Points on and next to trixel edges exercise the exact fallback of
+    // the filtered orientation tests used by index().
+    std::mt19937 rng(7);
+    std::vector<UnitVector3d> points;
+    for (int level : {1, 2, 3, 4, 7, 12}) {
+        HtmPixelization p(level);
+        std::uniform_int_distribution<uint64_t> trixels(
+            static_cast<uint64_t>(8) << (2 * level),
+            (static_cast<uint64_t>(16) << (2 * level)) - 1);
+        for (int t = 0; t < 40; ++t) {
+            uint64_t i = trixels(rng);
+            double c[9];
+            p.vertices(&i, 1, c);
+            for (int j = 0; j < 3; ++j) {
+                int k = (j + 1) % 3;
+                UnitVector3d a = UnitVector3d::fromNormalized(c[3 * j], c[3 * j + 1], c[3 * j + 2]);
+                UnitVector3d b = UnitVector3d::fromNormalized(c[3 * k], c[3 * k + 1], c[3 * k + 2]);
+                Vector3d n = a.robustCross(b);
+                n.normalize();
+                for (double w : {0.5, 0.25, 1.0e-9}) {
+                    Vector3d m = a * w + b * (1.0 - w);
+                    points.push_back(UnitVector3d(m));
+                    for (double e : {1.0e-17, 1.0e-16, 1.0e-15, 1.0e-14}) {
+                        points.push_back(UnitVector3d(m + e * n));
+                        points.push_back(UnitVector3d(m - e * n));
+                    }
+                }
+                points.push_back(a);
+            }
+        }
+    }
+    for (int level = 0; level <= 20; ++level) {
+        HtmPixelization p(level);
+        for (UnitVector3d const & v : points) {
+            CHECK(p.index(v) == referenceIndex(v, level));
+        }
+    }
+}
+
 TEST_CASE(Adaptivity) {
     UnitVector3d center(1.0, 1.0, 1.0);
     for (int level = 0; level <= 13; ++level) {
@@ -191,3 +304,633 @@ TEST_CASE(Adaptivity) {
         }
     }
 }
+
+TEST_CASE(EllipseEnvelopeAndInterior) {
+    // A long, thin ellipse must not be approximated by its bounding circle.
+    Ellipse e(UnitVector3d(LonLat::fromDegrees(30.0, 20.0)),
+              Angle::fromDegrees(5.0),
+              Angle::fromDegrees(0.3),
+              Angle::fromDegrees(35.0));
+    HtmPixelization pixelization(10);
+    RangeSet env = pixelization.envelope(e);
+    RangeSet circleEnv = pixelization.envelope(e.getBoundingCircle());
+    CHECK(4 * env.cardinality() < circleEnv.cardinality());
+    for (double lon = 20.0; lon < 40.0; lon += 0.1) {
+        for (double lat = 10.0; lat < 30.0; lat += 0.1) {
+            UnitVector3d v(LonLat::fromDegrees(lon, lat));
+            if (e.contains(v)) {
+                CHECK(env.contains(pixelization.index(v)));
+            }
+        }
+    }
+    RangeSet in = pixelization.interior(e);
+    CHECK(!in.empty());
+    CHECK(env.contains(in));
+    for (auto const & r: in) {
+        for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+            ConvexPolygon pixel = HtmPixelization::triangle(i);
+            for (UnitVector3d const & v: pixel.getVertices()) {
+                CHECK(e.contains(v));
+            }
+        }
+    }
+}
+
+
+TEST_CASE(BoxEnvelopeAndInterior) {
+    // Boxes are narrow, wider than π and wrapping, or contain a pole.
+    std::vector<Box> boxes = {
+        Box(NormalizedAngleInterval::fromDegrees(10.0, 25.0),
+            AngleInterval::fromDegrees(-30.0, -5.0)),
+        Box(NormalizedAngleInterval::fromDegrees(300.0, 250.0),
+            AngleInterval::fromDegrees(-10.0, 40.0)),
+        Box(NormalizedAngleInterval::fromDegrees(100.0, 160.0),
+            AngleInterval::fromDegrees(60.0, 90.0))
+    };
+    HtmPixelization pixelization(6);
+    for (Box const & b: boxes) {
+        RangeSet env = pixelization.envelope(b);
+        RangeSet in = pixelization.interior(b);
+        CHECK(!in.empty());
+        CHECK(env.contains(in));
+        for (double lon = 0.0; lon < 360.0; lon += 1.0) {
+            for (double lat = -89.5; lat < 90.0; lat += 1.0) {
+                UnitVector3d v(LonLat::fromDegrees(lon, lat));
+                uint64_t i = pixelization.index(v);
+                if (b.contains(v)) {
+                    CHECK(env.contains(i));
+                } else {
+                    CHECK(!in.contains(i));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(CompoundEnvelopeAndInterior) {
+    Circle c1(UnitVector3d(LonLat::fromDegrees(10.0, 5.0)),
+              Angle::fromDegrees(3.0));
+    Circle c2(UnitVector3d(LonLat::fromDegrees(13.0, 6.0)),
+              Angle::fromDegrees(2.0));
+    Box b(LonLat::fromDegrees(8.0, 4.0), LonLat::fromDegrees(20.0, 7.0));
+    UnionRegion u(c1, c2);
+    IntersectionRegion i(u, b);
+    HtmPixelization pixelization(9);
+    CHECK(pixelization.envelope(u) ==
+          (pixelization.envelope(c1) | pixelization.envelope(c2)));
+    CHECK(pixelization.interior(u) ==
+          (pixelization.interior(c1) | pixelization.interior(c2)));
+    RangeSet env = pixelization.envelope(i);
+    CHECK((pixelization.envelope(u) & pixelization.envelope(b)).contains(env));
+    CHECK(pixelization.interior(i) ==
+          (pixelization.interior(u) & pixelization.interior(b)));
+    CHECK(env.contains(pixelization.interior(i)));
+    CHECK(pixelization.envelope(i, 0, 4) == env);
+    Ellipse e(UnitVector3d(LonLat::fromDegrees(12.0, 5.0)),
+              Angle::fromDegrees(4.0),
+              Angle::fromDegrees(0.5),
+              Angle::fromDegrees(60.0));
+    UnionRegion ue(c1, e);
+    CHECK(pixelization.envelope(ue) ==
+          (pixelization.envelope(c1) | pixelization.envelope(e)));
+    CHECK(pixelization.interior(ue) ==
+          (pixelization.interior(c1) | pixelization.interior(e)));
+}
+
+
+TEST_CASE(ManyVertexPolygonEnvelopeAndInterior) {
+    // Polygons with many vertices are searched for using simplified
+    // polygons, but the results must be those obtained by relating pixels
+    // to the polygon itself, which is what happens for an operand of an
+    // intersection with the full circle.
+    UnitVector3d const center(LonLat::fromDegrees(40.0, 20.0));
+    UnitVector3d const v0(LonLat::fromDegrees(40.0, 35.0));
+    std::vector<UnitVector3d> points;
+    for (int i = 0; i < 1000; ++i) {
+        points.push_back(v0.rotatedAround(center, Angle(2.0 * PI * i / 1000)));
+    }
+    ConvexPolygon const p = ConvexPolygon::convexHull(points);
+    REQUIRE(p.getVertices().size() == 1000);
+    IntersectionRegion const reference(p, Circle::full());
+    for (int level: {4, 8}) {
+        HtmPixelization pixelization(level);
+        for (size_t maxRanges: {0, 20}) {
+            CHECK(pixelization.envelope(p, maxRanges) ==
+                  pixelization.envelope(reference, maxRanges));
+            CHECK(pixelization.interior(p, maxRanges) ==
+                  pixelization.interior(reference, maxRanges));
+            CHECK(pixelization.envelope(p, maxRanges, 4) ==
+                  pixelization.envelope(reference, maxRanges));
+        }
+    }
+}
+
+
+TEST_CASE(MaxLevelEnvelope) {
+    // Exercise the deepest possible traversal.
+    HtmPixelization p(HtmPixelization::MAX_LEVEL);
+    UnitVector3d v(LonLat::fromDegrees(12.5, -33.3));
+    RangeSet s = p.envelope(Circle(v, Angle::fromDegrees(1.0e-7)));
+    CHECK(!s.empty());
+    CHECK(s.contains(p.index(v)));
+}
+
+
+TEST_CASE(ParallelTraversal) {
+    // Check that parallel traversal gives the same results as serial
+    // traversal, including when the range limit forces simplification.
+    UnitVector3d center(1.0, -1.0, 0.5);
+    Circle c(center, Angle::fromDegrees(20.0));
+    Box b(LonLat::fromDegrees(10.0, -30.0), LonLat::fromDegrees(75.0, 45.0));
+    ConvexPolygon p = ConvexPolygon::convexHull(std::vector<UnitVector3d>{
+        UnitVector3d(1.0, 0.0, 0.1),
+        UnitVector3d(0.0, 1.0, -0.2),
+        UnitVector3d(-0.3, 0.2, 1.0)});
+    Region const * regions[] = {&c, &b, &p};
+    for (int level = 0; level <= 8; level += 4) {
+        HtmPixelization pixelization(level);
+        for (Region const * r: regions) {
+            for (size_t maxRanges: {0, 8, 100, 100000}) {
+                RangeSet e = pixelization.envelope(*r, maxRanges);
+                RangeSet i = pixelization.interior(*r, maxRanges);
+                for (unsigned numThreads: {2, 3, 16}) {
+                    CHECK(pixelization.envelope(
+                        *r, maxRanges, numThreads) == e);
+                    CHECK(pixelization.interior(
+                        *r, maxRanges, numThreads) == i);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(SmallRegionParallelTraversal) {
+    // Traversals for small regions start near the region; check that
+    // parallel traversal starts from the same pixels as serial traversal.
+    for (int level: {4, 8, 12}) {
+        HtmPixelization pixelization(level);
+        for (double lon = 7.3; lon < 360.0; lon += 30.1) {
+            for (double lat = -80.9; lat < 90.0; lat += 23.2) {
+                LonLat p = LonLat::fromDegrees(lon, lat);
+                UnitVector3d v(p);
+                UnitVector3d n = UnitVector3d::northFrom(v);
+                UnitVector3d e = UnitVector3d(n.cross(v));
+                Box b(p, Angle::fromDegrees(0.01), Angle::fromDegrees(0.007));
+                Circle c(v, Angle::fromDegrees(0.02));
+                ConvexPolygon t(UnitVector3d(v + n * 3.0e-4),
+                                UnitVector3d(v - n * 2.0e-4 + e * 2.0e-4),
+                                UnitVector3d(v - n * 1.0e-4 - e * 3.0e-4));
+                Region const * regions[] = {&b, &c, &t};
+                for (Region const * r: regions) {
+                    RangeSet env = pixelization.envelope(*r);
+                    RangeSet in = pixelization.interior(*r);
+                    for (unsigned numThreads: {2, 4, 16}) {
+                        CHECK(pixelization.envelope(*r, 0, numThreads) == env);
+                        CHECK(pixelization.interior(*r, 0, numThreads) == in);
+                    }
+                }
+            }
+        }
+    }
+    HtmPixelization pixelization(8);
+    Box b(LonLat::fromDegrees(37.3, 12.1),
+          Angle::fromDegrees(0.01), Angle::fromDegrees(0.007));
+    CHECK(pixelization.envelope(b, 0, 4) == pixelization.envelope(b));
+}
+
+TEST_CASE(PixelCache) {
+    // Cached pixels must match computed ones, both when pixels are evicted
+    // and when a cache shared by copies is used from several threads.
+    HtmPixelization uncached(6);
+    HtmPixelization cached(6, 100);
+    HtmPixelization copy(cached);
+    uint64_t const first = 8 << 12;
+    std::vector<char> ok(4, 1);
+    auto work = [&](size_t t) {
+        for (int pass = 0; pass < 3; ++pass) {
+            for (uint64_t i = first; i < first + 300; i += 1 + t) {
+                HtmPixelization const & p = (t % 2 == 0) ? cached : copy;
+                if (!(*static_cast<ConvexPolygon *>(p.pixel(i).get()) ==
+                      *static_cast<ConvexPolygon *>(uncached.pixel(i).get()))) {
+                    ok[t] = 0;
+                }
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < ok.size(); ++t) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread & t: threads) {
+        t.join();
+    }
+    for (char k: ok) {
+        CHECK(k == 1);
+    }
+    CHECK_THROW(cached.pixel(0), std::invalid_argument);
+}
+
+TEST_CASE(Vertices) {
+    HtmPixelization p(5);
+    std::vector<uint64_t> indexes = {8 << 10, 9000, 16383, 8 << 10};
+    std::vector<double> out(3 * HtmPixelization::NUM_VERTICES * indexes.size());
+    p.vertices(indexes.data(), indexes.size(), out.data());
+    double const * o = out.data();
+    for (uint64_t i: indexes) {
+        std::unique_ptr<Region> r = p.pixel(i);
+        ConvexPolygon const & poly = *static_cast<ConvexPolygon *>(r.get());
+        CHECK(poly.getVertices().size() == HtmPixelization::NUM_VERTICES);
+        for (UnitVector3d const & v: poly.getVertices()) {
+            CHECK(o[0] == v.x() && o[1] == v.y() && o[2] == v.z());
+            o += 3;
+        }
+    }
+    uint64_t invalid = 0;
+    CHECK_THROW(p.vertices(&invalid, 1, out.data()), std::invalid_argument);
+}
+
+TEST_CASE(TabulatedVertices) {
+    // Trixel vertices near the root are looked up rather than computed,
+    // and must be identical to the midpoints obtained by subdividing the
+    // root triangles.
+    std::vector<UnitVector3d> expected = {
+        UnitVector3d::X(), -UnitVector3d::Z(),  UnitVector3d::Y(),
+        UnitVector3d::Y(), -UnitVector3d::Z(), -UnitVector3d::X(),
+       -UnitVector3d::X(), -UnitVector3d::Z(), -UnitVector3d::Y(),
+       -UnitVector3d::Y(), -UnitVector3d::Z(),  UnitVector3d::X(),
+        UnitVector3d::X(),  UnitVector3d::Z(), -UnitVector3d::Y(),
+       -UnitVector3d::Y(),  UnitVector3d::Z(), -UnitVector3d::X(),
+       -UnitVector3d::X(),  UnitVector3d::Z(),  UnitVector3d::Y(),
+        UnitVector3d::Y(),  UnitVector3d::Z(),  UnitVector3d::X()
+    };
+    for (int level = 0; level <= 5; ++level) {
+        HtmPixelization p(level);
+        uint64_t const n = static_cast<uint64_t>(8) << (2 * level);
+        std::vector<uint64_t> indexes(n);
+        for (uint64_t i = 0; i < n; ++i) {
+            indexes[i] = n + i;
+        }
+        std::vector<double> out(3 * HtmPixelization::NUM_VERTICES * n);
+        p.vertices(indexes.data(), n, out.data());
+        for (size_t j = 0; j < expected.size(); ++j) {
+            UnitVector3d const & v = expected[j];
+            double const * o = &out[3 * j];
+            CHECK(o[0] == v.x() && o[1] == v.y() && o[2] == v.z());
+        }
+        std::vector<UnitVector3d> children;
+        for (size_t j = 0; j < expected.size(); j += 3) {
+            UnitVector3d const * t = &expected[j];
+            UnitVector3d m0(t[1] + t[2]), m1(t[2] + t[0]), m2(t[0] + t[1]);
+            UnitVector3d const c[12] = {t[0], m2, m1, t[1], m0, m2,
+                                        t[2], m1, m0, m0, m1, m2};
+            children.insert(children.end(), c, c + 12);
+        }
+        expected.swap(children);
+    }
+}
+
+// Return true if the two trixels share a vertex.
+bool shareVertex(ConvexPolygon const & a, ConvexPolygon const & b) {
+    for (UnitVector3d const & u: a.getVertices()) {
+        for (UnitVector3d const & v: b.getVertices()) {
+            if ((u - v).getSquaredNorm() < 1e-24) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST_CASE(Neighborhood) {
+    // Compare against brute force at low subdivision levels.
+    for (int level = 0; level <= 3; ++level) {
+        uint64_t const begin = static_cast<uint64_t>(8) << (2 * level);
+        std::vector<ConvexPolygon> trixels;
+        for (uint64_t i = begin; i < 2 * begin; ++i) {
+            trixels.push_back(HtmPixelization::triangle(i));
+        }
+        for (uint64_t i = begin; i < 2 * begin; ++i) {
+            std::vector<uint64_t> expected;
+            for (uint64_t j = begin; j < 2 * begin; ++j) {
+                if (shareVertex(trixels[i - begin], trixels[j - begin])) {
+                    expected.push_back(j);
+                }
+            }
+            CHECK(HtmPixelization::neighborhood(i) == expected);
+            CHECK(expected.size() == 13 || expected.size() == 11 ||
+                  expected.size() == 7);
+        }
+    }
+    // At higher levels, compare against the envelopes of tiny circles
+    // centered on the trixel vertices.
+    uint64_t const indexes[] = {
+        0x8e3c1b5ull, 0xf000000ull, 0x8000000ull, 0xb555555ull,
+        0xc0ffee123abull, 0xfffffffffffull, 0x3d0a94e1fc372ull
+    };
+    for (uint64_t i: indexes) {
+        int level = HtmPixelization::level(i);
+        REQUIRE(level >= 0);
+        HtmPixelization pixelization(level);
+        Angle r(std::ldexp(1.0e-3, -level));
+        RangeSet expected;
+        ConvexPolygon t = HtmPixelization::triangle(i);
+        for (UnitVector3d const & v: t.getVertices()) {
+            expected |= pixelization.envelope(Circle(v, r));
+        }
+        std::vector<uint64_t> n = HtmPixelization::neighborhood(i);
+        RangeSet actual;
+        for (uint64_t j: n) {
+            actual.insert(j);
+        }
+        CHECK(actual == expected);
+        CHECK(actual.cardinality() == n.size());
+    }
+    CHECK_THROW(HtmPixelization::neighborhood(4), std::invalid_argument);
+}
+
+TEST_CASE(KRing) {
+    uint64_t const i = 0xc0ffee123abull;
+    CHECK(HtmPixelization::neighborhood(i, 0) == RangeSet(i));
+    std::vector<uint64_t> n = HtmPixelization::neighborhood(i);
+    RangeSet ring = HtmPixelization::neighborhood(i, 1);
+    CHECK(ring.cardinality() == n.size());
+    for (uint64_t j: n) {
+        CHECK(ring.contains(j));
+    }
+    for (int k = 2; k <= 4; ++k) {
+        RangeSet expected;
+        for (auto const & r: ring) {
+            for (uint64_t j = std::get<0>(r); j != std::get<1>(r); ++j) {
+                for (uint64_t m: HtmPixelization::neighborhood(j)) {
+                    expected.insert(m);
+                }
+            }
+        }
+        ring = HtmPixelization::neighborhood(i, k);
+        CHECK(ring == expected);
+    }
+    CHECK_THROW(HtmPixelization::neighborhood(i, -1), std::invalid_argument);
+    CHECK_THROW(HtmPixelization::neighborhood(0, 1), std::invalid_argument);
+}
+
+TEST_CASE(NeighborhoodBatch) {
+    std::vector<uint64_t> indexes = {8, 0x8e3c1b5, 15, 0x8e3c1b5};
+    std::vector<size_t> offsets;
+    std::vector<uint64_t> neighbors;
+    HtmPixelization::neighborhood(indexes.data(), indexes.size(),
+                                  offsets, neighbors);
+    REQUIRE(offsets.size() == indexes.size() + 1);
+    CHECK(offsets.front() == 0 && offsets.back() == neighbors.size());
+    for (size_t p = 0; p < indexes.size(); ++p) {
+        std::vector<uint64_t> expected =
+            HtmPixelization::neighborhood(indexes[p]);
+        CHECK(std::vector<uint64_t>(neighbors.begin() + offsets[p],
+                                    neighbors.begin() + offsets[p + 1]) ==
+              expected);
+    }
+    uint64_t invalid = 1;
+    CHECK_THROW(HtmPixelization::neighborhood(&invalid, 1, offsets, neighbors),
+                std::invalid_argument);
+}
+
+TEST_CASE(EnvelopeAndInteriorMany) {
+    HtmPixelization const pixelization(10);
+    std::vector<std::unique_ptr<Region>> owned;
+    for (int i = 0; i < 300; ++i) {
+        LonLat p = LonLat::fromDegrees(1.7 * i, 80.0 * std::sin(0.37 * i));
+        UnitVector3d v(p);
+        switch (i % 4) {
+            case 0:
+                owned.emplace_back(new Circle(v, Angle::fromDegrees(0.01 * (i % 50))));
+                break;
+            case 1:
+                owned.emplace_back(new Box(p, Angle::fromDegrees(0.2), Angle::fromDegrees(0.1)));
+                break;
+            case 2:
+                owned.emplace_back(new Ellipse(v, Angle::fromDegrees(0.3), Angle::fromDegrees(0.1),
+                                               Angle::fromDegrees(i)));
+                break;
+            default:
+                owned.emplace_back(new UnionRegion(
+                    Circle(v, Angle::fromDegrees(0.1)),
+                    Box(p, Angle::fromDegrees(0.05), Angle::fromDegrees(0.3))));
+                break;
+        }
+    }
+    owned.emplace_back(new Circle(Circle::full()));
+    owned.emplace_back(new Circle(Circle::empty()));
+    std::vector<Region const *> regions;
+    for (auto const & r: owned) {
+        regions.push_back(r.get());
+    }
+    for (unsigned numThreads: {1u, 3u}) {
+        std::vector<RangeSet> envelopes = pixelization.envelopeMany(regions, 0, numThreads);
+        std::vector<RangeSet> interiors = pixelization.interiorMany(regions, 0, numThreads);
+        FlatRangeSets flatEnvelopes = pixelization.envelopeManyFlat(regions, 0, numThreads);
+        FlatRangeSets flatInteriors = pixelization.interiorManyFlat(regions, 0, numThreads);
+        REQUIRE(envelopes.size() == regions.size());
+        REQUIRE(interiors.size() == regions.size());
+        REQUIRE(flatEnvelopes.size() == regions.size());
+        REQUIRE(flatInteriors.size() == regions.size());
+        for (size_t i = 0; i < regions.size(); ++i) {
+            // Starting at an ancestor can avoid conservatively reported
+            // pixels, so envelopes may be smaller than those of envelope().
+            RangeSet envelope = pixelization.envelope(*regions[i]);
+            CHECK(envelope.contains(envelopes[i]));
+            CHECK(envelopes[i].contains(interiors[i]));
+            if (dynamic_cast<Circle const *>(regions[i]) != nullptr) {
+                CHECK(envelopes[i] == envelope);
+            }
+            CHECK(interiors[i] == pixelization.interior(*regions[i]));
+            CHECK(flatEnvelopes.get(i) == envelopes[i]);
+            CHECK(flatInteriors.get(i) == interiors[i]);
+        }
+        std::vector<RangeSet> coarse = pixelization.envelopeMany(regions, 4, numThreads);
+        for (size_t i = 0; i < regions.size(); ++i) {
+            CHECK(coarse[i].size() <= 4);
+            CHECK(coarse[i].contains(envelopes[i]));
+        }
+    }
+    CHECK(pixelization.envelopeMany({}).empty());
+    CHECK(pixelization.envelopeManyFlat({}).size() == 0);
+    CHECK_THROW(pixelization.envelopeManyFlat(regions).get(regions.size()),
+                std::out_of_range);
+    regions.push_back(nullptr);
+    CHECK_THROW(pixelization.envelopeMany(regions), std::invalid_argument);
+    CHECK_THROW(pixelization.interiorManyFlat(regions), std::invalid_argument);
+}
+
+TEST_CASE(SmallRegionEnvelope) {
+    // Traversals for small regions start near the region, rather than at
+    // the root pixels. Check that pixels containing points on the boundary
+    // of small circles are never missed, in particular for circles centered
+    // on root pixel vertices and edges.
+    std::vector<UnitVector3d> centers = {
+        UnitVector3d(1, 1, 1), UnitVector3d(-1, 1, -1), UnitVector3d::X(),
+        UnitVector3d::Z(), UnitVector3d(1, -1, 0), UnitVector3d(0, 1, 1),
+        UnitVector3d(0.3, -0.2, 0.9)
+    };
+    for (HtmPixelization const & pixelization: {HtmPixelization(8), HtmPixelization(16)}) {
+        for (UnitVector3d const & v: centers) {
+            UnitVector3d u = UnitVector3d::orthogonalTo(v);
+            UnitVector3d w(v.cross(u));
+            for (double r = 1e-8; r < 0.1; r *= 3.7) {
+                Circle c(v, Angle(r));
+                RangeSet envelope = pixelization.envelope(c);
+                CHECK(envelope.contains(pixelization.index(v)));
+                CHECK(envelope.contains(pixelization.interior(c)));
+                CHECK(envelope == pixelization.envelope(c, 0, 4));
+                for (int k = 0; k < 32; ++k) {
+                    double t = k * PI / 16.0;
+                    UnitVector3d p = UnitVector3d(
+                        std::cos(0.999 * r) * v +
+                        std::sin(0.999 * r) * (std::cos(t) * u + std::sin(t) * w));
+                    CHECK(envelope.contains(pixelization.index(p)));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(UpdateEnvelope) {
+    HtmPixelization pixelization(10);
+    UnitVector3d v(0.3, -0.2, 0.9);
+    UnitVector3d u = UnitVector3d::orthogonalTo(v);
+    Circle previous(v, Angle::fromDegrees(1.0));
+    RangeSet previousEnvelope = pixelization.envelope(previous);
+    EnvelopeUpdate same = pixelization.updateEnvelope(
+        previous, previousEnvelope, Circle(v, Angle::fromDegrees(1.0)));
+    CHECK(same.envelope == previousEnvelope);
+    CHECK(same.added.empty());
+    CHECK(same.removed.empty());
+    for (double d: {1e-4, 1e-2, 1.0}) {
+        Circle moved(UnitVector3d(v + d * u), Angle::fromDegrees(1.0));
+        EnvelopeUpdate update = pixelization.updateEnvelope(
+            previous, previousEnvelope, moved, 0, 2);
+        CHECK(update.envelope == pixelization.envelope(moved));
+        CHECK(update.added == update.envelope - previousEnvelope);
+        CHECK(update.removed == previousEnvelope - update.envelope);
+        CHECK(((previousEnvelope | update.added) - update.removed) ==
+              update.envelope);
+    }
+    ConvexPolygon p = ConvexPolygon::convexHull({
+        UnitVector3d(1, 0, 0.1), UnitVector3d(1, 0.1, 0), UnitVector3d(1, 0, -0.1)
+    });
+    EnvelopeUpdate changed = pixelization.updateEnvelope(
+        previous, previousEnvelope, p, 20);
+    CHECK(changed.envelope == pixelization.envelope(p, 20));
+    CHECK(changed.removed == previousEnvelope);
+}
+
+TEST_CASE(EnvelopeAndInteriorAtLevels) {
+    std::mt19937 rng(5);
+    std::normal_distribution<double> normal;
+    std::vector<int> levels = {12, 3, 8, 12, 0};
+    HtmPixelization pixelization(5);
+    for (double radius: {1e-6, 1e-3, 0.05, 0.8}) {
+        for (int trial = 0; trial < 5; ++trial) {
+            UnitVector3d c(normal(rng), normal(rng), normal(rng));
+            Circle circle(c, Angle(radius));
+            std::vector<UnitVector3d> points;
+            for (int k = 0; k < 6; ++k) {
+                Vector3d d(normal(rng), normal(rng), normal(rng));
+                points.push_back(UnitVector3d(c + radius * d));
+            }
+            ConvexPolygon polygon = ConvexPolygon::convexHull(points);
+            for (Region const * r: {static_cast<Region const *>(&circle),
+                                    static_cast<Region const *>(&polygon)}) {
+                std::vector<RangeSet> envelopes =
+                    pixelization.envelopeAtLevels(*r, levels);
+                std::vector<RangeSet> interiors =
+                    pixelization.interiorAtLevels(*r, levels);
+                REQUIRE(envelopes.size() == levels.size());
+                REQUIRE(interiors.size() == levels.size());
+                for (size_t i = 0; i < levels.size(); ++i) {
+                    HtmPixelization p(levels[i]);
+                    // Traversals for coarser levels can start closer to r.
+                    RangeSet e = p.envelope(*r);
+                    CHECK(envelopes[i].isWithin(e));
+                    CHECK(envelopes[i] == e || levels[i] < 12);
+                    CHECK(interiors[i] == p.interior(*r));
+                }
+            }
+        }
+    }
+    CHECK(pixelization.envelopeAtLevels(Circle(UnitVector3d::X()), {}).empty());
+    CHECK_THROW(pixelization.envelopeAtLevels(Circle::full(), {3, -1}),
+                std::invalid_argument);
+    CHECK_THROW(pixelization.interiorAtLevels(Circle::full(), {25}),
+                std::invalid_argument);
+}
+
+TEST_CASE(CombinedEnvelopeAndInterior) {
+    std::vector<std::unique_ptr<Region>> regions;
+    regions.emplace_back(new Circle(UnitVector3d(1, 1, 1), Angle(1e-5)));
+    regions.emplace_back(new Circle(UnitVector3d(0.3, -0.2, 0.9), Angle(0.05)));
+    regions.emplace_back(new Circle(UnitVector3d(-1, 0.5, 0.1), Angle(1.5)));
+    regions.emplace_back(new Box(LonLat::fromDegrees(10, 20),
+                                 Angle::fromDegrees(3), Angle::fromDegrees(1)));
+    regions.emplace_back(new ConvexPolygon(
+        UnitVector3d(1, 0, 0.1), UnitVector3d(1, 0.1, 0), UnitVector3d(1, 0, -0.1)));
+    regions.emplace_back(new Ellipse(UnitVector3d::Z(), Angle(0.2), Angle(0.1),
+                                     Angle(0.5)));
+    HtmPixelization pixelization(9);
+    for (auto const & r: regions) {
+        EnvelopeAndInterior both = pixelization.envelopeAndInterior(*r);
+        RangeSet envelope = pixelization.envelope(*r);
+        RangeSet interior = pixelization.interior(*r);
+        CHECK(both.envelope == envelope);
+        CHECK(both.interior == interior);
+        for (size_t maxRanges: {1, 4, 20}) {
+            both = pixelization.envelopeAndInterior(*r, maxRanges);
+            CHECK(both.envelope.size() <= maxRanges);
+            CHECK(both.interior.size() <= maxRanges);
+            CHECK(both.envelope.contains(envelope));
+            CHECK(both.interior.isWithin(interior));
+        }
+    }
+}
+
+TEST_CASE(StringConversion) {
+    HtmPixelization p(5);
+    std::vector<uint64_t> indexes;
+    for (uint64_t i = 8 << 10; i < 16 << 10; i += 37) {
+        indexes.push_back(i);
+    }
+    indexes.push_back((16 << 10) - 1);
+    size_t const width = p.maxStringLength();
+    CHECK(width == 7);
+    std::vector<char> buf(indexes.size() * width, 'x');
+    p.toString(indexes.data(), indexes.size(), buf.data(), width);
+    std::vector<uint64_t> parsed(indexes.size());
+    p.fromString(buf.data(), indexes.size(), width, parsed.data());
+    CHECK(parsed == indexes);
+    for (size_t k = 0; k < indexes.size(); ++k) {
+        std::string s = p.toString(indexes[k]);
+        CHECK(std::string(buf.data() + k * width, s.size()) == s);
+        CHECK(std::all_of(buf.data() + k * width + s.size(),
+                          buf.data() + (k + 1) * width,
+                          [](char c) { return c == '\0'; }));
+        CHECK(p.fromString(s) == indexes[k]);
+    }
+    // Fields wider than needed are padded.
+    std::vector<char> wide(2 * (width + 3));
+    p.toString(indexes.data(), 2, wide.data(), width + 3);
+    p.fromString(wide.data(), 2, width + 3, parsed.data());
+    CHECK(parsed[0] == indexes[0] && parsed[1] == indexes[1]);
+    CHECK_THROW(p.toString(&indexes.back(), 1, buf.data(), width - 1),
+                std::invalid_argument);
+    uint64_t invalid = 3;
+    CHECK_THROW(p.toString(&invalid, 1, buf.data(), width),
+                std::invalid_argument);
+    for (char const * s: {"", "N", "X0", "N4", "S01x", "N01230123012301230123012301"}) {
+        CHECK_THROW(p.fromString(s), std::invalid_argument);
+    }
+    // Strings for pixels at other levels are accepted.
+    CHECK(p.fromString("S0") == 8);
+    CHECK(p.fromString("N32") == 62);
+    uint64_t root = 15;
+    p.toString(&root, 1, buf.data(), width);
+    CHECK(std::string(buf.data()) == "N3");
+}
@@ -0,0 +1,146 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the HybridRangeSet class.
+
+#include <vector>
+
+#include "lsst/sphgeom/HybridRangeSet.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+uint64_t const MAX = static_cast<uint64_t>(-1);
+
+struct Random {
+    uint64_t x = 123456789;
+
+    uint64_t next(uint64_t n) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        return (x >> 33) % n;
+    }
+};
+
+// Returns sets exercising all container types, block boundaries, whole
+// blocks, and the bookends of the universe.
+std::vector<RangeSet> makeSets() {
+    Random r;
+    std::vector<RangeSet> sets = {
+        RangeSet(), RangeSet(0, 0), RangeSet(0), RangeSet(MAX),
+        RangeSet(65535, 65537), RangeSet(65536, 3 * 65536),
+        RangeSet({{0, 1}, {5, 8}, {9, 0}}), RangeSet(MAX - 70000, 0)
+    };
+    // Sparse isolated integers.
+    RangeSet sparse;
+    for (int i = 0; i < 300; ++i) {
+        sparse.insert(r.next(4 * 65536));
+    }
+    sets.push_back(sparse);
+    // A dense block with many short runs, best stored as a bitmap.
+    RangeSet dense;
+    for (int i = 0; i < 30000; ++i) {
+        dense.insert(65536 + r.next(65536));
+    }
+    sets.push_back(dense);
+    // Long runs, some crossing block boundaries.
+    RangeSet runs;
+    for (int i = 0; i < 50; ++i) {
+        uint64_t first = r.next(6 * 65536);
+        runs.insert(first, first + 1 + r.next(20000));
+    }
+    sets.push_back(runs);
+    sets.push_back(sparse | runs);
+    sets.push_back(~dense);
+    sets.push_back(~runs);
+    return sets;
+}
+
+} // unnamed namespace
+
+TEST_CASE(Conversion) {
+    CHECK(HybridRangeSet().empty());
+    CHECK(HybridRangeSet(RangeSet(0, 0)).full());
+    for (RangeSet const & s: makeSets()) {
+        HybridRangeSet h(s);
+        CHECK(h.isValid());
+        CHECK(h.toRangeSet() == s);
+        CHECK(h.empty() == s.empty());
+        CHECK(h.full() == s.full());
+        CHECK(h.cardinality() == s.cardinality());
+        CHECK(h == HybridRangeSet(h.toRangeSet()));
+        for (uint64_t u: {uint64_t(0), uint64_t(1), uint64_t(65535),
+                          uint64_t(65536), uint64_t(100000), MAX - 1, MAX}) {
+            CHECK(h.contains(u) == s.contains(u));
+        }
+        for (uint64_t u = 0; u < 7 * 65536; u += 97) {
+            CHECK(h.contains(u) == s.contains(u));
+        }
+    }
+}
+
+TEST_CASE(SetOperations) {
+    std::vector<RangeSet> sets = makeSets();
+    for (RangeSet const & a: sets) {
+        HybridRangeSet ha(a);
+        CHECK(ha.complemented().isValid());
+        CHECK(ha.complemented() == HybridRangeSet(~a));
+        for (RangeSet const & b: sets) {
+            HybridRangeSet hb(b);
+            HybridRangeSet i = ha & hb;
+            HybridRangeSet u = ha | hb;
+            HybridRangeSet d = ha - hb;
+            HybridRangeSet x = ha ^ hb;
+            CHECK(i.isValid() && i == HybridRangeSet(a & b));
+            CHECK(u.isValid() && u == HybridRangeSet(a | b));
+            CHECK(d.isValid() && d == HybridRangeSet(a - b));
+            CHECK(x.isValid() && x == HybridRangeSet(a ^ b));
+        }
+    }
+}
+
+TEST_CASE(Simplify) {
+    for (RangeSet const & s: makeSets()) {
+        for (uint32_t n: {0, 1, 3, 8, 15, 16, 17, 30, 64}) {
+            HybridRangeSet h = HybridRangeSet(s).simplified(n);
+            CHECK(h.isValid());
+            CHECK(h.toRangeSet() == s.simplified(n));
+        }
+    }
+}
+
+TEST_CASE(MemoryUsage) {
+    // Every other integer in 4 blocks: a RangeSet stores 16 bytes per
+    // integer, whereas bitmaps need 1 bit per integer.
+    RangeSet s;
+    for (uint64_t u = 0; u < 4 * 65536; u += 2) {
+        s.insert(u);
+    }
+    HybridRangeSet h(s);
+    CHECK(h.isValid());
+    CHECK(h.memoryUsage() < 16 * s.size() / 32);
+    CHECK(h.toRangeSet() == s);
+}
@@ -0,0 +1,112 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the header-only kernel variants.
+
+#include "lsst/sphgeom/inlineKernels.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/constants.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+bool identical(Vector3d const & a, Vector3d const & b) {
+    return a.x() == b.x() && a.y() == b.y() && a.z() == b.z() &&
+           std::signbit(a.x()) == std::signbit(b.x()) &&
+           std::signbit(a.y()) == std::signbit(b.y()) &&
+           std::signbit(a.z()) == std::signbit(b.z());
+}
+
+std::vector<Vector3d> testVectors() {
+    std::vector<Vector3d> vectors = {
+        Vector3d(1, 0, 0), Vector3d(0, -1, 0), Vector3d(0, 0, 1),
+        Vector3d(-0.0, 0, -3), Vector3d(1, 1, 0), Vector3d(-1, 0, 1),
+        Vector3d(0, 2, -2), Vector3d(1, -1, 1), Vector3d(1e-300, 0, 2e-300),
+        Vector3d(1e300, -1e300, 1e299), Vector3d(4.9e-324, 0, 0)
+    };
+    std::mt19937 rng(12345);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::uniform_int_distribution<int> exponent(-100, 100);
+    for (int i = 0; i < 10000; ++i) {
+        double s = std::ldexp(1.0, exponent(rng));
+        vectors.emplace_back(s * uniform(rng),
+                             s * uniform(rng),
+                             (i % 7 == 0) ? 0.0 : s * uniform(rng));
+    }
+    return vectors;
+}
+
+TEST_CASE(Normalize) {
+    for (Vector3d const & v : testVectors()) {
+        Vector3d expected = v;
+        Vector3d actual = v;
+        double expectedNorm = expected.normalize();
+        double actualNorm = inlined::normalize(actual);
+        CHECK(actualNorm == expectedNorm);
+        CHECK(identical(actual, expected));
+        CHECK(identical(inlined::normalized(v), UnitVector3d(v)));
+    }
+    Vector3d zero;
+    CHECK_THROW(inlined::normalize(zero), std::runtime_error);
+    CHECK_THROW(inlined::normalized(zero), std::runtime_error);
+}
+
+TEST_CASE(UnitVectorFromAngles) {
+    std::mt19937 rng(54321);
+    std::uniform_real_distribution<double> lon(-7.0, 7.0);
+    std::uniform_real_distribution<double> lat(-PI / 2.0, PI / 2.0);
+    for (int i = 0; i < 10000; ++i) {
+        Angle a(lon(rng)), b(lat(rng));
+        CHECK(identical(inlined::unitVector(a, b), UnitVector3d(a, b)));
+    }
+    CHECK(identical(inlined::unitVector(Angle(0), Angle(PI / 2.0)),
+                    UnitVector3d(Angle(0), Angle(PI / 2.0))));
+}
+
+TEST_CASE(Orientation) {
+    std::vector<Vector3d> vectors = testVectors();
+    std::vector<UnitVector3d> u;
+    for (Vector3d const & v : vectors) {
+        u.emplace_back(v);
+    }
+    size_t n = u.size();
+    for (size_t i = 0; i + 2 < n; ++i) {
+        UnitVector3d const & a = u[i];
+        UnitVector3d const & b = u[i + 1];
+        UnitVector3d const & c = u[i + 2];
+        CHECK(inlined::orientation(a, b, c) == orientation(a, b, c));
+        // Nearly coplanar inputs must be passed on to the exact fallback.
+        if (a != -b) {
+            UnitVector3d m(a + b);
+            CHECK(inlined::orientation(a, b, m) == orientation(a, b, m));
+        }
+        CHECK(inlined::orientation(a, a, b) == 0);
+        CHECK(inlined::orientation(a, -a, b) == 0);
+    }
+}
@@ -25,6 +25,9 @@
 
 #include "lsst/sphgeom/Matrix3d.h"
 
+#include <cmath>
+#include <vector>
+
 #include "test.h"
 
 
@@ -207,3 +210,25 @@ TEST_CASE(Inverse) {
     CHECK(N * M == I);
     CHECK(M * N == I);
 }
+
+TEST_CASE(Apply) {
+    Matrix3d m(0.1, -0.7, 0.3,
+               0.9, 0.2, -0.4,
+               -0.3, 0.5, 0.8);
+    std::vector<double> x, y, z;
+    for (int i = 0; i < 23; ++i) {
+        x.push_back(std::sin(i + 0.5));
+        y.push_back(std::cos(3.0 * i) * 1.0e-3);
+        z.push_back(i * 0.1 - 1.0);
+    }
+    size_t n = x.size();
+    std::vector<double> ox(n), oy(n), oz(n);
+    m.apply(x.data(), y.data(), z.data(), ox.data(), oy.data(), oz.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+        Vector3d v = m * Vector3d(x[i], y[i], z[i]);
+        CHECK(ox[i] == v.x() && oy[i] == v.y() && oz[i] == v.z());
+    }
+    // The products may overwrite the inputs.
+    m.apply(x.data(), y.data(), z.data(), x.data(), y.data(), z.data(), n);
+    CHECK(x == ox && y == oy && z == oz);
+}
@@ -0,0 +1,103 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for memory resource scopes.
+
+#include <memory_resource>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/MemoryResourceScope.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+TEST_CASE(NoScope) {
+    CHECK(MemoryResourceScope::current() == std::pmr::get_default_resource());
+    HtmPixelization p(8);
+    RangeSet s = p.envelope(Circle(UnitVector3d(1, 1, 1), Angle(0.1)));
+    CHECK(s.get_allocator().resource() == std::pmr::get_default_resource());
+}
+
+TEST_CASE(Nesting) {
+    std::pmr::monotonic_buffer_resource a, b;
+    {
+        MemoryResourceScope sa(a);
+        CHECK(MemoryResourceScope::current() == &a);
+        {
+            MemoryResourceScope sb(b);
+            CHECK(MemoryResourceScope::current() == &b);
+        }
+        CHECK(MemoryResourceScope::current() == &a);
+    }
+    CHECK(MemoryResourceScope::current() == std::pmr::get_default_resource());
+}
+
+TEST_CASE(Decode) {
+    RangeSet s = {{1, 3}, {5, 8}, {10, 0}};
+    std::vector<uint8_t> bytes = s.encode();
+    std::pmr::monotonic_buffer_resource arena;
+    MemoryResourceScope scope(arena);
+    RangeSet t = RangeSet::decode(bytes);
+    CHECK(t == s);
+    CHECK(t.get_allocator().resource() == &arena);
+}
+
+TEST_CASE(Envelopes) {
+    // Envelopes and interiors computed in a scope allocate from its memory
+    // resource, whether or not they are found by multiple threads, and do
+    // not depend on the resource.
+    HtmPixelization htm(10);
+    Mq3cPixelization mq3c(9);
+    Q3cPixelization q3c(9);
+    HealpixPixelization healpix(9);
+    std::vector<Pixelization const *> pixelizations = {
+        &htm, &mq3c, &q3c, &healpix};
+    Circle c(UnitVector3d(1, 2, 3), Angle(0.05));
+    Box b(LonLat::fromDegrees(10, 20), LonLat::fromDegrees(13, 22));
+    ConvexPolygon p(UnitVector3d(1, 0, 0), UnitVector3d(0, 1, 0),
+                    UnitVector3d(0, 0, 1));
+    std::vector<Region const *> regions = {&c, &b, &p};
+    for (Pixelization const * pix: pixelizations) {
+        for (Region const * r: regions) {
+            for (unsigned numThreads: {1, 3}) {
+                RangeSet envelope = pix->envelope(*r, 0, numThreads);
+                RangeSet interior = pix->interior(*r, 0, numThreads);
+                std::pmr::monotonic_buffer_resource arena;
+                MemoryResourceScope scope(arena);
+                RangeSet e = pix->envelope(*r, 0, numThreads);
+                RangeSet i = pix->interior(*r, 0, numThreads);
+                CHECK(e == envelope && i == interior);
+                CHECK(e.get_allocator().resource() == &arena);
+                CHECK(i.get_allocator().resource() == &arena);
+            }
+        }
+    }
+}
@@ -0,0 +1,150 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the MOC readers and writers.
+
+#include <cstdio>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/moc.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+RangeSet fromAscii(std::string const & s) {
+    std::istringstream is(s);
+    return readMocAscii(is);
+}
+
+std::string toAscii(RangeSet const & s, int order) {
+    std::ostringstream os;
+    writeMocAscii(os, s, order);
+    return os.str();
+}
+
+// `order29` returns the order 29 pixels of the given order `order` pixels.
+RangeSet order29(int order, uint64_t first, uint64_t last) {
+    int shift = 2 * (29 - order);
+    return RangeSet(first << shift, (last + 1) << shift);
+}
+
+} // unnamed namespace
+
+TEST_CASE(AsciiParsing) {
+    RangeSet expected = order29(1, 0, 3) | order29(1, 8, 8) |
+                        order29(3, 512, 512) | order29(3, 517, 517);
+    CHECK(fromAscii("1/0-3 8 3/512,517") == expected);
+    CHECK(fromAscii("s1/0-3,8\n3/512 517\n") == expected);
+    CHECK(fromAscii("3/517 512 1/8 0-3") == expected);
+    CHECK(fromAscii("\t1/0-3 8\r\n3/512 517 5/") == expected);
+    CHECK(fromAscii("").empty());
+    CHECK(fromAscii("29/").empty());
+    CHECK(fromAscii("0/0-11") == RangeSet(0, uint64_t(12) << 58));
+    CHECK_THROW(fromAscii("1"), std::runtime_error);
+    CHECK_THROW(fromAscii("30/1"), std::runtime_error);
+    CHECK_THROW(fromAscii("0/12"), std::runtime_error);
+    CHECK_THROW(fromAscii("1/3-"), std::runtime_error);
+    CHECK_THROW(fromAscii("1/5-3"), std::runtime_error);
+    CHECK_THROW(fromAscii("1/3-4-5"), std::runtime_error);
+    CHECK_THROW(fromAscii("t1/3"), std::runtime_error);
+    CHECK_THROW(fromAscii("1/99999999999999999999"), std::runtime_error);
+}
+
+TEST_CASE(AsciiWriting) {
+    RangeSet s = order29(1, 0, 3) | order29(1, 8, 8) | order29(3, 512, 512);
+    CHECK(toAscii(s, 3) == "0/0 1/8 3/512\n");
+    CHECK(toAscii(s, 5) == "0/0 1/8 3/512 5/\n");
+    CHECK(toAscii(RangeSet(), 2) == "2/\n");
+    // Coarsening to a lower order produces a covering MOC.
+    CHECK(toAscii(order29(3, 511, 513), 1) == "1/31-32\n");
+    CHECK(toAscii(order29(3, 510, 511), 3) == "3/510-511\n");
+    CHECK_THROW(toAscii(s, 30), std::invalid_argument);
+    CHECK_THROW(toAscii(s, -1), std::invalid_argument);
+    CHECK_THROW(toAscii(RangeSet(1, 0), 29), std::invalid_argument);
+    CHECK_THROW(toAscii(RangeSet(uint64_t(12) << 58), 29),
+                std::invalid_argument);
+}
+
+TEST_CASE(RoundTrip) {
+    HealpixPixelization healpix(29);
+    Circle c(UnitVector3d(1.0, -2.0, 0.5), Angle(0.05));
+    RangeSet s = healpix.envelope(c, 200);
+    std::ostringstream ascii;
+    writeMocAscii(ascii, s);
+    std::istringstream asciiIn(ascii.str());
+    CHECK(readMocAscii(asciiIn) == s);
+    std::ostringstream fits;
+    writeMocFits(fits, s);
+    CHECK(fits.str().size() % 2880 == 0);
+    CHECK(fits.str().compare(0, 9, "SIMPLE  =") == 0);
+    std::istringstream fitsIn(fits.str());
+    CHECK(readMocFits(fitsIn) == s);
+    // Writing at a lower order coarsens.
+    std::ostringstream coarse;
+    writeMocFits(coarse, s, 10);
+    std::istringstream coarseIn(coarse.str());
+    CHECK(readMocFits(coarseIn) == s.coarsened(19).scaled(uint64_t(1) << 38));
+}
+
+TEST_CASE(FitsErrors) {
+    std::istringstream empty("");
+    CHECK_THROW(readMocFits(empty), std::runtime_error);
+    std::istringstream ascii("SIMPLE  = T");
+    CHECK_THROW(readMocFits(ascii), std::runtime_error);
+    std::ostringstream os;
+    writeMocFits(os, order29(2, 5, 9));
+    std::string truncated = os.str().substr(0, 2 * 2880 + 16);
+    std::istringstream is(truncated);
+    CHECK_THROW(readMocFits(is), std::runtime_error);
+    // Only a primary HDU.
+    std::istringstream primary(os.str().substr(0, 2880));
+    CHECK_THROW(readMocFits(primary), std::runtime_error);
+}
+
+TEST_CASE(SetAlgebra) {
+    RangeSet a = fromAscii("1/0-3");
+    RangeSet b = fromAscii("0/0 2/16");
+    CHECK((a & b) == fromAscii("1/0-3"));
+    CHECK((a | b) == fromAscii("0/0 1/0-3 2/16"));
+    CHECK((b - a) == fromAscii("2/16"));
+    CHECK(toAscii(a | b, 29) == "0/0 2/16 29/\n");
+}
+
+TEST_CASE(Files) {
+    RangeSet s = fromAscii("3/1-7 100 5/4000-4010");
+    std::string path = "testMoc.tmp";
+    for (bool fits: {true, false}) {
+        writeMoc(path, s, 5, fits);
+        CHECK(readMoc(path) == s);
+    }
+    std::remove(path.c_str());
+    CHECK_THROW(readMoc("/nonexistent/moc.fits"), std::runtime_error);
+    CHECK_THROW(writeMoc("/nonexistent/moc.fits", s), std::runtime_error);
+}
@@ -0,0 +1,149 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the MultiLevelRangeSet class.
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/MultiLevelRangeSet.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+TEST_CASE(Empty) {
+    MultiLevelRangeSet s;
+    CHECK(s.empty());
+    CHECK(s.getMaxLevel() == 0);
+    CHECK(s.size() == 0);
+    CHECK(s.flatten().empty());
+    CHECK(s.uniq().empty());
+    CHECK(MultiLevelRangeSet(RangeSet(), 5).getMaxLevel() == 5);
+    CHECK_THROW(MultiLevelRangeSet(RangeSet(), -1), std::invalid_argument);
+    CHECK_THROW(MultiLevelRangeSet(RangeSet(), 31), std::invalid_argument);
+    CHECK_THROW(s.getRanges(1), std::invalid_argument);
+}
+
+TEST_CASE(Normalization) {
+    // At level 2, [16, 37) is level 1 pixels 4 - 8 plus level 2 pixel 36.
+    MultiLevelRangeSet s(RangeSet(16, 37), 2);
+    CHECK(s.getRanges(0) == RangeSet(1));
+    CHECK(s.getRanges(1) == RangeSet(8));
+    CHECK(s.getRanges(2) == RangeSet(36));
+    CHECK(s.getNumPixels() == 3);
+    CHECK(s.flatten() == RangeSet(16, 37));
+    // Unaligned ranges need pixels at the finest level at both ends.
+    MultiLevelRangeSet t(RangeSet(3, 21), 1);
+    CHECK(t.getRanges(0) == RangeSet(1, 5));
+    CHECK(t.getRanges(1) == (RangeSet(3) | RangeSet(20)));
+    CHECK(t.flatten() == RangeSet(3, 21));
+    CHECK(t != s);
+    CHECK(t == MultiLevelRangeSet(t.flatten(), 1));
+}
+
+TEST_CASE(RandomRoundTrip) {
+    std::mt19937_64 rng(7);
+    for (int level: {0, 3, 10, 24}) {
+        std::uniform_int_distribution<uint64_t> dist(
+            0, (uint64_t(16) << (2 * level)) - 1);
+        for (int trial = 0; trial < 20; ++trial) {
+            RangeSet s;
+            for (int i = 0; i < 50; ++i) {
+                uint64_t a = dist(rng), b = dist(rng);
+                s.insert(std::min(a, b), std::max(a, b) + 1);
+            }
+            MultiLevelRangeSet m(s, level);
+            CHECK(m.flatten() == s);
+            // No four siblings are present.
+            for (int l = 1; l <= level; ++l) {
+                for (auto const & r: m.getRanges(l)) {
+                    uint64_t first = std::get<0>(r);
+                    uint64_t last = std::get<1>(r);
+                    CHECK(last - first < 7);
+                    CHECK(((first + 3) & ~uint64_t(3)) + 4 > last);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(Envelopes) {
+    Circle c(UnitVector3d(1.0, 2.0, -1.0), Angle(0.3));
+    HtmPixelization htm(12);
+    Mq3cPixelization mq3c(12);
+    HealpixPixelization healpix(12);
+    MultiLevelRangeSet h = htm.multiLevelEnvelope(c);
+    MultiLevelRangeSet m = mq3c.multiLevelEnvelope(c);
+    MultiLevelRangeSet p = healpix.multiLevelEnvelope(c);
+    CHECK(h.flatten() == htm.envelope(c));
+    CHECK(m.flatten() == mq3c.envelope(c));
+    CHECK(p.flatten() == healpix.envelope(c));
+    CHECK(p == MultiLevelRangeSet(healpix.envelope(c), 12));
+    // The interior of a large circle is mostly made of coarse pixels.
+    for (MultiLevelRangeSet const * s: {&h, &m, &p}) {
+        CHECK(s->getNumPixels() < s->flatten().cardinality() / 100);
+        CHECK(!s->getRanges(6).empty());
+    }
+    CHECK(htm.multiLevelInterior(c).flatten() == htm.interior(c));
+    CHECK(mq3c.multiLevelInterior(c, 64).flatten() == mq3c.interior(c, 64));
+}
+
+TEST_CASE(Uniq) {
+    Circle c(UnitVector3d(1.0, 2.0, -1.0), Angle(0.1));
+    HealpixPixelization healpix(10);
+    MultiLevelRangeSet s = healpix.multiLevelEnvelope(c);
+    std::vector<uint64_t> u = s.uniq();
+    CHECK(u.size() == s.getNumPixels());
+    CHECK(std::is_sorted(u.begin(), u.end()));
+    CHECK(MultiLevelRangeSet::fromUniq(u) == s);
+    std::vector<uint64_t> shuffled(u.rbegin(), u.rend());
+    CHECK(MultiLevelRangeSet::fromUniq(shuffled, 10) == s);
+    CHECK(MultiLevelRangeSet::fromUniq(u, 12).flatten() ==
+          s.flatten().scaled(16));
+    // Level 0 pixel 11 and level 1 pixel 0 - the latter also covers
+    // 4 level 2 pixels, which are redundant.
+    std::vector<uint64_t> v = {4 + 11, 16 + 0, 64 + 0, 64 + 1, 64 + 2, 64 + 3};
+    MultiLevelRangeSet t = MultiLevelRangeSet::fromUniq(v);
+    CHECK(t.getMaxLevel() == 2);
+    CHECK(t.uniq() == std::vector<uint64_t>({15, 16}));
+    CHECK_THROW(MultiLevelRangeSet::fromUniq({3}), std::invalid_argument);
+    CHECK_THROW(MultiLevelRangeSet::fromUniq(v, 1), std::invalid_argument);
+    // HTM indexes cannot be NUNIQ encoded.
+    CHECK_THROW(MultiLevelRangeSet(RangeSet(15), 0).uniq(),
+                std::invalid_argument);
+}
+
+TEST_CASE(Stream) {
+    std::ostringstream os;
+    os << MultiLevelRangeSet(RangeSet(16, 37), 2);
+    CHECK(os.str() == "{\"MultiLevelRangeSet\": {\"0\": {\"RangeSet\": [[1, 2]]}, "
+                      "\"1\": {\"RangeSet\": [[8, 9]]}, "
+                      "\"2\": {\"RangeSet\": [[36, 37]]}}}");
+}
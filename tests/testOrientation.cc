@@ -25,6 +25,11 @@
 
 #include "lsst/sphgeom/orientation.h"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
 #include "test.h"
 
 using namespace lsst::sphgeom;
@@ -99,3 +104,115 @@ TEST_CASE(OrientationOverflow) {
     Vector3d v2(1.0e300, 0.0, 1.0e300);
     CHECK(orientationExact(v0, v1, v2) == 1);
 }
+
+TEST_CASE(OrientationNearlyCoplanar) {
+    // Nearly coplanar inputs are decided by the expansion stage, which
+    // must agree with arbitrary precision arithmetic.
+    std::mt19937 rng(5);
+    std::normal_distribution<double> d;
+    resetOrientationStatistics();
+    enableOrientationStatistics(true);
+    for (int i = 0; i < 10000; ++i) {
+        UnitVector3d a(d(rng), d(rng), d(rng));
+        UnitVector3d b(d(rng), d(rng), d(rng));
+        double e = (i % 2 == 0) ? 0.0 : 1.0e-17 * d(rng);
+        UnitVector3d c(d(rng) * a + d(rng) * b +
+                       e * Vector3d(d(rng), d(rng), d(rng)));
+        CHECK(orientation(a, b, c) == orientationExact(a, b, c));
+        CHECK(orientation(b, c, a) == orientationExact(b, c, a));
+        UnitVector3d p = UnitVector3d::fromNormalized(0.0, a.y(), a.z());
+        UnitVector3d q(UnitVector3d::X() * d(rng) + d(rng) * p);
+        CHECK(orientationX(p, q) == orientationExact(UnitVector3d::X(), p, q));
+    }
+    enableOrientationStatistics(false);
+    OrientationStatistics s = getOrientationStatistics();
+    CHECK(s.fast + s.permanent + s.degenerate + s.expansion + s.exact ==
+          30000u);
+    CHECK(s.expansion > 10000u);
+    CHECK(s.exact == 0u);
+    orientation(UnitVector3d::X(), UnitVector3d::Y(), UnitVector3d::Z());
+    CHECK(getOrientationStatistics().fast == s.fast);
+    resetOrientationStatistics();
+    CHECK(getOrientationStatistics().expansion == 0u);
+}
+
+TEST_CASE(OrientationStatisticsUnderflow) {
+    // Tiny components are handled with arbitrary precision arithmetic.
+    UnitVector3d v0 = UnitVector3d::X();
+    UnitVector3d v1 = UnitVector3d::fromNormalized(1.0, 1.0e-300, 0.0);
+    UnitVector3d v2 = UnitVector3d::fromNormalized(1.0, 0.0, 1.0e-300);
+    resetOrientationStatistics();
+    enableOrientationStatistics(true);
+    CHECK(orientation(v0, v1, v2) == 1);
+    enableOrientationStatistics(false);
+    CHECK(getOrientationStatistics().exact == 1u);
+}
+
+TEST_CASE(OrientationExactExponentRange) {
+    // Products in the determinant span the full range of double exponents.
+    double const tiny = 4.9406564584124654e-324;
+    double const huge = 1.7976931348623157e308;
+    CHECK(orientationExact(Vector3d(huge, 0, 0),
+                           Vector3d(0, tiny, 0),
+                           Vector3d(0, 0, tiny)) == 1);
+    CHECK(orientationExact(Vector3d(huge, tiny, 0),
+                           Vector3d(huge, 0, huge),
+                           Vector3d(0, huge, tiny)) == -1);
+    // a.x·b.y·c.z = huge³ and a.y·b.z·c.x = tiny³ with all other products
+    // zero: the tiny product must not be lost.
+    CHECK(orientationExact(Vector3d(huge, tiny, 0),
+                           Vector3d(0, huge, tiny),
+                           Vector3d(tiny, 0, huge)) == 1);
+    // Exact cancellation between differently scaled but equal products.
+    CHECK(orientationExact(Vector3d(3.0, 0.75, 0.0),
+                           Vector3d(2.0, 0.5, 0.0),
+                           Vector3d(0.0, 0.0, tiny)) == 0);
+    Vector3d a(std::ldexp(3.0, 900), std::ldexp(0.75, -1060), 0.0);
+    Vector3d b(std::ldexp(2.0, 900), std::ldexp(0.5, -1060), 0.0);
+    CHECK(orientationExact(a, b, Vector3d(0.0, 0.0, 1.0)) == 0);
+    // A difference of 1 unit in the last place of one component decides
+    // the sign.
+    double const x = 1.0 + 2.220446049250313e-16;
+    CHECK(orientationExact(Vector3d(x, 0.75, 0.0),
+                           Vector3d(4.0, 3.0, 0.0),
+                           Vector3d(0.0, 0.0, tiny)) == 1);
+    CHECK(orientationExact(Vector3d(x, 0.75, 0.0),
+                           Vector3d(4.0, 3.0, 0.0),
+                           Vector3d(0.0, 0.0, -huge)) == -1);
+}
+
+TEST_CASE(OrientationBatch) {
+    std::mt19937 rng(11);
+    std::normal_distribution<double> d;
+    std::vector<UnitVector3d> a, b, c;
+    for (int i = 0; i < 1003; ++i) {
+        UnitVector3d u(d(rng), d(rng), d(rng));
+        UnitVector3d v(d(rng), d(rng), d(rng));
+        a.push_back(u);
+        b.push_back(v);
+        switch (i % 4) {
+            case 0: c.push_back(UnitVector3d(d(rng), d(rng), d(rng))); break;
+            case 1: c.push_back(UnitVector3d(d(rng) * u + d(rng) * v)); break;
+            case 2: c.push_back(u); break;
+            default: c.push_back(-v); break;
+        }
+    }
+    std::vector<int> out(a.size());
+    for (size_t n : {a.size(), size_t(0), size_t(1), size_t(3), size_t(6)}) {
+        std::fill(out.begin(), out.end(), 2);
+        orientationBatch(a.data(), b.data(), c.data(), out.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(out[i] == orientation(a[i], b[i], c[i]));
+        }
+        for (size_t i = n; i < out.size(); ++i) {
+            CHECK(out[i] == 2);
+        }
+    }
+    for (size_t n : {a.size(), size_t(1), size_t(2), size_t(5)}) {
+        std::fill(out.begin(), out.end(), 2);
+        orientationEdges(c[1], b.data(), out.data(), n);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(out[i] == orientation(c[1], b[i], b[(i + 1) % n]));
+        }
+    }
+}
@@ -0,0 +1,156 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+/// \file
+/// \brief This file contains tests for the library performance counters.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/PerformanceCounters.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+TEST_CASE(CountersAreEnabled) {
+    CHECK(PerformanceSnapshot::ENABLED);
+}
+
+TEST_CASE(Names) {
+    for (size_t i = 0; i < NUM_PERFORMANCE_COUNTERS; ++i) {
+        char const * name =
+            PerformanceSnapshot::getName(static_cast<PerformanceCounter>(i));
+        REQUIRE(name != nullptr);
+        CHECK(std::strlen(name) > 0);
+        for (size_t j = 0; j < i; ++j) {
+            CHECK(std::strcmp(name, PerformanceSnapshot::getName(
+                static_cast<PerformanceCounter>(j))) != 0);
+        }
+    }
+    CHECK(std::strcmp(PerformanceSnapshot::getName(
+        PerformanceCounter::HTM_ENVELOPE_CALLS), "htm.envelope.calls") == 0);
+    CHECK_THROW(PerformanceSnapshot::getName(
+        static_cast<PerformanceCounter>(NUM_PERFORMANCE_COUNTERS)),
+        std::invalid_argument);
+}
+
+TEST_CASE(CountAndReset) {
+    HtmPixelization pixelization(8);
+    Circle c(UnitVector3d(1, 1, 1), Angle(0.01));
+    resetPerformanceCounters();
+    PerformanceSnapshot s = getPerformanceCounters();
+    for (uint64_t v: s.values) {
+        CHECK(v == 0);
+    }
+    pixelization.envelope(c);
+    pixelization.envelope(c);
+    pixelization.interior(c);
+    s = getPerformanceCounters();
+    CHECK(s[PerformanceCounter::HTM_ENVELOPE_CALLS] == 2);
+    CHECK(s[PerformanceCounter::HTM_INTERIOR_CALLS] == 1);
+    CHECK(s[PerformanceCounter::HTM_ENVELOPE_NANOSECONDS] > 0);
+    CHECK(s[PerformanceCounter::Q3C_ENVELOPE_CALLS] == 0);
+    resetPerformanceCounters();
+    s = getPerformanceCounters();
+    CHECK(s[PerformanceCounter::HTM_ENVELOPE_CALLS] == 0);
+    CHECK(s[PerformanceCounter::HTM_ENVELOPE_NANOSECONDS] == 0);
+}
+
+TEST_CASE(RelateAndMergeCounts) {
+    Box b = Box::fromDegrees(0, 0, 10, 10);
+    Circle c(UnitVector3d(1, 0, 0), Angle(0.1));
+    resetPerformanceCounters();
+    b.relate(c);
+    c.relate(b);
+    c.relate(c);
+    ConvexPolygon p(UnitVector3d::X(), UnitVector3d::Y(), UnitVector3d::Z());
+    p.relate(c);
+    c.relate(p);
+    RangeSet r1({{1, 3}, {5, 7}});
+    RangeSet r2({{2, 6}});
+    RangeSet r3 = r1 | r2;
+    r3 &= r1;
+    PerformanceSnapshot s = getPerformanceCounters();
+    CHECK(s[PerformanceCounter::RELATE_BOX_CIRCLE] == 2);
+    CHECK(s[PerformanceCounter::RELATE_CIRCLE_CIRCLE] == 1);
+    CHECK(s[PerformanceCounter::RELATE_CONVEX_POLYGON_CIRCLE] == 2);
+    CHECK(s[PerformanceCounter::RANGE_SET_MERGES] == 2);
+    CHECK(s[PerformanceCounter::RANGE_SET_MERGE_RANGES] >= 3 + 3);
+}
+
+TEST_CASE(DecodeCounts) {
+    std::vector<uint8_t> bytes = Circle(UnitVector3d(0, 0, 1)).encode();
+    resetPerformanceCounters();
+    Region::decode(bytes);
+    PerformanceSnapshot s = getPerformanceCounters();
+    CHECK(s[PerformanceCounter::REGION_DECODE_CALLS] == 1);
+    CHECK(s[PerformanceCounter::REGION_DECODE_BYTES] == bytes.size());
+}
+
+TEST_CASE(CountsFromOtherThreads) {
+    HtmPixelization pixelization(6);
+    Circle c(UnitVector3d(0, 1, 1), Angle(0.05));
+    resetPerformanceCounters();
+    std::thread t1([&]() { pixelization.envelope(c); });
+    std::thread t2([&]() { pixelization.envelope(c); });
+    t1.join();
+    t2.join();
+    pixelization.envelope(c);
+    PerformanceSnapshot s = getPerformanceCounters();
+    CHECK(s[PerformanceCounter::HTM_ENVELOPE_CALLS] == 3);
+    // Resetting discards the counts of threads that have exited.
+    resetPerformanceCounters();
+    std::thread([&]() { pixelization.interior(c); }).join();
+    s = getPerformanceCounters();
+    CHECK(s[PerformanceCounter::HTM_ENVELOPE_CALLS] == 0);
+    CHECK(s[PerformanceCounter::HTM_INTERIOR_CALLS] == 1);
+}
+
+TEST_CASE(Callback) {
+    std::atomic<int> calls(0);
+    CHECK_THROW(setPerformanceCallback(
+        [](PerformanceSnapshot const &) {}, std::chrono::milliseconds(0)),
+        std::invalid_argument);
+    setPerformanceCallback(
+        [&calls](PerformanceSnapshot const &) {
+            ++calls;
+            throw std::runtime_error("ignored");
+        },
+        std::chrono::milliseconds(1));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (calls < 2 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    setPerformanceCallback(nullptr, std::chrono::milliseconds(0));
+    CHECK(calls >= 2);
+    int n = calls;
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    CHECK(calls == n);
+}
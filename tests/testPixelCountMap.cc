@@ -0,0 +1,180 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the PixelCountMap class.
+
+#include <cstdint>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/PixelCountMap.h"
+#include "lsst/sphgeom/RangeSet.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+// `checkEqual` checks that m holds exactly the non-zero weights in w.
+void checkEqual(PixelCountMap const & m, std::map<uint64_t, double> const & w) {
+    size_t numPixels = 0;
+    double total = 0.0;
+    for (auto const & e: w) {
+        CHECK(m.get(e.first) == e.second);
+        if (e.second != 0.0) {
+            ++numPixels;
+            total += e.second;
+        }
+    }
+    CHECK(m.getNumPixels() == numPixels);
+    CHECK(m.total() == total);
+    PixelCountRuns runs = m.getRuns();
+    CHECK(runs.size() == m.size());
+    RangeSet pixels;
+    for (size_t i = 0; i < runs.size(); ++i) {
+        CHECK(runs.value[i] != 0.0);
+        CHECK(runs.begin[i] < runs.end[i]);
+        if (i > 0) {
+            CHECK(runs.end[i - 1] <= runs.begin[i]);
+            CHECK(runs.end[i - 1] < runs.begin[i] ||
+                  runs.value[i - 1] != runs.value[i]);
+        }
+        for (uint64_t j = runs.begin[i]; j < runs.end[i]; ++j) {
+            auto it = w.find(j);
+            REQUIRE(it != w.end());
+            CHECK(it->second == runs.value[i]);
+        }
+        pixels.insert(runs.begin[i], runs.end[i]);
+    }
+    CHECK(m.getPixels() == pixels);
+}
+
+TEST_CASE(Construction) {
+    PixelCountMap m(10);
+    CHECK(m.getLevel() == 10);
+    CHECK(m.empty());
+    CHECK(m.size() == 0);
+    CHECK(m.total() == 0.0);
+    CHECK(m.get(3) == 0.0);
+    CHECK(m.getPixels().empty());
+    CHECK_THROW(PixelCountMap(-1), std::invalid_argument);
+    CHECK_THROW(PixelCountMap(31), std::invalid_argument);
+    CHECK_THROW(m.coarsened(11), std::invalid_argument);
+    CHECK_THROW(m.add(PixelCountMap(9)), std::invalid_argument);
+}
+
+TEST_CASE(AddIndexes) {
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<uint64_t> u(0, 5000);
+    std::vector<uint64_t> indexes(300000);
+    std::vector<double> weights(indexes.size());
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        indexes[i] = u(rng);
+        // Small integer weights keep sums exact.
+        weights[i] = static_cast<double>(u(rng) % 7) - 3.0;
+    }
+    std::map<uint64_t, double> counts;
+    std::map<uint64_t, double> sums;
+    for (size_t i = 0; i < indexes.size(); ++i) {
+        counts[indexes[i]] += 1.0;
+        sums[indexes[i]] += weights[i];
+    }
+    for (unsigned numThreads: {1u, 3u}) {
+        PixelCountMap c(12);
+        c.add(indexes.data(), nullptr, indexes.size(), numThreads);
+        checkEqual(c, counts);
+        PixelCountMap s(12);
+        s.add(indexes.data(), weights.data(), indexes.size(), numThreads);
+        checkEqual(s, sums);
+    }
+    // Accumulating in several calls gives the same result.
+    PixelCountMap m(12);
+    for (size_t i = 0; i < indexes.size(); i += 100000) {
+        m.add(indexes.data() + i, weights.data() + i, 100000);
+    }
+    checkEqual(m, sums);
+    m.add(indexes[0], -sums[indexes[0]]);
+    sums[indexes[0]] = 0.0;
+    checkEqual(m, sums);
+}
+
+TEST_CASE(AddRanges) {
+    PixelCountMap m(5);
+    std::map<uint64_t, double> w;
+    m.add(RangeSet(10, 30), 2.0);
+    m.add(RangeSet({{20, 40}, {50, 52}}), 1.5);
+    m.add(25, -3.5);
+    uint64_t indexes[] = {9, 30, 45, 30};
+    m.add(indexes, nullptr, 4);
+    for (uint64_t i = 10; i < 30; ++i) { w[i] += 2.0; }
+    for (uint64_t i = 20; i < 40; ++i) { w[i] += 1.5; }
+    for (uint64_t i = 50; i < 52; ++i) { w[i] += 1.5; }
+    w[25] -= 3.5;
+    for (uint64_t i: indexes) { w[i] += 1.0; }
+    checkEqual(m, w);
+    CHECK(m.size() == 7);
+    PixelCountMap n(5);
+    n.add(RangeSet(0, 64), 1.0);
+    n.add(m);
+    for (uint64_t i = 0; i < 64; ++i) { w[i] += 1.0; }
+    checkEqual(n, w);
+    // A set reaching the end of the index space.
+    PixelCountMap e(30);
+    e.add(RangeSet(~static_cast<uint64_t>(0) - 3, 0), 1.0);
+    e.add(~static_cast<uint64_t>(0), 1.0);
+    CHECK(e.getNumPixels() == 4);
+    CHECK(e.get(~static_cast<uint64_t>(0)) == 2.0);
+    CHECK(e.getPixels() == RangeSet(~static_cast<uint64_t>(0) - 3, 0));
+    CHECK(e.getRuns().end.back() == 0);
+    CHECK(e.coarsened(29).get(~static_cast<uint64_t>(0) >> 2) == 5.0);
+}
+
+TEST_CASE(Coarsening) {
+    std::mt19937_64 rng(2);
+    std::uniform_int_distribution<uint64_t> u(0, 1 << 14);
+    PixelCountMap m(7);
+    std::vector<uint64_t> indexes(20000);
+    for (uint64_t & i: indexes) {
+        i = u(rng);
+    }
+    m.add(indexes.data(), nullptr, indexes.size());
+    m.add(RangeSet({{100, 3000}, {4097, 4099}, {8000, 12000}}), 0.5);
+    for (int level = 7; level >= 0; --level) {
+        PixelCountMap c = m.coarsened(level);
+        CHECK(c.getLevel() == level);
+        std::map<uint64_t, double> w;
+        int const shift = 2 * (7 - level);
+        for (uint64_t i = 0; i <= (1 << 14); ++i) {
+            double v = m.get(i);
+            if (v != 0.0) {
+                w[i >> shift] += v;
+            }
+        }
+        checkEqual(c, w);
+        if (level < 7) {
+            CHECK(c == m.coarsened(level + 1).coarsened(level));
+        }
+    }
+    CHECK(m.coarsened(7) == m);
+}
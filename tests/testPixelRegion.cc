@@ -0,0 +1,307 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the PixelRegion class.
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Box3d.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/PixelRegion.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/UnitVector3d.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+std::vector<std::unique_ptr<Pixelization>> makePixelizations(int level) {
+    std::vector<std::unique_ptr<Pixelization>> p;
+    p.push_back(std::make_unique<HtmPixelization>(level));
+    p.push_back(std::make_unique<Q3cPixelization>(level));
+    p.push_back(std::make_unique<Q3cPixelization>(level, 0, true));
+    p.push_back(std::make_unique<Mq3cPixelization>(level));
+    p.push_back(std::make_unique<HealpixPixelization>(level));
+    return p;
+}
+
+std::vector<UnitVector3d> makePoints(size_t n) {
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> d(-1.0, 1.0);
+    std::vector<UnitVector3d> points;
+    while (points.size() < n) {
+        Vector3d v(d(rng), d(rng), d(rng));
+        if (v.getSquaredNorm() > 1.0e-3 && v.getSquaredNorm() <= 1.0) {
+            points.push_back(UnitVector3d(v));
+        }
+    }
+    return points;
+}
+
+TEST_CASE(Construction) {
+    HtmPixelization htm(3);
+    PixelRegion r(htm, RangeSet(8 * 64, 9 * 64));
+    CHECK(r.getLevel() == 3);
+    CHECK(r.getPixels() == RangeSet(8 * 64, 9 * 64));
+    CHECK(r.getPixelization().getCacheKey() == "htm:3");
+    CHECK(!r.isEmpty());
+    CHECK(PixelRegion(htm, RangeSet()).isEmpty());
+    CHECK_THROW(PixelRegion(htm, RangeSet(0, 8 * 64 + 1)),
+                std::invalid_argument);
+    std::unique_ptr<Region> c = r.clone();
+    CHECK(dynamic_cast<PixelRegion const &>(*c) == r);
+    CHECK(PixelRegion(Q3cPixelization(3), RangeSet(0, 64)) !=
+          PixelRegion(Q3cPixelization(3, 0, true), RangeSet(0, 64)));
+}
+
+TEST_CASE(Contains) {
+    Circle const circle(UnitVector3d(LonLat::fromDegrees(30.0, 20.0)),
+                        Angle::fromDegrees(15.0));
+    std::vector<UnitVector3d> points = makePoints(5000);
+    std::vector<double> x, y, z;
+    for (UnitVector3d const & v: points) {
+        x.push_back(v.x());
+        y.push_back(v.y());
+        z.push_back(v.z());
+    }
+    for (auto const & p: makePixelizations(5)) {
+        RangeSet pixels = p->envelope(circle);
+        PixelRegion r(*p, pixels);
+        std::unique_ptr<bool[]> out(new bool[points.size()]);
+        r.contains(x.data(), y.data(), z.data(), out.get(), points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            bool expected = pixels.contains(p->index(points[i]));
+            CHECK(r.contains(points[i]) == expected);
+            CHECK(out[i] == expected);
+            if (circle.contains(points[i])) {
+                CHECK(expected);
+            }
+        }
+    }
+}
+
+TEST_CASE(Bounds) {
+    std::vector<UnitVector3d> points = makePoints(5000);
+    Circle const circle(UnitVector3d(LonLat::fromDegrees(-100.0, -60.0)),
+                        Angle::fromDegrees(10.0));
+    for (int level: {0, 4, 9}) {
+        for (auto const & p: makePixelizations(level)) {
+            for (PixelRegion const & r: {PixelRegion(*p, p->universe()),
+                                         PixelRegion(*p, p->envelope(circle)),
+                                         PixelRegion(*p, p->interior(circle))}) {
+                Box const b = r.getBoundingBox();
+                Box3d const b3 = r.getBoundingBox3d();
+                Circle const c = r.getBoundingCircle();
+                for (UnitVector3d const & v: points) {
+                    if (r.contains(v)) {
+                        CHECK(b.contains(v));
+                        CHECK(b3.contains(v));
+                        CHECK(c.contains(v));
+                    }
+                }
+            }
+        }
+    }
+    // Bounds of a pixel region with no pixels are empty.
+    PixelRegion const empty(HtmPixelization(2), RangeSet());
+    CHECK(empty.getBoundingBox().isEmpty());
+    CHECK(empty.getBoundingBox3d().isEmpty());
+    CHECK(empty.getBoundingCircle().isEmpty());
+    // The universe of the finest modified Q3C pixelization ends at 2⁶⁴,
+    // and a single fine pixel has small bounds.
+    Mq3cPixelization const mq3c(Mq3cPixelization::MAX_LEVEL);
+    UnitVector3d const v(LonLat::fromDegrees(10.0, -80.0));
+    uint64_t const i = mq3c.index(v);
+    PixelRegion const full(mq3c, mq3c.universe());
+    CHECK(full.getBoundingCircle().isFull());
+    PixelRegion const one(mq3c, RangeSet(i));
+    CHECK(one.getBoundingCircle().contains(v));
+    CHECK(one.getBoundingCircle().getOpeningAngle() <
+          Angle::fromDegrees(1.0e-4));
+}
+
+TEST_CASE(Relate) {
+    Circle const circle(UnitVector3d(LonLat::fromDegrees(200.0, 45.0)),
+                        Angle::fromDegrees(8.0));
+    Circle const inner(UnitVector3d(LonLat::fromDegrees(200.0, 45.0)),
+                       Angle::fromDegrees(1.0));
+    Circle const far(UnitVector3d(LonLat::fromDegrees(20.0, -45.0)),
+                     Angle::fromDegrees(5.0));
+    Box const box = Box::fromDegrees(205.0, 40.0, 215.0, 50.0);
+    for (auto const & p: makePixelizations(6)) {
+        PixelRegion const outer(*p, p->envelope(circle));
+        PixelRegion const within(*p, p->interior(circle));
+        CHECK((outer.relate(circle) & CONTAINS) != 0);
+        CHECK((outer.relate(inner) & CONTAINS) != 0);
+        CHECK((circle.relate(outer) & WITHIN) != 0);
+        CHECK((within.relate(circle) & WITHIN) != 0);
+        CHECK((circle.relate(within) & CONTAINS) != 0);
+        CHECK(outer.relate(far) == DISJOINT);
+        CHECK(far.relate(outer) == DISJOINT);
+        CHECK(outer.relate(box) == INTERSECTS);
+        CHECK((outer.relate(within) & CONTAINS) != 0);
+        CHECK((within.relate(outer) & WITHIN) != 0);
+        CHECK(outer.relate(PixelRegion(*p, p->envelope(far))) == DISJOINT);
+        CHECK(outer.relate(static_cast<Region const &>(outer)) ==
+              (CONTAINS | WITHIN));
+        CHECK(PixelRegion(*p, RangeSet()).relate(circle) ==
+              (DISJOINT | WITHIN));
+    }
+    // Pixel regions of different pixelizations are related through their
+    // envelopes and interiors.
+    PixelRegion const htm(HtmPixelization(7),
+                          HtmPixelization(7).envelope(circle));
+    PixelRegion const healpix(HealpixPixelization(4),
+                              HealpixPixelization(4).interior(circle));
+    CHECK((htm.relate(healpix) & CONTAINS) != 0);
+    CHECK((healpix.relate(htm) & WITHIN) != 0);
+}
+
+TEST_CASE(Envelope) {
+    Circle const circle(UnitVector3d(LonLat::fromDegrees(100.0, 10.0)),
+                        Angle::fromDegrees(12.0));
+    Circle const other(UnitVector3d(LonLat::fromDegrees(-60.0, 70.0)),
+                       Angle::fromDegrees(5.0));
+    std::vector<UnitVector3d> points = makePoints(5000);
+    HtmPixelization const htm(5);
+    PixelRegion const r(htm, htm.envelope(circle));
+    UnionRegion const u(r, other);
+    for (auto const & p: makePixelizations(4)) {
+        // Pixel regions are searched for directly, and through the generic
+        // region adapter when they are operands of compound regions.
+        RangeSet const envelope = p->envelope(r);
+        RangeSet const interior = p->interior(r);
+        RangeSet const unionEnvelope = p->envelope(u);
+        CHECK(envelope.contains(interior));
+        CHECK(unionEnvelope.contains(envelope));
+        CHECK(unionEnvelope.contains(p->interior(other)));
+        for (UnitVector3d const & v: points) {
+            uint64_t const i = p->index(v);
+            if (r.contains(v)) {
+                CHECK(envelope.contains(i));
+            } else {
+                CHECK(!interior.contains(i));
+            }
+            if (u.contains(v)) {
+                CHECK(unionEnvelope.contains(i));
+            }
+        }
+    }
+}
+
+TEST_CASE(Codec) {
+    Circle const circle(UnitVector3d(LonLat::fromDegrees(0.0, 0.0)),
+                        Angle::fromDegrees(3.0));
+    for (auto const & p: makePixelizations(8)) {
+        PixelRegion const r(*p, p->envelope(circle));
+        std::vector<uint8_t> s = r.encode();
+        CHECK(s[0] == PixelRegion::TYPE_CODE);
+        CHECK(*PixelRegion::decode(s) == r);
+        std::unique_ptr<Region> d = Region::decode(s);
+        CHECK(dynamic_cast<PixelRegion const &>(*d) == r);
+        std::vector<uint8_t> buffer(1, 0);
+        r.encodeTo(buffer);
+        CHECK(std::vector<uint8_t>(buffer.begin() + 1, buffer.end()) == s);
+        s.pop_back();
+        CHECK_THROW(PixelRegion::decode(s), std::runtime_error);
+    }
+    std::vector<uint8_t> s = PixelRegion(HtmPixelization(2), RangeSet()).encode();
+    s[1] = 9;
+    CHECK_THROW(PixelRegion::decode(s), std::runtime_error);
+    s[1] = 0;
+    s[2] = 30;
+    CHECK_THROW(PixelRegion::decode(s), std::runtime_error);
+    std::vector<uint8_t> bad = {PixelRegion::TYPE_CODE, 0, 2};
+    std::vector<uint8_t> pixels = RangeSet(0, 100).encode();
+    bad.insert(bad.end(), pixels.begin(), pixels.end());
+    CHECK_THROW(PixelRegion::decode(bad), std::runtime_error);
+    CHECK_THROW(PixelRegion::decode(nullptr, 0), std::runtime_error);
+}
+
+TEST_CASE(Polygons) {
+    Circle const circle(UnitVector3d(LonLat::fromDegrees(30.0, 20.0)),
+                        Angle::fromDegrees(10.0));
+    std::vector<UnitVector3d> points = makePoints(5000);
+    for (auto const & p: makePixelizations(6)) {
+        bool const healpix =
+            dynamic_cast<HealpixPixelization const *>(p.get()) != nullptr;
+        RangeSet pixels = p->interior(circle);
+        PixelRegion r(*p, pixels);
+        std::vector<ConvexPolygon> polygons = r.getPolygons();
+        CHECK(!polygons.empty());
+        CHECK(polygons.size() * 4 < pixels.cardinality());
+        // Each pixel center is in exactly one polygon, and the centers of
+        // the other pixels intersecting the circle are in none, except that
+        // HEALPix pixel approximations can overlap.
+        RangeSet envelope = p->envelope(circle);
+        for (auto const & range: envelope) {
+            for (uint64_t i = std::get<0>(range); i < std::get<1>(range);
+                 ++i) {
+                UnitVector3d c = p->pixel(i)->getBoundingCircle().getCenter();
+                size_t n = 0;
+                for (ConvexPolygon const & polygon: polygons) {
+                    n += polygon.contains(c) ? 1 : 0;
+                }
+                if (!pixels.contains(i)) {
+                    CHECK(n == 0);
+                } else if (healpix) {
+                    CHECK(n >= 1);
+                } else {
+                    CHECK(n == 1);
+                }
+            }
+        }
+        std::unique_ptr<UnionRegion> u = r.toUnionRegion();
+        CHECK(u->nOperands() == polygons.size());
+        if (!healpix) {
+            for (UnitVector3d const & v: points) {
+                CHECK(u->contains(v) == r.contains(v));
+            }
+        }
+    }
+    // A complete group of siblings is merged into their parent.
+    HtmPixelization htm(4);
+    std::vector<ConvexPolygon> polygons =
+        PixelRegion(htm, RangeSet(8 * 256 + 64, 8 * 256 + 128)).getPolygons();
+    REQUIRE(polygons.size() == 1);
+    CHECK(polygons[0] == HtmPixelization::triangle(8 * 4 + 1));
+    CHECK(PixelRegion(htm, RangeSet()).getPolygons().empty());
+    CHECK(PixelRegion(htm, RangeSet()).toUnionRegion()->nOperands() == 0);
+    // A rectangle of Q3C pixels on one face is a single quadrilateral.
+    Q3cPixelization q3c(6);
+    Box box = Box::fromDegrees(10.0, 10.0, 20.0, 20.0);
+    polygons = PixelRegion(q3c, q3c.interior(box)).getPolygons();
+    CHECK(polygons.size() <= 4);
+}
@@ -0,0 +1,206 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for converting pixel sets between
+///        pixelizations.
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+// `Naive` forwards to another pixelization, but uses the default pixel set
+// conversion implementations.
+class Naive : public Pixelization {
+public:
+    explicit Naive(Pixelization const & p) : _p(p) {}
+
+    RangeSet universe() const override { return _p.universe(); }
+    std::unique_ptr<Region> pixel(uint64_t i) const override {
+        return _p.pixel(i);
+    }
+    uint64_t index(UnitVector3d const & v) const override {
+        return _p.index(v);
+    }
+    std::string toString(uint64_t i) const override { return _p.toString(i); }
+    size_t maxStringLength() const override { return _p.maxStringLength(); }
+    uint64_t fromString(char const * s, size_t n) const override {
+        return _p.fromString(s, n);
+    }
+
+private:
+    Pixelization const & _p;
+
+    RangeSet _envelope(Region const & r, size_t maxRanges,
+                       unsigned numThreads) const override {
+        return _p.envelope(r, maxRanges, numThreads);
+    }
+    RangeSet _interior(Region const & r, size_t maxRanges,
+                       unsigned numThreads) const override {
+        return _p.interior(r, maxRanges, numThreads);
+    }
+};
+
+std::vector<std::unique_ptr<Pixelization>> makePixelizations(int level) {
+    std::vector<std::unique_ptr<Pixelization>> p;
+    p.push_back(std::make_unique<HtmPixelization>(level));
+    p.push_back(std::make_unique<Q3cPixelization>(level));
+    p.push_back(std::make_unique<Mq3cPixelization>(level));
+    p.push_back(std::make_unique<HealpixPixelization>(level));
+    return p;
+}
+
+// Check that every point in a source pixel is in a pixel of the envelope,
+// and that every point in a pixel of the interior is in a source pixel.
+void checkConversion(Pixelization const & from,
+                     RangeSet const & pixels,
+                     Pixelization const & to,
+                     RangeSet const & envelope,
+                     RangeSet const & interior,
+                     Box const & box)
+{
+    CHECK(envelope.contains(interior));
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> lon(
+        box.getLon().getA().asRadians(), box.getLon().getB().asRadians());
+    std::uniform_real_distribution<double> lat(
+        box.getLat().getA().asRadians(), box.getLat().getB().asRadians());
+    for (int i = 0; i < 5000; ++i) {
+        UnitVector3d v(LonLat::fromRadians(lon(rng), lat(rng)));
+        if (pixels.contains(from.index(v))) {
+            CHECK(envelope.contains(to.index(v)));
+        }
+        if (interior.contains(to.index(v))) {
+            CHECK(pixels.contains(from.index(v)));
+        }
+    }
+}
+
+TEST_CASE(EmptyAndUniverse) {
+    auto from = makePixelizations(3);
+    auto to = makePixelizations(5);
+    for (auto const & f: from) {
+        for (auto const & t: to) {
+            CHECK(t->envelope(*f, RangeSet()).empty());
+            CHECK(t->interior(*f, RangeSet()).empty());
+            CHECK(t->envelope(*f, f->universe()) == t->universe());
+            CHECK(t->interior(*f, f->universe()) == t->universe());
+        }
+    }
+}
+
+TEST_CASE(SameScheme) {
+    // Converting HTM pixels to a finer level yields their descendants,
+    // along with some of their neighbors in the envelope.
+    HtmPixelization coarse(5);
+    HtmPixelization fine(7);
+    Circle c(UnitVector3d(LonLat::fromDegrees(30.0, 40.0)),
+             Angle::fromDegrees(6.0));
+    RangeSet pixels = coarse.envelope(c);
+    RangeSet descendants = pixels.scaled(16);
+    RangeSet e = fine.envelope(coarse, pixels);
+    RangeSet i = fine.interior(coarse, pixels);
+    CHECK(e.contains(descendants));
+    CHECK(descendants.contains(i));
+    CHECK(!i.empty());
+    // Converting back to the coarse level brackets the original pixels.
+    // Coarse pixels on the boundary are left out of the interior, because
+    // their envelopes at the fine level include pixels of their neighbors.
+    RangeSet ci = coarse.interior(fine, descendants);
+    CHECK(coarse.envelope(fine, descendants).contains(pixels));
+    CHECK(pixels.contains(ci));
+    CHECK(!ci.empty());
+}
+
+TEST_CASE(CrossScheme) {
+    Box box(LonLat::fromDegrees(20.0, 50.0), LonLat::fromDegrees(60.0, 85.0));
+    Circle c(UnitVector3d(LonLat::fromDegrees(40.0, 70.0)),
+             Angle::fromDegrees(10.0));
+    auto from = makePixelizations(5);
+    auto to = makePixelizations(6);
+    for (auto const & f: from) {
+        RangeSet pixels = f->envelope(c) - f->interior(
+            Circle(c.getCenter(), Angle::fromDegrees(4.0)));
+        for (auto const & t: to) {
+            RangeSet e = t->envelope(*f, pixels);
+            RangeSet i = t->interior(*f, pixels);
+            CHECK(!i.empty());
+            checkConversion(*f, pixels, *t, e, i, box);
+        }
+    }
+}
+
+TEST_CASE(DefaultImplementation) {
+    Box box(LonLat::fromDegrees(-20.0, -30.0), LonLat::fromDegrees(20.0, 0.0));
+    Circle c(UnitVector3d(LonLat::fromDegrees(0.0, -15.0)),
+             Angle::fromDegrees(8.0));
+    HtmPixelization htm(4);
+    HealpixPixelization healpix(4);
+    Naive naive(healpix);
+    RangeSet pixels = htm.envelope(c);
+    RangeSet e = naive.envelope(htm, pixels);
+    RangeSet i = naive.interior(htm, pixels);
+    CHECK(!i.empty());
+    checkConversion(htm, pixels, healpix, e, i, box);
+    RangeSet e4 = naive.envelope(htm, pixels, 4);
+    RangeSet i4 = naive.interior(htm, pixels, 4);
+    CHECK(e4.size() <= 4 && e4.contains(e));
+    CHECK(i4.size() <= 4 && i.contains(i4));
+}
+
+TEST_CASE(MaxRangesAndThreads) {
+    Circle c(UnitVector3d(LonLat::fromDegrees(100.0, -20.0)),
+             Angle::fromDegrees(8.0));
+    HtmPixelization htm(5);
+    RangeSet pixels = htm.envelope(c);
+    for (auto const & t: makePixelizations(6)) {
+        RangeSet e = t->envelope(htm, pixels);
+        RangeSet i = t->interior(htm, pixels);
+        for (size_t maxRanges: {0, 4, 64}) {
+            RangeSet em = t->envelope(htm, pixels, maxRanges);
+            RangeSet im = t->interior(htm, pixels, maxRanges);
+            if (maxRanges != 0) {
+                CHECK(em.size() <= maxRanges);
+                CHECK(im.size() <= maxRanges);
+            }
+            CHECK(em.contains(e));
+            CHECK(i.contains(im));
+            for (unsigned numThreads: {2, 3}) {
+                CHECK(t->envelope(htm, pixels, maxRanges, numThreads) == em);
+                CHECK(t->interior(htm, pixels, maxRanges, numThreads) == im);
+            }
+        }
+    }
+}
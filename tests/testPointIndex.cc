@@ -0,0 +1,181 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the PointIndex class.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/PointIndex.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+UnitVector3dArray randomPoints(std::mt19937 & rng, size_t n) {
+    std::normal_distribution<double> dist;
+    UnitVector3dArray points;
+    for (size_t i = 0; i < n; ++i) {
+        points.push_back(UnitVector3d(dist(rng), dist(rng), dist(rng)));
+    }
+    return points;
+}
+
+std::vector<size_t> bruteForceWithin(UnitVector3dArray const & points,
+                                     UnitVector3d const & v,
+                                     Angle radius)
+{
+    std::vector<size_t> result;
+    Circle c(v, radius);
+    for (size_t i = 0; i < points.size(); ++i) {
+        if (c.contains(points[i])) {
+            result.push_back(i);
+        }
+    }
+    return result;
+}
+
+std::vector<std::pair<size_t, Angle>> bruteForceNearest(
+    UnitVector3dArray const & points,
+    UnitVector3d const & v,
+    size_t k)
+{
+    std::vector<std::pair<double, size_t>> d;
+    for (size_t i = 0; i < points.size(); ++i) {
+        d.emplace_back((points[i] - v).getSquaredNorm(), i);
+    }
+    std::sort(d.begin(), d.end());
+    std::vector<std::pair<size_t, Angle>> result;
+    for (size_t i = 0; i < std::min(k, d.size()); ++i) {
+        result.emplace_back(d[i].second, Circle::openingAngleFor(d[i].first));
+    }
+    return result;
+}
+
+void checkQueries(PointIndex const & index,
+                  UnitVector3dArray const & points,
+                  std::mt19937 & rng)
+{
+    UnitVector3dArray queries = randomPoints(rng, 50);
+    for (size_t q = 0; q < queries.size(); ++q) {
+        UnitVector3d v = queries[q];
+        for (double r: {0.0, 0.01, 0.1, 1.0, 4.0}) {
+            CHECK(index.findWithin(v, Angle(r)) ==
+                  bruteForceWithin(points, v, Angle(r)));
+        }
+        for (size_t k: {1, 2, 5, 10}) {
+            CHECK(index.findNearest(v, k) == bruteForceNearest(points, v, k));
+        }
+    }
+    // Query points that coincide with indexed points.
+    for (size_t i = 0; i < std::min<size_t>(points.size(), 20); ++i) {
+        auto nearest = index.findNearest(points[i], 1);
+        CHECK(nearest.size() == 1);
+        CHECK(nearest[0].second == Angle(0.0));
+        CHECK(index.findWithin(points[i], Angle(0.0)).size() >= 1);
+    }
+}
+
+TEST_CASE(Empty) {
+    PointIndex index;
+    CHECK(index.empty());
+    CHECK(index.size() == 0);
+    CHECK(index.findWithin(UnitVector3d::Z(), Angle(1.0)).empty());
+    CHECK(index.findNearest(UnitVector3d::Z(), 3).empty());
+    CHECK_THROW(PointIndex(UnitVector3dArray(), -1), std::invalid_argument);
+    CHECK_THROW(PointIndex(UnitVector3dArray(), 31), std::invalid_argument);
+}
+
+TEST_CASE(Queries) {
+    std::mt19937 rng(1);
+    UnitVector3dArray points = randomPoints(rng, 20000);
+    for (int level: {0, 3, 6, 9}) {
+        PointIndex index(points, level);
+        CHECK(index.size() == points.size());
+        CHECK(index.getLevel() == level);
+        checkQueries(index, points, rng);
+    }
+}
+
+TEST_CASE(Sparse) {
+    // Nearest neighbor searches must expand over many rings, or the
+    // whole sphere, when points are few and far between.
+    std::mt19937 rng(2);
+    UnitVector3dArray points = randomPoints(rng, 7);
+    PointIndex index(points, 5);
+    checkQueries(index, points, rng);
+    UnitVector3d v = UnitVector3d::X();
+    CHECK(index.findNearest(v, 100) == bruteForceNearest(points, v, 100));
+}
+
+TEST_CASE(Threads) {
+    std::mt19937 rng(3);
+    UnitVector3dArray points = randomPoints(rng, 300000);
+    // Duplicate some points, so that results depend on tie-breaking.
+    for (size_t i = 0; i < 1000; ++i) {
+        points.push_back(points[i * 7]);
+    }
+    PointIndex serial(points, 6);
+    PointIndex parallel(points, 6, 4);
+    UnitVector3dArray queries = randomPoints(rng, 20);
+    for (size_t q = 0; q < queries.size(); ++q) {
+        CHECK(serial.findNearest(queries[q], 10) ==
+              parallel.findNearest(queries[q], 10));
+        CHECK(serial.findWithin(queries[q], Angle(0.01)) ==
+              parallel.findWithin(queries[q], Angle(0.01)));
+    }
+    auto nearest = parallel.findNearest(points[7], 2);
+    CHECK(nearest.size() == 2);
+    CHECK(nearest[0].first == 7);
+    CHECK(nearest[1].first == 300001);
+}
+
+TEST_CASE(File) {
+    std::mt19937 rng(4);
+    UnitVector3dArray points = randomPoints(rng, 5000);
+    PointIndex index(points, 4);
+    std::string path = "testPointIndex.idx";
+    index.write(path);
+    PointIndex mapped = PointIndex::open(path);
+    CHECK(mapped.size() == index.size());
+    CHECK(mapped.getLevel() == index.getLevel());
+    checkQueries(mapped, points, rng);
+    // Copies share the mapping, which outlives the file name.
+    PointIndex copy = mapped;
+    std::remove(path.c_str());
+    CHECK(copy.findNearest(points[3], 1)[0].first == 3);
+    PointIndex().write(path);
+    CHECK(PointIndex::open(path).empty());
+    std::FILE * f = std::fopen(path.c_str(), "wb");
+    std::fputs("not an index, just some text", f);
+    std::fclose(f);
+    CHECK_THROW(PointIndex::open(path), std::runtime_error);
+    std::remove(path.c_str());
+    CHECK_THROW(PointIndex::open(path), std::runtime_error);
+}
@@ -0,0 +1,167 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the PolygonMesh class.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/PolygonMesh.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+UnitVector3d randomPoint(std::mt19937 & rng) {
+    std::normal_distribution<double> d;
+    return UnitVector3d(d(rng), d(rng), d(rng));
+}
+
+// `htmTriangles` returns the HTM triangles of the given level, which
+// tessellate the unit sphere.
+std::vector<ConvexPolygon> htmTriangles(int level) {
+    std::vector<ConvexPolygon> triangles;
+    uint64_t const begin = static_cast<uint64_t>(8) << 2 * level;
+    for (uint64_t i = begin; i < 2 * begin; ++i) {
+        triangles.push_back(HtmPixelization::triangle(i));
+    }
+    return triangles;
+}
+
+TEST_CASE(Empty) {
+    PolygonMesh mesh;
+    CHECK(mesh.empty());
+    CHECK(mesh.getNumFaces() == 0);
+    CHECK(mesh.findFace(UnitVector3d::X()) == PolygonMesh::NO_FACE);
+    CHECK(PolygonMesh(std::vector<ConvexPolygon>()).empty());
+}
+
+TEST_CASE(SharedVerticesAndEdges) {
+    std::vector<ConvexPolygon> faces = htmTriangles(3);
+    PolygonMesh mesh(faces);
+    // A closed triangulation with F faces has 3F/2 edges and 2 + F/2
+    // vertices.
+    size_t const numFaces = faces.size();
+    CHECK(mesh.getNumFaces() == numFaces);
+    CHECK(mesh.getNumEdges() == 3 * numFaces / 2);
+    CHECK(mesh.getVertices().size() == 2 + numFaces / 2);
+    for (size_t i = 0; i < numFaces; ++i) {
+        CHECK(mesh.getFace(i) == faces[i]);
+        for (size_t k = 0; k < 3; ++k) {
+            size_t j = mesh.getNeighbor(i, k);
+            REQUIRE(j < numFaces);
+            CHECK(j != i);
+            // Neighbors share both vertices of the edge.
+            std::vector<uint32_t> a = mesh.getFaceVertices(i);
+            std::vector<uint32_t> b = mesh.getFaceVertices(j);
+            uint32_t v0 = a[(k + 2) % 3];
+            uint32_t v1 = a[k];
+            CHECK(std::count(b.begin(), b.end(), v0) == 1);
+            CHECK(std::count(b.begin(), b.end(), v1) == 1);
+        }
+    }
+    // Without a neighbor, the walk falls back to testing every face.
+    PolygonMesh single(std::vector<ConvexPolygon>(1, faces[5]));
+    CHECK(single.getNeighbor(0, 0) == PolygonMesh::NO_FACE);
+    CHECK(single.findFace(faces[5].getCentroid()) == 0);
+    CHECK(single.findFace(faces[100].getCentroid()) == PolygonMesh::NO_FACE);
+}
+
+TEST_CASE(Overlap) {
+    std::vector<ConvexPolygon> faces = htmTriangles(1);
+    faces.push_back(faces[3]);
+    CHECK_THROW(PolygonMesh mesh(faces), std::invalid_argument);
+}
+
+TEST_CASE(FindFaces) {
+    std::mt19937 rng(3);
+    std::vector<ConvexPolygon> faces = htmTriangles(4);
+    // Leave a hole in the mesh.
+    faces.erase(faces.begin() + 200, faces.begin() + 210);
+    PolygonMesh mesh(faces);
+    std::vector<UnitVector3d> points;
+    for (int i = 0; i < 2000; ++i) {
+        points.push_back(randomPoint(rng));
+    }
+    // Include points on shared edges and vertices.
+    for (size_t i = 0; i < 50; ++i) {
+        points.push_back(faces[i].getVertices()[0]);
+    }
+    std::vector<size_t> found(points.size());
+    mesh.findFaces(points.data(), points.size(), found.data());
+    std::vector<size_t> threaded(points.size());
+    mesh.findFaces(points.data(), points.size(), threaded.data(), 3);
+    for (size_t p = 0; p < points.size(); ++p) {
+        bool expected = false;
+        for (size_t i = 0; i < faces.size(); ++i) {
+            CHECK(faces[i].contains(points[p]) == mesh.contains(i, points[p]));
+            expected = expected || faces[i].contains(points[p]);
+        }
+        if (expected) {
+            REQUIRE(found[p] < faces.size());
+            CHECK(faces[found[p]].contains(points[p]));
+            CHECK(threaded[p] < faces.size());
+        } else {
+            CHECK(found[p] == PolygonMesh::NO_FACE);
+            CHECK(threaded[p] == PolygonMesh::NO_FACE);
+        }
+        // Walks from any starting face find a face containing the point.
+        size_t f = mesh.findFace(points[p], p % faces.size());
+        CHECK(expected ? faces[f].contains(points[p]) : f == PolygonMesh::NO_FACE);
+    }
+}
+
+TEST_CASE(Relate) {
+    std::vector<ConvexPolygon> faces = htmTriangles(3);
+    PolygonMesh mesh(faces);
+    std::unique_ptr<Region> regions[] = {
+        std::unique_ptr<Region>(new Circle(UnitVector3d(1, 2, 3), Angle(0.3))),
+        std::unique_ptr<Region>(new Circle(UnitVector3d(1, 2, 3), Angle(1.0e-4))),
+        std::unique_ptr<Region>(new Box(LonLat::fromDegrees(10, 10),
+                                        LonLat::fromDegrees(60, 40)))
+    };
+    for (auto const & r : regions) {
+        std::vector<Relationship> out(faces.size());
+        mesh.relate(*r, out.data());
+        std::vector<Relationship> threaded(faces.size());
+        mesh.relate(*r, threaded.data(), 4);
+        size_t numIntersecting = 0;
+        for (size_t i = 0; i < faces.size(); ++i) {
+            Relationship expected = faces[i].relate(*r);
+            CHECK(out[i] == expected || out[i] == INTERSECTS);
+            CHECK((expected & (DISJOINT | WITHIN)) == 0 || out[i] == expected);
+            CHECK(threaded[i] == out[i]);
+            numIntersecting += (out[i] & DISJOINT) == 0;
+        }
+        CHECK(numIntersecting > 0);
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for progressive envelope computation.
+
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/HealpixPixelization.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/ProgressiveEnvelope.h"
+#include "lsst/sphgeom/Q3cPixelization.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+std::vector<std::unique_ptr<Pixelization>> makePixelizations(int level) {
+    std::vector<std::unique_ptr<Pixelization>> p;
+    p.emplace_back(new HtmPixelization(level));
+    p.emplace_back(new Q3cPixelization(level));
+    p.emplace_back(new Q3cPixelization(level, true));
+    p.emplace_back(new Mq3cPixelization(level));
+    p.emplace_back(new HealpixPixelization(level));
+    return p;
+}
+
+std::vector<std::unique_ptr<Region>> makeRegions() {
+    std::vector<std::unique_ptr<Region>> r;
+    UnitVector3d c(1.0, -2.0, 3.0);
+    r.emplace_back(new Circle(c, Angle(0.1)));
+    r.emplace_back(new Box(LonLat(c), Angle(0.2), Angle(0.05)));
+    r.emplace_back(new Ellipse(c, Angle(0.1), Angle(0.03), Angle(1.0)));
+    r.emplace_back(new ConvexPolygon(std::vector<UnitVector3d>{
+        UnitVector3d(1, 0, 0), UnitVector3d(1, 0.1, 0),
+        UnitVector3d(1, 0.05, 0.08)}));
+    std::vector<std::unique_ptr<Region>> operands;
+    operands.emplace_back(new Circle(c, Angle(0.05)));
+    operands.emplace_back(new Circle(UnitVector3d(-1, 1, 1), Angle(0.02)));
+    r.emplace_back(new UnionRegion(std::move(operands)));
+    return r;
+}
+
+TEST_CASE(Refinement) {
+    // Every intermediate envelope contains the next one, and the complete
+    // envelope is the regular one.
+    for (auto const & p: makePixelizations(8)) {
+        for (auto const & r: makeRegions()) {
+            RangeSet exact = p->envelope(*r);
+            ProgressiveEnvelope e = p->progressiveEnvelope(*r);
+            CHECK(e.getNumSteps() == 0);
+            CHECK(e.getCoarsestLevel() == 0 || e.isComplete());
+            RangeSet previous = e.getRanges();
+            double area = e.getFrontierArea();
+            while (!e.isComplete()) {
+                size_t steps = e.getNumSteps();
+                bool complete = e.refine(7);
+                CHECK(complete == e.isComplete());
+                CHECK(e.getNumSteps() <= steps + 7);
+                CHECK(complete || e.getNumSteps() == steps + 7);
+                CHECK(previous.contains(e.getRanges()));
+                CHECK(e.getRanges().contains(exact));
+                CHECK(e.getFrontierArea() <= area + 1.0e-12);
+                previous = e.getRanges();
+                area = e.getFrontierArea();
+            }
+            CHECK(e.getRanges() == exact);
+            CHECK(e.getCoarsestLevel() == 8);
+            CHECK(e.getFrontierArea() == 0.0);
+            CHECK(e.refine(1));
+        }
+    }
+}
+
+TEST_CASE(Deadline) {
+    HtmPixelization p(20);
+    Circle c(UnitVector3d(1.0, -2.0, 3.0), Angle(0.1));
+    ProgressiveEnvelope e = p.progressiveEnvelope(c);
+    // A deadline in the past performs no refinement.
+    CHECK(!e.refineUntil(ProgressiveEnvelope::Clock::now()));
+    CHECK(e.getNumSteps() == 0);
+    auto start = ProgressiveEnvelope::Clock::now();
+    bool complete = e.refineFor(std::chrono::milliseconds(5));
+    auto elapsed = ProgressiveEnvelope::Clock::now() - start;
+    CHECK(!complete);
+    CHECK(e.getNumSteps() > 0);
+    CHECK(elapsed < std::chrono::milliseconds(500));
+    CHECK(e.getRanges().contains(p.envelope(c, 0)));
+    // Refinement can continue later, and reaches the regular envelope.
+    e.refine(1000);
+    HtmPixelization q(10);
+    ProgressiveEnvelope f = q.progressiveEnvelope(c);
+    CHECK(f.refineUntil(ProgressiveEnvelope::Clock::time_point::max()));
+    CHECK(f.getRanges() == q.envelope(c));
+}
+
+TEST_CASE(RegionLifetime) {
+    // The region may be destroyed before the envelope is refined.
+    Mq3cPixelization p(10);
+    std::unique_ptr<ProgressiveEnvelope> e;
+    RangeSet exact;
+    for (auto & r: makeRegions()) {
+        exact = p.envelope(*r);
+        e.reset(new ProgressiveEnvelope(p.progressiveEnvelope(*r)));
+        r.reset();
+        e->refine(static_cast<size_t>(-1));
+        CHECK(e->getRanges() == exact);
+    }
+    // Envelopes can be moved.
+    Circle c(UnitVector3d(0.0, 1.0, 1.0), Angle(0.2));
+    ProgressiveEnvelope a = p.progressiveEnvelope(c);
+    ProgressiveEnvelope b = std::move(a);
+    b.refine(3);
+    a = std::move(b);
+    CHECK(a.getNumSteps() == 3);
+}
@@ -24,10 +24,22 @@
 /// \brief This file contains tests for Q3C indexing.
 
 #include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
 
+#include "lsst/sphgeom/Box.h"
 #include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
 #include "lsst/sphgeom/LonLat.h"
 #include "lsst/sphgeom/Q3cPixelization.h"
+#include "lsst/sphgeom/curve.h"
 #include "lsst/sphgeom/UnitVector3d.h"
 
 #include "test.h"
@@ -135,6 +147,29 @@ TEST_CASE(IndexPoint) {
 }
 
 
+TEST_CASE(IndexBatch) {
+    // Check that batch indexing agrees with single point indexing. The
+    // batch inputs are deliberately left unnormalized.
+    std::vector<double> x, y, z;
+    for (int lat = -90; lat <= 90; lat += 5) {
+        for (int lon = 0; lon < 360; lon += 5) {
+            UnitVector3d v(LonLat::fromDegrees(lon + 0.5 * lat, lat));
+            x.push_back(3.0 * v.x());
+            y.push_back(3.0 * v.y());
+            z.push_back(3.0 * v.z());
+        }
+    }
+    std::vector<uint64_t> indexes(x.size());
+    for (int level = 0; level <= Q3cPixelization::MAX_LEVEL; level += 3) {
+        Q3cPixelization p(level);
+        p.index(x.data(), y.data(), z.data(), indexes.data(), x.size());
+        for (size_t i = 0; i < x.size(); ++i) {
+            CHECK(indexes[i] == p.index(UnitVector3d(x[i], y[i], z[i])));
+        }
+    }
+}
+
+
 TEST_CASE(Envelope) {
     auto pixelization = Q3cPixelization(1);
     auto universe = pixelization.universe();
@@ -163,12 +198,147 @@ TEST_CASE(Interior) {
     }
 }
 
+TEST_CASE(EllipseEnvelopeAndInterior) {
+    // A long, thin ellipse must not be approximated by its bounding circle.
+    Ellipse e(UnitVector3d(LonLat::fromDegrees(30.0, 20.0)),
+              Angle::fromDegrees(5.0),
+              Angle::fromDegrees(0.3),
+              Angle::fromDegrees(35.0));
+    Q3cPixelization pixelization(10);
+    RangeSet env = pixelization.envelope(e);
+    RangeSet circleEnv = pixelization.envelope(e.getBoundingCircle());
+    CHECK(4 * env.cardinality() < circleEnv.cardinality());
+    for (double lon = 20.0; lon < 40.0; lon += 0.1) {
+        for (double lat = 10.0; lat < 30.0; lat += 0.1) {
+            UnitVector3d v(LonLat::fromDegrees(lon, lat));
+            if (e.contains(v)) {
+                CHECK(env.contains(pixelization.index(v)));
+            }
+        }
+    }
+    RangeSet in = pixelization.interior(e);
+    CHECK(!in.empty());
+    CHECK(env.contains(in));
+    for (auto const & r: in) {
+        for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+            ConvexPolygon pixel = pixelization.quad(i);
+            for (UnitVector3d const & v: pixel.getVertices()) {
+                CHECK(e.contains(v));
+            }
+        }
+    }
+}
+
+
+TEST_CASE(CompoundEnvelopeAndInterior) {
+    Circle c1(UnitVector3d(LonLat::fromDegrees(10.0, 5.0)),
+              Angle::fromDegrees(3.0));
+    Circle c2(UnitVector3d(LonLat::fromDegrees(13.0, 6.0)),
+              Angle::fromDegrees(2.0));
+    Box b(LonLat::fromDegrees(8.0, 4.0), LonLat::fromDegrees(20.0, 7.0));
+    UnionRegion u(c1, c2);
+    IntersectionRegion i(u, b);
+    Q3cPixelization pixelization(9);
+    CHECK(pixelization.envelope(u) ==
+          (pixelization.envelope(c1) | pixelization.envelope(c2)));
+    CHECK(pixelization.interior(u) ==
+          (pixelization.interior(c1) | pixelization.interior(c2)));
+    RangeSet env = pixelization.envelope(i);
+    CHECK((pixelization.envelope(u) & pixelization.envelope(b)).contains(env));
+    CHECK(pixelization.interior(i) ==
+          (pixelization.interior(u) & pixelization.interior(b)));
+    CHECK(env.contains(pixelization.interior(i)));
+    CHECK(pixelization.envelope(i, 0, 4) == env);
+    Ellipse e(UnitVector3d(LonLat::fromDegrees(12.0, 5.0)),
+              Angle::fromDegrees(4.0),
+              Angle::fromDegrees(0.5),
+              Angle::fromDegrees(60.0));
+    UnionRegion ue(c1, e);
+    CHECK(pixelization.envelope(ue) ==
+          (pixelization.envelope(c1) | pixelization.envelope(e)));
+    CHECK(pixelization.interior(ue) ==
+          (pixelization.interior(c1) | pixelization.interior(e)));
+}
+
+
+TEST_CASE(MaxLevelEnvelope) {
+    // Exercise the deepest possible traversal.
+    Q3cPixelization p(Q3cPixelization::MAX_LEVEL);
+    UnitVector3d v(LonLat::fromDegrees(12.5, -33.3));
+    RangeSet s = p.envelope(Circle(v, Angle::fromDegrees(1.0e-7)));
+    CHECK(!s.empty());
+    CHECK(s.contains(p.index(v)));
+}
+
+
+TEST_CASE(ParallelTraversal) {
+    // Check that parallel traversal gives the same results as serial
+    // traversal, including when the range limit forces simplification.
+    UnitVector3d center(1.0, -1.0, 0.5);
+    Circle c(center, Angle::fromDegrees(20.0));
+    Box b(LonLat::fromDegrees(10.0, -30.0), LonLat::fromDegrees(75.0, 45.0));
+    ConvexPolygon p = ConvexPolygon::convexHull(std::vector<UnitVector3d>{
+        UnitVector3d(1.0, 0.0, 0.1),
+        UnitVector3d(0.0, 1.0, -0.2),
+        UnitVector3d(-0.3, 0.2, 1.0)});
+    Region const * regions[] = {&c, &b, &p};
+    for (int level = 0; level <= 8; level += 4) {
+        Q3cPixelization pixelization(level);
+        for (Region const * r: regions) {
+            for (size_t maxRanges: {0, 8, 100, 100000}) {
+                RangeSet e = pixelization.envelope(*r, maxRanges);
+                RangeSet i = pixelization.interior(*r, maxRanges);
+                for (unsigned numThreads: {2, 3, 16}) {
+                    CHECK(pixelization.envelope(
+                        *r, maxRanges, numThreads) == e);
+                    CHECK(pixelization.interior(
+                        *r, maxRanges, numThreads) == i);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(SmallRegionParallelTraversal) {
+    // Traversals for small regions start near the region; check that
+    // parallel traversal starts from the same pixels as serial traversal.
+    for (int level: {4, 8, 12}) {
+        Q3cPixelization pixelization(level);
+        for (double lon = 7.3; lon < 360.0; lon += 30.1) {
+            for (double lat = -80.9; lat < 90.0; lat += 23.2) {
+                LonLat p = LonLat::fromDegrees(lon, lat);
+                UnitVector3d v(p);
+                UnitVector3d n = UnitVector3d::northFrom(v);
+                UnitVector3d e = UnitVector3d(n.cross(v));
+                Box b(p, Angle::fromDegrees(0.01), Angle::fromDegrees(0.007));
+                Circle c(v, Angle::fromDegrees(0.02));
+                ConvexPolygon t(UnitVector3d(v + n * 3.0e-4),
+                                UnitVector3d(v - n * 2.0e-4 + e * 2.0e-4),
+                                UnitVector3d(v - n * 1.0e-4 - e * 3.0e-4));
+                Region const * regions[] = {&b, &c, &t};
+                for (Region const * r: regions) {
+                    RangeSet env = pixelization.envelope(*r);
+                    RangeSet in = pixelization.interior(*r);
+                    for (unsigned numThreads: {2, 4, 16}) {
+                        CHECK(pixelization.envelope(*r, 0, numThreads) == env);
+                        CHECK(pixelization.interior(*r, 0, numThreads) == in);
+                    }
+                }
+            }
+        }
+    }
+    Q3cPixelization pixelization(4);
+    Box b(LonLat::fromDegrees(37.3, 12.1),
+          Angle::fromDegrees(0.01), Angle::fromDegrees(0.007));
+    CHECK(pixelization.envelope(b, 0, 4) == pixelization.envelope(b));
+}
+
 
 TEST_CASE(Neighborhood) {
     for (int level = 0; level < 3; ++level) {
         auto pixelization = Q3cPixelization(level);
         auto universe = pixelization.universe();
-        for (uint64_t i = 0; i < (6 << 2*level); ++i) {
+        for (uint64_t i = 0; i < (uint64_t(6) << 2*level); ++i) {
             ConvexPolygon q = pixelization.quad(i);
             RangeSet rs1 = pixelization.envelope(q);
             RangeSet rs2 = RangeSet(pixelization.neighborhood(i));
@@ -179,3 +349,363 @@ TEST_CASE(Neighborhood) {
         }
     }
 }
+
+TEST_CASE(FixedAndBatchNeighborhood) {
+    for (int level = 0; level < 3; ++level) {
+        auto pixelization = Q3cPixelization(level);
+        std::vector<uint64_t> indexes;
+        for (uint64_t i = 0; i < uint64_t(6) << 2*level; ++i) {
+            indexes.push_back(i);
+        }
+        std::vector<uint64_t> out(9 * indexes.size());
+        std::vector<uint8_t> counts(indexes.size());
+        pixelization.neighborhoods(indexes.data(), indexes.size(),
+                                   out.data(), counts.data());
+        for (size_t p = 0; p < indexes.size(); ++p) {
+            std::vector<uint64_t> expected =
+                pixelization.neighborhood(indexes[p]);
+            uint64_t fixed[9];
+            int n = pixelization.neighborhood(indexes[p], fixed);
+            REQUIRE(n == static_cast<int>(expected.size()));
+            CHECK(counts[p] == n);
+            CHECK(std::equal(expected.begin(), expected.end(), fixed));
+            CHECK(std::equal(fixed, fixed + 9, out.begin() + 9 * p));
+            for (int j = n; j < 9; ++j) {
+                CHECK(fixed[j] == expected.back());
+            }
+        }
+    }
+    auto pixelization = Q3cPixelization(1);
+    uint64_t fixed[9];
+    uint64_t invalid[2] = {0, 100};
+    uint64_t out[18];
+    uint8_t counts[2];
+    CHECK_THROW(pixelization.neighborhood(100, fixed), std::invalid_argument);
+    CHECK_THROW(pixelization.neighborhoods(invalid, 2, out, counts),
+                std::invalid_argument);
+}
+
+// Grow a pixel set by k rings, one pixel at a time.
+RangeSet bruteForceDilate(Q3cPixelization const & pixelization,
+                          RangeSet pixels,
+                          int k) {
+    for (; k > 0; --k) {
+        RangeSet grown = pixels;
+        for (auto const & r: pixels) {
+            for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+                grown |= RangeSet(pixelization.neighborhood(i));
+            }
+        }
+        pixels = grown;
+    }
+    return pixels;
+}
+
+TEST_CASE(Dilate) {
+    for (int level: {0, 2, 5}) {
+        Q3cPixelization pixelization(level);
+        uint64_t const base = 0;
+        uint64_t const faceSize = static_cast<uint64_t>(1) << (2 * level);
+        RangeSet universe = pixelization.universe();
+        std::vector<RangeSet> sets = {
+            RangeSet(),
+            RangeSet(base + 3 * faceSize - 1),
+            RangeSet(base + faceSize, base + 2 * faceSize),
+            RangeSet(base + faceSize / 2, base + 3 * faceSize - faceSize / 4),
+            pixelization.envelope(Circle(UnitVector3d(1.0, 1.0, 1.0),
+                                         Angle::fromDegrees(20.0))),
+        };
+        for (RangeSet const & s: sets) {
+            CHECK(pixelization.dilate(s, 0) == s);
+            for (int k = 1; k <= 3; ++k) {
+                RangeSet d = pixelization.dilate(s, k);
+                CHECK(d == bruteForceDilate(pixelization, s, k));
+                CHECK(d.isWithin(universe));
+            }
+        }
+        CHECK(pixelization.dilate(universe, 2) == universe);
+        uint64_t i = base + faceSize - 1;
+        CHECK(pixelization.dilate(RangeSet(i), 1) ==
+              RangeSet(pixelization.neighborhood(i)));
+        CHECK_THROW(pixelization.dilate(RangeSet(i), -1), std::invalid_argument);
+        CHECK_THROW(pixelization.dilate(RangeSet(base + 6 * faceSize), 1),
+                    std::invalid_argument);
+    }
+}
+
+// Convert a Hilbert ordered Q3C index to the Morton ordered one for the
+// same pixel.
+uint64_t hilbertToMortonQ3c(uint64_t i, int level) {
+    uint64_t const mask = (static_cast<uint64_t>(1) << (2 * level)) - 1;
+    return (i & ~mask) | hilbertToMorton(i & mask, level);
+}
+
+RangeSet hilbertToMortonQ3c(RangeSet const & s, int level) {
+    RangeSet result;
+    for (auto const & r: s) {
+        for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+            result.insert(hilbertToMortonQ3c(i, level));
+        }
+    }
+    return result;
+}
+
+TEST_CASE(HilbertOrder) {
+    CHECK(!Q3cPixelization(3).isHilbertOrder());
+    CHECK(Q3cPixelization(3, 0, true).isHilbertOrder());
+    for (int level = 0; level <= 4; ++level) {
+        Q3cPixelization morton(level);
+        Q3cPixelization hilbert(level, 0, true);
+        CHECK(hilbert.universe() == morton.universe());
+        uint64_t const faceSize = static_cast<uint64_t>(1) << (2 * level);
+        for (uint64_t i = 0; i < 6 * faceSize; ++i) {
+            uint64_t j = hilbertToMortonQ3c(i, level);
+            CHECK(hilbert.quad(i) == morton.quad(j));
+            CHECK(hilbert.index(hilbert.quad(i).getCentroid()) == i);
+            CHECK(hilbertToMortonQ3c(RangeSet(hilbert.neighborhood(i)),
+                                     level) ==
+                  RangeSet(morton.neighborhood(j)));
+            // Consecutive pixels on a face are adjacent.
+            if ((i + 1) % faceSize != 0) {
+                std::vector<uint64_t> n = hilbert.neighborhood(i);
+                CHECK(std::find(n.begin(), n.end(), i + 1) != n.end());
+            }
+        }
+        CHECK(hilbert.toString(0) == morton.toString(0));
+    }
+    // Envelopes and interiors cover the same pixels in both orders, but
+    // with fewer ranges in Hilbert order.
+    int const level = 8;
+    Q3cPixelization morton(level);
+    Q3cPixelization hilbert(level, 0, true);
+    size_t numMorton = 0;
+    size_t numHilbert = 0;
+    for (int k = 0; k < 20; ++k) {
+        Circle c(UnitVector3d(LonLat::fromDegrees(17.0 * k, 8.0 * k - 80.0)),
+                 Angle::fromDegrees(3.0));
+        RangeSet h = hilbert.envelope(c);
+        RangeSet m = morton.envelope(c);
+        CHECK(hilbertToMortonQ3c(h, level) == m);
+        CHECK(hilbertToMortonQ3c(hilbert.interior(c), level) ==
+              morton.interior(c));
+        CHECK(hilbert.envelope(c, 0, 4) == h);
+        numHilbert += h.size();
+        numMorton += m.size();
+    }
+    CHECK(numHilbert < numMorton);
+    // Batch indexing agrees with single point indexing.
+    std::vector<double> x, y, z;
+    for (int lat = -85; lat <= 85; lat += 10) {
+        for (int lon = 0; lon < 360; lon += 10) {
+            UnitVector3d v(LonLat::fromDegrees(lon, lat));
+            x.push_back(v.x());
+            y.push_back(v.y());
+            z.push_back(v.z());
+        }
+    }
+    std::vector<uint64_t> indexes(x.size());
+    hilbert.index(x.data(), y.data(), z.data(), indexes.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i) {
+        UnitVector3d v(x[i], y[i], z[i]);
+        CHECK(indexes[i] == hilbert.index(v));
+        CHECK(hilbertToMortonQ3c(indexes[i], level) == morton.index(v));
+    }
+    // Dilation works in either order.
+    Circle c(UnitVector3d(1.0, -1.0, 1.0), Angle::fromDegrees(10.0));
+    RangeSet s = hilbert.envelope(c);
+    for (int k = 1; k <= 2; ++k) {
+        CHECK(hilbert.dilate(s, k) == bruteForceDilate(hilbert, s, k));
+        CHECK(hilbertToMortonQ3c(hilbert.dilate(s, k), level) ==
+              morton.dilate(morton.envelope(c), k));
+    }
+}
+
+TEST_CASE(PixelCache) {
+    // Cached pixels must match computed ones, both when pixels are evicted
+    // and when a cache shared by copies is used from several threads.
+    Q3cPixelization uncached(6);
+    Q3cPixelization cached(6, 100);
+    Q3cPixelization copy(cached);
+    uint64_t const first = 1 << 12;
+    std::vector<char> ok(4, 1);
+    auto work = [&](size_t t) {
+        for (int pass = 0; pass < 3; ++pass) {
+            for (uint64_t i = first; i < first + 300; i += 1 + t) {
+                Q3cPixelization const & p = (t % 2 == 0) ? cached : copy;
+                if (!(*static_cast<ConvexPolygon *>(p.pixel(i).get()) ==
+                      *static_cast<ConvexPolygon *>(uncached.pixel(i).get()))) {
+                    ok[t] = 0;
+                }
+                if (!(p.quad(i) == uncached.quad(i))) {
+                    ok[t] = 0;
+                }
+            }
+        }
+    };
+    std::vector<std::thread> threads;
+    for (size_t t = 1; t < ok.size(); ++t) {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for (std::thread & t: threads) {
+        t.join();
+    }
+    for (char k: ok) {
+        CHECK(k == 1);
+    }
+    CHECK_THROW(cached.pixel(6 << 12), std::invalid_argument);
+}
+
+TEST_CASE(Vertices) {
+    Q3cPixelization p(5);
+    std::vector<uint64_t> indexes = {0, 1234, 6143, 0};
+    std::vector<double> out(3 * Q3cPixelization::NUM_VERTICES * indexes.size());
+    p.vertices(indexes.data(), indexes.size(), out.data());
+    double const * o = out.data();
+    for (uint64_t i: indexes) {
+        std::unique_ptr<Region> r = p.pixel(i);
+        ConvexPolygon const & poly = *static_cast<ConvexPolygon *>(r.get());
+        CHECK(poly.getVertices().size() == Q3cPixelization::NUM_VERTICES);
+        for (UnitVector3d const & v: poly.getVertices()) {
+            CHECK(o[0] == v.x() && o[1] == v.y() && o[2] == v.z());
+            o += 3;
+        }
+    }
+    uint64_t invalid = 6 << 10;
+    CHECK_THROW(p.vertices(&invalid, 1, out.data()), std::invalid_argument);
+}
+
+TEST_CASE(SmallRegionEnvelope) {
+    // Traversals for small regions start near the region, rather than at
+    // the root pixels. Check that pixels containing points on the boundary
+    // of small circles are never missed, in particular for circles centered
+    // on root pixel vertices and edges.
+    std::vector<UnitVector3d> centers = {
+        UnitVector3d(1, 1, 1), UnitVector3d(-1, 1, -1), UnitVector3d::X(),
+        UnitVector3d::Z(), UnitVector3d(1, -1, 0), UnitVector3d(0, 1, 1),
+        UnitVector3d(0.3, -0.2, 0.9)
+    };
+    for (Q3cPixelization const & pixelization: {Q3cPixelization(8), Q3cPixelization(16, 0, true)}) {
+        for (UnitVector3d const & v: centers) {
+            UnitVector3d u = UnitVector3d::orthogonalTo(v);
+            UnitVector3d w(v.cross(u));
+            for (double r = 1e-8; r < 0.1; r *= 3.7) {
+                Circle c(v, Angle(r));
+                RangeSet envelope = pixelization.envelope(c);
+                CHECK(envelope.contains(pixelization.index(v)));
+                CHECK(envelope.contains(pixelization.interior(c)));
+                CHECK(envelope == pixelization.envelope(c, 0, 4));
+                for (int k = 0; k < 32; ++k) {
+                    double t = k * PI / 16.0;
+                    UnitVector3d p = UnitVector3d(
+                        std::cos(0.999 * r) * v +
+                        std::sin(0.999 * r) * (std::cos(t) * u + std::sin(t) * w));
+                    CHECK(envelope.contains(pixelization.index(p)));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE(EnvelopeAndInteriorAtLevels) {
+    std::vector<int> levels = {10, 2, 6, 0};
+    std::vector<Circle> circles = {
+        Circle(UnitVector3d(1, 1, 1), Angle(1e-5)),
+        Circle(UnitVector3d(0.3, -0.2, 0.9), Angle(0.01)),
+        Circle(UnitVector3d::Z(), Angle(0.3)),
+        Circle(UnitVector3d(-1, 0.5, 0.1), Angle(1.5))
+    };
+    for (Q3cPixelization const & pixelization: {Q3cPixelization(3, 0, false),
+                                                Q3cPixelization(3, 0, true)}) {
+        for (Circle const & c: circles) {
+            Box b = c.getBoundingBox();
+            for (Region const * r: {static_cast<Region const *>(&c),
+                                    static_cast<Region const *>(&b)}) {
+                std::vector<RangeSet> envelopes =
+                    pixelization.envelopeAtLevels(*r, levels);
+                std::vector<RangeSet> interiors =
+                    pixelization.interiorAtLevels(*r, levels);
+                for (size_t i = 0; i < levels.size(); ++i) {
+                    Q3cPixelization p(levels[i], 0, pixelization.isHilbertOrder());
+                    // Traversals for coarser levels can start closer to r.
+                    RangeSet e = p.envelope(*r);
+                    CHECK(envelopes[i].isWithin(e));
+                    CHECK(envelopes[i] == e || levels[i] < 10);
+                    CHECK(interiors[i] == p.interior(*r));
+                }
+            }
+        }
+    }
+    CHECK_THROW(Q3cPixelization(3).envelopeAtLevels(Circle::full(), {31}),
+                std::invalid_argument);
+}
+
+TEST_CASE(CombinedEnvelopeAndInterior) {
+    std::vector<std::unique_ptr<Region>> regions;
+    regions.emplace_back(new Circle(UnitVector3d(1, 1, 1), Angle(1e-5)));
+    regions.emplace_back(new Circle(UnitVector3d(0.3, -0.2, 0.9), Angle(0.05)));
+    regions.emplace_back(new Circle(UnitVector3d(-1, 0.5, 0.1), Angle(1.5)));
+    regions.emplace_back(new Box(LonLat::fromDegrees(10, 20),
+                                 Angle::fromDegrees(3), Angle::fromDegrees(1)));
+    regions.emplace_back(new ConvexPolygon(
+        UnitVector3d(1, 0, 0.1), UnitVector3d(1, 0.1, 0), UnitVector3d(1, 0, -0.1)));
+    regions.emplace_back(new Ellipse(UnitVector3d::Z(), Angle(0.2), Angle(0.1),
+                                     Angle(0.5)));
+    Q3cPixelization pixelization(9, 0, true);
+    for (auto const & r: regions) {
+        EnvelopeAndInterior both = pixelization.envelopeAndInterior(*r);
+        RangeSet envelope = pixelization.envelope(*r);
+        RangeSet interior = pixelization.interior(*r);
+        CHECK(both.envelope == envelope);
+        CHECK(both.interior == interior);
+        for (size_t maxRanges: {1, 4, 20}) {
+            both = pixelization.envelopeAndInterior(*r, maxRanges);
+            CHECK(both.envelope.size() <= maxRanges);
+            CHECK(both.interior.size() <= maxRanges);
+            CHECK(both.envelope.contains(envelope));
+            CHECK(both.interior.isWithin(interior));
+        }
+    }
+}
+
+TEST_CASE(StringConversion) {
+    Q3cPixelization p(5);
+    std::vector<uint64_t> indexes;
+    for (uint64_t i = 0; i < 6 << 10; i += 37) {
+        indexes.push_back(i);
+    }
+    indexes.push_back((6 << 10) - 1);
+    size_t const width = p.maxStringLength();
+    CHECK(width == 7);
+    std::vector<char> buf(indexes.size() * width, 'x');
+    p.toString(indexes.data(), indexes.size(), buf.data(), width);
+    std::vector<uint64_t> parsed(indexes.size());
+    p.fromString(buf.data(), indexes.size(), width, parsed.data());
+    CHECK(parsed == indexes);
+    for (size_t k = 0; k < indexes.size(); ++k) {
+        std::string s = p.toString(indexes[k]);
+        CHECK(std::string(buf.data() + k * width, s.size()) == s);
+        CHECK(std::all_of(buf.data() + k * width + s.size(),
+                          buf.data() + (k + 1) * width,
+                          [](char c) { return c == '\0'; }));
+        CHECK(p.fromString(s) == indexes[k]);
+    }
+    // Fields wider than needed are padded.
+    std::vector<char> wide(2 * (width + 3));
+    p.toString(indexes.data(), 2, wide.data(), width + 3);
+    p.fromString(wide.data(), 2, width + 3, parsed.data());
+    CHECK(parsed[0] == indexes[0] && parsed[1] == indexes[1]);
+    CHECK_THROW(p.toString(&indexes.back(), 1, buf.data(), width - 1),
+                std::invalid_argument);
+    uint64_t invalid = 6 << 10;
+    CHECK_THROW(p.toString(&invalid, 1, buf.data(), width),
+                std::invalid_argument);
+    for (char const * s: {"", "+Z", "+Z0000", "+Z000000", "+W00000", "+Z0004x"}) {
+        CHECK_THROW(p.fromString(s), std::invalid_argument);
+    }
+    CHECK(p.fromString("-Z33333") == (6 << 10) - 1);
+    Q3cPixelization hilbert(5, 0, true);
+    hilbert.toString(indexes.data(), indexes.size(), buf.data(), width);
+    hilbert.fromString(buf.data(), indexes.size(), width, parsed.data());
+    CHECK(parsed == indexes);
+}
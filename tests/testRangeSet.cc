@@ -23,6 +23,16 @@
 /// \file
 /// \brief This file contains tests for the RangeSet class.
 
+#include <algorithm>
+#include <bitset>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
 #include "lsst/sphgeom/RangeSet.h"
 
 #include "test.h"
@@ -126,6 +136,44 @@ TEST_CASE(Insert) {
     CHECK(s.isValid() && s == RangeSet({{2, 3}, {4, 5}, {6, 7}, {8, 9}}));
 }
 
+TEST_CASE(InsertMany) {
+    uint64_t const max = static_cast<uint64_t>(-1);
+    // Check bookend handling.
+    std::vector<uint64_t> v = {0};
+    CHECK(RangeSet(v) == RangeSet(0u));
+    v = {max};
+    CHECK(RangeSet(v) == RangeSet(max));
+    v = {max, 0, 5, max - 1, 1, 5};
+    RangeSet s(v);
+    CHECK(s.isValid() && s == RangeSet({{0, 2}, {5, 6}, {max - 1, 0}}));
+    s.insertMany(nullptr, 0);
+    CHECK(s.isValid() && s == RangeSet({{0, 2}, {5, 6}, {max - 1, 0}}));
+    uint64_t u[3] = {2, 4, 3};
+    s.insertMany(u, 3);
+    CHECK(s.isValid() && s == RangeSet({{0, 6}, {max - 1, 0}}));
+    // Compare against element-wise insertion for inputs large enough to be
+    // radix sorted, with duplicates and runs of consecutive integers.
+    for (int shift: {0, 20, 40, 56}) {
+        v.clear();
+        RangeSet expected;
+        uint64_t x = 12345;
+        for (int i = 0; i < 10000; ++i) {
+            x = x * 6364136223846793005u + 1442695040888963407u;
+            uint64_t w = ((x >> 33) % 4096) << shift;
+            v.push_back(w);
+            v.push_back(w + 1);
+            expected.insert(w);
+            expected.insert(w + 1);
+        }
+        RangeSet bulk(v.begin(), v.end());
+        CHECK(bulk.isValid() && bulk == expected);
+        RangeSet t = {{1, 2}, {max - 3, max - 2}};
+        t.insertMany(v.data(), v.size());
+        expected |= RangeSet({{1, 2}, {max - 3, max - 2}});
+        CHECK(t.isValid() && t == expected);
+    }
+}
+
 TEST_CASE(Erase) {
     RangeSet s{{0, 0}};
     CHECK(s.isValid() && s.full());
@@ -215,6 +263,81 @@ TEST_CASE(SymmetricDifference) {
     CHECK((s ^ s).empty());
 }
 
+TEST_CASE(SkewedSetOperations) {
+    // Operands with very different numbers of ranges are intersected by
+    // galloping through the larger one. Check results against membership
+    // tests for sets of many sizes, including ones containing 0 and 2^64 - 1.
+    uint64_t const max = static_cast<uint64_t>(-1);
+    uint64_t x = 54321;
+    std::vector<RangeSet> sets;
+    for (int n: {1, 2, 3, 10, 40, 300, 2000}) {
+        RangeSet s;
+        for (int i = 0; i < n; ++i) {
+            x = x * 6364136223846793005u + 1442695040888963407u;
+            uint64_t first = (x >> 33) % 4096;
+            uint64_t len = 1 + (x >> 20) % (4096 / n / 2 + 1);
+            s.insert(first, first + len);
+        }
+        sets.push_back(s);
+        sets.push_back(~s);
+    }
+    for (RangeSet const & a: sets) {
+        for (RangeSet const & b: sets) {
+            RangeSet i = a & b;
+            RangeSet u = a | b;
+            RangeSet d = a - b;
+            CHECK(i.isValid() && u.isValid() && d.isValid());
+            for (uint64_t v = 0; v < 4200; ++v) {
+                CHECK(i.contains(v) == (a.contains(v) && b.contains(v)));
+                CHECK(u.contains(v) == (a.contains(v) || b.contains(v)));
+                CHECK(d.contains(v) == (a.contains(v) && !b.contains(v)));
+            }
+            CHECK(i.contains(max) == (a.contains(max) && b.contains(max)));
+            CHECK(u.contains(max) == (a.contains(max) || b.contains(max)));
+        }
+    }
+}
+
+TEST_CASE(InPlaceSetOperations) {
+    // The assignment operators, and the set operators applied to
+    // temporaries, compute their results in place. Check them against the
+    // out-of-place operations for operands of many relative sizes, some of
+    // which contain 0 and 2^64 - 1.
+    uint64_t x = 12345;
+    std::vector<RangeSet> sets = {RangeSet(), RangeSet(0, 0), RangeSet(0),
+                                  RangeSet(4000, 0)};
+    for (int n: {1, 3, 10, 40, 300, 2000}) {
+        RangeSet s;
+        for (int i = 0; i < n; ++i) {
+            x = x * 6364136223846793005u + 1442695040888963407u;
+            uint64_t first = (x >> 33) % 4096;
+            uint64_t len = 1 + (x >> 20) % (4096 / n / 2 + 1);
+            s.insert(first, first + len);
+        }
+        sets.push_back(s);
+        sets.push_back(~s);
+    }
+    for (RangeSet const & a: sets) {
+        for (RangeSet const & b: sets) {
+            RangeSet i(a), u(a), d(a);
+            i &= b;
+            u |= b;
+            d -= b;
+            CHECK(i.isValid() && i == a.intersection(b));
+            CHECK(u.isValid() && u == a.join(b));
+            CHECK(d.isValid() && d == a.difference(b));
+            CHECK((RangeSet(a) & b) == i);
+            CHECK((RangeSet(a) | b) == u);
+            CHECK((RangeSet(a) - b) == d);
+            CHECK(~RangeSet(a) == a.complemented());
+            for (RangeSet const & c: {sets[5], sets[8]}) {
+                RangeSet r = ((RangeSet(a) & b) | c) - b;
+                CHECK(r.isValid() && r == a.intersection(b).join(c).difference(b));
+            }
+        }
+    }
+}
+
 TEST_CASE(IntersectsAndIsDisjointFrom) {
     RangeSet empty = {};
     RangeSet full = {{0, 0}};
@@ -295,6 +418,46 @@ TEST_CASE(ContainsAndIsWithin) {
     CHECK(b.contains(a));
 }
 
+TEST_CASE(BatchContains) {
+    uint64_t const max = static_cast<uint64_t>(-1);
+    std::vector<RangeSet> sets = {
+        RangeSet(), RangeSet(0, 0), RangeSet(0), RangeSet(max),
+        RangeSet({{0, 1}, {5, 8}, {9, 0}}), RangeSet({{1, 5}, {8, 9}})
+    };
+    RangeSet s;
+    uint64_t x = 987654321;
+    for (int i = 0; i < 500; ++i) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        s.insert((x >> 33) % 65536, (x >> 33) % 65536 + 1 + (x >> 10) % 16);
+    }
+    sets.push_back(s);
+    sets.push_back(~s);
+    // Ascending, descending and unordered queries, with repeats.
+    std::vector<uint64_t> values;
+    for (uint64_t v = 0; v < 66000; v += 3) {
+        values.push_back(v);
+        values.push_back(v);
+    }
+    for (uint64_t v = 66003; v > 0; v -= 7) {
+        values.push_back(v);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        values.push_back((x >> 33) % 70000);
+    }
+    values.push_back(max);
+    values.push_back(0);
+    values.push_back(max);
+    std::unique_ptr<bool[]> out(new bool[values.size()]);
+    for (RangeSet const & t: sets) {
+        t.contains(values.data(), values.size(), out.get());
+        for (size_t i = 0; i < values.size(); ++i) {
+            CHECK(out[i] == t.contains(values[i]));
+        }
+    }
+    s.contains(nullptr, 0, nullptr);
+}
+
 TEST_CASE(Simplify) {
     RangeSet empty;
     RangeSet full(0, 0);
@@ -309,8 +472,325 @@ TEST_CASE(Simplify) {
     CHECK(s.isValid() && s == RangeSet({{0, 4}, {8, 12}, {16, 0}}));
 }
 
+TEST_CASE(Compact) {
+    RangeSet empty;
+    RangeSet full(0, 0);
+    CHECK(empty.compacted(1).empty());
+    CHECK(full.compacted(1).full());
+    CHECK(empty.compactionOverCoverage(1) == 0.0);
+    RangeSet a = {{0, 1}, {5, 8}, {9, 12}, {20, 22}, {30, 0}};
+    CHECK(a.compacted(0) == a);
+    CHECK(a.compacted(5) == a);
+    RangeSet s = a.compacted(4);
+    CHECK(s.isValid() && s == RangeSet({{0, 1}, {5, 12}, {20, 22}, {30, 0}}));
+    s = a.compacted(3);
+    CHECK(s.isValid() && s == RangeSet({{0, 12}, {20, 22}, {30, 0}}));
+    // The two gaps of length 8 are tied, and the lower one is filled first.
+    s = a.compacted(2);
+    CHECK(s.isValid() && s == RangeSet({{0, 22}, {30, 0}}));
+    CHECK(a.compactionOverCoverage(2) ==
+          static_cast<double>(s.cardinality() - a.cardinality()) /
+          static_cast<double>(a.cardinality()));
+    CHECK(a.compacted(1).full());
+    // Compare against an exhaustive search for the cheapest gaps to fill.
+    std::mt19937 rng(80);
+    std::uniform_int_distribution<uint64_t> d(0, 200);
+    for (int trial = 0; trial < 100; ++trial) {
+        RangeSet r;
+        for (int i = 0; i < 12; ++i) {
+            uint64_t u = d(rng);
+            r.insert(u, u + 1 + d(rng) % 5);
+        }
+        std::vector<std::tuple<uint64_t, uint64_t>> ranges(r.begin(), r.end());
+        size_t const n = ranges.size();
+        for (size_t maxRanges = 1; maxRanges < n; ++maxRanges) {
+            uint64_t best = std::numeric_limits<uint64_t>::max();
+            for (uint32_t m = 0; m < (1u << (n - 1)); ++m) {
+                if (std::bitset<32>(m).count() != n - maxRanges) {
+                    continue;
+                }
+                uint64_t added = 0;
+                for (size_t i = 0; i + 1 < n; ++i) {
+                    if (m & (1u << i)) {
+                        added += std::get<0>(ranges[i + 1]) -
+                                 std::get<1>(ranges[i]);
+                    }
+                }
+                best = std::min(best, added);
+            }
+            RangeSet c = r.compacted(maxRanges);
+            CHECK(c.isValid() && c.size() == maxRanges && c.contains(r));
+            CHECK(c.cardinality() - r.cardinality() == best);
+            CHECK(r.compactionOverCoverage(maxRanges) ==
+                  static_cast<double>(best) /
+                  static_cast<double>(r.cardinality()));
+        }
+    }
+}
+
 TEST_CASE(Scale) {
     RangeSet s = {{0, 1}, {5, 8}, {9, 0}};
     s.scale(10);
     CHECK(s.isValid() && s == RangeSet({{0, 10}, {50, 80}, {90, 0}}));
 }
+
+TEST_CASE(CoarsenRefine) {
+    RangeSet empty;
+    RangeSet full(0, 0);
+    CHECK(empty.coarsened(1).empty());
+    CHECK(empty.refined(1).empty());
+    CHECK(full.coarsened(1) == RangeSet(0, static_cast<uint64_t>(1) << 62));
+    CHECK(full.coarsened(1, true) == full.coarsened(1));
+    CHECK(full.refined(3).full());
+    CHECK(RangeSet(5).coarsened(32) == RangeSet(0));
+    CHECK(RangeSet(5).coarsened(32, true).empty());
+    CHECK(RangeSet(5).refined(32).empty());
+    CHECK(RangeSet(0).refined(32).full());
+    RangeSet s = {{3, 9}, {16, 31}, {33, 34}, {40, 48}};
+    RangeSet c = s.coarsened(1);
+    CHECK(c.isValid() && c == RangeSet({{0, 3}, {4, 9}, {10, 12}}));
+    c = s.coarsened(1, true);
+    CHECK(c.isValid() && c == RangeSet({{1, 2}, {4, 7}, {10, 12}}));
+    c = s.coarsened(2);
+    CHECK(c.isValid() && c == RangeSet({{0, 3}}));
+    CHECK(s.coarsened(2, true).empty());
+    CHECK(RangeSet(7, 0).coarsened(1, true) ==
+          RangeSet(2, static_cast<uint64_t>(1) << 62));
+    // Coarsening a refined set is the identity.
+    RangeSet r = s.refined(2);
+    CHECK(r.isValid() && r == RangeSet({{48, 144}, {256, 496},
+                                        {528, 544}, {640, 768}}));
+    CHECK(r.coarsened(2) == s);
+    CHECK(r.coarsened(2, true) == s);
+    // Compare against per-integer computations.
+    RangeSet any;
+    RangeSet all;
+    for (uint64_t u = 0; u < 16; ++u) {
+        if (s.intersects(4 * u, 4 * u + 4)) {
+            any.insert(u);
+        }
+        if (s.contains(4 * u, 4 * u + 4)) {
+            all.insert(u);
+        }
+    }
+    CHECK(s.coarsened(1) == any);
+    CHECK(s.coarsened(1, true) == all);
+}
+
+TEST_CASE(EncodeDecode) {
+    uint64_t const max = static_cast<uint64_t>(-1);
+    RangeSet s;
+    for (uint64_t i = 0; i < 1000; ++i) {
+        s.insert(1000000 + 5 * i, 1000000 + 5 * i + 1 + i % 3);
+    }
+    std::vector<RangeSet> sets = {
+        RangeSet(), RangeSet(0, 0), RangeSet(0), RangeSet(max),
+        RangeSet({{0, 1}, {5, 8}, {9, 0}}), RangeSet({{1, 5}, {8, 9}}),
+        RangeSet({{0, 1}, {max, 0}}), s, ~s
+    };
+    for (RangeSet const & t: sets) {
+        std::vector<uint8_t> buffer = t.encode();
+        CHECK(buffer[0] == RangeSet::TYPE_CODE);
+        RangeSet d = RangeSet::decode(buffer);
+        CHECK(d.isValid() && d == t);
+        // The decoder must produce the same ranges, and answer the same
+        // intersection queries.
+        RangeSetDecoder decoder(buffer);
+        CHECK(decoder.size() == t.size());
+        CHECK(decoder.empty() == t.empty());
+        uint64_t first = 0, last = 0;
+        for (auto r: t) {
+            CHECK(decoder.next(first, last));
+            CHECK(first == std::get<0>(r) && last == std::get<1>(r));
+        }
+        CHECK(!decoder.next(first, last));
+        decoder.rewind();
+        CHECK(decoder.next(first, last) == !t.empty());
+        for (uint64_t a: {uint64_t(0), uint64_t(1), uint64_t(4), uint64_t(8),
+                          uint64_t(1000003), uint64_t(1004000), max}) {
+            for (uint64_t b: {uint64_t(0), uint64_t(2), uint64_t(6),
+                              uint64_t(1000004), uint64_t(2000000), max}) {
+                CHECK(decoder.intersects(a, b) == t.intersects(a, b));
+            }
+            CHECK(decoder.intersects(a) == t.intersects(a));
+        }
+    }
+    // Closely spaced ranges take a couple of bytes per range.
+    CHECK(s.encode().size() < 3 * s.size());
+    // Invalid byte strings are rejected.
+    std::vector<uint8_t> buffer = RangeSet({{1, 5}, {8, 9}}).encode();
+    CHECK_THROW(RangeSet::decode(nullptr, 0), std::runtime_error);
+    CHECK_THROW(RangeSet::decode(buffer.data(), buffer.size() - 1),
+                std::runtime_error);
+    std::vector<uint8_t> bad = buffer;
+    bad.push_back(1);
+    CHECK_THROW(RangeSet::decode(bad), std::runtime_error);
+    bad = buffer;
+    bad[0] = 'c';
+    CHECK_THROW(RangeSet::decode(bad), std::runtime_error);
+    CHECK_THROW(RangeSetDecoder decoder(bad), std::runtime_error);
+    bad = buffer;
+    bad[1] = 2;
+    CHECK_THROW(RangeSet::decode(bad), std::runtime_error);
+    bad = buffer;
+    bad[4] = 0;
+    CHECK_THROW(RangeSet::decode(bad), std::runtime_error);
+    bad = {RangeSet::TYPE_CODE, 0, 2, 0xff, 0xff, 0xff, 0xff, 0xff,
+           0xff, 0xff, 0xff, 0xff, 0x01, 0x01};
+    CHECK_THROW(RangeSet::decode(bad), std::runtime_error);
+}
+
+TEST_CASE(Append) {
+    // Appending ranges must give the same result as inserting them, both
+    // on the fast path (ascending ranges) and when falling back to insert.
+    uint64_t const m = static_cast<uint64_t>(-1);
+    std::vector<std::vector<std::tuple<uint64_t, uint64_t>>> sequences = {
+        {{1, 2}, {2, 3}, {5, 7}, {6, 9}, {6, 8}, {20, 30}, {40, 0}},
+        {{0, 1}, {4, 5}, {4, 10}, {12, 13}, {m, 0}, {3, 3}},
+        {{10, 20}, {5, 6}, {30, 40}, {35, 2}, {50, 60}},
+        {{7, 9}, {9, 8}, {100, 200}, {150, 160}, {200, 300}}
+    };
+    uint64_t x = 1;
+    std::vector<std::tuple<uint64_t, uint64_t>> ascending;
+    for (uint64_t u = 0; u < 100000; u += 1 + x % 17) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        ascending.emplace_back(u, u + 1 + (x >> 60));
+    }
+    sequences.push_back(ascending);
+    for (auto const & ranges: sequences) {
+        RangeSet a, b;
+        for (auto const & r: ranges) {
+            a.append(std::get<0>(r), std::get<1>(r));
+            b.insert(std::get<0>(r), std::get<1>(r));
+            CHECK(a.isValid());
+            CHECK(a == b);
+        }
+        a.complement();
+        b.complement();
+        a.append(1000, 1001);
+        b.insert(1000, 1001);
+        CHECK(a == b);
+    }
+}
+
+TEST_CASE(UnionAllIntersectAll) {
+    CHECK(RangeSet::unionAll({}).empty());
+    CHECK(RangeSet::intersectAll({}).full());
+    uint64_t x = 7;
+    auto next = [&x](uint64_t n) {
+        x = x * 6364136223846793005u + 1442695040888963407u;
+        return (x >> 33) % n;
+    };
+    // Small sets exercise bookends, and large ones the parallel sweep.
+    for (size_t numRanges: {5, 20000}) {
+        std::vector<RangeSet> sets = {RangeSet(0), RangeSet(0, 0)};
+        for (int i = 0; i < 12; ++i) {
+            RangeSet s;
+            for (size_t j = 0; j < numRanges; ++j) {
+                uint64_t first = next(10 * numRanges);
+                s.insert(first, first + 1 + next(5));
+            }
+            if (i % 3 == 0) {
+                s.complement();
+            }
+            sets.push_back(s);
+        }
+        for (size_t k: {size_t(1), size_t(2), size_t(3), sets.size()}) {
+            for (size_t begin = 0; begin + k <= sets.size(); begin += k) {
+                std::vector<RangeSet> v(sets.begin() + begin,
+                                        sets.begin() + begin + k);
+                RangeSet u, i;
+                i.fill();
+                for (RangeSet const & s: v) {
+                    u |= s;
+                    i &= s;
+                }
+                for (unsigned numThreads: {1, 4}) {
+                    RangeSet ua = RangeSet::unionAll(v, numThreads);
+                    RangeSet ia = RangeSet::intersectAll(v, numThreads);
+                    CHECK(ua.isValid() && ua == u);
+                    CHECK(ia.isValid() && ia == i);
+                }
+            }
+        }
+    }
+}
+
+namespace {
+
+// `CountingResource` counts the allocations it forwards to the default
+// memory resource.
+struct CountingResource : std::pmr::memory_resource {
+    size_t allocations = 0;
+
+    void * do_allocate(size_t bytes, size_t alignment) override {
+        ++allocations;
+        return std::pmr::get_default_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * p, size_t bytes, size_t alignment) override {
+        std::pmr::get_default_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const & r) const noexcept override {
+        return this == &r;
+    }
+};
+
+} // unnamed namespace
+
+TEST_CASE(Allocators) {
+    CountingResource counter;
+    std::pmr::memory_resource * heap = std::pmr::get_default_resource();
+    RangeSet s(&counter);
+    CHECK(s.isValid() && s.empty());
+    CHECK(s.get_allocator().resource() == &counter);
+    size_t n = counter.allocations;
+    CHECK(n > 0);
+    for (uint64_t i = 0; i < 100; ++i) {
+        s.insert(3 * i, 3 * i + 1);
+    }
+    CHECK(counter.allocations > n);
+    // Sets derived from s use its memory resource, except for copies.
+    RangeSet t{RangeSet(7, 9)};
+    for (RangeSet const & r: {s & t, s | t, s - t, s ^ t, ~s,
+                              s.scaled(2), s.simplified(2), s.coarsened(1),
+                              s.refined(1)}) {
+        CHECK(r.get_allocator().resource() == &counter);
+    }
+    CHECK(RangeSet(s).get_allocator().resource() == heap);
+    RangeSet u(s, heap);
+    CHECK(u == s && u.get_allocator().resource() == heap);
+    RangeSet v(std::move(u), &counter);
+    CHECK(v == s && v.get_allocator().resource() == &counter);
+    // Assignment, insertion and in-place operations keep the resource.
+    t = s;
+    CHECK(t == s && t.get_allocator().resource() == heap);
+    t.insertMany(std::vector<uint64_t>{1, 2, 500}.data(), 3);
+    t -= RangeSet(0, 2);
+    s |= t;
+    s.coarsen(1);
+    CHECK(s.isValid() && s.get_allocator().resource() == &counter);
+    // Swapping sets with different resources exchanges their contents,
+    // but not their resources.
+    RangeSet a(&counter);
+    a.insert(1, 5);
+    RangeSet b = {{10, 20}, {30, 40}};
+    a.swap(b);
+    CHECK(a == RangeSet({{10, 20}, {30, 40}}) && b == RangeSet(1, 5));
+    CHECK(a.get_allocator().resource() == &counter);
+    CHECK(b.get_allocator().resource() == heap);
+    CHECK(a.isValid() && b.isValid());
+    // Operators applied to temporaries reuse their storage.
+    RangeSet big(&counter);
+    for (uint64_t i = 0; i < 1000; ++i) {
+        big.insert(4 * i, 4 * i + 3);
+    }
+    RangeSet small = {{5, 17}, {100, 2000}, {3000, 3003}};
+    big -= small;
+    n = counter.allocations;
+    RangeSet r = ~((std::move(big) & ~small) | RangeSet(6, 9));
+    CHECK(counter.allocations == n);
+    CHECK(r.get_allocator().resource() == &counter);
+    CHECK(r.isValid() && !r.contains(4) && r.contains(5) && !r.contains(8));
+}
@@ -0,0 +1,128 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the RangeSetExpression class.
+
+#include <vector>
+
+#include "lsst/sphgeom/RangeSetExpression.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+std::vector<RangeSet> makeSets() {
+    uint64_t x = 31415;
+    std::vector<RangeSet> sets = {RangeSet(), RangeSet(0, 0), RangeSet(0),
+                                  RangeSet(1000, 0)};
+    for (int n: {1, 5, 40, 200}) {
+        RangeSet s;
+        for (int i = 0; i < n; ++i) {
+            x = x * 6364136223846793005u + 1442695040888963407u;
+            uint64_t first = (x >> 33) % 1024;
+            uint64_t len = 1 + (x >> 20) % (1024 / n + 1);
+            s.insert(first, first + len);
+        }
+        sets.push_back(s);
+        sets.push_back(~s);
+    }
+    return sets;
+}
+
+void checkExpression(RangeSetExpression const & e, RangeSet const & expected) {
+    RangeSet s = e.evaluate();
+    CHECK(s.isValid());
+    CHECK(s == expected);
+    CHECK(e.empty() == expected.empty());
+    CHECK(e.cardinality() == expected.cardinality());
+    for (uint64_t u: {uint64_t(0), uint64_t(1), uint64_t(500), uint64_t(1023),
+                      static_cast<uint64_t>(-1)}) {
+        CHECK(e.contains(u) == expected.contains(u));
+    }
+}
+
+} // unnamed namespace
+
+TEST_CASE(Operand) {
+    for (RangeSet const & s: makeSets()) {
+        checkExpression(RangeSetExpression(s), s);
+        checkExpression(~RangeSetExpression(s), ~s);
+    }
+}
+
+TEST_CASE(BinaryOperators) {
+    std::vector<RangeSet> sets = makeSets();
+    for (RangeSet const & a: sets) {
+        for (RangeSet const & b: sets) {
+            RangeSetExpression e(a);
+            checkExpression(e & b, a & b);
+            checkExpression(e | b, a | b);
+            checkExpression(e - b, a - b);
+            checkExpression(e ^ b, a ^ b);
+        }
+    }
+}
+
+TEST_CASE(Combinations) {
+    std::vector<RangeSet> sets = makeSets();
+    for (size_t i = 0; i + 3 < sets.size(); ++i) {
+        RangeSet const & a = sets[i];
+        RangeSet const & b = sets[i + 1];
+        RangeSet const & c = sets[i + 2];
+        RangeSet const & d = sets[i + 3];
+        RangeSetExpression e = (RangeSetExpression(a) & b) -
+                               (RangeSetExpression(c) | d);
+        checkExpression(e, (a & b) - (c | d));
+        checkExpression(~e ^ a, ~((a & b) - (c | d)) ^ a);
+        // Repeated operands are allowed.
+        checkExpression(e | (RangeSetExpression(a) - c), e.evaluate() | (a - c));
+        checkExpression(RangeSetExpression(a) & ~RangeSetExpression(a),
+                        RangeSet());
+    }
+}
+
+TEST_CASE(ManyOperands) {
+    // Expressions with many distinct operands are evaluated differently
+    // from those with only a few.
+    std::vector<RangeSet> sets = makeSets();
+    RangeSetExpression e(sets[4]);
+    RangeSet expected = sets[4];
+    for (size_t i = 5; i < sets.size(); ++i) {
+        if (i % 3 == 0) {
+            e = e - sets[i];
+            expected -= sets[i];
+        } else if (i % 3 == 1) {
+            e = e ^ sets[i];
+            expected ^= sets[i];
+        } else {
+            e = ~e | sets[i];
+            expected = ~expected | sets[i];
+        }
+        checkExpression(e, expected);
+        checkExpression(e & sets[0], RangeSet());
+        checkExpression(e | sets[1], RangeSet(0, 0));
+    }
+}
@@ -0,0 +1,152 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the RangeSetIndex class.
+
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/RangeSet.h"
+#include "lsst/sphgeom/RangeSetIndex.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+// `members` returns the integers in a small set, in ascending order.
+std::vector<uint64_t> members(RangeSet const & s) {
+    std::vector<uint64_t> v;
+    for (auto const & r: s) {
+        for (uint64_t i = std::get<0>(r); i != std::get<1>(r); ++i) {
+            v.push_back(i);
+        }
+    }
+    return v;
+}
+
+TEST_CASE(EmptySet) {
+    RangeSetIndex index;
+    CHECK(index.empty());
+    CHECK(index.cardinality() == 0);
+    CHECK(index.rank(12) == 0);
+    CHECK(index.select(0, 10).empty());
+    CHECK_THROW(index.select(0), std::out_of_range);
+    std::mt19937_64 rng(1);
+    uint64_t out[1];
+    CHECK_THROW(index.sample(1, rng, out), std::invalid_argument);
+    CHECK(RangeSetIndex(RangeSet()).getRangeSet().empty());
+}
+
+TEST_CASE(FullSet) {
+    RangeSetIndex index(RangeSet(0, 0));
+    CHECK(index.full());
+    CHECK(!index.empty());
+    CHECK(index.cardinality() == 0);
+    CHECK(index.select(12345) == 12345);
+    CHECK(index.select(~static_cast<uint64_t>(0)) == ~static_cast<uint64_t>(0));
+    CHECK(index.rank(77) == 77);
+    CHECK(index.select(5, 10) == RangeSet(5, 10));
+    CHECK(index.select(5, 0) == RangeSet(5, 0));
+    CHECK(index.select(10, 5).empty());
+    CHECK(index.getRangeSet().full());
+}
+
+TEST_CASE(SelectAndRank) {
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<uint64_t> u(0, 2000);
+    for (int trial = 0; trial < 20; ++trial) {
+        RangeSet s;
+        for (int i = 0; i < 50; ++i) {
+            uint64_t a = u(rng);
+            s.insert(a, a + 1 + u(rng) % 20);
+        }
+        RangeSetIndex index(s);
+        std::vector<uint64_t> v = members(s);
+        CHECK(index.getRangeSet() == s);
+        CHECK(index.size() == s.size());
+        REQUIRE(index.cardinality() == v.size());
+        for (size_t k = 0; k < v.size(); ++k) {
+            CHECK(index.select(k) == v[k]);
+            CHECK(index.rank(v[k]) == k);
+        }
+        CHECK_THROW(index.select(v.size()), std::out_of_range);
+        size_t k = 0;
+        for (uint64_t i = 0; i < 2100; ++i) {
+            while (k < v.size() && v[k] < i) {
+                ++k;
+            }
+            CHECK(index.rank(i) == k);
+        }
+        // Pages of the set are sets of consecutive members.
+        for (uint64_t first: {0, 1, 17, 100, 5000}) {
+            for (uint64_t n: {1, 10, 333}) {
+                RangeSet page;
+                for (uint64_t j = first; j < first + n && j < v.size(); ++j) {
+                    page.insert(v[j]);
+                }
+                CHECK(index.select(first, first + n) == page);
+            }
+        }
+        CHECK(index.select(0, 0) == s);
+    }
+}
+
+TEST_CASE(Unbounded) {
+    // The last range of these sets ends at 2⁶⁴.
+    uint64_t const max = ~static_cast<uint64_t>(0);
+    RangeSet s(1, 0);
+    RangeSetIndex index(s);
+    CHECK(!index.full());
+    CHECK(index.cardinality() == max);
+    CHECK(index.select(max - 1) == max);
+    CHECK_THROW(index.select(max), std::out_of_range);
+    CHECK(index.rank(max) == max - 1);
+    CHECK(index.rank(0) == 0);
+    CHECK(index.select(max - 2, 0) == RangeSet(max - 1, 0));
+    RangeSet t = RangeSet(3, 5) | RangeSet(max - 1, 0);
+    RangeSetIndex tindex(t);
+    CHECK(tindex.cardinality() == 4);
+    CHECK(tindex.select(2) == max - 1);
+    CHECK(tindex.rank(max) == 3);
+    CHECK(tindex.select(1, 3) == (RangeSet(4) | RangeSet(max - 1)));
+    CHECK(tindex.getRangeSet() == t);
+}
+
+TEST_CASE(Sample) {
+    RangeSet s = RangeSet(10, 20) | RangeSet(100, 110);
+    RangeSetIndex index(s);
+    std::mt19937_64 rng(5);
+    std::vector<uint64_t> out(2000);
+    index.sample(out.size(), rng, out.data());
+    size_t low = 0;
+    for (uint64_t i: out) {
+        CHECK(s.contains(i));
+        low += i < 50;
+    }
+    // Both ranges have the same length, so about half of the samples
+    // should fall in each.
+    CHECK(low > 800 && low < 1200);
+    RangeSetIndex(RangeSet(0, 0)).sample(out.size(), rng, out.data());
+}
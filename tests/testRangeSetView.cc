@@ -0,0 +1,121 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the RangeSetView class.
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "lsst/sphgeom/RangeSetView.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+using Range = std::tuple<uint64_t, uint64_t>;
+
+std::vector<RangeSet> makeSets() {
+    RangeSet sparse;
+    for (uint64_t u = 3; u < 100000; u += 37) {
+        sparse.insert(u, u + (u % 5) + 1);
+    }
+    return {
+        RangeSet(), RangeSet(0, 0), RangeSet(0), RangeSet(5, 10),
+        RangeSet(10, 5), RangeSet(static_cast<uint64_t>(-1)),
+        sparse, ~sparse
+    };
+}
+
+void checkView(RangeSetView const & v, RangeSet const & s) {
+    CHECK(v.isValid());
+    CHECK(v.toRangeSet() == s);
+    CHECK(v.empty() == s.empty());
+    CHECK(v.full() == s.full());
+    CHECK(v.size() == s.size());
+    CHECK(v.cardinality() == s.cardinality());
+    std::vector<Range> vr(v.begin(), v.end());
+    std::vector<Range> sr(s.begin(), s.end());
+    CHECK(vr == sr);
+    for (RangeSet const & t: makeSets()) {
+        CHECK(v.intersects(t) == s.intersects(t));
+        CHECK(v.contains(t) == s.contains(t));
+        CHECK(v.isWithin(t) == s.isWithin(t));
+        CHECK(v.isDisjointFrom(t) == s.isDisjointFrom(t));
+    }
+    for (uint64_t u = 0; u < 100100; u += 13) {
+        CHECK(v.contains(u) == s.contains(u));
+        CHECK(v.intersects(u, u + 50) == s.intersects(u, u + 50));
+        CHECK(v.contains(u, u + 3) == s.contains(u, u + 3));
+        CHECK(v.isWithin(u, 100100 - u) == s.isWithin(u, 100100 - u));
+    }
+}
+
+} // unnamed namespace
+
+TEST_CASE(InMemory) {
+    CHECK(RangeSetView().empty());
+    for (RangeSet const & s: makeSets()) {
+        checkView(RangeSetView(s), s);
+    }
+}
+
+TEST_CASE(MappedFile) {
+    std::string path = "testRangeSetView.tmp";
+    for (RangeSet const & s: makeSets()) {
+        RangeSetView::write(s, path);
+        RangeSetView v(path);
+        // The mapping outlives the file name, and is shared by copies.
+        std::remove(path.c_str());
+        RangeSetView w = v;
+        checkView(w, s);
+    }
+}
+
+TEST_CASE(InvalidBuffer) {
+    std::vector<uint64_t> buffer = {RangeSetView::MAGIC, 1, 4, 0, 5, 10, 0};
+    checkView(RangeSetView(buffer.data(), 8 * buffer.size()),
+              RangeSet(0, 5) | RangeSet(10, 0));
+    CHECK_THROW(RangeSetView(buffer.data(), 16), std::runtime_error);
+    CHECK_THROW(RangeSetView(buffer.data(), 8 * buffer.size() - 1),
+                std::runtime_error);
+    buffer[2] = 3;
+    CHECK_THROW(RangeSetView(buffer.data(), 8 * buffer.size()),
+                std::runtime_error);
+    buffer[2] = 4;
+    buffer[6] = 7;
+    CHECK_THROW(RangeSetView(buffer.data(), 8 * buffer.size()),
+                std::runtime_error);
+    buffer[6] = 0;
+    buffer[4] = 11;
+    CHECK(!RangeSetView(buffer.data(), 8 * buffer.size()).isValid());
+    buffer[0] = 0;
+    CHECK_THROW(RangeSetView(buffer.data(), 8 * buffer.size()),
+                std::runtime_error);
+    CHECK_THROW(RangeSetView("does/not/exist"), std::runtime_error);
+}
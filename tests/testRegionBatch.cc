@@ -0,0 +1,131 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for region batch encoding and decoding.
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/RegionBatch.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+std::vector<std::unique_ptr<Region>> makeRegions() {
+    std::vector<std::unique_ptr<Region>> regions;
+    Circle c(UnitVector3d(1, 1, 1), Angle(0.2));
+    Box b = Box::fromDegrees(10, 20, 30, 40);
+    ConvexPolygon p(UnitVector3d::X(), UnitVector3d::Y(), UnitVector3d::Z());
+    Ellipse e(UnitVector3d(1, 0, 1), UnitVector3d(1, 0.2, 1), Angle(0.3));
+    UnionRegion u(c, p);
+    regions.push_back(c.clone());
+    regions.push_back(b.clone());
+    regions.push_back(p.clone());
+    regions.push_back(e.clone());
+    regions.push_back(u.clone());
+    regions.push_back(IntersectionRegion(u, b).clone());
+    return regions;
+}
+
+TEST_CASE(EncodeTo) {
+    std::vector<uint8_t> buffer = {1, 2, 3};
+    for (auto const & r: makeRegions()) {
+        std::vector<uint8_t> expected = r->encode();
+        size_t const n = buffer.size();
+        r->encodeTo(buffer);
+        CHECK(std::vector<uint8_t>(buffer.begin() + n, buffer.end()) == expected);
+        CHECK(Region::decode(expected)->encode() == expected);
+    }
+}
+
+TEST_CASE(RoundTrip) {
+    std::vector<std::unique_ptr<Region>> regions = makeRegions();
+    // Batches need not start at the beginning of a buffer.
+    std::vector<uint8_t> buffer = {42};
+    RegionBatchEncoder encoder(buffer);
+    for (int i = 0; i < 20; ++i) {
+        encoder.append(*regions[i % regions.size()]);
+    }
+    CHECK(encoder.size() == 20);
+    encoder.finish();
+    encoder.finish();
+    CHECK_THROW(encoder.append(*regions[0]), std::runtime_error);
+    CHECK(buffer[0] == 42);
+    RegionBatchDecoder decoder(buffer.data() + 1, buffer.size() - 1);
+    CHECK(decoder.size() == 20);
+    DecodedRegion storage;
+    // Decode in reverse order to exercise random access.
+    for (size_t i = 20; i-- > 0;) {
+        Region const & expected = *regions[i % regions.size()];
+        std::pair<uint8_t const *, size_t> s = decoder.getEncoded(i);
+        CHECK(std::vector<uint8_t>(s.first, s.first + s.second) == expected.encode());
+        CHECK(decoder.decode(i)->encode() == expected.encode());
+        CHECK(decoder.decode(i, storage).encode() == expected.encode());
+        CHECK(decoder.relate(i, *regions[1]) == expected.relate(*regions[1]));
+    }
+    CHECK_THROW(decoder.getEncoded(20), std::out_of_range);
+}
+
+TEST_CASE(EmptyBatch) {
+    std::vector<uint8_t> buffer;
+    RegionBatchEncoder encoder(buffer);
+    encoder.finish();
+    RegionBatchDecoder decoder(buffer);
+    CHECK(decoder.empty());
+}
+
+TEST_CASE(InvalidBatch) {
+    std::vector<uint8_t> buffer;
+    RegionBatchEncoder encoder(buffer);
+    encoder.append(Circle(UnitVector3d::Z(), Angle(0.1)));
+    encoder.append(Box::fromDegrees(0, 0, 1, 1));
+    encoder.finish();
+    std::vector<uint8_t> bad(buffer);
+    bad[0] = 'x';
+    CHECK_THROW(RegionBatchDecoder{bad}, std::runtime_error);
+    // An impossible region count.
+    bad = buffer;
+    bad[bad.size() - 1] = 0xff;
+    CHECK_THROW(RegionBatchDecoder{bad}, std::runtime_error);
+    // A corrupt offset.
+    bad = buffer;
+    bad[bad.size() - 16] = 0xff;
+    RegionBatchDecoder d1(bad);
+    CHECK_THROW(d1.getEncoded(1), std::runtime_error);
+    // A corrupt size prefix.
+    bad = buffer;
+    bad[1 + 7] = 0x10;
+    RegionBatchDecoder d2(bad);
+    CHECK_THROW(d2.getEncoded(0), std::runtime_error);
+    // A missing index.
+    bad.assign(buffer.begin(), buffer.begin() + 5);
+    CHECK_THROW(RegionBatchDecoder{bad}, std::runtime_error);
+}
@@ -0,0 +1,124 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+/// \file
+/// \brief This file contains tests for the RegionIndex class.
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/RegionIndex.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+UnitVector3d randomPoint(std::mt19937 & rng) {
+    std::normal_distribution<double> d;
+    return UnitVector3d(d(rng), d(rng), d(rng));
+}
+
+ConvexPolygon randomPolygon(std::mt19937 & rng, double size) {
+    UnitVector3d c = randomPoint(rng);
+    std::vector<UnitVector3d> points;
+    for (int j = 0; j < 5; ++j) {
+        points.emplace_back(c + size * Vector3d(randomPoint(rng)));
+    }
+    return ConvexPolygon::convexHull(points);
+}
+
+RegionIndex makeIndex(std::mt19937 & rng, size_t n) {
+    std::vector<std::unique_ptr<Region>> regions;
+    for (size_t i = 0; i < n; ++i) {
+        regions.push_back(std::make_unique<ConvexPolygon>(randomPolygon(rng, 0.03)));
+    }
+    regions.push_back(std::make_unique<Circle>(Circle::empty()));
+    return RegionIndex(std::move(regions));
+}
+
+TEST_CASE(Empty) {
+    RegionIndex index;
+    CHECK(index.empty());
+    CHECK(index.overlapping(Circle::full()).empty());
+    CHECK(index.containing(UnitVector3d::Z()).empty());
+    CHECK(RegionIndex::decode(index.encode())->empty());
+}
+
+TEST_CASE(NullRegion) {
+    std::vector<std::unique_ptr<Region>> regions;
+    regions.push_back(nullptr);
+    CHECK_THROW(RegionIndex(std::move(regions)), std::invalid_argument);
+}
+
+TEST_CASE(Overlapping) {
+    std::mt19937 rng(3);
+    RegionIndex index = makeIndex(rng, 2000);
+    for (int i = 0; i < 200; ++i) {
+        ConvexPolygon query = randomPolygon(rng, 0.1);
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < index.size(); ++j) {
+            if ((index.getRegion(j).relate(query) & DISJOINT) == 0) {
+                expected.push_back(j);
+            }
+        }
+        CHECK(index.overlapping(query) == expected);
+    }
+    // Every non-empty region overlaps the full circle.
+    CHECK(index.overlapping(Circle::full()).size() == index.size() - 1);
+    CHECK(index.overlapping(Circle::empty()).empty());
+}
+
+TEST_CASE(Containing) {
+    std::mt19937 rng(4);
+    RegionIndex index = makeIndex(rng, 2000);
+    for (int i = 0; i < 2000; ++i) {
+        UnitVector3d v = randomPoint(rng);
+        std::vector<size_t> expected;
+        for (size_t j = 0; j < index.size(); ++j) {
+            if (index.getRegion(j).contains(v)) {
+                expected.push_back(j);
+            }
+        }
+        CHECK(index.containing(v) == expected);
+    }
+}
+
+TEST_CASE(Codec) {
+    std::mt19937 rng(5);
+    RegionIndex index = makeIndex(rng, 10);
+    std::vector<uint8_t> buffer = index.encode();
+    std::unique_ptr<RegionIndex> decoded = RegionIndex::decode(buffer);
+    REQUIRE(decoded->size() == index.size());
+    for (size_t i = 0; i < index.size(); ++i) {
+        CHECK(decoded->getRegion(i).encode() == index.getRegion(i).encode());
+    }
+    CHECK_THROW(RegionIndex::decode(buffer.data(), buffer.size() - 1), std::runtime_error);
+    buffer.push_back(0);
+    CHECK_THROW(RegionIndex::decode(buffer), std::runtime_error);
+    buffer[0] = 'p';
+    CHECK_THROW(RegionIndex::decode(buffer), std::runtime_error);
+}
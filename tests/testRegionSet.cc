@@ -0,0 +1,133 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+/// \file
+/// \brief This file contains tests for the RegionSet class.
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/RegionSet.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+UnitVector3d randomPoint(std::mt19937 & rng) {
+    std::normal_distribution<double> d;
+    return UnitVector3d(d(rng), d(rng), d(rng));
+}
+
+// `bruteForce` returns the indexes of the regions containing v.
+std::vector<size_t> bruteForce(RegionSet const & s, UnitVector3d const & v) {
+    std::vector<size_t> indexes;
+    for (size_t i = 0; i < s.size(); ++i) {
+        if (s.getRegion(i).contains(v)) {
+            indexes.push_back(i);
+        }
+    }
+    return indexes;
+}
+
+RegionSet makeRegionSet(std::mt19937 & rng, size_t n) {
+    std::vector<std::unique_ptr<Region>> regions;
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d c = randomPoint(rng);
+        switch (i % 3) {
+            case 0:
+                regions.push_back(std::make_unique<Circle>(c, Angle(0.05)));
+                break;
+            case 1:
+                regions.push_back(std::make_unique<Box>(LonLat(c), Angle(0.04), Angle(0.03)));
+                break;
+            default:
+            {
+                std::vector<UnitVector3d> points;
+                for (int j = 0; j < 5; ++j) {
+                    points.emplace_back(c + 0.05 * Vector3d(randomPoint(rng)));
+                }
+                regions.push_back(std::make_unique<ConvexPolygon>(
+                    ConvexPolygon::convexHull(points)));
+                break;
+            }
+        }
+    }
+    // Empty regions never contain anything.
+    regions.push_back(std::make_unique<Circle>(Circle::empty()));
+    return RegionSet(std::move(regions));
+}
+
+TEST_CASE(Empty) {
+    RegionSet s;
+    CHECK(s.empty());
+    CHECK(s.size() == 0);
+    CHECK(!s.containsAny(UnitVector3d::X()));
+    CHECK(s.containsWhich(UnitVector3d::X()).empty());
+}
+
+TEST_CASE(NullRegion) {
+    std::vector<std::unique_ptr<Region>> regions;
+    regions.push_back(nullptr);
+    CHECK_THROW(RegionSet(std::move(regions)), std::invalid_argument);
+}
+
+TEST_CASE(ContainsWhich) {
+    std::mt19937 rng(1);
+    RegionSet s = makeRegionSet(rng, 1000);
+    CHECK(s.size() == 1001);
+    for (int i = 0; i < 2000; ++i) {
+        UnitVector3d v = randomPoint(rng);
+        std::vector<size_t> expected = bruteForce(s, v);
+        CHECK(s.containsWhich(v) == expected);
+        CHECK(s.containsAny(v) == !expected.empty());
+    }
+    // Points at region centers are guaranteed hits.
+    Circle const & c = dynamic_cast<Circle const &>(s.getRegion(0));
+    std::vector<size_t> hits = s.containsWhich(c.getCenter());
+    CHECK(!hits.empty() && hits[0] == 0);
+    CHECK(s.containsAny(c.getCenter().x(), c.getCenter().y(), c.getCenter().z()));
+}
+
+TEST_CASE(BatchContainsWhich) {
+    std::mt19937 rng(2);
+    RegionSet s = makeRegionSet(rng, 500);
+    std::vector<UnitVector3d> points;
+    for (int i = 0; i < 1000; ++i) {
+        points.push_back(randomPoint(rng));
+    }
+    std::vector<size_t> offsets;
+    std::vector<size_t> indexes;
+    s.containsWhich(points.data(), points.size(), offsets, indexes);
+    REQUIRE(offsets.size() == points.size() + 1);
+    CHECK(offsets.front() == 0);
+    CHECK(offsets.back() == indexes.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        std::vector<size_t> hits(indexes.begin() + offsets[i],
+                                 indexes.begin() + offsets[i + 1]);
+        CHECK(hits == bruteForce(s, points[i]));
+    }
+}
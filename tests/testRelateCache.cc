@@ -0,0 +1,157 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the RelateCache class.
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/RegionBatch.h"
+#include "lsst/sphgeom/RelateCache.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+// Return a row of quadrilaterals along the equator, each overlapping the
+// next.
+std::vector<ConvexPolygon> makePolygons() {
+    std::vector<ConvexPolygon> polygons;
+    for (int i = 0; i < 20; ++i) {
+        std::vector<UnitVector3d> vertices = {
+            UnitVector3d(LonLat::fromDegrees(i, -1)),
+            UnitVector3d(LonLat::fromDegrees(i + 1.5, -1)),
+            UnitVector3d(LonLat::fromDegrees(i + 1.5, 1)),
+            UnitVector3d(LonLat::fromDegrees(i, 1))};
+        polygons.push_back(ConvexPolygon(vertices));
+    }
+    return polygons;
+}
+
+TEST_CASE(Construction) {
+    CHECK_THROW(RelateCache(0), std::invalid_argument);
+    RelateCache cache(1 << 20);
+    CHECK(cache.getMaxBytes() == 1 << 20);
+    CHECK(cache.getBytes() <= cache.getMaxBytes());
+    // A cache too small for its slot table works, but stores nothing.
+    RelateCache tiny(1);
+    Circle c(UnitVector3d::X(), Angle(0.1));
+    size_t bytes = tiny.getBytes();
+    CHECK(tiny.relate(c, c) == (CONTAINS | WITHIN));
+    CHECK(tiny.getBytes() == bytes);
+}
+
+TEST_CASE(Relate) {
+    std::vector<ConvexPolygon> polygons = makePolygons();
+    Circle query(UnitVector3d(LonLat::fromDegrees(5, 0)), Angle::fromDegrees(2));
+    RelateCache cache(1 << 20);
+    size_t bytes = cache.getBytes();
+    for (int pass = 0; pass < 3; ++pass) {
+        for (ConvexPolygon const & p : polygons) {
+            CHECK(cache.relate(p, query) == p.relate(query));
+            CHECK(cache.relate(query, p) == query.relate(p));
+        }
+        if (pass == 0) {
+            CHECK(cache.getBytes() > bytes);
+            bytes = cache.getBytes();
+        } else {
+            // Repeated relates hit the cache, and store nothing new.
+            CHECK(cache.getBytes() == bytes);
+        }
+    }
+    CHECK(cache.getBytes() <= cache.getMaxBytes());
+    cache.clear();
+    CHECK(cache.getBytes() < bytes);
+}
+
+TEST_CASE(Eviction) {
+    // A cache with only a few slots must never return a result for the
+    // wrong pair of regions.
+    RelateCache cache(4000);
+    std::vector<ConvexPolygon> polygons = makePolygons();
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t i = 0; i + 1 < polygons.size(); ++i) {
+            CHECK(cache.relate(polygons[i], polygons[i + 1]) == INTERSECTS);
+            CHECK(cache.relate(polygons[i], polygons[i]) == (CONTAINS | WITHIN));
+        }
+    }
+    CHECK(cache.getBytes() <= cache.getMaxBytes());
+}
+
+TEST_CASE(Batch) {
+    std::vector<ConvexPolygon> polygons = makePolygons();
+    std::vector<uint8_t> buffer;
+    RegionBatchEncoder encoder(buffer);
+    for (ConvexPolygon const & p : polygons) {
+        encoder.append(p);
+    }
+    encoder.finish();
+    RegionBatchDecoder decoder(buffer);
+    Box query = Box::fromDegrees(3.2, -0.5, 7.7, 0.5);
+    RelateCache cache(1 << 20);
+    std::vector<Relationship> expected = decoder.relateAll(query);
+    REQUIRE(expected.size() == polygons.size());
+    for (size_t i = 0; i < polygons.size(); ++i) {
+        CHECK(expected[i] == polygons[i].relate(query));
+        CHECK(decoder.relate(i, query, cache) == expected[i]);
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        CHECK(decoder.relateAll(query, &cache) == expected);
+    }
+}
+
+TEST_CASE(Concurrency) {
+    std::vector<ConvexPolygon> polygons = makePolygons();
+    Circle query(UnitVector3d(LonLat::fromDegrees(10, 0)), Angle::fromDegrees(3));
+    std::vector<Relationship> expected;
+    for (ConvexPolygon const & p : polygons) {
+        expected.push_back(p.relate(query));
+    }
+    RelateCache cache(20000);
+    std::vector<int> failures(4, 0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t]() {
+            for (int pass = 0; pass < 50; ++pass) {
+                for (size_t i = 0; i < polygons.size(); ++i) {
+                    if (cache.relate(polygons[i], query) != expected[i]) {
+                        ++failures[t];
+                    }
+                }
+            }
+        });
+    }
+    for (std::thread & t : threads) {
+        t.join();
+    }
+    for (int f : failures) {
+        CHECK(f == 0);
+    }
+    CHECK(cache.getBytes() <= cache.getMaxBytes());
+}
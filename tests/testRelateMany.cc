@@ -0,0 +1,176 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for relating one region to many.
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/Region.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+// Return n regions of every type scattered over a patch of sky.
+std::vector<std::unique_ptr<Region>> makeTargets(size_t n) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lon(0, 20);
+    std::uniform_real_distribution<double> lat(-10, 10);
+    std::vector<std::unique_ptr<Region>> targets;
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d c(LonLat::fromDegrees(lon(rng), lat(rng)));
+        Angle r = Angle::fromDegrees(0.5);
+        switch (i % 5) {
+            case 0:
+                targets.push_back(std::make_unique<Circle>(c, r));
+                break;
+            case 1:
+                targets.push_back(std::make_unique<Box>(LonLat(c), r, r));
+                break;
+            case 2:
+            {
+                UnitVector3d u = UnitVector3d::orthogonalTo(c);
+                UnitVector3d v = UnitVector3d::orthogonalTo(c, u);
+                targets.push_back(std::make_unique<ConvexPolygon>(
+                    ConvexPolygon::convexHull(std::vector<UnitVector3d>{
+                        UnitVector3d(c - 0.01 * u), UnitVector3d(c + 0.01 * u),
+                        UnitVector3d(c + 0.01 * v)})));
+            }
+                break;
+            case 3:
+                targets.push_back(std::make_unique<Ellipse>(c, r, 0.5 * r, Angle(0.3)));
+                break;
+            default:
+                targets.push_back(std::make_unique<UnionRegion>(
+                    Circle(c, r), Box(LonLat(c), 2 * r, 0.1 * r)));
+                break;
+        }
+    }
+    return targets;
+}
+
+// Return n regions of every type with random sizes and orientations in a
+// small patch of sky, so that they often overlap.
+std::vector<std::unique_ptr<Region>> makeOverlappingRegions(size_t n) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> coord(0, 3);
+    std::uniform_real_distribution<double> size(0.2, 2);
+    std::uniform_real_distribution<double> angle(0, 3);
+    std::vector<std::unique_ptr<Region>> regions;
+    for (size_t i = 0; i < n; ++i) {
+        UnitVector3d c(LonLat::fromDegrees(coord(rng), coord(rng)));
+        Angle a = Angle::fromDegrees(size(rng));
+        Angle b = Angle::fromDegrees(size(rng));
+        switch (i % 5) {
+            case 0:
+                regions.push_back(std::make_unique<Circle>(c, a));
+                break;
+            case 1:
+                regions.push_back(std::make_unique<Box>(LonLat(c), a, b));
+                break;
+            case 2:
+            {
+                UnitVector3d u = UnitVector3d::orthogonalTo(c);
+                UnitVector3d v = UnitVector3d::orthogonalTo(c, u);
+                double s = a.asRadians();
+                regions.push_back(std::make_unique<ConvexPolygon>(
+                    ConvexPolygon::convexHull(std::vector<UnitVector3d>{
+                        UnitVector3d(c - s * u), UnitVector3d(c + s * u),
+                        UnitVector3d(c + s * v), UnitVector3d(c - s * v)})));
+            }
+                break;
+            case 3:
+                regions.push_back(std::make_unique<Ellipse>(
+                    c, std::max(a, b), std::min(a, b), Angle(angle(rng))));
+                break;
+            default:
+                regions.push_back(std::make_unique<UnionRegion>(
+                    Circle(c, a), Box(LonLat(c), b, 0.5 * a)));
+                break;
+        }
+    }
+    return regions;
+}
+
+TEST_CASE(RelateManyMatchesRelate) {
+    // Every pair of region types, including pairs of ellipses, for which
+    // relate is not symmetric, must give the same result as relate.
+    std::vector<std::unique_ptr<Region>> regions = makeOverlappingRegions(500);
+    std::vector<Region const *> pointers;
+    for (auto const & r : regions) {
+        pointers.push_back(r.get());
+    }
+    std::vector<Relationship> out(regions.size());
+    for (auto const & query : regions) {
+        relateMany(*query, pointers.data(), pointers.size(), out.data());
+        for (size_t i = 0; i < regions.size(); ++i) {
+            CHECK(out[i] == query->relate(*regions[i]));
+        }
+    }
+}
+
+TEST_CASE(RelateMany) {
+    std::vector<std::unique_ptr<Region>> targets = makeTargets(1000);
+    std::vector<Region const *> pointers;
+    for (auto const & t : targets) {
+        pointers.push_back(t.get());
+    }
+    Box box = Box::fromDegrees(3, -4, 12, 5);
+    Circle circle(UnitVector3d(LonLat::fromDegrees(10, 0)), Angle::fromDegrees(4));
+    std::vector<UnitVector3d> vertices = {
+        UnitVector3d(LonLat::fromDegrees(5, -5)),
+        UnitVector3d(LonLat::fromDegrees(15, -5)),
+        UnitVector3d(LonLat::fromDegrees(15, 5)),
+        UnitVector3d(LonLat::fromDegrees(5, 5))};
+    ConvexPolygon polygon(vertices);
+    Ellipse ellipse(UnitVector3d(LonLat::fromDegrees(8, 1)), Angle::fromDegrees(5),
+                    Angle::fromDegrees(2), Angle(1.0));
+    UnionRegion compound(box, circle);
+    for (Region const * query : std::vector<Region const *>{
+             &box, &circle, &polygon, &ellipse, &compound}) {
+        for (unsigned numThreads : {1u, 3u}) {
+            std::vector<Relationship> out(targets.size());
+            relateMany(*query, pointers.data(), pointers.size(), out.data(),
+                       numThreads);
+            for (size_t i = 0; i < targets.size(); ++i) {
+                CHECK(out[i] == query->relate(*targets[i]));
+            }
+        }
+    }
+    relateMany(box, nullptr, 0, nullptr);
+    std::vector<Relationship> out(1);
+    pointers[0] = nullptr;
+    CHECK_THROW(relateMany(box, pointers.data(), 1, out.data()),
+                std::invalid_argument);
+}
@@ -0,0 +1,169 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for uniform sampling of regions.
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Box.h"
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/CompoundRegion.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/Ellipse.h"
+#include "lsst/sphgeom/LonLat.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+constexpr size_t N = 20000;
+
+struct Samples {
+    std::vector<double> x, y, z;
+
+    Samples(Region const & r, uint64_t seed) : x(N), y(N), z(N) {
+        std::mt19937_64 rng(seed);
+        r.sample(N, rng, x.data(), y.data(), z.data());
+    }
+
+    UnitVector3d operator[](size_t i) const {
+        return UnitVector3d(x[i], y[i], z[i]);
+    }
+};
+
+// `checkSamples` checks that the samples of r are unit vectors in r, that
+// the same seed reproduces them, and that the fraction of them inside `part`,
+// a subregion of r with the given fraction of its area, is as expected.
+void checkSamples(Region const & r, Region const & part, double fraction) {
+    Samples s(r, 1);
+    size_t inside = 0;
+    for (size_t i = 0; i < N; ++i) {
+        double norm = std::sqrt(s.x[i] * s.x[i] + s.y[i] * s.y[i] +
+                                s.z[i] * s.z[i]);
+        CHECK(std::fabs(norm - 1.0) < 1.0e-15);
+        CHECK(r.contains(s[i]));
+        inside += part.contains(s[i]) ? 1 : 0;
+    }
+    // Allow five standard deviations of the binomial distribution.
+    double sigma = std::sqrt(fraction * (1.0 - fraction) / N);
+    CHECK(std::fabs(static_cast<double>(inside) / N - fraction) < 5 * sigma);
+    Samples t(r, 1);
+    CHECK(s.x == t.x && s.y == t.y && s.z == t.z);
+}
+
+} // unnamed namespace
+
+TEST_CASE(SampleCircle) {
+    UnitVector3d c(LonLat::fromDegrees(30.0, -60.0));
+    Circle small(c, Angle::fromDegrees(0.01));
+    // The inner circle has half the area when 1 - cos(r) is halved.
+    double h = 1.0 - std::cos(Angle::fromDegrees(0.01).asRadians());
+    checkSamples(small, Circle(c, Angle(std::acos(1.0 - 0.5 * h))), 0.5);
+    checkSamples(Circle(c, Angle::fromDegrees(120.0)),
+                 Circle(c, Angle(0.5 * PI)), 2.0 / 3.0);
+    checkSamples(Circle::full(), Circle(c, Angle(0.5 * PI)), 0.5);
+    std::mt19937_64 rng;
+    double x, y, z;
+    CHECK_THROW(Circle::empty().sample(1, rng, &x, &y, &z),
+                std::invalid_argument);
+}
+
+TEST_CASE(SampleBox) {
+    checkSamples(Box::fromDegrees(350.0, -10.0, 10.0, 10.0),
+                 Box::fromDegrees(0.0, -10.0, 10.0, 10.0), 0.5);
+    // Near the pole, most of the area is far from it.
+    Box cap = Box::fromDegrees(0.0, 80.0, 360.0, 90.0);
+    double f = (1.0 - std::sin(Angle::fromDegrees(85.0).asRadians())) /
+               (1.0 - std::sin(Angle::fromDegrees(80.0).asRadians()));
+    checkSamples(cap, Box::fromDegrees(0.0, 85.0, 360.0, 90.0), f);
+    checkSamples(Box::full(), Box::fromDegrees(0.0, 0.0, 90.0, 90.0), 0.125);
+    std::mt19937_64 rng;
+    double x, y, z;
+    CHECK_THROW(Box::empty().sample(1, rng, &x, &y, &z),
+                std::invalid_argument);
+}
+
+TEST_CASE(SampleConvexPolygon) {
+    // A small quadrilateral, split along a diagonal into equal halves.
+    std::vector<UnitVector3d> v = {
+        UnitVector3d(LonLat::fromDegrees(10.0, -85.0)),
+        UnitVector3d(LonLat::fromDegrees(100.0, -85.0)),
+        UnitVector3d(LonLat::fromDegrees(190.0, -85.0)),
+        UnitVector3d(LonLat::fromDegrees(280.0, -85.0))
+    };
+    ConvexPolygon quad(v);
+    checkSamples(quad, ConvexPolygon(std::vector<UnitVector3d>{v[0], v[1], v[2]}), 0.5);
+    // A large triangle about the south pole, which is split into smaller
+    // triangles before sampling, with three-fold symmetry about the z axis.
+    ConvexPolygon big(std::vector<UnitVector3d>{
+        UnitVector3d(LonLat::fromDegrees(0.0, -10.0)),
+        UnitVector3d(LonLat::fromDegrees(120.0, -10.0)),
+        UnitVector3d(LonLat::fromDegrees(240.0, -10.0))
+    });
+    checkSamples(big, Box::fromDegrees(0.0, -90.0, 120.0, 90.0), 1.0 / 3.0);
+    // A tiny sensor sized square.
+    UnitVector3d c(LonLat::fromDegrees(45.0, 89.9));
+    std::vector<UnitVector3d> sensor;
+    for (int i = 0; i < 4; ++i) {
+        sensor.push_back(c.rotatedAround(UnitVector3d::orthogonalTo(c),
+                                         Angle::fromDegrees(0.1))
+                          .rotatedAround(c, Angle::fromDegrees(90.0 * i)));
+    }
+    checkSamples(ConvexPolygon(sensor),
+                 ConvexPolygon(std::vector<UnitVector3d>(sensor.begin(),
+                                                         sensor.end() - 1)),
+                 0.5);
+}
+
+TEST_CASE(SampleEllipse) {
+    UnitVector3d c(LonLat::fromDegrees(200.0, 45.0));
+    Angle alpha = Angle::fromDegrees(2.0), beta = Angle::fromDegrees(0.5);
+    Angle orientation = Angle::fromDegrees(30.0);
+    // Scaling the axes of a small ellipse by 1/√2 about halves its area.
+    double k = 1.0 / std::sqrt(2.0);
+    checkSamples(Ellipse(c, alpha, beta, orientation),
+                 Ellipse(c, alpha * k, beta * k, orientation), 0.5);
+}
+
+TEST_CASE(SampleCompoundRegion) {
+    UnitVector3d c(LonLat::fromDegrees(0.0, 0.0));
+    Circle circle(c, Angle::fromDegrees(1.0));
+    checkSamples(IntersectionRegion(circle,
+                                    Box::fromDegrees(0.0, -5.0, 5.0, 5.0)),
+                 Box::fromDegrees(0.0, 0.0, 5.0, 5.0), 0.5);
+    Circle other(UnitVector3d(LonLat::fromDegrees(30.0, 0.0)),
+                 Angle::fromDegrees(1.0));
+    checkSamples(UnionRegion(circle, other), other, 0.5);
+    std::mt19937_64 rng;
+    double x, y, z;
+    CHECK_THROW(IntersectionRegion(circle, Circle::empty())
+                    .sample(1, rng, &x, &y, &z),
+                std::invalid_argument);
+}
@@ -0,0 +1,103 @@
+/*
+ * LSST Data Management System
+ * See COPYRIGHT file at the top of the source tree.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the SmallVector class.
+
+#include <utility>
+#include <vector>
+
+#include "lsst/sphgeom/SmallVector.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+using Small = SmallVector<int, 4>;
+
+void checkEqual(Small const & s, std::vector<int> const & v) {
+    CHECK(s.size() == v.size());
+    CHECK(s.empty() == v.empty());
+    CHECK(static_cast<size_t>(s.end() - s.begin()) == v.size());
+    CHECK(std::vector<int>(s) == v);
+    for (size_t i = 0; i < v.size(); ++i) {
+        CHECK(s[i] == v[i]);
+    }
+}
+
+TEST_CASE(Construction) {
+    checkEqual(Small(), {});
+    checkEqual(Small{1, 2, 3}, {1, 2, 3});
+    checkEqual(Small{1, 2, 3, 4, 5, 6}, {1, 2, 3, 4, 5, 6});
+    std::vector<int> v = {7, 8, 9, 10, 11};
+    checkEqual(Small(v.begin(), v.end()), v);
+    checkEqual(Small(v.begin(), v.begin() + 2), {7, 8});
+}
+
+TEST_CASE(PushBack) {
+    // Crossing the inline capacity must move elements to the heap.
+    Small s;
+    std::vector<int> v;
+    for (int i = 0; i < 10; ++i) {
+        s.push_back(i);
+        v.push_back(i);
+        checkEqual(s, v);
+        CHECK(s.front() == 0 && s.back() == i);
+    }
+    s.clear();
+    checkEqual(s, {});
+    s.push_back(3);
+    checkEqual(s, {3});
+}
+
+TEST_CASE(CopyAndMove) {
+    for (Small const & s: {Small{1, 2}, Small{1, 2, 3, 4, 5, 6, 7}}) {
+        std::vector<int> v(s);
+        Small c(s);
+        checkEqual(c, v);
+        Small m(std::move(c));
+        checkEqual(m, v);
+        checkEqual(c, {});
+        Small a{9};
+        a = m;
+        checkEqual(a, v);
+        Small b{9, 9, 9, 9, 9};
+        b = std::move(a);
+        checkEqual(b, v);
+        checkEqual(a, {});
+        b.assign(v.begin(), v.begin() + 1);
+        checkEqual(b, {v[0]});
+    }
+}
+
+TEST_CASE(MoveFromVector) {
+    std::vector<int> small{1, 2};
+    Small s(std::move(small));
+    checkEqual(s, {1, 2});
+    std::vector<int> large{1, 2, 3, 4, 5, 6};
+    int const * data = large.data();
+    Small l(std::move(large));
+    checkEqual(l, {1, 2, 3, 4, 5, 6});
+    // Heap storage is taken over rather than copied.
+    CHECK(l.data() == data);
+}
@@ -0,0 +1,106 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the spatial sort.
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+#include "lsst/sphgeom/spatialSort.h"
+
+#include "test.h"
+
+
+using namespace lsst::sphgeom;
+
+namespace {
+
+UnitVector3dArray randomPoints(size_t n) {
+    std::mt19937 rng(n);
+    std::normal_distribution<double> dist;
+    std::vector<UnitVector3d> points;
+    for (size_t i = 0; i < n; ++i) {
+        points.emplace_back(dist(rng), dist(rng), dist(rng));
+    }
+    return UnitVector3dArray(points);
+}
+
+void checkSorted(Pixelization const & pixelization,
+                 UnitVector3dArray const & points,
+                 std::vector<size_t> const & p) {
+    REQUIRE(p.size() == points.size());
+    std::vector<bool> seen(p.size(), false);
+    for (size_t i = 0; i < p.size(); ++i) {
+        REQUIRE(p[i] < p.size());
+        CHECK(!seen[p[i]]);
+        seen[p[i]] = true;
+        if (i > 0) {
+            uint64_t a = pixelization.index(points[p[i - 1]]);
+            uint64_t b = pixelization.index(points[p[i]]);
+            CHECK(a < b || (a == b && p[i - 1] < p[i]));
+        }
+    }
+}
+
+} // unnamed namespace
+
+TEST_CASE(Empty) {
+    UnitVector3dArray points;
+    CHECK(spatialSort(points, 10).empty());
+}
+
+TEST_CASE(Mq3c) {
+    UnitVector3dArray points = randomPoints(200000);
+    std::vector<size_t> p = spatialSort(points, 5);
+    checkSorted(Mq3cPixelization(5), points, p);
+    CHECK(spatialSort(points, 5, 4) == p);
+    // Sorting sorted points yields the identity.
+    std::vector<UnitVector3d> sorted;
+    for (size_t i : p) {
+        sorted.push_back(points[i]);
+    }
+    std::vector<size_t> q = spatialSort(UnitVector3dArray(sorted), 5, 3);
+    for (size_t i = 0; i < q.size(); ++i) {
+        CHECK(q[i] == i);
+    }
+    CHECK_THROW(spatialSort(points, Mq3cPixelization::MAX_LEVEL + 1),
+                std::invalid_argument);
+}
+
+TEST_CASE(Htm) {
+    UnitVector3dArray points = randomPoints(100);
+    HtmPixelization htm(20);
+    std::vector<size_t> p = spatialSort(htm, points.x(), points.y(),
+                                        points.z(), points.size());
+    checkSorted(htm, points, p);
+    points = randomPoints(300000);
+    p = spatialSort(htm, points.x(), points.y(), points.z(), points.size(), 7);
+    checkSorted(htm, points, p);
+    CHECK(spatialSort(htm, points.x(), points.y(), points.z(),
+                      points.size()) == p);
+}
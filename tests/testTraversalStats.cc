@@ -0,0 +1,149 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for traversal statistics.
+
+#include <numeric>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/TraversalStats.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+uint64_t totalNodes(TraversalStats const & s) {
+    return std::accumulate(s.nodesVisited.begin(), s.nodesVisited.end(),
+                           uint64_t(0));
+}
+
+TEST_CASE(NoScope) {
+    HtmPixelization p(8);
+    Circle c(UnitVector3d(1, 1, 1), Angle(0.1));
+    CHECK(TraversalStatsScope::current() == nullptr);
+    TraversalStats stats;
+    p.envelope(c);
+    CHECK(stats.relates() == 0);
+    CHECK(stats.finalLevel == -1);
+}
+
+TEST_CASE(Envelope) {
+    if (!TraversalStats::ENABLED) {
+        return;
+    }
+    Mq3cPixelization p(10);
+    Circle c(UnitVector3d(1, 2, 3), Angle(0.05));
+    TraversalStats stats;
+    RangeSet s;
+    {
+        TraversalStatsScope scope(stats);
+        CHECK(TraversalStatsScope::current() == &stats);
+        s = p.envelope(c);
+    }
+    CHECK(TraversalStatsScope::current() == nullptr);
+    CHECK(stats.nodesVisited.size() == 11);
+    // The traversal starts at the 9 level 2 pixels around the center of c.
+    CHECK(stats.nodesVisited[0] == 0);
+    CHECK(stats.nodesVisited[2] == 9);
+    CHECK(totalNodes(stats) == stats.relates());
+    CHECK(stats.disjoint > 0);
+    CHECK(stats.within > 0);
+    CHECK(stats.intersects > 0);
+    CHECK(stats.inserts >= s.size());
+    CHECK(stats.simplifications == 0);
+    CHECK(stats.finalLevel == 10);
+    // Statistics accumulate until cleared.
+    {
+        TraversalStatsScope scope(stats);
+        p.interior(c);
+    }
+    CHECK(stats.nodesVisited[2] == 18);
+    stats.clear();
+    CHECK(stats.relates() == 0);
+    CHECK(stats.nodesVisited.empty());
+}
+
+TEST_CASE(MaxRanges) {
+    if (!TraversalStats::ENABLED) {
+        return;
+    }
+    Mq3cPixelization p(16);
+    Circle c(UnitVector3d(1, 2, 3), Angle(0.05));
+    TraversalStats stats;
+    RangeSet s;
+    {
+        TraversalStatsScope scope(stats);
+        s = p.envelope(c, 8);
+    }
+    CHECK(s.size() <= 8);
+    CHECK(stats.simplifications > 0);
+    CHECK(stats.finalLevel == 16 - static_cast<int>(stats.simplifications));
+}
+
+TEST_CASE(Nesting) {
+    if (!TraversalStats::ENABLED) {
+        return;
+    }
+    HtmPixelization p(6);
+    Circle c(UnitVector3d(1, 1, 1), Angle(0.1));
+    TraversalStats outer, inner;
+    {
+        TraversalStatsScope s1(outer);
+        p.envelope(c);
+        {
+            TraversalStatsScope s2(inner);
+            CHECK(TraversalStatsScope::current() == &inner);
+            p.envelope(c);
+            p.envelope(c);
+        }
+        CHECK(TraversalStatsScope::current() == &outer);
+    }
+    CHECK(inner.relates() == 2 * outer.relates());
+    CHECK(inner.nodesVisited[0] == 16);
+}
+
+TEST_CASE(Threads) {
+    if (!TraversalStats::ENABLED) {
+        return;
+    }
+    Mq3cPixelization p(12);
+    Circle c(UnitVector3d(-1, 2, 1), Angle(0.2));
+    TraversalStats serial, parallel;
+    {
+        TraversalStatsScope scope(serial);
+        p.envelope(c);
+    }
+    {
+        TraversalStatsScope scope(parallel);
+        p.envelope(c, 0, 4);
+    }
+    // Subtrees are split between threads, but every pixel is still visited
+    // exactly once.
+    CHECK(parallel.nodesVisited == serial.nodesVisited);
+    CHECK(parallel.disjoint == serial.disjoint);
+    CHECK(parallel.within == serial.within);
+    CHECK(parallel.intersects == serial.intersects);
+    CHECK(parallel.finalLevel == 12);
+}
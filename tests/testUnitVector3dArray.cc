@@ -0,0 +1,277 @@
+/*
+ * LSST Data Management System
+ * Copyright 2014-2015 AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/// \file
+/// \brief This file contains tests for the UnitVector3dArray class.
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "lsst/sphgeom/Circle.h"
+#include "lsst/sphgeom/ConvexPolygon.h"
+#include "lsst/sphgeom/HtmPixelization.h"
+#include "lsst/sphgeom/LonLat.h"
+#include "lsst/sphgeom/Mq3cPixelization.h"
+#include "lsst/sphgeom/UnitVector3dArray.h"
+#include "lsst/sphgeom/utils.h"
+
+#include "test.h"
+
+using namespace lsst::sphgeom;
+
+// Sizes that exercise both full blocks and remainders of batch kernels.
+static size_t const SIZES[] = {0, 1, 3, 4, 5, 17, 1000};
+
+std::vector<double> randomValues(std::mt19937 & rng, double a, double b,
+                                 size_t n)
+{
+    std::uniform_real_distribution<double> dist(a, b);
+    std::vector<double> v(n);
+    for (double & d: v) {
+        d = dist(rng);
+    }
+    return v;
+}
+
+TEST_CASE(Construction) {
+    UnitVector3dArray a;
+    CHECK(a.empty());
+    CHECK(a.size() == 0);
+    std::vector<UnitVector3d> v = {
+        UnitVector3d::X(), UnitVector3d(1, 2, 3), UnitVector3d(-1, 0, 1)};
+    UnitVector3dArray b(v);
+    CHECK(b.size() == 3);
+    for (size_t i = 0; i < v.size(); ++i) {
+        CHECK(b[i] == v[i]);
+        CHECK(b.x()[i] == v[i].x());
+        CHECK(b.y()[i] == v[i].y());
+        CHECK(b.z()[i] == v[i].z());
+    }
+    a.push_back(v[0]);
+    CHECK(a != b);
+    a.push_back(v[1]);
+    a.push_back(v[2]);
+    CHECK(a == b);
+    a.clear();
+    CHECK(a.empty());
+}
+
+TEST_CASE(FromComponents) {
+    std::mt19937 rng(1);
+    for (size_t n: SIZES) {
+        std::vector<double> x = randomValues(rng, -1.0, 1.0, n);
+        std::vector<double> y = randomValues(rng, -1.0, 1.0, n);
+        std::vector<double> z = randomValues(rng, -1.0, 1.0, n);
+        // Include ties between the largest components, vectors along the
+        // coordinate axes, and very large and small magnitudes.
+        for (size_t i = 0; i < n; ++i) {
+            switch (i % 8) {
+                case 1: y[i] = -x[i]; break;
+                case 2: z[i] = x[i]; y[i] = x[i]; break;
+                case 3: x[i] = 0.0; y[i] = 0.0; break;
+                case 4: x[i] *= 1e300; y[i] *= 1e300; z[i] *= 1e300; break;
+                case 5: x[i] *= 1e-300; y[i] *= 1e-300; z[i] = 0.0; break;
+                default: break;
+            }
+        }
+        UnitVector3dArray a = UnitVector3dArray::fromComponents(
+            x.data(), y.data(), z.data(), n);
+        CHECK(a.size() == n);
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(a[i] == UnitVector3d(x[i], y[i], z[i]));
+        }
+    }
+    std::vector<double> x = {1.0, 1.0, 0.0, 1.0, 1.0};
+    std::vector<double> y = {0.0, 1.0, 0.0, 1.0, 1.0};
+    std::vector<double> z = {0.0, 1.0, 0.0, 1.0, 1.0};
+    CHECK_THROW(UnitVector3dArray::fromComponents(
+                    x.data(), y.data(), z.data(), x.size()),
+                std::runtime_error);
+}
+
+TEST_CASE(FromLonLat) {
+    std::mt19937 rng(2);
+    for (size_t n: SIZES) {
+        std::vector<double> lon = randomValues(rng, -10.0, 10.0, n);
+        std::vector<double> lat = randomValues(rng, -0.5 * PI, 0.5 * PI, n);
+        // Arguments too large for the polynomial argument reduction are
+        // handled by the standard library, without first being wrapped.
+        for (size_t i = 7; i < n; i += 8) {
+            lon[i] *= 1e10;
+        }
+        UnitVector3dArray a = UnitVector3dArray::fromLonLat(
+            lon.data(), lat.data(), n);
+        CHECK(a.size() == n);
+        for (size_t i = 0; i < n; ++i) {
+            if (i % 8 == 7) {
+                double x = std::cos(lon[i]) * std::cos(lat[i]);
+                double y = std::sin(lon[i]) * std::cos(lat[i]);
+                CHECK(std::fabs(a.x()[i] - x) <= 1e-15);
+                CHECK(std::fabs(a.y()[i] - y) <= 1e-15);
+                continue;
+            }
+            UnitVector3d v(LonLat::fromRadians(lon[i], lat[i]));
+            CHECK(std::fabs(a.x()[i] - v.x()) <= 1e-15);
+            CHECK(std::fabs(a.y()[i] - v.y()) <= 1e-15);
+            CHECK(std::fabs(a.z()[i] - v.z()) <= 1e-15);
+        }
+    }
+    double lon[] = {0.0, 0.5 * PI, PI, 1.5 * PI, -0.5 * PI};
+    double lat[] = {0.0, 0.0, 0.5 * PI, -0.5 * PI, 0.0};
+    UnitVector3dArray a = UnitVector3dArray::fromLonLat(lon, lat, 5);
+    CHECK(a.x()[0] == 1.0 && a.y()[0] == 0.0 && a.z()[0] == 0.0);
+    CHECK(std::fabs(a.x()[1]) < 1e-16 && a.y()[1] == 1.0);
+    CHECK(a.z()[2] == 1.0 && a.z()[3] == -1.0);
+    CHECK(a.y()[4] == -1.0);
+    lat[4] = 2.0;
+    CHECK_THROW(UnitVector3dArray::fromLonLat(lon, lat, 5),
+                std::invalid_argument);
+}
+
+TEST_CASE(ToLonLat) {
+    std::mt19937 rng(3);
+    for (size_t n: SIZES) {
+        std::vector<double> x = randomValues(rng, -1.0, 1.0, n);
+        std::vector<double> y = randomValues(rng, -1.0, 1.0, n);
+        std::vector<double> z = randomValues(rng, -1.0, 1.0, n);
+        UnitVector3dArray a = UnitVector3dArray::fromComponents(
+            x.data(), y.data(), z.data(), n);
+        std::vector<double> lon(n), lat(n);
+        a.toLonLat(lon.data(), lat.data());
+        for (size_t i = 0; i < n; ++i) {
+            LonLat p(a[i]);
+            CHECK(lon[i] == p.getLon().asRadians());
+            CHECK(lat[i] == p.getLat().asRadians());
+        }
+    }
+}
+
+TEST_CASE(Rotate) {
+    std::mt19937 rng(4);
+    Matrix3d m(0.36, 0.48, -0.8,
+               -0.8, 0.6, 0.0,
+               0.48, 0.64, 0.6);
+    for (size_t n: SIZES) {
+        std::vector<double> x = randomValues(rng, -1.0, 1.0, n);
+        std::vector<double> y = randomValues(rng, -1.0, 1.0, n);
+        std::vector<double> z = randomValues(rng, -1.0, 1.0, n);
+        UnitVector3dArray a = UnitVector3dArray::fromComponents(
+            x.data(), y.data(), z.data(), n);
+        UnitVector3dArray b = a;
+        b.rotate(m).rotate(m);
+        for (size_t i = 0; i < n; ++i) {
+            UnitVector3d v(m * UnitVector3d(m * a[i]));
+            CHECK(b[i] == v);
+        }
+    }
+}
+
+TEST_CASE(Batch) {
+    std::mt19937 rng(5);
+    size_t const n = 1000;
+    std::vector<double> lon = randomValues(rng, 0.0, 2.0 * PI, n);
+    std::vector<double> lat = randomValues(rng, -0.5 * PI, 0.5 * PI, n);
+    UnitVector3dArray a = UnitVector3dArray::fromLonLat(
+        lon.data(), lat.data(), n);
+    std::unique_ptr<Pixelization> pixelizations[] = {
+        std::unique_ptr<Pixelization>(new HtmPixelization(10)),
+        std::unique_ptr<Pixelization>(new Mq3cPixelization(10))};
+    for (auto const & p: pixelizations) {
+        std::vector<uint64_t> indexes(n);
+        p->index(a, indexes.data());
+        for (size_t i = 0; i < n; ++i) {
+            CHECK(indexes[i] == p->index(a[i]));
+        }
+    }
+    ConvexPolygon polygon = ConvexPolygon::convexHull(std::vector<UnitVector3d>{
+        UnitVector3d(1, 0, 0), UnitVector3d(0, 1, 0), UnitVector3d(0, 0, 1)});
+    Region const & region = polygon;
+    std::unique_ptr<bool[]> inside(new bool[n]);
+    region.contains(a, inside.get());
+    for (size_t i = 0; i < n; ++i) {
+        CHECK(inside[i] == polygon.contains(a[i]));
+    }
+}
+
+UnitVector3dArray randomPoints(std::mt19937 & rng, size_t n) {
+    std::vector<double> x = randomValues(rng, -1.0, 1.0, n);
+    std::vector<double> y = randomValues(rng, -1.0, 1.0, n);
+    std::vector<double> z = randomValues(rng, -1.0, 1.0, n);
+    return UnitVector3dArray::fromComponents(x.data(), y.data(), z.data(), n);
+}
+
+TEST_CASE(Separations) {
+    std::mt19937 rng(6);
+    UnitVector3dArray a = randomPoints(rng, 7);
+    for (size_t m: SIZES) {
+        UnitVector3dArray b = randomPoints(rng, m);
+        std::vector<double> d2(a.size() * m), sep(a.size() * m);
+        getSquaredChordLengths(a, b, d2.data());
+        getAngularSeparations(a, b, sep.data());
+        for (size_t i = 0; i < a.size(); ++i) {
+            std::vector<double> row(m);
+            getSquaredChordLengths(a[i], b, row.data());
+            for (size_t j = 0; j < m; ++j) {
+                double expected = (a[i] - b[j]).getSquaredNorm();
+                CHECK(d2[i * m + j] == expected);
+                CHECK(row[j] == expected);
+                CHECK(sep[i * m + j] ==
+                      Circle::openingAngleFor(expected).asRadians());
+            }
+        }
+    }
+    UnitVector3dArray c(std::vector<UnitVector3d>{
+        UnitVector3d::X(), UnitVector3d::Y(), -UnitVector3d::X()});
+    double sep[3];
+    getAngularSeparations(UnitVector3d::X(), c, sep);
+    CHECK(sep[0] == 0.0);
+    CHECK(std::fabs(sep[1] - 0.5 * PI) < 1e-15);
+    CHECK(sep[2] == PI);
+}
+
+TEST_CASE(PairsWithin) {
+    std::mt19937 rng(7);
+    UnitVector3dArray a = randomPoints(rng, 50);
+    UnitVector3dArray b = randomPoints(rng, 3001);
+    for (double r: {-1.0, 0.0, 0.1, 1.0, PI}) {
+        std::vector<std::pair<size_t, size_t>> pairs;
+        findPairsWithin(a, b, Angle(r), pairs);
+        std::sort(pairs.begin(), pairs.end());
+        std::vector<std::pair<size_t, size_t>> expected;
+        for (size_t i = 0; i < a.size(); ++i) {
+            Circle c(a[i], Angle(r));
+            for (size_t j = 0; j < b.size(); ++j) {
+                if (c.contains(b[j])) {
+                    expected.emplace_back(i, j);
+                }
+            }
+        }
+        CHECK(pairs == expected);
+    }
+    std::vector<std::pair<size_t, size_t>> pairs;
+    findPairsWithin(a, a, Angle(0.0), pairs);
+    CHECK(pairs.size() >= a.size());
+}
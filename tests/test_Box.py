@@ -132,6 +132,26 @@ class BoxTestCase(unittest.TestCase):
                 self.assertEqual(c3[i // 2, j], b.contains(u))
                 self.assertEqual(c4[i // 2, j], b.contains(u))
 
+    def test_vectorized_contains_broadcast(self):
+        b = Box.fromDegrees(200, 10, 300, 20)
+        x = np.random.randn(1000)
+        y = np.random.randn(1000)
+        expected = [b.contains(UnitVector3d(x[i], y[i], 0.2)) for i in range(1000)]
+        c = b.contains(x, y, 0.2)
+        self.assertEqual(c.dtype, np.bool_)
+        self.assertEqual(c.tolist(), expected)
+        self.assertEqual(b.contains(x, y, np.full(1000, 0.2), numThreads=2).tolist(), expected)
+        lon = np.linspace(0.0, 2.0 * math.pi, 7)
+        lat = np.linspace(-1.5, 1.5, 5)[:, np.newaxis]
+        c2 = b.contains(lon, lat)
+        self.assertEqual(c2.shape, (5, 7))
+        for i in range(5):
+            for j in range(7):
+                self.assertEqual(c2[i, j], b.contains(UnitVector3d(LonLat.fromRadians(lon[j], lat[i, 0]))))
+        self.assertIsInstance(b.contains(x[0], y[0], 0.2), bool)
+        self.assertEqual(b.contains(x[0], y[0], 0.2), expected[0])
+        self.assertEqual(b.contains(np.zeros(0), np.zeros(0)).shape, (0,))
+
     def test_expanding_and_clipping(self):
         a = Box.fromDegrees(0, 0, 10, 10)
         b = (
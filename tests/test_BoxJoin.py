@@ -0,0 +1,74 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import DISJOINT, Angle, Box3d, Circle, Interval1d, UnitVector3d, Vector3d, boxJoin, regionJoin
+
+
+class BoxJoinTestCase(unittest.TestCase):
+    """Test boxJoin and regionJoin."""
+
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.boxes = [Box3d(Vector3d(*c), *w)
+                      for c, w in zip(rng.uniform(0.0, 1.0, (300, 3)), rng.uniform(0.0, 0.05, (300, 3)))]
+        self.boxes.append(Box3d())
+        self.circles = [Circle(UnitVector3d(*v), Angle(r))
+                        for v, r in zip(rng.normal(size=(200, 3)), rng.uniform(0.0, 0.1, 200))]
+
+    def testSelfJoin(self):
+        pairs = boxJoin(self.boxes)
+        self.assertEqual(pairs.dtype, np.uint64)
+        self.assertEqual(pairs.shape[1], 2)
+        n = len(self.boxes)
+        expected = [(i, j) for i in range(n) for j in range(i + 1, n)
+                    if self.boxes[i].intersects(self.boxes[j])]
+        self.assertEqual([tuple(p) for p in pairs.tolist()], expected)
+        self.assertTrue(np.array_equal(boxJoin(self.boxes, numThreads=2), pairs))
+
+    def testBipartiteJoin(self):
+        a = self.boxes[:100]
+        b = self.boxes[100:]
+        pairs = boxJoin(a, b, numThreads=2)
+        expected = [(i, j) for i in range(len(a)) for j in range(len(b)) if a[i].intersects(b[j])]
+        self.assertEqual([tuple(p) for p in pairs.tolist()], expected)
+        self.assertEqual(boxJoin([], b).shape, (0, 2))
+        unit = Interval1d(0.0, 1.0)
+        touching = Box3d(Interval1d(1.0, 2.0), unit, unit)
+        self.assertEqual(boxJoin([Box3d(unit, unit, unit)], [touching]).tolist(), [[0, 0]])
+
+    def testRegionJoin(self):
+        c = self.circles
+        pairs = regionJoin(c)
+        expected = [(i, j) for i in range(len(c)) for j in range(i + 1, len(c))
+                    if not c[i].relate(c[j]) & DISJOINT]
+        self.assertEqual([tuple(p) for p in pairs.tolist()], expected)
+        pairs = regionJoin(c[:50], c[50:], numThreads=2)
+        expected = [(i, j) for i in range(50) for j in range(len(c) - 50)
+                    if not c[i].relate(c[50 + j]) & DISJOINT]
+        self.assertEqual([tuple(p) for p in pairs.tolist()], expected)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,80 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+from lsst.sphgeom import (
+    CONTAINS,
+    INTERSECTS,
+    Angle,
+    ChunkPixelMap,
+    Chunker,
+    Circle,
+    HtmPixelization,
+    LonLat,
+    Mq3cPixelization,
+    RangeSet,
+    UnitVector3d,
+)
+
+
+class ChunkPixelMapTestCase(unittest.TestCase):
+    """Test ChunkPixelMap."""
+
+    def testTables(self):
+        chunker = Chunker(12, 2)
+        pixelization = HtmPixelization(5)
+        m = ChunkPixelMap(chunker, pixelization, numThreads=2)
+        self.assertEqual(m.chunker, chunker)
+        self.assertEqual(len(m), len(chunker.getAllChunks()))
+        self.assertEqual(m.getChunkIds(), chunker.getAllChunks())
+        for chunkId in m.getChunkIds():
+            envelope = m.getEnvelope(chunkId)
+            self.assertTrue(envelope.contains(m.getInterior(chunkId)))
+            first = envelope.ranges()[0][0]
+            self.assertIn(chunkId, m.getChunks(first))
+        with self.assertRaises(ValueError):
+            m.getEnvelope(-1)
+
+    def testChunkSelection(self):
+        chunker = Chunker(18, 3)
+        pixelization = Mq3cPixelization(6)
+        m = ChunkPixelMap(chunker, pixelization)
+        circle = Circle(UnitVector3d(LonLat.fromDegrees(30, 20)), Angle.fromDegrees(10))
+        envelope = pixelization.envelope(circle)
+        interior = pixelization.interior(circle)
+        chunkIds = m.getChunksIntersecting(envelope)
+        self.assertEqual(chunkIds, sorted(chunkIds))
+        self.assertTrue(set(chunker.getChunksIntersecting(circle)) <= set(chunkIds))
+        classified = m.classifyChunks(envelope, interior)
+        self.assertEqual([c for c, _ in classified], chunkIds)
+        for chunkId, relationship in classified:
+            if interior.contains(m.getEnvelope(chunkId)):
+                self.assertEqual(relationship, CONTAINS)
+            else:
+                self.assertEqual(relationship, INTERSECTS)
+        self.assertTrue(any(r == CONTAINS for _, r in classified))
+        self.assertEqual(m.getChunksIntersecting(RangeSet()), [])
+
+
+if __name__ == "__main__":
+    unittest.main()
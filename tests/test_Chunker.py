@@ -23,7 +23,9 @@
 import pickle
 import unittest
 
-from lsst.sphgeom import Box, Chunker
+import numpy as np
+
+from lsst.sphgeom import CONTAINS, INTERSECTS, Angle, Box, Chunker, LonLat
 
 
 class ChunkerTestCase(unittest.TestCase):
@@ -46,6 +48,22 @@ class ChunkerTestCase(unittest.TestCase):
         self.assertEqual(c.getChunksIntersecting(b), [9630, 9631, 9797])
         self.assertEqual(c.getSubChunksIntersecting(b), [(9630, [770]), (9631, [759]), (9797, [11])])
 
+    def testClassify(self):
+        chunker = Chunker(85, 12)
+        box = Box.fromDegrees(10, 10, 30, 30)
+        chunks = chunker.classifyChunks(box)
+        self.assertEqual([c for c, _ in chunks], chunker.getChunksIntersecting(box))
+        self.assertIn(CONTAINS, [r for _, r in chunks])
+        self.assertIn(INTERSECTS, [r for _, r in chunks])
+        subChunks = chunker.classifySubChunks(box)
+        expected = chunker.getSubChunksIntersecting(box)
+        self.assertEqual([(c, ids) for c, _, ids, _ in subChunks], expected)
+        for _, r, ids, rs in subChunks:
+            self.assertEqual(len(ids), len(rs))
+            if r == CONTAINS:
+                self.assertEqual(set(rs), {CONTAINS})
+        self.assertEqual(chunker.classifySubChunks(box, numThreads=4), subChunks)
+
     def testString(self):
         chunker = Chunker(85, 12)
         self.assertEqual(str(chunker), "Chunker(85, 12)")
@@ -71,6 +89,54 @@ class ChunkerTestCase(unittest.TestCase):
         sb = Box.fromRadians(0.0, -1.5707963267948966, 6.283185307179586, -1.5676547341363067)
         self.assertAlmostEqual(sbbox, sb)
 
+    def testBoundingBoxTable(self):
+        chunker = Chunker(200, 5)
+        tabled = Chunker(200, 5, maxBoxTableBytes=1 << 20)
+        self.assertEqual(chunker, tabled)
+        self.assertEqual(tabled.getChunkBoundingBox(9, 45), chunker.getChunkBoundingBox(9, 45))
+        self.assertEqual(tabled.getSubChunkBoundingBox(0, 0), chunker.getSubChunkBoundingBox(0, 0))
+        boxes = tabled.getChunkBoundingBoxes(9)
+        self.assertEqual(boxes, chunker.getChunkBoundingBoxes(9))
+        self.assertEqual(boxes[45], chunker.getChunkBoundingBox(9, 45))
+        self.assertEqual(tabled.getSubChunkBoundingBoxes(47), chunker.getSubChunkBoundingBoxes(47))
+
+    def testLocate(self):
+        c = Chunker(85, 12)
+        p = LonLat.fromDegrees(273.65, 30.71)
+        self.assertEqual(c.locate(p), (9797, 11))
+        lon = np.radians([273.65, 273.65])
+        lat = np.radians([30.71, 30.71])
+        chunks, subChunks = c.locate(lon, lat)
+        self.assertEqual(chunks.tolist(), [9797, 9797])
+        self.assertEqual(subChunks.tolist(), [11, 11])
+        with self.assertRaises(ValueError):
+            c.locate(lon, lat[:1])
+
+    def testLocateWithOverlap(self):
+        c = Chunker(85, 12)
+        lon = np.radians([273.65, 10.0])
+        lat = np.radians([30.71, -20.0])
+        index, chunks, subChunks, overlap = c.locateWithOverlap(lon, lat, Angle.fromDegrees(0.5))
+        self.assertEqual(index[0], 0)
+        self.assertEqual((chunks[0], subChunks[0]), c.locate(LonLat.fromDegrees(273.65, 30.71)))
+        self.assertFalse(overlap[0])
+        self.assertTrue(overlap[1:].any())
+        self.assertEqual(np.count_nonzero(~overlap), 2)
+        self.assertTrue((np.diff(index) >= 0).all())
+
+    def testNeighbors(self):
+        c = Chunker(85, 12)
+        overlap = Angle.fromDegrees(0.5)
+        stripe = c.getStripe(9630)
+        b = c.getChunkBoundingBox(stripe, c.getChunk(9630, stripe)).dilatedBy(overlap)
+        expected = [i for i in c.getChunksIntersecting(b) if i != 9630]
+        self.assertEqual(c.getNeighborChunks(9630, overlap), expected)
+        neighbors = c.getNeighborSubChunks(9630, 770, Angle.fromDegrees(1.0 / 60.0))
+        self.assertEqual([n[0] for n in neighbors], sorted(n[0] for n in neighbors))
+        self.assertNotIn(770, dict(neighbors).get(9630, []))
+        with self.assertRaises(ValueError):
+            c.getNeighborChunks(-1, overlap)
+
 
 if __name__ == "__main__":
     unittest.main()
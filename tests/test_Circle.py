@@ -31,7 +31,7 @@ import math
 import unittest
 
 import numpy as np
-from lsst.sphgeom import CONTAINS, DISJOINT, Angle, Circle, Region, UnitVector3d
+from lsst.sphgeom import CONTAINS, DISJOINT, Angle, Box, Circle, ConvexPolygon, LonLat, Region, UnitVector3d
 
 
 class CircleTestCase(unittest.TestCase):
@@ -107,6 +107,39 @@ class CircleTestCase(unittest.TestCase):
                 self.assertEqual(c3[i // 2, j], b.contains(u))
                 self.assertEqual(c4[i // 2, j], b.contains(u))
 
+    def test_sample(self):
+        c = Circle(UnitVector3d(LonLat.fromDegrees(30, -70)), Angle.fromDegrees(2.0))
+        x, y, z = c.sample(1000, seed=5)
+        self.assertEqual(x.shape, (1000,))
+        self.assertTrue(np.all(c.contains(x, y, z)))
+        np.testing.assert_allclose(x * x + y * y + z * z, 1.0, rtol=1e-15)
+        for a, b in zip(c.sample(1000, seed=5), (x, y, z)):
+            self.assertTrue(np.array_equal(a, b))
+        polygon = ConvexPolygon([UnitVector3d(1, 0, 0), UnitVector3d(0, 1, 0), UnitVector3d(0, 0, 1)])
+        self.assertTrue(np.all(polygon.contains(*polygon.sample(100))))
+        with self.assertRaises(ValueError):
+            Circle.empty().sample(1)
+
+    def test_vectorized_contains_broadcast(self):
+        b = Circle(UnitVector3d(-1, -1, 0.2), Angle(0.4))
+        x = np.random.randn(1000)
+        y = np.random.randn(1000)
+        expected = [b.contains(UnitVector3d(x[i], y[i], 0.2)) for i in range(1000)]
+        c = b.contains(x, y, 0.2)
+        self.assertEqual(c.dtype, np.bool_)
+        self.assertEqual(c.tolist(), expected)
+        self.assertEqual(b.contains(x, y, np.full(1000, 0.2), numThreads=2).tolist(), expected)
+        lon = np.linspace(0.0, 2.0 * math.pi, 7)
+        lat = np.linspace(-1.5, 1.5, 5)[:, np.newaxis]
+        c2 = b.contains(lon, lat)
+        self.assertEqual(c2.shape, (5, 7))
+        for i in range(5):
+            for j in range(7):
+                self.assertEqual(c2[i, j], b.contains(UnitVector3d(LonLat.fromRadians(lon[j], lat[i, 0]))))
+        self.assertIsInstance(b.contains(x[0], y[0], 0.2), bool)
+        self.assertEqual(b.contains(x[0], y[0], 0.2), expected[0])
+        self.assertEqual(b.contains(np.zeros(0), np.zeros(0)).shape, (0,))
+
     def test_expanding_and_clipping(self):
         a = Circle.empty()
         b = (
@@ -140,6 +173,17 @@ class CircleTestCase(unittest.TestCase):
         self.assertEqual(c.getCenter(), -UnitVector3d.X())
         self.assertEqual(c.getSquaredChordLength(), 2.0)
 
+    def test_polygons(self):
+        c = Circle(UnitVector3d(1, 1, 1), Angle(0.2))
+        outer = c.toOuterPolygon()
+        inner = c.toInnerPolygon(n=5)
+        self.assertIsInstance(outer, ConvexPolygon)
+        self.assertEqual(len(outer.getVertices()), 16)
+        self.assertEqual(len(inner.getVertices()), 5)
+        self.assertEqual(c.relate(inner), CONTAINS)
+        with self.assertRaises(ValueError):
+            c.toInnerPolygon(2)
+
     def test_area(self):
         c = Circle(UnitVector3d(1, 1, 1), 2.0)
         self.assertAlmostEqual(c.getArea(), 2 * math.pi)
@@ -167,6 +211,21 @@ class CircleTestCase(unittest.TestCase):
         b = yaml.safe_load(yaml.dump(a))
         self.assertEqual(a, b)
 
+    def test_relate_many(self):
+        query = Circle(UnitVector3d(1, 0, 0), Angle(0.1))
+        targets = []
+        for x in np.linspace(-0.2, 0.2, 50):
+            c = UnitVector3d(1, x, 0)
+            targets.append(Circle(c, Angle(0.02)))
+            targets.append(Box.fromRadians(x - 0.01, -0.01, x + 0.01, 0.01))
+            targets.append(ConvexPolygon([UnitVector3d(1, x - 0.01, -0.01), UnitVector3d(1, x + 0.01, -0.01),
+                                          UnitVector3d(1, x, 0.01)]))
+        expected = np.array([query.relate(t) for t in targets], dtype=np.uint8)
+        self.assertTrue(np.array_equal(query.relateMany(targets), expected))
+        self.assertTrue(np.array_equal(query.relateMany(targets, numThreads=2), expected))
+        self.assertTrue(np.array_equal(query.relateMany([t.encode() for t in targets]), expected))
+        self.assertTrue(np.array_equal(query.relateMany(Region.encodeBatch(targets)), expected))
+        self.assertEqual(len(query.relateMany([])), 0)
 
 if __name__ == "__main__":
     unittest.main()
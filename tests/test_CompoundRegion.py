@@ -21,6 +21,7 @@
 #
 
 import pickle
+import struct
 import unittest
 
 try:
@@ -74,7 +75,7 @@ class CompoundRegionTestMixin:
         """Assert that a compound regions operands are equal to the given
         tuple of operands.
         """
-        self.assertCountEqual((region.cloneOperand(0), region.cloneOperand(1)), operands)
+        self.assertCountEqual(tuple(region.cloneOperand(i) for i in range(region.nOperands())), operands)
 
     def assertCompoundRegionsEqual(self, a, b):
         """Assert that two compound regions are equal.
@@ -85,7 +86,7 @@ class CompoundRegionTestMixin:
         these tests do implement equality comparison.
         """
         self.assertEqual(type(a), type(b))
-        self.assertOperandsEqual(a, (b.cloneOperand(0), b.cloneOperand(1)))
+        self.assertOperandsEqual(a, tuple(b.cloneOperand(i) for i in range(b.nOperands())))
 
     def testSetUp(self):
         """Test that the points and operand regions being tested have the
@@ -106,10 +107,45 @@ class CompoundRegionTestMixin:
         self.assertEqual(self.box.relate(self.box), CONTAINS | WITHIN)
         self.assertEqual(self.box.relate(self.faraway), DISJOINT)
 
+    def testBounds(self):
+        """Test that bounds are stable across calls and copies."""
+        box = self.instance.getBoundingBox()
+        box3d = self.instance.getBoundingBox3d()
+        circle = self.instance.getBoundingCircle()
+        for region in (self.instance, self.instance.clone()):
+            self.assertEqual(region.getBoundingBox(), box)
+            self.assertEqual(region.getBoundingBox3d(), box3d)
+            self.assertEqual(region.getBoundingCircle(), circle)
+
+    def testCostHint(self):
+        """Test that compound regions are costed by their operands."""
+        self.assertEqual(
+            self.instance.getCostHint(), self.circle.getCostHint() + self.box.getCostHint()
+        )
+
     def testOperands(self):
         """Test the cloneOperands accessor."""
         self.assertOperandsEqual(self.instance, self.operands)
 
+    def testFlatten(self):
+        """Test that nested operands of the same type are flattened."""
+        cls = type(self.instance)
+        nested = cls(self.instance, self.faraway)
+        self.assertEqual(nested.nOperands(), 3)
+        self.assertOperandsEqual(nested, self.operands + (self.faraway,))
+        self.assertOperandsEqual(cls(self.faraway, nested), (self.faraway,) + self.operands + (self.faraway,))
+        self.assertOperandsEqual(cls(self.circle), (self.circle,))
+        self.assertEqual(cls().nOperands(), 0)
+
+    def testLegacyCodec(self):
+        """Test that the legacy two-operand encoding can be decoded."""
+        s = bytes([type(self.instance).LEGACY_TYPE_CODE])
+        for operand in self.operands:
+            encoded = operand.encode()
+            s += struct.pack("<Q", len(encoded)) + encoded
+        self.assertCompoundRegionsEqual(type(self.instance).decode(s), self.instance)
+        self.assertCompoundRegionsEqual(Region.decode(s), self.instance)
+
     def testCodec(self):
         """Test that encode and decode round-trip."""
         s = self.instance.encode()
@@ -117,6 +153,17 @@ class CompoundRegionTestMixin:
         self.assertCompoundRegionsEqual(CompoundRegion.decode(s), self.instance)
         self.assertCompoundRegionsEqual(Region.decode(s), self.instance)
 
+    def testBatchCodec(self):
+        """Test that batch encoding and decoding round-trip."""
+        regions = [self.instance, self.circle, self.box, self.instance]
+        decoded = Region.decodeBatch(Region.encodeBatch(regions))
+        self.assertEqual(len(decoded), 4)
+        self.assertCompoundRegionsEqual(decoded[0], self.instance)
+        self.assertEqual(decoded[1], self.circle)
+        self.assertEqual(decoded[2], self.box)
+        self.assertCompoundRegionsEqual(decoded[3], self.instance)
+        self.assertEqual(Region.decodeBatch(Region.encodeBatch([])), [])
+
     def testPickle(self):
         """Test pickling round-trips."""
         s = pickle.dumps(self.instance, pickle.HIGHEST_PROTOCOL)
@@ -30,7 +30,17 @@ except ImportError:
 import unittest
 
 import numpy as np
-from lsst.sphgeom import CONTAINS, Circle, ConvexPolygon, Region, UnitVector3d
+from lsst.sphgeom import (
+    CONTAINS,
+    Angle,
+    Box,
+    Circle,
+    ConvexPolygon,
+    Ellipse,
+    Region,
+    UnitVector3d,
+    overlapArea,
+)
 
 
 class ConvexPolygonTestCase(unittest.TestCase):
@@ -70,6 +80,40 @@ class ConvexPolygonTestCase(unittest.TestCase):
         self.assertFalse(p.isDisjointFrom(tinyCircle))
         self.assertTrue(p.contains(tinyCircle))
 
+    def testArea(self):
+        p = ConvexPolygon([UnitVector3d.Z(), UnitVector3d.X(), UnitVector3d.Y()])
+        self.assertAlmostEqual(p.getArea(), 0.5 * np.pi, places=15)
+        self.assertAlmostEqual(overlapArea(p, p), p.getArea(), places=14)
+        self.assertAlmostEqual(overlapArea(p, Box.fromRadians(0.1, 0.2, 0.4, 0.5)),
+                               0.3 * (np.sin(0.5) - np.sin(0.2)), places=15)
+        c = Circle(UnitVector3d(1, 1, 1), Angle(0.1))
+        self.assertAlmostEqual(overlapArea(p, c), c.getArea(), places=15)
+        with self.assertRaises(ValueError):
+            overlapArea(p, Ellipse(UnitVector3d.X(), Angle(0.1)))
+
+    def testSimplification(self):
+        c = UnitVector3d(1, 1, 1)
+        v = UnitVector3d.X()
+        p = ConvexPolygon([v.rotatedAround(c, Angle(2 * np.pi * i / 300)) for i in range(300)])
+        outer = p.simplifiedOuter(maxVertices=12)
+        inner = p.simplifiedInner(12)
+        self.assertLessEqual(len(outer.getVertices()), 12)
+        self.assertEqual(len(inner.getVertices()), 12)
+        self.assertEqual(outer.relate(p) & CONTAINS, CONTAINS)
+        self.assertEqual(p.relate(inner) & CONTAINS, CONTAINS)
+        with self.assertRaises(ValueError):
+            p.simplifiedOuter(2)
+
+    def testDilation(self):
+        p = ConvexPolygon([UnitVector3d.X(), UnitVector3d.Y(), UnitVector3d.Z()])
+        d = p.dilatedBy(Angle(0.1))
+        self.assertEqual(d.relate(p) & CONTAINS, CONTAINS)
+        self.assertTrue(d.contains(UnitVector3d(1, -0.05, 0)))
+        self.assertFalse(d.contains(UnitVector3d(1, -0.2, 0)))
+        self.assertEqual(p.dilatedBy(Angle(0)), p)
+        with self.assertRaises(ValueError):
+            p.dilatedBy(Angle(-0.1))
+
     def test_vectorized_contains(self):
         b = ConvexPolygon([UnitVector3d.Z(), UnitVector3d.X(), UnitVector3d.Y()])
         x = np.random.rand(5, 3)
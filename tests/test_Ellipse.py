@@ -104,6 +104,24 @@ class EllipseTestCase(unittest.TestCase):
         f = e.complemented().complement()
         self.assertEqual(e, f)
 
+    def test_polygons(self):
+        e = Ellipse(UnitVector3d.X(), Angle(0.3), Angle(0.1), Angle(0.5))
+        outer = e.toOuterPolygon()
+        inner = e.toInnerPolygon(n=8)
+        self.assertEqual(len(outer.getVertices()), 16)
+        self.assertEqual(len(inner.getVertices()), 8)
+        self.assertEqual(e.relate(outer) & WITHIN, WITHIN)
+        self.assertEqual(e.relate(inner) & CONTAINS, CONTAINS)
+        with self.assertRaises(ValueError):
+            Ellipse.empty().toOuterPolygon()
+
+    def test_area(self):
+        c = Circle(UnitVector3d.Y(), Angle(0.5))
+        self.assertAlmostEqual(Ellipse(c).getArea(), c.getArea(), places=14)
+        e = Ellipse(UnitVector3d.X(), Angle(math.pi / 3), Angle(math.pi / 6), Angle(0))
+        self.assertAlmostEqual(e.getArea() + e.complemented().getArea(), 4 * math.pi, places=13)
+        self.assertEqual(Ellipse.empty().getArea(), 0.0)
+
     def test_codec(self):
         e = Ellipse(UnitVector3d.X(), UnitVector3d.Y(), Angle(2 * math.pi / 3))
         s = e.encode()
@@ -0,0 +1,62 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+from lsst.sphgeom import Angle, Circle, EnvelopeCache, HtmPixelization, LonLat, Mq3cPixelization, UnitVector3d
+
+
+class EnvelopeCacheTestCase(unittest.TestCase):
+    """Test EnvelopeCache."""
+
+    def setUp(self):
+        self.regions = [
+            Circle(UnitVector3d(LonLat.fromDegrees(7.0 * i, i)), Angle.fromDegrees(0.5)) for i in range(10)
+        ]
+
+    def testEnvelopeInterior(self):
+        cache = EnvelopeCache(1 << 20)
+        self.assertEqual(cache.getMaxBytes(), 1 << 20)
+        htm = HtmPixelization(10)
+        mq3c = Mq3cPixelization(10)
+        for _ in range(2):
+            for r in self.regions:
+                self.assertEqual(cache.envelope(htm, r), htm.envelope(r))
+                self.assertEqual(cache.envelope(htm, r, maxRanges=4), htm.envelope(r, 4))
+                self.assertEqual(cache.interior(mq3c, r), mq3c.interior(r))
+        self.assertEqual(len(cache), 30)
+        self.assertEqual(cache.getMisses(), 30)
+        self.assertEqual(cache.getHits(), 30)
+        self.assertEqual(cache.getEvictions(), 0)
+        self.assertLessEqual(cache.getBytes(), cache.getMaxBytes())
+        cache.clear()
+        self.assertEqual(len(cache), 0)
+        with self.assertRaises(ValueError):
+            EnvelopeCache(0)
+
+    def testCacheKey(self):
+        self.assertEqual(HtmPixelization(3).getCacheKey(), "htm:3")
+        self.assertNotEqual(HtmPixelization(3).getCacheKey(), Mq3cPixelization(3).getCacheKey())
+
+
+if __name__ == "__main__":
+    unittest.main()
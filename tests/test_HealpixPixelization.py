@@ -192,12 +192,49 @@ class HealpixPixelizationTestCase(unittest.TestCase):
 
         self.assertEqual(pixels, check_pixels)
 
+    def test_max_ranges(self):
+        """Test that envelope and interior respect maxRanges."""
+        h = HealpixPixelization(8)
+        circle = Circle(UnitVector3d(LonLat.fromDegrees(50.0, 20.0)), Angle.fromDegrees(3.0))
+        envelope = h.envelope(circle)
+        interior = h.interior(circle)
+        self.assertGreater(len(envelope), 4)
+        self.assertTrue(envelope.contains(rangeSet=interior))
+        coarse = h.envelope(circle, 4)
+        self.assertLessEqual(len(coarse), 4)
+        self.assertTrue(coarse.contains(rangeSet=envelope))
+        self.assertTrue(interior.contains(rangeSet=h.interior(circle, 4)))
+
+    def test_envelope_array(self):
+        """Test envelope and interior as NumPy arrays."""
+        h = HealpixPixelization(8)
+        circle = Circle(UnitVector3d(LonLat.fromDegrees(50.0, 20.0)), Angle.fromDegrees(1.0))
+        envelope = h.envelope(circle)
+        ranges = h.envelopeArray(circle)
+        self.assertEqual(ranges.dtype, np.uint64)
+        np.testing.assert_array_equal(ranges, np.asarray(envelope))
+        pixels = h.envelopeArray(circle, expand=True)
+        np.testing.assert_array_equal(pixels, np.concatenate([np.arange(b, e) for b, e in envelope]))
+        np.testing.assert_array_equal(h.interiorArray(circle), np.asarray(h.interior(circle)))
+
     def test_index_to_string(self):
         """Test converting index to string of HealpixPixelization."""
         h = HealpixPixelization(5)
         self.assertEqual(h.toString(0), str(0))
         self.assertEqual(h.toString(100), str(100))
 
+    def test_string_arrays(self):
+        """Test converting index arrays to and from byte string arrays."""
+        h = HealpixPixelization(5)
+        indexes = np.array([0, 9, 100, 12287], dtype=np.uint64)
+        strings = h.toStringArray(indexes)
+        self.assertEqual(strings.dtype, np.dtype("S5"))
+        self.assertEqual(strings.tolist(), [b"0", b"9", b"100", b"12287"])
+        np.testing.assert_array_equal(h.fromStringArray(strings), indexes)
+        self.assertEqual(h.fromString("100"), 100)
+        with self.assertRaises(ValueError):
+            h.fromStringArray(np.array([b"12288"]))
+
     def test_string(self):
         """Test string representation of HealpixPixelization."""
         h = HealpixPixelization(5)
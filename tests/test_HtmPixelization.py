@@ -29,7 +29,48 @@ except ImportError:
 
 import unittest
 
-from lsst.sphgeom import Angle, Circle, ConvexPolygon, HtmPixelization, RangeSet, UnitVector3d
+import numpy as np
+from lsst.sphgeom import (
+    Angle,
+    Circle,
+    ConvexPolygon,
+    HtmPixelization,
+    IntersectionRegion,
+    LonLat,
+    Mq3cPixelization,
+    PixelizationABC,
+    RangeSet,
+    UnionRegion,
+    UnitVector3d,
+)
+
+
+class PythonHtmPixelization(PixelizationABC):
+    """A pure Python pixelization that forwards the abstract methods of
+    PixelizationABC to an HTM pixelization, and so uses its default batch
+    methods.
+    """
+
+    def __init__(self, level):
+        self._htm = HtmPixelization(level)
+
+    def universe(self):
+        return self._htm.universe()
+
+    def pixel(self, i):
+        return self._htm.pixel(i)
+
+    def index(self, v):
+        return self._htm.index(v)
+
+    def toString(self, i):
+        return self._htm.toString(i)
+
+    def envelope(self, region, maxRanges=0):
+        return self._htm.envelope(region, maxRanges)
+
+    def interior(self, region, maxRanges=0):
+        return self._htm.interior(region, maxRanges)
 
 
 class HtmPixelizationTestCase(unittest.TestCase):
@@ -51,10 +92,49 @@ class HtmPixelizationTestCase(unittest.TestCase):
         h = HtmPixelization(1)
         self.assertEqual(h.index(UnitVector3d(1, 1, 1)), 63)
 
+    def test_index_array(self):
+        rng = np.random.RandomState(1)
+        x, y, z = rng.randn(3, 4, 25)
+        lon = np.arctan2(y, x)
+        lat = np.arctan2(z, np.hypot(x, y))
+        for level in (0, 3, 10):
+            pixelization = HtmPixelization(level)
+            indexes = pixelization.index(x, y, z)
+            self.assertEqual(indexes.dtype, np.uint64)
+            self.assertEqual(indexes.shape, x.shape)
+            for i, j in np.ndindex(x.shape):
+                v = UnitVector3d(x[i, j], y[i, j], z[i, j])
+                self.assertEqual(indexes[i, j], pixelization.index(v))
+            indexes = pixelization.index(lon, lat)
+            self.assertEqual(indexes.shape, lon.shape)
+            for i, j in np.ndindex(lon.shape):
+                v = UnitVector3d(LonLat.fromRadians(lon[i, j], lat[i, j]))
+                self.assertEqual(indexes[i, j], pixelization.index(v))
+            vectors = UnitVector3d.fromLonLatArrays(lon, lat, degrees=False)
+            self.assertEqual(pixelization.index(vectors).tolist(), indexes.tolist())
+            self.assertEqual(pixelization.index(lon, lat, numThreads=3).tolist(), indexes.tolist())
+            self.assertEqual(pixelization.index(vectors, numThreads=3).tolist(), indexes.tolist())
+        with self.assertRaises(ValueError):
+            pixelization.index(x, y, z[:2])
+        with self.assertRaises(ValueError):
+            pixelization.index(np.zeros((4, 2)))
+
     def test_pixel(self):
         h = HtmPixelization(1)
         self.assertIsInstance(h.pixel(10), ConvexPolygon)
 
+    def test_vertices(self):
+        p = HtmPixelization(3, cacheSize=16)
+        indexes = np.array([[512, 600], [1023, 512]], dtype=np.uint64)
+        vertices = p.vertices(indexes)
+        self.assertEqual(vertices.shape, (2, 2, HtmPixelization.NUM_VERTICES, 3))
+        for i, j in np.ndindex(indexes.shape):
+            expected = [v for v in p.pixel(int(indexes[i, j])).getVertices()]
+            for k, v in enumerate(expected):
+                self.assertEqual(tuple(vertices[i, j, k]), (v.x(), v.y(), v.z()))
+        with self.assertRaises(ValueError):
+            p.vertices(np.array([0], dtype=np.uint64))
+
     def test_level(self):
         for index in (0, 16 * 4**HtmPixelization.MAX_LEVEL):
             self.assertEqual(HtmPixelization.level(index), -1)
@@ -72,6 +152,175 @@ class HtmPixelizationTestCase(unittest.TestCase):
         self.assertTrue(rs.isWithin(pixelization.universe()))
         rs = pixelization.interior(c)
         self.assertTrue(rs.empty())
+        rs = pixelization.envelope(c, numThreads=4)
+        self.assertTrue(rs == RangeSet(0x3FF))
+        rs = pixelization.interior(c, 1, 4)
+        self.assertTrue(rs.empty())
+
+    def test_envelope_and_interior_at_levels(self):
+        pixelization = HtmPixelization(3)
+        c = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(2.0))
+        levels = [8, 4, 8, 0]
+        envelopes = pixelization.envelopeAtLevels(c, levels)
+        interiors = pixelization.interiorAtLevels(c, levels)
+        self.assertEqual(len(envelopes), len(levels))
+        for level, envelope, interior in zip(levels, envelopes, interiors):
+            self.assertTrue(envelope.isWithin(HtmPixelization(level).envelope(c)))
+            self.assertEqual(interior, HtmPixelization(level).interior(c))
+        self.assertEqual(envelopes[0], HtmPixelization(8).envelope(c))
+        with self.assertRaises(ValueError):
+            pixelization.envelopeAtLevels(c, [25])
+
+    def test_envelope_and_interior_combined(self):
+        pixelization = HtmPixelization(9)
+        c = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(2.0))
+        envelope, interior = pixelization.envelopeAndInterior(c)
+        self.assertEqual(envelope, pixelization.envelope(c))
+        self.assertEqual(interior, pixelization.interior(c))
+        envelope, interior = pixelization.envelopeAndInterior(c, maxRanges=4)
+        self.assertLessEqual(len(envelope), 4)
+        self.assertLessEqual(len(interior), 4)
+        self.assertTrue(envelope.contains(pixelization.envelope(c)))
+        self.assertTrue(interior.isWithin(pixelization.interior(c)))
+
+    def test_update_envelope(self):
+        pixelization = HtmPixelization(9)
+        previous = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(2.0))
+        previousEnvelope = pixelization.envelope(previous)
+        envelope, added, removed = pixelization.updateEnvelope(previous, previousEnvelope, previous)
+        self.assertEqual(envelope, previousEnvelope)
+        self.assertTrue(added.empty())
+        self.assertTrue(removed.empty())
+        moved = Circle(UnitVector3d(1, 1, 1.01), Angle.fromDegrees(2.0))
+        envelope, added, removed = pixelization.updateEnvelope(previous, previousEnvelope, moved, numThreads=2)
+        self.assertEqual(envelope, pixelization.envelope(moved))
+        self.assertEqual(added, envelope - previousEnvelope)
+        self.assertEqual(removed, previousEnvelope - envelope)
+        self.assertFalse(added.empty())
+
+    def test_envelope_and_interior_arrays(self):
+        pixelization = HtmPixelization(5)
+        c = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(5.0))
+        for method, arrayMethod in (
+            (pixelization.envelope, pixelization.envelopeArray),
+            (pixelization.interior, pixelization.interiorArray),
+        ):
+            rs = method(c)
+            a = arrayMethod(c)
+            self.assertEqual(a.dtype, np.uint64)
+            self.assertEqual(a.shape, (len(rs), 2))
+            self.assertEqual(a.tolist(), [list(r) for r in rs])
+            self.assertEqual(arrayMethod(c, 2).tolist(), [list(r) for r in method(c, 2)])
+            pixels = arrayMethod(c, expand=True)
+            self.assertEqual(pixels.dtype, np.uint64)
+            self.assertEqual(pixels.tolist(), [i for b, e in rs for i in range(b, e)])
+        self.assertEqual(pixelization.interiorArray(Circle(UnitVector3d(1, 1, 1))).shape, (0, 2))
+
+    def test_abc_batch_methods(self):
+        native = HtmPixelization(6)
+        python = PythonHtmPixelization(6)
+        self.assertIsInstance(native, PixelizationABC)
+        rng = np.random.default_rng(5)
+        v = rng.normal(size=(3, 4, 5))
+        for p in (native, python):
+            indexes = p.indexArray(v[0], v[1], v[2])
+            self.assertEqual(indexes.dtype, np.uint64)
+            self.assertEqual(indexes.shape, (4, 5))
+            np.testing.assert_array_equal(indexes, native.index(v[0], v[1], v[2]))
+            ids = indexes.ravel()[:3].tolist()
+            self.assertEqual(p.pixels(ids), [native.pixel(i) for i in ids])
+            regions = [Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(1.0)), Circle(UnitVector3d(0, 0, 1))]
+            self.assertEqual(p.envelopeMany(regions), [native.envelope(r) for r in regions])
+            self.assertEqual(p.interiorMany(regions, 4), [native.interior(r, 4) for r in regions])
+
+    def test_compound_envelope_and_interior(self):
+        pixelization = HtmPixelization(8)
+        c1 = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(2.0))
+        c2 = Circle(UnitVector3d(1, 1, 0.9), Angle.fromDegrees(1.0))
+        u = UnionRegion(c1, c2)
+        self.assertEqual(pixelization.envelope(u), pixelization.envelope(c1) | pixelization.envelope(c2))
+        self.assertEqual(pixelization.interior(u), pixelization.interior(c1) | pixelization.interior(c2))
+        i = IntersectionRegion(c1, c2)
+        self.assertEqual(pixelization.interior(i), pixelization.interior(c1) & pixelization.interior(c2))
+        self.assertTrue(pixelization.envelope(i).isWithin(pixelization.envelope(c1)))
+
+    def test_envelope_and_interior_many(self):
+        pixelization = HtmPixelization(10)
+        regions = [
+            Circle(UnitVector3d(LonLat.fromDegrees(7.0 * i, 60.0 * np.sin(i))), Angle.fromDegrees(0.05 * i))
+            for i in range(50)
+        ]
+        envelopes = pixelization.envelopeMany(regions, numThreads=2)
+        interiors = pixelization.interiorMany(regions)
+        self.assertEqual(envelopes, [pixelization.envelope(r) for r in regions])
+        self.assertEqual(interiors, [pixelization.interior(r) for r in regions])
+        offsets, bounds = pixelization.envelopeManyFlat(regions)
+        self.assertEqual(offsets.shape, (len(regions) + 1,))
+        self.assertEqual(bounds.shape, (offsets[-1], 2))
+        for i, s in enumerate(envelopes):
+            self.assertEqual(RangeSet(bounds[offsets[i]:offsets[i + 1]]), s)
+        offsets, bounds = pixelization.interiorManyFlat([])
+        self.assertEqual(offsets.tolist(), [0])
+        self.assertEqual(bounds.shape, (0, 2))
+
+    def test_progressive_envelope(self):
+        pixelization = HtmPixelization(12)
+        c = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(2.0))
+        e = pixelization.progressiveEnvelope(c)
+        self.assertFalse(e.isComplete())
+        self.assertFalse(e.refine(10))
+        self.assertEqual(e.getNumSteps(), 10)
+        self.assertTrue(e.getRanges().contains(pixelization.envelope(c)))
+        e.refineFor(0.001)
+        while not e.refine(1000):
+            pass
+        self.assertEqual(e.getRanges(), pixelization.envelope(c))
+        self.assertEqual(e.getCoarsestLevel(), 12)
+
+    def test_coverage_fraction(self):
+        pixelization = HtmPixelization(6)
+        c = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(5.0))
+        begin, end, fraction = pixelization.coverageFraction(c)
+        self.assertEqual(begin.dtype, np.uint64)
+        self.assertEqual(fraction.dtype, np.float64)
+        self.assertEqual(begin.shape, end.shape)
+        self.assertEqual(begin.shape, fraction.shape)
+        self.assertTrue(np.all(begin[1:] >= end[:-1]))
+        self.assertTrue(np.all((fraction > 0) & (fraction <= 1)))
+        runs = np.stack([begin, end], axis=1)
+        self.assertTrue(RangeSet(runs[fraction == 1]).contains(pixelization.interior(c)))
+        self.assertTrue(pixelization.envelope(c).contains(RangeSet(runs)))
+        area = 0.0
+        for b, e, f in zip(begin, end, fraction):
+            area += f * sum(pixelization.pixel(i).getArea() for i in range(int(b), int(e)))
+        self.assertAlmostEqual(area, c.getArea(), places=12)
+
+    def test_pixel_set_conversion(self):
+        htm = HtmPixelization(7)
+        mq3c = Mq3cPixelization(8)
+        c = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(3.0))
+        pixels = htm.envelope(c)
+        envelope = mq3c.envelope(htm, pixels)
+        interior = mq3c.interior(pixelization=htm, pixels=pixels)
+        self.assertFalse(interior.empty())
+        self.assertTrue(interior.isWithin(envelope))
+        self.assertEqual(mq3c.envelope(htm, pixels, numThreads=2), envelope)
+        self.assertLessEqual(len(mq3c.envelope(htm, pixels, 2)), 2)
+
+    def test_neighborhood(self):
+        i = HtmPixelization(6).index(UnitVector3d(1, 2, 3))
+        n = HtmPixelization.neighborhood(i)
+        self.assertEqual(len(n), 13)
+        self.assertIn(i, n)
+        self.assertEqual(n, sorted(n))
+        ring = HtmPixelization.neighborhood(i, 1)
+        self.assertEqual(ring, RangeSet(n))
+        self.assertTrue(HtmPixelization.neighborhood(i, 2).contains(rangeSet=ring))
+        offsets, neighbors = HtmPixelization.neighborhoods(np.array([i, 8]))
+        self.assertEqual(list(offsets), [0, 13, 20])
+        self.assertEqual(list(neighbors[:13]), n)
+        with self.assertRaises(ValueError):
+            HtmPixelization.neighborhood(0)
 
     def test_index_to_string(self):
         strings = ["S0", "S1", "S2", "S3", "N0", "N1", "N2", "N3"]
@@ -84,6 +333,26 @@ class HtmPixelizationTestCase(unittest.TestCase):
                 self.assertEqual(HtmPixelization.asString(i * 4 + j), s1)
                 self.assertEqual(HtmPixelization(1).asString(i * 4 + j), s1)
 
+    def test_string_arrays(self):
+        p = HtmPixelization(3)
+        indexes = np.arange(8 * 64, 16 * 64, dtype=np.uint64).reshape(8, 64)
+        strings = p.toStringArray(indexes)
+        self.assertEqual(strings.dtype, np.dtype("S5"))
+        self.assertEqual(strings.shape, indexes.shape)
+        self.assertEqual(strings[0, 0], b"S0000")
+        self.assertEqual(strings[-1, -1], b"N3333")
+        self.assertEqual(p.maxStringLength(), 5)
+        np.testing.assert_array_equal(p.fromStringArray(strings), indexes)
+        self.assertEqual(p.fromString("N32"), 62)
+        # Shorter strings for coarser pixels are NUL padded.
+        self.assertEqual(p.fromStringArray(np.array([b"S0", b"N0123"])).tolist(), [8, 795])
+        with self.assertRaises(ValueError):
+            p.fromStringArray(np.array([b"X0"]))
+        with self.assertRaises(ValueError):
+            p.toStringArray(np.array([0], dtype=np.uint64))
+        with self.assertRaises(TypeError):
+            p.fromStringArray(np.array([1, 2]))
+
     def test_string(self):
         p = HtmPixelization(3)
         self.assertEqual(str(p), "HtmPixelization(3)")
@@ -23,7 +23,8 @@
 import pickle
 import unittest
 
-from lsst.sphgeom import Matrix3d, Vector3d
+import numpy as np
+from lsst.sphgeom import Matrix3d, UnitVector3d, Vector3d
 
 
 class Matrix3dTestCase(unittest.TestCase):
@@ -89,6 +90,21 @@ class Matrix3dTestCase(unittest.TestCase):
         self.assertEqual(m + m, m * Matrix3d(2))
         self.assertEqual(m, m * Matrix3d(2) - m)
 
+    def testApply(self):
+        m = Matrix3d(0.1, -0.7, 0.3, 0.9, 0.2, -0.4, -0.3, 0.5, 0.8)
+        rng = np.random.default_rng(1)
+        x, y, z = rng.uniform(-1.0, 1.0, size=(3, 4, 5))
+        ox, oy, oz = m.apply(x, y, z)
+        self.assertEqual(ox.shape, (4, 5))
+        ux, uy, uz = m.apply(x, y, z, normalize=True)
+        for i in np.ndindex(x.shape):
+            v = m * Vector3d(x[i], y[i], z[i])
+            self.assertEqual(Vector3d(ox[i], oy[i], oz[i]), v)
+            u = UnitVector3d(v)
+            self.assertEqual((ux[i], uy[i], uz[i]), (u.x(), u.y(), u.z()))
+        with self.assertRaises(ValueError):
+            m.apply(x, y, z[0])
+
     def testCwiseProduct(self):
         m = Matrix3d(1, 2, 3, 4, 1, 6, 7, 8, 1)
         self.assertEqual(m.cwiseProduct(Matrix3d(2)), Matrix3d(2))
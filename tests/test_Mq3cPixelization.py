@@ -29,7 +29,8 @@ except ImportError:
 
 import unittest
 
-from lsst.sphgeom import Angle, Circle, Mq3cPixelization, RangeSet, UnitVector3d
+import numpy as np
+from lsst.sphgeom import Angle, Circle, LonLat, Mq3cPixelization, RangeSet, UnitVector3d
 
 
 class Mq3cPixelizationTestCase(unittest.TestCase):
@@ -51,6 +52,27 @@ class Mq3cPixelizationTestCase(unittest.TestCase):
         pixelization = Mq3cPixelization(1)
         self.assertEqual(pixelization.index(UnitVector3d(0.5, -0.5, 1.0)), 53)
 
+    def test_index_array(self):
+        rng = np.random.RandomState(1)
+        x, y, z = rng.randn(3, 4, 25)
+        lon = np.arctan2(y, x)
+        lat = np.arctan2(z, np.hypot(x, y))
+        for level in (0, 3, 10):
+            pixelization = Mq3cPixelization(level)
+            indexes = pixelization.index(x, y, z)
+            self.assertEqual(indexes.dtype, np.uint64)
+            self.assertEqual(indexes.shape, x.shape)
+            for i, j in np.ndindex(x.shape):
+                v = UnitVector3d(x[i, j], y[i, j], z[i, j])
+                self.assertEqual(indexes[i, j], pixelization.index(v))
+            indexes = pixelization.index(lon, lat)
+            self.assertEqual(indexes.shape, lon.shape)
+            for i, j in np.ndindex(lon.shape):
+                v = UnitVector3d(LonLat.fromRadians(lon[i, j], lat[i, j]))
+                self.assertEqual(indexes[i, j], pixelization.index(v))
+        with self.assertRaises(ValueError):
+            pixelization.index(x, y, z[:2])
+
     def test_level(self):
         self.assertEqual(Mq3cPixelization.level(0), -1)
         for level in range(Mq3cPixelization.MAX_LEVEL + 1):
@@ -61,6 +83,18 @@ class Mq3cPixelizationTestCase(unittest.TestCase):
                 index = root * 4**level
                 self.assertEqual(Mq3cPixelization.level(index), level)
 
+    def test_vertices(self):
+        p = Mq3cPixelization(3)
+        indexes = np.array([[640, 700], [1023, 640]], dtype=np.uint64)
+        vertices = p.vertices(indexes)
+        self.assertEqual(vertices.shape, (2, 2, Mq3cPixelization.NUM_VERTICES, 3))
+        for i, j in np.ndindex(indexes.shape):
+            expected = [v for v in p.pixel(int(indexes[i, j])).getVertices()]
+            for k, v in enumerate(expected):
+                self.assertEqual(tuple(vertices[i, j, k]), (v.x(), v.y(), v.z()))
+        with self.assertRaises(ValueError):
+            p.vertices(np.array([0], dtype=np.uint64))
+
     def test_envelope_and_interior(self):
         pixelization = Mq3cPixelization(1)
         c = Circle(UnitVector3d(1.0, -0.5, -0.5), Angle.fromDegrees(0.1))
@@ -72,6 +106,47 @@ class Mq3cPixelizationTestCase(unittest.TestCase):
         rs = pixelization.interior(c)
         self.assertTrue(rs.empty())
 
+    def test_adaptive_envelope_and_interior(self):
+        pixelization = Mq3cPixelization(16)
+        c = Circle(UnitVector3d(1.0, -0.5, -0.5), Angle.fromDegrees(1.0))
+        self.assertEqual(pixelization.adaptiveEnvelope(c, 0), pixelization.envelope(c))
+        rs = pixelization.adaptiveEnvelope(c, 16)
+        self.assertLessEqual(len(rs), 16)
+        self.assertTrue(rs.contains(pixelization.envelope(c)))
+        rs = pixelization.adaptiveInterior(c, targetRanges=0, areaBudget=1.0e-4)
+        self.assertTrue(rs.isWithin(pixelization.interior(c)))
+        self.assertFalse(rs.empty())
+
+    def test_neighborhoods(self):
+        p = Mq3cPixelization(3)
+        indexes = np.arange(10 * 4**3, 16 * 4**3, 7, dtype=np.uint64)
+        out, counts = p.neighborhoods(indexes)
+        self.assertEqual(out.shape, (len(indexes), 9))
+        self.assertEqual(counts.dtype, np.uint8)
+        for i, row, n in zip(indexes, out, counts):
+            expected = p.neighborhood(int(i))
+            self.assertEqual(row[:n].tolist(), expected)
+            self.assertEqual(row[n:].tolist(), [expected[-1]] * (9 - n))
+        out, counts = p.neighborhoods(np.array([], dtype=np.uint64))
+        self.assertEqual(out.shape, (0, 9))
+        with self.assertRaises(ValueError):
+            p.neighborhoods(np.array([[1]], dtype=np.uint64))
+
+    def test_dilate(self):
+        p = Mq3cPixelization(4)
+        i = p.index(UnitVector3d(1, 2, 3))
+        self.assertEqual(p.dilate(RangeSet(i)), RangeSet(p.neighborhood(i)))
+        ring = RangeSet(i)
+        for k in range(1, 4):
+            grown = RangeSet(ring)
+            for begin, end in ring:
+                for j in range(begin, end):
+                    grown |= RangeSet(p.neighborhood(j))
+            ring = grown
+            self.assertEqual(p.dilate(RangeSet(i), k), ring)
+        with self.assertRaises(ValueError):
+            p.dilate(RangeSet(i), -1)
+
     def test_index_to_string(self):
         strings = ["+X", "+Y", "+Z", "-X", "-Y", "-Z"]
         for i in range(6):
@@ -0,0 +1,80 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import pickle
+import unittest
+
+import numpy as np
+from lsst.sphgeom import (
+    Angle,
+    Circle,
+    HealpixPixelization,
+    HtmPixelization,
+    MultiLevelRangeSet,
+    RangeSet,
+    UnitVector3d,
+)
+
+
+class MultiLevelRangeSetTestCase(unittest.TestCase):
+    """Test MultiLevelRangeSet."""
+
+    def testConstruction(self):
+        s = MultiLevelRangeSet(RangeSet(16, 37), 2)
+        self.assertEqual(s.maxLevel, 2)
+        self.assertEqual(s.getRanges(0), RangeSet(1))
+        self.assertEqual(s.getRanges(1), RangeSet(8))
+        self.assertEqual(s.getRanges(2), RangeSet(36))
+        self.assertEqual(len(s), 3)
+        self.assertEqual(s.getNumPixels(), 3)
+        self.assertEqual(s.flatten(), RangeSet(16, 37))
+        self.assertTrue(MultiLevelRangeSet().empty())
+        with self.assertRaises(ValueError):
+            MultiLevelRangeSet(RangeSet(), 31)
+
+    def testEnvelope(self):
+        c = Circle(UnitVector3d(1.0, 2.0, -1.0), Angle(0.3))
+        p = HtmPixelization(12)
+        s = p.multiLevelEnvelope(c)
+        self.assertEqual(s.flatten(), p.envelope(c))
+        self.assertLess(s.getNumPixels(), p.envelope(c).cardinality() // 100)
+        self.assertEqual(p.multiLevelInterior(c, maxRanges=16).flatten(), p.interior(c, 16))
+
+    def testUniq(self):
+        c = Circle(UnitVector3d(1.0, 2.0, -1.0), Angle(0.1))
+        s = HealpixPixelization(10).multiLevelEnvelope(c)
+        u = s.uniq()
+        self.assertEqual(u.dtype, np.uint64)
+        self.assertEqual(len(u), s.getNumPixels())
+        self.assertEqual(MultiLevelRangeSet.fromUniq(u), s)
+        self.assertEqual(MultiLevelRangeSet.fromUniq(u[::-1], maxLevel=10), s)
+        with self.assertRaises(ValueError):
+            MultiLevelRangeSet(RangeSet(15), 0).uniq()
+
+    def testPickle(self):
+        s = MultiLevelRangeSet(RangeSet([(3, 21), (40, 100)]), 3)
+        self.assertEqual(pickle.loads(pickle.dumps(s)), s)
+        self.assertEqual(eval(repr(s), {"MultiLevelRangeSet": MultiLevelRangeSet, "RangeSet": RangeSet}), s)
+
+
+if __name__ == "__main__":
+    unittest.main()
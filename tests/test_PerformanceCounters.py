@@ -0,0 +1,76 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import threading
+import unittest
+
+from lsst.sphgeom import (
+    PERFORMANCE_COUNTERS_ENABLED,
+    Angle,
+    Circle,
+    HtmPixelization,
+    UnitVector3d,
+    getPerformanceCounters,
+    resetPerformanceCounters,
+    setPerformanceCallback,
+)
+
+
+@unittest.skipUnless(PERFORMANCE_COUNTERS_ENABLED, "performance counters are compiled out")
+class PerformanceCountersTestCase(unittest.TestCase):
+    """Test the library performance counters."""
+
+    def testCountAndReset(self):
+        pixelization = HtmPixelization(8)
+        c = Circle(UnitVector3d(1, 1, 1), Angle(0.01))
+        resetPerformanceCounters()
+        self.assertTrue(all(v == 0 for v in getPerformanceCounters().values()))
+        pixelization.envelope(c)
+        pixelization.interior(c)
+        counters = getPerformanceCounters()
+        self.assertEqual(counters["htm.envelope.calls"], 1)
+        self.assertEqual(counters["htm.interior.calls"], 1)
+        self.assertGreater(counters["htm.envelope.nanoseconds"], 0)
+        self.assertEqual(counters["q3c.envelope.calls"], 0)
+        resetPerformanceCounters()
+        self.assertEqual(getPerformanceCounters()["htm.envelope.calls"], 0)
+
+    def testCallback(self):
+        called = threading.Event()
+        snapshots = []
+
+        def callback(counters):
+            snapshots.append(counters)
+            called.set()
+
+        with self.assertRaises(ValueError):
+            setPerformanceCallback(callback, 0.0)
+        setPerformanceCallback(callback, 0.001)
+        try:
+            self.assertTrue(called.wait(10.0))
+        finally:
+            setPerformanceCallback(None)
+        self.assertIn("region.decode.bytes", snapshots[0])
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,82 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import Angle, Circle, Mq3cPixelization, PixelCountMap, UnitVector3d
+
+
+class PixelCountMapTestCase(unittest.TestCase):
+    """Test PixelCountMap."""
+
+    def testConstruction(self):
+        m = PixelCountMap(10)
+        self.assertEqual(m.getLevel(), 10)
+        self.assertEqual(m.level, 10)
+        self.assertTrue(m.empty())
+        self.assertEqual(len(m), 0)
+        with self.assertRaises(ValueError):
+            PixelCountMap(31)
+
+    def testAddIndexes(self):
+        rng = np.random.default_rng(1)
+        indexes = rng.integers(0, 1000, size=100000, dtype=np.uint64)
+        weights = rng.integers(-3, 4, size=indexes.size).astype(np.float64)
+        for numThreads in (1, 2):
+            m = PixelCountMap(8)
+            m.addIndexes(indexes, numThreads=numThreads)
+            begin, end, value = m.getRuns()
+            self.assertEqual(begin.dtype, np.uint64)
+            self.assertEqual(value.dtype, np.float64)
+            dense = np.zeros(1000)
+            for b, e, v in zip(begin, end, value):
+                dense[b:e] = v
+            np.testing.assert_array_equal(dense, np.bincount(indexes.astype(np.int64), minlength=1000))
+            w = PixelCountMap(8)
+            w.addIndexes(indexes, weights, numThreads=numThreads)
+            expected = np.bincount(indexes.astype(np.int64), weights=weights, minlength=1000)
+            self.assertEqual([w.get(i) for i in range(1000)], expected.tolist())
+            self.assertEqual(w.total(), expected.sum())
+        with self.assertRaises(ValueError):
+            m.addIndexes(indexes, weights[:10])
+
+    def testAddRangesAndCoarsen(self):
+        pixelization = Mq3cPixelization(12)
+        circle = Circle(UnitVector3d(1, 1, 1), Angle.fromDegrees(1.0))
+        envelope = pixelization.envelope(circle)
+        m = PixelCountMap(12)
+        m.addRanges(envelope, 2.0)
+        m.add(m)
+        self.assertEqual(m.getPixels(), envelope)
+        self.assertEqual(m.total(), 4.0 * envelope.cardinality())
+        c = m.coarsened(10)
+        self.assertEqual(c.level, 10)
+        self.assertEqual(c.total(), m.total())
+        self.assertEqual(c.getPixels(), envelope.coarsened(2))
+        m.add(0, 1.0)
+        self.assertEqual(m.get(0), 1.0)
+        self.assertNotEqual(m, PixelCountMap(12))
+
+
+if __name__ == "__main__":
+    unittest.main()
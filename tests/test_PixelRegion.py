@@ -0,0 +1,104 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+import pickle
+import unittest
+
+try:
+    import yaml
+except ImportError:
+    yaml = None
+
+from lsst.sphgeom import (
+    CONTAINS,
+    DISJOINT,
+    WITHIN,
+    Angle,
+    Circle,
+    ConvexPolygon,
+    HtmPixelization,
+    LonLat,
+    PixelRegion,
+    RangeSet,
+    Region,
+    UnionRegion,
+    UnitVector3d,
+)
+
+
+class PixelRegionTestCase(unittest.TestCase):
+    """Test PixelRegion."""
+
+    def setUp(self):
+        self.pixelization = HtmPixelization(8)
+        self.circle = Circle(UnitVector3d(LonLat.fromDegrees(45.0, 30.0)), Angle.fromDegrees(2.0))
+        self.region = PixelRegion(self.pixelization, self.pixelization.envelope(self.circle))
+
+    def testConstruction(self):
+        self.assertEqual(self.region.getLevel(), 8)
+        self.assertEqual(self.region.getPixels(), self.pixelization.envelope(self.circle))
+        self.assertEqual(self.region.getPixelization().getLevel(), 8)
+        self.assertFalse(self.region.isEmpty())
+        self.assertTrue(PixelRegion(self.pixelization, RangeSet()).isEmpty())
+        with self.assertRaises(ValueError):
+            PixelRegion(self.pixelization, RangeSet(0, 1))
+
+    def testContains(self):
+        v = UnitVector3d(LonLat.fromDegrees(45.0, 30.0))
+        self.assertTrue(self.region.contains(v))
+        self.assertFalse(self.region.contains(UnitVector3d(LonLat.fromDegrees(-45.0, -30.0))))
+        self.assertTrue(self.region.getBoundingCircle().contains(v))
+
+    def testRelate(self):
+        self.assertTrue(self.region.relate(self.circle) & CONTAINS)
+        self.assertTrue(self.circle.relate(self.region) & WITHIN)
+        far = Circle(UnitVector3d(LonLat.fromDegrees(-45.0, -30.0)), Angle.fromDegrees(2.0))
+        self.assertEqual(self.region.relate(far), DISJOINT)
+
+    def testPolygons(self):
+        polygons = self.region.getPolygons()
+        self.assertTrue(all(isinstance(p, ConvexPolygon) for p in polygons))
+        self.assertLess(len(polygons), self.region.getPixels().cardinality())
+        v = UnitVector3d(LonLat.fromDegrees(45.0, 30.0))
+        self.assertEqual(sum(p.contains(v) for p in polygons), 1)
+        u = self.region.toUnionRegion()
+        self.assertIsInstance(u, UnionRegion)
+        self.assertEqual(u.nOperands(), len(polygons))
+        self.assertTrue(u.contains(v))
+        self.assertEqual(PixelRegion(self.pixelization, RangeSet()).getPolygons(), [])
+
+    def testCodec(self):
+        s = self.region.encode()
+        self.assertEqual(PixelRegion.decode(s), self.region)
+        self.assertEqual(Region.decode(s), self.region)
+        self.assertEqual(pickle.loads(pickle.dumps(self.region)), self.region)
+        with self.assertRaises(RuntimeError):
+            PixelRegion.decode(s[:3])
+
+    @unittest.skipIf(not yaml, "YAML module can not be imported")
+    def testYaml(self):
+        r = yaml.safe_load(yaml.dump(self.region))
+        self.assertIsInstance(r, PixelRegion)
+        self.assertEqual(r, self.region)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,71 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import os
+import tempfile
+import unittest
+
+import numpy as np
+from lsst.sphgeom import Angle, Circle, PointIndex, UnitVector3d
+
+
+class PointIndexTestCase(unittest.TestCase):
+    """Test PointIndex."""
+
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.xyz = rng.normal(size=(3, 2000))
+        self.points = [UnitVector3d(*v) for v in self.xyz.T]
+        self.index = PointIndex(*self.xyz, level=4)
+
+    def testConstruction(self):
+        self.assertEqual(len(self.index), 2000)
+        self.assertEqual(self.index.getLevel(), 4)
+        self.assertTrue(PointIndex().empty())
+        with self.assertRaises(ValueError):
+            PointIndex(self.xyz[0], self.xyz[1], self.xyz[2][:3], level=4)
+
+    def testQueries(self):
+        v = UnitVector3d(1, 2, 3)
+        c = Circle(v, Angle(0.2))
+        within = self.index.findWithin(v, Angle(0.2))
+        self.assertEqual(within.tolist(), [i for i, p in enumerate(self.points) if c.contains(p)])
+        indexes, separations = self.index.findNearest(v, 5)
+        expected = sorted(range(len(self.points)), key=lambda i: ((self.points[i] - v).getSquaredNorm(), i))
+        self.assertEqual(indexes.tolist(), expected[:5])
+        self.assertTrue(np.all(np.diff(separations) >= 0.0))
+
+    def testFile(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, "points.idx")
+            self.index.write(path)
+            mapped = PointIndex.open(path)
+            self.assertEqual(len(mapped), len(self.index))
+            v = UnitVector3d(0, 0, 1)
+            self.assertEqual(mapped.findNearest(v, 3)[0].tolist(), self.index.findNearest(v, 3)[0].tolist())
+        with self.assertRaises(RuntimeError):
+            PointIndex.open(path)
+
+
+if __name__ == "__main__":
+    unittest.main()
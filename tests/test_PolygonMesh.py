@@ -0,0 +1,66 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import Angle, Circle, HtmPixelization, PolygonMesh, UnitVector3d
+
+
+class PolygonMeshTestCase(unittest.TestCase):
+    """Test PolygonMesh."""
+
+    def setUp(self):
+        self.faces = [HtmPixelization.triangle(i) for i in range(8 * 4**3, 16 * 4**3)]
+        self.mesh = PolygonMesh(self.faces)
+
+    def testConstruction(self):
+        self.assertEqual(len(self.mesh), len(self.faces))
+        self.assertEqual(self.mesh[0], self.faces[0])
+        self.assertEqual(self.mesh[-1], self.faces[-1])
+        self.assertEqual(self.mesh.getNumEdges(), 3 * len(self.faces) // 2)
+        self.assertEqual(len(self.mesh.getVertices()), 2 + len(self.faces) // 2)
+        self.assertTrue(PolygonMesh().empty())
+        self.assertIsNone(PolygonMesh(self.faces[:1]).getNeighbor(0, 0))
+        with self.assertRaises(ValueError):
+            PolygonMesh(self.faces + self.faces[:1])
+
+    def testFindFaces(self):
+        rng = np.random.default_rng(2)
+        v = rng.normal(size=(500, 3))
+        found = self.mesh.findFaces(v[:, 0], v[:, 1], v[:, 2])
+        for p, i in zip(v, found):
+            self.assertTrue(self.faces[i].contains(*p))
+        self.assertEqual(self.mesh.findFace(UnitVector3d(*v[0])), found[0])
+        hole = PolygonMesh(self.faces[:1])
+        self.assertIsNone(hole.findFace(self.faces[1].getCentroid()))
+        self.assertEqual(hole.findFaces(np.array([1.0]), np.array([2.0]), np.array([3.0])).tolist(), [-1])
+
+    def testRelate(self):
+        circle = Circle(UnitVector3d(1, 2, 3), Angle(0.3))
+        relationships = self.mesh.relate(circle)
+        self.assertEqual(len(relationships), len(self.faces))
+        self.assertIn(self.mesh.findFace(circle.getCenter()), np.flatnonzero(relationships != 1))
+
+
+if __name__ == "__main__":
+    unittest.main()
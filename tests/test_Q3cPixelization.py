@@ -29,7 +29,8 @@ except ImportError:
 
 import unittest
 
-from lsst.sphgeom import Angle, Circle, ConvexPolygon, Q3cPixelization, RangeSet, UnitVector3d
+import numpy as np
+from lsst.sphgeom import Angle, Circle, ConvexPolygon, LonLat, Q3cPixelization, RangeSet, UnitVector3d
 
 
 class Q3cPixelizationTestCase(unittest.TestCase):
@@ -46,15 +47,53 @@ class Q3cPixelizationTestCase(unittest.TestCase):
         q3 = Q3cPixelization(q2)
         self.assertNotEqual(q1, q2)
         self.assertEqual(q2, q3)
+        self.assertFalse(q2.isHilbertOrder())
+        q4 = Q3cPixelization(1, hilbertOrder=True)
+        self.assertTrue(q4.isHilbertOrder())
+        self.assertNotEqual(q2, q4)
+        self.assertEqual(q4, Q3cPixelization(q4))
 
     def test_indexing(self):
         pixelization = Q3cPixelization(1)
         self.assertEqual(pixelization.index(UnitVector3d(0.5, -0.5, 1.0)), 0)
 
+    def test_index_array(self):
+        rng = np.random.RandomState(1)
+        x, y, z = rng.randn(3, 4, 25)
+        lon = np.arctan2(y, x)
+        lat = np.arctan2(z, np.hypot(x, y))
+        for level in (0, 3, 10):
+            pixelization = Q3cPixelization(level)
+            indexes = pixelization.index(x, y, z)
+            self.assertEqual(indexes.dtype, np.uint64)
+            self.assertEqual(indexes.shape, x.shape)
+            for i, j in np.ndindex(x.shape):
+                v = UnitVector3d(x[i, j], y[i, j], z[i, j])
+                self.assertEqual(indexes[i, j], pixelization.index(v))
+            indexes = pixelization.index(lon, lat)
+            self.assertEqual(indexes.shape, lon.shape)
+            for i, j in np.ndindex(lon.shape):
+                v = UnitVector3d(LonLat.fromRadians(lon[i, j], lat[i, j]))
+                self.assertEqual(indexes[i, j], pixelization.index(v))
+        with self.assertRaises(ValueError):
+            pixelization.index(x, y, z[:2])
+
     def test_pixel(self):
         h = Q3cPixelization(1)
         self.assertIsInstance(h.pixel(10), ConvexPolygon)
 
+    def test_vertices(self):
+        p = Q3cPixelization(3)
+        indexes = np.array([[0, 17], [383, 0]], dtype=np.uint64)
+        vertices = p.vertices(indexes)
+        self.assertEqual(vertices.shape, (2, 2, Q3cPixelization.NUM_VERTICES, 3))
+        for i, j in np.ndindex(indexes.shape):
+            expected = [v for v in p.pixel(int(indexes[i, j])).getVertices()]
+            for k, v in enumerate(expected):
+                self.assertEqual(tuple(vertices[i, j, k]), (v.x(), v.y(), v.z()))
+        with self.assertRaises(ValueError):
+            p.vertices(np.array([384], dtype=np.uint64))
+
     def test_envelope_and_interior(self):
         pixelization = Q3cPixelization(1)
         c = Circle(UnitVector3d(1.0, -0.5, -0.5), Angle.fromDegrees(0.1))
@@ -66,6 +105,46 @@ class Q3cPixelizationTestCase(unittest.TestCase):
         rs = pixelization.interior(c)
         self.assertTrue(rs.empty())
 
+    def test_neighborhoods(self):
+        p = Q3cPixelization(3)
+        indexes = np.arange(0, 6 * 4**3, 7, dtype=np.uint64)
+        out, counts = p.neighborhoods(indexes)
+        self.assertEqual(out.shape, (len(indexes), 9))
+        self.assertEqual(counts.dtype, np.uint8)
+        for i, row, n in zip(indexes, out, counts):
+            expected = p.neighborhood(int(i))
+            self.assertEqual(row[:n].tolist(), expected)
+            self.assertEqual(row[n:].tolist(), [expected[-1]] * (9 - n))
+        out, counts = p.neighborhoods(np.array([], dtype=np.uint64))
+        self.assertEqual(out.shape, (0, 9))
+        with self.assertRaises(ValueError):
+            p.neighborhoods(np.array([[1]], dtype=np.uint64))
+
+    def test_dilate(self):
+        p = Q3cPixelization(4)
+        i = p.index(UnitVector3d(1, 2, 3))
+        self.assertEqual(p.dilate(RangeSet(i)), RangeSet(p.neighborhood(i)))
+        ring = RangeSet(i)
+        for k in range(1, 4):
+            grown = RangeSet(ring)
+            for begin, end in ring:
+                for j in range(begin, end):
+                    grown |= RangeSet(p.neighborhood(j))
+            ring = grown
+            self.assertEqual(p.dilate(RangeSet(i), k), ring)
+        with self.assertRaises(ValueError):
+            p.dilate(RangeSet(i), -1)
+
+    def test_hilbert_order(self):
+        m = Q3cPixelization(6)
+        h = Q3cPixelization(6, hilbertOrder=True)
+        self.assertEqual(h.universe(), m.universe())
+        c = Circle(UnitVector3d(1, 2, 3), Angle.fromDegrees(5))
+        self.assertEqual(h.envelope(c).cardinality(), m.envelope(c).cardinality())
+        self.assertLess(len(h.envelope(c)), len(m.envelope(c)))
+        for i in (100, 4095, 4096, 6 * 4096 - 1):
+            self.assertEqual(h.index(h.quad(i).getCentroid()), i)
+
     def test_index_to_string(self):
         strings = ["+X", "+Y", "+Z", "-X", "-Y", "-Z"]
         for i in range(6):
@@ -83,17 +162,26 @@ class Q3cPixelizationTestCase(unittest.TestCase):
         self.assertEqual(str(p), "Q3cPixelization(3)")
         self.assertEqual(str(p), repr(p))
         self.assertEqual(p, eval(repr(p), {"Q3cPixelization": Q3cPixelization}))
+        p = Q3cPixelization(3, hilbertOrder=True)
+        self.assertEqual(str(p), "Q3cPixelization(3, hilbertOrder=True)")
+        self.assertEqual(p, eval(repr(p), {"Q3cPixelization": Q3cPixelization}))
 
     def test_pickle(self):
         a = Q3cPixelization(20)
         b = pickle.loads(pickle.dumps(a))
         self.assertEqual(a, b)
+        a = Q3cPixelization(20, hilbertOrder=True)
+        b = pickle.loads(pickle.dumps(a))
+        self.assertEqual(a, b)
 
     @unittest.skipIf(not yaml, "YAML module can not be imported")
     def test_yaml(self):
         a = Q3cPixelization(20)
         b = yaml.safe_load(yaml.dump(a))
         self.assertEqual(a, b)
+        a = Q3cPixelization(20, hilbertOrder=True)
+        b = yaml.safe_load(yaml.dump(a))
+        self.assertEqual(a, b)
 
 
 if __name__ == "__main__":
@@ -24,6 +24,7 @@ import pickle
 import sys
 import unittest
 
+import numpy as np
 from lsst.sphgeom import RangeSet
 
 
@@ -39,6 +40,52 @@ class RangeSetTestCase(unittest.TestCase):
         self.assertEqual(s3, s4)
         self.assertEqual(s1, s3.complement())
 
+    def testArrayConstruction(self):
+        values = [7, 3, 4, 4, 10, 5, 0]
+        expected = RangeSet([(0, 1), (3, 6), (7, 8), (10, 11)])
+        for dtype in (np.uint64, np.int64, np.uint32, np.int16):
+            self.assertEqual(RangeSet(np.array(values, dtype=dtype)), expected)
+        self.assertEqual(RangeSet(np.array([[0, 1], [3, 6]])), RangeSet([(0, 1), (3, 6)]))
+        with self.assertRaises(ValueError):
+            RangeSet(np.array([1, -1]))
+        s = RangeSet(20)
+        s.insertMany(np.array(values))
+        self.assertEqual(s, expected | RangeSet(20))
+
+    def testArrayContains(self):
+        s = RangeSet([(0, 1), (3, 6), (10, 11)])
+        values = np.array([5, 0, 1, 2, 3, 10, 11, 4, 0], dtype=np.uint64)
+        result = s.contains(values)
+        self.assertEqual(result.dtype, np.bool_)
+        self.assertEqual(result.tolist(), [s.contains(int(v)) for v in values])
+        self.assertEqual(s.contains(np.sort(values)).tolist(), [s.contains(int(v)) for v in np.sort(values)])
+        self.assertEqual(s.contains(np.array([], dtype=np.int64)).tolist(), [])
+        self.assertTrue(s.contains(4))
+        with self.assertRaises(ValueError):
+            s.contains(np.array([1, -1]))
+
+    def testBufferProtocol(self):
+        s = RangeSet([(1, 3), (5, 8), (10, 11)])
+        a = np.asarray(s)
+        self.assertEqual(a.dtype, np.uint64)
+        self.assertEqual(a.shape, (3, 2))
+        self.assertEqual(a.tolist(), [[1, 3], [5, 8], [10, 11]])
+        self.assertFalse(a.flags.writeable)
+        self.assertEqual(np.asarray(~s).tolist(), [[0, 1], [3, 5], [8, 10], [11, 0]])
+        self.assertEqual(np.asarray(RangeSet()).shape, (0, 2))
+        self.assertEqual(np.asarray(RangeSet(0, 0)).tolist(), [[0, 0]])
+        for t in (s, ~s, RangeSet(), RangeSet(0, 0)):
+            self.assertEqual(RangeSet(np.asarray(t)), t)
+        self.assertEqual(RangeSet(np.array([[5, 8], [1, 6]], dtype=np.int32)), RangeSet(1, 8))
+
+    def testEncodeDecode(self):
+        for s in (RangeSet(), RangeSet(0, 0), RangeSet([(1, 3), (5, 8), (10, 0)])):
+            b = s.encode()
+            self.assertIsInstance(b, bytes)
+            self.assertEqual(RangeSet.decode(b), s)
+        with self.assertRaises(RuntimeError):
+            RangeSet.decode(b"not a RangeSet")
+
     def testComparisonOperators(self):
         s1 = RangeSet(1)
         s2 = RangeSet(2)
@@ -75,6 +122,34 @@ class RangeSetTestCase(unittest.TestCase):
         c ^= c
         self.assertTrue(c.empty())
 
+    def testUnionAllIntersectAll(self):
+        sets = [RangeSet(1, 10), RangeSet(5, 20), ~RangeSet(7, 8)]
+        self.assertEqual(RangeSet.unionAll(sets), sets[0] | sets[1] | sets[2])
+        self.assertEqual(RangeSet.intersectAll(sets), RangeSet([(5, 7), (8, 10)]))
+        self.assertEqual(RangeSet.unionAll(iter(sets), numThreads=2), RangeSet.unionAll(sets))
+        self.assertTrue(RangeSet.unionAll([]).empty())
+        self.assertTrue(RangeSet.intersectAll([]).full())
+
+    def testCoarsenRefine(self):
+        s = RangeSet([(3, 9), (16, 31), (33, 34), (40, 48)])
+        self.assertEqual(s.coarsened(1), RangeSet([(0, 3), (4, 9), (10, 12)]))
+        self.assertEqual(s.coarsened(1, interior=True), RangeSet([(1, 2), (4, 7), (10, 12)]))
+        self.assertEqual(s.refined(2).coarsened(2), s)
+        t = RangeSet(s)
+        t.refine(1)
+        self.assertEqual(t, s.scaled(4))
+        t.coarsen(1)
+        self.assertEqual(t, s)
+
+    def testCompact(self):
+        s = RangeSet([(0, 1), (5, 8), (9, 12), (20, 22), (30, 40)])
+        self.assertEqual(s.compacted(3), RangeSet([(0, 12), (20, 22), (30, 40)]))
+        self.assertAlmostEqual(s.compactionOverCoverage(3), 5 / 21)
+        self.assertEqual(s.compacted(0), s)
+        t = RangeSet(s)
+        t.compact(1)
+        self.assertEqual(t, RangeSet(0, 40))
+
     def testRanges(self):
         s = RangeSet()
         s.insert(0, 1)
@@ -98,6 +173,21 @@ class RangeSetTestCase(unittest.TestCase):
         r = RangeSet([2, 3, 5, 7, 11, 13, 17, 19])
         s = pickle.loads(pickle.dumps(r))
         self.assertEqual(r, s)
+        for t in (RangeSet(), RangeSet(0, 0), RangeSet([(0, 2), (5, 8), (10, 0)]), r):
+            for protocol in range(2, pickle.HIGHEST_PROTOCOL + 1):
+                self.assertEqual(pickle.loads(pickle.dumps(t, protocol)), t)
+
+    @unittest.skipIf(pickle.HIGHEST_PROTOCOL < 5, "pickle protocol 5 is not available")
+    def testPickleOutOfBand(self):
+        r = RangeSet(np.arange(0, 2000000, 3))
+        buffers = []
+        data = pickle.dumps(r, protocol=5, buffer_callback=buffers.append)
+        self.assertEqual(len(buffers), 1)
+        self.assertEqual(buffers[0].raw().nbytes, 16 * len(r))
+        self.assertLess(len(data), 1000)
+        self.assertEqual(pickle.loads(data, buffers=buffers), r)
+        # The varint encoding is used with earlier protocols.
+        self.assertLess(len(pickle.dumps(r, protocol=4)), 3 * len(r))
 
 
 if __name__ == "__main__":
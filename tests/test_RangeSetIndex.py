@@ -0,0 +1,61 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import RangeSet, RangeSetIndex
+
+
+class RangeSetIndexTestCase(unittest.TestCase):
+    """Test RangeSetIndex."""
+
+    def testSelectAndRank(self):
+        s = RangeSet([(3, 6), (10, 12), (20, 25)])
+        index = RangeSetIndex(s)
+        members = [3, 4, 5, 10, 11, 20, 21, 22, 23, 24]
+        self.assertEqual(index.cardinality(), len(members))
+        self.assertEqual(len(index), 3)
+        self.assertEqual(index.getRangeSet(), s)
+        self.assertEqual([index.select(k) for k in range(len(members))], members)
+        self.assertEqual([index.rank(i) for i in members], list(range(len(members))))
+        self.assertEqual(index.rank(100), len(members))
+        self.assertEqual(index.select(2, 6), RangeSet([(5, 6), (10, 12), (20, 21)]))
+        with self.assertRaises(IndexError):
+            index.select(len(members))
+
+    def testSample(self):
+        s = RangeSet([(3, 6), (10, 12)])
+        values = RangeSetIndex(s).sample(100, seed=1)
+        self.assertEqual(values.shape, (100,))
+        self.assertTrue(all(s.contains(int(v)) for v in values))
+        self.assertTrue(np.array_equal(values, RangeSetIndex(s).sample(100, seed=1)))
+        with self.assertRaises(ValueError):
+            RangeSetIndex().sample(1)
+
+    def testString(self):
+        index = RangeSetIndex(RangeSet(1, 10))
+        self.assertEqual(repr(index), "RangeSetIndex(RangeSet([(1, 10)]))")
+
+
+if __name__ == "__main__":
+    unittest.main()
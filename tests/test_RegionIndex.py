@@ -0,0 +1,71 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import pickle
+import unittest
+
+import numpy as np
+from lsst.sphgeom import DISJOINT, Angle, Circle, ConvexPolygon, RegionIndex, UnitVector3d
+
+
+class RegionIndexTestCase(unittest.TestCase):
+    """Test RegionIndex."""
+
+    def setUp(self):
+        rng = np.random.default_rng(2)
+        self.regions = []
+        for c in rng.normal(size=(500, 3)):
+            offsets = 0.02 * rng.normal(size=(5, 3))
+            self.regions.append(ConvexPolygon([UnitVector3d(*(c / np.linalg.norm(c) + o)) for o in offsets]))
+        self.index = RegionIndex(self.regions)
+        self.points = [UnitVector3d(*p) for p in rng.normal(size=(200, 3))]
+
+    def testConstruction(self):
+        self.assertEqual(len(self.index), len(self.regions))
+        self.assertEqual(self.index[0], self.regions[0])
+        self.assertEqual(self.index[-1], self.regions[-1])
+        with self.assertRaises(IndexError):
+            self.index[len(self.regions)]
+        self.assertEqual(len(RegionIndex([])), 0)
+
+    def testOverlapping(self):
+        for p in self.points:
+            query = Circle(p, Angle.fromDegrees(10.0))
+            expected = [i for i, r in enumerate(self.regions) if not (r.relate(query) & DISJOINT)]
+            self.assertEqual(self.index.overlapping(query), expected)
+
+    def testContaining(self):
+        for r in self.regions[:20]:
+            c = r.getCentroid()
+            expected = [i for i, s in enumerate(self.regions) if s.contains(c)]
+            self.assertEqual(self.index.containing(c), expected)
+            self.assertIn(self.regions.index(r), expected)
+
+    def testCodec(self):
+        s = self.index.encode()
+        for decoded in (RegionIndex.decode(s), pickle.loads(pickle.dumps(self.index))):
+            self.assertEqual(len(decoded), len(self.index))
+            self.assertEqual(list(decoded[i] for i in range(len(decoded))), self.regions)
+
+
+if __name__ == "__main__":
+    unittest.main()
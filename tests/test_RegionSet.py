@@ -0,0 +1,78 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import Angle, Box, Circle, LonLat, RegionSet, UnitVector3d
+
+
+class RegionSetTestCase(unittest.TestCase):
+    """Test RegionSet."""
+
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.regions = []
+        for lon, lat in zip(rng.uniform(0.0, 360.0, 300), rng.uniform(-80.0, 80.0, 300)):
+            if len(self.regions) % 2 == 0:
+                self.regions.append(
+                    Circle(UnitVector3d(LonLat.fromDegrees(lon, lat)), Angle.fromDegrees(5.0))
+                )
+            else:
+                self.regions.append(Box.fromDegrees(lon - 4.0, lat - 3.0, lon + 4.0, lat + 3.0))
+        self.regionSet = RegionSet(self.regions)
+        v = rng.normal(size=(1000, 3))
+        self.x, self.y, self.z = v[:, 0], v[:, 1], v[:, 2]
+
+    def bruteForce(self, x, y, z):
+        return [i for i, r in enumerate(self.regions) if r.contains(x, y, z)]
+
+    def testConstruction(self):
+        self.assertEqual(len(self.regionSet), len(self.regions))
+        self.assertEqual(self.regionSet[0], self.regions[0])
+        self.assertEqual(self.regionSet[-1], self.regions[-1])
+        with self.assertRaises(IndexError):
+            self.regionSet[len(self.regions)]
+        self.assertEqual(len(RegionSet([])), 0)
+
+    def testContainsAny(self):
+        expected = [bool(self.bruteForce(*p)) for p in zip(self.x, self.y, self.z)]
+        np.testing.assert_array_equal(self.regionSet.containsAny(self.x, self.y, self.z), expected)
+        center = self.regions[0].getCenter()
+        self.assertTrue(self.regionSet.containsAny(center))
+        lonlat = LonLat(center)
+        self.assertTrue(
+            self.regionSet.containsAny(lonlat.getLon().asRadians(), lonlat.getLat().asRadians())
+        )
+
+    def testContainsWhich(self):
+        offsets, indexes = self.regionSet.containsWhich(self.x, self.y, self.z)
+        self.assertEqual(len(offsets), len(self.x) + 1)
+        self.assertEqual(offsets[-1], len(indexes))
+        for i, p in enumerate(zip(self.x, self.y, self.z)):
+            expected = self.bruteForce(*p)
+            self.assertEqual(list(indexes[offsets[i] : offsets[i + 1]]), expected)
+            self.assertEqual(self.regionSet.containsWhich(UnitVector3d(*p)), expected)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,60 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+from lsst.sphgeom import CONTAINS, DISJOINT, WITHIN, Angle, Box, Circle, LonLat, Region, RelateCache, UnitVector3d
+
+
+class RelateCacheTestCase(unittest.TestCase):
+    """Test RelateCache."""
+
+    def setUp(self):
+        self.regions = [
+            Circle(UnitVector3d(LonLat.fromDegrees(lon, 0.0)), Angle.fromDegrees(1.0)) for lon in range(20)
+        ]
+        self.query = Box.fromDegrees(4.5, -0.5, 8.5, 0.5)
+
+    def testRelate(self):
+        cache = RelateCache(1 << 20)
+        self.assertEqual(cache.getMaxBytes(), 1 << 20)
+        for _ in range(2):
+            for r in self.regions:
+                self.assertEqual(cache.relate(r, self.query), r.relate(self.query))
+        self.assertLessEqual(cache.getBytes(), cache.getMaxBytes())
+        self.assertEqual(cache.relate(self.query, self.query), CONTAINS | WITHIN)
+        cache.clear()
+        with self.assertRaises(ValueError):
+            RelateCache(0)
+
+    def testRelateBatch(self):
+        encoded = Region.encodeBatch(self.regions)
+        expected = [r.relate(self.query) for r in self.regions]
+        self.assertEqual(Region.relateBatch(encoded, self.query), expected)
+        cache = RelateCache(1 << 20)
+        for _ in range(2):
+            self.assertEqual(Region.relateBatch(encoded, self.query, cache), expected)
+        self.assertEqual(expected[0], DISJOINT)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,70 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+from lsst.sphgeom import Angle, Circle, Mq3cPixelization, TraversalStats, UnitVector3d
+
+
+@unittest.skipUnless(TraversalStats.ENABLED, "traversal statistics are compiled out")
+class TraversalStatsTestCase(unittest.TestCase):
+    """Test TraversalStats."""
+
+    def setUp(self):
+        self.pixelization = Mq3cPixelization(12)
+        self.circle = Circle(UnitVector3d(1, 2, 3), Angle(0.05))
+
+    def testContextManager(self):
+        with TraversalStats() as stats:
+            s = self.pixelization.envelope(self.circle)
+        self.assertEqual(len(stats.nodesVisited), 13)
+        self.assertEqual(stats.nodesVisited[0], 6)
+        self.assertEqual(sum(stats.nodesVisited), stats.relates())
+        self.assertGreaterEqual(stats.inserts, len(s))
+        self.assertEqual(stats.simplifications, 0)
+        self.assertEqual(stats.finalLevel, 12)
+        # Calls made outside of the context are not recorded.
+        self.pixelization.envelope(self.circle)
+        self.assertEqual(stats.nodesVisited[0], 6)
+
+    def testMaxRanges(self):
+        with TraversalStats() as stats:
+            self.pixelization.envelope(self.circle, maxRanges=4)
+        self.assertGreater(stats.simplifications, 0)
+        self.assertEqual(stats.finalLevel, 12 - stats.simplifications)
+
+    def testNesting(self):
+        with TraversalStats() as outer:
+            self.pixelization.interior(self.circle)
+            with TraversalStats() as inner:
+                self.pixelization.interior(self.circle)
+                self.pixelization.interior(self.circle)
+        self.assertEqual(inner.relates(), 2 * outer.relates())
+        outer.merge(inner)
+        self.assertEqual(outer.nodesVisited[0], 18)
+        outer.clear()
+        self.assertEqual(outer.relates(), 0)
+        self.assertEqual(outer.finalLevel, -1)
+
+
+if __name__ == "__main__":
+    unittest.main()
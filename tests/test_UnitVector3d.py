@@ -24,6 +24,7 @@ import math
 import pickle
 import unittest
 
+import numpy as np
 from lsst.sphgeom import Angle, LonLat, UnitVector3d, Vector3d
 
 
@@ -88,6 +89,36 @@ class UnitVector3dTestCase(unittest.TestCase):
         self.assertAlmostEqual(v.y(), 0.0, places=15)
         self.assertAlmostEqual(v.z(), 1.0, places=15)
 
+    def testLonLatArrays(self):
+        rng = np.random.default_rng(5)
+        lon = rng.uniform(-360.0, 720.0, size=(3, 7))
+        lat = rng.uniform(-90.0, 90.0, size=(3, 7))
+        lat[0, 0] = 90.0
+        v = UnitVector3d.fromLonLatArrays(lon, lat)
+        self.assertEqual(v.shape, (3, 7, 3))
+        fast = UnitVector3d.fromLonLatArrays(lon, lat, fast=True)
+        self.assertEqual(fast.shape, v.shape)
+        for i in np.ndindex(lon.shape):
+            u = UnitVector3d(LonLat.fromDegrees(lon[i], lat[i]))
+            self.assertEqual(tuple(v[i]), (u.x(), u.y(), u.z()))
+            self.assertLess(np.abs(fast[i] - v[i]).max(), 1e-15)
+        r = UnitVector3d.fromLonLatArrays(np.radians(lon), np.radians(lat), degrees=False)
+        self.assertLess(np.abs(r - v).max(), 1e-15)
+        lon2, lat2 = UnitVector3d.toLonLatArrays(v)
+        self.assertEqual(lon2.shape, lon.shape)
+        for i in np.ndindex(lon.shape):
+            p = LonLat(Vector3d(*v[i]))
+            self.assertEqual(lon2[i], p.getLon().asDegrees())
+            self.assertEqual(lat2[i], p.getLat().asDegrees())
+        lon3, lat3 = UnitVector3d.toLonLatArrays(v, degrees=False)
+        np.testing.assert_allclose(np.degrees(lat3), lat2)
+        with self.assertRaises(ValueError):
+            UnitVector3d.fromLonLatArrays(lon, lat[:2])
+        with self.assertRaises(ValueError):
+            UnitVector3d.fromLonLatArrays([0.0], [91.0])
+        with self.assertRaises(ValueError):
+            UnitVector3d.toLonLatArrays(np.zeros((2, 2)))
+
     def testString(self):
         v = UnitVector3d.X()
         self.assertEqual(str(v), "[1.0, 0.0, 0.0]")
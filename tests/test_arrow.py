@@ -0,0 +1,105 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+try:
+    import pyarrow as pa
+except ImportError:
+    pa = None
+
+from lsst.sphgeom import (
+    Angle,
+    Box,
+    Circle,
+    Ellipse,
+    HtmPixelization,
+    LonLat,
+    RangeSet,
+    UnitVector3d,
+    containsColumn,
+    decodeColumn,
+    envelopeColumn,
+    relateColumn,
+)
+
+
+@unittest.skipIf(pa is None, "pyarrow is not available")
+class ArrowTestCase(unittest.TestCase):
+    """Test the Arrow region column functions."""
+
+    def setUp(self):
+        center = UnitVector3d(LonLat.fromDegrees(30.0, 10.0))
+        self.regions = [
+            Circle(center, Angle.fromDegrees(1.0)),
+            None,
+            Box(LonLat.fromDegrees(30.5, 10.0), Angle.fromDegrees(0.5), Angle.fromDegrees(0.5)),
+            Ellipse(center, Angle.fromDegrees(2.0), Angle.fromDegrees(1.0), Angle.fromDegrees(45.0)),
+        ]
+        self.column = pa.array([None if r is None else r.encode() for r in self.regions], type=pa.binary())
+        self.query = Circle(center, Angle.fromDegrees(0.2))
+
+    def testDecode(self):
+        for column in (self.column, self.column.cast(pa.large_binary())):
+            decoded = decodeColumn(column)
+            self.assertEqual(decoded, self.regions)
+        self.assertEqual(decodeColumn(self.column.slice(1, 2)), self.regions[1:3])
+        with self.assertRaises(ValueError):
+            decodeColumn(pa.array([1, 2]))
+        with self.assertRaises(TypeError):
+            decodeColumn([r.encode() for r in self.regions if r is not None])
+
+    def testRelateAndContains(self):
+        for numThreads in (1, 2):
+            relations = pa.array(relateColumn(self.column, self.query, numThreads=numThreads))
+            self.assertEqual(relations.type, pa.uint8())
+            self.assertEqual(
+                relations.to_pylist(),
+                [None if r is None else r.relate(self.query) for r in self.regions],
+            )
+            contains = pa.array(containsColumn(self.column, self.query.getCenter(), numThreads=numThreads))
+            self.assertEqual(contains.type, pa.bool_())
+            self.assertEqual(
+                contains.to_pylist(),
+                [None if r is None else r.contains(self.query.getCenter()) for r in self.regions],
+            )
+
+    def testEnvelope(self):
+        pixelization = HtmPixelization(8)
+        envelopes = pa.array(envelopeColumn(self.column, pixelization, numThreads=2))
+        self.assertEqual(envelopes.null_count, 1)
+        for r, ranges in zip(self.regions, envelopes.to_pylist()):
+            if r is None:
+                self.assertIsNone(ranges)
+            else:
+                self.assertEqual(RangeSet([tuple(x) for x in ranges]), pixelization.envelope(r))
+
+    def testExportOnce(self):
+        result = relateColumn(self.column, self.query)
+        pa.array(result)
+        self.assertTrue(result.empty())
+        with self.assertRaises(RuntimeError):
+            pa.array(result)
+
+
+if __name__ == "__main__":
+    unittest.main()
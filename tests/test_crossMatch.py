@@ -0,0 +1,76 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import Angle, Circle, LonLat, UnitVector3d, crossMatch
+
+
+class CrossMatchTestCase(unittest.TestCase):
+    """Test crossMatch."""
+
+    def setUp(self):
+        rng = np.random.default_rng(1)
+        self.lon1 = rng.uniform(0.0, 2.0 * np.pi, 500)
+        self.lat1 = np.arcsin(rng.uniform(-1.0, 1.0, 500))
+        self.lon2 = np.concatenate((self.lon1 + rng.uniform(-0.01, 0.01, 500), rng.uniform(0.0, 1.0, 200)))
+        self.lat2 = np.concatenate((np.clip(self.lat1 + rng.uniform(-0.01, 0.01, 500), -1.5, 1.5),
+                                    rng.uniform(-0.5, 0.5, 200)))
+
+    def bruteForce(self, radius):
+        v2 = [UnitVector3d(LonLat.fromRadians(lon, lat)) for lon, lat in zip(self.lon2, self.lat2)]
+        result = []
+        for i, (lon, lat) in enumerate(zip(self.lon1, self.lat1)):
+            c = Circle(UnitVector3d(LonLat.fromRadians(lon, lat)), radius)
+            result.extend((i, j) for j, v in enumerate(v2) if c.contains(v))
+        return result
+
+    def testLonLat(self):
+        radius = Angle(0.01)
+        pairs = crossMatch(self.lon1, self.lat1, self.lon2, self.lat2, radius)
+        self.assertEqual(pairs.dtype, np.uint64)
+        self.assertEqual(pairs.shape[1], 2)
+        self.assertEqual([tuple(p) for p in pairs.tolist()], self.bruteForce(radius))
+        threaded = crossMatch(self.lon1, self.lat1, self.lon2, self.lat2, radius, numThreads=2)
+        self.assertTrue(np.array_equal(pairs, threaded))
+
+    def testVectors(self):
+        radius = Angle(0.005)
+        x1 = np.cos(self.lat1) * np.cos(self.lon1)
+        y1 = np.cos(self.lat1) * np.sin(self.lon1)
+        z1 = np.sin(self.lat1)
+        pairs = crossMatch(x1, y1, z1, x1, y1, z1, radius)
+        # Every point matches itself, and matching is symmetric.
+        self.assertEqual({i for i, j in pairs.tolist() if i == j}, set(range(len(x1))))
+        self.assertEqual(sorted((j, i) for i, j in pairs.tolist()), [tuple(p) for p in pairs.tolist()])
+
+    def testErrors(self):
+        with self.assertRaises(ValueError):
+            crossMatch(self.lon1, self.lat1[:3], self.lon2, self.lat2, Angle(0.01))
+        empty = np.array([], dtype=np.float64)
+        self.assertEqual(crossMatch(empty, empty, self.lon2, self.lat2, Angle(0.01)).shape, (0, 2))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,77 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import os
+import tempfile
+import unittest
+
+from lsst.sphgeom import (
+    MOC_MAX_ORDER,
+    Angle,
+    Circle,
+    HealpixPixelization,
+    RangeSet,
+    UnitVector3d,
+    mocFromAscii,
+    mocFromFits,
+    mocToAscii,
+    mocToFits,
+    readMoc,
+    writeMoc,
+)
+
+
+class MocTestCase(unittest.TestCase):
+    """Test MOC reading and writing."""
+
+    def testAscii(self):
+        s = mocFromAscii("1/0-3 8 3/512")
+        shift = 2 * (MOC_MAX_ORDER - 1)
+        self.assertEqual(s & RangeSet(0, 4 << shift), RangeSet(0, 4 << shift))
+        self.assertEqual(mocToAscii(s, 3), "0/0 1/8 3/512\n")
+        self.assertEqual(mocFromAscii(mocToAscii(s)), s)
+        with self.assertRaises(RuntimeError):
+            mocFromAscii("1/2-")
+        with self.assertRaises(ValueError):
+            mocToAscii(s, 30)
+
+    def testFits(self):
+        c = Circle(UnitVector3d(1, 0, 1), Angle(0.1))
+        s = HealpixPixelization(MOC_MAX_ORDER).envelope(c, 100)
+        b = mocToFits(s)
+        self.assertIsInstance(b, bytes)
+        self.assertEqual(len(b) % 2880, 0)
+        self.assertEqual(mocFromFits(b), s)
+        with self.assertRaises(RuntimeError):
+            mocFromFits(b[:2880])
+
+    def testFiles(self):
+        s = mocFromAscii("3/1-7 100 5/4000-4010")
+        with tempfile.TemporaryDirectory() as d:
+            for fits in (True, False):
+                path = os.path.join(d, "moc.fits" if fits else "moc.txt")
+                writeMoc(path, s, 5, fits=fits)
+                self.assertEqual(readMoc(path), s)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,61 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+
+import numpy as np
+from lsst.sphgeom import HtmPixelization, Mq3cPixelization, UnitVector3d, spatialSort
+
+
+class SpatialSortTestCase(unittest.TestCase):
+    """Test spatialSort."""
+
+    def setUp(self):
+        rng = np.random.default_rng(3)
+        self.x, self.y, self.z = rng.normal(size=(3, 5000))
+
+    def checkSorted(self, pixelization, p):
+        self.assertEqual(p.shape, self.x.shape)
+        self.assertEqual(sorted(p.tolist()), list(range(len(p))))
+        indexes = [pixelization.index(UnitVector3d(self.x[i], self.y[i], self.z[i])) for i in p]
+        self.assertEqual(indexes, sorted(indexes))
+
+    def testMq3c(self):
+        p = spatialSort(self.x, self.y, self.z, level=8)
+        self.checkSorted(Mq3cPixelization(8), p)
+        self.assertTrue(np.array_equal(spatialSort(self.x, self.y, self.z, 8, numThreads=4), p))
+        q = spatialSort(self.x[p], self.y[p], self.z[p], 8)
+        self.assertTrue(np.array_equal(q, np.arange(len(p))))
+
+    def testPixelization(self):
+        htm = HtmPixelization(12)
+        self.checkSorted(htm, spatialSort(htm, self.x, self.y, self.z))
+
+    def testErrors(self):
+        with self.assertRaises(ValueError):
+            spatialSort(self.x, self.y[:10], self.z, 8)
+        with self.assertRaises(ValueError):
+            spatialSort(self.x, self.y, self.z, Mq3cPixelization.MAX_LEVEL + 1)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,117 @@
+#
+# LSST Data Management System
+# See COPYRIGHT file at the top of the source tree.
+#
+# This product includes software developed by the
+# LSST Project (http://www.lsst.org/).
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the LSST License Statement and
+# the GNU General Public License along with this program.  If not,
+# see <https://www.lsstcorp.org/LegalNotices/>.
+#
+
+import unittest
+from concurrent.futures import ThreadPoolExecutor
+
+from lsst.sphgeom import (
+    Angle,
+    Box,
+    Chunker,
+    Circle,
+    ConvexPolygon,
+    Ellipse,
+    HtmPixelization,
+    LonLat,
+    Mq3cPixelization,
+    RangeSet,
+    UnitVector3d,
+    getMaxThreads,
+    setMaxThreads,
+)
+
+
+class ThreadingTestCase(unittest.TestCase):
+    """Test that heavy calls give the same results when run concurrently
+    on shared objects.
+    """
+
+    numThreads = 8
+
+    def setUp(self):
+        self.regions = []
+        for i in range(32):
+            center = UnitVector3d(LonLat.fromDegrees(11.0 * i, 2.5 * i - 40.0))
+            self.regions.append(Circle(center, Angle.fromDegrees(1.0 + 0.1 * i)))
+            self.regions.append(Ellipse(center, Angle.fromDegrees(2.0), Angle.fromDegrees(0.5),
+                                        Angle.fromDegrees(10.0 * i)))
+            self.regions.append(Box(LonLat.fromDegrees(11.0 * i, 2.5 * i - 40.0),
+                                    Angle.fromDegrees(1.5), Angle.fromDegrees(0.5)))
+
+    def checkConcurrent(self, func, args):
+        expected = [func(a) for a in args]
+        with ThreadPoolExecutor(self.numThreads) as executor:
+            for _ in range(3):
+                self.assertEqual(list(executor.map(func, args)), expected)
+
+    def testEnvelopeInterior(self):
+        for pixelization in (HtmPixelization(10), Mq3cPixelization(10)):
+            self.checkConcurrent(pixelization.envelope, self.regions)
+            self.checkConcurrent(pixelization.interior, self.regions)
+
+    def testChunker(self):
+        chunker = Chunker(85, 12)
+
+        def subChunks(region):
+            return [(c, list(s)) for c, s in chunker.getSubChunksIntersecting(region)]
+
+        self.checkConcurrent(subChunks, self.regions)
+        self.checkConcurrent(chunker.getChunksIntersecting, self.regions)
+
+    def testConvexHull(self):
+        def hull(region):
+            box = region.getBoundingBox()
+            lon, lat = box.getLon(), box.getLat()
+            points = [
+                UnitVector3d(LonLat(x, y))
+                for x in (lon.getA(), lon.getB(), box.getCenter().getLon())
+                for y in (lat.getA(), lat.getB())
+            ]
+            return ConvexPolygon.convexHull(points).getVertices()
+
+        self.checkConcurrent(hull, self.regions)
+
+    def testRangeSetOperations(self):
+        pixelization = HtmPixelization(12)
+        sets = [pixelization.envelope(r) for r in self.regions]
+        union = RangeSet.unionAll(sets)
+
+        def ops(s):
+            return [s | union, s & union, union - s, s ^ union, ~s, s.complemented()]
+
+        self.checkConcurrent(ops, sets)
+
+    def testMaxThreads(self):
+        sets = [HtmPixelization(12).envelope(r) for r in self.regions]
+        expected = RangeSet.unionAll(sets)
+        self.assertEqual(getMaxThreads(), 0)
+        try:
+            for n in (1, 2, 0):
+                setMaxThreads(n)
+                self.assertEqual(getMaxThreads(), n)
+                self.assertEqual(RangeSet.unionAll(sets, numThreads=4), expected)
+        finally:
+            setMaxThreads(0)
+
+
+if __name__ == "__main__":
+    unittest.main()